@@ -395,7 +395,7 @@ workEndAddr = (UINT32)pWorkEndAddr;
 /* Set Dst End Address for return */
 memcpy(pDstEnd, &workEndAddr, sizeof(UINT32));
 
-		if (TDRP_VAR_SIZE == noOfItems) /* variable size    */
+		if (TRDP_VAR_SIZE == noOfItems) /* variable size    */
 		{
 			noOfItems = var_size;
 		}
@@ -106,6 +106,7 @@ void usage (const char *appName)
            "-s <cycle time> (default 1000000 [us])\n"
            "-e send empty request\n"
            "-d <custom string to send> (default: 'Hello World')\n"
+           "-p <PTP clock device> time base, e.g. /dev/ptp0 (default: local clock)\n"
            "-v print version and quit\n"
            );
 }
@@ -133,6 +134,7 @@ int main (int argc, char *argv[])
     UINT32                  ownIP           = 0u;
     int rv = 0;
     UINT32                  destIP = 0u;
+    const CHAR8             *pPtpDevice = NULL;
 
     /*    Generate some data, that we want to send, when nothing was specified. */
     UINT8                   *outputBuffer;
@@ -150,7 +152,7 @@ int main (int argc, char *argv[])
         return 1;
     }
 
-    while ((ch = getopt(argc, argv, "t:o:d:s:h?vec:")) != -1)
+    while ((ch = getopt(argc, argv, "t:o:d:s:p:h?vec:")) != -1)
     {
         switch (ch)
         {
@@ -223,6 +225,9 @@ int main (int argc, char *argv[])
                outputBufferSize = dataSize;
                break;
            }
+           case 'p':
+               pPtpDevice = optarg;
+               break;
            case 'v':    /*  version */
                printf("%s: Version %s\t(%s - %s)\n",
                       argv[0], APP_VERSION, __DATE__, __TIME__);
@@ -252,6 +257,13 @@ int main (int argc, char *argv[])
         return 1;
     }
 
+    /*    Send on the time base of the train, before any time is taken    */
+    if ((pPtpDevice != NULL) && (vos_setTimeBase(pPtpDevice) != VOS_NO_ERR))
+    {
+        printf("Cannot use %s as time base\n", pPtpDevice);
+        return 1;
+    }
+
     /*    Open a session  */
     if (tlc_openSession(&appHandle,
                         ownIP, 0,               /* use default IP address           */
@@ -29,6 +29,14 @@
 #include <netinet/in.h>
 #ifdef __linux
 #   include <linux/if.h>
+#   include <linux/futex.h>
+#   include <linux/netlink.h>
+#   include <linux/rtnetlink.h>
+#   include <sys/socket.h>
+#   include <errno.h>
+#   include <sys/syscall.h>
+#   include <limits.h>
+#   include <time.h>
 #else
 #include <net/if.h>
 #endif
@@ -46,14 +54,79 @@
  * DEFINES
  */
 
-/*******************************************************************************
- * TYPEDEFS
- */
+/* Telegram seqlock of a Traffic Store offset */
+/* Telegrams in one cache line share a seqlock */
+#define TS_SEQLOCK(offset)  (&pTrafficStoreHeader->seqLock[(((offset) / TRAFFIC_STORE_CACHE_LINE) ^ ((offset) >> 14)) \
+                                              & (TRAFFIC_STORE_SEQLOCK_CNT - 1)].seq)
+
+/* Poll interval of tau_waitTrafficStore() where futexes are not available */
+#ifndef TRAFFIC_STORE_POLL_INTERVAL
+#define TRAFFIC_STORE_POLL_INTERVAL 1000u
+#endif
+
+/* Number of watched subnet interfaces (eth0: subnet1, eth1: subnet2) */
+#define LINK_WATCH_IF_CNT   2u
+
+/* Round up to the next cache line */
+#define TS_ALIGN(size)      (((size) + TRAFFIC_STORE_CACHE_LINE - 1) & ~(UINT32)(TRAFFIC_STORE_CACHE_LINE - 1))
+
+#ifdef __GNUC__
+#define TS_SEQ_LOAD(pSeq)           __atomic_load_n((pSeq), __ATOMIC_ACQUIRE)
+#define TS_SEQ_STORE(pSeq, val)     __atomic_store_n((pSeq), (val), __ATOMIC_RELEASE)
+#define TS_SEQ_CAS(pSeq, old, new)  __atomic_compare_exchange_n((pSeq), &(old), (new), FALSE, \
+                                                                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)
+#define TS_SEQ_FENCE()              __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#define TS_SEQ_ADD(pSeq, val)       __atomic_add_fetch((pSeq), (val), __ATOMIC_SEQ_CST)
+#define TS_SEQ_FULL_FENCE()         __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define TS_SEQ_LOAD(pSeq)           (*(volatile UINT32 *)(pSeq))
+#define TS_SEQ_STORE(pSeq, val)     (*(volatile UINT32 *)(pSeq) = (val))
+#define TS_SEQ_CAS(pSeq, old, new)  (TS_SEQ_LOAD(pSeq) == (old) && (TS_SEQ_STORE((pSeq), (new)), TRUE))
+#define TS_SEQ_FENCE()
+#define TS_SEQ_ADD(pSeq, val)       (*(volatile UINT32 *)(pSeq) += (val))
+#define TS_SEQ_FULL_FENCE()
+#endif
 
 /******************************************************************************
  *   Locals
  */
 
+/* TRUE if the Traffic Store was attached by tau_ladder_attach(), not created */
+static BOOL8 trafficStoreAttached = FALSE;
+
+/* Broker: next unused offset of the broker area, last client request sequence served */
+static UINT32 brokerAllocOffset = 0u;
+static UINT32 brokerServedSeq = 0u;
+
+/******************************************************************************
+ *   Local functions
+ */
+
+/* Wake readers sleeping in tau_waitTrafficStore(), enter the kernel only if one of them sleeps */
+static void tau_notifyTrafficStore (void)
+{
+    TRAFFIC_STORE_SEQLOCK_T *pNotify = &pTrafficStoreHeader->notify;
+
+    (void) TS_SEQ_ADD(&pNotify->seq, 1u);
+    TS_SEQ_FULL_FENCE();
+#ifdef __linux
+    if (TS_SEQ_LOAD(&pNotify->waiters) != 0u)
+    {
+        (void) syscall(SYS_futex, &pNotify->seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+#endif
+}
+
+/* Broker entry of a subscription handle, NULL if invalid */
+static TRAFFIC_STORE_BROKER_ENTRY_T *tau_getBrokerEntry (UINT32 subHandle)
+{
+    if ((pTrafficStoreHeader == NULL) || (subHandle == 0u) || (subHandle > TRAFFIC_STORE_BROKER_MAX))
+    {
+        return NULL;
+    }
+    return &pTrafficStoreHeader->broker[subHandle - 1u];
+}
+
 /******************************************************************************
  *   Globals
  */
@@ -65,9 +138,10 @@ VOS_MUTEX_T pTrafficStoreMutex = NULL;                    /* Pointer to Mutex fo
 /* Traffic Store */
 CHAR8 TRAFFIC_STORE[] = "/ladder_ts";                    /* Traffic Store shared memory name */
 mode_t PERMISSION     = 0666;                                /* Traffic Store permission is rw-rw-rw- */
-UINT8 *pTrafficStoreAddr;                                /* pointer to pointer to Traffic Store Address */
+UINT8 *pTrafficStoreAddr;                                /* pointer to Traffic Store data area */
+UINT32 trafficStoreSize = TRAFFIC_STORE_SIZE;            /* Traffic Store data area size */
+TRAFFIC_STORE_HEADER_T *pTrafficStoreHeader = NULL;     /* pointer to Traffic Store header */
 VOS_SHRD_T  pTrafficStoreHandle;                        /* Pointer to Traffic Store Handle */
-UINT16 TRAFFIC_STORE_MUTEX_VALUE_AREA = 0xFF00;        /* Traffic Store mutex ID Area */
 
 /* PDComLadderThread */
 //CHAR8 pdComLadderThreadName[] ="PDComLadderThread";        /* Thread name is PDComLadder Thread. */
@@ -87,12 +161,29 @@ UINT32 usingSubnetId;                                    /* Using SubnetId */
  *    @retval            TRDP_MUTEX_ERR
  */
 TRDP_ERR_T tau_ladder_init (void)
+{
+    return tau_ladder_initSize(TRAFFIC_STORE_SIZE);
+}
+
+/******************************************************************************/
+/** Initialize TRDP Ladder Support with a Traffic Store of the given size
+ *  Create Traffic Store mutex, Traffic Store.
+ *
+ *  @param[in]        size                Traffic Store data area size, 0: TRAFFIC_STORE_SIZE
+ *
+ *    @retval            TRDP_NO_ERR
+ *    @retval            TRDP_MUTEX_ERR
+ *    @retval            TRDP_MEM_ERR
+ */
+TRDP_ERR_T tau_ladder_initSize (UINT32 size)
 {
     /* Traffic Store */
     extern CHAR8 TRAFFIC_STORE[];                    /* Traffic Store shared memory name */
     extern VOS_SHRD_T  pTrafficStoreHandle;                /* Pointer to Traffic Store Handle */
-    extern UINT8 *pTrafficStoreAddr;                /* pointer to pointer to Traffic Store Address */
-    UINT32 trafficStoreSize = TRAFFIC_STORE_SIZE;    /* Traffic Store Size : 64KB */
+    extern UINT8 *pTrafficStoreAddr;                /* pointer to Traffic Store data area */
+    UINT8 *pSharedMemory = NULL;                    /* start of the Traffic Store shared memory */
+    UINT32 dataOffset = TS_ALIGN(sizeof(TRAFFIC_STORE_HEADER_T));
+    UINT32 sharedMemorySize;
 
 #if 0
     /* PDComLadderThread */
@@ -117,6 +208,26 @@ TRDP_ERR_T tau_ladder_init (void)
     }
 #endif
 
+    if (trafficStoreAttached == TRUE)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "TRDP Traffic Store already attached\n");
+        return TRDP_INIT_ERR;
+    }
+
+    /* Data area follows the header, both cache line aligned */
+    if (size == 0u)
+    {
+        size = TRAFFIC_STORE_SIZE;
+    }
+    size = TS_ALIGN(size);
+    /* Broker area for client subscriptions follows the configured telegrams */
+    if (size > 0xFFFFFFFFu - dataOffset - TS_ALIGN(TRAFFIC_STORE_BROKER_SIZE))
+    {
+        vos_printLog(VOS_LOG_ERROR, "TRDP Traffic Store size %u too large\n", size);
+        return TRDP_PARAM_ERR;
+    }
+    sharedMemorySize = dataOffset + size + TS_ALIGN(TRAFFIC_STORE_BROKER_SIZE);
+
     vosErr = vos_mutexCreate(&pTrafficStoreMutex);
     if (vosErr != VOS_NO_ERR)
     {
@@ -156,7 +267,7 @@ TRDP_ERR_T tau_ladder_init (void)
     }
 
     /* Create the Traffic Store */
-    vosErr = vos_sharedOpen(TRAFFIC_STORE, &pTrafficStoreHandle, &pTrafficStoreAddr, &trafficStoreSize);
+    vosErr = vos_sharedOpen(TRAFFIC_STORE, &pTrafficStoreHandle, &pSharedMemory, &sharedMemorySize);
     if (vosErr != VOS_NO_ERR)
     {
         vos_printLog(VOS_LOG_ERROR, "TRDP Traffic Store Create failed. VOS Error: %d\n", vosErr);
@@ -168,6 +279,20 @@ TRDP_ERR_T tau_ladder_init (void)
         pTrafficStoreHandle->sharedMemoryName = TRAFFIC_STORE;
     }
 
+    /* Publish the layout header, slots are added when the telegrams are configured */
+    pTrafficStoreHeader = (TRAFFIC_STORE_HEADER_T *) pSharedMemory;
+    pTrafficStoreHeader->version    = TRAFFIC_STORE_VERSION;
+    pTrafficStoreHeader->dataOffset = dataOffset;
+    pTrafficStoreHeader->dataSize   = size + TS_ALIGN(TRAFFIC_STORE_BROKER_SIZE);
+    pTrafficStoreHeader->brokerOffset = size;
+    pTrafficStoreHeader->brokerSize = TS_ALIGN(TRAFFIC_STORE_BROKER_SIZE);
+    pTrafficStoreHeader->slotCnt    = 0u;
+    pTrafficStoreHeader->magic      = TRAFFIC_STORE_MAGIC;
+    pTrafficStoreAddr   = pSharedMemory + dataOffset;
+    trafficStoreSize    = pTrafficStoreHeader->dataSize;
+    brokerAllocOffset   = size;
+    brokerServedSeq     = 0u;
+
     /* Traffic Store Mutex unlock */
     vos_mutexUnlock(pTrafficStoreMutex);
 /*    if ((vos_mutexUnlock(pTrafficStoreMutex)) != VOS_NO_ERR)
@@ -176,10 +301,6 @@ TRDP_ERR_T tau_ladder_init (void)
         return ret;
     }
 */
-    /* Set Traffic Store Semaphore Value */
-    memcpy((void *)((int)pTrafficStoreAddr + TRAFFIC_STORE_MUTEX_VALUE_AREA),
-            &pTrafficStoreMutex->mutexId,
-            sizeof(pTrafficStoreMutex->mutexId));
 
 #if 0
 /* Delete proc for TAUL */
@@ -225,17 +346,24 @@ TRDP_ERR_T tau_ladder_init (void)
  */
 TRDP_ERR_T tau_ladder_terminate (void)
 {
-    extern UINT8 *pTrafficStoreAddr;                    /* pointer to pointer to Traffic Store Address */
     extern VOS_MUTEX_T pTrafficStoreMutex;                /* Pointer to Mutex for Traffic Store */
     TRDP_ERR_T err = TRDP_NO_ERR;
 
+    /* Attached Traffic Store belongs to another process */
+    if (trafficStoreAttached == TRUE)
+    {
+        return tau_ladder_detach();
+    }
+
     /* Delete Traffic Store */
     tau_lockTrafficStore();
-    if (vos_sharedClose(pTrafficStoreHandle, pTrafficStoreAddr) != VOS_NO_ERR)
+    if (vos_sharedClose(pTrafficStoreHandle, (UINT8 *) pTrafficStoreHeader) != VOS_NO_ERR)
     {
         vos_printLog(VOS_LOG_ERROR, "Release Traffic Store shared memory failed\n");
         err = TRDP_MEM_ERR;
     }
+    pTrafficStoreHeader = NULL;
+    pTrafficStoreAddr   = NULL;
     tau_unlockTrafficStore();
 
     /* Delete Traffic Store Mutex */
@@ -331,6 +459,12 @@ TRDP_ERR_T  tau_lockTrafficStore (
         vos_printLog(VOS_LOG_ERROR, "TRDP Traffic Store Mutex Lock failed\n");
         return TRDP_MUTEX_ERR;
     }
+    /* Let per telegram readers retry while the store is locked */
+    if (pTrafficStoreHeader != NULL)
+    {
+        TS_SEQ_STORE(&pTrafficStoreHeader->lockSeq.seq, pTrafficStoreHeader->lockSeq.seq + 1u);
+        TS_SEQ_FENCE();
+    }
     return TRDP_NO_ERR;
 }
 
@@ -346,6 +480,11 @@ TRDP_ERR_T  tau_unlockTrafficStore (
 {
     extern VOS_MUTEX_T pTrafficStoreMutex;                            /* pointer to Mutex for Traffic Store */
 
+    if (pTrafficStoreHeader != NULL)
+    {
+        TS_SEQ_STORE(&pTrafficStoreHeader->lockSeq.seq, pTrafficStoreHeader->lockSeq.seq + 1u);
+    }
+
     /* Lock Traffic Store by Mutex */
     vos_mutexUnlock(pTrafficStoreMutex);
 /*    if (vos_mutexUnlock(pTrafficStoreMutex) != VOS_NO_ERR)
@@ -357,53 +496,627 @@ TRDP_ERR_T  tau_unlockTrafficStore (
         return TRDP_NO_ERR;
 }
 
+/******************************************************************************/
+/** Attach to the Traffic Store of another process
+ *  Maps the Traffic Store created by tau_ladder_init() of the TRDP process.
+ *
+ *    @retval            TRDP_NO_ERR
+ *    @retval            TRDP_MEM_ERR        Traffic Store does not exist
+ *    @retval            TRDP_INIT_ERR       Traffic Store not initialised or of another version
+ */
+TRDP_ERR_T tau_ladder_attach (void)
+{
+    TRAFFIC_STORE_HEADER_T *pHeader;
+    UINT8 *pSharedMemory = NULL;
+    UINT32 sharedMemorySize = 0u;
+    VOS_ERR_T vosErr;
+
+    if (pTrafficStoreHeader != NULL)
+    {
+        return TRDP_INIT_ERR;
+    }
+
+    vosErr = vos_sharedAttach(TRAFFIC_STORE, &pTrafficStoreHandle, &pSharedMemory, &sharedMemorySize);
+    if (vosErr != VOS_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "TRDP Traffic Store attach failed. VOS Error: %d\n", vosErr);
+        return TRDP_MEM_ERR;
+    }
+
+    /* The creator writes magic last */
+    pHeader = (TRAFFIC_STORE_HEADER_T *) pSharedMemory;
+    if ((sharedMemorySize < sizeof(TRAFFIC_STORE_HEADER_T))
+        || (TS_SEQ_LOAD(&pHeader->magic) != TRAFFIC_STORE_MAGIC)
+        || (pHeader->version != TRAFFIC_STORE_VERSION)
+        || (pHeader->dataOffset > sharedMemorySize)
+        || (pHeader->dataSize > sharedMemorySize - pHeader->dataOffset))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "TRDP Traffic Store header invalid\n");
+        (void) vos_sharedClose(pTrafficStoreHandle, pSharedMemory);
+        pTrafficStoreHandle = NULL;
+        return TRDP_INIT_ERR;
+    }
+
+    trafficStoreAttached = TRUE;
+    pTrafficStoreAddr    = pSharedMemory + pHeader->dataOffset;
+    trafficStoreSize     = pHeader->dataSize;
+    pTrafficStoreHeader  = pHeader;
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Detach from the Traffic Store of another process
+ *
+ *    @retval            TRDP_NO_ERR
+ *    @retval            TRDP_NOINIT_ERR     not attached
+ */
+TRDP_ERR_T tau_ladder_detach (void)
+{
+    UINT8 *pSharedMemory = (UINT8 *) pTrafficStoreHeader;
+
+    if ((trafficStoreAttached == FALSE) || (pSharedMemory == NULL))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pTrafficStoreHeader = NULL;
+    pTrafficStoreAddr   = NULL;
+    trafficStoreAttached = FALSE;
+    (void) vos_sharedClose(pTrafficStoreHandle, pSharedMemory);
+    pTrafficStoreHandle = NULL;
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
-/** Check Link up/down
+/** Add a telegram slot to the Traffic Store layout table
  *
- *  @param[in]        checkSubnetId            check Sub-network Id
- *  @param[out]        pLinkUpDown          pointer to check Sub-network Id Link Up Down TRUE:Up, FALSE:Down
+ *  @param[in]        comId               ComId of the telegram
+ *  @param[in]        offset              Traffic Store offset of the dataset
+ *  @param[in]        size                size of the dataset
+ *  @param[in]        kind                publish, subscribe or request
  *
- *  @retval         TRDP_NO_ERR                no error
- *  @retval         TRDP_PARAM_ERR            parameter err
- *  @retval         TRDP_SOCK_ERR            socket err
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR        slot exceeds the Traffic Store
+ *  @retval         TRDP_MEM_ERR          layout table full
+ */
+TRDP_ERR_T tau_addTrafficStoreLayout (
+    UINT32 comId,
+    UINT32 offset,
+    UINT32 size,
+    TRAFFIC_STORE_SLOT_KIND_T kind)
+{
+    TRAFFIC_STORE_SLOT_T *pSlot;
+    UINT32 i;
+
+    if (pTrafficStoreHeader == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if ((offset > trafficStoreSize) || (size > trafficStoreSize - offset))
+    {
+        vos_printLog(VOS_LOG_ERROR, "comId %u: offset %u size %u exceeds Traffic Store size %u\n",
+                     comId, offset, size, trafficStoreSize);
+        return TRDP_PARAM_ERR;
+    }
+    if ((offset % TRAFFIC_STORE_CACHE_LINE) != 0u)
+    {
+        vos_printLog(VOS_LOG_WARNING, "comId %u: offset %u is not aligned to %u bytes\n",
+                     comId, offset, TRAFFIC_STORE_CACHE_LINE);
+    }
+
+    tau_lockTrafficStore();
+    /* Subscriptions of the same telegram on both subnets share the slot */
+    for (i = 0u; i < pTrafficStoreHeader->slotCnt; i++)
+    {
+        pSlot = &pTrafficStoreHeader->slot[i];
+        if ((pSlot->offset == offset) && (pSlot->comId == comId))
+        {
+            tau_unlockTrafficStore();
+            return TRDP_NO_ERR;
+        }
+        if ((size > 0u) && (pSlot->size > 0u)
+            && (offset / TRAFFIC_STORE_CACHE_LINE <= (pSlot->offset + pSlot->size - 1u) / TRAFFIC_STORE_CACHE_LINE)
+            && (pSlot->offset / TRAFFIC_STORE_CACHE_LINE <= (offset + size - 1u) / TRAFFIC_STORE_CACHE_LINE))
+        {
+            vos_printLog(VOS_LOG_WARNING, "comId %u and comId %u share a Traffic Store cache line\n",
+                         comId, pSlot->comId);
+        }
+    }
+    if (pTrafficStoreHeader->slotCnt >= TRAFFIC_STORE_LAYOUT_MAX)
+    {
+        tau_unlockTrafficStore();
+        vos_printLog(VOS_LOG_ERROR, "Traffic Store layout table full, comId %u not listed\n", comId);
+        return TRDP_MEM_ERR;
+    }
+    pSlot = &pTrafficStoreHeader->slot[pTrafficStoreHeader->slotCnt];
+    pSlot->comId    = comId;
+    pSlot->offset   = offset;
+    pSlot->size     = size;
+    pSlot->kind     = (UINT32) kind;
+    TS_SEQ_STORE(&pTrafficStoreHeader->slotCnt, pTrafficStoreHeader->slotCnt + 1u);
+    tau_unlockTrafficStore();
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Begin writing a telegram in the Traffic Store.
  *
+ *  @param[in]      offset              Traffic Store offset of the telegram
  *
+ *  @retval         TRDP_NO_ERR            no error
  */
-static int ifGetSocket = 0;
+TRDP_ERR_T  tau_beginTrafficStoreWrite (
+    UINT32 offset)
+{
+    UINT32 *pSeq = TS_SEQLOCK(offset);
+    UINT32 seq;
 
-TRDP_ERR_T  tau_checkLinkUpDown (
-    UINT32 checkSubnetId,
-    BOOL8 *pLinkUpDown)
+    /* Make the sequence odd, writers of telegrams sharing the seqlock wait for each other */
+    for (;;)
+    {
+        seq = TS_SEQ_LOAD(pSeq);
+        if (((seq & 1u) == 0u) && TS_SEQ_CAS(pSeq, seq, seq + 1u))
+        {
+            break;
+        }
+        (void) vos_threadDelay(0u);
+    }
+    TS_SEQ_FENCE();
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** End writing a telegram in the Traffic Store.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ */
+TRDP_ERR_T  tau_endTrafficStoreWrite (
+    UINT32 offset)
 {
-    struct ifreq ifRead;
-    CHAR8 SUBNETWORK_ID1_IF_NAME[] = "eth0";
-    CHAR8 SUBNETWORK_ID2_IF_NAME[] = "eth1";
+    UINT32 *pSeq = TS_SEQLOCK(offset);
 
-    /* Parameter Check */
-    if (pLinkUpDown == NULL)
+    TS_SEQ_FENCE();
+    TS_SEQ_STORE(pSeq, *pSeq + 1u);
+    tau_notifyTrafficStore();
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Write a telegram into the Traffic Store.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[in]      pData               pointer to the telegram data
+ *  @param[in]      size                size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR        parameter error
+ */
+TRDP_ERR_T  tau_writeTrafficStore (
+    UINT32 offset,
+    const UINT8 *pData,
+    UINT32 size)
+{
+    if ((pData == NULL) || (offset > trafficStoreSize) || (size > trafficStoreSize - offset))
     {
-        vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown pLinkUpDown parameter err\n");
         return TRDP_PARAM_ERR;
     }
+    tau_beginTrafficStoreWrite(offset);
+    memcpy(pTrafficStoreAddr + offset, pData, size);
+    tau_endTrafficStoreWrite(offset);
+    return TRDP_NO_ERR;
+}
 
-    memset(&ifRead, 0, sizeof(ifRead));
+/**********************************************************************************************************************/
+/** Read a consistent copy of a telegram from the Traffic Store.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[out]     pData               pointer to the buffer receiving the telegram
+ *  @param[in]      size                size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR        parameter error
+ */
+TRDP_ERR_T  tau_readTrafficStore (
+    UINT32 offset,
+    UINT8 *pData,
+    UINT32 size)
+{
+    UINT32 *pSeq = TS_SEQLOCK(offset);
+    UINT32 seq, lockSeq;
+    UINT32 retry;
 
-    /* Check I/F setting */
-    if (checkSubnetId == SUBNET1)
+    if ((pData == NULL) || (offset > trafficStoreSize) || (size > trafficStoreSize - offset))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    for (retry = 0u; retry < TRAFFIC_STORE_READ_RETRY; retry++)
     {
-        /* Set I/F subnet1 */
-        strncpy(ifRead.ifr_name, SUBNETWORK_ID1_IF_NAME, IFNAMSIZ-1);
+        seq     = TS_SEQ_LOAD(pSeq);
+        lockSeq = TS_SEQ_LOAD(&pTrafficStoreHeader->lockSeq.seq);
+        if (((seq | lockSeq) & 1u) != 0u)
+        {
+            continue;
+        }
+        memcpy(pData, pTrafficStoreAddr + offset, size);
+        TS_SEQ_FENCE();
+        if ((TS_SEQ_LOAD(pSeq) == seq) && (TS_SEQ_LOAD(&pTrafficStoreHeader->lockSeq.seq) == lockSeq))
+        {
+            return TRDP_NO_ERR;
+        }
     }
-    else if (checkSubnetId == SUBNET2)
+
+    /* Telegram rewritten continuously, copy it as writer */
+    tau_beginTrafficStoreWrite(offset);
+    memcpy(pData, pTrafficStoreAddr + offset, size);
+    tau_endTrafficStoreWrite(offset);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Wait for a telegram write to the Traffic Store.
+ *
+ *  @param[in,out]  pNotifySeq          last notification sequence seen, updated on return
+ *  @param[in]      timeout             timeout in us, TRAFFIC_STORE_WAIT_FOREVER: no timeout
+ *
+ *  @retval         TRDP_NO_ERR            a telegram was written
+ *  @retval         TRDP_TIMEOUT_ERR      no telegram written within timeout
+ *  @retval         TRDP_PARAM_ERR        parameter error
+ *  @retval         TRDP_NOINIT_ERR       Traffic Store not initialised or attached
+ */
+TRDP_ERR_T  tau_waitTrafficStore (
+    UINT32 *pNotifySeq,
+    UINT32 timeout)
+{
+    TRAFFIC_STORE_SEQLOCK_T *pNotify;
+    VOS_TIMEVAL_T now, end, remaining = {0, 0};
+    UINT32 seq;
+#ifdef __linux
+    struct timespec ts;
+#endif
+
+    if (pNotifySeq == NULL)
     {
-        /* Set I/F subnet2 */
-        strncpy(ifRead.ifr_name, SUBNETWORK_ID2_IF_NAME, IFNAMSIZ-1);
+        return TRDP_PARAM_ERR;
     }
-    else
+    if (pTrafficStoreHeader == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pNotify = &pTrafficStoreHeader->notify;
+
+    if (timeout != TRAFFIC_STORE_WAIT_FOREVER)
+    {
+        vos_getTime(&end);
+        remaining.tv_sec    = timeout / 1000000u;
+        remaining.tv_usec   = timeout % 1000000u;
+        vos_addTime(&end, &remaining);
+    }
+
+    for (;;)
+    {
+        seq = TS_SEQ_LOAD(&pNotify->seq);
+        if (seq != *pNotifySeq)
+        {
+            *pNotifySeq = seq;
+            return TRDP_NO_ERR;
+        }
+        if (timeout != TRAFFIC_STORE_WAIT_FOREVER)
+        {
+            vos_getTime(&now);
+            if (vos_cmpTime(&now, &end) >= 0)
+            {
+                return TRDP_TIMEOUT_ERR;
+            }
+            remaining = end;
+            vos_subTime(&remaining, &now);
+        }
+#ifdef __linux
+        /* The kernel rechecks seq, a write after the load above is not missed */
+        (void) TS_SEQ_ADD(&pNotify->waiters, 1u);
+        ts.tv_sec   = remaining.tv_sec;
+        ts.tv_nsec  = remaining.tv_usec * 1000;
+        (void) syscall(SYS_futex, &pNotify->seq, FUTEX_WAIT, seq,
+                       (timeout == TRAFFIC_STORE_WAIT_FOREVER) ? NULL : &ts, NULL, 0);
+        (void) TS_SEQ_ADD(&pNotify->waiters, (UINT32) -1);
+#else
+        (void) vos_threadDelay(TRAFFIC_STORE_POLL_INTERVAL);
+#endif
+    }
+}
+
+/**********************************************************************************************************************/
+/** Subscribe a telegram through the PD broker.
+ *
+ *  @param[out]     pSubHandle          returned subscription handle
+ *  @param[in]      comId               ComId to subscribe
+ *  @param[in]      srcIpAddr           source IP filter, 0: any
+ *  @param[in]      destIpAddr          multicast group to join or 0
+ *  @param[in]      size                max. size of the dataset
+ *  @param[in]      timeout             receive timeout in us, 0: session default
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR        parameter error
+ *  @retval         TRDP_NOINIT_ERR       Traffic Store not initialised or attached
+ *  @retval         TRDP_MEM_ERR          no free subscription entry or Traffic Store area
+ *  @retval         TRDP_TIMEOUT_ERR      broker did not answer
+ */
+TRDP_ERR_T  tau_subscribeBrokerTelegram (
+    UINT32          *pSubHandle,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  destIpAddr,
+    UINT32          size,
+    UINT32          timeout)
+{
+    TRAFFIC_STORE_BROKER_ENTRY_T *pEntry = NULL;
+    UINT32 index, state, notifySeq = 0u;
+    VOS_TIMEVAL_T now, end, wait = {TRAFFIC_STORE_BROKER_WAIT / 1000000u, TRAFFIC_STORE_BROKER_WAIT % 1000000u};
+
+    if ((pSubHandle == NULL) || (size == 0u))
     {
-        vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown Check SubnetId failed\n");
         return TRDP_PARAM_ERR;
     }
+    if (pTrafficStoreHeader == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /* Claim a free entry, entries are shared by all client processes */
+    for (index = 0u; index < TRAFFIC_STORE_BROKER_MAX; index++)
+    {
+        state = TRAFFIC_STORE_BROKER_FREE;
+        if (TS_SEQ_CAS(&pTrafficStoreHeader->broker[index].state, state, TRAFFIC_STORE_BROKER_CLAIMED))
+        {
+            pEntry = &pTrafficStoreHeader->broker[index];
+            break;
+        }
+    }
+    if (pEntry == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Broker subscription table full, comId %u not subscribed\n", comId);
+        return TRDP_MEM_ERR;
+    }
+    pEntry->comId       = comId;
+    pEntry->srcIpAddr   = srcIpAddr;
+    pEntry->destIpAddr  = destIpAddr;
+    pEntry->size        = size;
+    pEntry->timeout     = timeout;
+    pEntry->rxCount     = 0u;
+    pEntry->status      = (UINT32) TRDP_NODATA_ERR;
+    (void) tau_waitTrafficStore(&notifySeq, 0u);
+    TS_SEQ_STORE(&pEntry->state, TRAFFIC_STORE_BROKER_REQUESTED);
+    (void) TS_SEQ_ADD(&pTrafficStoreHeader->brokerRequest.seq, 1u);
+
+    /* The broker notifies readers after serving a request */
+    vos_getTime(&end);
+    vos_addTime(&end, &wait);
+    for (;;)
+    {
+        state = TS_SEQ_LOAD(&pEntry->state);
+        if (state == TRAFFIC_STORE_BROKER_ACTIVE)
+        {
+            *pSubHandle = index + 1u;
+            return TRDP_NO_ERR;
+        }
+        if (state == TRAFFIC_STORE_BROKER_REJECTED)
+        {
+            TS_SEQ_STORE(&pEntry->state, TRAFFIC_STORE_BROKER_FREE);
+            return (TRDP_ERR_T)(INT32) pEntry->status;
+        }
+        vos_getTime(&now);
+        if (vos_cmpTime(&now, &end) >= 0)
+        {
+            break;
+        }
+        wait = end;
+        vos_subTime(&wait, &now);
+        (void) tau_waitTrafficStore(&notifySeq, (UINT32) (wait.tv_sec * 1000000 + wait.tv_usec));
+    }
+
+    /* Withdraw the request, or have it unsubscribed if the broker just served it */
+    state = TRAFFIC_STORE_BROKER_REQUESTED;
+    if (!TS_SEQ_CAS(&pEntry->state, state, TRAFFIC_STORE_BROKER_FREE))
+    {
+        (void) tau_unsubscribeBrokerTelegram(index + 1u);
+    }
+    vos_printLog(VOS_LOG_ERROR, "Broker did not answer subscription of comId %u\n", comId);
+    return TRDP_TIMEOUT_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Unsubscribe a telegram subscribed through the PD broker.
+ *
+ *  @param[in]      subHandle           subscription handle
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR        parameter error
+ *  @retval         TRDP_NOSUB_ERR        not subscribed
+ */
+TRDP_ERR_T  tau_unsubscribeBrokerTelegram (
+    UINT32          subHandle)
+{
+    TRAFFIC_STORE_BROKER_ENTRY_T *pEntry = tau_getBrokerEntry(subHandle);
+    UINT32 state = TRAFFIC_STORE_BROKER_ACTIVE;
+
+    if (pEntry == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!TS_SEQ_CAS(&pEntry->state, state, TRAFFIC_STORE_BROKER_RELEASE))
+    {
+        return TRDP_NOSUB_ERR;
+    }
+    (void) TS_SEQ_ADD(&pTrafficStoreHeader->brokerRequest.seq, 1u);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the last telegram received for a broker subscription, like tlp_get().
+ *
+ *  @param[in]      subHandle           subscription handle
+ *  @param[out]     pData               pointer to the buffer receiving the telegram
+ *  @param[in,out]  pDataSize           size of the buffer, on return size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR        parameter error
+ *  @retval         TRDP_NOSUB_ERR        not subscribed
+ *  @retval         TRDP_NODATA_ERR       nothing received yet
+ *  @retval         TRDP_TIMEOUT_ERR      telegram timed out, pData holds the last value
+ */
+TRDP_ERR_T  tau_getBrokerTelegram (
+    UINT32          subHandle,
+    UINT8           *pData,
+    UINT32          *pDataSize)
+{
+    TRAFFIC_STORE_BROKER_ENTRY_T *pEntry = tau_getBrokerEntry(subHandle);
+    TRDP_ERR_T status;
+
+    if ((pEntry == NULL) || (pData == NULL) || (pDataSize == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (TS_SEQ_LOAD(&pEntry->state) != TRAFFIC_STORE_BROKER_ACTIVE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+    status = (TRDP_ERR_T)(INT32) TS_SEQ_LOAD(&pEntry->status);
+    if (TS_SEQ_LOAD(&pEntry->rxCount) == 0u)
+    {
+        return TRDP_NODATA_ERR;
+    }
+    if (*pDataSize > pEntry->size)
+    {
+        *pDataSize = pEntry->size;
+    }
+    (void) tau_readTrafficStore(pEntry->offset, pData, *pDataSize);
+    return status;
+}
+
+/**********************************************************************************************************************/
+/** Serve the requests of broker clients.
+ *
+ *  @param[in]      pfServe             subscribes or unsubscribes a client entry
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_NOINIT_ERR       Traffic Store not initialised
+ */
+TRDP_ERR_T  tau_serveTrafficStoreBroker (
+    TRAFFIC_STORE_BROKER_CB_T pfServe)
+{
+    TRAFFIC_STORE_BROKER_ENTRY_T *pEntry;
+    UINT32 index, requestSeq, size;
+    BOOL8 served = FALSE;
+    TRDP_ERR_T err;
+
+    if ((pTrafficStoreHeader == NULL) || (trafficStoreAttached == TRUE) || (pfServe == NULL))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    requestSeq = TS_SEQ_LOAD(&pTrafficStoreHeader->brokerRequest.seq);
+    if (requestSeq == brokerServedSeq)
+    {
+        return TRDP_NO_ERR;
+    }
+    brokerServedSeq = requestSeq;
+
+    for (index = 0u; index < TRAFFIC_STORE_BROKER_MAX; index++)
+    {
+        pEntry = &pTrafficStoreHeader->broker[index];
+        switch (TS_SEQ_LOAD(&pEntry->state))
+        {
+            case TRAFFIC_STORE_BROKER_REQUESTED:
+                /* Reuse the area of an earlier subscription of this entry if large enough */
+                size = TS_ALIGN(pEntry->size);
+                if (pEntry->capacity < size)
+                {
+                    if (size > pTrafficStoreHeader->brokerOffset + pTrafficStoreHeader->brokerSize - brokerAllocOffset)
+                    {
+                        pEntry->status = (UINT32) TRDP_MEM_ERR;
+                        TS_SEQ_STORE(&pEntry->state, TRAFFIC_STORE_BROKER_REJECTED);
+                        served = TRUE;
+                        break;
+                    }
+                    pEntry->offset      = brokerAllocOffset;
+                    pEntry->capacity    = size;
+                    brokerAllocOffset   += size;
+                }
+                err = pfServe(index, pEntry, TRUE);
+                if (err == TRDP_NO_ERR)
+                {
+                    TS_SEQ_STORE(&pEntry->state, TRAFFIC_STORE_BROKER_ACTIVE);
+                }
+                else
+                {
+                    pEntry->status = (UINT32) err;
+                    TS_SEQ_STORE(&pEntry->state, TRAFFIC_STORE_BROKER_REJECTED);
+                }
+                served = TRUE;
+                break;
+            case TRAFFIC_STORE_BROKER_RELEASE:
+                (void) pfServe(index, pEntry, FALSE);
+                TS_SEQ_STORE(&pEntry->state, TRAFFIC_STORE_BROKER_FREE);
+                break;
+            default:
+                break;
+        }
+    }
+    if (served == TRUE)
+    {
+        tau_notifyTrafficStore();
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Record the reception state of a broker subscription.
+ *
+ *  @param[in]      index               broker entry index
+ *  @param[in]      status              TRDP_NO_ERR on reception, TRDP_TIMEOUT_ERR on timeout
+ */
+void  tau_setBrokerTelegramStatus (
+    UINT32          index,
+    TRDP_ERR_T      status)
+{
+    TRAFFIC_STORE_BROKER_ENTRY_T *pEntry = tau_getBrokerEntry(index + 1u);
+
+    if (pEntry == NULL)
+    {
+        return;
+    }
+    TS_SEQ_STORE(&pEntry->status, (UINT32) status);
+    if (status == TRDP_NO_ERR)
+    {
+        (void) TS_SEQ_ADD(&pEntry->rxCount, 1u);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Link up/down state
+ *  On Linux the state of both subnet interfaces is kept up to date from RTNLGRP_LINK netlink events, the ioctl
+ *  is only used to read the initial state and to resynchronise after a lost event.
+ */
+static int ifGetSocket = 0;
+
+static const CHAR8 *const linkIfName[LINK_WATCH_IF_CNT] = {"eth0", "eth1"};
+
+#ifdef __linux
+static int      linkWatchSocket = -1;                       /* netlink socket, -1 if not opened */
+static int      linkWatchIfIndex[LINK_WATCH_IF_CNT];        /* kernel interface index of eth0, eth1 */
+static BOOL8    linkWatchUp[LINK_WATCH_IF_CNT];             /* last known link state */
+#endif
+
+/* Read link state (and interface index) of an interface by ioctl */
+static TRDP_ERR_T tau_readLinkUpDown (
+    const CHAR8 *pIfName,
+    BOOL8       *pLinkUpDown,
+    int         *pIfIndex)
+{
+    struct ifreq ifRead;
+
+    memset(&ifRead, 0, sizeof(ifRead));
+    strncpy(ifRead.ifr_name, pIfName, IFNAMSIZ-1);
 
     if (ifGetSocket <= 0)
     {
@@ -412,6 +1125,7 @@ TRDP_ERR_T  tau_checkLinkUpDown (
         if (ifGetSocket == -1)
         {
             vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown socket descriptor err.\n");
+            ifGetSocket = 0;
             return TRDP_SOCK_ERR;
         }
     }
@@ -424,21 +1138,226 @@ TRDP_ERR_T  tau_checkLinkUpDown (
     }
 
     /* Check I/F Information Link UP or DOWN */
-    if (((ifRead.ifr_ifru.ifru_flags & IFF_UP) == IFF_UP)
-        && ((ifRead.ifr_ifru.ifru_flags & IFF_RUNNING) == IFF_RUNNING))
+    *pLinkUpDown = (((ifRead.ifr_flags & IFF_UP) == IFF_UP)
+                    && ((ifRead.ifr_flags & IFF_RUNNING) == IFF_RUNNING)) ? TRUE : FALSE;
+
+#ifdef __linux
+    if (pIfIndex != NULL)
     {
-        /* Link Up */
-        *pLinkUpDown = TRUE;
+        if (ioctl(ifGetSocket, SIOCGIFINDEX, &ifRead) != 0)
+        {
+            vos_printLog(VOS_LOG_ERROR, "Get I/F Index failed\n");
+            return TRDP_SOCK_ERR;
+        }
+        *pIfIndex = ifRead.ifr_ifindex;
     }
-    else
+#else
+    (void) pIfIndex;
+#endif
+    return TRDP_NO_ERR;
+}
+
+#ifdef __linux
+/* Read the state of both interfaces, used at open and after the netlink socket overflowed */
+static void tau_syncLinkWatch (void)
+{
+    UINT32 i;
+
+    for (i = 0u; i < LINK_WATCH_IF_CNT; i++)
+    {
+        if (tau_readLinkUpDown(linkIfName[i], &linkWatchUp[i], &linkWatchIfIndex[i]) != TRDP_NO_ERR)
+        {
+            /* Unknown interface: never matches an event, reported as down */
+            linkWatchIfIndex[i] = 0;
+            linkWatchUp[i]      = FALSE;
+        }
+    }
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Open the link state watcher
+ *  Subscribes to the netlink link events of the kernel. The returned descriptor becomes readable on every
+ *  link change and is to be passed to tau_processLinkEvents(); tau_checkLinkUpDown() then answers from the
+ *  last event without any system call.
+ *
+ *  @retval         descriptor          to be added to the read set of select()
+ *  @retval         -1                  not supported, tau_checkLinkUpDown() falls back to polling
+ */
+INT32 tau_openLinkWatch (void)
+{
+#ifdef __linux
+    struct sockaddr_nl addr;
+
+    if (linkWatchSocket >= 0)
+    {
+        return linkWatchSocket;
+    }
+
+    linkWatchSocket = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (linkWatchSocket < 0)
+    {
+        vos_printLog(VOS_LOG_WARNING, "tau_openLinkWatch netlink socket err, polling link state\n");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family  = AF_NETLINK;
+    addr.nl_groups  = RTMGRP_LINK;
+    if (bind(linkWatchSocket, (struct sockaddr *) &addr, sizeof(addr)) != 0)
+    {
+        vos_printLog(VOS_LOG_WARNING, "tau_openLinkWatch netlink bind err, polling link state\n");
+        close(linkWatchSocket);
+        linkWatchSocket = -1;
+        return -1;
+    }
+
+    /* Subscribed before reading the initial state, a change in between is delivered as event */
+    tau_syncLinkWatch();
+    return linkWatchSocket;
+#else
+    return -1;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Process pending link events
+ *  Reads all queued netlink messages without blocking and updates the link state of the subnet interfaces.
+ *
+ *  @param[out]     pChanged            TRUE if the state of a subnet interface changed
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     link watcher not opened
+ */
+TRDP_ERR_T tau_processLinkEvents (
+    BOOL8 *pChanged)
+{
+#ifdef __linux
+    UINT32          buf[2048];              /* UINT32 for the alignment of struct nlmsghdr */
+    struct nlmsghdr *pHdr;
+    ssize_t         len;
+    int             msgLen;
+    UINT32          i;
+
+    if (pChanged != NULL)
+    {
+        *pChanged = FALSE;
+    }
+    if (linkWatchSocket < 0)
     {
-        /* Link Down */
-        *pLinkUpDown = FALSE;
+        return TRDP_NOINIT_ERR;
     }
 
-//    close(ifGetSocket);
+    for (;;)
+    {
+        len = recv(linkWatchSocket, buf, sizeof(buf), MSG_DONTWAIT);
+        if (len < 0)
+        {
+            if (errno == ENOBUFS)
+            {
+                /* Events were lost, read the current state again */
+                vos_printLog(VOS_LOG_WARNING, "tau_processLinkEvents netlink overrun, resync\n");
+                tau_syncLinkWatch();
+                if (pChanged != NULL)
+                {
+                    *pChanged = TRUE;
+                }
+                continue;
+            }
+            break;                          /* EAGAIN: queue drained */
+        }
+
+        msgLen = (int) len;
+        for (pHdr = (struct nlmsghdr *) buf; NLMSG_OK(pHdr, msgLen); pHdr = NLMSG_NEXT(pHdr, msgLen))
+        {
+            const struct ifinfomsg *pInfo;
+            BOOL8 up;
 
+            if (((pHdr->nlmsg_type != RTM_NEWLINK) && (pHdr->nlmsg_type != RTM_DELLINK))
+                || (pHdr->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifinfomsg))))
+            {
+                continue;
+            }
+            pInfo   = (const struct ifinfomsg *) NLMSG_DATA(pHdr);
+            up      = ((pHdr->nlmsg_type == RTM_NEWLINK)
+                       && ((pInfo->ifi_flags & IFF_UP) == IFF_UP)
+                       && ((pInfo->ifi_flags & IFF_RUNNING) == IFF_RUNNING)) ? TRUE : FALSE;
+
+            for (i = 0u; i < LINK_WATCH_IF_CNT; i++)
+            {
+                if ((linkWatchIfIndex[i] != 0) && (linkWatchIfIndex[i] == pInfo->ifi_index)
+                    && (linkWatchUp[i] != up))
+                {
+                    linkWatchUp[i] = up;
+                    vos_printLog(VOS_LOG_INFO, "%s link %s\n", linkIfName[i], (up == TRUE) ? "up" : "down");
+                    if (pChanged != NULL)
+                    {
+                        *pChanged = TRUE;
+                    }
+                }
+            }
+        }
+    }
     return TRDP_NO_ERR;
+#else
+    if (pChanged != NULL)
+    {
+        *pChanged = FALSE;
+    }
+    return TRDP_NOINIT_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Check Link up/down
+ *
+ *  @param[in]        checkSubnetId            check Sub-network Id
+ *  @param[out]        pLinkUpDown          pointer to check Sub-network Id Link Up Down TRUE:Up, FALSE:Down
+ *
+ *  @retval         TRDP_NO_ERR                no error
+ *  @retval         TRDP_PARAM_ERR            parameter err
+ *  @retval         TRDP_SOCK_ERR            socket err
+ *
+ *
+ */
+TRDP_ERR_T  tau_checkLinkUpDown (
+    UINT32 checkSubnetId,
+    BOOL8 *pLinkUpDown)
+{
+    UINT32 ifNo;
+
+    /* Parameter Check */
+    if (pLinkUpDown == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown pLinkUpDown parameter err\n");
+        return TRDP_PARAM_ERR;
+    }
+
+    /* Check I/F setting */
+    if (checkSubnetId == SUBNET1)
+    {
+        ifNo = 0u;
+    }
+    else if (checkSubnetId == SUBNET2)
+    {
+        ifNo = 1u;
+    }
+    else
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown Check SubnetId failed\n");
+        return TRDP_PARAM_ERR;
+    }
+
+#ifdef __linux
+    /* Kept up to date by tau_processLinkEvents() */
+    if (linkWatchSocket >= 0)
+    {
+        *pLinkUpDown = linkWatchUp[ifNo];
+        return TRDP_NO_ERR;
+    }
+#endif
+
+    return tau_readLinkUpDown(linkIfName[ifNo], pLinkUpDown, NULL);
 }
 
 /**********************************************************************************************************************/
@@ -455,6 +1374,13 @@ TRDP_ERR_T  tau_closeCheckLinkUpDown (void)
         close(ifGetSocket);
         ifGetSocket = 0;
     }
+#ifdef __linux
+    if (linkWatchSocket >= 0)
+    {
+        close(linkWatchSocket);
+        linkWatchSocket = -1;
+    }
+#endif
     return TRDP_NO_ERR;
 }
 
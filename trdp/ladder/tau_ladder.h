@@ -36,7 +36,13 @@ extern "C" {
 /***********************************************************************************************************************
  * DEFINES
  */
-#define TRAFFIC_STORE_SIZE 65536			/* Traffic Store Size : 64KB */
+#ifndef TRAFFIC_STORE_SIZE
+#define TRAFFIC_STORE_SIZE 65536			/* Default Traffic Store Size : 64KB */
+#endif
+#define TRAFFIC_STORE_CACHE_LINE	64			/* Cache line size telegram slots should be aligned to */
+#define TRAFFIC_STORE_LAYOUT_MAX	1024		/* max. number of telegram slots in the layout table */
+#define TRAFFIC_STORE_MAGIC			0x54524453u	/* 'TRDS' marks an initialised Traffic Store header */
+#define TRAFFIC_STORE_VERSION		3u			/* Traffic Store header version */
 #define SUBNET1	0x00000000					/* Sub-network Id1 */
 #define SUBNET2	0x00002000					/* Sub-network Id2 */
 #define NUM_ED_INTERFACES	10				/* number of End Device Interfaces */
@@ -44,6 +50,101 @@ extern "C" {
 /* SubnetId Type */
 #define SUBNETID_TYPE1				1			/* SUBNETID Type1 */
 #define SUBNETID_TYPE2				2			/* SUBNETID Type2 */
+/* Per telegram access */
+#define TRAFFIC_STORE_SEQLOCK_CNT	256			/* number of telegram seqlocks, power of 2 */
+#define TRAFFIC_STORE_READ_RETRY	1000		/* reader retries before falling back to the store mutex */
+#define TRAFFIC_STORE_WAIT_FOREVER	0xFFFFFFFFu	/* tau_waitTrafficStore() without timeout */
+/* PD broker */
+#define TRAFFIC_STORE_BROKER_MAX	64			/* number of client subscriptions served by the broker */
+#ifndef TRAFFIC_STORE_BROKER_SIZE
+#define TRAFFIC_STORE_BROKER_SIZE	16384		/* Traffic Store area for client subscriptions */
+#endif
+#ifndef TRAFFIC_STORE_BROKER_WAIT
+#define TRAFFIC_STORE_BROKER_WAIT	2000000u	/* us a client waits for the broker to subscribe */
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/* Telegram slot kind */
+typedef enum
+{
+	TRAFFIC_STORE_SLOT_PUBLISH		= 1,		/* published telegram */
+	TRAFFIC_STORE_SLOT_SUBSCRIBE	= 2,		/* subscribed telegram */
+	TRAFFIC_STORE_SLOT_REQUEST		= 3			/* PD request telegram */
+} TRAFFIC_STORE_SLOT_KIND_T;
+
+/* Telegram slot in the Traffic Store layout table */
+typedef struct
+{
+	UINT32	comId;								/* ComId of the telegram */
+	UINT32	offset;								/* Offset of the dataset from the Traffic Store data area */
+	UINT32	size;								/* Size of the dataset */
+	UINT32	kind;								/* TRAFFIC_STORE_SLOT_KIND_T */
+} TRAFFIC_STORE_SLOT_T;
+
+/* Sequence counter padded to a cache line, writers of different telegrams do not share lines */
+typedef struct
+{
+	UINT32	seq;								/* odd while written, bumped on every write */
+	UINT32	waiters;							/* processes sleeping on seq (notification only) */
+	UINT8	pad[TRAFFIC_STORE_CACHE_LINE - 2 * sizeof(UINT32)];
+} TRAFFIC_STORE_SEQLOCK_T;
+
+/* State of a broker subscription entry */
+typedef enum
+{
+	TRAFFIC_STORE_BROKER_FREE		= 0,		/* unused */
+	TRAFFIC_STORE_BROKER_CLAIMED	= 1,		/* client fills in the request */
+	TRAFFIC_STORE_BROKER_REQUESTED	= 2,		/* waiting for the broker to subscribe */
+	TRAFFIC_STORE_BROKER_ACTIVE		= 3,		/* subscribed, data at offset */
+	TRAFFIC_STORE_BROKER_REJECTED	= 4,		/* broker could not subscribe, reason in status */
+	TRAFFIC_STORE_BROKER_RELEASE	= 5			/* waiting for the broker to unsubscribe */
+} TRAFFIC_STORE_BROKER_STATE_T;
+
+/* Client subscription served by the broker, one cache line */
+typedef struct
+{
+	UINT32	state;								/* TRAFFIC_STORE_BROKER_STATE_T */
+	UINT32	comId;								/* requested ComId */
+	UINT32	srcIpAddr;							/* source IP filter, 0: any */
+	UINT32	destIpAddr;							/* multicast group or 0 */
+	UINT32	size;								/* max. size of the dataset */
+	UINT32	timeout;							/* receive timeout in us, 0: session default */
+	UINT32	offset;								/* Traffic Store offset set by the broker */
+	UINT32	capacity;							/* size reserved at offset, kept for reuse */
+	UINT32	status;								/* TRDP_ERR_T of the subscription or last reception */
+	UINT32	rxCount;							/* number of telegrams received */
+	UINT8	pad[TRAFFIC_STORE_CACHE_LINE - 10 * sizeof(UINT32)];
+} TRAFFIC_STORE_BROKER_ENTRY_T;
+
+/* Broker service for a client subscription, called by tau_serveTrafficStoreBroker() */
+typedef TRDP_ERR_T (*TRAFFIC_STORE_BROKER_CB_T)(
+	UINT32								index,
+	const TRAFFIC_STORE_BROKER_ENTRY_T	*pEntry,
+	BOOL8								subscribe);
+
+/* Header at the start of the Traffic Store shared memory, the data area follows at dataOffset.
+   External processes attach to the shared memory, locate telegrams by the slot table and read them
+   lock-free through the seqlocks, which live in the shared memory as well. */
+typedef struct
+{
+	UINT32	magic;								/* TRAFFIC_STORE_MAGIC */
+	UINT32	version;							/* TRAFFIC_STORE_VERSION */
+	UINT32	dataOffset;							/* Offset of the data area, cache line aligned */
+	UINT32	dataSize;							/* Size of the data area */
+	UINT32	slotCnt;							/* Number of valid entries in slot[] */
+	UINT32	brokerOffset;						/* Offset of the broker area in the data area */
+	UINT32	brokerSize;							/* Size of the broker area */
+	UINT32	reserved[9];						/* pad to a cache line */
+	TRAFFIC_STORE_SEQLOCK_T	lockSeq;			/* odd while tau_lockTrafficStore() is held */
+	TRAFFIC_STORE_SEQLOCK_T	notify;				/* bumped after every telegram write, futex word */
+	TRAFFIC_STORE_SEQLOCK_T	brokerRequest;		/* bumped by clients on every broker request */
+	TRAFFIC_STORE_SEQLOCK_T	seqLock[TRAFFIC_STORE_SEQLOCK_CNT];	/* telegram seqlocks */
+	TRAFFIC_STORE_BROKER_ENTRY_T	broker[TRAFFIC_STORE_BROKER_MAX];	/* client subscriptions */
+	TRAFFIC_STORE_SLOT_T	slot[TRAFFIC_STORE_LAYOUT_MAX];
+} TRAFFIC_STORE_HEADER_T;
 
 /***********************************************************************************************************************
  * GLOBAL VARIABLES
@@ -52,9 +153,10 @@ extern "C" {
 /* Traffic Store */
 extern CHAR8 TRAFFIC_STORE[];				/* Traffic Store shared memory name */
 extern mode_t PERMISSION	;					/* Traffic Store permission is rw-rw-rw- */
-extern UINT8 *pTrafficStoreAddr;			/* pointer to pointer to Traffic Store Address */
+extern UINT8 *pTrafficStoreAddr;			/* pointer to Traffic Store data area */
+extern UINT32 trafficStoreSize;				/* Traffic Store data area size */
+extern TRAFFIC_STORE_HEADER_T *pTrafficStoreHeader;	/* pointer to Traffic Store header (start of the shared memory) */
 extern VOS_SHRD_T  pTrafficStoreHandle;	/* Pointer to Traffic Store Handle */
-extern UINT16 TRAFFIC_STORE_MUTEX_VALUE_AREA;		/* Traffic Store mutex ID Area */
 
 /* PDComLadderThread */
 extern CHAR8 pdComLadderThreadName[];		/* Thread name is PDComLadder Thread. */
@@ -79,6 +181,60 @@ extern UINT32 usingSubnetId;				/* Using SubnetId */
 TRDP_ERR_T tau_ladder_init (
 	void);
 
+/******************************************************************************/
+/** Initialize TRDP Ladder Support with a Traffic Store of the given size
+ *  Create Traffic Store mutex, Traffic Store.
+ *
+ *  @param[in]		size				Traffic Store data area size, 0: TRAFFIC_STORE_SIZE
+ *
+ *	@retval			TRDP_NO_ERR
+ *	@retval			TRDP_MUTEX_ERR
+ *	@retval			TRDP_MEM_ERR
+ */
+TRDP_ERR_T tau_ladder_initSize (
+	UINT32 size);
+
+/******************************************************************************/
+/** Attach to the Traffic Store of another process
+ *  Maps the Traffic Store created by tau_ladder_init() of the TRDP process, its telegrams can then be read by
+ *  tau_readTrafficStore() and waited for by tau_waitTrafficStore() without any syscall or lock.
+ *
+ *	@retval			TRDP_NO_ERR
+ *	@retval			TRDP_MEM_ERR		Traffic Store does not exist
+ *	@retval			TRDP_INIT_ERR		Traffic Store not initialised or of another version
+ */
+TRDP_ERR_T tau_ladder_attach (
+	void);
+
+/******************************************************************************/
+/** Detach from the Traffic Store of another process
+ *
+ *	@retval			TRDP_NO_ERR
+ *	@retval			TRDP_NOINIT_ERR		not attached
+ */
+TRDP_ERR_T tau_ladder_detach (
+	void);
+
+/******************************************************************************/
+/** Add a telegram slot to the Traffic Store layout table
+ *  Slots which are not cache line aligned or which share a cache line with another slot are accepted,
+ *  but reported, as their writers will contend for the cache line.
+ *
+ *  @param[in]		comId				ComId of the telegram
+ *  @param[in]		offset				Traffic Store offset of the dataset
+ *  @param[in]		size				size of the dataset
+ *  @param[in]		kind				publish, subscribe or request
+ *
+ *	@retval			TRDP_NO_ERR
+ *	@retval			TRDP_PARAM_ERR		slot exceeds the Traffic Store
+ *	@retval			TRDP_MEM_ERR		layout table full
+ */
+TRDP_ERR_T tau_addTrafficStoreLayout (
+	UINT32 comId,
+	UINT32 offset,
+	UINT32 size,
+	TRAFFIC_STORE_SLOT_KIND_T kind);
+
 /******************************************************************************/
 /** Finalize TRDP Ladder Support
  *  Delete Traffic Store mutex, Traffic Store.
@@ -131,6 +287,8 @@ TRDP_ERR_T  tau_getNetworkContext (
 
 /**********************************************************************************************************************/
 /** Get Traffic Store accessibility.
+ *  Locks the whole Traffic Store against tau_readTrafficStore() readers and other lock holders,
+ *  single telegrams should be accessed by tau_writeTrafficStore() / tau_readTrafficStore().
  *
  *  @retval         TRDP_NO_ERR			no error
  *  @retval         TRDP_PARAM_ERR		parameter error
@@ -153,6 +311,177 @@ TRDP_ERR_T  tau_lockTrafficStore (
 TRDP_ERR_T  tau_unlockTrafficStore (
     void);
 
+/**********************************************************************************************************************/
+/** Begin writing a telegram in the Traffic Store.
+ *  Writers of different telegrams do not block each other, readers of the telegram retry until the write has
+ *  ended. Must be paired with tau_endTrafficStoreWrite().
+ *
+ *  @param[in]      offset				Traffic Store offset of the telegram
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ */
+TRDP_ERR_T  tau_beginTrafficStoreWrite (
+    UINT32 offset);
+
+/**********************************************************************************************************************/
+/** End writing a telegram in the Traffic Store.
+ *
+ *  @param[in]      offset				Traffic Store offset of the telegram
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ */
+TRDP_ERR_T  tau_endTrafficStoreWrite (
+    UINT32 offset);
+
+/**********************************************************************************************************************/
+/** Write a telegram into the Traffic Store.
+ *
+ *  @param[in]      offset				Traffic Store offset of the telegram
+ *  @param[in]      pData				pointer to the telegram data
+ *  @param[in]      size				size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ */
+TRDP_ERR_T  tau_writeTrafficStore (
+    UINT32 offset,
+    const UINT8 *pData,
+    UINT32 size);
+
+/**********************************************************************************************************************/
+/** Read a consistent copy of a telegram from the Traffic Store.
+ *  The reader never takes a lock unless a telegram is rewritten TRAFFIC_STORE_READ_RETRY times during the copy.
+ *
+ *  @param[in]      offset				Traffic Store offset of the telegram
+ *  @param[out]     pData				pointer to the buffer receiving the telegram
+ *  @param[in]      size				size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ */
+TRDP_ERR_T  tau_readTrafficStore (
+    UINT32 offset,
+    UINT8 *pData,
+    UINT32 size);
+
+/**********************************************************************************************************************/
+/** Wait for a telegram write to the Traffic Store.
+ *  Returns at once if any telegram was written since *pNotifySeq was taken, else sleeps until the next write.
+ *  Start with *pNotifySeq = 0 to return at once. Sleeping uses a shared futex on Linux, readers in several
+ *  processes may wait; writers only enter the kernel if a reader is waiting.
+ *
+ *  @param[in,out]  pNotifySeq			last notification sequence seen, updated on return
+ *  @param[in]      timeout				timeout in us, TRAFFIC_STORE_WAIT_FOREVER: no timeout
+ *
+ *  @retval         TRDP_NO_ERR			a telegram was written
+ *  @retval         TRDP_TIMEOUT_ERR	no telegram written within timeout
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not initialised or attached
+ */
+TRDP_ERR_T  tau_waitTrafficStore (
+    UINT32 *pNotifySeq,
+    UINT32 timeout);
+
+/**********************************************************************************************************************/
+/** Subscribe a telegram through the PD broker.
+ *  For client processes attached by tau_ladder_attach(): instead of opening a session of its own, the client asks
+ *  the TRDP process (the broker) to subscribe the telegram. The broker writes received telegrams to a Traffic Store
+ *  area of the client subscription, every client process reads them from there by tau_getBrokerTelegram().
+ *  Waits up to TRAFFIC_STORE_BROKER_WAIT for the broker.
+ *
+ *  @param[out]     pSubHandle			returned subscription handle
+ *  @param[in]      comId				ComId to subscribe
+ *  @param[in]      srcIpAddr			source IP filter, 0: any
+ *  @param[in]      destIpAddr			multicast group to join or 0
+ *  @param[in]      size				max. size of the dataset
+ *  @param[in]      timeout				receive timeout in us, 0: session default
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not initialised or attached
+ *  @retval         TRDP_MEM_ERR		no free subscription entry or Traffic Store area
+ *  @retval         TRDP_TIMEOUT_ERR	broker did not answer
+ */
+TRDP_ERR_T  tau_subscribeBrokerTelegram (
+    UINT32          *pSubHandle,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  destIpAddr,
+    UINT32          size,
+    UINT32          timeout);
+
+/**********************************************************************************************************************/
+/** Unsubscribe a telegram subscribed through the PD broker.
+ *
+ *  @param[in]      subHandle			subscription handle
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOSUB_ERR		not subscribed
+ */
+TRDP_ERR_T  tau_unsubscribeBrokerTelegram (
+    UINT32          subHandle);
+
+/**********************************************************************************************************************/
+/** Get the last telegram received for a broker subscription, like tlp_get().
+ *
+ *  @param[in]      subHandle			subscription handle
+ *  @param[out]     pData				pointer to the buffer receiving the telegram
+ *  @param[in,out]  pDataSize			size of the buffer, on return size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOSUB_ERR		not subscribed
+ *  @retval         TRDP_NODATA_ERR	nothing received yet
+ *  @retval         TRDP_TIMEOUT_ERR	telegram timed out, pData holds the last value
+ */
+TRDP_ERR_T  tau_getBrokerTelegram (
+    UINT32          subHandle,
+    UINT8           *pData,
+    UINT32          *pDataSize);
+
+/**********************************************************************************************************************/
+/** Serve the requests of broker clients.
+ *  Called cyclically by the broker, returns at once if no client request is pending.
+ *
+ *  @param[in]      pfServe				subscribes or unsubscribes a client entry
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not initialised
+ */
+TRDP_ERR_T  tau_serveTrafficStoreBroker (
+    TRAFFIC_STORE_BROKER_CB_T pfServe);
+
+/**********************************************************************************************************************/
+/** Record the reception state of a broker subscription.
+ *
+ *  @param[in]      index				broker entry index
+ *  @param[in]      status				TRDP_NO_ERR on reception, TRDP_TIMEOUT_ERR on timeout
+ */
+void  tau_setBrokerTelegramStatus (
+    UINT32          index,
+    TRDP_ERR_T      status);
+
+/**********************************************************************************************************************/
+/** Open the link state watcher
+ *  Linux only: subscribes to the netlink link events, tau_checkLinkUpDown() then answers without system calls.
+ *
+ *  @retval         descriptor          becomes readable on link changes, call tau_processLinkEvents() then
+ *  @retval         -1                  not supported, tau_checkLinkUpDown() polls the interface
+ */
+INT32  tau_openLinkWatch (void);
+
+/**********************************************************************************************************************/
+/** Process pending link events
+ *
+ *  @param[out]     pChanged            TRUE if the link state of a subnet changed
+ *
+ *  @retval         TRDP_NO_ERR				no error
+ *  @retval         TRDP_NOINIT_ERR			link watcher not opened
+ */
+TRDP_ERR_T  tau_processLinkEvents (
+    BOOL8 *pChanged);
+
 /**********************************************************************************************************************/
 /** Check Link up/down
  *
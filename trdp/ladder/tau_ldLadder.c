@@ -33,6 +33,7 @@
 #include <net/if.h>
 #endif
 #include <unistd.h>
+#include <fcntl.h>
 
 #include "trdp_utils.h"
 #include "trdp_if.h"
@@ -88,8 +89,178 @@ TRDP_URI_HOST_T         IP_ADDRESS_ZERO = {"0.0.0.0"};  /* IP Address 0.0.0.0 */
 const TRDP_DEST_T       defaultDestination = {0};       /* Destination Parameter (id, SDT, URI) */
 static INT32 ts_buffer[2048/sizeof(INT32)];
 
+/* Wakes TAULpdMainThread from select(), written by tau_ldWakeUpPdMainThread() */
+static int taulWakeUpPipe[2] = {-1, -1};
+static UINT32 taulWakeUpPending = 0;
+
 /**********************************************************************************************************************/
 /** TAUL Local Function */
+
+/* Telegram Lists are hashed by comId, search walks one bucket only */
+#define TAUL_TELEGRAM_HASH(comId)   (((comId) ^ ((comId) >> 6) ^ ((comId) >> 12)) & (TAUL_TELEGRAM_HASH_SIZE - 1))
+
+static PUBLISH_TELEGRAM_T *apPublishTelegramHash[TAUL_TELEGRAM_HASH_SIZE];
+static SUBSCRIBE_TELEGRAM_T *apSubscribeTelegramHash[TAUL_TELEGRAM_HASH_SIZE];
+static PD_REQUEST_TELEGRAM_T *apPdRequestTelegramHash[TAUL_TELEGRAM_HASH_SIZE];
+
+/* Subscriptions of broker clients, per broker entry and interface */
+static SUBSCRIBE_TELEGRAM_T *apBrokerSubscribeTelegram[TRAFFIC_STORE_BROKER_MAX][LADDER_IF_NUMBER];
+static TRDP_PD_PAR_T aBrokerPdParameter[TRAFFIC_STORE_BROKER_MAX];
+
+/* Publishers and subscribers of one configureTelegrams() call, handed to the stack in one batch each */
+typedef struct
+{
+    UINT32                  numPub;
+    UINT32                  numSub;
+    TRDP_PUB_ENTRY_T        *pPubEntry;
+    TRDP_SUB_ENTRY_T        *pSubEntry;
+    PUBLISH_TELEGRAM_T      **ppPubTelegram;
+    SUBSCRIBE_TELEGRAM_T    **ppSubTelegram;
+} TELEGRAM_BATCH_T;
+
+/* Set while configureTelegrams() collects, NULL: publishTelegram()/subscribeTelegram() call the stack directly */
+static TELEGRAM_BATCH_T *pTelegramBatch = NULL;
+
+static TRDP_ERR_T finishPublishTelegram (PUBLISH_TELEGRAM_T *, TRDP_ERR_T);
+static TRDP_ERR_T finishSubscribeTelegram (SUBSCRIBE_TELEGRAM_T *, TRDP_ERR_T);
+
+/**********************************************************************************************************************/
+/** Append a Publish Telegram at the end of its comId hash bucket, called with the list mutex held
+ *
+ *  @param[in]      pNewPublishTelegram            pointer to Publish Telegram to append
+ */
+static void insertPublishTelegramHash (
+        PUBLISH_TELEGRAM_T    *pNewPublishTelegram)
+{
+    PUBLISH_TELEGRAM_T **ppIter = &apPublishTelegramHash[TAUL_TELEGRAM_HASH(pNewPublishTelegram->comId)];
+
+    while (*ppIter != NULL)
+    {
+        ppIter = &(*ppIter)->pNextHashPublishTelegram;
+    }
+    pNewPublishTelegram->pNextHashPublishTelegram = NULL;
+    *ppIter = pNewPublishTelegram;
+}
+
+/**********************************************************************************************************************/
+/** Remove a Publish Telegram from its comId hash bucket, called with the list mutex held
+ *
+ *  @param[in]      pDeletePublishTelegram         pointer to Publish Telegram to remove
+ */
+static void removePublishTelegramHash (
+        PUBLISH_TELEGRAM_T    *pDeletePublishTelegram)
+{
+    PUBLISH_TELEGRAM_T **ppIter = &apPublishTelegramHash[TAUL_TELEGRAM_HASH(pDeletePublishTelegram->comId)];
+
+    while (*ppIter != NULL)
+    {
+        if (*ppIter == pDeletePublishTelegram)
+        {
+            *ppIter = pDeletePublishTelegram->pNextHashPublishTelegram;
+            break;
+        }
+        ppIter = &(*ppIter)->pNextHashPublishTelegram;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Append a Subscribe Telegram at the end of its comId hash bucket, called with the list mutex held
+ *
+ *  @param[in]      pNewSubscribeTelegram            pointer to Subscribe Telegram to append
+ */
+static void insertSubscribeTelegramHash (
+        SUBSCRIBE_TELEGRAM_T    *pNewSubscribeTelegram)
+{
+    SUBSCRIBE_TELEGRAM_T **ppIter = &apSubscribeTelegramHash[TAUL_TELEGRAM_HASH(pNewSubscribeTelegram->comId)];
+
+    while (*ppIter != NULL)
+    {
+        ppIter = &(*ppIter)->pNextHashSubscribeTelegram;
+    }
+    pNewSubscribeTelegram->pNextHashSubscribeTelegram = NULL;
+    *ppIter = pNewSubscribeTelegram;
+}
+
+/**********************************************************************************************************************/
+/** Remove a Subscribe Telegram from its comId hash bucket, called with the list mutex held
+ *
+ *  @param[in]      pDeleteSubscribeTelegram         pointer to Subscribe Telegram to remove
+ */
+static void removeSubscribeTelegramHash (
+        SUBSCRIBE_TELEGRAM_T    *pDeleteSubscribeTelegram)
+{
+    SUBSCRIBE_TELEGRAM_T **ppIter = &apSubscribeTelegramHash[TAUL_TELEGRAM_HASH(pDeleteSubscribeTelegram->comId)];
+
+    while (*ppIter != NULL)
+    {
+        if (*ppIter == pDeleteSubscribeTelegram)
+        {
+            *ppIter = pDeleteSubscribeTelegram->pNextHashSubscribeTelegram;
+            break;
+        }
+        ppIter = &(*ppIter)->pNextHashSubscribeTelegram;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Append a PD Request Telegram at the end of its comId hash bucket, called with the list mutex held
+ *
+ *  @param[in]      pNewPdRequestTelegram            pointer to PD Request Telegram to append
+ */
+static void insertPdRequestTelegramHash (
+        PD_REQUEST_TELEGRAM_T    *pNewPdRequestTelegram)
+{
+    PD_REQUEST_TELEGRAM_T **ppIter = &apPdRequestTelegramHash[TAUL_TELEGRAM_HASH(pNewPdRequestTelegram->comId)];
+
+    while (*ppIter != NULL)
+    {
+        ppIter = &(*ppIter)->pNextHashPdRequestTelegram;
+    }
+    pNewPdRequestTelegram->pNextHashPdRequestTelegram = NULL;
+    *ppIter = pNewPdRequestTelegram;
+}
+
+/**********************************************************************************************************************/
+/** Remove a PD Request Telegram from its comId hash bucket, called with the list mutex held
+ *
+ *  @param[in]      pDeletePdRequestTelegram         pointer to PD Request Telegram to remove
+ */
+static void removePdRequestTelegramHash (
+        PD_REQUEST_TELEGRAM_T    *pDeletePdRequestTelegram)
+{
+    PD_REQUEST_TELEGRAM_T **ppIter = &apPdRequestTelegramHash[TAUL_TELEGRAM_HASH(pDeletePdRequestTelegram->comId)];
+
+    while (*ppIter != NULL)
+    {
+        if (*ppIter == pDeletePdRequestTelegram)
+        {
+            *ppIter = pDeletePdRequestTelegram->pNextHashPdRequestTelegram;
+            break;
+        }
+        ppIter = &(*ppIter)->pNextHashPdRequestTelegram;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Copy a publish dataset from the Traffic Store into ts_buffer
+ *
+ *  @param[in]      offset              Traffic Store offset of the dataset
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ */
+static TRDP_ERR_T tau_ldReadPublishDataset (
+    UINT32 offset)
+{
+    UINT32 size = sizeof(ts_buffer);
+
+    /* Stay inside the Traffic Store for datasets at its end */
+    if ((offset <= trafficStoreSize) && (size > trafficStoreSize - offset))
+    {
+        size = trafficStoreSize - offset;
+    }
+    return tau_readTrafficStore(offset, (UINT8 *)ts_buffer, size);
+}
+
 /**********************************************************************************************************************/
 /** Append an Publish Telegram at end of List
  *
@@ -157,6 +328,7 @@ TRDP_ERR_T appendPublishTelegramList (
     if (*ppHeadPublishTelegram == NULL)
     {
         *ppHeadPublishTelegram = pNewPublishTelegram;
+        insertPublishTelegramHash(pNewPublishTelegram);
         /* UnLock Publish Telegram by Mutex */
         vos_mutexUnlock(pPublishTelegramMutex);
         return TRDP_NO_ERR;
@@ -169,6 +341,7 @@ TRDP_ERR_T appendPublishTelegramList (
         ;
     }
     iterPublishTelegram->pNextPublishTelegram = pNewPublishTelegram;
+    insertPublishTelegramHash(pNewPublishTelegram);
     /* UnLock Publish Telegram by Mutex */
     vos_mutexUnlock(pPublishTelegramMutex);
     return TRDP_NO_ERR;
@@ -218,6 +391,7 @@ TRDP_ERR_T deletePublishTelegramList (
     if (pDeletePublishTelegram == *ppHeadPublishTelegram)
     {
         *ppHeadPublishTelegram = pDeletePublishTelegram->pNextPublishTelegram;
+        removePublishTelegramHash(pDeletePublishTelegram);
         vos_memFree(pDeletePublishTelegram);
         pDeletePublishTelegram = NULL;
         /* UnLock Publish Telegram by Mutex */
@@ -232,6 +406,7 @@ TRDP_ERR_T deletePublishTelegramList (
         if (iterPublishTelegram->pNextPublishTelegram == pDeletePublishTelegram)
         {
             iterPublishTelegram->pNextPublishTelegram = pDeletePublishTelegram->pNextPublishTelegram;
+            removePublishTelegramHash(pDeletePublishTelegram);
             vos_memFree(pDeletePublishTelegram);
             pDeletePublishTelegram = NULL;
             break;
@@ -289,9 +464,9 @@ PUBLISH_TELEGRAM_T *searchPublishTelegramList (
     }
 
     /* Check PublishTelegram List Loop */
-    for (iterPublishTelegram = pHeadPublishTelegram;
+    for (iterPublishTelegram = apPublishTelegramHash[TAUL_TELEGRAM_HASH(comId)];
             iterPublishTelegram != NULL;
-            iterPublishTelegram = iterPublishTelegram->pNextPublishTelegram)
+            iterPublishTelegram = iterPublishTelegram->pNextHashPublishTelegram)
     {
         /* Publish Telegram: We match if src/dst address is zero or matches, and comId */
         if ((iterPublishTelegram->comId == comId)
@@ -379,6 +554,7 @@ TRDP_ERR_T appendSubscribeTelegramList (
     if (*ppHeadSubscribeTelegram == NULL)
     {
         *ppHeadSubscribeTelegram = pNewSubscribeTelegram;
+        insertSubscribeTelegramHash(pNewSubscribeTelegram);
         /* UnLock Subscribe Telegram by Mutex */
         vos_mutexUnlock(pSubscribeTelegramMutex);
         return TRDP_NO_ERR;
@@ -391,6 +567,7 @@ TRDP_ERR_T appendSubscribeTelegramList (
         ;
     }
     iterSubscribeTelegram->pNextSubscribeTelegram = pNewSubscribeTelegram;
+    insertSubscribeTelegramHash(pNewSubscribeTelegram);
     /* UnLock Subscribe Telegram by Mutex */
     vos_mutexUnlock(pSubscribeTelegramMutex);
     return TRDP_NO_ERR;
@@ -436,10 +613,17 @@ TRDP_ERR_T deleteSubscribeTelegramList (
         }
     }
 
+    /* The peer on the other subnet no longer suppresses duplicates */
+    if (pDeleteSubscribeTelegram->pPeerSubscribeTelegram != NULL)
+    {
+        pDeleteSubscribeTelegram->pPeerSubscribeTelegram->pPeerSubscribeTelegram = NULL;
+    }
+
     /* handle removal of first element */
     if (pDeleteSubscribeTelegram == *ppHeadSubscribeTelegram)
     {
         *ppHeadSubscribeTelegram = pDeleteSubscribeTelegram->pNextSubscribeTelegram;
+        removeSubscribeTelegramHash(pDeleteSubscribeTelegram);
         vos_memFree(pDeleteSubscribeTelegram);
         pDeleteSubscribeTelegram = NULL;
         /* UnLock Subscribe Telegram by Mutex */
@@ -454,6 +638,7 @@ TRDP_ERR_T deleteSubscribeTelegramList (
         if (iterSubscribeTelegram->pNextSubscribeTelegram == pDeleteSubscribeTelegram)
         {
             iterSubscribeTelegram->pNextSubscribeTelegram = pDeleteSubscribeTelegram->pNextSubscribeTelegram;
+            removeSubscribeTelegramHash(pDeleteSubscribeTelegram);
             vos_memFree(pDeleteSubscribeTelegram);
             pDeleteSubscribeTelegram = NULL;
             break;
@@ -464,6 +649,37 @@ TRDP_ERR_T deleteSubscribeTelegramList (
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Link a Subscribe Telegram with the same telegram subscribed on the other subnet
+ *
+ *  The copies of a telegram received on both subnets share their sequence counter, the second copy is dropped
+ *  in tau_ldRecvPdDs() before it is written to the Traffic Store.
+ *
+ *  @param[in]      pNewSubscribeTelegram           pointer to the new Subscribe Telegram
+ *
+ */
+static void linkPeerSubscribeTelegram (
+        SUBSCRIBE_TELEGRAM_T    *pNewSubscribeTelegram)
+{
+    SUBSCRIBE_TELEGRAM_T *iterSubscribeTelegram;
+
+    for (iterSubscribeTelegram = apSubscribeTelegramHash[TAUL_TELEGRAM_HASH(pNewSubscribeTelegram->comId)];
+            iterSubscribeTelegram != NULL;
+            iterSubscribeTelegram = iterSubscribeTelegram->pNextHashSubscribeTelegram)
+    {
+        if ((iterSubscribeTelegram != pNewSubscribeTelegram)
+            && (iterSubscribeTelegram->appHandle != pNewSubscribeTelegram->appHandle)
+            && (iterSubscribeTelegram->pPeerSubscribeTelegram == NULL)
+            && (iterSubscribeTelegram->comId == pNewSubscribeTelegram->comId)
+            && (iterSubscribeTelegram->pPdParameter->offset == pNewSubscribeTelegram->pPdParameter->offset))
+        {
+            iterSubscribeTelegram->pPeerSubscribeTelegram = pNewSubscribeTelegram;
+            pNewSubscribeTelegram->pPeerSubscribeTelegram = iterSubscribeTelegram;
+            return;
+        }
+    }
+}
+
 /**********************************************************************************************************************/
 /** Return the SubscribeTelegram with same comId and IP addresses
  *
@@ -509,9 +725,9 @@ SUBSCRIBE_TELEGRAM_T *searchSubscribeTelegramList (
         }
     }
     /* Check Subscribe Telegram List Loop */
-    for (iterSubscribeTelegram = pHeadSubscribeTelegram;
+    for (iterSubscribeTelegram = apSubscribeTelegramHash[TAUL_TELEGRAM_HASH(comId)];
             iterSubscribeTelegram != NULL;
-            iterSubscribeTelegram = iterSubscribeTelegram->pNextSubscribeTelegram)
+            iterSubscribeTelegram = iterSubscribeTelegram->pNextHashSubscribeTelegram)
     {
         /* Subscribe Telegram: We match if src/dst address is zero or matches, and comId */
         if ((iterSubscribeTelegram->comId == comId)
@@ -644,6 +860,7 @@ TRDP_ERR_T appendPdRequestTelegramList (
     if (*ppHeadPdRequestTelegram == NULL)
     {
         *ppHeadPdRequestTelegram = pNewPdRequestTelegram;
+        insertPdRequestTelegramHash(pNewPdRequestTelegram);
         /* UnLock PD Request Telegram by Mutex */
         vos_mutexUnlock(pPdRequestTelegramMutex);
         return TRDP_NO_ERR;
@@ -656,6 +873,7 @@ TRDP_ERR_T appendPdRequestTelegramList (
         ;
     }
     iterPdRequestTelegram->pNextPdRequestTelegram = pNewPdRequestTelegram;
+    insertPdRequestTelegramHash(pNewPdRequestTelegram);
     /* UnLock PD Request Telegram by Mutex */
     vos_mutexUnlock(pPdRequestTelegramMutex);
     return TRDP_NO_ERR;
@@ -705,6 +923,7 @@ TRDP_ERR_T deletePdRequestTelegramList (
     if (pDeletePdRequestTelegram == *ppHeadPdRequestTelegram)
     {
         *ppHeadPdRequestTelegram = pDeletePdRequestTelegram->pNextPdRequestTelegram;
+        removePdRequestTelegramHash(pDeletePdRequestTelegram);
         vos_memFree(pDeletePdRequestTelegram);
         pDeletePdRequestTelegram = NULL;
         /* UnLock PD Request Telegram by Mutex */
@@ -719,6 +938,7 @@ TRDP_ERR_T deletePdRequestTelegramList (
         if (iterPdRequestTelegram->pNextPdRequestTelegram == pDeletePdRequestTelegram)
         {
             iterPdRequestTelegram->pNextPdRequestTelegram = pDeletePdRequestTelegram->pNextPdRequestTelegram;
+            removePdRequestTelegramHash(pDeletePdRequestTelegram);
             vos_memFree(pDeletePdRequestTelegram);
             pDeletePdRequestTelegram = NULL;
             break;
@@ -778,9 +998,9 @@ PD_REQUEST_TELEGRAM_T *searchPdRequestTelegramList (
         }
     }
     /* Check PD Request Telegram List Loop */
-    for (iterPdRequestTelegram = pHeadPdRequestTelegram;
+    for (iterPdRequestTelegram = apPdRequestTelegramHash[TAUL_TELEGRAM_HASH(comId)];
             iterPdRequestTelegram != NULL;
-            iterPdRequestTelegram = iterPdRequestTelegram->pNextPdRequestTelegram)
+            iterPdRequestTelegram = iterPdRequestTelegram->pNextHashPdRequestTelegram)
     {
         /* PD Request Telegram: We match if src/dst address is zero or matches, and comId */
         if ((iterPdRequestTelegram->comId == comId)
@@ -1056,10 +1276,69 @@ TRDP_ERR_T setConfigParameterFromInternalConfig (
 }
 #endif /* #ifndef XML_CONFIG_ENABLE */
 
+/******************************************************************************/
+/** Hand the collected publishers and subscribers of one interface to the stack.
+ *  Each list goes in with one session lock, so the send schedule is rebuilt once and a
+ *  multicast group is joined once per socket instead of once per telegram.
+ *
+ *  @param[in]      ifIndex             interface Index
+ *  @param[in]      pBatch              collected telegrams
+ *
+ *  @retval         TRDP_NO_ERR         all telegrams are in their lists
+ *  @retval         other               error of the first telegram that failed
+ */
+static TRDP_ERR_T flushTelegramBatch (
+        UINT32              ifIndex,
+        TELEGRAM_BATCH_T    *pBatch)
+{
+    TRDP_APP_SESSION_T  sessionHandle = arraySessionConfigTAUL[ifIndex].sessionHandle;
+    TRDP_ERR_T          result = TRDP_NO_ERR;
+    TRDP_ERR_T          err;
+    UINT32              i;
+
+    if (pBatch->numPub > 0)
+    {
+        err = tlp_publishBatch(sessionHandle, pBatch->pPubEntry, pBatch->numPub);
+        for (i = 0; i < pBatch->numPub; i++)
+        {
+            /* A batch refused as a whole leaves no result in the entries */
+            if ((err == TRDP_PARAM_ERR) || (err == TRDP_NOINIT_ERR))
+            {
+                pBatch->pPubEntry[i].result = err;
+            }
+            pBatch->ppPubTelegram[i]->pubHandle = pBatch->pPubEntry[i].pubHandle;
+            err = finishPublishTelegram(pBatch->ppPubTelegram[i], pBatch->pPubEntry[i].result);
+            if ((err != TRDP_NO_ERR) && (result == TRDP_NO_ERR))
+            {
+                result = err;
+            }
+        }
+    }
+    if (pBatch->numSub > 0)
+    {
+        err = tlp_subscribeBatch(sessionHandle, pBatch->pSubEntry, pBatch->numSub);
+        for (i = 0; i < pBatch->numSub; i++)
+        {
+            if ((err == TRDP_PARAM_ERR) || (err == TRDP_NOINIT_ERR))
+            {
+                pBatch->pSubEntry[i].result = err;
+            }
+            pBatch->ppSubTelegram[i]->subHandle = pBatch->pSubEntry[i].subHandle;
+            err = finishSubscribeTelegram(pBatch->ppSubTelegram[i], pBatch->pSubEntry[i].result);
+            if ((err != TRDP_NO_ERR) && (result == TRDP_NO_ERR))
+            {
+                result = err;
+            }
+        }
+    }
+    return result;
+}
+
 /******************************************************************************/
 /** PD/MD Telegrams configured for one interface.
  * PD: Publisher, Subscriber, Requester
  * MD: Caller, Replier
+ * Publishers and subscribers are collected first and handed to the stack in one batch each.
  *
  *  @param[in]      ifIndex             interface Index
  *  @param[in]      numExchgPar         Number of Exchange Parameter
@@ -1075,10 +1354,33 @@ TRDP_ERR_T configureTelegrams (
         TRDP_EXCHG_PAR_T    *pExchgPar)
 {
     UINT32  telegramIndex = 0;
+    UINT32  numSrc = 0;
     TRDP_ERR_T  err = TRDP_NO_ERR;
+    TELEGRAM_BATCH_T    batch;
 
-    /* Get Telegram */
+    /* Room for one publisher per telegram and one subscriber per source */
     for (telegramIndex = 0; telegramIndex < numExchgPar; telegramIndex++)
+    {
+        numSrc += pExchgPar[telegramIndex].srcCnt;
+    }
+    memset(&batch, 0, sizeof(batch));
+    batch.pPubEntry = (TRDP_PUB_ENTRY_T *)vos_memAlloc((numExchgPar + 1) * sizeof(TRDP_PUB_ENTRY_T));
+    batch.ppPubTelegram = (PUBLISH_TELEGRAM_T **)vos_memAlloc((numExchgPar + 1) * sizeof(PUBLISH_TELEGRAM_T *));
+    batch.pSubEntry = (TRDP_SUB_ENTRY_T *)vos_memAlloc((numSrc + 1) * sizeof(TRDP_SUB_ENTRY_T));
+    batch.ppSubTelegram = (SUBSCRIBE_TELEGRAM_T **)vos_memAlloc((numSrc + 1) * sizeof(SUBSCRIBE_TELEGRAM_T *));
+    if ((batch.pPubEntry == NULL) || (batch.ppPubTelegram == NULL)
+        || (batch.pSubEntry == NULL) || (batch.ppSubTelegram == NULL))
+    {
+        vos_printLog(VOS_LOG_ERROR, "configureTelegrams() failed. Telegram batch vos_memAlloc() Err\n");
+        err = TRDP_MEM_ERR;
+    }
+    else
+    {
+        pTelegramBatch = &batch;
+    }
+
+    /* Get Telegram */
+    for (telegramIndex = 0; (err == TRDP_NO_ERR) && (telegramIndex < numExchgPar); telegramIndex++)
     {
         /* PD Telegram */
         if (pExchgPar[telegramIndex].pPdPar != NULL)
@@ -1091,12 +1393,8 @@ TRDP_ERR_T configureTelegrams (
                 if (err != TRDP_NO_ERR)
                 {
                     vos_printLog(VOS_LOG_ERROR, "configureTelegrams() failed. publishTelegram() error\n");
-                    return err;
-                }
-                else
-                {
-                    continue;
                 }
+                continue;
             }
             /* Subscriber */
             if ((pExchgPar[telegramIndex].destCnt > 0)
@@ -1107,12 +1405,8 @@ TRDP_ERR_T configureTelegrams (
                 if (err != TRDP_NO_ERR)
                 {
                     vos_printLog(VOS_LOG_ERROR, "configureTelegrams() failed. subscribeTelegram() error\n");
-                    return err;
-                }
-                else
-                {
-                    continue;
                 }
+                continue;
             }
             /* PD Requester */
             if ((pExchgPar[telegramIndex].destCnt > 0)
@@ -1123,16 +1417,48 @@ TRDP_ERR_T configureTelegrams (
                 if (err != TRDP_NO_ERR)
                 {
                     vos_printLog(VOS_LOG_ERROR, "configureTelegrams() failed. pdRequestTelegram() error\n");
-                    return err;
-                }
-                else
-                {
-                    continue;
                 }
+                continue;
             }
         }
     }
-    return TRDP_NO_ERR;
+    pTelegramBatch = NULL;
+
+    if (err == TRDP_NO_ERR)
+    {
+        err = flushTelegramBatch(ifIndex, &batch);
+    }
+    else
+    {
+        /* Drop the telegrams not handed to the stack yet */
+        for (telegramIndex = 0; telegramIndex < batch.numPub; telegramIndex++)
+        {
+            vos_memFree(batch.ppPubTelegram[telegramIndex]->dataset.pDatasetStartAddr);
+            vos_memFree(batch.ppPubTelegram[telegramIndex]);
+        }
+        for (telegramIndex = 0; telegramIndex < batch.numSub; telegramIndex++)
+        {
+            vos_memFree(batch.ppSubTelegram[telegramIndex]->dataset.pDatasetStartAddr);
+            vos_memFree(batch.ppSubTelegram[telegramIndex]);
+        }
+    }
+    if (batch.pPubEntry != NULL)
+    {
+        vos_memFree(batch.pPubEntry);
+    }
+    if (batch.ppPubTelegram != NULL)
+    {
+        vos_memFree(batch.ppPubTelegram);
+    }
+    if (batch.pSubEntry != NULL)
+    {
+        vos_memFree(batch.pSubEntry);
+    }
+    if (batch.ppSubTelegram != NULL)
+    {
+        vos_memFree(batch.ppSubTelegram);
+    }
+    return err;
 }
 
 /******************************************************************************/
@@ -1188,6 +1514,7 @@ TRDP_ERR_T sizeWriteDatasetInTrafficStore (
             marshallConfig.pRefCon,
             pDataset->id,
             pTempSrcDataset,
+            TRDP_MAX_MD_DATA_SIZE,
             &datasetNetworkByteSize,
             &pDataset);
     if (err != TRDP_NO_ERR)
@@ -1208,6 +1535,7 @@ TRDP_ERR_T sizeWriteDatasetInTrafficStore (
                 &marshallConfig.pRefCon,            /* pointer to user context */
                 pDataset->id,                       /* datasetId */
                 pTempSrcDataset,                    /* source pointer to received original message */
+                datasetNetworkByteSize,             /* source size */
                 pTempDestDataset,                   /* destination pointer to a buffer for the treated message */
                 pDatasetSize,                       /* destination Buffer Size */
                 &pDataset);                     /* pointer to pointer of cached dataset */
@@ -1223,8 +1551,85 @@ TRDP_ERR_T sizeWriteDatasetInTrafficStore (
     return TRDP_NO_ERR;
 }
 
+/******************************************************************************/
+/** Complete a Publish Telegram once the stack has published it, or drop it on error.
+ *
+ *  @param[in]      pPublishTelegram    Pointer to the Publish Telegram
+ *  @param[in]      err                 result of tlp_publish() for this telegram
+ *
+ *  @retval         TRDP_NO_ERR         telegram is in the Publish Telegram List
+ *  @retval         other               telegram and its dataset are freed
+ */
+static TRDP_ERR_T finishPublishTelegram (
+        PUBLISH_TELEGRAM_T  *pPublishTelegram,
+        TRDP_ERR_T          err)
+{
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "publishTelegram() Failed. Publish Telegram tlp_publish() Err:%d\n", err);
+    }
+    else
+    {
+        /* Append Publish Telegram */
+        err = appendPublishTelegramList(&pHeadPublishTelegram, pPublishTelegram);
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "publishTelegram() Failed. Publish Telegram appendPublishTelegramList() Err:%d\n", err);
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        /* Free Publish Dataset */
+        vos_memFree(pPublishTelegram->dataset.pDatasetStartAddr);
+        /* Free Publish Telegram */
+        vos_memFree(pPublishTelegram);
+    }
+    return err;
+}
+
+/******************************************************************************/
+/** Complete a Subscribe Telegram once the stack has subscribed it, or drop it on error.
+ *
+ *  @param[in]      pSubscribeTelegram  Pointer to the Subscribe Telegram
+ *  @param[in]      err                 result of tlp_subscribe() for this telegram
+ *
+ *  @retval         TRDP_NO_ERR         telegram is in the Subscribe Telegram List
+ *  @retval         other               telegram and its dataset are freed
+ */
+static TRDP_ERR_T finishSubscribeTelegram (
+        SUBSCRIBE_TELEGRAM_T    *pSubscribeTelegram,
+        TRDP_ERR_T              err)
+{
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "subscribeTelegram() Failed. Subscribe Telegram tlp_subscribe() Err:%d\n", err);
+    }
+    else
+    {
+        /* Append Subscribe Telegram */
+        err = appendSubscribeTelegramList(&pHeadSubscribeTelegram, pSubscribeTelegram);
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "subscribeTelegram() Failed. Subscribe Telegram appendSubscribeTelegramList() Err:%d\n", err);
+        }
+        else
+        {
+            linkPeerSubscribeTelegram(pSubscribeTelegram);
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        /* Free Subscribe Dataset */
+        vos_memFree(pSubscribeTelegram->dataset.pDatasetStartAddr);
+        /* Free Subscribe Telegram */
+        vos_memFree(pSubscribeTelegram);
+    }
+    return err;
+}
+
 /******************************************************************************/
 /** Publisher Telegrams configured for one interface.
+ *  While configureTelegrams() collects a batch the telegram is only queued for tlp_publishBatch().
  *
  *  @param[in]      ifIndex             interface Index
  *  @param[in]      pExchgPar           Pointer to Exchange Parameter
@@ -1316,6 +1721,16 @@ TRDP_ERR_T publishTelegram (
             vos_memFree(pPublishTelegram);
             return TRDP_PARAM_ERR;
         }
+        /* Register the telegram slot in the Traffic Store layout */
+        err = tau_addTrafficStoreLayout(pExchgPar->comId, pExchgPar->pPdPar->offset,
+                                        pPublishTelegram->dataset.size, TRAFFIC_STORE_SLOT_PUBLISH);
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "publishTelegram() Failed. tau_addTrafficStoreLayout() returns error = %d\n", err);
+            /* Free Publish Telegram */
+            vos_memFree(pPublishTelegram);
+            return err;
+        }
         /* Create Dataset */
         pPublishDataset = (UINT32 *)vos_memAlloc(pPublishTelegram->dataset.size);
         if (pPublishDataset == NULL)
@@ -1342,6 +1757,7 @@ TRDP_ERR_T publishTelegram (
                     marshallConfig.pRefCon,
                     pExchgPar->datasetId,
                     (UINT8 *) pPublishDataset,
+                    pPublishTelegram->dataset.size,
                     &pPublishTelegram->datasetNetworkByteSize,
                     &pPublishTelegram->pDatasetDescriptor);
             if (err != TRDP_NO_ERR)
@@ -1434,10 +1850,34 @@ TRDP_ERR_T publishTelegram (
         /* Set send Parameter */
         pPublishTelegram->pSendParam = &arraySessionConfigTAUL[ifIndex].pdConfig.sendParam;
 
+        /* Collecting for tlp_publishBatch() ? */
+        if (pTelegramBatch != NULL)
+        {
+            TRDP_PUB_ENTRY_T *pEntry = &pTelegramBatch->pPubEntry[pTelegramBatch->numPub];
+
+            pEntry->pUserRef        = &pPublishTelegram->pPdParameter->offset;
+            pEntry->pfCbFunction    = NULL;
+            pEntry->comId           = pPublishTelegram->comId;
+            pEntry->etbTopoCnt      = pPublishTelegram->etbTopoCount;
+            pEntry->opTrnTopoCnt    = pPublishTelegram->opTrnTopoCount;
+            pEntry->srcIpAddr       = pPublishTelegram->srcIpAddr;
+            pEntry->destIpAddr      = pPublishTelegram->dstIpAddr;
+            pEntry->interval        = pPublishTelegram->pPdParameter->cycle;
+            pEntry->redId           = pPublishTelegram->pPdParameter->redundant;
+            pEntry->pktFlags        = pPublishTelegram->pPdParameter->flags;
+            pEntry->pSendParam      = pPublishTelegram->pSendParam;
+            pEntry->pData           = pPublishTelegram->dataset.pDatasetStartAddr;
+            pEntry->dataSize        = pPublishTelegram->datasetNetworkByteSize;
+            pTelegramBatch->ppPubTelegram[pTelegramBatch->numPub++] = pPublishTelegram;
+            return TRDP_NO_ERR;
+        }
+
         /* Publish */
         err = tlp_publish(
                 pPublishTelegram->appHandle,                                    /* our application identifier */
                 &pPublishTelegram->pubHandle,                                   /* our publish identifier */
+                &pPublishTelegram->pPdParameter->offset,                        /* user reference value = offset */
+                NULL,                                                           /* no callback */
                 pPublishTelegram->comId,                                        /* ComID to send */
                 pPublishTelegram->etbTopoCount,                                 /* ETB topocount to use, 0 if consist local communication */
                 pPublishTelegram->opTrnTopoCount,                               /* operational topocount, != 0 for orientation/direction sensitive communication */
@@ -1449,37 +1889,14 @@ TRDP_ERR_T publishTelegram (
                 pPublishTelegram->pSendParam,                                   /* send Paramter */
                 pPublishTelegram->dataset.pDatasetStartAddr,                    /* initial data */
                 pPublishTelegram->datasetNetworkByteSize);                      /* data size */
-        if (err != TRDP_NO_ERR)
-        {
-            /* Free Publish Dataset */
-            vos_memFree(pPublishDataset);
-            /* Free Publish Telegram */
-            vos_memFree(pPublishTelegram);
-            vos_printLog(VOS_LOG_ERROR, "publishTelegram() Failed. Publish Telegram tlp_publish() Err:%d\n", err);
-            return err;
-        }
-        else
-        {
-            /* Set user reference in pSndQueue */
-            pPublishTelegram->pubHandle->pUserRef = &pPublishTelegram->pPdParameter->offset;
-            /* Append Publish Telegram */
-            err = appendPublishTelegramList(&pHeadPublishTelegram, pPublishTelegram);
-            if (err != TRDP_NO_ERR)
-            {
-                /* Free Publish Dataset */
-                vos_memFree(pPublishDataset);
-                /* Free Publish Telegram */
-                vos_memFree(pPublishTelegram);
-                vos_printLog(VOS_LOG_ERROR, "publishTelegram() Failed. Publish Telegram appendPublishTelegramList() Err:%d\n", err);
-                return err;
-            }
-        }
+        err = finishPublishTelegram(pPublishTelegram, err);
     }
-    return TRDP_NO_ERR;
+    return err;
 }
 
 /******************************************************************************/
 /** Subscriber Telegrams configured for one interface.
+ *  While configureTelegrams() collects a batch the telegrams are only queued for tlp_subscribeBatch().
  *
  *  @param[in]      ifIndex             interface Index
  *  @param[in]      numExchgPar         Number of Exchange Parameter
@@ -1660,6 +2077,16 @@ TRDP_ERR_T subscribeTelegram (
                 vos_memFree(pSubscribeTelegram);
                 return TRDP_PARAM_ERR;
             }
+            /* Register the telegram slot in the Traffic Store layout */
+            err = tau_addTrafficStoreLayout(pExchgPar->comId, pExchgPar->pPdPar->offset,
+                                            pSubscribeTelegram->dataset.size, TRAFFIC_STORE_SLOT_SUBSCRIBE);
+            if (err != TRDP_NO_ERR)
+            {
+                vos_printLog(VOS_LOG_ERROR, "subscribeTelegram() Failed. tau_addTrafficStoreLayout() returns error = %d\n", err);
+                /* Free Subscribe Telegram */
+                vos_memFree(pSubscribeTelegram);
+                return err;
+            }
             /* Create Dataset */
             pSubscribeDataset = (UINT32 *)vos_memAlloc(pSubscribeTelegram->dataset.size);
             if (pSubscribeDataset == NULL)
@@ -1684,6 +2111,7 @@ TRDP_ERR_T subscribeTelegram (
                         marshallConfig.pRefCon,
                         pExchgPar->datasetId,
                         (UINT8 *) pSubscribeDataset,
+                        pSubscribeTelegram->dataset.size,
                         &pSubscribeTelegram->datasetNetworkByteSize,
                         &pSubscribeTelegram->pDatasetDescriptor);
                 if (err != TRDP_NO_ERR)
@@ -1743,6 +2171,25 @@ TRDP_ERR_T subscribeTelegram (
             }
             /* Set user reference */
             pSubscribeTelegram->pUserRef = (void *)pSubscribeTelegram;
+            /* Collecting for tlp_subscribeBatch() ? */
+            if (pTelegramBatch != NULL)
+            {
+                TRDP_SUB_ENTRY_T *pEntry = &pTelegramBatch->pSubEntry[pTelegramBatch->numSub];
+
+                pEntry->pUserRef        = pSubscribeTelegram->pUserRef;
+                pEntry->pfCbFunction    = NULL;
+                pEntry->comId           = pSubscribeTelegram->comId;
+                pEntry->etbTopoCnt      = pSubscribeTelegram->etbTopoCount;
+                pEntry->opTrnTopoCnt    = pSubscribeTelegram->opTrnTopoCount;
+                pEntry->srcIpAddr1      = pSubscribeTelegram->srcIpAddr;
+                pEntry->srcIpAddr2      = 0;
+                pEntry->destIpAddr      = pSubscribeTelegram->dstIpAddr;
+                pEntry->pktFlags        = pSubscribeTelegram->pPdParameter->flags;
+                pEntry->timeout         = pSubscribeTelegram->pPdParameter->timeout;
+                pEntry->toBehavior      = pSubscribeTelegram->pPdParameter->toBehav;
+                pTelegramBatch->ppSubTelegram[pTelegramBatch->numSub++] = pSubscribeTelegram;
+                continue;
+            }
             /* Subscribe */
             err = tlp_subscribe(
                     pSubscribeTelegram->appHandle,                                  /* our application identifier */
@@ -1757,29 +2204,11 @@ TRDP_ERR_T subscribeTelegram (
                     pSubscribeTelegram->pPdParameter->flags,                        /* Option */
                     pSubscribeTelegram->pPdParameter->timeout,                  /* Time out in us   */
                     pSubscribeTelegram->pPdParameter->toBehav);                      /* delete invalid data on timeout */
+            err = finishSubscribeTelegram(pSubscribeTelegram, err);
             if (err != TRDP_NO_ERR)
             {
-                /* Free Subscribe Dataset */
-                vos_memFree(pSubscribeDataset);
-                /* Free Subscribe Telegram */
-                vos_memFree(pSubscribeTelegram);
-                vos_printLog(VOS_LOG_ERROR, "subscribeTelegram() Failed. Subscribe Telegram tlp_subscribe() Err:%d\n", err);
                 return err;
             }
-            else
-            {
-                /* Append Subscribe Telegram */
-                err = appendSubscribeTelegramList(&pHeadSubscribeTelegram, pSubscribeTelegram);
-                if (err != TRDP_NO_ERR)
-                {
-                    /* Free Subscribe Dataset */
-                    vos_memFree(pSubscribeDataset);
-                    /* Free Subscribe Telegram */
-                    vos_memFree(pSubscribeTelegram);
-                    vos_printLog(VOS_LOG_ERROR, "subscribeTelegram() Failed. Subscribe Telegram appendSubscribeTelegramList() Err:%d\n", err);
-                    return err;
-                }
-            }
         }
     }
     return TRDP_NO_ERR;
@@ -2021,6 +2450,16 @@ TRDP_ERR_T pdRequestTelegram (
                 vos_memFree(pPdRequestTelegram);
                 return TRDP_PARAM_ERR;
             }
+            /* Register the telegram slot in the Traffic Store layout */
+            err = tau_addTrafficStoreLayout(pExchgPar->comId, pExchgPar->pPdPar->offset,
+                                            pPdRequestTelegram->dataset.size, TRAFFIC_STORE_SLOT_REQUEST);
+            if (err != TRDP_NO_ERR)
+            {
+                vos_printLog(VOS_LOG_ERROR, "pdRequestTelegram() Failed. tau_addTrafficStoreLayout() returns error = %d\n", err);
+                /* Free PD Request Telegram */
+                vos_memFree(pPdRequestTelegram);
+                return err;
+            }
             /* Create Dataset */
             pPdRequestDataset = (UINT32 *)vos_memAlloc(pPdRequestTelegram->dataset.size);
             if (pPdRequestDataset == NULL)
@@ -2046,7 +2485,8 @@ TRDP_ERR_T pdRequestTelegram (
                 err = tau_calcDatasetSize(
                         marshallConfig.pRefCon,
                         pExchgPar->datasetId,
-                        (UINT8 *) pPdRequestTelegram,
+                        (UINT8 *) pPdRequestDataset,
+                        pPdRequestTelegram->dataset.size,
                         &pPdRequestTelegram->datasetNetworkByteSize,
                         &pPdRequestTelegram->pDatasetDescriptor);
                 if (err != TRDP_NO_ERR)
@@ -2137,6 +2577,139 @@ TRDP_ERR_T pdRequestTelegram (
     return TRDP_NO_ERR;
 }
 
+/******************************************************************************/
+/** Subscribe or unsubscribe a telegram for a broker client.
+ *  The client telegram is subscribed like a configured one on every interface, tau_ldRecvPdDs() writes it to the
+ *  Traffic Store area the broker reserved for the client.
+ *
+ *  @param[in]      index               broker entry index
+ *  @param[in]      pEntry              pointer to the broker entry
+ *  @param[in]      subscribe           TRUE: subscribe, FALSE: unsubscribe
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_PARAM_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+static TRDP_ERR_T tau_ldServeBroker (
+    UINT32                              index,
+    const TRAFFIC_STORE_BROKER_ENTRY_T  *pEntry,
+    BOOL8                               subscribe)
+{
+    SUBSCRIBE_TELEGRAM_T    *pSubscribeTelegram = NULL;
+    TRDP_PD_PAR_T           *pPdParameter = NULL;
+    UINT32                  ifIndex = 0;
+    UINT32                  numIf = LADDER_IF_NUMBER;
+    TRDP_ERR_T              err = TRDP_NO_ERR;
+
+    if (index >= TRAFFIC_STORE_BROKER_MAX)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pPdParameter = &aBrokerPdParameter[index];
+
+    /* Unsubscribe */
+    if (subscribe == FALSE)
+    {
+        for (ifIndex = 0; ifIndex < LADDER_IF_NUMBER; ifIndex++)
+        {
+            pSubscribeTelegram = apBrokerSubscribeTelegram[index][ifIndex];
+            if (pSubscribeTelegram != NULL)
+            {
+                err = tlp_unsubscribe(pSubscribeTelegram->appHandle, pSubscribeTelegram->subHandle);
+                if (err != TRDP_NO_ERR)
+                {
+                    vos_printLog(VOS_LOG_ERROR, "tau_ldServeBroker() Failed. tlp_unsubscribe() Err:%d\n", err);
+                }
+                (void) deleteSubscribeTelegramList(&pHeadSubscribeTelegram, pSubscribeTelegram);
+                apBrokerSubscribeTelegram[index][ifIndex] = NULL;
+            }
+        }
+        return TRDP_NO_ERR;
+    }
+
+    /* Client data is copied as received, no marshalling */
+    memset(pPdParameter, 0, sizeof(TRDP_PD_PAR_T));
+    pPdParameter->offset    = pEntry->offset;
+    pPdParameter->timeout   = pEntry->timeout;
+    pPdParameter->toBehav   = TRDP_TO_KEEP_LAST_VALUE;
+    pPdParameter->flags     = TRDP_FLAGS_NONE;
+
+    /* Not Ladder Topology ? */
+    if (appHandle2 == (TRDP_APP_SESSION_T) LADDER_TOPOLOGY_DISABLE)
+    {
+        numIf = 1;
+    }
+    for (ifIndex = 0; ifIndex < numIf; ifIndex++)
+    {
+        /* Get Subscribe Telegram memory area */
+        pSubscribeTelegram = (SUBSCRIBE_TELEGRAM_T *)vos_memAlloc(sizeof(SUBSCRIBE_TELEGRAM_T));
+        if (pSubscribeTelegram == NULL)
+        {
+            vos_printLog(VOS_LOG_ERROR, "tau_ldServeBroker() Failed. Subscribe Telegram vos_memAlloc() Err\n");
+            err = TRDP_MEM_ERR;
+            break;
+        }
+        pSubscribeTelegram->appHandle       = arraySessionConfigTAUL[ifIndex].sessionHandle;
+        pSubscribeTelegram->dataset.size    = pEntry->size;
+        pSubscribeTelegram->pIfConfig       = &pIfConfig[ifIndex];
+        pSubscribeTelegram->pPdParameter    = pPdParameter;
+        pSubscribeTelegram->comId           = pEntry->comId;
+        pSubscribeTelegram->srcIpAddr       = pEntry->srcIpAddr;
+        pSubscribeTelegram->dstIpAddr       = pEntry->destIpAddr;
+        /* Subnet2 addresses differ by the Sub-network Id */
+        if (ifIndex == IF_INDEX_SUBNET2)
+        {
+            if (pSubscribeTelegram->srcIpAddr != IP_ADDRESS_NOTHING)
+            {
+                pSubscribeTelegram->srcIpAddr |= SUBNET2_NETMASK;
+            }
+            if ((pSubscribeTelegram->dstIpAddr != IP_ADDRESS_NOTHING) && !vos_isMulticast(pSubscribeTelegram->dstIpAddr))
+            {
+                pSubscribeTelegram->dstIpAddr |= SUBNET2_NETMASK;
+            }
+        }
+        pSubscribeTelegram->brokerIndex     = index + 1;
+        pSubscribeTelegram->pUserRef        = (void *)pSubscribeTelegram;
+        /* Subscribe */
+        err = tlp_subscribe(
+                pSubscribeTelegram->appHandle,                                  /* our application identifier */
+                &pSubscribeTelegram->subHandle,                                 /* our subscription identifier */
+                pSubscribeTelegram->pUserRef,                                   /* user reference value */
+                NULL,                                                           /* callback function */
+                pSubscribeTelegram->comId,                                      /* ComID */
+                0,                                                              /* ETB topocount */
+                0,                                                              /* operational topocount */
+                pSubscribeTelegram->srcIpAddr, 0,                               /* Source IP filter */
+                pSubscribeTelegram->dstIpAddr,                                  /* Default destination  (or MC Group) */
+                pPdParameter->flags,                                            /* Option */
+                pPdParameter->timeout,                                          /* Time out in us   */
+                pPdParameter->toBehav);                                         /* keep last value on timeout */
+        if (err != TRDP_NO_ERR)
+        {
+            vos_memFree(pSubscribeTelegram);
+            vos_printLog(VOS_LOG_ERROR, "tau_ldServeBroker() Failed. comId:%d tlp_subscribe() Err:%d\n", pEntry->comId, err);
+            break;
+        }
+        err = appendSubscribeTelegramList(&pHeadSubscribeTelegram, pSubscribeTelegram);
+        if (err != TRDP_NO_ERR)
+        {
+            (void) tlp_unsubscribe(pSubscribeTelegram->appHandle, pSubscribeTelegram->subHandle);
+            vos_memFree(pSubscribeTelegram);
+            vos_printLog(VOS_LOG_ERROR, "tau_ldServeBroker() Failed. appendSubscribeTelegramList() Err:%d\n", err);
+            break;
+        }
+        linkPeerSubscribeTelegram(pSubscribeTelegram);
+        apBrokerSubscribeTelegram[index][ifIndex] = pSubscribeTelegram;
+    }
+
+    /* Undo the interfaces already subscribed */
+    if (err != TRDP_NO_ERR)
+    {
+        (void) tau_ldServeBroker(index, pEntry, FALSE);
+    }
+    return err;
+}
+
 /******************************************************************************/
 /** PD Main Process Init
  *
@@ -2152,6 +2725,17 @@ TRDP_ERR_T tau_pd_main_proc_init (
     /* TAULpdMainThread */
     extern CHAR8 taulPdMainThreadName[];                    /* Thread name is TAUL PD Main Thread. */
 
+    /* Create the wake up pipe, both ends non-blocking */
+    if ((taulWakeUpPipe[0] < 0)
+        && ((pipe(taulWakeUpPipe) != 0)
+            || (fcntl(taulWakeUpPipe[0], F_SETFL, O_NONBLOCK) != 0)
+            || (fcntl(taulWakeUpPipe[1], F_SETFL, O_NONBLOCK) != 0)))
+    {
+        vos_printLog(VOS_LOG_ERROR, "TAULpdMainThread wake up pipe create failed\n");
+        return TRDP_THREAD_ERR;
+    }
+    taulWakeUpPending = 0;
+
     /* Init Thread */
     vos_threadInit();
     /* Create TAULpdMainThread */
@@ -2173,9 +2757,12 @@ TRDP_ERR_T tau_pd_main_proc_init (
 
 /******************************************************************************/
 /** TAUL PD Main Process Thread
+ *  Sleeps in select() until a socket is readable, the next PD is due or tau_ldWakeUpPdMainThread() is called.
+ *  For ladder topology, the subnet is switched on netlink link events; where these are not available the
+ *  idle time is limited to TAUL_LINK_CHECK_INTERVAL for the link up/down check.
  *
  */
-static const TRDP_TIME_T  max_tv = {0, 10000};
+static const TRDP_TIME_T  max_tv = {TAUL_LINK_CHECK_INTERVAL / 1000000, TAUL_LINK_CHECK_INTERVAL % 1000000};
 VOS_THREAD_FUNC_T TAULpdMainThread (
     void)
 {
@@ -2188,6 +2775,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
     UINT32                      replyIpAddrHostByteOrder = 0;
     TRDP_TIME_T             tv_interval = {0};                              /* interval Time :timeval type */
     TRDP_TIME_T             trdp_time_tv_interval = {0};                    /* interval Time :TRDP_TIME_T type for TRDP function */
+    INT32                       linkWatch = -1;                                 /* link event descriptor, -1: poll */
 
     /* Check appHandle */
     while (1)
@@ -2216,6 +2804,12 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
     /* Set Byet order Message Type:Pr */
     msgTypePrNetworkByteOder = vos_htons(TRDP_MSG_PR);
 
+    /* Ladder Topology: switch the subnet on link events instead of polling the link state */
+    if (appHandle2 != (TRDP_APP_SESSION_T) LADDER_TOPOLOGY_DISABLE)
+    {
+        linkWatch = tau_openLinkWatch();
+    }
+
     /* Enter the PD main processing loop. */
     while (1)
     {
@@ -2227,6 +2821,9 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
         TRDP_TIME_T  tv2 = max_tv;
         BOOL8 linkUpDown = TRUE;                        /* Link Up Down information TRUE:Up FALSE:Down */
         UINT32 writeSubnetId;                        /* Using Traffic Store Write Sub-network Id */
+        BOOL8 wakeUp = FALSE;                        /* Woken up by tau_ldWakeUpPdMainThread() */
+        BOOL8 linkChanged = FALSE;                   /* Link event received */
+        UINT8 drain[16];
 
         /*
         Prepare the file descriptor set for the select call.
@@ -2247,15 +2844,9 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
         /*
         The wait time for select must consider cycle times and timeouts of
         the PD packets received or sent.
-        If we need to poll something faster than the lowest PD cycle,
-        we need to set the maximum timeout ourselfs
+        Without link events the ladder topology polls the link state while idle.
         */
 
-        if (vos_cmpTime((TRDP_TIME_T *) &tv, (TRDP_TIME_T *) &max_tv) > 0)
-        {
-            tv = max_tv;
-        }
-
         /* second TRDP instance */
         if (appHandle2 != (TRDP_APP_SESSION_T) LADDER_TOPOLOGY_DISABLE)
         {
@@ -2263,10 +2854,37 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                              (TRDP_TIME_T *) &tv2,
                              (TRDP_FDS_T *) &rfds,
                              &noOfDesc2);
-            if (vos_cmpTime((TRDP_TIME_T *) &tv2, (TRDP_TIME_T *) &max_tv) > 0)
+            if (linkWatch < 0)
             {
-                tv2 = max_tv;
+                if (vos_cmpTime((TRDP_TIME_T *) &tv, (TRDP_TIME_T *) &max_tv) > 0)
+                {
+                    tv = max_tv;
+                }
+                if (vos_cmpTime((TRDP_TIME_T *) &tv2, (TRDP_TIME_T *) &max_tv) > 0)
+                {
+                    tv2 = max_tv;
+                }
             }
+            else
+            {
+                /* Wake up on link changes */
+                FD_SET(linkWatch, &rfds);
+                if (noOfDesc2 < linkWatch)
+                {
+                    noOfDesc2 = linkWatch;
+                }
+            }
+        }
+        else
+        {
+            tv2 = tv;
+        }
+
+        /* Wake up on application writes to the Traffic Store */
+        FD_SET(taulWakeUpPipe[0], &rfds);
+        if (noOfDesc2 < taulWakeUpPipe[0])
+        {
+            noOfDesc2 = taulWakeUpPipe[0];
         }
 
         /*
@@ -2287,7 +2905,27 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
         {
             tv = tv2;
         }
-        rv = vos_select((int)noOfDesc + 1, &rfds, NULL, NULL, (VOS_TIME_T *)&tv);
+        rv = vos_select((int)noOfDesc + 1, &rfds, NULL, NULL, &tv);
+
+        if ((rv > 0) && FD_ISSET(taulWakeUpPipe[0], &rfds))
+        {
+            /* Re-arm before draining, a write after the drain wakes us again */
+            __atomic_store_n(&taulWakeUpPending, 0, __ATOMIC_SEQ_CST);
+            while (read(taulWakeUpPipe[0], drain, sizeof(drain)) > 0)
+            {
+                ;
+            }
+            FD_CLR(taulWakeUpPipe[0], &rfds);
+            rv--;
+            wakeUp = TRUE;
+        }
+
+        if ((rv > 0) && (linkWatch >= 0) && FD_ISSET(linkWatch, &rfds))
+        {
+            (void) tau_processLinkEvents(&linkChanged);
+            FD_CLR(linkWatch, &rfds);
+            rv--;
+        }
 
         vos_mutexLock(appHandle->mutex);
 
@@ -2352,7 +2990,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                                         pUpdatePdRequestTelegram->pPdParameter->redundant,
                                         pUpdatePdRequestTelegram->pPdParameter->flags,
                                         pUpdatePdRequestTelegram->pSendParam,
-                                        (UINT8 *)((INT32) pTrafficStoreAddr + (UINT16)pUpdatePdRequestTelegram->pPdParameter->offset),
+                                        (UINT8 *)(pTrafficStoreAddr + pUpdatePdRequestTelegram->pPdParameter->offset),
                                         pUpdatePdRequestTelegram->datasetNetworkByteSize,
                                         pUpdatePdRequestTelegram->replyComId,
                                         pUpdatePdRequestTelegram->replyIpAddr);
@@ -2378,18 +3016,15 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
             /* Publish Telegram */
             else
             {
-                /* Is Now Time send Timing ? */
-                if (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0)
+                /* Is Now Time send Timing or Traffic Store written ? */
+                if ((wakeUp == TRUE)
+                    || (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0))
                 {
                     /* Check comId which Publish our statistics packet */
                     if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
                     {
                         /* Update Publish Dataset */
-                        tau_ldLockTrafficStore();
-                        memcpy((void *)ts_buffer,
-                                 (UINT8 *)((INT32)pTrafficStoreAddr + *(UINT16*)(iterPD->pUserRef)),
-                                 2048);
-                        tau_ldUnlockTrafficStore();
+                        tau_ldReadPublishDataset(*(UINT32*)(iterPD->pUserRef));
                         err = tlp_put(
                                 appHandle,
                                 iterPD,
@@ -2467,7 +3102,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                                         pUpdatePdRequestTelegram->pPdParameter->redundant,
                                         pUpdatePdRequestTelegram->pPdParameter->flags,
                                         pUpdatePdRequestTelegram->pSendParam,
-                                        (UINT8 *)((INT32) pTrafficStoreAddr + (UINT16)pUpdatePdRequestTelegram->pPdParameter->offset),
+                                        (UINT8 *)(pTrafficStoreAddr + pUpdatePdRequestTelegram->pPdParameter->offset),
                                         pUpdatePdRequestTelegram->datasetNetworkByteSize,
                                         pUpdatePdRequestTelegram->replyComId,
                                         pUpdatePdRequestTelegram->replyIpAddr);
@@ -2492,18 +3127,15 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                 /* Publish Telegram */
                 else
                 {
-                    /* Is Now Time send Timing ? */
-                    if (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0)
+                    /* Is Now Time send Timing or Traffic Store written ? */
+                    if ((wakeUp == TRUE)
+                        || (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0))
                     {
                         /* Check comId which Publish our statistics packet */
                         if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
                         {
                             /* Update Publish Dataset */
-                            tau_ldLockTrafficStore();
-                            memcpy((void *)ts_buffer,
-                                     (UINT8 *)((INT32)pTrafficStoreAddr + *(UINT16*)(iterPD->pUserRef)),
-                                     2048);
-                            tau_ldUnlockTrafficStore();
+                            tau_ldReadPublishDataset(*(UINT32*)(iterPD->pUserRef));
                             err = tlp_put(
                                     appHandle2,
                                     iterPD,
@@ -2520,6 +3152,9 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
             vos_mutexUnlock(appHandle2->mutex);
         }
 
+        /* Subscribe / unsubscribe telegrams requested by broker clients */
+        (void) tau_serveTrafficStoreBroker(tau_ldServeBroker);
+
         /*
         Check for overdue PDs (sending and receiving)
         Send any PDs if it's time...
@@ -2530,8 +3165,9 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
         function (in it's context and thread)!
         */
 
-        /* Don't Receive ? AND Ladder Topology */
-        if ((rv <= 0) && (appHandle2 != (TRDP_APP_SESSION_T) LADDER_TOPOLOGY_DISABLE))
+        /* Link changed, or (polling) Don't Receive ? AND Ladder Topology */
+        if ((appHandle2 != (TRDP_APP_SESSION_T) LADDER_TOPOLOGY_DISABLE)
+            && ((linkChanged == TRUE) || ((linkWatch < 0) && (rv <= 0) && (wakeUp == FALSE))))
         {
             /* Get Write Traffic Store Receive SubnetId */
             err = tau_getNetworkContext(&writeSubnetId);
@@ -2586,6 +3222,27 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
 /**********************************************************************************************************************/
 /** TAUL API
  */
+/******************************************************************************/
+/** Log the duration of one tau_ldInit() phase and start timing the next one
+ *
+ *  @param[in]      pPhase              name of the finished phase
+ *  @param[in,out]  pPhaseStart         start of the finished phase, set to now
+ */
+static void logInitPhase (
+    const CHAR8     *pPhase,
+    TRDP_TIME_T     *pPhaseStart)
+{
+    TRDP_TIME_T now;
+    TRDP_TIME_T duration;
+
+    vos_getTime(&now);
+    duration = now;
+    vos_subTime(&duration, pPhaseStart);
+    vos_printLog(VOS_LOG_INFO, "tau_ldInit() %-14s %u.%03u ms\n", pPhase,
+                 (UINT32)(duration.tv_sec * 1000 + duration.tv_usec / 1000), (UINT32)(duration.tv_usec % 1000));
+    *pPhaseStart = now;
+}
+
 /******************************************************************************/
 /** Initialize TAUL and create shared memory if required.
  *  Create Traffic Store mutex, Traffic Store
@@ -2611,6 +3268,9 @@ TRDP_ERR_T tau_ldInit (
     UINT32 getNoOfIfaces = NUM_ED_INTERFACES;
     VOS_IF_REC_T ifAddressTable[NUM_ED_INTERFACES];
     TRDP_IP_ADDR_T ownIpAddress = 0;
+    /* For the startup timing breakdown */
+    TRDP_TIME_T initStart;
+    TRDP_TIME_T phaseStart;
 #ifdef __linux
     CHAR8 SUBNETWORK_ID1_IF_NAME[] = "eth0";
 //#elif defined(__APPLE__)
@@ -2618,6 +3278,9 @@ TRDP_ERR_T tau_ldInit (
     CHAR8 SUBNETWORK_ID1_IF_NAME[] = "en0";
 #endif
 
+    vos_getTime(&initStart);
+    phaseStart = initStart;
+
     /* Clear application handles */
     appHandle = NULL;
     appHandle2 = NULL;
@@ -2626,6 +3289,10 @@ TRDP_ERR_T tau_ldInit (
     pHeadPublishTelegram = NULL;
     pHeadSubscribeTelegram = NULL;
     pHeadPdRequestTelegram = NULL;
+    memset(apPublishTelegramHash, 0, sizeof(apPublishTelegramHash));
+    memset(apSubscribeTelegramHash, 0, sizeof(apSubscribeTelegramHash));
+    memset(apPdRequestTelegramHash, 0, sizeof(apPdRequestTelegramHash));
+    memset(apBrokerSubscribeTelegram, 0, sizeof(apBrokerSubscribeTelegram));
 
     /* Clear mutex pointers */
     pPublishTelegramMutex = NULL;
@@ -2662,15 +3329,18 @@ TRDP_ERR_T tau_ldInit (
         return err;
     }
 #endif /* ifdef XML_CONFIG_ENABLE */
+    logInitPhase("config:", &phaseStart);
 
     /*  Init the TRDP library  */
     err = tlc_init(pPrintDebugString,            /* debug print function */
+                        NULL,                               /* no context */
                         &memoryConfigTAUL);                /* Use application supplied memory */
     if (err != TRDP_NO_ERR)
     {
         vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. tlc_init() error = %d\n",err);
         return err;
     }
+    logInitPhase("tlc_init:", &phaseStart);
     /* Get I/F address */
     if (vos_getInterfaces(&getNoOfIfaces, ifAddressTable) != VOS_NO_ERR)
     {
@@ -2690,6 +3360,7 @@ TRDP_ERR_T tau_ldInit (
     }
     /* Sub-net Id2 Address */
     subnetId2Address = subnetId1Address | SUBNET2_NETMASK;
+    logInitPhase("interfaces:", &phaseStart);
 
 
 #ifdef XML_CONFIG_ENABLE
@@ -2704,6 +3375,7 @@ TRDP_ERR_T tau_ldInit (
         vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. tau_readXmlDatasetConfig() error = %d\n",err);
         return err;
     }
+    logInitPhase("datasets:", &phaseStart);
 #endif /* ifdef XML_CONFIG_ENABLE */
 
     /* Set MD Call Back Function */
@@ -2802,13 +3474,15 @@ TRDP_ERR_T tau_ldInit (
             return err;
         }
     }
+    logInitPhase("sessions:", &phaseStart);
     /* TRDP Ladder Support Initialize */
-    err = tau_ladder_init();
+    err = tau_ladder_initSize(taulConfig.trafficStoreSize);
     if (err != TRDP_NO_ERR)
     {
         vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. TRDP Ladder Support Initialize failed\n");
         return err;
     }
+    logInitPhase("traffic store:", &phaseStart);
     /* Get Telegram Loop */
     for (ifIndex = 0; ifIndex < numIfConfig; ifIndex++)
     {
@@ -2819,6 +3493,7 @@ TRDP_ERR_T tau_ldInit (
             return err;
         }
     }
+    logInitPhase("telegrams:", &phaseStart);
 
     /* main Loop */
     /* Create TAUL PD Main Thread */
@@ -2840,6 +3515,8 @@ TRDP_ERR_T tau_ldInit (
     {
         appHandle2 = (TRDP_APP_SESSION_T) LADDER_TOPOLOGY_DISABLE;
     }
+    logInitPhase("PD thread:", &phaseStart);
+    logInitPhase("total:", &initStart);
     return TRDP_NO_ERR;
 }
 
@@ -2946,6 +3623,15 @@ TRDP_ERR_T tau_ldTerminate (
         vos_threadDelay(1000);
     }
 
+    /* Close the wake up pipe */
+    if (taulWakeUpPipe[0] >= 0)
+    {
+        close(taulWakeUpPipe[0]);
+        close(taulWakeUpPipe[1]);
+        taulWakeUpPipe[0] = -1;
+        taulWakeUpPipe[1] = -1;
+    }
+
 //#ifdef XML_CONFIG_ENABLE
     /*  Free allocated memory - parsed telegram configuration */
     for (i=0; i < LADDER_IF_NUMBER ; i++)
@@ -3077,8 +3763,11 @@ TRDP_ERR_T tau_ldTerminate (
                 vos_printLog(VOS_LOG_DBG, "%s ComId:%d Destination IP Address:%d unSubscribe.\n", vos_getTimeStamp(), iterSubscribeTelegram->subHandle->addr.comId, iterSubscribeTelegram->subHandle->addr.destIpAddr);
             }
         }
-        /* Free Subscribe Dataset */
-        vos_memFree(iterSubscribeTelegram->dataset.pDatasetStartAddr);
+        /* Free Subscribe Dataset, broker client telegrams have none */
+        if (iterSubscribeTelegram->dataset.pDatasetStartAddr != NULL)
+        {
+            vos_memFree(iterSubscribeTelegram->dataset.pDatasetStartAddr);
+        }
         iterSubscribeTelegram->dataset.pDatasetStartAddr = NULL;
         iterSubscribeTelegram->dataset.size = 0;
         /* Free Subscribe Telegram */
@@ -3364,9 +4053,32 @@ TRDP_ERR_T  tau_ldUnlockTrafficStore (
         vos_printLog(VOS_LOG_ERROR, "tau_ldUnlockTrafficeStore() failed\n");
         return err;
     }
+    /* Hand changed publish datasets to the stack */
+    (void) tau_ldWakeUpPdMainThread();
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Wake up the TAUL PD main thread.
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     TAUL not initialised
+ */
+TRDP_ERR_T  tau_ldWakeUpPdMainThread (
+    void)
+{
+    if (taulWakeUpPipe[1] < 0)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    /* One byte in the pipe is enough until the thread has drained it */
+    if (__atomic_exchange_n(&taulWakeUpPending, 1, __ATOMIC_SEQ_CST) == 0)
+    {
+        (void) write(taulWakeUpPipe[1], "", 1);
+    }
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** callback function PD receive
  *
@@ -3386,10 +4098,12 @@ void tau_ldRecvPdDs (
 {
     UINT32 subnetId;                            /* Using Sub-network Id */
     UINT32 displaySubnetId;                /* Using Sub-network Id for Display log */
-    UINT16 offset;                                        /* Traffic Store Offset Address */
+    UINT32 offset;                                        /* Traffic Store Offset Address */
     extern UINT8 *pTrafficStoreAddr;            /* pointer to pointer to Traffic Store Address */
 
     SUBSCRIBE_TELEGRAM_T *pSubscribeTelegram;
+    SUBSCRIBE_TELEGRAM_T *pPeerSubscribeTelegram;
+    TRDP_IP_ADDR_T srcIpAddr;                           /* Source IP Address without Sub-network Id */
     TRDP_ERR_T err;
 
     /* check parameter */
@@ -3402,11 +4116,32 @@ void tau_ldRecvPdDs (
         return;
     }
 
+    if ((pSubscribeTelegram = (SUBSCRIBE_TELEGRAM_T *)pPDInfo->pUserRef) == NULL)
+    {
+        return;
+    }
+
     tau_getNetworkContext(&subnetId);
 
+    /* Redundant telegram: the first copy from either subnet is written, the copy from the other subnet */
+    /* carries the same sequence counter and is dropped before any copying or unmarshalling */
+    pPeerSubscribeTelegram = pSubscribeTelegram->pPeerSubscribeTelegram;
+    if ((pPeerSubscribeTelegram != NULL) && (pPDInfo->resultCode == TRDP_NO_ERR))
+    {
+        srcIpAddr = pPDInfo->srcIpAddr & ~(TRDP_IP_ADDR_T)SUBNET2_NETMASK;
+        if ((pPeerSubscribeTelegram->lastSeqValid == TRUE)
+            && (pPeerSubscribeTelegram->lastSeqCount == pPDInfo->seqCount)
+            && (pPeerSubscribeTelegram->lastSrcIpAddr == srcIpAddr))
+        {
+            return;
+        }
+        pSubscribeTelegram->lastSeqCount = pPDInfo->seqCount;
+        pSubscribeTelegram->lastSrcIpAddr = srcIpAddr;
+        pSubscribeTelegram->lastSeqValid = TRUE;
+    }
     /* Write received PD from using subnetwork in Traffic Store */
     /* Check Receive Socket */
-    if ((subnetId == SUBNET1) && (argAppHandle == appHandle) && ((pPDInfo->srcIpAddr & SUBNET2_NETMASK) == subnetId))
+    else if ((subnetId == SUBNET1) && (argAppHandle == appHandle) && ((pPDInfo->srcIpAddr & SUBNET2_NETMASK) == subnetId))
     {
         /* Continue Write Traffic Store process */
         ;
@@ -3428,11 +4163,6 @@ void tau_ldRecvPdDs (
         return;
     }
 
-    if ((pSubscribeTelegram = (SUBSCRIBE_TELEGRAM_T *)pPDInfo->pUserRef) == NULL)
-    {
-        return;
-    }
-
     /* Receive Timeout ? */
     if (pPDInfo->resultCode == TRDP_TIMEOUT_ERR)
     {
@@ -3441,10 +4171,10 @@ void tau_ldRecvPdDs (
         {
             /* Clear Traffic Store */
             /* Get offset Address */
-            offset = (UINT16)pSubscribeTelegram->pPdParameter->offset;
-            tau_ldLockTrafficStore();
-            memset((void *)((INT32)pTrafficStoreAddr + offset), 0, pSubscribeTelegram->dataset.size);
-            tau_ldUnlockTrafficStore();
+            offset = pSubscribeTelegram->pPdParameter->offset;
+            tau_beginTrafficStoreWrite(offset);
+            memset((void *)(pTrafficStoreAddr + offset), 0, pSubscribeTelegram->dataset.size);
+            tau_endTrafficStoreWrite(offset);
 
             /* Set sunbetId for display log */
             if( subnetId == SUBNET1)
@@ -3460,23 +4190,33 @@ void tau_ldRecvPdDs (
             vos_printLog(VOS_LOG_ERROR, "SubnetId:%d comId:%d Timeout. Traffic Store Clear.\n", displaySubnetId, pPDInfo->comId);
         }
     }
+    /* Broker client telegram: bounded by the client area, not unmarshalled */
+    else if (pSubscribeTelegram->brokerIndex != 0)
+    {
+        if (dataSize > pSubscribeTelegram->dataset.size)
+        {
+            dataSize = pSubscribeTelegram->dataset.size;
+        }
+        tau_writeTrafficStore(pSubscribeTelegram->pPdParameter->offset, pData, dataSize);
+    }
     else
     {
         /* Get offset Address */
-        offset = (UINT16)pSubscribeTelegram->pPdParameter->offset;
+        offset = pSubscribeTelegram->pPdParameter->offset;
         /* Check Marshalling Kind : Marshalling Enable */
         if ((pSubscribeTelegram->pPdParameter->flags & TRDP_FLAGS_MARSHALL) == TRDP_FLAGS_MARSHALL)
         {
             /* unmarshalling */
-            tau_ldLockTrafficStore();
+            tau_beginTrafficStoreWrite(offset);
             err = tau_unmarshall(
                         &marshallConfig.pRefCon,                                        /* pointer to user context*/
                         pPDInfo->comId,                                                 /* comId */
                         pData,                                                          /* source pointer to received original message */
-                        (UINT8 *)((INT32)pTrafficStoreAddr + (INT32)offset),            /* destination pointer to a buffer for the treated message */
+                        dataSize,                                                       /* source size */
+                        (UINT8 *)(pTrafficStoreAddr + offset),                          /* destination pointer to a buffer for the treated message */
                         &pSubscribeTelegram->dataset.size,                              /* destination Buffer Size */
                         &pSubscribeTelegram->pDatasetDescriptor);                       /* pointer to pointer of cached dataset */
-            tau_ldUnlockTrafficStore();
+            tau_endTrafficStoreWrite(offset);
             if (err != TRDP_NO_ERR)
             {
                 vos_printLog(VOS_LOG_ERROR, "tau_unmarshall returns error %d\n", err);
@@ -3486,11 +4226,15 @@ void tau_ldRecvPdDs (
         else
         {
             /* Set received PD Data in Traffic Store */
-            tau_ldLockTrafficStore();
-            memcpy((void *)((INT32)pTrafficStoreAddr + offset), pData, dataSize);
-            tau_ldUnlockTrafficStore();
+            tau_writeTrafficStore(offset, pData, dataSize);
         }
     }
+
+    /* Let broker clients see reception and timeout */
+    if (pSubscribeTelegram->brokerIndex != 0)
+    {
+        tau_setBrokerTelegramStatus(pSubscribeTelegram->brokerIndex - 1, pPDInfo->resultCode);
+    }
 }
 
 /**********************************************************************************************************************/
@@ -3610,8 +4354,11 @@ TRDP_ERR_T tau_ldAllUnSubscribe(
                 vos_printLog(VOS_LOG_DBG, "%s ComId:%d Destination IP Address:%d unSubscribe.\n", vos_getTimeStamp(), iterSubscribeTelegram->subHandle->addr.comId, iterSubscribeTelegram->subHandle->addr.destIpAddr);
             }
         }
-        /* Free Subscribe Dataset */
-        vos_memFree(iterSubscribeTelegram->dataset.pDatasetStartAddr);
+        /* Free Subscribe Dataset, broker client telegrams have none */
+        if (iterSubscribeTelegram->dataset.pDatasetStartAddr != NULL)
+        {
+            vos_memFree(iterSubscribeTelegram->dataset.pDatasetStartAddr);
+        }
         iterSubscribeTelegram->dataset.pDatasetStartAddr = NULL;
         iterSubscribeTelegram->dataset.size = 0;
         /* Free Subscribe Telegram */
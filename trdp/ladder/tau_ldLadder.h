@@ -71,6 +71,10 @@ extern "C" {
 #define TAUL_PROCESS_PRIORITY	0			/* TAUL process priority */
 #define TAUL_PROCESS_THREAD_STACK_SIZE  0	/* TAUL Main Thread Stack Size (0:Default, 0!:Byte) */
 #define LADDER_TOPOLOGY_DISABLE -1            /* Not Ladder Topology */
+#define TAUL_TELEGRAM_HASH_SIZE	64		/* Number of comId hash buckets per Telegram List, power of 2 */
+#ifndef TAUL_LINK_CHECK_INTERVAL
+#define TAUL_LINK_CHECK_INTERVAL	100000	/* Max. idle time between Link up/down checks without link events [us] */
+#endif
 
 /**********************************************************************************************************************/
 /** Callback
@@ -112,6 +116,7 @@ typedef enum
 typedef struct
 {
 	TRDP_IP_ADDR_T	ownIpAddr;				/**< own IP Address  										*/
+	UINT32			trafficStoreSize;		/**< Traffic Store size, 0: TRAFFIC_STORE_SIZE				*/
 } TAU_LD_CONFIG_T;
 
 typedef struct
@@ -136,6 +141,7 @@ typedef struct PUBLISH_TELEGRAM
 	TRDP_IP_ADDR_T					srcIpAddr;						/* own IP address, 0 - srcIP will be set by the stack */
 	TRDP_IP_ADDR_T					dstIpAddr;						/* where to send the packet to */
 	TRDP_SEND_PARAM_T					*pSendParam;					/* optional pointer to send parameter, NULL - default parameters are used */
+	struct PUBLISH_TELEGRAM			*pNextHashPublishTelegram;		/* next Publish Telegram with the same comId hash or NULL */
 	struct PUBLISH_TELEGRAM			*pNextPublishTelegram;		/* pointer to next Publish Telegram or NULL */
 } PUBLISH_TELEGRAM_T;
 
@@ -155,6 +161,12 @@ typedef struct SUBSCRIBE_TELEGRAM
 	UINT32                          opTrnTopoCount;			/* operational topocount, != 0 for orientation/direction sensitive communication */
 	TRDP_IP_ADDR_T					srcIpAddr;					/* IP for source filtering, set 0 if not used */
 	TRDP_IP_ADDR_T					dstIpAddr;						/* IP address to join */
+	struct SUBSCRIBE_TELEGRAM		*pPeerSubscribeTelegram;		/* same telegram subscribed on the other subnet or NULL */
+	UINT32								lastSeqCount;					/* sequence counter of the last accepted copy */
+	TRDP_IP_ADDR_T					lastSrcIpAddr;					/* source of the last accepted copy, subnet masked out */
+	BOOL8								lastSeqValid;					/* lastSeqCount is valid */
+	UINT32								brokerIndex;					/* broker entry index + 1, 0: configured telegram */
+	struct SUBSCRIBE_TELEGRAM		*pNextHashSubscribeTelegram;		/* next Subscribe Telegram with the same comId hash or NULL */
 	struct SUBSCRIBE_TELEGRAM		*pNextSubscribeTelegram;		/* pointer to next Subscribe Telegram or NULL */
 } SUBSCRIBE_TELEGRAM_T;
 
@@ -177,6 +189,7 @@ typedef struct PD_REQUEST_TELEGRAM
 	TRDP_IP_ADDR_T					replyIpAddr;					/* IP for reply (Pull request Ip) */
 	TRDP_SEND_PARAM_T					*pSendParam;					/* optional pointer to send parameter, NULL - default parameters are used */
 	TRDP_TIME_T						requestSendTime;				/* next Request Send Timing */
+	struct PD_REQUEST_TELEGRAM	*pNextHashPdRequestTelegram;		/* next PD Request Telegram with the same comId hash or NULL */
 	struct PD_REQUEST_TELEGRAM	*pNextPdRequestTelegram;		/* pointer to next PD Request Telegram or NULL */
 } PD_REQUEST_TELEGRAM_T;
 
@@ -645,6 +658,7 @@ TRDP_ERR_T  tau_ldLockTrafficStore (
 
 /**********************************************************************************************************************/
 /** Release Traffic Store accessibility.
+ *  Changed publish datasets are handed to the stack immediately.
  *
  *  @retval         TRDP_NO_ERR			no error
  *  @retval         TRDP_PARAM_ERR		parameter error
@@ -654,6 +668,17 @@ TRDP_ERR_T  tau_ldLockTrafficStore (
 TRDP_ERR_T  tau_ldUnlockTrafficStore (
     void);
 
+/**********************************************************************************************************************/
+/** Wake up the TAUL PD main thread.
+ *  The thread hands the current Traffic Store contents of all publishers to the stack without waiting for their
+ *  next cycle. Called by tau_ldUnlockTrafficStore().
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_NOINIT_ERR	TAUL not initialised
+ */
+TRDP_ERR_T  tau_ldWakeUpPdMainThread (
+    void);
+
 /**********************************************************************************************************************/
 /** callback function PD receive
  *
@@ -20,6 +20,7 @@ ifeq ($(TARGET_OS), VXWORKS)
 AS	= $(TCPATH)as$(TCPOSTFIX)
 LD	= $(TCPATH)ld$(TCPOSTFIX)
 CC	= $(TCPATH)cc$(TCPOSTFIX)
+CXX	= $(TCPATH)c++$(TCPOSTFIX)
 CPP	= $(CC) -E
 AR	= $(TCPATH)ar$(TCPOSTFIX)
 NM	= $(TCPATH)nm$(TCPOSTFIX)
@@ -35,6 +36,7 @@ else
 AS	= $(TCPATH)$(TCPREFIX)as
 LD	= $(TCPATH)$(TCPREFIX)ld
 CC	= $(TCPATH)$(TCPREFIX)gcc
+CXX	= $(TCPATH)$(TCPREFIX)g++
 CPP	= $(TCPATH)$(CC) -E
 AR	= $(TCPATH)$(TCPREFIX)ar
 NM	= $(TCPATH)$(TCPREFIX)nm
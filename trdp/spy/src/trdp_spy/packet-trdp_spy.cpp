@@ -130,6 +130,7 @@ static const value_string trdp_spy_subs_code_vals[] =
 static const char *gbl_trdpDictionary_1 = NULL;	//XML Config Files String from ..Edit/Preference menu
 static guint g_pd_port = TRDP_DEFAULT_UDP_PD_PORT;
 static guint g_md_port = TRDP_DEFAULT_UDPTCP_MD_PORT;
+static gboolean g_check_crc = TRUE;	//Verify the CRCs, when the field is displayed or filtered on
 
 /* Initialize the subtree pointers */
 static gint ett_trdp_spy = -1;
@@ -173,24 +174,30 @@ static TrdpConfigHandler *pTrdpParser = NULL;
 static void add_crc2tree(tvbuff_t *tvb, proto_tree *trdp_spy_tree, int ref_fcs, int ref_fcs_calc, guint32 offset, guint32 data_start, guint32 data_end, const char* descr_text)
 {
 	guint32 calced_crc, package_crc, length;
-	guint8* pBuff;
+	const guint8* pBuff;
 
 	// this must always fit (if not, the programmer made a big mistake -> display nothing)
 	if (data_start > data_end) {
 		return;
 	}
 
-	length = data_end - data_start;
+	// Without a tree nothing is displayed or filtered on, the CRC is calculated only when it is needed
+	if (trdp_spy_tree == NULL) {
+		return;
+	}
+
+	package_crc = tvb_get_ntohl(tvb, offset);
 
-	pBuff = (guint8*) g_malloc(length);
-	if (pBuff == NULL) { // big problem, could not allocate the needed memory
+	if (!g_check_crc) {
+		proto_tree_add_uint_format_value(trdp_spy_tree, ref_fcs, tvb, offset, 4, NULL, "%sCrc: 0x%04x [not verified]", descr_text, package_crc);
 		return;
 	}
 
-	tvb_memcpy(tvb, pBuff, data_start, length);
-	calced_crc = g_ntohl(trdp_fcs32(pBuff, length,0xffffffff));
+	length = data_end - data_start;
 
-	package_crc = tvb_get_ntohl(tvb, offset);
+	// the data is checked in place, without copying it
+	pBuff = tvb_get_ptr(tvb, data_start, length);
+	calced_crc = g_ntohl(trdp_fcs32(pBuff, length,0xffffffff));
 
 	if (package_crc == calced_crc)
 	{
@@ -203,7 +210,6 @@ static void add_crc2tree(tvbuff_t *tvb, proto_tree *trdp_spy_tree, int ref_fcs,
 			descr_text, package_crc, calced_crc);
 
 	}
-	g_free(pBuff);
 }
 
 /* @fn *static void checkPaddingAndOffset(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, guint32 start_offset, guint32 offset)
@@ -353,10 +359,10 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 	}
 
 
-	ti = proto_tree_add_subtree_format(trdp_spy_tree, tvb, offset, length, 1 /* second element in ett[] */, NULL, "Dataset id : %d (%s)", pFound->datasetId, (pFound->name.length() > 0) ? pFound->name.toLatin1().data() : "" );
+	ti = proto_tree_add_subtree_format(trdp_spy_tree, tvb, offset, length, 1 /* second element in ett[] */, NULL, "Dataset id : %d (%s)", pFound->datasetId, pFound->nameLatin1.constData() );
 	trdp_spy_userdata = proto_item_add_subtree(ti, ett_trdp_spy_userdata);
 
-	if (pFound->calculateSize(pTrdpParser) <= 0)
+	if (pFound->size <= 0)	/* calculated once, when the configuration was loaded */
 	{
 		proto_tree_add_expert_format(trdp_spy_userdata, pinfo, &ei_trdp_userdata_empty, tvb, offset, length, "Userdata should be empty.");
 		return offset;
@@ -367,10 +373,10 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 	formated_value = 0;
     while (iterator.hasNext())
     {
-	Element el = iterator.next();
+	const Element &el = iterator.next();
 
         PRNT(printf("[%d] Offset %5d ----> Element: type=%2d %s\tname=%s\tarray-size=%d\tunit=%s\tscale=%f\toffset=%d\n", dataset_level,
-                     offset, el.type, (el.typeName.length() > 0) ? el.typeName.toLatin1().data() : "", el.name.toLatin1().data(), el.array_size, el.unit.toLatin1().data(), el.scale, el.offset));
+                     offset, el.type, (el.typeName.length() > 0) ? el.typeName.toLatin1().data() : "", el.nameLatin1.constData(), el.array_size, el.unitLatin1.constData(), el.scale, el.offset));
 
         value8u = 0; // flag, if there was a dynamic list found
 
@@ -379,7 +385,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 		{
 			value32 = 0; // Use this value to fetch the width in bytes of one element
 			// calculate the size of one element in bytes
-			value32 = trdp_dissect_width(el.type);
+			value32 = el.width;
 
 			element_amount = el.array_size;
 
@@ -406,7 +412,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
                     element_amount = value32u + 1; /* include the padding into the element */
                     value32u = 0; /* clear the borrowed variable */
 
-		   proto_tree_add_bytes_format_value(trdp_spy_userdata, hf_trdp_ds_type2and3, tvb, offset, length, NULL, "%s [%d]", el.name.toLatin1().data() , element_amount);
+		   proto_tree_add_bytes_format_value(trdp_spy_userdata, hf_trdp_ds_type2and3, tvb, offset, length, NULL, "%s [%d]", el.nameLatin1.constData() , element_amount);
                 }
                 else
                 {
@@ -435,7 +441,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
             if ((element_amount > 1  || element_amount == 0) && value8u != 2)
             {
 
-		ti = proto_tree_add_subtree_format(trdp_spy_userdata, tvb, offset, value16u, 1 /* second element in ett[] */, NULL, "%s (%d)", el.name.toLatin1().data() , element_amount);
+		ti = proto_tree_add_subtree_format(trdp_spy_userdata, tvb, offset, value16u, 1 /* second element in ett[] */, NULL, "%s (%d)", el.nameLatin1.constData() , element_amount);
                 userdata_actual = proto_item_add_subtree(ti, ett_trdp_spy_userdata);
             }
             else if (value8u != 2) /* check, that the dissector tree was not already modified handling dynamic datatypes */
@@ -451,10 +457,10 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
                 if (value64 > 0 && value64 < TRDP_FCS_LENGTH /*There will be always kept space for the FCS*/)
                 {
                     PRNT(printf("The dynamic size is too large: %s : has %d elements [%d byte each], but only %d left",
-                                el.name.toLatin1().data(), element_amount, value32, tvb_reported_length_remaining(tvb, offset)));
+                                el.nameLatin1.constData(), element_amount, value32, tvb_reported_length_remaining(tvb, offset)));
 
 		    expert_add_info_format(pinfo, trdp_spy_tree, &ei_trdp_userdata_wrong, "%s : has %d elements [%d byte each], but only %d left",
-                                        el.name.toLatin1().data(), element_amount, value32, tvb_reported_length_remaining(tvb, offset));
+                                        el.nameLatin1.constData(), element_amount, value32, tvb_reported_length_remaining(tvb, offset));
                 }
             }
 
@@ -471,12 +477,12 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 		{
 		case TRDP_BOOL8: //	   1
 			value32 = tvb_get_guint8(tvb, offset);
-			proto_tree_add_bytes_format_value(trdp_spy_userdata, hf_trdp_ds_type1, tvb, offset, 1, NULL, "%s : %s", el.name.toLatin1().data(), (value32 == 0) ? "false" : "true");
+			proto_tree_add_bytes_format_value(trdp_spy_userdata, hf_trdp_ds_type1, tvb, offset, 1, NULL, "%s : %s", el.nameLatin1.constData(), (value32 == 0) ? "false" : "true");
 			offset += 1;
 			break;
 		case TRDP_CHAR8:
 			//FIXME text = (gchar *) tvb_get_ephemeral_string(tvb, offset, element_amount);
-			proto_tree_add_bytes_format_value(trdp_spy_userdata, hf_trdp_ds_type2, tvb, offset, element_amount, NULL, "%s : %s %s", el.name.toLatin1().data(), text, (el.unit.length() > 0) ? el.unit.toLatin1().data() : "");
+			proto_tree_add_bytes_format_value(trdp_spy_userdata, hf_trdp_ds_type2, tvb, offset, element_amount, NULL, "%s : %s %s", el.nameLatin1.constData(), text, el.unitLatin1.constData());
 			offset += element_amount;
             array_id = element_amount - 1; // Jump to the next element (remove one, because this will be added automatically later)
 			break;
@@ -499,7 +505,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value8 = (gint8) tvb_get_guint8(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type4, tvb, offset, 1, NULL, "%s : %d %s", el.name.toLatin1().data(), value8 + el.offset, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type4, tvb, offset, 1, NULL, "%s : %d %s", el.nameLatin1.constData(), value8 + el.offset, el.unitLatin1.constData());
 
 			} else {
 				formated_value = (gdouble) value8; // the value will be displayed in the bottom of the loop
@@ -510,7 +516,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value16 = (gint16) tvb_get_ntohs(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type5, tvb, offset, 2, NULL, "%s : %d %s", el.name.toLatin1().data(), value16 + el.offset, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type5, tvb, offset, 2, NULL, "%s : %d %s", el.nameLatin1.constData(), value16 + el.offset, el.unitLatin1.constData());
 			} else {
 				formated_value = (gdouble) value16; // the value will be displayed in the bottom of the loop
 			}
@@ -520,7 +526,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value32 = (gint32) tvb_get_ntohl(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type6, tvb, offset, 4, NULL, "%s : %d %s", el.name.toLatin1().data(), value32 + el.offset, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type6, tvb, offset, 4, NULL, "%s : %d %s", el.nameLatin1.constData(), value32 + el.offset, el.unitLatin1.constData());
 			} else {
 				formated_value = (gdouble) value32; // the value will be displayed in the bottom of the loop
 			}
@@ -530,7 +536,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value64 = (gint64) tvb_get_ntoh64(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type7, tvb, offset, 8, NULL, "%s : %d %s", el.name.toLatin1().data(), value64 + el.offset, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type7, tvb, offset, 8, NULL, "%s : %d %s", el.nameLatin1.constData(), value64 + el.offset, el.unitLatin1.constData());
 			} else {
 				formated_value = (gdouble) value64; // the value will be displayed in the bottom of the loop
 			}
@@ -540,7 +546,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value8u = tvb_get_guint8(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type8, tvb, offset, 1, NULL, "%s : %d %s", el.name.toLatin1().data(), value8u + el.offset, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type8, tvb, offset, 1, NULL, "%s : %d %s", el.nameLatin1.constData(), value8u + el.offset, el.unitLatin1.constData());
 			} else {
 				formated_value = (gdouble) value8u; // the value will be displayed in the bottom of the loop
 			}
@@ -550,7 +556,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value16u = tvb_get_ntohs(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type9, tvb, offset, 2, NULL, "%s : %d %s", el.name.toLatin1().data(), value16u + el.offset, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type9, tvb, offset, 2, NULL, "%s : %d %s", el.nameLatin1.constData(), value16u + el.offset, el.unitLatin1.constData());
 			} else {
 				formated_value = (gdouble) value16u; // the value will be displayed in the bottom of the loop
 			}
@@ -560,7 +566,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value32u = tvb_get_ntohl(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type9, tvb, offset, 4, NULL, "%s : %d %s", el.name.toLatin1().data(), value32u + el.offset, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type9, tvb, offset, 4, NULL, "%s : %d %s", el.nameLatin1.constData(), value32u + el.offset, el.unitLatin1.constData());
 			} else {
 				formated_value = (gdouble) value32u; // the value will be displayed in the bottom of the loop
 			}
@@ -570,7 +576,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value64u = tvb_get_ntoh64(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type9, tvb, offset, 8, NULL, "%s : %d %s", el.name.toLatin1().data(), value64u + el.offset, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type9, tvb, offset, 8, NULL, "%s : %d %s", el.nameLatin1.constData(), value64u + el.offset, el.unitLatin1.constData());
 			} else {
 				formated_value = (gdouble) value64u; // the value will be displayed in the bottom of the loop
 			}
@@ -580,7 +586,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			real32 = tvb_get_ntohieee_float(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 4, NULL, "%s : %f %s", el.name.toLatin1().data(), real32, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 4, NULL, "%s : %f %s", el.nameLatin1.constData(), real32, el.unitLatin1.constData());
 			} else {
 				formated_value = (gdouble) real32; // the value will be displayed in the bottom of the loop
 			}
@@ -590,7 +596,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			real64 = tvb_get_ntohieee_double(tvb, offset);
 			if (el.scale == 0)
 			{
-				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 8, NULL, "%s : %f %s", el.name.toLatin1().data(), real64, (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+				proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 8, NULL, "%s : %f %s", el.nameLatin1.constData(), real64, el.unitLatin1.constData());
 			}
 			else
 			{
@@ -602,7 +608,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			memset(&time, 0, sizeof(time) );
 			value32u = tvb_get_ntohl(tvb, offset);
 			time.tv_sec = value32u;
-			proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 4, NULL, "%s : %s %s", el.name.toLatin1().data(), g_time_val_to_iso8601(&time), (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+			proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 4, NULL, "%s : %s %s", el.nameLatin1.constData(), g_time_val_to_iso8601(&time), el.unitLatin1.constData());
 			offset += 4;
 			break;
 		case TRDP_TIMEDATE48:
@@ -611,7 +617,7 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			value16u = tvb_get_ntohs(tvb, offset + 4);
 			time.tv_sec = value32u;
 			//time.tv_usec TODO how are ticks calculated to microseconds
-			proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 6, NULL, "%s : %s %s", el.name.toLatin1().data(), g_time_val_to_iso8601(&time), (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+			proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 6, NULL, "%s : %s %s", el.nameLatin1.constData(), g_time_val_to_iso8601(&time), el.unitLatin1.constData());
 			offset += 6;
 			break;
 		case TRDP_TIMEDATE64:
@@ -620,12 +626,12 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 			time.tv_sec = value32u;
 			value32u = tvb_get_ntohl(tvb, offset + 4);
 			time.tv_usec = value32u;
-			proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 8, NULL, "%s : %s %s", el.name.toLatin1().data(), g_time_val_to_iso8601(&time), (el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+			proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type10, tvb, offset, 8, NULL, "%s : %s %s", el.nameLatin1.constData(), g_time_val_to_iso8601(&time), el.unitLatin1.constData());
 			offset += 8;
 			break;
 		default:
 			//proto_tree_add_text(userdata_actual, tvb, offset, 1, "Unkown type %d for %s", el->type, el->name);
-			PRNT(printf("Unique type %d for %s\n", el.type, el.name.toLatin1().data()));
+			PRNT(printf("Unique type %d for %s\n", el.type, el.nameLatin1.constData()));
 
 			//FIXME check the dataset_level (maximum is 5!)
 
@@ -639,9 +645,9 @@ static guint32 dissect_trdp_generic_body(tvbuff_t *tvb, packet_info *pinfo, prot
 		if (formated_value != 0)
 		{
 			formated_value = (formated_value * el.scale) + el.offset;
-			value16 = trdp_dissect_width(el.type); // width of the element
-			proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type99, tvb, offset - value16, value16, NULL, "%s : %lf %s", el.name.toLatin1().data(), formated_value
-,(el.unit.length() != 0) ? el.unit.toLatin1().data() : "");
+			value16 = el.width; // width of the element
+			proto_tree_add_int_format_value(trdp_spy_userdata, hf_trdp_ds_type99, tvb, offset - value16, value16, NULL, "%s : %lf %s", el.nameLatin1.constData(), formated_value
+,el.unitLatin1.constData());
 		}
 		formated_value=0;
 
@@ -1013,6 +1019,9 @@ void proto_register_trdp(void)
     prefs_register_uint_preference(trdp_spy_module, "md.udptcp.port",
                                    "MD message Port",
 								   "UDP and TCP port for MD messages (Default port is " TRDP_DEFAULT_STR_MD_PORT ")", 10 /*base */, &g_md_port);
+    prefs_register_bool_preference(trdp_spy_module, "crc.check",
+                                   "Verify CRC",
+                                   "Calculate the CRCs of the header and compare them (only when the packet is displayed or filtered on)", &g_check_crc);
 
    /* Register expert information */
    expert_module_t* expert_trdp;
@@ -60,19 +60,26 @@ TrdpConfigHandler::TrdpConfigHandler(const char *xmlconfigFile)
 	this->metXbelTag = false;
     this->mDynamicSizeFound = false;
 
-    QFile *file= new QFile(this->xmlconfigFile);
+    QFile file(this->xmlconfigFile);
 
-    if (!file->exists()) {
+    if (!file.exists()) {
         this->xmlconfigFile = QString("");
     } else {
+#ifdef TRDP_SPY_TAU_XML
+        /* streamed by the parser of the TRDP library, without building a DOM or Qt strings per attribute */
+        bool ok = loadTauXml(xmlconfigFile);
+#else
         QXmlSimpleReader xmlReader;
-        QXmlInputSource *source = new QXmlInputSource(file);
+        QXmlInputSource source(&file);
 
         xmlReader.setContentHandler(this);
-        bool ok = xmlReader.parse(source);
+        bool ok = xmlReader.parse(&source);
+#endif
 
         if (!ok) {
             this->xmlconfigFile = QString("");
+        } else {
+            prepareLayouts();
         }
     }
 }
@@ -158,11 +165,11 @@ bool TrdpConfigHandler::startElement(const QString &namespaceURI, const QString
                 newElement.name = attributes.value(idxName);
             }
 
-            /* search the new inserted element */
-            Dataset currentworking = this->mTableDataset.value(this->mWorkingDatasetId);
-            currentworking.listOfElements.append(newElement);
-            /* update the element in the list */
-            this->mTableDataset.insert(this->mWorkingDatasetId, currentworking);
+            /* append it to the dataset in place */
+            Dataset *pWorking = searchDataset(this->mWorkingDatasetId);
+            if (pWorking != NULL) {
+                pWorking->listOfElements.append(newElement);
+            }
         }
     }
 
@@ -192,24 +199,11 @@ QString TrdpConfigHandler::errorString() const {
 }
 
 Dataset * TrdpConfigHandler::search(quint32 comId) {
-  Dataset *foundDS = NULL;
-
-  QHash<quint32, ComId>::const_iterator foundComId = this->mTableComId.find(comId);
-  while (((foundComId != this->mTableComId.end()) && ( foundComId.key() == comId)) && (foundDS == NULL)) {
-    QHash<quint32, Dataset>::const_iterator foundDataset = this->mTableDataset.find(
-                foundComId.value().dataset);
-    while ((foundDataset != this->mTableDataset.end())
-            && (foundDS == NULL)) {
-        if (foundDataset.key() == foundComId.value().dataset) {
-            foundDS = (Dataset *) &(foundDataset.value());
-        } else {
-            /* Pick element, but don't store it somewhere */
-            (void) foundDataset.value();
-        }
+    QHash<quint32, ComId>::const_iterator foundComId = this->mTableComId.constFind(comId);
+    if (foundComId == this->mTableComId.constEnd()) {
+        return NULL;
     }
-  }
-
-  return foundDS;
+    return searchDataset(foundComId.value().dataset);
 }
 
 /******************************************************************************
@@ -225,22 +219,52 @@ int TrdpConfigHandler::searchIndex(const QXmlAttributes &attributes, QString sea
     return -1;
 }
 
-/*FIXME: tiny iterator example */
+/** Search a dataset by its id.
+ * The returned pointer stays valid until the configuration is reloaded, no datasets are added after loading.
+ *
+ * @brief TrdpConfigHandler::searchDataset
+ * @param datasetId the unique identifier, that shall be searched
+ * @return the dataset or <code>NULL</code>, if it is unknown
+ */
 Dataset * TrdpConfigHandler::searchDataset(quint32 datasetId) {
-    Dataset *pFoundDataset = NULL;
-    QHashIterator<quint32, Dataset> iterator(this->mTableDataset);
-    while (iterator.hasNext()) {
-        iterator.next();
+    QHash<quint32, Dataset>::iterator found = this->mTableDataset.find(datasetId);
+    if (found == this->mTableDataset.end()) {
+        return NULL;
+    }
+    return &found.value();
+}
 
-        Dataset val = iterator.value();
-        // Found the datasetId we searched
-        if (val.datasetId == datasetId) {
-            pFoundDataset = (Dataset *) &val;
-            return pFoundDataset;
+/** Prepare the layout of all datasets once after parsing, so the dissector can reuse it for every packet:
+ * the width of each element, the nested datasets and the size of each dataset.
+ *
+ * @brief TrdpConfigHandler::prepareLayouts
+ */
+void TrdpConfigHandler::prepareLayouts(void) {
+    QHash<quint32, Dataset>::iterator itDataset;
+
+    for (itDataset = this->mTableDataset.begin(); itDataset != this->mTableDataset.end(); ++itDataset) {
+        QList<Element>::iterator itElement;
+        itDataset.value().nameLatin1 = itDataset.value().name.toLatin1();
+        for (itElement = itDataset.value().listOfElements.begin();
+             itElement != itDataset.value().listOfElements.end(); ++itElement) {
+            itElement->nameLatin1 = itElement->name.toLatin1();
+            itElement->unitLatin1 = itElement->unit.toLatin1();
+            if (itElement->type > TRDP_STANDARDTYPE_MAX) {
+                itElement->width = 0U;
+                /* direct recursion is ignored */
+                itElement->pDataset = (itElement->type != itDataset.key()) ? searchDataset(itElement->type) : NULL;
+            } else {
+                itElement->width = trdp_dissect_width(itElement->type);
+                itElement->pDataset = NULL;
+            }
         }
     }
-    // When nothing, was found, nothing is returned
-    return pFoundDataset;
+
+    for (itDataset = this->mTableDataset.begin(); itDataset != this->mTableDataset.end(); ++itDataset) {
+        (void) itDataset.value().calculateSize(this);
+    }
+    /* only valid per calculation, see isMinCalcSize() */
+    this->mDynamicSizeFound = false;
 }
 
 /** insert a new dataset identified by its unique id.
@@ -341,34 +365,47 @@ quint32 TrdpConfigHandler::calculateTelegramSize(quint32 comid) {
 
 quint32 Dataset::calculateSize(TrdpConfigHandler *pConfigHandler) {
     quint32 size = 0U;
+
+    /* calculated once, when the configuration is loaded */
+    if (this->sizeCalculated) {
+        if (this->dynamicSize && (pConfigHandler != NULL)) {
+            pConfigHandler->setDynamicSize();
+        }
+        return this->size;
+    }
+    /* mark it, so an indirect recursion ends here */
+    this->sizeCalculated = true;
+
     QListIterator<Element> iterator(this->listOfElements);
     while (iterator.hasNext()) {
-        Element val = iterator.next();
+        const Element &val = iterator.next();
 
         /* dynamic elements will kill the size calculation.
          * Set a flag, that only the minimum size was calculated */
         if (val.array_size == 0U) {
-            pConfigHandler->setDynamicSize();
+            this->dynamicSize = true;
         }
 
         if (val.type > TRDP_STANDARDTYPE_MAX) {
-            if ((pConfigHandler != NULL) && (val.type != this->datasetId)) {
-                /* direct recursion is ignored */
-                Dataset *pFound = pConfigHandler->searchDataset(val.type);
-                if (pFound) {
-                    size += pFound->calculateSize(pConfigHandler);
-                } else {
-                    //FIXME: The dataset cannot be found :-|
-                    return 0U;
-                }
+            if (val.pDataset != NULL) {
+                size += val.pDataset->calculateSize(pConfigHandler);
+                this->dynamicSize = this->dynamicSize || val.pDataset->dynamicSize;
+            } else if (val.type != this->datasetId) {
+                //FIXME: The dataset cannot be found :-|
+                size = 0U;
+                break;
             } else {
-                /* only called internally, programmer has to secure a valid pointer */
+                /* direct recursion is ignored */
             }
         } else {
-            size += val.calculateSize();
+            size += val.width * val.array_size;
         }
 
     }
+    this->size = size;
+    if (this->dynamicSize && (pConfigHandler != NULL)) {
+        pConfigHandler->setDynamicSize();
+    }
     return size;
 }
 
@@ -26,6 +26,7 @@
 */
 #include <QtXml/QXmlDefaultHandler>
 #include <QHash>
+#include <QByteArray>
 #include <QList>
 
 /*******************************************************************************
@@ -33,6 +34,7 @@
 */
 
 class TrdpConfigHandler; /**< empty class, needed for bidirectional dependencies */
+class Dataset;           /**< empty class, an element may refer to a nested dataset */
 
 /** @class Element
  *  @brief description of one element
@@ -82,12 +84,18 @@ public:
     float       scale=0.0f;      /**< A factor the given value is scaled */
     qint32      offset=0U;     /**< Offset that is added to the values. displayed value = scale * raw value + offset */
 
+    /* Layout, prepared once when the configuration is loaded (see TrdpConfigHandler::prepareLayouts()) */
+    quint32     width=0U;      /**< Width in bytes of one standard type value, 0 for a nested dataset */
+    Dataset     *pDataset=NULL; /**< The nested dataset, if the type is not a standard one */
+    QByteArray  nameLatin1;    /**< name, as displayed in the tree */
+    QByteArray  unitLatin1;    /**< unit, as displayed in the tree */
+
     /** Calculate the size in bytes of this element
      * @brief calculate the amount of used bytes
-     * @return number of bytes (or zero, if a unkown type is set, as then type is zero)
+     * @return number of bytes (or zero, if a unkown type is set, as then the width is zero)
      */
     quint32 calculateSize(void) {
-        return this->type * this->array_size;
+        return this->width * this->array_size;
     }
 };
 
@@ -98,7 +106,11 @@ class Dataset {
 public:
     quint32 datasetId;      /**< Unique identification of one dataset */
     QString name;           /**< Description of the dataset */
+    QByteArray nameLatin1;  /**< name, as displayed in the tree (prepared when the configuration is loaded) */
     QList<Element>   listOfElements; /**< All elements, this dataset consists of. */
+    quint32 size=0U;        /**< Size in bytes, the minimum if dynamicSize is set (cached by calculateSize()) */
+    bool    dynamicSize=false; /**< The dataset contains dynamic lists */
+    bool    sizeCalculated=false; /**< size and dynamicSize are valid */
 
     bool operator==(const Dataset & other) const; /* == overloading to assign in QHash */
 
@@ -173,7 +185,7 @@ public:
     quint32 calculateTelegramSize(quint32 comId);
     quint32 calculateDatasetSize(quint32 datasetId);
 
-    bool setDynamicSize(void) { mDynamicSizeFound = true;}
+    void setDynamicSize(void) { mDynamicSizeFound = true;}
 private:
     QString xmlconfigFile;
     QString currentText;
@@ -187,6 +199,10 @@ private:
     quint32 decodeDefaultTypes(QString typeName);
 
     int searchIndex(const QXmlAttributes &attributes, QString searchname);
+    void prepareLayouts(void);
+#ifdef TRDP_SPY_TAU_XML
+    bool loadTauXml(const char *xmlconfigFile);
+#endif
     void insertStandardType(quint32 id, char* textdescr);
 };
 
@@ -0,0 +1,94 @@
+/******************************************************************************/
+/**
+* @file            trdpTauXmlLoader.cpp
+*
+* @brief           Loading of the XML description with the parser of the TRDP library
+*
+* @details         Alternative to the Qt SAX handler, built with TRDP_SPY_TAU_XML.
+*                  The datasets are read with tau_readXmlDatasetConfig() and copied once into the tables of the
+*                  TrdpConfigHandler. The dataset description of the library carries no names, the elements are
+*                  named by their position.
+*
+* @note            Project: TRDP SPY
+*
+* @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+*          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2017. All rights reserved.
+*
+* $Id: $
+*
+*/
+
+#ifdef TRDP_SPY_TAU_XML
+
+/*******************************************************************************
+* INCLUDES
+*/
+#include "trdpConfigHandler.h"
+#include "tau_xml.h"
+
+/*******************************************************************************
+ * CLASS Implementation
+ */
+
+/** Read the comId mapping and the datasets of a configuration file
+ * @brief TrdpConfigHandler::loadTauXml
+ * @param xmlconfigFile path of the XML configuration
+ * @return <code>true</code> if the configuration could be read
+ */
+bool TrdpConfigHandler::loadTauXml(const char *xmlconfigFile) {
+    TRDP_XML_DOC_HANDLE_T   docHnd;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    TRDP_DATASET_T          **apDataset     = NULL;
+    UINT32                  numComId        = 0U;
+    UINT32                  numDataset      = 0U;
+    TRDP_ERR_T              err;
+    UINT32                  i;
+    UINT32                  j;
+
+    if (tau_prepareXmlDoc(xmlconfigFile, &docHnd) != TRDP_NO_ERR) {
+        return false;
+    }
+    err = tau_readXmlDatasetConfig(&docHnd, &numComId, &pComIdDsIdMap, &numDataset, &apDataset);
+    tau_freeXmlDoc(&docHnd);
+    if (err != TRDP_NO_ERR) {
+        return false;
+    }
+
+    this->mTableComId.reserve(numComId);
+    for (i = 0U; i < numComId; i++) {
+        ComId currentComId;
+        currentComId.comId = pComIdDsIdMap[i].comId;
+        currentComId.dataset = pComIdDsIdMap[i].datasetId;
+        this->mTableComId.insert(currentComId.comId, currentComId);
+    }
+
+    /* the datasets are built in place, the elements are appended to their final list */
+    this->mTableDataset.reserve(numDataset);
+    for (i = 0U; i < numDataset; i++) {
+        const TRDP_DATASET_T *pDs = apDataset[i];
+        Dataset &dataset = this->mTableDataset[pDs->id];
+
+        dataset.datasetId = pDs->id;
+        dataset.listOfElements.reserve(pDs->numElement);
+        for (j = 0U; j < pDs->numElement; j++) {
+            const TRDP_DATASET_ELEMENT_T *pEl = &pDs->pElement[j];
+            Element newElement;
+
+            newElement.name = QString("element%1").arg(j);
+            newElement.type = pEl->type;
+            newElement.array_size = pEl->size;
+            if (pEl->unit != NULL) {
+                newElement.unit = QString::fromLatin1(pEl->unit);
+            }
+            newElement.scale = pEl->scale;
+            newElement.offset = pEl->offset;
+            dataset.listOfElements.append(newElement);
+        }
+    }
+
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    return true;
+}
+
+#endif
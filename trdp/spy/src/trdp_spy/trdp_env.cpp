@@ -22,6 +22,9 @@
  * INCLUDES
  */
 #include "trdp_env.h"
+#ifdef TRDP_SPY_VOS_CRC
+#include "vos_utils.h"
+#endif
 
 /*******************************************************************************
  * DEFINES
@@ -111,6 +114,10 @@ static const quint32 fcstab[256] =
 
 quint32 trdp_fcs32(const quint8 buf[], quint32 len, quint32 fcs)
 {
+#ifdef TRDP_SPY_VOS_CRC
+    /* the same CRC as the stack, slice-by-8 or by the CPU's CRC instructions */
+    return vos_crc32(fcs, buf, len);
+#else
     quint32 i;
 
     for (i=0; i < len; i++)
@@ -118,6 +125,7 @@ quint32 trdp_fcs32(const quint8 buf[], quint32 len, quint32 fcs)
         fcs = (fcs >> 8)^fcstab[(fcs ^ buf[i]) & 0xff];
     }
    return ~fcs;
+#endif
 }
 
 
@@ -53,6 +53,20 @@ extern "C" {
  * TYPEDEFS
  */
 
+/** Callback for ECSP status changes, pEcspStat is zeroed if the status timed out (pPdInfo->resultCode) */
+typedef void (*TAU_ECSP_STAT_CB_T)(
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_ECSP_STAT_T  *pEcspStat,
+    const TRDP_PD_INFO_T    *pPdInfo);
+
+/** Callback for ECSP confirmation replies, pReply is NULL if result != TRDP_NO_ERR */
+typedef void (*TAU_ECSP_CONF_CB_T)(
+    void                            *pRefCon,
+    TRDP_APP_SESSION_T              appHandle,
+    const TRDP_ECSP_CONF_REPLY_T    *pReply,
+    TRDP_ERR_T                      result);
+
 
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -108,14 +122,18 @@ EXT_DECL TRDP_ERR_T tau_setEcspCtrl ( TRDP_APP_SESSION_T   appHandle,
 
 /**********************************************************************************************************************/
 /**    Function to get ECSP status information
+ *
+ *  Returns the status cached on its last reception, without accessing the TRDP session.
  *
  *  @param[in]      appHandle       Application Handle
  *  @param[in,out]  pEcspStat       Pointer to the ECSP status structure
- *  @param[in,out]  pPdInfo         Pointer to PD status information
+ *  @param[in,out]  pPdInfo         Pointer to PD status information, may be NULL
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_NOINIT_ERR module not initialised
  *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR no status received yet
+ *  @retval         TRDP_TIMEOUT_ERR status timed out
  *
  */
 EXT_DECL TRDP_ERR_T tau_getEcspStat ( TRDP_APP_SESSION_T   appHandle,
@@ -142,6 +160,48 @@ EXT_DECL TRDP_ERR_T tau_requestEcspConfirm ( TRDP_APP_SESSION_T         appHandl
                                              TRDP_ECSP_CONF_REQUEST_T  *pEcspConfRequest);
 
 
+/**********************************************************************************************************************/
+/**    Function to register a callback for ECSP status changes
+ *
+ *  The callback is called from within tlc_process() whenever the content of the received ECSP status changes
+ *  or its reception times out.
+ *
+ *  @param[in]      appHandle           Application Handle
+ *  @param[in]      pfCbFunction        Pointer to callback function, NULL to unregister
+ *  @param[in]      pRefCon             user reference passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_NOINIT_ERR module not initialised
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_setEcspStatCallback ( TRDP_APP_SESSION_T    appHandle,
+                                              TAU_ECSP_STAT_CB_T    pfCbFunction,
+                                              void                  *pRefCon);
+
+
+/**********************************************************************************************************************/
+/**    Function for an ECSP confirmation/correction request, the decoded reply is passed to a callback
+ *
+ *  The function returns after queueing the request. The callback is called from within tlc_process() with the
+ *  reply, or with NULL and the error on timeout.
+ *
+ *  @param[in]      appHandle           Application Handle
+ *  @param[in]      pEcspConfRequest    Pointer to confirmation data
+ *  @param[in]      pfCbFunction        Pointer to callback function
+ *  @param[in]      pRefCon             user reference passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_NOINIT_ERR module not initialised
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_requestEcspConfirmAsync ( TRDP_APP_SESSION_T                appHandle,
+                                                  const TRDP_ECSP_CONF_REQUEST_T    *pEcspConfRequest,
+                                                  TAU_ECSP_CONF_CB_T                pfCbFunction,
+                                                  void                              *pRefCon);
+
+
 #ifdef __cplusplus
 }
 #endif
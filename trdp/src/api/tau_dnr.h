@@ -59,6 +59,22 @@ typedef enum TRDP_DNR_OPTS {
     TRDP_DNR_OWN_THREAD     = 1,
     TRDP_DNR_STANDARD_DNS   = 2
 } TRDP_DNR_OPTS_T;
+
+/**********************************************************************************************************************/
+/**    Callback delivering the result of tau_uri2AddrAsync().
+ *
+ *  @param[in]    pRefCon       pointer to user context
+ *  @param[in]    appHandle     handle returned by tlc_openSession()
+ *  @param[in]    pUri          the URI which was asked for
+ *  @param[in]    addr          resolved IP address, VOS_INADDR_ANY on error
+ *  @param[in]    result        TRDP_NO_ERR, TRDP_UNRESOLVED_ERR or TRDP_TIMEOUT_ERR
+ */
+typedef void (*TAU_DNR_CALLBACK_T)(
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      addr,
+    TRDP_ERR_T          result);
     
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -70,7 +86,7 @@ typedef enum TRDP_DNR_OPTS {
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *  @param[in]      dnsIpAddr       DNS/ECSP IP address.
  *  @param[in]      dnsPort         DNS port number.
- *  @param[in]      pHostsFileName  Optional host file name as ECSP replacement/addition.
+ *  @param[in]      pHostsFileName  Optional host file name as ECSP replacement/addition. May be a binary hosts image.
  *  @param[in]      dnsOptions      Use existing thread (recommended), use own tlc_process loop or use standard DNS
  *
  *  @retval         TRDP_NO_ERR     no error
@@ -84,8 +100,50 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
     const CHAR8         *pHostsFileName,
     TRDP_DNR_OPTS_T     dnsOptions);
 
+/**********************************************************************************************************************/
+/**    Function to init DNR with its cache in shared memory
+ *  Processes using the same pCacheName share the resolved addresses, only URIs unknown to all are asked for.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      dnsIpAddr       DNS/ECSP IP address.
+ *  @param[in]      dnsPort         DNS port number.
+ *  @param[in]      pHostsFileName  Optional host file name as ECSP replacement/addition. May be a binary hosts image.
+ *  @param[in]      dnsOptions      Use existing thread (recommended), use own tlc_process loop or use standard DNS
+ *  @param[in]      pCacheName      Name of the shared memory area, NULL for a cache private to the process
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_MEM_ERR    out of memory or shared memory not available
+ *  @retval         TRDP_INIT_ERR   the shared memory area has a different layout
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_initSharedDnr (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      dnsIpAddr,
+    UINT16              dnsPort,
+    const CHAR8         *pHostsFileName,
+    TRDP_DNR_OPTS_T     dnsOptions,
+    const CHAR8         *pCacheName);
+
+/**********************************************************************************************************************/
+/**    Function to use the DNR of another session
+ *  Both sessions use one cache and one resolver, until the last of them calls tau_deInitDnr().
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession(), without DNR
+ *  @param[in]      dnrHandle       Session initialised by tau_initDnr() or tau_initSharedDnr()
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_MUTEX_ERR  mutex error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_shareDnr (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_APP_SESSION_T  dnrHandle);
+
 /**********************************************************************************************************************/
 /**    Release any resources allocated by DNR
+ *  Shared by several sessions, they are released with the last one.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *
@@ -96,6 +154,24 @@ EXT_DECL void tau_deInitDnr (
     TRDP_APP_SESSION_T appHandle);
 
 
+/**********************************************************************************************************************/
+/**    Function to write the hosts read by tau_initDnr() as binary hosts image.
+ *  The image can be passed to tau_initDnr() instead of a hosts file. It is loaded without parsing and sorting, which
+ *  pays off for hosts files with thousands of entries.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession().
+ *  @param[in]      pImageFileName      Name of the image file to write
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error or no hosts file read
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         TRDP_IO_ERR     file could not be written
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_writeHostsImage (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pImageFileName);
+
 /**********************************************************************************************************************/
 /**    Function to get the status of DNR
  *
@@ -164,6 +240,41 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     const TRDP_URI_T     pUri);
 
 
+/**********************************************************************************************************************/
+/**    Function to convert a URI to an IP address without waiting for the resolver.
+ *  If the address is known, the callback is called before this function returns. Otherwise the URI is queued and
+ *  the callback is called when the reply arrives. All URIs queued while a TCN-DNS request is outstanding are asked
+ *  for with one request, standard DNS queries are sent at once and answered in parallel.
+ *  TCN-DNS replies are delivered by tlc_process(), standard DNS replies by tau_processDnr().
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      pUri            Pointer to a URI or an IP Address string, NULL==own URI
+ *  @param[in]      pfCbFunction    Callback to receive the address
+ *  @param[in]      pRefCon         User context passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_MEM_ERR    no room for the request
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrAsync (
+    TRDP_APP_SESSION_T   appHandle,
+    const TRDP_URI_T     pUri,
+    TAU_DNR_CALLBACK_T   pfCbFunction,
+    void                *pRefCon);
+
+
+/**********************************************************************************************************************/
+/**    Function to deliver the results of asynchronous standard DNS requests.
+ *  Should be called cyclically when tau_uri2AddrAsync() is used with TRDP_DNR_STANDARD_DNS.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *
+ */
+EXT_DECL void tau_processDnr (
+    TRDP_APP_SESSION_T   appHandle);
+
+
 /**********************************************************************************************************************/
 /**    Function to convert an IP address to a URI.
  *  Receives an IP-Address and translates it into the host part of the corresponding URI.
@@ -0,0 +1,188 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_hist.h
+ *
+ * @brief           TRDP utility interface definitions
+ *
+ * @details         This module provides the interface to the following utilities
+ *                  - columnar history store of PD telegrams
+ *
+ *                  Telegrams handed to tau_histLog() are only copied to a queue. A background thread sorts them
+ *                  by ComId and, using the dataset definitions read by tau_xml, splits their payload in network
+ *                  format into one column per dataset element. Every rowsPerChunk telegrams of a ComId the columns
+ *                  are compressed and written to the file as one chunk. Nothing is unmarshalled.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TAU_HIST_H
+#define TAU_HIST_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_HIST_ROWS_DEFAULT       256u                /**< telegrams of a ComId per chunk                 */
+#define TAU_HIST_QUEUE_DEFAULT      (1024u * 1024u)     /**< bytes queued between two runs of the thread    */
+#define TAU_HIST_INTERVAL_DEFAULT   100000u             /**< us between two runs of the thread              */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/**    Configuration of a history store    */
+typedef struct
+{
+    UINT32                      numComId;       /**< number of entries in pComIdDsIdMap                         */
+    const TRDP_COMID_DSID_MAP_T *pComIdDsIdMap; /**< ComId - dataset map, as read by tau_readXmlDatasetConfig   */
+    UINT32                      numDataset;     /**< number of entries in apDataset                             */
+    TRDP_DATASET_T              * *apDataset;   /**< datasets, as read by tau_readXmlDatasetConfig              */
+    UINT32                      rowsPerChunk;   /**< telegrams of a ComId per chunk, 0 = default                */
+    UINT32                      queueSize;      /**< bytes queued between two runs of the thread, 0 = default  */
+    UINT32                      interval;       /**< us between two runs of the thread, 0 = default             */
+} TAU_HIST_CONFIG_T;
+
+/**    Counters of a history store    */
+typedef struct
+{
+    UINT32  numLogged;                          /**< telegrams queued                                           */
+    UINT32  numDropped;                         /**< telegrams dropped, queue full                              */
+    UINT32  numChunks;                          /**< chunks written                                             */
+    UINT64  bytesLogged;                        /**< payload bytes queued                                       */
+    UINT64  bytesWritten;                       /**< bytes written to the file                                  */
+} TAU_HIST_STATS_T;
+
+/**    Handle of a history store    */
+typedef struct TAU_HIST *TAU_HIST_T;
+
+/**********************************************************************************************************************/
+/**    Callback for every telegram read by tau_histRead().
+ *
+ *  @param[in]    pRefCon       pointer to user context
+ *  @param[in]    comId         ComId of the telegram
+ *  @param[in]    pTime         time of tau_histLog() (s since 1970 with us)
+ *  @param[in]    srcIpAddr     source IP address passed to tau_histLog()
+ *  @param[in]    pData         payload in network format
+ *  @param[in]    dataSize      size of the payload
+ */
+typedef void (*TAU_HIST_CALLBACK_T)(
+    void                *pRefCon,
+    UINT32              comId,
+    const TRDP_TIME_T   *pTime,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    const UINT8         *pData,
+    UINT32              dataSize);
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Create a history store and start its thread.
+ *  The dataset definitions must stay valid until tau_histClose(). ComIds without a dataset of fixed size, and
+ *  telegrams not matching the size of their dataset, are stored as one column of bytes.
+ *
+ *  @param[out]     pHist           pointer to return the handle
+ *  @param[in]      pFileName       name of the file, it is replaced
+ *  @param[in]      pConfig         configuration
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         TRDP_IO_ERR     file could not be created
+ *  @retval         TRDP_THREAD_ERR thread could not be started
+ */
+EXT_DECL TRDP_ERR_T tau_histOpen (
+    TAU_HIST_T              *pHist,
+    const CHAR8             *pFileName,
+    const TAU_HIST_CONFIG_T *pConfig);
+
+/**********************************************************************************************************************/
+/**    Log a telegram.
+ *  The payload is copied to the queue, e.g. from the PD callback or after tlp_get(). Thread safe.
+ *
+ *  @param[in]      hist            handle returned by tau_histOpen()
+ *  @param[in]      comId           ComId of the telegram
+ *  @param[in]      srcIpAddr       source IP address
+ *  @param[in]      pData           payload in network format
+ *  @param[in]      dataSize        size of the payload
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_QUEUE_FULL_ERR queue full, telegram dropped
+ */
+EXT_DECL TRDP_ERR_T tau_histLog (
+    TAU_HIST_T      hist,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    const UINT8     *pData,
+    UINT32          dataSize);
+
+/**********************************************************************************************************************/
+/**    Get the counters of a history store.
+ *
+ *  @param[in]      hist            handle returned by tau_histOpen()
+ *  @param[out]     pStats          the counters
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ */
+EXT_DECL TRDP_ERR_T tau_histGetStatistics (
+    TAU_HIST_T          hist,
+    TAU_HIST_STATS_T    *pStats);
+
+/**********************************************************************************************************************/
+/**    Write all logged telegrams, stop the thread, close the file.
+ *
+ *  @param[in]      hist            handle returned by tau_histOpen()
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_IO_ERR     file could not be written
+ */
+EXT_DECL TRDP_ERR_T tau_histClose (
+    TAU_HIST_T hist);
+
+/**********************************************************************************************************************/
+/**    Read a history file.
+ *  The telegrams are delivered per chunk, i.e. in order per ComId.
+ *
+ *  @param[in]      pFileName       name of the file
+ *  @param[in]      pfCallback      called for every telegram
+ *  @param[in]      pRefCon         user context passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_IO_ERR     file could not be read
+ *  @retval         TRDP_WIRE_ERR   file corrupt
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_histRead (
+    const CHAR8         *pFileName,
+    TAU_HIST_CALLBACK_T pfCallback,
+    void                *pRefCon);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_HIST_H */
@@ -45,12 +45,46 @@ extern "C" {
 
 #define TAU_MAX_DS_LEVEL  5
 
+/** Precompile datasets without variable sized elements into flat marshalling plans at tau_initMarshall(),
+    and all datasets into size descriptors for tau_calcDatasetSize() */
+#ifndef TAU_MARSHALL_PLAN
+#define TAU_MARSHALL_PLAN 1
+#endif
+
+/** Use SSSE3/AVX2/NEON kernels to convert long arrays of 16/32/64 bit items, if supported by the CPU */
+#ifndef TAU_MARSHALL_SIMD
+#define TAU_MARSHALL_SIMD 1
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
 /** Types for marshalling / unmarshalling    */
 
+/** Generated conversion of one dataset, see trdp-xml2c. The buffers have the sizes given in TAU_DS_CODEC_T   */
+typedef void (*TAU_DS_CONVERT_T)(
+    const UINT8 *pSrc,
+    UINT8       *pDst);
+
+/** Generated marshalling functions of a dataset of fixed size, registered by tau_registerCodecs()  */
+typedef struct
+{
+    UINT32              datasetId;      /**< dataset the functions were generated for                   */
+    UINT32              hostSize;       /**< host bytes, as tau_unmarshall() would return               */
+    UINT32              wireSize;       /**< wire bytes, as tau_marshall() would return                 */
+    UINT32              alignment;      /**< alignment of the host structure                            */
+    TAU_DS_CONVERT_T    pfMarshall;     /**< host structure to wire format                              */
+    TAU_DS_CONVERT_T    pfUnmarshall;   /**< wire format to host structure                              */
+} TAU_DS_CODEC_T;
+
+/** Loader of a dataset given as stub to tau_initMarshallLazy(), e.g. tau_loadXmlDataset(). The dataset returned must
+    be allocated with vos_memAlloc(), it replaces the stub in the tables and is freed with them    */
+typedef TRDP_ERR_T (*TAU_DS_LOAD_T)(
+    void            *pLoadRef,
+    UINT32          datasetId,
+    TRDP_DATASET_T  * *ppDataset);
+
 /***********************************************************************************************************************
  * PROTOTYPES
  */
@@ -61,7 +95,8 @@ extern "C" {
 
 /**********************************************************************************************************************/
 /**    Function to initialise the marshalling/unmarshalling.
- *
+ *  Each set of tables gets its own context, the reference context selects it. Marshalling with different contexts
+ *  (e.g. one per session) can run concurrently; NULL as reference context uses the most recently initialised one.
  *
  *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
  *  @param[in]      numComId         Number of datasets found in the configuration
@@ -82,6 +117,87 @@ EXT_DECL TRDP_ERR_T tau_initMarshall(
     UINT32 numDataSet,
     TRDP_DATASET_T         * pDataset[]);
 
+/**********************************************************************************************************************/
+/**    Function to initialise the marshalling/unmarshalling with datasets loaded on first use.
+ *  Datasets without elements are stubs holding only their id, pfLoad replaces them when a marshalling function
+ *  needs them first and their plans are compiled then. Such a context writes its tables on first use and
+ *  must not be shared between threads.
+ *
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to complete datasets or stubs
+ *  @param[in]      pfLoad           Function loading a dataset by its id
+ *  @param[in]      pLoadRef         Reference passed to pfLoad
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     out of memory
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_initMarshallLazy(
+    void * *ppRefCon,
+    UINT32 numComId,
+    TRDP_COMID_DSID_MAP_T  * pComIdDsIdMap,
+    UINT32 numDataSet,
+    TRDP_DATASET_T         * pDataset[],
+    TAU_DS_LOAD_T pfLoad,
+    void *pLoadRef);
+
+/**********************************************************************************************************************/
+/**    Release a marshalling context.
+ *
+ *  @param[in]      pRefCon          reference context returned by tau_initMarshall()
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_PARAM_ERR   unknown reference context
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_deInitMarshall(
+    void *pRefCon);
+
+/**********************************************************************************************************************/
+/**    Register generated marshalling functions with a marshalling context.
+ *  The marshalling functions use them instead of the interpreter for the datasets given, as long as the buffers
+ *  are large enough and the host structure is aligned. The table must stay valid while the context is in use,
+ *  tau_initMarshall() with the same tables drops the registrations.
+ *
+ *  @param[in]      pRefCon          reference context returned by tau_initMarshall()
+ *  @param[in]      numCodecs        number of entries in pCodecs
+ *  @param[in]      pCodecs          table of generated functions
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_INIT_ERR    marshalling not initialised or built without TAU_MARSHALL_PLAN
+ *  @retval         TRDP_PARAM_ERR   at least one entry does not match its dataset and was not registered
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_registerCodecs(
+    void                    *pRefCon,
+    UINT32                  numCodecs,
+    const TAU_DS_CODEC_T    *pCodecs);
+
+/**********************************************************************************************************************/
+/**    Convert an array of 16, 32 or 64 bit items between host and network byte order.
+ *  Long arrays are converted by the vector kernels of the marshalling, generated marshalling functions use it
+ *  for their arrays.
+ *
+ *  @param[out]     pDst             destination, may equal pSrc
+ *  @param[in]      pSrc             source
+ *  @param[in]      noOfItems        number of items
+ *  @param[in]      itemSize         2, 4 or 8
+ *
+ */
+
+EXT_DECL void tau_swapItems(
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems,
+    UINT32      itemSize);
+
 
 
 /**********************************************************************************************************************/
@@ -253,6 +369,26 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSizeByComId (
     UINT32          *pDestSize,
     TRDP_DATASET_T  * *ppDSPointer);
 
+/**********************************************************************************************************************/
+/**    Return the dataset of a comId.
+ *  The result can be kept by the caller and passed as cached dataset to the marshalling functions.
+ *
+ *  @param[in]      pRefCon         pointer to user context
+ *  @param[in]      comId           ComId to identify the structure out of a configuration
+ *  @param[out]     ppDataset       pointer to return the dataset
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_INIT_ERR   marshalling not initialised
+ *  @retval         TRDP_COMID_ERR  comid not existing
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_lookupDataset (
+    void            *pRefCon,
+    UINT32          comId,
+    TRDP_DATASET_T  * *ppDataset);
+
 
 #ifdef __cplusplus
 }
@@ -48,6 +48,20 @@ extern "C" {
  * TYPEDEFS
  */
 
+/** Read-only view of a cached consist info, see tau_openCstView().
+    The lists are read from the received telegram, all multi-byte fields are in network byte order. */
+typedef struct
+{
+    const TRDP_CONSIST_INFO_T   *pCstInfo;      /**< consist info in network format, up to cstProp valid    */
+    UINT32                      size;           /**< size of the consist info                               */
+    UINT16                      etbCnt;         /**< number of ETB infos                                    */
+    UINT16                      vehCnt;         /**< number of vehicle infos                                */
+    UINT16                      fctCnt;         /**< number of function infos                               */
+    UINT16                      cltrCstCnt;     /**< number of closed train consist infos                   */
+    UINT32                      cstTopoCnt;     /**< consist topology counter (host byte order)             */
+    const void                  *pSnap;         /**< TTDB snapshot held by the view (internal)              */
+    const void                  *pEntry;        /**< cached consist info and its offsets (internal)         */
+} TAU_CST_VIEW_T;
 
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -307,6 +321,100 @@ EXT_DECL TRDP_ERR_T tau_getCstInfo (
     const TRDP_LABEL_T      pCstLabel);
 
 
+/**********************************************************************************************************************/
+/**    Function to open a view of the consist information of a train's consist without copying it.
+ *  The view refers to the received telegram; it stays valid and unchanged, even across an inauguration, until
+ *  tau_closeCstView() is called.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[out]     pView           Pointer to the view to be returned.
+ *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR Try again
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_openCstView (
+    TRDP_APP_SESSION_T      appHandle,
+    TAU_CST_VIEW_T          *pView,
+    const TRDP_LABEL_T      pCstLabel);
+
+/**********************************************************************************************************************/
+/**    Function to release a view opened by tau_openCstView().
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *
+ */
+EXT_DECL void tau_closeCstView (
+    TAU_CST_VIEW_T          *pView);
+
+/**********************************************************************************************************************/
+/**    Function to access an ETB info of a consist view.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      etbNo           Position in the list, 0..etbCnt - 1.
+ *
+ *  @retval         ETB info in network format, NULL if out of range
+ *
+ */
+EXT_DECL const TRDP_ETB_INFO_T *tau_cstViewEtb (
+    const TAU_CST_VIEW_T    *pView,
+    UINT16                  etbNo);
+
+/**********************************************************************************************************************/
+/**    Function to access a vehicle info of a consist view.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      vehNo           Position in the list, 0..vehCnt - 1.
+ *
+ *  @retval         vehicle info in network format, its vehProp.len octets of properties, NULL if out of range
+ *
+ */
+EXT_DECL const TRDP_VEHICLE_INFO_T *tau_cstViewVeh (
+    const TAU_CST_VIEW_T    *pView,
+    UINT16                  vehNo);
+
+/**********************************************************************************************************************/
+/**    Function to find a vehicle info of a consist view by its label.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      pVehLabel       Pointer to a vehicle label.
+ *
+ *  @retval         vehicle info in network format, NULL if not found
+ *
+ */
+EXT_DECL const TRDP_VEHICLE_INFO_T *tau_cstViewFindVeh (
+    const TAU_CST_VIEW_T    *pView,
+    const TRDP_LABEL_T      pVehLabel);
+
+/**********************************************************************************************************************/
+/**    Function to access a function info of a consist view.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      fctNo           Position in the list, 0..fctCnt - 1.
+ *
+ *  @retval         function info in network format, NULL if out of range
+ *
+ */
+EXT_DECL const TRDP_FUNCTION_INFO_T *tau_cstViewFct (
+    const TAU_CST_VIEW_T    *pView,
+    UINT16                  fctNo);
+
+/**********************************************************************************************************************/
+/**    Function to access a closed train consist info of a consist view.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      cltrCstNo       Position in the list, 0..cltrCstCnt - 1.
+ *
+ *  @retval         closed train consist info in network format, NULL if out of range
+ *
+ */
+EXT_DECL const TRDP_CLTR_CST_INFO_T *tau_cstViewCltrCst (
+    const TAU_CST_VIEW_T    *pView,
+    UINT16                  cltrCstNo);
+
+
 /* ---------------------------------------------------------------------------- */
 
 
@@ -59,21 +59,7 @@ typedef enum
     TRDP_EXCHG_SOURCESINK   = 3     /**< telegram shall be published and subscribed  */
 } TRDP_EXCHG_OPTION_T;
 
-/** Types to read out the XML configuration    */
-typedef struct
-{
-    UINT32  smi1;        /**< Safe message identifier - unique for this message at consist level */
-    UINT32  smi2;        /**< Safe message identifier - unique for this message at consist level */
-    UINT32  cmThr;       /**< Channel monitoring threshold */
-    UINT16  udv;         /**< User data version */
-    UINT16  rxPeriod;    /**< Sink cycle time */
-    UINT16  txPeriod;    /**< Source cycle time */
-    UINT16  nGuard;      /**< Initial timeout cycles */
-    UINT8   nrxSafe;     /**< Timout cycles */
-    UINT8   reserved1;   /**< Reserved for future use */
-    UINT16  reserved2;   /**< Reserved for future use */
-} TRDP_SDT_PAR_T;
-
+/** Types to read out the XML configuration (TRDP_SDT_PAR_T is declared in trdp_types.h)   */
 typedef struct
 {
     UINT32              cycle;     /**< Interval for push data in us */
@@ -81,7 +67,7 @@ typedef struct
     UINT32              timeout;   /**< Timeout value in us, before considering received process data invalid */
     TRDP_TO_BEHAVIOR_T  toBehav;   /**< Behavior when received process data is invalid/timed out. */
     TRDP_FLAGS_T        flags;     /**< TRDP_FLAGS_MARSHALL, TRDP_FLAGS_REDUNDANT */
-    UINT16              offset;    /**< Offset-address for PD in traffic store for ladder topology */
+    UINT32              offset;    /**< Offset-address for PD in traffic store for ladder topology */
 } TRDP_PD_PAR_T;
 
 typedef struct
@@ -173,6 +159,38 @@ typedef struct
     struct XML_HANDLE *pXmlDocument;           /**< XML document context */
 } TRDP_XML_DOC_HANDLE_T;
 
+/** Dataset definitions kept as text by tau_readXmlDatasetIndex, parsed by tau_loadXmlDataset on first use
+ */
+typedef struct TAU_XML_DS_SOURCE TAU_XML_DS_SOURCE_T;
+
+
+/** Configuration of one interface, as read by tau_readXmlConfig
+ */
+typedef struct
+{
+    TRDP_IF_CONFIG_T        ifConfig;       /**< interface name and addresses */
+    TRDP_PROCESS_CONFIG_T   processConfig;  /**< TRDP process (session) configuration */
+    TRDP_PD_CONFIG_T        pdConfig;       /**< PD default configuration */
+    TRDP_MD_CONFIG_T        mdConfig;       /**< MD default configuration */
+    UINT32                  numExchgPar;    /**< number of configured telegrams */
+    TRDP_EXCHG_PAR_T        *pExchgPar;     /**< array of telegram configurations */
+} TRDP_XML_IF_T;
+
+/** Complete device configuration, as read by tau_readXmlConfig or tau_loadXmlConfig
+ */
+typedef struct
+{
+    TRDP_MEM_CONFIG_T       memConfig;      /**< memory configuration */
+    TRDP_DBG_CONFIG_T       dbgConfig;      /**< debug printout configuration */
+    UINT32                  numComPar;      /**< number of com parameters */
+    TRDP_COM_PAR_T          *pComPar;       /**< array of com parameters */
+    UINT32                  numIf;          /**< number of interfaces */
+    TRDP_XML_IF_T           *pIf;           /**< array of interface configurations */
+    UINT32                  numComId;       /**< number of ComId - dataset mappings */
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap; /**< array of ComId - dataset mappings */
+    UINT32                  numDataset;     /**< number of datasets */
+    apTRDP_DATASET_T        apDataset;      /**< array of dataset pointers */
+} TRDP_XML_CONFIG_T;
 
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -200,6 +218,26 @@ EXT_DECL TRDP_ERR_T tau_prepareXmlDoc (
     TRDP_XML_DOC_HANDLE_T   *pDocHnd
     );
 
+/**********************************************************************************************************************/
+/**    Prepare parsing of an XML configuration held in memory.
+ *     The document is not copied, it must stay valid until tau_freeXmlDoc is called.
+ *
+ *
+ *  @param[in]      pBuffer           XML document
+ *  @param[in]      bufSize           Size of the XML document in bytes
+ *  @param[out]     pDocHnd           Handle of the parsed XML document
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    no document or handle given
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_prepareXmlMem (
+    const CHAR8             *pBuffer,
+    UINT32                  bufSize,
+    TRDP_XML_DOC_HANDLE_T   *pDocHnd
+    );
+
 /**********************************************************************************************************************/
 /**    Free all the memory allocated by tau_prepareXmlDoc
  *
@@ -308,6 +346,60 @@ EXT_DECL void tau_freeXmlDatasetConfig (
     UINT32                  numDataset,
     TRDP_DATASET_T          * *pNumDataset);
 
+/**********************************************************************************************************************/
+/**    Function to read the ComId DatasetId mapping and an index of the datasets out of the XML configuration file.
+ *  The datasets are returned as stubs holding only their id, the text of the dataset list is copied into the
+ *  source. tau_initMarshallLazy() with tau_loadXmlDataset() and the source parses a dataset when it is used first.
+ *  The tables are released with tau_freeXmlDatasetConfig, the source with tau_freeXmlDatasetSource.
+ *
+ *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
+ *  @param[out]     pNumComId         Pointer to the number of entries in the ComId DatasetId mapping list
+ *  @param[out]     ppComIdDsIdMap    Pointer to an array of a structures of type TRDP_COMID_DSID_MAP_T
+ *  @param[out]     pNumDataset       Pointer to the number of datasets found in the configuration
+ *  @param[out]     papDataset        Pointer to an array of pointers to dataset stubs
+ *  @param[out]     ppSource          Pointer to the source of the datasets
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_IO_ERR       the dataset list could not be read
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_readXmlDatasetIndex (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    UINT32                      *pNumComId,
+    TRDP_COMID_DSID_MAP_T       * *ppComIdDsIdMap,
+    UINT32                      *pNumDataset,
+    papTRDP_DATASET_T           papDataset,
+    TAU_XML_DS_SOURCE_T         * *ppSource);
+
+/**********************************************************************************************************************/
+/**    Parse one dataset of a source read by tau_readXmlDatasetIndex, a TAU_DS_LOAD_T for tau_initMarshallLazy().
+ *
+ *  @param[in]      pSource           Source of the datasets
+ *  @param[in]      datasetId         Id of the dataset
+ *  @param[out]     ppDataset         Returns the dataset, allocated in one block with its elements
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    dataset not in the source
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_loadXmlDataset (
+    void            *pSource,
+    UINT32          datasetId,
+    TRDP_DATASET_T  * *ppDataset);
+
+/**********************************************************************************************************************/
+/**    Free a source read by tau_readXmlDatasetIndex
+ *
+ *  @param[in]      pSource           Source of the datasets, may be NULL
+ *
+ */
+EXT_DECL void tau_freeXmlDatasetSource (
+    TAU_XML_DS_SOURCE_T *pSource);
+
 /**********************************************************************************************************************/
 /**    Free array of telegram configurations allocated by tau_readXmlInterfaceConfig
  *
@@ -319,6 +411,54 @@ EXT_DECL void tau_freeTelegrams (
     UINT32              numExchgPar,
     TRDP_EXCHG_PAR_T    *pExchgPar);
 
+/**********************************************************************************************************************/
+/**    Read the complete configuration (device, all interfaces with their telegrams, datasets) in one call.
+ *     The memory must be released with tau_freeXmlConfig.
+ *
+ *
+ *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
+ *  @param[out]     pConfig           Configuration read
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readXmlConfig (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    TRDP_XML_CONFIG_T           *pConfig);
+
+/**********************************************************************************************************************/
+/**    Read the complete configuration, using a binary cache of an earlier parse if it is still valid.
+ *     The cache holds a checksum of the XML file; if it does not match, the XML file is parsed and
+ *     the cache is rewritten. The cache is build specific and must not be shared between targets.
+ *     The memory must be released with tau_freeXmlConfig.
+ *
+ *
+ *  @param[in]      pFileName         Path and filename of the xml configuration file
+ *  @param[in]      pCacheName        Path and filename of the binary cache, NULL to parse only
+ *  @param[out]     pConfig           Configuration read
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    parameter error or XML file not readable
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_loadXmlConfig (
+    const CHAR8         *pFileName,
+    const CHAR8         *pCacheName,
+    TRDP_XML_CONFIG_T   *pConfig);
+
+/**********************************************************************************************************************/
+/**    Free the memory allocated by tau_readXmlConfig or tau_loadXmlConfig
+ *
+ *
+ *  @param[in]      pConfig           Configuration to release
+ *
+ */
+EXT_DECL void tau_freeXmlConfig (
+    TRDP_XML_CONFIG_T *pConfig);
+
 #ifdef __cplusplus
 }
 #endif
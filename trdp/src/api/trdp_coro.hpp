@@ -0,0 +1,501 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_coro.hpp
+ *
+ * @brief           C++20 coroutine adapter for message data (header only)
+ *
+ * @details         MD transactions written as straight line code instead of callback state machines:
+ *
+ *                      trdp::Task client (trdp::MdCaller &caller)
+ *                      {
+ *                          trdp::MdResult result = co_await caller.request(comId, destIp, pData, dataSize);
+ *                          ...
+ *                      }
+ *
+ *                      trdp::Task server (trdp::MdListener &listener)
+ *                      {
+ *                          for (;;)
+ *                          {
+ *                              trdp::MdMessage request = co_await listener.receive();
+ *                              (void) listener.reply(request, 0u, pData, dataSize);
+ *                          }
+ *                      }
+ *
+ *                  The coroutines are resumed from the MD callbacks, i.e. by the thread running tlc_process() (or
+ *                  a callback worker, if the session has them). A suspended transaction costs its coroutine frame
+ *                  and one map entry, no thread. The data of a received message is copied before resuming.
+ *                  Callbacks of sessions which are no longer awaited (e.g. a late timeout) are ignored.
+ *
+ *                  MdCaller and MdListener must outlive the transactions awaited on them: coroutines still waiting
+ *                  when they are destroyed are not resumed. They are neither copyable nor movable, their address
+ *                  is passed to the stack as user reference.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *                  Requires C++20.
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TRDP_CORO_HPP
+#define TRDP_CORO_HPP
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <array>
+#include <coroutine>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <map>
+#include <vector>
+
+#include "trdp_if_light.h"
+
+#if MD_SUPPORT
+
+namespace trdp
+{
+
+/***********************************************************************************************************************
+ * TYPES
+ */
+
+/** Fire and forget coroutine: starts at once, frees itself when it returns    */
+class Task
+{
+public:
+    struct promise_type
+    {
+        Task get_return_object () noexcept { return Task{}; }
+        std::suspend_never initial_suspend () noexcept { return {}; }
+        std::suspend_never final_suspend () noexcept { return {}; }
+        void return_void () noexcept {}
+        void unhandled_exception () noexcept { std::terminate(); }
+    };
+};
+
+/** A received MD message (notification, request, reply or confirm)    */
+struct MdMessage
+{
+    TRDP_MD_INFO_T      info;
+    std::vector<UINT8>  data;
+};
+
+/** Outcome of a request: resultCode of the session end and the replies received until then.
+    With an unknown number of replies (numReplies == 0) a session always ends with TRDP_REPLYTO_ERR  */
+struct MdResult
+{
+    TRDP_ERR_T              resultCode = TRDP_NO_ERR;
+    std::vector<MdMessage>  replies;
+};
+
+namespace detail
+{
+
+using SessionKey = std::array<UINT8, sizeof(TRDP_UUID_T)>;
+
+inline SessionKey sessionKey (const TRDP_UUID_T &sessionId)
+{
+    SessionKey key;
+    std::memcpy(key.data(), &sessionId, key.size());
+    return key;
+}
+
+inline MdMessage copyMessage (const TRDP_MD_INFO_T *pMsg, const UINT8 *pData, UINT32 dataSize)
+{
+    MdMessage msg;
+
+    msg.info = *pMsg;
+    if ((pData != nullptr) && (dataSize > 0u))
+    {
+        msg.data.assign(pData, pData + dataSize);
+    }
+    return msg;
+}
+
+/** Flags of a transaction: always with callback, without the modes handing over other buffers   */
+inline TRDP_FLAGS_T coroFlags (TRDP_FLAGS_T pktFlags, TRDP_FLAGS_T dropFlags)
+{
+    pktFlags = static_cast<TRDP_FLAGS_T>(pktFlags & ~(TRDP_FLAGS_NONE | TRDP_FLAGS_FORCE_CB | dropFlags));
+    return static_cast<TRDP_FLAGS_T>(pktFlags | TRDP_FLAGS_CALLBACK);
+}
+
+}   /* namespace detail */
+
+/***********************************************************************************************************************
+ * CALLER
+ */
+
+/** Sends requests of one TRDP session and resumes the awaiting coroutines with the replies   */
+class MdCaller
+{
+public:
+    /** co_await caller.request(...) yields an MdResult    */
+    class RequestAwaiter
+    {
+    public:
+        bool await_ready () const noexcept { return false; }
+
+        bool await_suspend (std::coroutine_handle<> handle)
+        {
+            TRDP_UUID_T sessionId;
+
+            mResult.resultCode = tlm_request(mpCaller->mAppHandle, mpCaller, &MdCaller::mdCallback, &sessionId,
+                                             mComId, 0u, 0u, mSrcIpAddr, mDestIpAddr, mPktFlags, mNumReplies,
+                                             mReplyTimeout, mpSendParam, mpData, mDataSize, mpSourceURI,
+                                             mpDestURI);
+            if (mResult.resultCode != TRDP_NO_ERR)
+            {
+                return false;       /* not sent, continue at once */
+            }
+            mHandle = handle;
+            mpCaller->mPending[detail::sessionKey(sessionId)] = this;
+            return true;
+        }
+
+        MdResult await_resume () { return std::move(mResult); }
+
+    private:
+        friend class MdCaller;
+
+        RequestAwaiter () = default;
+
+        MdCaller                *mpCaller       = nullptr;
+        UINT32                  mComId          = 0u;
+        TRDP_IP_ADDR_T          mSrcIpAddr      = 0u;
+        TRDP_IP_ADDR_T          mDestIpAddr     = 0u;
+        TRDP_FLAGS_T            mPktFlags       = TRDP_FLAGS_CALLBACK;
+        UINT32                  mNumReplies     = 1u;
+        UINT32                  mReplyTimeout   = 0u;
+        const TRDP_SEND_PARAM_T *mpSendParam    = nullptr;
+        const UINT8             *mpData         = nullptr;
+        UINT32                  mDataSize       = 0u;
+        const CHAR8             *mpSourceURI    = nullptr;
+        const CHAR8             *mpDestURI      = nullptr;
+        std::coroutine_handle<> mHandle;
+        MdResult                mResult;
+    };
+
+    explicit MdCaller (TRDP_APP_SESSION_T appHandle) : mAppHandle(appHandle) {}
+    MdCaller (const MdCaller &) = delete;
+    MdCaller &operator = (const MdCaller &) = delete;
+
+    /** Abort the sessions still open, their coroutines are not resumed  */
+    ~MdCaller ()
+    {
+        for (const auto &pending : mPending)
+        {
+            TRDP_UUID_T sessionId;
+            std::memcpy(&sessionId, pending.first.data(), sizeof(sessionId));
+            (void) tlm_abortSession(mAppHandle, &sessionId);
+        }
+    }
+
+    /** Send a request; parameters as tlm_request. The request data is sent (copied) when the awaiter is
+        co_awaited. TRDP_FLAGS_DEFAULT is not resolved to the session default, pass e.g. TRDP_FLAGS_TCP as needed.
+        Replies with confirmation (Mq) are confirmed with user status 0.  */
+    RequestAwaiter request (UINT32                  comId,
+                            TRDP_IP_ADDR_T          destIpAddr,
+                            const UINT8             *pData,
+                            UINT32                  dataSize,
+                            UINT32                  numReplies = 1u,
+                            UINT32                  replyTimeout = 0u,
+                            TRDP_FLAGS_T            pktFlags = TRDP_FLAGS_NONE,
+                            const TRDP_SEND_PARAM_T *pSendParam = nullptr,
+                            TRDP_IP_ADDR_T          srcIpAddr = 0u,
+                            const CHAR8             *pSourceURI = nullptr,
+                            const CHAR8             *pDestURI = nullptr)
+    {
+        RequestAwaiter awaiter;
+
+        awaiter.mpCaller        = this;
+        awaiter.mComId          = comId;
+        awaiter.mSrcIpAddr      = srcIpAddr;
+        awaiter.mDestIpAddr     = destIpAddr;
+        awaiter.mPktFlags       = detail::coroFlags(pktFlags, TRDP_FLAGS_TCP_NOCOPY | TRDP_FLAGS_MD_COLLECT);
+        awaiter.mNumReplies     = numReplies;
+        awaiter.mReplyTimeout   = replyTimeout;
+        awaiter.mpSendParam     = pSendParam;
+        awaiter.mpData          = pData;
+        awaiter.mDataSize       = dataSize;
+        awaiter.mpSourceURI     = pSourceURI;
+        awaiter.mpDestURI       = pDestURI;
+        return awaiter;
+    }
+
+    /** Number of requests waiting for their replies   */
+    std::size_t pending () const { return mPending.size(); }
+
+private:
+    static void mdCallback (void                    * /* pRefCon */,
+                            TRDP_APP_SESSION_T      appHandle,
+                            const TRDP_MD_INFO_T    *pMsg,
+                            UINT8                   *pData,
+                            UINT32                  dataSize)
+    {
+        MdCaller    *pSelf = static_cast<MdCaller *>(const_cast<void *>(pMsg->pUserRef));
+        auto        it = pSelf->mPending.find(detail::sessionKey(pMsg->sessionId));
+        bool        done;
+
+        if (it == pSelf->mPending.end())
+        {
+            return;     /* session no longer awaited */
+        }
+        RequestAwaiter *pAwaiter = it->second;
+
+        if (pMsg->resultCode != TRDP_NO_ERR)
+        {
+            pAwaiter->mResult.resultCode = pMsg->resultCode;
+            done = true;
+        }
+        else if ((pMsg->msgType == TRDP_MSG_MP) || (pMsg->msgType == TRDP_MSG_MQ))
+        {
+            pAwaiter->mResult.replies.push_back(detail::copyMessage(pMsg, pData, dataSize));
+            done = (pMsg->aboutToDie == TRUE);
+            if (pMsg->msgType == TRDP_MSG_MQ)
+            {
+                (void) tlm_confirm(appHandle, &pMsg->sessionId, 0u, nullptr);
+                /* the stack closes the session silently once the last expected reply is confirmed */
+                done = done || ((pMsg->numExpReplies != 0u) &&
+                                (pMsg->numReplies + pMsg->numRepliesQuery >= pMsg->numExpReplies));
+            }
+        }
+        else
+        {
+            return;     /* e.g. send complete */
+        }
+
+        if (done)
+        {
+            pSelf->mPending.erase(it);
+            pAwaiter->mHandle.resume();
+        }
+    }
+
+    TRDP_APP_SESSION_T                              mAppHandle;
+    std::map<detail::SessionKey, RequestAwaiter *>  mPending;
+};
+
+/***********************************************************************************************************************
+ * LISTENER
+ */
+
+/** Listener of one TRDP session handing notifications and requests to awaiting coroutines    */
+class MdListener
+{
+public:
+    /** co_await listener.receive() yields the next notification or request, in order of arrival   */
+    class ReceiveAwaiter
+    {
+    public:
+        bool await_ready () const noexcept { return !mpListener->mReceived.empty(); }
+
+        void await_suspend (std::coroutine_handle<> handle)
+        {
+            mHandle = handle;
+            mpListener->mReceivers.push_back(this);
+        }
+
+        MdMessage await_resume ()
+        {
+            if (mHandle)
+            {
+                return std::move(mMsg);
+            }
+            MdMessage msg = std::move(mpListener->mReceived.front());
+            mpListener->mReceived.pop_front();
+            return msg;
+        }
+
+    private:
+        friend class MdListener;
+
+        explicit ReceiveAwaiter (MdListener *pListener) : mpListener(pListener) {}
+
+        MdListener              *mpListener;
+        std::coroutine_handle<> mHandle;
+        MdMessage               mMsg;
+    };
+
+    /** co_await listener.replyQuery(...) yields TRDP_NO_ERR when confirmed, else the error (e.g. TRDP_CONFIRMTO_ERR)   */
+    class ConfirmAwaiter
+    {
+    public:
+        bool await_ready () const noexcept { return false; }
+
+        bool await_suspend (std::coroutine_handle<> handle)
+        {
+            mResult = tlm_replyQuery(mpListener->mAppHandle, &mSessionId, mComId, mUserStatus, mConfirmTimeout,
+                                     mpSendParam, mpData, mDataSize);
+            if (mResult != TRDP_NO_ERR)
+            {
+                return false;
+            }
+            mHandle = handle;
+            mpListener->mConfirms[detail::sessionKey(mSessionId)] = this;
+            return true;
+        }
+
+        TRDP_ERR_T await_resume () const noexcept { return mResult; }
+
+    private:
+        friend class MdListener;
+
+        ConfirmAwaiter () = default;
+
+        MdListener              *mpListener     = nullptr;
+        TRDP_UUID_T             mSessionId;
+        UINT32                  mComId          = 0u;
+        UINT16                  mUserStatus     = 0u;
+        UINT32                  mConfirmTimeout = 0u;
+        const TRDP_SEND_PARAM_T *mpSendParam    = nullptr;
+        const UINT8             *mpData         = nullptr;
+        UINT32                  mDataSize       = 0u;
+        std::coroutine_handle<> mHandle;
+        TRDP_ERR_T              mResult         = TRDP_NO_ERR;
+    };
+
+    MdListener () = default;
+    MdListener (const MdListener &) = delete;
+    MdListener &operator = (const MdListener &) = delete;
+    ~MdListener () { (void) remove(); }
+
+    /** Listen to a comId; parameters as tlm_addListener   */
+    TRDP_ERR_T add (TRDP_APP_SESSION_T  appHandle,
+                    UINT32              comId,
+                    TRDP_FLAGS_T        pktFlags = TRDP_FLAGS_NONE,
+                    TRDP_IP_ADDR_T      srcIpAddr1 = 0u,
+                    TRDP_IP_ADDR_T      srcIpAddr2 = 0u,
+                    TRDP_IP_ADDR_T      mcDestIpAddr = 0u,
+                    const CHAR8         *pSrcURI = nullptr,
+                    const CHAR8         *pDestURI = nullptr)
+    {
+        TRDP_ERR_T err;
+
+        if (mHandle != nullptr)
+        {
+            return TRDP_STATE_ERR;
+        }
+        err = tlm_addListener(appHandle, &mHandle, this, &MdListener::mdCallback, TRUE, comId, 0u, 0u, srcIpAddr1,
+                              srcIpAddr2, mcDestIpAddr, detail::coroFlags(pktFlags, TRDP_FLAGS_TCP_STREAM),
+                              pSrcURI, pDestURI);
+        if (err == TRDP_NO_ERR)
+        {
+            mAppHandle = appHandle;
+        }
+        else
+        {
+            mHandle = nullptr;
+        }
+        return err;
+    }
+
+    TRDP_ERR_T remove ()
+    {
+        TRDP_ERR_T err = TRDP_NO_ERR;
+
+        if (mHandle != nullptr)
+        {
+            err         = tlm_delListener(mAppHandle, mHandle);
+            mHandle     = nullptr;
+        }
+        return err;
+    }
+
+    ReceiveAwaiter receive () { return ReceiveAwaiter(this); }
+
+    /** Reply to a request received by receive()    */
+    TRDP_ERR_T reply (const MdMessage           &request,
+                      UINT16                    userStatus,
+                      const UINT8               *pData,
+                      UINT32                    dataSize,
+                      const TRDP_SEND_PARAM_T   *pSendParam = nullptr)
+    {
+        return tlm_reply(mAppHandle, &request.info.sessionId, request.info.comId, userStatus, pSendParam, pData,
+                         dataSize);
+    }
+
+    /** Reply asking for confirmation, resumed by the confirm or its timeout  */
+    ConfirmAwaiter replyQuery (const MdMessage          &request,
+                               UINT16                   userStatus,
+                               UINT32                   confirmTimeout,
+                               const UINT8              *pData,
+                               UINT32                   dataSize,
+                               const TRDP_SEND_PARAM_T  *pSendParam = nullptr)
+    {
+        ConfirmAwaiter awaiter;
+
+        awaiter.mpListener      = this;
+        std::memcpy(&awaiter.mSessionId, &request.info.sessionId, sizeof(TRDP_UUID_T));
+        awaiter.mComId          = request.info.comId;
+        awaiter.mUserStatus     = userStatus;
+        awaiter.mConfirmTimeout = confirmTimeout;
+        awaiter.mpSendParam     = pSendParam;
+        awaiter.mpData          = pData;
+        awaiter.mDataSize       = dataSize;
+        return awaiter;
+    }
+
+    TRDP_LIS_T handle () const { return mHandle; }
+
+private:
+    static void mdCallback (void                    * /* pRefCon */,
+                            TRDP_APP_SESSION_T      /* appHandle */,
+                            const TRDP_MD_INFO_T    *pMsg,
+                            UINT8                   *pData,
+                            UINT32                  dataSize)
+    {
+        MdListener  *pSelf = static_cast<MdListener *>(const_cast<void *>(pMsg->pUserRef));
+        auto        it = pSelf->mConfirms.find(detail::sessionKey(pMsg->sessionId));
+
+        if (it != pSelf->mConfirms.end())
+        {
+            ConfirmAwaiter *pAwaiter = it->second;
+
+            if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType != TRDP_MSG_MC))
+            {
+                return;     /* e.g. send complete of the reply query */
+            }
+            pAwaiter->mResult = pMsg->resultCode;
+            pSelf->mConfirms.erase(it);
+            pAwaiter->mHandle.resume();
+        }
+        else if ((pMsg->resultCode == TRDP_NO_ERR) &&
+                 ((pMsg->msgType == TRDP_MSG_MN) || (pMsg->msgType == TRDP_MSG_MR)))
+        {
+            MdMessage msg = detail::copyMessage(pMsg, pData, dataSize);
+
+            if (pSelf->mReceivers.empty())
+            {
+                pSelf->mReceived.push_back(std::move(msg));
+            }
+            else
+            {
+                ReceiveAwaiter *pAwaiter = pSelf->mReceivers.front();
+
+                pSelf->mReceivers.pop_front();
+                pAwaiter->mMsg = std::move(msg);
+                pAwaiter->mHandle.resume();
+            }
+        }
+    }
+
+    TRDP_APP_SESSION_T                              mAppHandle  = nullptr;
+    TRDP_LIS_T                                      mHandle     = nullptr;
+    std::deque<MdMessage>                           mReceived;
+    std::deque<ReceiveAwaiter *>                    mReceivers;
+    std::map<detail::SessionKey, ConfirmAwaiter *>  mConfirms;
+};
+
+}   /* namespace trdp */
+
+#endif /* MD_SUPPORT */
+
+#endif /* TRDP_CORO_HPP */
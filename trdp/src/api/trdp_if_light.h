@@ -118,6 +118,8 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
  *  Should be called by the application when a link-down/link-up event
  *    has occured during normal operation.
  *    We need to re-join the multicast groups...
+ *    The sockets stay open, every multicast membership of a socket is joined once.
+ *    The duration is reported in the timing statistics (TRDP_TIMING_REINIT).
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
  *
@@ -205,6 +207,39 @@ EXT_DECL TRDP_ERR_T tlc_setOpTrainTopoCount (
 EXT_DECL UINT32     tlc_getOpTrainTopoCount (
     TRDP_APP_SESSION_T  appHandle);
 
+/**********************************************************************************************************************/
+/** Set both topocounts at once, e.g. after an inauguration.
+ *  With TRDP_OPTION_TOPO_FOLLOW, the publishers and subscriptions using the former counters are updated in one pass.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      etbTopoCnt          New ETB topocount value
+ *  @param[in]      opTrnTopoCnt        New operational topocount value
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setTopoCounts (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              etbTopoCnt,
+    UINT32              opTrnTopoCnt);
+
+/**********************************************************************************************************************/
+/** Enter or leave the operational phase.
+ *  Call this when all telegrams are set up. With TRDP_OPTION_PREALLOCATE, the buffers for the configured
+ *  telegrams are allocated now. Allocations while operational are counted (vos_memOperationalAllocs) and,
+ *  depending on VOS_MEM_CHECK_OPERATIONAL, logged or asserted.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      operational         TRUE: start up is done, FALSE: before changing the configuration
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+EXT_DECL TRDP_ERR_T tlc_setOperational (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               operational);
+
 /**********************************************************************************************************************/
 /** Frees the buffer reserved by the TRDP layer.
  *
@@ -225,6 +260,7 @@ EXT_DECL TRDP_ERR_T tlc_freeBuf (
  *  Return the maximum time interval suitable for 'select()' so that we
  *    can send due PD packets in time.
  *    If the PD send queue is empty, return zero time
+ *    If the last tlc_process() call stopped reading at its work budget, the interval is zero
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
  *  @param[out]     pInterval           pointer to needed interval
@@ -246,6 +282,13 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
  *    Search the queue for pending PDs to be sent
  *    Search the receive queue for pending PDs (time out)
  *
+ *  Different sessions can be processed concurrently by different threads: tlc_process() only takes the session's own
+ *  mutex. Each session should use its own marshalling context (tau_initMarshall()) as pRefCon of its
+ *  TRDP_MARSHALL_CONFIG_T.
+ *
+ *  With a work budget (TRDP_PROCESS_CONFIG_T.budgetFrames/budgetTime) the due PDs are sent first, then frames are
+ *  read until the budget is spent. The sockets left are read by the next call, tlc_getInterval() returns a zero
+ *  interval meanwhile.
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
  *  @param[in]      pRfds               pointer to set of ready descriptors
@@ -259,6 +302,84 @@ EXT_DECL TRDP_ERR_T tlc_process (
     TRDP_FDS_T          *pRfds,
     INT32               *pCount);
 
+/**********************************************************************************************************************/
+/** Send the due PDs of the session.
+ *  Together with tlc_processReceive() and tlc_processTimeouts() a replacement of tlc_process(), which allows to send
+ *  and to receive from different threads: the send side of a session has its own lock, tlc_processSend() does not
+ *  wait for receiving, time outs or callbacks of subscribers and listeners. Callbacks of publishers are called with
+ *  the send side locked and must not call functions of the session.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ */
+EXT_DECL TRDP_ERR_T tlc_processSend (
+    TRDP_APP_SESSION_T appHandle);
+
+/**********************************************************************************************************************/
+/** Read the ready sockets of the session (PD unless read by the PD thread, MD).
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      pRfds               pointer to set of ready descriptors (from tlc_getInterval and select)
+ *  @param[in,out]  pCount              pointer to number of ready descriptors
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_processReceive (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_FDS_T          *pRfds,
+    INT32               *pCount);
+
+/**********************************************************************************************************************/
+/** Housekeeping of the session: time outs of subscriptions, sending and time outs of MD, statistics export.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_processTimeouts (
+    TRDP_APP_SESSION_T appHandle);
+
+/**********************************************************************************************************************/
+/** Get the event descriptor and the lowest time interval of the session.
+ *  Alternative to tlc_getInterval() for applications handling many sockets: Instead of a descriptor set, a single
+ *  descriptor (epoll or kqueue) is returned, which becomes readable as soon as one of the session's sockets is
+ *  readable. The application waits on it (select(), poll(), epoll) at most for the returned interval and then calls
+ *  tlc_processEvents(). The descriptor stays the same during the lifetime of the session.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[out]     pInterval           pointer to needed interval
+ *  @param[out]     pEventFd            pointer to the event descriptor
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_SOCK_ERR       event descriptor not supported on this target
+ */
+EXT_DECL TRDP_ERR_T tlc_getEventFd (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TIME_T         *pInterval,
+    SOCKET              *pEventFd);
+
+/**********************************************************************************************************************/
+/** Work loop of the TRDP handler for the event descriptor.
+ *    Same as tlc_process(), but only the sockets reported ready by the session's poll set are read.
+ *    The call does not block, it should be called after the descriptor returned by tlc_getEventFd() became readable
+ *    or the interval expired.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       event descriptor not supported on this target
+ */
+EXT_DECL TRDP_ERR_T tlc_processEvents (
+    TRDP_APP_SESSION_T appHandle);
+
 /**********************************************************************************************************************/
 /** Get the interface address
  *
@@ -315,6 +436,25 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     const UINT8             *pData,
     UINT32                  dataSize);
 
+/**********************************************************************************************************************/
+/** Prepare for sending a set of PD messages.
+ *  Publishes all entries under one session lock. Traffic shaping and the send schedule are updated once
+ *  after the last entry instead of once per publisher.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pEntries            publishers; pubHandle and result are set for each entry
+ *  @param[in]      numEntries          number of entries
+ *
+ *  @retval         TRDP_NO_ERR         all entries published
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               error of the first entry that failed, see the results of the entries
+ */
+EXT_DECL TRDP_ERR_T tlp_publishBatch (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_ENTRY_T    *pEntries,
+    UINT32              numEntries);
+
 /**********************************************************************************************************************/
 /** Prepare for sending PD messages.
  *  Reinitialize and queue a PD message, it will be send when tlc_publish has been called
@@ -378,6 +518,135 @@ EXT_DECL TRDP_ERR_T tlp_put (
     UINT32              dataSize);
 
 
+/**********************************************************************************************************************/
+/** Update the process data of several publishers at once.
+ *  Same as tlp_put for each item, but the session is locked only once. The result of each telegram is returned
+ *  in its item, a failing item does not stop the others.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pItems              array of publisher handles and data, result per item
+ *  @param[in]      numItems            number of items
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               result of the last failing item
+ */
+EXT_DECL TRDP_ERR_T tlp_putMulti (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUT_ITEM_T     *pItems,
+    UINT32              numItems);
+
+
+/**********************************************************************************************************************/
+/** Set the heartbeat of a publisher sending on change (TRDP_FLAGS_PD_ON_CHANGE).
+ *  Unchanged data is sent once per heartbeat, the timeout of the subscribers must be longer than this.
+ *  The heartbeat is rounded down to a multiple of the interval, 0 restores the default of
+ *  TRDP_PD_HEARTBEAT_CYCLES intervals.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pubHandle           the handle returned by publish
+ *  @param[in]      heartbeat           heartbeat in us
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      not published
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_setHeartbeat (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    UINT32              heartbeat);
+
+
+/**********************************************************************************************************************/
+/** Send and receive the PD of a comId range delta encoded.
+ *  Only the runs of data changed since the last key frame are sent, every keyCycles-th frame is sent in full as
+ *  key frame. Delta frames are marked in the reserved field of the PD header, so the receiving devices must set
+ *  the same range. A delta frame arriving before its key frame is counted as missed. Pulled PD is sent in full.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      firstComId          first comId of the range, 0: no delta encoding
+ *  @param[in]      lastComId           last comId of the range
+ *  @param[in]      keyCycles           every n-th frame is a key frame, 0: TRDP_PD_DELTA_KEY_CYCLES (10)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_setDeltaRange (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              firstComId,
+    UINT32              lastComId,
+    UINT32              keyCycles);
+
+
+/**********************************************************************************************************************/
+/** Send a publication on a second interface as well (redundant networks, e.g. ECN A/B).
+ *  The frame is prepared once, with the same sequence counter and CRC, and sent on both interfaces from a socket
+ *  bound to ifaceIp. Pulled PD is sent on the first interface only, send batching is not used for the publisher.
+ *  Subscribers on both networks receive the telegram once with tlp_addRecvInterface().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pubHandle           the handle returned by publish
+ *  @param[in]      ifaceIp             own IP address on the second network, 0: stop sending there
+ *  @param[in]      destIpAddr          destination on the second network, 0: same as published (multicast)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      not published
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       no socket available
+ */
+EXT_DECL TRDP_ERR_T tlp_addSendInterface (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    TRDP_IP_ADDR_T      ifaceIp,
+    TRDP_IP_ADDR_T      destIpAddr);
+
+
+/**********************************************************************************************************************/
+/** Get direct access to the process data to send.
+ *  The data of a published telegram is written in place, no copy is made. The session is locked until
+ *  tlp_commitPut is called from the same thread, so keep the time in between short. The data is sent as written,
+ *  marshalling is not applied.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pubHandle           the handle returned by publish
+ *  @param[out]     ppData              pointer to the data of the frame
+ *  @param[out]     pDataSize           size of the data as published
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      not published
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_STATE_ERR      tlp_beginPut already called
+ */
+EXT_DECL TRDP_ERR_T tlp_beginPut (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    UINT8               **ppData,
+    UINT32              *pDataSize);
+
+
+/**********************************************************************************************************************/
+/** Finish writing the process data to send.
+ *  The data written after tlp_beginPut becomes valid and will be sent earliest when tlc_process is called.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pubHandle           the handle returned by publish
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      not published
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_STATE_ERR      tlp_beginPut not called
+ */
+EXT_DECL TRDP_ERR_T tlp_commitPut (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle);
+
+
 /**********************************************************************************************************************/
 /** Do not send redundant PD's when we are follower.
  *
@@ -413,6 +682,40 @@ EXT_DECL TRDP_ERR_T tlp_getRedundant (
     );
 
 
+/**********************************************************************************************************************/
+/** Limit the number of outstanding PD pull requests.
+ *  Requests of tlp_request() are kept in an index by reply comId and pulled device until their reply arrived or
+ *  the time out of the requesting subscription (default: PD time out of the session) passed. Further requests are
+ *  refused with TRDP_QUEUE_FULL_ERR while the limit is reached.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      maxRequests         max. requests waiting for their reply, 0: no limit
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      pull request index not compiled in
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_setPullLimit (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              maxRequests);
+
+/**********************************************************************************************************************/
+/** Get the number of outstanding and of unanswered PD pull requests.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pNumPending         requests waiting for their reply, may be NULL
+ *  @param[out]     pNumExpired         requests to single devices dropped unanswered, may be NULL
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      pull request index not compiled in
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_getPullStatus (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              *pNumPending,
+    UINT32              *pNumExpired);
+
+
 /**********************************************************************************************************************/
 /** Initiate sending PD messages (PULL).
  *  Send a PD request message
@@ -436,6 +739,7 @@ EXT_DECL TRDP_ERR_T tlp_getRedundant (
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        could not insert (out of memory)
+ *  @retval         TRDP_QUEUE_FULL_ERR too many requests outstanding (tlp_setPullLimit)
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
 EXT_DECL TRDP_ERR_T tlp_request (
@@ -495,6 +799,24 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     TRDP_TO_BEHAVIOR_T  toBehavior);
 
 
+/**********************************************************************************************************************/
+/** Prepare for receiving a set of PD messages.
+ *  Subscribes all entries under one session lock.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pEntries            subscribers; subHandle and result are set for each entry
+ *  @param[in]      numEntries          number of entries
+ *
+ *  @retval         TRDP_NO_ERR         all entries subscribed
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               error of the first entry that failed, see the results of the entries
+ */
+EXT_DECL TRDP_ERR_T tlp_subscribeBatch (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_ENTRY_T    *pEntries,
+    UINT32              numEntries);
+
 /**********************************************************************************************************************/
 /** Reprepare for receiving PD messages.
  *  Resubscribe to a specific PD ComID and source IP
@@ -522,6 +844,53 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
     TRDP_IP_ADDR_T      destIpAddr);
 
 
+/**********************************************************************************************************************/
+/** Set the priority of a subscription.
+ *  The sockets of subscriptions with a higher priority are read first, so under load their frames are handled
+ *  before the others. Publishers take their priority from the QoS of their send parameters, due PD of a higher
+ *  priority is sent first. Subscriptions start with the QoS of the session's PD defaults.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           handle for this subscription
+ *  @param[in]      prio                priority 0 (lowest) .. 7 (highest), like the QoS of the sender
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_setPriority (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    UINT8               prio);
+
+
+/**********************************************************************************************************************/
+/** Receive a subscription on a second interface as well (redundant networks, e.g. ECN A/B).
+ *  A multicast group of the subscription is joined on ifaceIp too; unicast telegrams of the second network are
+ *  only received if the session is not bound to the address of the first interface. Telegrams from srcIpAddr count
+ *  as sent by the source of the subscription: the copy arriving first is taken, the other one is dropped as
+ *  duplicate by its sequence counter. The subscription must have a single source IP address. Call it again after
+ *  tlp_resubscribe().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           handle for this subscription
+ *  @param[in]      ifaceIp             own IP address on the second network, 0: stop receiving there
+ *  @param[in]      srcIpAddr           IP address of the publisher on the second network
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       multicast group could not be joined
+ */
+EXT_DECL TRDP_ERR_T tlp_addRecvInterface (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_IP_ADDR_T      ifaceIp,
+    TRDP_IP_ADDR_T      srcIpAddr);
+
+
 /**********************************************************************************************************************/
 /** Stop receiving PD messages.
  *  Unsubscribe to a specific PD ComID
@@ -539,6 +908,51 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
     TRDP_SUB_T          subHandle);
 
 
+/**********************************************************************************************************************/
+/** Add a consumer to a subscription.
+ *  The callback of the consumer is called after the one of the subscription, with the same received data and
+ *  pUserRef of the consumer. Several consumers of a telegram share one subscription, the frame is looked up,
+ *  checked and stored once. The subscription must have been made with TRDP_FLAGS_CALLBACK, the callbacks of a
+ *  subscription must not unsubscribe it nor remove its consumers.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle for this subscription
+ *  @param[in]      pUserRef            user supplied value returned with the received data
+ *  @param[in]      pfCbFunction        callback of the consumer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, subscription without TRDP_FLAGS_CALLBACK
+ *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_addConsumer (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    const void          *pUserRef,
+    TRDP_PD_CALLBACK_T  pfCbFunction);
+
+
+/**********************************************************************************************************************/
+/** Remove a consumer added with tlp_addConsumer.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle for this subscription
+ *  @param[in]      pUserRef            user reference of the consumer
+ *  @param[in]      pfCbFunction        callback of the consumer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, no such consumer
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_delConsumer (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    const void          *pUserRef,
+    TRDP_PD_CALLBACK_T  pfCbFunction);
+
+
 /**********************************************************************************************************************/
 /** Get the last valid PD message.
  *  This allows polling of PDs instead of event driven handling by callback
@@ -553,6 +967,7 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_SUB_ERR        not subscribed
  *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_SAFETY_ERR     vital data not valid (see tlp_getSdtStatus), data not copied
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  *  @retval         TRDP_COMID_ERR      ComID not found when marshalling
  */
@@ -564,6 +979,207 @@ EXT_DECL TRDP_ERR_T tlp_get (
     UINT32              *pDataSize);
 
 
+/**********************************************************************************************************************/
+/** Get the last valid PD messages of several subscriptions at once.
+ *  Same as tlp_get for each item, but the session is locked only once and, in polling mode, each socket is read
+ *  once. Subscriptions received by the PD thread are copied from their snapshot without locking. The result and
+ *  PD info of each telegram are returned in its item.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pItems              array of subscriber handles and buffers, result and info per item
+ *  @param[in]      numItems            number of items
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               result of the last failing item
+ */
+EXT_DECL TRDP_ERR_T tlp_getMulti (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_GET_ITEM_T     *pItems,
+    UINT32              numItems);
+
+
+/**********************************************************************************************************************/
+/** Create a subscription group.
+ *  The latest frames of the group's subscriptions are copied into one of two buffers of the group at the end of each
+ *  receive pass in which one of them received a frame (tlc_process, tlc_processEvents, the PD receive thread or the
+ *  socket reads of tlp_get in polling mode). tlp_getSubGroup() reads all of them from the same pass.
+ *  Vital subscriptions (tlp_setSdt) cannot be members.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pGroupHandle        returned handle of the group
+ *  @param[in]      pSubHandles         the subscriptions of the group
+ *  @param[in]      numSubs             number of subscriptions, 1...64
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, vital subscription
+ *  @retval         TRDP_NOSUB_ERR      a handle is no subscription
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_createSubGroup (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_GROUP_T    *pGroupHandle,
+    const TRDP_SUB_T    *pSubHandles,
+    UINT32              numSubs);
+
+/**********************************************************************************************************************/
+/** Get the data of a subscription group from the same receive pass.
+ *  Items as for tlp_getMulti, each naming a subscription of the group, in any order. The session is not locked if
+ *  the target has atomic built-ins (the copy is repeated if a receive pass published meanwhile), the sockets are
+ *  not read. A subscription unsubscribed after the group was created returns TRDP_NOSUB_ERR from the next receive
+ *  pass on.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      groupHandle         the handle returned by tlp_createSubGroup
+ *  @param[in,out]  pItems              array of subscriber handles and buffers, result and info per item
+ *  @param[in]      numItems            number of items
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               result of the last failing item
+ */
+EXT_DECL TRDP_ERR_T tlp_getSubGroup (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_GROUP_T    groupHandle,
+    TRDP_GET_ITEM_T     *pItems,
+    UINT32              numItems);
+
+/**********************************************************************************************************************/
+/** Delete a subscription group. The subscriptions are not affected.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      groupHandle         the handle returned by tlp_createSubGroup
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_deleteSubGroup (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_GROUP_T    groupHandle);
+
+
+/**********************************************************************************************************************/
+/** Get a reference to the last valid PD message.
+ *  Like tlp_get, but instead of copying the data a pointer to the received frame is returned. The data is in
+ *  network representation, it is not unmarshalled. The frame stays valid until the next PD of this subscription is
+ *  received, tlp_releaseBufferRef tells if this happened while the data was read.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in,out]  pPdInfo             pointer to application's info buffer or NULL
+ *  @param[out]     ppData              pointer to the received data, NULL on error
+ *  @param[out]     pDataSize           size of the received data
+ *  @param[out]     pGeneration         generation of the frame, to be passed to tlp_releaseBufferRef
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NODATA_ERR     no data received yet
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_SAFETY_ERR     vital data not valid (see tlp_getSdtStatus)
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_getBufferRef (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_INFO_T      *pPdInfo,
+    const UINT8         **ppData,
+    UINT32              *pDataSize,
+    UINT32              *pGeneration);
+
+
+/**********************************************************************************************************************/
+/** Return a reference obtained by tlp_getBufferRef.
+ *  Checks whether the referenced frame was still current; if not, the data read in between may be inconsistent and
+ *  must be discarded.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in]      generation          generation returned by tlp_getBufferRef
+ *
+ *  @retval         TRDP_NO_ERR         the data was not overwritten
+ *  @retval         TRDP_STATE_ERR      a new frame was received meanwhile, data is not reliable
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_releaseBufferRef (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    UINT32              generation);
+
+/**********************************************************************************************************************/
+/** Validate the vital data of a subscription (SDTv2).
+ *  Each received frame is checked before it replaces the last valid data: safety code (SC-32 seeded with the SID of
+ *  smi1 or smi2), user data version, safe sequence counter and latency. Invalid frames are discarded and reported to
+ *  the callback with TRDP_SAFETY_ERR, tlp_get() returns TRDP_SAFETY_ERR unless the channel is TRDP_SDT_VALID.
+ *  Calling it again resets the channel, also after the channel monitoring latched TRDP_SDT_ERROR.
+ *  With TRDP_OPTION_PD_THREAD tlp_get() of a vital subscription locks the session to check the channel.
+ *  Members of a subscription group cannot be vital, tlp_getSubGroup() does not check the channels.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in]      pSdtPar             SDT parameters, NULL to end the validation
+ *  @param[in]      cstUUID             UUID of the source's consist, all zero for consist local communication
+ *  @param[in]      safeTopoCnt         safe topography counter, 0 for consist local communication
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, subscription is member of a group
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_setSdt (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_SUB_T              subHandle,
+    const TRDP_SDT_PAR_T    *pSdtPar,
+    const TRDP_UUID_T       cstUUID,
+    UINT32                  safeTopoCnt);
+
+/**********************************************************************************************************************/
+/** Get the state and the error counters of a vital subscription.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[out]     pStatus             state and counters of the safe channel
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, subscription not vital
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_getSdtStatus (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_SDT_STATUS_T   *pStatus);
+
+/**********************************************************************************************************************/
+/** Receive the PD of the session by AF_XDP.
+ *  The PD frames for the session's PD port arriving on the given receive queue of the interface are redirected by an
+ *  XDP program into frame buffers shared with the stack and handled from there, bypassing the kernel's UDP stack.
+ *  Subscriptions and multicast joins are unchanged; frames of other queues are still received by the PD sockets.
+ *  The AF_XDP socket is closed with the session. Only one session per interface can use it.
+ *  Linux only, needs the CAP_NET_ADMIN and CAP_BPF capabilities.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pIfName             name of the interface
+ *  @param[in]      queueId             receive queue of the interface
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, AF_XDP already used by the session
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       AF_XDP not supported or not permitted
+ */
+EXT_DECL TRDP_ERR_T tlp_openXdp (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pIfName,
+    UINT32              queueId);
+
+
 
 #if MD_SUPPORT
 
@@ -579,7 +1195,8 @@ EXT_DECL TRDP_ERR_T tlp_get (
  *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
  *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
  *  @param[in]      destIpAddr          where to send the packet to
- *  @param[in]      pktFlags            OPTIONS: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP
+ *  @param[in]      pktFlags            OPTIONS: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP,
+ *                                      TRDP_FLAGS_TCP_NOCOPY
  *  @param[in]      pSendParam          optional pointer to send parameter, NULL - default parameters are used
  *  @param[in]      pData               pointer to packet data / dataset
  *  @param[in]      dataSize            size of packet data
@@ -590,6 +1207,7 @@ EXT_DECL TRDP_ERR_T tlp_get (
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        out of memory
  *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_BLOCK_ERR      TCP send queue to the peer is full, retry later
  */
 EXT_DECL TRDP_ERR_T tlm_notify (
     TRDP_APP_SESSION_T      appHandle,
@@ -621,7 +1239,8 @@ EXT_DECL TRDP_ERR_T tlm_notify (
  *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
  *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
  *  @param[in]      destIpAddr          where to send the packet to
- *  @param[in]      pktFlags            OPTIONS: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP
+ *  @param[in]      pktFlags            OPTIONS: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP,
+ *                                      TRDP_FLAGS_TCP_NOCOPY, TRDP_FLAGS_MD_COLLECT
  *  @param[in]      numReplies          number of expected replies, 0 if unknown
  *  @param[in]      replyTimeout        timeout for reply
  *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
@@ -634,6 +1253,7 @@ EXT_DECL TRDP_ERR_T tlm_notify (
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        out of memory
  *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_BLOCK_ERR      TCP send queue to the peer is full, retry later
  */
 EXT_DECL TRDP_ERR_T tlm_request (
     TRDP_APP_SESSION_T      appHandle,
@@ -709,7 +1329,8 @@ EXT_DECL TRDP_ERR_T tlm_abortSession (
  *  @param[in]      srcIpAddr1          Source IP address, lower address in case of address range, set 0 if not used
  *  @param[in]      srcIpAddr2          upper address in case of address range, set to 0 if not used
  *  @param[in]      mcDestIpAddr        multicast group to listen on
- *  @param[in]      pktFlags            OPTION: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP
+ *  @param[in]      pktFlags            OPTION: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP,
+ *                                      TRDP_FLAGS_TCP_NOCOPY (also used for the replies of this listener)
  *  @param[in]      srcURI              only functional group of source URI, set 0 if not used
  *  @param[in]      destURI             only functional group of destination URI, set 0 if not used
 
@@ -795,6 +1416,7 @@ EXT_DECL TRDP_ERR_T tlm_delListener (
  *  @retval         TRDP_MEM_ERR        Out of memory
  *  @retval         TRDP_NO_SESSION_ERR no such session
  *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_BLOCK_ERR      TCP send queue to the peer is full, retry later
  */
 TRDP_ERR_T tlm_reply (
     TRDP_APP_SESSION_T      appHandle,
@@ -825,6 +1447,7 @@ TRDP_ERR_T tlm_reply (
  *  @retval         TRDP_MEM_ERR        out of memory
  *  @retval         TRDP_NO_SESSION_ERR no such session
  *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_BLOCK_ERR      TCP send queue to the peer is full, retry later
  */
 TRDP_ERR_T tlm_replyQuery (
     TRDP_APP_SESSION_T      appHandle,
@@ -883,6 +1506,40 @@ EXT_DECL TRDP_ERR_T tlc_getStatistics (
     TRDP_STATISTICS_T   *pStatistics);
 
 
+/**********************************************************************************************************************/
+/** Return timing statistics.
+ *  The histograms are only filled if the session was configured with TRDP_OPTION_TIMING_STATS.
+ *  Memory for statistics information must be preserved by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to timing statistics for this application session
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getTimingStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_TIMING_STATISTICS_T    *pStatistics);
+
+
+/**********************************************************************************************************************/
+/** Return the send slot usage of the traffic shaping.
+ *  All values are 0 if the session was not configured with TRDP_OPTION_TRAFFIC_SHAPING or publishes less than two
+ *  cyclic telegrams.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the slot usage of this application session
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getShapingStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_SHAPING_STATISTICS_T   *pStatistics);
+
+
 /**********************************************************************************************************************/
 /** Return PD subscription statistics.
  *  Memory for statistics information must be provided by the user.
@@ -904,6 +1561,30 @@ EXT_DECL TRDP_ERR_T tlc_getSubsStatistics (
     TRDP_SUBS_STATISTICS_T  *pStatistics);
 
 
+/**********************************************************************************************************************/
+/** Return a page of the PD subscription statistics.
+ *  The session is locked for one page only, large tables should be fetched page by page.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      startIdx            number of (matching) subscriptions to skip
+ *  @param[in]      comId               return subscriptions of this comId only, 0 = all
+ *  @param[in,out]  pNumSubs            In: The number of subscriptions requested
+ *                                      Out: Number of subscriptions returned
+ *  @param[out]     pStatistics         Pointer to an array with the subscription statistics information
+ *
+ *  @retval         TRDP_NO_ERR         no error, no more subscriptions
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more subscriptions, continue at startIdx + *pNumSubs
+ */
+EXT_DECL TRDP_ERR_T tlc_getSubsStatisticsPage (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT16                  startIdx,
+    UINT32                  comId,
+    UINT16                  *pNumSubs,
+    TRDP_SUBS_STATISTICS_T  *pStatistics);
+
+
 /**********************************************************************************************************************/
 /** Return PD publish statistics.
  *  Memory for statistics information must be provided by the user.
@@ -923,6 +1604,30 @@ EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
     UINT16                  *pNumPub,
     TRDP_PUB_STATISTICS_T   *pStatistics);
 
+
+/**********************************************************************************************************************/
+/** Return a page of the PD publish statistics.
+ *  The session is locked for one page only, large tables should be fetched page by page.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      startIdx            number of (matching) publishers to skip
+ *  @param[in]      comId               return publishers of this comId only, 0 = all
+ *  @param[in,out]  pNumPub             In: The number of publishers requested
+ *                                      Out: Number of publishers returned
+ *  @param[out]     pStatistics         pointer to a list with the publish statistics information
+ *
+ *  @retval         TRDP_NO_ERR         no error, no more publishers
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more publishers, continue at startIdx + *pNumPub
+ */
+EXT_DECL TRDP_ERR_T tlc_getPubStatisticsPage (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT16                  startIdx,
+    UINT32                  comId,
+    UINT16                  *pNumPub,
+    TRDP_PUB_STATISTICS_T   *pStatistics);
+
 #if MD_SUPPORT
 /**********************************************************************************************************************/
 /** Return UDP MD listener statistics.
@@ -963,6 +1668,38 @@ EXT_DECL TRDP_ERR_T tlc_getTcpListStatistics (
     UINT16                  *pNumList,
     TRDP_LIST_STATISTICS_T  *pStatistics);
 
+
+/**********************************************************************************************************************/
+/** Return the usage statistics of the TCP caller connections.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the connection statistics
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getTcpConnStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_TCP_CONN_STATISTICS_T  *pStatistics);
+
+
+/**********************************************************************************************************************/
+/** Return the usage statistics of the MD element and frame pool.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the pool statistics
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getMdPoolStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_MD_POOL_STATISTICS_T   *pStatistics);
+
 #endif /* MD_SUPPORT    */
 
 /**********************************************************************************************************************/
@@ -1005,6 +1742,88 @@ EXT_DECL TRDP_ERR_T tlc_getJoinStatistics (
     UINT32              *pIpAddr);
 
 
+/**********************************************************************************************************************/
+/** Export the statistics of a session to shared memory.
+ *  A snapshot of the session, memory, subscription, publisher and socket statistics is written by tlc_process()
+ *  every interval ms. Other processes on the host read it with tlc_getExportedMetrics() without touching the session.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pName               name of the shared memory area (e.g. "/trdp-stats"), NULL to stop the export
+ *  @param[in]      interval            export interval in ms, 0 = 1s
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_MEM_ERR        shared memory not available
+ */
+EXT_DECL TRDP_ERR_T tlc_exportStatistics (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pName,
+    UINT32              interval);
+
+
+/**********************************************************************************************************************/
+/** Return the statistics exported by a session as OpenMetrics (Prometheus) text.
+ *
+ *  @param[in]      pName               name of the shared memory area passed to tlc_exportStatistics()
+ *  @param[out]     pText               buffer for the text, zero terminated
+ *  @param[in,out]  pSize               In: size of pText, Out: length of the text or, on TRDP_MEM_ERR, size needed
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     no statistics exported by that name
+ *  @retval         TRDP_MEM_ERR        pText too small or out of memory
+ *  @retval         TRDP_BLOCK_ERR      no consistent snapshot could be read
+ */
+EXT_DECL TRDP_ERR_T tlc_getExportedMetrics (
+    const CHAR8 *pName,
+    CHAR8       *pText,
+    UINT32      *pSize);
+
+/**********************************************************************************************************************/
+/** Record the telegrams of a session.
+ *  Every PD and MD telegram sent or received by the session is appended to a ring in the shared memory area pName,
+ *  without a system call per telegram. When the ring is full the oldest records are overwritten. The area survives
+ *  an abnormal termination of the process. Recording is stopped, and the area removed, by pName NULL or closing the
+ *  session. Not available if built with TRDP_RECORDER 0.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pName               name of the shared memory area (e.g. "/trdp-rec"), NULL to stop recording
+ *  @param[in]      size                size of the ring in bytes, 0 = 4 MB
+ *  @param[in]      snapLen             max. bytes recorded of a telegram, 0 = all
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        shared memory not available
+ */
+EXT_DECL TRDP_ERR_T tlc_record (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pName,
+    UINT32              size,
+    UINT32              snapLen);
+
+/**********************************************************************************************************************/
+/** Save the telegrams recorded by tlc_record() as pcapng file.
+ *  Reads the area while it is recorded into, from any process, or after the recording process terminated.
+ *  The telegrams are written as UDP/IPv4 datagrams (TCP MD as well), oldest first.
+ *
+ *  @param[in]      pName               name of the shared memory area passed to tlc_record()
+ *  @param[in]      pFileName           name of the pcapng file to write
+ *  @param[out]     pNoRecords          number of telegrams written, may be NULL
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     no recording by that name
+ *  @retval         TRDP_IO_ERR         file could not be written
+ *  @retval         TRDP_BLOCK_ERR      no consistent ring state could be read
+ *  @retval         TRDP_WIRE_ERR       ring corrupt, the records before are saved
+ */
+EXT_DECL TRDP_ERR_T tlc_saveRecording (
+    const CHAR8 *pName,
+    const CHAR8 *pFileName,
+    UINT32      *pNoRecords);
+
+
 /**********************************************************************************************************************/
 /** Reset statistics.
  *
@@ -0,0 +1,483 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp_typed.hpp
+ *
+ * @brief           Typed C++ layer over the TRDP light interface (header only)
+ *
+ * @details         A dataset is a plain struct which lists its members in wire order:
+ *
+ *                      struct DoorState
+ *                      {
+ *                          UINT8       state;
+ *                          UINT16      speed;
+ *                          CHAR8       name[16];
+ *                          TIMEDATE64  stamp;
+ *                          using TrdpFields = trdp::Fields<&DoorState::state, &DoorState::speed,
+ *                                                          &DoorState::name, &DoorState::stamp>;
+ *                      };
+ *
+ *                  The packed size (trdp::wireSize<DoorState>()) and the per member big endian conversion are
+ *                  resolved at compile time, so marshalling is inlined code without any dataset table lookup.
+ *                  The wire format is the one of tau_marshall for the equivalent TRDP_DATASET_T.
+ *                  Supported members: the TRDP scalar types, TIMEDATE48/64, fixed size C arrays, std::array and
+ *                  nested datasets. Variable sized arrays are not supported (use tau_marshall for those).
+ *
+ *                  trdp::Publisher<T> and trdp::Subscriber<T> own a publication/subscription of one dataset type.
+ *                  They accept and return T only, hand packed data to the stack (TRDP_FLAGS_MARSHALL is never set)
+ *                  and use no virtual functions. They are neither copyable nor movable, the subscriber's address
+ *                  is passed to the stack as user reference.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *                  Requires C++17.
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TRDP_TYPED_HPP
+#define TRDP_TYPED_HPP
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "trdp_if_light.h"
+
+namespace trdp
+{
+
+/***********************************************************************************************************************
+ * DATASET DESCRIPTION
+ */
+
+/** Member list of a dataset in wire order, e.g. Fields<&T::a, &T::b>   */
+template <auto ... Members>
+struct Fields {};
+
+/** Wire representation of one member type, specialised below; unsupported types fail to compile   */
+template <typename T, typename Enable = void>
+struct Wire;
+
+namespace detail
+{
+
+template <std::size_t N> struct Unsigned;
+template <> struct Unsigned<1> { using type = UINT8; };
+template <> struct Unsigned<2> { using type = UINT16; };
+template <> struct Unsigned<4> { using type = UINT32; };
+template <> struct Unsigned<8> { using type = UINT64; };
+
+template <typename P> struct MemberOf;
+template <typename C, typename M> struct MemberOf<M C::*>
+{
+    using cls   = C;
+    using type  = M;
+};
+
+/** Store a scalar big endian. Written as shifts, the compiler turns it into a byte swap and one store  */
+template <typename T>
+inline void putBE (UINT8 *pDst, T value)
+{
+    typename Unsigned<sizeof(T)>::type u;
+    std::memcpy(&u, &value, sizeof(u));
+    for (std::size_t i = sizeof(u); i-- > 0u; )
+    {
+        pDst[i] = static_cast<UINT8>(u);
+        u       = static_cast<decltype(u)>(u >> 8u);
+    }
+}
+
+/** Load a big endian scalar    */
+template <typename T>
+inline T getBE (const UINT8 *pSrc)
+{
+    typename Unsigned<sizeof(T)>::type u = 0u;
+    for (std::size_t i = 0u; i < sizeof(u); i++)
+    {
+        u = static_cast<decltype(u)>((u << 8u) | pSrc[i]);
+    }
+    T value;
+    std::memcpy(&value, &u, sizeof(value));
+    return value;
+}
+
+template <typename T, typename L> struct Dataset;
+
+template <typename T, auto ... Members>
+struct Dataset<T, Fields<Members ...> >
+{
+    static_assert(sizeof...(Members) > 0u, "dataset without members");
+    static_assert((std::is_same_v<typename MemberOf<decltype(Members)>::cls, T> && ...),
+                  "TrdpFields must list members of the dataset itself");
+
+    static constexpr std::size_t size = (Wire<typename MemberOf<decltype(Members)>::type>::size + ...);
+
+    static void put (UINT8 *pDst, const T &src)
+    {
+        ((Wire<typename MemberOf<decltype(Members)>::type>::put(pDst, src.*Members),
+          pDst += Wire<typename MemberOf<decltype(Members)>::type>::size), ...);
+    }
+
+    static void get (const UINT8 *pSrc, T &dst)
+    {
+        ((Wire<typename MemberOf<decltype(Members)>::type>::get(pSrc, dst.*Members),
+          pSrc += Wire<typename MemberOf<decltype(Members)>::type>::size), ...);
+    }
+};
+
+}   /* namespace detail */
+
+/** Scalars (BOOL8, CHAR8, UTF16, INTx, UINTx, REALx, TIMEDATE32)   */
+template <typename T>
+struct Wire<T, std::enable_if_t<std::is_arithmetic_v<T> > >
+{
+    static constexpr std::size_t size = sizeof(T);
+    static void put (UINT8 *pDst, const T &src) { detail::putBE(pDst, src); }
+    static void get (const UINT8 *pSrc, T &dst) { dst = detail::getBE<T>(pSrc); }
+};
+
+template <>
+struct Wire<TIMEDATE48>
+{
+    static constexpr std::size_t size = 6u;
+    static void put (UINT8 *pDst, const TIMEDATE48 &src)
+    {
+        detail::putBE(pDst, src.sec);
+        detail::putBE(pDst + 4u, src.ticks);
+    }
+    static void get (const UINT8 *pSrc, TIMEDATE48 &dst)
+    {
+        dst.sec     = detail::getBE<UINT32>(pSrc);
+        dst.ticks   = detail::getBE<UINT16>(pSrc + 4u);
+    }
+};
+
+template <>
+struct Wire<TIMEDATE64>
+{
+    static constexpr std::size_t size = 8u;
+    static void put (UINT8 *pDst, const TIMEDATE64 &src)
+    {
+        detail::putBE(pDst, src.tv_sec);
+        detail::putBE(pDst + 4u, src.tv_usec);
+    }
+    static void get (const UINT8 *pSrc, TIMEDATE64 &dst)
+    {
+        dst.tv_sec  = detail::getBE<UINT32>(pSrc);
+        dst.tv_usec = detail::getBE<INT32>(pSrc + 4u);
+    }
+};
+
+/** Fixed size arrays   */
+template <typename T, std::size_t N>
+struct Wire<T[N]>
+{
+    static constexpr std::size_t size = N * Wire<T>::size;
+    static void put (UINT8 *pDst, const T (&src)[N])
+    {
+        for (std::size_t i = 0u; i < N; i++, pDst += Wire<T>::size)
+        {
+            Wire<T>::put(pDst, src[i]);
+        }
+    }
+    static void get (const UINT8 *pSrc, T (&dst)[N])
+    {
+        for (std::size_t i = 0u; i < N; i++, pSrc += Wire<T>::size)
+        {
+            Wire<T>::get(pSrc, dst[i]);
+        }
+    }
+};
+
+template <typename T, std::size_t N>
+struct Wire<std::array<T, N> >
+{
+    static constexpr std::size_t size = N * Wire<T>::size;
+    static void put (UINT8 *pDst, const std::array<T, N> &src)
+    {
+        for (std::size_t i = 0u; i < N; i++, pDst += Wire<T>::size)
+        {
+            Wire<T>::put(pDst, src[i]);
+        }
+    }
+    static void get (const UINT8 *pSrc, std::array<T, N> &dst)
+    {
+        for (std::size_t i = 0u; i < N; i++, pSrc += Wire<T>::size)
+        {
+            Wire<T>::get(pSrc, dst[i]);
+        }
+    }
+};
+
+/** Datasets, also when nested as a member  */
+template <typename T>
+struct Wire<T, std::void_t<typename T::TrdpFields> >
+    : detail::Dataset<T, typename T::TrdpFields> {};
+
+/***********************************************************************************************************************
+ * MARSHALLING
+ */
+
+/** Packed (wire) size of a dataset     */
+template <typename T>
+constexpr std::size_t wireSize ()
+{
+    return Wire<T>::size;
+}
+
+/** Buffer holding one packed dataset   */
+template <typename T>
+using WireBuffer = std::array<UINT8, Wire<T>::size>;
+
+/** Pack a dataset into pDst, which must provide wireSize<T>() bytes    */
+template <typename T>
+inline void marshall (const T &src, UINT8 *pDst)
+{
+    Wire<T>::put(pDst, src);
+}
+
+/** Unpack a dataset from pSrc, which must provide wireSize<T>() bytes  */
+template <typename T>
+inline void unmarshall (const UINT8 *pSrc, T &dst)
+{
+    Wire<T>::get(pSrc, dst);
+}
+
+/** Flags handed to the stack: no marshalling (the data is packed already) and only the given callback flags   */
+inline TRDP_FLAGS_T packedFlags (TRDP_FLAGS_T pktFlags, TRDP_FLAGS_T cbFlags)
+{
+    pktFlags = static_cast<TRDP_FLAGS_T>(pktFlags & ~(TRDP_FLAGS_NONE | TRDP_FLAGS_MARSHALL | TRDP_FLAGS_CALLBACK |
+                                                      TRDP_FLAGS_FORCE_CB));
+    pktFlags = static_cast<TRDP_FLAGS_T>(pktFlags | cbFlags);
+    return (pktFlags == 0u) ? static_cast<TRDP_FLAGS_T>(TRDP_FLAGS_NONE) : pktFlags;
+}
+
+/***********************************************************************************************************************
+ * PUBLISHER / SUBSCRIBER
+ */
+
+/** Publication of dataset T    */
+template <typename T>
+class Publisher
+{
+public:
+    static_assert(Wire<T>::size <= TRDP_MAX_PD_DATA_SIZE, "dataset exceeds TRDP_MAX_PD_DATA_SIZE");
+
+    Publisher () = default;
+    Publisher (const Publisher &) = delete;
+    Publisher &operator = (const Publisher &) = delete;
+    ~Publisher () { (void) unpublish(); }
+
+    /** Publish with initial data; parameters as tlp_publish. TRDP_FLAGS_DEFAULT stands for 'no flags' here,
+        since the session default may include marshalling   */
+    TRDP_ERR_T publish (TRDP_APP_SESSION_T          appHandle,
+                        UINT32                      comId,
+                        TRDP_IP_ADDR_T              destIpAddr,
+                        UINT32                      interval,
+                        const T                     &data,
+                        TRDP_FLAGS_T                pktFlags = TRDP_FLAGS_NONE,
+                        const TRDP_SEND_PARAM_T     *pSendParam = nullptr,
+                        TRDP_IP_ADDR_T              srcIpAddr = 0u,
+                        UINT32                      redId = 0u,
+                        UINT32                      etbTopoCnt = 0u,
+                        UINT32                      opTrnTopoCnt = 0u)
+    {
+        WireBuffer<T>   buffer;
+        TRDP_ERR_T      err;
+
+        if (mHandle != nullptr)
+        {
+            return TRDP_STATE_ERR;
+        }
+        marshall(data, buffer.data());
+        err = tlp_publish(appHandle, &mHandle, nullptr, nullptr, comId, etbTopoCnt, opTrnTopoCnt, srcIpAddr,
+                          destIpAddr, interval, redId, packedFlags(pktFlags, 0u), pSendParam,
+                          buffer.data(), static_cast<UINT32>(buffer.size()));
+        if (err == TRDP_NO_ERR)
+        {
+            mAppHandle = appHandle;
+        }
+        else
+        {
+            mHandle = nullptr;
+        }
+        return err;
+    }
+
+    /** Update the published data   */
+    TRDP_ERR_T put (const T &data)
+    {
+        WireBuffer<T> buffer;
+
+        if (mHandle == nullptr)
+        {
+            return TRDP_NOPUB_ERR;
+        }
+        marshall(data, buffer.data());
+        return tlp_put(mAppHandle, mHandle, buffer.data(), static_cast<UINT32>(buffer.size()));
+    }
+
+    TRDP_ERR_T unpublish ()
+    {
+        TRDP_ERR_T err = TRDP_NO_ERR;
+
+        if (mHandle != nullptr)
+        {
+            err         = tlp_unpublish(mAppHandle, mHandle);
+            mHandle     = nullptr;
+            mAppHandle  = nullptr;
+        }
+        return err;
+    }
+
+    TRDP_PUB_T handle () const { return mHandle; }
+
+private:
+    TRDP_APP_SESSION_T  mAppHandle  = nullptr;
+    TRDP_PUB_T          mHandle     = nullptr;
+};
+
+/** Subscription of dataset T   */
+template <typename T>
+class Subscriber
+{
+public:
+    static_assert(Wire<T>::size <= TRDP_MAX_PD_DATA_SIZE, "dataset exceeds TRDP_MAX_PD_DATA_SIZE");
+
+    /** Typed receive callback. On timeout (pInfo.resultCode == TRDP_TIMEOUT_ERR) data is value initialised   */
+    using Callback = void (*)(void *pRefCon, const T &data, const TRDP_PD_INFO_T &info);
+
+    Subscriber () = default;
+    Subscriber (const Subscriber &) = delete;
+    Subscriber &operator = (const Subscriber &) = delete;
+    ~Subscriber () { (void) unsubscribe(); }
+
+    /** Install a typed callback, must be called before subscribe()  */
+    void onReceive (Callback pfCbFunction, void *pRefCon = nullptr)
+    {
+        mCb     = pfCbFunction;
+        mRefCon = pRefCon;
+    }
+
+    /** Subscribe; parameters as tlp_subscribe  */
+    TRDP_ERR_T subscribe (TRDP_APP_SESSION_T    appHandle,
+                          UINT32                comId,
+                          UINT32                timeout,
+                          TRDP_IP_ADDR_T        srcIpAddr1 = 0u,
+                          TRDP_IP_ADDR_T        srcIpAddr2 = 0u,
+                          TRDP_IP_ADDR_T        destIpAddr = 0u,
+                          TRDP_TO_BEHAVIOR_T    toBehavior = TRDP_TO_SET_TO_ZERO,
+                          TRDP_FLAGS_T          pktFlags = TRDP_FLAGS_NONE,
+                          UINT32                etbTopoCnt = 0u,
+                          UINT32                opTrnTopoCnt = 0u)
+    {
+        TRDP_ERR_T err;
+
+        if (mHandle != nullptr)
+        {
+            return TRDP_STATE_ERR;
+        }
+        if (mCb != nullptr)
+        {
+            pktFlags = packedFlags(pktFlags,
+                                   static_cast<TRDP_FLAGS_T>(TRDP_FLAGS_CALLBACK | (pktFlags & TRDP_FLAGS_FORCE_CB)));
+        }
+        else
+        {
+            pktFlags = packedFlags(pktFlags, 0u);
+        }
+        err = tlp_subscribe(appHandle, &mHandle, this, (mCb != nullptr) ? &Subscriber::dispatch : nullptr, comId,
+                            etbTopoCnt, opTrnTopoCnt, srcIpAddr1, srcIpAddr2, destIpAddr, pktFlags, timeout,
+                            toBehavior);
+        if (err == TRDP_NO_ERR)
+        {
+            mAppHandle = appHandle;
+        }
+        else
+        {
+            mHandle = nullptr;
+        }
+        return err;
+    }
+
+    /** Fetch the last received data; a telegram of another size is reported as TRDP_WIRE_ERR    */
+    TRDP_ERR_T get (T &data, TRDP_PD_INFO_T *pPdInfo = nullptr)
+    {
+        WireBuffer<T>   buffer;
+        UINT32          size = static_cast<UINT32>(buffer.size());
+        TRDP_ERR_T      err;
+
+        if (mHandle == nullptr)
+        {
+            return TRDP_NOSUB_ERR;
+        }
+        err = tlp_get(mAppHandle, mHandle, pPdInfo, buffer.data(), &size);
+        if (err == TRDP_NO_ERR)
+        {
+            if (size != buffer.size())
+            {
+                return TRDP_WIRE_ERR;
+            }
+            unmarshall(buffer.data(), data);
+        }
+        return err;
+    }
+
+    TRDP_ERR_T unsubscribe ()
+    {
+        TRDP_ERR_T err = TRDP_NO_ERR;
+
+        if (mHandle != nullptr)
+        {
+            err         = tlp_unsubscribe(mAppHandle, mHandle);
+            mHandle     = nullptr;
+            mAppHandle  = nullptr;
+        }
+        return err;
+    }
+
+    TRDP_SUB_T handle () const { return mHandle; }
+
+private:
+    static void dispatch (void                  * /* pRefCon */,
+                          TRDP_APP_SESSION_T    /* appHandle */,
+                          const TRDP_PD_INFO_T  *pMsg,
+                          UINT8                 *pData,
+                          UINT32                dataSize)
+    {
+        const Subscriber    *pSelf = static_cast<const Subscriber *>(pMsg->pUserRef);
+        T                   data{};
+
+        if ((pSelf == nullptr) || (pSelf->mCb == nullptr))
+        {
+            return;
+        }
+        if ((pMsg->resultCode == TRDP_NO_ERR) && ((pData == nullptr) || (dataSize != Wire<T>::size)))
+        {
+            return;     /* not our layout */
+        }
+        if ((pData != nullptr) && (dataSize == Wire<T>::size))
+        {
+            unmarshall(pData, data);
+        }
+        pSelf->mCb(pSelf->mRefCon, data, *pMsg);
+    }
+
+    TRDP_APP_SESSION_T  mAppHandle  = nullptr;
+    TRDP_SUB_T          mHandle     = nullptr;
+    Callback            mCb         = nullptr;
+    void                *mRefCon    = nullptr;
+};
+
+}   /* namespace trdp */
+
+#endif /* TRDP_TYPED_HPP */
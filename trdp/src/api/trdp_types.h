@@ -147,6 +147,7 @@ typedef enum
     TRDP_XML_PARSER_ERR     = -48,  /**< Returned by the tau_xml subsystem              */
     TRDP_INUSE_ERR          = -49,  /**< Resource is still in use                       */
     TRDP_MARSHALLING_ERR    = -50,  /**< Source size exceeded, dataset mismatch         */
+    TRDP_SAFETY_ERR         = -51,  /**< SDT: vital data not valid                      */
     TRDP_UNKNOWN_ERR        = -99   /**< Unspecified error                              */
 } TRDP_ERR_T;
 
@@ -190,6 +191,22 @@ typedef enum
 #define TRDP_FLAGS_CALLBACK   0x04u       /**< Use of callback function                                   */
 #define TRDP_FLAGS_TCP        0x08u       /**< Use TCP for message data                                   */
 #define TRDP_FLAGS_FORCE_CB   0x10u       /**< Force a callback for every received packet                 */
+#define TRDP_FLAGS_TCP_NOCOPY 0x20u       /**< TCP MD: send the user buffer in place instead of copying it.
+                                               The buffer must stay valid until the send complete callback
+                                               (resultCode TRDP_NO_ERR, pData == user buffer) or until the
+                                               session ends with an error callback                          */
+#define TRDP_FLAGS_TCP_STREAM 0x40u       /**< TCP MD listener: hand notifications over in chunks as they
+                                               arrive instead of reassembling them (see chunkOffset)        */
+#define TRDP_FLAGS_PD_ON_CHANGE 0x40u     /**< PD publisher: send cyclic data only if it changed, unchanged
+                                               data is sent as heartbeat every n-th interval (see
+                                               tlp_setHeartbeat). Same bit as the MD only
+                                               TRDP_FLAGS_TCP_STREAM                                        */
+#define TRDP_FLAGS_MD_COLLECT 0x80u       /**< MD request: collect the replies and hand them over in one
+                                               callback when the session ends (array of TRDP_MD_REPLY_T)    */
+#define TRDP_FLAGS_PD_LATEST  0x80u       /**< PD subscription with callback: the frames received in one
+                                               tlc_process() call are handed over in one callback with the
+                                               newest data (see numCoalesced). Same bit as the MD only
+                                               TRDP_FLAGS_MD_COLLECT                                        */
 
 #define TRDP_INFINITE_TIMEOUT 0xffffffffu /**< Infinite reply timeout                                      */
 
@@ -235,6 +252,10 @@ typedef struct
     TRDP_URI_HOST_T     srcHostURI; /**< source URI host part (unused)                              */
     TRDP_URI_HOST_T     destHostURI; /**< destination URI host part (unused)                         */
     TRDP_TO_BEHAVIOR_T  toBehavior; /**< callback can decide about handling of data on timeout      */
+    TRDP_TIME_T         rxTime;     /**< reception time of the data (time base of vos_getTime), from the
+                                         kernel or NIC with TRDP_OPTION_RX_TIMESTAMPS                  */
+    UINT32              numCoalesced; /**< frames received before this one and not handed over
+                                         (TRDP_FLAGS_PD_LATEST), 0 otherwise                           */
 } TRDP_PD_INFO_T;
 
 
@@ -242,6 +263,43 @@ typedef struct
  */
 typedef VOS_UUID_T TRDP_UUID_T;
 
+/** SDT (safe data transmission, IEC 61375-2-3 Annex B) parameters of a vital telegram    */
+typedef struct
+{
+    UINT32  smi1;        /**< Safe message identifier - unique for this message at consist level */
+    UINT32  smi2;        /**< Safe message identifier - unique for this message at consist level */
+    UINT32  cmThr;       /**< Channel monitoring threshold */
+    UINT16  udv;         /**< User data version */
+    UINT16  rxPeriod;    /**< Sink cycle time */
+    UINT16  txPeriod;    /**< Source cycle time */
+    UINT16  nGuard;      /**< Initial timeout cycles */
+    UINT8   nrxSafe;     /**< Timout cycles */
+    UINT8   reserved1;   /**< Reserved for future use */
+    UINT16  reserved2;   /**< Reserved for future use */
+} TRDP_SDT_PAR_T;
+
+/** State of a safe channel, see tlp_getSdtStatus()   */
+typedef enum
+{
+    TRDP_SDT_INIT       = 0u,   /**< no valid vital data received yet, within nGuard sink cycles                    */
+    TRDP_SDT_VALID      = 1u,   /**< fresh vital data received within nrxSafe sink cycles                           */
+    TRDP_SDT_TIMEOUT    = 2u,   /**< no fresh vital data within nrxSafe (or nGuard) sink cycles                     */
+    TRDP_SDT_ERROR      = 3u    /**< channel monitoring threshold exceeded, latched until tlp_setSdt()              */
+} TRDP_SDT_STATE_T;
+
+/** Validation results of a safe channel   */
+typedef struct
+{
+    TRDP_SDT_STATE_T    state;          /**< current state of the channel                                   */
+    UINT32              lastSsc;        /**< safe sequence counter of the last valid vital data             */
+    UINT32              numValid;       /**< frames accepted                                                */
+    UINT32              numScErr;       /**< frames with a wrong safety code (SC-32) or size                */
+    UINT32              numUdvErr;      /**< frames with a wrong user data version                          */
+    UINT32              numSscErr;      /**< frames with a repeated or old safe sequence counter            */
+    UINT32              numLatencyErr;  /**< frames older than nrxSafe sink cycles (latency supervision)     */
+    UINT32              numTimeout;     /**< transitions to TRDP_SDT_TIMEOUT                                */
+} TRDP_SDT_STATUS_T;
+
 
 /**    Message data info from received telegram; allows the application to generate responses.
  *
@@ -273,8 +331,26 @@ typedef struct
     UINT32              numReplies;         /**< actual number of replies for the request   */
     const void          *pUserRef;          /**< User reference given with the local call   */
     TRDP_ERR_T          resultCode;         /**< error code                                 */
+    UINT32              chunkOffset;        /**< offset of pData in the message data (TRDP_FLAGS_TCP_STREAM) */
+    UINT32              totalLength;        /**< size of the whole message data if it is handed over in
+                                                 chunks (TRDP_FLAGS_TCP_STREAM), 0 otherwise                 */
 } TRDP_MD_INFO_T;
 
+/**    One reply of a request sent with TRDP_FLAGS_MD_COLLECT.
+ *
+ *  The callback gets an array of dataSize / sizeof(TRDP_MD_REPLY_T) entries as pData. pData of the entries points
+ *  into a buffer owned by the stack, it is valid during the callback only.
+ */
+typedef struct
+{
+    TRDP_IP_ADDR_T      srcIpAddr;          /**< IP address of the replier                  */
+    UINT32              seqCount;           /**< sequence counter of the reply              */
+    UINT16              userStatus;         /**< user status of the reply                   */
+    TRDP_REPLY_STATUS_T replyStatus;        /**< reply status                               */
+    const UINT8         *pData;             /**< data of the reply                          */
+    UINT32              dataSize;           /**< size of the data                           */
+} TRDP_MD_REPLY_T;
+
 
 /**    Quality/type of service and time to live    */
 typedef struct
@@ -282,6 +358,7 @@ typedef struct
     UINT8   qos;       /**< Quality of service (default should be 5 for PD and 3 for MD)  */
     UINT8   ttl;       /**< Time to live (default should be 64)  */
     UINT8   retries;   /**< Retries from XML file */
+    BOOL8   txTime;    /**< PD only: send ahead with the due time as launch time (Linux SO_TXTIME, ETF qdisc) */
 } TRDP_SEND_PARAM_T;
 
 
@@ -424,6 +501,35 @@ typedef struct
 } TRDP_MD_STATISTICS_T;
 
 
+/** Usage of the TCP connections opened by MD callers.
+    A caller reuses an open connection to the same peer, requests are pipelined over it. An idle connection is closed
+    after the connection timeout or if more than maxNumIdleConn connections are idle.                                 */
+typedef struct
+{
+    UINT32  numConnect;            /**< number of new connections */
+    UINT32  numReuse;              /**< number of requests sent over an already open connection */
+    UINT32  numIdleClose;          /**< number of idle connections closed */
+    UINT32  numOpen;               /**< number of currently open caller connections */
+    UINT32  numIdle;               /**< number of currently idle caller connections */
+    UINT32  numThrottled;          /**< number of messages refused with TRDP_BLOCK_ERR (send queue full) */
+    UINT32  queuedBytes;           /**< bytes currently waiting to be sent on all TCP connections */
+} TRDP_TCP_CONN_STATISTICS_T;
+
+
+/** Usage of the pool of MD session elements and frames.
+    Sessions and frames of up to TRDP_MD_POOL_DATA_SIZE bytes of data are taken from the pool instead of the heap,
+    not more than maxNumSessions of each are kept for reuse.                                                         */
+typedef struct
+{
+    UINT32  numEleHit;             /**< number of MD session elements taken from the pool */
+    UINT32  numEleAlloc;           /**< number of MD session elements allocated */
+    UINT32  numFrameHit;           /**< number of MD frames taken from the pool */
+    UINT32  numFrameAlloc;         /**< number of MD frames allocated */
+    UINT32  numEleFree;            /**< number of MD session elements currently in the pool */
+    UINT32  numFrameFree;          /**< number of MD frames currently in the pool */
+} TRDP_MD_POOL_STATISTICS_T;
+
+
 /** Structure containing all general memory, PD and MD statistics information. */
 typedef struct
 {
@@ -445,6 +551,47 @@ typedef struct
     TRDP_MD_STATISTICS_T    tcpMd;        /**< TCP md statistics */
 } TRDP_STATISTICS_T;
 
+/** Timing statistics: histograms of durations in us.
+    Buckets 0...3 count the values 0...3, above each power of two 2^e (e >= 2) is split into two buckets:
+    bucket 4 + 2 * (e - 2) counts 2^e ... 1.5 * 2^e - 1, the next one 1.5 * 2^e ... 2^(e+1) - 1.
+    The last bucket also counts all larger values.                                                                    */
+#define TRDP_TIMING_BUCKETS         48u
+
+#define TRDP_TIMING_PROCESS         0u          /**< duration of tlc_process / tlc_processEvents            */
+#define TRDP_TIMING_PD_RCV_CB       1u          /**< reception of a PD frame until its callback is called   */
+#define TRDP_TIMING_PD_SEND_LATE    2u          /**< delay of cyclic PD sending against the due time        */
+#define TRDP_TIMING_MD_ROUND_TRIP   3u          /**< MD request sent until reply received                   */
+#define TRDP_TIMING_REINIT          4u          /**< duration of tlc_reinitSession (multicast rejoin)       */
+#define TRDP_TIMING_MD_RETRY        5u          /**< MD request first sent until reply to a retransmission  */
+#define TRDP_TIMING_CNT             6u
+
+/** Histogram of one measured duration */
+typedef struct
+{
+    UINT32  count;                              /**< number of samples */
+    UINT32  min;                                /**< smallest sample in us */
+    UINT32  max;                                /**< largest sample in us */
+    UINT32  mean;                               /**< mean of the samples in us */
+    UINT32  bucket[TRDP_TIMING_BUCKETS];        /**< number of samples per bucket */
+} TRDP_TIMING_HIST_T;
+
+/** Timing statistics of a session (TRDP_OPTION_TIMING_STATS), appended to the statistics PD if enabled */
+typedef struct
+{
+    TRDP_TIMING_HIST_T  hist[TRDP_TIMING_CNT];  /**< indexed by TRDP_TIMING_PROCESS... */
+} TRDP_TIMING_STATISTICS_T;
+
+/** Send slot usage of the traffic shaping (TRDP_OPTION_TRAFFIC_SHAPING) */
+typedef struct
+{
+    UINT32  slotTime;                           /**< duration of a send slot in us */
+    UINT32  slotCnt;                            /**< number of slots of the hyper-period (LCM of the intervals) */
+    UINT32  numPub;                             /**< number of cyclic publishers distributed over the slots */
+    UINT32  avgLoad;                            /**< average number of bytes sent per slot */
+    UINT32  peakLoad;                           /**< max. number of bytes sent in one slot */
+    UINT32  peakBandwidth;                      /**< peak bandwidth in kbit/s (peakLoad per slotTime) */
+} TRDP_SHAPING_STATISTICS_T;
+
 /** Table containing particular PD subscription information. */
 typedef struct
 {
@@ -497,8 +644,28 @@ typedef struct
 typedef struct TRDP_SESSION *TRDP_APP_SESSION_T;
 typedef struct PD_ELE *TRDP_PUB_T;
 typedef struct PD_ELE *TRDP_SUB_T;
+typedef struct PD_SUB_GROUP *TRDP_SUB_GROUP_T;
 typedef struct MD_LIS_ELE *TRDP_LIS_T;
 
+/** One telegram of tlp_putMulti */
+typedef struct
+{
+    TRDP_PUB_T      pubHandle;      /**< handle returned by publish                 */
+    const UINT8     *pData;         /**< data to send                               */
+    UINT32          dataSize;       /**< size of the data                           */
+    TRDP_ERR_T      result;         /**< out: result of tlp_put for this telegram    */
+} TRDP_PUT_ITEM_T;
+
+/** One telegram of tlp_getMulti */
+typedef struct
+{
+    TRDP_SUB_T      subHandle;      /**< handle returned by subscribe               */
+    UINT8           *pData;         /**< buffer for the received data               */
+    UINT32          dataSize;       /**< in: size of the buffer, out: size of data  */
+    TRDP_ERR_T      result;         /**< out: result of tlp_get for this telegram    */
+    TRDP_PD_INFO_T  pdInfo;         /**< out: info of the received telegram          */
+} TRDP_GET_ITEM_T;
+
 
 
 /**********************************************************************************************************************/
@@ -617,6 +784,45 @@ typedef struct
     UINT16              port;                   /**< Port to be used for PD communication       */
 } TRDP_PD_CONFIG_T;
 
+/**********************************************************************************************************************/
+/** One publisher for tlp_publishBatch, the parameters are those of tlp_publish    */
+typedef struct
+{
+    TRDP_PUB_T              pubHandle;              /**< out: handle of the publisher                       */
+    TRDP_ERR_T              result;                 /**< out: result of publishing this entry               */
+    const void              *pUserRef;              /**< user supplied value returned in the callback       */
+    TRDP_PD_CALLBACK_T      pfCbFunction;           /**< pre-send callback function, NULL if not used       */
+    UINT32                  comId;                  /**< comId of packet to send                            */
+    UINT32                  etbTopoCnt;             /**< ETB topocount to use                               */
+    UINT32                  opTrnTopoCnt;           /**< operational topocount                              */
+    TRDP_IP_ADDR_T          srcIpAddr;              /**< own IP address, 0 - set by the stack               */
+    TRDP_IP_ADDR_T          destIpAddr;             /**< where to send the packet to                        */
+    UINT32                  interval;               /**< frequency of PD packet in usec, 0 for PULL only    */
+    UINT32                  redId;                  /**< 0 - Non-redundant, > 0 valid redundancy group      */
+    TRDP_FLAGS_T            pktFlags;               /**< packet flags                                       */
+    const TRDP_SEND_PARAM_T *pSendParam;            /**< send parameters, NULL - default parameters         */
+    const UINT8             *pData;                 /**< initial data, NULL if sending starts with tlp_put  */
+    UINT32                  dataSize;               /**< size of the initial data                           */
+} TRDP_PUB_ENTRY_T;
+
+/** One subscriber for tlp_subscribeBatch, the parameters are those of tlp_subscribe    */
+typedef struct
+{
+    TRDP_SUB_T              subHandle;              /**< out: handle of the subscriber                      */
+    TRDP_ERR_T              result;                 /**< out: result of subscribing this entry              */
+    const void              *pUserRef;              /**< user supplied value returned in the callback       */
+    TRDP_PD_CALLBACK_T      pfCbFunction;           /**< callback function, NULL to use the default one     */
+    UINT32                  comId;                  /**< comId of packet to receive                         */
+    UINT32                  etbTopoCnt;             /**< ETB topocount to use                               */
+    UINT32                  opTrnTopoCnt;           /**< operational topocount                              */
+    TRDP_IP_ADDR_T          srcIpAddr1;             /**< source IP address or lower address of a range      */
+    TRDP_IP_ADDR_T          srcIpAddr2;             /**< upper address of a source range, 0 if not used     */
+    TRDP_IP_ADDR_T          destIpAddr;             /**< IP address to join                                 */
+    TRDP_FLAGS_T            pktFlags;               /**< packet flags                                       */
+    UINT32                  timeout;                /**< timeout in usec, 0 - default timeout               */
+    TRDP_TO_BEHAVIOR_T      toBehavior;             /**< timeout behavior                                   */
+} TRDP_SUB_ENTRY_T;
+
 
 /**********************************************************************************************************************/
 /**    Callback for receiving indications, timeouts, releases, responses.
@@ -651,6 +857,8 @@ typedef struct
     UINT16              udpPort;                /**< Port to be used for UDP MD communication   */
     UINT16              tcpPort;                /**< Port to be used for TCP MD communication   */
     UINT32              maxNumSessions;         /**< Maximal number of replier sessions         */
+    UINT32              maxNumIdleConn;         /**< Maximal number of idle TCP caller connections kept open
+                                                     for reuse (connectTimeout), 0 = no limit   */
 } TRDP_MD_CONFIG_T;
 
 
@@ -665,6 +873,7 @@ typedef struct
     UINT8   *p;                                     /**< pointer to static or allocated memory  */
     UINT32  size;                                   /**< size of static or allocated memory     */
     UINT32  prealloc[VOS_MEM_NBLOCKSIZES];          /**< memory block structure                 */
+    UINT32  blockSize[VOS_MEM_NBLOCKSIZES];         /**< block sizes, all 0: VOS_MEM_BLOCKSIZES */
 } TRDP_MEM_CONFIG_T;
 
 
@@ -684,7 +893,35 @@ typedef struct
                                                   Default: Allow                                            */
 #define TRDP_OPTION_NO_UDP_CHK      0x10u       /**< Suppress UDP CRC generation
                                                   Default: Compute UDP CRC                                  */
-typedef UINT8 TRDP_OPTION_T;
+#define TRDP_OPTION_PD_THREAD       0x20u       /**< Receive PD in a separate thread, PD callbacks are called
+                                                  from that thread, tlp_get() does not lock the session
+                                                  Default: PD is received by tlc_process() and tlp_get()    */
+#define TRDP_OPTION_TIMING_STATS    0x40u       /**< Collect timing statistics (tlc_getTimingStatistics)
+                                                  Default: OFF                                              */
+#define TRDP_OPTION_RX_TIMESTAMPS   0x80u       /**< Take the PD reception time from kernel or NIC time stamps
+                                                  Default: time the frame is read from the socket           */
+#define TRDP_OPTION_PREALLOCATE     0x100u      /**< Allocate the buffers for the configured telegrams in
+                                                  tlc_setOperational(), no allocation during traffic
+                                                  Default: allocate on demand                               */
+#define TRDP_OPTION_BUSY_POLL       0x200u      /**< Low latency PD receive: busy poll the PD sockets in the
+                                                  driver (Linux SO_BUSY_POLL) and spin on them for
+                                                  busyPollBudget after reading, trades CPU for latency
+                                                  Default: OFF                                              */
+#define TRDP_OPTION_TOPO_FOLLOW     0x400u      /**< Publishers and subscriptions using the current topocounts
+                                                  follow a change of the session topocounts: their queued
+                                                  frames and filters are updated in place, no tlp_republish()
+                                                  or tlp_resubscribe() needed
+                                                  Default: OFF                                              */
+#define TRDP_OPTION_MD_UDP_SEGMENT  0x800u      /**< UDP MD: pass runs of equal sized notifications to the
+                                                  same destination to the kernel in one call (Linux
+                                                  UDP_SEGMENT) and take coalesced datagrams (UDP_GRO)
+                                                  Default: OFF                                              */
+#define TRDP_OPTION_SHARE_SOCKETS   0x1000u     /**< Share the PD receive sockets with the other sessions of the
+                                                  process on the same address which set this option, frames
+                                                  are handed to the session subscribing them. Not with
+                                                  TRDP_OPTION_PD_THREAD or TRDP_OPTION_BLOCK
+                                                  Default: each session opens its own sockets               */
+typedef UINT16 TRDP_OPTION_T;
 
 /**********************************************************************************************************************/
 /** Various flags/general TRDP options for library initialization
@@ -696,6 +933,16 @@ typedef struct
     UINT32          cycleTime;      /**< TRDP main process cycle time in us  */
     UINT32          priority;       /**< TRDP main process priority (0-255, 0=default, 255=highest)   */
     TRDP_OPTION_T   options;        /**< TRDP options */
+    UINT32          busyPollBudget; /**< TRDP_OPTION_BUSY_POLL: spin time in us, 0 for TRDP_PD_BUSY_POLL_BUDGET */
+    UINT32          pdRcvShards;    /**< TRDP_OPTION_PD_THREAD: no. of receive threads, each with own sockets for
+                                         the comIds with comId % pdRcvShards == thread no. 0/1: one thread.
+                                         A subscription to any comId (0) gets the comIds of thread 0 only */
+    UINT32          cbWorkers;      /**< no. of worker threads calling the PD receive and MD callbacks in order of
+                                         their comId while the stack goes on, 0: called by the stack in place */
+    UINT32          budgetFrames;   /**< max. no. of frames received per tlc_process() call, 0: unlimited.
+                                         Due PDs are always sent, the rest is read by the next call and
+                                         tlc_getInterval() returns a zero interval until the backlog is done */
+    UINT32          budgetTime;     /**< max. time in us spent receiving per tlc_process() call, 0: unlimited */
 } TRDP_PROCESS_CONFIG_T;
 
 
@@ -43,6 +43,12 @@
  * TYPEDEFS
  */
 
+/** Context of an ECSP confirmation request handed over to the MD callback */
+typedef struct
+{
+    TAU_ECSP_CONF_CB_T  pfCbFunction;
+    void                *pRefCon;
+} TAU_ECSP_CONF_CTX_T;
 
 /**********************************************************************************************************************
  *   Locals
@@ -53,6 +59,117 @@ static TRDP_SUB_T       priv_subHandle  = 0;            /*    Our identifier to
 static TRDP_IP_ADDR_T   priv_ecspIpAddr = 0u;           /*    ECSP IP address                                       */
 static BOOL8            priv_ecspCtrlInitialised = FALSE;
 
+static VOS_MUTEX_T      priv_statMutex  = NULL;         /*    Protects the cached ECSP status                       */
+static TRDP_ECSP_STAT_T priv_ecspStat;                  /*    Last received ECSP status                             */
+static TRDP_PD_INFO_T   priv_ecspStatInfo;              /*    PD info of the last received ECSP status              */
+static TRDP_ERR_T       priv_ecspStatErr = TRDP_NODATA_ERR; /* Result of the last status reception              */
+static TAU_ECSP_STAT_CB_T   priv_pfStatCb   = NULL;     /*    Called on status changes                              */
+static void                 *priv_pStatRefCon = NULL;
+
+
+/**********************************************************************************************************************/
+/**    Callback for the ECSP status telegram
+ *
+ *  Cache the received status and notify the application if it changed or timed out.
+ *
+ *  @param[in]      pRefCon         unused
+ *  @param[in]      appHandle       Application handle
+ *  @param[in]      pMsg            Pointer to the message info
+ *  @param[in]      pData           Pointer to the received status
+ *  @param[in]      dataSize        Size of the received status
+ *
+ */
+static void ecspStatCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_ECSP_STAT_T    ecspStat;
+    BOOL8               changed = FALSE;
+    TAU_ECSP_STAT_CB_T  pfCb;
+    void                *pCbRefCon;
+
+    (void) pRefCon;
+
+    memset(&ecspStat, 0, sizeof(ecspStat));
+    if (pMsg->resultCode == TRDP_NO_ERR && pData != NULL)
+    {
+        memcpy(&ecspStat, pData, (dataSize < sizeof(ecspStat)) ? dataSize : sizeof(ecspStat));
+    }
+    else if (pMsg->resultCode != TRDP_TIMEOUT_ERR)
+    {
+        return;
+    }
+
+    if (vos_mutexLock(priv_statMutex) != VOS_NO_ERR)
+    {
+        return;
+    }
+    if (pMsg->resultCode != priv_ecspStatErr ||
+        memcmp(&ecspStat, &priv_ecspStat, sizeof(ecspStat)) != 0)
+    {
+        changed = TRUE;
+    }
+    priv_ecspStat       = ecspStat;
+    priv_ecspStatInfo   = *pMsg;
+    priv_ecspStatErr    = pMsg->resultCode;
+    pfCb        = priv_pfStatCb;
+    pCbRefCon   = priv_pStatRefCon;
+    (void) vos_mutexUnlock(priv_statMutex);
+
+    if (changed == TRUE && pfCb != NULL)
+    {
+        pfCb(pCbRefCon, appHandle, &ecspStat, pMsg);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Callback for the ECSP confirmation reply, hands the decoded reply to the application
+ *
+ *  @param[in]      pRefCon         unused
+ *  @param[in]      appHandle       Application handle
+ *  @param[in]      pMsg            Pointer to the message info, pUserRef refers to the request context
+ *  @param[in]      pData           Pointer to the received reply
+ *  @param[in]      dataSize        Size of the received reply
+ *
+ */
+static void ecspConfCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TAU_ECSP_CONF_CTX_T     *pCtx = (TAU_ECSP_CONF_CTX_T *) pMsg->pUserRef;
+    TRDP_ECSP_CONF_REPLY_T  reply;
+    TRDP_ERR_T              result = pMsg->resultCode;
+
+    (void) pRefCon;
+
+    if (pCtx == NULL)
+    {
+        return;
+    }
+    if (result == TRDP_NO_ERR)
+    {
+        if (pData == NULL || dataSize < sizeof(TRDP_ECSP_CONF_REPLY_T))
+        {
+            result = TRDP_WIRE_ERR;
+        }
+        else
+        {
+            memcpy(&reply, pData, sizeof(reply));
+        }
+    }
+    if (pCtx->pfCbFunction != NULL)
+    {
+        pCtx->pfCbFunction(pCtx->pRefCon, appHandle, (result == TRDP_NO_ERR) ? &reply : NULL, result);
+    }
+    vos_memFree(pCtx);
+}
+
 
 /**********************************************************************************************************************/
 /*    Train switch control                                                                                            */
@@ -76,6 +193,16 @@ EXT_DECL TRDP_ERR_T tau_initEcspCtrl ( TRDP_APP_SESSION_T   appHandle,
 
     priv_ecspIpAddr = ecspIpAddr;
 
+    if (priv_statMutex == NULL &&
+        vos_mutexCreate(&priv_statMutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_mutexCreate() failed !\n");
+        return TRDP_INIT_ERR;
+    }
+    memset(&priv_ecspStat, 0, sizeof(priv_ecspStat));
+    memset(&priv_ecspStatInfo, 0, sizeof(priv_ecspStatInfo));
+    priv_ecspStatErr = TRDP_NODATA_ERR;
+
     /*    Copy the packet into the internal send queue, prepare for sending.    */
     /*    If we change the data, just re-publish it    */
     err = tlp_publish(  appHandle,                  /*    our application identifier        */
@@ -102,13 +229,13 @@ EXT_DECL TRDP_ERR_T tau_initEcspCtrl ( TRDP_APP_SESSION_T   appHandle,
     err = tlp_subscribe( appHandle,                 /*    our application identifier            */
                          &priv_subHandle,           /*    our subscription identifier           */
                          NULL,                      /*    user ref                              */
-                         NULL,                      /*    callback function                     */
+                         ecspStatCallback,          /*    callback function, caches the status  */
                          TRDP_ECSP_STAT_COMID,      /*    ComID                                 */
                          0,                         /*    ecnTopoCounter                        */
                          0,                         /*    opTopoCounter                         */
                          0, 0,                      /*    Source IP filter                      */
                          appHandle->realIP,         /*    Default destination    (or MC Group)  */
-                         TRDP_FLAGS_MARSHALL,       /*    packet flags - UDP, no call back      */
+                         (TRDP_FLAGS_T) (TRDP_FLAGS_MARSHALL | TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB),
                          ECSP_STAT_TIMEOUT,         /*    Time out in us                        */
                          TRDP_TO_SET_TO_ZERO);      /*    delete invalid data on timeout        */
 
@@ -143,6 +270,8 @@ EXT_DECL TRDP_ERR_T tau_terminateEcspCtrl (TRDP_APP_SESSION_T appHandle)
         TRDP_ERR_T err;
 
         priv_ecspCtrlInitialised = FALSE;
+        priv_pfStatCb       = NULL;
+        priv_pStatRefCon    = NULL;
 
         err = tlp_unpublish(appHandle, priv_pubHandle);
         if ( err != TRDP_NO_ERR )
@@ -190,31 +319,48 @@ EXT_DECL TRDP_ERR_T tau_setEcspCtrl ( TRDP_APP_SESSION_T    appHandle,
 
 /**********************************************************************************************************************/
 /**    Function to get ECSP status information
+ *
+ *  Returns the status cached on its last reception, without accessing the TRDP session.
  *
  *  @param[in]      appHandle       Application handle
  *  @param[in,out]  pEcspStat       Pointer to the ECSP status structure
- *  @param[in,out]  pPdInfo         Pointer to PD status information
+ *  @param[in,out]  pPdInfo         Pointer to PD status information, may be NULL
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_NOINIT_ERR module not initialised
  *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR no status received yet
+ *  @retval         TRDP_TIMEOUT_ERR status timed out
  *
  */
 EXT_DECL TRDP_ERR_T tau_getEcspStat ( TRDP_APP_SESSION_T    appHandle,
                                       TRDP_ECSP_STAT_T      *pEcspStat,
                                       TRDP_PD_INFO_T        *pPdInfo)
 {
-    if (priv_ecspCtrlInitialised == TRUE)
+    TRDP_ERR_T err;
+
+    if (priv_ecspCtrlInitialised != TRUE)
     {
-        UINT32 receivedSize = sizeof(TRDP_ECSP_STAT_T);
-        return tlp_get(appHandle,
-                       priv_subHandle,
-                       pPdInfo,
-                       (UINT8 *) pEcspStat,
-                       &receivedSize);
+        return TRDP_NOINIT_ERR;
+    }
+    if (pEcspStat == NULL)
+    {
+        return TRDP_PARAM_ERR;
     }
 
-    return TRDP_NOINIT_ERR;
+    /* the status is cached by the subscription callback, no need to access the receive queue */
+    if (vos_mutexLock(priv_statMutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    *pEcspStat = priv_ecspStat;
+    if (pPdInfo != NULL)
+    {
+        *pPdInfo = priv_ecspStatInfo;
+    }
+    err = priv_ecspStatErr;
+    (void) vos_mutexUnlock(priv_statMutex);
+    return err;
 }
 
 
@@ -253,7 +399,7 @@ EXT_DECL TRDP_ERR_T tau_requestEcspConfirm ( TRDP_APP_SESSION_T         appHandl
                             1,                              /* numReplies */
                             ECSP_CONF_REPLY_TIMEOUT,        /* replyTimeout */
                             NULL,                           /* pSendParam */
-                            (const UINT8 *) &pEcspConfRequest,
+                            (const UINT8 *) pEcspConfRequest,
                             sizeof(TRDP_ECSP_CONF_REQUEST_T),
                             NULL,                           /* srcUri */
                             NULL);                          /* destUri */
@@ -261,3 +407,104 @@ EXT_DECL TRDP_ERR_T tau_requestEcspConfirm ( TRDP_APP_SESSION_T         appHandl
 
     return TRDP_NOINIT_ERR;
 }
+
+
+/**********************************************************************************************************************/
+/**    Function to register a callback for ECSP status changes
+ *
+ *  The callback is called from within tlc_process() whenever the content of the received ECSP status changes
+ *  or its reception times out.
+ *
+ *  @param[in]      appHandle           Application Handle
+ *  @param[in]      pfCbFunction        Pointer to callback function, NULL to unregister
+ *  @param[in]      pRefCon             user reference passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_NOINIT_ERR module not initialised
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_setEcspStatCallback ( TRDP_APP_SESSION_T    appHandle,
+                                              TAU_ECSP_STAT_CB_T    pfCbFunction,
+                                              void                  *pRefCon)
+{
+    (void) appHandle;
+
+    if (priv_ecspCtrlInitialised != TRUE)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (vos_mutexLock(priv_statMutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    priv_pfStatCb       = pfCbFunction;
+    priv_pStatRefCon    = pRefCon;
+    (void) vos_mutexUnlock(priv_statMutex);
+    return TRDP_NO_ERR;
+}
+
+
+/**********************************************************************************************************************/
+/**    Function for an ECSP confirmation/correction request, the decoded reply is passed to a callback
+ *
+ *  The function returns after queueing the request. The callback is called from within tlc_process() with the
+ *  reply, or with NULL and the error on timeout.
+ *
+ *  @param[in]      appHandle           Application Handle
+ *  @param[in]      pEcspConfRequest    Pointer to confirmation data
+ *  @param[in]      pfCbFunction        Pointer to callback function
+ *  @param[in]      pRefCon             user reference passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_NOINIT_ERR module not initialised
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_requestEcspConfirmAsync ( TRDP_APP_SESSION_T                appHandle,
+                                                  const TRDP_ECSP_CONF_REQUEST_T    *pEcspConfRequest,
+                                                  TAU_ECSP_CONF_CB_T                pfCbFunction,
+                                                  void                              *pRefCon)
+{
+    TAU_ECSP_CONF_CTX_T *pCtx;
+    TRDP_ERR_T          err;
+
+    if (priv_ecspCtrlInitialised != TRUE)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (pEcspConfRequest == NULL || pfCbFunction == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pCtx = (TAU_ECSP_CONF_CTX_T *) vos_memAlloc(sizeof(TAU_ECSP_CONF_CTX_T));
+    if (pCtx == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pCtx->pfCbFunction  = pfCbFunction;
+    pCtx->pRefCon       = pRefCon;
+
+    err = tlm_request( appHandle,                      /* appHandle */
+                       pCtx,                           /* pUserRef */
+                       ecspConfCallback,               /* callback function */
+                       NULL,                           /* pSessionId */
+                       TRDP_ECSP_CONF_REQ_COMID,       /* comId */
+                       0,                              /* etbTopoCnt */
+                       0,                              /* opTrnTopoCnt */
+                       appHandle->realIP,              /* srcIpAddr */
+                       priv_ecspIpAddr,                /* destIpAddr */
+                       TRDP_FLAGS_CALLBACK,            /* pktFlags */
+                       1,                              /* numReplies */
+                       ECSP_CONF_REPLY_TIMEOUT,        /* replyTimeout */
+                       NULL,                           /* pSendParam */
+                       (const UINT8 *) pEcspConfRequest,
+                       sizeof(TRDP_ECSP_CONF_REQUEST_T),
+                       NULL,                           /* srcUri */
+                       NULL);                          /* destUri */
+    if (err != TRDP_NO_ERR)
+    {
+        vos_memFree(pCtx);
+    }
+    return err;
+}
@@ -41,13 +41,13 @@
 #include "trdp_if_light.h"
 #include "vos_mem.h"
 #include "vos_sock.h"
+#include "vos_shared_mem.h"
 
 
 /***********************************************************************************************************************
  * DEFINES
  */
 
-#define TAU_MAX_HOSTS_LINE_LENGTH   120u
 #define TAU_MAX_NO_CACHE_ENTRY      50u
 #define TAU_MAX_NO_IF               4u      /**< Default interface should be in the first 4 */
 #define TAU_MAX_DNS_BUFFER_SIZE     1500u   /* if this doesn't suffice, we need to allocate it */
@@ -58,6 +58,25 @@
 
 #define TAU_MAX_HOST_URI_LEN        80u     /**< Including EOS! */
 
+#define TAU_DNR_INDEX_SIZE          128u    /**< Slots per hash index, power of 2 and > 2 * TAU_MAX_NO_CACHE_ENTRY */
+#define TAU_DNR_MAX_TTL             86400u  /**< Upper limit in seconds for the validity of DNS answers               */
+
+#define TAU_DNR_IMAGE_MAGIC         "TRDPHST1"  /**< Start of a binary hosts image                                    */
+#define TAU_DNR_IMAGE_RECORD_SIZE   12u     /**< Address, URI offset and address order position of a host             */
+
+#define TAU_DNR_AREA_MAGIC          0x544E5231u /**< "TNR1", shared cache of this layout                          */
+#define TAU_DNR_LOCK_DELAY          1000u   /**< us to wait for the shared cache lock                                 */
+#define TAU_DNR_LOCK_TRIES          1000u   /**< the lock is taken over after this, its holder died                   */
+
+/*  The shared cache is locked with an atomic exchange, processes do not share a VOS mutex  */
+#ifdef __GNUC__
+#define DNR_LOCK_TAKE(pLock)        __atomic_exchange_n((pLock), 1u, __ATOMIC_ACQUIRE)
+#define DNR_LOCK_GIVE(pLock)        __atomic_store_n((pLock), 0u, __ATOMIC_RELEASE)
+#define DNR_SHARED_CACHE            1
+#else
+#define DNR_SHARED_CACHE            0
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -68,17 +87,74 @@ typedef struct tau_dnr_cache
     TRDP_IP_ADDR_T  ipAddr;
     UINT32          etbTopoCnt;
     UINT32          opTrnTopoCnt;
-    BOOL8           fixedEntry;
+    UINT8           waiters;                        /**< asynchronous requests waiting for it       */
+    UINT16          queryId;                        /**< id of the pending standard DNS query       */
+    TRDP_TIME_T     validUntil;                     /**< end of the DNS TTL, zero if unlimited      */
+    TRDP_TIME_T     retryAt;                        /**< pending refresh is given up after this     */
 } TAU_DNR_ENTRY_T;
 
+typedef struct tau_dnr_host
+{
+    const CHAR8     *pUri;                          /**< host name within the string pool           */
+    TRDP_IP_ADDR_T  ipAddr;
+} TAU_DNR_HOST_T;
+
+/** Header of a binary hosts image, counts in network byte order. It is followed by one record per host in URI order
+    (see TAU_DNR_IMAGE_RECORD_SIZE) and the string pool of the zero terminated URIs. */
+typedef struct tau_dnr_image_hdr
+{
+    CHAR8   magic[8];
+    UINT32  noOfHosts;
+    UINT32  poolSize;
+} TAU_DNR_IMAGE_HDR_T;
+
+typedef struct tau_dnr_pending
+{
+    struct tau_dnr_pending  *pNext;
+    TRDP_APP_SESSION_T      appHandle;              /**< session which asked, receives the callback */
+    TRDP_URI_HOST_T         uri;                    /**< URI asked for                              */
+    TAU_DNR_CALLBACK_T      pfCbFunction;           /**< callback to report the result              */
+    void                    *pRefCon;               /**< user context for the callback              */
+    BOOL8                   sent;                   /**< part of the outstanding TCN-DNS request    */
+    TRDP_IP_ADDR_T          addr;                   /**< result to report                           */
+    TRDP_ERR_T              result;
+} TAU_DNR_PENDING_T;
+
+/** The cache and its indexes. It holds no pointers, so it can be placed in shared memory and used by the DNR of
+    several processes. */
+typedef struct tau_dnr_cache_area
+{
+    UINT32          magic;                          /**< TAU_DNR_AREA_MAGIC in shared memory        */
+    UINT32          lock;                           /**< != 0 while a process updates shared memory */
+    UINT32          noOfCachedEntries;              /**< no of items currently in the cache         */
+    UINT32          nextVictim;                     /**< round robin replacement if cache is full   */
+    UINT8           uriIndex[TAU_DNR_INDEX_SIZE];   /**< URI hash -> cache position + 1             */
+    UINT8           addrIndex[TAU_DNR_INDEX_SIZE];  /**< IP address hash -> cache position + 1      */
+    TAU_DNR_ENTRY_T cache[TAU_MAX_NO_CACHE_ENTRY];  /**< resolved and asked for URIs                */
+} TAU_DNR_CACHE_T;
+
+/** The DNR of a session, it may be shared by several sessions of the process (tau_shareDnr) */
 typedef struct tau_dnr_data
 {
+    VOS_MUTEX_T     mutex;                          /**< replies arrive in the tlc_process thread   */
+    UINT32          refCnt;                         /**< sessions using this DNR                    */
     TRDP_IP_ADDR_T  dnsIpAddr;                      /**< IP address of the resolver                 */
     UINT16          dnsPort;                        /**< 53 for standard DNS or 17225 for TCN-DNS   */
     UINT8           timeout;                        /**< timeout for requests (in seconds)          */
     TRDP_DNR_OPTS_T useTCN_DNS;                     /**< how to use TCN DNR                         */
-    UINT32          noOfCachedEntries;              /**< no of items currently in the cache         */
-    TAU_DNR_ENTRY_T cache[TAU_MAX_NO_CACHE_ENTRY];  /**< if != 0 use TCN DNS as resolver            */
+    SOCKET          dnsSocket;                      /**< socket for standard DNS refresh queries    */
+    UINT8           querySeq;                       /**< upper byte of standard DNS query ids       */
+    BOOL8           tcnOutstanding;                 /**< asynchronous TCN-DNS request not answered  */
+    TRDP_APP_SESSION_T  tcnSession;                 /**< session which sent that request            */
+    TRDP_UUID_T     tcnSessionId;                   /**< its MD session id                          */
+    TAU_DNR_PENDING_T   *pPending;                  /**< asynchronous requests in order of arrival  */
+    UINT32          noOfHosts;                      /**< entries read from the hosts file           */
+    TAU_DNR_HOST_T  *pHosts;                        /**< hosts file entries sorted by URI           */
+    TAU_DNR_HOST_T  **ppHostsByAddr;                /**< the same sorted by IP address              */
+    CHAR8           *pHostsPool;                    /**< hosts file contents holding the URIs       */
+    VOS_SHRD_T      shm;                            /**< shared memory holding the cache, or NULL   */
+    TAU_DNR_CACHE_T *pCache;                        /**< localCache or the shared memory area       */
+    TAU_DNR_CACHE_T localCache;                     /**< cache of this process                      */
 } TAU_DNR_DATA_T;
 
 typedef struct tau_dnr_query
@@ -143,6 +219,15 @@ typedef struct QUESTION
  *   Locals
  */
 
+static void dnrMDCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize);
+
+static UINT8 sTCN_DNS_Buffer[sizeof(TRDP_DNS_REQUEST_T)];
+
 
 #pragma mark ----------------------- Local -----------------------------
 
@@ -249,117 +334,706 @@ static void changetoDnsNameFormat (UINT8 *pDns, CHAR8 *pHost)
     *pDns++ = '\0';
 }
 
-static int compareURI ( const void *arg1, const void *arg2 )
+/**********************************************************************************************************************/
+/**    Lock the cache shared with other processes, if it is in shared memory
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *
+ */
+static void dnrAreaLock (
+    TAU_DNR_DATA_T *pDNR)
 {
-    return vos_strnicmp((const CHAR8 *)arg1, (const CHAR8 *)arg2, TRDP_MAX_URI_HOST_LEN);
+#if DNR_SHARED_CACHE
+    UINT32 tries = 0u;
+
+    if (pDNR->shm == NULL)
+    {
+        return;
+    }
+    while (DNR_LOCK_TAKE(&pDNR->pCache->lock) != 0u)
+    {
+        if (++tries > TAU_DNR_LOCK_TRIES)
+        {
+            /* It is held for a few microseconds only, a process holding it for a second has died */
+            vos_printLogStr(VOS_LOG_WARNING, "Lock of the shared DNR cache taken over\n");
+            break;
+        }
+        (void) vos_threadDelay(TAU_DNR_LOCK_DELAY);
+    }
+#else
+    (void) pDNR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/**    Unlock the cache shared with other processes
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *
+ */
+static void dnrAreaUnlock (
+    TAU_DNR_DATA_T *pDNR)
+{
+#if DNR_SHARED_CACHE
+    if (pDNR->shm != NULL)
+    {
+        DNR_LOCK_GIVE(&pDNR->pCache->lock);
+    }
+#else
+    (void) pDNR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/**    Lock the DNR against the other sessions and threads of the process and the cache against other processes
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_MUTEX_ERR   mutex error
+ */
+static VOS_ERR_T dnrLock (
+    TAU_DNR_DATA_T *pDNR)
+{
+    VOS_ERR_T err = vos_mutexLock(pDNR->mutex);
+
+    if (err == VOS_NO_ERR)
+    {
+        dnrAreaLock(pDNR);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Release the locks taken by dnrLock()
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *
+ */
+static void dnrUnlock (
+    TAU_DNR_DATA_T *pDNR)
+{
+    dnrAreaUnlock(pDNR);
+    (void) vos_mutexUnlock(pDNR->mutex);
 }
 
 static void printDNRcache (TAU_DNR_DATA_T *pDNR)
 {
     UINT32 i;
-    for (i = 0u; i < pDNR->noOfCachedEntries; i++)
+    for (i = 0u; i < pDNR->noOfHosts; i++)
+    {
+        vos_printLog(VOS_LOG_DBG, "%03u:\t%s\t%s\t(hosts file)\n", i,
+                     vos_ipDotted(pDNR->pHosts[i].ipAddr), pDNR->pHosts[i].pUri);
+    }
+    for (i = 0u; i < pDNR->pCache->noOfCachedEntries; i++)
     {
         vos_printLog(VOS_LOG_DBG, "%03u:\t%0u.%0u.%0u.%0u\t%s\t(topo: 0x%08x/0x%08x)\n", i,
-                     pDNR->cache[i].ipAddr >> 24u,
-                     (pDNR->cache[i].ipAddr >> 16u) & 0xFFu,
-                     (pDNR->cache[i].ipAddr >> 8u) & 0xFFu,
-                     pDNR->cache[i].ipAddr & 0xFFu,
-                     pDNR->cache[i].uri,
-                     pDNR->cache[i].etbTopoCnt,
-                     pDNR->cache[i].opTrnTopoCnt);
+                     pDNR->pCache->cache[i].ipAddr >> 24u,
+                     (pDNR->pCache->cache[i].ipAddr >> 16u) & 0xFFu,
+                     (pDNR->pCache->cache[i].ipAddr >> 8u) & 0xFFu,
+                     pDNR->pCache->cache[i].ipAddr & 0xFFu,
+                     pDNR->pCache->cache[i].uri,
+                     pDNR->pCache->cache[i].etbTopoCnt,
+                     pDNR->pCache->cache[i].opTrnTopoCnt);
     }
 }
 
 /**********************************************************************************************************************/
-/**    Function to populate the cache from a hosts file
+/**    Hash a host URI, case insensitive like the comparison
  *
- *  @param[in]      pDNR                Pointer to dnr data
- *  @param[in]      pHostsFileName      Hosts file name as ECSP replacement
+ *  @param[in]      pUri            Host part of the URI
+ *
+ *  @retval         hash value
+ */
+static UINT32 dnrHashUri (
+    const CHAR8 *pUri)
+{
+    UINT32  hash = 2166136261u;     /* FNV-1a */
+    UINT32  i;
+
+    for (i = 0u; (i < TRDP_MAX_URI_HOST_LEN) && (pUri[i] != '\0'); i++)
+    {
+        hash    ^= (UINT32) tolower((int) pUri[i]);
+        hash    *= 16777619u;
+    }
+    return hash;
+}
+
+/**********************************************************************************************************************/
+/**    Hash an IP address
+ *
+ *  @param[in]      ipAddr          IP address
+ *
+ *  @retval         hash value
+ */
+static UINT32 dnrHashAddr (
+    TRDP_IP_ADDR_T ipAddr)
+{
+    UINT32 hash = ipAddr * 2654435761u;
+
+    return hash ^ (hash >> 16u);
+}
+
+/**********************************************************************************************************************/
+/**    Home position of a cache entry within one of the hash indexes
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      byAddr          TRUE for the address index, FALSE for the URI index
+ *  @param[in]      pos             Position of the entry in the cache
+ *
+ *  @retval         index position
+ */
+static UINT32 dnrIndexHome (
+    const TAU_DNR_DATA_T    *pDNR,
+    BOOL8                   byAddr,
+    UINT32                  pos)
+{
+    UINT32 hash = (byAddr == TRUE) ? dnrHashAddr(pDNR->pCache->cache[pos].ipAddr) : dnrHashUri(pDNR->pCache->cache[pos].uri);
+
+    return hash & (TAU_DNR_INDEX_SIZE - 1u);
+}
+
+/**********************************************************************************************************************/
+/**    Add a cache entry to one of the hash indexes (linear probing)
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      byAddr          TRUE for the address index, FALSE for the URI index
+ *  @param[in]      pos             Position of the entry in the cache
  *
  *  @retval         none
  */
+static void dnrIndexInsert (
+    TAU_DNR_DATA_T  *pDNR,
+    BOOL8           byAddr,
+    UINT32          pos)
+{
+    UINT8   *pIndex = (byAddr == TRUE) ? pDNR->pCache->addrIndex : pDNR->pCache->uriIndex;
+    UINT32  i       = dnrIndexHome(pDNR, byAddr, pos);
 
-static TRDP_ERR_T readHostsFile (
+    /* The index is more than twice as large as the cache, there is always a free slot */
+    while (pIndex[i] != 0u)
+    {
+        i = (i + 1u) & (TAU_DNR_INDEX_SIZE - 1u);
+    }
+    pIndex[i] = (UINT8) (pos + 1u);
+}
+
+/**********************************************************************************************************************/
+/**    Remove a cache entry from one of the hash indexes.
+ *  Must be called while the key of the entry is still unchanged. Following entries of the probe sequence are
+ *  shifted back, so no tombstones are needed.
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      byAddr          TRUE for the address index, FALSE for the URI index
+ *  @param[in]      pos             Position of the entry in the cache
+ *
+ *  @retval         none
+ */
+static void dnrIndexRemove (
     TAU_DNR_DATA_T  *pDNR,
-    const CHAR8     *pHostsFileName)
+    BOOL8           byAddr,
+    UINT32          pos)
 {
-    TRDP_ERR_T  err = TRDP_PARAM_ERR;
-    /* Note: MS says use of fopen is unsecure. Reading a hosts file is used for development only */
-    FILE        *fp = fopen(pHostsFileName, "r");
+    UINT8   *pIndex = (byAddr == TRUE) ? pDNR->pCache->addrIndex : pDNR->pCache->uriIndex;
+    UINT32  i       = dnrIndexHome(pDNR, byAddr, pos);
+    UINT32  j;
+    UINT32  home;
 
-    CHAR8       line[TAU_MAX_HOSTS_LINE_LENGTH];
+    while (pIndex[i] != (UINT8) (pos + 1u))
+    {
+        if (pIndex[i] == 0u)
+        {
+            return;                             /* not indexed */
+        }
+        i = (i + 1u) & (TAU_DNR_INDEX_SIZE - 1u);
+    }
 
-    if (fp != NULL)
+    for (j = (i + 1u) & (TAU_DNR_INDEX_SIZE - 1u); pIndex[j] != 0u; j = (j + 1u) & (TAU_DNR_INDEX_SIZE - 1u))
     {
-        /* while not end of file */
-        while ((!feof(fp)) && (pDNR->noOfCachedEntries < TAU_MAX_NO_CACHE_ENTRY))
+        home = dnrIndexHome(pDNR, byAddr, pIndex[j] - 1u);
+
+        /* Move the entry into the gap, if its home position does not lie cyclically within (i, j] */
+        if (((i <= j) && ((home <= i) || (home > j))) ||
+            ((i > j) && (home <= i) && (home > j)))
         {
-            /* get a line from the file */
-            if (fgets(line, TAU_MAX_HOSTS_LINE_LENGTH, fp) != NULL)
-            {
-                UINT32  start       = 0u;
-                UINT32  l_index       = 0u;
-                UINT32  maxIndex    = (UINT32) strlen(line);
-
-                /* Skip empty lines, comment lines */
-                if (line[l_index] == '#' ||
-                    line[l_index] == '\0' ||
-                    iscntrl(line[l_index]))
-                {
-                    continue;
-                }
+            pIndex[i]   = pIndex[j];
+            i           = j;
+        }
+    }
+    pIndex[i] = 0u;
+}
+
+/**********************************************************************************************************************/
+/**    Find a cache entry by its URI
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pUri            Host part of the URI
+ *
+ *  @retval         pointer to the entry or NULL
+ */
+static TAU_DNR_ENTRY_T *dnrFindUri (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pUri)
+{
+    UINT32 i = dnrHashUri(pUri) & (TAU_DNR_INDEX_SIZE - 1u);
 
-                /* Try to get IP */
-                pDNR->cache[pDNR->noOfCachedEntries].ipAddr = vos_dottedIP(&line[l_index]);
+    while (pDNR->pCache->uriIndex[i] != 0u)
+    {
+        TAU_DNR_ENTRY_T *pEntry = &pDNR->pCache->cache[pDNR->pCache->uriIndex[i] - 1u];
 
-                if (pDNR->cache[pDNR->noOfCachedEntries].ipAddr == VOS_INADDR_ANY)
-                {
-                    continue;
-                }
-                /* now skip the address */
-                while (l_index < maxIndex && (isdigit(line[l_index]) || ispunct(line[l_index])))
-                {
-                    l_index++;
-                }
+        if (vos_strnicmp(pEntry->uri, pUri, TRDP_MAX_URI_HOST_LEN) == 0)
+        {
+            return pEntry;
+        }
+        i = (i + 1u) & (TAU_DNR_INDEX_SIZE - 1u);
+    }
+    return NULL;
+}
 
-                /* skip the space between IP and URI */
-                while (l_index < maxIndex && isspace(line[l_index]))
-                {
-                    l_index++;
-                }
+/**********************************************************************************************************************/
+/**    Change the address of a cache entry and keep the address index up to date
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pEntry          Pointer to the cache entry
+ *  @param[in]      ipAddr          New address, VOS_INADDR_ANY if unresolved
+ *
+ *  @retval         none
+ */
+static void dnrSetAddr (
+    TAU_DNR_DATA_T  *pDNR,
+    TAU_DNR_ENTRY_T *pEntry,
+    TRDP_IP_ADDR_T  ipAddr)
+{
+    UINT32 pos = (UINT32) (pEntry - pDNR->pCache->cache);
+
+    if (pEntry->ipAddr == ipAddr)
+    {
+        return;
+    }
+    if (pEntry->ipAddr != VOS_INADDR_ANY)
+    {
+        dnrIndexRemove(pDNR, TRUE, pos);
+    }
+    pEntry->ipAddr = ipAddr;
+    if (ipAddr != VOS_INADDR_ANY)
+    {
+        dnrIndexInsert(pDNR, TRUE, pos);
+    }
+}
 
-                /* remember start of URI */
-                start = l_index;
+/**********************************************************************************************************************/
+/**    Get a cache entry for a new URI and index it.
+ *  If the cache is full, entries are replaced round robin. Entries awaited by asynchronous requests are never
+ *  replaced.
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pUri            Host part of the URI
+ *
+ *  @retval         pointer to the entry, address unresolved
+ *  @retval         NULL if all entries are awaited
+ */
+static TAU_DNR_ENTRY_T *dnrNewEntry (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pUri)
+{
+    UINT32          pos = pDNR->pCache->noOfCachedEntries;
+    UINT32          i;
+    TAU_DNR_ENTRY_T *pEntry;
 
-                /* remember start of URI */
-                while (l_index < maxIndex && !isspace(line[l_index]) && !iscntrl(line[l_index]) && line[l_index] != '#')
-                {
-                    l_index++;
-                }
-                if (l_index < maxIndex)
-                {
-                    vos_strncpy(pDNR->cache[pDNR->noOfCachedEntries].uri, &line[start], l_index - start);
-                }
-                /* increment only if entry is valid */
-                if (strlen(pDNR->cache[pDNR->noOfCachedEntries].uri) > 0u)
-                {
-                    pDNR->cache[pDNR->noOfCachedEntries].etbTopoCnt     = 0u;
-                    pDNR->cache[pDNR->noOfCachedEntries].opTrnTopoCnt   = 0u;
-                    pDNR->cache[pDNR->noOfCachedEntries].fixedEntry     = TRUE;
-                    pDNR->noOfCachedEntries++;
-                }
+    if (pos >= TAU_MAX_NO_CACHE_ENTRY)      /* Cache is full! */
+    {
+        for (i = 0u; i < TAU_MAX_NO_CACHE_ENTRY; i++)
+        {
+            pos = pDNR->pCache->nextVictim;
+            pDNR->pCache->nextVictim = (pDNR->pCache->nextVictim + 1u) % TAU_MAX_NO_CACHE_ENTRY;
+            if (pDNR->pCache->cache[pos].waiters == 0u)
+            {
+                break;
             }
         }
-        vos_printLog(VOS_LOG_DBG, "readHostsFile: %d entries processed\n", pDNR->noOfCachedEntries);
-        vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
+        if (i >= TAU_MAX_NO_CACHE_ENTRY)
+        {
+            return NULL;
+        }
+        dnrSetAddr(pDNR, &pDNR->pCache->cache[pos], VOS_INADDR_ANY);
+        dnrIndexRemove(pDNR, FALSE, pos);
+    }
+    else
+    {
+        pDNR->pCache->noOfCachedEntries++;
+    }
+
+    pEntry = &pDNR->pCache->cache[pos];
+    memset(pEntry, 0, sizeof(TAU_DNR_ENTRY_T));
+    vos_strncpy(pEntry->uri, pUri, TRDP_MAX_URI_HOST_LEN);
+    dnrIndexInsert(pDNR, FALSE, pos);
+    return pEntry;
+}
+
+/**********************************************************************************************************************/
+/**    Check if a cache entry belongs to the current topology
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pEntry          Pointer to the cache entry
+ *
+ *  @retval         TRUE            the topocounts match
+ */
+static BOOL8 dnrTopoMatches (
+    TRDP_APP_SESSION_T      appHandle,
+    const TAU_DNR_ENTRY_T   *pEntry)
+{
+    return ((pEntry->etbTopoCnt == appHandle->etbTopoCnt) ||                    /* Do the topocounts match? */
+            (pEntry->opTrnTopoCnt == appHandle->opTrnTopoCnt) ||
+            ((appHandle->etbTopoCnt == 0u) && (appHandle->opTrnTopoCnt == 0u))) /* Or do we not care?       */
+           ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/**    Compare two hosts by URI (case insensitive)
+ */
+static int compareHostUri (
+    const void  *arg1,
+    const void  *arg2)
+{
+    return vos_strnicmp(((const TAU_DNR_HOST_T *)arg1)->pUri,
+                        ((const TAU_DNR_HOST_T *)arg2)->pUri,
+                        TRDP_MAX_URI_HOST_LEN);
+}
+
+/**********************************************************************************************************************/
+/**    Compare two pointers to hosts by IP address
+ */
+static int compareHostAddr (
+    const void  *arg1,
+    const void  *arg2)
+{
+    TRDP_IP_ADDR_T  addr1   = (*(TAU_DNR_HOST_T * const *)arg1)->ipAddr;
+    TRDP_IP_ADDR_T  addr2   = (*(TAU_DNR_HOST_T * const *)arg2)->ipAddr;
+
+    return (addr1 < addr2) ? -1 : ((addr1 > addr2) ? 1 : 0);
+}
+
+/**********************************************************************************************************************/
+/**    Find a host of the hosts file by its URI
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pUri            Host part of the URI
+ *
+ *  @retval         pointer to the host or NULL
+ */
+static const TAU_DNR_HOST_T *dnrFindHostUri (
+    const TAU_DNR_DATA_T    *pDNR,
+    const CHAR8             *pUri)
+{
+    TAU_DNR_HOST_T key;
+
+    key.pUri    = pUri;
+    key.ipAddr  = VOS_INADDR_ANY;
+
+    return (const TAU_DNR_HOST_T *) vos_bsearch(&key, pDNR->pHosts, pDNR->noOfHosts, sizeof(TAU_DNR_HOST_T),
+                                                compareHostUri);
+}
+
+/**********************************************************************************************************************/
+/**    Find a host of the hosts file by its IP address
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      ipAddr          IP address
+ *
+ *  @retval         pointer to the host or NULL
+ */
+static const TAU_DNR_HOST_T *dnrFindHostAddr (
+    const TAU_DNR_DATA_T    *pDNR,
+    TRDP_IP_ADDR_T          ipAddr)
+{
+    TAU_DNR_HOST_T  key;
+    TAU_DNR_HOST_T  *pKey = &key;
+    TAU_DNR_HOST_T  **ppHost;
+
+    key.pUri    = NULL;
+    key.ipAddr  = ipAddr;
+
+    ppHost = (TAU_DNR_HOST_T **) vos_bsearch(&pKey, pDNR->ppHostsByAddr, pDNR->noOfHosts, sizeof(TAU_DNR_HOST_T *),
+                                             compareHostAddr);
+    return (ppHost != NULL) ? *ppHost : NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Release the hosts table
+ *
+ *  @param[in]      pDNR                Pointer to dnr data
+ *
+ */
+static void freeHosts (
+    TAU_DNR_DATA_T *pDNR)
+{
+    if (pDNR->pHosts != NULL)
+    {
+        vos_memFree(pDNR->pHosts);
+    }
+    if (pDNR->ppHostsByAddr != NULL)
+    {
+        vos_memFree(pDNR->ppHostsByAddr);
+    }
+    if (pDNR->pHostsPool != NULL)
+    {
+        vos_memFree(pDNR->pHostsPool);
+    }
+    pDNR->pHosts        = NULL;
+    pDNR->ppHostsByAddr = NULL;
+    pDNR->pHostsPool    = NULL;
+    pDNR->noOfHosts     = 0u;
+}
+
+/**********************************************************************************************************************/
+/**    Parse the text of a hosts file.
+ *  The URIs are terminated in place, the buffer becomes the string pool of the hosts table.
+ *
+ *  @param[in]      pDNR                Pointer to dnr data
+ *  @param[in]      pText               Hosts file contents, zero terminated
+ *  @param[in]      size                Size of the contents
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+static TRDP_ERR_T parseHostsText (
+    TAU_DNR_DATA_T  *pDNR,
+    CHAR8           *pText,
+    UINT32          size)
+{
+    UINT32  maxHosts = 1u;
+    UINT32  l_index;
+    UINT32  start;
+    UINT32  end;
+    CHAR8   *pLine;
+
+    for (l_index = 0u; l_index < size; l_index++)
+    {
+        if (pText[l_index] == '\n')
+        {
+            maxHosts++;
+        }
+    }
+
+    pDNR->pHosts = (TAU_DNR_HOST_T *) vos_memAlloc(maxHosts * sizeof(TAU_DNR_HOST_T));
+    if (pDNR->pHosts == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    for (pLine = pText; pLine < pText + size; pLine += end + 1u)
+    {
+        TRDP_IP_ADDR_T ipAddr;
+
+        /* Terminate the line */
+        for (end = 0u; (pLine + end < pText + size) && (pLine[end] != '\n'); end++)
+        {
+            ;
+        }
+        pLine[end] = '\0';
+
+        /* Skip empty lines, comment lines */
+        if (pLine[0] == '#' ||
+            pLine[0] == '\0' ||
+            iscntrl(pLine[0]))
+        {
+            continue;
+        }
+
+        /* Try to get IP */
+        ipAddr = vos_dottedIP(pLine);
+
+        if (ipAddr == VOS_INADDR_ANY)
+        {
+            continue;
+        }
+        /* now skip the address */
+        for (l_index = 0u; l_index < end && (isdigit(pLine[l_index]) || ispunct(pLine[l_index])); l_index++)
+        {
+            ;
+        }
+
+        /* skip the space between IP and URI */
+        while (l_index < end && isspace(pLine[l_index]))
+        {
+            l_index++;
+        }
+
+        /* remember start of URI */
+        start = l_index;
+
+        while (l_index < end && !isspace(pLine[l_index]) && !iscntrl(pLine[l_index]) && pLine[l_index] != '#')
+        {
+            l_index++;
+        }
+
+        /* take it only if the entry is valid */
+        if ((l_index > start) && (l_index - start <= TRDP_MAX_URI_HOST_LEN))
+        {
+            pLine[l_index] = '\0';
+            pDNR->pHosts[pDNR->noOfHosts].pUri      = &pLine[start];
+            pDNR->pHosts[pDNR->noOfHosts].ipAddr    = ipAddr;
+            pDNR->noOfHosts++;
+        }
+    }
+
+    /* Sort once by URI, the address order is derived from it */
+    vos_qsort(pDNR->pHosts, pDNR->noOfHosts, sizeof(TAU_DNR_HOST_T), compareHostUri);
+
+    pDNR->ppHostsByAddr = (TAU_DNR_HOST_T **) vos_memAlloc(maxHosts * sizeof(TAU_DNR_HOST_T *));
+    if (pDNR->ppHostsByAddr == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    for (l_index = 0u; l_index < pDNR->noOfHosts; l_index++)
+    {
+        pDNR->ppHostsByAddr[l_index] = &pDNR->pHosts[l_index];
+    }
+    vos_qsort(pDNR->ppHostsByAddr, pDNR->noOfHosts, sizeof(TAU_DNR_HOST_T *), compareHostAddr);
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Take over a binary hosts image as written by tau_writeHostsImage().
+ *  The image is already sorted, the string pool at its end is used in place.
+ *
+ *  @param[in]      pDNR                Pointer to dnr data
+ *  @param[in]      pImage              Hosts image
+ *  @param[in]      size                Size of the image
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      image is inconsistent
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+static TRDP_ERR_T parseHostsImage (
+    TAU_DNR_DATA_T  *pDNR,
+    CHAR8           *pImage,
+    UINT32          size)
+{
+    const TAU_DNR_IMAGE_HDR_T   *pHdr = (const TAU_DNR_IMAGE_HDR_T *) pImage;
+    const UINT8                 *pRecord;
+    const CHAR8                 *pPool;
+    UINT32                      noOfHosts;
+    UINT32                      poolSize;
+    UINT32                      i;
+    UINT32                      pos;
+
+    noOfHosts   = vos_ntohl(pHdr->noOfHosts);
+    poolSize    = vos_ntohl(pHdr->poolSize);
+
+    if ((noOfHosts > (size / TAU_DNR_IMAGE_RECORD_SIZE)) ||
+        (size != sizeof(TAU_DNR_IMAGE_HDR_T) + noOfHosts * TAU_DNR_IMAGE_RECORD_SIZE + poolSize) ||
+        ((poolSize > 0u) && (pImage[size - 1u] != '\0')))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "readHostsFile: Corrupt hosts image!\n");
+        return TRDP_PARAM_ERR;
+    }
+
+    pDNR->pHosts        = (TAU_DNR_HOST_T *) vos_memAlloc((noOfHosts + 1u) * sizeof(TAU_DNR_HOST_T));
+    pDNR->ppHostsByAddr = (TAU_DNR_HOST_T **) vos_memAlloc((noOfHosts + 1u) * sizeof(TAU_DNR_HOST_T *));
+    if ((pDNR->pHosts == NULL) || (pDNR->ppHostsByAddr == NULL))
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    /* Records of address, URI offset and position in address order, all UINT32 */
+    pRecord = (const UINT8 *) (pHdr + 1);
+    pPool   = pImage + sizeof(TAU_DNR_IMAGE_HDR_T) + noOfHosts * TAU_DNR_IMAGE_RECORD_SIZE;
+
+    for (i = 0u; i < noOfHosts; i++, pRecord += TAU_DNR_IMAGE_RECORD_SIZE)
+    {
+        pDNR->pHosts[i].ipAddr  = vos_ntohl(*(const UINT32 *) pRecord);
+        pos                     = vos_ntohl(*(const UINT32 *) (pRecord + 4u));
+        if (pos >= poolSize)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "readHostsFile: Corrupt hosts image!\n");
+            return TRDP_PARAM_ERR;
+        }
+        pDNR->pHosts[i].pUri    = pPool + pos;
+
+        pos = vos_ntohl(*(const UINT32 *) (pRecord + 8u));
+        if (pos >= noOfHosts)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "readHostsFile: Corrupt hosts image!\n");
+            return TRDP_PARAM_ERR;
+        }
+        pDNR->ppHostsByAddr[pos] = &pDNR->pHosts[i];
+    }
+    pDNR->noOfHosts = noOfHosts;
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Function to populate the hosts table from a hosts file or a binary hosts image.
+ *  The file is read at once, the text format is parsed in place and sorted once.
+ *
+ *  @param[in]      pDNR                Pointer to dnr data
+ *  @param[in]      pHostsFileName      Hosts file name as ECSP replacement
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      file not found or corrupt
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+static TRDP_ERR_T readHostsFile (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pHostsFileName)
+{
+    TRDP_ERR_T  err = TRDP_PARAM_ERR;
+    /* Note: MS says use of fopen is unsecure. Reading a hosts file is used for development only */
+    FILE        *fp = fopen(pHostsFileName, "rb");
+    long        fileSize;
+    CHAR8       *pBuffer;
+
+    if (fp == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "readHostsFile: Not found!\n");
+        return err;
+    }
+
+    if ((fseek(fp, 0L, SEEK_END) != 0) ||
+        ((fileSize = ftell(fp)) < 0L) ||
+        (fseek(fp, 0L, SEEK_SET) != 0))
+    {
+        fclose(fp);
+        return err;
+    }
+
+    /* The buffer is kept as string pool of the hosts table */
+    pBuffer = (CHAR8 *) vos_memAlloc((UINT32) fileSize + 1u);
+    if (pBuffer == NULL)
+    {
         fclose(fp);
-        printDNRcache(pDNR);
-        err = TRDP_NO_ERR;
+        return TRDP_MEM_ERR;
+    }
+
+    if (fread(pBuffer, 1u, (size_t) fileSize, fp) == (size_t) fileSize)
+    {
+        pDNR->pHostsPool = pBuffer;
+
+        if (((UINT32) fileSize >= sizeof(TAU_DNR_IMAGE_HDR_T)) &&
+            (memcmp(pBuffer, TAU_DNR_IMAGE_MAGIC, sizeof(((TAU_DNR_IMAGE_HDR_T *) 0)->magic)) == 0))
+        {
+            err = parseHostsImage(pDNR, pBuffer, (UINT32) fileSize);
+        }
+        else
+        {
+            err = parseHostsText(pDNR, pBuffer, (UINT32) fileSize);
+        }
     }
     else
     {
-        vos_printLogStr(VOS_LOG_ERROR, "readHostsFile: Not found!\n");
+        vos_memFree(pBuffer);
+    }
+    fclose(fp);
+
+    if (err != TRDP_NO_ERR)
+    {
+        freeHosts(pDNR);
     }
+    vos_printLog(VOS_LOG_DBG, "readHostsFile: %u entries processed\n", pDNR->noOfHosts);
+    printDNRcache(pDNR);
     return err; /*lint !e481 !e480 call states and execution paths? */
 }
 
@@ -434,7 +1108,8 @@ static void parseResponse (
     UINT32          size,
     UINT16          id,
     UINT32          querySize,
-    TRDP_IP_ADDR_T  *pIP_addr)
+    TRDP_IP_ADDR_T  *pIP_addr,
+    UINT32          *pTTL)
 {
     TAU_DNS_HEADER_T *dns = (TAU_DNS_HEADER_T *) pPacket;
     UINT8   *pReader;
@@ -476,6 +1151,7 @@ static void parseResponse (
             }
 
             *pIP_addr = (TRDP_IP_ADDR_T) ((pReader[0] << 24u) | (pReader[1] << 16u) | (pReader[2] << 8u) | pReader[3]);
+            *pTTL = vos_ntohl(answers[i].resource->ttl);
             vos_printLog(VOS_LOG_INFO, "%s -> 0x%08x\n", name, *pIP_addr);
 
             pReader = pReader + vos_ntohs(answers[i].resource->data_len);
@@ -578,128 +1254,163 @@ static void parseResponse (
 }
 
 /**********************************************************************************************************************/
-/**    Query the DNS server for the addresses
+/**    Send a standard DNS query for a cache entry without waiting for the reply.
+ *  The reply is picked up by dnrReceiveReplies() and matched by the query id, which carries the cache position.
  *
- *  @param[in]      appHandle           Handle returned by tlc_openSession()
- *  @param[in]      pTemp               Last entry which was invalid, can be NULL
- *  @param[in]      pUri                Pointer to host name
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pEntry          Pointer to the cache entry to resolve
  *
  *  @retval         TRDP_NO_ERR     no error
- *  @retval         TRDP_PARAM_ERR  Parameter error
- *  @retval         TRDP_INIT_ERR   initialisation error
+ *  @retval         TRDP_SOCK_ERR   socket error
  *
  */
-static void updateDNSentry (
-    TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_ENTRY_T     *pTemp,
-    const CHAR8         *pUri)
+static TRDP_ERR_T dnrSendQuery (
+    TAU_DNR_DATA_T  *pDNR,
+    TAU_DNR_ENTRY_T *pEntry)
 {
-    SOCKET          my_socket;
-    VOS_ERR_T       err;
-    UINT8           packetBuffer[TAU_MAX_DNS_BUFFER_SIZE];
-    UINT32          size;
-    UINT32          querySize;
     VOS_SOCK_OPT_T  opts;
-    UINT16          id      = (UINT16) ((UINT16) appHandle & 0xFFFFu);
-    TAU_DNR_DATA_T  *pDNR   = (TAU_DNR_DATA_T *) appHandle->pUser;
-    TRDP_IP_ADDR_T  ip_addr = VOS_INADDR_ANY;
+    TRDP_ERR_T      err;
+    TRDP_TIME_T     tv;
+    UINT32          querySize;
+    UINT16          id;
+
+    if (pDNR->dnsSocket == VOS_INVALID_SOCKET)
+    {
+        memset(&opts, 0, sizeof(opts));
 
-    memset(&opts, 0, sizeof(opts));
+        if (vos_sockOpenUDP(&pDNR->dnsSocket, &opts) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "dnrSendQuery failed to open socket\n");
+            pDNR->dnsSocket = VOS_INVALID_SOCKET;
+            return TRDP_SOCK_ERR;
+        }
+    }
+
+    id = (UINT16) (((UINT16) pDNR->querySeq++ << 8u) | (UINT16) ((pEntry - pDNR->pCache->cache) + 1));
 
-    err = vos_sockOpenUDP(&my_socket, &opts);
+    err = createSendQuery(pDNR, pDNR->dnsSocket, pEntry->uri, id, &querySize);
 
-    if (err != VOS_NO_ERR)
+    if (err == TRDP_NO_ERR)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "updateDNSentry failed to open socket\n");
-        return;
+        /* Don't ask again until the reply is overdue */
+        pEntry->queryId = id;
+        tv.tv_sec       = pDNR->timeout;
+        tv.tv_usec      = 0;
+        vos_getTime(&pEntry->retryAt);
+        vos_addTime(&pEntry->retryAt, &tv);
     }
+    return err;
+}
 
-    err = (VOS_ERR_T) createSendQuery(pDNR, my_socket, pUri, id, &querySize);
-
-    if (err != VOS_NO_ERR)
+/**********************************************************************************************************************/
+/**    Receive the replies to outstanding standard DNS queries and update the cache
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pDNR                Pointer to dnr data
+ *  @param[in]      pAwaited            Entry to wait for, NULL to collect available replies only
+ *
+ */
+static void dnrReceiveReplies (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR,
+    TAU_DNR_ENTRY_T     *pAwaited)
+{
+    UINT8           packetBuffer[TAU_MAX_DNS_BUFFER_SIZE];
+    CHAR8           name[TAU_MAX_NAME_SIZE];
+    UINT32          size;
+    UINT32          skip;
+    UINT32          pos;
+    UINT32          ttl;
+    UINT16          id;
+    UINT16          srcPort;
+    TRDP_IP_ADDR_T  srcIP;
+    TRDP_IP_ADDR_T  ip_addr;
+    TRDP_TIME_T     tv;
+    TAU_DNR_ENTRY_T *pEntry;
+
+    if (pDNR->dnsSocket == VOS_INVALID_SOCKET)
     {
-        goto exit;
+        return;
     }
 
-    /* wait for reply */
     for (;; )
     {
         VOS_FDS_T   rfds;
-        TRDP_TIME_T tv;
         int         rv;
 
-        tv.tv_sec   = pDNR->timeout;
+        tv.tv_sec   = (pAwaited != NULL) ? pDNR->timeout : 0;
         tv.tv_usec  = 0;
 
         FD_ZERO(&rfds);
-        FD_SET(my_socket, &rfds); /*lint !e573 Signed/unsigned mix in std-header */
+        FD_SET(pDNR->dnsSocket, &rfds); /*lint !e573 Signed/unsigned mix in std-header */
 
-        rv = vos_select(my_socket + 1, &rfds, NULL, NULL, &tv);
+        /* Other processes may use the shared cache meanwhile, pAwaited stays an entry of the cache */
+        if (pAwaited != NULL)
+        {
+            dnrAreaUnlock(pDNR);
+        }
+        rv = vos_select(pDNR->dnsSocket + 1, &rfds, NULL, NULL, &tv);
+        if (pAwaited != NULL)
+        {
+            dnrAreaLock(pDNR);
+        }
 
-        if (rv > 0 && FD_ISSET(my_socket, &rfds)) /*lint !e573 Signed/unsigned mix in std-header */
+        if ((rv <= 0) || !FD_ISSET(pDNR->dnsSocket, &rfds)) /*lint !e573 Signed/unsigned mix in std-header */
         {
-            /* Clear our packet buffer  */
-            memset(packetBuffer, 0, TAU_MAX_DNS_BUFFER_SIZE);
-            size = TAU_MAX_DNS_BUFFER_SIZE;
+            break;
+        }
 
-            /* Get what was announced */
-            (void) vos_sockReceiveUDP(my_socket, packetBuffer, &size, &pDNR->dnsIpAddr, &pDNR->dnsPort, NULL, FALSE);
+        /* Clear our packet buffer  */
+        memset(packetBuffer, 0, TAU_MAX_DNS_BUFFER_SIZE);
+        size = TAU_MAX_DNS_BUFFER_SIZE;
 
-            FD_CLR(my_socket, &rfds); /*lint !e573 !e502 Signed/unsigned mix in std-header */
+        (void) vos_sockReceiveUDP(pDNR->dnsSocket, packetBuffer, &size, &srcIP, &srcPort, NULL, FALSE);
 
-            if (size == 0u)
-            {
-                continue;       /* Try again, if there was no data */
-            }
+        if (size <= sizeof(TAU_DNS_HEADER_T))
+        {
+            continue;       /* Try again, if there was no data */
+        }
 
-            /*  Get and convert response */
-            parseResponse(packetBuffer, size, id, querySize, &ip_addr);
+        /* The query id tells us the cache entry */
+        id  = vos_ntohs(((TAU_DNS_HEADER_T *) packetBuffer)->id);
+        pos = (UINT32) (id & 0xFFu) - 1u;
 
-            if ((pTemp != NULL) &&
-                (ip_addr != VOS_INADDR_ANY) &&
-                (pTemp->fixedEntry == FALSE))
-            {
-                /* Overwrite outdated entry */
-                pTemp->ipAddr       = ip_addr;
-                pTemp->etbTopoCnt   = appHandle->etbTopoCnt;
-                pTemp->opTrnTopoCnt = appHandle->opTrnTopoCnt;
-                break;
-            }
-            else /* It's a new one, update our cache */
-            {
-                UINT32 cacheEntry = pDNR->noOfCachedEntries;
+        if ((pos >= pDNR->pCache->noOfCachedEntries) ||
+            (pDNR->pCache->cache[pos].queryId != id) ||
+            !timerisset(&pDNR->pCache->cache[pos].retryAt))
+        {
+            continue;       /* outdated or unknown reply */
+        }
+        pEntry = &pDNR->pCache->cache[pos];
 
-                if (cacheEntry >= TAU_MAX_NO_CACHE_ENTRY)   /* Cache is full! */
-                {
-                    cacheEntry = 0u;                        /* Overwrite first */
-                    // tbd: cacheEntry = cacheGetOldest();
-                }
-                else
-                {
-                    pDNR->noOfCachedEntries++;
-                }
+        /* Skip the echoed query */
+        (void) readName(packetBuffer + sizeof(TAU_DNS_HEADER_T), packetBuffer, &skip, name);
 
-                /* Position found, store everything */
-                vos_strncpy(pDNR->cache[cacheEntry].uri, pUri, TAU_MAX_URI_SIZE - 1u);
-                pDNR->cache[cacheEntry].ipAddr          = ip_addr;
-                pDNR->cache[cacheEntry].etbTopoCnt      = appHandle->etbTopoCnt;
-                pDNR->cache[cacheEntry].opTrnTopoCnt    = appHandle->opTrnTopoCnt;
-                pDNR->cache[cacheEntry].fixedEntry      = FALSE;
-
-                /* Sort the entries to get faster hits  */
-                vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
-                break;
-            }
+        /*  Get and convert response */
+        ip_addr = VOS_INADDR_ANY;
+        ttl     = 0u;
+        parseResponse(packetBuffer, size, id, skip + 4u, &ip_addr, &ttl);
+
+        vos_clearTime(&pEntry->retryAt);
+        pEntry->queryId = 0u;
+
+        if (ip_addr != VOS_INADDR_ANY)
+        {
+            /* Overwrite outdated entry, it is valid for the TTL given by the server */
+            dnrSetAddr(pDNR, pEntry, ip_addr);
+            pEntry->etbTopoCnt      = appHandle->etbTopoCnt;
+            pEntry->opTrnTopoCnt    = appHandle->opTrnTopoCnt;
+            tv.tv_sec   = (ttl < TAU_DNR_MAX_TTL) ? ttl : TAU_DNR_MAX_TTL;
+            tv.tv_usec  = 0;
+            vos_getTime(&pEntry->validUntil);
+            vos_addTime(&pEntry->validUntil, &tv);
         }
-        else
+
+        if (pEntry == pAwaited)
         {
             break;
         }
     }
-
-exit:
-    (void) vos_sockClose(my_socket);
-    return;
 }
 
 /**********************************************************************************************************************/
@@ -727,22 +1438,21 @@ static void buildRequest (
     pRequest->etbId = 255u;            /* don't care */
 
     /* Walk over the cache entries */
-    for (cacheEntry = 0u; (cacheEntry < pDNR->noOfCachedEntries) && (pRequest->tcnUriCnt < 255u); cacheEntry++)
+    for (cacheEntry = 0u; (cacheEntry < pDNR->pCache->noOfCachedEntries) && (pRequest->tcnUriCnt < 255u); cacheEntry++)
     {
-        /* Needs update? No, if it is a fixed entry (hostsfile) or it is a consist local adress */
-        if ((pDNR->cache[cacheEntry].fixedEntry == TRUE) ||
-            ((pDNR->cache[cacheEntry].ipAddr != 0u) &&
-             (pDNR->cache[cacheEntry].etbTopoCnt == 0u) && (pDNR->cache[cacheEntry].opTrnTopoCnt == 0u)))
+        /* Needs update? No, if it is a consist local adress (hosts file entries are not cached) */
+        if ((pDNR->pCache->cache[cacheEntry].ipAddr != 0u) &&
+            (pDNR->pCache->cache[cacheEntry].etbTopoCnt == 0u) && (pDNR->pCache->cache[cacheEntry].opTrnTopoCnt == 0u))
         {
             continue;
         }
         /* Needs update? Only when there is no address or the topocounts do not match */
-        else if ((pDNR->cache[cacheEntry].ipAddr == 0u) ||
-            ((pDNR->cache[cacheEntry].etbTopoCnt != appHandle->etbTopoCnt) ||
-            (pDNR->cache[cacheEntry].opTrnTopoCnt != appHandle->opTrnTopoCnt)))
+        else if ((pDNR->pCache->cache[cacheEntry].ipAddr == 0u) ||
+            ((pDNR->pCache->cache[cacheEntry].etbTopoCnt != appHandle->etbTopoCnt) ||
+            (pDNR->pCache->cache[cacheEntry].opTrnTopoCnt != appHandle->opTrnTopoCnt)))
         {
             /* Make sure the string is not longer than 79 chars (+ trailing zero) */
-            vos_strncpy(pRequest->tcnUriList[pRequest->tcnUriCnt].tcnUriStr, pDNR->cache[cacheEntry].uri, TAU_MAX_HOST_URI_LEN - 1u);
+            vos_strncpy(pRequest->tcnUriList[pRequest->tcnUriCnt].tcnUriStr, pDNR->pCache->cache[cacheEntry].uri, TAU_MAX_HOST_URI_LEN - 1u);
             pRequest->tcnUriCnt++;
         }
     }
@@ -753,44 +1463,6 @@ static void buildRequest (
     *pSize = sizeof(TRDP_DNS_REQUEST_T) - (255u - pRequest->tcnUriCnt) * sizeof(TCN_URI_T);
 }
 
-/**********************************************************************************************************************/
-/**    Add an entry to the DNS cache to be resolved
- *
- *  @param[in]      appHandle       Session context
- *  @param[in]      pDNR            DNR context
- *  @param[in]      pURI            URI to add
- *
- *
- */
-static void addEntry (
-    TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_DATA_T      *pDNR,
-    const CHAR8         *pURI)
-{
-    /* It's a new one, update our cache */
-    UINT32 cacheEntry = pDNR->noOfCachedEntries;
-
-    if (cacheEntry >= TAU_MAX_NO_CACHE_ENTRY)   /* Cache is full! */
-    {
-        cacheEntry = 0u;                        /* Overwrite first */
-        // tbd: cacheEntry = cacheGetOldest();
-    }
-    else
-    {
-        pDNR->noOfCachedEntries++;
-    }
-
-    /* Position found, store everything */
-    vos_strncpy(pDNR->cache[cacheEntry].uri, pURI, TAU_MAX_HOST_URI_LEN);
-    pDNR->cache[cacheEntry].ipAddr          = 0u;
-    pDNR->cache[cacheEntry].etbTopoCnt      = appHandle->etbTopoCnt;
-    pDNR->cache[cacheEntry].opTrnTopoCnt    = appHandle->opTrnTopoCnt;
-    pDNR->cache[cacheEntry].fixedEntry      = FALSE;
-
-    /* Sort the entries to get faster hits  */
-    vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
-}
-
 /**********************************************************************************************************************/
 /**    Parse the reply payload and update the DNS cache
  *
@@ -814,17 +1486,13 @@ static void parseUpdateTCNResponse (
     {
         if (pReply->tcnUriList[i].resolvState != -1)
         {
-            pTemp = (TAU_DNR_ENTRY_T *) vos_bsearch(pReply->tcnUriList[i].tcnUriStr,
-                                                pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T),
-                                                compareURI);
+            pTemp = dnrFindUri(pDNR, pReply->tcnUriList[i].tcnUriStr);
             if (pTemp != NULL)
             {
                 /* Position found, store everything */
-                vos_strncpy(pTemp->uri, pReply->tcnUriList[i].tcnUriStr, TAU_MAX_URI_SIZE);
-                pTemp->ipAddr          = vos_ntohl(pReply->tcnUriList[i].tcnUriIpAddr);
+                dnrSetAddr(pDNR, pTemp, vos_ntohl(pReply->tcnUriList[i].tcnUriIpAddr));
                 pTemp->etbTopoCnt      = vos_ntohl(pReply->etbTopoCnt);
                 pTemp->opTrnTopoCnt    = vos_ntohl(pReply->opTrnTopoCnt);
-                pTemp->fixedEntry      = FALSE;
                 if (pTemp->ipAddr == VOS_INADDR_ANY)
                 {
                     vos_printLog(VOS_LOG_WARNING, "%s resolved to INADDR_ANY\n", pReply->tcnUriList[i].tcnUriStr);
@@ -840,8 +1508,157 @@ static void parseUpdateTCNResponse (
             vos_printLog(VOS_LOG_WARNING, "%s could not be resolved\n", pReply->tcnUriList[i].tcnUriStr);
         }
     }
-    /* Sort the entries to get faster hits  */
-    vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
+}
+
+/**********************************************************************************************************************/
+/**    Move all answered asynchronous requests of all sessions sharing the DNR to a list of results to be reported
+ *
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      failErr         Error for requests part of the answered TCN-DNS request, TRDP_NO_ERR if none
+ *
+ *  @retval         list of answered requests
+ */
+static TAU_DNR_PENDING_T *dnrCompletePending (
+    TAU_DNR_DATA_T      *pDNR,
+    TRDP_ERR_T          failErr)
+{
+    TAU_DNR_PENDING_T   *pDone  = NULL;
+    TAU_DNR_PENDING_T   **ppTail = &pDone;
+    TAU_DNR_PENDING_T   **ppIter = &pDNR->pPending;
+    TAU_DNR_PENDING_T   *pIter;
+    TAU_DNR_ENTRY_T     *pEntry;
+    TRDP_TIME_T         now;
+
+    vos_getTime(&now);
+
+    while (*ppIter != NULL)
+    {
+        pIter   = *ppIter;
+        pEntry  = dnrFindUri(pDNR, pIter->uri);
+        pIter->result = TRDP_NO_ERR;
+
+        if ((pEntry != NULL) &&
+            (pEntry->ipAddr != VOS_INADDR_ANY) &&
+            (dnrTopoMatches(pIter->appHandle, pEntry) == TRUE))
+        {
+            pIter->addr = pEntry->ipAddr;
+        }
+        else if (pDNR->useTCN_DNS == TRDP_DNR_STANDARD_DNS)
+        {
+            if ((pEntry == NULL) || !timerisset(&pEntry->retryAt))
+            {
+                pIter->result = TRDP_UNRESOLVED_ERR;    /* answered without an address */
+            }
+            else if (vos_cmpTime(&pEntry->retryAt, &now) < 0)
+            {
+                vos_clearTime(&pEntry->retryAt);
+                pIter->result = TRDP_TIMEOUT_ERR;
+            }
+            else
+            {
+                ppIter = &pIter->pNext;                 /* still waiting */
+                continue;
+            }
+        }
+        else if ((pIter->sent == TRUE) && (failErr != TRDP_NO_ERR))
+        {
+            pIter->result = failErr;
+        }
+        else
+        {
+            ppIter = &pIter->pNext;                     /* not asked for yet */
+            continue;
+        }
+
+        if ((pEntry != NULL) && (pEntry->waiters > 0u))
+        {
+            pEntry->waiters--;
+        }
+        *ppIter         = pIter->pNext;
+        pIter->pNext    = NULL;
+        *ppTail         = pIter;
+        ppTail          = &pIter->pNext;
+    }
+    return pDone;
+}
+
+/**********************************************************************************************************************/
+/**    Report the results of answered asynchronous requests to the sessions which asked and release them.
+ *  Must be called without holding the DNR mutex, the callbacks may ask for further URIs.
+ *
+ *  @param[in]      pDone           List returned by dnrCompletePending()
+ *
+ */
+static void dnrReportPending (
+    TAU_DNR_PENDING_T   *pDone)
+{
+    TAU_DNR_PENDING_T *pNext;
+
+    while (pDone != NULL)
+    {
+        pNext = pDone->pNext;
+        pDone->pfCbFunction(pDone->pRefCon, pDone->appHandle, pDone->uri,
+                            (pDone->result == TRDP_NO_ERR) ? pDone->addr : VOS_INADDR_ANY, pDone->result);
+        vos_memFree(pDone);
+        pDone = pNext;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Send a TCN-DNS request for all unknown or outdated cache entries.
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pUserRef        Semaphore to signal the reply, NULL for asynchronous requests
+ *  @param[out]     pSessionId      Returns the MD session id
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_NODATA_ERR nothing to ask for
+ *  @retval         != TRDP_NO_ERR  error from tlm_request()
+ */
+static TRDP_ERR_T dnrSendTCNRequest (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR,
+    void                *pUserRef,
+    TRDP_UUID_T         *pSessionId)
+{
+    TRDP_DNS_REQUEST_T  *pDNS_REQ = (TRDP_DNS_REQUEST_T *)sTCN_DNS_Buffer;
+    TAU_DNR_PENDING_T   *pIter;
+    UINT32              querySize;
+    TRDP_ERR_T          err;
+
+    /* build the request telegram with all possible outdated entries */
+    buildRequest(appHandle, pDNR, pDNS_REQ, &querySize);
+
+    if (pDNS_REQ->tcnUriCnt == 0u)
+    {
+        return TRDP_NODATA_ERR;
+    }
+
+    err = tlm_request(appHandle, pUserRef, dnrMDCallback, pSessionId, TCN_DNS_REQ_COMID,
+                      0u, 0u,
+                      VOS_INADDR_ANY, pDNR->dnsIpAddr,
+                      TRDP_FLAGS_CALLBACK,
+                      1u,
+                      TCN_DNS_REQ_TO_US,
+                      NULL,
+                      sTCN_DNS_Buffer,
+                      querySize,
+                      NULL,
+                      NULL);
+
+    if ((err == TRDP_NO_ERR) && (pUserRef == NULL))
+    {
+        /* Everything queued up to now is part of this request, later ones wait for the next */
+        for (pIter = pDNR->pPending; pIter != NULL; pIter = pIter->pNext)
+        {
+            pIter->sent = TRUE;
+        }
+        pDNR->tcnOutstanding    = TRUE;
+        pDNR->tcnSession        = appHandle;
+        memcpy(pDNR->tcnSessionId, *pSessionId, sizeof(TRDP_UUID_T));
+    }
+    return err;
 }
 
 /**********************************************************************************************************************/
@@ -862,10 +1679,13 @@ static void dnrMDCallback (
     UINT8                   *pData,
     UINT32                  dataSize)
 {
+    TAU_DNR_DATA_T      *pDNR;
+    TAU_DNR_PENDING_T   *pDone      = NULL;
+    TAU_DNR_PENDING_T   *pDoneAlso  = NULL;
+    TAU_DNR_PENDING_T   *pIter;
+    TRDP_ERR_T          failErr;
 
     if ((appHandle == NULL) ||
-         (pData == NULL) ||
-         (dataSize == 0u) ||
          (pMsg == NULL))
     {
          return;
@@ -873,9 +1693,19 @@ static void dnrMDCallback (
 
     pRefCon = pRefCon;
 
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+
+    if ((pDNR == NULL) ||
+        (dnrLock(pDNR) != VOS_NO_ERR))
+    {
+        return;
+    }
+
     /* we await TCN-DNS reply */
     if ((pMsg->comId == TCN_DNS_REP_COMID) &&
-        (pMsg->resultCode == TRDP_NO_ERR))
+        (pMsg->resultCode == TRDP_NO_ERR) &&
+        (pData != NULL) &&
+        (dataSize != 0u))
     {
         VOS_SEMA_T      *pDnsSema = (VOS_SEMA_T*) pMsg->pUserRef;
 
@@ -883,18 +1713,57 @@ static void dnrMDCallback (
         // if (sdt_isvalid(appHandle, pData, dataSize)) ...
 
         /* update the cache */
-        parseUpdateTCNResponse((TAU_DNR_DATA_T *) appHandle->pUser, (TRDP_DNS_REPLY_T *)pData, dataSize);
+        parseUpdateTCNResponse(pDNR, (TRDP_DNS_REPLY_T *)pData, dataSize);
 
-        (void) vos_semaGive(*pDnsSema);
+        if (pDnsSema != NULL)
+        {
+            (void) vos_semaGive(*pDnsSema);
+        }
+        failErr = TRDP_UNRESOLVED_ERR;
     }
     else
     {
         vos_printLog(VOS_LOG_WARNING, "dnrMDCallback error (resultCode = %d)\n", pMsg->resultCode);
+        failErr = (pMsg->resultCode != TRDP_NO_ERR) ? pMsg->resultCode : TRDP_UNRESOLVED_ERR;
+    }
+
+    /* Answer the asynchronous requests; only a reply to our own request tells what could not be resolved */
+    if (pMsg->pUserRef == NULL)
+    {
+        pDNR->tcnOutstanding = FALSE;
+    }
+    else
+    {
+        failErr = TRDP_NO_ERR;
+    }
+    pDone = dnrCompletePending(pDNR, failErr);
+
+    /* Ask for everything queued in the meantime with one request */
+    if ((pDNR->tcnOutstanding == FALSE) && (pDNR->pPending != NULL))
+    {
+        TRDP_UUID_T sessionId;
+
+        failErr = dnrSendTCNRequest(appHandle, pDNR, NULL, &sessionId);
+        if (failErr != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "dnrMDCallback failed to send request (%d)\n", failErr);
+            for (pIter = pDNR->pPending; pIter != NULL; pIter = pIter->pNext)
+            {
+                pIter->sent = TRUE;
+            }
+            pDoneAlso = dnrCompletePending(pDNR, TRDP_UNRESOLVED_ERR);
+        }
     }
+
+    dnrUnlock(pDNR);
+
+    dnrReportPending(pDone);
+    dnrReportPending(pDoneAlso);
 }
 
 /**********************************************************************************************************************/
-/**    Query the TCN-DNS server for the addresses
+/**    Query the TCN-DNS server for the addresses.
+ *  Called with the DNR mutex taken, it is released while waiting for the reply.
  *
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
  *  @param[in]      pTemp               Last entry which was invalid, can be NULL
@@ -911,14 +1780,10 @@ static void updateTCNDNSentry (
     const CHAR8         *pUri)
 {
     TRDP_ERR_T      err;
-    UINT32          querySize;
     TAU_DNR_DATA_T  *pDNR   = (TAU_DNR_DATA_T *) appHandle->pUser;
     VOS_SEMA_T      dnsSema;
     unsigned int    i;
 
-    static UINT8 sTCN_DNS_Buffer[sizeof(TRDP_DNS_REQUEST_T)];
-
-    TRDP_DNS_REQUEST_T  *pDNS_REQ = (TRDP_DNS_REQUEST_T *)sTCN_DNS_Buffer;
     TRDP_UUID_T         sessionId;
 
     /* Create semaphore */
@@ -934,36 +1799,21 @@ static void updateTCNDNSentry (
 
     if (pTemp == NULL)
     {
-        addEntry(appHandle, pDNR, pUri);
+        (void) dnrNewEntry(pDNR, pUri);
     }
-    /* build the request telegram with all possible outdated entries */
 
-    buildRequest(appHandle, pDNR, pDNS_REQ, &querySize);
+    /* send the MD request with all possible outdated entries */
 
-    if (querySize == 0u)
-    {
-        vos_printLogStr(VOS_LOG_ERROR, "updateTCNDNSentry failed to send request\n");
-        goto exit;
-    }
-    /* send the MD request */
-
-    err = tlm_request(appHandle, &dnsSema, dnrMDCallback, &sessionId, TCN_DNS_REQ_COMID,
-                        0u, 0u,
-                        VOS_INADDR_ANY, pDNR->dnsIpAddr,
-                        TRDP_FLAGS_CALLBACK,
-                        1u,
-                        TCN_DNS_REQ_TO_US,
-                        NULL,
-                        sTCN_DNS_Buffer,
-                        querySize,
-                        NULL,
-                        NULL);
+    err = dnrSendTCNRequest(appHandle, pDNR, &dnsSema, &sessionId);
     if (err != TRDP_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_ERROR, "updateTCNDNSentry failed to send request\n");
         goto exit;
     }
 
+    /* The reply is processed in dnrMDCallback, which must be able to take the DNR mutex */
+    dnrUnlock(pDNR);
+
     /* how do we get the reply? */
     if (pDNR->useTCN_DNS == TRDP_DNR_OWN_THREAD)
     {
@@ -1018,17 +1868,112 @@ static void updateTCNDNSentry (
         }
         else
         {
-            vos_printLogStr(VOS_LOG_WARNING, "TCN-DNS request timed out!\n");
-            /* reply timed out */
+            vos_printLogStr(VOS_LOG_WARNING, "TCN-DNS request timed out!\n");
+            /* reply timed out */
+        }
+    }
+
+    /* kill the session to avoid dangeling semaphore */
+    (void) tlm_abortSession(appHandle, &sessionId);
+
+    (void) dnrLock(pDNR);
+
+exit:
+    vos_semaDelete(dnsSema);
+    return;
+}
+
+/**********************************************************************************************************************/
+/**    Look up a URI in the cache.
+ *  An expired TTL does not block the caller: the known address is used and refreshed in the background, unless a
+ *  query is already outstanding.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pDNR                DNR context
+ *  @param[in]      pUri                Pointer to host name
+ *  @param[out]     ppEntry             Returns the cache entry, NULL if not cached
+ *
+ *  @retval         TRUE                the address of the entry can be used
+ */
+static BOOL8 dnrLookup (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR,
+    const CHAR8         *pUri,
+    TAU_DNR_ENTRY_T     **ppEntry)
+{
+    TAU_DNR_ENTRY_T *pEntry = dnrFindUri(pDNR, pUri);
+    TRDP_TIME_T     now;
+
+    *ppEntry = pEntry;
+
+    if ((pEntry == NULL) ||
+        (pEntry->ipAddr == VOS_INADDR_ANY) ||
+        (dnrTopoMatches(appHandle, pEntry) == FALSE))
+    {
+        return FALSE;
+    }
+
+    if (timerisset(&pEntry->validUntil))
+    {
+        vos_getTime(&now);
+        if ((vos_cmpTime(&pEntry->validUntil, &now) < 0) &&
+            (!timerisset(&pEntry->retryAt) || (vos_cmpTime(&pEntry->retryAt, &now) < 0)))
+        {
+            (void) dnrSendQuery(pDNR, pEntry);
+        }
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Place the cache in shared memory, attach to the area of another process or create it.
+ *
+ *  @param[in]      pDNR                DNR context
+ *  @param[in]      pCacheName          Name of the shared memory area
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        area could not be created
+ *  @retval         TRDP_INIT_ERR       area has a different layout, or no atomic operations to lock it
+ */
+static TRDP_ERR_T dnrOpenArea (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pCacheName)
+{
+#if DNR_SHARED_CACHE
+    UINT8   *pArea  = NULL;
+    UINT32  size    = sizeof(TAU_DNR_CACHE_T);
+
+    if (vos_sharedAttach(pCacheName, &pDNR->shm, &pArea, &size) == VOS_NO_ERR)
+    {
+        /* A zero magic is an area just created by another process, it is an empty cache as well */
+        if ((size < sizeof(TAU_DNR_CACHE_T)) ||
+            ((((TAU_DNR_CACHE_T *) pArea)->magic != TAU_DNR_AREA_MAGIC) && (((TAU_DNR_CACHE_T *) pArea)->magic != 0u)))
+        {
+            vos_printLog(VOS_LOG_ERROR, "Shared DNR cache %s has a different layout\n", pCacheName);
+            (void) vos_sharedClose(pDNR->shm, pArea);
+            pDNR->shm = NULL;
+            return TRDP_INIT_ERR;
+        }
+    }
+    else
+    {
+        /* The area is created cleared, that is an empty cache */
+        size = sizeof(TAU_DNR_CACHE_T);
+        if (vos_sharedOpen(pCacheName, &pDNR->shm, &pArea, &size) != VOS_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "Shared DNR cache %s could not be created\n", pCacheName);
+            pDNR->shm = NULL;
+            return TRDP_MEM_ERR;
         }
+        ((TAU_DNR_CACHE_T *) pArea)->magic = TAU_DNR_AREA_MAGIC;
     }
-
-    /* kill the session to avoid dangeling semaphore */
-    (void) tlm_abortSession(appHandle, &sessionId);
-
-exit:
-    vos_semaDelete(dnsSema);
-    return;
+    pDNR->pCache = (TAU_DNR_CACHE_T *) pArea;
+    return TRDP_NO_ERR;
+#else
+    (void) pDNR;
+    vos_printLog(VOS_LOG_ERROR, "Shared DNR cache %s needs atomic operations\n", pCacheName);
+    return TRDP_INIT_ERR;
+#endif
 }
 
 #pragma mark ----------------------- Public -----------------------------
@@ -1051,7 +1996,7 @@ exit:
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *  @param[in]      dnsIpAddr       DNS/ECSP IP address.
  *  @param[in]      dnsPort         DNS port number.
- *  @param[in]      pHostsFileName  Optional host file name as ECSP replacement/addition.
+ *  @param[in]      pHostsFileName  Optional host file name as ECSP replacement/addition. May be a binary hosts image.
  *  @param[in]      dnsOptions      Use existing thread (recommended), use own tlc_process loop or use standard DNS
  *
  *  @retval         TRDP_NO_ERR     no error
@@ -1064,11 +2009,42 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
                                  UINT16              dnsPort,
                                  const CHAR8         *pHostsFileName,
                                  TRDP_DNR_OPTS_T     dnsOptions)
+{
+    return tau_initSharedDnr(appHandle, dnsIpAddr, dnsPort, pHostsFileName, dnsOptions, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Function to init the DNR subsystem with its cache in shared memory
+ *  Like tau_initDnr(), but the cache is placed in the shared memory area pCacheName. The first process creates the
+ *  area, the others attach to it. An address resolved by one process is known to all of them, only URIs unknown to
+ *  all are asked for. Each process reads its hosts file and sends its own queries. The area is removed when its
+ *  creator calls tau_deInitDnr(), processes attached keep using it, processes starting later create a new one.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      dnsIpAddr       DNS/ECSP IP address.
+ *  @param[in]      dnsPort         DNS port number.
+ *  @param[in]      pHostsFileName  Optional host file name as ECSP replacement/addition. May be a binary hosts image.
+ *  @param[in]      dnsOptions      Use existing thread (recommended), use own tlc_process loop or use standard DNS
+ *  @param[in]      pCacheName      Name of the shared memory area, NULL for a cache private to the process
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_MEM_ERR    out of memory or shared memory not available
+ *  @retval         TRDP_INIT_ERR   the shared memory area has a different layout
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_initSharedDnr (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      dnsIpAddr,
+    UINT16              dnsPort,
+    const CHAR8         *pHostsFileName,
+    TRDP_DNR_OPTS_T     dnsOptions,
+    const CHAR8         *pCacheName)
 {
     TRDP_ERR_T      err = TRDP_NO_ERR;
     TAU_DNR_DATA_T  *pDNR;      /**< default DNR/ECSP settings  */
 
-    if (appHandle == NULL)
+    if ((appHandle == NULL) || (appHandle->pUser != NULL))
     {
         return TRDP_PARAM_ERR;
     }
@@ -1079,9 +2055,7 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
         return TRDP_MEM_ERR;
     }
 
-    /* save to application session */
-    appHandle->pUser = pDNR;
-
+    pDNR->refCnt        = 1u;
     pDNR->dnsIpAddr     = (dnsIpAddr == 0u) ? 0x0a000001u : dnsIpAddr;
 
     /* Set default ports */
@@ -1095,6 +2069,28 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
     }
 
     pDNR->useTCN_DNS = dnsOptions;
+    pDNR->dnsSocket  = VOS_INVALID_SOCKET;  /* opened on the first standard DNS query */
+    pDNR->pCache     = &pDNR->localCache;
+
+    if (vos_mutexCreate(&pDNR->mutex) != VOS_NO_ERR)
+    {
+        vos_memFree(pDNR);
+        return TRDP_MUTEX_ERR;
+    }
+
+    if (pCacheName != NULL)
+    {
+        err = dnrOpenArea(pDNR, pCacheName);
+        if (err != TRDP_NO_ERR)
+        {
+            vos_mutexDelete(pDNR->mutex);
+            vos_memFree(pDNR);
+            return err;
+        }
+    }
+
+    /* save to application session */
+    appHandle->pUser = pDNR;
 
     /* Get locally defined hosts */
     if ((pHostsFileName != NULL) && (strlen(pHostsFileName) > 0))
@@ -1104,14 +2100,56 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
     }
     else
     {
-        pDNR->noOfCachedEntries = 0u;
         pDNR->timeout = TAU_DNS_TIME_OUT_LONG;
     }
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Function to use the DNR of another session
+ *  The session shares the hosts file, cache and resolver of dnrHandle: an URI resolved for one session is known to
+ *  all, there is one socket for standard DNS and one outstanding asynchronous TCN-DNS request. The DNR stays until
+ *  the last of the sessions calls tau_deInitDnr(). Results of tau_uri2AddrAsync() are reported to the session which
+ *  asked, but possibly from the thread of another session, which received the reply.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession(), without DNR
+ *  @param[in]      dnrHandle       Session initialised by tau_initDnr() or tau_initSharedDnr()
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_MUTEX_ERR  mutex error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_shareDnr (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_APP_SESSION_T  dnrHandle)
+{
+    TAU_DNR_DATA_T *pDNR;
+
+    if ((appHandle == NULL) ||
+        (dnrHandle == NULL) ||
+        (appHandle->pUser != NULL) ||
+        (dnrHandle->pUser == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    pDNR = (TAU_DNR_DATA_T *) dnrHandle->pUser;
+
+    if (dnrLock(pDNR) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    pDNR->refCnt++;
+    dnrUnlock(pDNR);
+
+    appHandle->pUser = pDNR;
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /**    Function to deinit DNR
+ *  The DNR is released when the last session using it (see tau_shareDnr()) deinits.
  *
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
  *
@@ -1125,9 +2163,179 @@ EXT_DECL void tau_deInitDnr (
 
     if (appHandle != NULL && appHandle->pUser != NULL)
     {
-        vos_memFree(appHandle->pUser);
+        TAU_DNR_DATA_T      *pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+        TAU_DNR_PENDING_T   **ppIter;
+        TAU_DNR_PENDING_T   *pIter;
+        TAU_DNR_PENDING_T   *pDone      = NULL;
+        TAU_DNR_ENTRY_T     *pEntry;
+        TRDP_UUID_T         sessionId;
+        TRDP_UUID_T         newSessionId;
+        BOOL8               abort       = FALSE;
+        BOOL8               last;
+
+        (void) dnrLock(pDNR);
+
+        /* Unanswered asynchronous requests of the session are dropped */
+        ppIter = &pDNR->pPending;
+        while ((pIter = *ppIter) != NULL)
+        {
+            if (pIter->appHandle == appHandle)
+            {
+                pEntry = dnrFindUri(pDNR, pIter->uri);
+                if ((pEntry != NULL) && (pEntry->waiters > 0u))
+                {
+                    pEntry->waiters--;
+                }
+                *ppIter = pIter->pNext;
+                vos_memFree(pIter);
+            }
+            else
+            {
+                ppIter = &pIter->pNext;
+            }
+        }
+
+        /* The reply to a request sent by the session is lost, ask again for the other sessions */
+        if ((pDNR->tcnOutstanding == TRUE) && (pDNR->tcnSession == appHandle))
+        {
+            abort = TRUE;
+            memcpy(sessionId, pDNR->tcnSessionId, sizeof(TRDP_UUID_T));
+            pDNR->tcnOutstanding = FALSE;
+            for (pIter = pDNR->pPending; pIter != NULL; pIter = pIter->pNext)
+            {
+                pIter->sent = FALSE;
+            }
+            if ((pDNR->pPending != NULL) &&
+                (dnrSendTCNRequest(pDNR->pPending->appHandle, pDNR, NULL, &newSessionId) != TRDP_NO_ERR))
+            {
+                for (pIter = pDNR->pPending; pIter != NULL; pIter = pIter->pNext)
+                {
+                    pIter->sent = TRUE;
+                }
+                pDone = dnrCompletePending(pDNR, TRDP_UNRESOLVED_ERR);
+            }
+        }
+        last = (--pDNR->refCnt == 0u) ? TRUE : FALSE;
+
+        dnrUnlock(pDNR);
         appHandle->pUser = NULL;
+
+        if (abort == TRUE)
+        {
+            (void) tlm_abortSession(appHandle, &sessionId);
+        }
+        dnrReportPending(pDone);
+
+        if (last == TRUE)
+        {
+            if (pDNR->dnsSocket != VOS_INVALID_SOCKET)
+            {
+                (void) vos_sockClose(pDNR->dnsSocket);
+            }
+            if (pDNR->shm != NULL)
+            {
+                (void) vos_sharedClose(pDNR->shm, (const UINT8 *) pDNR->pCache);
+            }
+            freeHosts(pDNR);
+            vos_mutexDelete(pDNR->mutex);
+            vos_memFree(pDNR);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Function to write the hosts read by tau_initDnr() as binary hosts image.
+ *  The image can be passed to tau_initDnr() instead of a hosts file. It is loaded without parsing and sorting, which
+ *  pays off for hosts files with thousands of entries.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pImageFileName      Name of the image file to write
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error or no hosts file read
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         TRDP_IO_ERR     file could not be written
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_writeHostsImage (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pImageFileName)
+{
+    TAU_DNR_DATA_T      *pDNR;
+    TAU_DNR_IMAGE_HDR_T hdr;
+    UINT32              record[TAU_DNR_IMAGE_RECORD_SIZE / sizeof(UINT32)];
+    UINT32              i;
+    UINT32              *pAddrPos;
+    UINT32              poolSize = 0u;
+    TRDP_ERR_T          err = TRDP_NO_ERR;
+    FILE                *fp;
+
+    if ((appHandle == NULL) ||
+        (appHandle->pUser == NULL) ||
+        (pImageFileName == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+
+    if (pDNR->noOfHosts == 0u)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* Position of each host in address order */
+    pAddrPos = (UINT32 *) vos_memAlloc(pDNR->noOfHosts * sizeof(UINT32));
+    if (pAddrPos == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    for (i = 0u; i < pDNR->noOfHosts; i++)
+    {
+        pAddrPos[pDNR->ppHostsByAddr[i] - pDNR->pHosts] = i;
+        poolSize += (UINT32) strlen(pDNR->pHosts[i].pUri) + 1u;
+    }
+
+    fp = fopen(pImageFileName, "wb");
+    if (fp == NULL)
+    {
+        vos_memFree(pAddrPos);
+        return TRDP_IO_ERR;
+    }
+
+    memcpy(hdr.magic, TAU_DNR_IMAGE_MAGIC, sizeof(hdr.magic));
+    hdr.noOfHosts   = vos_htonl(pDNR->noOfHosts);
+    hdr.poolSize    = vos_htonl(poolSize);
+    if (fwrite(&hdr, sizeof(hdr), 1u, fp) != 1u)
+    {
+        err = TRDP_IO_ERR;
+    }
+
+    /* Records in URI order: address, offset of the URI in the pool, position in address order */
+    poolSize = 0u;
+    for (i = 0u; (i < pDNR->noOfHosts) && (err == TRDP_NO_ERR); i++)
+    {
+        record[0]   = vos_htonl(pDNR->pHosts[i].ipAddr);
+        record[1]   = vos_htonl(poolSize);
+        record[2]   = vos_htonl(pAddrPos[i]);
+        poolSize    += (UINT32) strlen(pDNR->pHosts[i].pUri) + 1u;
+        if (fwrite(record, sizeof(record), 1u, fp) != 1u)
+        {
+            err = TRDP_IO_ERR;
+        }
+    }
+
+    for (i = 0u; (i < pDNR->noOfHosts) && (err == TRDP_NO_ERR); i++)
+    {
+        if (fwrite(pDNR->pHosts[i].pUri, strlen(pDNR->pHosts[i].pUri) + 1u, 1u, fp) != 1u)
+        {
+            err = TRDP_IO_ERR;
+        }
     }
+
+    vos_memFree(pAddrPos);
+    fclose(fp);
+    return err;
 }
 
 /**********************************************************************************************************************/
@@ -1154,7 +2362,7 @@ EXT_DECL TRDP_DNR_STATE_T tau_DNRstatus (
             {
                 return TRDP_DNR_HOSTSFILE;
             }
-            if (pDNR->noOfCachedEntries > 0u)
+            if (pDNR->pCache->noOfCachedEntries > 0u)
             {
                 return TRDP_DNR_ACTIVE;
             }
@@ -1236,6 +2444,9 @@ EXT_DECL TRDP_IP_ADDR_T tau_getOwnAddr (
  *
  *  Receives an URI as input variable and translates this URI to an IP-Address.
  *  The URI may specify either a unicast or a multicast IP-Address.
+ *  Cached addresses are returned without waiting for the resolver. If the DNS TTL of an address has run out, it is
+ *  still returned while a refresh is sent in the background; only unknown URIs and entries of an outdated topology
+ *  wait for the resolver.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession()
  *  @param[out]     pAddr           Pointer to return the IP address
@@ -1252,8 +2463,9 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     TRDP_IP_ADDR_T      *pAddr,
     const TRDP_URI_T    pUri)
 {
-    TAU_DNR_DATA_T  *pDNR;
-    TAU_DNR_ENTRY_T *pTemp;
+    TAU_DNR_DATA_T          *pDNR;
+    TAU_DNR_ENTRY_T         *pTemp;
+    const TAU_DNR_HOST_T    *pHost;
     int i;
 
     if (appHandle == NULL ||
@@ -1276,41 +2488,238 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     {
         return TRDP_NO_ERR;
     }
+    if (pDNR == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* The hosts file takes precedence, it does not change after initialisation */
+    if ((pHost = dnrFindHostUri(pDNR, pUri)) != NULL)
+    {
+        *pAddr = pHost->ipAddr;
+        return TRDP_NO_ERR;
+    }
+
+    if (dnrLock(pDNR) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    /* Collect the replies to earlier background refreshes */
+    if (pDNR->useTCN_DNS == TRDP_DNR_STANDARD_DNS)
+    {
+        dnrReceiveReplies(appHandle, pDNR, NULL);
+    }
+
     /* Look inside the cache    */
     for (i = 0; i < 2; ++i)
     {
-        pTemp = (TAU_DNR_ENTRY_T *) vos_bsearch(pUri, pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T),
-                                                compareURI);
-        if ((pTemp != NULL) &&
-            ((pTemp->fixedEntry == TRUE) ||
-             (pTemp->etbTopoCnt == appHandle->etbTopoCnt) ||                    /* Do the topocounts match? */
-             (pTemp->opTrnTopoCnt == appHandle->opTrnTopoCnt) ||
-             ((appHandle->etbTopoCnt == 0u) && (appHandle->opTrnTopoCnt == 0u))   /* Or do we not care?       */
-            ))
+        if (dnrLookup(appHandle, pDNR, pUri, &pTemp) == TRUE)
         {
             *pAddr = pTemp->ipAddr;
+            dnrUnlock(pDNR);
             return TRDP_NO_ERR;
         }
         else    /* address is not known or out of date (topocounts differ)  */
         {
-            if (pDNR->useTCN_DNS != 0)
+            if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
             {
                 updateTCNDNSentry(appHandle, pTemp, pUri);   /* Update everything, at least this URI */
             }
             else
             {
-                updateDNSentry(appHandle, pTemp, pUri);
+                if (pTemp == NULL)
+                {
+                    pTemp = dnrNewEntry(pDNR, pUri);
+                }
+                if ((pTemp != NULL) &&
+                    (dnrSendQuery(pDNR, pTemp) == TRDP_NO_ERR))
+                {
+                    dnrReceiveReplies(appHandle, pDNR, pTemp);
+                }
             }
             /* try resolving again... */
         }
     }
 
+    dnrUnlock(pDNR);
     *pAddr = VOS_INADDR_ANY;
     return TRDP_UNRESOLVED_ERR;
 }
 
 
 
+/**********************************************************************************************************************/
+/**    Function to convert a URI to an IP address without waiting for the resolver.
+ *  If the address is known, the callback is called before this function returns. Otherwise the URI is queued and
+ *  the callback is called when the reply arrives. All URIs queued while a TCN-DNS request is outstanding are asked
+ *  for with one request, standard DNS queries are sent at once and answered in parallel.
+ *  TCN-DNS replies are delivered by tlc_process(), standard DNS replies by tau_processDnr().
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pUri            Pointer to an URI or an IP Address string, NULL==own URI
+ *  @param[in]      pfCbFunction    Callback to receive the address
+ *  @param[in]      pRefCon         User context passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_MEM_ERR        no room for the request
+ *  @retval         TRDP_MUTEX_ERR      mutex error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrAsync (
+    TRDP_APP_SESSION_T  appHandle,
+    const TRDP_URI_T    pUri,
+    TAU_DNR_CALLBACK_T  pfCbFunction,
+    void                *pRefCon)
+{
+    TAU_DNR_DATA_T          *pDNR;
+    TAU_DNR_ENTRY_T         *pEntry;
+    TAU_DNR_PENDING_T       *pPending;
+    TAU_DNR_PENDING_T       **ppTail;
+    const TAU_DNR_HOST_T    *pHost;
+    TRDP_IP_ADDR_T          addr;
+    TRDP_UUID_T             sessionId;
+    TRDP_ERR_T              err = TRDP_NO_ERR;
+
+    if ((appHandle == NULL) ||
+        (pfCbFunction == NULL) ||
+        (appHandle->pUser == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* Own address and dotted IP addresses need no resolver */
+    if (pUri == NULL)
+    {
+        pfCbFunction(pRefCon, appHandle, pUri, tau_getOwnAddr(appHandle), TRDP_NO_ERR);
+        return TRDP_NO_ERR;
+    }
+    if ((addr = vos_dottedIP(pUri)) != VOS_INADDR_ANY)
+    {
+        pfCbFunction(pRefCon, appHandle, pUri, addr, TRDP_NO_ERR);
+        return TRDP_NO_ERR;
+    }
+
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+
+    if ((pHost = dnrFindHostUri(pDNR, pUri)) != NULL)
+    {
+        pfCbFunction(pRefCon, appHandle, pUri, pHost->ipAddr, TRDP_NO_ERR);
+        return TRDP_NO_ERR;
+    }
+
+    if (dnrLock(pDNR) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+
+    if (pDNR->useTCN_DNS == TRDP_DNR_STANDARD_DNS)
+    {
+        dnrReceiveReplies(appHandle, pDNR, NULL);
+    }
+
+    if (dnrLookup(appHandle, pDNR, pUri, &pEntry) == TRUE)
+    {
+        addr = pEntry->ipAddr;
+        dnrUnlock(pDNR);
+        pfCbFunction(pRefCon, appHandle, pUri, addr, TRDP_NO_ERR);
+        return TRDP_NO_ERR;
+    }
+
+    /* Queue the request */
+    if (pEntry == NULL)
+    {
+        pEntry = dnrNewEntry(pDNR, pUri);
+    }
+    pPending = (TAU_DNR_PENDING_T *) vos_memAlloc(sizeof(TAU_DNR_PENDING_T));
+    if ((pEntry == NULL) || (pPending == NULL))
+    {
+        dnrUnlock(pDNR);
+        if (pPending != NULL)
+        {
+            vos_memFree(pPending);
+        }
+        return TRDP_MEM_ERR;
+    }
+    vos_strncpy(pPending->uri, pEntry->uri, TRDP_MAX_URI_HOST_LEN);
+    pPending->appHandle     = appHandle;
+    pPending->pfCbFunction  = pfCbFunction;
+    pPending->pRefCon       = pRefCon;
+
+    /* Ask the resolver, unless the URI is already asked for */
+    if (pDNR->useTCN_DNS == TRDP_DNR_STANDARD_DNS)
+    {
+        TRDP_TIME_T now;
+
+        vos_getTime(&now);
+        if (!timerisset(&pEntry->retryAt) || (vos_cmpTime(&pEntry->retryAt, &now) < 0))
+        {
+            err = dnrSendQuery(pDNR, pEntry);
+        }
+    }
+    else if (pDNR->tcnOutstanding == FALSE)
+    {
+        /* All URIs queued until the reply will be sent with the next request */
+        pPending->pNext     = pDNR->pPending;
+        pDNR->pPending      = pPending;
+        err = dnrSendTCNRequest(appHandle, pDNR, NULL, &sessionId);
+        pDNR->pPending      = pPending->pNext;
+        pPending->pNext     = NULL;
+    }
+
+    if (err != TRDP_NO_ERR)
+    {
+        dnrUnlock(pDNR);
+        vos_memFree(pPending);
+        return err;
+    }
+
+    pEntry->waiters++;
+    for (ppTail = &pDNR->pPending; *ppTail != NULL; ppTail = &(*ppTail)->pNext)
+    {
+        ;
+    }
+    *ppTail = pPending;
+
+    dnrUnlock(pDNR);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Function to deliver the results of asynchronous standard DNS requests.
+ *  Should be called cyclically when tau_uri2AddrAsync() is used with TRDP_DNR_STANDARD_DNS.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *
+ */
+EXT_DECL void tau_processDnr (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_DNR_DATA_T      *pDNR;
+    TAU_DNR_PENDING_T   *pDone;
+
+    if ((appHandle == NULL) || (appHandle->pUser == NULL))
+    {
+        return;
+    }
+
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+
+    if ((pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS) ||
+        (dnrLock(pDNR) != VOS_NO_ERR))
+    {
+        return;
+    }
+
+    dnrReceiveReplies(appHandle, pDNR, NULL);
+    pDone = dnrCompletePending(pDNR, TRDP_NO_ERR);
+
+    dnrUnlock(pDNR);
+
+    dnrReportPending(pDone);
+}
+
 /**********************************************************************************************************************/
 /**    Function to convert an IP address to a URI.
  *  Receives an IP-Address and translates it into the host part of the corresponding URI.
@@ -1330,7 +2739,9 @@ EXT_DECL TRDP_ERR_T tau_addr2Uri (
     TRDP_URI_HOST_T     pUri,
     TRDP_IP_ADDR_T      addr)
 {
-    TAU_DNR_DATA_T *pDNR;
+    TAU_DNR_DATA_T          *pDNR;
+    const TAU_DNR_HOST_T    *pHost;
+
     if ((appHandle == NULL) || (pUri == NULL))
     {
         return TRDP_PARAM_ERR;
@@ -1338,22 +2749,43 @@ EXT_DECL TRDP_ERR_T tau_addr2Uri (
 
     pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
 
-    if (addr != VOS_INADDR_ANY)
+    if ((addr != VOS_INADDR_ANY) &&
+        (pDNR != NULL) &&
+        ((pHost = dnrFindHostAddr(pDNR, addr)) != NULL))
     {
-        UINT32 i;
-        for (i = 0u; i < pDNR->noOfCachedEntries; ++i)
+        vos_strncpy(pUri, pHost->pUri, TRDP_MAX_URI_HOST_LEN + 1);
+        return TRDP_NO_ERR;
+    }
+
+    if ((addr != VOS_INADDR_ANY) &&
+        (pDNR != NULL) &&
+        (dnrLock(pDNR) == VOS_NO_ERR))
+    {
+        UINT32          i = dnrHashAddr(addr) & (TAU_DNR_INDEX_SIZE - 1u);
+        TAU_DNR_ENTRY_T *pEntry;
+
+        if (pDNR->useTCN_DNS == TRDP_DNR_STANDARD_DNS)
+        {
+            dnrReceiveReplies(appHandle, pDNR, NULL);
+        }
+
+        /* Walk the probe sequence of the address, several URIs may share one address */
+        for (; pDNR->pCache->addrIndex[i] != 0u; i = (i + 1u) & (TAU_DNR_INDEX_SIZE - 1u))
         {
-            if ((pDNR->cache[i].ipAddr == addr) &&
-                ((appHandle->etbTopoCnt == 0u) || (pDNR->cache[i].etbTopoCnt == appHandle->etbTopoCnt)) &&
-                ((appHandle->opTrnTopoCnt == 0u) || (pDNR->cache[i].opTrnTopoCnt == appHandle->opTrnTopoCnt)))
+            pEntry = &pDNR->pCache->cache[pDNR->pCache->addrIndex[i] - 1u];
+            if ((pEntry->ipAddr == addr) &&
+                ((appHandle->etbTopoCnt == 0u) || (pEntry->etbTopoCnt == appHandle->etbTopoCnt)) &&
+                ((appHandle->opTrnTopoCnt == 0u) || (pEntry->opTrnTopoCnt == appHandle->opTrnTopoCnt)))
             {
-                vos_strncpy(pUri, pDNR->cache[i].uri, TRDP_MAX_URI_HOST_LEN + 1);
+                vos_strncpy(pUri, pEntry->uri, TRDP_MAX_URI_HOST_LEN + 1);
+                dnrUnlock(pDNR);
                 return TRDP_NO_ERR;
             }
         }
         /* address not in cache: Make reverse request */
         /* tbd */
 
+        dnrUnlock(pDNR);
     }
     return TRDP_UNRESOLVED_ERR;
 }
@@ -0,0 +1,1345 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_hist.c
+ *
+ * @brief           Columnar history store of PD telegrams
+ *
+ * @details         tau_histLog() copies a telegram to the fill half of a double buffer. The thread of the store
+ *                  swaps the halves every interval and appends each telegram as a row to the chunk of its ComId.
+ *                  The row is the payload in network format; the columns are the byte ranges of the dataset
+ *                  elements, computed once per ComId from the dataset definitions. A full chunk is written
+ *                  column by column, each column compressed:
+ *                  - every value is XORed with the value of the previous row, unchanged values become zeros,
+ *                  - the bytes are transposed to byte planes, the rarely changing high bytes become zero runs,
+ *                  - runs of zeros and literal bytes are run length encoded.
+ *                  The time column holds the differences of the time stamps, cyclic telegrams compress to zero.
+ *
+ *                  File format, all numbers in network byte order, a sequence of blocks {type, length, body}:
+ *                  - HEAD:  magic, version, wall clock (s since 1970) of the time stamps 0
+ *                  - DESC:  ComId, dataset id, row size, number of columns, per column: offset, width, type, items
+ *                           Written before the first chunk of a ComId and whenever its layout changes.
+ *                  - CHUNK: ComId, number of rows, per column (time, source IP, size, data columns): length, bytes
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "tau_hist.h"
+#include "tau_marshall.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_HIST_MAGIC          0x54524853u     /* "TRHS" */
+#define TAU_HIST_VERSION        1u
+
+#define TAU_HIST_BLK_HEAD       1u
+#define TAU_HIST_BLK_DESC       2u
+#define TAU_HIST_BLK_CHUNK      3u
+
+#define TAU_HIST_MAX_COMIDS     1024u           /* ComIds of a store                                    */
+#define TAU_HIST_MAX_COLS       256u            /* columns of a dataset, more are stored as bytes       */
+#define TAU_HIST_ROW_ALIGN      16u             /* rows of unknown layout grow in these steps           */
+#define TAU_HIST_FIXED_COLS     3u              /* time, source IP and size column                      */
+#define TAU_HIST_RUN            128u            /* longest run of the run length encoding               */
+
+#define TAU_HIST_ALIGN(size)    (((size) + 7u) & ~7u)
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Column: byte range of a dataset element in the payload */
+typedef struct
+{
+    UINT32  offset;                 /**< offset in the payload                          */
+    UINT32  width;                  /**< bytes                                          */
+    UINT32  type;                   /**< TRDP_DATA_TYPE_T of the items, 0 = bytes       */
+    UINT32  count;                  /**< number of items                                */
+} TAU_HIST_COL_T;
+
+/** Telegram in the queue, followed by the payload */
+typedef struct
+{
+    UINT32          len;            /**< length incl. payload and padding               */
+    UINT32          comId;
+    TRDP_IP_ADDR_T  srcIpAddr;
+    UINT32          dataSize;
+    TRDP_TIME_T     time;           /**< vos_getTime() of tau_histLog()                 */
+} TAU_HIST_ENTRY_T;
+
+/** The rows of a ComId not yet written */
+typedef struct
+{
+    UINT32          comId;
+    UINT32          datasetId;
+    UINT32          rowSize;        /**< bytes of a row                                 */
+    BOOL8           described;      /**< DESC block of the layout written               */
+    UINT32          noOfCols;
+    TAU_HIST_COL_T  *pCols;
+    UINT32          noOfRows;
+    UINT64          *pTime;         /**< time stamps in us                              */
+    TRDP_IP_ADDR_T  *pSrc;          /**< source IP addresses                            */
+    UINT32          *pSize;         /**< payload sizes                                  */
+    UINT8           *pRows;         /**< payloads, zero padded to rowSize               */
+} TAU_HIST_STREAM_T;
+
+/** History store */
+struct TAU_HIST
+{
+    TAU_HIST_CONFIG_T   config;
+    FILE                *fp;
+    VOS_MUTEX_T         mutex;          /**< guards the fill buffer, run flags and counters */
+    VOS_THREAD_T        thread;
+    BOOL8               run;            /**< thread shall run                               */
+    BOOL8               active;         /**< thread runs                                    */
+    TRDP_ERR_T          err;            /**< first write error                              */
+    TRDP_TIME_T         start;          /**< vos_getTime() of time stamp 0                  */
+    UINT8               *pFill;         /**< buffer tau_histLog() copies to                 */
+    UINT8               *pDrain;        /**< buffer the thread reads                        */
+    UINT32              fillSize;
+    TAU_HIST_STATS_T    stats;
+    TAU_HIST_STREAM_T   *pStreams[2u * TAU_HIST_MAX_COMIDS];    /**< hash of the ComIds     */
+    UINT32              noOfStreams;
+    UINT8               *pTmp;          /**< transposed column                              */
+    UINT32              tmpSize;
+    UINT8               *pOut;          /**< encoded chunk                                  */
+    UINT32              outSize;
+    UINT8               *pCol;          /**< time, source and size column                   */
+};
+
+/***********************************************************************************************************************
+ *   Locals
+ */
+
+/**********************************************************************************************************************/
+/** Store a 32 bit number in network byte order
+ *
+ *  @param[out]     p           destination
+ *  @param[in]      value       the number
+ */
+static void tau_histPut32 (
+    UINT8   *p,
+    UINT32  value)
+{
+    p[0]    = (UINT8) (value >> 24u);
+    p[1]    = (UINT8) (value >> 16u);
+    p[2]    = (UINT8) (value >> 8u);
+    p[3]    = (UINT8) value;
+}
+
+/**********************************************************************************************************************/
+/** Read a 32 bit number in network byte order
+ *
+ *  @param[in]      p           source
+ *
+ *  @retval         the number
+ */
+static UINT32 tau_histGet32 (
+    const UINT8 *p)
+{
+    return ((UINT32) p[0] << 24u) | ((UINT32) p[1] << 16u) | ((UINT32) p[2] << 8u) | (UINT32) p[3];
+}
+
+/**********************************************************************************************************************/
+/** Wire size of a basic type
+ *
+ *  @param[in]      type        TRDP_DATA_TYPE_T
+ *
+ *  @retval         size in bytes, 0 if unknown
+ */
+static UINT32 tau_histWireSize (
+    UINT32 type)
+{
+    switch (type)
+    {
+       case TRDP_BOOL8:
+       case TRDP_CHAR8:
+       case TRDP_INT8:
+       case TRDP_UINT8:
+           return 1u;
+       case TRDP_UTF16:
+       case TRDP_INT16:
+       case TRDP_UINT16:
+           return 2u;
+       case TRDP_INT32:
+       case TRDP_UINT32:
+       case TRDP_REAL32:
+       case TRDP_TIMEDATE32:
+           return 4u;
+       case TRDP_TIMEDATE48:
+           return 6u;
+       case TRDP_INT64:
+       case TRDP_UINT64:
+       case TRDP_REAL64:
+       case TRDP_TIMEDATE64:
+           return 8u;
+       default:
+           return 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Find a dataset by its id
+ *
+ *  @param[in]      pConfig     configuration with the datasets
+ *  @param[in]      datasetId   id of the dataset
+ *
+ *  @retval         the dataset or NULL
+ */
+static const TRDP_DATASET_T *tau_histFindDs (
+    const TAU_HIST_CONFIG_T *pConfig,
+    UINT32                  datasetId)
+{
+    UINT32 i;
+
+    for (i = 0u; i < pConfig->numDataset; i++)
+    {
+        if ((pConfig->apDataset[i] != NULL) && (pConfig->apDataset[i]->id == datasetId))
+        {
+            return pConfig->apDataset[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Append the columns of a dataset of fixed size
+ *
+ *  @param[in]      pConfig     configuration with the datasets
+ *  @param[in]      pDataset    the dataset
+ *  @param[in]      level       nesting level
+ *  @param[in,out]  pCols       columns, TAU_HIST_MAX_COLS
+ *  @param[in,out]  pNoOfCols   number of columns
+ *  @param[in,out]  pOffset     offset of the dataset in the payload, returns the offset after it
+ *
+ *  @retval         TRUE        columns appended
+ *  @retval         FALSE       dataset of variable size, unknown or too many columns
+ */
+static BOOL8 tau_histFlatten (
+    const TAU_HIST_CONFIG_T *pConfig,
+    const TRDP_DATASET_T    *pDataset,
+    UINT32                  level,
+    TAU_HIST_COL_T          *pCols,
+    UINT32                  *pNoOfCols,
+    UINT32                  *pOffset)
+{
+    UINT32 i;
+    UINT32 j;
+
+    if (level > TAU_MAX_DS_LEVEL)
+    {
+        return FALSE;
+    }
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        const TRDP_DATASET_ELEMENT_T *pElement = &pDataset->pElement[i];
+
+        if (pElement->size == TRDP_VAR_SIZE)
+        {
+            return FALSE;
+        }
+        if (pElement->type <= (UINT32) TRDP_TYPE_MAX)
+        {
+            UINT32 wireSize = tau_histWireSize(pElement->type);
+
+            if ((wireSize == 0u) || (*pNoOfCols == TAU_HIST_MAX_COLS) || (pElement->size > TRDP_MAX_PD_DATA_SIZE))
+            {
+                return FALSE;
+            }
+            pCols[*pNoOfCols].offset    = *pOffset;
+            pCols[*pNoOfCols].width     = wireSize * pElement->size;
+            pCols[*pNoOfCols].type      = pElement->type;
+            pCols[*pNoOfCols].count     = pElement->size;
+            (*pNoOfCols)++;
+            *pOffset += wireSize * pElement->size;
+        }
+        else
+        {
+            const TRDP_DATASET_T *pNested = tau_histFindDs(pConfig, pElement->type);
+
+            if (pNested == NULL)
+            {
+                return FALSE;
+            }
+            for (j = 0u; j < pElement->size; j++)
+            {
+                if (!tau_histFlatten(pConfig, pNested, level + 1u, pCols, pNoOfCols, pOffset))
+                {
+                    return FALSE;
+                }
+            }
+        }
+        if (*pOffset > TRDP_MAX_PD_DATA_SIZE)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Set the row size of a stream and allocate its row buffers
+ *
+ *  @param[in]      pHist       the store
+ *  @param[in]      pStream     the stream, without rows
+ *  @param[in]      rowSize     new row size
+ *
+ *  @retval         TRUE        done
+ *  @retval         FALSE       out of memory
+ */
+static BOOL8 tau_histSetRowSize (
+    TAU_HIST_T          pHist,
+    TAU_HIST_STREAM_T   *pStream,
+    UINT32              rowSize)
+{
+    UINT8 *pRows = (UINT8 *) vos_memAlloc(rowSize * pHist->config.rowsPerChunk);
+
+    if (pRows == NULL)
+    {
+        return FALSE;
+    }
+    if (pStream->pRows != NULL)
+    {
+        vos_memFree(pStream->pRows);
+    }
+    pStream->pRows      = pRows;
+    pStream->rowSize    = rowSize;
+    pStream->described  = FALSE;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Find or create the stream of a ComId
+ *  The columns are the elements of its dataset; without dataset of fixed size the row is one column of bytes.
+ *
+ *  @param[in]      pHist       the store
+ *  @param[in]      comId       the ComId
+ *
+ *  @retval         the stream or NULL
+ */
+static TAU_HIST_STREAM_T *tau_histStream (
+    TAU_HIST_T  pHist,
+    UINT32      comId)
+{
+    UINT32              index   = (comId * 2654435761u) & (2u * TAU_HIST_MAX_COMIDS - 1u);
+    TAU_HIST_STREAM_T   *pStream;
+    TAU_HIST_COL_T      cols[TAU_HIST_MAX_COLS];
+    const TRDP_DATASET_T *pDataset = NULL;
+    UINT32              noOfCols    = 0u;
+    UINT32              rowSize     = 0u;
+    UINT32              i;
+
+    while (pHist->pStreams[index] != NULL)
+    {
+        if (pHist->pStreams[index]->comId == comId)
+        {
+            return pHist->pStreams[index];
+        }
+        index = (index + 1u) & (2u * TAU_HIST_MAX_COMIDS - 1u);
+    }
+    if (pHist->noOfStreams == TAU_HIST_MAX_COMIDS)
+    {
+        return NULL;
+    }
+
+    pStream = (TAU_HIST_STREAM_T *) vos_memAlloc(sizeof(TAU_HIST_STREAM_T));
+    if (pStream == NULL)
+    {
+        return NULL;
+    }
+    pStream->comId = comId;
+    for (i = 0u; i < pHist->config.numComId; i++)
+    {
+        if (pHist->config.pComIdDsIdMap[i].comId == comId)
+        {
+            pStream->datasetId  = pHist->config.pComIdDsIdMap[i].datasetId;
+            pDataset            = tau_histFindDs(&pHist->config, pStream->datasetId);
+            break;
+        }
+    }
+    if ((pDataset == NULL) || !tau_histFlatten(&pHist->config, pDataset, 0u, cols, &noOfCols, &rowSize) ||
+        (rowSize == 0u))
+    {
+        /* one column of bytes, sized by the first telegram */
+        noOfCols    = 1u;
+        rowSize     = 0u;
+        memset(cols, 0, sizeof(TAU_HIST_COL_T));
+    }
+
+    pStream->noOfCols   = noOfCols;
+    pStream->pCols      = (TAU_HIST_COL_T *) vos_memAlloc(noOfCols * sizeof(TAU_HIST_COL_T));
+    pStream->pTime      = (UINT64 *) vos_memAlloc(pHist->config.rowsPerChunk * sizeof(UINT64));
+    pStream->pSrc       = (TRDP_IP_ADDR_T *) vos_memAlloc(pHist->config.rowsPerChunk * sizeof(TRDP_IP_ADDR_T));
+    pStream->pSize      = (UINT32 *) vos_memAlloc(pHist->config.rowsPerChunk * sizeof(UINT32));
+    if ((pStream->pCols == NULL) || (pStream->pTime == NULL) || (pStream->pSrc == NULL) || (pStream->pSize == NULL) ||
+        ((rowSize > 0u) && !tau_histSetRowSize(pHist, pStream, rowSize)))
+    {
+        vos_memFree(pStream->pCols);
+        vos_memFree(pStream->pTime);
+        vos_memFree(pStream->pSrc);
+        vos_memFree(pStream->pSize);
+        vos_memFree(pStream);
+        return NULL;
+    }
+    memcpy(pStream->pCols, cols, noOfCols * sizeof(TAU_HIST_COL_T));
+
+    pHist->pStreams[index] = pStream;
+    pHist->noOfStreams++;
+    return pStream;
+}
+
+/**********************************************************************************************************************/
+/** Grow a scratch buffer
+ *
+ *  @param[in,out]  ppBuf       the buffer
+ *  @param[in,out]  pSize       its size
+ *  @param[in]      size        size needed
+ *
+ *  @retval         TRUE        buffer large enough
+ *  @retval         FALSE       out of memory
+ */
+static BOOL8 tau_histReserve (
+    UINT8   * *ppBuf,
+    UINT32  *pSize,
+    UINT32  size)
+{
+    if (*pSize < size)
+    {
+        UINT8 *pBuf = (UINT8 *) vos_memAlloc(size);
+
+        if (pBuf == NULL)
+        {
+            return FALSE;
+        }
+        if (*ppBuf != NULL)
+        {
+            vos_memFree(*ppBuf);
+        }
+        *ppBuf  = pBuf;
+        *pSize  = size;
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Compress a column
+ *  XOR with the previous row, transposition to byte planes, run length encoding of zeros and literal bytes:
+ *  control byte 0x00...0x7F: 1...128 literal bytes follow, 0x80...0xFF: 1...128 zeros.
+ *
+ *  @param[in]      pSrc        first value
+ *  @param[in]      stride      bytes from one value to the next
+ *  @param[in]      width       bytes of a value
+ *  @param[in]      noOfRows    number of values
+ *  @param[in]      pTmp        scratch buffer of width * noOfRows
+ *  @param[out]     pOut        encoded column, at most n + n / 128 + 1 bytes for n = width * noOfRows
+ *
+ *  @retval         length of the encoded column
+ */
+static UINT32 tau_histEncode (
+    const UINT8 *pSrc,
+    UINT32      stride,
+    UINT32      width,
+    UINT32      noOfRows,
+    UINT8       *pTmp,
+    UINT8       *pOut)
+{
+    UINT32  n   = width * noOfRows;
+    UINT32  i   = 0u;
+    UINT32  o   = 0u;
+    UINT32  r;
+    UINT32  b;
+
+    for (b = 0u; b < width; b++)
+    {
+        pTmp[b * noOfRows] = pSrc[b];
+    }
+    for (r = 1u; r < noOfRows; r++)
+    {
+        const UINT8 *pRow = pSrc + r * stride;
+
+        for (b = 0u; b < width; b++)
+        {
+            pTmp[b * noOfRows + r] = pRow[b] ^ (pRow - stride)[b];
+        }
+    }
+
+    while (i < n)
+    {
+        UINT32 run = 0u;
+
+        if (pTmp[i] == 0u)
+        {
+            while ((i + run < n) && (pTmp[i + run] == 0u) && (run < TAU_HIST_RUN))
+            {
+                run++;
+            }
+            pOut[o++] = (UINT8) (0x7Fu + run);
+        }
+        else
+        {
+            /* a single zero is cheaper in the literal */
+            while ((i + run < n) && (run < TAU_HIST_RUN) &&
+                   !((pTmp[i + run] == 0u) && (i + run + 1u < n) && (pTmp[i + run + 1u] == 0u)))
+            {
+                run++;
+            }
+            pOut[o++] = (UINT8) (run - 1u);
+            memcpy(pOut + o, pTmp + i, run);
+            o += run;
+        }
+        i += run;
+    }
+    return o;
+}
+
+/**********************************************************************************************************************/
+/** Decompress a column
+ *
+ *  @param[in]      pIn         encoded column
+ *  @param[in]      inLen       its length
+ *  @param[out]     pDest       first value
+ *  @param[in]      stride      bytes from one value to the next
+ *  @param[in]      width       bytes of a value
+ *  @param[in]      noOfRows    number of values
+ *  @param[in]      pTmp        scratch buffer of width * noOfRows
+ *
+ *  @retval         TRUE        decoded
+ *  @retval         FALSE       corrupt
+ */
+static BOOL8 tau_histDecode (
+    const UINT8 *pIn,
+    UINT32      inLen,
+    UINT8       *pDest,
+    UINT32      stride,
+    UINT32      width,
+    UINT32      noOfRows,
+    UINT8       *pTmp)
+{
+    UINT32  n   = width * noOfRows;
+    UINT32  i   = 0u;
+    UINT32  o   = 0u;
+    UINT32  r;
+    UINT32  b;
+
+    while (i < inLen)
+    {
+        UINT32 ctrl = pIn[i++];
+
+        if (ctrl >= 0x80u)
+        {
+            ctrl -= 0x7Fu;
+            if (o + ctrl > n)
+            {
+                return FALSE;
+            }
+            memset(pTmp + o, 0, ctrl);
+        }
+        else
+        {
+            ctrl++;
+            if ((o + ctrl > n) || (i + ctrl > inLen))
+            {
+                return FALSE;
+            }
+            memcpy(pTmp + o, pIn + i, ctrl);
+            i += ctrl;
+        }
+        o += ctrl;
+    }
+    if (o != n)
+    {
+        return FALSE;
+    }
+
+    for (b = 0u; b < width; b++)
+    {
+        pDest[b] = pTmp[b * noOfRows];
+    }
+    for (r = 1u; r < noOfRows; r++)
+    {
+        UINT8 *pRow = pDest + r * stride;
+
+        for (b = 0u; b < width; b++)
+        {
+            pRow[b] = pTmp[b * noOfRows + r] ^ (pRow - stride)[b];
+        }
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Write a block to the file
+ *
+ *  @param[in]      pHist       the store
+ *  @param[in]      type        block type
+ *  @param[in]      pBody       body of the block
+ *  @param[in]      size        size of the body
+ */
+static void tau_histWriteBlock (
+    TAU_HIST_T  pHist,
+    UINT32      type,
+    const UINT8 *pBody,
+    UINT32      size)
+{
+    UINT8 head[8];
+
+    tau_histPut32(head, type);
+    tau_histPut32(head + 4u, size);
+    if ((fwrite(head, sizeof(head), 1u, pHist->fp) != 1u) ||
+        ((size > 0u) && (fwrite(pBody, size, 1u, pHist->fp) != 1u)))
+    {
+        if (pHist->err == TRDP_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "tau_hist: write failed\n");
+        }
+        pHist->err = TRDP_IO_ERR;
+    }
+    else
+    {
+        (void) vos_mutexLock(pHist->mutex);
+        pHist->stats.bytesWritten += sizeof(head) + size;
+        (void) vos_mutexUnlock(pHist->mutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write the rows of a stream as chunk, preceded by the layout if not written before
+ *
+ *  @param[in]      pHist       the store
+ *  @param[in]      pStream     the stream
+ */
+static void tau_histWriteChunk (
+    TAU_HIST_T          pHist,
+    TAU_HIST_STREAM_T   *pStream)
+{
+    UINT32  rows    = pStream->noOfRows;
+    UINT32  width   = (pStream->rowSize > 8u) ? pStream->rowSize : 8u;
+    UINT32  bound;
+    UINT32  pos;
+    UINT32  i;
+    UINT64  prev    = 0u;
+
+    if (rows == 0u)
+    {
+        return;
+    }
+    pStream->noOfRows = 0u;
+
+    bound = 8u + (pStream->noOfCols + TAU_HIST_FIXED_COLS) * 5u + 16u * rows + pStream->rowSize * rows;
+    bound += bound / TAU_HIST_RUN;
+    if (!tau_histReserve(&pHist->pTmp, &pHist->tmpSize, width * rows) ||
+        !tau_histReserve(&pHist->pOut, &pHist->outSize, (bound > 20u + pStream->noOfCols * 16u) ?
+                         bound : 20u + pStream->noOfCols * 16u))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "tau_hist: out of memory\n");
+        pHist->err = TRDP_MEM_ERR;
+        return;
+    }
+
+    if (!pStream->described)
+    {
+        tau_histPut32(pHist->pOut, pStream->comId);
+        tau_histPut32(pHist->pOut + 4u, pStream->datasetId);
+        tau_histPut32(pHist->pOut + 8u, pStream->rowSize);
+        tau_histPut32(pHist->pOut + 12u, pStream->noOfCols);
+        for (i = 0u; i < pStream->noOfCols; i++)
+        {
+            tau_histPut32(pHist->pOut + 16u + i * 16u, pStream->pCols[i].offset);
+            tau_histPut32(pHist->pOut + 20u + i * 16u, pStream->pCols[i].width);
+            tau_histPut32(pHist->pOut + 24u + i * 16u, pStream->pCols[i].type);
+            tau_histPut32(pHist->pOut + 28u + i * 16u, pStream->pCols[i].count);
+        }
+        tau_histWriteBlock(pHist, TAU_HIST_BLK_DESC, pHist->pOut, 16u + pStream->noOfCols * 16u);
+        pStream->described = TRUE;
+    }
+
+    tau_histPut32(pHist->pOut, pStream->comId);
+    tau_histPut32(pHist->pOut + 4u, rows);
+    pos = 8u;
+
+    /* time differences */
+    for (i = 0u; i < rows; i++)
+    {
+        UINT64 diff = pStream->pTime[i] - prev;
+
+        prev = pStream->pTime[i];
+        tau_histPut32(pHist->pCol + i * 8u, (UINT32) (diff >> 32u));
+        tau_histPut32(pHist->pCol + i * 8u + 4u, (UINT32) diff);
+    }
+    tau_histPut32(pHist->pOut + pos, tau_histEncode(pHist->pCol, 8u, 8u, rows, pHist->pTmp, pHist->pOut + pos + 4u));
+    pos += 4u + tau_histGet32(pHist->pOut + pos);
+
+    for (i = 0u; i < rows; i++)
+    {
+        tau_histPut32(pHist->pCol + i * 4u, pStream->pSrc[i]);
+    }
+    tau_histPut32(pHist->pOut + pos, tau_histEncode(pHist->pCol, 4u, 4u, rows, pHist->pTmp, pHist->pOut + pos + 4u));
+    pos += 4u + tau_histGet32(pHist->pOut + pos);
+
+    for (i = 0u; i < rows; i++)
+    {
+        tau_histPut32(pHist->pCol + i * 4u, pStream->pSize[i]);
+    }
+    tau_histPut32(pHist->pOut + pos, tau_histEncode(pHist->pCol, 4u, 4u, rows, pHist->pTmp, pHist->pOut + pos + 4u));
+    pos += 4u + tau_histGet32(pHist->pOut + pos);
+
+    for (i = 0u; i < pStream->noOfCols; i++)
+    {
+        const TAU_HIST_COL_T *pCol = &pStream->pCols[i];
+
+        tau_histPut32(pHist->pOut + pos,
+                      tau_histEncode(pStream->pRows + pCol->offset, pStream->rowSize, pCol->width, rows,
+                                     pHist->pTmp, pHist->pOut + pos + 4u));
+        pos += 4u + tau_histGet32(pHist->pOut + pos);
+    }
+
+    tau_histWriteBlock(pHist, TAU_HIST_BLK_CHUNK, pHist->pOut, pos);
+    (void) vos_mutexLock(pHist->mutex);
+    pHist->stats.numChunks++;
+    (void) vos_mutexUnlock(pHist->mutex);
+}
+
+/**********************************************************************************************************************/
+/** Append a telegram to the rows of its ComId
+ *
+ *  @param[in]      pHist       the store
+ *  @param[in]      pEntry      the telegram
+ */
+static void tau_histAppend (
+    TAU_HIST_T              pHist,
+    const TAU_HIST_ENTRY_T  *pEntry)
+{
+    TAU_HIST_STREAM_T   *pStream = tau_histStream(pHist, pEntry->comId);
+    UINT8               *pRow;
+    INT32               sec;
+    INT32               usec;
+
+    if (pStream == NULL)
+    {
+        (void) vos_mutexLock(pHist->mutex);
+        pHist->stats.numDropped++;
+        (void) vos_mutexUnlock(pHist->mutex);
+        return;
+    }
+
+    /* a telegram larger than its dataset turns the row into one column of bytes */
+    if (pEntry->dataSize > pStream->rowSize)
+    {
+        tau_histWriteChunk(pHist, pStream);
+        pStream->noOfCols           = 1u;
+        pStream->pCols[0].offset    = 0u;
+        pStream->pCols[0].width     = (pEntry->dataSize + TAU_HIST_ROW_ALIGN - 1u) & ~(TAU_HIST_ROW_ALIGN - 1u);
+        pStream->pCols[0].type      = 0u;
+        pStream->pCols[0].count     = pStream->pCols[0].width;
+        if (!tau_histSetRowSize(pHist, pStream, pStream->pCols[0].width))
+        {
+            pStream->rowSize = 0u;
+            pHist->err = TRDP_MEM_ERR;
+            return;
+        }
+    }
+
+    sec     = (INT32) (pEntry->time.tv_sec - pHist->start.tv_sec);
+    usec    = (INT32) (pEntry->time.tv_usec - pHist->start.tv_usec);
+    pStream->pTime[pStream->noOfRows]   = (UINT64) ((INT64) sec * 1000000 + usec);
+    pStream->pSrc[pStream->noOfRows]    = pEntry->srcIpAddr;
+    pStream->pSize[pStream->noOfRows]   = pEntry->dataSize;
+    if (pStream->rowSize > 0u)
+    {
+        pRow = pStream->pRows + pStream->noOfRows * pStream->rowSize;
+        memcpy(pRow, pEntry + 1, pEntry->dataSize);
+        memset(pRow + pEntry->dataSize, 0, pStream->rowSize - pEntry->dataSize);
+    }
+
+    if (++pStream->noOfRows == pHist->config.rowsPerChunk)
+    {
+        tau_histWriteChunk(pHist, pStream);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Swap the buffers and append the telegrams queued
+ *
+ *  @param[in]      pHist       the store
+ *
+ *  @retval         TRUE        the thread shall go on
+ */
+static BOOL8 tau_histDrain (
+    TAU_HIST_T pHist)
+{
+    UINT8   *pBuf;
+    UINT32  size;
+    UINT32  pos;
+    BOOL8   run;
+
+    (void) vos_mutexLock(pHist->mutex);
+    pBuf            = pHist->pFill;
+    size            = pHist->fillSize;
+    pHist->pFill    = pHist->pDrain;
+    pHist->pDrain   = pBuf;
+    pHist->fillSize = 0u;
+    run             = pHist->run;
+    (void) vos_mutexUnlock(pHist->mutex);
+
+    for (pos = 0u; pos < size; pos += ((const TAU_HIST_ENTRY_T *) (pBuf + pos))->len)
+    {
+        tau_histAppend(pHist, (const TAU_HIST_ENTRY_T *) (pBuf + pos));
+    }
+    return run;
+}
+
+/**********************************************************************************************************************/
+/** Thread of the store
+ *
+ *  @param[in]      pArg        the store
+ */
+static void tau_histThread (
+    void *pArg)
+{
+    TAU_HIST_T pHist = (TAU_HIST_T) pArg;
+
+    while (tau_histDrain(pHist))
+    {
+        (void) vos_threadDelay(pHist->config.interval);
+    }
+    /* what was logged before tau_histClose() */
+    (void) tau_histDrain(pHist);
+
+    (void) vos_mutexLock(pHist->mutex);
+    pHist->active = FALSE;
+    (void) vos_mutexUnlock(pHist->mutex);
+}
+
+/**********************************************************************************************************************/
+/** Free a store
+ *
+ *  @param[in]      pHist       the store
+ */
+static void tau_histFree (
+    TAU_HIST_T pHist)
+{
+    UINT32 i;
+
+    for (i = 0u; i < 2u * TAU_HIST_MAX_COMIDS; i++)
+    {
+        TAU_HIST_STREAM_T *pStream = pHist->pStreams[i];
+
+        if (pStream != NULL)
+        {
+            vos_memFree(pStream->pCols);
+            vos_memFree(pStream->pTime);
+            vos_memFree(pStream->pSrc);
+            vos_memFree(pStream->pSize);
+            if (pStream->pRows != NULL)
+            {
+                vos_memFree(pStream->pRows);
+            }
+            vos_memFree(pStream);
+        }
+    }
+    if (pHist->pTmp != NULL)
+    {
+        vos_memFree(pHist->pTmp);
+    }
+    if (pHist->pOut != NULL)
+    {
+        vos_memFree(pHist->pOut);
+    }
+    if (pHist->pCol != NULL)
+    {
+        vos_memFree(pHist->pCol);
+    }
+    if (pHist->pFill != NULL)
+    {
+        vos_memFree(pHist->pFill);
+    }
+    if (pHist->pDrain != NULL)
+    {
+        vos_memFree(pHist->pDrain);
+    }
+    if (pHist->mutex != NULL)
+    {
+        vos_mutexDelete(pHist->mutex);
+    }
+    vos_memFree(pHist);
+}
+
+/***********************************************************************************************************************
+ *   Globals
+ */
+
+/**********************************************************************************************************************/
+/**    Create a history store and start its thread.
+ *  The dataset definitions must stay valid until tau_histClose(). ComIds without a dataset of fixed size, and
+ *  telegrams not matching the size of their dataset, are stored as one column of bytes.
+ *
+ *  @param[out]     pHist           pointer to return the handle
+ *  @param[in]      pFileName       name of the file, it is replaced
+ *  @param[in]      pConfig         configuration
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         TRDP_IO_ERR     file could not be created
+ *  @retval         TRDP_THREAD_ERR thread could not be started
+ */
+EXT_DECL TRDP_ERR_T tau_histOpen (
+    TAU_HIST_T              *pHist,
+    const CHAR8             *pFileName,
+    const TAU_HIST_CONFIG_T *pConfig)
+{
+    TAU_HIST_T  pNew;
+    UINT8       head[12];
+
+    if ((pHist == NULL) || (pFileName == NULL) || (pConfig == NULL) ||
+        ((pConfig->numComId > 0u) && (pConfig->pComIdDsIdMap == NULL)) ||
+        ((pConfig->numDataset > 0u) && (pConfig->apDataset == NULL)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    pNew = (TAU_HIST_T) vos_memAlloc(sizeof(struct TAU_HIST));
+    if (pNew == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pNew->config = *pConfig;
+    if (pNew->config.rowsPerChunk == 0u)
+    {
+        pNew->config.rowsPerChunk = TAU_HIST_ROWS_DEFAULT;
+    }
+    if (pNew->config.queueSize < sizeof(TAU_HIST_ENTRY_T) + TRDP_MAX_PD_DATA_SIZE)
+    {
+        pNew->config.queueSize = TAU_HIST_QUEUE_DEFAULT;
+    }
+    if (pNew->config.interval == 0u)
+    {
+        pNew->config.interval = TAU_HIST_INTERVAL_DEFAULT;
+    }
+    pNew->pFill     = (UINT8 *) vos_memAlloc(pNew->config.queueSize);
+    pNew->pDrain    = (UINT8 *) vos_memAlloc(pNew->config.queueSize);
+    pNew->pCol      = (UINT8 *) vos_memAlloc(pNew->config.rowsPerChunk * 8u);
+    if ((pNew->pFill == NULL) || (pNew->pDrain == NULL) || (pNew->pCol == NULL) ||
+        (vos_mutexCreate(&pNew->mutex) != VOS_NO_ERR))
+    {
+        tau_histFree(pNew);
+        return TRDP_MEM_ERR;
+    }
+
+    pNew->fp = fopen(pFileName, "wb");
+    if (pNew->fp == NULL)
+    {
+        tau_histFree(pNew);
+        return TRDP_IO_ERR;
+    }
+    vos_getTime(&pNew->start);
+    tau_histPut32(head, TAU_HIST_MAGIC);
+    tau_histPut32(head + 4u, TAU_HIST_VERSION);
+    tau_histPut32(head + 8u, (UINT32) time(NULL));
+    tau_histWriteBlock(pNew, TAU_HIST_BLK_HEAD, head, sizeof(head));
+
+    pNew->run       = TRUE;
+    pNew->active    = TRUE;
+    if ((pNew->err != TRDP_NO_ERR) ||
+        (vos_threadCreate(&pNew->thread, "tauHist", VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
+                          tau_histThread, pNew) != VOS_NO_ERR))
+    {
+        TRDP_ERR_T err = (pNew->err != TRDP_NO_ERR) ? pNew->err : TRDP_THREAD_ERR;
+
+        (void) fclose(pNew->fp);
+        tau_histFree(pNew);
+        return err;
+    }
+    *pHist = pNew;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Log a telegram.
+ *  The payload is copied to the queue, e.g. from the PD callback or after tlp_get(). Thread safe.
+ *
+ *  @param[in]      hist            handle returned by tau_histOpen()
+ *  @param[in]      comId           ComId of the telegram
+ *  @param[in]      srcIpAddr       source IP address
+ *  @param[in]      pData           payload in network format
+ *  @param[in]      dataSize        size of the payload
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_QUEUE_FULL_ERR queue full, telegram dropped
+ */
+EXT_DECL TRDP_ERR_T tau_histLog (
+    TAU_HIST_T      hist,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    const UINT8     *pData,
+    UINT32          dataSize)
+{
+    TRDP_ERR_T          err = TRDP_NO_ERR;
+    TAU_HIST_ENTRY_T    *pEntry;
+    TRDP_TIME_T         now;
+    UINT32              len = TAU_HIST_ALIGN(sizeof(TAU_HIST_ENTRY_T) + dataSize);
+
+    if ((hist == NULL) || ((pData == NULL) && (dataSize > 0u)) || (dataSize > TRDP_MAX_PD_DATA_SIZE))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    vos_getTime(&now);
+
+    if (vos_mutexLock(hist->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    if (hist->fillSize + len > hist->config.queueSize)
+    {
+        hist->stats.numDropped++;
+        err = TRDP_QUEUE_FULL_ERR;
+    }
+    else
+    {
+        pEntry              = (TAU_HIST_ENTRY_T *) (hist->pFill + hist->fillSize);
+        pEntry->len         = len;
+        pEntry->comId       = comId;
+        pEntry->srcIpAddr   = srcIpAddr;
+        pEntry->dataSize    = dataSize;
+        pEntry->time        = now;
+        if (dataSize > 0u)
+        {
+            memcpy(pEntry + 1, pData, dataSize);
+        }
+        hist->fillSize += len;
+        hist->stats.numLogged++;
+        hist->stats.bytesLogged += dataSize;
+    }
+    (void) vos_mutexUnlock(hist->mutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Get the counters of a history store.
+ *
+ *  @param[in]      hist            handle returned by tau_histOpen()
+ *  @param[out]     pStats          the counters
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ */
+EXT_DECL TRDP_ERR_T tau_histGetStatistics (
+    TAU_HIST_T          hist,
+    TAU_HIST_STATS_T    *pStats)
+{
+    if ((hist == NULL) || (pStats == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    (void) vos_mutexLock(hist->mutex);
+    *pStats = hist->stats;
+    (void) vos_mutexUnlock(hist->mutex);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Write all logged telegrams, stop the thread, close the file.
+ *
+ *  @param[in]      hist            handle returned by tau_histOpen()
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_IO_ERR     file could not be written
+ */
+EXT_DECL TRDP_ERR_T tau_histClose (
+    TAU_HIST_T hist)
+{
+    TRDP_ERR_T  err;
+    BOOL8       active = TRUE;
+    UINT32      i;
+
+    if (hist == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    (void) vos_mutexLock(hist->mutex);
+    hist->run = FALSE;
+    (void) vos_mutexUnlock(hist->mutex);
+    while (active)
+    {
+        (void) vos_threadDelay(1000u);
+        (void) vos_mutexLock(hist->mutex);
+        active = hist->active;
+        (void) vos_mutexUnlock(hist->mutex);
+    }
+
+    for (i = 0u; i < 2u * TAU_HIST_MAX_COMIDS; i++)
+    {
+        if (hist->pStreams[i] != NULL)
+        {
+            tau_histWriteChunk(hist, hist->pStreams[i]);
+        }
+    }
+    if (fclose(hist->fp) != 0)
+    {
+        hist->err = TRDP_IO_ERR;
+    }
+    err = hist->err;
+    tau_histFree(hist);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Read a history file.
+ *  The telegrams are delivered per chunk, i.e. in order per ComId.
+ *
+ *  @param[in]      pFileName       name of the file
+ *  @param[in]      pfCallback      called for every telegram
+ *  @param[in]      pRefCon         user context passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_IO_ERR     file could not be read
+ *  @retval         TRDP_WIRE_ERR   file corrupt
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_histRead (
+    const CHAR8         *pFileName,
+    TAU_HIST_CALLBACK_T pfCallback,
+    void                *pRefCon)
+{
+    TRDP_ERR_T          err         = TRDP_NO_ERR;
+    TAU_HIST_STREAM_T   *pDesc[2u * TAU_HIST_MAX_COMIDS];
+    UINT8               *pBody      = NULL;
+    UINT32              bodySize    = 0u;
+    UINT8               *pTmp       = NULL;
+    UINT32              tmpSize     = 0u;
+    UINT8               *pRows      = NULL;
+    UINT32              rowsSize    = 0u;
+    UINT32              wallSec     = 0u;
+    UINT8               head[8];
+    FILE                *fp;
+    UINT32              i;
+
+    if ((pFileName == NULL) || (pfCallback == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    fp = fopen(pFileName, "rb");
+    if (fp == NULL)
+    {
+        return TRDP_IO_ERR;
+    }
+    memset(pDesc, 0, sizeof(pDesc));
+
+    while ((err == TRDP_NO_ERR) && (fread(head, sizeof(head), 1u, fp) == 1u))
+    {
+        UINT32 type = tau_histGet32(head);
+        UINT32 size = tau_histGet32(head + 4u);
+
+        if (size > 0x10000000u)
+        {
+            err = TRDP_WIRE_ERR;
+            break;
+        }
+        if (!tau_histReserve(&pBody, &bodySize, size + 1u))
+        {
+            err = TRDP_MEM_ERR;
+            break;
+        }
+        if ((size > 0u) && (fread(pBody, size, 1u, fp) != 1u))
+        {
+            err = TRDP_WIRE_ERR;
+            break;
+        }
+
+        if (type == TAU_HIST_BLK_HEAD)
+        {
+            if ((size < 12u) || (tau_histGet32(pBody) != TAU_HIST_MAGIC) ||
+                (tau_histGet32(pBody + 4u) != TAU_HIST_VERSION))
+            {
+                err = TRDP_WIRE_ERR;
+            }
+            wallSec = tau_histGet32(pBody + 8u);
+        }
+        else if (wallSec == 0u)
+        {
+            err = TRDP_WIRE_ERR;        /* no header */
+        }
+        else if (type == TAU_HIST_BLK_DESC)
+        {
+            UINT32              comId       = tau_histGet32(pBody);
+            UINT32              noOfCols    = (size >= 16u) ? tau_histGet32(pBody + 12u) : 0u;
+            UINT32              index       = (comId * 2654435761u) & (2u * TAU_HIST_MAX_COMIDS - 1u);
+            TAU_HIST_STREAM_T   *pStream;
+
+            if ((size < 16u) || (noOfCols == 0u) || (noOfCols > TAU_HIST_MAX_COLS) ||
+                (size != 16u + noOfCols * 16u) || (tau_histGet32(pBody + 8u) > TRDP_MAX_PD_DATA_SIZE + TAU_HIST_ROW_ALIGN))
+            {
+                err = TRDP_WIRE_ERR;
+                break;
+            }
+            while ((pDesc[index] != NULL) && (pDesc[index]->comId != comId))
+            {
+                index = (index + 1u) & (2u * TAU_HIST_MAX_COMIDS - 1u);
+            }
+            pStream = pDesc[index];
+            if (pStream == NULL)
+            {
+                pStream = (TAU_HIST_STREAM_T *) vos_memAlloc(sizeof(TAU_HIST_STREAM_T));
+                if (pStream == NULL)
+                {
+                    err = TRDP_MEM_ERR;
+                    break;
+                }
+                pDesc[index] = pStream;
+            }
+            else
+            {
+                vos_memFree(pStream->pCols);
+            }
+            pStream->comId      = comId;
+            pStream->datasetId  = tau_histGet32(pBody + 4u);
+            pStream->rowSize    = tau_histGet32(pBody + 8u);
+            pStream->noOfCols   = noOfCols;
+            pStream->pCols      = (TAU_HIST_COL_T *) vos_memAlloc(noOfCols * sizeof(TAU_HIST_COL_T));
+            if (pStream->pCols == NULL)
+            {
+                pStream->noOfCols = 0u;
+                err = TRDP_MEM_ERR;
+                break;
+            }
+            for (i = 0u; i < noOfCols; i++)
+            {
+                pStream->pCols[i].offset    = tau_histGet32(pBody + 16u + i * 16u);
+                pStream->pCols[i].width     = tau_histGet32(pBody + 20u + i * 16u);
+                pStream->pCols[i].type      = tau_histGet32(pBody + 24u + i * 16u);
+                pStream->pCols[i].count     = tau_histGet32(pBody + 28u + i * 16u);
+                if ((pStream->pCols[i].width > pStream->rowSize) ||
+                    (pStream->pCols[i].offset > pStream->rowSize - pStream->pCols[i].width))
+                {
+                    err = TRDP_WIRE_ERR;
+                }
+            }
+        }
+        else if (type == TAU_HIST_BLK_CHUNK)
+        {
+            UINT32              comId   = (size >= 8u) ? tau_histGet32(pBody) : 0u;
+            UINT32              rows    = (size >= 8u) ? tau_histGet32(pBody + 4u) : 0u;
+            UINT32              index   = (comId * 2654435761u) & (2u * TAU_HIST_MAX_COMIDS - 1u);
+            TAU_HIST_STREAM_T   *pStream;
+            UINT32              rowSize;
+            UINT32              pos     = 8u;
+            UINT64              time    = 0u;
+            UINT32              col;
+
+            while ((pDesc[index] != NULL) && (pDesc[index]->comId != comId))
+            {
+                index = (index + 1u) & (2u * TAU_HIST_MAX_COMIDS - 1u);
+            }
+            pStream = pDesc[index];
+            if ((size < 8u) || (pStream == NULL) || (rows == 0u) || (rows > 0x100000u))
+            {
+                err = TRDP_WIRE_ERR;
+                break;
+            }
+            /* a row holds the payload, followed by time, source IP and size */
+            rowSize = pStream->rowSize + 16u;
+            if (!tau_histReserve(&pRows, &rowsSize, rows * rowSize) ||
+                !tau_histReserve(&pTmp, &tmpSize, rows * rowSize))
+            {
+                err = TRDP_MEM_ERR;
+                break;
+            }
+            for (col = 0u; col < pStream->noOfCols + TAU_HIST_FIXED_COLS; col++)
+            {
+                UINT32  len = (pos + 4u <= size) ? tau_histGet32(pBody + pos) : 0u;
+                UINT32  offset;
+                UINT32  width;
+
+                if (col < TAU_HIST_FIXED_COLS)
+                {
+                    offset  = (col == 0u) ? pStream->rowSize : pStream->rowSize + 4u + 4u * col;
+                    width   = (col == 0u) ? 8u : 4u;
+                }
+                else
+                {
+                    offset  = pStream->pCols[col - TAU_HIST_FIXED_COLS].offset;
+                    width   = pStream->pCols[col - TAU_HIST_FIXED_COLS].width;
+                }
+                if ((pos + 4u > size) || (len > size - pos - 4u) ||
+                    !tau_histDecode(pBody + pos + 4u, len, pRows + offset, rowSize, width, rows, pTmp))
+                {
+                    err = TRDP_WIRE_ERR;
+                    break;
+                }
+                pos += 4u + len;
+            }
+            for (i = 0u; (err == TRDP_NO_ERR) && (i < rows); i++)
+            {
+                const UINT8 *pRow   = pRows + i * rowSize;
+                const UINT8 *pFix   = pRow + pStream->rowSize;
+                UINT32      dataSize = tau_histGet32(pFix + 12u);
+                TRDP_TIME_T stamp;
+
+                time += ((UINT64) tau_histGet32(pFix) << 32u) | tau_histGet32(pFix + 4u);
+                stamp.tv_sec    = (long) (wallSec + time / 1000000u);
+                stamp.tv_usec   = (long) (time % 1000000u);
+                if (dataSize > pStream->rowSize)
+                {
+                    err = TRDP_WIRE_ERR;
+                    break;
+                }
+                pfCallback(pRefCon, comId, &stamp, tau_histGet32(pFix + 8u), pRow, dataSize);
+            }
+        }
+    }
+    if ((err == TRDP_NO_ERR) && (ferror(fp) || (wallSec == 0u)))
+    {
+        err = ferror(fp) ? TRDP_IO_ERR : TRDP_WIRE_ERR;
+    }
+
+    (void) fclose(fp);
+    for (i = 0u; i < 2u * TAU_HIST_MAX_COMIDS; i++)
+    {
+        if (pDesc[i] != NULL)
+        {
+            if (pDesc[i]->pCols != NULL)
+            {
+                vos_memFree(pDesc[i]->pCols);
+            }
+            vos_memFree(pDesc[i]);
+        }
+    }
+    if (pBody != NULL)
+    {
+        vos_memFree(pBody);
+    }
+    if (pTmp != NULL)
+    {
+        vos_memFree(pTmp);
+    }
+    if (pRows != NULL)
+    {
+        vos_memFree(pRows);
+    }
+    return err;
+}
@@ -41,9 +41,24 @@
 #include "trdp_if_light.h"
 #include "trdp_utils.h"
 #include "vos_mem.h"
+#include "trdp_trace.h"
 
 #include "tau_marshall.h"
 
+/* Byte swap kernels for long runs of array items, only needed on little endian hosts */
+#if TAU_MARSHALL_SIMD && defined(L_ENDIAN) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TAU_SIMD_X86    1
+#include <immintrin.h>
+#elif TAU_MARSHALL_SIMD && defined(L_ENDIAN) && defined(__ARM_NEON)
+#define TAU_SIMD_NEON   1
+#include <arm_neon.h>
+#endif
+
+#if TAU_SIMD_X86 || TAU_SIMD_NEON
+#define TAU_SIMD        1
+#define TAU_SIMD_MIN_SIZE   32u     /**< Min. number of bytes of a run for the vector kernels   */
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -56,6 +71,7 @@ typedef struct
     UINT8   *pSrcEnd;       /**< last source             */
     UINT8   *pDst;          /**< destination pointer     */
     UINT8   *pDstEnd;       /**< last destination        */
+    const struct TAU_MARSHALL_CFG *pCfg;    /**< tables of the marshalling context  */
 } TAU_MARSHALL_INFO_T;
 
 /* structure type definitions for alignment calculation */
@@ -75,16 +91,131 @@ typedef struct
     TIMEDATE64 a;
 } TIMEDATE64_STRUCT_T;
 
+#if TAU_MARSHALL_PLAN
+/** Operations of a marshalling plan */
+typedef enum
+{
+    TAU_PLAN_COPY   = 0u,   /**< copy bytes                 */
+    TAU_PLAN_SWAP16 = 1u,   /**< convert 16 bit items       */
+    TAU_PLAN_SWAP32 = 2u,   /**< convert 32 bit items       */
+    TAU_PLAN_SWAP64 = 3u    /**< convert 64 bit items       */
+} TAU_PLAN_OP_T;
+
+/** One run of a marshalling plan: items of the same size at consecutive addresses */
+typedef struct
+{
+    UINT32  hostOffset;     /**< offset into the (aligned) host structure   */
+    UINT32  wireOffset;     /**< offset into the (packed) wire buffer       */
+    UINT32  noOfItems;      /**< number of items (bytes for TAU_PLAN_COPY)  */
+    UINT32  op;             /**< TAU_PLAN_OP_T                              */
+} TAU_PLAN_RUN_T;
+
+/** Precompiled marshalling plan of a dataset without variable sized elements */
+typedef struct
+{
+    UINT32          hostSize;   /**< host bytes read by marshalling / written by unmarshalling  */
+    UINT32          wireSize;   /**< wire bytes written by marshalling / read by unmarshalling  */
+    UINT32          alignment;  /**< alignment the host structure was compiled for              */
+    UINT32          numRuns;    /**< number of runs                                             */
+    UINT32          maxRuns;    /**< allocated runs                                             */
+    TAU_PLAN_RUN_T  *pRun;      /**< list of runs                                               */
+    const TAU_DS_CODEC_T *pCodec;   /**< generated functions used instead of the runs, or NULL  */
+} TAU_PLAN_T;
+
+/** Plan compilation state, mirrors TAU_MARSHALL_INFO_T with offsets instead of pointers */
+typedef struct
+{
+    INT32       level;      /**< track recursive level   */
+    UINT32      host;       /**< host offset             */
+    UINT32      wire;       /**< wire offset             */
+    TAU_PLAN_T  *pPlan;     /**< plan to fill            */
+    const struct TAU_MARSHALL_CFG *pCfg;    /**< tables of the marshalling context  */
+} TAU_PLAN_INFO_T;
+
+/** Kinds of steps of a size descriptor */
+typedef enum
+{
+    TAU_SIZE_FIXED  = 0u,   /**< consecutive elements of fixed size                 */
+    TAU_SIZE_ITEMS  = 1u,   /**< variable number of items of a basic type           */
+    TAU_SIZE_NESTED = 2u    /**< nested datasets which are not of fixed size        */
+} TAU_SIZE_KIND_T;
+
+#define TAU_SIZE_RESIDUES   8u      /**< host offsets are tracked modulo the largest alignment   */
+
+/** One step of a size descriptor */
+typedef struct
+{
+    UINT32  kind;               /**< TAU_SIZE_KIND_T                                                    */
+    UINT32  wireSize;           /**< FIXED: wire bytes of the step, ITEMS: wire bytes of one item       */
+    UINT32  hostSize;           /**< ITEMS: host bytes of one item                                      */
+    UINT32  alignment;          /**< ITEMS: host alignment of the items                                 */
+    UINT32  noOfItems;          /**< NESTED: number of datasets, TRDP_VAR_SIZE: taken from the counter  */
+    UINT32  counterOffset;      /**< wire offset of the last possible counter in the step               */
+    UINT32  counterSize;        /**< size of that counter, 0 if the step contains none                  */
+    UINT32  hostEnd[TAU_SIZE_RESIDUES];     /**< FIXED: host end offset by host start offset modulo 8  */
+    const struct TAU_SIZE_DESC  *pNested;   /**< NESTED: descriptor of the nested dataset              */
+} TAU_SIZE_STEP_T;
+
+/** Size descriptor of a dataset: fixed parts are precomputed, only the counters are read at run time */
+typedef struct TAU_SIZE_DESC
+{
+    UINT32          alignment;  /**< host alignment of the dataset start    */
+    UINT32          depth;      /**< levels of nesting, including this one  */
+    UINT32          numSteps;   /**< number of steps                        */
+    TAU_SIZE_STEP_T *pStep;     /**< list of steps                          */
+} TAU_SIZE_DESC_T;
+#endif
+
+/** Entry of an open addressing lookup index */
+typedef struct
+{
+    UINT32  key;            /**< comId or dataset id                        */
+    UINT32  index;          /**< index into pDataSets, TAU_INDEX_UNUSED     */
+} TAU_INDEX_ENTRY_T;
+
+/** Open addressing lookup index with linear probing, the size is a power of two */
+typedef struct
+{
+    UINT32              mask;       /**< size - 1                   */
+    TAU_INDEX_ENTRY_T   *pEntry;    /**< slots, NULL if not built   */
+} TAU_INDEX_T;
+
+#define TAU_INDEX_UNUSED    0xFFFFFFFFu     /**< marks an unused slot    */
+
+/** Marshalling context: the tables of one tau_initMarshall() call, its address is the reference context */
+typedef struct TAU_MARSHALL_CFG
+{
+    struct TAU_MARSHALL_CFG *pNext;         /**< next context                                   */
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap; /**< comId to dataset id map, sorted by comId       */
+    UINT32                  numComId;       /**< number of entries in pComIdDsIdMap             */
+    TRDP_DATASET_T          * *pDataSets;   /**< datasets, sorted by id                         */
+    UINT32                  numEntries;     /**< number of datasets                             */
+    TAU_INDEX_T             comIdIndex;     /**< comId lookup index into pDataSets              */
+    TAU_INDEX_T             dsIdIndex;      /**< dataset id lookup index into pDataSets         */
+    TAU_DS_LOAD_T           pfLoad;         /**< loader of datasets, NULL: all loaded           */
+    void                    *pLoadRef;      /**< reference passed to pfLoad                     */
+    BOOL8                   *pLoaded;       /**< datasets materialised, same order as pDataSets */
+#if TAU_MARSHALL_PLAN
+    TAU_PLAN_T              * *pPlans;      /**< plans, same order as pDataSets, NULL: no plan  */
+    UINT32                  numPlans;       /**< number of entries in pPlans                    */
+    TAU_SIZE_DESC_T         * *pSizes;      /**< size descriptors, same order as pDataSets      */
+    UINT32                  numSizes;       /**< number of entries in pSizes                    */
+#endif
+} TAU_MARSHALL_CFG_T;
+
 
 /***********************************************************************************************************************
  * LOCALS
  */
 
-static TRDP_COMID_DSID_MAP_T    *sComIdDsIdMap = NULL;
-static UINT32 sNumComId = 0u;
+/** Marshalling contexts created by tau_initMarshall(), the most recent first. They are only changed by
+    tau_initMarshall()/tau_deInitMarshall(), which must not run concurrently with the marshalling functions. */
+static TAU_MARSHALL_CFG_T   *sCfgList = NULL;
 
-static TRDP_DATASET_T           * *sDataSets = NULL;
-static UINT32       sNumEntries = 0u;
+#if TAU_SIMD
+/** Byte swap kernel selected by tau_initMarshall() */
+static void (*sSwapKernel)(UINT8 *pDst, const UINT8 *pSrc, UINT32 size, UINT32 itemSize) = NULL;
+#endif
 
 /** List of byte sizes for standard TCMS types */
 static const UINT8  cSizeOfBasicTypes[] = {1, 1, 1, 2, 1, 2, 4, 8, 1, 2, 4, 8, 4, 8, 4, 4, 4};
@@ -111,6 +242,207 @@ static INLINE UINT8 *alignePtr (
     return (UINT8 *) (((uintptr_t) pSrc + alignment) & ~alignment);
 }
 
+#if TAU_SIMD
+/**********************************************************************************************************************/
+/**    Reverse the bytes of each item, scalar version for the tails of the vector kernels.
+ *
+ *  @param[out]     pDst            destination
+ *  @param[in]      pSrc            source
+ *  @param[in]      size            number of bytes
+ *  @param[in]      itemSize        2, 4, 8
+ */
+static INLINE void swapScalar (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      size,
+    UINT32      itemSize)
+{
+    UINT32 i;
+
+    for (; size >= itemSize; size -= itemSize)
+    {
+        for (i = 0u; i < itemSize; i++)
+        {
+            pDst[i] = pSrc[itemSize - 1u - i];
+        }
+        pDst    += itemSize;
+        pSrc    += itemSize;
+    }
+}
+
+#if TAU_SIMD_X86
+/** pshufb masks reversing 2, 4 and 8 byte items */
+static const UINT8 cSwapMask[3][16] =
+{
+    {1u, 0u, 3u, 2u, 5u, 4u, 7u, 6u, 9u, 8u, 11u, 10u, 13u, 12u, 15u, 14u},
+    {3u, 2u, 1u, 0u, 7u, 6u, 5u, 4u, 11u, 10u, 9u, 8u, 15u, 14u, 13u, 12u},
+    {7u, 6u, 5u, 4u, 3u, 2u, 1u, 0u, 15u, 14u, 13u, 12u, 11u, 10u, 9u, 8u}
+};
+
+/**********************************************************************************************************************/
+/**    Reverse the bytes of each item, SSSE3 version (16 bytes per step).
+ *
+ *  @param[out]     pDst            destination
+ *  @param[in]      pSrc            source
+ *  @param[in]      size            number of bytes
+ *  @param[in]      itemSize        2, 4, 8
+ */
+__attribute__((target("ssse3")))
+static void swapSsse3 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      size,
+    UINT32      itemSize)
+{
+    __m128i mask = _mm_loadu_si128((const __m128i *)(const void *) cSwapMask[itemSize >> 2u]);
+
+    for (; size >= 16u; size -= 16u)
+    {
+        _mm_storeu_si128((__m128i *)(void *) pDst,
+                         _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *) pSrc), mask));
+        pDst    += 16u;
+        pSrc    += 16u;
+    }
+    swapScalar(pDst, pSrc, size, itemSize);
+}
+
+/**********************************************************************************************************************/
+/**    Reverse the bytes of each item, AVX2 version (32 bytes per step).
+ *
+ *  @param[out]     pDst            destination
+ *  @param[in]      pSrc            source
+ *  @param[in]      size            number of bytes
+ *  @param[in]      itemSize        2, 4, 8
+ */
+__attribute__((target("avx2")))
+static void swapAvx2 (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      size,
+    UINT32      itemSize)
+{
+    __m128i mask    = _mm_loadu_si128((const __m128i *)(const void *) cSwapMask[itemSize >> 2u]);
+    __m256i mask2   = _mm256_broadcastsi128_si256(mask);   /* shuffles stay within 128 bit lanes */
+
+    for (; size >= 32u; size -= 32u)
+    {
+        _mm256_storeu_si256((__m256i *)(void *) pDst,
+                            _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(const void *) pSrc), mask2));
+        pDst    += 32u;
+        pSrc    += 32u;
+    }
+    if (size >= 16u)
+    {
+        _mm_storeu_si128((__m128i *)(void *) pDst,
+                         _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *) pSrc), mask));
+        pDst    += 16u;
+        pSrc    += 16u;
+        size    -= 16u;
+    }
+    swapScalar(pDst, pSrc, size, itemSize);
+}
+#endif
+
+#if TAU_SIMD_NEON
+/**********************************************************************************************************************/
+/**    Reverse the bytes of each item, NEON version (16 bytes per step).
+ *
+ *  @param[out]     pDst            destination
+ *  @param[in]      pSrc            source
+ *  @param[in]      size            number of bytes
+ *  @param[in]      itemSize        2, 4, 8
+ */
+static void swapNeon (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      size,
+    UINT32      itemSize)
+{
+    for (; size >= 16u; size -= 16u)
+    {
+        uint8x16_t v = vld1q_u8(pSrc);
+        switch (itemSize)
+        {
+           case 2u:
+               v = vrev16q_u8(v);
+               break;
+           case 4u:
+               v = vrev32q_u8(v);
+               break;
+           default:
+               v = vrev64q_u8(v);
+               break;
+        }
+        vst1q_u8(pDst, v);
+        pDst    += 16u;
+        pSrc    += 16u;
+    }
+    swapScalar(pDst, pSrc, size, itemSize);
+}
+#endif
+
+/**********************************************************************************************************************/
+/**    Select the fastest byte swap kernel of this CPU.
+ */
+static void selectSwapKernel (void)
+{
+#if TAU_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        sSwapKernel = swapAvx2;
+    }
+    else if (__builtin_cpu_supports("ssse3"))
+    {
+        sSwapKernel = swapSsse3;
+    }
+    else
+    {
+        sSwapKernel = NULL;
+    }
+#else
+    sSwapKernel = swapNeon;
+#endif
+}
+#endif
+
+/**********************************************************************************************************************/
+/**    Convert a run of array items between host and network byte order with a vector kernel.
+ *  Short runs and targets without vector kernels are left to the scalar loops of the caller. On big endian hosts
+ *  network order is host order and every run is copied unchanged.
+ *
+ *  @param[out]     pDst            destination
+ *  @param[in]      pSrc            source
+ *  @param[in]      noOfItems       number of items
+ *  @param[in]      itemSize        2, 4, 8
+ *
+ *  @retval         TRUE            items were converted
+ *  @retval         FALSE           caller has to convert the items
+ */
+static INLINE BOOL8 swapItems (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems,
+    UINT32      itemSize)
+{
+#ifdef B_ENDIAN
+    memcpy(pDst, pSrc, noOfItems * itemSize);
+    return TRUE;
+#elif TAU_SIMD
+    if ((sSwapKernel != NULL) && (noOfItems * itemSize >= TAU_SIMD_MIN_SIZE))
+    {
+        sSwapKernel(pDst, pSrc, noOfItems * itemSize, itemSize);
+        return TRUE;
+    }
+#else
+    (void) pDst;
+    (void) pSrc;
+    (void) noOfItems;
+    (void) itemSize;
+#endif
+    return FALSE;
+}
+
 /**********************************************************************************************************************/
 /**    Copy a variable to its natural address.
  *
@@ -125,19 +457,15 @@ static INLINE void unpackedCopy64 (
     UINT8   * *ppSrc,
     UINT8   * *ppDst,
     UINT32  noOfItems)
-
-#if __BIG_ENDIAN__ || __ARMEB__ || __AARCH64EB__ || __MIPSEB__
-{
-    UINT32  size    = noOfItems * sizeof(UINT64);
-    UINT8   *pDst8  = (UINT8 *) alignePtr(*ppDst, ALIGNOF(UINT64));
-    memcpy(pDst8, *ppSrc, size);
-    *ppSrc  = (UINT8 *) *ppSrc + size;
-    *ppDst  = (UINT8 *) pDst8 + size;
-}
-#else
 {
     UINT8   *pDst8  = (UINT8 *) alignePtr(*ppDst, ALIGNOF(UINT64));
     UINT8   *pSrc8  = *ppSrc;
+    if (swapItems(pDst8, pSrc8, noOfItems, 8u) == TRUE)
+    {
+        pDst8       += noOfItems * 8u;
+        pSrc8       += noOfItems * 8u;
+        noOfItems   = 0u;
+    }
     while (noOfItems--)
     {
         *pDst8++    = *(pSrc8 + 7u);
@@ -153,7 +481,6 @@ static INLINE void unpackedCopy64 (
     *ppSrc  = (UINT8 *) pSrc8;
     *ppDst  = (UINT8 *) pDst8;
 }
-#endif
 
 /**********************************************************************************************************************/
 /**    Copy a variable from its natural address.
@@ -172,6 +499,12 @@ static INLINE void packedCopy64 (
     UINT32  noOfItems)
 {
     UINT64 *pSrc64 = (UINT64 *) alignePtr(*ppSrc, ALIGNOF(UINT64));
+    if (swapItems(*ppDst, (const UINT8 *) pSrc64, noOfItems, 8u) == TRUE)
+    {
+        *ppDst      += noOfItems * 8u;
+        pSrc64      += noOfItems;
+        noOfItems   = 0u;
+    }
     while (noOfItems--)
     {
         *(*ppDst)++ = (UINT8) (*pSrc64 >> 56u);
@@ -278,28 +611,201 @@ static int compareComId (
 }
 
 
+/**********************************************************************************************************************/
+/**    Hash function of the lookup indices
+ *
+ *  @param[in]      key         comId or dataset id
+ *  @param[in]      mask        size of the index - 1
+ *
+ *  @retval         slot to start probing
+ */
+static INLINE UINT32 indexHash (
+    UINT32  key,
+    UINT32  mask)
+{
+    UINT32 hash = key * 2654435761u;    /* Knuth's multiplicative hash */
+
+    return (hash ^ (hash >> 16u)) & mask;
+}
+
+/**********************************************************************************************************************/
+/**    Return the dataset index stored for a key
+ *
+ *  @param[in]      pIndex      lookup index
+ *  @param[in]      key         comId or dataset id
+ *
+ *  @retval         TAU_INDEX_UNUSED if not found
+ *  @retval         index into pDataSets
+ */
+static INLINE UINT32 indexFind (
+    const TAU_INDEX_T   *pIndex,
+    UINT32              key)
+{
+    UINT32 slot = indexHash(key, pIndex->mask);
+
+    /* the table is at most half full, probing always ends at an unused slot */
+    while (pIndex->pEntry[slot].index != TAU_INDEX_UNUSED)
+    {
+        if (pIndex->pEntry[slot].key == key)
+        {
+            return pIndex->pEntry[slot].index;
+        }
+        slot = (slot + 1u) & pIndex->mask;
+    }
+    return TAU_INDEX_UNUSED;
+}
+
+/**********************************************************************************************************************/
+/**    Store a dataset index for a key, the first entry of duplicate keys is kept
+ *
+ *  @param[in]      pIndex      lookup index
+ *  @param[in]      key         comId or dataset id
+ *  @param[in]      index       index into pDataSets
+ */
+static void indexInsert (
+    TAU_INDEX_T *pIndex,
+    UINT32      key,
+    UINT32      index)
+{
+    UINT32 slot = indexHash(key, pIndex->mask);
+
+    while (pIndex->pEntry[slot].index != TAU_INDEX_UNUSED)
+    {
+        if (pIndex->pEntry[slot].key == key)
+        {
+            return;
+        }
+        slot = (slot + 1u) & pIndex->mask;
+    }
+    pIndex->pEntry[slot].key    = key;
+    pIndex->pEntry[slot].index  = index;
+}
+
+/**********************************************************************************************************************/
+/**    Allocate an empty lookup index
+ *
+ *  @param[out]     pIndex      lookup index
+ *  @param[in]      noOfKeys    number of keys to be stored
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T indexCreate (
+    TAU_INDEX_T *pIndex,
+    UINT32      noOfKeys)
+{
+    UINT32 size = 16u;
+    UINT32 i;
+
+    while (size < 2u * noOfKeys)
+    {
+        size <<= 1u;
+    }
+    pIndex->pEntry = (TAU_INDEX_ENTRY_T *) vos_memAlloc(size * sizeof(TAU_INDEX_ENTRY_T));
+    if (pIndex->pEntry == NULL)
+    {
+        pIndex->mask = 0u;
+        return TRDP_MEM_ERR;
+    }
+    pIndex->mask = size - 1u;
+    for (i = 0u; i < size; i++)
+    {
+        pIndex->pEntry[i].index = TAU_INDEX_UNUSED;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Release a lookup index
+ *
+ *  @param[in]      pIndex      lookup index
+ */
+static void indexFree (
+    TAU_INDEX_T *pIndex)
+{
+    if (pIndex->pEntry != NULL)
+    {
+        vos_memFree(pIndex->pEntry);
+        pIndex->pEntry  = NULL;
+        pIndex->mask    = 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Build the comId and dataset id indices of the tables of a context.
+ *  Without memory the indices stay empty and the lookups fall back to binary search.
+ *
+ *  @param[in,out]  pCfg        marshalling context
+ */
+static void buildIndices (
+    TAU_MARSHALL_CFG_T *pCfg)
+{
+    UINT32 i, index;
+
+    indexFree(&pCfg->comIdIndex);
+    indexFree(&pCfg->dsIdIndex);
+
+    if ((indexCreate(&pCfg->dsIdIndex, pCfg->numEntries) != TRDP_NO_ERR) ||
+        (indexCreate(&pCfg->comIdIndex, pCfg->numComId) != TRDP_NO_ERR))
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "No memory for dataset index, using binary search\n");
+        indexFree(&pCfg->dsIdIndex);
+        return;
+    }
+    for (i = 0u; i < pCfg->numEntries; i++)
+    {
+        indexInsert(&pCfg->dsIdIndex, pCfg->pDataSets[i]->id, i);
+    }
+    /* map the comIds directly to their datasets, comIds without dataset are left out */
+    for (i = 0u; i < pCfg->numComId; i++)
+    {
+        index = indexFind(&pCfg->dsIdIndex, pCfg->pComIdDsIdMap[i].datasetId);
+        if (index != TAU_INDEX_UNUSED)
+        {
+            indexInsert(&pCfg->comIdIndex, pCfg->pComIdDsIdMap[i].comId, index);
+        }
+    }
+}
+
+static TRDP_DATASET_T *loadDs (
+    const TAU_MARSHALL_CFG_T    *pCfg,
+    UINT32                      index);
+
 /**********************************************************************************************************************/
 /**    Return the dataset for the comID
  *
  *
+ *  @param[in]      pCfg        marshalling context, NULL if not initialised
  *  @param[in]      comId       ComId to find
  *
  *  @retval         NULL if not found
  *  @retval         pointer to dataset
  */
 static TRDP_DATASET_T *findDSFromComId (
-    UINT32 comId)
+    const TAU_MARSHALL_CFG_T    *pCfg,
+    UINT32                      comId)
 {
     TRDP_COMID_DSID_MAP_T   key1;
     TRDP_DATASET_T          * *key3;
     TRDP_COMID_DSID_MAP_T   *key2;
 
+    if (pCfg == NULL)
+    {
+        return NULL;
+    }
+
+    if (pCfg->comIdIndex.pEntry != NULL)
+    {
+        UINT32 index = indexFind(&pCfg->comIdIndex, comId);
+        return (index != TAU_INDEX_UNUSED) ? loadDs(pCfg, index) : NULL;
+    }
+
     key1.comId      = comId;
     key1.datasetId  = 0u;
 
     key2 = (TRDP_COMID_DSID_MAP_T *) vos_bsearch(&key1,
-                                                 sComIdDsIdMap,
-                                                 sNumComId,
+                                                 pCfg->pComIdDsIdMap,
+                                                 pCfg->numComId,
                                                  sizeof(TRDP_COMID_DSID_MAP_T),
                                                  compareComId);
 
@@ -309,13 +815,13 @@ static TRDP_DATASET_T *findDSFromComId (
 
         key22.id    = key2->datasetId;
         key3        = (TRDP_DATASET_T * *) vos_bsearch(&key22,
-                                                       sDataSets,
-                                                       sNumEntries,
+                                                       pCfg->pDataSets,
+                                                       pCfg->numEntries,
                                                        sizeof(TRDP_DATASET_T *),
                                                        compareDatasetDeref);
         if (key3 != NULL)
         {
-            return *key3;
+            return loadDs(pCfg, (UINT32) (key3 - pCfg->pDataSets));
         }
     }
 
@@ -326,28 +832,39 @@ static TRDP_DATASET_T *findDSFromComId (
 /**    Return the dataset for the datasetID
  *
  *
+ *  @param[in]      pCfg                    marshalling context, NULL if not initialised
  *  @param[in]      datasetId               dataset ID to find
  *
  *  @retval         NULL if not found
  *  @retval         pointer to dataset
  */
 static TRDP_DATASET_T *findDs (
-    UINT32 datasetId)
+    const TAU_MARSHALL_CFG_T    *pCfg,
+    UINT32                      datasetId)
 {
-    if ((sDataSets != NULL) && (sNumEntries != 0u))
+    if (pCfg == NULL)
+    {
+        return NULL;
+    }
+    if (pCfg->dsIdIndex.pEntry != NULL)
+    {
+        UINT32 index = indexFind(&pCfg->dsIdIndex, datasetId);
+        return (index != TAU_INDEX_UNUSED) ? loadDs(pCfg, index) : NULL;
+    }
+    if ((pCfg->pDataSets != NULL) && (pCfg->numEntries != 0u))
     {
         TRDP_DATASET_T  key2 = {0u, 0u, 0u};
         TRDP_DATASET_T  * *key3;
 
         key2.id = datasetId;
         key3    = (TRDP_DATASET_T * *) vos_bsearch(&key2,
-                                                   sDataSets,
-                                                   sNumEntries,
+                                                   pCfg->pDataSets,
+                                                   pCfg->numEntries,
                                                    sizeof(TRDP_DATASET_T *),
                                                    compareDatasetDeref);
         if (key3 != NULL)
         {
-            return *key3;
+            return loadDs(pCfg, (UINT32) (key3 - pCfg->pDataSets));
         }
     }
 
@@ -357,13 +874,15 @@ static TRDP_DATASET_T *findDs (
 /**********************************************************************************************************************/
 /**    Return the size of the largest member of this dataset.
  *
+ *  @param[in]      pCfg            marshalling context
  *  @param[in]      pDataset        Pointer to one dataset
  *
  *  @retval         1,2,4,8
  *
  */
 static UINT8 maxSizeOfDSMember (
-    TRDP_DATASET_T *pDataset)
+    const TAU_MARSHALL_CFG_T    *pCfg,
+    TRDP_DATASET_T              *pDataset)
 {
     UINT16  lIndex;
     UINT8   maxSize = 1;
@@ -382,7 +901,7 @@ static UINT8 maxSizeOfDSMember (
             }
             else    /* recurse if nested dataset */
             {
-                maxSize = maxSizeOfDSMember(findDs(pDataset->pElement[lIndex].type));
+                maxSize = maxSizeOfDSMember(pCfg, findDs(pCfg, pDataset->pElement[lIndex].type));
             }
         }
     }
@@ -425,7 +944,7 @@ static TRDP_ERR_T marshallDs (
             "A struct is always aligned to the largest types alignment requirements"
         Only, at this point we do need to know the size of the largest member to follow! */
 
-    pSrc = alignePtr(pInfo->pSrc, maxSizeOfDSMember(pDataset));
+    pSrc = alignePtr(pInfo->pSrc, maxSizeOfDSMember(pInfo->pCfg, pDataset));
 
     /*    Loop over all datasets in the array    */
     for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
@@ -448,7 +967,7 @@ static TRDP_ERR_T marshallDs (
                 if (NULL == pDataset->pElement[lIndex].pCachedDS)
                 {
                     /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
+                    pDataset->pElement[lIndex].pCachedDS = findDs(pInfo->pCfg, pDataset->pElement[lIndex].type);
                 }
 
                 if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
@@ -503,6 +1022,13 @@ static TRDP_ERR_T marshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
+                   if (swapItems(pDst, (const UINT8 *) pSrc16, noOfItems, 2u) == TRUE)
+                   {
+                       pDst    += noOfItems * 2u;
+                       pSrc16  += noOfItems;
+                       noOfItems = 0u;
+                   }
+
                    while (noOfItems-- > 0u)
                    {
                        *pDst++  = (UINT8) (*pSrc16 >> 8u);
@@ -527,6 +1053,13 @@ static TRDP_ERR_T marshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
+                   if (swapItems(pDst, (const UINT8 *) pSrc32, noOfItems, 4u) == TRUE)
+                   {
+                       pDst    += noOfItems * 4u;
+                       pSrc32  += noOfItems;
+                       noOfItems = 0u;
+                   }
+
                    while (noOfItems-- > 0u)
                    {
                        *pDst++  = (UINT8) (*pSrc32 >> 24u);
@@ -547,6 +1080,14 @@ static TRDP_ERR_T marshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
+                   /* an array of TIMEDATE64 is a run of 32 bit items */
+                   if (swapItems(pDst, (const UINT8 *) pSrc32, noOfItems * 2u, 4u) == TRUE)
+                   {
+                       pDst    += noOfItems * 8u;
+                       pSrc32  += noOfItems * 2u;
+                       noOfItems = 0u;
+                   }
+
                    while (noOfItems-- > 0u)
                    {
                        *pDst++  = (UINT8) (*pSrc32 >> 24u);
@@ -652,7 +1193,7 @@ static TRDP_ERR_T unmarshallDs (
         return TRDP_STATE_ERR;
     }
 
-    pDst = alignePtr(pInfo->pDst, maxSizeOfDSMember(pDataset));
+    pDst = alignePtr(pInfo->pDst, maxSizeOfDSMember(pInfo->pCfg, pDataset));
 
     /*    Loop over all datasets in the array    */
     for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
@@ -673,7 +1214,7 @@ static TRDP_ERR_T unmarshallDs (
                 if (NULL == pDataset->pElement[lIndex].pCachedDS)
                 {
                     /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
+                    pDataset->pElement[lIndex].pCachedDS = findDs(pInfo->pCfg, pDataset->pElement[lIndex].type);
                 }
 
                 if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
@@ -723,6 +1264,15 @@ static TRDP_ERR_T unmarshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
+                   if (swapItems((UINT8 *) pDst16, pSrc, noOfItems, 2u) == TRUE)
+                   {
+                       pSrc    += noOfItems * 2u;
+                       pDst16  += noOfItems;
+                       /*    possible variable source size    */
+                       var_size = *(pDst16 - 1);
+                       noOfItems = 0u;
+                   }
+
                    while (noOfItems-- > 0u)
                    {
                        *pDst16  = (UINT16) (*pSrc++ << 8u);
@@ -746,6 +1296,14 @@ static TRDP_ERR_T unmarshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
+                   if (swapItems((UINT8 *) pDst32, pSrc, noOfItems, 4u) == TRUE)
+                   {
+                       pSrc    += noOfItems * 4u;
+                       pDst32  += noOfItems;
+                       var_size = *(pDst32 - 1);
+                       noOfItems = 0u;
+                   }
+
                    while (noOfItems-- > 0)
                    {
                        *pDst32  = ((UINT32)(*pSrc++)) << 24u;
@@ -795,6 +1353,15 @@ static TRDP_ERR_T unmarshallDs (
                        return TRDP_PARAM_ERR;
                    }
 
+                   /* an array of TIMEDATE64 is a run of 32 bit items */
+                   pDst32 = (UINT32 *) alignePtr(pDst, ALIGNOF(TIMEDATE64_STRUCT_T));
+                   if ((noOfItems > 0u) && (swapItems((UINT8 *) pDst32, pSrc, noOfItems * 2u, 4u) == TRUE))
+                   {
+                       pSrc    += noOfItems * 8u;
+                       pDst    = (UINT8 *) (pDst32 + noOfItems * 2u);
+                       noOfItems = 0u;
+                   }
+
                    while (noOfItems-- > 0u)
                    {
                        pDst32   = (UINT32 *) alignePtr(pDst, ALIGNOF(TIMEDATE64_STRUCT_T));
@@ -875,7 +1442,7 @@ static TRDP_ERR_T size_unmarshall (
         return TRDP_STATE_ERR;
     }
 
-    pDst = alignePtr(pInfo->pDst, maxSizeOfDSMember(pDataset));
+    pDst = alignePtr(pInfo->pDst, maxSizeOfDSMember(pInfo->pCfg, pDataset));
 
     /*    Loop over all datasets in the array    */
     for (lIndex = 0u; (lIndex < pDataset->numElement) && (pInfo->pSrcEnd > pInfo->pSrc); ++lIndex)
@@ -897,7 +1464,7 @@ static TRDP_ERR_T size_unmarshall (
                 if (NULL == pDataset->pElement[lIndex].pCachedDS)
                 {
                     /* Look for it   */
-                    pDataset->pElement[lIndex].pCachedDS = findDs(pDataset->pElement[lIndex].type);
+                    pDataset->pElement[lIndex].pCachedDS = findDs(pInfo->pCfg, pDataset->pElement[lIndex].type);
                 }
 
                 if (NULL == pDataset->pElement[lIndex].pCachedDS)      /* Not in our DB    */
@@ -940,8 +1507,8 @@ static TRDP_ERR_T size_unmarshall (
                {
                    UINT16 *pDst16 = (UINT16 *) alignePtr(pDst, ALIGNOF(UINT16));
 
-                   /*    possible variable source size    */
-                   var_size = *(UINT16 *)pSrc;
+                   /*    possible variable source size, the source is in network order    */
+                   var_size = ((UINT32) pSrc[0] << 8u) | pSrc[1];
 
                    while (noOfItems-- > 0u)
                    {
@@ -958,8 +1525,9 @@ static TRDP_ERR_T size_unmarshall (
                {
                    UINT32 *pDst32 = (UINT32 *) alignePtr(pDst, ALIGNOF(UINT32));
 
-                   /*    possible variable source size    */
-                   var_size = *(UINT32 *)pSrc;
+                   /*    possible variable source size, the source is in network order    */
+                   var_size = ((UINT32) pSrc[0] << 24u) | ((UINT32) pSrc[1] << 16u) |
+                              ((UINT32) pSrc[2] << 8u) | pSrc[3];
 
                    while (noOfItems-- > 0u)
                    {
@@ -971,15 +1539,15 @@ static TRDP_ERR_T size_unmarshall (
                }
                case TRDP_TIMEDATE48:
                {
-                   /*    This is not a base type but a structure    */
-                   UINT16 *pDst16;
+                   /*    This is not a base type but a structure, unmarshallDs() fills 8 bytes    */
+                   UINT32 *pDst32;
 
                    while (noOfItems-- > 0u)
                    {
-                       pDst16   = (UINT16 *) alignePtr(pDst, ALIGNOF(TIMEDATE48_STRUCT_T));
-                       pDst16   += 3u;
+                       pDst32   = (UINT32 *) alignePtr(pDst, ALIGNOF(TIMEDATE48_STRUCT_T));
+                       pDst32   += 2u;
                        pSrc     += 6u;
-                       pDst     = (UINT8 *) pDst16;
+                       pDst     = (UINT8 *) pDst32;
                    }
                    break;
                }
@@ -993,7 +1561,8 @@ static TRDP_ERR_T size_unmarshall (
                        pSrc     += 8u;
                        pDst32++;
                        pDst32   = (UINT32 *) alignePtr((UINT8 *) pDst32, ALIGNOF(UINT32));
-                       pDst     = (UINT8 *) pDst32++;
+                       pDst32++;
+                       pDst     = (UINT8 *) pDst32;
                    }
                    break;
                }
@@ -1034,68 +1603,1462 @@ static TRDP_ERR_T size_unmarshall (
     return TRDP_NO_ERR;
 }
 
-/**********************************************************************************************************************
- * GLOBAL FUNCTIONS
- */
-
+#if TAU_MARSHALL_PLAN
 /**********************************************************************************************************************/
-/**    Function to initialise the marshalling/unmarshalling.
- *    The supplied array must be sorted by ComIds. The array must exist during the use of the marshalling
- *    functions (until tlc_terminate()).
- *
- *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
- *  @param[in]      numComId         Number of datasets found in the configuration
- *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
- *  @param[in]      numDataSet       Number of datasets found in the configuration
- *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+/**    Append an item run to a plan, merge it with the previous run if it is contiguous on both sides.
  *
- *  @retval         TRDP_NO_ERR      no error
- *  @retval         TRDP_MEM_ERR     provided buffer to small
- *  @retval         TRDP_PARAM_ERR   Parameter error
+ *  @param[in,out]  pPlan           Pointer to the plan
+ *  @param[in]      op              TAU_PLAN_OP_T
+ *  @param[in]      itemSize        size of one item in bytes
+ *  @param[in]      host            host offset
+ *  @param[in]      wire            wire offset
+ *  @param[in]      noOfItems       number of items
  *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
  */
-
-EXT_DECL TRDP_ERR_T tau_initMarshall (
-    void                    * *ppRefCon,
-    UINT32                  numComId,
-    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
-    UINT32                  numDataSet,
-    TRDP_DATASET_T          *pDataset[])
+static TRDP_ERR_T addPlanRun (
+    TAU_PLAN_T  *pPlan,
+    UINT32      op,
+    UINT32      itemSize,
+    UINT32      host,
+    UINT32      wire,
+    UINT32      noOfItems)
 {
-    UINT32 i, j;
-
-    ppRefCon = ppRefCon;
+    TAU_PLAN_RUN_T *pLast = (pPlan->numRuns > 0u) ? &pPlan->pRun[pPlan->numRuns - 1u] : NULL;
 
-    if ((pDataset == NULL) || (numDataSet == 0u) || (numComId == 0u) || (pComIdDsIdMap == 0u))
+#ifdef B_ENDIAN
+    /* Nothing to convert: all items are copied, contiguous runs of any size merge into one memcpy */
+    op = TAU_PLAN_COPY;
+#endif
+    if (op == TAU_PLAN_COPY)
+    {
+        noOfItems   *= itemSize;
+        itemSize    = 1u;
+    }
+
+    if ((pLast != NULL) &&
+        (pLast->op == op) &&
+        (pLast->hostOffset + pLast->noOfItems * itemSize == host) &&
+        (pLast->wireOffset + pLast->noOfItems * itemSize == wire))
+    {
+        pLast->noOfItems += noOfItems;
+        return TRDP_NO_ERR;
+    }
+
+    if (pPlan->numRuns == pPlan->maxRuns)
+    {
+        UINT32          maxRuns = (pPlan->maxRuns == 0u) ? 16u : pPlan->maxRuns * 2u;
+        TAU_PLAN_RUN_T  *pRun   = (TAU_PLAN_RUN_T *) vos_memAlloc(maxRuns * sizeof(TAU_PLAN_RUN_T));
+
+        if (pRun == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        if (pPlan->pRun != NULL)
+        {
+            memcpy(pRun, pPlan->pRun, pPlan->numRuns * sizeof(TAU_PLAN_RUN_T));
+            vos_memFree(pPlan->pRun);
+        }
+        pPlan->pRun     = pRun;
+        pPlan->maxRuns  = maxRuns;
+    }
+
+    pPlan->pRun[pPlan->numRuns].hostOffset  = host;
+    pPlan->pRun[pPlan->numRuns].wireOffset  = wire;
+    pPlan->pRun[pPlan->numRuns].noOfItems   = noOfItems;
+    pPlan->pRun[pPlan->numRuns].op          = op;
+    pPlan->numRuns++;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Align a host offset and remember the largest alignment used.
+ *
+ *  @param[in,out]  pInfo           Pointer with plan info
+ *  @param[in]      offset          offset to align
+ *  @param[in]      alignment       1, 2, 4, 8
+ *
+ *  @retval         aligned offset
+ */
+static UINT32 alignPlanOffset (
+    TAU_PLAN_INFO_T *pInfo,
+    UINT32          offset,
+    UINT32          alignment)
+{
+    if (pInfo->pPlan->alignment < alignment)
+    {
+        pInfo->pPlan->alignment = alignment;
+    }
+    return (offset + alignment - 1u) & ~(alignment - 1u);
+}
+
+/**********************************************************************************************************************/
+/**    Compile one dataset into a plan.
+ *  The layout is computed exactly as marshallDs()/unmarshallDs() walk the dataset, assuming the host structure
+ *  starts on an address aligned to the largest alignment used. Datasets with variable sized elements, unknown types
+ *  or elements without any data can not be compiled.
+ *
+ *  @param[in,out]  pInfo           Pointer with plan info
+ *  @param[in]      pDataset        Pointer to one dataset
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         TRDP_PARAM_ERR  dataset can not be compiled
+ *  @retval         TRDP_STATE_ERR  Too deep recursion
+ *  @retval         TRDP_COMID_ERR  nested dataset unknown
+ */
+static TRDP_ERR_T compileDs (
+    TAU_PLAN_INFO_T *pInfo,
+    TRDP_DATASET_T  *pDataset)
+{
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT16      lIndex;
+    UINT32      host;
+    UINT32      wire = pInfo->wire;
+
+    /* Restrict recursion */
+    pInfo->level++;
+    if (pInfo->level > TAU_MAX_DS_LEVEL)
+    {
+        return TRDP_STATE_ERR;
+    }
+
+    /*  Align on struct boundary first, but only for the elements of this level (see marshallDs)  */
+    host = alignPlanOffset(pInfo, pInfo->host, maxSizeOfDSMember(pInfo->pCfg, pDataset));
+
+    for (lIndex = 0u; (lIndex < pDataset->numElement) && (err == TRDP_NO_ERR); ++lIndex)
+    {
+        UINT32 noOfItems = pDataset->pElement[lIndex].size;
+
+        if (TRDP_VAR_SIZE == noOfItems)
+        {
+            return TRDP_PARAM_ERR;
+        }
+
+        if (pDataset->pElement[lIndex].type > (UINT32) TRDP_TYPE_MAX)
+        {
+            if (NULL == pDataset->pElement[lIndex].pCachedDS)
+            {
+                pDataset->pElement[lIndex].pCachedDS = findDs(pInfo->pCfg, pDataset->pElement[lIndex].type);
+            }
+            if (NULL == pDataset->pElement[lIndex].pCachedDS)
+            {
+                return TRDP_COMID_ERR;
+            }
+            if (pDataset->pElement[lIndex].pCachedDS->numElement == 0u)
+            {
+                return TRDP_PARAM_ERR;
+            }
+            while ((noOfItems-- > 0u) && (err == TRDP_NO_ERR))
+            {
+                err = compileDs(pInfo, pDataset->pElement[lIndex].pCachedDS);
+            }
+            host    = pInfo->host;
+            wire    = pInfo->wire;
+            continue;
+        }
+
+        switch (pDataset->pElement[lIndex].type)
+        {
+           case TRDP_BOOL8:
+           case TRDP_CHAR8:
+           case TRDP_INT8:
+           case TRDP_UINT8:
+               err     = addPlanRun(pInfo->pPlan, TAU_PLAN_COPY, 1u, host, wire, noOfItems);
+               host    += noOfItems;
+               wire    += noOfItems;
+               break;
+           case TRDP_UTF16:
+           case TRDP_INT16:
+           case TRDP_UINT16:
+               host    = alignPlanOffset(pInfo, host, ALIGNOF(UINT16));
+               err     = addPlanRun(pInfo->pPlan, TAU_PLAN_SWAP16, 2u, host, wire, noOfItems);
+               host    += noOfItems * 2u;
+               wire    += noOfItems * 2u;
+               break;
+           case TRDP_INT32:
+           case TRDP_UINT32:
+           case TRDP_REAL32:
+           case TRDP_TIMEDATE32:
+               host    = alignPlanOffset(pInfo, host, ALIGNOF(UINT32));
+               err     = addPlanRun(pInfo->pPlan, TAU_PLAN_SWAP32, 4u, host, wire, noOfItems);
+               host    += noOfItems * 4u;
+               wire    += noOfItems * 4u;
+               break;
+           case TRDP_TIMEDATE48:
+               while ((noOfItems-- > 0u) && (err == TRDP_NO_ERR))
+               {
+                   host    = alignPlanOffset(pInfo, host, ALIGNOF(TIMEDATE48_STRUCT_T));
+                   err     = addPlanRun(pInfo->pPlan, TAU_PLAN_SWAP32, 4u, host, wire, 1u);
+                   if (err == TRDP_NO_ERR)
+                   {
+                       err = addPlanRun(pInfo->pPlan, TAU_PLAN_SWAP16, 2u,
+                                        alignPlanOffset(pInfo, host + 4u, ALIGNOF(UINT16)), wire + 4u, 1u);
+                   }
+                   host    += 8u;
+                   wire    += 6u;
+               }
+               break;
+           case TRDP_TIMEDATE64:
+               while ((noOfItems-- > 0u) && (err == TRDP_NO_ERR))
+               {
+                   host    = alignPlanOffset(pInfo, host, ALIGNOF(TIMEDATE64_STRUCT_T));
+                   err     = addPlanRun(pInfo->pPlan, TAU_PLAN_SWAP32, 4u, host, wire, 1u);
+                   host    = alignPlanOffset(pInfo, host + 4u, ALIGNOF(UINT32));
+                   if (err == TRDP_NO_ERR)
+                   {
+                       err = addPlanRun(pInfo->pPlan, TAU_PLAN_SWAP32, 4u, host, wire + 4u, 1u);
+                   }
+                   host    += 4u;
+                   wire    += 8u;
+               }
+               break;
+           case TRDP_INT64:
+           case TRDP_UINT64:
+           case TRDP_REAL64:
+               host    = alignPlanOffset(pInfo, host, ALIGNOF(UINT64));
+               err     = addPlanRun(pInfo->pPlan, TAU_PLAN_SWAP64, 8u, host, wire, noOfItems);
+               host    += noOfItems * 8u;
+               wire    += noOfItems * 8u;
+               break;
+           default:
+               return TRDP_PARAM_ERR;
+        }
+        pInfo->host = host;
+        pInfo->wire = wire;
+    }
+
+    pInfo->level--;
+
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Return the index of a dataset of the context.
+ *
+ *  @param[in]      pCfg            marshalling context
+ *  @param[in]      pDataset        Pointer to the dataset
+ *
+ *  @retval         TAU_INDEX_UNUSED if the dataset is not one of the context
+ *  @retval         index into pDataSets
+ */
+static UINT32 dsIndexOf (
+    const TAU_MARSHALL_CFG_T    *pCfg,
+    TRDP_DATASET_T              *pDataset)
+{
+    TRDP_DATASET_T  * *key3;
+    UINT32          index;
+
+    if (pCfg->dsIdIndex.pEntry != NULL)
+    {
+        index = indexFind(&pCfg->dsIdIndex, pDataset->id);
+    }
+    else
+    {
+        key3 = (TRDP_DATASET_T * *) vos_bsearch(pDataset,
+                                                pCfg->pDataSets,
+                                                pCfg->numEntries,
+                                                sizeof(TRDP_DATASET_T *),
+                                                compareDatasetDeref);
+        index = (key3 != NULL) ? (UINT32) (key3 - pCfg->pDataSets) : TAU_INDEX_UNUSED;
+    }
+    if ((index == TAU_INDEX_UNUSED) || (pCfg->pDataSets[index] != pDataset))
+    {
+        return TAU_INDEX_UNUSED;
+    }
+    return index;
+}
+
+/**********************************************************************************************************************/
+/**    Free a plan.
+ *
+ *  @param[in]      pPlan           Pointer to the plan
+ */
+static void freePlan (
+    TAU_PLAN_T *pPlan)
+{
+    if (pPlan != NULL)
+    {
+        if (pPlan->pRun != NULL)
+        {
+            vos_memFree(pPlan->pRun);
+        }
+        vos_memFree(pPlan);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return the host and wire layout of the items of a basic type, as size_unmarshall() walks them.
+ *
+ *  @param[in]      type            basic type
+ *  @param[out]     pStep           step to fill: alignment, hostSize, wireSize and counterSize
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  unknown type
+ */
+static TRDP_ERR_T sizeOfItems (
+    UINT32          type,
+    TAU_SIZE_STEP_T *pStep)
+{
+    switch (type)
+    {
+       case TRDP_BOOL8:
+       case TRDP_CHAR8:
+       case TRDP_INT8:
+       case TRDP_UINT8:
+           pStep->alignment     = 1u;
+           pStep->hostSize      = 1u;
+           pStep->wireSize      = 1u;
+           pStep->counterSize   = 1u;
+           break;
+       case TRDP_UTF16:
+       case TRDP_INT16:
+       case TRDP_UINT16:
+           pStep->alignment     = ALIGNOF(UINT16);
+           pStep->hostSize      = 2u;
+           pStep->wireSize      = 2u;
+           pStep->counterSize   = 2u;
+           break;
+       case TRDP_INT32:
+       case TRDP_UINT32:
+       case TRDP_REAL32:
+       case TRDP_TIMEDATE32:
+           pStep->alignment     = ALIGNOF(UINT32);
+           pStep->hostSize      = 4u;
+           pStep->wireSize      = 4u;
+           pStep->counterSize   = 4u;
+           break;
+       case TRDP_TIMEDATE48:
+           pStep->alignment     = ALIGNOF(TIMEDATE48_STRUCT_T);
+           pStep->hostSize      = 8u;
+           pStep->wireSize      = 6u;
+           pStep->counterSize   = 0u;
+           break;
+       case TRDP_TIMEDATE64:
+           pStep->alignment     = ALIGNOF(TIMEDATE64_STRUCT_T);
+           pStep->hostSize      = 8u;
+           pStep->wireSize      = 8u;
+           pStep->counterSize   = 0u;
+           break;
+       case TRDP_INT64:
+       case TRDP_UINT64:
+       case TRDP_REAL64:
+           pStep->alignment     = ALIGNOF(UINT64);
+           pStep->hostSize      = 8u;
+           pStep->wireSize      = 8u;
+           pStep->counterSize   = 0u;
+           break;
+       default:
+           return TRDP_PARAM_ERR;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Return the fixed step to append an element to, add one if the last step is not fixed.
+ *
+ *  @param[in,out]  pDesc           Pointer to the descriptor, pStep must have room for another step
+ *
+ *  @retval         pointer to the step
+ */
+static TAU_SIZE_STEP_T *fixedSizeStep (
+    TAU_SIZE_DESC_T *pDesc)
+{
+    TAU_SIZE_STEP_T *pStep;
+    UINT32          r;
+
+    if ((pDesc->numSteps > 0u) && (pDesc->pStep[pDesc->numSteps - 1u].kind == TAU_SIZE_FIXED))
+    {
+        return &pDesc->pStep[pDesc->numSteps - 1u];
+    }
+    pStep = &pDesc->pStep[pDesc->numSteps++];
+    pStep->kind = TAU_SIZE_FIXED;
+    for (r = 0u; r < TAU_SIZE_RESIDUES; r++)
+    {
+        pStep->hostEnd[r] = r;
+    }
+    return pStep;
+}
+
+/**********************************************************************************************************************/
+/**    Free a size descriptor.
+ *
+ *  @param[in]      pDesc           Pointer to the descriptor
+ */
+static void freeSizeDesc (
+    TAU_SIZE_DESC_T *pDesc)
+{
+    if (pDesc != NULL)
+    {
+        if (pDesc->pStep != NULL)
+        {
+            vos_memFree(pDesc->pStep);
+        }
+        vos_memFree(pDesc);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Compile the size descriptor of a dataset, and of its nested datasets first.
+ *  Consecutive elements of fixed size are folded into one step, which holds the host end offset for every start
+ *  offset modulo 8, i.e. the padding size_unmarshall() would insert. Elements of variable size become steps of their
+ *  own, which remember how to find their counter.
+ *
+ *  @param[in,out]  pCfg            marshalling context
+ *  @param[in]      pDataset        Pointer to the dataset
+ *  @param[in]      level           recursion level
+ *
+ *  @retval         NULL if the dataset can not be described (size_unmarshall() is used)
+ *  @retval         pointer to the descriptor, owned by pCfg->pSizes
+ */
+static const TAU_SIZE_DESC_T *compileSizeDesc (
+    TAU_MARSHALL_CFG_T  *pCfg,
+    TRDP_DATASET_T      *pDataset,
+    UINT32              level)
+{
+    TAU_SIZE_DESC_T         *pDesc;
+    TAU_SIZE_STEP_T         *pStep;
+    const TAU_SIZE_DESC_T   *pSub;
+    UINT16                  lIndex;
+    UINT32                  index = dsIndexOf(pCfg, pDataset);
+    UINT32                  r;
+
+    if ((index == TAU_INDEX_UNUSED) || (level > TAU_MAX_DS_LEVEL) || (pDataset->numElement == 0u))
+    {
+        return NULL;
+    }
+    if (pCfg->pSizes[index] != NULL)
+    {
+        return pCfg->pSizes[index];
+    }
+
+    pDesc = (TAU_SIZE_DESC_T *) vos_memAlloc(sizeof(TAU_SIZE_DESC_T));
+    if (pDesc == NULL)
+    {
+        return NULL;
+    }
+    /*  An element needs at most one step  */
+    pDesc->pStep = (TAU_SIZE_STEP_T *) vos_memAlloc(pDataset->numElement * sizeof(TAU_SIZE_STEP_T));
+    if (pDesc->pStep == NULL)
+    {
+        freeSizeDesc(pDesc);
+        return NULL;
+    }
+    pDesc->alignment    = maxSizeOfDSMember(pCfg, pDataset);
+    pDesc->depth        = 1u;
+
+    for (lIndex = 0u; lIndex < pDataset->numElement; ++lIndex)
+    {
+        TRDP_DATASET_ELEMENT_T  *pElement   = &pDataset->pElement[lIndex];
+        UINT32                  noOfItems   = pElement->size;
+
+        if (pElement->type > (UINT32) TRDP_TYPE_MAX)
+        {
+            if (NULL == pElement->pCachedDS)
+            {
+                pElement->pCachedDS = findDs(pCfg, pElement->type);
+            }
+            pSub = (pElement->pCachedDS != NULL) ? compileSizeDesc(pCfg, pElement->pCachedDS, level + 1u) : NULL;
+            if ((pSub == NULL) || (pSub->depth + 1u > TAU_MAX_DS_LEVEL))
+            {
+                freeSizeDesc(pDesc);
+                return NULL;
+            }
+            if (pDesc->depth < pSub->depth + 1u)
+            {
+                pDesc->depth = pSub->depth + 1u;
+            }
+
+            if ((noOfItems != TRDP_VAR_SIZE) && (pSub->numSteps == 1u) && (pSub->pStep[0].kind == TAU_SIZE_FIXED))
+            {
+                /*  Nested datasets of fixed size: each one is aligned, then adds its own fixed step    */
+                pStep = fixedSizeStep(pDesc);
+                for (r = 0u; r < TAU_SIZE_RESIDUES; r++)
+                {
+                    UINT32  host = pStep->hostEnd[r];
+                    UINT32  i;
+
+                    for (i = 0u; i < noOfItems; i++)
+                    {
+                        host = (host + pSub->alignment - 1u) & ~(pSub->alignment - 1u);
+                        host = (host & ~(TAU_SIZE_RESIDUES - 1u)) + pSub->pStep[0].hostEnd[host & (TAU_SIZE_RESIDUES - 1u)];
+                    }
+                    pStep->hostEnd[r] = host;
+                }
+                pStep->wireSize += noOfItems * pSub->pStep[0].wireSize;
+            }
+            else
+            {
+                /*  Nested datasets don't change the counter of this level  */
+                pStep = &pDesc->pStep[pDesc->numSteps++];
+                pStep->kind         = TAU_SIZE_NESTED;
+                pStep->noOfItems    = noOfItems;
+                pStep->counterSize  = 0u;
+                pStep->pNested      = pSub;
+            }
+        }
+        else if (noOfItems == TRDP_VAR_SIZE)
+        {
+            pStep = &pDesc->pStep[pDesc->numSteps++];
+            pStep->kind             = TAU_SIZE_ITEMS;
+            pStep->counterOffset    = 0u;
+            if (sizeOfItems(pElement->type, pStep) != TRDP_NO_ERR)
+            {
+                freeSizeDesc(pDesc);
+                return NULL;
+            }
+        }
+        else
+        {
+            TAU_SIZE_STEP_T items;
+
+            if (sizeOfItems(pElement->type, &items) != TRDP_NO_ERR)
+            {
+                freeSizeDesc(pDesc);
+                return NULL;
+            }
+            pStep = fixedSizeStep(pDesc);
+            if (items.counterSize != 0u)
+            {
+                pStep->counterOffset    = pStep->wireSize;
+                pStep->counterSize      = items.counterSize;
+            }
+            for (r = 0u; r < TAU_SIZE_RESIDUES; r++)
+            {
+                pStep->hostEnd[r] = ((pStep->hostEnd[r] + items.alignment - 1u) & ~(items.alignment - 1u)) +
+                    noOfItems * items.hostSize;
+            }
+            pStep->wireSize += noOfItems * items.wireSize;
+        }
+    }
+
+    pCfg->pSizes[index] = pDesc;
+    return pDesc;
+}
+
+/**********************************************************************************************************************/
+/**    Read the counter of a variable sized element from the wire buffer.
+ *
+ *  @param[in]      pSrc            Pointer to the wire buffer
+ *  @param[in]      srcSize         size of the wire buffer
+ *  @param[in]      offset          wire offset of the counter
+ *  @param[in]      size            size of the counter, 0: no counter on this level so far
+ *  @param[out]     pValue          counter value
+ *
+ *  @retval         FALSE if the counter is beyond the buffer
+ */
+static BOOL8 readSizeCounter (
+    const UINT8 *pSrc,
+    UINT32      srcSize,
+    UINT32      offset,
+    UINT32      size,
+    UINT32      *pValue)
+{
+    UINT32 value = 0u;
+
+    if (offset + size > srcSize)
+    {
+        return FALSE;
+    }
+    pSrc += offset;
+    while (size-- > 0u)
+    {
+        value = (value << 8u) | *pSrc++;
+    }
+    *pValue = value;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Compute the host size of a dataset by its size descriptor.
+ *  The result equals size_unmarshall() for complete data; the walk stops at the end of the source buffer like
+ *  size_unmarshall() does. If any element would cross the end of the buffer, the interpreter has to decide.
+ *
+ *  @param[in]      pDesc           Pointer to the descriptor
+ *  @param[in]      pSrc            Pointer to the wire buffer
+ *  @param[in]      srcSize         size of the wire buffer
+ *  @param[in,out]  pWire           wire offset
+ *  @param[in,out]  pHost           host offset
+ *
+ *  @retval         FALSE if size_unmarshall() must be used
+ */
+static BOOL8 sizeByDesc (
+    const TAU_SIZE_DESC_T   *pDesc,
+    const UINT8             *pSrc,
+    UINT32                  srcSize,
+    UINT32                  *pWire,
+    UINT32                  *pHost)
+{
+    const TAU_SIZE_STEP_T   *pStep;
+    UINT32                  wire        = *pWire;
+    UINT32                  host        = *pHost;
+    UINT32                  counter     = 0u;
+    UINT32                  counterSize = 0u;
+    UINT32                  noOfItems;
+    UINT32                  i;
+
+    if (wire >= srcSize)
+    {
+        return TRUE;
+    }
+    host = (host + pDesc->alignment - 1u) & ~(pDesc->alignment - 1u);
+
+    for (i = 0u; (i < pDesc->numSteps) && (wire < srcSize); i++)
+    {
+        pStep = &pDesc->pStep[i];
+        switch (pStep->kind)
+        {
+           case TAU_SIZE_FIXED:
+               if (pStep->wireSize > srcSize - wire)
+               {
+                   return FALSE;
+               }
+               if (pStep->counterSize != 0u)
+               {
+                   counter     = wire + pStep->counterOffset;
+                   counterSize = pStep->counterSize;
+               }
+               host = (host & ~(TAU_SIZE_RESIDUES - 1u)) + pStep->hostEnd[host & (TAU_SIZE_RESIDUES - 1u)];
+               wire += pStep->wireSize;
+               break;
+           case TAU_SIZE_ITEMS:
+               if ((readSizeCounter(pSrc, srcSize, counter, counterSize, &noOfItems) == FALSE) ||
+                   (noOfItems > (srcSize - wire) / pStep->wireSize))
+               {
+                   return FALSE;
+               }
+               /*  size_unmarshall() aligns 8, 16 and 32 bit types (the possible counters) even for no items  */
+               if (pStep->counterSize != 0u)
+               {
+                   counter     = wire;
+                   counterSize = pStep->counterSize;
+                   host        = (host + pStep->alignment - 1u) & ~(pStep->alignment - 1u);
+               }
+               else if (noOfItems > 0u)
+               {
+                   host = (host + pStep->alignment - 1u) & ~(pStep->alignment - 1u);
+               }
+               host += noOfItems * pStep->hostSize;
+               wire += noOfItems * pStep->wireSize;
+               break;
+           default:
+               noOfItems = pStep->noOfItems;
+               if ((noOfItems == TRDP_VAR_SIZE) &&
+                   (readSizeCounter(pSrc, srcSize, counter, counterSize, &noOfItems) == FALSE))
+               {
+                   return FALSE;
+               }
+               while ((noOfItems-- > 0u) && (wire < srcSize))
+               {
+                   if (sizeByDesc(pStep->pNested, pSrc, srcSize, &wire, &host) == FALSE)
+                   {
+                       return FALSE;
+                   }
+               }
+               break;
+        }
+    }
+    *pWire  = wire;
+    *pHost  = host;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Compute the host size of a dataset by its size descriptor, if there is one.
+ *
+ *  @param[in]      pCfg            marshalling context
+ *  @param[in]      pDataset        Pointer to the dataset
+ *  @param[in]      pSrc            Pointer to the wire buffer
+ *  @param[in]      srcSize         size of the wire buffer
+ *  @param[out]     pDestSize       host size
+ *
+ *  @retval         FALSE if size_unmarshall() must be used
+ */
+static BOOL8 sizeByCfg (
+    const TAU_MARSHALL_CFG_T    *pCfg,
+    TRDP_DATASET_T              *pDataset,
+    const UINT8                 *pSrc,
+    UINT32                      srcSize,
+    UINT32                      *pDestSize)
+{
+    UINT32  index;
+    UINT32  wire = 0u;
+    UINT32  host = 0u;
+
+    if ((pCfg == NULL) || (pCfg->pSizes == NULL))
+    {
+        return FALSE;
+    }
+    index = dsIndexOf(pCfg, pDataset);
+    if ((index == TAU_INDEX_UNUSED) || (pCfg->pSizes[index] == NULL) ||
+        (sizeByDesc(pCfg->pSizes[index], pSrc, srcSize, &wire, &host) == FALSE))
+    {
+        return FALSE;
+    }
+    *pDestSize = host;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Compile the plan and the size descriptor of one dataset of a context.
+ *  Datasets which can not be compiled get no plan and are interpreted by marshallDs()/unmarshallDs().
+ *
+ *  @param[in,out]  pCfg            marshalling context with allocated plan tables
+ *  @param[in]      index           index into pDataSets
+ */
+static void compilePlan (
+    TAU_MARSHALL_CFG_T  *pCfg,
+    UINT32              index)
+{
+    TAU_PLAN_INFO_T info;
+
+    if ((pCfg->pPlans != NULL) && (pCfg->pPlans[index] == NULL))
+    {
+        info.level  = 0;
+        info.host   = 0u;
+        info.wire   = 0u;
+        info.pCfg   = pCfg;
+        info.pPlan  = (TAU_PLAN_T *) vos_memAlloc(sizeof(TAU_PLAN_T));
+        if (info.pPlan != NULL)
+        {
+            info.pPlan->alignment = 1u;
+
+            if ((compileDs(&info, pCfg->pDataSets[index]) == TRDP_NO_ERR) && (info.pPlan->numRuns > 0u))
+            {
+                info.pPlan->hostSize    = info.host;
+                info.pPlan->wireSize    = info.wire;
+                pCfg->pPlans[index]     = info.pPlan;
+            }
+            else
+            {
+                freePlan(info.pPlan);
+            }
+        }
+    }
+    if (pCfg->pSizes != NULL)
+    {
+        (void) compileSizeDesc(pCfg, pCfg->pDataSets[index], 1u);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Compile the plans of all loaded datasets of a context.
+ *  The plans of datasets not loaded yet are compiled by loadDs() on first use.
+ *
+ *  @param[in,out]  pCfg            marshalling context
+ */
+static void compileAllPlans (
+    TAU_MARSHALL_CFG_T *pCfg)
+{
+    UINT32 i;
+
+    pCfg->pPlans = (TAU_PLAN_T * *) vos_memAlloc(pCfg->numEntries * sizeof(TAU_PLAN_T *));
+    if (pCfg->pPlans != NULL)
+    {
+        pCfg->numPlans = pCfg->numEntries;
+    }
+    pCfg->pSizes = (TAU_SIZE_DESC_T * *) vos_memAlloc(pCfg->numEntries * sizeof(TAU_SIZE_DESC_T *));
+    if (pCfg->pSizes != NULL)
+    {
+        pCfg->numSizes = pCfg->numEntries;
+    }
+
+    for (i = 0u; i < pCfg->numEntries; i++)
+    {
+        if ((pCfg->pLoaded == NULL) || (pCfg->pLoaded[i] == TRUE))
+        {
+            compilePlan(pCfg, i);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Free the plans of all datasets of a context.
+ *
+ *  @param[in,out]  pCfg            marshalling context
+ */
+static void freeAllPlans (
+    TAU_MARSHALL_CFG_T *pCfg)
+{
+    UINT32 i;
+
+    if (pCfg->pPlans != NULL)
+    {
+        for (i = 0u; i < pCfg->numPlans; i++)
+        {
+            freePlan(pCfg->pPlans[i]);
+        }
+        vos_memFree(pCfg->pPlans);
+        pCfg->pPlans      = NULL;
+        pCfg->numPlans   = 0u;
+    }
+    if (pCfg->pSizes != NULL)
+    {
+        for (i = 0u; i < pCfg->numSizes; i++)
+        {
+            freeSizeDesc(pCfg->pSizes[i]);
+        }
+        vos_memFree(pCfg->pSizes);
+        pCfg->pSizes    = NULL;
+        pCfg->numSizes  = 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return the plan of a dataset, if it can be used for the buffers supplied.
+ *  The plan is not used if the buffers are too small or the host structure is not aligned; in this case the
+ *  interpreter decides about partial results and errors.
+ *
+ *  @param[in]      pCfg            marshalling context
+ *  @param[in]      pDataset        Pointer to the dataset
+ *  @param[in]      pHost           Pointer to the host structure
+ *  @param[in]      hostSize        size of the host buffer
+ *  @param[in]      wireSize        size of the wire buffer
+ *
+ *  @retval         NULL if no plan can be used
+ *  @retval         pointer to plan
+ */
+static const TAU_PLAN_T *findPlan (
+    const TAU_MARSHALL_CFG_T    *pCfg,
+    TRDP_DATASET_T              *pDataset,
+    const UINT8                 *pHost,
+    UINT32                      hostSize,
+    UINT32                      wireSize)
+{
+    TAU_PLAN_T  *pPlan;
+    UINT32      index;
+
+    if ((pCfg == NULL) || (pCfg->pPlans == NULL))
+    {
+        return NULL;
+    }
+    index = dsIndexOf(pCfg, pDataset);
+    if (index == TAU_INDEX_UNUSED)
+    {
+        return NULL;
+    }
+    pPlan = pCfg->pPlans[index];
+    if ((pPlan == NULL) ||
+        (hostSize < pPlan->hostSize) ||
+        (wireSize < pPlan->wireSize) ||
+        (((uintptr_t) pHost & (pPlan->alignment - 1u)) != 0u))
+    {
+        return NULL;
+    }
+    return pPlan;
+}
+
+/**********************************************************************************************************************/
+/**    Marshall a dataset by its plan.
+ *
+ *  @param[in]      pPlan           Pointer to the plan
+ *  @param[in]      pSrc            Pointer to the host structure
+ *  @param[out]     pDst            Pointer to the wire buffer
+ */
+static void marshallPlan (
+    const TAU_PLAN_T    *pPlan,
+    UINT8               *pSrc,
+    UINT8               *pDst)
+{
+    const TAU_PLAN_RUN_T    *pRun   = pPlan->pRun;
+    const TAU_PLAN_RUN_T    *pEnd   = pRun + pPlan->numRuns;
+
+    if (pPlan->pCodec != NULL)
+    {
+        pPlan->pCodec->pfMarshall(pSrc, pDst);
+        return;
+    }
+
+    for (; pRun < pEnd; pRun++)
+    {
+        UINT8   *pSrc8      = pSrc + pRun->hostOffset;
+        UINT8   *pDst8      = pDst + pRun->wireOffset;
+        UINT32  noOfItems   = pRun->noOfItems;
+
+        switch (pRun->op)
+        {
+           case TAU_PLAN_COPY:
+               memcpy(pDst8, pSrc8, noOfItems);
+               break;
+           case TAU_PLAN_SWAP16:
+           {
+               UINT16 *pSrc16 = (UINT16 *) (void *) pSrc8;
+               if (swapItems(pDst8, pSrc8, noOfItems, 2u) == TRUE)
+               {
+                   break;
+               }
+               while (noOfItems-- > 0u)
+               {
+                   *pDst8++ = (UINT8) (*pSrc16 >> 8u);
+                   *pDst8++ = (UINT8) (*pSrc16 & 0xFFu);
+                   pSrc16++;
+               }
+               break;
+           }
+           case TAU_PLAN_SWAP32:
+           {
+               UINT32 *pSrc32 = (UINT32 *) (void *) pSrc8;
+               if (swapItems(pDst8, pSrc8, noOfItems, 4u) == TRUE)
+               {
+                   break;
+               }
+               while (noOfItems-- > 0u)
+               {
+                   *pDst8++ = (UINT8) (*pSrc32 >> 24u);
+                   *pDst8++ = (UINT8) (*pSrc32 >> 16u);
+                   *pDst8++ = (UINT8) (*pSrc32 >> 8u);
+                   *pDst8++ = (UINT8) (*pSrc32 & 0xFFu);
+                   pSrc32++;
+               }
+               break;
+           }
+           default:
+               packedCopy64(&pSrc8, &pDst8, noOfItems);
+               break;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Unmarshall a dataset by its plan.
+ *
+ *  @param[in]      pPlan           Pointer to the plan
+ *  @param[in]      pSrc            Pointer to the wire buffer
+ *  @param[out]     pDst            Pointer to the host structure
+ */
+static void unmarshallPlan (
+    const TAU_PLAN_T    *pPlan,
+    UINT8               *pSrc,
+    UINT8               *pDst)
+{
+    const TAU_PLAN_RUN_T    *pRun   = pPlan->pRun;
+    const TAU_PLAN_RUN_T    *pEnd   = pRun + pPlan->numRuns;
+
+    if (pPlan->pCodec != NULL)
+    {
+        pPlan->pCodec->pfUnmarshall(pSrc, pDst);
+        return;
+    }
+
+    for (; pRun < pEnd; pRun++)
+    {
+        UINT8   *pSrc8      = pSrc + pRun->wireOffset;
+        UINT8   *pDst8      = pDst + pRun->hostOffset;
+        UINT32  noOfItems   = pRun->noOfItems;
+
+        switch (pRun->op)
+        {
+           case TAU_PLAN_COPY:
+               memcpy(pDst8, pSrc8, noOfItems);
+               break;
+           case TAU_PLAN_SWAP16:
+           {
+               UINT16 *pDst16 = (UINT16 *) (void *) pDst8;
+               if (swapItems(pDst8, pSrc8, noOfItems, 2u) == TRUE)
+               {
+                   break;
+               }
+               while (noOfItems-- > 0u)
+               {
+                   *pDst16  = (UINT16) (*pSrc8++ << 8u);
+                   *pDst16  += *pSrc8++;
+                   pDst16++;
+               }
+               break;
+           }
+           case TAU_PLAN_SWAP32:
+           {
+               UINT32 *pDst32 = (UINT32 *) (void *) pDst8;
+               if (swapItems(pDst8, pSrc8, noOfItems, 4u) == TRUE)
+               {
+                   break;
+               }
+               while (noOfItems-- > 0u)
+               {
+                   *pDst32  = ((UINT32)(*pSrc8++)) << 24u;
+                   *pDst32  += ((UINT32)(*pSrc8++)) << 16u;
+                   *pDst32  += ((UINT32)(*pSrc8++)) << 8u;
+                   *pDst32  += *pSrc8++;
+                   pDst32++;
+               }
+               break;
+           }
+           default:
+               unpackedCopy64(&pSrc8, &pDst8, noOfItems);
+               break;
+        }
+    }
+}
+#endif
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Return the marshalling context of a reference context.
+ *  Reference contexts not created by tau_initMarshall() (e.g. NULL) select the most recently initialised context.
+ *
+ *  @param[in]      pRefCon         reference context returned by tau_initMarshall()
+ *
+ *  @retval         NULL if marshalling is not initialised
+ *  @retval         pointer to the context
+ */
+static const TAU_MARSHALL_CFG_T *findCfg (
+    const void *pRefCon)
+{
+    const TAU_MARSHALL_CFG_T *pCfg;
+
+    for (pCfg = sCfgList; pCfg != NULL; pCfg = pCfg->pNext)
+    {
+        if (pCfg == (const TAU_MARSHALL_CFG_T *) pRefCon)
+        {
+            return pCfg;
+        }
+    }
+    return sCfgList;
+}
+
+/**********************************************************************************************************************/
+/**    Resolve the nested datasets of all datasets of a context.
+ *  With the cache filled in advance, marshalling never writes to the dataset tables.
+ *
+ *  @param[in]      pCfg            marshalling context
+ */
+static void resolveNestedDs (
+    const TAU_MARSHALL_CFG_T *pCfg)
+{
+    UINT32 i, j;
+
+    for (i = 0u; i < pCfg->numEntries; i++)
+    {
+        if ((pCfg->pLoaded != NULL) && (pCfg->pLoaded[i] == FALSE))
+        {
+            continue;
+        }
+        for (j = 0u; j < pCfg->pDataSets[i]->numElement; j++)
+        {
+            TRDP_DATA_TYPE_T type = (TRDP_DATA_TYPE_T) pCfg->pDataSets[i]->pElement[j].type;
+
+            pCfg->pDataSets[i]->pElement[j].pCachedDS =
+                (type > TRDP_TYPE_MAX) ? findDs(pCfg, pCfg->pDataSets[i]->pElement[j].type) : NULL;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return a dataset of a context, loading it first if only its stub is known.
+ *  The loaded dataset replaces the stub, its nested datasets are resolved and its plan is compiled. A context with
+ *  a loader therefore writes its tables on first use of a dataset and must not be shared between threads.
+ *
+ *  @param[in]      pCfg            marshalling context
+ *  @param[in]      index           index into pDataSets
+ *
+ *  @retval         NULL if the dataset could not be loaded
+ *  @retval         pointer to dataset
+ */
+static TRDP_DATASET_T *loadDs (
+    const TAU_MARSHALL_CFG_T    *pCfg,
+    UINT32                      index)
+{
+    TAU_MARSHALL_CFG_T  *pLazy = (TAU_MARSHALL_CFG_T *) pCfg;
+    TRDP_DATASET_T      *pStub = pCfg->pDataSets[index];
+    TRDP_DATASET_T      *pDataset = NULL;
+    UINT16              j;
+
+    if ((pCfg->pLoaded == NULL) || (pCfg->pLoaded[index] == TRUE))
+    {
+        return pStub;
+    }
+    if ((pCfg->pfLoad(pCfg->pLoadRef, pStub->id, &pDataset) != TRDP_NO_ERR) || (pDataset == NULL) ||
+        (pDataset->id != pStub->id))
+    {
+        vos_printLog(VOS_LOG_ERROR, "Loading dataset %u failed\n", pStub->id);
+        if (pDataset != NULL)
+        {
+            vos_memFree(pDataset);
+        }
+        return NULL;
+    }
+    vos_memFree(pStub);
+    pLazy->pDataSets[index] = pDataset;
+
+    /* mark it before resolving, a dataset may contain itself */
+    pLazy->pLoaded[index] = TRUE;
+    for (j = 0u; j < pDataset->numElement; j++)
+    {
+        pDataset->pElement[j].pCachedDS =
+            (pDataset->pElement[j].type > (UINT32) TRDP_TYPE_MAX) ? findDs(pCfg, pDataset->pElement[j].type) : NULL;
+    }
+#if TAU_MARSHALL_PLAN
+    compilePlan(pLazy, index);
+#endif
+    return pDataset;
+}
+
+/**********************************************************************************************************************/
+/**    Create or replace the context of a set of tables.
+ *
+ *  @param[in,out]  ppRefCon         Returns the reference context
+ *  @param[in]      numComId         Number of comIds
+ *  @param[in]      pComIdDsIdMap    comId to dataset id map
+ *  @param[in]      numDataSet       Number of datasets
+ *  @param[in]      pDataset         Pointer to an array of pointers to datasets
+ *  @param[in]      pfLoad           loader of datasets given as stubs, NULL if all are complete
+ *  @param[in]      pLoadRef         reference passed to pfLoad
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     out of memory
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ */
+static TRDP_ERR_T initMarshall (
+    void                    * *ppRefCon,
+    UINT32                  numComId,
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
+    UINT32                  numDataSet,
+    TRDP_DATASET_T          *pDataset[],
+    TAU_DS_LOAD_T           pfLoad,
+    void                    *pLoadRef)
+{
+    TAU_MARSHALL_CFG_T  *pCfg;
+    UINT32              i;
+
+    if ((pDataset == NULL) || (numDataSet == 0u) || (numComId == 0u) || (pComIdDsIdMap == 0u))
     {
         return TRDP_PARAM_ERR;
     }
 
+    /*    Tables initialised again replace their context, new tables get a new one    */
+    for (pCfg = sCfgList; pCfg != NULL; pCfg = pCfg->pNext)
+    {
+        if ((pCfg->pComIdDsIdMap == pComIdDsIdMap) && (pCfg->pDataSets == pDataset))
+        {
+            break;
+        }
+    }
+    if (pCfg == NULL)
+    {
+        pCfg = (TAU_MARSHALL_CFG_T *) vos_memAlloc(sizeof(TAU_MARSHALL_CFG_T));
+        if (pCfg == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        pCfg->pNext = sCfgList;
+        sCfgList    = pCfg;
+    }
+
     /*    Save the pointer to the comId mapping table    */
-    sComIdDsIdMap   = pComIdDsIdMap;
-    sNumComId       = numComId;
+    pCfg->pComIdDsIdMap = pComIdDsIdMap;
+    pCfg->numComId      = numComId;
 
     /* sort the table    */
     vos_qsort(pComIdDsIdMap, numComId, sizeof(TRDP_COMID_DSID_MAP_T), compareComId);
 
     /*    Save the pointer to the table    */
-    sDataSets   = pDataset;
-    sNumEntries = numDataSet;
+    pCfg->pDataSets     = pDataset;
+    pCfg->numEntries    = numDataSet;
 
-    /* invalidate the cache */
-    for (i = 0u; i < numDataSet; i++)
+    /* sort the table    */
+    vos_qsort(pDataset, numDataSet, sizeof(TRDP_DATASET_T *), compareDataset);
+
+    /* datasets without elements are stubs, loaded on first use */
+    if (pCfg->pLoaded != NULL)
+    {
+        vos_memFree(pCfg->pLoaded);
+        pCfg->pLoaded = NULL;
+    }
+    pCfg->pfLoad    = pfLoad;
+    pCfg->pLoadRef  = pLoadRef;
+    if (pfLoad != NULL)
     {
-        for (j = 0u; j < pDataset[i]->numElement; j++)
+        pCfg->pLoaded = (BOOL8 *) vos_memAlloc(numDataSet * sizeof(BOOL8));
+        if (pCfg->pLoaded == NULL)
+        {
+            pCfg->pfLoad = NULL;
+            return TRDP_MEM_ERR;
+        }
+        for (i = 0u; i < numDataSet; i++)
         {
-            pDataset[i]->pElement[j].pCachedDS = NULL;
+            pCfg->pLoaded[i] = (pDataset[i]->numElement != 0u) ? TRUE : FALSE;
         }
     }
-    /* sort the table    */
-    vos_qsort(pDataset, numDataSet, sizeof(TRDP_DATASET_T *), compareDataset);
 
+    /* direct lookup of comIds and dataset ids */
+    buildIndices(pCfg);
+
+    /* fill the cache of nested datasets */
+    resolveNestedDs(pCfg);
+
+#if TAU_MARSHALL_PLAN
+    /* precompile the datasets */
+    freeAllPlans(pCfg);
+    compileAllPlans(pCfg);
+#endif
+
+#if TAU_SIMD
+    selectSwapKernel();
+#endif
+
+    if (ppRefCon != NULL)
+    {
+        *ppRefCon = pCfg;
+    }
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/**    Function to initialise the marshalling/unmarshalling.
+ *    The supplied array must be sorted by ComIds. The array must exist during the use of the marshalling
+ *    functions (until tlc_terminate()).
+ *
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     provided buffer to small
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_initMarshall (
+    void                    * *ppRefCon,
+    UINT32                  numComId,
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
+    UINT32                  numDataSet,
+    TRDP_DATASET_T          *pDataset[])
+{
+    return initMarshall(ppRefCon, numComId, pComIdDsIdMap, numDataSet, pDataset, NULL, NULL);
+}
+
+/**********************************************************************************************************************/
+/**    Function to initialise the marshalling/unmarshalling with datasets loaded on first use.
+ *    Datasets without elements are stubs holding only their id. The first lookup of such a dataset by a marshalling
+ *    function calls pfLoad, the returned dataset replaces the stub (which is freed with vos_memFree()) and its plan is
+ *    compiled then. As the tables are written on first use, the context must not be shared between threads.
+ *
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to complete datasets or stubs
+ *  @param[in]      pfLoad           Function loading a dataset by its id, e.g. tau_loadXmlDataset()
+ *  @param[in]      pLoadRef         Reference passed to pfLoad
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     out of memory
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_initMarshallLazy (
+    void                    * *ppRefCon,
+    UINT32                  numComId,
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
+    UINT32                  numDataSet,
+    TRDP_DATASET_T          *pDataset[],
+    TAU_DS_LOAD_T           pfLoad,
+    void                    *pLoadRef)
+{
+    if (pfLoad == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    return initMarshall(ppRefCon, numComId, pComIdDsIdMap, numDataSet, pDataset, pfLoad, pLoadRef);
+}
+
+/**********************************************************************************************************************/
+/**    Release a marshalling context.
+ *  The tables passed to tau_initMarshall() are not freed.
+ *
+ *  @param[in]      pRefCon          reference context returned by tau_initMarshall()
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_PARAM_ERR   unknown reference context
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_deInitMarshall (
+    void *pRefCon)
+{
+    TAU_MARSHALL_CFG_T * *ppIter;
+
+    for (ppIter = &sCfgList; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        if (*ppIter == (TAU_MARSHALL_CFG_T *) pRefCon)
+        {
+            TAU_MARSHALL_CFG_T *pCfg = *ppIter;
+
+            *ppIter = pCfg->pNext;
+            indexFree(&pCfg->comIdIndex);
+            indexFree(&pCfg->dsIdIndex);
+#if TAU_MARSHALL_PLAN
+            freeAllPlans(pCfg);
+#endif
+            if (pCfg->pLoaded != NULL)
+            {
+                vos_memFree(pCfg->pLoaded);
+            }
+            vos_memFree(pCfg);
+            return TRDP_NO_ERR;
+        }
+    }
+    return TRDP_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Register generated marshalling functions with a marshalling context.
+ *  The functions are attached to the plans of their datasets, an entry is only accepted if the sizes match the plan.
+ *
+ *  @param[in]      pRefCon          reference context returned by tau_initMarshall()
+ *  @param[in]      numCodecs        number of entries in pCodecs
+ *  @param[in]      pCodecs          table of generated functions
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_INIT_ERR    marshalling not initialised or built without TAU_MARSHALL_PLAN
+ *  @retval         TRDP_PARAM_ERR   at least one entry does not match its dataset and was not registered
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_registerCodecs (
+    void                    *pRefCon,
+    UINT32                  numCodecs,
+    const TAU_DS_CODEC_T    *pCodecs)
+{
+#if TAU_MARSHALL_PLAN
+    const TAU_MARSHALL_CFG_T    *pCfg = findCfg(pRefCon);
+    TRDP_DATASET_T              *pDataset;
+    TAU_PLAN_T                  *pPlan;
+    TRDP_ERR_T                  err = TRDP_NO_ERR;
+    UINT32                      i;
+    UINT32                      index;
+
+    if ((pCodecs == NULL) && (numCodecs > 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if ((pCfg == NULL) || (pCfg->pPlans == NULL))
+    {
+        return TRDP_INIT_ERR;
+    }
+
+    for (i = 0u; i < numCodecs; i++)
+    {
+        pDataset    = findDs(pCfg, pCodecs[i].datasetId);
+        index       = (pDataset != NULL) ? dsIndexOf(pCfg, pDataset) : TAU_INDEX_UNUSED;
+        pPlan       = (index != TAU_INDEX_UNUSED) ? pCfg->pPlans[index] : NULL;
+
+        if ((pPlan == NULL) ||
+            (pPlan->hostSize != pCodecs[i].hostSize) ||
+            (pPlan->wireSize != pCodecs[i].wireSize) ||
+            (pCodecs[i].pfMarshall == NULL) ||
+            (pCodecs[i].pfUnmarshall == NULL))
+        {
+            vos_printLog(VOS_LOG_WARNING, "Generated functions of dataset %u do not match its definition\n",
+                         pCodecs[i].datasetId);
+            err = TRDP_PARAM_ERR;
+            continue;
+        }
+        if (pPlan->alignment < pCodecs[i].alignment)
+        {
+            pPlan->alignment = pCodecs[i].alignment;
+        }
+        pPlan->pCodec = &pCodecs[i];
+    }
+    return err;
+#else
+    (void) pRefCon;
+    (void) numCodecs;
+    (void) pCodecs;
+    return TRDP_INIT_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/**    Convert an array of 16, 32 or 64 bit items between host and network byte order.
+ *
+ *  @param[out]     pDst             destination, may equal pSrc
+ *  @param[in]      pSrc             source
+ *  @param[in]      noOfItems        number of items
+ *  @param[in]      itemSize         2, 4 or 8
+ *
+ */
+
+EXT_DECL void tau_swapItems (
+    UINT8       *pDst,
+    const UINT8 *pSrc,
+    UINT32      noOfItems,
+    UINT32      itemSize)
+{
+#ifdef B_ENDIAN
+    if (pDst != pSrc)
+    {
+        memmove(pDst, pSrc, noOfItems * itemSize);
+    }
+#else
+    UINT8   item[8];
+    UINT32  i;
+
+    if ((pDst == NULL) || (pSrc == NULL) || (itemSize > 8u))
+    {
+        return;
+    }
+    if ((pDst != pSrc) && (swapItems(pDst, pSrc, noOfItems, itemSize) == TRUE))
+    {
+        return;
+    }
+    for (; noOfItems > 0u; noOfItems--)
+    {
+        for (i = 0u; i < itemSize; i++)
+        {
+            item[i] = pSrc[itemSize - 1u - i];
+        }
+        memcpy(pDst, item, itemSize);
+        pDst    += itemSize;
+        pSrc    += itemSize;
+    }
+#endif
+}
+
+/**********************************************************************************************************************/
+/**    Return the dataset of a comId.
+ *  The result can be kept by the caller and passed as cached dataset to the marshalling functions.
+ *
+ *  @param[in]      pRefCon         pointer to user context
+ *  @param[in]      comId           ComId to identify the structure out of a configuration
+ *  @param[out]     ppDataset       pointer to return the dataset
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_INIT_ERR   marshalling not initialised
+ *  @retval         TRDP_COMID_ERR  comid not existing
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_lookupDataset (
+    void            *pRefCon,
+    UINT32          comId,
+    TRDP_DATASET_T  * *ppDataset)
+{
+    const TAU_MARSHALL_CFG_T *pCfg = findCfg(pRefCon);
+
+    if (NULL == ppDataset)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (NULL == pCfg)
+    {
+        return TRDP_INIT_ERR;
+    }
+
+    *ppDataset = findDSFromComId(pCfg, comId);
+
+    return (NULL == *ppDataset) ? TRDP_COMID_ERR : TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /**    marshall function.
  *
@@ -1128,8 +3091,12 @@ EXT_DECL TRDP_ERR_T tau_marshall (
     TRDP_ERR_T          err;
     TRDP_DATASET_T      *pDataset;
     TAU_MARSHALL_INFO_T info;
+    const TAU_MARSHALL_CFG_T *pCfg;
+#if TAU_MARSHALL_PLAN
+    const TAU_PLAN_T    *pPlan;
+#endif
 
-    pRefCon = pRefCon;
+    pCfg = findCfg(pRefCon);
 
     if ((0u == comId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
@@ -1141,13 +3108,13 @@ EXT_DECL TRDP_ERR_T tau_marshall (
     {
         if (NULL == *ppDSPointer)
         {
-            *ppDSPointer = findDSFromComId(comId);
+            *ppDSPointer = findDSFromComId(pCfg, comId);
         }
         pDataset = *ppDSPointer;
     }
     else
     {
-        pDataset = findDSFromComId(comId);
+        pDataset = findDSFromComId(pCfg, comId);
     }
 
     if (NULL == pDataset)   /* Not in our DB    */
@@ -1156,7 +3123,21 @@ EXT_DECL TRDP_ERR_T tau_marshall (
         return TRDP_COMID_ERR;
     }
 
+    TRDP_TRACE2(marshall, comId, srcSize);
+
+#if TAU_MARSHALL_PLAN
+    pPlan = findPlan(pCfg, pDataset, pSrc, srcSize, *pDestSize);
+    if (NULL != pPlan)
+    {
+        marshallPlan(pPlan, pSrc, pDest);
+        *pDestSize = pPlan->wireSize;
+        TRDP_TRACE3(marshall_done, comId, *pDestSize, TRDP_NO_ERR);
+        return TRDP_NO_ERR;
+    }
+#endif
+
     info.level      = 0u;
+    info.pCfg       = pCfg;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pDest;
@@ -1166,6 +3147,7 @@ EXT_DECL TRDP_ERR_T tau_marshall (
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
+    TRDP_TRACE3(marshall_done, comId, *pDestSize, err);
     return err;
 }
 
@@ -1203,8 +3185,12 @@ EXT_DECL TRDP_ERR_T tau_unmarshall (
     TRDP_ERR_T          err;
     TRDP_DATASET_T      *pDataset;
     TAU_MARSHALL_INFO_T info;
+    const TAU_MARSHALL_CFG_T *pCfg;
+#if TAU_MARSHALL_PLAN
+    const TAU_PLAN_T    *pPlan;
+#endif
 
-    pRefCon = pRefCon;
+    pCfg = findCfg(pRefCon);
 
     if ((0u == comId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
@@ -1216,13 +3202,13 @@ EXT_DECL TRDP_ERR_T tau_unmarshall (
     {
         if (NULL == *ppDSPointer)
         {
-            *ppDSPointer = findDSFromComId(comId);
+            *ppDSPointer = findDSFromComId(pCfg, comId);
         }
         pDataset = *ppDSPointer;
     }
     else
     {
-        pDataset = findDSFromComId(comId);
+        pDataset = findDSFromComId(pCfg, comId);
     }
 
     if (NULL == pDataset)   /* Not in our DB    */
@@ -1231,7 +3217,21 @@ EXT_DECL TRDP_ERR_T tau_unmarshall (
         return TRDP_COMID_ERR;
     }
 
+    TRDP_TRACE2(unmarshall, comId, srcSize);
+
+#if TAU_MARSHALL_PLAN
+    pPlan = findPlan(pCfg, pDataset, pDest, *pDestSize, srcSize);
+    if (NULL != pPlan)
+    {
+        unmarshallPlan(pPlan, pSrc, pDest);
+        *pDestSize = pPlan->hostSize;
+        TRDP_TRACE3(unmarshall_done, comId, *pDestSize, TRDP_NO_ERR);
+        return TRDP_NO_ERR;
+    }
+#endif
+
     info.level      = 0u;
+    info.pCfg       = pCfg;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pDest;
@@ -1241,6 +3241,7 @@ EXT_DECL TRDP_ERR_T tau_unmarshall (
 
     *pDestSize = (UINT32) (info.pDst - pDest);
 
+    TRDP_TRACE3(unmarshall_done, comId, *pDestSize, err);
     return err;
 }
 
@@ -1279,8 +3280,12 @@ EXT_DECL TRDP_ERR_T tau_marshallDs (
     TRDP_ERR_T          err;
     TRDP_DATASET_T      *pDataset;
     TAU_MARSHALL_INFO_T info;
+    const TAU_MARSHALL_CFG_T *pCfg;
+#if TAU_MARSHALL_PLAN
+    const TAU_PLAN_T    *pPlan;
+#endif
 
-    pRefCon = pRefCon;
+    pCfg = findCfg(pRefCon);
 
     if ((0u == dsId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
@@ -1292,13 +3297,13 @@ EXT_DECL TRDP_ERR_T tau_marshallDs (
     {
         if (NULL == *ppDSPointer)
         {
-            *ppDSPointer = findDs(dsId);
+            *ppDSPointer = findDs(pCfg, dsId);
         }
         pDataset = *ppDSPointer;
     }
     else
     {
-        pDataset = findDs(dsId);
+        pDataset = findDs(pCfg, dsId);
     }
 
     if (NULL == pDataset)   /* Not in our DB    */
@@ -1307,7 +3312,18 @@ EXT_DECL TRDP_ERR_T tau_marshallDs (
         return TRDP_COMID_ERR;
     }
 
+#if TAU_MARSHALL_PLAN
+    pPlan = findPlan(pCfg, pDataset, pSrc, srcSize, *pDestSize);
+    if (NULL != pPlan)
+    {
+        marshallPlan(pPlan, pSrc, pDest);
+        *pDestSize = pPlan->wireSize;
+        return TRDP_NO_ERR;
+    }
+#endif
+
     info.level      = 0u;
+    info.pCfg       = pCfg;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pDest;
@@ -1354,8 +3370,12 @@ EXT_DECL TRDP_ERR_T tau_unmarshallDs (
     TRDP_ERR_T          err;
     TRDP_DATASET_T      *pDataset;
     TAU_MARSHALL_INFO_T info;
+    const TAU_MARSHALL_CFG_T *pCfg;
+#if TAU_MARSHALL_PLAN
+    const TAU_PLAN_T    *pPlan;
+#endif
 
-    pRefCon = pRefCon;
+    pCfg = findCfg(pRefCon);
 
     if ((0u == dsId) || (NULL == pSrc) || (NULL == pDest) || (NULL == pDestSize) || (0u == *pDestSize))
     {
@@ -1367,13 +3387,13 @@ EXT_DECL TRDP_ERR_T tau_unmarshallDs (
     {
         if (NULL == *ppDSPointer)
         {
-            *ppDSPointer = findDs(dsId);
+            *ppDSPointer = findDs(pCfg, dsId);
         }
         pDataset = *ppDSPointer;
     }
     else
     {
-        pDataset = findDs(dsId);
+        pDataset = findDs(pCfg, dsId);
     }
 
     if (NULL == pDataset)   /* Not in our DB    */
@@ -1382,7 +3402,18 @@ EXT_DECL TRDP_ERR_T tau_unmarshallDs (
         return TRDP_COMID_ERR;
     }
 
+#if TAU_MARSHALL_PLAN
+    pPlan = findPlan(pCfg, pDataset, pDest, *pDestSize, srcSize);
+    if (NULL != pPlan)
+    {
+        unmarshallPlan(pPlan, pSrc, pDest);
+        *pDestSize = pPlan->hostSize;
+        return TRDP_NO_ERR;
+    }
+#endif
+
     info.level      = 0u;
+    info.pCfg       = pCfg;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = pDest;
@@ -1428,8 +3459,9 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSize (
     TRDP_ERR_T          err;
     TRDP_DATASET_T      *pDataset;
     TAU_MARSHALL_INFO_T info;
+    const TAU_MARSHALL_CFG_T *pCfg;
 
-    pRefCon = pRefCon;
+    pCfg = findCfg(pRefCon);
 
     if ((0u == dsId) || (NULL == pSrc) || (NULL == pDestSize))
     {
@@ -1441,13 +3473,13 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSize (
     {
         if (NULL == *ppDSPointer)
         {
-            *ppDSPointer = findDs(dsId);
+            *ppDSPointer = findDs(pCfg, dsId);
         }
         pDataset = *ppDSPointer;
     }
     else
     {
-        pDataset = findDs(dsId);
+        pDataset = findDs(pCfg, dsId);
     }
 
     if (NULL == pDataset)   /* Not in our DB    */
@@ -1456,7 +3488,16 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSize (
         return TRDP_COMID_ERR;
     }
 
+#if TAU_MARSHALL_PLAN
+    /*  Only the counters of variable sized elements are read if the dataset has a size descriptor  */
+    if (sizeByCfg(pCfg, pDataset, pSrc, srcSize, pDestSize) == TRUE)
+    {
+        return TRDP_NO_ERR;
+    }
+#endif
+
     info.level      = 0u;
+    info.pCfg       = pCfg;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = 0u;
@@ -1500,8 +3541,9 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSizeByComId (
     TRDP_ERR_T          err;
     TRDP_DATASET_T      *pDataset;
     TAU_MARSHALL_INFO_T info;
+    const TAU_MARSHALL_CFG_T *pCfg;
 
-    pRefCon = pRefCon;
+    pCfg = findCfg(pRefCon);
 
     if ((0u == comId) || (NULL == pSrc) || (NULL == pDestSize))
     {
@@ -1513,13 +3555,13 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSizeByComId (
     {
         if (NULL == *ppDSPointer)
         {
-            *ppDSPointer = findDSFromComId(comId);
+            *ppDSPointer = findDSFromComId(pCfg, comId);
         }
         pDataset = *ppDSPointer;
     }
     else
     {
-        pDataset = findDSFromComId(comId);
+        pDataset = findDSFromComId(pCfg, comId);
     }
 
     if (NULL == pDataset)   /* Not in our DB    */
@@ -1528,7 +3570,16 @@ EXT_DECL TRDP_ERR_T tau_calcDatasetSizeByComId (
         return TRDP_COMID_ERR;
     }
 
+#if TAU_MARSHALL_PLAN
+    /*  Only the counters of variable sized elements are read if the dataset has a size descriptor  */
+    if (sizeByCfg(pCfg, pDataset, pSrc, srcSize, pDestSize) == TRUE)
+    {
+        return TRDP_NO_ERR;
+    }
+#endif
+
     info.level      = 0u;
+    info.pCfg       = pCfg;
     info.pSrc       = pSrc;
     info.pSrcEnd    = pSrc + srcSize;
     info.pDst       = 0u;
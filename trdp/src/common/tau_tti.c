@@ -5,9 +5,10 @@
  * @brief           Functions for train topology information access
  *
  * @details         The TTI subsystem maintains a pointer to the TAU_TTDB struct in the TRDP session struct.
- *                  That TAU_TTDB struct keeps the subscription and listener handles, the current TTDB directories and
- *                  a pointer list to consist infos (in network format). On init, most TTDB data is requested from the
- *                  ECSP plus the own consist info.
+ *                  That TAU_TTDB struct keeps the subscription and listener handles and a pointer to an immutable
+ *                  snapshot of the current TTDB directories and a pointer list to consist infos (in network format).
+ *                  Updates publish a new snapshot, the getters read a referenced snapshot without locking.
+ *                  On init, most TTDB data is requested from the ECSP plus the own consist info.
  *                  This data is automatically updated if an inauguration is detected. Additional consist infos are
  *                  requested on demand, only.
  *
@@ -38,6 +39,7 @@
  * INCLUDES
  */
 
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -55,23 +57,78 @@
  */
 
 #define TTI_CACHED_CONSISTS  8u             /**< We hold this number of consist infos (ca. 105kB) */
+#define TTI_MAX_CST_VEH_CNT  32u            /**< Max. number of vehicles in one consist info        */
+#define TTI_CST_INDEX_SIZE   16u            /**< Hash slots for cached consist labels (power of 2)  */
+#define TTI_VEH_INDEX_SIZE   64u            /**< Hash slots for vehicle labels of a consist         */
+#define TTI_OP_VEH_INDEX_SIZE 128u          /**< Hash slots for vehicle labels of the op. train dir */
+
+/* Readers of the TTDB snapshots need atomic built-ins, else the getters must run in the tlc_process() thread */
+#ifdef __GNUC__
+#define TTI_ATOMIC_LOAD(var)        __atomic_load_n(&(var), __ATOMIC_SEQ_CST)
+#define TTI_ATOMIC_XCHG(var, val)   __atomic_exchange_n(&(var), (val), __ATOMIC_SEQ_CST)
+#define TTI_ATOMIC_INC(var)         (void) __atomic_add_fetch(&(var), 1u, __ATOMIC_SEQ_CST)
+#define TTI_ATOMIC_DEC(var)         (void) __atomic_sub_fetch(&(var), 1u, __ATOMIC_SEQ_CST)
+#else
+#define TTI_ATOMIC_LOAD(var)        (var)
+#define TTI_ATOMIC_XCHG(var, val)   ttiExchange(&(var), (val))
+#define TTI_ATOMIC_INC(var)         (var)++
+#define TTI_ATOMIC_DEC(var)         (var)--
+#endif
 
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
-typedef struct TAU_TTDB
+/** Offsets into a cached consist info (network format) and its vehicle label index, computed once on reception */
+typedef struct TAU_CST_INDEX
 {
-    TRDP_SUB_T                      pd100SubHandle;
-    TRDP_LIS_T                      md101Listener;
-    TRDP_LIS_T                      md102Listener;
+    UINT16  etbCnt;
+    UINT16  vehCnt;
+    UINT16  fctCnt;
+    UINT16  cltrCstCnt;
+    UINT32  etbOffset;                              /**< offset of the ETB info list                */
+    UINT32  fctOffset;                              /**< offset of the function info list           */
+    UINT32  cltrCstOffset;                          /**< offset of the closed train consist list    */
+    UINT32  cstTopoCnt;                             /**< consist topocount (host endianess)         */
+    UINT32  vehOffset[TTI_MAX_CST_VEH_CNT];         /**< offsets of the (variable sized) vehicle infos */
+    UINT32  vehSize[TTI_MAX_CST_VEH_CNT];           /**< sizes of the vehicle infos                 */
+    UINT8   vehIndex[TTI_VEH_INDEX_SIZE];           /**< vehId hash -> vehicle position + 1         */
+} TAU_CST_INDEX_T;
+
+/** A received consist info (network format) with its offsets, shared read-only by the TTDB snapshots */
+typedef struct TAU_CST_ENTRY
+{
+    UINT32                          refCnt;         /**< number of snapshots referring to the entry         */
+    UINT32                          size;           /**< size of the consist info                           */
+    UINT32                          trnDirTopoCnt;  /**< trnDir cstTopoCnt the info was fetched for         */
+    TAU_CST_INDEX_T                 index;
+    TRDP_CONSIST_INFO_T             *pCstInfo;      /**< points behind the entry                            */
+} TAU_CST_ENTRY_T;
+
+/** Immutable view of the TTDB. Updates build a new snapshot and swap it in, readers hold a reference. */
+typedef struct TAU_TTDB_SNAP
+{
+    struct TAU_TTDB_SNAP            *pNext;         /**< list of replaced snapshots still in use            */
+    UINT32                          refCnt;         /**< readers plus one while published                   */
     TRDP_OP_TRAIN_DIR_STATUS_INFO_T opTrnState;
     TRDP_OP_TRAIN_DIR_T             opTrnDir;
     TRDP_TRAIN_DIR_T                trnDir;
     TRDP_TRAIN_NET_DIR_T            trnNetDir;
-    UINT32                          noOfCachedCst;
-    UINT32                          cstSize[TRDP_MAX_CST_CNT];
-    TRDP_CONSIST_INFO_T             *cstInfo[TRDP_MAX_CST_CNT];
+    TAU_CST_ENTRY_T                 *pCst[TTI_CACHED_CONSISTS];             /**< slot 0 holds the own consist */
+    UINT8                           cstLabelIndex[TTI_CST_INDEX_SIZE];      /**< cstId hash -> cache slot + 1 */
+    UINT8                           opVehIndex[TTI_OP_VEH_INDEX_SIZE];      /**< vehId hash -> opVehList pos + 1 */
+    UINT8                           opCstIndex[256];                        /**< opCstNo -> opCstList pos + 1 */
+    UINT8                           opCstFirstVeh[256];                     /**< opCstNo -> opVehList pos + 1 */
+} TAU_TTDB_SNAP_T;
+
+typedef struct TAU_TTDB
+{
+    TRDP_SUB_T                      pd100SubHandle;
+    TRDP_LIS_T                      md101Listener;
+    TRDP_LIS_T                      md102Listener;
+    TAU_TTDB_SNAP_T                 *pSnap;         /**< current snapshot, swapped atomically               */
+    TAU_TTDB_SNAP_T                 *pRetired;      /**< replaced snapshots waiting for their readers       */
+    UINT32                          readers;        /**< readers between loading pSnap and referencing it   */
 } TAU_TTDB_T;
 
 /***********************************************************************************************************************
@@ -83,67 +140,344 @@ static void ttiRequestTTDBdata (TRDP_APP_SESSION_T  appHandle,
                                 const TRDP_UUID_T   cstUUID);
 
 static void ttiGetUUIDfromLabel (
-                          TRDP_APP_SESSION_T  appHandle,
-                          TRDP_UUID_T         cstUUID,
-                          const TRDP_LABEL_T  cstLabel);
+                          const TAU_TTDB_SNAP_T   *pSnap,
+                          TRDP_UUID_T             cstUUID,
+                          const TRDP_LABEL_T      cstLabel);
 
 static TRDP_IP_ADDR_T ipFromURI (
     TRDP_APP_SESSION_T  appHandle,
-    TRDP_URI_HOST_T     uri)
+    const CHAR8         *pUri)
 {
-    TRDP_IP_ADDR_T ipAddr = VOS_INADDR_ANY;
+    TRDP_IP_ADDR_T  ipAddr = VOS_INADDR_ANY;
+    TRDP_URI_T      uri;
 
+    /*  tau_uri2Addr() reads a full URI buffer, the request URIs are shorter constants  */
+    memset(uri, 0, sizeof(uri));
+    vos_strncpy(uri, pUri, sizeof(uri) - 1u);
     (void) tau_uri2Addr(appHandle, &ipAddr, uri);
 
     return ipAddr;
 }
 
+/**********************************************************************************************************************/
+/*  TTDB snapshots                                                                                                    */
+/*  Readers reference the published snapshot without locking: they count themselves in 'readers' while loading the  */
+/*  pointer and taking their reference, and a replaced snapshot is only freed when no reader is between these steps  */
+/*  and its reference count dropped to zero. Snapshots are built and freed by the thread handling the TTDB telegrams */
+/*  only, so the consist entries shared between snapshots are counted without atomics.                              */
+/**********************************************************************************************************************/
+
+#ifndef __GNUC__
+static TAU_TTDB_SNAP_T *ttiExchange (
+    TAU_TTDB_SNAP_T **ppSnap,
+    TAU_TTDB_SNAP_T *pSnap)
+{
+    TAU_TTDB_SNAP_T *pOld = *ppSnap;
+    *ppSnap = pSnap;
+    return pOld;
+}
+#endif
+
+static void ttiCstEntryRelease (
+    TAU_CST_ENTRY_T *pEntry)
+{
+    if (pEntry != NULL &&
+        --pEntry->refCnt == 0u)
+    {
+        vos_memFree(pEntry);
+    }
+}
+
+static void ttiSnapFree (
+    TAU_TTDB_SNAP_T *pSnap)
+{
+    UINT32 i;
+
+    for (i = 0u; i < TTI_CACHED_CONSISTS; i++)
+    {
+        ttiCstEntryRelease(pSnap->pCst[i]);
+    }
+    vos_memFree(pSnap);
+}
+
+/**********************************************************************************************************************/
+/**    Free replaced snapshots which are not referenced by any reader anymore
+ */
+static void ttiSnapReclaim (
+    TAU_TTDB_T *pTTDB)
+{
+    TAU_TTDB_SNAP_T **ppSnap = &pTTDB->pRetired;
+
+    if (TTI_ATOMIC_LOAD(pTTDB->readers) != 0u)
+    {
+        return;     /* a reader may just be referencing one of them, try again on the next update    */
+    }
+    while (*ppSnap != NULL)
+    {
+        TAU_TTDB_SNAP_T *pSnap = *ppSnap;
+
+        if (TTI_ATOMIC_LOAD(pSnap->refCnt) == 0u)
+        {
+            *ppSnap = pSnap->pNext;
+            ttiSnapFree(pSnap);
+        }
+        else
+        {
+            ppSnap = &pSnap->pNext;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return a private copy of the current snapshot, to be modified and published with ttiSnapCommit()
+ */
+static TAU_TTDB_SNAP_T *ttiSnapEdit (
+    TAU_TTDB_T *pTTDB)
+{
+    TAU_TTDB_SNAP_T *pSnap = (TAU_TTDB_SNAP_T *) vos_memAlloc(sizeof(TAU_TTDB_SNAP_T));
+    UINT32          i;
+
+    if (pSnap == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "No memory to update the TTDB!\n");
+        return NULL;
+    }
+    *pSnap          = *pTTDB->pSnap;
+    pSnap->pNext    = NULL;
+    pSnap->refCnt   = 1u;
+    for (i = 0u; i < TTI_CACHED_CONSISTS; i++)
+    {
+        if (pSnap->pCst[i] != NULL)
+        {
+            pSnap->pCst[i]->refCnt++;
+        }
+    }
+    return pSnap;
+}
+
+/**********************************************************************************************************************/
+/**    Publish a modified snapshot, the replaced one is freed as soon as its readers released it
+ */
+static void ttiSnapCommit (
+    TAU_TTDB_T      *pTTDB,
+    TAU_TTDB_SNAP_T *pSnap)
+{
+    TAU_TTDB_SNAP_T *pOld = TTI_ATOMIC_XCHG(pTTDB->pSnap, pSnap);
+
+    pOld->pNext     = pTTDB->pRetired;
+    pTTDB->pRetired = pOld;
+    TTI_ATOMIC_DEC(pOld->refCnt);
+    ttiSnapReclaim(pTTDB);
+}
+
+/**********************************************************************************************************************/
+/**    Reference the current snapshot for reading, must be released with ttiSnapRelease()
+ */
+static const TAU_TTDB_SNAP_T *ttiSnapAcquire (
+    TAU_TTDB_T *pTTDB)
+{
+    TAU_TTDB_SNAP_T *pSnap;
+
+    TTI_ATOMIC_INC(pTTDB->readers);
+    pSnap = TTI_ATOMIC_LOAD(pTTDB->pSnap);
+    TTI_ATOMIC_INC(pSnap->refCnt);
+    TTI_ATOMIC_DEC(pTTDB->readers);
+    return pSnap;
+}
+
+static void ttiSnapRelease (
+    const TAU_TTDB_SNAP_T *pSnap)
+{
+    TTI_ATOMIC_DEC(((TAU_TTDB_SNAP_T *) pSnap)->refCnt);
+}
+
+/**********************************************************************************************************************/
+/**    Case insensitive hash (FNV-1a) of a label, used by the label indices
+ */
+static UINT32 ttiHashLabel (
+    const CHAR8 *pLabel)
+{
+    UINT32  hash = 2166136261u;
+    UINT32  i;
+
+    for (i = 0u; i < sizeof(TRDP_NET_LABEL_T) && pLabel[i] != 0; i++)
+    {
+        CHAR8 c = pLabel[i];
+        if (c >= 'A' && c <= 'Z')
+        {
+            c = (CHAR8) (c - 'A' + 'a');
+        }
+        hash    ^= (UINT8) c;
+        hash    *= 16777619u;
+    }
+    return hash;
+}
+
+/**********************************************************************************************************************/
+/**    Enter a position into an open addressing label index (linear probing, slots hold position + 1)
+ */
+static void ttiIndexInsert (
+    UINT8   *pIndex,
+    UINT32  indexSize,
+    UINT32  hash,
+    UINT32  pos)
+{
+    UINT32 i;
+
+    for (i = 0u; i < indexSize; i++)
+    {
+        UINT32 slot = (hash + i) & (indexSize - 1u);
+        if (pIndex[slot] == 0u)
+        {
+            pIndex[slot] = (UINT8) (pos + 1u);
+            return;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return the position of a vehicle in the operational train directory, TRDP_MAX_VEH_CNT if not found
+ */
+static UINT32 ttiFindOpVeh (
+    const TAU_TTDB_SNAP_T   *pSnap,
+    const CHAR8             *pVehLabel)
+{
+    UINT32  hash = ttiHashLabel(pVehLabel);
+    UINT32  i;
+
+    for (i = 0u; i < TTI_OP_VEH_INDEX_SIZE; i++)
+    {
+        UINT32  slot    = (hash + i) & (TTI_OP_VEH_INDEX_SIZE - 1u);
+        UINT32  pos     = pSnap->opVehIndex[slot];
+
+        if (pos == 0u)
+        {
+            break;
+        }
+        if (vos_strnicmp(pSnap->opTrnDir.opVehList[pos - 1u].vehId, pVehLabel,
+                         sizeof(TRDP_NET_LABEL_T)) == 0)
+        {
+            return pos - 1u;
+        }
+    }
+    return TRDP_MAX_VEH_CNT;
+}
+
+/**********************************************************************************************************************/
+/**    Return the cache slot of a consist info, TTI_CACHED_CONSISTS if not cached. NULL means own consist.
+ */
+static UINT32 ttiFindCst (
+    const TAU_TTDB_SNAP_T   *pSnap,
+    const CHAR8             *pCstLabel)
+{
+    UINT32  hash;
+    UINT32  i;
+
+    if (pCstLabel == NULL)
+    {
+        return (pSnap->pCst[0] != NULL) ? 0u : TTI_CACHED_CONSISTS;
+    }
+    hash = ttiHashLabel(pCstLabel);
+    for (i = 0u; i < TTI_CST_INDEX_SIZE; i++)
+    {
+        UINT32  slot    = (hash + i) & (TTI_CST_INDEX_SIZE - 1u);
+        UINT32  pos     = pSnap->cstLabelIndex[slot];
+
+        if (pos == 0u)
+        {
+            break;
+        }
+        if (pSnap->pCst[pos - 1u] != NULL &&
+            vos_strnicmp(pSnap->pCst[pos - 1u]->pCstInfo->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
+        {
+            return pos - 1u;
+        }
+    }
+    return TTI_CACHED_CONSISTS;
+}
+
+/**********************************************************************************************************************/
+/**    Return the position of a vehicle within a cached consist info, TTI_MAX_CST_VEH_CNT if not found
+ */
+static UINT32 ttiFindCstVeh (
+    const TAU_CST_ENTRY_T   *pEntry,
+    const CHAR8             *pVehLabel)
+{
+    const TAU_CST_INDEX_T   *pIndex = &pEntry->index;
+    const UINT8             *pBase  = (const UINT8 *) pEntry->pCstInfo;
+    UINT32  hash = ttiHashLabel(pVehLabel);
+    UINT32  i;
+
+    for (i = 0u; i < TTI_VEH_INDEX_SIZE; i++)
+    {
+        UINT32  slot    = (hash + i) & (TTI_VEH_INDEX_SIZE - 1u);
+        UINT32  pos     = pIndex->vehIndex[slot];
+
+        if (pos == 0u)
+        {
+            break;
+        }
+        /* vehId is the first member of a vehicle info */
+        if (vos_strnicmp((const CHAR8 *) (pBase + pIndex->vehOffset[pos - 1u]), pVehLabel,
+                         sizeof(TRDP_NET_LABEL_T)) == 0)
+        {
+            return pos - 1u;
+        }
+    }
+    return TTI_MAX_CST_VEH_CNT;
+}
+
 /**********************************************************************************************************************/
 /**    Function returns the UUID for the given UIC ID
- *      We need to search in the OP_TRAIN_DIR the OP_VEHICLE where the vehicle is the
- *      first one in the consist and its name matches.
+ *      We look up the vehicle with a matching vehId in the OP_TRAIN_DIR and return the UUID of its consist.
  *      Note: The first vehicle in a consist has the same ID as the consist it is belonging to (5.3.3.2.5)
+ *      A NULL label returns the UUID of the own consist.
  */
 static void ttiGetUUIDfromLabel (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_UUID_T         cstUUID,
-    const TRDP_LABEL_T  cstLabel)
+    const TAU_TTDB_SNAP_T   *pSnap,
+    TRDP_UUID_T             cstUUID,
+    const TRDP_LABEL_T      cstLabel)
 {
-    UINT32  i;
-    UINT32  j;
+    UINT8   opCstNo;
+    UINT32  pos;
 
-    /* Search the vehicles in the OP_TRAIN_DIR for a matching vehID */
-
-    for (i = 0u; i < appHandle->pTTDB->opTrnDir.opVehCnt; i++)
+    if (cstLabel == NULL)
+    {
+        opCstNo = pSnap->opTrnState.ownOpCstNo;
+    }
+    else
     {
-        if (vos_strnicmp(appHandle->pTTDB->opTrnDir.opVehList[i].vehId, cstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
+        pos = ttiFindOpVeh(pSnap, cstLabel);
+        if (pos >= pSnap->opTrnDir.opVehCnt)
         {
-            /* vehicle found, is it the first in the consist?   */
-            UINT8 opCstNo = appHandle->pTTDB->opTrnDir.opVehList[i].ownOpCstNo;
-            for (j = 0u; j < appHandle->pTTDB->opTrnDir.opCstCnt; j++)
-            {
-                if (opCstNo == appHandle->pTTDB->opTrnDir.opCstList[j].opCstNo)
-                {
-                    memcpy(cstUUID, appHandle->pTTDB->opTrnDir.opCstList[j].cstUUID, sizeof(TRDP_UUID_T));
-                    return;
-                }
-            }
+            /* not found    */
+            memset(cstUUID, 0, sizeof(TRDP_UUID_T));
+            return;
         }
+        opCstNo = pSnap->opTrnDir.opVehList[pos].ownOpCstNo;
+    }
+
+    pos = pSnap->opCstIndex[opCstNo];
+    if (pos != 0u)
+    {
+        memcpy(cstUUID, pSnap->opTrnDir.opCstList[pos - 1u].cstUUID, sizeof(TRDP_UUID_T));
+    }
+    else
+    {
+        memset(cstUUID, 0, sizeof(TRDP_UUID_T));
     }
-    /* not found    */
-    memset(cstUUID, 0, sizeof(TRDP_UUID_T));
 }
 
 static BOOL8   ttiIsOwnCstInfo (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_CONSIST_INFO_T *pTelegram)
+    const TAU_TTDB_SNAP_T   *pSnap,
+    TRDP_CONSIST_INFO_T     *pTelegram)
 {
     UINT32 i;
-    for (i = 0u; i < appHandle->pTTDB->opTrnDir.opCstCnt; i++)
+    for (i = 0u; i < pSnap->opTrnDir.opCstCnt; i++)
     {
-        if (appHandle->pTTDB->opTrnState.ownTrnCstNo == appHandle->pTTDB->opTrnDir.opCstList[i].trnCstNo)
+        if (pSnap->opTrnState.ownTrnCstNo == pSnap->opTrnDir.opCstList[i].trnCstNo)
         {
-            return memcmp(appHandle->pTTDB->opTrnDir.opCstList[i].cstUUID, pTelegram->cstUUID,
+            return memcmp(pSnap->opTrnDir.opCstList[i].cstUUID, pTelegram->cstUUID,
                           sizeof(TRDP_UUID_T)) == 0u;
         }
     }
@@ -182,6 +516,7 @@ static void ttiPDCallback (
             (dataSize <= sizeof(TRDP_OP_TRAIN_DIR_STATUS_INFO_T)))
         {
             TRDP_OP_TRAIN_DIR_STATUS_INFO_T *pTelegram = (TRDP_OP_TRAIN_DIR_STATUS_INFO_T *) pData;
+            TRDP_OP_TRAIN_DIR_STATUS_INFO_T opTrnState;
             UINT32 crc;
 
             /* check the crc:   */
@@ -195,29 +530,41 @@ static void ttiPDCallback (
             }
 
             /* Store the state locally */
-            memcpy(&appHandle->pTTDB->opTrnState, &pTelegram->state,
+            memset(&opTrnState, 0, sizeof(opTrnState));
+            memcpy(&opTrnState, &pTelegram->state,
                    (sizeof(TRDP_OP_TRAIN_DIR_STATE_T) < dataSize) ? sizeof(TRDP_OP_TRAIN_DIR_STATE_T) : dataSize);
 
             /* unmarshall manually:   */
-            appHandle->pTTDB->opTrnState.etbTopoCnt         = vos_ntohl(pTelegram->etbTopoCnt);
-            appHandle->pTTDB->opTrnState.state.opTrnTopoCnt = vos_ntohl(pTelegram->state.opTrnTopoCnt);
-            appHandle->pTTDB->opTrnState.state.crc = vos_ntohl(pTelegram->state.crc);
+            opTrnState.etbTopoCnt           = vos_ntohl(pTelegram->etbTopoCnt);
+            opTrnState.state.opTrnTopoCnt   = vos_ntohl(pTelegram->state.opTrnTopoCnt);
+            opTrnState.state.crc            = vos_ntohl(pTelegram->state.crc);
+
+            /* publish a new snapshot only if the status info changed   */
+            if (memcmp(&opTrnState, &appHandle->pTTDB->pSnap->opTrnState, sizeof(opTrnState)) != 0)
+            {
+                TAU_TTDB_SNAP_T *pSnap = ttiSnapEdit(appHandle->pTTDB);
+                if (pSnap != NULL)
+                {
+                    pSnap->opTrnState = opTrnState;
+                    ttiSnapCommit(appHandle->pTTDB, pSnap);
+                }
+            }
 
             /* vos_printLog(VOS_LOG_INFO, "---> Operational status info received on %p\n", appHandle); */
 
             /* Has the etbTopoCnt changed? */
-            if (appHandle->etbTopoCnt != appHandle->pTTDB->opTrnState.etbTopoCnt)
+            if (appHandle->etbTopoCnt != opTrnState.etbTopoCnt)
             {
                 vos_printLog(VOS_LOG_INFO, "ETB topocount changed (old: 0x%08x, new: 0x%08x) on %p!\n",
-                             appHandle->etbTopoCnt, appHandle->pTTDB->opTrnState.etbTopoCnt, (void*) appHandle);
+                             appHandle->etbTopoCnt, opTrnState.etbTopoCnt, (void*) appHandle);
                 changed++;
-                (void) tlc_setETBTopoCount(appHandle, appHandle->pTTDB->opTrnState.etbTopoCnt);
+                (void) tlc_setETBTopoCount(appHandle, opTrnState.etbTopoCnt);
             }
 
-            if (appHandle->opTrnTopoCnt != appHandle->pTTDB->opTrnState.state.opTrnTopoCnt)
+            if (appHandle->opTrnTopoCnt != opTrnState.state.opTrnTopoCnt)
             {
                 changed++;
-                (void) tlc_setOpTrainTopoCount(appHandle, appHandle->pTTDB->opTrnState.state.opTrnTopoCnt);
+                (void) tlc_setOpTrainTopoCount(appHandle, opTrnState.state.opTrnTopoCnt);
             }
 
         }
@@ -254,10 +601,11 @@ static void ttiPDCallback (
 /**********************************************************************************************************************/
 static void ttiStoreOpTrnDir (
     TRDP_APP_SESSION_T  appHandle,
+    TAU_TTDB_SNAP_T     *pSnap,
     UINT8               *pData)
 {
     TRDP_OP_TRAIN_DIR_T *pTelegram = (TRDP_OP_TRAIN_DIR_T *) pData;
-    UINT32 size;
+    UINT32 size, vehCnt, i;
 
     /* we have to unpack the data, copy up to OP_CONSIST */
     if (pTelegram->opCstCnt > TRDP_MAX_CST_CNT)
@@ -269,18 +617,45 @@ static void ttiStoreOpTrnDir (
 
     /* 8 Bytes up to opCstCnt plus number of Consists  */
     size = 8 + pTelegram->opCstCnt * sizeof(TRDP_OP_CONSIST_T);
-    memcpy(&appHandle->pTTDB->opTrnDir, pData, size);
+    memcpy(&pSnap->opTrnDir, pData, size);
     pData   += size + 3;            /* jump to cnt  */
-    size    = *pData++ *sizeof(TRDP_OP_VEHICLE_T) + sizeof(UINT32); /* copy opTrnTopoCnt as well    */
-    memcpy(&appHandle->pTTDB->opTrnDir, pData, size);
+    vehCnt  = *pData++;
+    if (vehCnt > TRDP_MAX_VEH_CNT)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Max count of vehicles of received operational dir exceeded (%u)!\n", vehCnt);
+        return;
+    }
+    pSnap->opTrnDir.opVehCnt = (UINT8) vehCnt;
+    size = vehCnt * sizeof(TRDP_OP_VEHICLE_T);
+    memcpy(pSnap->opTrnDir.opVehList, pData, size);
+    memcpy(&pSnap->opTrnDir.opTrnTopoCnt, pData + size, sizeof(UINT32));   /* copy opTrnTopoCnt as well */
 
     /* unmarshall manually and update the opTrnTopoCount   */
-    appHandle->pTTDB->opTrnDir.opTrnTopoCnt = vos_ntohl(appHandle->pTTDB->opTrnDir.opTrnTopoCnt);
-    (void) tlc_setOpTrainTopoCount(appHandle, appHandle->pTTDB->opTrnDir.opTrnTopoCnt);
+    pSnap->opTrnDir.opTrnTopoCnt = vos_ntohl(pSnap->opTrnDir.opTrnTopoCnt);
+    (void) tlc_setOpTrainTopoCount(appHandle, pSnap->opTrnDir.opTrnTopoCnt);
+
+    /* index consists by opCstNo and vehicles by label   */
+    memset(pSnap->opVehIndex, 0, sizeof(pSnap->opVehIndex));
+    memset(pSnap->opCstIndex, 0, sizeof(pSnap->opCstIndex));
+    memset(pSnap->opCstFirstVeh, 0, sizeof(pSnap->opCstFirstVeh));
+    for (i = 0u; i < pSnap->opTrnDir.opCstCnt; i++)
+    {
+        pSnap->opCstIndex[pSnap->opTrnDir.opCstList[i].opCstNo] = (UINT8) (i + 1u);
+    }
+    for (i = 0u; i < vehCnt; i++)
+    {
+        const TRDP_OP_VEHICLE_T *pVeh = &pSnap->opTrnDir.opVehList[i];
+
+        ttiIndexInsert(pSnap->opVehIndex, TTI_OP_VEH_INDEX_SIZE, ttiHashLabel(pVeh->vehId), i);
+        if (pSnap->opCstFirstVeh[pVeh->ownOpCstNo] == 0u)
+        {
+            pSnap->opCstFirstVeh[pVeh->ownOpCstNo] = (UINT8) (i + 1u);
+        }
+    }
 }
 
 static void ttiStoreTrnDir (
-    TRDP_APP_SESSION_T  appHandle,
+    TAU_TTDB_SNAP_T     *pSnap,
     UINT8               *pData)
 {
     TRDP_TRAIN_DIR_T *pTelegram = (TRDP_TRAIN_DIR_T *) pData;
@@ -296,21 +671,21 @@ static void ttiStoreTrnDir (
 
     /* 4 Bytes up to cstCnt plus number of Consists  */
     size = 4 + pTelegram->cstCnt * sizeof(TRDP_CONSIST_T);
-    memcpy(&appHandle->pTTDB->trnDir, pData, size);
+    memcpy(&pSnap->trnDir, pData, size);
     pData += size;              /* jump to trnTopoCount  */
 
     /* unmarshall manually and update the trnTopoCount   */
-    appHandle->pTTDB->trnDir.trnTopoCnt = vos_ntohl((*(UINT32 *)pData));   /* copy trnTopoCnt as well    */
+    pSnap->trnDir.trnTopoCnt = vos_ntohl((*(UINT32 *)pData));   /* copy trnTopoCnt as well    */
 
     /* swap the consist topoCnts    */
-    for (i = 0; i < appHandle->pTTDB->trnDir.cstCnt; i++)
+    for (i = 0; i < pSnap->trnDir.cstCnt; i++)
     {
-        appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt = vos_ntohl(appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt);
+        pSnap->trnDir.cstList[i].cstTopoCnt = vos_ntohl(pSnap->trnDir.cstList[i].cstTopoCnt);
     }
 }
 
 static void ttiStoreTrnNetDir (
-    TRDP_APP_SESSION_T  appHandle,
+    TAU_TTDB_SNAP_T     *pSnap,
     UINT8               *pData)
 {
     TRDP_TRAIN_NET_DIR_T *pTelegram = (TRDP_TRAIN_NET_DIR_T *) pData;
@@ -318,79 +693,264 @@ static void ttiStoreTrnNetDir (
 
     /* we have to unpack the data, copy up to CONSIST */
 
-    appHandle->pTTDB->trnNetDir.reserved01  = 0;
-    appHandle->pTTDB->trnNetDir.entryCnt    = vos_ntohs(pTelegram->entryCnt);
-    if (appHandle->pTTDB->trnNetDir.entryCnt > TRDP_MAX_CST_CNT)
+    pSnap->trnNetDir.reserved01  = 0;
+    pSnap->trnNetDir.entryCnt    = vos_ntohs(pTelegram->entryCnt);
+    if (pSnap->trnNetDir.entryCnt > TRDP_MAX_CST_CNT)
     {
         vos_printLog(VOS_LOG_ERROR, "Max count of consists of received train net dir exceeded (%d)!\n",
-                     vos_ntohs(appHandle->pTTDB->trnNetDir.entryCnt));
+                     vos_ntohs(pSnap->trnNetDir.entryCnt));
         return;
     }
 
     /* 4 Bytes up to cstCnt plus number of Consists  */
-    size = appHandle->pTTDB->trnNetDir.entryCnt * sizeof(TRDP_TRAIN_NET_DIR_ENTRY_T);
-    memcpy(&appHandle->pTTDB->trnNetDir.trnNetDir[0], pData, size);
+    size = pSnap->trnNetDir.entryCnt * sizeof(TRDP_TRAIN_NET_DIR_ENTRY_T);
+    memcpy(&pSnap->trnNetDir.trnNetDir[0], pData, size);
     pData += 4 + size;              /* jump to etbTopoCnt  */
 
     /* unmarshall manually and update the etbTopoCount   */
-    appHandle->pTTDB->trnNetDir.etbTopoCnt = vos_ntohl((*(UINT32 *)pData));   /* copy etbTopoCnt as well    */
+    pSnap->trnNetDir.etbTopoCnt = vos_ntohl((*(UINT32 *)pData));   /* copy etbTopoCnt as well    */
 
     /* swap the consist network properties    */
-    for (i = 0; i < appHandle->pTTDB->trnNetDir.entryCnt; i++)
+    for (i = 0; i < pSnap->trnNetDir.entryCnt; i++)
     {
-        appHandle->pTTDB->trnNetDir.trnNetDir[i].cstNetProp = vos_ntohl(
-                appHandle->pTTDB->trnNetDir.trnNetDir[i].cstNetProp);
+        pSnap->trnNetDir.trnNetDir[i].cstNetProp = vos_ntohl(
+                pSnap->trnNetDir.trnNetDir[i].cstNetProp);
     }
 }
 
 /***********************************************************************************************************************
- * Find an appropriate location to store the received consist info
+ * Walk a received consist info (network format) once and record the offsets of its variable sized lists,
+ * so the getters need not walk the property and vehicle lists again. Returns FALSE if the info is truncated.
  */
-static void ttiStoreCstInfo (
-    TRDP_APP_SESSION_T  appHandle,
-    UINT8               *pData,
-    UINT32              dataSize)
+static BOOL8 ttiIndexCstInfo (
+    TAU_CST_INDEX_T *pIndex,
+    const UINT8     *pData,
+    UINT32          dataSize)
 {
-    TRDP_CONSIST_INFO_T *pTelegram = (TRDP_CONSIST_INFO_T *) pData;
-    UINT32 curEntry = 0;
+    const UINT32    vehFixSize = offsetof(TRDP_VEHICLE_INFO_T, vehProp) + 4u;
+    UINT32          offset;
+    UINT32          i;
+
+    memset(pIndex, 0, sizeof(TAU_CST_INDEX_T));
 
-    if (ttiIsOwnCstInfo(appHandle, pTelegram) == TRUE)
+    /* skip fixed header and cstProp, then reserved03 */
+    offset = offsetof(TRDP_CONSIST_INFO_T, cstProp);
+    if (offset + 4u > dataSize)
     {
-        if (appHandle->pTTDB->cstInfo[curEntry] != NULL)
+        return FALSE;
+    }
+    offset += 4u + vos_ntohs(*(const UINT16 *)(pData + offset + 2u)) + 2u;
+
+    /* ETB info list */
+    if (offset + 2u > dataSize)
+    {
+        return FALSE;
+    }
+    pIndex->etbCnt      = vos_ntohs(*(const UINT16 *)(pData + offset));
+    pIndex->etbOffset   = offset + 2u;
+    offset = pIndex->etbOffset + pIndex->etbCnt * sizeof(TRDP_ETB_INFO_T) + 2u;
+
+    /* vehicle info list */
+    if (offset + 2u > dataSize)
+    {
+        return FALSE;
+    }
+    pIndex->vehCnt  = vos_ntohs(*(const UINT16 *)(pData + offset));
+    offset          += 2u;
+    if (pIndex->vehCnt > TTI_MAX_CST_VEH_CNT)
+    {
+        return FALSE;
+    }
+    for (i = 0u; i < pIndex->vehCnt; i++)
+    {
+        if (offset + vehFixSize > dataSize)
         {
-            vos_memFree(appHandle->pTTDB->cstInfo[curEntry]);
-            appHandle->pTTDB->cstInfo[curEntry] = NULL;
+            return FALSE;
         }
+        pIndex->vehOffset[i]    = offset;
+        pIndex->vehSize[i]      = vehFixSize +
+            vos_ntohs(*(const UINT16 *)(pData + offset + offsetof(TRDP_VEHICLE_INFO_T, vehProp) + 2u));
+        offset += pIndex->vehSize[i];
+        ttiIndexInsert(pIndex->vehIndex, TTI_VEH_INDEX_SIZE,
+                       ttiHashLabel((const CHAR8 *)(pData + pIndex->vehOffset[i])), i);
     }
-    else
+
+    /* function info list */
+    offset += 2u;
+    if (offset + 2u > dataSize)
     {
-        UINT32 l_index;
-        curEntry = 1;
-        /* check if already loaded */
-        for (l_index = 1; l_index < TRDP_MAX_CST_CNT; l_index++)
+        return FALSE;
+    }
+    pIndex->fctCnt      = vos_ntohs(*(const UINT16 *)(pData + offset));
+    pIndex->fctOffset   = offset + 2u;
+    offset = pIndex->fctOffset + pIndex->fctCnt * sizeof(TRDP_FUNCTION_INFO_T) + 2u;
+
+    /* closed train consist list and cstTopoCnt */
+    if (offset + 2u > dataSize)
+    {
+        return FALSE;
+    }
+    pIndex->cltrCstCnt      = vos_ntohs(*(const UINT16 *)(pData + offset));
+    pIndex->cltrCstOffset   = offset + 2u;
+    offset = pIndex->cltrCstOffset + pIndex->cltrCstCnt * sizeof(TRDP_CLTR_CST_INFO_T);
+    if (offset + 4u > dataSize)
+    {
+        return FALSE;
+    }
+    pIndex->cstTopoCnt = vos_ntohl(*(const UINT32 *)(pData + offset));
+    return TRUE;
+}
+
+/***********************************************************************************************************************
+ * Rebuild the consist label index over the cache slots
+ */
+static void ttiIndexCstCache (
+    TAU_TTDB_SNAP_T *pSnap)
+{
+    UINT32 l_index;
+
+    memset(pSnap->cstLabelIndex, 0, sizeof(pSnap->cstLabelIndex));
+    for (l_index = 0u; l_index < TTI_CACHED_CONSISTS; l_index++)
+    {
+        if (pSnap->pCst[l_index] != NULL)
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                appHandle->pTTDB->cstInfo[l_index]->cstTopoCnt != 0 &&
-                memcmp(appHandle->pTTDB->cstInfo[l_index]->cstUUID, pTelegram->cstUUID, sizeof(TRDP_UUID_T)) == 0)
+            ttiIndexInsert(pSnap->cstLabelIndex, TTI_CST_INDEX_SIZE,
+                           ttiHashLabel(pSnap->pCst[l_index]->pCstInfo->cstId), l_index);
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * Return the consist topocount the current train directory lists for a consist, 0 if unknown
+ */
+static UINT32 ttiTrnDirCstTopoCnt (
+    const TAU_TTDB_SNAP_T   *pSnap,
+    const TRDP_UUID_T       cstUUID)
+{
+    UINT32 i;
+    for (i = 0; i < pSnap->trnDir.cstCnt && i < TRDP_MAX_CST_CNT; i++)
+    {
+        if (memcmp(pSnap->trnDir.cstList[i].cstUUID, cstUUID, sizeof(TRDP_UUID_T)) == 0)
+        {
+            return pSnap->trnDir.cstList[i].cstTopoCnt;
+        }
+    }
+    return 0u;
+}
+
+/***********************************************************************************************************************
+ * Drop cached consist infos which are no longer part of the train or whose consist topocount changed,
+ * and return the consists whose infos are missing from the cache (to be requested after publishing)
+ */
+static UINT32 ttiUpdateCstCache (
+    TAU_TTDB_SNAP_T *pSnap,
+    TRDP_UUID_T     missing[])
+{
+    UINT32 i, l_index, noOfMissing = 0u;
+
+    for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
+    {
+        if (pSnap->pCst[l_index] != NULL)
+        {
+            UINT32 topoCnt = ttiTrnDirCstTopoCnt(pSnap, pSnap->pCst[l_index]->pCstInfo->cstUUID);
+
+            if (topoCnt == 0u ||
+                topoCnt != pSnap->pCst[l_index]->trnDirTopoCnt)
+            {
+                ttiCstEntryRelease(pSnap->pCst[l_index]);
+                pSnap->pCst[l_index] = NULL;
+            }
+        }
+    }
+
+    for (i = 0; i < TTI_CACHED_CONSISTS && i < pSnap->trnDir.cstCnt; i++)
+    {
+        if (pSnap->trnDir.cstList[i].cstTopoCnt == 0)
+        {
+            break;  /* no of available consists reached   */
+        }
+        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
+        {
+            if (pSnap->pCst[l_index] != NULL &&
+                memcmp(pSnap->pCst[l_index]->pCstInfo->cstUUID, pSnap->trnDir.cstList[i].cstUUID,
+                       sizeof(TRDP_UUID_T)) == 0)
             {
-                vos_memFree(appHandle->pTTDB->cstInfo[l_index]);
-                appHandle->pTTDB->cstInfo[l_index] = NULL;
-                curEntry = l_index;
                 break;
             }
         }
+        if (l_index == TTI_CACHED_CONSISTS)    /* not cached or outdated */
+        {
+            memcpy(missing[noOfMissing++], pSnap->trnDir.cstList[i].cstUUID, sizeof(TRDP_UUID_T));
+        }
     }
-    appHandle->pTTDB->cstInfo[curEntry] = (TRDP_CONSIST_INFO_T *) vos_memAlloc(dataSize);
-    if (appHandle->pTTDB->cstInfo[curEntry] == NULL)
+    ttiIndexCstCache(pSnap);
+    return noOfMissing;
+}
+
+/***********************************************************************************************************************
+ * Find an appropriate location to store the received consist info
+ */
+static void ttiStoreCstInfo (
+    TAU_TTDB_SNAP_T *pSnap,
+    UINT8           *pData,
+    UINT32          dataSize)
+{
+    TRDP_CONSIST_INFO_T *pTelegram = (TRDP_CONSIST_INFO_T *) pData;
+    UINT32 curEntry = 0;
+    TAU_CST_ENTRY_T *pEntry;
+
+    pEntry = (TAU_CST_ENTRY_T *) vos_memAlloc(sizeof(TAU_CST_ENTRY_T) + dataSize);
+    if (pEntry == NULL)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Consist info could not be stored!");
         return;
     }
+    if (ttiIndexCstInfo(&pEntry->index, pData, dataSize) != TRUE)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Received consist info is malformed and was not stored!");
+        vos_memFree(pEntry);
+        return;
+    }
+
+    if (ttiIsOwnCstInfo(pSnap, pTelegram) != TRUE)
+    {
+        UINT32 l_index;
+        curEntry = 0;
+        /* check if already loaded, else take the first free slot, else overwrite slot 1 */
+        for (l_index = 1; l_index < TTI_CACHED_CONSISTS; l_index++)
+        {
+            if (pSnap->pCst[l_index] == NULL)
+            {
+                if (curEntry == 0)
+                {
+                    curEntry = l_index;
+                }
+            }
+            else if (memcmp(pSnap->pCst[l_index]->pCstInfo->cstUUID, pTelegram->cstUUID,
+                            sizeof(TRDP_UUID_T)) == 0)
+            {
+                curEntry = l_index;
+                break;
+            }
+        }
+        if (curEntry == 0)
+        {
+            curEntry = 1;
+        }
+    }
 
     /* We do not convert but just copy the consist info slot   */
 
-    memcpy(appHandle->pTTDB->cstInfo[curEntry], pTelegram, dataSize);
-    appHandle->pTTDB->cstSize[curEntry] = dataSize;
+    pEntry->refCnt          = 1u;
+    pEntry->size            = dataSize;
+    pEntry->trnDirTopoCnt   = ttiTrnDirCstTopoCnt(pSnap, pTelegram->cstUUID);
+    pEntry->pCstInfo        = (TRDP_CONSIST_INFO_T *) (pEntry + 1);
+    memcpy(pEntry->pCstInfo, pTelegram, dataSize);
+
+    /* the replaced info stays valid for the readers of older snapshots   */
+    ttiCstEntryRelease(pSnap->pCst[curEntry]);
+    pSnap->pCst[curEntry] = pEntry;
+    ttiIndexCstCache(pSnap);
 }
 
 /**********************************************************************************************************************/
@@ -414,15 +974,23 @@ static void ttiMDCallback (
     UINT8                   *pData,
     UINT32                  dataSize)
 {
-    VOS_SEMA_T waitForInaug = (VOS_SEMA_T) pRefCon;
+    VOS_SEMA_T      waitForInaug = (VOS_SEMA_T) pRefCon;
+    TAU_TTDB_SNAP_T *pSnap;
+
+    if (pMsg->resultCode != TRDP_NO_ERR ||
+        appHandle->pTTDB == NULL)
+    {
+        return;
+    }
 
     if (pMsg->comId == TTDB_OP_DIR_INFO_COMID ||      /* TTDB notification */
         pMsg->comId == TTDB_OP_DIR_INFO_REP_COMID)
     {
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_OP_TRAIN_DIR_T))
+        if (dataSize <= sizeof(TRDP_OP_TRAIN_DIR_T) &&
+            (pSnap = ttiSnapEdit(appHandle->pTTDB)) != NULL)
         {
-            ttiStoreOpTrnDir(appHandle, pData);
+            ttiStoreOpTrnDir(appHandle, pSnap, pData);
+            ttiSnapCommit(appHandle->pTTDB, pSnap);
             if (waitForInaug != NULL)
             {
                 vos_semaGive(waitForInaug);           /* Signal new inauguration    */
@@ -431,44 +999,35 @@ static void ttiMDCallback (
     }
     else if (pMsg->comId == TTDB_TRN_DIR_REP_COMID)
     {
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_TRAIN_DIR_T))
+        if (dataSize <= sizeof(TRDP_TRAIN_DIR_T) &&
+            (pSnap = ttiSnapEdit(appHandle->pTTDB)) != NULL)
         {
-            UINT32 i;
-            ttiStoreTrnDir(appHandle, pData);
-            /* Request consist infos now (fill cache)   */
-            for (i = 0; i < TTI_CACHED_CONSISTS; i++)
-            {
-                /* invalidate entry */
-                if (appHandle->pTTDB->cstInfo[i] != NULL)
-                {
-                    vos_memFree(appHandle->pTTDB->cstInfo[i]);
-                    appHandle->pTTDB->cstInfo[i] = NULL;
-                }
-                ;
-            }
-            for (i = 0; i < TTI_CACHED_CONSISTS; i++)
+            TRDP_UUID_T missing[TTI_CACHED_CONSISTS];
+            UINT32      i, noOfMissing;
+
+            ttiStoreTrnDir(pSnap, pData);
+            noOfMissing = ttiUpdateCstCache(pSnap, missing);
+            ttiSnapCommit(appHandle->pTTDB, pSnap);
+
+            /* Request changed or missing consist infos only (fill cache)   */
+            for (i = 0u; i < noOfMissing; i++)
             {
-                if (appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt == 0)
-                {
-                    break;  /* no of available consists reached   */
-                }
-                ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, appHandle->pTTDB->trnDir.cstList[i].cstUUID);
+                ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, missing[i]);
             }
         }
     }
     else if (pMsg->comId == TTDB_NET_DIR_REP_COMID)
     {
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_TRAIN_NET_DIR_T))
+        if (dataSize <= sizeof(TRDP_TRAIN_NET_DIR_T) &&
+            (pSnap = ttiSnapEdit(appHandle->pTTDB)) != NULL)
         {
-            ttiStoreTrnNetDir(appHandle, pData);
+            ttiStoreTrnNetDir(pSnap, pData);
+            ttiSnapCommit(appHandle->pTTDB, pSnap);
         }
     }
     else if (pMsg->comId == TTDB_READ_CMPLT_REP_COMID)
     {
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_READ_COMPLETE_REPLY_T))
+        if (dataSize <= sizeof(TRDP_READ_COMPLETE_REPLY_T))
         {
             TRDP_READ_COMPLETE_REPLY_T *pTelegram = (TRDP_READ_COMPLETE_REPLY_T *) pData;
             UINT32 crc;
@@ -484,28 +1043,35 @@ static void ttiMDCallback (
                     (void) tlc_setOpTrainTopoCount(appHandle, 0);
                 return;
             }
-            memcpy(&appHandle->pTTDB->opTrnState.state, &pTelegram->state,
+            pSnap = ttiSnapEdit(appHandle->pTTDB);
+            if (pSnap == NULL)
+            {
+                return;
+            }
+            memcpy(&pSnap->opTrnState.state, &pTelegram->state,
                    (dataSize > sizeof(TRDP_OP_TRAIN_DIR_STATE_T)) ? sizeof(TRDP_OP_TRAIN_DIR_STATE_T) : dataSize);
 
             /* unmarshall manually:   */
-            appHandle->pTTDB->opTrnState.state.opTrnTopoCnt = vos_ntohl(pTelegram->state.opTrnTopoCnt);
-            (void) tlc_setOpTrainTopoCount(appHandle, appHandle->pTTDB->opTrnState.state.opTrnTopoCnt);
-            appHandle->pTTDB->opTrnState.state.crc = MAKE_LE(pTelegram->state.crc);
+            pSnap->opTrnState.state.opTrnTopoCnt = vos_ntohl(pTelegram->state.opTrnTopoCnt);
+            (void) tlc_setOpTrainTopoCount(appHandle, pSnap->opTrnState.state.opTrnTopoCnt);
+            pSnap->opTrnState.state.crc = MAKE_LE(pTelegram->state.crc);
 
             /* handle the other parts of the message    */
-            ttiStoreOpTrnDir(appHandle, (UINT8 *) &pTelegram->opTrnDir);
-            ttiStoreTrnDir(appHandle, (UINT8 *) &pTelegram->trnDir);
-            ttiStoreTrnNetDir(appHandle, (UINT8 *) &pTelegram->trnNetDir);
+            ttiStoreOpTrnDir(appHandle, pSnap, (UINT8 *) &pTelegram->opTrnDir);
+            ttiStoreTrnDir(pSnap, (UINT8 *) &pTelegram->trnDir);
+            ttiStoreTrnNetDir(pSnap, (UINT8 *) &pTelegram->trnNetDir);
+            ttiSnapCommit(appHandle->pTTDB, pSnap);
         }
     }
     else if (pMsg->comId == TTDB_STAT_CST_REP_COMID)
     {
 
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_CONSIST_INFO_T))
+        if (dataSize <= sizeof(TRDP_CONSIST_INFO_T) &&
+            (pSnap = ttiSnapEdit(appHandle->pTTDB)) != NULL)
         {
             /* find a free place in the cache, or overwrite oldest entry   */
-            ttiStoreCstInfo(appHandle, pData, dataSize);
+            ttiStoreCstInfo(pSnap, pData, dataSize);
+            ttiSnapCommit(appHandle->pTTDB, pSnap);
         }
     }
 }
@@ -619,6 +1185,14 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
     {
         return TRDP_MEM_ERR;
     }
+    appHandle->pTTDB->pSnap = (TAU_TTDB_SNAP_T *) vos_memAlloc(sizeof(TAU_TTDB_SNAP_T));
+    if (appHandle->pTTDB->pSnap == NULL)
+    {
+        vos_memFree(appHandle->pTTDB);
+        appHandle->pTTDB = NULL;
+        return TRDP_MEM_ERR;
+    }
+    appHandle->pTTDB->pSnap->refCnt = 1u;
 
     /*  subscribe to PD 100 */
 
@@ -633,7 +1207,9 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
                       TTDB_STATUS_TO * 1000u,
                       TRDP_TO_SET_TO_ZERO) != TRDP_NO_ERR)
     {
+        ttiSnapFree(appHandle->pTTDB->pSnap);
         vos_memFree(appHandle->pTTDB);
+        appHandle->pTTDB = NULL;
         return TRDP_INIT_ERR;
     }
 
@@ -651,7 +1227,10 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
                         vos_dottedIP(TTDB_OP_DIR_INFO_IP),
                         TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR)
     {
+        (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle);
+        ttiSnapFree(appHandle->pTTDB->pSnap);
         vos_memFree(appHandle->pTTDB);
+        appHandle->pTTDB = NULL;
         return TRDP_INIT_ERR;
     }
     return TRDP_NO_ERR;
@@ -671,17 +1250,17 @@ EXT_DECL void tau_deInitTTI (
 {
     if (appHandle->pTTDB != NULL)
     {
-        UINT32 i;
-        for (i = 0; i < appHandle->pTTDB->noOfCachedCst; i++)
-        {
-            if (appHandle->pTTDB->cstInfo[i] != NULL)
-            {
-                vos_memFree(appHandle->pTTDB->cstInfo[i]);
-                appHandle->pTTDB->cstInfo[i] = NULL;
-            }
-        }
         (void) tlm_delListener(appHandle, appHandle->pTTDB->md101Listener);
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle);
+
+        /* no more readers are expected, free all snapshots   */
+        while (appHandle->pTTDB->pRetired != NULL)
+        {
+            TAU_TTDB_SNAP_T *pNext = appHandle->pTTDB->pRetired->pNext;
+            ttiSnapFree(appHandle->pTTDB->pRetired);
+            appHandle->pTTDB->pRetired = pNext;
+        }
+        ttiSnapFree(appHandle->pTTDB->pSnap);
         vos_memFree(appHandle->pTTDB);
         appHandle->pTTDB = NULL;
     }
@@ -705,25 +1284,30 @@ EXT_DECL TRDP_ERR_T tau_getOpTrDirectory (
     TRDP_OP_TRAIN_DIR_STATE_T   *pOpTrnDirState,
     TRDP_OP_TRAIN_DIR_T         *pOpTrnDir)
 {
+    const TAU_TTDB_SNAP_T *pSnap;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-    if (appHandle->pTTDB->opTrnDir.opCstCnt == 0 ||
-        appHandle->pTTDB->opTrnDir.opTrnTopoCnt != appHandle->opTrnTopoCnt)     /* need update? */
+    pSnap = ttiSnapAcquire(appHandle->pTTDB);
+    if (pSnap->opTrnDir.opCstCnt == 0 ||
+        pSnap->opTrnDir.opTrnTopoCnt != appHandle->opTrnTopoCnt)     /* need update? */
     {
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_OP_DIR_INFO_REQ_COMID, NULL);
         return TRDP_NODATA_ERR;
     }
     if (pOpTrnDirState != NULL)
     {
-        *pOpTrnDirState = appHandle->pTTDB->opTrnState.state;
+        *pOpTrnDirState = pSnap->opTrnState.state;
     }
     if (pOpTrnDir != NULL)
     {
-        *pOpTrnDir = appHandle->pTTDB->opTrnDir;
+        *pOpTrnDir = pSnap->opTrnDir;
     }
+    ttiSnapRelease(pSnap);
     return TRDP_NO_ERR;
 }
 
@@ -743,13 +1327,17 @@ EXT_DECL TRDP_ERR_T tau_getOpTrnDirectoryStatusInfo (
     TRDP_APP_SESSION_T              appHandle,
     TRDP_OP_TRAIN_DIR_STATUS_INFO_T *pOpTrnDirStatusInfo)
 {
+    const TAU_TTDB_SNAP_T *pSnap;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pOpTrnDirStatusInfo == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-    *pOpTrnDirStatusInfo = appHandle->pTTDB->opTrnState;
+    pSnap = ttiSnapAcquire(appHandle->pTTDB);
+    *pOpTrnDirStatusInfo = pSnap->opTrnState;
+    ttiSnapRelease(pSnap);
     return TRDP_NO_ERR;
 }
 
@@ -770,19 +1358,24 @@ EXT_DECL TRDP_ERR_T tau_getTrDirectory (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_TRAIN_DIR_T    *pTrnDir)
 {
+    const TAU_TTDB_SNAP_T *pSnap;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pTrnDir == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-    if (appHandle->pTTDB->trnDir.cstCnt == 0 ||
-        appHandle->pTTDB->trnDir.trnTopoCnt != appHandle->etbTopoCnt)     /* need update? */
+    pSnap = ttiSnapAcquire(appHandle->pTTDB);
+    if (pSnap->trnDir.cstCnt == 0 ||
+        pSnap->trnDir.trnTopoCnt != appHandle->etbTopoCnt)     /* need update? */
     {
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
         return TRDP_NODATA_ERR;
     }
-    *pTrnDir = appHandle->pTTDB->trnDir;
+    *pTrnDir = pSnap->trnDir;
+    ttiSnapRelease(pSnap);
     return TRDP_NO_ERR;
 }
 
@@ -804,6 +1397,7 @@ EXT_DECL TRDP_ERR_T tau_getStaticCstInfo (
     TRDP_CONSIST_INFO_T *pCstInfo,
     TRDP_UUID_T const   cstUUID)
 {
+    const TAU_TTDB_SNAP_T *pSnap;
     UINT32 l_index;
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
@@ -812,6 +1406,7 @@ EXT_DECL TRDP_ERR_T tau_getStaticCstInfo (
         return TRDP_PARAM_ERR;
     }
 
+    pSnap = ttiSnapAcquire(appHandle->pTTDB);
     if (cstUUID == NULL)
     {
         l_index = 0;
@@ -821,20 +1416,22 @@ EXT_DECL TRDP_ERR_T tau_getStaticCstInfo (
         /* find the consist in our cache list */
         for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                memcmp(appHandle->pTTDB->cstInfo[l_index]->cstUUID, cstUUID, sizeof(TRDP_UUID_T)) == 0)
+            if (pSnap->pCst[l_index] != NULL &&
+                memcmp(pSnap->pCst[l_index]->pCstInfo->cstUUID, cstUUID, sizeof(TRDP_UUID_T)) == 0)
             {
                 break;
             }
         }
     }
     if (l_index < TTI_CACHED_CONSISTS &&
-        appHandle->pTTDB->cstInfo[l_index] != NULL)
+        pSnap->pCst[l_index] != NULL)
     {
-        memcpy(pCstInfo, appHandle->pTTDB->cstInfo[l_index], appHandle->pTTDB->cstSize[l_index]);
+        memcpy(pCstInfo, pSnap->pCst[l_index]->pCstInfo, pSnap->pCst[l_index]->size);
+        ttiSnapRelease(pSnap);
     }
     else    /* not found, get it and return directly */
     {
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
         return TRDP_NODATA_ERR;
     }
@@ -863,28 +1460,33 @@ EXT_DECL TRDP_ERR_T tau_getTTI (
     TRDP_TRAIN_DIR_T            *pTrnDir,
     TRDP_TRAIN_NET_DIR_T        *pTrnNetDir)
 {
+    const TAU_TTDB_SNAP_T *pSnap;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL)
     {
         return TRDP_PARAM_ERR;
     }
 
+    /* all directories are taken from the same snapshot and are therefore consistent   */
+    pSnap = ttiSnapAcquire(appHandle->pTTDB);
     if (pOpTrnDirState != NULL)
     {
-        *pOpTrnDirState = appHandle->pTTDB->opTrnState.state;
+        *pOpTrnDirState = pSnap->opTrnState.state;
     }
     if (pOpTrnDir != NULL)
     {
-        *pOpTrnDir = appHandle->pTTDB->opTrnDir;
+        *pOpTrnDir = pSnap->opTrnDir;
     }
     if (pTrnDir != NULL)
     {
-        *pTrnDir = appHandle->pTTDB->trnDir;
+        *pTrnDir = pSnap->trnDir;
     }
     if (pTrnNetDir != NULL)
     {
-        *pTrnNetDir = appHandle->pTTDB->trnNetDir;
+        *pTrnNetDir = pSnap->trnNetDir;
     }
+    ttiSnapRelease(pSnap);
     return TRDP_NO_ERR;
 }
 
@@ -905,20 +1507,26 @@ EXT_DECL TRDP_ERR_T tau_getTrnCstCnt (
     TRDP_APP_SESSION_T  appHandle,
     UINT16              *pTrnCstCnt)
 {
+    const TAU_TTDB_SNAP_T *pSnap;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pTrnCstCnt == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-    if (appHandle->pTTDB->trnDir.cstCnt == 0 ||
-        appHandle->pTTDB->opTrnState.etbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
+
+    pSnap = ttiSnapAcquire(appHandle->pTTDB);
+    if (pSnap->trnDir.cstCnt == 0 ||
+        pSnap->opTrnState.etbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
     {
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
         return TRDP_NODATA_ERR;
     }
 
-    *pTrnCstCnt = appHandle->pTTDB->trnDir.cstCnt;
+    *pTrnCstCnt = pSnap->trnDir.cstCnt;
+    ttiSnapRelease(pSnap);
     return TRDP_NO_ERR;
 }
 
@@ -939,6 +1547,8 @@ EXT_DECL TRDP_ERR_T tau_getTrnVehCnt (
     TRDP_APP_SESSION_T  appHandle,
     UINT16              *pTrnVehCnt)
 {
+    const TAU_TTDB_SNAP_T *pSnap;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pTrnVehCnt == NULL)
@@ -946,14 +1556,17 @@ EXT_DECL TRDP_ERR_T tau_getTrnVehCnt (
         return TRDP_PARAM_ERR;
     }
 
-    if (appHandle->pTTDB->trnDir.cstCnt == 0 ||
-        appHandle->pTTDB->opTrnState.etbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
+    pSnap = ttiSnapAcquire(appHandle->pTTDB);
+    if (pSnap->trnDir.cstCnt == 0 ||
+        pSnap->opTrnState.etbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
     {
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
         return TRDP_NODATA_ERR;
     }
 
-    *pTrnVehCnt = appHandle->pTTDB->opTrnDir.opVehCnt;
+    *pTrnVehCnt = pSnap->opTrnDir.opVehCnt;
+    ttiSnapRelease(pSnap);
     return TRDP_NO_ERR;
 }
 
@@ -976,7 +1589,10 @@ EXT_DECL TRDP_ERR_T tau_getCstVehCnt (
     UINT16              *pCstVehCnt,
     const TRDP_LABEL_T  pCstLabel)
 {
-    UINT32 l_index;
+    const TAU_TTDB_SNAP_T *pSnap;
+    TRDP_UUID_T cstUUID;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      l_index;
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pCstVehCnt == NULL)
@@ -984,34 +1600,22 @@ EXT_DECL TRDP_ERR_T tau_getCstVehCnt (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    pSnap   = ttiSnapAcquire(appHandle->pTTDB);
+    l_index = ttiFindCst(pSnap, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        *pCstVehCnt = vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->vehCnt);
+        *pCstVehCnt = pSnap->pCst[l_index]->index.vehCnt;
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
+        ttiGetUUIDfromLabel(pSnap, cstUUID, pCstLabel);
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
         return TRDP_NODATA_ERR;
     }
-    return TRDP_NO_ERR;
+    ttiSnapRelease(pSnap);
+    return err;
 }
 
 
@@ -1032,7 +1636,10 @@ EXT_DECL TRDP_ERR_T tau_getCstFctCnt (
     UINT16              *pCstFctCnt,
     const TRDP_LABEL_T  pCstLabel)
 {
-    UINT32 l_index;
+    const TAU_TTDB_SNAP_T *pSnap;
+    TRDP_UUID_T cstUUID;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      l_index;
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pCstFctCnt == NULL)
@@ -1040,34 +1647,22 @@ EXT_DECL TRDP_ERR_T tau_getCstFctCnt (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    pSnap   = ttiSnapAcquire(appHandle->pTTDB);
+    l_index = ttiFindCst(pSnap, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        *pCstFctCnt = vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->fctCnt);
+        *pCstFctCnt = pSnap->pCst[l_index]->index.fctCnt;
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
+        ttiGetUUIDfromLabel(pSnap, cstUUID, pCstLabel);
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
         return TRDP_NODATA_ERR;
     }
-    return TRDP_NO_ERR;
+    ttiSnapRelease(pSnap);
+    return err;
 }
 
 
@@ -1093,7 +1688,10 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
     const TRDP_LABEL_T      pCstLabel,
     UINT16                  maxFctCnt)
 {
-    UINT32 l_index, l_index2;
+    const TAU_TTDB_SNAP_T *pSnap;
+    TRDP_UUID_T cstUUID;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      l_index, l_index2;
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pFctInfo == NULL ||
@@ -1102,39 +1700,30 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    pSnap   = ttiSnapAcquire(appHandle->pTTDB);
+    l_index = ttiFindCst(pSnap, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        for (l_index2 = 0; l_index2 < vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->fctCnt) &&
+        const TAU_CST_INDEX_T   *pIndex = &pSnap->pCst[l_index]->index;
+        const UINT8             *pSrc   = (const UINT8 *) pSnap->pCst[l_index]->pCstInfo + pIndex->fctOffset;
+
+        for (l_index2 = 0; l_index2 < pIndex->fctCnt &&
              l_index2 < maxFctCnt; ++l_index2)
         {
-            pFctInfo[l_index2]        = appHandle->pTTDB->cstInfo[l_index]->pFctInfoList[l_index2];
-            pFctInfo[l_index2].fctId  = vos_ntohs(pFctInfo[l_index2].fctId);
+            memcpy(&pFctInfo[l_index2], pSrc + l_index2 * sizeof(TRDP_FUNCTION_INFO_T), sizeof(TRDP_FUNCTION_INFO_T));
+            pFctInfo[l_index2].fctId = vos_ntohs(pFctInfo[l_index2].fctId);
         }
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
+        ttiGetUUIDfromLabel(pSnap, cstUUID, pCstLabel);
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
         return TRDP_NODATA_ERR;
     }
-    return TRDP_NO_ERR;
+    ttiSnapRelease(pSnap);
+    return err;
 }
 
 
@@ -1157,7 +1746,10 @@ EXT_DECL TRDP_ERR_T tau_getVehInfo (
     const TRDP_LABEL_T  pVehLabel,
     const TRDP_LABEL_T  pCstLabel)
 {
-    UINT32 l_index, l_index2;
+    const TAU_TTDB_SNAP_T *pSnap;
+    TRDP_UUID_T cstUUID;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      l_index, l_index2;
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pVehInfo == NULL)
@@ -1165,42 +1757,35 @@ EXT_DECL TRDP_ERR_T tau_getVehInfo (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
+    /* find the consist in our cache list */
+    pSnap   = ttiSnapAcquire(appHandle->pTTDB);
+    l_index = ttiFindCst(pSnap, pCstLabel);
+    if (l_index < TTI_CACHED_CONSISTS)
     {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
+        const TAU_CST_INDEX_T *pIndex = &pSnap->pCst[l_index]->index;
+
+        l_index2 = (pVehLabel == NULL) ? 0u : ttiFindCstVeh(pSnap->pCst[l_index], pVehLabel);
+        if (l_index2 < pIndex->vehCnt)
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
+            memset(pVehInfo, 0, sizeof(TRDP_VEHICLE_INFO_T));
+            memcpy(pVehInfo, (const UINT8 *) pSnap->pCst[l_index]->pCstInfo + pIndex->vehOffset[l_index2],
+                   (pIndex->vehSize[l_index2] < sizeof(TRDP_VEHICLE_INFO_T)) ?
+                   pIndex->vehSize[l_index2] : sizeof(TRDP_VEHICLE_INFO_T));
         }
-    }
-    if (l_index < TTI_CACHED_CONSISTS)
-    {
-        for (l_index2 = 0; l_index2 < vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->vehCnt); ++l_index2)
+        else
         {
-            if (pVehLabel == NULL ||
-                vos_strnicmp(pVehLabel, appHandle->pTTDB->cstInfo[l_index]->pVehInfoList[l_index2].vehId,
-                             sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                *pVehInfo = appHandle->pTTDB->cstInfo[l_index]->pVehInfoList[l_index2];
-            }
+            err = TRDP_PARAM_ERR;
         }
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
+        ttiGetUUIDfromLabel(pSnap, cstUUID, pCstLabel);
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
         return TRDP_NODATA_ERR;
     }
-    return TRDP_NO_ERR;
+    ttiSnapRelease(pSnap);
+    return err;
 }
 
 
@@ -1221,7 +1806,10 @@ EXT_DECL TRDP_ERR_T tau_getCstInfo (
     TRDP_CONSIST_INFO_T *pCstInfo,
     const TRDP_LABEL_T  pCstLabel)
 {
-    UINT32 l_index;
+    const TAU_TTDB_SNAP_T *pSnap;
+    TRDP_UUID_T cstUUID;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      l_index;
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pCstInfo == NULL)
@@ -1229,39 +1817,230 @@ EXT_DECL TRDP_ERR_T tau_getCstInfo (
         return TRDP_PARAM_ERR;
     }
 
-    if (pCstLabel == NULL)
+    /* find the consist in our cache list */
+    pSnap   = ttiSnapAcquire(appHandle->pTTDB);
+    l_index = ttiFindCst(pSnap, pCstLabel);
+    if (l_index < TTI_CACHED_CONSISTS)
     {
-        l_index = 0;
+        const TAU_CST_ENTRY_T *pEntry = pSnap->pCst[l_index];
+
+        /* copy the fixed part, the variable sized lists are available through the other getters   */
+        memset(pCstInfo, 0, sizeof(TRDP_CONSIST_INFO_T));
+        memcpy(pCstInfo, pEntry->pCstInfo,
+               (pEntry->size < offsetof(TRDP_CONSIST_INFO_T, reserved03)) ?
+               pEntry->size : offsetof(TRDP_CONSIST_INFO_T, reserved03));
+        pCstInfo->etbCnt        = pEntry->index.etbCnt;
+        pCstInfo->vehCnt        = pEntry->index.vehCnt;
+        pCstInfo->fctCnt        = pEntry->index.fctCnt;
+        pCstInfo->cltrCstCnt    = pEntry->index.cltrCstCnt;
+        pCstInfo->cstTopoCnt    = pEntry->index.cstTopoCnt;
     }
-    else
+    else    /* not found, get it and return directly */
     {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
+        ttiGetUUIDfromLabel(pSnap, cstUUID, pCstLabel);
+        ttiSnapRelease(pSnap);
+        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
+        return TRDP_NODATA_ERR;
     }
-    if (l_index < TTI_CACHED_CONSISTS)
+    ttiSnapRelease(pSnap);
+    return err;
+}
+
+
+/**********************************************************************************************************************/
+/**    Function to open a view of the consist information of a train's consist without copying it.
+ *  The view holds a reference to the current TTDB snapshot, the consist info and its precomputed offsets stay
+ *  valid until tau_closeCstView(). Nothing is copied or parsed when the lists are accessed.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[out]     pView           Pointer to the view to be returned.
+ *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR Try again
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_openCstView (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_CST_VIEW_T      *pView,
+    const TRDP_LABEL_T  pCstLabel)
+{
+    const TAU_TTDB_SNAP_T *pSnap;
+    const TAU_CST_ENTRY_T *pEntry;
+    TRDP_UUID_T cstUUID;
+    UINT32      l_index;
+    if (appHandle == NULL ||
+        appHandle->pTTDB == NULL ||
+        pView == NULL)
     {
-        *pCstInfo           = *appHandle->pTTDB->cstInfo[l_index];
-        pCstInfo->etbCnt    = vos_ntohs(pCstInfo->etbCnt);
-        pCstInfo->vehCnt    = vos_ntohs(pCstInfo->vehCnt);
-        pCstInfo->fctCnt    = vos_ntohs(pCstInfo->fctCnt);
+        return TRDP_PARAM_ERR;
     }
-    else    /* not found, get it and return directly */
+
+    memset(pView, 0, sizeof(TAU_CST_VIEW_T));
+
+    /* find the consist in our cache list */
+    pSnap   = ttiSnapAcquire(appHandle->pTTDB);
+    l_index = ttiFindCst(pSnap, pCstLabel);
+    if (l_index >= TTI_CACHED_CONSISTS)    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
+        ttiGetUUIDfromLabel(pSnap, cstUUID, pCstLabel);
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
         return TRDP_NODATA_ERR;
     }
+
+    /* the snapshot keeps the entry, the reference is released by tau_closeCstView() */
+    pEntry              = pSnap->pCst[l_index];
+    pView->pCstInfo     = pEntry->pCstInfo;
+    pView->size         = pEntry->size;
+    pView->etbCnt       = pEntry->index.etbCnt;
+    pView->vehCnt       = pEntry->index.vehCnt;
+    pView->fctCnt       = pEntry->index.fctCnt;
+    pView->cltrCstCnt   = pEntry->index.cltrCstCnt;
+    pView->cstTopoCnt   = pEntry->index.cstTopoCnt;
+    pView->pSnap        = pSnap;
+    pView->pEntry       = pEntry;
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/**    Function to release a view opened by tau_openCstView().
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *
+ */
+EXT_DECL void tau_closeCstView (
+    TAU_CST_VIEW_T *pView)
+{
+    if (pView != NULL &&
+        pView->pSnap != NULL)
+    {
+        ttiSnapRelease((const TAU_TTDB_SNAP_T *) pView->pSnap);
+        memset(pView, 0, sizeof(TAU_CST_VIEW_T));
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Function to access an ETB info of a consist view.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      etbNo           Position in the list, 0..etbCnt - 1.
+ *
+ *  @retval         ETB info in network format, NULL if out of range
+ *
+ */
+EXT_DECL const TRDP_ETB_INFO_T *tau_cstViewEtb (
+    const TAU_CST_VIEW_T    *pView,
+    UINT16                  etbNo)
+{
+    if (pView == NULL ||
+        pView->pEntry == NULL ||
+        etbNo >= pView->etbCnt)
+    {
+        return NULL;
+    }
+    return (const TRDP_ETB_INFO_T *) ((const UINT8 *) pView->pCstInfo +
+                                      ((const TAU_CST_ENTRY_T *) pView->pEntry)->index.etbOffset +
+                                      etbNo * sizeof(TRDP_ETB_INFO_T));
+}
+
+/**********************************************************************************************************************/
+/**    Function to access a vehicle info of a consist view.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      vehNo           Position in the list, 0..vehCnt - 1.
+ *
+ *  @retval         vehicle info in network format, NULL if out of range
+ *
+ */
+EXT_DECL const TRDP_VEHICLE_INFO_T *tau_cstViewVeh (
+    const TAU_CST_VIEW_T    *pView,
+    UINT16                  vehNo)
+{
+    if (pView == NULL ||
+        pView->pEntry == NULL ||
+        vehNo >= pView->vehCnt)
+    {
+        return NULL;
+    }
+    return (const TRDP_VEHICLE_INFO_T *) ((const UINT8 *) pView->pCstInfo +
+                                          ((const TAU_CST_ENTRY_T *) pView->pEntry)->index.vehOffset[vehNo]);
+}
+
+/**********************************************************************************************************************/
+/**    Function to find a vehicle info of a consist view by its label, using the vehicle label index.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      pVehLabel       Pointer to a vehicle label.
+ *
+ *  @retval         vehicle info in network format, NULL if not found
+ *
+ */
+EXT_DECL const TRDP_VEHICLE_INFO_T *tau_cstViewFindVeh (
+    const TAU_CST_VIEW_T    *pView,
+    const TRDP_LABEL_T      pVehLabel)
+{
+    UINT32 vehNo;
+
+    if (pView == NULL ||
+        pView->pEntry == NULL ||
+        pVehLabel == NULL)
+    {
+        return NULL;
+    }
+    vehNo = ttiFindCstVeh((const TAU_CST_ENTRY_T *) pView->pEntry, pVehLabel);
+    return (vehNo < pView->vehCnt) ? tau_cstViewVeh(pView, (UINT16) vehNo) : NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Function to access a function info of a consist view.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      fctNo           Position in the list, 0..fctCnt - 1.
+ *
+ *  @retval         function info in network format, NULL if out of range
+ *
+ */
+EXT_DECL const TRDP_FUNCTION_INFO_T *tau_cstViewFct (
+    const TAU_CST_VIEW_T    *pView,
+    UINT16                  fctNo)
+{
+    if (pView == NULL ||
+        pView->pEntry == NULL ||
+        fctNo >= pView->fctCnt)
+    {
+        return NULL;
+    }
+    return (const TRDP_FUNCTION_INFO_T *) ((const UINT8 *) pView->pCstInfo +
+                                           ((const TAU_CST_ENTRY_T *) pView->pEntry)->index.fctOffset +
+                                           fctNo * sizeof(TRDP_FUNCTION_INFO_T));
+}
+
+/**********************************************************************************************************************/
+/**    Function to access a closed train consist info of a consist view.
+ *
+ *  @param[in]      pView           Pointer to the view.
+ *  @param[in]      cltrCstNo       Position in the list, 0..cltrCstCnt - 1.
+ *
+ *  @retval         closed train consist info in network format, NULL if out of range
+ *
+ */
+EXT_DECL const TRDP_CLTR_CST_INFO_T *tau_cstViewCltrCst (
+    const TAU_CST_VIEW_T    *pView,
+    UINT16                  cltrCstNo)
+{
+    if (pView == NULL ||
+        pView->pEntry == NULL ||
+        cltrCstNo >= pView->cltrCstCnt)
+    {
+        return NULL;
+    }
+    return (const TRDP_CLTR_CST_INFO_T *) ((const UINT8 *) pView->pCstInfo +
+                                           ((const TAU_CST_ENTRY_T *) pView->pEntry)->index.cltrCstOffset +
+                                           cltrCstNo * sizeof(TRDP_CLTR_CST_INFO_T));
+}
+
 
 /* ---------------------------------------------------------------------------- */
 
@@ -1292,8 +2071,10 @@ EXT_DECL TRDP_ERR_T tau_getVehOrient (
     TRDP_LABEL_T        pVehLabel,
     TRDP_LABEL_T        pCstLabel)
 {
-    UINT32 l_index, l_index2, l_index3;
-
+    const TAU_TTDB_SNAP_T *pSnap;
+    TRDP_UUID_T cstUUID;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      l_index, l_index2, l_index3;
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pVehOrient == NULL ||
@@ -1307,52 +2088,37 @@ EXT_DECL TRDP_ERR_T tau_getVehOrient (
     *pVehOrient = 0;
     *pCstOrient = 0;
 
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
+    /* find the consist in our cache list */
+    pSnap   = ttiSnapAcquire(appHandle->pTTDB);
+    l_index = ttiFindCst(pSnap, pCstLabel);
     if (l_index < TTI_CACHED_CONSISTS)
     {
-        /* Search the vehicles in the OP_TRAIN_DIR for a matching vehID */
+        /* Search the consist in the OP_TRAIN_DIR, its first vehicle is indexed by opCstNo */
 
-        for (l_index2 = 0; l_index2 < appHandle->pTTDB->opTrnDir.opCstCnt; l_index2++)
+        for (l_index2 = 0; l_index2 < pSnap->opTrnDir.opCstCnt; l_index2++)
         {
-            if (vos_strnicmp((CHAR8 *) appHandle->pTTDB->opTrnDir.opCstList[l_index2].cstUUID,
-                             (CHAR8 *) appHandle->pTTDB->cstInfo[l_index]->cstUUID, sizeof(TRDP_UUID_T)) == 0)
+            if (memcmp(pSnap->opTrnDir.opCstList[l_index2].cstUUID,
+                       pSnap->pCst[l_index]->pCstInfo->cstUUID, sizeof(TRDP_UUID_T)) == 0)
             {
                 /* consist found   */
-                *pCstOrient = appHandle->pTTDB->opTrnDir.opCstList[l_index2].opCstOrient;
+                *pCstOrient = pSnap->opTrnDir.opCstList[l_index2].opCstOrient;
 
-                for (l_index3 = 0; l_index3 < appHandle->pTTDB->opTrnDir.opVehCnt; l_index3++)
+                l_index3 = pSnap->opCstFirstVeh[pSnap->opTrnDir.opCstList[l_index2].opCstNo];
+                if (l_index3 != 0u)
                 {
-                    if (appHandle->pTTDB->opTrnDir.opVehList[l_index3].ownOpCstNo ==
-                        appHandle->pTTDB->opTrnDir.opCstList[l_index2].opCstNo)
-                    {
-                        *pVehOrient = appHandle->pTTDB->opTrnDir.opVehList[l_index3].vehOrient;
-                        return TRDP_NO_ERR;
-                    }
+                    *pVehOrient = pSnap->opTrnDir.opVehList[l_index3 - 1u].vehOrient;
                 }
+                break;
             }
         }
     }
     else    /* not found, get it and return directly */
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
+        ttiGetUUIDfromLabel(pSnap, cstUUID, pCstLabel);
+        ttiSnapRelease(pSnap);
         ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
         return TRDP_NODATA_ERR;
     }
-    return TRDP_NO_ERR;
+    ttiSnapRelease(pSnap);
+    return err;
 }
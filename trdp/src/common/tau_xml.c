@@ -65,34 +65,249 @@
 #define TRDP_SDT_DEFAULT_CMTHR  10u                                 /**< Default SDT chan. monitoring threshold */
 #endif
 
+#define TAU_XML_CACHE_MAGIC     "TRDPXMLC"                          /**< Binary configuration cache signature   */
+#define TAU_XML_CACHE_VERSION   1u                                  /**< Binary configuration cache format      */
+
 /*******************************************************************************
  * TYPEDEFS
  */
 
+/** Name to key mapping, tables are sorted case-insensitively by name for xmlLookup() */
+typedef struct
+{
+    const CHAR8 *pName;
+    UINT32      key;
+} TAU_XML_KEY_T;
+
+/** Attributes of telegram and dataset definitions */
+typedef enum
+{
+    XML_ATTR_UNKNOWN = 0u,
+    XML_ATTR_ARRAY_SIZE,
+    XML_ATTR_CALLBACK,
+    XML_ATTR_CM_THR,
+    XML_ATTR_COM_ID,
+    XML_ATTR_COM_PARAMETER_ID,
+    XML_ATTR_CONFIRM_TIMEOUT,
+    XML_ATTR_CREATE,
+    XML_ATTR_CYCLE,
+    XML_ATTR_DATA_SET_ID,
+    XML_ATTR_ID,
+    XML_ATTR_MARSHALL,
+    XML_ATTR_N_GUARD,
+    XML_ATTR_N_RXSAFE,
+    XML_ATTR_OFFSET,
+    XML_ATTR_OFFSET_ADDRESS,
+    XML_ATTR_PROTOCOL,
+    XML_ATTR_REDUNDANT,
+    XML_ATTR_REPLY_TIMEOUT,
+    XML_ATTR_RX_PERIOD,
+    XML_ATTR_SCALE,
+    XML_ATTR_SMI1,
+    XML_ATTR_SMI2,
+    XML_ATTR_TIMEOUT,
+    XML_ATTR_TX_PERIOD,
+    XML_ATTR_TYPE,
+    XML_ATTR_UDV,
+    XML_ATTR_UNIT,
+    XML_ATTR_URI,
+    XML_ATTR_URI1,
+    XML_ATTR_URI2,
+    XML_ATTR_VALIDITY_BEHAVIOR
+} TAU_XML_ATTR_T;
+
+/** Header of the binary configuration cache */
+typedef struct
+{
+    CHAR8   magic[8];       /**< TAU_XML_CACHE_MAGIC */
+    UINT32  layout;         /**< structure layout of the writing build */
+    UINT32  xmlSize;        /**< size of the XML file */
+    UINT32  xmlCrc;         /**< checksum of the XML file */
+    UINT32  dataSize;       /**< size of the data following the header */
+    UINT32  dataCrc;        /**< checksum of the data */
+} TAU_XML_CACHE_HDR_T;
+
+/** Read/write position in a serialized configuration */
+typedef struct
+{
+    UINT8   *pBuffer;
+    UINT32  size;
+    UINT32  pos;
+    BOOL8   error;
+} TAU_XML_STREAM_T;
+
+/** Position of a dataset in the text of a source */
+typedef struct
+{
+    UINT32  id;             /**< dataset id */
+    UINT32  offset;         /**< offset of the dataset behind its tag name */
+} TAU_XML_DS_ENTRY_T;
+
+/** Dataset definitions kept as text, see tau_readXmlDatasetIndex() */
+struct TAU_XML_DS_SOURCE
+{
+    UINT32              numEntries; /**< number of datasets */
+    TAU_XML_DS_ENTRY_T  *pEntry;    /**< positions of the datasets, sorted by id */
+    UINT32              size;       /**< size of the text */
+    CHAR8               *pText;     /**< text of the dataset list */
+};
+
 
 /******************************************************************************
  *   Locals
  */
 
+static const TAU_XML_KEY_T cTypeTable[] =
+{
+    {"ANTIVALENT8", TRDP_BITSET8},
+    {"BITSET8", TRDP_BITSET8},
+    {"BOOL8", TRDP_BITSET8},
+    {"CHAR8", TRDP_CHAR8},
+    {"INT16", TRDP_INT16},
+    {"INT32", TRDP_INT32},
+    {"INT64", TRDP_INT64},
+    {"INT8", TRDP_INT8},
+    {"REAL32", TRDP_REAL32},
+    {"REAL64", TRDP_REAL64},
+    {"TIMEDATE32", TRDP_TIMEDATE32},
+    {"TIMEDATE48", TRDP_TIMEDATE48},
+    {"TIMEDATE64", TRDP_TIMEDATE64},
+    {"UINT16", TRDP_UINT16},
+    {"UINT32", TRDP_UINT32},
+    {"UINT64", TRDP_UINT64},
+    {"UINT8", TRDP_UINT8},
+    {"UTF16", TRDP_UTF16},
+    {"UTF8", TRDP_CHAR8}
+};
+
+static const TAU_XML_KEY_T cAttrTable[] =
+{
+    {"array-size", XML_ATTR_ARRAY_SIZE},
+    {"callback", XML_ATTR_CALLBACK},
+    {"cm-thr", XML_ATTR_CM_THR},
+    {"com-id", XML_ATTR_COM_ID},
+    {"com-parameter-id", XML_ATTR_COM_PARAMETER_ID},
+    {"confirm-timeout", XML_ATTR_CONFIRM_TIMEOUT},
+    {"create", XML_ATTR_CREATE},
+    {"cycle", XML_ATTR_CYCLE},
+    {"data-set-id", XML_ATTR_DATA_SET_ID},
+    {"id", XML_ATTR_ID},
+    {"marshall", XML_ATTR_MARSHALL},
+    {"n-guard", XML_ATTR_N_GUARD},
+    {"n-rxsafe", XML_ATTR_N_RXSAFE},
+    {"offset", XML_ATTR_OFFSET},
+    {"offset-address", XML_ATTR_OFFSET_ADDRESS},
+    {"protocol", XML_ATTR_PROTOCOL},
+    {"redundant", XML_ATTR_REDUNDANT},
+    {"reply-timeout", XML_ATTR_REPLY_TIMEOUT},
+    {"rx-period", XML_ATTR_RX_PERIOD},
+    {"scale", XML_ATTR_SCALE},
+    {"smi1", XML_ATTR_SMI1},
+    {"smi2", XML_ATTR_SMI2},
+    {"timeout", XML_ATTR_TIMEOUT},
+    {"tx-period", XML_ATTR_TX_PERIOD},
+    {"type", XML_ATTR_TYPE},
+    {"udv", XML_ATTR_UDV},
+    {"unit", XML_ATTR_UNIT},
+    {"uri", XML_ATTR_URI},
+    {"uri1", XML_ATTR_URI1},
+    {"uri2", XML_ATTR_URI2},
+    {"validity-behavior", XML_ATTR_VALIDITY_BEHAVIOR}
+};
+
+/*
+ * Binary search of a name in a sorted key table, returns 0 if not found
+ */
+static UINT32 xmlLookup (
+    const TAU_XML_KEY_T *pTable,
+    UINT32              count,
+    const CHAR8         *pName)
+{
+    UINT32  lo  = 0u;
+    UINT32  hi  = count;
+
+    while (lo < hi)
+    {
+        UINT32  mid = (lo + hi) / 2u;
+        INT32   cmp = vos_strnicmp(pName, pTable[mid].pName, MAX_TOK_LEN);
+
+        if (cmp == 0)
+        {
+            return pTable[mid].key;
+        }
+        if (cmp < 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1u;
+        }
+    }
+    return 0u;
+}
+
+/*
+ * Get attribute key
+ */
+static TAU_XML_ATTR_T xmlAttr (const CHAR8 *pAttribute)
+{
+    return (TAU_XML_ATTR_T) xmlLookup(cAttrTable, (UINT32) (sizeof(cAttrTable) / sizeof(cAttrTable[0])), pAttribute);
+}
+
 /*
  * Get type value
  */
 static TRDP_DATA_TYPE_T string2type (const CHAR8 *pTypeStr)
 {
-    CHAR8       *p;
-    const CHAR8 tokenList[] =
-        "01 BITSET8 01 BOOL8 01 ANTIVALENT8 02 CHAR8 02 UTF8 03 UTF16 04 INT8 05 INT16 06 INT32 07 INT64 08 UINT8"
-        " 09 UINT16 10 UINT32 11 UINT64 12 REAL32 13 REAL64 14 TIMEDATE32 15 TIMEDATE48 16 TIMEDATE64";
+    return (TRDP_DATA_TYPE_T) xmlLookup(cTypeTable, (UINT32) (sizeof(cTypeTable) / sizeof(cTypeTable[0])), pTypeStr);
+}
+
+/*
+ * Read the attributes of an <sdt-parameter> tag
+ */
+static void readSdtPar (
+    XML_HANDLE_T    *pXML,
+    TRDP_SDT_PAR_T  *pSdtPar)
+{
+    CHAR8   attribute[MAX_TOK_LEN];
+    CHAR8   value[MAX_TOK_LEN];
+    UINT32  valueInt;
 
-    p = (CHAR8*) strstr(tokenList, pTypeStr);
-    if (p != NULL)
+    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
     {
-        return (TRDP_DATA_TYPE_T) strtol(p - 3u, NULL, 10);
+        switch (xmlAttr(attribute))
+        {
+            case XML_ATTR_SMI1:
+                pSdtPar->smi1 = valueInt;
+                break;
+            case XML_ATTR_SMI2:
+                pSdtPar->smi2 = valueInt;
+                break;
+            case XML_ATTR_UDV:
+                pSdtPar->udv = (UINT16) valueInt;
+                break;
+            case XML_ATTR_RX_PERIOD:
+                pSdtPar->rxPeriod = (UINT16) valueInt;
+                break;
+            case XML_ATTR_TX_PERIOD:
+                pSdtPar->txPeriod = (UINT16) valueInt;
+                break;
+            case XML_ATTR_N_RXSAFE:
+                pSdtPar->nrxSafe = (UINT8) valueInt;
+                break;
+            case XML_ATTR_N_GUARD:
+                pSdtPar->nGuard = (UINT16) valueInt;
+                break;
+            case XML_ATTR_CM_THR:
+                pSdtPar->cmThr = valueInt;
+                break;
+            default:
+                break;
+        }
     }
-    return TRDP_INVALID;
 }
 
-
 /*
  * Set default values to device parameters
  */
@@ -112,6 +327,7 @@ static void setDefaultDeviceValues (
         pMemConfig->size    = 0u;
         pMemConfig->p       = NULL;
         memcpy(pMemConfig->prealloc, defaultPrealloc, sizeof(defaultPrealloc));
+        memset(pMemConfig->blockSize, 0, sizeof(pMemConfig->blockSize));
     }
     /*  Default debug parameters*/
     if (pDbgConfig)
@@ -159,6 +375,11 @@ static void setDefaultInterfaceValues (
         pProcessConfig->cycleTime   = TRDP_PROCESS_DEFAULT_CYCLE_TIME;
         pProcessConfig->options     = TRDP_PROCESS_DEFAULT_OPTIONS;
         pProcessConfig->priority    = TRDP_PROCESS_DEFAULT_PRIORITY;
+        pProcessConfig->busyPollBudget  = 0u;
+        pProcessConfig->pdRcvShards     = 0u;
+        pProcessConfig->cbWorkers       = 0u;
+        pProcessConfig->budgetFrames    = 0u;
+        pProcessConfig->budgetTime      = 0u;
     }
 
     /*  Default Pd configuration    */
@@ -190,6 +411,7 @@ static void setDefaultInterfaceValues (
         pMdConfig->tcpPort              = TRDP_MD_TCP_PORT;
         pMdConfig->udpPort              = TRDP_MD_UDP_PORT;
         pMdConfig->maxNumSessions       = TRDP_MD_MAX_NUM_SESSIONS;
+        pMdConfig->maxNumIdleConn       = 0u;
     }
 }
 
@@ -257,39 +479,39 @@ static TRDP_ERR_T readTelegramDef (
 
     while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
     {
-        if (vos_strnicmp(attribute, "com-id", MAX_TOK_LEN) == 0)
-        {
-            pExchgParam->comId = valueInt;
-        }
-        else if (vos_strnicmp(attribute, "data-set-id", MAX_TOK_LEN) == 0)
+        switch (xmlAttr(attribute))
         {
-            pExchgParam->datasetId = valueInt;
-        }
-        else if (vos_strnicmp(attribute, "com-parameter-id", MAX_TOK_LEN) == 0)
-        {
-            pExchgParam->comParId = valueInt;
-        }
-        else if (vos_strnicmp(attribute, "type", MAX_TOK_LEN) == 0)
-        {
-            if (vos_strnicmp("sink", value, TRDP_MAX_LABEL_LEN) == 0)
-            {
-                pExchgParam->type = TRDP_EXCHG_SINK;
-            }
-            else if (vos_strnicmp("source", value, TRDP_MAX_LABEL_LEN) == 0)
-            {
-                pExchgParam->type = TRDP_EXCHG_SOURCE;
-            }
-            else if (vos_strnicmp("source-sink", value, TRDP_MAX_LABEL_LEN) == 0)
-            {
-                pExchgParam->type = TRDP_EXCHG_SOURCESINK;
-            }
-        }
-        else if (vos_strnicmp(attribute, "create", MAX_TOK_LEN) == 0)
-        {
-            if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
-            {
-                pExchgParam->create = TRUE;
-            }
+            case XML_ATTR_COM_ID:
+                pExchgParam->comId = valueInt;
+                break;
+            case XML_ATTR_DATA_SET_ID:
+                pExchgParam->datasetId = valueInt;
+                break;
+            case XML_ATTR_COM_PARAMETER_ID:
+                pExchgParam->comParId = valueInt;
+                break;
+            case XML_ATTR_TYPE:
+                if (vos_strnicmp("sink", value, TRDP_MAX_LABEL_LEN) == 0)
+                {
+                    pExchgParam->type = TRDP_EXCHG_SINK;
+                }
+                else if (vos_strnicmp("source", value, TRDP_MAX_LABEL_LEN) == 0)
+                {
+                    pExchgParam->type = TRDP_EXCHG_SOURCE;
+                }
+                else if (vos_strnicmp("source-sink", value, TRDP_MAX_LABEL_LEN) == 0)
+                {
+                    pExchgParam->type = TRDP_EXCHG_SOURCESINK;
+                }
+                break;
+            case XML_ATTR_CREATE:
+                if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
+                {
+                    pExchgParam->create = TRUE;
+                }
+                break;
+            default:
+                break;
         }
     }
 
@@ -311,45 +533,45 @@ static TRDP_ERR_T readTelegramDef (
             {
                 while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
                 {
-                    if (vos_strnicmp(attribute, "reply-timeout", MAX_TOK_LEN) == 0)
-                    {
-                        pExchgParam->pMdPar->replyTimeout = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "confirm-timeout", MAX_TOK_LEN) == 0)
-                    {
-                        pExchgParam->pMdPar->confirmTimeout = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "marshall", MAX_TOK_LEN) == 0)
-                    {
-                        if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
-                        {
-                            pExchgParam->pMdPar->flags  |= TRDP_FLAGS_MARSHALL;
-                            pExchgParam->pMdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
-                        }
-                    }
-                    else if (vos_strnicmp(attribute, "callback", MAX_TOK_LEN) == 0)
-                    {
-                        if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
-                        {
-                            pExchgParam->pMdPar->flags  |= TRDP_FLAGS_CALLBACK;
-                            pExchgParam->pMdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
-                        }
-                        else if (vos_strnicmp("always", value, TRDP_MAX_LABEL_LEN) == 0)
-                        {
-                            pExchgParam->pMdPar->flags  |= TRDP_FLAGS_FORCE_CB;
-                            pExchgParam->pMdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
-                        }
-                    }
-                    else if (vos_strnicmp(attribute, "protocol", MAX_TOK_LEN) == 0)
+                    switch (xmlAttr(attribute))
                     {
-                        if (vos_strnicmp("TCP", value, TRDP_MAX_LABEL_LEN) == 0)
-                        {
-                            pExchgParam->pMdPar->flags |= TRDP_FLAGS_TCP;
-                        }
-                        else
-                        {
-                            pExchgParam->pMdPar->flags &= (TRDP_FLAGS_T) ~TRDP_FLAGS_TCP;
-                        }
+                        case XML_ATTR_REPLY_TIMEOUT:
+                            pExchgParam->pMdPar->replyTimeout = valueInt;
+                            break;
+                        case XML_ATTR_CONFIRM_TIMEOUT:
+                            pExchgParam->pMdPar->confirmTimeout = valueInt;
+                            break;
+                        case XML_ATTR_MARSHALL:
+                            if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pMdPar->flags  |= TRDP_FLAGS_MARSHALL;
+                                pExchgParam->pMdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
+                            }
+                            break;
+                        case XML_ATTR_CALLBACK:
+                            if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pMdPar->flags  |= TRDP_FLAGS_CALLBACK;
+                                pExchgParam->pMdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
+                            }
+                            else if (vos_strnicmp("always", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pMdPar->flags  |= TRDP_FLAGS_FORCE_CB;
+                                pExchgParam->pMdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
+                            }
+                            break;
+                        case XML_ATTR_PROTOCOL:
+                            if (vos_strnicmp("TCP", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pMdPar->flags |= TRDP_FLAGS_TCP;
+                            }
+                            else
+                            {
+                                pExchgParam->pMdPar->flags &= (TRDP_FLAGS_T) ~TRDP_FLAGS_TCP;
+                            }
+                            break;
+                        default:
+                            break;
                     }
                 }
             }
@@ -366,53 +588,56 @@ static TRDP_ERR_T readTelegramDef (
             {
                 while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
                 {
-                    if (vos_strnicmp(attribute, "cycle", MAX_TOK_LEN) == 0)
-                    {
-                        pExchgParam->pPdPar->cycle = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "timeout", MAX_TOK_LEN) == 0)
-                    {
-                        pExchgParam->pPdPar->timeout = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "marshall", MAX_TOK_LEN) == 0)
-                    {
-                        if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
-                        {
-                            pExchgParam->pPdPar->flags  |= TRDP_FLAGS_MARSHALL;
-                            pExchgParam->pPdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
-                        }
-                    }
-                    else if (vos_strnicmp(attribute, "callback", MAX_TOK_LEN) == 0)
+                    switch (xmlAttr(attribute))
                     {
-                        if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
-                        {
-                            pExchgParam->pPdPar->flags  |= TRDP_FLAGS_CALLBACK;
-                            pExchgParam->pPdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
-                        }
-                        else if (vos_strnicmp("always", value, TRDP_MAX_LABEL_LEN) == 0)
-                        {
-                            pExchgParam->pPdPar->flags  |= TRDP_FLAGS_FORCE_CB;
-                            pExchgParam->pPdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
-                        }
-                    }
-                    else if (vos_strnicmp(attribute, "redundant", MAX_TOK_LEN) == 0)
-                    {
-                        pExchgParam->pPdPar->redundant = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "validity-behavior", MAX_TOK_LEN) == 0)
-                    {
-                        if (vos_strnicmp("keep", value, TRDP_MAX_LABEL_LEN) == 0)
-                        {
-                            pExchgParam->pPdPar->toBehav |= TRDP_TO_KEEP_LAST_VALUE;
-                        }
-                        else
-                        {
-                            pExchgParam->pPdPar->toBehav |= TRDP_TO_SET_TO_ZERO;
-                        }
-                    }
-                    else if (vos_strnicmp(attribute, "offset-address", MAX_TOK_LEN) == 0)
-                    {
-                        pExchgParam->pPdPar->offset = (UINT16) valueInt;
+                        case XML_ATTR_CYCLE:
+                            pExchgParam->pPdPar->cycle = valueInt;
+                            break;
+                        case XML_ATTR_TIMEOUT:
+                            pExchgParam->pPdPar->timeout = valueInt;
+                            break;
+                        case XML_ATTR_MARSHALL:
+                            if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pPdPar->flags  |= TRDP_FLAGS_MARSHALL;
+                                pExchgParam->pPdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
+                            }
+                            break;
+                        case XML_ATTR_CALLBACK:
+                            if (vos_strnicmp("on", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pPdPar->flags  |= TRDP_FLAGS_CALLBACK;
+                                pExchgParam->pPdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
+                            }
+                            else if (vos_strnicmp("always", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pPdPar->flags  |= TRDP_FLAGS_FORCE_CB;
+                                pExchgParam->pPdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
+                            }
+                            else if (vos_strnicmp("latest", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pPdPar->flags  |= TRDP_FLAGS_CALLBACK | TRDP_FLAGS_PD_LATEST;
+                                pExchgParam->pPdPar->flags  &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
+                            }
+                            break;
+                        case XML_ATTR_REDUNDANT:
+                            pExchgParam->pPdPar->redundant = valueInt;
+                            break;
+                        case XML_ATTR_VALIDITY_BEHAVIOR:
+                            if (vos_strnicmp("keep", value, TRDP_MAX_LABEL_LEN) == 0)
+                            {
+                                pExchgParam->pPdPar->toBehav |= TRDP_TO_KEEP_LAST_VALUE;
+                            }
+                            else
+                            {
+                                pExchgParam->pPdPar->toBehav |= TRDP_TO_SET_TO_ZERO;
+                            }
+                            break;
+                        case XML_ATTR_OFFSET_ADDRESS:
+                            pExchgParam->pPdPar->offset = (UINT32) valueInt;
+                            break;
+                        default:
+                            break;
                     }
                 }
             }
@@ -501,41 +726,7 @@ static TRDP_ERR_T readTelegramDef (
                     return TRDP_MEM_ERR;
                 }
 
-                while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                {
-                    if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
-                    {
-                        pSrc->pSdtPar->smi1 = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
-                    {
-                        pSrc->pSdtPar->smi2 = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "udv", MAX_TOK_LEN) == 0)
-                    {
-                        pSrc->pSdtPar->udv = (UINT16) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "rx-period", MAX_TOK_LEN) == 0)
-                    {
-                        pSrc->pSdtPar->rxPeriod = (UINT16) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "tx-period", MAX_TOK_LEN) == 0)
-                    {
-                        pSrc->pSdtPar->txPeriod = (UINT16) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "n-rxsafe", MAX_TOK_LEN) == 0)
-                    {
-                        pSrc->pSdtPar->nrxSafe = (UINT8) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "n-guard", MAX_TOK_LEN) == 0)
-                    {
-                        pSrc->pSdtPar->nGuard = (UINT16) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "cm-thr", MAX_TOK_LEN) == 0)
-                    {
-                        pSrc->pSdtPar->cmThr = valueInt;
-                    }
-                }
+                readSdtPar(pXML, pSrc->pSdtPar);
             }
             trdp_XMLLeave(pXML);
             if (pSrc != NULL)
@@ -612,41 +803,7 @@ static TRDP_ERR_T readTelegramDef (
                     return TRDP_MEM_ERR;
                 }
 
-                while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                {
-                    if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
-                    {
-                        pDest->pSdtPar->smi1 = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
-                    {
-                        pDest->pSdtPar->smi2 = valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "udv", MAX_TOK_LEN) == 0)
-                    {
-                        pDest->pSdtPar->udv = (UINT16) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "rx-period", MAX_TOK_LEN) == 0)
-                    {
-                        pDest->pSdtPar->rxPeriod = (UINT16) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "tx-period", MAX_TOK_LEN) == 0)
-                    {
-                        pDest->pSdtPar->txPeriod = (UINT16) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "n-rxsafe", MAX_TOK_LEN) == 0)
-                    {
-                        pDest->pSdtPar->nrxSafe = (UINT8) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "n-guard", MAX_TOK_LEN) == 0)
-                    {
-                        pDest->pSdtPar->nGuard = (UINT16) valueInt;
-                    }
-                    else if (vos_strnicmp(attribute, "cm-thr", MAX_TOK_LEN) == 0)
-                    {
-                        pDest->pSdtPar->cmThr = valueInt;
-                    }
-                }
+                readSdtPar(pXML, pDest->pSdtPar);
             }
             trdp_XMLLeave(pXML);
             if (pDest != NULL)
@@ -747,17 +904,100 @@ static TRDP_ERR_T readXmlDatasetMap (
 
 }
 
+/**********************************************************************************************************************/
+/**    Read one dataset, the parser stands behind the data-set tag.
+ *
+ *  @param[in]      pXML                XML parser
+ *  @param[out]     ppDataset           Returns the dataset, allocated in one block with its elements
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+static TRDP_ERR_T readXmlDataset (
+    XML_HANDLE_T    *pXML,
+    TRDP_DATASET_T  * *ppDataset)
+{
+    CHAR8           attribute[MAX_TOK_LEN];
+    CHAR8           value[MAX_TOK_LEN];
+    UINT32          valueInt;
+    UINT32          count;
+    UINT32          i = 0u;
+    TRDP_DATASET_T  *pDataset;
+
+    trdp_XMLEnter(pXML);
+    count = (UINT32) trdp_XMLCountStartTag(pXML, "element");
+
+    /* Allocate the dataset element */
+    pDataset = (TRDP_DATASET_T *)vos_memAlloc(count * sizeof(TRDP_DATASET_ELEMENT_T) + sizeof(TRDP_DATASET_T));
+    *ppDataset = pDataset;
+
+    if (pDataset == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR,
+                     "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
+                     (unsigned long) (count * sizeof(TRDP_DATASET_ELEMENT_T) + sizeof(TRDP_DATASET_T)));
+        return TRDP_MEM_ERR;
+    }
+
+    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+    {
+        if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
+        {
+            pDataset->id = valueInt;
+        }
+    }
+
+    while ((i < count) && (trdp_XMLSeekStartTag(pXML, "element") == 0))
+    {
+        pDataset->pElement[i].size = 1;   /* default  */
+        while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+        {
+            switch (xmlAttr(attribute))
+            {
+                case XML_ATTR_TYPE:
+                    if (valueInt == 0)
+                    {
+                        pDataset->pElement[i].type = string2type(value);
+                    }
+                    else
+                    {
+                        pDataset->pElement[i].type = valueInt;
+                    }
+                    break;
+                case XML_ATTR_ARRAY_SIZE:
+                    pDataset->pElement[i].size = valueInt;
+                    break;
+                case XML_ATTR_UNIT:
+                    pDataset->pElement[i].unit = (CHAR8 *) vos_memAlloc((UINT32) strlen(value) + 1u);
+                    if (pDataset->pElement[i].unit == NULL)
+                    {
+                        return TRDP_MEM_ERR;
+                    }
+                    vos_strncpy(pDataset->pElement[i].unit, value, (UINT32) strlen(value) + 1u);
+                    break;
+                case XML_ATTR_SCALE:
+                    pDataset->pElement[i].scale = (REAL32) strtod(value, NULL);
+                    break;
+                case XML_ATTR_OFFSET:
+                    pDataset->pElement[i].offset = (INT32) valueInt;
+                    break;
+                default:
+                    break;
+            }
+        }
+        pDataset->numElement++;
+        i++;
+    }
+    trdp_XMLLeave(pXML);
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 static TRDP_ERR_T readXmlDatasets (
     XML_HANDLE_T        *pXML,
     UINT32              *pNumDataset,
     papTRDP_DATASET_T   papDataset)
 {
-    /* CHAR8   tag[MAX_TAG_LEN]; */
-    CHAR8   attribute[MAX_TOK_LEN];
-    CHAR8   value[MAX_TOK_LEN];
-    UINT32  valueInt;
-
     trdp_XMLRewind(pXML);
 
     trdp_XMLEnter(pXML);
@@ -790,80 +1030,574 @@ static TRDP_ERR_T readXmlDatasets (
             /* Read the interface params */
             for (idx = 0; idx < *pNumDataset && trdp_XMLSeekStartTag(pXML, "data-set") == 0; idx++)
             {
-                UINT32 i = 0u;
-                trdp_XMLEnter(pXML);
-                count = (UINT32) trdp_XMLCountStartTag(pXML, "element");
-
-                /* Allocate the dataset element */
-                (*papDataset)[idx] =
-                    (TRDP_DATASET_T *)vos_memAlloc(count * sizeof(TRDP_DATASET_ELEMENT_T) + sizeof(TRDP_DATASET_T));
-
-                if ((*papDataset)[idx] == NULL)
+                if (readXmlDataset(pXML, &(*papDataset)[idx]) != TRDP_NO_ERR)
                 {
-                    vos_printLog(VOS_LOG_ERROR,
-                                 "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
-                                 (unsigned long) (count * sizeof(TRDP_DATASET_ELEMENT_T) + sizeof(TRDP_DATASET_T)));
                     return TRDP_MEM_ERR;
                 }
+            }
+        }
+        trdp_XMLLeave(pXML);
+    }
+    trdp_XMLLeave(pXML);
+    return TRDP_NO_ERR;
+}
 
-                while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+/*  Binary configuration cache, see tau_loadXmlConfig()  */
+
+/**********************************************************************************************************************/
+/**    Return a stamp of the structure layout, a cache written by a different build is rejected.
+ *
+ *  @retval         layout stamp
+ */
+static UINT32 xmlCacheLayout (void)
+{
+    const UINT32 sizes[] =
+    {
+        TAU_XML_CACHE_VERSION,
+        (UINT32) sizeof(TRDP_XML_CONFIG_T),
+        (UINT32) sizeof(TRDP_XML_IF_T),
+        (UINT32) sizeof(TRDP_EXCHG_PAR_T),
+        (UINT32) sizeof(TRDP_DEST_T),
+        (UINT32) sizeof(TRDP_SRC_T),
+        (UINT32) sizeof(TRDP_SDT_PAR_T),
+        (UINT32) sizeof(TRDP_PD_PAR_T),
+        (UINT32) sizeof(TRDP_MD_PAR_T),
+        (UINT32) sizeof(TRDP_DATASET_T),
+        (UINT32) sizeof(TRDP_DATASET_ELEMENT_T),
+        (UINT32) sizeof(void *)
+    };
+
+    return vos_crc32(INITFCS, (const UINT8 *) sizes, (UINT32) sizeof(sizes));
+}
+
+/**********************************************************************************************************************/
+/**    Append data to the cache stream, the stream buffer grows as needed.
+ *
+ *  @param[in]      pStream           Cache stream
+ *  @param[in]      pData             Data to append
+ *  @param[in]      size              Size of data
+ */
+static void xmlCachePut (
+    TAU_XML_STREAM_T    *pStream,
+    const void          *pData,
+    UINT32              size)
+{
+    if ((pStream->error == TRUE) || (size == 0u))
+    {
+        return;
+    }
+    if (pStream->pos + size > pStream->size)
+    {
+        UINT32  newSize = (pStream->size == 0u) ? 4096u : pStream->size;
+        UINT8   *pNew;
+
+        while (pStream->pos + size > newSize)
+        {
+            newSize *= 2u;
+        }
+        pNew = (UINT8 *) vos_memAlloc(newSize);
+        if (pNew == NULL)
+        {
+            pStream->error = TRUE;
+            return;
+        }
+        if (pStream->pBuffer != NULL)
+        {
+            memcpy(pNew, pStream->pBuffer, pStream->pos);
+            vos_memFree(pStream->pBuffer);
+        }
+        pStream->pBuffer    = pNew;
+        pStream->size       = newSize;
+    }
+    memcpy(pStream->pBuffer + pStream->pos, pData, size);
+    pStream->pos += size;
+}
+
+/**********************************************************************************************************************/
+/**    Append a string to the cache stream, NULL is kept.
+ *
+ *  @param[in]      pStream           Cache stream
+ *  @param[in]      pStr              String or NULL
+ */
+static void xmlCachePutStr (
+    TAU_XML_STREAM_T    *pStream,
+    const CHAR8         *pStr)
+{
+    UINT32 len = (pStr == NULL) ? 0u : (UINT32) strlen(pStr) + 1u;
+
+    xmlCachePut(pStream, &len, sizeof(len));
+    xmlCachePut(pStream, pStr, len);
+}
+
+/**********************************************************************************************************************/
+/**    Take data from the cache stream.
+ *
+ *  @param[in]      pStream           Cache stream
+ *  @param[out]     pData             Data read
+ *  @param[in]      size              Size of data
+ */
+static void xmlCacheGet (
+    TAU_XML_STREAM_T    *pStream,
+    void                *pData,
+    UINT32              size)
+{
+    if ((pStream->error == TRUE) || (pStream->pos + size > pStream->size))
+    {
+        pStream->error = TRUE;
+        memset(pData, 0, size);
+        return;
+    }
+    memcpy(pData, pStream->pBuffer + pStream->pos, size);
+    pStream->pos += size;
+}
+
+/**********************************************************************************************************************/
+/**    Take an array from the cache stream into newly allocated memory.
+ *
+ *  @param[in]      pStream           Cache stream
+ *  @param[in]      size              Size of the array
+ *
+ *  @retval         array, NULL if size is 0 or on error
+ */
+static void *xmlCacheGetArray (
+    TAU_XML_STREAM_T    *pStream,
+    UINT32              size)
+{
+    UINT8 *pData;
+
+    if ((pStream->error == TRUE) || (size == 0u))
+    {
+        return NULL;
+    }
+    pData = (UINT8 *) vos_memAlloc(size);
+    if (pData == NULL)
+    {
+        pStream->error = TRUE;
+        return NULL;
+    }
+    xmlCacheGet(pStream, pData, size);
+    if (pStream->error == TRUE)
+    {
+        vos_memFree(pData);
+        return NULL;
+    }
+    return pData;
+}
+
+/**********************************************************************************************************************/
+/**    Take a string from the cache stream into newly allocated memory.
+ *
+ *  @param[in]      pStream           Cache stream
+ *  @param[in]      minSize           Minimum size to allocate (URI user parts are allocated at full length)
+ *
+ *  @retval         string, NULL if it was NULL or on error
+ */
+static CHAR8 *xmlCacheGetStr (
+    TAU_XML_STREAM_T    *pStream,
+    UINT32              minSize)
+{
+    UINT32  len     = 0u;
+    CHAR8   *pStr;
+
+    xmlCacheGet(pStream, &len, sizeof(len));
+    if ((pStream->error == TRUE) || (len == 0u) || (pStream->pos + len > pStream->size))
+    {
+        pStream->error = (len != 0u) ? TRUE : pStream->error;
+        return NULL;
+    }
+    pStr = (CHAR8 *) vos_memAlloc((len > minSize) ? len : minSize);
+    if (pStr == NULL)
+    {
+        pStream->error = TRUE;
+        return NULL;
+    }
+    xmlCacheGet(pStream, pStr, len);
+    pStr[len - 1u] = 0;
+    return pStr;
+}
+
+/**********************************************************************************************************************/
+/**    Take an optional SDT parameter set from the cache stream.
+ *
+ *  @param[in]      pStream           Cache stream
+ *  @param[in]      present           Parameters were written
+ *
+ *  @retval         SDT parameters or NULL
+ */
+static TRDP_SDT_PAR_T *xmlCacheGetSdt (
+    TAU_XML_STREAM_T    *pStream,
+    BOOL8               present)
+{
+    return (present == TRUE) ? (TRDP_SDT_PAR_T *) xmlCacheGetArray(pStream, sizeof(TRDP_SDT_PAR_T)) : NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Serialize a configuration into a cache stream.
+ *     Pointer members are written as they are and only tell the reader if the referenced data follows.
+ *
+ *  @param[in]      pStream           Cache stream
+ *  @param[in]      pConfig           Configuration
+ */
+static void xmlCacheWriteConfig (
+    TAU_XML_STREAM_T        *pStream,
+    const TRDP_XML_CONFIG_T *pConfig)
+{
+    UINT32  i, j, k;
+
+    xmlCachePut(pStream, pConfig, sizeof(TRDP_XML_CONFIG_T));
+    xmlCachePut(pStream, pConfig->pComPar, pConfig->numComPar * sizeof(TRDP_COM_PAR_T));
+    xmlCachePut(pStream, pConfig->pIf, pConfig->numIf * sizeof(TRDP_XML_IF_T));
+
+    for (i = 0u; i < pConfig->numIf; i++)
+    {
+        const TRDP_XML_IF_T *pIf = &pConfig->pIf[i];
+
+        xmlCachePut(pStream, pIf->pExchgPar, pIf->numExchgPar * sizeof(TRDP_EXCHG_PAR_T));
+        for (j = 0u; j < pIf->numExchgPar; j++)
+        {
+            const TRDP_EXCHG_PAR_T *pEP = &pIf->pExchgPar[j];
+
+            if (pEP->pMdPar != NULL)
+            {
+                xmlCachePut(pStream, pEP->pMdPar, sizeof(TRDP_MD_PAR_T));
+            }
+            if (pEP->pPdPar != NULL)
+            {
+                xmlCachePut(pStream, pEP->pPdPar, sizeof(TRDP_PD_PAR_T));
+            }
+            xmlCachePut(pStream, pEP->pDest, pEP->destCnt * sizeof(TRDP_DEST_T));
+            for (k = 0u; k < pEP->destCnt; k++)
+            {
+                xmlCachePutStr(pStream, (const CHAR8 *) pEP->pDest[k].pUriUser);
+                xmlCachePutStr(pStream, (const CHAR8 *) pEP->pDest[k].pUriHost);
+                if (pEP->pDest[k].pSdtPar != NULL)
                 {
-                    if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
-                    {
-                        (*papDataset)[idx]->id = valueInt;
-                    }
+                    xmlCachePut(pStream, pEP->pDest[k].pSdtPar, sizeof(TRDP_SDT_PAR_T));
                 }
-
-                while (trdp_XMLSeekStartTag(pXML, "element") == 0)
+            }
+            xmlCachePut(pStream, pEP->pSrc, pEP->srcCnt * sizeof(TRDP_SRC_T));
+            for (k = 0u; k < pEP->srcCnt; k++)
+            {
+                xmlCachePutStr(pStream, (const CHAR8 *) pEP->pSrc[k].pUriUser);
+                xmlCachePutStr(pStream, (const CHAR8 *) pEP->pSrc[k].pUriHost1);
+                xmlCachePutStr(pStream, (const CHAR8 *) pEP->pSrc[k].pUriHost2);
+                if (pEP->pSrc[k].pSdtPar != NULL)
                 {
-                    (*papDataset)[idx]->pElement[i].size = 1;   /* default  */
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "type", MAX_TOK_LEN) == 0)
-                        {
-                            if (valueInt == 0)
-                            {
-                                (*papDataset)[idx]->pElement[i].type = string2type(value);
-                            }
-                            else
-                            {
-                                (*papDataset)[idx]->pElement[i].type = valueInt;
-                            }
-                        }
-                        else if (vos_strnicmp(attribute, "array-size", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].size = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "unit", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].unit = (CHAR8 *) vos_memAlloc((UINT32) strlen(value) + 1u);
-                            if ((*papDataset)[idx]->pElement[i].unit == NULL)
-                            {
-                                return TRDP_MEM_ERR;
-                            }
-                            vos_strncpy((*papDataset)[idx]->pElement[i].unit, value, (UINT32) strlen(value) + 1u);
-                        }
-                        else if (vos_strnicmp(attribute, "scale", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].scale = (REAL32) strtod(value, NULL);
-                        }
-                        else if (vos_strnicmp(attribute, "offset", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].offset = (INT32) valueInt;
-                        }
-                    }
-                    (*papDataset)[idx]->numElement++;
-                    i++;
+                    xmlCachePut(pStream, pEP->pSrc[k].pSdtPar, sizeof(TRDP_SDT_PAR_T));
                 }
-                trdp_XMLLeave(pXML);
             }
         }
-        trdp_XMLLeave(pXML);
     }
-    trdp_XMLLeave(pXML);
+
+    xmlCachePut(pStream, pConfig->pComIdDsIdMap, pConfig->numComId * sizeof(TRDP_COMID_DSID_MAP_T));
+    for (i = 0u; i < pConfig->numDataset; i++)
+    {
+        const TRDP_DATASET_T *pDataset = pConfig->apDataset[i];
+
+        xmlCachePut(pStream, pDataset,
+                    sizeof(TRDP_DATASET_T) + pDataset->numElement * sizeof(TRDP_DATASET_ELEMENT_T));
+        for (j = 0u; j < pDataset->numElement; j++)
+        {
+            xmlCachePutStr(pStream, pDataset->pElement[j].unit);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Rebuild a configuration from a cache stream.
+ *     Every pointer is replaced, so the result can be released by tau_freeXmlConfig() even on error.
+ *
+ *  @param[in]      pStream           Cache stream
+ *  @param[out]     pConfig           Configuration
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory or cache truncated
+ */
+static TRDP_ERR_T xmlCacheReadConfig (
+    TAU_XML_STREAM_T    *pStream,
+    TRDP_XML_CONFIG_T   *pConfig)
+{
+    UINT32  i, j, k;
+
+    xmlCacheGet(pStream, pConfig, sizeof(TRDP_XML_CONFIG_T));
+    pConfig->memConfig.p    = NULL;
+    pConfig->pComPar        = (TRDP_COM_PAR_T *) xmlCacheGetArray(pStream, pConfig->numComPar * sizeof(TRDP_COM_PAR_T));
+    pConfig->pIf            = (TRDP_XML_IF_T *) xmlCacheGetArray(pStream, pConfig->numIf * sizeof(TRDP_XML_IF_T));
+    pConfig->pComIdDsIdMap  = NULL;
+    pConfig->apDataset      = NULL;
+    if (pConfig->pIf == NULL)
+    {
+        pConfig->numIf = 0u;
+    }
+
+    for (i = 0u; i < pConfig->numIf; i++)
+    {
+        TRDP_XML_IF_T *pIf = &pConfig->pIf[i];
+
+        pIf->pdConfig.pfCbFunction  = NULL;
+        pIf->pdConfig.pRefCon       = NULL;
+        pIf->mdConfig.pfCbFunction  = NULL;
+        pIf->mdConfig.pRefCon       = NULL;
+        pIf->pExchgPar = (TRDP_EXCHG_PAR_T *) xmlCacheGetArray(pStream,
+                                                               pIf->numExchgPar * sizeof(TRDP_EXCHG_PAR_T));
+        if (pIf->pExchgPar == NULL)
+        {
+            pIf->numExchgPar = 0u;
+        }
+        for (j = 0u; j < pIf->numExchgPar; j++)
+        {
+            TRDP_EXCHG_PAR_T *pEP = &pIf->pExchgPar[j];
+
+            pEP->pMdPar = (pEP->pMdPar == NULL) ? NULL :
+                (TRDP_MD_PAR_T *) xmlCacheGetArray(pStream, sizeof(TRDP_MD_PAR_T));
+            pEP->pPdPar = (pEP->pPdPar == NULL) ? NULL :
+                (TRDP_PD_PAR_T *) xmlCacheGetArray(pStream, sizeof(TRDP_PD_PAR_T));
+            pEP->pDest = (TRDP_DEST_T *) xmlCacheGetArray(pStream, pEP->destCnt * sizeof(TRDP_DEST_T));
+            if (pEP->pDest == NULL)
+            {
+                pEP->destCnt = 0u;
+            }
+            for (k = 0u; k < pEP->destCnt; k++)
+            {
+                BOOL8 hasSdt = (pEP->pDest[k].pSdtPar != NULL) ? TRUE : FALSE;
+
+                pEP->pDest[k].pUriUser  = (TRDP_URI_USER_T *) xmlCacheGetStr(pStream, TRDP_MAX_URI_USER_LEN + 1u);
+                pEP->pDest[k].pUriHost  = (TRDP_URI_HOST_T *) xmlCacheGetStr(pStream, 0u);
+                pEP->pDest[k].pSdtPar   = xmlCacheGetSdt(pStream, hasSdt);
+            }
+            pEP->pSrc = (TRDP_SRC_T *) xmlCacheGetArray(pStream, pEP->srcCnt * sizeof(TRDP_SRC_T));
+            if (pEP->pSrc == NULL)
+            {
+                pEP->srcCnt = 0u;
+            }
+            for (k = 0u; k < pEP->srcCnt; k++)
+            {
+                BOOL8 hasSdt = (pEP->pSrc[k].pSdtPar != NULL) ? TRUE : FALSE;
+
+                pEP->pSrc[k].pUriUser   = (TRDP_URI_USER_T *) xmlCacheGetStr(pStream, TRDP_MAX_URI_USER_LEN + 1u);
+                pEP->pSrc[k].pUriHost1  = (TRDP_URI_HOST_T *) xmlCacheGetStr(pStream, 0u);
+                pEP->pSrc[k].pUriHost2  = (TRDP_URI_HOST_T *) xmlCacheGetStr(pStream, 0u);
+                pEP->pSrc[k].pSdtPar    = xmlCacheGetSdt(pStream, hasSdt);
+            }
+        }
+    }
+
+    pConfig->pComIdDsIdMap = (TRDP_COMID_DSID_MAP_T *) xmlCacheGetArray(pStream,
+                                                                        pConfig->numComId *
+                                                                        sizeof(TRDP_COMID_DSID_MAP_T));
+    if (pConfig->pComIdDsIdMap == NULL)
+    {
+        pConfig->numComId = 0u;
+    }
+    if (pConfig->numDataset > 0u)
+    {
+        pConfig->apDataset = (apTRDP_DATASET_T) vos_memAlloc(pConfig->numDataset * sizeof(pTRDP_DATASET_T));
+        if (pConfig->apDataset == NULL)
+        {
+            pStream->error = TRUE;
+        }
+    }
+    for (i = 0u; (i < pConfig->numDataset) && (pStream->error == FALSE); i++)
+    {
+        TRDP_DATASET_T  header;
+        TRDP_DATASET_T  *pDataset;
+
+        xmlCacheGet(pStream, &header, sizeof(TRDP_DATASET_T));
+        pDataset = (TRDP_DATASET_T *) vos_memAlloc(sizeof(TRDP_DATASET_T) +
+                                                   header.numElement * sizeof(TRDP_DATASET_ELEMENT_T));
+        if (pDataset == NULL)
+        {
+            pStream->error = TRUE;
+            break;
+        }
+        *pDataset = header;
+        xmlCacheGet(pStream, pDataset->pElement, header.numElement * sizeof(TRDP_DATASET_ELEMENT_T));
+        for (j = 0u; j < header.numElement; j++)
+        {
+            pDataset->pElement[j].unit      = xmlCacheGetStr(pStream, 0u);
+            pDataset->pElement[j].pCachedDS = NULL;
+        }
+        pConfig->apDataset[i] = pDataset;
+    }
+    if (pStream->error == TRUE)
+    {
+        pConfig->numDataset = (pConfig->apDataset == NULL) ? 0u : i;
+        return TRDP_MEM_ERR;
+    }
     return TRDP_NO_ERR;
 }
 
+
+/**********************************************************************************************************************/
+/**    Read a whole file into newly allocated memory.
+ *
+ *  @param[in]      pFileName         Path and filename
+ *  @param[out]     ppData            File content, to be released with vos_memFree
+ *  @param[out]     pSize             Size of the file
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_IO_ERR       file not readable
+ *  @retval         TRDP_MEM_ERR      out of memory
+ */
+static TRDP_ERR_T xmlReadFile (
+    const CHAR8 *pFileName,
+    UINT8       * *ppData,
+    UINT32      *pSize)
+{
+    FILE        *fp;
+    long        size;
+    TRDP_ERR_T  err = TRDP_IO_ERR;
+
+    *ppData = NULL;
+    fp      = fopen(pFileName, "rb");
+    if (fp == NULL)
+    {
+        return TRDP_IO_ERR;
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) && ((size = ftell(fp)) > 0) && (fseek(fp, 0, SEEK_SET) == 0))
+    {
+        *ppData = (UINT8 *) vos_memAlloc((UINT32) size);
+        if (*ppData == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else if (fread(*ppData, 1u, (size_t) size, fp) == (size_t) size)
+        {
+            *pSize  = (UINT32) size;
+            err     = TRDP_NO_ERR;
+        }
+        else
+        {
+            vos_memFree(*ppData);
+            *ppData = NULL;
+        }
+    }
+    (void) fclose(fp);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Load the configuration from the binary cache, if it was written for this XML file and build.
+ *
+ *  @param[in]      pCacheName        Path and filename of the cache
+ *  @param[in]      xmlSize           Size of the XML file
+ *  @param[in]      xmlCrc            Checksum of the XML file
+ *  @param[out]     pConfig           Configuration
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_IO_ERR       no valid cache
+ *  @retval         TRDP_MEM_ERR      out of memory
+ */
+static TRDP_ERR_T xmlCacheLoad (
+    const CHAR8         *pCacheName,
+    UINT32              xmlSize,
+    UINT32              xmlCrc,
+    TRDP_XML_CONFIG_T   *pConfig)
+{
+    TAU_XML_CACHE_HDR_T hdr;
+    TAU_XML_STREAM_T    stream;
+    UINT8               *pCache = NULL;
+    UINT32              size    = 0u;
+    TRDP_ERR_T          err;
+
+    err = xmlReadFile(pCacheName, &pCache, &size);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    err = TRDP_IO_ERR;
+    if (size >= sizeof(hdr))
+    {
+        memcpy(&hdr, pCache, sizeof(hdr));
+        if ((memcmp(hdr.magic, TAU_XML_CACHE_MAGIC, sizeof(hdr.magic)) == 0) &&
+            (hdr.layout == xmlCacheLayout()) &&
+            (hdr.xmlSize == xmlSize) &&
+            (hdr.xmlCrc == xmlCrc) &&
+            (hdr.dataSize == size - (UINT32) sizeof(hdr)) &&
+            (hdr.dataCrc == vos_crc32(INITFCS, pCache + sizeof(hdr), hdr.dataSize)))
+        {
+            memset(&stream, 0, sizeof(stream));
+            stream.pBuffer  = pCache + sizeof(hdr);
+            stream.size     = hdr.dataSize;
+            err = xmlCacheReadConfig(&stream, pConfig);
+            if ((err != TRDP_NO_ERR) || (stream.pos != stream.size))
+            {
+                tau_freeXmlConfig(pConfig);
+                err = (err != TRDP_NO_ERR) ? err : TRDP_IO_ERR;
+            }
+        }
+    }
+    vos_memFree(pCache);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Write the configuration to the binary cache.
+ *
+ *  @param[in]      pCacheName        Path and filename of the cache
+ *  @param[in]      xmlSize           Size of the XML file
+ *  @param[in]      xmlCrc            Checksum of the XML file
+ *  @param[in]      pConfig           Configuration
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_IO_ERR       file not writable
+ *  @retval         TRDP_MEM_ERR      out of memory
+ */
+static TRDP_ERR_T xmlCacheStore (
+    const CHAR8             *pCacheName,
+    UINT32                  xmlSize,
+    UINT32                  xmlCrc,
+    const TRDP_XML_CONFIG_T *pConfig)
+{
+    TAU_XML_CACHE_HDR_T hdr;
+    TAU_XML_STREAM_T    stream;
+    FILE                *fp;
+    TRDP_ERR_T          err = TRDP_IO_ERR;
+
+    memset(&stream, 0, sizeof(stream));
+    xmlCacheWriteConfig(&stream, pConfig);
+    if (stream.error == TRUE)
+    {
+        if (stream.pBuffer != NULL)
+        {
+            vos_memFree(stream.pBuffer);
+        }
+        return TRDP_MEM_ERR;
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, TAU_XML_CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.layout      = xmlCacheLayout();
+    hdr.xmlSize     = xmlSize;
+    hdr.xmlCrc      = xmlCrc;
+    hdr.dataSize    = stream.pos;
+    hdr.dataCrc     = vos_crc32(INITFCS, stream.pBuffer, stream.pos);
+
+    fp = fopen(pCacheName, "wb");
+    if (fp != NULL)
+    {
+        if ((fwrite(&hdr, sizeof(hdr), 1u, fp) == 1u) &&
+            ((stream.pos == 0u) || (fwrite(stream.pBuffer, stream.pos, 1u, fp) == 1u)))
+        {
+            err = TRDP_NO_ERR;
+        }
+        if (fclose(fp) != 0)
+        {
+            err = TRDP_IO_ERR;
+        }
+        if (err != TRDP_NO_ERR)
+        {
+            (void) remove(pCacheName);
+        }
+    }
+    if (stream.pBuffer != NULL)
+    {
+        vos_memFree(stream.pBuffer);
+    }
+    return err;
+}
+
 /******************************************************************************
  *   Globals
  */
@@ -876,27 +1610,71 @@ static TRDP_ERR_T readXmlDatasets (
  *  @param[out]     pDocHnd           Handle of the parsed XML file
  *
  *  @retval         TRDP_NO_ERR       no error
- *  @retval         TRDP_PARAM_ERR    File does not exist
+ *  @retval         TRDP_PARAM_ERR    File does not exist
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_prepareXmlDoc (
+    const CHAR8             *pFileName,
+    TRDP_XML_DOC_HANDLE_T   *pDocHnd
+    )
+{
+    /*  Check file name */
+    if ((pFileName == NULL) || (strlen(pFileName) == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* Check parameters */
+    if (pDocHnd == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /*  Set handle pointers to NULL */
+    memset(pDocHnd, 0, sizeof(TRDP_XML_DOC_HANDLE_T));
+
+    pDocHnd->pXmlDocument = (XML_HANDLE_T *) vos_memAlloc(sizeof(XML_HANDLE_T));
+    if (pDocHnd->pXmlDocument == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    /*  Read XML file  */
+    if (trdp_XMLOpen(pDocHnd->pXmlDocument, pFileName))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Prepare XML doc: failed to open XML file\n");
+        vos_memFree(pDocHnd->pXmlDocument);
+        pDocHnd->pXmlDocument = NULL;
+        return TRDP_PARAM_ERR;
+    }
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Prepare parsing of an XML configuration held in memory.
+ *
+ *
+ *  @param[in]      pBuffer           XML document
+ *  @param[in]      bufSize           Size of the XML document in bytes
+ *  @param[out]     pDocHnd           Handle of the parsed XML document
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    no document or handle given
+ *  @retval         TRDP_MEM_ERR      out of memory
  *
  */
-EXT_DECL TRDP_ERR_T tau_prepareXmlDoc (
-    const CHAR8             *pFileName,
+EXT_DECL TRDP_ERR_T tau_prepareXmlMem (
+    const CHAR8             *pBuffer,
+    UINT32                  bufSize,
     TRDP_XML_DOC_HANDLE_T   *pDocHnd
     )
 {
-    /*  Check file name */
-    if ((pFileName == NULL) || (strlen(pFileName) == 0u))
-    {
-        return TRDP_PARAM_ERR;
-    }
-
-    /* Check parameters */
-    if (pDocHnd == NULL)
+    if ((pBuffer == NULL) || (bufSize == 0u) || (pDocHnd == NULL))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /*  Set handle pointers to NULL */
     memset(pDocHnd, 0, sizeof(TRDP_XML_DOC_HANDLE_T));
 
     pDocHnd->pXmlDocument = (XML_HANDLE_T *) vos_memAlloc(sizeof(XML_HANDLE_T));
@@ -905,14 +1683,7 @@ EXT_DECL TRDP_ERR_T tau_prepareXmlDoc (
         return TRDP_MEM_ERR;
     }
 
-    /*  Read XML file  */
-    if (trdp_XMLOpen(pDocHnd->pXmlDocument, pFileName))
-    {
-        vos_printLogStr(VOS_LOG_ERROR, "Prepare XML doc: failed to open XML file\n");
-        return TRDP_PARAM_ERR;
-    }
-
-    return TRDP_NO_ERR;
+    return trdp_XMLOpenMem(pDocHnd->pXmlDocument, pBuffer, bufSize);
 }
 
 /**********************************************************************************************************************/
@@ -926,7 +1697,7 @@ EXT_DECL void tau_freeXmlDoc (
     TRDP_XML_DOC_HANDLE_T *pDocHnd)
 {
     /*  Check parameter */
-    if (!pDocHnd)
+    if ((pDocHnd == NULL) || (pDocHnd->pXmlDocument == NULL))
     {
         return;
     }
@@ -1101,6 +1872,11 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                         pPdConfig->flags    |= TRDP_FLAGS_FORCE_CB;
                                         pPdConfig->flags    &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
                                     }
+                                    else if (vos_strnicmp("latest", value, TRDP_MAX_LABEL_LEN) == 0)
+                                    {
+                                        pPdConfig->flags    |= TRDP_FLAGS_CALLBACK | TRDP_FLAGS_PD_LATEST;
+                                        pPdConfig->flags    &= (TRDP_FLAGS_T) ~TRDP_FLAGS_NONE;
+                                    }
                                 }
                                 else if (vos_strnicmp(attribute, "timeout-value", MAX_TOK_LEN) == 0)
                                 {
@@ -1182,6 +1958,10 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                 {
                                     pMdConfig->connectTimeout = valueInt;
                                 }
+                                else if (vos_strnicmp(attribute, "max-idle-connections", MAX_TOK_LEN) == 0)
+                                {
+                                    pMdConfig->maxNumIdleConn = valueInt;
+                                }
                                 else if (vos_strnicmp(attribute, "reply-timeout", MAX_TOK_LEN) == 0)
                                 {
                                     pMdConfig->replyTimeout = valueInt;
@@ -1402,9 +2182,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
                     trdp_XMLEnter(pDocHnd->pXmlDocument);
                     while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "mem-block") == 0)
                     {
-                        const UINT32    mem_list[] =
-                        {32u, 72u, 128u, 256u, 512u, 1024u, 1480u, 2048u, 4096u, 11520u, 16384u, 32768u, 65536u,
-                         131072u};
+                        const UINT32    mem_list[VOS_MEM_NBLOCKSIZES] = VOS_MEM_BLOCKSIZES;
                         UINT32          sizeValue   = 0u;
                         UINT32          preAlloc    = 0u;
                         int             i;
@@ -1417,11 +2195,11 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
                             if (found == TOK_ATTRIBUTE && vos_strnicmp(attribute, "preallocate", MAX_TOK_LEN) == 0)
                             {
                                 /* Find the slot to store the value in  */
-                                for (i = 0; sizeValue > mem_list[i]; i++)
+                                for (i = 0; (i < (int) VOS_MEM_NBLOCKSIZES) && (sizeValue > mem_list[i]); i++)
                                 {
                                     ;
                                 }
-                                if (i < 15)
+                                if (i < (int) VOS_MEM_NBLOCKSIZES)
                                 {
                                     pMemConfig->prealloc[i] = preAlloc;
                                 }
@@ -1591,6 +2369,257 @@ EXT_DECL TRDP_ERR_T tau_readXmlDatasetConfig (
     return err;
 }
 
+/**********************************************************************************************************************/
+/**    Free a dataset with the units of its elements.
+ *
+ *  @param[in]      pDataset          dataset, may be NULL
+ */
+static void freeXmlDataset (
+    TRDP_DATASET_T *pDataset)
+{
+    UINT32 j;
+
+    if (pDataset != NULL)
+    {
+        for (j = 0u; j < pDataset->numElement; ++j)
+        {
+            if (pDataset->pElement[j].unit != NULL)
+            {
+                vos_memFree(pDataset->pElement[j].unit);
+            }
+        }
+        vos_memFree(pDataset);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Compare the ids of two dataset positions, for qsort and bsearch.
+ *
+ *  @param[in]      pArg1             first entry
+ *  @param[in]      pArg2             second entry
+ *
+ *  @retval         -1, 0, 1
+ */
+static int compareDsEntry (
+    const void  *pArg1,
+    const void  *pArg2)
+{
+    UINT32  id1 = ((const TAU_XML_DS_ENTRY_T *) pArg1)->id;
+    UINT32  id2 = ((const TAU_XML_DS_ENTRY_T *) pArg2)->id;
+
+    return (id1 < id2) ? -1 : ((id1 > id2) ? 1 : 0);
+}
+
+/**********************************************************************************************************************/
+/**    Function to read the ComId DatasetId mapping and an index of the datasets out of the XML configuration file.
+ *  The elements are skipped, the datasets are stubs which are loaded by tau_loadXmlDataset().
+ *
+ *
+ *  @param[in]      pDocHnd             Handle of the XML document prepared by tau_prepareXmlDoc
+ *  @param[out]     pNumComId           Pointer to the number of entries in the ComId DatasetId mapping list
+ *  @param[out]     ppComIdDsIdMap      Pointer to an array of a structures of type TRDP_COMID_DSID_MAP_T
+ *  @param[out]     pNumDataset         Pointer to the number of datasets found in the configuration
+ *  @param[out]     papDataset          Pointer to an array of pointers to dataset stubs
+ *  @param[out]     ppSource            Pointer to the source of the datasets
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_IO_ERR         the dataset list could not be read
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readXmlDatasetIndex (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    UINT32                      *pNumComId,
+    TRDP_COMID_DSID_MAP_T       * *ppComIdDsIdMap,
+    UINT32                      *pNumDataset,
+    papTRDP_DATASET_T           papDataset,
+    TAU_XML_DS_SOURCE_T         * *ppSource)
+{
+    XML_HANDLE_T        *pXML = pDocHnd->pXmlDocument;
+    CHAR8               attribute[MAX_TOK_LEN];
+    CHAR8               value[MAX_TOK_LEN];
+    UINT32              valueInt;
+    UINT32              count   = 0u;
+    UINT32              idx     = 0u;
+    long                pos;
+    long                start   = 0;
+    long                end     = 0;
+    TAU_XML_DS_SOURCE_T *pSource;
+    TRDP_ERR_T          err;
+
+    *ppSource       = NULL;
+    *pNumDataset    = 0u;
+    err = readXmlDatasetMap(pXML, pNumComId, ppComIdDsIdMap);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    pSource = (TAU_XML_DS_SOURCE_T *) vos_memAlloc(sizeof(TAU_XML_DS_SOURCE_T));
+    if (pSource == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    trdp_XMLRewind(pXML);
+
+    trdp_XMLEnter(pXML);
+
+    if (trdp_XMLSeekStartTag(pXML, "device") == 0) /* Optional */
+    {
+        trdp_XMLEnter(pXML);
+
+        if (trdp_XMLSeekStartTag(pXML, "data-set-list") == 0)
+        {
+            trdp_XMLEnter(pXML);
+
+            count = (UINT32) trdp_XMLCountStartTag(pXML, "data-set");
+            if (count > 0u)
+            {
+                *papDataset     = (apTRDP_DATASET_T) vos_memAlloc(count * sizeof(apTRDP_DATASET_T));
+                pSource->pEntry = (TAU_XML_DS_ENTRY_T *) vos_memAlloc(count * sizeof(TAU_XML_DS_ENTRY_T));
+                if ((*papDataset == NULL) || (pSource->pEntry == NULL))
+                {
+                    vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while indexing XML dataset definitions!\n",
+                                 (unsigned long) (count * (sizeof(apTRDP_DATASET_T) + sizeof(TAU_XML_DS_ENTRY_T))));
+                    tau_freeXmlDatasetSource(pSource);
+                    return TRDP_MEM_ERR;
+                }
+            }
+
+            /* Only the ids are read, the elements are skipped */
+            for (idx = 0u; (idx < count) && (trdp_XMLSeekStartTag(pXML, "data-set") == 0); idx++)
+            {
+                pos = trdp_XMLTell(pXML);
+                if (idx == 0u)
+                {
+                    start = pos;
+                }
+                (*papDataset)[idx] = (TRDP_DATASET_T *) vos_memAlloc(sizeof(TRDP_DATASET_T));
+                if ((*papDataset)[idx] == NULL)
+                {
+                    tau_freeXmlDatasetSource(pSource);
+                    return TRDP_MEM_ERR;
+                }
+                *pNumDataset = idx + 1u;
+
+                while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+                {
+                    if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
+                    {
+                        (*papDataset)[idx]->id = valueInt;
+                    }
+                }
+                pSource->pEntry[idx].id     = (*papDataset)[idx]->id;
+                pSource->pEntry[idx].offset = (UINT32) (pos - start);
+            }
+            pSource->numEntries = idx;
+
+            /* The text ends with the list, behind the elements of the last dataset */
+            if (idx > 0u)
+            {
+                (void) trdp_XMLSeekStartTag(pXML, "data-set");
+                end = trdp_XMLTell(pXML);
+            }
+        }
+        trdp_XMLLeave(pXML);
+    }
+    trdp_XMLLeave(pXML);
+
+    if (end > start)
+    {
+        pSource->size   = (UINT32) (end - start);
+        pSource->pText  = (CHAR8 *) vos_memAlloc(pSource->size);
+        err = (pSource->pText == NULL) ? TRDP_MEM_ERR : trdp_XMLCopy(pXML, start, pSource->size, pSource->pText);
+        if (err != TRDP_NO_ERR)
+        {
+            tau_freeXmlDatasetSource(pSource);
+            return err;
+        }
+    }
+    vos_qsort(pSource->pEntry, pSource->numEntries, sizeof(TAU_XML_DS_ENTRY_T), compareDsEntry);
+
+    *ppSource = pSource;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Parse one dataset of a source read by tau_readXmlDatasetIndex
+ *
+ *
+ *  @param[in]      pSource             Source of the datasets
+ *  @param[in]      datasetId           Id of the dataset
+ *  @param[out]     ppDataset           Returns the dataset, allocated in one block with its elements
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_PARAM_ERR      dataset not in the source
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_loadXmlDataset (
+    void            *pSource,
+    UINT32          datasetId,
+    TRDP_DATASET_T  * *ppDataset)
+{
+    const TAU_XML_DS_SOURCE_T   *pSrc = (const TAU_XML_DS_SOURCE_T *) pSource;
+    TAU_XML_DS_ENTRY_T          key;
+    const TAU_XML_DS_ENTRY_T    *pEntry;
+    XML_HANDLE_T                xml;
+    TRDP_ERR_T                  err;
+
+    if ((pSrc == NULL) || (ppDataset == NULL) || (pSrc->pText == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    key.id      = datasetId;
+    key.offset  = 0u;
+    pEntry      = (const TAU_XML_DS_ENTRY_T *) vos_bsearch(&key, pSrc->pEntry, pSrc->numEntries,
+                                                           sizeof(TAU_XML_DS_ENTRY_T), compareDsEntry);
+    if (pEntry == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    err = trdp_XMLOpenElement(&xml, pSrc->pText + pEntry->offset, pSrc->size - pEntry->offset);
+    if (err == TRDP_NO_ERR)
+    {
+        err = readXmlDataset(&xml, ppDataset);
+        if ((err != TRDP_NO_ERR) && (*ppDataset != NULL))
+        {
+            freeXmlDataset(*ppDataset);
+            *ppDataset = NULL;
+        }
+        trdp_XMLClose(&xml);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Free a source read by tau_readXmlDatasetIndex
+ *
+ *
+ *  @param[in]      pSource             Source of the datasets, may be NULL
+ *
+ *  @retval         none
+ *
+ */
+EXT_DECL void tau_freeXmlDatasetSource (
+    TAU_XML_DS_SOURCE_T *pSource)
+{
+    if (pSource != NULL)
+    {
+        if (pSource->pEntry != NULL)
+        {
+            vos_memFree(pSource->pEntry);
+        }
+        if (pSource->pText != NULL)
+        {
+            vos_memFree(pSource->pText);
+        }
+        vos_memFree(pSource);
+    }
+}
+
 /**********************************************************************************************************************/
 /**    Function to free the memory for the DataSet configuration
  *
@@ -1611,8 +2640,7 @@ EXT_DECL void tau_freeXmlDatasetConfig (
     UINT32                  numDataset,
     TRDP_DATASET_T          * *ppDataset)
 {
-    UINT32  i;
-    UINT32  j;
+    UINT32 i;
 
     /*  Mapping between ComId and DatasetId   */
     if (numComId > 0u && pComIdDsIdMap != NULL)
@@ -1625,15 +2653,174 @@ EXT_DECL void tau_freeXmlDatasetConfig (
     {
         for (i = 0u; i < numDataset; ++i)
         {
-            for (j = 0u; j < ppDataset[i]->numElement; ++j)
-            {
-                if (ppDataset[i]->pElement[j].unit != NULL)
-                {
-                    vos_memFree(ppDataset[i]->pElement[j].unit);
-                }
-            }
-            vos_memFree(ppDataset[i]);
+            freeXmlDataset(ppDataset[i]);
         }
         vos_memFree(ppDataset);
     }
 }
+
+/**********************************************************************************************************************/
+/**    Read the complete configuration (device, all interfaces with their telegrams, datasets) in one call.
+ *
+ *
+ *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
+ *  @param[out]     pConfig           Configuration read
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readXmlConfig (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    TRDP_XML_CONFIG_T           *pConfig)
+{
+    TRDP_IF_CONFIG_T    *pIfConfig  = NULL;
+    UINT32              numIfConfig = 0u;
+    UINT32              i;
+    TRDP_ERR_T          err;
+
+    if ((pDocHnd == NULL) || (pDocHnd->pXmlDocument == NULL) || (pConfig == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    memset(pConfig, 0, sizeof(TRDP_XML_CONFIG_T));
+
+    err = tau_readXmlDeviceConfig(pDocHnd, &pConfig->memConfig, &pConfig->dbgConfig,
+                                  &pConfig->numComPar, &pConfig->pComPar, &numIfConfig, &pIfConfig);
+    if ((err == TRDP_NO_ERR) && (numIfConfig > 0u))
+    {
+        pConfig->pIf = (TRDP_XML_IF_T *) vos_memAlloc(numIfConfig * sizeof(TRDP_XML_IF_T));
+        if (pConfig->pIf == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+    }
+
+    for (i = 0u; (err == TRDP_NO_ERR) && (i < numIfConfig); i++)
+    {
+        TRDP_XML_IF_T *pIf = &pConfig->pIf[i];
+
+        pIf->ifConfig   = pIfConfig[i];
+        pConfig->numIf  = i + 1u;
+        err = tau_readXmlInterfaceConfig(pDocHnd, pIf->ifConfig.ifName, &pIf->processConfig,
+                                         &pIf->pdConfig, &pIf->mdConfig, &pIf->numExchgPar, &pIf->pExchgPar);
+    }
+
+    if (pIfConfig != NULL)
+    {
+        vos_memFree(pIfConfig);
+    }
+
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_readXmlDatasetConfig(pDocHnd, &pConfig->numComId, &pConfig->pComIdDsIdMap,
+                                       &pConfig->numDataset, &pConfig->apDataset);
+    }
+
+    if (err != TRDP_NO_ERR)
+    {
+        tau_freeXmlConfig(pConfig);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Read the complete configuration, using a binary cache of an earlier parse if it is still valid.
+ *
+ *
+ *  @param[in]      pFileName         Path and filename of the xml configuration file
+ *  @param[in]      pCacheName        Path and filename of the binary cache, NULL to parse only
+ *  @param[out]     pConfig           Configuration read
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    parameter error or XML file not readable
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_loadXmlConfig (
+    const CHAR8         *pFileName,
+    const CHAR8         *pCacheName,
+    TRDP_XML_CONFIG_T   *pConfig)
+{
+    TRDP_XML_DOC_HANDLE_T   docHnd;
+    UINT8                   *pXml   = NULL;
+    UINT32                  xmlSize = 0u;
+    UINT32                  xmlCrc;
+    TRDP_ERR_T              err;
+
+    if ((pFileName == NULL) || (pConfig == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    memset(pConfig, 0, sizeof(TRDP_XML_CONFIG_T));
+
+    /*  The XML file is read once, its checksum decides if the cache can be used    */
+    err = xmlReadFile(pFileName, &pXml, &xmlSize);
+    if (err != TRDP_NO_ERR)
+    {
+        return (err == TRDP_MEM_ERR) ? err : TRDP_PARAM_ERR;
+    }
+    xmlCrc = vos_crc32(INITFCS, pXml, xmlSize);
+
+    if ((pCacheName != NULL) && (xmlCacheLoad(pCacheName, xmlSize, xmlCrc, pConfig) == TRDP_NO_ERR))
+    {
+        vos_memFree(pXml);
+        return TRDP_NO_ERR;
+    }
+
+    err = tau_prepareXmlMem((const CHAR8 *) pXml, xmlSize, &docHnd);
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_readXmlConfig(&docHnd, pConfig);
+        tau_freeXmlDoc(&docHnd);
+    }
+    vos_memFree(pXml);
+
+    if ((err == TRDP_NO_ERR) && (pCacheName != NULL) &&
+        (xmlCacheStore(pCacheName, xmlSize, xmlCrc, pConfig) != TRDP_NO_ERR))
+    {
+        vos_printLog(VOS_LOG_WARNING, "XML configuration cache %s could not be written\n", pCacheName);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Free the memory allocated by tau_readXmlConfig or tau_loadXmlConfig
+ *
+ *
+ *  @param[in]      pConfig           Configuration to release
+ *
+ */
+EXT_DECL void tau_freeXmlConfig (
+    TRDP_XML_CONFIG_T *pConfig)
+{
+    UINT32 i;
+
+    if (pConfig == NULL)
+    {
+        return;
+    }
+
+    if (pConfig->pComPar != NULL)
+    {
+        vos_memFree(pConfig->pComPar);
+    }
+    if (pConfig->pIf != NULL)
+    {
+        for (i = 0u; i < pConfig->numIf; i++)
+        {
+            tau_freeTelegrams(pConfig->pIf[i].numExchgPar, pConfig->pIf[i].pExchgPar);
+        }
+        vos_memFree(pConfig->pIf);
+    }
+    if ((pConfig->numDataset == 0u) && (pConfig->apDataset != NULL))
+    {
+        vos_memFree(pConfig->apDataset);
+    }
+    tau_freeXmlDatasetConfig(pConfig->numComId, pConfig->pComIdDsIdMap, pConfig->numDataset, pConfig->apDataset);
+
+    memset(pConfig, 0, sizeof(TRDP_XML_CONFIG_T));
+}
@@ -77,6 +77,9 @@
 #include "trdp_utils.h"
 #include "trdp_pdcom.h"
 #include "trdp_stats.h"
+#include "trdp_sdt.h"
+#include "trdp_trace.h"
+#include "trdp_rec.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 #include "vos_utils.h"
@@ -102,6 +105,18 @@ static TRDP_APP_SESSION_T   sSession        = NULL;
 static VOS_MUTEX_T          sSessionMutex   = NULL;
 static BOOL8 sInited = FALSE;
 
+/*  Open sessions for trdp_isValidSession(), written under sSessionMutex and read without lock.
+    Sessions beyond the table (counted in sSessionRegOverflow) are found in sSession under the mutex.  */
+#define TRDP_SESSION_REG_CNT    32u
+static TRDP_SESSION_PT      sSessionReg[TRDP_SESSION_REG_CNT];
+static UINT32               sSessionRegOverflow = 0u;
+
+#if TRDP_TRACE && defined (WIN32)
+/*  ETW provider 'TCNOpen.TRDP' of the tracepoints  */
+TRACELOGGING_DEFINE_PROVIDER(trdp_traceProvider, "TCNOpen.TRDP",
+                             (0x4f2b7a63, 0x1c0e, 0x4d8a, 0x9b, 0x52, 0x3e, 0x61, 0xd4, 0x0a, 0x8c, 0x17));
+#endif
+
 /******************************************************************************
  * LOCAL FUNCTIONS
  */
@@ -125,29 +140,43 @@ TRDP_APP_SESSION_T *trdp_sessionQueue (void);
 BOOL8    trdp_isValidSession (
     TRDP_APP_SESSION_T pSessionHandle)
 {
-    TRDP_SESSION_PT pSession = NULL;
-    BOOL8 found = FALSE;
+    TRDP_SESSION_PT pSession    = NULL;
+    BOOL8           found       = FALSE;
+    UINT32          i;
 
     if (pSessionHandle == NULL)
     {
         return FALSE;
     }
 
-    if (vos_mutexLock(sSessionMutex) != VOS_NO_ERR)
+    /*  The handle is only dereferenced once it is known to be an open session: no global lock is taken
+        for registered sessions, calls on different sessions stay independent  */
+    for (i = 0u; i < TRDP_SESSION_REG_CNT; i++)
+    {
+        if (TRDP_ATOMIC_LOAD(sSessionReg[i]) == (TRDP_SESSION_PT) pSessionHandle)
+        {
+            return (pSessionHandle->magic == TRDP_MAGIC_SESSION_VALUE) ? TRUE : FALSE;
+        }
+    }
+
+    if (TRDP_ATOMIC_LOAD(sSessionRegOverflow) == 0u)
     {
         return FALSE;
     }
 
-    pSession = sSession;
+    /*  More sessions than registry entries: search the session list  */
+    if (vos_mutexLock(sSessionMutex) != VOS_NO_ERR)
+    {
+        return FALSE;
+    }
 
-    while (pSession)
+    for (pSession = sSession; pSession != NULL; pSession = pSession->pNext)
     {
         if (pSession == (TRDP_SESSION_PT) pSessionHandle)
         {
-            found = TRUE;
+            found = (pSession->magic == TRDP_MAGIC_SESSION_VALUE) ? TRUE : FALSE;
             break;
         }
-        pSession = pSession->pNext;
     }
 
     if (vos_mutexUnlock(sSessionMutex) != VOS_NO_ERR)
@@ -158,6 +187,49 @@ BOOL8    trdp_isValidSession (
     return found;
 }
 
+/**********************************************************************************************************************/
+/** Register an open session for trdp_isValidSession(), called with sSessionMutex held
+ *
+ *  @param[in]    pSession              session queued in sSession
+ */
+static void trdp_sessionRegister (
+    TRDP_SESSION_PT pSession)
+{
+    UINT32 i;
+
+    for (i = 0u; i < TRDP_SESSION_REG_CNT; i++)
+    {
+        if (sSessionReg[i] == NULL)
+        {
+            TRDP_ATOMIC_STORE(sSessionReg[i], pSession);
+            return;
+        }
+    }
+    /*  Writers are serialized by sSessionMutex, the store only has to be seen by the readers  */
+    TRDP_ATOMIC_STORE(sSessionRegOverflow, sSessionRegOverflow + 1u);
+}
+
+/**********************************************************************************************************************/
+/** Unregister a session before it is freed, called with sSessionMutex held
+ *
+ *  @param[in]    pSession              session removed from sSession
+ */
+static void trdp_sessionUnregister (
+    TRDP_SESSION_PT pSession)
+{
+    UINT32 i;
+
+    for (i = 0u; i < TRDP_SESSION_REG_CNT; i++)
+    {
+        if (sSessionReg[i] == pSession)
+        {
+            TRDP_ATOMIC_STORE(sSessionReg[i], NULL);
+            return;
+        }
+    }
+    TRDP_ATOMIC_STORE(sSessionRegOverflow, sSessionRegOverflow - 1u);
+}
+
 /**********************************************************************************************************************/
 /** Get the session queue head pointer
  *
@@ -223,7 +295,8 @@ EXT_DECL TRDP_ERR_T tlc_init (
             }
             else
             {
-                ret = (TRDP_ERR_T) vos_memInit(pMemConfig->p, pMemConfig->size, pMemConfig->prealloc);
+                ret = (TRDP_ERR_T) vos_memInitBlockSizes(pMemConfig->p, pMemConfig->size, pMemConfig->prealloc,
+                                                         (pMemConfig->blockSize[0] != 0u) ? pMemConfig->blockSize : NULL);
             }
 
             if (ret != TRDP_NO_ERR)
@@ -233,6 +306,14 @@ EXT_DECL TRDP_ERR_T tlc_init (
             else
             {
                 ret = (TRDP_ERR_T) vos_mutexCreate(&sSessionMutex);
+                if (ret == TRDP_NO_ERR)
+                {
+                    ret = trdp_shareInit();
+                }
+                if (ret == TRDP_NO_ERR)
+                {
+                    ret = trdp_seqPubInit();
+                }
 
                 if (ret != TRDP_NO_ERR)
                 {
@@ -243,6 +324,12 @@ EXT_DECL TRDP_ERR_T tlc_init (
 
         if (ret == TRDP_NO_ERR)
         {
+#if TRDP_PD_LAZY_FCS
+            trdp_pdInitFcs();
+#endif
+#if TRDP_TRACE && defined (WIN32)
+            (void) TraceLoggingRegister(trdp_traceProvider);
+#endif
             sInited = TRUE;
             vos_printLog(VOS_LOG_INFO, "TRDP Stack Version %s: successfully initiated\n", tlc_getVersionString());
         }
@@ -325,12 +412,17 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     pSession->pdDefault.port            = TRDP_PD_UDP_PORT;
     pSession->pdDefault.sendParam.qos   = TRDP_PD_DEFAULT_QOS;
     pSession->pdDefault.sendParam.ttl   = TRDP_PD_DEFAULT_TTL;
+    pSession->deltaKeyCycles            = TRDP_PD_DELTA_KEY_CYCLES;
+#if TRDP_PD_PULL_HASH_SIZE > 0
+    pSession->pullMax                   = TRDP_PD_PULL_MAX;
+#endif
 
 #if MD_SUPPORT
     pSession->mdDefault.pfCbFunction    = NULL;
     pSession->mdDefault.pRefCon         = NULL;
     pSession->mdDefault.confirmTimeout  = TRDP_MD_DEFAULT_CONFIRM_TIMEOUT;
     pSession->mdDefault.connectTimeout  = TRDP_MD_DEFAULT_CONNECTION_TIMEOUT;
+    pSession->mdDefault.sendingTimeout  = TRDP_MD_DEFAULT_SENDING_TIMEOUT;
     pSession->mdDefault.replyTimeout    = TRDP_MD_DEFAULT_REPLY_TIMEOUT;
     pSession->mdDefault.flags               = TRDP_FLAGS_NONE;
     pSession->mdDefault.udpPort             = TRDP_MD_UDP_PORT;
@@ -340,6 +432,7 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     pSession->mdDefault.sendParam.retries   = TRDP_MD_DEFAULT_RETRIES;
     pSession->mdDefault.maxNumSessions      = TRDP_MD_MAX_NUM_SESSIONS;
     pSession->tcpFd.listen_sd               = VOS_INVALID_SOCKET;
+    pSession->tcpFd.polled_sd               = VOS_INVALID_SOCKET;
 
 #endif
 
@@ -359,6 +452,16 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
         return ret;
     }
 
+    ret = (TRDP_ERR_T) vos_mutexCreate(&pSession->sndMutex);
+
+    if (ret != TRDP_NO_ERR)
+    {
+        vos_mutexDelete(pSession->mutex);
+        vos_memFree(pSession);
+        vos_printLog(VOS_LOG_ERROR, "vos_mutexCreate() failed (Err: %d)\n", ret);
+        return ret;
+    }
+
     vos_clearTime(&pSession->nextJob);
     vos_getTime(&pSession->initTime);
 
@@ -377,13 +480,39 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     pSession->stats.leaderIpAddr    = leaderIpAddr;
 
     /*  Get a buffer to receive PD   */
-    pSession->pNewFrame = (PD_PACKET_T *) vos_memAlloc(TRDP_MAX_PD_PACKET_SIZE);
+    pSession->pNewFrame = (PD_PACKET_T *) vos_memAllocAligned(TRDP_MAX_PD_PACKET_SIZE, TRDP_PD_FRAME_ALIGN);
     if (pSession->pNewFrame == NULL)
     {
+        vos_mutexDelete(pSession->sndMutex);
+        vos_mutexDelete(pSession->mutex);
+        vos_memFree(pSession);
         vos_printLogStr(VOS_LOG_ERROR, "Out of meory!\n");
         return TRDP_MEM_ERR;
     }
 
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+    {
+        UINT32 i;
+        for (i = 0u; i < TRDP_PD_RCV_BATCH_SIZE; i++)
+        {
+            pSession->pRcvBatch[i] = (PD_PACKET_T *) vos_memAllocAligned(TRDP_MAX_PD_PACKET_SIZE, TRDP_PD_FRAME_ALIGN);
+            if (pSession->pRcvBatch[i] == NULL)
+            {
+                while (i > 0u)
+                {
+                    vos_memFree(pSession->pRcvBatch[--i]);
+                }
+                vos_memFree(pSession->pNewFrame);
+                vos_mutexDelete(pSession->sndMutex);
+                vos_mutexDelete(pSession->mutex);
+                vos_memFree(pSession);
+                vos_printLogStr(VOS_LOG_ERROR, "Out of meory!\n");
+                return TRDP_MEM_ERR;
+            }
+        }
+    }
+#endif
+
     /*    Queue the session in    */
     ret = (TRDP_ERR_T) vos_mutexLock(sSessionMutex);
 
@@ -396,8 +525,10 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
         unsigned int retries;
 
         pSession->pNext = sSession;
+        pSession->magic = TRDP_MAGIC_SESSION_VALUE;
         sSession        = pSession;
         *pAppHandle     = pSession;
+        trdp_sessionRegister(pSession);
 
         for (retries = 0; retries < TRDP_IF_WAIT_FOR_READY; retries++)
         {
@@ -415,6 +546,8 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
                               TRDP_FLAGS_NONE,          /*    No callbacks                  */
                               NULL,                     /*    default qos and ttl           */
                               NULL,                     /*    initial data                  */
+                              (pSession->option & TRDP_OPTION_TIMING_STATS) ?
+                              (sizeof(TRDP_STATISTICS_T) + sizeof(TRDP_TIMING_STATISTICS_T)) :
                               sizeof(TRDP_STATISTICS_T));
             if (ret == TRDP_SOCK_ERR)
             {
@@ -442,6 +575,16 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
                                 TRDP_TIMER_FOREVER,     /*    Time out in us                    */
                                 TRDP_TO_DEFAULT);       /*    delete invalid data on timeout    */
         }
+        if ((ret == TRDP_NO_ERR) && (pSession->cbWorkerCnt > 0u))
+        {
+            ret = trdp_cbDispatchStart(pSession);
+        }
+#if TRDP_PD_RCV_THREAD
+        if ((ret == TRDP_NO_ERR) && (pSession->option & TRDP_OPTION_PD_THREAD))
+        {
+            ret = trdp_pdRcvThreadStart(pSession);
+        }
+#endif
         if (ret == TRDP_NO_ERR)
         {
             vos_printLogStr(VOS_LOG_INFO, "TRDP session opened successfully\n");
@@ -490,6 +633,63 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
     if (pProcessConfig != NULL)
     {
         pSession->option = pProcessConfig->options;
+#if !TRDP_PD_RCV_THREAD
+        if (pSession->option & TRDP_OPTION_PD_THREAD)
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "TRDP_OPTION_PD_THREAD not supported on this target\n");
+            pSession->option &= (TRDP_OPTION_T) ~TRDP_OPTION_PD_THREAD;
+        }
+#endif
+#if !TRDP_TIMING_STATS
+        if (pSession->option & TRDP_OPTION_TIMING_STATS)
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "TRDP_OPTION_TIMING_STATS not supported by this build\n");
+            pSession->option &= (TRDP_OPTION_T) ~TRDP_OPTION_TIMING_STATS;
+        }
+#else
+        if (pSession->option & TRDP_OPTION_TIMING_STATS)
+        {
+            trdp_timingInit();
+        }
+#endif
+        pSession->busyPollBudget        = (pProcessConfig->busyPollBudget != 0u) ?
+            pProcessConfig->busyPollBudget : TRDP_PD_BUSY_POLL_BUDGET;
+        pSession->budgetFrames          = pProcessConfig->budgetFrames;
+        pSession->budgetTime            = pProcessConfig->budgetTime;
+#if TRDP_PD_RCV_THREAD
+        /*  The sockets of the receive threads are bound once, the number of threads can not change later  */
+        if ((pProcessConfig->pdRcvShards > 1u) && (pSession->pdShardCnt == 0u))
+        {
+            if (!(pSession->option & TRDP_OPTION_PD_THREAD) ||
+                (pSession->option & (TRDP_OPTION_BLOCK | TRDP_OPTION_NO_REUSE_ADDR)))
+            {
+                vos_printLogStr(VOS_LOG_WARNING,
+                                "pdRcvShards needs TRDP_OPTION_PD_THREAD, non-blocking and reusable sockets\n");
+            }
+            else if (pProcessConfig->pdRcvShards > TRDP_PD_RCV_SHARDS_MAX)
+            {
+                vos_printLog(VOS_LOG_WARNING, "pdRcvShards limited to %u\n", (unsigned int) TRDP_PD_RCV_SHARDS_MAX);
+                pSession->pdShardCnt = (TRDP_PD_RCV_SHARDS_MAX > 1u) ? TRDP_PD_RCV_SHARDS_MAX : 0u;
+            }
+            else
+            {
+                pSession->pdShardCnt = pProcessConfig->pdRcvShards;
+            }
+        }
+#endif
+        /*  The workers are started with the session  */
+        if ((pProcessConfig->cbWorkers > 0u) && (pSession->pCbDispatch == NULL))
+        {
+            if (pProcessConfig->cbWorkers > TRDP_CB_WORKERS_MAX)
+            {
+                vos_printLog(VOS_LOG_WARNING, "cbWorkers limited to %u\n", (unsigned int) TRDP_CB_WORKERS_MAX);
+                pSession->cbWorkerCnt = TRDP_CB_WORKERS_MAX;
+            }
+            else
+            {
+                pSession->cbWorkerCnt = pProcessConfig->cbWorkers;
+            }
+        }
         pSession->stats.processCycle    = pProcessConfig->cycleTime;
         pSession->stats.processPrio     = pProcessConfig->priority;
         vos_strncpy(pSession->stats.hostName, pProcessConfig->hostName, TRDP_MAX_LABEL_LEN - 1);
@@ -555,6 +755,11 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
         {
             pSession->pdDefault.sendParam.ttl = pPdDefault->sendParam.ttl;
         }
+
+        if (pPdDefault->sendParam.txTime)
+        {
+            pSession->pdDefault.sendParam.txTime = TRUE;
+        }
     }
 
 #if MD_SUPPORT
@@ -647,6 +852,8 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
             pSession->mdDefault.maxNumSessions = pMdDefault->maxNumSessions;
         }
 
+        pSession->mdDefault.maxNumIdleConn = pMdDefault->maxNumIdleConn;
+
     }
 
 #endif
@@ -706,6 +913,11 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
             }
         }
 
+        if (found)
+        {
+            trdp_sessionUnregister((TRDP_SESSION_PT) appHandle);
+        }
+
         /* We can release the global session mutex after removing the session from the list */
         if (vos_mutexUnlock(sSessionMutex) != VOS_NO_ERR)
         {
@@ -716,9 +928,19 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
         if (found)
         {
             pSession = (TRDP_SESSION_PT) appHandle;
+            pSession->magic = 0u;
+
+#if TRDP_PD_RCV_THREAD
+            /*    The receive thread locks the session, it must be gone before    */
+            trdp_pdRcvThreadStop(pSession);
+#endif
+            /*    Waiting callbacks are called before the session is gone    */
+            trdp_cbDispatchStop(pSession);
+            /*    No more frames from the sockets shared with other sessions    */
+            trdp_shareDetach(pSession);
 
             /*    Take the session mutex to prevent someone sitting on the branch while we cut it    */
-            ret = (TRDP_ERR_T) vos_mutexLock(pSession->mutex);
+            ret = (TRDP_ERR_T) trdp_sessionLock(pSession);
 
             if (ret != TRDP_NO_ERR)
             {
@@ -729,6 +951,15 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
 
                 /*    Release all allocated sockets and memory    */
                 vos_memFree(pSession->pNewFrame);
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+                {
+                    UINT32 i;
+                    for (i = 0u; i < TRDP_PD_RCV_BATCH_SIZE; i++)
+                    {
+                        vos_memFree(pSession->pRcvBatch[i]);
+                    }
+                }
+#endif
 
                 while (pSession->pSndQueue != NULL)
                 {
@@ -736,11 +967,21 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
 
                     /*  UnPublish our packets   */
                     trdp_releaseSocket(appHandle->iface, pSession->pSndQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
+                    if (pSession->pSndQueue->redSocketIdx != 0u)
+                    {
+                        trdp_releaseSocket(pSession->iface, (INT32) pSession->pSndQueue->redSocketIdx - 1, 0, FALSE,
+                                           VOS_INADDR_ANY);
+                    }
 
+                    trdp_seqPubUnlist(pSession->pSndQueue);
                     if (pSession->pSndQueue->pSeqCntList != NULL)
                     {
                         vos_memFree(pSession->pSndQueue->pSeqCntList);
                     }
+                    if (pSession->pSndQueue->pDelta != NULL)
+                    {
+                        vos_memFree(pSession->pSndQueue->pDelta);
+                    }
                     vos_memFree(pSession->pSndQueue->pFrame);
 
                     /*    Only close socket if not used anymore    */
@@ -750,6 +991,19 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     pSession->pSndQueue = pNext;
                 }
 
+                trdp_pdSchedFree(pSession);
+                trdp_pdTimeoutFree(pSession);
+                trdp_pdPullRemoveSub(pSession, NULL);
+                trdp_pdDistributeFree(pSession);
+                trdp_pdRedGroupsFree(pSession);
+                trdp_pdGroupsFree(pSession);
+                trdp_sdtFree(pSession);
+                trdp_srcTableFree(pSession);
+                trdp_exportStop(pSession);
+#if TRDP_RECORDER
+                trdp_recStop(pSession);
+#endif
+
                 while (pSession->pRcvQueue != NULL)
                 {
                     PD_ELE_T *pNext = pSession->pRcvQueue->pNext;
@@ -761,10 +1015,27 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     {
                         vos_memFree(pSession->pRcvQueue->pSeqCntList);
                     }
-                    if (pSession->pRcvQueue->pFrame != NULL)
+                    if (pSession->pRcvQueue->pDelta != NULL)
+                    {
+                        vos_memFree(pSession->pRcvQueue->pDelta);
+                    }
+                    while (pSession->pRcvQueue->pConsumers != NULL)
+                    {
+                        TRDP_PD_CONSUMER_T *pNextCons = pSession->pRcvQueue->pConsumers->pNext;
+
+                        vos_memFree(pSession->pRcvQueue->pConsumers);
+                        pSession->pRcvQueue->pConsumers = pNextCons;
+                    }
+                    if (trdp_pdFrameReclaim(pSession->pRcvQueue, 0u) != NULL)
                     {
                         vos_memFree(pSession->pRcvQueue->pFrame);
                     }
+#if TRDP_PD_RCV_THREAD
+                    if (pSession->pRcvQueue->pSnap != NULL)
+                    {
+                        vos_memFree(pSession->pRcvQueue->pSnap);
+                    }
+#endif
                     vos_memFree(pSession->pRcvQueue);
                     pSession->pRcvQueue = pNext;
                 }
@@ -791,7 +1062,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                                        pSession->mdDefault.connectTimeout,
                                        FALSE,
                                        VOS_INADDR_ANY);
-                    trdp_mdFreeSession(pSession->pMDSndQueue);
+                    trdp_mdFreeSession(pSession, pSession->pMDSndQueue);
                     pSession->pMDSndQueue = pNext;
                 }
                 /*    Release all allocated sockets and memory    */
@@ -805,9 +1076,13 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                                        pSession->mdDefault.connectTimeout,
                                        FALSE,
                                        VOS_INADDR_ANY);
-                    trdp_mdFreeSession(pSession->pMDRcvQueue);
+                    trdp_mdFreeSession(pSession, pSession->pMDRcvQueue);
                     pSession->pMDRcvQueue = pNext;
                 }
+                trdp_mdSchedFree(pSession);
+                trdp_mdStreamFree(pSession);
+                trdp_mdUdpSegFree(pSession);
+                trdp_mdPoolFree(pSession);
                 /*    Release all allocated sockets and memory    */
                 while (pSession->pMDListenQueue != NULL)
                 {
@@ -832,11 +1107,30 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     pSession->tcpFd.listen_sd = VOS_INVALID_SOCKET;
                 }
 #endif
-                if (vos_mutexUnlock(pSession->mutex) != VOS_NO_ERR)
+                trdp_freeSockets(pSession->iface);
+                if (pSession->pdXdp != NULL)
+                {
+                    (void) vos_xdpClose(pSession->pdXdp);
+                    pSession->pdXdp = NULL;
+                }
+#if TRDP_PD_URING
+                if (pSession->pdUring != NULL)
+                {
+                    (void) vos_uringClose(pSession->pdUring);
+                    pSession->pdUring = NULL;
+                }
+#endif
+                if (pSession->pollSet != NULL)
+                {
+                    (void) vos_pollDelete(pSession->pollSet);
+                    pSession->pollSet = NULL;
+                }
+                if (trdp_sessionUnlock(pSession) != VOS_NO_ERR)
                 {
                     vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
                 }
 
+                vos_mutexDelete(pSession->sndMutex);
                 vos_mutexDelete(pSession->mutex);
                 vos_memFree(pSession);
             }
@@ -879,7 +1173,12 @@ EXT_DECL TRDP_ERR_T tlc_terminate (void)
         /* Delete SessionMutex and clear static variable */
         vos_mutexDelete(sSessionMutex);
         sSessionMutex = NULL;
+        trdp_shareTerm();
+        trdp_seqPubTerm();
 
+#if TRDP_TRACE && defined (WIN32)
+        TraceLoggingUnregister(trdp_traceProvider);
+#endif
         /* Close stop timers, release memory  */
         vos_terminate();
         sInited = FALSE;
@@ -895,6 +1194,9 @@ EXT_DECL TRDP_ERR_T tlc_terminate (void)
 /** Re-Initialize.
  *  Should be called by the application when a link-down/link-up event has occured during normal operation.
  *  We need to re-join the multicast groups...
+ *  The sockets stay open. Each membership recorded for a socket is joined once, however many subscriptions or
+ *  listeners share it; source specific memberships are joined for their source again. The duration is added to
+ *  the timing statistics (TRDP_TIMING_REINIT).
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
  *
@@ -905,8 +1207,6 @@ EXT_DECL TRDP_ERR_T tlc_terminate (void)
 EXT_DECL TRDP_ERR_T tlc_reinitSession (
     TRDP_APP_SESSION_T appHandle)
 {
-    PD_ELE_T    *iterPD;
-
     TRDP_ERR_T  ret;
 
     if (trdp_isValidSession(appHandle))
@@ -914,35 +1214,51 @@ EXT_DECL TRDP_ERR_T tlc_reinitSession (
         ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
         if (ret == TRDP_NO_ERR)
         {
-            /*    Walk over the registered PDs */
-            for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+            UINT32  numJoin     = 0u;
+            INT32   lIndex;
+#if TRDP_TIMING_STATS
+            UINT64  startStamp  = trdp_timingStamp();
+#endif
+
+            /*    Walk over the memberships of the sockets */
+            for (lIndex = 0; lIndex < (INT32) VOS_MAX_SOCKET_CNT; lIndex++)
             {
-                if (iterPD->privFlags & TRDP_MC_JOINT &&
-                    iterPD->socketIdx != -1)
+                TRDP_SOCKETS_T  *pSock = &appHandle->iface[lIndex];
+                UINT32          i;
+
+                if ((pSock->sock == VOS_INVALID_SOCKET) || (pSock->usage <= 0))
                 {
-                    /*    Join the MC group again    */
-                    ret = (TRDP_ERR_T) vos_sockJoinMC(appHandle->iface[iterPD->socketIdx].sock,
-                                                      iterPD->addr.mcGroup,
-                                                      appHandle->realIP);
+                    continue;
                 }
-            }
-#if MD_SUPPORT
-            {
-                MD_ELE_T *iterMD;
-                /*    Walk over the registered MDs */
-                for (iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext )
+                for (i = 0u; i < pSock->mcJoinCnt; i++)
                 {
-                    if (iterMD->privFlags & TRDP_MC_JOINT &&
-                        iterMD->socketIdx != -1)
+                    VOS_ERR_T err;
+
+                    /*    Join the MC group again    */
+                    if (pSock->pMcJoins[i].srcIp != VOS_INADDR_ANY)
+                    {
+                        err = vos_sockJoinSourceMC(pSock->sock, pSock->pMcJoins[i].mcGroup,
+                                                   pSock->pMcJoins[i].srcIp, appHandle->realIP);
+                    }
+                    else
+                    {
+                        err = vos_sockJoinMC(pSock->sock, pSock->pMcJoins[i].mcGroup, appHandle->realIP);
+                    }
+                    if (err != VOS_NO_ERR)
                     {
-                        /*    Join the MC group again    */
-                        ret = (TRDP_ERR_T) vos_sockJoinMC(appHandle->iface[iterMD->socketIdx].sock,
-                                                          iterMD->addr.mcGroup,
-                                                          appHandle->realIP);
+                        ret = (TRDP_ERR_T) err;
                     }
+                    numJoin++;
                 }
             }
+#if TRDP_TIMING_STATS
+            if (appHandle->option & TRDP_OPTION_TIMING_STATS)
+            {
+                trdp_timingAddNs(appHandle, TRDP_TIMING_REINIT, trdp_timingStamp() - startStamp);
+            }
 #endif
+            vos_printLog(VOS_LOG_INFO, "tlc_reinitSession: %u multicast memberships joined again\n", numJoin);
+
             if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
             {
                 vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -1004,57 +1320,39 @@ TRDP_ERR_T tlp_setRedundant (
     UINT32              redId,
     BOOL8               leader)
 {
-    TRDP_ERR_T  ret = TRDP_NOINIT_ERR;
-    PD_ELE_T    *iterPD;
-    BOOL8       found = FALSE;
+    TRDP_RED_GROUP_T *pGroup;
 
-    if (trdp_isValidSession(appHandle))
+    if (!trdp_isValidSession(appHandle))
     {
-        ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
-        if (TRDP_NO_ERR == ret)
-        {
-            /*    Set the redundancy flag for every PD with the specified ID */
-            for (iterPD = appHandle->pSndQueue; NULL != iterPD; iterPD = iterPD->pNext)
-            {
-                if ((0u != iterPD->redId)                           /* packet has redundant ID       */
-                    &&
-                    ((0u == redId) || (iterPD->redId == redId)))    /* all set redundant ID are targeted if redId == 0
-                                                                      or packet redundant ID matches       */
-                {
-                    if (TRUE == leader)
-                    {
-                        iterPD->privFlags = (TRDP_PRIV_FLAGS_T) (iterPD->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_REDUNDANT);
-                    }
-                    else
-                    {
-                        iterPD->privFlags |= TRDP_REDUNDANT;
-                    }
-                    found = TRUE;
-                }
-            }
-
-            /*  It would lead to an error, if the user tries to change the redundancy on a non-existant group, because
-             the leadership state is recorded in the PD send queue! If there is no published comID with a certain
-             redId, it would never be set... */
-            if ((FALSE == found) && (0u != redId))
-            {
-                vos_printLogStr(VOS_LOG_ERROR, "Redundant ID not found\n");
-                ret = TRDP_PARAM_ERR;
-            }
+        return TRDP_NOINIT_ERR;
+    }
 
-            if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
-            {
-                vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
-            }
+    /*  The publishers of a group share its state, which is checked when they are due: no queue walk, no lock   */
+    if (0u == redId)
+    {
+        /*  all groups are targeted  */
+        for (pGroup = TRDP_ATOMIC_LOAD(appHandle->pRedGroups); NULL != pGroup; pGroup = pGroup->pNext)
+        {
+            TRDP_ATOMIC_STORE(pGroup->follower, (BOOL8) !leader);
         }
+        return TRDP_NO_ERR;
     }
 
-    return ret;
+    /*  It would lead to an error, if the user tries to change the redundancy on a non-existant group: a group
+     exists once a comID was published with this redId */
+    pGroup = trdp_pdRedGroup(appHandle, redId, FALSE);
+    if (NULL == pGroup)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Redundant ID not found\n");
+        return TRDP_PARAM_ERR;
+    }
+    TRDP_ATOMIC_STORE(pGroup->follower, (BOOL8) !leader);
+
+    return TRDP_NO_ERR;
 }
 
 /**********************************************************************************************************************/
 /** Get status of redundant ComIds.
- *  Only the status of the first found redundancy group entry will be returned!
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @param[in]      redId               will be returned for all ComID's with the given redId
@@ -1069,44 +1367,25 @@ EXT_DECL TRDP_ERR_T tlp_getRedundant (
     UINT32              redId,
     BOOL8               *pLeader)
 {
-    TRDP_ERR_T  ret = TRDP_NOINIT_ERR;
-    PD_ELE_T    *iterPD;
+    TRDP_RED_GROUP_T *pGroup;
 
     if ((pLeader == NULL) || (redId == 0u))
     {
         return TRDP_PARAM_ERR;
     }
 
-    if (trdp_isValidSession(appHandle))
+    if (!trdp_isValidSession(appHandle))
     {
-        ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
-        if (ret == TRDP_NO_ERR)
-        {
-            /*    Search the redundancy flag for every PD with the specified ID */
-            for (iterPD = appHandle->pSndQueue; NULL != iterPD; iterPD = iterPD->pNext)
-            {
-                if (iterPD->redId == redId)         /* packet redundant ID matches                      */
-                {
-                    if (iterPD->privFlags & TRDP_REDUNDANT)
-                    {
-                        *pLeader = FALSE;
-                    }
-                    else
-                    {
-                        *pLeader = TRUE;
-                    }
-                    break;
-                }
-            }
+        return TRDP_NOINIT_ERR;
+    }
 
-            if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
-            {
-                vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
-            }
-        }
+    pGroup = trdp_pdRedGroup(appHandle, redId, FALSE);
+    if (NULL != pGroup)
+    {
+        *pLeader = (TRDP_ATOMIC_LOAD(pGroup->follower) == TRUE) ? FALSE : TRUE;
     }
 
-    return ret;
+    return TRDP_NO_ERR;
 }
 
 /**********************************************************************************************************************/
@@ -1128,13 +1407,20 @@ EXT_DECL TRDP_ERR_T tlc_setETBTopoCount (
 
     if (trdp_isValidSession(appHandle))
     {
-        ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+        ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
         if (ret == TRDP_NO_ERR)
         {
+            UINT32 oldEtbTopoCnt = appHandle->etbTopoCnt;
+
             /*  Set the etbTopoCnt for each session  */
             appHandle->etbTopoCnt = etbTopoCnt;
 
-            if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+            if ((appHandle->option & TRDP_OPTION_TOPO_FOLLOW) && (etbTopoCnt != oldEtbTopoCnt))
+            {
+                trdp_pdTopoFollow(appHandle, oldEtbTopoCnt, 0u);
+            }
+
+            if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
             {
                 vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
             }
@@ -1167,13 +1453,20 @@ EXT_DECL TRDP_ERR_T tlc_setOpTrainTopoCount (
 
     if (trdp_isValidSession(appHandle))
     {
-        ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+        ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
         if (ret == TRDP_NO_ERR)
         {
+            UINT32 oldOpTrnTopoCnt = appHandle->opTrnTopoCnt;
+
             /*  Set the opTrnTopoCnt for each session  */
             appHandle->opTrnTopoCnt = opTrnTopoCnt;
 
-            if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+            if ((appHandle->option & TRDP_OPTION_TOPO_FOLLOW) && (opTrnTopoCnt != oldOpTrnTopoCnt))
+            {
+                trdp_pdTopoFollow(appHandle, 0u, oldOpTrnTopoCnt);
+            }
+
+            if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
             {
                 vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
             }
@@ -1188,34 +1481,85 @@ EXT_DECL TRDP_ERR_T tlc_setOpTrainTopoCount (
 }
 
 /**********************************************************************************************************************/
-/** Set new topocount for trainwide communication
- *
- *    This value is used for validating outgoing and incoming packets only!
- *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
- *
- *  @retval         etbTopoCnt
- */
-EXT_DECL UINT32 tlc_getETBTopoCount (TRDP_APP_SESSION_T appHandle)
-{
-    if (trdp_isValidSession(appHandle))
-    {
-        return appHandle->etbTopoCnt;
-    }
-    return 0u;
-}
-
-/**********************************************************************************************************************/
-/** Set new operational train topocount for direction/orientation sensitive communication.
- *
- *    This value is used for validating outgoing and incoming packets only!
+/** Set both topocounts at once, e.g. after an inauguration.
+ *  With TRDP_OPTION_TOPO_FOLLOW, the publishers and subscriptions using the former counters are updated in one pass.
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      etbTopoCnt          New ETB topocount value
+ *  @param[in]      opTrnTopoCnt        New operational topocount value
  *
- *  @retval         opTrnTopoCnt        New operational topocount value
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
-EXT_DECL UINT32 tlc_getOpTrainTopoCount (
-    TRDP_APP_SESSION_T appHandle)
+EXT_DECL TRDP_ERR_T tlc_setTopoCounts (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              etbTopoCnt,
+    UINT32              opTrnTopoCnt)
+{
+    TRDP_ERR_T ret;
+
+    if (trdp_isValidSession(appHandle))
+    {
+        ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+        if (ret == TRDP_NO_ERR)
+        {
+            UINT32  oldEtbTopoCnt   = appHandle->etbTopoCnt;
+            UINT32  oldOpTrnTopoCnt = appHandle->opTrnTopoCnt;
+
+            appHandle->etbTopoCnt   = etbTopoCnt;
+            appHandle->opTrnTopoCnt = opTrnTopoCnt;
+
+            if ((appHandle->option & TRDP_OPTION_TOPO_FOLLOW) &&
+                ((etbTopoCnt != oldEtbTopoCnt) || (opTrnTopoCnt != oldOpTrnTopoCnt)))
+            {
+                trdp_pdTopoFollow(appHandle,
+                                  (etbTopoCnt != oldEtbTopoCnt) ? oldEtbTopoCnt : 0u,
+                                  (opTrnTopoCnt != oldOpTrnTopoCnt) ? oldOpTrnTopoCnt : 0u);
+            }
+
+            if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
+            {
+                vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+            }
+        }
+    }
+    else
+    {
+        ret = TRDP_NOINIT_ERR;
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Set new topocount for trainwide communication
+ *
+ *    This value is used for validating outgoing and incoming packets only!
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *
+ *  @retval         etbTopoCnt
+ */
+EXT_DECL UINT32 tlc_getETBTopoCount (TRDP_APP_SESSION_T appHandle)
+{
+    if (trdp_isValidSession(appHandle))
+    {
+        return appHandle->etbTopoCnt;
+    }
+    return 0u;
+}
+
+/**********************************************************************************************************************/
+/** Set new operational train topocount for direction/orientation sensitive communication.
+ *
+ *    This value is used for validating outgoing and incoming packets only!
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *
+ *  @retval         opTrnTopoCnt        New operational topocount value
+ */
+EXT_DECL UINT32 tlc_getOpTrainTopoCount (
+    TRDP_APP_SESSION_T appHandle)
 {
     if (trdp_isValidSession(appHandle))
     {
@@ -1224,6 +1568,77 @@ EXT_DECL UINT32 tlc_getOpTrainTopoCount (
     return 0u;
 }
 
+/**********************************************************************************************************************/
+/** Enter or leave the operational phase.
+ *  Call this when all telegrams of the session are set up. With TRDP_OPTION_PREALLOCATE, the buffers the traffic of
+ *  the configured publishers, subscribers and MD sessions needs are allocated now: the sequence counter tables of
+ *  the subscribers and maxNumSessions MD elements and frames.
+ *  VOS memory is set operational, allocations from then on are counted and reported depending on
+ *  VOS_MEM_CHECK_OPERATIONAL. Leave the operational phase before changing the configuration.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      operational         TRUE: start up is done
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+EXT_DECL TRDP_ERR_T tlc_setOperational (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               operational)
+{
+    TRDP_ERR_T  ret = TRDP_NO_ERR;
+    PD_ELE_T    *iterPD;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (operational && (appHandle->option & TRDP_OPTION_PREALLOCATE))
+    {
+        if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
+        {
+            return TRDP_NOINIT_ERR;
+        }
+
+        /* another session may already be operational */
+        vos_memSetOperational(FALSE);
+
+        for (iterPD = appHandle->pRcvQueue; (iterPD != NULL) && (ret == TRDP_NO_ERR); iterPD = iterPD->pNext)
+        {
+            ret = trdp_initSequenceCounter(iterPD);
+        }
+        trdp_srcTablePrepare(appHandle);
+        for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        {
+            if ((iterPD->dataSize == 0u) && (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))
+            {
+                vos_printLog(VOS_LOG_WARNING, "ComId %u published without data, tlp_put() will allocate\n",
+                             iterPD->addr.comId);
+            }
+        }
+#if MD_SUPPORT
+        if (ret == TRDP_NO_ERR)
+        {
+            ret = trdp_mdPoolFill(appHandle);
+        }
+#endif
+        if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+        if (ret != TRDP_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "tlc_setOperational() failed to preallocate\n");
+            return ret;
+        }
+    }
+
+    vos_memSetOperational(operational);
+    return ret;
+}
+
 /**********************************************************************************************************************/
 /** Prepare for sending PD messages.
  *  Queue a PD message, it will be send when tlc_publish has been called
@@ -1285,7 +1700,7 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     }
 
     /*    Reserve mutual access    */
-    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
     if (ret == TRDP_NO_ERR)
     {
         TRDP_ADDRESSES_T pubHandle;
@@ -1301,6 +1716,8 @@ EXT_DECL TRDP_ERR_T tlp_publish (
         pubHandle.destIpAddr    = destIpAddr;
         pubHandle.mcGroup       = vos_isMulticast(destIpAddr) ? destIpAddr : 0u;
         pubHandle.srcIpAddr     = srcIpAddr;
+        pubHandle.etbTopoCnt    = etbTopoCnt;
+        pubHandle.opTrnTopoCnt  = opTrnTopoCnt;
 
         /*    Look for existing element    */
         if (trdp_queueFindPubAddr(appHandle->pSndQueue, &pubHandle) != NULL)
@@ -1308,6 +1725,11 @@ EXT_DECL TRDP_ERR_T tlp_publish (
             /*  Already published! */
             ret = TRDP_NOPUB_ERR;
         }
+        /*    The publisher joins its redundancy group and follows the state of the group    */
+        else if ((0u != redId) && (trdp_pdRedGroup(appHandle, redId, TRUE) == NULL))
+        {
+            ret = TRDP_MEM_ERR;
+        }
         else
         {
             pNewElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
@@ -1348,8 +1770,14 @@ EXT_DECL TRDP_ERR_T tlp_publish (
                 }
                 else
                 {
+#if TRDP_PD_QOS_PER_FRAME
+                    pNewElement->qos = (pSendParam != NULL) ? pSendParam->qos : appHandle->pdDefault.sendParam.qos;
+#endif
+                    pNewElement->prio = TRDP_PD_PRIO_OF((pSendParam != NULL) ?
+                                                        pSendParam->qos : appHandle->pdDefault.sendParam.qos);
                     /*  Alloc the corresponding data buffer  */
-                    pNewElement->pFrame = (PD_PACKET_T *) vos_memAlloc(pNewElement->grossSize);
+                    pNewElement->pFrame = (PD_PACKET_T *) vos_memAllocAligned(pNewElement->grossSize,
+                                                                              TRDP_PD_FRAME_ALIGN);
                     if (pNewElement->pFrame == NULL)
                     {
                         vos_memFree(pNewElement);
@@ -1377,6 +1805,20 @@ EXT_DECL TRDP_ERR_T tlp_publish (
                 vos_addTime(&nextTime, &tv_interval);
                 pNewElement->interval   = tv_interval;
                 pNewElement->timeToGo   = nextTime;
+
+                /*  Sent ahead by one process cycle, the interface transmits it at timeToGo    */
+                if (appHandle->iface[pNewElement->socketIdx].sendParam.txTime)
+                {
+                    UINT32 lead = (appHandle->stats.processCycle != 0u) ?
+                        appHandle->stats.processCycle : TRDP_PD_TXTIME_LEAD;
+
+                    if (lead >= interval)
+                    {
+                        lead = interval / 2u;
+                    }
+                    pNewElement->txLead.tv_sec  = lead / 1000000u;
+                    pNewElement->txLead.tv_usec = lead % 1000000;
+                }
             }
 
             /*    Update the internal data */
@@ -1385,6 +1827,7 @@ EXT_DECL TRDP_ERR_T tlp_publish (
             /* pNewElement->privFlags      = TRDP_PRIV_NONE; */
             pNewElement->pullIpAddress  = 0u;
             pNewElement->redId          = redId;
+            pNewElement->pRedGroup      = trdp_pdRedGroup(appHandle, redId, FALSE);
             pNewElement->pCachedDS      = NULL;
             pNewElement->magic          = TRDP_MAGIC_PUB_HNDL_VALUE;
             pNewElement->pUserRef       = pUserRef;
@@ -1404,46 +1847,40 @@ EXT_DECL TRDP_ERR_T tlp_publish (
              curSeqCnt holds the last sent sequence counter, therefore set the value initially to -1,
              it will be incremented when sending...    */
 
-            pNewElement->curSeqCnt = trdp_getSeqCnt(pNewElement->addr.comId, TRDP_MSG_PD,
+            pNewElement->curSeqCnt = trdp_getSeqCnt(appHandle, pNewElement->addr.comId, TRDP_MSG_PD,
                                                     pNewElement->addr.srcIpAddr) - 1;
 
             /*  Get a second sequence counter in case this packet is requested as PULL. This way we will not
              disturb the monotonic sequence for PDs  */
-            pNewElement->curSeqCnt4Pull = trdp_getSeqCnt(pNewElement->addr.comId, TRDP_MSG_PP,
+            pNewElement->curSeqCnt4Pull = trdp_getSeqCnt(appHandle, pNewElement->addr.comId, TRDP_MSG_PP,
                                                          pNewElement->addr.srcIpAddr) - 1;
 
-            /*    Check if the redundancy group is already set as follower; if set, we need to mark this one also!
-             This will only happen, if publish() is called while we are in redundant mode */
-            if (0 != redId)
-            {
-                BOOL8 isLeader = TRUE;
-
-                ret = tlp_getRedundant(appHandle, redId, &isLeader);
-                if (ret == TRDP_NO_ERR && FALSE == isLeader)
-                {
-                    pNewElement->privFlags |= TRDP_REDUNDANT;
-                }
-            }
-
             /*    Compute the header fields */
             trdp_pdInit(pNewElement, TRDP_MSG_PD, etbTopoCnt, opTrnTopoCnt, 0u, 0u);
 
             /*    Insert at front    */
-            trdp_queueInsFirst(&appHandle->pSndQueue, pNewElement);
+            trdp_sndQueueInsFirst(appHandle, pNewElement);
+            appHandle->stats.pd.numPub++;
+            ret = trdp_pdSchedUpdate(appHandle, pNewElement);
 
             *pPubHandle = (TRDP_PUB_T) pNewElement;
 
-            if (dataSize != 0u)
+            if ((ret == TRDP_NO_ERR) && (dataSize != 0u))
             {
                 ret = tlp_put(appHandle, *pPubHandle, pData, dataSize);
             }
-            if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
+            if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING) &&
+                (appHandle->pdBatch == FALSE))
             {
-                ret = trdp_pdDistribute(appHandle->pSndQueue);
+                ret = trdp_pdDistribute(appHandle, pNewElement);
+                if (ret == TRDP_NO_ERR)
+                {
+                    ret = trdp_pdSchedRebuild(appHandle);
+                }
             }
         }
 
-        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
@@ -1452,6 +1889,86 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     return ret;
 }
 
+/**********************************************************************************************************************/
+/** Prepare for sending a set of PD messages.
+ *  Publishes all entries under one session lock. Traffic shaping and the send schedule are updated once
+ *  after the last entry instead of once per publisher.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pEntries            publishers; pubHandle and result are set for each entry
+ *  @param[in]      numEntries          number of entries
+ *
+ *  @retval         TRDP_NO_ERR         all entries published
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               error of the first entry that failed, see the results of the entries
+ */
+EXT_DECL TRDP_ERR_T tlp_publishBatch (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_ENTRY_T    *pEntries,
+    UINT32              numEntries)
+{
+    TRDP_ERR_T  ret = TRDP_NO_ERR;
+    UINT32      i;
+
+    if ((pEntries == NULL) && (numEntries != 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access, tlp_publish locks recursively    */
+    if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    appHandle->pdBatch = TRUE;
+
+    for (i = 0u; i < numEntries; i++)
+    {
+        TRDP_PUB_ENTRY_T *pEntry = &pEntries[i];
+
+        pEntry->pubHandle   = NULL;
+        pEntry->result      = tlp_publish(appHandle, &pEntry->pubHandle, pEntry->pUserRef, pEntry->pfCbFunction,
+                                          pEntry->comId, pEntry->etbTopoCnt, pEntry->opTrnTopoCnt,
+                                          pEntry->srcIpAddr, pEntry->destIpAddr, pEntry->interval, pEntry->redId,
+                                          pEntry->pktFlags, pEntry->pSendParam, pEntry->pData, pEntry->dataSize);
+        if ((pEntry->result != TRDP_NO_ERR) && (ret == TRDP_NO_ERR))
+        {
+            ret = pEntry->result;
+        }
+    }
+
+    appHandle->pdBatch = FALSE;
+
+    /*  Place all new publishers at once    */
+    if ((numEntries != 0u) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
+    {
+        TRDP_ERR_T err = trdp_pdDistribute(appHandle, NULL);
+
+        if (err == TRDP_NO_ERR)
+        {
+            err = trdp_pdSchedRebuild(appHandle);
+        }
+        if (ret == TRDP_NO_ERR)
+        {
+            ret = err;
+        }
+    }
+
+    if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+}
+
 /**********************************************************************************************************************/
 /** Prepare for sending PD messages.
  *  Reinitialize and queue a PD message, it will be send when tlc_publish has been called
@@ -1489,7 +2006,7 @@ EXT_DECL TRDP_ERR_T tlp_republish (
     }
 
     /*    Reserve mutual access    */
-    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
     {
         return TRDP_NOINIT_ERR;
     }
@@ -1497,6 +2014,7 @@ EXT_DECL TRDP_ERR_T tlp_republish (
     /*  Change the addressing item   */
     pubHandle->addr.srcIpAddr   = srcIpAddr;
     pubHandle->addr.destIpAddr  = destIpAddr;
+    trdp_seqPubList(pubHandle);
 
     pubHandle->addr.etbTopoCnt      = etbTopoCnt;
     pubHandle->addr.opTrnTopoCnt    = opTrnTopoCnt;
@@ -1513,7 +2031,7 @@ EXT_DECL TRDP_ERR_T tlp_republish (
     /*    Compute the header fields */
     trdp_pdInit(pubHandle, TRDP_MSG_PD, etbTopoCnt, opTrnTopoCnt, 0u, 0u);
 
-    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
     }
@@ -1556,27 +2074,32 @@ TRDP_ERR_T  tlp_unpublish (
     }
 
     /*    Reserve mutual access    */
-    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
     if (ret == TRDP_NO_ERR)
     {
         /*    Remove from queue?    */
-        trdp_queueDelElement(&appHandle->pSndQueue, pElement);
+        trdp_pdSchedRemove(appHandle, pElement);
+        trdp_pdDistributeRemove(appHandle, pElement);
+        trdp_sndQueueDelElement(appHandle, pElement);
+        appHandle->stats.pd.numPub--;
         trdp_releaseSocket(appHandle->iface, pElement->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+        if (pElement->redSocketIdx != 0u)
+        {
+            trdp_releaseSocket(appHandle->iface, (INT32) pElement->redSocketIdx - 1, 0u, FALSE, VOS_INADDR_ANY);
+        }
         pElement->magic = 0u;
         if (pElement->pSeqCntList != NULL)
         {
             vos_memFree(pElement->pSeqCntList);
         }
-        vos_memFree(pElement->pFrame);
-        vos_memFree(pElement);
-
-        /* Re-compute distribution times */
-        if (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING)
+        if (pElement->pDelta != NULL)
         {
-            ret = trdp_pdDistribute(appHandle->pSndQueue);
+            vos_memFree(pElement->pDelta);
         }
+        vos_memFree(pElement->pFrame);
+        vos_memFree(pElement);
 
-        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
@@ -1625,7 +2148,7 @@ TRDP_ERR_T tlp_put (
     }
 
     /*    Reserve mutual access    */
-    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
     if ( ret == TRDP_NO_ERR )
     {
         /*    Find the published queue entry    */
@@ -1635,7 +2158,7 @@ TRDP_ERR_T tlp_put (
                          pData,
                          dataSize);
 
-        if ( vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR )
+        if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
@@ -1645,236 +2168,221 @@ TRDP_ERR_T tlp_put (
 }
 
 /**********************************************************************************************************************/
-/** Get the lowest time interval for PDs.
- *  Return the maximum time interval suitable for 'select()' so that we
- *    can send due PD packets in time.
- *    If the PD send queue is empty, return zero time
+/** Update the process data of several publishers at once.
+ *  Same as tlp_put for each item, but the session is locked only once. The result of each telegram is returned
+ *  in its item, a failing item does not stop the others.
  *
- *  @param[in]      appHandle          The handle returned by tlc_openSession
- *  @param[out]     pInterval          pointer to needed interval
- *  @param[in,out]  pFileDesc          pointer to file descriptor set
- *  @param[out]     pNoDesc            pointer to put no of highest used descriptors (for select())
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pItems              array of publisher handles and data, result per item
+ *  @param[in]      numItems            number of items
  *
- *  @retval         TRDP_NO_ERR        no error
- *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               result of the last failing item
  */
-EXT_DECL TRDP_ERR_T tlc_getInterval (
+EXT_DECL TRDP_ERR_T tlp_putMulti (
     TRDP_APP_SESSION_T  appHandle,
-    TRDP_TIME_T         *pInterval,
-    TRDP_FDS_T          *pFileDesc,
-    INT32               *pNoDesc)
+    TRDP_PUT_ITEM_T     *pItems,
+    UINT32              numItems)
 {
-    TRDP_TIME_T now;
-    TRDP_ERR_T  ret = TRDP_NOINIT_ERR;
+    TRDP_ERR_T  ret = TRDP_NO_ERR;
+    UINT32      i;
 
-    if (trdp_isValidSession(appHandle))
+    if ((pItems == NULL) && (numItems > 0u))
     {
-        if ((pInterval == NULL)
-            || (pFileDesc == NULL)
-            || (pNoDesc == NULL))
-        {
-            ret = TRDP_PARAM_ERR;
-        }
-        else
-        {
-            ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
-
-            if (ret == TRDP_NO_ERR)
-            {
-                /*    Get the current time    */
-                vos_getTime(&now);
-                vos_clearTime(&appHandle->nextJob);
-
-                trdp_pdCheckPending(appHandle, pFileDesc, pNoDesc);
+        return TRDP_PARAM_ERR;
+    }
 
-#if MD_SUPPORT
-                trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
-#endif
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
-                /*    if next job time is known, return the time-out value to the caller   */
-                if (timerisset(&appHandle->nextJob) &&
-                    timercmp(&now, &appHandle->nextJob, <))
-                {
-                    vos_subTime(&appHandle->nextJob, &now);
-                    *pInterval = appHandle->nextJob;
-                }
-                else if (timerisset(&appHandle->nextJob))
-                {
-                    pInterval->tv_sec   = 0u;                               /* 0ms if time is over (were we delayed?) */
-                    pInterval->tv_usec  = 0;                                /* Application should limit this    */
-                }
-                else    /* if no timeout set, set maximum time to 1000sec   */
-                {
-                    pInterval->tv_sec   = 1000u;                            /* 1000s if no timeout is set      */
-                    pInterval->tv_usec  = 0;                                /* Application should limit this    */
-                }
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+    if ( ret == TRDP_NO_ERR )
+    {
+        for (i = 0u; i < numItems; i++)
+        {
+            PD_ELE_T *pElement = (PD_ELE_T *) pItems[i].pubHandle;
 
-                if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
-                {
-                    vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
-                }
+            if (pElement == NULL)
+            {
+                pItems[i].result = TRDP_PARAM_ERR;
+            }
+            else if (pElement->magic != TRDP_MAGIC_PUB_HNDL_VALUE)
+            {
+                pItems[i].result = TRDP_NOPUB_ERR;
+            }
+            else
+            {
+                pItems[i].result = trdp_pdPut(pElement,
+                                              appHandle->marshall.pfCbMarshall,
+                                              appHandle->marshall.pRefCon,
+                                              pItems[i].pData,
+                                              pItems[i].dataSize);
+            }
+            if (pItems[i].result != TRDP_NO_ERR)
+            {
+                ret = pItems[i].result;
             }
         }
+
+        if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
     }
+
     return ret;
 }
 
 /**********************************************************************************************************************/
-/** Work loop of the TRDP handler.
- *    Search the queue for pending PDs to be sent
- *    Search the receive queue for pending PDs (time out)
- *
+/** Set the heartbeat of a publisher sending on change.
  *
- *  @param[in]      appHandle          The handle returned by tlc_openSession
- *  @param[in]      pRfds              pointer to set of ready descriptors
- *  @param[in,out]  pCount             pointer to number of ready descriptors
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pubHandle           the handle returned by publish
+ *  @param[in]      heartbeat           heartbeat in us, 0: default
  *
- *  @retval         TRDP_NO_ERR        no error
- *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      not published
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
-EXT_DECL TRDP_ERR_T tlc_process (
+EXT_DECL TRDP_ERR_T tlp_setHeartbeat (
     TRDP_APP_SESSION_T  appHandle,
-    TRDP_FDS_T          *pRfds,
-    INT32               *pCount)
+    TRDP_PUB_T          pubHandle,
+    UINT32              heartbeat)
 {
-    TRDP_ERR_T  result = TRDP_NO_ERR;
-    TRDP_ERR_T  err;
+    PD_ELE_T    *pElement = (PD_ELE_T *) pubHandle;
+    TRDP_ERR_T  ret;
+    UINT64      interval;
+    UINT64      cycles = 0u;
 
-    if (!trdp_isValidSession(appHandle))
+    if (pElement == NULL)
     {
-        return TRDP_NOINIT_ERR;
+        return TRDP_PARAM_ERR;
     }
 
-    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    if (pElement->magic != TRDP_MAGIC_PUB_HNDL_VALUE)
     {
-        return TRDP_NOINIT_ERR;
+        return TRDP_NOPUB_ERR;
     }
-    else
-    {
-        vos_clearTime(&appHandle->nextJob);
-
-        /******************************************************
-         Find and send the packets which have to be sent next:
-         ******************************************************/
-
-        err = trdp_pdSendQueued(appHandle);
-
-        if (err != TRDP_NO_ERR)
-        {
-            /*  We do not break here, only report error */
-            result = err;
-            /* vos_printLog(VOS_LOG_ERROR, "trdp_pdSendQueued failed (Err: %d)\n", err);*/
-        }
-
-        /******************************************************
-         Find packets which are pending/overdue
-         ******************************************************/
-        trdp_pdHandleTimeOuts(appHandle);
 
-#if MD_SUPPORT
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
-        err = trdp_mdSend(appHandle);
-        if (err != TRDP_NO_ERR)
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+    if ( ret == TRDP_NO_ERR )
+    {
+        interval = (UINT64) pElement->interval.tv_sec * 1000000u + (UINT64) pElement->interval.tv_usec;
+        if ((heartbeat != 0u) && (interval != 0u))
         {
-            if (err == TRDP_IO_ERR)
+            cycles = heartbeat / interval;
+            if (cycles == 0u)
             {
-                vos_printLogStr(VOS_LOG_INFO, "trdp_mdSend() incomplete \n");
-
+                cycles = 1u;
             }
-            else
+            else if (cycles > 0xFFFFu)
             {
-                result = err;
-                vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+                cycles = 0xFFFFu;
             }
         }
+        pElement->hbCycles  = (UINT16) cycles;
+        pElement->hbSkipped = 0u;
 
-#endif
-
-        /******************************************************
-         Find packets which are to be received
-         ******************************************************/
-        err = trdp_pdCheckListenSocks(appHandle, pRfds, pCount);
-        if (err != TRDP_NO_ERR)
+        if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
         {
-            /*  We do not break here */
-            result = err;
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
+    }
 
-#if MD_SUPPORT
+    return ret;
+}
 
-        trdp_mdCheckListenSocks(appHandle, pRfds, pCount);
+/**********************************************************************************************************************/
+/** Send and receive the PD of a comId range delta encoded.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      firstComId          first comId of the range, 0: no delta encoding
+ *  @param[in]      lastComId           last comId of the range
+ *  @param[in]      keyCycles           every n-th frame is a key frame, 0: TRDP_PD_DELTA_KEY_CYCLES
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_setDeltaRange (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              firstComId,
+    UINT32              lastComId,
+    UINT32              keyCycles)
+{
+    TRDP_ERR_T ret;
 
-        trdp_mdCheckTimeouts(appHandle);
+    if ((firstComId != 0u) && (lastComId < firstComId))
+    {
+        return TRDP_PARAM_ERR;
+    }
 
-#endif
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
-        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+    if ( ret == TRDP_NO_ERR )
+    {
+        appHandle->deltaFirstComId  = firstComId;
+        appHandle->deltaLastComId   = lastComId;
+        appHandle->deltaKeyCycles   = (keyCycles != 0u) ? keyCycles : TRDP_PD_DELTA_KEY_CYCLES;
+
+        if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
     }
 
-    return result;
+    return ret;
 }
 
 /**********************************************************************************************************************/
-/** Initiate sending PD messages (PULL).
- *  Send a PD request message
+/** Send a publication on a second interface as well.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[in]      subHandle           handle from related subscribe
- *  @param[in]      comId               comId of packet to be sent
- *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
- *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
- *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
- *  @param[in]      destIpAddr          where to send the packet to
- *  @param[in]      redId               0 - Non-redundant, > 0 valid redundancy group
- *  @param[in]      pktFlags            OPTION:
- *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
- *  @param[in]      pSendParam          optional pointer to send parameter, NULL - default parameters are used
- *  @param[in]      pData               pointer to packet data / dataset
- *  @param[in]      dataSize            size of packet data
- *  @param[in]      replyComId          comId of reply (default comID of subscription)
- *  @param[in]      replyIpAddr         IP for reply
+ *  @param[in]      pubHandle           the handle returned by publish
+ *  @param[in]      ifaceIp             own IP address on the second network, 0: stop sending there
+ *  @param[in]      destIpAddr          destination on the second network, 0: same as published
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_MEM_ERR        could not insert (out of memory)
+ *  @retval         TRDP_NOPUB_ERR      not published
  *  @retval         TRDP_NOINIT_ERR     handle invalid
- *  @retval         TRDP_NOSUB_ERR      no matching subscription found
+ *  @retval         TRDP_SOCK_ERR       no socket available
  */
-EXT_DECL TRDP_ERR_T tlp_request (
-    TRDP_APP_SESSION_T      appHandle,
-    TRDP_SUB_T              subHandle,
-    UINT32                  comId,
-    UINT32                  etbTopoCnt,
-    UINT32                  opTrnTopoCnt,
-    TRDP_IP_ADDR_T          srcIpAddr,
-    TRDP_IP_ADDR_T          destIpAddr,
-    UINT32                  redId,
-    TRDP_FLAGS_T            pktFlags,
-    const TRDP_SEND_PARAM_T *pSendParam,
-    const UINT8             *pData,
-    UINT32                  dataSize,
-    UINT32                  replyComId,
-    TRDP_IP_ADDR_T          replyIpAddr)
+EXT_DECL TRDP_ERR_T tlp_addSendInterface (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    TRDP_IP_ADDR_T      ifaceIp,
+    TRDP_IP_ADDR_T      destIpAddr)
 {
-    TRDP_ERR_T  ret             = TRDP_NO_ERR;
-    PD_ELE_T    *pSubPD         = (PD_ELE_T *) subHandle;
-    PD_ELE_T    *pReqElement    = NULL;
+    PD_ELE_T    *pElement   = (PD_ELE_T *) pubHandle;
+    INT32       socketIdx   = TRDP_INVALID_SOCKET_INDEX;
+    TRDP_ERR_T  ret;
 
-    /*    Check params    */
-    if ((appHandle == NULL)
-        || (subHandle == NULL)
-        || ((comId == 0u) && (replyComId == 0u))
-        || (destIpAddr == 0u))
+    if (pElement == NULL)
     {
         return TRDP_PARAM_ERR;
     }
 
-    if (pSubPD->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    if (pElement->magic != TRDP_MAGIC_PUB_HNDL_VALUE)
     {
-        return TRDP_NOSUB_ERR;
+        return TRDP_NOPUB_ERR;
     }
 
     if (!trdp_isValidSession(appHandle))
@@ -1882,192 +2390,2251 @@ EXT_DECL TRDP_ERR_T tlp_request (
         return TRDP_NOINIT_ERR;
     }
 
-    if (0 != redId)                 /* look for pending redundancy for that group */
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+    if ( ret == TRDP_NO_ERR )
     {
-        BOOL8 isLeader = TRUE;
+        if (ifaceIp != VOS_INADDR_ANY)
+        {
+            /*  A socket bound to the second interface, with the send parameters of the first one  */
+            TRDP_SEND_PARAM_T sendParam = appHandle->iface[pElement->socketIdx].sendParam;
 
-        ret = tlp_getRedundant(appHandle, redId, &isLeader);
-        if ((ret == TRDP_NO_ERR) && (FALSE == isLeader))
+            ret = trdp_requestSocket(appHandle->iface,
+                                     appHandle->pdDefault.port,
+                                     &sendParam,
+                                     ifaceIp,
+                                     0u,
+                                     TRDP_SOCK_PD,
+                                     appHandle->option,
+                                     FALSE,
+                                     -1,
+                                     &socketIdx,
+                                     0u);
+        }
+        if (ret == TRDP_NO_ERR)
         {
-            return TRDP_NO_ERR;
+            if (pElement->redSocketIdx != 0u)
+            {
+                trdp_releaseSocket(appHandle->iface, (INT32) pElement->redSocketIdx - 1, 0u, FALSE, VOS_INADDR_ANY);
+            }
+            pElement->redSocketIdx  = (ifaceIp != VOS_INADDR_ANY) ? (UINT32) socketIdx + 1u : 0u;
+            pElement->redIfaceAddr  = ifaceIp;
+            pElement->redIpAddr     = (ifaceIp != VOS_INADDR_ANY) ? destIpAddr : VOS_INADDR_ANY;
+        }
+
+        if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
     }
-    /*    Reserve mutual access    */
-    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
 
-    if ( ret == TRDP_NO_ERR)
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Get direct access to the process data to send.
+ *  The data of a published telegram is written in place, no copy is made. The session is locked until
+ *  tlp_commitPut is called from the same thread, so keep the time in between short. The data is sent as written,
+ *  marshalling is not applied.
+ *
+ *  @param[in]      appHandle          the handle returned by tlc_openSession
+ *  @param[in]      pubHandle          the handle returned by publish
+ *  @param[out]     ppData             pointer to the data of the frame
+ *  @param[out]     pDataSize          size of the data as published
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_PARAM_ERR     parameter error
+ *  @retval         TRDP_NOPUB_ERR     not published
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_STATE_ERR     tlp_beginPut already called
+ */
+EXT_DECL TRDP_ERR_T tlp_beginPut (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    UINT8               **ppData,
+    UINT32              *pDataSize)
+{
+    PD_ELE_T    *pElement   = (PD_ELE_T *)pubHandle;
+    TRDP_ERR_T  ret         = TRDP_NO_ERR;
+
+    if ((pElement == NULL) || (ppData == NULL) || (pDataSize == NULL))
     {
-        /* Ticket #171: srcIP should be set if there is more than one interface */
-        if (srcIpAddr == VOS_INADDR_ANY)
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_PUB_HNDL_VALUE)
+    {
+        return TRDP_NOPUB_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access, it is released by tlp_commitPut    */
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+    if ( ret == TRDP_NO_ERR )
+    {
+        if (pElement->privFlags & TRDP_PUT_PENDING)
         {
-            srcIpAddr = appHandle->realIP;
+            ret = TRDP_STATE_ERR;
+            if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
+            {
+                vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+            }
+        }
+        else
+        {
+            pElement->privFlags |= TRDP_PUT_PENDING;
+            *ppData     = pElement->pFrame->data;
+            *pDataSize  = pElement->dataSize;
         }
+    }
 
-        /*    Do not look for former request element anymore.
-              We always create a new send queue entry now and have it removed in pd_sendQueued...
-                Handling for Ticket #172!
-         */
+    return ret;
+}
 
-        /*  Get a new element   */
-        pReqElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+/**********************************************************************************************************************/
+/** Finish writing the process data to send.
+ *  The data written after tlp_beginPut becomes valid and will be sent earliest when tlc_process is called.
+ *
+ *  @param[in]      appHandle          the handle returned by tlc_openSession
+ *  @param[in]      pubHandle          the handle returned by publish
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_PARAM_ERR     parameter error
+ *  @retval         TRDP_NOPUB_ERR     not published
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_STATE_ERR     tlp_beginPut not called
+ */
+EXT_DECL TRDP_ERR_T tlp_commitPut (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle)
+{
+    PD_ELE_T    *pElement   = (PD_ELE_T *)pubHandle;
+    TRDP_ERR_T  ret         = TRDP_NO_ERR;
+
+    if (pElement == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_PUB_HNDL_VALUE)
+    {
+        return TRDP_NOPUB_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
-        if (pReqElement == NULL)
+    /*    The mutex is recursive: this thread holds it already if tlp_beginPut was called    */
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+    if ( ret == TRDP_NO_ERR )
+    {
+        if (!(pElement->privFlags & TRDP_PUT_PENDING))
         {
-            ret = TRDP_MEM_ERR;
+            ret = TRDP_STATE_ERR;
         }
         else
         {
-            vos_printLog(VOS_LOG_INFO,
-                         "PD Request (comId: %u) getting new element %p\n",
-                         comId,
-                         (void *)pReqElement);
-            /*
-                Compute the overal packet size
-             */
-            pReqElement->dataSize   = dataSize;
-            pReqElement->grossSize  = trdp_packetSizePD(dataSize);
-            pReqElement->pFrame     = (PD_PACKET_T *) vos_memAlloc(pReqElement->grossSize);
+            /* set data valid */
+            pElement->privFlags = (TRDP_PRIV_FLAGS_T) (pElement->privFlags &
+                                                       ~(TRDP_PRIV_FLAGS_T)(TRDP_PUT_PENDING | TRDP_INVALID_DATA));
 
-            if (pReqElement->pFrame == NULL)
+            /*  Update some statistics  */
+            pElement->updPkts++;
+
+            /*  Release the lock taken by tlp_beginPut    */
+            if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
             {
-                vos_memFree(pReqElement);
-                pReqElement = NULL;
+                vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
             }
-            else
+        }
+
+        if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Compute the time until the next job of a locked session.
+ *  Shared by tlc_getInterval() and tlc_getEventFd().
+ *
+ *  @param[in]      appHandle          The session, locked
+ *  @param[out]     pInterval          pointer to needed interval
+ *  @param[in,out]  pFileDesc          pointer to file descriptor set, NULL if the poll set is used
+ *  @param[out]     pNoDesc            pointer to put no of highest used descriptors (for select())
+ */
+static void trdp_getIntervalLocked (
+    TRDP_SESSION_PT appHandle,
+    TRDP_TIME_T     *pInterval,
+    TRDP_FDS_T      *pFileDesc,
+    INT32           *pNoDesc)
+{
+    TRDP_TIME_T now;
+
+    /*    Get the current time    */
+    vos_getTime(&now);
+    vos_clearTime(&appHandle->nextJob);
+
+    trdp_pdCheckPending(appHandle, pFileDesc, pNoDesc);
+
+#if MD_SUPPORT
+    trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
+#endif
+
+    /*    if the last call left frames unread or others read frames for us, come back at once  */
+    if (appHandle->backlog || (appHandle->shareQueued != 0u))
+    {
+        pInterval->tv_sec   = 0u;
+        pInterval->tv_usec  = 0;
+    }
+    /*    if next job time is known, return the time-out value to the caller   */
+    else if (timerisset(&appHandle->nextJob) &&
+             timercmp(&now, &appHandle->nextJob, <))
+    {
+        vos_subTime(&appHandle->nextJob, &now);
+        *pInterval = appHandle->nextJob;
+    }
+    else if (timerisset(&appHandle->nextJob))
+    {
+        pInterval->tv_sec   = 0u;                               /* 0ms if time is over (were we delayed?) */
+        pInterval->tv_usec  = 0;                                /* Application should limit this    */
+    }
+    else    /* if no timeout set, set maximum time to 1000sec   */
+    {
+        pInterval->tv_sec   = 1000u;                            /* 1000s if no timeout is set      */
+        pInterval->tv_usec  = 0;                                /* Application should limit this    */
+    }
+}
+
+/**********************************************************************************************************************/
+/** First part of the work loop of a locked session: send due PD and MD, handle PD time outs.
+ *  Shared by tlc_process() and tlc_processEvents(), which differ only in how they find the sockets to read.
+ *
+ *  @param[in]      appHandle          The session, locked
+ *  @param[out]     pStartStamp        start of the call for the timing statistics
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         other              error of trdp_pdSendQueued() or trdp_mdSend()
+ */
+static TRDP_ERR_T trdp_processBegin (
+    TRDP_SESSION_PT appHandle,
+    UINT64          *pStartStamp)
+{
+    TRDP_ERR_T  result = TRDP_NO_ERR;
+    TRDP_ERR_T  err;
+
+    *pStartStamp = 0u;
+#if TRDP_PROCESS_TIME_CACHE
+    vos_getTime(&appHandle->processTime);
+    appHandle->processTimeValid = TRUE;
+#endif
+#if TRDP_TIMING_STATS
+    if (appHandle->option & TRDP_OPTION_TIMING_STATS)
+    {
+        *pStartStamp = trdp_timingStamp();
+    }
+#endif
+    vos_clearTime(&appHandle->nextJob);
+
+    /******************************************************
+     Find and send the packets which have to be sent next:
+     ******************************************************/
+
+    err = trdp_pdSendQueued(appHandle);
+
+    if (err != TRDP_NO_ERR)
+    {
+        /*  We do not break here, only report error */
+        result = err;
+        /* vos_printLog(VOS_LOG_ERROR, "trdp_pdSendQueued failed (Err: %d)\n", err);*/
+    }
+
+    /******************************************************
+     Find packets which are pending/overdue
+     ******************************************************/
+    trdp_pdHandleTimeOuts(appHandle);
+
+#if MD_SUPPORT
+
+    err = trdp_mdSend(appHandle);
+    if (err != TRDP_NO_ERR)
+    {
+        if (err == TRDP_IO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "trdp_mdSend() incomplete \n");
+
+        }
+        else
+        {
+            result = err;
+            vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+        }
+    }
+
+#endif
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Last part of the work loop of a locked session: MD time outs, timing and exported statistics.
+ *
+ *  @param[in]      appHandle          The session, locked
+ *  @param[in]      startStamp         start of the call, from trdp_processBegin()
+ */
+static void trdp_processEnd (
+    TRDP_SESSION_PT appHandle,
+    UINT64          startStamp)
+{
+#if MD_SUPPORT
+
+    trdp_mdCheckTimeouts(appHandle);
+
+#endif
+
+#if TRDP_TIMING_STATS
+    if (appHandle->option & TRDP_OPTION_TIMING_STATS)
+    {
+        trdp_timingAddNs(appHandle, TRDP_TIMING_PROCESS, trdp_timingStamp() - startStamp);
+    }
+#else
+    (void) startStamp;
+#endif
+    trdp_exportStats(appHandle);
+
+#if TRDP_PROCESS_TIME_CACHE
+    appHandle->processTimeValid = FALSE;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Get the lowest time interval for PDs.
+ *  Return the maximum time interval suitable for 'select()' so that we
+ *    can send due PD packets in time.
+ *    If the PD send queue is empty, return zero time
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[out]     pInterval          pointer to needed interval
+ *  @param[in,out]  pFileDesc          pointer to file descriptor set
+ *  @param[out]     pNoDesc            pointer to put no of highest used descriptors (for select())
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_getInterval (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TIME_T         *pInterval,
+    TRDP_FDS_T          *pFileDesc,
+    INT32               *pNoDesc)
+{
+    TRDP_ERR_T ret = TRDP_NOINIT_ERR;
+
+    if (trdp_isValidSession(appHandle))
+    {
+        if ((pInterval == NULL)
+            || (pFileDesc == NULL)
+            || (pNoDesc == NULL))
+        {
+            ret = TRDP_PARAM_ERR;
+        }
+        else
+        {
+            ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+
+            if (ret == TRDP_NO_ERR)
             {
-                /*    Get a socket    */
-                ret = trdp_requestSocket(appHandle->iface,
-                                         appHandle->pdDefault.port,
-                                         (pSendParam != NULL) ? pSendParam : &appHandle->pdDefault.sendParam,
-                                         srcIpAddr,
-                                         0u,
-                                         TRDP_SOCK_PD,
-                                         appHandle->option,
-                                         FALSE,
-                                         -1,
-                                         &pReqElement->socketIdx,
-                                         0u);
+                trdp_getIntervalLocked(appHandle, pInterval, pFileDesc, pNoDesc);
 
-                if (ret != TRDP_NO_ERR)
-                {
-                    vos_memFree(pReqElement->pFrame);
-                    vos_memFree(pReqElement);
-                    pReqElement = NULL;
-                }
-                else
+                if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
                 {
-                    /*  Mark this element as a PD PULL Request.  Request will be sent on tlc_process time.    */
-                    vos_clearTime(&pReqElement->interval);
-                    vos_clearTime(&pReqElement->timeToGo);
-
-                    /*  Update the internal data */
-                    pReqElement->addr.comId         = comId;
-                    pReqElement->redId              = redId;
-                    pReqElement->addr.destIpAddr    = destIpAddr;
-                    pReqElement->addr.srcIpAddr     = srcIpAddr;
-                    pReqElement->addr.mcGroup       =
-                        (vos_isMulticast(destIpAddr) == 1) ? destIpAddr : VOS_INADDR_ANY;
-                    pReqElement->pktFlags =
-                        (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
-                    pReqElement->magic = TRDP_MAGIC_PUB_HNDL_VALUE;
-                    /*  Find a possible redundant entry in one of the other sessions and sync
-                        the sequence counter! curSeqCnt holds the last sent sequence counter,
-                        therefore set the value initially to -1, it will be incremented when sending... */
-                    pReqElement->curSeqCnt = trdp_getSeqCnt(pReqElement->addr.comId,
-                                                            TRDP_MSG_PR, pReqElement->addr.srcIpAddr) - 1;
-                    /*    Enter this request into the send queue.    */
-                    trdp_queueInsFirst(&appHandle->pSndQueue, pReqElement);
+                    vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
                 }
             }
         }
+    }
+    return ret;
+}
 
-        if (ret == TRDP_NO_ERR && pReqElement != NULL)
-        {
+/**********************************************************************************************************************/
+/** Work loop of the TRDP handler.
+ *    Search the queue for pending PDs to be sent
+ *    Search the receive queue for pending PDs (time out)
+ *
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[in]      pRfds              pointer to set of ready descriptors
+ *  @param[in,out]  pCount             pointer to number of ready descriptors
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_process (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_FDS_T          *pRfds,
+    INT32               *pCount)
+{
+    TRDP_ERR_T  result;
+    TRDP_ERR_T  err;
+    UINT64      startStamp;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    else
+    {
+        result = trdp_processBegin(appHandle, &startStamp);
 
-            if (replyComId == 0u)
+        /******************************************************
+         Find packets which are to be received (unless the PD thread does),
+         as many as the work budget allows
+         ******************************************************/
+        trdp_shareRxBegin(appHandle);
+        trdp_budgetStart(appHandle);
+
+        if (!(appHandle->option & TRDP_OPTION_PD_THREAD))
+        {
+            err = trdp_pdCheckListenSocks(appHandle, pRfds, pCount);
+            if (err != TRDP_NO_ERR)
             {
-                replyComId = pSubPD->addr.comId;
+                /*  We do not break here */
+                result = err;
             }
+        }
 
-            pReqElement->addr.destIpAddr    = destIpAddr;
-            pReqElement->addr.srcIpAddr     = srcIpAddr;
-            pReqElement->addr.mcGroup       = (vos_isMulticast(destIpAddr) == 1) ? destIpAddr : VOS_INADDR_ANY;
+#if MD_SUPPORT
+
+        trdp_mdCheckListenSocks(appHandle, pRfds, pCount);
+
+#endif
+
+        trdp_budgetStop(appHandle);
+        trdp_shareRxEnd(appHandle);
+
+        trdp_processEnd(appHandle, startStamp);
+
+        if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Send the due PDs of the session.
+ *  Only the send side of the session is locked: the frames, schedule and sequence counters of the publishers.
+ *  The socket pool is not touched, sent PD requests are freed by tlc_processTimeouts.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_IO_ERR        socket I/O error
+ */
+EXT_DECL TRDP_ERR_T tlc_processSend (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ERR_T result;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->sndMutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    appHandle->sndOnly = TRUE;
+    result = trdp_pdSendQueued(appHandle);
+    appHandle->sndOnly = FALSE;
+
+    if (vos_mutexUnlock(appHandle->sndMutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Read the ready sockets of the session.
+ *  The send side is locked only to answer PD pull requests.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[in]      pRfds              pointer to set of ready descriptors
+ *  @param[in,out]  pCount             pointer to number of ready descriptors
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_processReceive (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_FDS_T          *pRfds,
+    INT32               *pCount)
+{
+    TRDP_ERR_T result = TRDP_NO_ERR;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_shareRxBegin(appHandle);
+    trdp_budgetStart(appHandle);
+
+    if (!(appHandle->option & TRDP_OPTION_PD_THREAD))
+    {
+        result = trdp_pdCheckListenSocks(appHandle, pRfds, pCount);
+    }
+
+#if MD_SUPPORT
+    trdp_mdCheckListenSocks(appHandle, pRfds, pCount);
+#endif
+
+    trdp_budgetStop(appHandle);
+    trdp_shareRxEnd(appHandle);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Housekeeping of the session.
+ *    Report the time outs of subscriptions, send MD and supervise its time outs, free the PD requests sent by
+ *    tlc_processSend and export the statistics.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_processTimeouts (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ERR_T result = TRDP_NO_ERR;
+#if MD_SUPPORT
+    TRDP_ERR_T err;
+#endif
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_pdHandleTimeOuts(appHandle);
+
+    if (vos_mutexLock(appHandle->sndMutex) == VOS_NO_ERR)
+    {
+        trdp_pdPurgeRequests(appHandle);
+        (void) vos_mutexUnlock(appHandle->sndMutex);
+    }
+
+#if MD_SUPPORT
+    err = trdp_mdSend(appHandle);
+    if (err != TRDP_NO_ERR)
+    {
+        if (err == TRDP_IO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "trdp_mdSend() incomplete \n");
+        }
+        else
+        {
+            result = err;
+            vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+        }
+    }
+
+    trdp_mdCheckTimeouts(appHandle);
+#endif
+
+    trdp_exportStats(appHandle);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Get the event descriptor and the lowest time interval of the session.
+ *  Alternative to tlc_getInterval() for applications handling many sockets: Instead of a descriptor set, a single
+ *  descriptor (epoll or kqueue) is returned, which becomes readable as soon as one of the session's sockets is
+ *  readable. The application waits on it (select(), poll(), epoll) at most for the returned interval and then calls
+ *  tlc_processEvents(). The descriptor stays the same during the lifetime of the session.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[out]     pInterval          pointer to needed interval
+ *  @param[out]     pEventFd           pointer to the event descriptor
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_PARAM_ERR     parameter error
+ *  @retval         TRDP_SOCK_ERR      event descriptor not supported on this target
+ */
+EXT_DECL TRDP_ERR_T tlc_getEventFd (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TIME_T         *pInterval,
+    SOCKET              *pEventFd)
+{
+    TRDP_ERR_T ret = TRDP_NOINIT_ERR;
+
+    if (trdp_isValidSession(appHandle))
+    {
+        if ((pInterval == NULL) || (pEventFd == NULL))
+        {
+            ret = TRDP_PARAM_ERR;
+        }
+        else
+        {
+            ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+
+            if (ret == TRDP_NO_ERR)
+            {
+                if ((appHandle->pollSet == NULL) &&
+                    (vos_pollCreate(&appHandle->pollSet) != VOS_NO_ERR))
+                {
+                    ret = TRDP_SOCK_ERR;
+                }
+                else
+                {
+                    (void) trdp_syncPollSet(appHandle);
+                    (void) vos_pollGetFd(appHandle->pollSet, pEventFd);
+
+                    trdp_getIntervalLocked(appHandle, pInterval, NULL, NULL);
+                }
+
+                if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+                {
+                    vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Order the ready sockets by priority: PD sockets by the highest priority of their subscriptions, the AF_XDP socket
+ *  and the io_uring carrying all of them first, MD last. Sockets of the same priority keep their order.
+ *
+ *  @param[in]      appHandle           session
+ *  @param[in,out]  tags                tags of the ready sockets
+ *  @param[in]      noOfTags            no. of tags
+ */
+static void trdp_sortEventTags (
+    TRDP_SESSION_PT appHandle,
+    UINT32          tags[],
+    UINT32          noOfTags)
+{
+    UINT32  prio[VOS_MAX_SOCKET_CNT + 3];
+    UINT32  i;
+    UINT32  j;
+
+    for (i = 0u; i < noOfTags; i++)
+    {
+        UINT32  tag = tags[i];
+        UINT32  tagPrio;
+
+        if ((tag == TRDP_XDP_POLL_TAG) || (tag == TRDP_URING_POLL_TAG))
+        {
+            tagPrio = TRDP_PD_PRIO_MAX + 1u;
+        }
+        else if ((tag < VOS_MAX_SOCKET_CNT) && (appHandle->iface[tag].type == TRDP_SOCK_PD))
+        {
+            tagPrio = appHandle->iface[tag].rcvPrio;
+        }
+        else
+        {
+            tagPrio = 0u;
+        }
+
+        /*  Insertion sort, there are a few ready sockets only  */
+        for (j = i; (j > 0u) && (prio[j - 1u] < tagPrio); j--)
+        {
+            prio[j] = prio[j - 1u];
+            tags[j] = tags[j - 1u];
+        }
+        prio[j] = tagPrio;
+        tags[j] = tag;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Work loop of the TRDP handler for the event descriptor.
+ *    Same as tlc_process(), but only the sockets reported ready by the session's poll set are read.
+ *    The call does not block, it should be called after the descriptor returned by tlc_getEventFd() became readable
+ *    or the interval expired.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_SOCK_ERR      event descriptor not supported on this target
+ */
+EXT_DECL TRDP_ERR_T tlc_processEvents (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ERR_T          result;
+    TRDP_ERR_T          err;
+    UINT32              tags[VOS_MAX_SOCKET_CNT + 3];
+    UINT32              noOfTags = VOS_MAX_SOCKET_CNT + 3;
+    UINT32              i;
+    const VOS_TIMEVAL_T noWait = {0, 0};
+    UINT64              startStamp;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    else
+    {
+        if ((appHandle->pollSet == NULL) &&
+            (vos_pollCreate(&appHandle->pollSet) != VOS_NO_ERR))
+        {
+            (void) trdp_sessionUnlock(appHandle);
+            return TRDP_SOCK_ERR;
+        }
+
+        result = trdp_processBegin(appHandle, &startStamp);
+
+        /******************************************************
+         Read only the sockets which are ready
+         ******************************************************/
+        (void) trdp_syncPollSet(appHandle);
+
+        if (vos_pollWait(appHandle->pollSet, tags, &noOfTags, &noWait) != VOS_NO_ERR)
+        {
+            noOfTags = 0u;
+        }
+        trdp_sortEventTags(appHandle, tags, noOfTags);
+
+        trdp_shareRxBegin(appHandle);
+        trdp_budgetStart(appHandle);
+
+        for (i = 0u; i < noOfTags; i++)
+        {
+            /*  Budget spent: the sockets left stay ready and are read by the next call  */
+            if (!trdp_budgetLeft(appHandle))
+            {
+                break;
+            }
+#if MD_SUPPORT
+            if (tags[i] == VOS_MAX_SOCKET_CNT)
+            {
+                trdp_mdAccept(appHandle, NULL, NULL);
+                continue;
+            }
+#endif
+            if (tags[i] == TRDP_XDP_POLL_TAG)
+            {
+                err = trdp_pdReceiveXdp(appHandle);
+                if (err != TRDP_NO_ERR)
+                {
+                    result = err;
+                }
+                continue;
+            }
+#if TRDP_PD_URING
+            if (tags[i] == TRDP_URING_POLL_TAG)
+            {
+                err = trdp_pdReceiveUring(appHandle);
+                if (err != TRDP_NO_ERR)
+                {
+                    result = err;
+                }
+                continue;
+            }
+#endif
+            /*  The socket may have been closed or replaced while handling a previous event   */
+            if ((tags[i] >= VOS_MAX_SOCKET_CNT) || !appHandle->iface[tags[i]].polled)
+            {
+                continue;
+            }
+            if (appHandle->iface[tags[i]].type == TRDP_SOCK_PD)
+            {
+                err = trdp_pdReceiveSocket(appHandle, &appHandle->iface[tags[i]]);
+                if (err != TRDP_NO_ERR)
+                {
+                    /*  We do not break here */
+                    result = err;
+                }
+            }
+#if MD_SUPPORT
+            else
+            {
+                trdp_mdReceiveSocket(appHandle, (INT32) tags[i]);
+                trdp_budgetSpend(appHandle, 1u);
+            }
+#endif
+        }
+
+        if (((appHandle->option & (TRDP_OPTION_BUSY_POLL | TRDP_OPTION_PD_THREAD)) == TRDP_OPTION_BUSY_POLL) &&
+            trdp_budgetLeft(appHandle))
+        {
+            trdp_pdBusyPoll(appHandle);
+        }
+        trdp_pdCallPending(appHandle);
+
+        trdp_budgetStop(appHandle);
+        trdp_shareRxEnd(appHandle);
+
+        trdp_processEnd(appHandle, startStamp);
+
+        if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Limit the number of outstanding PD pull requests.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      maxRequests         max. requests waiting for their reply, 0: no limit
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      pull request index not compiled in (TRDP_PD_PULL_HASH_SIZE)
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_setPullLimit (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              maxRequests)
+{
+#if TRDP_PD_PULL_HASH_SIZE > 0
+    TRDP_ERR_T ret;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+    if ( ret == TRDP_NO_ERR )
+    {
+        appHandle->pullMax = maxRequests;
+
+        if ( trdp_sessionUnlock(appHandle) != VOS_NO_ERR )
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;
+#else
+    (void) appHandle;
+    (void) maxRequests;
+    return TRDP_PARAM_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Get the number of outstanding and of unanswered PD pull requests.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pNumPending         requests waiting for their reply, may be NULL
+ *  @param[out]     pNumExpired         requests to single devices dropped unanswered since the session was opened,
+ *                                      may be NULL
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      pull request index not compiled in (TRDP_PD_PULL_HASH_SIZE)
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_getPullStatus (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              *pNumPending,
+    UINT32              *pNumExpired)
+{
+#if TRDP_PD_PULL_HASH_SIZE > 0
+    TRDP_ERR_T ret;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if ( ret == TRDP_NO_ERR )
+    {
+        if (pNumPending != NULL)
+        {
+            *pNumPending = appHandle->pullCnt;
+        }
+        if (pNumExpired != NULL)
+        {
+            *pNumExpired = appHandle->pullExpired;
+        }
+
+        if ( vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR )
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;
+#else
+    (void) appHandle;
+    (void) pNumPending;
+    (void) pNumExpired;
+    return TRDP_PARAM_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Initiate sending PD messages (PULL).
+ *  Send a PD request message
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           handle from related subscribe
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      destIpAddr          where to send the packet to
+ *  @param[in]      redId               0 - Non-redundant, > 0 valid redundancy group
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
+ *  @param[in]      pSendParam          optional pointer to send parameter, NULL - default parameters are used
+ *  @param[in]      pData               pointer to packet data / dataset
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      replyComId          comId of reply (default comID of subscription)
+ *  @param[in]      replyIpAddr         IP for reply
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        could not insert (out of memory)
+ *  @retval         TRDP_QUEUE_FULL_ERR too many requests outstanding (tlp_setPullLimit)
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_NOSUB_ERR      no matching subscription found
+ */
+EXT_DECL TRDP_ERR_T tlp_request (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_SUB_T              subHandle,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    UINT32                  redId,
+    TRDP_FLAGS_T            pktFlags,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    UINT32                  replyComId,
+    TRDP_IP_ADDR_T          replyIpAddr)
+{
+    TRDP_ERR_T  ret             = TRDP_NO_ERR;
+    PD_ELE_T    *pSubPD         = (PD_ELE_T *) subHandle;
+    PD_ELE_T    *pReqElement    = NULL;
+
+    /*    Check params    */
+    if ((appHandle == NULL)
+        || (subHandle == NULL)
+        || ((comId == 0u) && (replyComId == 0u))
+        || (destIpAddr == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pSubPD->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (0 != redId)                 /* look for pending redundancy for that group */
+    {
+        BOOL8 isLeader = TRUE;
+
+        ret = tlp_getRedundant(appHandle, redId, &isLeader);
+        if ((ret == TRDP_NO_ERR) && (FALSE == isLeader))
+        {
+            return TRDP_NO_ERR;
+        }
+    }
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) trdp_sessionLock(appHandle);
+
+    if ( ret == TRDP_NO_ERR)
+    {
+        /* Ticket #171: srcIP should be set if there is more than one interface */
+        if (srcIpAddr == VOS_INADDR_ANY)
+        {
+            srcIpAddr = appHandle->realIP;
+        }
+
+        if (replyComId == 0u)
+        {
+            replyComId = pSubPD->addr.comId;
+        }
+
+#if TRDP_PD_PULL_HASH_SIZE > 0
+        /*  Index the request by the expected reply, a unicast request is answered by the pulled device only  */
+        {
+            TRDP_TIME_T deadline;
+            TRDP_TIME_T timeout;
+
+            if (timerisset(&pSubPD->interval))
+            {
+                timeout = pSubPD->interval;
+            }
+            else
+            {
+                timeout.tv_sec  = (long) (appHandle->pdDefault.timeout / 1000000u);
+                timeout.tv_usec = (long) (appHandle->pdDefault.timeout % 1000000u);
+            }
+            vos_getTime(&deadline);
+            vos_addTime(&deadline, &timeout);
+            ret = trdp_pdPullAdd(appHandle, pSubPD, replyComId,
+                                 (vos_isMulticast(destIpAddr) == 1) ? VOS_INADDR_ANY : destIpAddr, &deadline);
+        }
+#endif
+
+        /*    Do not look for former request element anymore.
+              We always create a new send queue entry now and have it removed in pd_sendQueued...
+                Handling for Ticket #172!
+         */
+
+        /*  Get a new element   */
+        if (ret != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "PD Request (comId: %u) refused, too many requests outstanding\n", comId);
+        }
+        else if ((pReqElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T))) == NULL)
+        {
+            ret = TRDP_MEM_ERR;
+        }
+        else
+        {
+            vos_printLog(VOS_LOG_INFO,
+                         "PD Request (comId: %u) getting new element %p\n",
+                         comId,
+                         (void *)pReqElement);
+            /*
+                Compute the overal packet size
+             */
+            pReqElement->dataSize   = dataSize;
+            pReqElement->grossSize  = trdp_packetSizePD(dataSize);
+            pReqElement->pFrame     = (PD_PACKET_T *) vos_memAllocAligned(pReqElement->grossSize, TRDP_PD_FRAME_ALIGN);
+
+            if (pReqElement->pFrame == NULL)
+            {
+                vos_memFree(pReqElement);
+                pReqElement = NULL;
+            }
+            else
+            {
+                /*    Get a socket    */
+                ret = trdp_requestSocket(appHandle->iface,
+                                         appHandle->pdDefault.port,
+                                         (pSendParam != NULL) ? pSendParam : &appHandle->pdDefault.sendParam,
+                                         srcIpAddr,
+                                         0u,
+                                         TRDP_SOCK_PD,
+                                         appHandle->option,
+                                         FALSE,
+                                         -1,
+                                         &pReqElement->socketIdx,
+                                         0u);
+
+                if (ret != TRDP_NO_ERR)
+                {
+                    vos_memFree(pReqElement->pFrame);
+                    vos_memFree(pReqElement);
+                    pReqElement = NULL;
+                }
+                else
+                {
+#if TRDP_PD_QOS_PER_FRAME
+                    pReqElement->qos = (pSendParam != NULL) ? pSendParam->qos : appHandle->pdDefault.sendParam.qos;
+#endif
+                    pReqElement->prio = TRDP_PD_PRIO_OF((pSendParam != NULL) ?
+                                                        pSendParam->qos : appHandle->pdDefault.sendParam.qos);
+                    /*  Mark this element as a PD PULL Request.  Request will be sent on tlc_process time.    */
+                    vos_clearTime(&pReqElement->interval);
+                    vos_clearTime(&pReqElement->timeToGo);
+
+                    /*  Update the internal data */
+                    pReqElement->addr.comId         = comId;
+                    pReqElement->redId              = redId;
+                    pReqElement->pRedGroup          = trdp_pdRedGroup(appHandle, redId, TRUE);
+                    pReqElement->addr.destIpAddr    = destIpAddr;
+                    pReqElement->addr.srcIpAddr     = srcIpAddr;
+                    pReqElement->addr.mcGroup       =
+                        (vos_isMulticast(destIpAddr) == 1) ? destIpAddr : VOS_INADDR_ANY;
+                    pReqElement->pktFlags =
+                        (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
+                    pReqElement->magic = TRDP_MAGIC_PUB_HNDL_VALUE;
+                    /*  Find a possible redundant entry in one of the other sessions and sync
+                        the sequence counter! curSeqCnt holds the last sent sequence counter,
+                        therefore set the value initially to -1, it will be incremented when sending... */
+                    pReqElement->curSeqCnt = trdp_getSeqCnt(appHandle, pReqElement->addr.comId,
+                                                            TRDP_MSG_PR, pReqElement->addr.srcIpAddr) - 1;
+                    /*    Enter this request into the send queue.    */
+                    trdp_sndQueueInsFirst(appHandle, pReqElement);
+                }
+            }
+        }
+
+        if (ret == TRDP_NO_ERR && pReqElement != NULL)
+        {
+            pReqElement->addr.destIpAddr    = destIpAddr;
+            pReqElement->addr.srcIpAddr     = srcIpAddr;
+            pReqElement->addr.mcGroup       = (vos_isMulticast(destIpAddr) == 1) ? destIpAddr : VOS_INADDR_ANY;
+            trdp_seqPubList(pReqElement);
+
+            /*    Compute the header fields */
+            trdp_pdInit(pReqElement, TRDP_MSG_PR, etbTopoCnt, opTrnTopoCnt, replyComId, replyIpAddr);
+
+            /*  Copy data only if available! */
+            if ((NULL != pData) && (0u < dataSize))
+            {
+                ret = tlp_put(appHandle, (TRDP_PUB_T) pReqElement, pData, dataSize);
+            }
+            /*  This flag triggers sending in tlc_process (one shot)  */
+            pReqElement->privFlags |= TRDP_REQ_2B_SENT;
+            if (trdp_pdSchedUpdate(appHandle, pReqElement) != TRDP_NO_ERR)
+            {
+                ret = TRDP_MEM_ERR;
+            }
+
+            /*    Set the current time and start time out of subscribed packet  */
+            if (timerisset(&pSubPD->interval))
+            {
+                vos_getTime(&pSubPD->timeToGo);
+                vos_addTime(&pSubPD->timeToGo, &pSubPD->interval);
+                pSubPD->privFlags &= (unsigned)~TRDP_TIMED_OUT;   /* Reset time out flag (#151) */
+                if (trdp_pdTimeoutUpdate(appHandle, pSubPD) != TRDP_NO_ERR)
+                {
+                    ret = TRDP_MEM_ERR;
+                }
+            }
+        }
+
+        if (trdp_sessionUnlock(appHandle) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Prepare for receiving PD messages.
+ *  Subscribe to a specific PD ComID and source IP.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pSubHandle          return a handle for this subscription
+ *  @param[in]      pUserRef            user supplied value returned within the info structure
+ *  @param[in]      pfCbFunction        Pointer to subscriber specific callback function, NULL to use default function
+ *  @param[in]      comId               comId of packet to receive
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr1          Source IP address, lower address in case of address range, set to 0 if not used
+ *  @param[in]      srcIpAddr2          upper address in case of address range, set to 0 if not used
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
+ *  @param[in]      destIpAddr          IP address to join
+ *  @param[in]      timeout             timeout (>= 10ms) in usec
+ *  @param[in]      toBehavior          timeout behavior
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_subscribe (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          *pSubHandle,
+    const void          *pUserRef,
+    TRDP_PD_CALLBACK_T  pfCbFunction,
+    UINT32              comId,
+    UINT32              etbTopoCnt,
+    UINT32              opTrnTopoCnt,
+    TRDP_IP_ADDR_T      srcIpAddr1,
+    TRDP_IP_ADDR_T      srcIpAddr2,
+    TRDP_IP_ADDR_T      destIpAddr,
+    TRDP_FLAGS_T        pktFlags,
+    UINT32              timeout,
+    TRDP_TO_BEHAVIOR_T  toBehavior)
+{
+    TRDP_TIME_T         now;
+    TRDP_ERR_T          ret = TRDP_NO_ERR;
+    TRDP_ADDRESSES_T    subHandle;
+    INT32 lIndex;
+
+    /*    Check params    */
+    if (pSubHandle == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (timeout == 0u)
+    {
+        timeout = appHandle->pdDefault.timeout;
+    }
+    else if (timeout < TRDP_TIMER_GRANULARITY)
+    {
+        timeout = TRDP_TIMER_GRANULARITY;
+    }
+
+    /*    Reserve mutual access    */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*  Create an addressing item   */
+    subHandle.comId         = comId;
+    subHandle.srcIpAddr     = srcIpAddr1;
+    subHandle.srcIpAddr2    = srcIpAddr2;
+    subHandle.destIpAddr    = destIpAddr;
+    subHandle.opTrnTopoCnt  = 0u;            /* Do not compare topocounts  */
+    subHandle.etbTopoCnt    = 0u;
+
+    if (vos_isMulticast(destIpAddr))
+    {
+        subHandle.mcGroup = destIpAddr;
+    }
+    else
+    {
+        subHandle.mcGroup = 0u;
+    }
+
+    /*    Get the current time    */
+    vos_getTime(&now);
+
+    /*    Look for existing element    */
+    if (trdp_rcvQueueFindSubAddr(appHandle, &subHandle) != NULL)
+    {
+        ret = TRDP_NOSUB_ERR;
+    }
+    else
+    {
+        subHandle.opTrnTopoCnt  = opTrnTopoCnt; /* Set topocounts now  */
+        subHandle.etbTopoCnt    = etbTopoCnt;
+
+        /*    Find a (new) socket    */
+        ret = trdp_pdRequestRcvSocket(appHandle,
+                                      comId,
+                                      subHandle.mcGroup,
+                                      (srcIpAddr2 == VOS_INADDR_ANY) ? srcIpAddr1 : VOS_INADDR_ANY,
+                                      &lIndex);
+
+        if (ret == TRDP_NO_ERR)
+        {
+            PD_ELE_T *newPD;
+
+            /*    buffer size is PD_ELEMENT plus max. payload size    */
+
+            /*    Allocate a buffer for this kind of packets    */
+            newPD = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+
+            if (newPD == NULL)
+            {
+                ret = TRDP_MEM_ERR;
+                trdp_releaseSocket(appHandle->iface, lIndex, 0u, FALSE, VOS_INADDR_ANY);
+            }
+            else
+            {
+                /*  Alloc the corresponding data buffer  */
+#if TRDP_PD_RCV_COPY
+                /*  grown to the data size on reception   */
+                newPD->frameSize    = sizeof(PD_HEADER_T);
+#else
+                newPD->frameSize    = TRDP_MAX_PD_PACKET_SIZE;
+#endif
+                newPD->pFrame = (PD_PACKET_T *) vos_memAllocAligned(newPD->frameSize, TRDP_PD_FRAME_ALIGN);
+                if (newPD->pFrame == NULL)
+                {
+                    vos_memFree(newPD);
+                    newPD   = NULL;
+                    ret     = TRDP_MEM_ERR;
+                }
+                else
+                {
+                    /*    Initialize some fields    */
+                    if (vos_isMulticast(destIpAddr))
+                    {
+                        newPD->addr.mcGroup = destIpAddr;
+                        newPD->privFlags    |= TRDP_MC_JOINT;
+                    }
+                    else
+                    {
+                        newPD->addr.mcGroup = 0u;
+                    }
+
+                    newPD->addr.comId       = comId;
+                    newPD->addr.srcIpAddr   = srcIpAddr1;
+                    newPD->addr.srcIpAddr2  = srcIpAddr2;
+                    newPD->addr.destIpAddr  = destIpAddr;
+                    newPD->interval.tv_sec  = timeout / 1000000u;
+                    newPD->interval.tv_usec = timeout % 1000000u;
+                    newPD->toBehavior       =
+                        (toBehavior == TRDP_TO_DEFAULT) ? appHandle->pdDefault.toBehavior : toBehavior;
+                    newPD->grossSize    = newPD->frameSize;
+                    newPD->pUserRef     = pUserRef;
+                    newPD->socketIdx    = lIndex;
+                    newPD->prio         = TRDP_PD_PRIO_OF(appHandle->pdDefault.sendParam.qos);
+                    newPD->privFlags    |= TRDP_INVALID_DATA;
+                    newPD->pktFlags     =
+                        (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
+                    newPD->pfCbFunction =
+                        (pfCbFunction == NULL) ? appHandle->pdDefault.pfCbFunction : pfCbFunction;
+                    newPD->pCachedDS    = NULL;
+                    newPD->magic        = TRDP_MAGIC_SUB_HNDL_VALUE;
+
+                    if (timeout == TRDP_TIMER_FOREVER)
+                    {
+                        vos_clearTime(&newPD->timeToGo);
+                        vos_clearTime(&newPD->interval);
+                    }
+                    else
+                    {
+                        vos_getTime(&newPD->timeToGo);
+                        vos_addTime(&newPD->timeToGo, &newPD->interval);
+                    }
+
+#if TRDP_PD_RCV_THREAD
+                    if ((appHandle->option & TRDP_OPTION_PD_THREAD) &&
+                        (trdp_pdSnapCreate(newPD) != TRDP_NO_ERR))
+                    {
+                        vos_memFree(newPD->pFrame);
+                        vos_memFree(newPD);
+                        ret = TRDP_MEM_ERR;
+                        trdp_releaseSocket(appHandle->iface, lIndex, 0u, FALSE, VOS_INADDR_ANY);
+                    }
+                    else
+#endif
+                    {
+                        /*  append this subscription to our receive queue */
+                        trdp_rcvQueueAppLast(appHandle, newPD);
+                        trdp_pdSetSockFilter(appHandle, lIndex);
+                        ret = trdp_pdTimeoutUpdate(appHandle, newPD);
+
+                        *pSubHandle = (TRDP_SUB_T) newPD;
+                    }
+                }
+            }
+        } /*lint !e438 unused newPD */
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+}
+
+
+/**********************************************************************************************************************/
+/** Prepare for receiving a set of PD messages.
+ *  Subscribes all entries under one session lock.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pEntries            subscribers; subHandle and result are set for each entry
+ *  @param[in]      numEntries          number of entries
+ *
+ *  @retval         TRDP_NO_ERR         all entries subscribed
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               error of the first entry that failed, see the results of the entries
+ */
+EXT_DECL TRDP_ERR_T tlp_subscribeBatch (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_ENTRY_T    *pEntries,
+    UINT32              numEntries)
+{
+    TRDP_ERR_T  ret = TRDP_NO_ERR;
+    UINT32      i;
+
+    if ((pEntries == NULL) && (numEntries != 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access, tlp_subscribe locks recursively    */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    The socket filters are built once at the end    */
+    appHandle->pdBatch = TRUE;
+
+    for (i = 0u; i < numEntries; i++)
+    {
+        TRDP_SUB_ENTRY_T *pEntry = &pEntries[i];
+
+        pEntry->subHandle   = NULL;
+        pEntry->result      = tlp_subscribe(appHandle, &pEntry->subHandle, pEntry->pUserRef, pEntry->pfCbFunction,
+                                            pEntry->comId, pEntry->etbTopoCnt, pEntry->opTrnTopoCnt,
+                                            pEntry->srcIpAddr1, pEntry->srcIpAddr2, pEntry->destIpAddr,
+                                            pEntry->pktFlags, pEntry->timeout, pEntry->toBehavior);
+        if ((pEntry->result != TRDP_NO_ERR) && (ret == TRDP_NO_ERR))
+        {
+            ret = pEntry->result;
+        }
+    }
+
+    appHandle->pdBatch = FALSE;
+    for (i = 0u; i < (UINT32) VOS_MAX_SOCKET_CNT; i++)
+    {
+        trdp_pdSetSockFilter(appHandle, (INT32) i);
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Stop receiving PD messages.
+ *  Unsubscribe to a specific PD ComID
+ *
+ *  @param[in]      appHandle            the handle returned by tlc_openSession
+ *  @param[in]      subHandle            the handle for this subscription
+ *
+ *  @retval         TRDP_NO_ERR          no error
+ *  @retval         TRDP_PARAM_ERR       parameter error
+ *  @retval         TRDP_NOSUB_ERR       not subscribed
+ *  @retval         TRDP_NOINIT_ERR      handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_unsubscribe (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle)
+{
+    PD_ELE_T    *pElement = (PD_ELE_T *) subHandle;
+    TRDP_ERR_T  ret;
+
+    if (pElement == NULL )
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        TRDP_IP_ADDR_T mcGroup = pElement->addr.mcGroup;
+        /*    Remove from queue?    */
+        trdp_rcvQueueDelElement(appHandle, pElement);
+        trdp_pdGroupsRemoveSub(appHandle, pElement);
+        trdp_pdTimeoutRemove(appHandle, pElement);
+        trdp_pdPullRemoveSub(appHandle, pElement);
+        trdp_sdtRemove(appHandle, pElement);
+        /*    if we subscribed to an MC-group, check if anyone else did too: */
+        if (mcGroup != VOS_INADDR_ANY)
+        {
+            mcGroup = trdp_findMCjoins(appHandle, mcGroup);
+        }
+        if (pElement->redIfaceAddr != VOS_INADDR_ANY)
+        {
+            if (mcGroup != VOS_INADDR_ANY)
+            {
+                (void) vos_sockLeaveMC(appHandle->iface[pElement->socketIdx].sock, mcGroup, pElement->redIfaceAddr);
+            }
+            appHandle->redRcvCnt--;
+        }
+        trdp_releaseSocket(appHandle->iface, pElement->socketIdx, 0u, FALSE, mcGroup);
+        trdp_pdSetSockFilter(appHandle, pElement->socketIdx);
+        pElement->magic = 0u;
+        if (trdp_pdFrameReclaim(pElement, 0u) != NULL)
+        {
+            vos_memFree(pElement->pFrame);
+        }
+        if (pElement->pSeqCntList != NULL)
+        {
+            vos_memFree(pElement->pSeqCntList);
+        }
+        if (pElement->pDelta != NULL)
+        {
+            vos_memFree(pElement->pDelta);
+        }
+        while (pElement->pConsumers != NULL)
+        {
+            TRDP_PD_CONSUMER_T *pNext = pElement->pConsumers->pNext;
+
+            vos_memFree(pElement->pConsumers);
+            pElement->pConsumers = pNext;
+        }
+#if TRDP_PD_RCV_THREAD
+        if (pElement->pSnap != NULL)
+        {
+            vos_memFree(pElement->pSnap);
+        }
+#endif
+        vos_memFree(pElement);
+        ret = TRDP_NO_ERR;
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;      /*    Not found    */
+}
+
+
+/**********************************************************************************************************************/
+/** Add a consumer to a subscription.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle for this subscription
+ *  @param[in]      pUserRef            user supplied value returned with the received data
+ *  @param[in]      pfCbFunction        callback of the consumer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_addConsumer (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    const void          *pUserRef,
+    TRDP_PD_CALLBACK_T  pfCbFunction)
+{
+    PD_ELE_T            *pElement = (PD_ELE_T *) subHandle;
+    TRDP_PD_CONSUMER_T  *pConsumer;
+    TRDP_PD_CONSUMER_T  * *ppIter;
+    TRDP_ERR_T          ret;
+
+    if ((pElement == NULL) || (pfCbFunction == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    if ((pElement->pktFlags & TRDP_FLAGS_CALLBACK) == 0)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pConsumer = (TRDP_PD_CONSUMER_T *) vos_memAlloc(sizeof(TRDP_PD_CONSUMER_T));
+    if (pConsumer == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pConsumer->pNext        = NULL;
+    pConsumer->pUserRef     = pUserRef;
+    pConsumer->pfCbFunction = pfCbFunction;
+
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret != TRDP_NO_ERR)
+    {
+        vos_memFree(pConsumer);
+        return ret;
+    }
+
+    /*  Consumers are called in the order they were added  */
+    for (ppIter = &pElement->pConsumers; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        ;
+    }
+    *ppIter = pConsumer;
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return TRDP_NO_ERR;
+}
+
+
+/**********************************************************************************************************************/
+/** Remove a consumer added with tlp_addConsumer.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle for this subscription
+ *  @param[in]      pUserRef            user reference of the consumer
+ *  @param[in]      pfCbFunction        callback of the consumer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_delConsumer (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    const void          *pUserRef,
+    TRDP_PD_CALLBACK_T  pfCbFunction)
+{
+    PD_ELE_T            *pElement = (PD_ELE_T *) subHandle;
+    TRDP_PD_CONSUMER_T  * *ppIter;
+    TRDP_ERR_T          ret;
+
+    if (pElement == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        ret = TRDP_PARAM_ERR;
+        for (ppIter = &pElement->pConsumers; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+        {
+            if (((*ppIter)->pUserRef == pUserRef) && ((*ppIter)->pfCbFunction == pfCbFunction))
+            {
+                TRDP_PD_CONSUMER_T *pConsumer = *ppIter;
+
+                *ppIter = pConsumer->pNext;
+                vos_memFree(pConsumer);
+                ret = TRDP_NO_ERR;
+                break;
+            }
+        }
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    return ret;
+}
+
+
+/**********************************************************************************************************************/
+/** Reprepare for receiving PD messages.
+ *  Resubscribe to a specific PD ComID and source IP
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           handle for this subscription
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr1          Source IP address, lower address in case of address range, set to 0 if not used
+ *  @param[in]      srcIpAddr2          upper address in case of address range, set to 0 if not used
+ *  @param[in]      destIpAddr          IP address to join
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       Resource (socket) not available, subscription canceled
+ */
+EXT_DECL TRDP_ERR_T tlp_resubscribe (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    UINT32              etbTopoCnt,
+    UINT32              opTrnTopoCnt,
+    TRDP_IP_ADDR_T      srcIpAddr1,
+    TRDP_IP_ADDR_T      srcIpAddr2,
+    TRDP_IP_ADDR_T      destIpAddr)
+{
+    TRDP_ERR_T  ret = TRDP_NO_ERR;
+    INT32       oldSocketIdx;
+
+    /*    Check params    */
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (subHandle->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    /*    Reserve mutual access    */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    oldSocketIdx = subHandle->socketIdx;
+
+    /*  Change the addressing item   */
+    subHandle->addr.srcIpAddr   = srcIpAddr1;
+    subHandle->addr.srcIpAddr2   = srcIpAddr2;
+    subHandle->addr.destIpAddr  = destIpAddr;
+
+    subHandle->addr.etbTopoCnt      = etbTopoCnt;
+    subHandle->addr.opTrnTopoCnt    = opTrnTopoCnt;
+    trdp_srcTableFree(appHandle);
+
+    if (vos_isMulticast(destIpAddr))
+    {
+        /* For multicast subscriptions, we might need to change the socket joins */
+        if (subHandle->addr.mcGroup != destIpAddr)
+        {
+            /*  Find the correct socket
+             Release old usage first, we unsubscribe to the former MC group, because it is not valid anymore */
+            trdp_releaseSocket(appHandle->iface, subHandle->socketIdx, 0u, FALSE, subHandle->addr.mcGroup);
+            ret = trdp_pdRequestRcvSocket(appHandle,
+                                          subHandle->addr.comId,
+                                          destIpAddr,
+                                          (srcIpAddr2 == VOS_INADDR_ANY) ? srcIpAddr1 : VOS_INADDR_ANY,
+                                          &subHandle->socketIdx);
+            if (ret != TRDP_NO_ERR)
+            {
+                /* This is a critical error: We must unsubscribe! */
+                (void) tlp_unsubscribe(appHandle, subHandle);
+                vos_printLogStr(VOS_LOG_ERROR, "tlp_resubscribe() failed, out of sockets\n");
+            }
+            else
+            {
+                subHandle->addr.mcGroup = destIpAddr;
+            }
+        }
+        else
+        {
+            /* Same group, but a source specific join might not cover the new source */
+            if ((subHandle->socketIdx != TRDP_INVALID_SOCKET_INDEX)
+                && (trdp_SockAddJoin(&appHandle->iface[subHandle->socketIdx], destIpAddr,
+                                     (srcIpAddr2 == VOS_INADDR_ANY) ? srcIpAddr1 : VOS_INADDR_ANY,
+                                     appHandle->realIP) == FALSE))
+            {
+                vos_printLogStr(VOS_LOG_WARNING, "tlp_resubscribe() could not join the new source\n");
+            }
+            subHandle->addr.mcGroup = destIpAddr;
+        }
+    }
+    else
+    {
+        subHandle->addr.mcGroup = 0u;
+    }
+
+    /*  The filter of the former socket and of the new one changed  */
+    trdp_pdSetSockFilter(appHandle, oldSocketIdx);
+    if ((ret == TRDP_NO_ERR) && (subHandle->socketIdx != oldSocketIdx))
+    {
+        trdp_pdSetSockFilter(appHandle, subHandle->socketIdx);
+        trdp_rcvSockPrio(appHandle, oldSocketIdx);
+        trdp_rcvSockPrio(appHandle, subHandle->socketIdx);
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Set the priority of a subscription.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           handle for this subscription
+ *  @param[in]      prio                priority 0 (lowest) .. 7 (highest)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_setPriority (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    UINT8               prio)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if ((subHandle == NULL) || (prio > TRDP_PD_PRIO_MAX))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (subHandle->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    /*    Reserve mutual access    */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*  Move the subscription behind the others of its new priority  */
+    trdp_rcvQueueSetPrio(appHandle, subHandle, prio);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return TRDP_NO_ERR;
+}
+
+
+/**********************************************************************************************************************/
+/** Receive a subscription on a second interface as well.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           handle for this subscription
+ *  @param[in]      ifaceIp             own IP address on the second network, 0: stop receiving there
+ *  @param[in]      srcIpAddr           IP address of the publisher on the second network
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       multicast group could not be joined
+ */
+EXT_DECL TRDP_ERR_T tlp_addRecvInterface (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_IP_ADDR_T      ifaceIp,
+    TRDP_IP_ADDR_T      srcIpAddr)
+{
+    TRDP_SOCKETS_T  *pSock;
+    TRDP_ERR_T      ret = TRDP_NO_ERR;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (subHandle == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (subHandle->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    /*  The sequence counters of both sources are checked as one: the subscription must have a single source  */
+    if ((ifaceIp != VOS_INADDR_ANY) &&
+        ((srcIpAddr == VOS_INADDR_ANY) || (subHandle->addr.srcIpAddr == VOS_INADDR_ANY) ||
+         ((subHandle->addr.srcIpAddr2 != VOS_INADDR_ANY) && (subHandle->addr.srcIpAddr2 != subHandle->addr.srcIpAddr))))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /*    Reserve mutual access    */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pSock = &appHandle->iface[subHandle->socketIdx];
+    if ((ifaceIp != VOS_INADDR_ANY) && (subHandle->addr.mcGroup == VOS_INADDR_ANY) &&
+        (pSock->bindAddr != VOS_INADDR_ANY) && (pSock->bindAddr != ifaceIp))
+    {
+        /*  A socket bound to the address of the first interface does not receive unicasts of the second one */
+        vos_printLogStr(VOS_LOG_ERROR, "tlp_addRecvInterface: session bound to one interface\n");
+        ret = TRDP_PARAM_ERR;
+    }
+    else if ((ifaceIp != VOS_INADDR_ANY) && (subHandle->addr.mcGroup != VOS_INADDR_ANY) &&
+             (vos_sockJoinMC(pSock->sock, subHandle->addr.mcGroup, ifaceIp) != VOS_NO_ERR))
+    {
+        ret = TRDP_SOCK_ERR;
+    }
+    else
+    {
+        if (subHandle->redIfaceAddr != VOS_INADDR_ANY)
+        {
+            if ((subHandle->addr.mcGroup != VOS_INADDR_ANY) && (subHandle->redIfaceAddr != ifaceIp))
+            {
+                (void) vos_sockLeaveMC(pSock->sock, subHandle->addr.mcGroup, subHandle->redIfaceAddr);
+            }
+            appHandle->redRcvCnt--;
+        }
+        subHandle->redIfaceAddr = ifaceIp;
+        subHandle->redIpAddr    = (ifaceIp != VOS_INADDR_ANY) ? srcIpAddr : VOS_INADDR_ANY;
+        if (ifaceIp != VOS_INADDR_ANY)
+        {
+            appHandle->redRcvCnt++;
+        }
+        trdp_pdSetSockFilter(appHandle, subHandle->socketIdx);
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Copy the last valid PD message of a subscription, the session is locked.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pElement            the subscription
+ *  @param[in]      pNow                current time
+ *  @param[in,out]  pPdInfo             pointer to application's info buffer or NULL
+ *  @param[in,out]  pData               pointer to application's data buffer
+ *  @param[in,out]  pDataSize           in: size of buffer, out: size of data
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_SAFETY_ERR     vital data not valid
+ *  @retval         other               result of trdp_pdGet
+ */
+static TRDP_ERR_T trdp_getLocked (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pElement,
+    const TRDP_TIME_T   *pNow,
+    TRDP_PD_INFO_T      *pPdInfo,
+    UINT8               *pData,
+    UINT32              *pDataSize)
+{
+    TRDP_ERR_T ret;
+
+    /*    Check time out    */
+    if (timerisset(&pElement->interval) &&
+        timercmp(&pElement->timeToGo, pNow, <))
+    {
+        /*    Packet is late    */
+        if (pElement->toBehavior == TRDP_TO_SET_TO_ZERO &&
+            pData != NULL && pDataSize != NULL)
+        {
+            memset(pData, 0, *pDataSize);
+        }
+        else /* TRDP_TO_KEEP_LAST_VALUE */
+        {
+            ;
+        }
+        ret = TRDP_TIMEOUT_ERR;
+    }
+    else if ((pElement->sdtIdx != 0u) && (trdp_sdtGetState(appHandle, pElement, pNow) != TRDP_SDT_VALID))
+    {
+        /*    No fresh valid vital data    */
+        ret = TRDP_SAFETY_ERR;
+    }
+    else
+    {
+        ret = trdp_pdGet(pElement,
+                         appHandle->marshall.pfCbUnmarshall,
+                         appHandle->marshall.pRefCon,
+                         pData,
+                         pDataSize);
+    }
+
+    if (pPdInfo != NULL)
+    {
+        trdp_pdGetInfo(pElement, pPdInfo, ret);
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Get the last valid PD message.
+ *  This allows polling of PDs instead of event driven handling by callbacks
+ *  If the session was opened with TRDP_OPTION_PD_THREAD, the data is copied from the last frame handed over by
+ *  the receive thread without locking the session.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in,out]  pPdInfo             pointer to application's info buffer
+ *  @param[in,out]  pData               pointer to application's data buffer
+ *  @param[in,out]  pDataSize           in: size of buffer, out: size of data
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_SUB_ERR        not subscribed
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_SAFETY_ERR     vital data not valid (see tlp_getSdtStatus), data not copied
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_COMID_ERR      ComID not found when marshalling
+ */
+EXT_DECL TRDP_ERR_T tlp_get (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_INFO_T      *pPdInfo,
+    UINT8               *pData,
+    UINT32              *pDataSize)
+{
+    PD_ELE_T    *pElement   = (PD_ELE_T *) subHandle;
+    TRDP_ERR_T  ret         = TRDP_NOSUB_ERR;
+    TRDP_TIME_T now;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pElement == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+#if TRDP_PD_RCV_THREAD
+    /*    Received by the PD thread: copy the latest frame without locking the session,
+          vital data needs the state of the safe channel    */
+    if ((appHandle->option & TRDP_OPTION_PD_THREAD) && (pElement->pSnap != NULL) && (pElement->sdtIdx == 0u))
+    {
+        return trdp_pdSnapGet(pElement,
+                              appHandle->marshall.pfCbUnmarshall,
+                              appHandle->marshall.pRefCon,
+                              pPdInfo,
+                              pData,
+                              pDataSize);
+    }
+#endif
+
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        /*    Call the receive function if we are in non blocking mode    */
+        if (!(appHandle->option & TRDP_OPTION_BLOCK))
+        {
+            /* read all you can get, return value is not interesting */
+            trdp_shareRxBegin(appHandle);
+            do
+            {}
+            while (trdp_pdReceive(appHandle, appHandle->iface[pElement->socketIdx].sock) == TRDP_NO_ERR);
+            trdp_pdCallPending(appHandle);
+            trdp_shareRxEnd(appHandle);
+        }
+
+        /*    Get the current time    */
+        vos_getTime(&now);
+
+        ret = trdp_getLocked(appHandle, pElement, &now, pPdInfo, pData, pDataSize);
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Get the last valid PD messages of several subscriptions at once.
+ *  Same as tlp_get for each item, but the session is locked only once and, in polling mode, each socket is read
+ *  once. Subscriptions received by the PD thread are copied from their snapshot without locking. The result and
+ *  PD info of each telegram are returned in its item.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pItems              array of subscriber handles and buffers, result and info per item
+ *  @param[in]      numItems            number of items
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               result of the last failing item
+ */
+EXT_DECL TRDP_ERR_T tlp_getMulti (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_GET_ITEM_T     *pItems,
+    UINT32              numItems)
+{
+    TRDP_ERR_T  ret     = TRDP_NO_ERR;
+    BOOL8       locked  = FALSE;
+    TRDP_TIME_T now;
+    UINT8       sockRead[VOS_MAX_SOCKET_CNT];
+    UINT32      i;
+
+    if ((pItems == NULL) && (numItems > 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    memset(sockRead, 0, sizeof(sockRead));
 
-            /*    Compute the header fields */
-            trdp_pdInit(pReqElement, TRDP_MSG_PR, etbTopoCnt, opTrnTopoCnt, replyComId, replyIpAddr);
+    for (i = 0u; i < numItems; i++)
+    {
+        PD_ELE_T *pElement = (PD_ELE_T *) pItems[i].subHandle;
 
-            /*  Copy data only if available! */
-            if ((NULL != pData) && (0u < dataSize))
+        if (pElement == NULL)
+        {
+            pItems[i].result = TRDP_PARAM_ERR;
+        }
+        else if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+        {
+            pItems[i].result = TRDP_NOSUB_ERR;
+        }
+#if TRDP_PD_RCV_THREAD
+        else if ((appHandle->option & TRDP_OPTION_PD_THREAD) && (pElement->pSnap != NULL) &&
+                 (pElement->sdtIdx == 0u))
+        {
+            /*    Received by the PD thread: copy the latest frame without locking the session    */
+            pItems[i].result = trdp_pdSnapGet(pElement,
+                                              appHandle->marshall.pfCbUnmarshall,
+                                              appHandle->marshall.pRefCon,
+                                              &pItems[i].pdInfo,
+                                              pItems[i].pData,
+                                              &pItems[i].dataSize);
+        }
+#endif
+        else
+        {
+            /*    Reserve mutual access once for all remaining items    */
+            if (!locked)
             {
-                ret = tlp_put(appHandle, (TRDP_PUB_T) pReqElement, pData, dataSize);
+                if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+                {
+                    return TRDP_NOINIT_ERR;
+                }
+                locked = TRUE;
+                vos_getTime(&now);
             }
-            /*  This flag triggers sending in tlc_process (one shot)  */
-            pReqElement->privFlags |= TRDP_REQ_2B_SENT;
 
-            /*    Set the current time and start time out of subscribed packet  */
-            if (timerisset(&pSubPD->interval))
+            /*    Call the receive function once per socket if we are in non blocking mode    */
+            if (!(appHandle->option & TRDP_OPTION_BLOCK) &&
+                (pElement->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
+                (sockRead[pElement->socketIdx] == 0u))
             {
-                vos_getTime(&pSubPD->timeToGo);
-                vos_addTime(&pSubPD->timeToGo, &pSubPD->interval);
-                pSubPD->privFlags &= (unsigned)~TRDP_TIMED_OUT;   /* Reset time out flag (#151) */
+                sockRead[pElement->socketIdx] = 1u;
+                trdp_shareRxBegin(appHandle);
+                do
+                {}
+                while (trdp_pdReceive(appHandle, appHandle->iface[pElement->socketIdx].sock) == TRDP_NO_ERR);
+                trdp_pdCallPending(appHandle);
+                trdp_shareRxEnd(appHandle);
+                vos_getTime(&now);
             }
-        }
 
-        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+            pItems[i].result = trdp_getLocked(appHandle, pElement, &now, &pItems[i].pdInfo,
+                                              pItems[i].pData, &pItems[i].dataSize);
+        }
+        if (pItems[i].result != TRDP_NO_ERR)
         {
-            vos_printLogStr(VOS_LOG_ERROR, "vos_mutexUnlock() failed\n");
+            ret = pItems[i].result;
         }
     }
 
+    if (locked && (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR))
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
     return ret;
 }
 
 /**********************************************************************************************************************/
-/** Prepare for receiving PD messages.
- *  Subscribe to a specific PD ComID and source IP.
+/** Create a subscription group.
+ *  The latest frames of the group's subscriptions are copied into one of two buffers of the group at the end of each
+ *  receive pass in which one of them received a frame. tlp_getSubGroup() reads all of them from the same pass.
+ *  Vital subscriptions (tlp_setSdt) cannot be members.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[out]     pSubHandle          return a handle for this subscription
- *  @param[in]      pUserRef            user supplied value returned within the info structure
- *  @param[in]      pfCbFunction        Pointer to subscriber specific callback function, NULL to use default function
- *  @param[in]      comId               comId of packet to receive
- *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
- *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
- *  @param[in]      srcIpAddr1          Source IP address, lower address in case of address range, set to 0 if not used
- *  @param[in]      srcIpAddr2          upper address in case of address range, set to 0 if not used
- *  @param[in]      pktFlags            OPTION:
- *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
- *  @param[in]      destIpAddr          IP address to join
- *  @param[in]      timeout             timeout (>= 10ms) in usec
- *  @param[in]      toBehavior          timeout behavior
+ *  @param[out]     pGroupHandle        returned handle of the group
+ *  @param[in]      pSubHandles         the subscriptions of the group
+ *  @param[in]      numSubs             number of subscriptions, 1...TRDP_PD_GROUP_MAX_SUBS
  *
  *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
+ *  @retval         TRDP_PARAM_ERR      parameter error, vital subscription
+ *  @retval         TRDP_NOSUB_ERR      a handle is no subscription
+ *  @retval         TRDP_MEM_ERR        out of memory
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
-EXT_DECL TRDP_ERR_T tlp_subscribe (
+EXT_DECL TRDP_ERR_T tlp_createSubGroup (
     TRDP_APP_SESSION_T  appHandle,
-    TRDP_SUB_T          *pSubHandle,
-    const void          *pUserRef,
-    TRDP_PD_CALLBACK_T  pfCbFunction,
-    UINT32              comId,
-    UINT32              etbTopoCnt,
-    UINT32              opTrnTopoCnt,
-    TRDP_IP_ADDR_T      srcIpAddr1,
-    TRDP_IP_ADDR_T      srcIpAddr2,
-    TRDP_IP_ADDR_T      destIpAddr,
-    TRDP_FLAGS_T        pktFlags,
-    UINT32              timeout,
-    TRDP_TO_BEHAVIOR_T  toBehavior)
+    TRDP_SUB_GROUP_T    *pGroupHandle,
+    const TRDP_SUB_T    *pSubHandles,
+    UINT32              numSubs)
 {
-    TRDP_TIME_T         now;
-    TRDP_ERR_T          ret = TRDP_NO_ERR;
-    TRDP_ADDRESSES_T    subHandle;
-    INT32 lIndex;
+    TRDP_ERR_T  ret;
+    UINT32      i;
 
-    /*    Check params    */
-    if (pSubHandle == NULL)
+    if ((pGroupHandle == NULL) || (pSubHandles == NULL) || (numSubs == 0u) || (numSubs > TRDP_PD_GROUP_MAX_SUBS))
     {
         return TRDP_PARAM_ERR;
     }
@@ -2077,169 +4644,263 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
         return TRDP_NOINIT_ERR;
     }
 
-    if (timeout == 0u)
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
     {
-        timeout = appHandle->pdDefault.timeout;
+        for (i = 0u; i < numSubs; i++)
+        {
+            if ((pSubHandles[i] == NULL) || (pSubHandles[i]->magic != TRDP_MAGIC_SUB_HNDL_VALUE))
+            {
+                ret = TRDP_NOSUB_ERR;
+                break;
+            }
+            if (pSubHandles[i]->sdtIdx != 0u)
+            {
+                ret = TRDP_PARAM_ERR;               /* vital data needs the state of the safe channel */
+                break;
+            }
+        }
+        if (ret == TRDP_NO_ERR)
+        {
+            ret = trdp_pdGroupCreate(appHandle, pGroupHandle, pSubHandles, numSubs);
+        }
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
     }
-    else if (timeout < TRDP_TIMER_GRANULARITY)
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Get the data of a subscription group from the same receive pass.
+ *  Items as for tlp_getMulti, each naming a subscription of the group, in any order. The session is not locked if
+ *  the target has atomic built-ins, the sockets are not read.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      groupHandle         the handle returned by tlp_createSubGroup
+ *  @param[in,out]  pItems              array of subscriber handles and buffers, result and info per item
+ *  @param[in]      numItems            number of items
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               result of the last failing item
+ */
+EXT_DECL TRDP_ERR_T tlp_getSubGroup (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_GROUP_T    groupHandle,
+    TRDP_GET_ITEM_T     *pItems,
+    UINT32              numItems)
+{
+    TRDP_ERR_T ret;
+
+    if ((groupHandle == NULL) || (groupHandle->magic != TRDP_MAGIC_GROUP_HNDL_VALUE) ||
+        ((pItems == NULL) && (numItems > 0u)))
     {
-        timeout = TRDP_TIMER_GRANULARITY;
+        return TRDP_PARAM_ERR;
     }
 
-    /*    Reserve mutual access    */
-    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    if (!trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
     }
 
-    /*  Create an addressing item   */
-    subHandle.comId         = comId;
-    subHandle.srcIpAddr     = srcIpAddr1;
-    subHandle.srcIpAddr2    = srcIpAddr2;
-    subHandle.destIpAddr    = destIpAddr;
-    subHandle.opTrnTopoCnt  = 0u;            /* Do not compare topocounts  */
-    subHandle.etbTopoCnt    = 0u;
-
-    if (vos_isMulticast(destIpAddr))
-    {
-        subHandle.mcGroup = destIpAddr;
-    }
-    else
+#if TRDP_PD_GROUP_SEQLOCK
+    ret = trdp_pdGroupGet(appHandle, groupHandle, pItems, numItems);
+#else
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
     {
-        subHandle.mcGroup = 0u;
+        ret = trdp_pdGroupGet(appHandle, groupHandle, pItems, numItems);
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
     }
+#endif
+    return ret;
+}
 
-    /*    Get the current time    */
-    vos_getTime(&now);
+/**********************************************************************************************************************/
+/** Delete a subscription group. The subscriptions are not affected.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      groupHandle         the handle returned by tlp_createSubGroup
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_deleteSubGroup (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_GROUP_T    groupHandle)
+{
+    TRDP_ERR_T ret;
 
-    /*    Look for existing element    */
-    if (trdp_queueFindSubAddr(appHandle->pRcvQueue, &subHandle) != NULL)
+    if ((groupHandle == NULL) || (groupHandle->magic != TRDP_MAGIC_GROUP_HNDL_VALUE))
     {
-        ret = TRDP_NOSUB_ERR;
+        return TRDP_PARAM_ERR;
     }
-    else
-    {
-        subHandle.opTrnTopoCnt  = opTrnTopoCnt; /* Set topocounts now  */
-        subHandle.etbTopoCnt    = etbTopoCnt;
 
-        /*    Find a (new) socket    */
-        ret = trdp_requestSocket(appHandle->iface,
-                                 appHandle->pdDefault.port,
-                                 &appHandle->pdDefault.sendParam,
-                                 appHandle->realIP,
-                                 subHandle.mcGroup,
-                                 TRDP_SOCK_PD,
-                                 appHandle->option,
-                                 TRUE,
-                                 -1,
-                                 &lIndex,
-                                 0u);
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        ret = trdp_pdGroupUnlink(appHandle, groupHandle);
         if (ret == TRDP_NO_ERR)
         {
-            PD_ELE_T *newPD;
-
-            /*    buffer size is PD_ELEMENT plus max. payload size    */
-
-            /*    Allocate a buffer for this kind of packets    */
-            newPD = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+            trdp_pdGroupFree(groupHandle);
+        }
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
 
-            if (newPD == NULL)
-            {
-                ret = TRDP_MEM_ERR;
-                trdp_releaseSocket(appHandle->iface, lIndex, 0u, FALSE, VOS_INADDR_ANY);
-            }
-            else
-            {
-                /*  Alloc the corresponding data buffer  */
-                newPD->pFrame = (PD_PACKET_T *) vos_memAlloc(TRDP_MAX_PD_PACKET_SIZE);
-                if (newPD->pFrame == NULL)
-                {
-                    vos_memFree(newPD);
-                    newPD   = NULL;
-                    ret     = TRDP_MEM_ERR;
-                }
-                else
-                {
-                    /*    Initialize some fields    */
-                    if (vos_isMulticast(destIpAddr))
-                    {
-                        newPD->addr.mcGroup = destIpAddr;
-                        newPD->privFlags    |= TRDP_MC_JOINT;
-                    }
-                    else
-                    {
-                        newPD->addr.mcGroup = 0u;
-                    }
+    return ret;
+}
 
-                    newPD->addr.comId       = comId;
-                    newPD->addr.srcIpAddr   = srcIpAddr1;
-                    newPD->addr.srcIpAddr2  = srcIpAddr2;
-                    newPD->addr.destIpAddr  = destIpAddr;
-                    newPD->interval.tv_sec  = timeout / 1000000u;
-                    newPD->interval.tv_usec = timeout % 1000000u;
-                    newPD->toBehavior       =
-                        (toBehavior == TRDP_TO_DEFAULT) ? appHandle->pdDefault.toBehavior : toBehavior;
-                    newPD->grossSize    = TRDP_MAX_PD_PACKET_SIZE;
-                    newPD->pUserRef     = pUserRef;
-                    newPD->socketIdx    = lIndex;
-                    newPD->privFlags    |= TRDP_INVALID_DATA;
-                    newPD->pktFlags     =
-                        (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
-                    newPD->pfCbFunction =
-                        (pfCbFunction == NULL) ? appHandle->pdDefault.pfCbFunction : pfCbFunction;
-                    newPD->pCachedDS    = NULL;
-                    newPD->magic        = TRDP_MAGIC_SUB_HNDL_VALUE;
+/**********************************************************************************************************************/
+/** Get a reference to the last valid PD message.
+ *  Like tlp_get, but instead of copying the data a pointer to the received frame is returned. The data is in
+ *  network representation, it is not unmarshalled. The frame stays valid until the next PD of this subscription is
+ *  received, tlp_releaseBufferRef tells if this happened while the data was read.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in,out]  pPdInfo             pointer to application's info buffer or NULL
+ *  @param[out]     ppData              pointer to the received data, NULL on error
+ *  @param[out]     pDataSize           size of the received data
+ *  @param[out]     pGeneration         generation of the frame, to be passed to tlp_releaseBufferRef
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NODATA_ERR     no data received yet
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_SAFETY_ERR     vital data not valid (see tlp_getSdtStatus)
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_getBufferRef (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_INFO_T      *pPdInfo,
+    const UINT8         **ppData,
+    UINT32              *pDataSize,
+    UINT32              *pGeneration)
+{
+    PD_ELE_T    *pElement   = (PD_ELE_T *) subHandle;
+    TRDP_ERR_T  ret         = TRDP_NOSUB_ERR;
+    TRDP_TIME_T now;
 
-                    if (timeout == TRDP_TIMER_FOREVER)
-                    {
-                        vos_clearTime(&newPD->timeToGo);
-                        vos_clearTime(&newPD->interval);
-                    }
-                    else
-                    {
-                        vos_getTime(&newPD->timeToGo);
-                        vos_addTime(&newPD->timeToGo, &newPD->interval);
-                    }
+    if ((pElement == NULL) || (ppData == NULL) || (pDataSize == NULL) || (pGeneration == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
 
-                    /*  append this subscription to our receive queue */
-                    trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
+    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
 
-                    *pSubHandle = (TRDP_SUB_T) newPD;
-                }
-            }
-        } /*lint !e438 unused newPD */
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
     }
 
-    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
     {
-        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        /*    Call the receive function if we are in non blocking mode    */
+        if (!(appHandle->option & (TRDP_OPTION_BLOCK | TRDP_OPTION_PD_THREAD)))
+        {
+            /* read all you can get, return value is not interesting */
+            trdp_shareRxBegin(appHandle);
+            do
+            {}
+            while (trdp_pdReceive(appHandle, appHandle->iface[pElement->socketIdx].sock) == TRDP_NO_ERR);
+            trdp_pdCallPending(appHandle);
+            trdp_shareRxEnd(appHandle);
+        }
+
+        /*    Get the current time    */
+        vos_getTime(&now);
+
+        /*    Check time out    */
+        if ((timerisset(&pElement->interval) && timercmp(&pElement->timeToGo, &now, <)) ||
+            (pElement->privFlags & TRDP_TIMED_OUT))
+        {
+            ret = TRDP_TIMEOUT_ERR;
+        }
+        else if (pElement->privFlags & TRDP_INVALID_DATA)
+        {
+            ret = TRDP_NODATA_ERR;
+        }
+        else if ((pElement->sdtIdx != 0u) && (trdp_sdtGetState(appHandle, pElement, &now) != TRDP_SDT_VALID))
+        {
+            ret = TRDP_SAFETY_ERR;
+        }
+
+        if (ret == TRDP_NO_ERR)
+        {
+            pElement->getPkts++;
+            *ppData     = pElement->pFrame->data;
+            *pDataSize  = pElement->dataSize;
+        }
+        else
+        {
+            *ppData     = NULL;
+            *pDataSize  = 0u;
+        }
+        *pGeneration = pElement->frameGen;
+
+        if (pPdInfo != NULL)
+        {
+            trdp_pdGetInfo(pElement, pPdInfo, ret);
+        }
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
     }
 
     return ret;
 }
 
-
 /**********************************************************************************************************************/
-/** Stop receiving PD messages.
- *  Unsubscribe to a specific PD ComID
+/** Return a reference obtained by tlp_getBufferRef.
+ *  Checks whether the referenced frame was still current; if not, the data read in between may be inconsistent and
+ *  must be discarded.
  *
- *  @param[in]      appHandle            the handle returned by tlc_openSession
- *  @param[in]      subHandle            the handle for this subscription
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in]      generation          generation returned by tlp_getBufferRef
  *
- *  @retval         TRDP_NO_ERR          no error
- *  @retval         TRDP_PARAM_ERR       parameter error
- *  @retval         TRDP_NOSUB_ERR       not subscribed
- *  @retval         TRDP_NOINIT_ERR      handle invalid
+ *  @retval         TRDP_NO_ERR         the data was not overwritten
+ *  @retval         TRDP_STATE_ERR      a new frame was received meanwhile, data is not reliable
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
-EXT_DECL TRDP_ERR_T tlp_unsubscribe (
+EXT_DECL TRDP_ERR_T tlp_releaseBufferRef (
     TRDP_APP_SESSION_T  appHandle,
-    TRDP_SUB_T          subHandle)
+    TRDP_SUB_T          subHandle,
+    UINT32              generation)
 {
     PD_ELE_T    *pElement = (PD_ELE_T *) subHandle;
     TRDP_ERR_T  ret;
 
-    if (pElement == NULL )
+    if (pElement == NULL)
     {
         return TRDP_PARAM_ERR;
     }
@@ -2254,74 +4915,54 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
         return TRDP_NOINIT_ERR;
     }
 
-    /*    Reserve mutual access    */
+    /*    The receiver changes the generation before it overwrites the old frame, the lock orders our reads    */
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
     if (ret == TRDP_NO_ERR)
     {
-        TRDP_IP_ADDR_T mcGroup = pElement->addr.mcGroup;
-        /*    Remove from queue?    */
-        trdp_queueDelElement(&appHandle->pRcvQueue, pElement);
-        /*    if we subscribed to an MC-group, check if anyone else did too: */
-        if (mcGroup != VOS_INADDR_ANY)
-        {
-            mcGroup = trdp_findMCjoins(appHandle, mcGroup);
-        }
-        trdp_releaseSocket(appHandle->iface, pElement->socketIdx, 0u, FALSE, mcGroup);
-        pElement->magic = 0u;
-        if (pElement->pFrame != NULL)
-        {
-            vos_memFree(pElement->pFrame);
-        }
-        if (pElement->pSeqCntList != NULL)
-        {
-            vos_memFree(pElement->pSeqCntList);
-        }
-        vos_memFree(pElement);
-        ret = TRDP_NO_ERR;
+        ret = (pElement->frameGen == generation) ? TRDP_NO_ERR : TRDP_STATE_ERR;
+
         if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
     }
 
-    return ret;      /*    Not found    */
+    return ret;
 }
 
-
 /**********************************************************************************************************************/
-/** Reprepare for receiving PD messages.
- *  Resubscribe to a specific PD ComID and source IP
+/** Validate the vital data of a subscription (SDTv2).
+ *  Each received frame is checked before it replaces the last valid data: safety code (SC-32 seeded with the SID of
+ *  smi1 or smi2), user data version, safe sequence counter and latency. Invalid frames are discarded and reported to
+ *  the callback with TRDP_SAFETY_ERR, tlp_get() returns TRDP_SAFETY_ERR unless the channel is TRDP_SDT_VALID.
+ *  Calling it again resets the channel, also after the channel monitoring latched TRDP_SDT_ERROR.
+ *  With TRDP_OPTION_PD_THREAD tlp_get() of a vital subscription locks the session to check the channel.
+ *  Members of a subscription group cannot be vital, tlp_getSubGroup() does not check the channels.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[in]      subHandle           handle for this subscription
- *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
- *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
- *  @param[in]      srcIpAddr1          Source IP address, lower address in case of address range, set to 0 if not used
- *  @param[in]      srcIpAddr2          upper address in case of address range, set to 0 if not used
- *  @param[in]      destIpAddr          IP address to join
+ *  @param[in]      subHandle           the handle returned by subscription
+ *  @param[in]      pSdtPar             SDT parameters, NULL to end the validation
+ *  @param[in]      cstUUID             UUID of the source's consist, all zero for consist local communication
+ *  @param[in]      safeTopoCnt         safe topography counter, 0 for consist local communication
  *
  *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
+ *  @retval         TRDP_PARAM_ERR      parameter error, subscription is member of a group
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_MEM_ERR        out of memory
  *  @retval         TRDP_NOINIT_ERR     handle invalid
- *  @retval         TRDP_SOCK_ERR       Resource (socket) not available, subscription canceled
  */
-EXT_DECL TRDP_ERR_T tlp_resubscribe (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_SUB_T          subHandle,
-    UINT32              etbTopoCnt,
-    UINT32              opTrnTopoCnt,
-    TRDP_IP_ADDR_T      srcIpAddr1,
-    TRDP_IP_ADDR_T      srcIpAddr2,
-    TRDP_IP_ADDR_T      destIpAddr)
+EXT_DECL TRDP_ERR_T tlp_setSdt (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_SUB_T              subHandle,
+    const TRDP_SDT_PAR_T    *pSdtPar,
+    const TRDP_UUID_T       cstUUID,
+    UINT32                  safeTopoCnt)
 {
-    TRDP_ERR_T ret = TRDP_NO_ERR;
-
-    /*    Check params    */
+    TRDP_ERR_T ret;
 
-    if (!trdp_isValidSession(appHandle))
+    if ((subHandle == NULL) || ((pSdtPar != NULL) && (cstUUID == NULL)))
     {
-        return TRDP_NOINIT_ERR;
+        return TRDP_PARAM_ERR;
     }
 
     if (subHandle->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
@@ -2329,103 +4970,58 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
         return TRDP_NOSUB_ERR;
     }
 
-    /*    Reserve mutual access    */
-    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    if (!trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
     }
 
-    /*  Change the addressing item   */
-    subHandle->addr.srcIpAddr   = srcIpAddr1;
-    subHandle->addr.srcIpAddr2   = srcIpAddr2;
-    subHandle->addr.destIpAddr  = destIpAddr;
-
-    subHandle->addr.etbTopoCnt      = etbTopoCnt;
-    subHandle->addr.opTrnTopoCnt    = opTrnTopoCnt;
-
-    if (vos_isMulticast(destIpAddr))
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
     {
-        /* For multicast subscriptions, we might need to change the socket joins */
-        if (subHandle->addr.mcGroup != destIpAddr)
+        if ((pSdtPar != NULL) && trdp_pdGroupsHaveSub(appHandle, subHandle))
         {
-            /*  Find the correct socket
-             Release old usage first, we unsubscribe to the former MC group, because it is not valid anymore */
-            trdp_releaseSocket(appHandle->iface, subHandle->socketIdx, 0u, FALSE, subHandle->addr.mcGroup);
-            ret = trdp_requestSocket(appHandle->iface,
-                                     appHandle->pdDefault.port,
-                                     &appHandle->pdDefault.sendParam,
-                                     appHandle->realIP,
-                                     destIpAddr,
-                                     TRDP_SOCK_PD,
-                                     appHandle->option,
-                                     TRUE,
-                                     -1,
-                                     &subHandle->socketIdx,
-                                     0u);
-            if (ret != TRDP_NO_ERR)
-            {
-                /* This is a critical error: We must unsubscribe! */
-                (void) tlp_unsubscribe(appHandle, subHandle);
-                vos_printLogStr(VOS_LOG_ERROR, "tlp_resubscribe() failed, out of sockets\n");
-            }
-            else
-            {
-                subHandle->addr.mcGroup = destIpAddr;
-            }
+            ret = TRDP_PARAM_ERR;
         }
         else
         {
-            subHandle->addr.mcGroup = destIpAddr;
+            ret = trdp_sdtSet(appHandle, subHandle, pSdtPar, cstUUID, safeTopoCnt);
         }
-    }
-    else
-    {
-        subHandle->addr.mcGroup = 0u;
-    }
 
-    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
-    {
-        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
     }
 
     return ret;
 }
 
-
 /**********************************************************************************************************************/
-/** Get the last valid PD message.
- *  This allows polling of PDs instead of event driven handling by callbacks
+/** Get the state and the error counters of a vital subscription.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @param[in]      subHandle           the handle returned by subscription
- *  @param[in,out]  pPdInfo             pointer to application's info buffer
- *  @param[in,out]  pData               pointer to application's data buffer
- *  @param[in,out]  pDataSize           in: size of buffer, out: size of data
+ *  @param[out]     pStatus             state and counters of the safe channel
  *
  *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_SUB_ERR        not subscribed
- *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         TRDP_PARAM_ERR      parameter error, subscription not vital
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
  *  @retval         TRDP_NOINIT_ERR     handle invalid
- *  @retval         TRDP_COMID_ERR      ComID not found when marshalling
  */
-EXT_DECL TRDP_ERR_T tlp_get (
+EXT_DECL TRDP_ERR_T tlp_getSdtStatus (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_SUB_T          subHandle,
-    TRDP_PD_INFO_T      *pPdInfo,
-    UINT8               *pData,
-    UINT32              *pDataSize)
+    TRDP_SDT_STATUS_T   *pStatus)
 {
-    PD_ELE_T    *pElement   = (PD_ELE_T *) subHandle;
-    TRDP_ERR_T  ret         = TRDP_NOSUB_ERR;
+    TRDP_ERR_T  ret;
     TRDP_TIME_T now;
 
-    if (pElement == NULL)
+    if ((subHandle == NULL) || (pStatus == NULL))
     {
         return TRDP_PARAM_ERR;
     }
 
-    if (pElement->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    if (subHandle->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
     {
         return TRDP_NOSUB_ERR;
     }
@@ -2435,61 +5031,78 @@ EXT_DECL TRDP_ERR_T tlp_get (
         return TRDP_NOINIT_ERR;
     }
 
-    /*    Reserve mutual access    */
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
     if (ret == TRDP_NO_ERR)
     {
-        /*    Call the receive function if we are in non blocking mode    */
-        if (!(appHandle->option & TRDP_OPTION_BLOCK))
+        if (subHandle->sdtIdx == 0u)
         {
-            /* read all you can get, return value is not interesting */
-            do
-            {}
-            while (trdp_pdReceive(appHandle, appHandle->iface[pElement->socketIdx].sock) == TRDP_NO_ERR);
+            ret = TRDP_PARAM_ERR;
         }
-
-        /*    Get the current time    */
-        vos_getTime(&now);
-
-        /*    Check time out    */
-        if (timerisset(&pElement->interval) &&
-            timercmp(&pElement->timeToGo, &now, <))
+        else
         {
-            /*    Packet is late    */
-            if (pElement->toBehavior == TRDP_TO_SET_TO_ZERO &&
-                pData != NULL && pDataSize != NULL)
-            {
-                memset(pData, 0, *pDataSize);
-            }
-            else /* TRDP_TO_KEEP_LAST_VALUE */
-            {
-                ;
-            }
-            ret = TRDP_TIMEOUT_ERR;
+            vos_getTime(&now);
+            trdp_sdtGetStatus(appHandle, subHandle, &now, pStatus);
         }
-        else
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
         {
-            ret = trdp_pdGet(pElement,
-                             appHandle->marshall.pfCbUnmarshall,
-                             appHandle->marshall.pRefCon,
-                             pData,
-                             pDataSize);
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
+    }
 
-        if (pPdInfo != NULL)
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Receive the PD of the session by AF_XDP.
+ *  The PD frames for the session's PD port arriving on the given receive queue of the interface are redirected by an
+ *  XDP program into frame buffers shared with the stack and handled from there, bypassing the kernel's UDP stack.
+ *  Subscriptions and multicast joins are unchanged; frames of other queues are still received by the PD sockets.
+ *  The AF_XDP socket is closed with the session. Only one session per interface can use it.
+ *  Linux only, needs the CAP_NET_ADMIN and CAP_BPF capabilities.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pIfName             name of the interface
+ *  @param[in]      queueId             receive queue of the interface
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, AF_XDP already used by the session
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       AF_XDP not supported or not permitted
+ */
+EXT_DECL TRDP_ERR_T tlp_openXdp (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pIfName,
+    UINT32              queueId)
+{
+    TRDP_ERR_T ret;
+
+    if (pIfName == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        if (appHandle->pdXdp != NULL)
         {
-            pPdInfo->comId          = pElement->addr.comId;
-            pPdInfo->srcIpAddr      = pElement->lastSrcIP;
-            pPdInfo->destIpAddr     = pElement->addr.destIpAddr;
-            pPdInfo->etbTopoCnt     = vos_ntohl(pElement->pFrame->frameHead.etbTopoCnt);
-            pPdInfo->opTrnTopoCnt   = vos_ntohl(pElement->pFrame->frameHead.opTrnTopoCnt);
-            pPdInfo->msgType        = (TRDP_MSG_T) vos_ntohs(pElement->pFrame->frameHead.msgType);
-            pPdInfo->seqCount       = pElement->curSeqCnt;
-            pPdInfo->protVersion    = vos_ntohs(pElement->pFrame->frameHead.protocolVersion);
-            pPdInfo->replyComId     = vos_ntohl(pElement->pFrame->frameHead.replyComId);
-            pPdInfo->replyIpAddr    = vos_ntohl(pElement->pFrame->frameHead.replyIpAddress);
-            pPdInfo->pUserRef       = pElement->pUserRef;
-            pPdInfo->resultCode     = ret;
+            ret = TRDP_PARAM_ERR;
+        }
+        else if ((vos_xdpOpen(&appHandle->pdXdp, pIfName, queueId, appHandle->pdDefault.port) != VOS_NO_ERR) ||
+                 (vos_xdpGetFd(appHandle->pdXdp, &appHandle->pdXdpSock) != VOS_NO_ERR))
+        {
+            if (appHandle->pdXdp != NULL)
+            {
+                (void) vos_xdpClose(appHandle->pdXdp);
+                appHandle->pdXdp = NULL;
+            }
+            ret = TRDP_SOCK_ERR;
         }
 
         if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
@@ -2526,6 +5139,7 @@ EXT_DECL TRDP_ERR_T tlp_get (
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        out of memory
  *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_BLOCK_ERR      TCP send queue to the peer is full, retry later
  */
 TRDP_ERR_T tlm_notify (
     TRDP_APP_SESSION_T      appHandle,
@@ -2589,7 +5203,7 @@ TRDP_ERR_T tlm_notify (
  *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
  *  @param[in]      destIpAddr          where to send the packet to
  *  @param[in]      pktFlags            OPTION:
- *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_MD_COLLECT
  *  @param[in]      numReplies          number of expected replies, 0 if unknown
  *  @param[in]      replyTimeout        timeout for reply
  *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
@@ -2602,6 +5216,7 @@ TRDP_ERR_T tlm_notify (
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        out of memory
  *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_BLOCK_ERR      TCP send queue to the peer is full, retry later
  */
 TRDP_ERR_T tlm_request (
     TRDP_APP_SESSION_T      appHandle,
@@ -2782,6 +5397,8 @@ EXT_DECL TRDP_ERR_T  tlm_addListener (
                 {
                     vos_strncpy(pNewElement->destURI, destURI, TRDP_MAX_URI_USER_LEN);
                 }
+                pNewElement->srcUriHash     = trdp_uriHash(pNewElement->srcURI);
+                pNewElement->destUriHash    = trdp_uriHash(pNewElement->destURI);
                 if (vos_isMulticast(mcDestIpAddr))
                 {
                     pNewElement->addr.mcGroup   = mcDestIpAddr;     /* Set multicast group address */
@@ -2826,8 +5443,7 @@ EXT_DECL TRDP_ERR_T  tlm_addListener (
                 else
                 {
                     /* Insert into list */
-                    pNewElement->pNext          = appHandle->pMDListenQueue;
-                    appHandle->pMDListenQueue   = pNewElement;
+                    trdp_MDlistenerIns(appHandle, pNewElement);
 
                     /* Statistics */
                     if ((pNewElement->pktFlags & TRDP_FLAGS_TCP) != 0)
@@ -2882,9 +5498,7 @@ TRDP_ERR_T tlm_delListener (
     TRDP_LIS_T          listenHandle)
 {
     TRDP_ERR_T      errv        = TRDP_NO_ERR;
-    MD_LIS_ELE_T    *iterLis    = NULL;
     MD_LIS_ELE_T    *pDelete    = (MD_LIS_ELE_T *) listenHandle;
-    BOOL8           dequeued    = FALSE;
 
     if (!trdp_isValidSession(appHandle))
     {
@@ -2901,26 +5515,7 @@ TRDP_ERR_T tlm_delListener (
     /* mutex protected */
     if (NULL != pDelete)
     {
-        /* handle removal of first element */
-        if (pDelete == appHandle->pMDListenQueue)
-        {
-            appHandle->pMDListenQueue = pDelete->pNext;
-            dequeued = TRUE;
-        }
-        else
-        {
-            for (iterLis = appHandle->pMDListenQueue; iterLis != NULL; iterLis = iterLis->pNext)
-            {
-                if (iterLis->pNext == pDelete)
-                {
-                    iterLis->pNext  = pDelete->pNext;
-                    dequeued        = TRUE;
-                    break;
-                }
-            }
-        }
-
-        if (TRUE == dequeued)
+        if (TRUE == trdp_MDlistenerDel(appHandle, pDelete))
         {
             /* cleanup instance */
             if (pDelete->socketIdx != -1)
@@ -3072,6 +5667,7 @@ EXT_DECL TRDP_ERR_T tlm_readdListener (
  *  @retval         TRDP_MEM_ERR        Out of memory
  *  @retval         TRDP_NO_SESSION_ERR no such session
  *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_BLOCK_ERR      TCP send queue to the peer is full, retry later
  */
 TRDP_ERR_T tlm_reply (
     TRDP_APP_SESSION_T      appHandle,
@@ -3121,6 +5717,7 @@ TRDP_ERR_T tlm_reply (
  *  @retval         TRDP_MEM_ERR        out of memory
  *  @retval         TRDP_NO_SESSION_ERR no such session
  *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_BLOCK_ERR      TCP send queue to the peer is full, retry later
  */
 TRDP_ERR_T tlm_replyQuery (
     TRDP_APP_SESSION_T      appHandle,
@@ -60,6 +60,9 @@
 #include "trdp_if.h"
 #include "trdp_utils.h"
 #include "trdp_mdcom.h"
+#include "trdp_stats.h"
+#include "trdp_trace.h"
+#include "trdp_rec.h"
 
 
 /***********************************************************************************************************************
@@ -87,10 +90,14 @@ static const TRDP_MD_INFO_T cTrdp_md_info_default;
 static void         trdp_mdUpdatePacket (MD_ELE_T *pElement);
 static void         trdp_mdFillStateElement (const TRDP_MSG_T   msgType,
                                              MD_ELE_T           *pMdElement);
-static void         trdp_mdManageSessionId (TRDP_UUID_T pSessionId,
+static void         trdp_mdNewSessionId (TRDP_SESSION_PT    appHandle,
+                                         TRDP_UUID_T        pSessionId);
+static void         trdp_mdManageSessionId (TRDP_SESSION_PT appHandle,
+                                            TRDP_UUID_T pSessionId,
                                             MD_ELE_T    *pMdElement);
 
-static TRDP_ERR_T   trdp_mdLookupElement (MD_ELE_T                  *pinitialMdElement,
+static TRDP_ERR_T   trdp_mdLookupElement (TRDP_SESSION_PT           appHandle,
+                                          MD_ELE_T                  * *ppQueue,
                                           const TRDP_MD_ELE_ST_T    elementState,
                                           const TRDP_UUID_T         pSessionId,
                                           MD_ELE_T                  * *pretrievedMdElement);
@@ -98,6 +105,12 @@ static TRDP_ERR_T   trdp_mdLookupElement (MD_ELE_T                  *pinitialMdE
 static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
                                    const TRDP_SESSION_PT    appHandle,
                                    const TRDP_ERR_T         resultCode);
+static void trdp_mdCollectReply (MD_ELE_T *pElement);
+static MD_PACKET_T  *trdp_mdAllocPacket (TRDP_SESSION_PT    appHandle,
+                                         MD_ELE_T           *pElement,
+                                         UINT32             size);
+static void         trdp_mdReleasePacket (TRDP_SESSION_PT   appHandle,
+                                          MD_ELE_T          *pElement);
 static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T          *pElement,
                                           TRDP_SESSION_PT   appHandle,
                                           TRDP_ERR_T        *pResult);
@@ -120,9 +133,46 @@ static TRDP_ERR_T   trdp_mdCheck (TRDP_SESSION_PT   appHandle,
                                   MD_HEADER_T       *pPacket,
                                   UINT32            packetSize,
                                   BOOL8             checkHeaderOnly);
+static MD_LIS_ELE_T *trdp_mdFindListener (TRDP_SESSION_PT  appHandle,
+                                          const MD_HEADER_T *pH,
+                                          BOOL8             isTCP,
+                                          TRDP_IP_ADDR_T    srcIpAddr,
+                                          TRDP_IP_ADDR_T    destIpAddr);
+#if TRDP_MD_STREAM_CHUNK_SIZE > 0
+static BOOL8        trdp_mdStreamStart (TRDP_SESSION_PT     appHandle,
+                                        UINT32              socketIndex,
+                                        MD_HEADER_T         *pH);
+static void         trdp_mdStreamAbort (TRDP_SESSION_PT     appHandle,
+                                        UINT32              socketIndex,
+                                        TRDP_ERR_T          resultCode);
+static TRDP_ERR_T   trdp_mdStreamRecv (TRDP_SESSION_PT      appHandle,
+                                       UINT32               socketIndex);
+#endif
+static BOOL8        trdp_mdSendInPlace (TRDP_SESSION_PT     appHandle,
+                                        const MD_ELE_T      *pElement,
+                                        const UINT8         *pData);
+static BOOL8        trdp_mdTxThrottled (TRDP_SESSION_PT     appHandle,
+                                        const MD_ELE_T      *pElement);
+static void         trdp_mdTxQueue (TRDP_SESSION_PT         appHandle,
+                                    MD_ELE_T                *pElement);
+static void         trdp_mdTxDequeue (TRDP_SESSION_PT       appHandle,
+                                      MD_ELE_T              *pElement);
+#if TRDP_MD_TCP_CORK
+static UINT32       trdp_mdCork (TRDP_SESSION_PT            appHandle);
+static void         trdp_mdUncork (TRDP_SESSION_PT          appHandle);
+#endif
+#if TRDP_MD_UDP_SEG_SIZE > 0
+static MD_UDP_SEG_T *trdp_mdUdpSegGet (TRDP_SESSION_PT      appHandle);
+static void         trdp_mdSendUdpSeg (TRDP_SESSION_PT      appHandle);
+static TRDP_ERR_T   trdp_mdRecvUdpSeg (TRDP_SESSION_PT      appHandle,
+                                       SOCKET               mdSock,
+                                       MD_ELE_T             *pElement);
+#endif
 static TRDP_ERR_T   trdp_mdSendPacket (SOCKET   mdSock,
                                        UINT16   port,
                                        MD_ELE_T *pElement);
+static TRDP_ERR_T   trdp_mdRetransmit (TRDP_SESSION_PT   appHandle,
+                                       MD_ELE_T         *pElement);
 static TRDP_ERR_T   trdp_mdRecvTCPPacket (TRDP_SESSION_PT   appHandle,
                                           SOCKET            mdSock,
                                           MD_ELE_T          *pElement);
@@ -157,6 +207,10 @@ static TRDP_ERR_T   trdp_mdConnectSocket (TRDP_APP_SESSION_T        appHandle,
                                           TRDP_IP_ADDR_T            destIpAddr,
                                           BOOL8                     newSession,
                                           MD_ELE_T                  *pSenderElement);
+#if TRDP_MD_TIMEOUT_SCHEDULER
+static TRDP_ERR_T   trdp_mdSchedReserve (TRDP_SESSION_PT    appHandle,
+                                         UINT32             count);
+#endif
 
 /**********************************************************************************************************************/
 /** Set the statEle property to next state
@@ -198,17 +252,68 @@ static void trdp_mdFillStateElement (const TRDP_MSG_T msgType, MD_ELE_T *pMdElem
 }
 
 
+/**********************************************************************************************************************/
+/** Create a new session ID
+ *  The IDs of a session share a random prefix, the second half counts up. The result is an RFC 4122 version 4 UUID.
+ *  The prefix is derived once from vos_getUuid() (time and MAC address) and the session handle, so no clock or
+ *  socket call is needed per request.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[out]     pSessionId          new session ID
+ */
+static void trdp_mdNewSessionId (TRDP_SESSION_PT    appHandle,
+                                 TRDP_UUID_T        pSessionId)
+{
+#if TRDP_MD_FAST_UUID
+    UINT64  count;
+    UINT32  i;
+
+    if (appHandle->mdUuidCount == 0u)
+    {
+        VOS_UUID_T  seed;
+        UINT64      mix = (UINT64) (uintptr_t) appHandle;
+
+        vos_getUuid(seed);
+        /* splitmix64 over the time based UUID and the session handle */
+        for (i = 0u; i < TRDP_SESS_ID_SIZE; i++)
+        {
+            mix += 0x9E3779B97F4A7C15ull + seed[i];
+            mix = (mix ^ (mix >> 30u)) * 0xBF58476D1CE4E5B9ull;
+            mix = (mix ^ (mix >> 27u)) * 0x94D049BB133111EBull;
+            mix ^= mix >> 31u;
+        }
+        for (i = 0u; i < 8u; i++)
+        {
+            appHandle->mdUuidPrefix[i] = (UINT8) (mix >> (8u * i));
+        }
+        appHandle->mdUuidPrefix[6] = (UINT8) ((appHandle->mdUuidPrefix[6] & 0x0Fu) | 0x40u);   /* version 4 */
+    }
+    count = appHandle->mdUuidCount++;
+
+    memcpy(pSessionId, appHandle->mdUuidPrefix, 8u);
+    for (i = 0u; i < 8u; i++)
+    {
+        pSessionId[15u - i] = (UINT8) (count >> (8u * i));
+    }
+    pSessionId[8] = (UINT8) ((pSessionId[8] & 0x3Fu) | 0x80u);                                  /* RFC 4122 variant */
+#else
+    (void) appHandle;
+    vos_getUuid(pSessionId);
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Create session ID for a given MD_ELE_T
  *  This function will create a new UUID if the given MD_ELE_T contains
  *  an empty session ID.
  *
+ *  @param[in]      appHandle           session pointer
  *  @param[in]      pSessionId          Type of MD message
  *  @param[out]     pMdElement          MD element taken from queue or newly allocated
  *
  *  @retval         none
  */
-static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement)
+static void trdp_mdManageSessionId (TRDP_SESSION_PT appHandle, TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement)
 {
     if (memcmp(pMdElement->sessionID, cEmptySession, TRDP_SESS_ID_SIZE) != 0)
     {
@@ -223,7 +328,7 @@ static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement
     {
         /* create session ID */
         VOS_UUID_T uuid;
-        vos_getUuid(uuid);
+        trdp_mdNewSessionId(appHandle, uuid);
 
         /* return session id to caller if required */
         if (NULL != pSessionId)
@@ -243,9 +348,10 @@ static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement
 
 /**********************************************************************************************************************/
 /** Look up an element identified by its elementState and pSessionId
- *  within a list starting with pinitialMdElement.*
+ *  within the send or receive queue of the session.
  *
- *  @param[in]      pinitialMdElement   start element within a list of element
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      ppQueue             &appHandle->pMDSndQueue or &appHandle->pMDRcvQueue
  *  @param[in]      elementState        element state to look for
  *  @param[in]      pSessionId          element session to look for
  *  @param[out]     pretrievedMdElement pointer to looked up element
@@ -253,23 +359,24 @@ static void trdp_mdManageSessionId (TRDP_UUID_T pSessionId, MD_ELE_T *pMdElement
  *  @retval         TRDP_NO_ERR           no error
  *  @retval         TRDP_NOLIST_ERR       no match found error
  */
-static TRDP_ERR_T trdp_mdLookupElement (MD_ELE_T                *pinitialMdElement,
+static TRDP_ERR_T trdp_mdLookupElement (TRDP_SESSION_PT         appHandle,
+                                        MD_ELE_T                * *ppQueue,
                                         const TRDP_MD_ELE_ST_T  elementState,
                                         const TRDP_UUID_T       pSessionId,
                                         MD_ELE_T                * *pretrievedMdElement)
 {
     TRDP_ERR_T errv = TRDP_NOLIST_ERR; /* init error code indicating no matching MD_ELE_T in list */
-    if ((pinitialMdElement != NULL)
+    if ((*ppQueue != NULL)
         &&
         (pSessionId != NULL))
     {
         MD_ELE_T *iterMD;
-        /* start iteration through receive or send list */
-        for (iterMD = pinitialMdElement; iterMD != NULL; iterMD = iterMD->pNext)
+        /* iterate through the sessions of the receive or send list with this session ID */
+        for (iterMD = trdp_MDqueueFindSession(appHandle, ppQueue, pSessionId, NULL);
+             iterMD != NULL;
+             iterMD = trdp_MDqueueFindSession(appHandle, ppQueue, pSessionId, iterMD))
         {
-            if ((elementState == iterMD->stateEle)
-                &&
-                (0 == memcmp(iterMD->sessionID, pSessionId, TRDP_SESS_ID_SIZE)))
+            if (elementState == iterMD->stateEle)
             {
                 *pretrievedMdElement = iterMD;
                 errv = TRDP_NO_ERR;
@@ -300,12 +407,21 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
 {
     INT32 replyStatus = 0;
     TRDP_MD_INFO_T theMessage = cTrdp_md_info_default;
+    UINT8   *pCollected     = NULL;
+    UINT32  collectedSize   = 0u;
 
     if (pMdItem == NULL)
     {
         return;
     }
 
+    /* the replies collected for the request are handed over as one array */
+    if ((pMdItem->pCollect != NULL) && (pMdItem->pCollect->numReplies > 0u))
+    {
+        pCollected      = (UINT8 *) pMdItem->pCollect->pReplies;
+        collectedSize   = pMdItem->pCollect->numReplies * (UINT32) sizeof(TRDP_MD_REPLY_T);
+    }
+
     if (pMdItem->pPacket != NULL)
     {
         replyStatus = (INT32) vos_ntohl((UINT32)pMdItem->pPacket->frameHead.replyStatus);
@@ -352,12 +468,29 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         theMessage.etbTopoCnt   = vos_ntohl(pMdItem->pPacket->frameHead.etbTopoCnt);
         theMessage.opTrnTopoCnt = vos_ntohl(pMdItem->pPacket->frameHead.opTrnTopoCnt);
         theMessage.srcIpAddr    = pMdItem->addr.srcIpAddr;
-        pMdItem->pfCbFunction(
-            appHandle->mdDefault.pRefCon,
-            appHandle,
-            &theMessage,
-            (UINT8 *)(pMdItem->pPacket->data),
-            vos_ntohl(pMdItem->pPacket->frameHead.datasetLength));
+        /* a send complete callback returns the user buffer sent in place */
+        if (pCollected != NULL)
+        {
+            TRDP_TRACE2(md_callback, theMessage.comId, resultCode);
+            pMdItem->pfCbFunction(appHandle->mdDefault.pRefCon, appHandle, &theMessage, pCollected, collectedSize);
+            TRDP_TRACE1(md_callback_done, theMessage.comId);
+        }
+        /* the data of a received message is copied for the callback dispatcher, user buffers and collected
+           replies are owned by the stack or the application and handed over in place */
+        else if ((pMdItem->pUserData != NULL) ||
+                 (appHandle->pCbDispatch == NULL) ||
+                 (trdp_cbDispatchMd(appHandle, pMdItem->pfCbFunction, &theMessage, pMdItem->pPacket->data,
+                                    vos_ntohl(pMdItem->pPacket->frameHead.datasetLength)) != TRDP_NO_ERR))
+        {
+            TRDP_TRACE2(md_callback, theMessage.comId, resultCode);
+            pMdItem->pfCbFunction(
+                appHandle->mdDefault.pRefCon,
+                appHandle,
+                &theMessage,
+                (pMdItem->pUserData != NULL) ? (UINT8 *)pMdItem->pUserData : (UINT8 *)(pMdItem->pPacket->data),
+                vos_ntohl(pMdItem->pPacket->frameHead.datasetLength));
+            TRDP_TRACE1(md_callback_done, theMessage.comId);
+        }
     }
     else
     {
@@ -365,14 +498,106 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         theMessage.etbTopoCnt   = pMdItem->addr.etbTopoCnt;
         theMessage.opTrnTopoCnt = pMdItem->addr.opTrnTopoCnt;
         theMessage.srcIpAddr    = 0u;
-        /*in case of any detected turbulence return a zero buffer*/
-        pMdItem->pfCbFunction(
-            appHandle->mdDefault.pRefCon,
-            appHandle,
-            &theMessage,
-            (UINT8 *)NULL,
-            0u);
+        /*in case of any detected turbulence return a zero buffer, or the replies collected until then */
+        if ((pCollected != NULL) ||
+            (appHandle->pCbDispatch == NULL) ||
+            (trdp_cbDispatchMd(appHandle, pMdItem->pfCbFunction, &theMessage, NULL, 0u) != TRDP_NO_ERR))
+        {
+            TRDP_TRACE2(md_callback, theMessage.comId, resultCode);
+            pMdItem->pfCbFunction(
+                appHandle->mdDefault.pRefCon,
+                appHandle,
+                &theMessage,
+                pCollected,
+                collectedSize);
+            TRDP_TRACE1(md_callback_done, theMessage.comId);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Add a received reply to the replies collected for a request (TRDP_FLAGS_MD_COLLECT)
+ *  The buffers grow by doubling, a reply which does not fit any more into memory is dropped.
+ *
+ *  @param[in,out]  pElement        caller session, pPacket holds the received reply
+ */
+static void trdp_mdCollectReply (MD_ELE_T *pElement)
+{
+    MD_COLLECT_T    *pCollect;
+    TRDP_MD_REPLY_T *pReply;
+    UINT32          i;
+    INT32           replyStatus;
+
+    if (pElement->pCollect == NULL)
+    {
+        pElement->pCollect = (MD_COLLECT_T *) vos_memAlloc(sizeof(MD_COLLECT_T));
+        if (pElement->pCollect == NULL)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Reply dropped, out of memory for collected replies\n");
+            return;
+        }
+    }
+    pCollect = pElement->pCollect;
+
+    if (pCollect->numReplies == pCollect->maxReplies)
+    {
+        UINT32          maxReplies  = (pCollect->maxReplies == 0u) ? 16u : 2u * pCollect->maxReplies;
+        TRDP_MD_REPLY_T *pReplies   = (TRDP_MD_REPLY_T *) vos_memAlloc(maxReplies * sizeof(TRDP_MD_REPLY_T));
+
+        if (pReplies == NULL)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Reply dropped, out of memory for collected replies\n");
+            return;
+        }
+        if (pCollect->pReplies != NULL)
+        {
+            memcpy(pReplies, pCollect->pReplies, pCollect->numReplies * sizeof(TRDP_MD_REPLY_T));
+            vos_memFree(pCollect->pReplies);
+        }
+        pCollect->pReplies      = pReplies;
+        pCollect->maxReplies    = maxReplies;
+    }
+
+    if (pCollect->dataSize + pElement->dataSize > pCollect->maxDataSize)
+    {
+        UINT32  maxDataSize = (pCollect->maxDataSize == 0u) ? 1024u : 2u * pCollect->maxDataSize;
+        UINT8   *pData;
+
+        while (maxDataSize < pCollect->dataSize + pElement->dataSize)
+        {
+            maxDataSize *= 2u;
+        }
+        pData = (UINT8 *) vos_memAlloc(maxDataSize);
+        if (pData == NULL)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Reply dropped, out of memory for collected replies\n");
+            return;
+        }
+        if (pCollect->pData != NULL)
+        {
+            memcpy(pData, pCollect->pData, pCollect->dataSize);
+            /* move the data pointers of the replies collected so far into the new buffer */
+            for (i = 0u; i < pCollect->numReplies; i++)
+            {
+                pCollect->pReplies[i].pData = pData + (pCollect->pReplies[i].pData - pCollect->pData);
+            }
+            vos_memFree(pCollect->pData);
+        }
+        pCollect->pData         = pData;
+        pCollect->maxDataSize   = maxDataSize;
     }
+
+    replyStatus = (INT32) vos_ntohl((UINT32)pElement->pPacket->frameHead.replyStatus);
+
+    pReply = &pCollect->pReplies[pCollect->numReplies++];
+    pReply->srcIpAddr   = pElement->addr.srcIpAddr;
+    pReply->seqCount    = vos_ntohl(pElement->pPacket->frameHead.sequenceCounter);
+    pReply->userStatus  = (replyStatus >= 0) ? (UINT16) replyStatus : 0u;
+    pReply->replyStatus = (replyStatus >= 0) ? TRDP_REPLY_OK : (TRDP_REPLY_STATUS_T) replyStatus;
+    pReply->pData       = pCollect->pData + pCollect->dataSize;
+    pReply->dataSize    = pElement->dataSize;
+    memcpy(pCollect->pData + pCollect->dataSize, pElement->pPacket->data, pElement->dataSize);
+    pCollect->dataSize  += pElement->dataSize;
 }
 
 /**********************************************************************************************************************/
@@ -387,7 +612,8 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
  */
 static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT appHandle, TRDP_ERR_T *pResult)
 {
-    BOOL8 hasTimedOut = FALSE;
+    BOOL8   hasTimedOut = FALSE;
+    BOOL8   retransmit  = FALSE;
     /* timeout on queue ? */
     switch ( pElement->stateEle )
     {
@@ -418,7 +644,7 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                hasTimedOut          = TRUE;
                *pResult = TRDP_REPLYTO_ERR;
 
-               appHandle->stats.tcpMd.numReplyTimeout++;
+               TRDP_STATS_INC(appHandle, tcpMd.numReplyTimeout);
            }
            else
            {
@@ -440,22 +666,23 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                        (pElement->pPacket != NULL))
                    {
                        vos_printLogStr(VOS_LOG_INFO, "UDP MD start retransmission\n");
-                       /* Retransmission will occur upon resetting the state of  */
-                       /* this MD_ELE_T item to TRDP_ST_TX_REQUEST_ARM, for ref- */
-                       /* erence check the trdp_mdSend function                  */
-                       pElement->stateEle = TRDP_ST_TX_REQUEST_ARM;
                        /* Increment the retry counter */
                        pElement->numRetries++;
                        /* Increment sequence counter in network order of course */
                        pElement->pPacket->frameHead.sequenceCounter =
                            vos_htonl((vos_ntohl(pElement->pPacket->frameHead.sequenceCounter) + 1));
-                       /* Store new sequence counter within the management info */
+                       /* update the frame header CRC also, the prepared frame is sent as is */
+                       trdp_mdUpdatePacket(pElement);
                        /* Set new time out value */
                        vos_addTime(&pElement->timeToGo, &pElement->interval);
-                       /* update the frame header CRC also */
-                       trdp_mdUpdatePacket(pElement);
-                       /* ready to proceed - will be handled by trdp_mdSend run- */
-                       /* ning within its own loop triggered cyclically.         */
+                       trdp_mdSchedUpdate(appHandle, pElement);
+                       /* Send the frame now instead of one cycle later. If that fails, the retransmission */
+                       /* is left to trdp_mdSend by resetting the state to TRDP_ST_TX_REQUEST_ARM          */
+                       if (trdp_mdRetransmit(appHandle, pElement) != TRDP_NO_ERR)
+                       {
+                           pElement->stateEle = TRDP_ST_TX_REQUEST_ARM;
+                       }
+                       retransmit  = TRUE;
                        hasTimedOut = FALSE;
                    }
                    else
@@ -466,11 +693,11 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                        *pResult = TRDP_REPLYTO_ERR;
                    }
                    /* Statistics */
-                   appHandle->stats.udpMd.numReplyTimeout++;
+                   TRDP_STATS_INC(appHandle, udpMd.numReplyTimeout);
                }
 
                /* Manage send Confirm if no repetition */
-               if ( pElement->stateEle != TRDP_ST_TX_REQUEST_ARM )
+               if (retransmit == FALSE)
                {
                    if ((pElement->numRepliesQuery == 0u)
                        ||
@@ -501,11 +728,11 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
            /* Statistics */
            if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0 )
            {
-               appHandle->stats.tcpMd.numConfirmTimeout++;
+               TRDP_STATS_INC(appHandle, tcpMd.numConfirmTimeout);
            }
            else
            {
-               appHandle->stats.udpMd.numConfirmTimeout++;
+               TRDP_STATS_INC(appHandle, udpMd.numConfirmTimeout);
            }
            break;
        case TRDP_ST_TX_REPLY_RECEIVED:
@@ -552,12 +779,12 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
 static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEADER_T *pMdItemHeader)
 {
     MD_ELE_T    *iterMD         = NULL;
-    MD_ELE_T    *startElement   = NULL;
+    MD_ELE_T    * *ppQueue      = NULL;
     /* determine the queue to look for the recevd pMdItemHeader */
     if ((vos_ntohs(pMdItemHeader->msgType) == TRDP_MSG_MC)
         )
     {
-        startElement = appHandle->pMDRcvQueue;
+        ppQueue = &appHandle->pMDRcvQueue;
     }
     else
     {
@@ -567,15 +794,17 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
             ||
             (vos_ntohs(pMdItemHeader->msgType) == TRDP_MSG_ME))
         {
-            startElement = appHandle->pMDSndQueue;
+            ppQueue = &appHandle->pMDSndQueue;
         }
-        /* having no else here will render the startElement to be NULL  */
+        /* having no else here will render the ppQueue to be NULL       */
         /* this will sufficiently skip the for loop below, getting NULL */
         /* as function return value - which also will get correctly     */
         /* handled by trdp_mdRecv                                       */
     }
-    /* iterate through the receive queue */
-    for (iterMD = startElement; iterMD != NULL; iterMD = iterMD->pNext)
+    /* iterate through the sessions of the queue with the received session ID */
+    for (iterMD = trdp_MDqueueFindSession(appHandle, ppQueue, pMdItemHeader->sessionID, NULL);
+         iterMD != NULL;
+         iterMD = trdp_MDqueueFindSession(appHandle, ppQueue, pMdItemHeader->sessionID, iterMD))
     {
         /* accept only local communication or matching topo counters */
         if (((pMdItemHeader->etbTopoCnt != 0u) || (pMdItemHeader->opTrnTopoCnt != 0u))
@@ -591,16 +820,15 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
         if (0 == memcmp(iterMD->pPacket->frameHead.sessionID, pMdItemHeader->sessionID, TRDP_SESS_ID_SIZE))
         {
             /* throw away old packet data  */
-            if (NULL != iterMD->pPacket)
-            {
-                vos_memFree(iterMD->pPacket);
-            }
+            trdp_mdReleasePacket(appHandle, iterMD);
             /* and get the newly received data  */
             iterMD->pPacket     = appHandle->pMDRcvEle->pPacket;
+            iterMD->poolPacket  = appHandle->pMDRcvEle->poolPacket;
             iterMD->dataSize    = vos_ntohl(pMdItemHeader->datasetLength);
             iterMD->grossSize   = appHandle->pMDRcvEle->grossSize;
 
-            appHandle->pMDRcvEle->pPacket = NULL;
+            appHandle->pMDRcvEle->pPacket       = NULL;
+            appHandle->pMDRcvEle->poolPacket    = FALSE;
 
             /* Table A.26 states that the comID for an Me message is zero. This     */
             /* induces the need to lookup the caller comID by using the received    */
@@ -629,6 +857,20 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                 vos_strncpy(iterMD->srcURI, (CHAR8 *) pMdItemHeader->sourceURI, TRDP_MAX_URI_USER_LEN);
                 vos_strncpy(iterMD->destURI, (CHAR8 *) pMdItemHeader->destinationURI, TRDP_MAX_URI_USER_LEN);
 
+#if TRDP_TIMING_STATS
+                if ((appHandle->option & TRDP_OPTION_TIMING_STATS) && timerisset(&iterMD->sendTime))
+                {
+                    TRDP_TIME_T now;
+
+                    vos_getTime(&now);
+                    trdp_timingAdd(appHandle, TRDP_TIMING_MD_ROUND_TRIP, &iterMD->sendTime, &now);
+                    if (iterMD->numRetries > 0u)
+                    {
+                        trdp_timingAdd(appHandle, TRDP_TIMING_MD_RETRY, &iterMD->firstSendTime, &now);
+                    }
+                }
+#endif
+
                 if (vos_ntohs(pMdItemHeader->msgType) == TRDP_MSG_MQ)
                 {
                     /* dedicated MQ handling */
@@ -645,6 +887,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
                     iterMD->interval.tv_sec     = vos_ntohl(pMdItemHeader->replyTimeout) / 1000000u;
                     iterMD->interval.tv_usec    = vos_ntohl(pMdItemHeader->replyTimeout) % 1000000;
                     vos_addTime(&iterMD->timeToGo, &iterMD->interval);
+                    trdp_mdSchedUpdate(appHandle, iterMD);
                     break; /* exit for loop */
 
                 }
@@ -711,15 +954,17 @@ static void trdp_mdCloseSessions (
     {
         if (TRUE == iterMD->morituri)
         {
+            trdp_mdTxDequeue(appHandle, iterMD);
             trdp_releaseSocket(appHandle->iface, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
                                FALSE, VOS_INADDR_ANY);
-            trdp_MDqueueDelElement(&appHandle->pMDSndQueue, iterMD);
+            trdp_mdSchedRemove(appHandle, iterMD);
+            trdp_MDqueueDelSession(appHandle, &appHandle->pMDSndQueue, iterMD);
             vos_printLog(VOS_LOG_INFO, "Freeing %s MD caller session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                          iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
                          iterMD->sessionID[0], iterMD->sessionID[1], iterMD->sessionID[2], iterMD->sessionID[3],
                          iterMD->sessionID[4], iterMD->sessionID[5], iterMD->sessionID[6], iterMD->sessionID[7])
 
-            trdp_mdFreeSession(iterMD);
+            trdp_mdFreeSession(appHandle, iterMD);
             iterMD = appHandle->pMDSndQueue;
         }
         else
@@ -734,17 +979,19 @@ static void trdp_mdCloseSessions (
     {
         if (TRUE == iterMD->morituri)
         {
+            trdp_mdTxDequeue(appHandle, iterMD);
             if (0 != (iterMD->pktFlags & TRDP_FLAGS_TCP))
             {
                 trdp_releaseSocket(appHandle->iface, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
                                    FALSE, VOS_INADDR_ANY);
             }
-            trdp_MDqueueDelElement(&appHandle->pMDRcvQueue, iterMD);
+            trdp_mdSchedRemove(appHandle, iterMD);
+            trdp_MDqueueDelSession(appHandle, &appHandle->pMDRcvQueue, iterMD);
             vos_printLog(VOS_LOG_INFO, "Freeing MD %s replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                          iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
                          iterMD->sessionID[0], iterMD->sessionID[1], iterMD->sessionID[2], iterMD->sessionID[3],
                          iterMD->sessionID[4], iterMD->sessionID[5], iterMD->sessionID[6], iterMD->sessionID[7])
-            trdp_mdFreeSession(iterMD);
+            trdp_mdFreeSession(appHandle, iterMD);
             iterMD = appHandle->pMDRcvQueue;
         }
         else
@@ -761,7 +1008,11 @@ static void trdp_mdCloseSessions (
                      "Replacing the old socket by the new one (New Socket: %d, Index: %d)\n",
                      (int) newSocket, (int) socketIndex);
 
+#if TRDP_MD_STREAM_CHUNK_SIZE > 0
+        trdp_mdStreamAbort(appHandle, (UINT32) socketIndex, TRDP_NOCONN_ERR);
+#endif
         appHandle->iface[socketIndex].sock = newSocket;
+        appHandle->iface[socketIndex].polled = FALSE;
         appHandle->iface[socketIndex].rcvMostly = TRUE;
         appHandle->iface[socketIndex].tcpParams.notSend     = FALSE;
         appHandle->iface[socketIndex].type                  = TRDP_SOCK_MD_TCP;
@@ -770,6 +1021,7 @@ static void trdp_mdCloseSessions (
         appHandle->iface[socketIndex].tcpParams.addFileDesc = TRUE;
         appHandle->iface[socketIndex].tcpParams.connectionTimeout.tv_sec    = 0u;
         appHandle->iface[socketIndex].tcpParams.connectionTimeout.tv_usec   = 0;
+        appHandle->iface[socketIndex].tcpParams.connected                   = FALSE;
     }
 }
 
@@ -954,151 +1206,628 @@ static void    trdp_mdUpdatePacket (MD_ELE_T *pElement)
 }
 
 /**********************************************************************************************************************/
-/** Send MD packet
+/** Check if the user data of an MD message to be sent can be sent in place (TRDP_FLAGS_TCP_NOCOPY)
+ *  Marshalled data has to be converted into the packet buffer and is always copied.
  *
- *  @param[in]      mdSock          socket descriptor
- *  @param[in]      port            port on which to send
- *  @param[in]      pElement        pointer to element to be sent
- *  @retval         != NULL         error
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        pointer to element to be sent (pktFlags and dataSize set)
+ *  @param[in]      pData           pointer to user data
+ *
+ *  @retval         TRUE            send pData in place, allocate the header only
+ *  @retval         FALSE           copy pData into the packet
  */
-static TRDP_ERR_T  trdp_mdSendPacket (SOCKET    mdSock,
-                                      UINT16    port,
-                                      MD_ELE_T  *pElement)
+static BOOL8 trdp_mdSendInPlace (TRDP_SESSION_PT    appHandle,
+                                 const MD_ELE_T     *pElement,
+                                 const UINT8        *pData)
 {
-    VOS_ERR_T   err         = VOS_NO_ERR;
-    UINT32      tmpSndSize  = 0u;
+    return ((pData != NULL) && (pElement->dataSize > 0u) &&
+            ((pElement->pktFlags & (TRDP_FLAGS_TCP | TRDP_FLAGS_TCP_NOCOPY)) ==
+             (TRDP_FLAGS_TCP | TRDP_FLAGS_TCP_NOCOPY)) &&
+            !(((pElement->pktFlags & TRDP_FLAGS_MARSHALL) != 0) && (appHandle->marshall.pfCbMarshall != NULL)));
+}
 
-    if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
+/**********************************************************************************************************************/
+/** Check if the send queue of the TCP connection of an MD element is full
+ *  Once the queue exceeded TRDP_MD_TCP_SNDQ_HIGH, new messages are refused until it drained to TRDP_MD_TCP_SNDQ_LOW.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        pointer to element to be sent (pktFlags and socketIdx set)
+ *
+ *  @retval         TRUE            refuse the message with TRDP_BLOCK_ERR
+ *  @retval         FALSE           queue the message
+ */
+static BOOL8 trdp_mdTxThrottled (TRDP_SESSION_PT    appHandle,
+                                 const MD_ELE_T     *pElement)
+{
+    if (((pElement->pktFlags & TRDP_FLAGS_TCP) != 0) &&
+        (pElement->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
+        (appHandle->iface[pElement->socketIdx].tcpParams.throttled == TRUE))
     {
-        tmpSndSize = pElement->sendSize;
+        appHandle->tcpConnStats.numThrottled++;
+        return TRUE;
+    }
+    return FALSE;
+}
 
-        pElement->sendSize = pElement->grossSize - tmpSndSize;
+/**********************************************************************************************************************/
+/** Account a TCP MD message waiting to be sent in the send queue of its connection
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        pointer to element to be sent
+ */
+static void trdp_mdTxQueue (TRDP_SESSION_PT appHandle,
+                            MD_ELE_T        *pElement)
+{
+    TRDP_SOCKET_TCP_T *pTcp;
 
-        err = vos_sockSendTCP(mdSock, ((UINT8 *)&pElement->pPacket->frameHead) + tmpSndSize, &pElement->sendSize);
-        pElement->sendSize = tmpSndSize + pElement->sendSize;
+    if (((pElement->pktFlags & TRDP_FLAGS_TCP) == 0) ||
+        (pElement->socketIdx == TRDP_INVALID_SOCKET_INDEX) ||
+        (pElement->queuedSize != 0u))
+    {
+        return;
     }
-    else
+    pTcp = &appHandle->iface[pElement->socketIdx].tcpParams;
+    pElement->queuedSize    = pElement->grossSize;
+    pTcp->queuedBytes       += pElement->queuedSize;
+    if ((TRDP_MD_TCP_SNDQ_HIGH > 0u) && (pTcp->queuedBytes >= TRDP_MD_TCP_SNDQ_HIGH) && (pTcp->throttled == FALSE))
     {
-        pElement->sendSize = pElement->grossSize;
-
-        err = vos_sockSendUDP(mdSock,
-                              (UINT8 *)&pElement->pPacket->frameHead,
-                              &pElement->sendSize,
-                              pElement->addr.destIpAddr,
-                              port);
+        vos_printLog(VOS_LOG_INFO, "TCP send queue of socket %d full (%u bytes)\n",
+                     (int) appHandle->iface[pElement->socketIdx].sock, (unsigned int) pTcp->queuedBytes);
+        pTcp->throttled = TRUE;
     }
+}
 
-    if (err != VOS_NO_ERR)
-    {
-        vos_printLog(VOS_LOG_ERROR, "vos_sockSend%s error (Err: %d, Socket: %d, Port: %u)\n",
-                     (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", err, (int) mdSock, (unsigned int) port);
+/**********************************************************************************************************************/
+/** Remove a sent or freed TCP MD message from the send queue of its connection
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        pointer to element sent or about to be freed
+ */
+static void trdp_mdTxDequeue (TRDP_SESSION_PT   appHandle,
+                              MD_ELE_T          *pElement)
+{
+    TRDP_SOCKET_TCP_T *pTcp;
 
-        if (err == VOS_NOCONN_ERR)
-        {
-            return TRDP_NOCONN_ERR;
-        }
-        else if (err == VOS_IO_ERR)
-        {
-            return TRDP_IO_ERR;
-        }
-        else
-        {
-            return TRDP_BLOCK_ERR;
-        }
+    if ((pElement->queuedSize == 0u) || (pElement->socketIdx == TRDP_INVALID_SOCKET_INDEX))
+    {
+        return;
     }
+    pTcp = &appHandle->iface[pElement->socketIdx].tcpParams;
 
-    if ((pElement->sendSize) != pElement->grossSize)
+    /* the counter was reset if the connection has been closed meanwhile */
+    pTcp->queuedBytes       = (pTcp->queuedBytes > pElement->queuedSize) ? pTcp->queuedBytes - pElement->queuedSize : 0u;
+    pElement->queuedSize    = 0u;
+    if ((pTcp->throttled == TRUE) && (pTcp->queuedBytes <= TRDP_MD_TCP_SNDQ_LOW))
     {
-        vos_printLog(VOS_LOG_INFO, "vos_sockSend%s incomplete (Socket: %d, Port: %d)\n",
-                     (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", (int) mdSock, (unsigned int) port);
-        return TRDP_IO_ERR;
+        vos_printLog(VOS_LOG_INFO, "TCP send queue of socket %d accepts messages again\n",
+                     (int) appHandle->iface[pElement->socketIdx].sock);
+        pTcp->throttled = FALSE;
     }
-
-    return TRDP_NO_ERR;
 }
 
-
+#if TRDP_MD_TCP_CORK
 /**********************************************************************************************************************/
-/** Receive MD packet transmitted via TCP
+/** Cork the TCP connections which have more than one MD message to send in this cycle
+ *  The messages are counted in txBatch of their connection, trdp_mdUncork() resets the counters.
  *
  *  @param[in]      appHandle       session pointer
- *  @param[in]      mdSock          socket descriptor
- *  @param[out]     pElement        pointer to received packet
- *  @retval         != TRDP_NO_ERR  error
+ *
+ *  @retval         number of TCP messages to send
  */
-static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock, MD_ELE_T *pElement)
+static UINT32 trdp_mdCork (TRDP_SESSION_PT appHandle)
 {
-    /* TCP receiver */
-    TRDP_ERR_T  err = TRDP_NO_ERR;
-    UINT32      size = 0u;                       /* Size of the all data read until now */
-    UINT32      dataSize        = 0u;            /* The pending data to read */
-    UINT32      socketIndex     = 0u;
-    UINT32      readSize        = 0u;            /* All the data read in this cycle (Header + Data) */
-    UINT32      readDataSize    = 0u;            /* All the data part read in this cycle (Data) */
-    BOOL8       noDataToRead    = FALSE;
-    UINT32      storedDataSize  = 0u;
+    MD_ELE_T    *iterMD;
+    UINT32      noOfMsgs = 0u;
+    int         queue;
 
-    /* Initialize to 0 the stored header size*/
-    UINT32      storedHeader = 0;
+    for (queue = 0; queue < 2; queue++)
+    {
+        for (iterMD = (queue == 0) ? appHandle->pMDSndQueue : appHandle->pMDRcvQueue;
+             iterMD != NULL;
+             iterMD = iterMD->pNext)
+        {
+            TRDP_SOCKETS_T *pIface;
 
-    /* Initialize to 0 the pElement->dataSize
-     * Once it is known, the message complete data size will be saved*/
-    pElement->dataSize = 0u;
+            if (((iterMD->pktFlags & TRDP_FLAGS_TCP) == 0)
+                || (iterMD->socketIdx == TRDP_INVALID_SOCKET_INDEX)
+                || ((iterMD->privFlags & TRDP_REDUNDANT) != 0))
+            {
+                continue;
+            }
+            switch (iterMD->stateEle)
+            {
+               case TRDP_ST_TX_NOTIFY_ARM:
+               case TRDP_ST_TX_REQUEST_ARM:
+               case TRDP_ST_TX_REPLY_ARM:
+               case TRDP_ST_TX_REPLYQUERY_ARM:
+               case TRDP_ST_TX_CONFIRM_ARM:
+                   break;
+               default:
+                   continue;
+            }
+            pIface = &appHandle->iface[iterMD->socketIdx];
+            if ((pIface->tcpParams.connected == FALSE) || (iterMD->tcpParameters.doConnect == TRUE))
+            {
+                continue;   /* connect() is done by trdp_mdSend() */
+            }
+            if ((pIface->tcpParams.notSend == TRUE) && (iterMD->tcpParameters.msgUncomplete == FALSE))
+            {
+                continue;   /* waits for the uncompleted message before it */
+            }
+            noOfMsgs++;
+            pIface->tcpParams.txBatch++;
+            if ((pIface->tcpParams.txBatch == 2u) && (pIface->tcpParams.corked == FALSE))
+            {
+                pIface->tcpParams.corked = (vos_sockSetCork(pIface->sock, TRUE) == VOS_NO_ERR) ? TRUE : FALSE;
+            }
+        }
+    }
+    return noOfMsgs;
+}
 
-    /* Fill destination address */
-    pElement->addr.destIpAddr = appHandle->realIP;
+/**********************************************************************************************************************/
+/** Push out what the corked TCP connections held back and reset the message counters
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+static void trdp_mdUncork (TRDP_SESSION_PT appHandle)
+{
+    UINT32 idx;
 
-    /* Find the socket index */
-    for ( socketIndex = 0u; socketIndex < VOS_MAX_SOCKET_CNT; socketIndex++ )
+    for (idx = 0u; idx < VOS_MAX_SOCKET_CNT; idx++)
     {
-        if ( appHandle->iface[socketIndex].sock == mdSock )
+        TRDP_SOCKET_TCP_T *pTcp = &appHandle->iface[idx].tcpParams;
+
+        pTcp->txBatch = 0u;
+        if (pTcp->corked == TRUE)
         {
-            break;
+            (void) vos_sockSetCork(appHandle->iface[idx].sock, FALSE);
+            pTcp->corked = FALSE;
         }
     }
+}
+#endif
 
-    if ( socketIndex >= VOS_MAX_SOCKET_CNT )
+#if TRDP_MD_UDP_SEG_SIZE > 0
+/**********************************************************************************************************************/
+/** Get the segment buffers of the session, allocate them on first use
+ *
+ *  @param[in]      appHandle       session pointer
+ *
+ *  @retval         pointer to the segment buffers, NULL if out of memory
+ */
+static MD_UDP_SEG_T *trdp_mdUdpSegGet (TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pMDUdpSeg == NULL)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecvPacket - Socket index out of range\n");
-        return TRDP_UNKNOWN_ERR;
+        appHandle->pMDUdpSeg = (MD_UDP_SEG_T *) vos_memAlloc(sizeof(MD_UDP_SEG_T));
+        if (appHandle->pMDUdpSeg != NULL)
+        {
+            appHandle->pMDUdpSeg->sock = VOS_INVALID_SOCKET;
+        }
     }
+    return appHandle->pMDUdpSeg;
+}
 
-    /* Read Header */
-    if ((appHandle->uncompletedTCP[socketIndex] == NULL)
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize < sizeof(MD_HEADER_T))))
+/**********************************************************************************************************************/
+/** Check if an armed UDP notification can be sent in segments
+ *
+ *  @param[in]      pElement        pointer to the element
+ *
+ *  @retval         TRUE            the notification can be gathered with others of its size
+ */
+static BOOL8 trdp_mdUdpSegCandidate (const MD_ELE_T *pElement)
+{
+    return ((pElement->stateEle == TRDP_ST_TX_NOTIFY_ARM)
+            && ((pElement->pktFlags & TRDP_FLAGS_TCP) == 0)
+            && ((pElement->privFlags & TRDP_REDUNDANT) == 0)
+            && (pElement->socketIdx != TRDP_INVALID_SOCKET_INDEX)
+            && (pElement->morituri == FALSE)
+            && (pElement->grossSize <= TRDP_MD_UDP_SEG_SIZE)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Send the UDP notifications of equal size to the same destination with one call (TRDP_OPTION_MD_UDP_SEGMENT)
+ *  A notification stays armed for trdp_mdSend() if it is the only one of its kind, or if the segmented send failed.
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+static void trdp_mdSendUdpSeg (TRDP_SESSION_PT appHandle)
+{
+    MD_ELE_T        *pGroup[VOS_MAX_UDP_SEGS];
+    MD_ELE_T        *iterMD;
+    MD_ELE_T        *iterNext;
+    MD_UDP_SEG_T    *pSeg = NULL;
+    UINT32          noOfSegs;
+    UINT32          maxSegs;
+    UINT32          size;
+    UINT32          i;
+
+    for (iterMD = appHandle->pMDSndQueue; iterMD != NULL; iterMD = iterMD->pNext)
     {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
+        if (trdp_mdUdpSegCandidate(iterMD) == FALSE)
         {
-            readSize = sizeof(MD_HEADER_T);
+            continue;
         }
-        else
+        maxSegs = TRDP_MD_UDP_SEG_BUF_SIZE / iterMD->grossSize;
+        if (maxSegs > VOS_MAX_UDP_SEGS)
         {
-            /* If we have read some data before, read the rest */
-            readSize        = sizeof(MD_HEADER_T) - appHandle->uncompletedTCP[socketIndex]->grossSize;
-            storedHeader    = appHandle->uncompletedTCP[socketIndex]->grossSize;
+            maxSegs = VOS_MAX_UDP_SEGS;
         }
-
-        if ( readSize > 0u )
+        pGroup[0]   = iterMD;
+        noOfSegs    = 1u;
+        for (iterNext = iterMD->pNext; (iterNext != NULL) && (noOfSegs < maxSegs); iterNext = iterNext->pNext)
         {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                                                  &readSize);
-
-            /* Add the read data size to the size read before */
-            size = storedHeader + readSize;
-
-            if ( err == TRDP_NO_ERR
-                 && (appHandle->uncompletedTCP[socketIndex] != NULL)
-                 && (size >= sizeof(MD_HEADER_T))
-                 && appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )     /* BL: Prevent NULL pointer access */
+            if ((trdp_mdUdpSegCandidate(iterNext) == TRUE)
+                && (iterNext->grossSize == iterMD->grossSize)
+                && (iterNext->socketIdx == iterMD->socketIdx)
+                && (iterNext->addr.destIpAddr == iterMD->addr.destIpAddr))
             {
-                if ( trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, size, CHECK_HEADER_ONLY) == TRDP_NO_ERR )
-                {
-                    /* Uncompleted Header, completed. Save some parameters in the uncompletedTCP structure */
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength =
-                        pElement->pPacket->frameHead.datasetLength;
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.frameCheckSum =
+                pGroup[noOfSegs++] = iterNext;
+            }
+        }
+        if (noOfSegs < 2u)
+        {
+            continue;
+        }
+        if (pSeg == NULL)
+        {
+            pSeg = trdp_mdUdpSegGet(appHandle);
+            if (pSeg == NULL)
+            {
+                return;
+            }
+        }
+        for (i = 0u; i < noOfSegs; i++)
+        {
+            trdp_mdUpdatePacket(pGroup[i]);
+            TRDP_TRACE2(md_send, vos_ntohl(pGroup[i]->pPacket->frameHead.comId), pGroup[i]->grossSize);
+            memcpy(pSeg->txBuf + i * iterMD->grossSize, &pGroup[i]->pPacket->frameHead, iterMD->grossSize);
+        }
+        size = noOfSegs * iterMD->grossSize;
+        if (vos_sockSendUDPSeg(appHandle->iface[iterMD->socketIdx].sock, pSeg->txBuf, &size, iterMD->grossSize,
+                               iterMD->addr.destIpAddr, appHandle->mdDefault.udpPort) != VOS_NO_ERR)
+        {
+            /* the remaining notifications are sent (and their errors handled) one by one */
+            vos_printLog(VOS_LOG_WARNING, "Segmented MD send to %s incomplete (%u of %u bytes)\n",
+                         vos_ipDotted(iterMD->addr.destIpAddr), (unsigned int) size,
+                         (unsigned int) (noOfSegs * iterMD->grossSize));
+        }
+        for (i = 0u; (i < noOfSegs) && (size >= iterMD->grossSize); i++)
+        {
+            size -= iterMD->grossSize;
+            TRDP_REC(appHandle, TRDP_REC_MD_TX, appHandle->realIP, iterMD->addr.destIpAddr,
+                     appHandle->mdDefault.udpPort, &pGroup[i]->pPacket->frameHead, iterMD->grossSize);
+            pGroup[i]->sendSize = pGroup[i]->grossSize;
+            pGroup[i]->stateEle = TRDP_ST_NONE;
+            pGroup[i]->morituri = TRUE;
+            TRDP_STATS_INC(appHandle, udpMd.numSend);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Receive one MD datagram from the datagrams the kernel coalesced (TRDP_OPTION_MD_UDP_SEGMENT)
+ *  The socket is read only when all datagrams read before have been handed over.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      mdSock          socket descriptor
+ *  @param[out]     pElement        pointer to received packet
+ *  @retval         != TRDP_NO_ERR  error
+ */
+static TRDP_ERR_T trdp_mdRecvUdpSeg (TRDP_SESSION_PT appHandle, SOCKET mdSock, MD_ELE_T *pElement)
+{
+    MD_UDP_SEG_T    *pSeg = trdp_mdUdpSegGet(appHandle);
+    UINT8           *pData;
+    UINT32          size;
+
+    if (pSeg == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    if ((pSeg->sock != mdSock) || (pSeg->offset >= pSeg->size))
+    {
+        TRDP_ERR_T err;
+
+        pSeg->sock          = mdSock;
+        pSeg->offset        = 0u;
+        pSeg->size          = TRDP_MD_UDP_SEG_BUF_SIZE;
+        pSeg->srcIpAddr     = 0u;
+        pSeg->destIpAddr    = appHandle->realIP;    /* Preset destination IP  */
+
+        err = (TRDP_ERR_T) vos_sockReceiveUDPSeg(mdSock,
+                                                 pSeg->rxBuf,
+                                                 &pSeg->size,
+                                                 &pSeg->segSize,
+                                                 &pSeg->srcIpAddr,
+                                                 &pSeg->srcPort,
+                                                 &pSeg->destIpAddr);
+        switch ( err )
+        {
+           case TRDP_NO_ERR:
+               break;
+           case TRDP_NODATA_ERR:
+               pSeg->size = 0u;
+               vos_printLog(VOS_LOG_INFO, "vos_sockReceiveUDPSeg - No data at socket %d\n", (int) mdSock);
+               return TRDP_NODATA_ERR;
+           case TRDP_BLOCK_ERR:
+               pSeg->size = 0u;
+               return TRDP_BLOCK_ERR;
+           default:
+               pSeg->size = 0u;
+               vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveUDPSeg failed (Err: %d, Socket: %d)\n", err, (int) mdSock);
+               return err;
+        }
+        if (pSeg->segSize == 0u)
+        {
+            /* ICMP port unreachable received (result of previous send) */
+            return TRDP_NODATA_ERR;
+        }
+    }
+
+    pData           = pSeg->rxBuf + pSeg->offset;
+    size            = pSeg->size - pSeg->offset;
+    if (size > pSeg->segSize)
+    {
+        size = pSeg->segSize;
+    }
+    pSeg->offset    += size;
+
+    pElement->addr.srcIpAddr    = pSeg->srcIpAddr;
+    pElement->addr.destIpAddr   = pSeg->destIpAddr;
+    pElement->replyPort         = pSeg->srcPort;
+
+    if ((size < sizeof(MD_HEADER_T))
+        || (trdp_mdCheck(appHandle, (MD_HEADER_T *) pData, sizeof(MD_HEADER_T), CHECK_HEADER_ONLY) != TRDP_NO_ERR)
+        || (size < trdp_packetSizeMD(vos_ntohl(((MD_HEADER_T *) pData)->datasetLength))))
+    {
+        vos_printLog(VOS_LOG_INFO, "UDP MD header check failed. Packet from socket %d thrown away\n", (int) mdSock);
+        return TRDP_NODATA_ERR;
+    }
+
+    pElement->dataSize  = vos_ntohl(((MD_HEADER_T *) pData)->datasetLength);
+    pElement->grossSize = trdp_packetSizeMD(pElement->dataSize);
+
+    if (pElement->grossSize > cMinimumMDSize)
+    {
+        /* we have to allocate a bigger buffer */
+        MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(pElement->grossSize);
+        if (pBigData == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        /*  Swap the pointers ...  */
+        vos_memFree(pElement->pPacket);
+        pElement->pPacket       = pBigData;
+        pElement->poolPacket    = FALSE;
+    }
+    memcpy(pElement->pPacket, pData, pElement->grossSize);
+
+    return TRDP_NO_ERR;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Send MD packet
+ *  A packet with user data sent in place is gathered from header, user buffer and padding.
+ *
+ *  @param[in]      mdSock          socket descriptor
+ *  @param[in]      port            port on which to send
+ *  @param[in]      pElement        pointer to element to be sent
+ *  @retval         != NULL         error
+ */
+static TRDP_ERR_T  trdp_mdSendPacket (SOCKET    mdSock,
+                                      UINT16    port,
+                                      MD_ELE_T  *pElement)
+{
+    VOS_ERR_T   err         = VOS_NO_ERR;
+    UINT32      tmpSndSize  = 0u;
+
+    TRDP_TRACE2(md_send, vos_ntohl(pElement->pPacket->frameHead.comId), pElement->grossSize);
+
+    if (((pElement->pktFlags & TRDP_FLAGS_TCP) != 0) && (pElement->pUserData != NULL))
+    {
+        VOS_SOCK_SEG_T  segs[3];
+        UINT32          i;
+
+        segs[0].pBuffer = (const UINT8 *)&pElement->pPacket->frameHead;
+        segs[0].size    = sizeof(MD_HEADER_T);
+        segs[1].pBuffer = pElement->pUserData;
+        segs[1].size    = pElement->dataSize;
+        segs[2].pBuffer = pElement->pPacket->data;      /* zeroed padding */
+        segs[2].size    = pElement->grossSize - sizeof(MD_HEADER_T) - pElement->dataSize;
+
+        /* skip what has been sent before */
+        tmpSndSize = pElement->sendSize;
+        for (i = 0u; i < 3u; i++)
+        {
+            UINT32 skip = (tmpSndSize < segs[i].size) ? tmpSndSize : segs[i].size;
+            segs[i].pBuffer += skip;
+            segs[i].size    -= skip;
+            tmpSndSize      -= skip;
+        }
+
+        err = vos_sockSendTCPv(mdSock, segs, 3u, &tmpSndSize);
+        pElement->sendSize += tmpSndSize;
+    }
+    else if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
+    {
+        tmpSndSize = pElement->sendSize;
+
+        pElement->sendSize = pElement->grossSize - tmpSndSize;
+
+        err = vos_sockSendTCP(mdSock, ((UINT8 *)&pElement->pPacket->frameHead) + tmpSndSize, &pElement->sendSize);
+        pElement->sendSize = tmpSndSize + pElement->sendSize;
+    }
+    else
+    {
+        pElement->sendSize = pElement->grossSize;
+
+        err = vos_sockSendUDP(mdSock,
+                              (UINT8 *)&pElement->pPacket->frameHead,
+                              &pElement->sendSize,
+                              pElement->addr.destIpAddr,
+                              port);
+    }
+
+    if (err != VOS_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "vos_sockSend%s error (Err: %d, Socket: %d, Port: %u)\n",
+                     (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", err, (int) mdSock, (unsigned int) port);
+
+        if (err == VOS_NOCONN_ERR)
+        {
+            return TRDP_NOCONN_ERR;
+        }
+        else if (err == VOS_IO_ERR)
+        {
+            return TRDP_IO_ERR;
+        }
+        else
+        {
+            return TRDP_BLOCK_ERR;
+        }
+    }
+
+    if ((pElement->sendSize) != pElement->grossSize)
+    {
+        vos_printLog(VOS_LOG_INFO, "vos_sockSend%s incomplete (Socket: %d, Port: %d)\n",
+                     (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", (int) mdSock, (unsigned int) port);
+        return TRDP_IO_ERR;
+    }
+
+    return TRDP_NO_ERR;
+}
+
+
+/**********************************************************************************************************************/
+/** Retransmit a UDP request after a reply timeout
+ *  The frame prepared by the first send is kept with the updated sequence counter and header FCS, a retry is
+ *  only a send and leaves the element waiting for the reply.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        pointer to the request element
+ *  @retval         TRDP_NO_ERR     sent
+ *  @retval         != TRDP_NO_ERR  not sent, retry by trdp_mdSend
+ */
+static TRDP_ERR_T trdp_mdRetransmit (TRDP_SESSION_PT    appHandle,
+                                     MD_ELE_T           *pElement)
+{
+    TRDP_ERR_T result;
+
+    if (pElement->socketIdx == TRDP_INVALID_SOCKET_INDEX)
+    {
+        return TRDP_SOCK_ERR;
+    }
+
+    result = trdp_mdSendPacket(appHandle->iface[pElement->socketIdx].sock, appHandle->mdDefault.udpPort, pElement);
+    if (result != TRDP_NO_ERR)
+    {
+        return result;
+    }
+
+#if TRDP_RECORDER
+    if (appHandle->pRecorder != NULL)
+    {
+        trdp_recWrite(appHandle->pRecorder, TRDP_REC_MD_TX, appHandle->realIP, pElement->addr.destIpAddr,
+                      appHandle->mdDefault.udpPort, (const UINT8 *)&pElement->pPacket->frameHead,
+                      pElement->grossSize, NULL, 0u);
+    }
+#endif
+    TRDP_STATS_INC(appHandle, udpMd.numSend);
+#if TRDP_TIMING_STATS
+    if (appHandle->option & TRDP_OPTION_TIMING_STATS)
+    {
+        vos_getTime(&pElement->sendTime);
+    }
+#endif
+    pElement->stateEle = TRDP_ST_TX_REQUEST_W4REPLY;
+    return TRDP_NO_ERR;
+}
+
+
+/**********************************************************************************************************************/
+/** Receive MD packet transmitted via TCP
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      mdSock          socket descriptor
+ *  @param[out]     pElement        pointer to received packet
+ *  @retval         != TRDP_NO_ERR  error
+ */
+static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock, MD_ELE_T *pElement)
+{
+    /* TCP receiver */
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      size = 0u;                       /* Size of the all data read until now */
+    UINT32      dataSize        = 0u;            /* The pending data to read */
+    UINT32      socketIndex     = 0u;
+    UINT32      readSize        = 0u;            /* All the data read in this cycle (Header + Data) */
+    UINT32      readDataSize    = 0u;            /* All the data part read in this cycle (Data) */
+    BOOL8       noDataToRead    = FALSE;
+    UINT32      storedDataSize  = 0u;
+
+    /* Initialize to 0 the stored header size*/
+    UINT32      storedHeader = 0;
+
+    /* Initialize to 0 the pElement->dataSize
+     * Once it is known, the message complete data size will be saved*/
+    pElement->dataSize = 0u;
+
+    /* Fill destination address */
+    pElement->addr.destIpAddr = appHandle->realIP;
+
+    /* Find the socket index */
+    for ( socketIndex = 0u; socketIndex < VOS_MAX_SOCKET_CNT; socketIndex++ )
+    {
+        if ( appHandle->iface[socketIndex].sock == mdSock )
+        {
+            break;
+        }
+    }
+
+    if ( socketIndex >= VOS_MAX_SOCKET_CNT )
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecvPacket - Socket index out of range\n");
+        return TRDP_UNKNOWN_ERR;
+    }
+
+    /* Read Header */
+    if ((appHandle->uncompletedTCP[socketIndex] == NULL)
+        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
+            && (appHandle->uncompletedTCP[socketIndex]->grossSize < sizeof(MD_HEADER_T))))
+    {
+        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
+        {
+            readSize = sizeof(MD_HEADER_T);
+        }
+        else
+        {
+            /* If we have read some data before, read the rest */
+            readSize        = sizeof(MD_HEADER_T) - appHandle->uncompletedTCP[socketIndex]->grossSize;
+            storedHeader    = appHandle->uncompletedTCP[socketIndex]->grossSize;
+        }
+
+        if ( readSize > 0u )
+        {
+            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
+                                                  ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
+                                                  &readSize);
+
+            /* Add the read data size to the size read before */
+            size = storedHeader + readSize;
+
+            if ( err == TRDP_NO_ERR
+                 && (appHandle->uncompletedTCP[socketIndex] != NULL)
+                 && (size >= sizeof(MD_HEADER_T))
+                 && appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )     /* BL: Prevent NULL pointer access */
+            {
+                if ( trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, size, CHECK_HEADER_ONLY) == TRDP_NO_ERR )
+                {
+                    /* Uncompleted Header, completed. Save some parameters in the uncompletedTCP structure */
+                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength =
+                        pElement->pPacket->frameHead.datasetLength;
+                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.frameCheckSum =
                         pElement->pPacket->frameHead.frameCheckSum;
                 }
                 else
@@ -1110,6 +1839,24 @@ static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock
         }
     }
 
+#if TRDP_MD_STREAM_CHUNK_SIZE > 0
+    /* The header of a new message is complete: hand the data over in chunks if a streaming listener takes it */
+    if ((err == TRDP_NO_ERR) && (size >= sizeof(MD_HEADER_T)) &&
+        (trdp_mdStreamStart(appHandle, socketIndex, &pElement->pPacket->frameHead) == TRUE))
+    {
+        if (appHandle->uncompletedTCP[socketIndex] != NULL)
+        {
+            if (appHandle->uncompletedTCP[socketIndex]->pPacket != NULL)
+            {
+                vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
+            }
+            vos_memFree(appHandle->uncompletedTCP[socketIndex]);
+            appHandle->uncompletedTCP[socketIndex] = NULL;
+        }
+        return TRDP_PACKET_ERR;
+    }
+#endif
+
     /* Read Data */
     if ((size >= sizeof(MD_HEADER_T))
         || ((appHandle->uncompletedTCP[socketIndex] != NULL)
@@ -1155,7 +1902,8 @@ static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock
                        readSize);
 
                 vos_memFree(pElement->pPacket);
-                pElement->pPacket = pBigData;
+                pElement->pPacket       = pBigData;
+                pElement->poolPacket    = FALSE;
             }
         }
 
@@ -1344,6 +2092,13 @@ static TRDP_ERR_T trdp_mdRecvUDPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock
     TRDP_ERR_T  err = TRDP_NO_ERR;
     UINT32      size; /* Size of the all data read until now */
 
+#if TRDP_MD_UDP_SEG_SIZE > 0
+    if ((appHandle->option & TRDP_OPTION_MD_UDP_SEGMENT) != 0)
+    {
+        return trdp_mdRecvUdpSeg(appHandle, mdSock, pElement);
+    }
+#endif
+
     /* We read the header first */
     size = sizeof(MD_HEADER_T);
     pElement->addr.srcIpAddr    = 0u;
@@ -1376,8 +2131,9 @@ static TRDP_ERR_T trdp_mdRecvUDPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock
                 }
                 /*  Swap the pointers ...  */
                 vos_memFree(pElement->pPacket);
-                pElement->pPacket   = pBigData;
-                pElement->grossSize = trdp_packetSizeMD(pElement->dataSize);
+                pElement->pPacket       = pBigData;
+                pElement->poolPacket    = FALSE;
+                pElement->grossSize     = trdp_packetSizeMD(pElement->dataSize);
             }
 
             /*  get the complete packet */
@@ -1461,53 +2217,403 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
         }
         /* use the TCP statistic structure for storing */
         /* the trdp_mdCheck result                      */
-        pElementStatistics = &appHandle->stats.tcpMd;
+        pElementStatistics = &trdp_statsBlock(appHandle)->tcpMd;
     }
     else
     {
-        /* Call UDP receiver function */
-        err = trdp_mdRecvUDPPacket(appHandle, mdSock, pElement);
-        if (err != TRDP_NO_ERR)
+        /* Call UDP receiver function */
+        err = trdp_mdRecvUDPPacket(appHandle, mdSock, pElement);
+        if (err != TRDP_NO_ERR)
+        {
+            /* fatal communication issue, exit function */
+            return err;
+        }
+        /* use the UDP statisctic structure for storing */
+        /* the trdp_mdCheck result                      */
+        pElementStatistics = &trdp_statsBlock(appHandle)->udpMd;
+    }
+    /* Step 2: Check the received buffer for data con-   */
+    /* sistency and TRDP protocol coherency              */
+    err = trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, pElement->grossSize, CHECK_DATA_TOO);
+    /* Step 3: Update the statistics structure counters  */
+    /* according the trdp_mdCheck result                 */
+    switch (err)
+    {
+       case TRDP_NO_ERR:
+           TRDP_CNT_ADD(pElementStatistics->numRcv, 1u);
+           break;
+       case TRDP_CRC_ERR:
+           TRDP_CNT_ADD(pElementStatistics->numCrcErr, 1u);
+           break;
+       case TRDP_WIRE_ERR:
+           TRDP_CNT_ADD(pElementStatistics->numProtErr, 1u);
+           break;
+       case TRDP_TOPO_ERR:
+           TRDP_CNT_ADD(pElementStatistics->numTopoErr, 1u);
+           break;
+       default:
+           ;
+    }
+
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "trdp_mdCheck %s failed (Err: %d)\n",
+                     (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", err);
+    }
+
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Find the listener for an incoming request or notification
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_init
+ *  @param[in]      pH              Header of the incoming message
+ *  @param[in]      isTCP           TCP ?
+ *  @param[in]      srcIpAddr       source IP address of the message
+ *  @param[in]      destIpAddr      destination IP address of the message
+ *
+ *  @retval         != NULL         first matching listener
+ *  @retval         NULL            no listener
+ */
+static MD_LIS_ELE_T *trdp_mdFindListener (TRDP_SESSION_PT   appHandle,
+                                          const MD_HEADER_T *pH,
+                                          BOOL8             isTCP,
+                                          TRDP_IP_ADDR_T    srcIpAddr,
+                                          TRDP_IP_ADDR_T    destIpAddr)
+{
+    MD_LIS_ELE_T        *iterListener;
+    TRDP_MD_LIS_ITER_T  lisIter;
+    BOOL8               uriHashed   = FALSE;
+    UINT32              srcUriHash  = 0u;
+    UINT32              destUriHash = 0u;
+
+    /* only the listeners of this comId and those for any comId are candidates */
+    trdp_MDlistenerFirst(appHandle, vos_ntohl(pH->comId), &lisIter);
+    for ( iterListener = trdp_MDlistenerNext(&lisIter); iterListener != NULL;
+          iterListener = trdp_MDlistenerNext(&lisIter) )
+    {
+        if ((iterListener->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
+            (isTCP == TRUE))
+        {
+            continue;
+        }
+
+        /* Ticket #206: TCP requests should use TCP listeners only */
+        if ((iterListener->pktFlags & TRDP_FLAGS_TCP) && (isTCP == FALSE))
+        {
+            continue;
+        }
+
+        /* Ticket #180: Do the filtering as the standard demands */
+
+        /* If comID does not match but should, continue */
+        if (((iterListener->privFlags & TRDP_CHECK_COMID) != 0) &&
+            (vos_ntohl(pH->comId) != iterListener->addr.comId))
+        {
+            continue;
+        }
+
+        /* the URIs of the message are hashed once, listener URIs differing in their hash are not compared */
+        if (!uriHashed && ((iterListener->srcURI[0] != 0) || (iterListener->destURI[0] != 0)))
+        {
+            srcUriHash  = trdp_uriHash((CHAR8 *) pH->sourceURI);
+            destUriHash = trdp_uriHash((CHAR8 *) pH->destinationURI);
+            uriHashed   = TRUE;
+        }
+
+        /* check the source URI if set  */
+        if ((iterListener->srcURI[0] != 0) &&
+            ((iterListener->srcUriHash != srcUriHash) ||
+             !trdp_isAddressed(iterListener->srcURI, (CHAR8 *) pH->sourceURI)))
+        {
+            continue;
+        }
+
+        /* check the destination URI if set  */
+        if ((iterListener->destURI[0] != 0) &&
+            ((iterListener->destUriHash != destUriHash) ||
+             !trdp_isAddressed(iterListener->destURI, (CHAR8 *) pH->destinationURI)))
+        {
+            continue;
+        }
+
+        /* check topocounts before comparing source or destination IP addresses! */
+        /* Step 1: here we need to check the topccounts */
+        /* in case of train communication (topo counters != zero) check topo validity of recvd message and */
+        /* recv queue item by matching the etbTopoCnt and opTrnTopoCnt                                     */
+        if (((pH->etbTopoCnt != 0u) || (pH->opTrnTopoCnt != 0u))
+            && (!trdp_validTopoCounters( vos_ntohl(pH->etbTopoCnt),
+                                         vos_ntohl(pH->opTrnTopoCnt),
+                                         iterListener->addr.etbTopoCnt,
+                                         iterListener->addr.opTrnTopoCnt)))
+        {
+            continue;
+        }
+
+        /* If multicast address is set, but does not match, we go to the next listener (if any) */
+        if ((iterListener->addr.mcGroup != 0u) &&
+            (iterListener->addr.mcGroup != destIpAddr))
+        {
+            /* no IP match for unicast addressing */
+            continue;
+        }
+
+        /* if source IP given (and no range) */
+        if ((iterListener->addr.srcIpAddr2 == 0) &&
+            (iterListener->addr.srcIpAddr != 0) &&
+            (iterListener->addr.srcIpAddr != srcIpAddr))
+        {
+            continue;
+        }
+
+        /* if source IP given and is within given IP range */
+        if ((iterListener->addr.srcIpAddr != 0) &&
+            (iterListener->addr.srcIpAddr2 != 0) &&
+            (!trdp_isInIPrange(srcIpAddr,
+                               iterListener->addr.srcIpAddr,
+                               iterListener->addr.srcIpAddr2)))
+        {
+            continue;
+        }
+
+        return iterListener;
+    }
+    return NULL;
+}
+
+#if TRDP_MD_STREAM_CHUNK_SIZE > 0
+/**********************************************************************************************************************/
+/** Hand a chunk of a streamed TCP notification (or the abort of the stream) to the listener
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pStream         stream state
+ *  @param[in]      pData           chunk data, NULL on abort
+ *  @param[in]      dataSize        size of the chunk
+ *  @param[in]      resultCode      TRDP_NO_ERR or the reason of the abort
+ */
+static void trdp_mdStreamCallback (TRDP_SESSION_PT      appHandle,
+                                   const MD_STREAM_T    *pStream,
+                                   UINT8                *pData,
+                                   UINT32               dataSize,
+                                   TRDP_ERR_T           resultCode)
+{
+    TRDP_MD_INFO_T  theMessage  = cTrdp_md_info_default;
+    INT32           replyStatus = (INT32) vos_ntohl((UINT32)pStream->frameHead.replyStatus);
+
+    if (pStream->pfCbFunction == NULL)
+    {
+        return;
+    }
+
+    theMessage.srcIpAddr    = pStream->srcIpAddr;
+    theMessage.destIpAddr   = appHandle->realIP;
+    theMessage.seqCount     = vos_ntohl(pStream->frameHead.sequenceCounter);
+    theMessage.protVersion  = vos_ntohs(pStream->frameHead.protocolVersion);
+    theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(pStream->frameHead.msgType);
+    theMessage.comId        = vos_ntohl(pStream->frameHead.comId);
+    theMessage.etbTopoCnt   = vos_ntohl(pStream->frameHead.etbTopoCnt);
+    theMessage.opTrnTopoCnt = vos_ntohl(pStream->frameHead.opTrnTopoCnt);
+    memcpy(theMessage.sessionId, pStream->frameHead.sessionID, TRDP_SESS_ID_SIZE);
+    theMessage.replyTimeout = vos_ntohl(pStream->frameHead.replyTimeout);
+    vos_strncpy(theMessage.destUserURI, (CHAR8 *) pStream->frameHead.destinationURI, TRDP_MAX_URI_USER_LEN);
+    vos_strncpy(theMessage.srcUserURI, (CHAR8 *) pStream->frameHead.sourceURI, TRDP_MAX_URI_USER_LEN);
+    if ( replyStatus >= 0 )
+    {
+        theMessage.userStatus   = (UINT16) replyStatus;
+        theMessage.replyStatus  = TRDP_REPLY_OK;
+    }
+    else
+    {
+        theMessage.replyStatus  = (TRDP_REPLY_STATUS_T) replyStatus;
+    }
+    theMessage.pUserRef     = pStream->pUserRef;
+    theMessage.resultCode   = resultCode;
+    theMessage.chunkOffset  = pStream->offset;
+    theMessage.totalLength  = vos_ntohl(pStream->frameHead.datasetLength);
+
+    TRDP_TRACE2(md_callback, theMessage.comId, resultCode);
+    pStream->pfCbFunction(appHandle->mdDefault.pRefCon, appHandle, &theMessage, pData, dataSize);
+    TRDP_TRACE1(md_callback_done, theMessage.comId);
+}
+
+/**********************************************************************************************************************/
+/** Start handing a TCP notification over to a streaming listener
+ *  Called with the complete header of a new message. If a TRDP_FLAGS_TCP_STREAM listener takes the notification, its
+ *  data is read by trdp_mdStreamRecv() from now on instead of being reassembled.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      socketIndex     index of the TCP socket
+ *  @param[in]      pH              header of the message
+ *
+ *  @retval         TRUE            the message is streamed
+ *  @retval         FALSE           the message is reassembled as usual
+ */
+static BOOL8 trdp_mdStreamStart (TRDP_SESSION_PT    appHandle,
+                                 UINT32             socketIndex,
+                                 MD_HEADER_T        *pH)
+{
+    MD_LIS_ELE_T    *pListener;
+    MD_STREAM_T     *pStream;
+    UINT32          dataSize = vos_ntohl(pH->datasetLength);
+
+    if ((vos_ntohs(pH->msgType) != TRDP_MSG_MN) || (dataSize == 0u) ||
+        (trdp_mdCheck(appHandle, pH, sizeof(MD_HEADER_T), CHECK_HEADER_ONLY) != TRDP_NO_ERR))
+    {
+        return FALSE;
+    }
+
+    pListener = trdp_mdFindListener(appHandle, pH, TRUE, appHandle->iface[socketIndex].tcpParams.cornerIp,
+                                    appHandle->realIP);
+    if ((pListener == NULL) || ((pListener->pktFlags & TRDP_FLAGS_TCP_STREAM) == 0))
+    {
+        return FALSE;
+    }
+
+    pStream = (MD_STREAM_T *) vos_memAlloc(sizeof(MD_STREAM_T));
+    if (pStream == NULL)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "trdp_mdStreamStart - out of memory, reassembling notification\n");
+        return FALSE;
+    }
+    pStream->sock           = appHandle->iface[socketIndex].sock;
+    pStream->frameHead      = *pH;
+    pStream->srcIpAddr      = appHandle->iface[socketIndex].tcpParams.cornerIp;
+    pStream->pUserRef       = pListener->pUserRef;
+    pStream->pfCbFunction   = pListener->pfCbFunction;
+    pStream->offset         = 0u;
+    pStream->remaining      = trdp_packetSizeMD(dataSize) - sizeof(MD_HEADER_T);
+
+    pListener->numSessions++;
+    appHandle->pMDStream[socketIndex] = pStream;
+
+    vos_printLog(VOS_LOG_INFO, "Streaming TCP MD notification (comId %u, %u bytes, Socket: %d)\n",
+                 vos_ntohl(pH->comId), dataSize, (int) pStream->sock);
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Abort a streamed TCP notification
+ *  The listener is called with pData == NULL and the reason as resultCode.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      socketIndex     index of the TCP socket
+ *  @param[in]      resultCode      reason of the abort
+ */
+static void trdp_mdStreamAbort (TRDP_SESSION_PT appHandle,
+                                UINT32          socketIndex,
+                                TRDP_ERR_T      resultCode)
+{
+    MD_STREAM_T *pStream = appHandle->pMDStream[socketIndex];
+
+    if (pStream != NULL)
+    {
+        vos_printLog(VOS_LOG_WARNING, "Streamed TCP MD notification aborted after %u bytes (Err: %d)\n",
+                     pStream->offset, resultCode);
+        appHandle->pMDStream[socketIndex] = NULL;
+        trdp_mdStreamCallback(appHandle, pStream, NULL, 0u, resultCode);
+        vos_memFree(pStream);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Read the available data of a streamed TCP notification and hand it to the listener
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      socketIndex     index of the TCP socket
+ *
+ *  @retval         TRDP_NO_ERR     no error (also if no data was available)
+ *  @retval         != TRDP_NO_ERR  the connection failed, the stream was aborted
+ */
+static TRDP_ERR_T trdp_mdStreamRecv (TRDP_SESSION_PT    appHandle,
+                                     UINT32             socketIndex)
+{
+    MD_STREAM_T *pStream    = appHandle->pMDStream[socketIndex];
+    UINT32      totalLength = vos_ntohl(pStream->frameHead.datasetLength);
+    UINT32      readSize;
+    UINT32      chunkSize;
+    TRDP_ERR_T  err;
+
+    do
+    {
+        readSize = (pStream->remaining < TRDP_MD_STREAM_CHUNK_SIZE) ? pStream->remaining : TRDP_MD_STREAM_CHUNK_SIZE;
+        err = (TRDP_ERR_T) vos_sockReceiveTCP(pStream->sock, pStream->chunk, &readSize);
+
+        if (readSize > 0u)
         {
-            /* fatal communication issue, exit function */
-            return err;
+            pStream->remaining -= readSize;
+
+            /* the padding is not handed over */
+            chunkSize = totalLength - pStream->offset;
+            if (chunkSize > readSize)
+            {
+                chunkSize = readSize;
+            }
+            if (chunkSize > 0u)
+            {
+                trdp_mdStreamCallback(appHandle, pStream, pStream->chunk, chunkSize, TRDP_NO_ERR);
+                pStream->offset += chunkSize;
+            }
         }
-        /* use the UDP statisctic structure for storing */
-        /* the trdp_mdCheck result                      */
-        pElementStatistics = &appHandle->stats.udpMd;
     }
-    /* Step 2: Check the received buffer for data con-   */
-    /* sistency and TRDP protocol coherency              */
-    err = trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, pElement->grossSize, CHECK_DATA_TOO);
-    /* Step 3: Update the statistics structure counters  */
-    /* according the trdp_mdCheck result                 */
-    switch (err)
+    while ((err == TRDP_NO_ERR) && (readSize > 0u) && (pStream->remaining > 0u));
+
+    if (pStream->remaining == 0u)
     {
-       case TRDP_NO_ERR:
-           pElementStatistics->numRcv++;
-           break;
-       case TRDP_CRC_ERR:
-           pElementStatistics->numCrcErr++;
-           break;
-       case TRDP_WIRE_ERR:
-           pElementStatistics->numProtErr++;
-           break;
-       case TRDP_TOPO_ERR:
-           pElementStatistics->numTopoErr++;
-           break;
-       default:
-           ;
+        /* message complete */
+        TRDP_STATS_INC(appHandle, tcpMd.numRcv);
+        appHandle->pMDStream[socketIndex] = NULL;
+        vos_memFree(pStream);
+        return TRDP_NO_ERR;
     }
 
-    if (err != TRDP_NO_ERR)
+    if ((err == TRDP_NO_ERR) || (err == TRDP_BLOCK_ERR))
     {
-        vos_printLog(VOS_LOG_ERROR, "trdp_mdCheck %s failed (Err: %d)\n",
-                     (pElement->pktFlags & TRDP_FLAGS_TCP) ? "TCP" : "UDP", err);
+        return TRDP_NO_ERR;
     }
 
+    trdp_mdStreamAbort(appHandle, socketIndex, err);
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Free the state of all streamed TCP notifications of a session (without callback)
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_mdStreamFree (
+    TRDP_SESSION_PT appHandle)
+{
+    UINT32 i;
+
+    for (i = 0u; i < VOS_MAX_SOCKET_CNT; i++)
+    {
+        if (appHandle->pMDStream[i] != NULL)
+        {
+            vos_memFree(appHandle->pMDStream[i]);
+            appHandle->pMDStream[i] = NULL;
+        }
+    }
+}
+#endif
+
+#if TRDP_MD_UDP_SEG_SIZE > 0
+/**********************************************************************************************************************/
+/** Free the segment buffers of a session (TRDP_OPTION_MD_UDP_SEGMENT)
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_mdUdpSegFree (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pMDUdpSeg != NULL)
+    {
+        vos_memFree(appHandle->pMDUdpSeg);
+        appHandle->pMDUdpSeg = NULL;
+    }
+}
+#endif
+
 /**********************************************************************************************************************/
 /** Handle incoming request message - private SW level
  *
@@ -1528,7 +2634,7 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
                                         TRDP_MD_ELE_ST_T    state,
                                         MD_ELE_T            * *pIterMD)
 {
-    UINT32 numOfReceivers = 0u;
+    UINT32 numOfReceivers = appHandle->numMDRcvSessions;
     MD_LIS_ELE_T    *iterListener   = NULL;
     TRDP_ERR_T      result          = TRDP_NO_ERR;
     MD_ELE_T        *iterMD         = NULL;
@@ -1539,9 +2645,10 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
     /* Search for existing session (in case it is a repeated request)  */
     /* This is kind of error detection/comm issue remedy functionality */
     /* running ahead of further logic */
-    for ( iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext )
+    for ( iterMD = trdp_MDqueueFindSession(appHandle, &appHandle->pMDRcvQueue, pH->sessionID, NULL);
+          iterMD != NULL;
+          iterMD = trdp_MDqueueFindSession(appHandle, &appHandle->pMDRcvQueue, pH->sessionID, iterMD))
     {
-        numOfReceivers++; /* count the list items here */
         if ( 0 == memcmp(iterMD->pPacket->frameHead.sessionID, pH->sessionID, TRDP_SESS_ID_SIZE))
         {
             /* According IEC61375-2-3 A.7.7.1 */
@@ -1592,6 +2699,7 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
                 /* Store new sequence counter within the management info */
                 /* Set new time out value */
                 vos_addTime(&iterMD->timeToGo, &iterMD->interval);
+                trdp_mdSchedUpdate(appHandle, iterMD);
                 /* update the frame header CRC also */
                 trdp_mdUpdatePacket(iterMD);
                 /* ready to proceed - will be handled by trdp_mdSend run- */
@@ -1614,120 +2722,46 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
     iterMD = NULL; /* reset item for the actual lookup task */
 
     /* search for existing listener */
-    for ( iterListener = appHandle->pMDListenQueue; iterListener != NULL;
-          iterListener = iterListener->pNext )
+    iterListener = trdp_mdFindListener(appHandle, pH, isTCP,
+                                       appHandle->pMDRcvEle->addr.srcIpAddr,
+                                       appHandle->pMDRcvEle->addr.destIpAddr);
+    if (iterListener != NULL)
     {
-        if ((iterListener->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
-            (isTCP == TRUE))
-        {
-            continue;
-        }
-
-        /* Ticket #206: TCP requests should use TCP listeners only */
-        if ((iterListener->pktFlags & TRDP_FLAGS_TCP) && (isTCP == FALSE))
-        {
-            continue;
-        }
-
-        /* Ticket #180: Do the filtering as the standard demands */
-
-        /* If comID does not match but should, continue */
-        if (((iterListener->privFlags & TRDP_CHECK_COMID) != 0) &&
-            (vos_ntohl(pH->comId) != iterListener->addr.comId))
-        {
-            continue;
-        }
-
-        /* check the source URI if set  */
-        if ((iterListener->srcURI[0] != 0) &&
-            (!trdp_isAddressed(iterListener->srcURI, (CHAR8 *) pH->sourceURI)))
-        {
-            continue;
-        }
-
-        /* check the destination URI if set  */
-        if ((iterListener->destURI[0] != 0) &&
-            (!trdp_isAddressed(iterListener->destURI, (CHAR8 *) pH->destinationURI)))
-        {
-            continue;
-        }
+        /* We found a listener, set some values for this new session  */
+        iterMD = appHandle->pMDRcvEle;
+        iterMD->pUserRef = iterListener->pUserRef;
+        iterMD->pfCbFunction        = iterListener->pfCbFunction;
+        iterMD->stateEle            = state;
+        iterMD->addr.etbTopoCnt     = iterListener->addr.etbTopoCnt;
+        iterMD->addr.opTrnTopoCnt   = iterListener->addr.opTrnTopoCnt;
+        iterMD->pktFlags            = iterListener->pktFlags;           /* BL: This was missing! */
 
-        /* check topocounts before comparing source or destination IP addresses! */
-        /* Step 1: here we need to check the topccounts */
-        /* in case of train communication (topo counters != zero) check topo validity of recvd message and */
-        /* recv queue item by matching the etbTopoCnt and opTrnTopoCnt                                     */
-        if (((pH->etbTopoCnt != 0u) || (pH->opTrnTopoCnt != 0u))
-            && (!trdp_validTopoCounters( vos_ntohl(pH->etbTopoCnt),
-                                         vos_ntohl(pH->opTrnTopoCnt),
-                                         iterListener->addr.etbTopoCnt,
-                                         iterListener->addr.opTrnTopoCnt)))
-        {
-            continue;
-        }
 
-        /* If multicast address is set, but does not match, we go to the next listener (if any) */
-        if ((iterListener->addr.mcGroup != 0u) &&
-            (iterListener->addr.mcGroup != appHandle->pMDRcvEle->addr.destIpAddr))
-        {
-            /* no IP match for unicast addressing */
-            continue;
-        }
+        /* Count this Request/Notification as new session */
+        iterListener->numSessions++;
 
-        /* if source IP given (and no range) */
-        if ((iterListener->addr.srcIpAddr2 == 0) &&
-            (iterListener->addr.srcIpAddr != 0) &&
-            (iterListener->addr.srcIpAddr != appHandle->pMDRcvEle->addr.srcIpAddr))
+        if ( iterListener->socketIdx == TRDP_INVALID_SOCKET_INDEX ) /* On TCP, listeners have no socket
+           assigned  */
         {
-            continue;
+            iterMD->socketIdx = (INT32) sockIndex;
         }
-
-        /* if source IP given and is within given IP range */
-        if ((iterListener->addr.srcIpAddr != 0) &&
-            (iterListener->addr.srcIpAddr2 != 0) &&
-            (!trdp_isInIPrange(appHandle->pMDRcvEle->addr.srcIpAddr,
-                               iterListener->addr.srcIpAddr,
-                               iterListener->addr.srcIpAddr2)))
+        else
         {
-            continue;
+            iterMD->socketIdx = iterListener->socketIdx;
         }
 
-        /* If we come here, it is the right listener! */
-        {
-            /* We found a listener, set some values for this new session  */
-            iterMD = appHandle->pMDRcvEle;
-            iterMD->pUserRef = iterListener->pUserRef;
-            iterMD->pfCbFunction        = iterListener->pfCbFunction;
-            iterMD->stateEle            = state;
-            iterMD->addr.etbTopoCnt     = iterListener->addr.etbTopoCnt;
-            iterMD->addr.opTrnTopoCnt   = iterListener->addr.opTrnTopoCnt;
-            iterMD->pktFlags            = iterListener->pktFlags;           /* BL: This was missing! */
-
-
-            /* Count this Request/Notification as new session */
-            iterListener->numSessions++;
-
-            if ( iterListener->socketIdx == TRDP_INVALID_SOCKET_INDEX ) /* On TCP, listeners have no socket
-               assigned  */
-            {
-                iterMD->socketIdx = (INT32) sockIndex;
-            }
-            else
-            {
-                iterMD->socketIdx = iterListener->socketIdx;
-            }
-
-            trdp_MDqueueInsFirst(&appHandle->pMDRcvQueue, iterMD);
+        /* the session ID is the key of the session index */
+        memcpy(iterMD->sessionID, pH->sessionID, TRDP_SESS_ID_SIZE);
+        trdp_MDqueueInsSession(appHandle, &appHandle->pMDRcvQueue, iterMD, FALSE);
 
-            appHandle->pMDRcvEle = NULL;
+        appHandle->pMDRcvEle = NULL;
 
-            vos_printLog(VOS_LOG_INFO,
-                         "Creating %s MD replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
-                         iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
-                         pH->sessionID[0], pH->sessionID[1], pH->sessionID[2],
-                         pH->sessionID[3], pH->sessionID[4], pH->sessionID[5],
-                         pH->sessionID[6], pH->sessionID[7]);
-            break;
-        }
+        vos_printLog(VOS_LOG_INFO,
+                     "Creating %s MD replier session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
+                     iterMD->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
+                     pH->sessionID[0], pH->sessionID[1], pH->sessionID[2],
+                     pH->sessionID[3], pH->sessionID[4], pH->sessionID[5],
+                     pH->sessionID[6], pH->sessionID[7]);
     }
     if ( NULL != iterMD )
     {
@@ -1752,6 +2786,7 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
             iterMD->interval.tv_usec    = vos_ntohl(pH->replyTimeout) % 1000000;
             vos_addTime(&iterMD->timeToGo, &iterMD->interval);
         }
+        trdp_mdSchedUpdate(appHandle, iterMD);
         /* save session Id and sequence counter for next steps */
         memcpy(iterMD->sessionID, pH->sessionID, TRDP_SESS_ID_SIZE);
         /* save source URI for reply */
@@ -1762,11 +2797,11 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
         /*this should be the place to add the Me call*/
         if ( isTCP == TRUE )
         {
-            appHandle->stats.tcpMd.numNoListener++;
+            TRDP_STATS_INC(appHandle, tcpMd.numNoListener);
         }
         else
         {
-            appHandle->stats.udpMd.numNoListener++;
+            TRDP_STATS_INC(appHandle, udpMd.numNoListener);
         }
         vos_printLogStr(VOS_LOG_INFO, "trdp_mdRecv: No listener found!\n");
         result = TRDP_NOLIST_ERR;
@@ -1817,11 +2852,10 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
     {
         /* we have found the MD_ELE_T */
         /* Room for MD element */
-        pSenderElement = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+        pSenderElement = trdp_mdAllocElement(appHandle);
         /* Reset descriptor value */
         if ( NULL != pSenderElement )
         {
-            memset(pSenderElement, 0, sizeof(MD_ELE_T));
             pSenderElement->addr.comId = 0u;
             pSenderElement->addr.srcIpAddr      = mdElement->addr.destIpAddr;
             pSenderElement->addr.destIpAddr     = mdElement->addr.srcIpAddr;
@@ -1855,16 +2889,10 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
                  (Re-)allocate the data buffer if current size is different from requested size.
                  If no data at all, free data pointer
                  */
-                if ( NULL != pSenderElement->pPacket )
-                {
-                    vos_memFree(pSenderElement->pPacket);
-                    pSenderElement->pPacket = NULL;
-                }
                 /* allocate a buffer for the data   */
-                pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
-                if ( NULL == pSenderElement->pPacket )
+                if ( NULL == trdp_mdAllocPacket(appHandle, pSenderElement, pSenderElement->grossSize) )
                 {
-                    vos_memFree(pSenderElement);
+                    trdp_mdFreeSession(appHandle, pSenderElement);
                     pSenderElement = NULL;
                     errv = TRDP_MEM_ERR;
 
@@ -1894,7 +2922,7 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
         if ( TRDP_NO_ERR != errv &&
              NULL != pSenderElement )
         {
-            trdp_mdFreeSession(pSenderElement);
+            trdp_mdFreeSession(appHandle, pSenderElement);
             pSenderElement = NULL;
         }
     }
@@ -1942,7 +2970,7 @@ static TRDP_ERR_T  trdp_mdRecv (
     /* get buffer if none available */
     if (appHandle->pMDRcvEle == NULL)
     {
-        appHandle->pMDRcvEle = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+        appHandle->pMDRcvEle = trdp_mdAllocElement(appHandle);
         if (NULL != appHandle->pMDRcvEle)
         {
             appHandle->pMDRcvEle->pPacket   = NULL; /* (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize); */
@@ -1968,10 +2996,8 @@ static TRDP_ERR_T  trdp_mdRecv (
 
     if (appHandle->pMDRcvEle->pPacket == NULL)
     {
-        /* Malloc the minimum size for now */
-        appHandle->pMDRcvEle->pPacket = (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize);
-
-        if (appHandle->pMDRcvEle->pPacket == NULL)
+        /* Get the minimum size for now, from the pool if it fits */
+        if (trdp_mdAllocPacket(appHandle, appHandle->pMDRcvEle, cMinimumMDSize) == NULL)
         {
             vos_memFree(appHandle->pMDRcvEle);
             appHandle->pMDRcvEle = NULL;
@@ -1980,9 +3006,30 @@ static TRDP_ERR_T  trdp_mdRecv (
         }
     }
 
+#if TRDP_MD_STREAM_CHUNK_SIZE > 0
+    /* The data of a streamed notification is read directly into its chunk buffer */
+    if (isTCP && (appHandle->pMDStream[sockIndex] != NULL))
+    {
+        if (appHandle->pMDStream[sockIndex]->sock == appHandle->iface[sockIndex].sock)
+        {
+            return trdp_mdStreamRecv(appHandle, sockIndex);
+        }
+        /* the connection has been replaced */
+        trdp_mdStreamAbort(appHandle, sockIndex, TRDP_NOCONN_ERR);
+    }
+#endif
+
     /* get packet: */
     result = trdp_mdRecvPacket(appHandle, appHandle->iface[sockIndex].sock, appHandle->pMDRcvEle);
 
+#if TRDP_MD_STREAM_CHUNK_SIZE > 0
+    if (isTCP && (result == TRDP_PACKET_ERR) && (appHandle->pMDStream[sockIndex] != NULL))
+    {
+        /* the header started a streamed notification, go on with its data */
+        return trdp_mdStreamRecv(appHandle, sockIndex);
+    }
+#endif
+
     if (result != TRDP_NO_ERR)
     {
         return result;
@@ -1991,6 +3038,8 @@ static TRDP_ERR_T  trdp_mdRecv (
     /* process message */
     pH = &appHandle->pMDRcvEle->pPacket->frameHead;
 
+    TRDP_TRACE2(md_receive, vos_ntohl(pH->comId), vos_ntohl(pH->datasetLength));
+
     vos_printLog(VOS_LOG_INFO,
                  "Received %s MD packet (type: '%c%c' UUID: %02x%02x%02x%02x%02x%02x%02x%02x Data len: %u)\n",
                  appHandle->pMDRcvEle->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
@@ -2011,6 +3060,9 @@ static TRDP_ERR_T  trdp_mdRecv (
     {
         appHandle->pMDRcvEle->addr.srcIpAddr = appHandle->iface[sockIndex].tcpParams.cornerIp;
     }
+    TRDP_REC(appHandle, isTCP ? TRDP_REC_TCP_RX : TRDP_REC_MD_RX, appHandle->pMDRcvEle->addr.srcIpAddr,
+             appHandle->pMDRcvEle->addr.destIpAddr, isTCP ? appHandle->mdDefault.tcpPort : appHandle->mdDefault.udpPort,
+             pH, appHandle->pMDRcvEle->grossSize);
 
     state = TRDP_ST_RX_REQ_W4AP_REPLY;
 
@@ -2058,6 +3110,17 @@ static TRDP_ERR_T  trdp_mdRecv (
            break;
     }
 
+    /* Collected replies are handed over when the last expected one arrived or the session timed out */
+    if ((NULL != iterMD) && (vos_ntohs(pH->msgType) == TRDP_MSG_MP)
+        && ((iterMD->pktFlags & TRDP_FLAGS_MD_COLLECT) != 0))
+    {
+        trdp_mdCollectReply(iterMD);
+        if (iterMD->morituri == FALSE)
+        {
+            return TRDP_NO_ERR;
+        }
+    }
+
     /* Inform user  */
     if (NULL != iterMD && iterMD->pfCbFunction != NULL)
     {
@@ -2103,6 +3166,11 @@ TRDP_ERR_T trdp_mdGetTCPSocket (
         trdp_sock_opt.ttl_multicast = 0u;
         trdp_sock_opt.reuseAddrPort = TRUE;
         trdp_sock_opt.no_mc_loop    = FALSE;
+        trdp_sock_opt.txTime        = FALSE;
+        trdp_sock_opt.rxTime        = FALSE;
+        trdp_sock_opt.busyPoll      = 0u;
+        trdp_sock_opt.tcpNoDelay    = TRUE;
+        trdp_sock_opt.udpGro        = FALSE;
 
         /* The socket is defined non-blocking */
         trdp_sock_opt.nonBlocking = TRUE;
@@ -2113,48 +3181,242 @@ TRDP_ERR_T trdp_mdGetTCPSocket (
         {
             return result;
         }
-
-        result = (TRDP_ERR_T)vos_sockBind(pSession->tcpFd.listen_sd,
-                                          pSession->realIP,
-                                          pSession->mdDefault.tcpPort);
-
-        if (result != TRDP_NO_ERR)
+
+        result = (TRDP_ERR_T)vos_sockBind(pSession->tcpFd.listen_sd,
+                                          pSession->realIP,
+                                          pSession->mdDefault.tcpPort);
+
+        if (result != TRDP_NO_ERR)
+        {
+            return result;
+        }
+
+        result = (TRDP_ERR_T)vos_sockListen(pSession->tcpFd.listen_sd, backlog);
+
+        if (result != TRDP_NO_ERR)
+        {
+            return result;
+        }
+
+        vos_printLog(VOS_LOG_INFO, "TCP socket opened and listening (Socket: %d, Port: %u)\n",
+                     (int) pSession->tcpFd.listen_sd, (unsigned int) pSession->mdDefault.tcpPort);
+
+        return TRDP_NO_ERR;
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Get an MD element, from the pool of free elements if possible
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         zeroed element, NULL if out of memory
+ */
+MD_ELE_T *trdp_mdAllocElement (
+    TRDP_SESSION_PT appHandle)
+{
+    MD_ELE_T *pElement = appHandle->pMDElePool;
+
+    if (pElement != NULL)
+    {
+        appHandle->pMDElePool = pElement->pNext;
+        appHandle->mdPoolStats.numEleFree--;
+        appHandle->mdPoolStats.numEleHit++;
+        memset(pElement, 0, sizeof(MD_ELE_T));
+    }
+    else
+    {
+        pElement = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+        appHandle->mdPoolStats.numEleAlloc++;
+    }
+    return pElement;
+}
+
+/**********************************************************************************************************************/
+/** Replace the packet buffer of an MD element by a new one
+ *  Buffers for up to TRDP_MD_POOL_DATA_SIZE bytes of data are taken from the pool of free frames if possible.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pElement            element getting the buffer, its old buffer is released
+ *  @param[in]      size                size of the buffer
+ *
+ *  @retval         zeroed buffer, NULL if out of memory
+ */
+static MD_PACKET_T *trdp_mdAllocPacket (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement,
+    UINT32          size)
+{
+    trdp_mdReleasePacket(appHandle, pElement);
+
+    if ((TRDP_MD_POOL_DATA_SIZE > 0u) && (size <= trdp_packetSizeMD(TRDP_MD_POOL_DATA_SIZE)))
+    {
+        if (appHandle->pMDFramePool != NULL)
+        {
+            pElement->pPacket           = (MD_PACKET_T *) appHandle->pMDFramePool;
+            appHandle->pMDFramePool     = *(void * *) appHandle->pMDFramePool;
+            appHandle->mdPoolStats.numFrameFree--;
+            appHandle->mdPoolStats.numFrameHit++;
+            memset(pElement->pPacket, 0, size);
+        }
+        else
+        {
+            /* always the pool frame size, so it can be reused for any small message */
+            pElement->pPacket = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(TRDP_MD_POOL_DATA_SIZE));
+            appHandle->mdPoolStats.numFrameAlloc++;
+        }
+        pElement->poolPacket = (pElement->pPacket != NULL) ? TRUE : FALSE;
+    }
+    else
+    {
+        pElement->pPacket = (MD_PACKET_T *) vos_memAlloc(size);
+    }
+    return pElement->pPacket;
+}
+
+/**********************************************************************************************************************/
+/** Release the packet buffer of an MD element
+ *  Pool frames are kept for reuse up to the maximum number of sessions.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pElement            element to release the buffer of
+ */
+static void trdp_mdReleasePacket (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    if (pElement->pPacket == NULL)
+    {
+        return;
+    }
+    if ((pElement->poolPacket == TRUE) && (appHandle->mdPoolStats.numFrameFree < appHandle->mdDefault.maxNumSessions))
+    {
+        *(void * *) pElement->pPacket   = appHandle->pMDFramePool;
+        appHandle->pMDFramePool         = pElement->pPacket;
+        appHandle->mdPoolStats.numFrameFree++;
+    }
+    else
+    {
+        vos_memFree(pElement->pPacket);
+    }
+    pElement->pPacket       = NULL;
+    pElement->poolPacket    = FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Free memory of session
+ *  The element is kept for reuse up to the maximum number of sessions.
+ *
+ *  @param[in]      appHandle         session pointer
+ *  @param[in]      pMDSession        MD element
+ */
+void trdp_mdFreeSession (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pMDSession)
+{
+    if (NULL != pMDSession)
+    {
+        trdp_mdReleasePacket(appHandle, pMDSession);
+        if (NULL != pMDSession->pCollect)
+        {
+            if (NULL != pMDSession->pCollect->pReplies)
+            {
+                vos_memFree(pMDSession->pCollect->pReplies);
+            }
+            if (NULL != pMDSession->pCollect->pData)
+            {
+                vos_memFree(pMDSession->pCollect->pData);
+            }
+            vos_memFree(pMDSession->pCollect);
+            pMDSession->pCollect = NULL;
+        }
+        if (appHandle->mdPoolStats.numEleFree < appHandle->mdDefault.maxNumSessions)
         {
-            return result;
+            pMDSession->pNext       = appHandle->pMDElePool;
+            appHandle->pMDElePool   = pMDSession;
+            appHandle->mdPoolStats.numEleFree++;
         }
-
-        result = (TRDP_ERR_T)vos_sockListen(pSession->tcpFd.listen_sd, backlog);
-
-        if (result != TRDP_NO_ERR)
+        else
         {
-            return result;
+            vos_memFree(pMDSession);
         }
+    }
+}
 
-        vos_printLog(VOS_LOG_INFO, "TCP socket opened and listening (Socket: %d, Port: %u)\n",
-                     (int) pSession->tcpFd.listen_sd, (unsigned int) pSession->mdDefault.tcpPort);
+/**********************************************************************************************************************/
+/** Free the MD elements and frames kept for reuse
+ *
+ *  @param[in]      appHandle         session pointer
+ */
+void trdp_mdPoolFree (
+    TRDP_SESSION_PT appHandle)
+{
+    while (appHandle->pMDElePool != NULL)
+    {
+        MD_ELE_T *pNext = appHandle->pMDElePool->pNext;
 
-        return TRDP_NO_ERR;
+        vos_memFree(appHandle->pMDElePool);
+        appHandle->pMDElePool = pNext;
     }
+    while (appHandle->pMDFramePool != NULL)
+    {
+        void *pNext = *(void * *) appHandle->pMDFramePool;
 
-    return result;
+        vos_memFree(appHandle->pMDFramePool);
+        appHandle->pMDFramePool = pNext;
+    }
+    appHandle->mdPoolStats.numEleFree   = 0u;
+    appHandle->mdPoolStats.numFrameFree = 0u;
 }
 
 /**********************************************************************************************************************/
-/** Free memory of session
+/** Fill the pools of MD elements and frames up to the maximum number of sessions
+ *  The timeout schedule is enlarged for the pooled elements, too. Afterwards, MD sessions with up to
+ *  TRDP_MD_POOL_DATA_SIZE bytes of data are handled without allocating memory.
  *
- *  @param[in]      pMDSession        session pointer
+ *  @param[in]      appHandle         session pointer
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
  */
-void trdp_mdFreeSession (
-    MD_ELE_T *pMDSession)
+TRDP_ERR_T trdp_mdPoolFill (
+    TRDP_SESSION_PT appHandle)
 {
-    if (NULL != pMDSession)
+    while (appHandle->mdPoolStats.numEleFree < appHandle->mdDefault.maxNumSessions)
+    {
+        MD_ELE_T *pElement = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+
+        if (pElement == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        appHandle->mdPoolStats.numEleAlloc++;
+        pElement->pNext         = appHandle->pMDElePool;
+        appHandle->pMDElePool   = pElement;
+        appHandle->mdPoolStats.numEleFree++;
+    }
+    while ((TRDP_MD_POOL_DATA_SIZE > 0u) &&
+           (appHandle->mdPoolStats.numFrameFree < appHandle->mdDefault.maxNumSessions))
     {
-        if (NULL != pMDSession->pPacket)
+        void *pFrame = vos_memAlloc(trdp_packetSizeMD(TRDP_MD_POOL_DATA_SIZE));
+
+        if (pFrame == NULL)
         {
-            vos_memFree(pMDSession->pPacket);
+            return TRDP_MEM_ERR;
         }
-        vos_memFree(pMDSession);
+        appHandle->mdPoolStats.numFrameAlloc++;
+        *(void * *) pFrame      = appHandle->pMDFramePool;
+        appHandle->pMDFramePool = pFrame;
+        appHandle->mdPoolStats.numFrameFree++;
     }
+#if TRDP_MD_TIMEOUT_SCHEDULER
+    /* every pooled element may be scheduled in addition to the current sessions */
+    return trdp_mdSchedReserve(appHandle, appHandle->mdSchedCnt + appHandle->mdPoolStats.numEleFree);
+#else
+    return TRDP_NO_ERR;
+#endif
 }
 
 /**********************************************************************************************************************/
@@ -2170,6 +3432,16 @@ TRDP_ERR_T  trdp_mdSend (
     TRDP_ERR_T  result      = TRDP_NO_ERR;
     MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
     BOOL8       firstLoop   = TRUE;
+#if TRDP_MD_TCP_CORK
+    UINT32      noOfTcpMsgs = trdp_mdCork(appHandle);
+#endif
+
+#if TRDP_MD_UDP_SEG_SIZE > 0
+    if ((appHandle->option & TRDP_OPTION_MD_UDP_SEGMENT) != 0)
+    {
+        trdp_mdSendUdpSeg(appHandle);
+    }
+#endif
 
     /*  Find the packet which has to be sent next:
      Note: We must also check the receive queue for pending replies! */
@@ -2223,7 +3495,11 @@ TRDP_ERR_T  trdp_mdSend (
             /*    Send the packet if it is not redundant    */
             else if (!(iterMD->privFlags & TRDP_REDUNDANT))
             {
-                trdp_mdUpdatePacket(iterMD);
+                /* the header FCS of a retransmission is already updated */
+                if ((iterMD->stateEle != TRDP_ST_TX_REQUEST_ARM) || (iterMD->numRetries == 0u))
+                {
+                    trdp_mdUpdatePacket(iterMD);
+                }
 
                 if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
                 {
@@ -2237,6 +3513,7 @@ TRDP_ERR_T  trdp_mdSend (
                         if (err == VOS_NO_ERR)
                         {
                             iterMD->tcpParameters.doConnect = FALSE;
+                            appHandle->iface[iterMD->socketIdx].tcpParams.connected = TRUE;
                             vos_printLog(VOS_LOG_INFO,
                                          "Opened TCP connection to %s (Socket: %d, Port: %u)\n",
                                          vos_ipDotted(iterMD->addr.destIpAddr),
@@ -2250,6 +3527,7 @@ TRDP_ERR_T  trdp_mdSend (
                                          (int)appHandle->iface[iterMD->socketIdx].sock,
                                          (unsigned int)appHandle->mdDefault.tcpPort);
                             iterMD->tcpParameters.doConnect = FALSE;
+                            appHandle->iface[iterMD->socketIdx].tcpParams.connected = TRUE;
                             iterMD = iterMD->pNext;
                             continue;
                         }
@@ -2307,6 +3585,22 @@ TRDP_ERR_T  trdp_mdSend (
                                                    iterMD);
                     }
 
+#if TRDP_RECORDER
+                    if ((result == TRDP_NO_ERR) && (appHandle->pRecorder != NULL))
+                    {
+                        BOOL8 inPlace = ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0) && (iterMD->pUserData != NULL);
+
+                        trdp_recWrite(appHandle->pRecorder,
+                                      ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0) ? TRDP_REC_TCP_TX : TRDP_REC_MD_TX,
+                                      appHandle->realIP, iterMD->addr.destIpAddr,
+                                      ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0) ? appHandle->mdDefault.tcpPort :
+                                      (iterMD->replyPort != 0u) ? iterMD->replyPort : appHandle->mdDefault.udpPort,
+                                      (const UINT8 *)&iterMD->pPacket->frameHead,
+                                      inPlace ? sizeof(MD_HEADER_T) : iterMD->grossSize,
+                                      inPlace ? iterMD->pUserData : NULL,
+                                      inPlace ? iterMD->dataSize : 0u);
+                    }
+#endif
                     if (result == TRDP_NO_ERR)
                     {
                         if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
@@ -2314,16 +3608,27 @@ TRDP_ERR_T  trdp_mdSend (
                             appHandle->iface[iterMD->socketIdx].tcpParams.notSend = FALSE;
                             iterMD->tcpParameters.msgUncomplete = FALSE;
                             appHandle->iface[iterMD->socketIdx].tcpParams.sendNotOk = FALSE;
+                            trdp_mdTxDequeue(appHandle, iterMD);
 
                             /* Add the socket in the file descriptor*/
                             appHandle->iface[iterMD->socketIdx].tcpParams.addFileDesc = TRUE;
                             /* increment transmission counter for TCP */
-                            appHandle->stats.tcpMd.numSend++;
+                            TRDP_STATS_INC(appHandle, tcpMd.numSend);
+
+                            /* user buffer sent in place: hand it back to the application */
+                            if (iterMD->pUserData != NULL)
+                            {
+                                if (iterMD->pfCbFunction != NULL)
+                                {
+                                    trdp_mdInvokeCallback(iterMD, appHandle, TRDP_NO_ERR);
+                                }
+                                iterMD->pUserData = NULL;
+                            }
                         }
                         else
                         {
                             /* increment transmission counter for UDP */
-                            appHandle->stats.udpMd.numSend++;
+                            TRDP_STATS_INC(appHandle, udpMd.numSend);
                         }
 
                         if (nextstate == TRDP_ST_RX_REPLYQUERY_W4C)
@@ -2331,8 +3636,20 @@ TRDP_ERR_T  trdp_mdSend (
                             /* Update timeout */
                             vos_getTime(&iterMD->timeToGo);
                             vos_addTime(&iterMD->timeToGo, &iterMD->interval);
+                            trdp_mdSchedUpdate(appHandle, iterMD);
                             vos_printLogStr(VOS_LOG_INFO, "Setting timeout for confirmation!\n");
                         }
+#if TRDP_TIMING_STATS
+                        if ((iterMD->stateEle == TRDP_ST_TX_REQUEST_ARM) &&
+                            (appHandle->option & TRDP_OPTION_TIMING_STATS))
+                        {
+                            vos_getTime(&iterMD->sendTime);     /* start of the round trip */
+                            if (iterMD->numRetries == 0u)
+                            {
+                                iterMD->firstSendTime = iterMD->sendTime;
+                            }
+                        }
+#endif
 
                         switch (iterMD->stateEle)
                         {
@@ -2373,9 +3690,10 @@ TRDP_ERR_T  trdp_mdSend (
                     }
                     else
                     {
-                        if (result == TRDP_IO_ERR)
+                        if ((result == TRDP_IO_ERR)
+                            || ((result == TRDP_BLOCK_ERR) && ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)))
                         {
-                            /* Send uncompleted */
+                            /* Send uncompleted, also if the send buffer is full (EWOULDBLOCK) */
                             if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
                             {
                                 appHandle->iface[iterMD->socketIdx].tcpParams.notSend = TRUE;
@@ -2431,6 +3749,12 @@ TRDP_ERR_T  trdp_mdSend (
     }
     while (TRUE); /*lint !e506 */
 
+#if TRDP_MD_TCP_CORK
+    if (noOfTcpMsgs > 0u)
+    {
+        trdp_mdUncork(appHandle);
+    }
+#endif
     trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
 
     return result;
@@ -2439,9 +3763,10 @@ TRDP_ERR_T  trdp_mdSend (
 
 /******************************************************************************/
 /** Check for pending packets, set FD if non blocking
+ *  With TRDP_MD_TIMEOUT_SCHEDULER the next MD timeout is also taken into account for the next job time.
  *
  *  @param[in]      appHandle           session pointer
- *  @param[in,out]  pFileDesc           pointer to set of ready descriptors
+ *  @param[in,out]  pFileDesc           pointer to set of ready descriptors, NULL: next job time only
  *  @param[in,out]  pNoDesc             pointer to number of ready descriptors
  */
 
@@ -2454,6 +3779,27 @@ void trdp_mdCheckPending (
     MD_ELE_T *iterMD;
     MD_LIS_ELE_T *iterListener;
 
+#if TRDP_MD_TIMEOUT_SCHEDULER
+    /*    The earliest MD timeout, unless it already expired without being handled    */
+    if ((appHandle->mdSchedCnt > 0u) && (appHandle->mdSchedIncomplete == FALSE))
+    {
+        TRDP_TIME_T         now;
+        const TRDP_TIME_T   *pNext = &appHandle->pMDSched[0]->timeToGo;
+
+        vos_getTime(&now);
+        if (timercmp(pNext, &now, >) &&
+            (!timerisset(&appHandle->nextJob) || timercmp(pNext, &appHandle->nextJob, <)))
+        {
+            appHandle->nextJob = *pNext;
+        }
+    }
+#endif
+
+    if (pFileDesc == NULL)
+    {
+        return;
+    }
+
     /*    Add the socket to the pFileDesc    */
     if (appHandle->tcpFd.listen_sd != VOS_INVALID_SOCKET)
     {
@@ -2553,6 +3899,260 @@ void trdp_mdCheckPending (
 }
 
 
+/**********************************************************************************************************************/
+/** Accept all incoming connections queued up on the TCP listening socket
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pRfds               pointer to set of ready descriptors, may be NULL
+ *  @param[in,out]  pCount              pointer to number of ready descriptors, may be NULL
+ */
+void trdp_mdAccept (
+    const TRDP_SESSION_PT   appHandle,
+    TRDP_FDS_T              *pRfds,
+    INT32                   *pCount)
+{
+    TRDP_ERR_T  err;
+    SOCKET      new_sd = VOS_INVALID_SOCKET;
+
+    /*************************************************/
+    /* Accept all incoming connections that are      */
+    /* queued up on the listening socket.            */
+    /*************************************************/
+    do
+    {
+        /**********************************************/
+        /* Accept each incoming connection.           */
+        /* Check any failure on accept                */
+        /**********************************************/
+        TRDP_IP_ADDR_T  newIp;
+        UINT16          read_tcpPort;
+
+        newIp = appHandle->realIP;
+        read_tcpPort = appHandle->mdDefault.tcpPort;
+
+        err = (TRDP_ERR_T) vos_sockAccept(appHandle->tcpFd.listen_sd,
+                                          &new_sd, &newIp,
+                                          &(read_tcpPort));
+
+        if (new_sd < 0)
+        {
+            if (err == TRDP_NO_ERR)
+            {
+                break;
+            }
+            else
+            {
+                vos_printLog(VOS_LOG_ERROR, "vos_sockAccept() failed (Err: %d, Socket: %d, Port: %u)\n",
+                             err, (int) appHandle->tcpFd.listen_sd, (unsigned int) read_tcpPort);
+
+                /* Callback the error to the application  */
+                if (appHandle->mdDefault.pfCbFunction != NULL)
+                {
+                    TRDP_MD_INFO_T theMessage = cTrdp_md_info_default;
+
+                    theMessage.etbTopoCnt   = appHandle->etbTopoCnt;
+                    theMessage.opTrnTopoCnt = appHandle->opTrnTopoCnt;
+                    theMessage.resultCode   = TRDP_SOCK_ERR;
+                    theMessage.srcIpAddr    = newIp;
+                    appHandle->mdDefault.pfCbFunction(appHandle->mdDefault.pRefCon, appHandle,
+                                                      &theMessage, NULL, 0);
+                }
+                continue;
+            }
+        }
+        else
+        {
+            vos_printLog(VOS_LOG_INFO, "Accepting new TCP connection on Socket: %d (Port: %u)\n",
+                         (int) new_sd, (unsigned int) read_tcpPort);
+        }
+
+        {
+            VOS_SOCK_OPT_T trdp_sock_opt;
+
+            trdp_sock_opt.qos   = appHandle->mdDefault.sendParam.qos;
+            trdp_sock_opt.ttl   = appHandle->mdDefault.sendParam.ttl;
+            trdp_sock_opt.ttl_multicast = 0;
+            trdp_sock_opt.reuseAddrPort = TRUE;
+            trdp_sock_opt.nonBlocking   = TRUE;
+            trdp_sock_opt.no_mc_loop    = FALSE;
+            trdp_sock_opt.txTime        = FALSE;
+            trdp_sock_opt.rxTime        = FALSE;
+            trdp_sock_opt.busyPoll      = 0u;
+            trdp_sock_opt.tcpNoDelay    = TRUE;
+            trdp_sock_opt.udpGro        = FALSE;
+        trdp_sock_opt.udpGro        = FALSE;
+
+            err = (TRDP_ERR_T) vos_sockSetOptions(new_sd, &trdp_sock_opt);
+            if (err != TRDP_NO_ERR)
+            {
+                continue;
+            }
+        }
+
+        /* There is one more socket to manage */
+
+        /* Compare with the sockets stored in the socket list */
+        {
+            INT32   socketIndex;
+            BOOL8   socketFound = FALSE;
+
+            for (socketIndex = 0; socketIndex < VOS_MAX_SOCKET_CNT; socketIndex++)
+            {
+                if ((appHandle->iface[socketIndex].sock != VOS_INVALID_SOCKET)
+                    && (appHandle->iface[socketIndex].type == TRDP_SOCK_MD_TCP)
+                    && (appHandle->iface[socketIndex].tcpParams.cornerIp == newIp)
+                    && (appHandle->iface[socketIndex].rcvMostly == TRUE))
+                {
+                    vos_printLog(VOS_LOG_INFO, "New socket accepted from the same device (Ip = %u)\n", newIp);
+
+                    if (appHandle->iface[socketIndex].usage > 0)
+                    {
+                        vos_printLog(
+                            VOS_LOG_INFO,
+                            "The new socket accepted from the same device (Ip = %u), won't be removed, because it is still in use\n",
+                            newIp);
+                        socketFound = TRUE;
+                        break;
+                    }
+
+                    if ((pRfds != NULL) &&
+                        FD_ISSET(appHandle->iface[socketIndex].sock, (fd_set *) pRfds)) /*lint !e573
+                                                                                          signed/unsigned
+                                                                                          division in macro */
+                    {
+                        /* Decrement the Ready descriptors counter */
+                        if (pCount != NULL)
+                        {
+                            (*pCount)--;
+                        }
+                        FD_CLR(appHandle->iface[socketIndex].sock, (fd_set *) pRfds); /*lint !e502 !e573
+                                                                                        signed/unsigned division
+                                                                                        in macro */
+                    }
+
+
+                    /* Close the old socket */
+                    appHandle->iface[socketIndex].tcpParams.morituri = TRUE;
+
+                    /* Manage the socket pool (update the socket) */
+                    trdp_mdCloseSessions(appHandle, socketIndex, new_sd, TRUE);
+
+                    socketFound = TRUE;
+                    break;
+                }
+            }
+
+            if (socketFound == FALSE)
+            {
+                /* Save the new socket in the iface.
+                   On receiving MD data on this connection, a listener will be searched and a receive
+                   session instantiated. The socket/connection will be closed when the session has finished.
+                 */
+                err = trdp_requestSocket(
+                        appHandle->iface,
+                        appHandle->mdDefault.tcpPort,
+                        &appHandle->mdDefault.sendParam,
+                        appHandle->realIP,
+                        0,
+                        TRDP_SOCK_MD_TCP,
+                        TRDP_OPTION_NONE,
+                        TRUE,
+                        new_sd,
+                        &socketIndex,
+                        newIp);
+
+                if (err != TRDP_NO_ERR)
+                {
+                    vos_printLog(VOS_LOG_ERROR, "trdp_requestSocket() failed (Err: %d, Port: %d)\n",
+                                 err, (UINT32)appHandle->mdDefault.tcpPort);
+                }
+            }
+        }
+
+        /**********************************************/
+        /* Loop back up and accept another incoming   */
+        /* connection                                 */
+        /**********************************************/
+    }
+    while (new_sd != VOS_INVALID_SOCKET);
+}
+
+/**********************************************************************************************************************/
+/** Read MD from a readable socket
+ *  Call user's callback if needed, close TCP connections on failure
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      lIndex              index of the socket in the socket pool
+ */
+void trdp_mdReceiveSocket (
+    const TRDP_SESSION_PT   appHandle,
+    INT32                   lIndex)
+{
+    TRDP_ERR_T err;
+
+    err = trdp_mdRecv(appHandle, (UINT32) lIndex);
+
+#if TRDP_MD_UDP_SEG_SIZE > 0
+    /* hand over the other datagrams the kernel coalesced with the first one */
+    if ((appHandle->iface[lIndex].type == TRDP_SOCK_MD_UDP) && (appHandle->pMDUdpSeg != NULL))
+    {
+        MD_UDP_SEG_T *pSeg = appHandle->pMDUdpSeg;
+
+        while ((pSeg->sock == appHandle->iface[lIndex].sock) && (pSeg->offset < pSeg->size))
+        {
+            UINT32 offset = pSeg->offset;
+
+            /* finished sessions (e.g. notifications) must not catch the next datagram as a repetition */
+            trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, FALSE);
+            (void) trdp_mdRecv(appHandle, (UINT32) lIndex);
+            if (pSeg->offset == offset)
+            {
+                pSeg->size = 0u;    /* not taken (out of memory), drop the rest */
+            }
+        }
+    }
+#endif
+
+    if (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
+    {
+        /* The receive message is incomplete */
+        if (err == TRDP_PACKET_ERR)
+        {
+            vos_printLog(VOS_LOG_INFO, "Incomplete TCP MD received (Socket: %d)\n",
+                         (int) appHandle->iface[lIndex].sock);
+        }
+        /* A packet error on TCP should not lead to closing of the connection!
+             The following if-clauses were converted to else-if to prevent a false error handling (Ticket #160) */
+        /* Check if the socket has been closed in the other corner */
+        else if (err == TRDP_NODATA_ERR)
+        {
+            vos_printLog(VOS_LOG_INFO,
+                         "The socket has been closed in the other corner (Corner Ip: %s, Socket: %d)\n",
+                         vos_ipDotted(appHandle->iface[lIndex].tcpParams.cornerIp),
+                         (int) appHandle->iface[lIndex].sock);
+
+            appHandle->iface[lIndex].tcpParams.morituri = TRUE;
+
+            trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
+        }
+        /* Check if the socket has been closed in the other corner */
+        else if ((err == TRDP_CRC_ERR) ||
+                 (err == TRDP_WIRE_ERR) ||
+                 (err == TRDP_TOPO_ERR))
+        {
+            vos_printLog(VOS_LOG_WARNING,
+                         "Closing TCP connection, out of sync (Corner Ip: %s, Socket: %d)\n",
+                         vos_ipDotted(appHandle->iface[lIndex].tcpParams.cornerIp),
+                         (int) appHandle->iface[lIndex].sock);
+
+            appHandle->iface[lIndex].tcpParams.morituri = TRUE;
+
+            trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
+        }
+    }
+}
+
+
 /**********************************************************************************************************************/
 /** Checking receive connection requests and data
  *  Call user's callback if needed
@@ -2570,8 +4170,6 @@ void  trdp_mdCheckListenSocks (
     INT32       noOfDesc;
     SOCKET      highDesc = VOS_INVALID_SOCKET;
     INT32       lIndex;
-    TRDP_ERR_T  err;
-    SOCKET      new_sd = VOS_INVALID_SOCKET;
 
     if (appHandle == NULL)
     {
@@ -2607,199 +4205,49 @@ void  trdp_mdCheckListenSocks (
             {
                 FD_SET(appHandle->iface[lIndex].sock, (fd_set *)&rfds); /*lint !e573 signed/unsigned division in macro
                                                                           */
-                if (highDesc < appHandle->iface[lIndex].sock)
-                {
-                    highDesc = appHandle->iface[lIndex].sock;
-                }
-            }
-        }
-        if (highDesc == VOS_INVALID_SOCKET)
-        {
-            return;
-        }
-        noOfDesc = vos_select(highDesc + 1, &rfds, NULL, NULL, &timeOut);
-        if (noOfDesc == VOS_INVALID_SOCKET)
-        {
-            vos_printLogStr(VOS_LOG_ERROR, "select() failed\n");
-            return;
-        }
-        pRfds   = &rfds;
-        pCount  = &noOfDesc;
-    }
-
-    if (pCount != NULL && *pCount > 0)
-    {
-        /*    Check the sockets for received MD packets    */
-
-        /**********************************************************/
-        /* One or more descriptors are readable.  Need to         */
-        /* determine which ones they are.                         */
-        /**********************************************************/
-
-        /****************************************************/
-        /* Check to see if this is the TCP listening socket */
-        /****************************************************/
-
-        /* vos_printLogStr(VOS_LOG_INFO, " ----- CHECKING READY DESCRIPTORS -----\n"); */
-        if (appHandle->tcpFd.listen_sd != VOS_INVALID_SOCKET &&
-            FD_ISSET(appHandle->tcpFd.listen_sd, (fd_set *)pRfds)) /*lint !e573 signed/unsigned division in macro */
-        {
-            /****************************************************/
-            /* A TCP connection request in the listen socket.   */
-            /****************************************************/
-            (*pCount)--;
-
-            /*************************************************/
-            /* Accept all incoming connections that are      */
-            /* queued up on the listening socket.            */
-            /*************************************************/
-            do
-            {
-                /**********************************************/
-                /* Accept each incoming connection.           */
-                /* Check any failure on accept                */
-                /**********************************************/
-                TRDP_IP_ADDR_T  newIp;
-                UINT16          read_tcpPort;
-
-                newIp = appHandle->realIP;
-                read_tcpPort = appHandle->mdDefault.tcpPort;
-
-                err = (TRDP_ERR_T) vos_sockAccept(appHandle->tcpFd.listen_sd,
-                                                  &new_sd, &newIp,
-                                                  &(read_tcpPort));
-
-                if (new_sd < 0)
-                {
-                    if (err == TRDP_NO_ERR)
-                    {
-                        break;
-                    }
-                    else
-                    {
-                        vos_printLog(VOS_LOG_ERROR, "vos_sockAccept() failed (Err: %d, Socket: %d, Port: %u)\n",
-                                     err, (int) appHandle->tcpFd.listen_sd, (unsigned int) read_tcpPort);
-
-                        /* Callback the error to the application  */
-                        if (appHandle->mdDefault.pfCbFunction != NULL)
-                        {
-                            TRDP_MD_INFO_T theMessage = cTrdp_md_info_default;
-
-                            theMessage.etbTopoCnt   = appHandle->etbTopoCnt;
-                            theMessage.opTrnTopoCnt = appHandle->opTrnTopoCnt;
-                            theMessage.resultCode   = TRDP_SOCK_ERR;
-                            theMessage.srcIpAddr    = newIp;
-                            appHandle->mdDefault.pfCbFunction(appHandle->mdDefault.pRefCon, appHandle,
-                                                              &theMessage, NULL, 0);
-                        }
-                        continue;
-                    }
-                }
-                else
-                {
-                    vos_printLog(VOS_LOG_INFO, "Accepting new TCP connection on Socket: %d (Port: %u)\n",
-                                 (int) new_sd, (unsigned int) read_tcpPort);
-                }
-
-                {
-                    VOS_SOCK_OPT_T trdp_sock_opt;
-
-                    trdp_sock_opt.qos   = appHandle->mdDefault.sendParam.qos;
-                    trdp_sock_opt.ttl   = appHandle->mdDefault.sendParam.ttl;
-                    trdp_sock_opt.ttl_multicast = 0;
-                    trdp_sock_opt.reuseAddrPort = TRUE;
-                    trdp_sock_opt.nonBlocking   = TRUE;
-                    trdp_sock_opt.no_mc_loop    = FALSE;
-
-                    err = (TRDP_ERR_T) vos_sockSetOptions(new_sd, &trdp_sock_opt);
-                    if (err != TRDP_NO_ERR)
-                    {
-                        continue;
-                    }
-                }
-
-                /* There is one more socket to manage */
-
-                /* Compare with the sockets stored in the socket list */
-                {
-                    INT32   socketIndex;
-                    BOOL8   socketFound = FALSE;
-
-                    for (socketIndex = 0; socketIndex < VOS_MAX_SOCKET_CNT; socketIndex++)
-                    {
-                        if ((appHandle->iface[socketIndex].sock != VOS_INVALID_SOCKET)
-                            && (appHandle->iface[socketIndex].type == TRDP_SOCK_MD_TCP)
-                            && (appHandle->iface[socketIndex].tcpParams.cornerIp == newIp)
-                            && (appHandle->iface[socketIndex].rcvMostly == TRUE))
-                        {
-                            vos_printLog(VOS_LOG_INFO, "New socket accepted from the same device (Ip = %u)\n", newIp);
-
-                            if (appHandle->iface[socketIndex].usage > 0)
-                            {
-                                vos_printLog(
-                                    VOS_LOG_INFO,
-                                    "The new socket accepted from the same device (Ip = %u), won't be removed, because it is still in use\n",
-                                    newIp);
-                                socketFound = TRUE;
-                                break;
-                            }
-
-                            if (FD_ISSET(appHandle->iface[socketIndex].sock, (fd_set *) pRfds)) /*lint !e573
-                                                                                                  signed/unsigned
-                                                                                                  division in macro */
-                            {
-                                /* Decrement the Ready descriptors counter */
-                                (*pCount)--;
-                                FD_CLR(appHandle->iface[socketIndex].sock, (fd_set *) pRfds); /*lint !e502 !e573
-                                                                                                signed/unsigned division
-                                                                                                in macro */
-                            }
-
+                if (highDesc < appHandle->iface[lIndex].sock)
+                {
+                    highDesc = appHandle->iface[lIndex].sock;
+                }
+            }
+        }
+        if (highDesc == VOS_INVALID_SOCKET)
+        {
+            return;
+        }
+        noOfDesc = vos_select(highDesc + 1, &rfds, NULL, NULL, &timeOut);
+        if (noOfDesc == VOS_INVALID_SOCKET)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "select() failed\n");
+            return;
+        }
+        pRfds   = &rfds;
+        pCount  = &noOfDesc;
+    }
 
-                            /* Close the old socket */
-                            appHandle->iface[socketIndex].tcpParams.morituri = TRUE;
+    if (pCount != NULL && *pCount > 0)
+    {
+        /*    Check the sockets for received MD packets    */
 
-                            /* Manage the socket pool (update the socket) */
-                            trdp_mdCloseSessions(appHandle, socketIndex, new_sd, TRUE);
+        /**********************************************************/
+        /* One or more descriptors are readable.  Need to         */
+        /* determine which ones they are.                         */
+        /**********************************************************/
 
-                            socketFound = TRUE;
-                            break;
-                        }
-                    }
+        /****************************************************/
+        /* Check to see if this is the TCP listening socket */
+        /****************************************************/
 
-                    if (socketFound == FALSE)
-                    {
-                        /* Save the new socket in the iface.
-                           On receiving MD data on this connection, a listener will be searched and a receive
-                           session instantiated. The socket/connection will be closed when the session has finished.
-                         */
-                        err = trdp_requestSocket(
-                                appHandle->iface,
-                                appHandle->mdDefault.tcpPort,
-                                &appHandle->mdDefault.sendParam,
-                                appHandle->realIP,
-                                0,
-                                TRDP_SOCK_MD_TCP,
-                                TRDP_OPTION_NONE,
-                                TRUE,
-                                new_sd,
-                                &socketIndex,
-                                newIp);
-
-                        if (err != TRDP_NO_ERR)
-                        {
-                            vos_printLog(VOS_LOG_ERROR, "trdp_requestSocket() failed (Err: %d, Port: %d)\n",
-                                         err, (UINT32)appHandle->mdDefault.tcpPort);
-                        }
-                    }
-                }
+        /* vos_printLogStr(VOS_LOG_INFO, " ----- CHECKING READY DESCRIPTORS -----\n"); */
+        if (appHandle->tcpFd.listen_sd != VOS_INVALID_SOCKET &&
+            FD_ISSET(appHandle->tcpFd.listen_sd, (fd_set *)pRfds)) /*lint !e573 signed/unsigned division in macro */
+        {
+            /****************************************************/
+            /* A TCP connection request in the listen socket.   */
+            /****************************************************/
+            (*pCount)--;
 
-                /**********************************************/
-                /* Loop back up and accept another incoming   */
-                /* connection                                 */
-                /**********************************************/
-            }
-            while (new_sd != VOS_INVALID_SOCKET);
+            trdp_mdAccept(appHandle, pRfds, pCount);
         }
     }
 
@@ -2813,6 +4261,10 @@ void  trdp_mdCheckListenSocks (
             FD_ISSET(appHandle->iface[lIndex].sock, (fd_set *)pRfds) != 0) /*lint !e573 signed/unsigned division in
                                                                              macro */
         {
+            if (!trdp_budgetLeft(appHandle))
+            {
+                break;
+            }
             if (pCount != NULL)
             {
                 (*pCount)--;
@@ -2823,100 +4275,312 @@ void  trdp_mdCheckListenSocks (
             }
             FD_CLR(appHandle->iface[lIndex].sock, (fd_set *)pRfds); /*lint !e502 !e573 signed/unsigned division in macro
                                                                       */
-            err = trdp_mdRecv(appHandle, (UINT32) lIndex);
+            trdp_mdReceiveSocket(appHandle, lIndex);
+            trdp_budgetSpend(appHandle, 1u);
+        }
+    }
+}
 
-            if (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
-            {
-                /* The receive message is incomplete */
-                if (err == TRDP_PACKET_ERR)
-                {
-                    vos_printLog(VOS_LOG_INFO, "Incomplete TCP MD received (Socket: %d)\n",
-                                 (int) appHandle->iface[lIndex].sock);
-                }
-                /* A packet error on TCP should not lead to closing of the connection!
-                     The following if-clauses were converted to else-if to prevent a false error handling (Ticket #160) */
-                /* Check if the socket has been closed in the other corner */
-                else if (err == TRDP_NODATA_ERR)
-                {
-                    vos_printLog(VOS_LOG_INFO,
-                                 "The socket has been closed in the other corner (Corner Ip: %s, Socket: %d)\n",
-                                 vos_ipDotted(appHandle->iface[lIndex].tcpParams.cornerIp),
-                                 (int) appHandle->iface[lIndex].sock);
 
-                    appHandle->iface[lIndex].tcpParams.morituri = TRUE;
 
-                    trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
-                }
-                /* Check if the socket has been closed in the other corner */
-                else if ((err == TRDP_CRC_ERR) ||
-                         (err == TRDP_WIRE_ERR) ||
-                         (err == TRDP_TOPO_ERR))
-                {
-                    vos_printLog(VOS_LOG_WARNING,
-                                 "Closing TCP connection, out of sync (Corner Ip: %s, Socket: %d)\n",
-                                 vos_ipDotted(appHandle->iface[lIndex].tcpParams.cornerIp),
-                                 (int) appHandle->iface[lIndex].sock);
 
-                    appHandle->iface[lIndex].tcpParams.morituri = TRUE;
+#if TRDP_MD_TIMEOUT_SCHEDULER
+/**********************************************************************************************************************/
+/** Swap two entries of the timeout schedule
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      i                   index of first entry
+ *  @param[in]      j                   index of second entry
+ */
+static void trdp_mdSchedSwap (
+    TRDP_SESSION_PT appHandle,
+    UINT32          i,
+    UINT32          j)
+{
+    MD_ELE_T *pTemp = appHandle->pMDSched[i];
 
-                    trdp_mdCloseSessions(appHandle, TRDP_INVALID_SOCKET_INDEX, VOS_INVALID_SOCKET, TRUE);
-                }
-            }
+    appHandle->pMDSched[i] = appHandle->pMDSched[j];
+    appHandle->pMDSched[j] = pTemp;
+    appHandle->pMDSched[i]->schedIdx    = i + 1u;
+    appHandle->pMDSched[j]->schedIdx    = j + 1u;
+}
+
+/**********************************************************************************************************************/
+/** Restore the heap order for one entry of the timeout schedule
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      idx                 index of the entry which changed
+ */
+static void trdp_mdSchedFix (
+    TRDP_SESSION_PT appHandle,
+    UINT32          idx)
+{
+    MD_ELE_T **pHeap = appHandle->pMDSched;
+
+    /*  Move up, while earlier than parent  */
+    while ((idx > 0u) && (vos_cmpTime(&pHeap[idx]->timeToGo, &pHeap[(idx - 1u) / 2u]->timeToGo) < 0))
+    {
+        trdp_mdSchedSwap(appHandle, idx, (idx - 1u) / 2u);
+        idx = (idx - 1u) / 2u;
+    }
+
+    /*  Move down, while a child is earlier  */
+    for (;; )
+    {
+        UINT32  child   = 2u * idx + 1u;
+        UINT32  least   = idx;
+
+        if ((child < appHandle->mdSchedCnt) &&
+            (vos_cmpTime(&pHeap[child]->timeToGo, &pHeap[least]->timeToGo) < 0))
+        {
+            least = child;
+        }
+        if ((child + 1u < appHandle->mdSchedCnt) &&
+            (vos_cmpTime(&pHeap[child + 1u]->timeToGo, &pHeap[least]->timeToGo) < 0))
+        {
+            least = child + 1u;
+        }
+        if (least == idx)
+        {
+            break;
         }
+        trdp_mdSchedSwap(appHandle, idx, least);
+        idx = least;
     }
 }
 
+/**********************************************************************************************************************/
+/** Remove an MD session from the timeout schedule
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            element to remove
+ */
+void trdp_mdSchedRemove (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    UINT32 idx;
+
+    if ((appHandle == NULL) || (pElement == NULL) || (pElement->schedIdx == 0u))
+    {
+        return;
+    }
 
+    idx = pElement->schedIdx - 1u;
+    pElement->schedIdx = 0u;
+    appHandle->mdSchedCnt--;
 
+    if (idx != appHandle->mdSchedCnt)
+    {
+        appHandle->pMDSched[idx] = appHandle->pMDSched[appHandle->mdSchedCnt];
+        appHandle->pMDSched[idx]->schedIdx = idx + 1u;
+        trdp_mdSchedFix(appHandle, idx);
+    }
+}
 
 /**********************************************************************************************************************/
-/** Checking message data timeouts
- *  Call user's callback if needed
+/** Enlarge the timeout schedule to hold at least count entries
  *
  *  @param[in]      appHandle           session pointer
+ *  @param[in]      count               number of entries needed
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
  */
-void  trdp_mdCheckTimeouts (
-    TRDP_SESSION_PT appHandle)
+static TRDP_ERR_T trdp_mdSchedReserve (
+    TRDP_SESSION_PT appHandle,
+    UINT32          count)
 {
-    MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
-    BOOL8       firstLoop   = TRUE;
-    BOOL8       timeOut     = FALSE;
-    TRDP_TIME_T now;
+    UINT32      newSize = (appHandle->mdSchedSize == 0u) ? TRDP_MD_SCHED_START_SIZE : appHandle->mdSchedSize;
+    MD_ELE_T    **pNewSched;
 
-    if (appHandle == NULL)
+    if (count <= appHandle->mdSchedSize)
+    {
+        return TRDP_NO_ERR;
+    }
+    while (newSize < count)
+    {
+        newSize *= 2u;
+    }
+    pNewSched = (MD_ELE_T * *) vos_memAlloc(newSize * sizeof(MD_ELE_T *));
+    if (pNewSched == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    if (appHandle->pMDSched != NULL)
+    {
+        memcpy(pNewSched, appHandle->pMDSched, appHandle->mdSchedCnt * sizeof(MD_ELE_T *));
+        vos_memFree(appHandle->pMDSched);
+    }
+    appHandle->pMDSched     = pNewSched;
+    appHandle->mdSchedSize  = newSize;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Insert or re-sort an MD session in the timeout schedule
+ *  Must be called whenever timeToGo of an element of the MD send or receive queue was changed.
+ *  If the schedule cannot be enlarged, the element is scheduled again by the next trdp_mdCheckTimeouts(), which scans
+ *  the queues until then.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            changed element
+ */
+void trdp_mdSchedUpdate (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement)
+{
+    if ((appHandle == NULL) || (pElement == NULL))
     {
         return;
     }
 
-    /*  Find the sessions which needs action
-     Note: We must also check the receive queue for pending replies! */
-    do
+    if (pElement->schedIdx == 0u)
     {
-        TRDP_ERR_T resultCode = TRDP_UNKNOWN_ERR;
+        if (trdp_mdSchedReserve(appHandle, appHandle->mdSchedCnt + 1u) != TRDP_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "trdp_mdSchedUpdate: Out of memory!\n");
+            appHandle->mdSchedIncomplete = TRUE;
+            return;
+        }
+        appHandle->pMDSched[appHandle->mdSchedCnt] = pElement;
+        pElement->schedIdx = ++appHandle->mdSchedCnt;
+    }
 
-        /* Update the current time always inside loop in case of application delays  */
-        vos_getTime(&now);
+    trdp_mdSchedFix(appHandle, pElement->schedIdx - 1u);
+}
 
-        /*  Switch to receive queue */
-        if (NULL == iterMD && TRUE == firstLoop)
+/**********************************************************************************************************************/
+/** Free the timeout schedule
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_mdSchedFree (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pMDSched != NULL)
+    {
+        vos_memFree(appHandle->pMDSched);
+    }
+    appHandle->pMDSched             = NULL;
+    appHandle->mdSchedCnt           = 0u;
+    appHandle->mdSchedSize          = 0u;
+    appHandle->mdSchedIncomplete    = FALSE;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Collect the MD sessions whose timeout has expired
+ *  With TRDP_MD_TIMEOUT_SCHEDULER only the part of the schedule which has expired is visited: the children of a
+ *  pending entry are pending as well. Expired sessions in a state without timeout handling stay at the top of the
+ *  schedule and are visited again, as they were by the scan of the queues.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pNow                current time
+ *
+ *  @retval         list of expired sessions linked by pNextDue, NULL if none
+ */
+static MD_ELE_T *trdp_mdCollectDue (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pNow)
+{
+    MD_ELE_T    *pDue = NULL;
+    MD_ELE_T    *iterMD;
+
+#if TRDP_MD_TIMEOUT_SCHEDULER
+    if (appHandle->mdSchedIncomplete == TRUE)
+    {
+        /*  Try to schedule the sessions left out before    */
+        appHandle->mdSchedIncomplete = FALSE;
+        for (iterMD = appHandle->pMDSndQueue; iterMD != NULL; iterMD = iterMD->pNext)
         {
-            iterMD      = appHandle->pMDRcvQueue;
-            firstLoop   = FALSE;
+            trdp_mdSchedUpdate(appHandle, iterMD);
+        }
+        for (iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext)
+        {
+            trdp_mdSchedUpdate(appHandle, iterMD);
         }
+    }
 
-        /*  Are we finished?   */
-        if (NULL == iterMD)
+    if (appHandle->mdSchedIncomplete == FALSE)
+    {
+        UINT32  stack[64u];         /* pending right children, bounded by the depth of the heap */
+        UINT32  noOfStacked = 0u;
+
+        if (appHandle->mdSchedCnt > 0u)
         {
-            break;
+            stack[noOfStacked++] = 0u;
         }
+        while (noOfStacked > 0u)
+        {
+            UINT32 idx = stack[--noOfStacked];
 
-        /* timeToGo is timeout value! */
-        if (0 > vos_cmpTime(&iterMD->timeToGo, &now))     /* timeout overflow */
+            iterMD = appHandle->pMDSched[idx];
+            if (0 <= vos_cmpTime(&iterMD->timeToGo, pNow))
+            {
+                continue;
+            }
+            iterMD->pNextDue    = pDue;
+            pDue                = iterMD;
+            if (2u * idx + 2u < appHandle->mdSchedCnt)
+            {
+                stack[noOfStacked++] = 2u * idx + 2u;
+            }
+            if (2u * idx + 1u < appHandle->mdSchedCnt)
+            {
+                stack[noOfStacked++] = 2u * idx + 1u;
+            }
+        }
+        return pDue;
+    }
+#endif
+
+    /*  Note: We must also check the receive queue for pending replies! */
+    for (iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext)
+    {
+        if (0 > vos_cmpTime(&iterMD->timeToGo, pNow))
+        {
+            iterMD->pNextDue    = pDue;
+            pDue                = iterMD;
+        }
+    }
+    for (iterMD = appHandle->pMDSndQueue; iterMD != NULL; iterMD = iterMD->pNext)
+    {
+        if (0 > vos_cmpTime(&iterMD->timeToGo, pNow))
         {
-            timeOut = trdp_mdTimeOutStateHandler( iterMD, appHandle, &resultCode);
+            iterMD->pNextDue    = pDue;
+            pDue                = iterMD;
         }
+    }
+    return pDue;
+}
+
+/**********************************************************************************************************************/
+/** Checking message data timeouts
+ *  Call user's callback if needed
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void  trdp_mdCheckTimeouts (
+    TRDP_SESSION_PT appHandle)
+{
+    MD_ELE_T    *iterMD;
+    TRDP_TIME_T now;
+
+    if (appHandle == NULL)
+    {
+        return;
+    }
+
+    trdp_getNow(appHandle, &now);
+
+    /*  Find the sessions which needs action; the list is not affected by rescheduling in the handler  */
+    for (iterMD = trdp_mdCollectDue(appHandle, &now); iterMD != NULL; iterMD = iterMD->pNextDue)
+    {
+        TRDP_ERR_T resultCode = TRDP_UNKNOWN_ERR;
 
-        if (TRUE == timeOut)    /* Notify user  */
+        /* timeToGo is timeout value! */
+        if (TRUE == trdp_mdTimeOutStateHandler( iterMD, appHandle, &resultCode))    /* Notify user  */
         {
             /* Execute callback */
             if (iterMD->pfCbFunction != NULL)
@@ -2924,15 +4588,17 @@ void  trdp_mdCheckTimeouts (
                 trdp_mdInvokeCallback(iterMD, appHandle, resultCode);
             }
         }
-
-        iterMD = iterMD->pNext;
     }
-    while (TRUE); /*lint !e506 */
+
+    /* Update the current time in case of application delays (outside tlc_process)  */
+    trdp_getNow(appHandle, &now);
 
     /* Check for sockets Connection Timeouts */
     /* if ((appHandle->mdDefault.flags & TRDP_FLAGS_TCP) != 0) */
     {
-        INT32 lIndex;
+        INT32   lIndex;
+        INT32   oldest;
+        UINT32  numIdle = 0u;
 
         for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
         {
@@ -2940,6 +4606,7 @@ void  trdp_mdCheckTimeouts (
                 && (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
                 && (appHandle->iface[lIndex].usage == 0)
                 && (appHandle->iface[lIndex].rcvMostly == FALSE)
+                && (appHandle->iface[lIndex].tcpParams.morituri == FALSE)
                 && ((appHandle->iface[lIndex].tcpParams.connectionTimeout.tv_sec > 0)
                     || (appHandle->iface[lIndex].tcpParams.connectionTimeout.tv_usec > 0)))
             {
@@ -2947,8 +4614,44 @@ void  trdp_mdCheckTimeouts (
                 {
                     vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) TIMEOUT\n", (int) appHandle->iface[lIndex].sock);
                     appHandle->iface[lIndex].tcpParams.morituri = TRUE;
+                    appHandle->tcpConnStats.numIdleClose++;
+                }
+                else
+                {
+                    numIdle++;
+                }
+            }
+        }
+
+        /* Keep not more idle connections than configured, the one idle for the longest time is closed first */
+        while ((appHandle->mdDefault.maxNumIdleConn != 0u) && (numIdle > appHandle->mdDefault.maxNumIdleConn))
+        {
+            oldest = TRDP_INVALID_SOCKET_INDEX;
+            for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+            {
+                if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
+                    && (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
+                    && (appHandle->iface[lIndex].usage == 0)
+                    && (appHandle->iface[lIndex].rcvMostly == FALSE)
+                    && (appHandle->iface[lIndex].tcpParams.morituri == FALSE)
+                    && ((appHandle->iface[lIndex].tcpParams.connectionTimeout.tv_sec > 0)
+                        || (appHandle->iface[lIndex].tcpParams.connectionTimeout.tv_usec > 0))
+                    && ((oldest == TRDP_INVALID_SOCKET_INDEX)
+                        || (0 > vos_cmpTime(&appHandle->iface[lIndex].tcpParams.connectionTimeout,
+                                            &appHandle->iface[oldest].tcpParams.connectionTimeout))))
+                {
+                    oldest = lIndex;
                 }
             }
+            if (oldest == TRDP_INVALID_SOCKET_INDEX)
+            {
+                break;
+            }
+            vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) exceeds the idle connections\n",
+                         (int) appHandle->iface[oldest].sock);
+            appHandle->iface[oldest].tcpParams.morituri = TRUE;
+            appHandle->tcpConnStats.numIdleClose++;
+            numIdle--;
         }
     }
 
@@ -3031,10 +4734,31 @@ static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
                 /* Error getting socket, exit function */
                 return err;
             }
+
+            /* The application has to wait until the messages queued for the peer have been sent */
+            if (trdp_mdTxThrottled(appHandle, pSenderElement))
+            {
+                trdp_releaseSocket(appHandle->iface, pSenderElement->socketIdx, appHandle->mdDefault.connectTimeout,
+                                   FALSE, VOS_INADDR_ANY);
+                pSenderElement->socketIdx = TRDP_INVALID_SOCKET_INDEX;
+                return TRDP_BLOCK_ERR;
+            }
+
+            /* An open connection to the peer is reused, the request is pipelined behind the pending ones */
+            if ((appHandle->iface[pSenderElement->socketIdx].usage > 1)
+                || (appHandle->iface[pSenderElement->socketIdx].tcpParams.connected == TRUE))
+            {
+                appHandle->tcpConnStats.numReuse++;
+            }
+            else
+            {
+                appHandle->tcpConnStats.numConnect++;
+            }
         }
 
         /* In the case that it is the first connection, do connect() */
-        if ( appHandle->iface[pSenderElement->socketIdx].usage > 1 )
+        if ((appHandle->iface[pSenderElement->socketIdx].usage > 1)
+            || (appHandle->iface[pSenderElement->socketIdx].tcpParams.connected == TRUE))
         {
             pSenderElement->tcpParameters.doConnect = FALSE;
         }
@@ -3147,7 +4871,7 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
                                                     &pSenderElement->pCachedDS);
             pSenderElement->pPacket->frameHead.datasetLength = vos_htonl(destSize);
         }
-        else
+        else if (pSenderElement->pUserData == NULL)
         {
             memcpy(pSenderElement->pPacket->data, pData, dataSize);
         }
@@ -3156,15 +4880,11 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
     /* Insert element in send queue */
     if ( TRUE == newSession )
     {
-        if ((pSenderElement->pktFlags & TRDP_FLAGS_TCP) != 0 )
-        {
-            trdp_MDqueueAppLast(&appHandle->pMDSndQueue, pSenderElement);
-        }
-        else
-        {
-            trdp_MDqueueInsFirst(&appHandle->pMDSndQueue, pSenderElement);
-        }
+        trdp_MDqueueInsSession(appHandle, &appHandle->pMDSndQueue, pSenderElement,
+                               (pSenderElement->pktFlags & TRDP_FLAGS_TCP) != 0);
     }
+    /* (re-)schedule the timeout of the session */
+    trdp_mdSchedUpdate(appHandle, pSenderElement);
     vos_printLog(VOS_LOG_INFO,
                  "MD sender element state = %d, msgType=%c%c\n",
                  pSenderElement->stateEle,
@@ -3228,15 +4948,20 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
 
     if ( pSessionId )
     {
-        errv = trdp_mdLookupElement((MD_ELE_T *)appHandle->pMDRcvQueue,
+        errv = trdp_mdLookupElement(appHandle,
+                                    &appHandle->pMDRcvQueue,
                                     TRDP_ST_RX_REQ_W4AP_REPLY,
                                     pSessionId,
                                     &pSenderElement);
 
         if ((TRDP_NO_ERR == errv) && (NULL != pSenderElement))
         {
-
-            if ( NULL != pSenderElement->pPacket )
+            /* keep the session unchanged, the reply can be sent again once the send queue drained */
+            if (trdp_mdTxThrottled(appHandle, pSenderElement))
+            {
+                errv = TRDP_BLOCK_ERR;
+            }
+            else if ( NULL != pSenderElement->pPacket )
             {
                 /*get values for later use*/
                 destURI = (TRDP_URI_USER_T *)pSenderElement->srcURI;
@@ -3259,7 +4984,7 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                 pSenderElement->pCachedDS       = NULL;
                 pSenderElement->morituri        = FALSE;
                 trdp_mdFillStateElement(msgType, pSenderElement);
-                trdp_mdManageSessionId(pSessionId, pSenderElement);
+                trdp_mdManageSessionId(appHandle, pSessionId, pSenderElement);
 
                 if ( msgType == TRDP_MSG_MQ )
                 {
@@ -3277,14 +5002,11 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                                             pSenderElement);
                 if ( errv == TRDP_NO_ERR )
                 {
-                    if ( NULL != pSenderElement->pPacket )
-                    {
-                        vos_memFree(pSenderElement->pPacket);
-                        pSenderElement->pPacket = NULL;
-                    }
-                    /* allocate a buffer for the data   */
-                    pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
-                    if ( NULL == pSenderElement->pPacket )
+                    /* allocate a buffer for the data, only header and padding if the data is sent in place */
+                    pSenderElement->pUserData = trdp_mdSendInPlace(appHandle, pSenderElement, pData) ? pData : NULL;
+                    if ( NULL == trdp_mdAllocPacket(appHandle, pSenderElement,
+                                                    (pSenderElement->pUserData != NULL) ?
+                                                    sizeof(MD_HEADER_T) + 4u : pSenderElement->grossSize) )
                     {
                         vos_memFree(pSenderElement);
                         pSenderElement = NULL;
@@ -3303,6 +5025,7 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                                                   (const TRDP_URI_USER_T *)srcURI,
                                                   (const TRDP_URI_USER_T *)destURI,
                                                   pSenderElement);
+                        trdp_mdTxQueue(appHandle, pSenderElement);
                         errv = TRDP_NO_ERR;
                     }
                 }
@@ -3399,12 +5122,11 @@ TRDP_ERR_T trdp_mdCall (
     }
 
     /* Room for MD element */
-    pSenderElement = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+    pSenderElement = trdp_mdAllocElement(appHandle);
 
     /* Reset descriptor value */
     if ( NULL != pSenderElement )
     {
-        memset(pSenderElement, 0, sizeof(MD_ELE_T));
         pSenderElement->socketIdx   = TRDP_INVALID_SOCKET_INDEX;
         pSenderElement->pktFlags    =
             (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->mdDefault.flags : pktFlags;
@@ -3486,22 +5208,19 @@ TRDP_ERR_T trdp_mdCall (
         {
             trdp_mdFillStateElement(msgType, pSenderElement);
 
-            trdp_mdManageSessionId((UINT8 *)pSessionId, pSenderElement);
+            trdp_mdManageSessionId(appHandle, (UINT8 *)pSessionId, pSenderElement);
 
             /*
              (Re-)allocate the data buffer if current size is different from requested size.
              If no data at all, free data pointer
              */
-            if ( NULL != pSenderElement->pPacket )
+            /* allocate a buffer for the data, only header and padding if the data is sent in place */
+            pSenderElement->pUserData = trdp_mdSendInPlace(appHandle, pSenderElement, pData) ? pData : NULL;
+            if ( NULL == trdp_mdAllocPacket(appHandle, pSenderElement,
+                                            (pSenderElement->pUserData != NULL) ?
+                                            sizeof(MD_HEADER_T) + 4u : pSenderElement->grossSize) )
             {
-                vos_memFree(pSenderElement->pPacket);
-                pSenderElement->pPacket = NULL;
-            }
-            /* allocate a buffer for the data   */
-            pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
-            if ( NULL == pSenderElement->pPacket )
-            {
-                vos_memFree(pSenderElement);
+                trdp_mdFreeSession(appHandle, pSenderElement);
                 pSenderElement = NULL;
                 errv = TRDP_MEM_ERR;
 
@@ -3519,6 +5238,7 @@ TRDP_ERR_T trdp_mdCall (
                                           (const TRDP_URI_USER_T *)srcURI,
                                           (const TRDP_URI_USER_T *)destURI,
                                           pSenderElement);
+                trdp_mdTxQueue(appHandle, pSenderElement);
                 errv = TRDP_NO_ERR;
             }
         }
@@ -3531,7 +5251,7 @@ TRDP_ERR_T trdp_mdCall (
     if ( TRDP_NO_ERR != errv &&
          NULL != pSenderElement )
     {
-        trdp_mdFreeSession(pSenderElement);
+        trdp_mdFreeSession(appHandle, pSenderElement);
         pSenderElement = NULL;
     }
 
@@ -3585,7 +5305,8 @@ TRDP_ERR_T trdp_mdConfirm (
 
     if ( pSessionId )
     {
-        errv = trdp_mdLookupElement((MD_ELE_T *)appHandle->pMDSndQueue,
+        errv = trdp_mdLookupElement(appHandle,
+                                    &appHandle->pMDSndQueue,
                                     TRDP_ST_TX_REQ_W4AP_CONFIRM,
                                     (const UINT8 *)pSessionId,
                                     &pSenderElement);
@@ -3630,14 +5351,10 @@ TRDP_ERR_T trdp_mdConfirm (
                              pSenderElement->sessionID[4], pSenderElement->sessionID[5],
                              pSenderElement->sessionID[6], pSenderElement->sessionID[7]);
 
-                if ( NULL != pSenderElement->pPacket )
-                {
-                    vos_memFree(pSenderElement->pPacket);
-                    pSenderElement->pPacket = NULL;
-                }
+                /* a confirmation carries no data */
+                pSenderElement->pUserData = NULL;
                 /* allocate a buffer for the data   */
-                pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
-                if ( NULL == pSenderElement->pPacket )
+                if ( NULL == trdp_mdAllocPacket(appHandle, pSenderElement, pSenderElement->grossSize) )
                 {
                     vos_memFree(pSenderElement);
                     pSenderElement = NULL;
@@ -47,8 +47,18 @@
 TRDP_ERR_T  trdp_mdGetTCPSocket (
     TRDP_SESSION_PT pSession);
 
+MD_ELE_T    *trdp_mdAllocElement (
+    TRDP_SESSION_PT appHandle);
+
 void        trdp_mdFreeSession (
-    MD_ELE_T *pMDSession);
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pMDSession);
+
+void        trdp_mdPoolFree (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_mdPoolFill (
+    TRDP_SESSION_PT appHandle);
 
 TRDP_ERR_T  trdp_mdSend (
     TRDP_SESSION_PT appHandle);
@@ -58,11 +68,51 @@ void        trdp_mdCheckPending (
     TRDP_FDS_T          *pFileDesc,
     INT32               *pNoDesc);
 
+void trdp_mdAccept (
+    const TRDP_SESSION_PT appHandle,
+    TRDP_FDS_T      *pRfds,
+    INT32           *pCount);
+
+void trdp_mdReceiveSocket (
+    const TRDP_SESSION_PT appHandle,
+    INT32           lIndex);
+
 void trdp_mdCheckListenSocks (
     const TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
     INT32           *pCount);
 
+#if TRDP_MD_TIMEOUT_SCHEDULER
+void        trdp_mdSchedUpdate (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement);
+
+void        trdp_mdSchedRemove (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        *pElement);
+
+void        trdp_mdSchedFree (
+    TRDP_SESSION_PT appHandle);
+#else
+#define trdp_mdSchedUpdate(appHandle, pElement)
+#define trdp_mdSchedRemove(appHandle, pElement)
+#define trdp_mdSchedFree(appHandle)
+#endif
+
+#if TRDP_MD_STREAM_CHUNK_SIZE > 0
+void        trdp_mdStreamFree (
+    TRDP_SESSION_PT appHandle);
+#else
+#define trdp_mdStreamFree(appHandle)
+#endif
+
+#if TRDP_MD_UDP_SEG_SIZE > 0
+void        trdp_mdUdpSegFree (
+    TRDP_SESSION_PT appHandle);
+#else
+#define trdp_mdUdpSegFree(appHandle)
+#endif
+
 void        trdp_mdCheckTimeouts (
     TRDP_SESSION_PT appHandle);
 
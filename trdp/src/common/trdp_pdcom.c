@@ -56,6 +56,7 @@
  * INCLUDES
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #include "trdp_types.h"
@@ -63,6 +64,9 @@
 #include "trdp_pdcom.h"
 #include "trdp_if.h"
 #include "trdp_stats.h"
+#include "trdp_sdt.h"
+#include "trdp_trace.h"
+#include "trdp_rec.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 
@@ -83,6 +87,23 @@
  *   Locals
  */
 
+#if TRDP_PD_LAZY_FCS
+/*  CRC register contribution of each byte of the sequence counter, followed by the rest of a zeroed header  */
+static UINT32 sFcsSeqTable[sizeof(UINT32)][256];
+#endif
+
+static TRDP_ERR_T   trdp_pdHandleFrame (TRDP_SESSION_PT appHandle,
+                                        UINT32          recSize,
+                                        TRDP_IP_ADDR_T  srcIpAddr,
+                                        TRDP_IP_ADDR_T  destIpAddr,
+                                        const UINT32    *pFcs);
+static void         trdp_pdBatchFcs (const VOS_SOCK_MSG_T   msgs[],
+                                     UINT32                 noFrames,
+                                     UINT32                 fcs[]);
+static void         trdp_pdCheckRxQueue (TRDP_SOCKETS_T *pSock);
+static void         trdp_pdGroupsPublish (TRDP_SESSION_PT appHandle);
+static void         trdp_pdFreeRequest (TRDP_SESSION_PT appHandle,
+                                        PD_ELE_T        *iterPD);
 
 /******************************************************************************/
 /** Initialize/construct the packet
@@ -117,6 +138,9 @@ void    trdp_pdInit (
     pPacket->pFrame->frameHead.reserved         = 0u;
     pPacket->pFrame->frameHead.replyComId       = vos_htonl(replyComId);
     pPacket->pFrame->frameHead.replyIpAddress   = vos_htonl(replyIpAddress);
+#if TRDP_PD_LAZY_FCS
+    pPacket->fcsHeadType = 0u;                  /* header changed, recompute on next send */
+#endif
 }
 
 /******************************************************************************/
@@ -165,7 +189,7 @@ TRDP_ERR_T trdp_pdPut (
 
             pPacket->dataSize   = dataSize;
             pPacket->grossSize  = trdp_packetSizePD(dataSize);
-            pTemp = (PD_PACKET_T *) vos_memAlloc(pPacket->grossSize);
+            pTemp = (PD_PACKET_T *) vos_memAllocAligned(pPacket->grossSize, TRDP_PD_FRAME_ALIGN);
             if (pTemp == NULL)
             {
                 return TRDP_MEM_ERR;
@@ -278,888 +302,4899 @@ TRDP_ERR_T trdp_pdGet (
 }
 
 /******************************************************************************/
-/** Send all due PD messages
+/** Fill the info block of the current frame
+ *
+ *  @param[in]      pPacket             subscription
+ *  @param[out]     pPdInfo             pointer to application's info buffer
+ *  @param[in]      resultCode          result to report
+ */
+void trdp_pdGetInfo (
+    const PD_ELE_T      *pPacket,
+    TRDP_PD_INFO_T      *pPdInfo,
+    TRDP_ERR_T          resultCode)
+{
+    pPdInfo->comId          = pPacket->addr.comId;
+    pPdInfo->srcIpAddr      = pPacket->lastSrcIP;
+    pPdInfo->destIpAddr     = pPacket->addr.destIpAddr;
+    pPdInfo->etbTopoCnt     = vos_ntohl(pPacket->pFrame->frameHead.etbTopoCnt);
+    pPdInfo->opTrnTopoCnt   = vos_ntohl(pPacket->pFrame->frameHead.opTrnTopoCnt);
+    pPdInfo->msgType        = (TRDP_MSG_T) vos_ntohs(pPacket->pFrame->frameHead.msgType);
+    pPdInfo->seqCount       = pPacket->curSeqCnt;
+    pPdInfo->protVersion    = vos_ntohs(pPacket->pFrame->frameHead.protocolVersion);
+    pPdInfo->replyComId     = vos_ntohl(pPacket->pFrame->frameHead.replyComId);
+    pPdInfo->replyIpAddr    = vos_ntohl(pPacket->pFrame->frameHead.replyIpAddress);
+    pPdInfo->pUserRef       = pPacket->pUserRef;
+    pPdInfo->resultCode     = resultCode;
+    pPdInfo->rxTime         = pPacket->rxTime;
+    pPdInfo->numCoalesced   = 0u;
+}
+
+/******************************************************************************/
+/** Collect the PD receive sockets of the session (subscriptions, AF_XDP and io_uring)
  *
  *  @param[in]      appHandle           session pointer
+ *  @param[out]     pRfds               descriptor set to fill
  *
- *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_IO_ERR         socket I/O error
+ *  @retval         highest descriptor, -1 if there is none
  */
-TRDP_ERR_T  trdp_pdSendQueued (
-    TRDP_SESSION_PT appHandle)
+static INT32 trdp_pdRcvFds (
+    TRDP_SESSION_PT appHandle,
+    TRDP_FDS_T      *pRfds)
 {
-    PD_ELE_T    *iterPD = appHandle->pSndQueue;
-    TRDP_TIME_T now;
-    TRDP_ERR_T  err = TRDP_NO_ERR;
+    PD_ELE_T    *iterPD;
+    INT32       noDesc = -1;
 
-    vos_clearTime(&appHandle->nextJob);
+    FD_ZERO((fd_set *)pRfds);
 
-    /*    Find the packet which has to be sent next:    */
-    while (iterPD != NULL)
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        /*    Get the current time    */
-        vos_getTime(&now);
-
-        /*  Is this a cyclic packet and
-         due to sent?
-         or is it a PD Request or a requested packet (PULL) ?
-         */
-        if ((timerisset(&iterPD->interval) &&                   /*  Request for immediate sending   */
-             !timercmp(&iterPD->timeToGo, &now, >)) ||
-            (iterPD->privFlags & TRDP_REQ_2B_SENT))
+        if ((iterPD->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
+#if TRDP_PD_URING
+            (appHandle->iface[iterPD->socketIdx].uring == NULL) &&
+#endif
+            (appHandle->iface[iterPD->socketIdx].sock != VOS_INVALID_SOCKET))
         {
-            /* send only if there is valid data */
-            if (!(iterPD->privFlags & TRDP_INVALID_DATA))
+            FD_SET(appHandle->iface[iterPD->socketIdx].sock, (fd_set *)pRfds);   /*lint !e573 */
+            if ((INT32) appHandle->iface[iterPD->socketIdx].sock > noDesc)
             {
-                if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
-                    (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))       /*  PULL packet?  */
-                {
-                    iterPD->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PP);
-                }
-                /*  Update the sequence counter and re-compute CRC    */
-                trdp_pdUpdate(iterPD);
-
-                /* Publisher check from Table A.5:
-                   Actual topography counter values <-> Locally stored with publish */
-                if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
-                                              appHandle->opTrnTopoCnt,
-                                              vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt),
-                                              vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt)))
-                {
-                    err = TRDP_TOPO_ERR;
-                    vos_printLogStr(VOS_LOG_INFO, "Sending PD: TopoCount is out of date!\n");
-                }
-                /*    In case we're sending on an uninitialized publisher; should never happen. */
-                else if (iterPD->socketIdx == TRDP_INVALID_SOCKET_INDEX)
-                {
-                    vos_printLogStr(VOS_LOG_ERROR, "Sending PD: Socket invalid!\n");
-                    /* Try to send the other packets */
-                }
-                /*    Send the packet if it is not redundant    */
-                else if (!(iterPD->privFlags & TRDP_REDUNDANT))
-                {
-                    TRDP_ERR_T result;
-                    if (iterPD->pfCbFunction != NULL)
-                    {
-                        TRDP_PD_INFO_T theMessage;
-                        theMessage.comId        = iterPD->addr.comId;
-                        theMessage.srcIpAddr    = iterPD->addr.srcIpAddr;
-                        theMessage.destIpAddr   = iterPD->addr.destIpAddr;
-                        theMessage.etbTopoCnt   = vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt);
-                        theMessage.opTrnTopoCnt = vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt);
-                        theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(iterPD->pFrame->frameHead.msgType);
-                        theMessage.seqCount     = iterPD->curSeqCnt;
-                        theMessage.protVersion  = vos_ntohs(iterPD->pFrame->frameHead.protocolVersion);
-                        theMessage.replyComId   = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
-                        theMessage.replyIpAddr  = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
-                        theMessage.pUserRef     = iterPD->pUserRef; /* User reference given with the local subscribe? */
-                        theMessage.resultCode   = err;
-
-                        iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                                       appHandle,
-                                                       &theMessage,
-                                                       iterPD->pFrame->data,
-                                                       vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
-                    }
-                    /* We pass the error to the application, but we keep on going    */
-                    result = trdp_pdSend(appHandle->iface[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
-                    if (result == TRDP_NO_ERR)
-                    {
-                        appHandle->stats.pd.numSend++;
-                        iterPD->numRxTx++;
-                    }
-                    else
-                    {
-                        err = result;   /* pass last error to application  */
-                    }
-                }
+                noDesc = (INT32) appHandle->iface[iterPD->socketIdx].sock;
             }
+        }
+    }
+    if (appHandle->pdXdp != NULL)
+    {
+        FD_SET(appHandle->pdXdpSock, (fd_set *)pRfds);   /*lint !e573 */
+        if ((INT32) appHandle->pdXdpSock > noDesc)
+        {
+            noDesc = (INT32) appHandle->pdXdpSock;
+        }
+    }
+#if TRDP_PD_URING
+    if (appHandle->pdUring != NULL)
+    {
+        FD_SET(appHandle->pdUringFd, (fd_set *)pRfds);   /*lint !e573 */
+        if ((INT32) appHandle->pdUringFd > noDesc)
+        {
+            noDesc = (INT32) appHandle->pdUringFd;
+        }
+    }
+#endif
+    return noDesc;
+}
 
-            if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
-                (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PP)))       /*  PULL packet?  */
-            {
-                /* Do not reset timer, but restore msgType */
-                iterPD->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PD);
-            }
-            else if (timerisset(&iterPD->interval))
-            {
-                /*  Set timer if interval was set.
-                    In case of a requested cyclically PD packet, this will lead to one time jump (jitter) in the interval
-                */
-                vos_addTime(&iterPD->timeToGo, &iterPD->interval);
+#if TRDP_PD_RCV_THREAD
+/******************************************************************************/
+/** Publish the current frame of a subscription to its snapshot
+ *  Called by the receiving thread with the session locked. The frame is written into the buffer not
+ *  read by tlp_get() at the moment; readers detect an overwrite by the changed sequence number.
+ *
+ *  @param[in]      pPacket             subscription with the new frame in pFrame
+ */
+static void trdp_pdSnapWrite (
+    PD_ELE_T *pPacket)
+{
+    PD_SNAPSHOT_T   *pSnap      = pPacket->pSnap;
+    UINT32          version     = __atomic_load_n(&pSnap->version, __ATOMIC_RELAXED) + 1u;
+    PD_SNAP_BUF_T   *pBuffer    = &pSnap->buffer[version & 1u];
+    UINT32          seq         = pBuffer->seq;
+    UINT32          dataSize    = (pPacket->dataSize > TRDP_MAX_PD_DATA_SIZE) ? TRDP_MAX_PD_DATA_SIZE : pPacket->dataSize;
 
-                if (vos_cmpTime(&iterPD->timeToGo, &now) <= 0)
-                {
-                    /* in case of a delay of more than one interval - avoid sending it in the next cycle again */
-                    iterPD->timeToGo = now;
-                    vos_addTime(&iterPD->timeToGo, &iterPD->interval);
-                }
-            }
+    __atomic_store_n(&pBuffer->seq, seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
 
-            /* Reset "immediate" flag for request or requested packet */
-            iterPD->privFlags = (TRDP_PRIV_FLAGS_T) (iterPD->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_REQ_2B_SENT);
+    pBuffer->srcIpAddr  = pPacket->lastSrcIP;
+    pBuffer->seqCnt     = pPacket->curSeqCnt;
+    pBuffer->dataSize   = dataSize;
+    pBuffer->timeToGo   = pPacket->timeToGo;
+    pBuffer->rxTime     = pPacket->rxTime;
+    memcpy(&pBuffer->frame, pPacket->pFrame, sizeof(PD_HEADER_T) + dataSize);
 
-            /* remove one shot messages after they have been sent */
-            if (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PR))    /* Ticket #172: remove element */
-            {
-                PD_ELE_T *pTemp;
-                /* Decrease the socket ref */
-                trdp_releaseSocket(appHandle->iface, iterPD->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
-                /* Save next element */
-                pTemp = iterPD->pNext;
-                /* Remove current element */
-                trdp_queueDelElement(&appHandle->pSndQueue, iterPD);
-                iterPD->magic = 0u;
-                if (iterPD->pSeqCntList != NULL)
-                {
-                    vos_memFree(iterPD->pSeqCntList);
-                }
-                vos_memFree(iterPD->pFrame);
-                vos_memFree(iterPD);
+    __atomic_store_n(&pBuffer->seq, seq + 2u, __ATOMIC_RELEASE);
+    __atomic_store_n(&pSnap->version, version, __ATOMIC_RELEASE);
+}
 
-                /* pre-set next element */
-                iterPD = pTemp;
-                continue;
-            }
-        }
-        iterPD = iterPD->pNext;
+/******************************************************************************/
+/** Allocate the snapshot of a new subscription
+ *
+ *  @param[in]      pPacket             subscription, interval and timeToGo already set
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_pdSnapCreate (
+    PD_ELE_T *pPacket)
+{
+    pPacket->pSnap = (PD_SNAPSHOT_T *) vos_memAlloc(sizeof(PD_SNAPSHOT_T));
+    if (pPacket->pSnap == NULL)
+    {
+        return TRDP_MEM_ERR;
     }
-    return err;
+    /*  Until the first frame arrives, buffer 0 tells tlp_get() when the subscription times out */
+    pPacket->pSnap->buffer[0].timeToGo = pPacket->timeToGo;
+    return TRDP_NO_ERR;
 }
 
 /******************************************************************************/
-/** Receiving PD messages
- *  Read the receive socket for arriving PDs, copy the packet to a new PD_ELE_T
- *  Check for protocol errors and compare the received data to the data in our receive queue.
- *  If it is a new packet, check if it is a PD Request (PULL).
- *  If it is an update, exchange the existing entry with the new one
- *  Call user's callback if needed
+/** Copy the latest frame of a subscription without locking the session
+ *  Same results as trdp_pdGet() plus the time out check of tlp_get(), but taken from the snapshot written by
+ *  the receive thread. Retries until a consistent copy was read.
  *
- *  @param[in]      appHandle           session pointer
- *  @param[in]      sock                the socket to read from
+ *  @param[in]      pPacket             subscription
+ *  @param[in]      unmarshall          unmarshalling function or NULL
+ *  @param[in]      refCon              context for unmarshalling
+ *  @param[in,out]  pPdInfo             pointer to application's info buffer or NULL
+ *  @param[in,out]  pData               pointer to application's data buffer or NULL
+ *  @param[in,out]  pDataSize           in: size of buffer, out: size of data
  *
  *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_WIRE_ERR       protocol error (late packet, version mismatch)
- *  @retval         TRDP_QUEUE_ERR      not in queue
- *  @retval         TRDP_CRC_ERR        header checksum
- *  @retval         TRDP_TOPOCOUNT_ERR  invalid topocount
+ *  @retval         TRDP_PARAM_ERR      buffer too small
+ *  @retval         TRDP_NODATA_ERR     nothing received yet
+ *  @retval         TRDP_TIMEOUT_ERR    packet timed out
+ *  @retval         else                error of the unmarshaller
  */
-TRDP_ERR_T  trdp_pdReceive (
-    TRDP_SESSION_PT appHandle,
-    SOCKET          sock)
+TRDP_ERR_T trdp_pdSnapGet (
+    PD_ELE_T            *pPacket,
+    TRDP_UNMARSHALL_T   unmarshall,
+    void                *refCon,
+    TRDP_PD_INFO_T      *pPdInfo,
+    UINT8               *pData,
+    UINT32              *pDataSize)
 {
-    PD_HEADER_T         *pNewFrameHead      = &appHandle->pNewFrame->frameHead;
-    PD_ELE_T            *pExistingElement   = NULL;
-    PD_ELE_T            *pPulledElement;
-    TRDP_ERR_T          err             = TRDP_NO_ERR;
-    UINT32              recSize         = TRDP_MAX_PD_PACKET_SIZE;
-    int                 informUser      = FALSE;
-    TRDP_ADDRESSES_T    subAddresses    = { 0u, 0u, 0u, 0u, 0u, 0u, 0u};
+    PD_SNAPSHOT_T   *pSnap = pPacket->pSnap;
+    PD_SNAP_BUF_T   copy;
+    UINT32          version;
+    TRDP_TIME_T     now;
+    TRDP_ERR_T      ret = TRDP_NO_ERR;
 
-    /*  Get the packet from the wire:  */
-    err = (TRDP_ERR_T) vos_sockReceiveUDP(sock,
-                                          (UINT8 *) pNewFrameHead,
-                                          &recSize,
-                                          &subAddresses.srcIpAddr,
-                                          NULL,
-                                          &subAddresses.destIpAddr,
-                                          FALSE);
-    if ( err != TRDP_NO_ERR)
+    for (;; )
     {
-        return err;
+        PD_SNAP_BUF_T   *pBuffer;
+        UINT32          seq;
+
+        version = __atomic_load_n(&pSnap->version, __ATOMIC_ACQUIRE);
+        pBuffer = &pSnap->buffer[version & 1u];
+        seq     = __atomic_load_n(&pBuffer->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1u)
+        {
+            continue;                               /* being written */
+        }
+        copy.srcIpAddr  = pBuffer->srcIpAddr;
+        copy.seqCnt     = pBuffer->seqCnt;
+        copy.dataSize   = pBuffer->dataSize;
+        copy.timeToGo   = pBuffer->timeToGo;
+        copy.rxTime     = pBuffer->rxTime;
+        if (copy.dataSize > TRDP_MAX_PD_DATA_SIZE)
+        {
+            copy.dataSize = TRDP_MAX_PD_DATA_SIZE;  /* torn read, discarded below */
+        }
+        memcpy(&copy.frame, &pBuffer->frame, sizeof(PD_HEADER_T) + copy.dataSize);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&pBuffer->seq, __ATOMIC_RELAXED) == seq)
+        {
+            break;
+        }
     }
 
-    /*  Is packet sane?    */
-    err = trdp_pdCheck(pNewFrameHead, recSize);
+    /*  Update some statistics  */
+    (void) __atomic_add_fetch(&pPacket->getPkts, 1u, __ATOMIC_RELAXED);
 
-    /*  Update statistics   */
-    switch (err)
+    vos_getTime(&now);
+
+    if (timerisset(&pPacket->interval) &&
+        timercmp(&copy.timeToGo, &now, <))
     {
-       case TRDP_NO_ERR:
-           appHandle->stats.pd.numRcv++;
-           break;
-       case TRDP_CRC_ERR:
-           appHandle->stats.pd.numCrcErr++;
-           return err;
-       case TRDP_WIRE_ERR:
-           appHandle->stats.pd.numProtErr++;
-           return err;
-       default:
-           return err;
+        /*    Packet is late    */
+        if ((pPacket->toBehavior == TRDP_TO_SET_TO_ZERO) &&
+            (pData != NULL) && (pDataSize != NULL))
+        {
+            memset(pData, 0, *pDataSize);
+        }
+        ret = TRDP_TIMEOUT_ERR;
     }
-
-    /* First check incoming packet's topoCount against session topoCounts */
-    /* First subscriber check from Table A.5:
-       Actual topography counter values <-> Topography counters of received */
-    if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
-                                  appHandle->opTrnTopoCnt,
-                                  vos_ntohl(pNewFrameHead->etbTopoCnt),
-                                  vos_ntohl(pNewFrameHead->opTrnTopoCnt)))
+    else if (version == 0u)
     {
-        appHandle->stats.pd.numTopoErr++;
-        return TRDP_TOPO_ERR;
+        ret = TRDP_NODATA_ERR;
     }
-
-    /*  Compute the subscription handle */
-    subAddresses.comId          = vos_ntohl(pNewFrameHead->comId);
-    subAddresses.etbTopoCnt     = vos_ntohl(pNewFrameHead->etbTopoCnt);
-    subAddresses.opTrnTopoCnt   = vos_ntohl(pNewFrameHead->opTrnTopoCnt);
-
-    /*  It might be a PULL request      */
-    if (vos_ntohs(pNewFrameHead->msgType) == (UINT16) TRDP_MSG_PR)
+    else if ((pData != NULL) && (pDataSize != NULL))
     {
-        /*  Handle statistics request  */
-        if (vos_ntohl(pNewFrameHead->comId) == TRDP_STATISTICS_PULL_COMID)
+        if (!(pPacket->pktFlags & TRDP_FLAGS_MARSHALL) || (unmarshall == NULL))
         {
-            pPulledElement = trdp_queueFindComId(appHandle->pSndQueue, TRDP_GLOBAL_STATISTICS_COMID);
-            if (pPulledElement != NULL)
+            if (*pDataSize >= copy.dataSize)
             {
-                pPulledElement->addr.comId      = TRDP_GLOBAL_STATISTICS_COMID;
-                pPulledElement->addr.destIpAddr = vos_ntohl(pNewFrameHead->replyIpAddress);
-
-                trdp_pdInit(pPulledElement, TRDP_MSG_PP, appHandle->etbTopoCnt, appHandle->opTrnTopoCnt, 0u, 0u);
-
-                trdp_pdPrepareStats(appHandle, pPulledElement);
+                *pDataSize = copy.dataSize;
+                memcpy(pData, copy.frame.data, copy.dataSize);
             }
             else
             {
-                vos_printLogStr(VOS_LOG_ERROR, "Statistics request failed, not published!\n");
+                ret = TRDP_PARAM_ERR;
             }
         }
         else
         {
-            UINT32 replyComId = vos_ntohl(pNewFrameHead->replyComId);
+            ret = unmarshall(refCon,
+                             pPacket->addr.comId,
+                             copy.frame.data,
+                             copy.dataSize,
+                             pData,
+                             pDataSize,
+                             &pPacket->pCachedDS);
+        }
+    }
 
-            if (replyComId == 0u)
-            {
-                replyComId = vos_ntohl(pNewFrameHead->comId);
-            }
+    if (pPdInfo != NULL)
+    {
+        pPdInfo->comId          = pPacket->addr.comId;
+        pPdInfo->srcIpAddr      = copy.srcIpAddr;
+        pPdInfo->destIpAddr     = pPacket->addr.destIpAddr;
+        pPdInfo->etbTopoCnt     = vos_ntohl(copy.frame.frameHead.etbTopoCnt);
+        pPdInfo->opTrnTopoCnt   = vos_ntohl(copy.frame.frameHead.opTrnTopoCnt);
+        pPdInfo->msgType        = (TRDP_MSG_T) vos_ntohs(copy.frame.frameHead.msgType);
+        pPdInfo->seqCount       = copy.seqCnt;
+        pPdInfo->protVersion    = vos_ntohs(copy.frame.frameHead.protocolVersion);
+        pPdInfo->replyComId     = vos_ntohl(copy.frame.frameHead.replyComId);
+        pPdInfo->replyIpAddr    = vos_ntohl(copy.frame.frameHead.replyIpAddress);
+        pPdInfo->pUserRef       = pPacket->pUserRef;
+        pPdInfo->resultCode     = ret;
+        pPdInfo->rxTime         = copy.rxTime;
+        pPdInfo->numCoalesced   = 0u;
+    }
+    return ret;
+}
 
-            /*  Find requested publish element  */
-            pPulledElement = trdp_queueFindComId(appHandle->pSndQueue, replyComId);
+/******************************************************************************/
+/** PD receive thread of TRDP_OPTION_PD_THREAD
+ *  Waits for the sockets of the subscriptions and reads them with the session locked.
+ *
+ *  @param[in]      pArg                session pointer
+ */
+static void trdp_pdRcvThread (
+    void *pArg)
+{
+    TRDP_SESSION_PT appHandle = (TRDP_SESSION_PT) pArg;
+
+    while (appHandle->pdRcvRun)
+    {
+        TRDP_FDS_T      rfds;
+        INT32           noDesc;
+        VOS_TIMEVAL_T   tv      = {0, TRDP_PD_RCV_THREAD_POLL};
+
+        if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            break;
         }
+        noDesc = trdp_pdRcvFds(appHandle, &rfds);
+        (void) vos_mutexUnlock(appHandle->mutex);
 
-        if (pPulledElement != NULL)
+        if (noDesc < 0)
         {
-            /*  Set the destination address of the requested telegram either to the replyIp or the source Ip of the
-                requester   */
+            (void) vos_threadDelay(TRDP_PD_RCV_THREAD_POLL);
+            continue;
+        }
 
-            if (pNewFrameHead->replyIpAddress != 0u)
+        noDesc = vos_select((SOCKET) noDesc + 1, &rfds, NULL, NULL, &tv);
+        if ((noDesc > 0) && appHandle->pdRcvRun &&
+            (vos_mutexLock(appHandle->mutex) == VOS_NO_ERR))
+        {
+            (void) trdp_pdCheckListenSocks(appHandle, &rfds, &noDesc);
+            (void) vos_mutexUnlock(appHandle->mutex);
+        }
+    }
+    vos_semaGive(appHandle->pdRcvDone);
+}
+
+/******************************************************************************/
+/** Read the frames waiting on a socket of a receive thread (pdShardCnt > 1)
+ *  The socket is read into the buffers of the thread without the session lock, the session is locked to handle the
+ *  frames only. Multicast frames reach all sockets of the group: comIds of another thread are dropped here if the
+ *  socket filter did not already.
+ *
+ *  @param[in]      pShard              receive thread
+ *  @param[in]      socketIdx           index of the socket in the session's socket pool
+ *  @param[in]      sock                the socket
+ */
+static void trdp_pdShardRead (
+    PD_RCV_SHARD_T  *pShard,
+    INT32           socketIdx,
+    SOCKET          sock)
+{
+    TRDP_SESSION_PT appHandle   = pShard->pSession;
+    VOS_SOCK_MSG_T  msgs[TRDP_PD_RCV_BATCH_SIZE];
+    UINT32          fcs[TRDP_PD_RCV_BATCH_SIZE];
+    TRDP_ERR_T      err;
+    UINT32          noFrames    = 0u;
+    UINT32          frames      = 0u;
+    UINT32          i;
+
+    do
+    {
+        for (i = 0u; i < TRDP_PD_RCV_BATCH_SIZE; i++)
+        {
+            msgs[i].pBuffer = (UINT8 *) pShard->pRcvBatch[i];
+            msgs[i].size    = TRDP_MAX_PD_PACKET_SIZE;
+        }
+        if ((vos_sockReceiveUDPBatch(sock, msgs, TRDP_PD_RCV_BATCH_SIZE, &noFrames) != VOS_NO_ERR) ||
+            (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR))
+        {
+            break;
+        }
+        trdp_pdBatchFcs(msgs, noFrames, fcs);
+        for (i = 0u; i < noFrames; i++)
+        {
+            PD_PACKET_T *pTemp = appHandle->pNewFrame;
+
+            if ((msgs[i].size >= sizeof(PD_HEADER_T)) &&
+                ((vos_ntohl(pShard->pRcvBatch[i]->frameHead.comId) % appHandle->pdShardCnt) != pShard->index))
             {
-                pPulledElement->pullIpAddress = vos_ntohl(pNewFrameHead->replyIpAddress);
+                continue;
             }
-            else
+            /*  Handle the frame as if it had been received into pNewFrame  */
+            appHandle->pNewFrame    = pShard->pRcvBatch[i];
+            appHandle->pdRcvTime    = msgs[i].rxTime;
+            err = trdp_pdHandleFrame(appHandle, msgs[i].size, msgs[i].srcIPAddr, msgs[i].dstIPAddr, &fcs[i]);
+            pShard->pRcvBatch[i]    = appHandle->pNewFrame;
+            appHandle->pNewFrame    = pTemp;
+            if ((err != TRDP_NO_ERR) && (err != TRDP_NOSUB_ERR))
             {
-                pPulledElement->pullIpAddress = subAddresses.srcIpAddr;
+                vos_printLog(VOS_LOG_WARNING, "trdp_pdReceive() failed (Err: %d)\n", err);
             }
+        }
+        /* Check the queue while the backlog is still in it */
+        if ((frames < TRDP_PD_RXQ_CHECK_FRAMES) && (frames + noFrames >= TRDP_PD_RXQ_CHECK_FRAMES))
+        {
+            trdp_pdCheckRxQueue(&appHandle->iface[socketIdx]);
+        }
+        frames += noFrames;
+        trdp_pdCallPending(appHandle);
+        (void) vos_mutexUnlock(appHandle->mutex);
+    }
+    while (noFrames == TRDP_PD_RCV_BATCH_SIZE);
+}
 
-            /* trigger immediate sending of PD  */
-            pPulledElement->privFlags |= TRDP_REQ_2B_SENT;
+/******************************************************************************/
+/** PD receive thread of a sharded session
+ *  Waits for the sockets of its comIds, the first thread also for the AF_XDP socket.
+ *
+ *  @param[in]      pArg                receive thread
+ */
+static void trdp_pdShardThread (
+    void *pArg)
+{
+    PD_RCV_SHARD_T  *pShard     = (PD_RCV_SHARD_T *) pArg;
+    TRDP_SESSION_PT appHandle   = pShard->pSession;
+    INT32           sockIdx[VOS_MAX_SOCKET_CNT];
+    SOCKET          socks[VOS_MAX_SOCKET_CNT];
 
-            if (trdp_pdSendQueued(appHandle) != TRDP_NO_ERR)
+    while (appHandle->pdRcvRun)
+    {
+        TRDP_FDS_T      rfds;
+        INT32           noSocks = 0;
+        INT32           noDesc  = -1;
+        SOCKET          xdpSock = VOS_INVALID_SOCKET;
+        INT32           i;
+        VOS_TIMEVAL_T   tv      = {0, TRDP_PD_RCV_THREAD_POLL};
+
+        FD_ZERO((fd_set *)&rfds);
+        if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            break;
+        }
+        for (i = 0; i < VOS_MAX_SOCKET_CNT; i++)
+        {
+            if ((appHandle->iface[i].sock != VOS_INVALID_SOCKET) &&
+                (appHandle->iface[i].shard == pShard->index + 1u))
             {
-                /*  We do not break here, only report error */
-                vos_printLogStr(VOS_LOG_WARNING, "Error sending one or more PD packets\n");
+                sockIdx[noSocks]    = i;
+                socks[noSocks++]    = appHandle->iface[i].sock;
+                FD_SET(appHandle->iface[i].sock, (fd_set *)&rfds);   /*lint !e573 */
+                if ((INT32) appHandle->iface[i].sock > noDesc)
+                {
+                    noDesc = (INT32) appHandle->iface[i].sock;
+                }
             }
+        }
+        if ((pShard->index == 0u) && (appHandle->pdXdp != NULL))
+        {
+            xdpSock = appHandle->pdXdpSock;
+            FD_SET(xdpSock, (fd_set *)&rfds);   /*lint !e573 */
+            if ((INT32) xdpSock > noDesc)
+            {
+                noDesc = (INT32) xdpSock;
+            }
+        }
+        (void) vos_mutexUnlock(appHandle->mutex);
 
-            informUser = TRUE;
+        if (noDesc < 0)
+        {
+            (void) vos_threadDelay(TRDP_PD_RCV_THREAD_POLL);
+            continue;
+        }
+
+        noDesc = vos_select((SOCKET) noDesc + 1, &rfds, NULL, NULL, &tv);
+        if ((noDesc <= 0) || !appHandle->pdRcvRun)
+        {
+            continue;
+        }
+        for (i = 0; i < noSocks; i++)
+        {
+            if (FD_ISSET(socks[i], (fd_set *)&rfds))   /*lint !e573 */
+            {
+                trdp_pdShardRead(pShard, sockIdx[i], socks[i]);
+            }
+        }
+        if ((xdpSock != VOS_INVALID_SOCKET) && FD_ISSET(xdpSock, (fd_set *)&rfds) &&   /*lint !e573 */
+            (vos_mutexLock(appHandle->mutex) == VOS_NO_ERR))
+        {
+            if (appHandle->pdXdp != NULL)
+            {
+                (void) trdp_pdReceiveXdp(appHandle);
+            }
+            (void) vos_mutexUnlock(appHandle->mutex);
         }
     }
+    vos_semaGive(pShard->done);
+}
 
-    /*  Examine subscription queue, are we interested in this PD?   */
-    pExistingElement = trdp_queueFindSubAddr(appHandle->pRcvQueue, &subAddresses);
+/******************************************************************************/
+/** Stop the receive threads of a sharded session, wait for their termination and free them
+ *  The threads' hold on their sockets is released, the sockets are closed with the last subscription.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+static void trdp_pdShardsStop (
+    TRDP_SESSION_PT appHandle)
+{
+    UINT32  i;
+    UINT32  j;
+    INT32   lIndex;
 
-    if (pExistingElement == NULL)
+    appHandle->pdRcvRun = FALSE;
+    for (i = 0u; i < appHandle->pdShardCnt; i++)
     {
-        /*
-        vos_printLog(VOS_LOG_INFO, "No subscription (SrcIp: %s comId %u)\n", vos_ipDotted(subAddresses.srcIpAddr),
-                        vos_ntohl(pNewFrame->frameHead.comId));
-        */
-        err = TRDP_NOSUB_ERR;
-    }
-    else
+        PD_RCV_SHARD_T *pShard = &appHandle->pPdShards[i];
+
+        if (pShard->thread != NULL)
+        {
+            (void) vos_semaTake(pShard->done, VOS_SEMA_WAIT_FOREVER);
+        }
+        if (pShard->done != NULL)
+        {
+            vos_semaDelete(pShard->done);
+        }
+        for (j = 0u; j < TRDP_PD_RCV_BATCH_SIZE; j++)
+        {
+            if (pShard->pRcvBatch[j] != NULL)
+            {
+                vos_memFree(pShard->pRcvBatch[j]);
+            }
+        }
+    }
+    vos_memFree(appHandle->pPdShards);
+    appHandle->pPdShards = NULL;
+
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
     {
-        /*  We check for local communication
-         or if etbTopoCnt and opTrnTopoCnt of the subscription are zero or match */
-        if (((subAddresses.etbTopoCnt == 0) && (subAddresses.opTrnTopoCnt == 0))
-            ||
-            trdp_validTopoCounters(subAddresses.etbTopoCnt,
-                                   subAddresses.opTrnTopoCnt,
-                                   pExistingElement->addr.etbTopoCnt,
-                                   pExistingElement->addr.opTrnTopoCnt))
+        if ((appHandle->iface[lIndex].shard != 0u) && (appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET))
         {
-            UINT32 newSeqCnt = vos_ntohl(pNewFrameHead->sequenceCounter);
-            /* Save the source IP address of the received packet */
-            pExistingElement->lastSrcIP = subAddresses.srcIpAddr;
-            /* Save the real destination of the received packet (own IP or MC group) */
-            pExistingElement->addr.destIpAddr = subAddresses.destIpAddr;
+            appHandle->iface[lIndex].shard = 0u;
+            trdp_releaseSocket(appHandle->iface, lIndex, 0u, FALSE, VOS_INADDR_ANY);
+        }
+    }
+}
 
+/******************************************************************************/
+/** Start the receive threads of a sharded session
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_SEMA_ERR       no semaphore available
+ *  @retval         TRDP_THREAD_ERR     thread could not be created
+ */
+static TRDP_ERR_T trdp_pdShardsStart (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_ERR_T  ret = TRDP_NO_ERR;
+    UINT32      i;
+    UINT32      j;
 
-            if (newSeqCnt == 0u)  /* restarted or new sender */
-            {
-                trdp_resetSequenceCounter(pExistingElement, subAddresses.srcIpAddr,
-                                          (TRDP_MSG_T) vos_ntohs(pNewFrameHead->msgType));
-            }
+    appHandle->pPdShards = (PD_RCV_SHARD_T *) vos_memAlloc(appHandle->pdShardCnt * sizeof(PD_RCV_SHARD_T));
+    if (appHandle->pPdShards == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    appHandle->pdRcvRun = TRUE;
+    for (i = 0u; (i < appHandle->pdShardCnt) && (ret == TRDP_NO_ERR); i++)
+    {
+        PD_RCV_SHARD_T  *pShard = &appHandle->pPdShards[i];
+        CHAR8           name[16];
+        VOS_ERR_T       err;
 
-            /* find sender in our list */
-            switch (trdp_checkSequenceCounter(pExistingElement,
-                                              newSeqCnt,
-                                              subAddresses.srcIpAddr,
-                                              (TRDP_MSG_T) vos_ntohs(pNewFrameHead->msgType)))
+        pShard->pSession    = appHandle;
+        pShard->index       = i;
+        for (j = 0u; j < TRDP_PD_RCV_BATCH_SIZE; j++)
+        {
+            pShard->pRcvBatch[j] = (PD_PACKET_T *) vos_memAllocAligned(TRDP_MAX_PD_PACKET_SIZE, TRDP_PD_FRAME_ALIGN);
+            if (pShard->pRcvBatch[j] == NULL)
             {
-               case 0:                      /* Sequence counter is valid (at least 1 higher than previous one) */
-                   break;
-               case -1:                     /* List overflow */
-                   return TRDP_MEM_ERR;
-               case 1:
-                   vos_printLog(VOS_LOG_INFO, "Old PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
-                                    subAddresses.srcIpAddr), vos_ntohl(pNewFrameHead->comId));
-                   return TRDP_NO_ERR;      /* Ignore packet, too old or duplicate */
+                ret = TRDP_MEM_ERR;
             }
+        }
+        if (ret != TRDP_NO_ERR)
+        {
+            break;
+        }
+        err = vos_semaCreate(&pShard->done, VOS_SEMA_EMPTY);
+        if (err != VOS_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "vos_semaCreate() failed (Err: %d)\n", err);
+            ret = TRDP_SEMA_ERR;
+            break;
+        }
+        (void) vos_snprintf(name, sizeof(name), "trdpPdRcv%u", (unsigned int) i);
+        err = vos_threadCreate(&pShard->thread, name, VOS_THREAD_POLICY_OTHER,
+                               0u, 0u, 0u, trdp_pdShardThread, pShard);
+        if (err != VOS_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "vos_threadCreate() failed (Err: %d)\n", err);
+            pShard->thread  = NULL;
+            ret             = TRDP_THREAD_ERR;
+        }
+    }
+    if (ret != TRDP_NO_ERR)
+    {
+        trdp_pdShardsStop(appHandle);
+    }
+    return ret;
+}
 
-            if ((newSeqCnt > 0u) && (newSeqCnt > (pExistingElement->curSeqCnt + 1u)))
-            {
-                pExistingElement->numMissed += newSeqCnt - pExistingElement->curSeqCnt - 1u;
-            }
-            else if (pExistingElement->curSeqCnt > newSeqCnt)
-            {
-                pExistingElement->numMissed += UINT32_MAX - pExistingElement->curSeqCnt + newSeqCnt;
-            }
+/******************************************************************************/
+/** Start the PD receive thread of a session
+ *  With pdShardCnt > 1, a thread per shard is started instead.
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_SEMA_ERR       no semaphore available
+ *  @retval         TRDP_THREAD_ERR     thread could not be created
+ */
+TRDP_ERR_T trdp_pdRcvThreadStart (
+    TRDP_SESSION_PT appHandle)
+{
+    VOS_ERR_T err;
 
-            /* Store last received sequence counter here, too (pd_get et. al. may access it).   */
-            pExistingElement->curSeqCnt = vos_ntohl(pNewFrameHead->sequenceCounter);
+    if (appHandle->pdShardCnt > 1u)
+    {
+        return trdp_pdShardsStart(appHandle);
+    }
 
-            /*  This might have not been set!   */
-            pExistingElement->dataSize  = vos_ntohl(pNewFrameHead->datasetLength);
-            pExistingElement->grossSize = trdp_packetSizePD(pExistingElement->dataSize);
+    err = vos_semaCreate(&appHandle->pdRcvDone, VOS_SEMA_EMPTY);
+    if (err != VOS_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "vos_semaCreate() failed (Err: %d)\n", err);
+        return TRDP_SEMA_ERR;
+    }
+    appHandle->pdRcvRun = TRUE;
+    err = vos_threadCreate(&appHandle->pdRcvThread, "trdpPdRcv", VOS_THREAD_POLICY_OTHER,
+                           0u, 0u, 0u, trdp_pdRcvThread, appHandle);
+    if (err != VOS_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "vos_threadCreate() failed (Err: %d)\n", err);
+        appHandle->pdRcvRun     = FALSE;
+        appHandle->pdRcvThread  = NULL;
+        vos_semaDelete(appHandle->pdRcvDone);
+        appHandle->pdRcvDone    = NULL;
+        return TRDP_THREAD_ERR;
+    }
+    return TRDP_NO_ERR;
+}
 
-            /*  Has the data changed?   */
-            if (pExistingElement->pktFlags & TRDP_FLAGS_CALLBACK)
-            {
-                if ((pExistingElement->pktFlags & TRDP_FLAGS_FORCE_CB) ||
-                    (pExistingElement->privFlags & TRDP_TIMED_OUT))
-                {
-                    informUser = TRUE;                 /* Inform user anyway */
-                }
-                else if (0 != memcmp(appHandle->pNewFrame->data,
-                                     pExistingElement->pFrame->data,
-                                     pExistingElement->dataSize))
-                {
-                    informUser = TRUE;
-                }
-            }
+/******************************************************************************/
+/** Stop the PD receive thread of a session and wait for its termination
+ *  Must not be called with the session locked.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdRcvThreadStop (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pPdShards != NULL)
+    {
+        trdp_pdShardsStop(appHandle);
+    }
+    if (appHandle->pdRcvThread != NULL)
+    {
+        appHandle->pdRcvRun = FALSE;
+        (void) vos_semaTake(appHandle->pdRcvDone, VOS_SEMA_WAIT_FOREVER);
+        vos_semaDelete(appHandle->pdRcvDone);
+        appHandle->pdRcvDone    = NULL;
+        appHandle->pdRcvThread  = NULL;
+    }
+}
+#endif
 
-            /*  Get the current time and compute the next time this packet should be received.  */
-            vos_getTime(&pExistingElement->timeToGo);
-            vos_addTime(&pExistingElement->timeToGo, &pExistingElement->interval);
+#if TRDP_PD_SND_BATCH_SIZE > 1
+/******************************************************************************/
+/** Account the PD messages of a batch after sending
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pGroup              elements sent
+ *  @param[in]      pMsgs               datagrams of the elements, size holds the bytes sent
+ *  @param[in]      noMsgs              number of elements
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         a message was sent incompletely
+ */
+static TRDP_ERR_T trdp_pdSendBatchDone (
+    TRDP_SESSION_PT         appHandle,
+    PD_ELE_T                *pGroup[],
+    const VOS_SOCK_MSG_T    *pMsgs,
+    UINT32                  noMsgs)
+{
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    UINT32      i;
 
-            /*  Update some statistics  */
-            pExistingElement->numRxTx++;
-            pExistingElement->lastErr   = TRDP_NO_ERR;
-            pExistingElement->privFlags =
-                (TRDP_PRIV_FLAGS_T) (pExistingElement->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_TIMED_OUT);
+    for (i = 0u; i < noMsgs; i++)
+    {
+        pGroup[i]->sendSize = pMsgs[i].size;
+        if (pMsgs[i].size == pGroup[i]->grossSize)
+        {
+            TRDP_STATS_INC(appHandle, pd.numSend);
+            pGroup[i]->numRxTx++;
+            TRDP_REC(appHandle, TRDP_REC_PD_TX, appHandle->realIP, pMsgs[i].dstIPAddr, pMsgs[i].dstIPPort,
+                     pMsgs[i].pBuffer, pMsgs[i].size);
+        }
+        else if (pMsgs[i].size != 0u)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "trdp_pdSend incomplete\n");
+            err = TRDP_IO_ERR;
+        }
+    }
+    return err;
+}
+
+/******************************************************************************/
+/** Send all PD messages collected in the send batch
+ *  The collected elements are grouped by socket, each group is handed to vos_sockSendUDPBatch(). With an io_uring,
+ *  all elements are handed to vos_uringSend() at once.
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ */
+static TRDP_ERR_T trdp_pdSendBatchFlush (
+    TRDP_SESSION_PT appHandle)
+{
+    VOS_SOCK_MSG_T  msgs[TRDP_PD_SND_BATCH_SIZE];
+    PD_ELE_T        *pGroup[TRDP_PD_SND_BATCH_SIZE];
+    TRDP_ERR_T      err = TRDP_NO_ERR;
+    INT32           socketIdx;
+    UINT32          noMsgs;
+    UINT32          noLeft;
+    UINT32          i;
+
+#if TRDP_PD_URING
+    /*  The io_uring sends on all sockets with one call  */
+    if ((appHandle->pdUring != NULL) && (appHandle->sndBatchCnt > 0u))
+    {
+        SOCKET socks[TRDP_PD_SND_BATCH_SIZE];
+
+        noMsgs = appHandle->sndBatchCnt;
+        for (i = 0u; i < noMsgs; i++)
+        {
+            PD_ELE_T *pElement = appHandle->pSndBatch[i];
 
-            /* mark the data as valid */
-            pExistingElement->privFlags =
-                (TRDP_PRIV_FLAGS_T) (pExistingElement->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
+            pElement->sendSize  = pElement->grossSize;
+            socks[i]            = appHandle->iface[pElement->socketIdx].sock;
+            msgs[i].pBuffer     = (UINT8 *)&pElement->pFrame->frameHead;
+            msgs[i].size        = pElement->grossSize;
+            msgs[i].dstIPAddr   = pElement->addr.destIpAddr;
+            msgs[i].dstIPPort   = appHandle->pdDefault.port;
+            msgs[i].qos         = pElement->qos;
+            pGroup[i]           = pElement;
+            TRDP_TRACE2(pd_send, pElement->addr.comId, pElement->grossSize);
+        }
+        appHandle->sndBatchCnt = 0u;
+
+        if (vos_uringSend(appHandle->pdUring, socks, msgs, noMsgs) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "trdp_pdSend failed\n");
+            err = TRDP_IO_ERR;
+        }
+        if (trdp_pdSendBatchDone(appHandle, pGroup, msgs, noMsgs) != TRDP_NO_ERR)
+        {
+            err = TRDP_IO_ERR;
+        }
+        return err;
+    }
+#endif
 
-            /*  remove the old one, insert the new one  */
-            /*  -> always swap the frame pointers              */
+    while (appHandle->sndBatchCnt > 0u)
+    {
+        /*  Take all elements sharing the socket of the first one, keep the others in the batch  */
+        socketIdx   = appHandle->pSndBatch[0]->socketIdx;
+        noMsgs      = 0u;
+        noLeft      = 0u;
+        for (i = 0u; i < appHandle->sndBatchCnt; i++)
+        {
+            PD_ELE_T *pElement = appHandle->pSndBatch[i];
+            if (pElement->socketIdx == socketIdx)
+            {
+                pElement->sendSize          = pElement->grossSize;
+                msgs[noMsgs].pBuffer        = (UINT8 *)&pElement->pFrame->frameHead;
+                msgs[noMsgs].size           = pElement->grossSize;
+                msgs[noMsgs].dstIPAddr      = pElement->addr.destIpAddr;
+                msgs[noMsgs].dstIPPort      = appHandle->pdDefault.port;
+                msgs[noMsgs].qos            = pElement->qos;
+                pGroup[noMsgs++]            = pElement;
+                TRDP_TRACE2(pd_send, pElement->addr.comId, pElement->grossSize);
+            }
+            else
             {
-                PD_PACKET_T *pTemp = pExistingElement->pFrame;
-                pExistingElement->pFrame    = appHandle->pNewFrame;
-                appHandle->pNewFrame        = pTemp;
+                appHandle->pSndBatch[noLeft++] = pElement;
             }
         }
-        else
+        appHandle->sndBatchCnt = noLeft;
+
+        if (vos_sockSendUDPBatch(appHandle->iface[socketIdx].sock, msgs, noMsgs) != VOS_NO_ERR)
         {
-            appHandle->stats.pd.numTopoErr++;
-            pExistingElement->lastErr = TRDP_TOPO_ERR;
-            err         = TRDP_TOPO_ERR;
-            informUser  = TRUE;
+            vos_printLogStr(VOS_LOG_ERROR, "trdp_pdSend failed\n");
+            err = TRDP_IO_ERR;
+        }
+
+        if (trdp_pdSendBatchDone(appHandle, pGroup, msgs, noMsgs) != TRDP_NO_ERR)
+        {
+            err = TRDP_IO_ERR;
         }
     }
+    return err;
+}
+#endif
 
-    if ((pExistingElement != NULL) &&
-        (informUser == TRUE))
+/******************************************************************************/
+/** Check if a due cyclic PD message may be left out (TRDP_FLAGS_PD_ON_CHANGE)
+ *  The data is only hashed if it was written since the last check. Unchanged data is sent every hbCycles intervals.
+ *
+ *  @param[in]      iterPD              element to send
+ *
+ *  @retval         TRUE                data unchanged and no heartbeat due, do not send
+ */
+static BOOL8 trdp_pdUnchanged (
+    PD_ELE_T *iterPD)
+{
+    UINT32 hbCycles;
+
+    if (!(iterPD->pktFlags & TRDP_FLAGS_PD_ON_CHANGE) ||
+        (iterPD->privFlags & TRDP_REQ_2B_SENT) ||
+        (iterPD->pFrame->frameHead.msgType != vos_htons(TRDP_MSG_PD)))
     {
-        /*  If a callback was provided, call it now */
-        if ((pExistingElement->pktFlags & TRDP_FLAGS_CALLBACK)
-            && (pExistingElement->pfCbFunction != NULL))
-        {
-            TRDP_PD_INFO_T theMessage;
-            theMessage.comId        = pExistingElement->addr.comId;
-            theMessage.srcIpAddr    = pExistingElement->lastSrcIP;
-            theMessage.destIpAddr   = subAddresses.destIpAddr;
-            theMessage.etbTopoCnt   = vos_ntohl(pExistingElement->pFrame->frameHead.etbTopoCnt);
-            theMessage.opTrnTopoCnt = vos_ntohl(pExistingElement->pFrame->frameHead.opTrnTopoCnt);
-            theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(pExistingElement->pFrame->frameHead.msgType);
-            theMessage.seqCount     = pExistingElement->curSeqCnt;
-            theMessage.protVersion  = vos_ntohs(pExistingElement->pFrame->frameHead.protocolVersion);
-            theMessage.replyComId   = vos_ntohl(pExistingElement->pFrame->frameHead.replyComId);
-            theMessage.replyIpAddr  = vos_ntohl(pExistingElement->pFrame->frameHead.replyIpAddress);
-            theMessage.pUserRef     = pExistingElement->pUserRef; /* User reference given with the local subscribe? */
-            theMessage.resultCode   = err;
-
-            pExistingElement->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                           appHandle,
-                                           &theMessage,
-                                           pExistingElement->pFrame->data,
-                                           vos_ntohl(pExistingElement->pFrame->frameHead.datasetLength));
+        return FALSE;
+    }
+    if ((iterPD->updPkts != iterPD->txUpdPkts) || (iterPD->numRxTx == 0u))
+    {
+        UINT32 crc = vos_crc32(0xFFFFFFFFu, iterPD->pFrame->data, iterPD->dataSize);
+
+        iterPD->txUpdPkts = iterPD->updPkts;
+        if ((crc != iterPD->txCrc) || (iterPD->numRxTx == 0u))
+        {
+            iterPD->txCrc       = crc;
+            iterPD->hbSkipped   = 0u;
+            return FALSE;
         }
     }
-    return err;
+    hbCycles = (iterPD->hbCycles != 0u) ? iterPD->hbCycles : TRDP_PD_HEARTBEAT_CYCLES;
+    if (++iterPD->hbSkipped >= hbCycles)
+    {
+        iterPD->hbSkipped = 0u;
+        return FALSE;
+    }
+    return TRUE;
 }
 
 /******************************************************************************/
-/** Check for pending packets, set FD if non blocking
+/** Check if a comId is sent delta encoded
  *
  *  @param[in]      appHandle           session pointer
- *  @param[in,out]  pFileDesc           pointer to set of ready descriptors
- *  @param[in,out]  pNoDesc             pointer to number of ready descriptors
+ *  @param[in]      comId               comId of the telegram
+ *
+ *  @retval         TRUE                comId is in the range of tlp_setDeltaRange
  */
-void trdp_pdCheckPending (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_FDS_T          *pFileDesc,
-    INT32               *pNoDesc)
+static BOOL8 trdp_pdDeltaRange (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId)
 {
-    PD_ELE_T *iterPD;
+    return (appHandle->deltaFirstComId != 0u) &&
+           (comId >= appHandle->deltaFirstComId) && (comId <= appHandle->deltaLastComId);
+}
 
-    /*    Walk over the registered PDs, find pending packets */
+/******************************************************************************/
+/** Prepare the delta frame of a publisher in the delta range
+ *  The data is compared to the last key frame, the changed runs are written to pDelta->frame. Runs separated by
+ *  less unchanged bytes than the run overhead are merged. If the delta would not be smaller than the data, or a
+ *  key frame is due, the data is kept as new key frame and the frame is sent in full.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      iterPD              element to send, sequence counter already updated
+ *
+ *  @retval         size of the delta data to send, 0: send the frame in full
+ */
+static UINT32 trdp_pdDeltaEncode (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *iterPD)
+{
+    PD_DELTA_T  *pDelta     = iterPD->pDelta;
+    const UINT8 *pData      = iterPD->pFrame->data;
+    UINT32      dataSize    = vos_ntohl(iterPD->pFrame->frameHead.datasetLength);
+    UINT32      outSize     = TRDP_PD_DELTA_HEAD_SIZE;
+    UINT32      numRuns     = 0u;
+    UINT32      i           = 0u;
 
-    timerclear(&appHandle->nextJob);
+    if (!trdp_pdDeltaRange(appHandle, iterPD->addr.comId) ||
+        (iterPD->pFrame->frameHead.msgType != vos_htons(TRDP_MSG_PD)) ||
+        (dataSize <= TRDP_PD_DELTA_HEAD_SIZE))
+    {
+        return 0u;
+    }
+    if (pDelta == NULL)
+    {
+        pDelta = (PD_DELTA_T *) vos_memAlloc(sizeof(PD_DELTA_T));
+        if (pDelta == NULL)
+        {
+            return 0u;
+        }
+        iterPD->pDelta = pDelta;
+    }
 
-    /*    Find the packet which has to be received next:    */
-    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    if ((pDelta->keySize == dataSize) && ((pDelta->cnt + 1u) < appHandle->deltaKeyCycles))
     {
-        if ((!(iterPD->privFlags & TRDP_TIMED_OUT)) &&              /* Exempt already timed-out packet */
-            timerisset(&iterPD->interval) &&                        /* not PD PULL?                    */
-            (timercmp(&iterPD->timeToGo, &appHandle->nextJob, <) || /* earlier than current time-out?  */
-             !timerisset(&appHandle->nextJob)))                     /* or not set at all?              */
+        UINT8 *pOut = pDelta->frame.data;
+
+        while ((i < dataSize) && (outSize < dataSize))
         {
-            appHandle->nextJob = iterPD->timeToGo;                  /* set new next time value from queue element */
+            UINT32 start;
+            UINT32 end;
+
+            if (pData[i] == pDelta->key[i])
+            {
+                i++;
+                continue;
+            }
+            start   = i;
+            end     = i + 1u;
+            for (i = end; (i < dataSize) && ((i - end) < TRDP_PD_DELTA_RUN_SIZE); i++)
+            {
+                if (pData[i] != pDelta->key[i])
+                {
+                    end = i + 1u;
+                }
+            }
+            i = end;
+            if ((outSize + TRDP_PD_DELTA_RUN_SIZE + end - start) >= dataSize)
+            {
+                outSize = dataSize;
+                break;
+            }
+            pOut[outSize++] = (UINT8) (start >> 8);
+            pOut[outSize++] = (UINT8) start;
+            pOut[outSize++] = (UINT8) ((end - start) >> 8);
+            pOut[outSize++] = (UINT8) (end - start);
+            memcpy(&pOut[outSize], &pData[start], end - start);
+            outSize += end - start;
+            numRuns++;
         }
+        if (outSize < dataSize)
+        {
+            UINT32 myCRC;
 
-        /*    Check and set the socket file descriptor, if not already done    */
-        if (iterPD->socketIdx != -1 &&
-            appHandle->iface[iterPD->socketIdx].sock != -1 &&
-            !FD_ISSET(appHandle->iface[iterPD->socketIdx].sock, (fd_set *)pFileDesc))     /*lint !e573
-                                                                                            signed/unsigned division
-                                                                                            in macro */
+            pOut[0] = (UINT8) (pDelta->keySeqCnt >> 24);
+            pOut[1] = (UINT8) (pDelta->keySeqCnt >> 16);
+            pOut[2] = (UINT8) (pDelta->keySeqCnt >> 8);
+            pOut[3] = (UINT8) pDelta->keySeqCnt;
+            pOut[4] = (UINT8) (dataSize >> 8);
+            pOut[5] = (UINT8) dataSize;
+            pOut[6] = (UINT8) (numRuns >> 8);
+            pOut[7] = (UINT8) numRuns;
+            /*  zero the padding    */
+            for (i = outSize; (i & 3u) != 0u; i++)
+            {
+                pOut[i] = 0u;
+            }
+            pDelta->frame.frameHead                 = iterPD->pFrame->frameHead;
+            pDelta->frame.frameHead.datasetLength   = vos_htonl(outSize);
+            pDelta->frame.frameHead.reserved        = vos_htonl(TRDP_PD_DELTA_TAG);
+            myCRC = vos_crc32(INITFCS, (UINT8 *)&pDelta->frame.frameHead, sizeof(PD_HEADER_T) - SIZE_OF_FCS);
+            pDelta->frame.frameHead.frameCheckSum   = MAKE_LE(myCRC);
+            pDelta->cnt++;
+            return outSize;
+        }
+    }
+
+    /*  Send a key frame    */
+    memcpy(pDelta->key, pData, dataSize);
+    pDelta->keySize     = dataSize;
+    pDelta->keySeqCnt   = iterPD->curSeqCnt;
+    pDelta->cnt         = 0u;
+    return 0u;
+}
+
+/******************************************************************************/
+/** Decode a received delta frame or keep a key frame of a subscription in the delta range
+ *  A delta frame is replaced by the data of its key frame with the changed runs applied.
+ *
+ *  @param[in]      appHandle           session pointer, pNewFrame holds the received frame
+ *  @param[in]      pSub                the subscription
+ *  @param[in]      srcIpAddr           source of the frame
+ *
+ *  @retval         FALSE               delta frame without matching key frame, the frame is lost
+ */
+static BOOL8 trdp_pdDeltaDecode (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pSub,
+    TRDP_IP_ADDR_T  srcIpAddr)
+{
+    PD_PACKET_T *pFrame     = appHandle->pNewFrame;
+    PD_DELTA_T  *pDelta     = pSub->pDelta;
+    UINT32      dataSize    = vos_ntohl(pFrame->frameHead.datasetLength);
+    const UINT8 *pIn        = pFrame->data;
+    UINT32      pos         = TRDP_PD_DELTA_HEAD_SIZE;
+    UINT32      numRuns;
+
+    if (pFrame->frameHead.reserved != vos_htonl(TRDP_PD_DELTA_TAG))
+    {
+        /*  Keep the data of a key frame to decode the following delta frames   */
+        if (trdp_pdDeltaRange(appHandle, vos_ntohl(pFrame->frameHead.comId)) &&
+            (pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))
         {
-            FD_SET(appHandle->iface[iterPD->socketIdx].sock, (fd_set *)pFileDesc);   /*lint !e573
-                                                                                       signed/unsigned division
-                                                                                       in macro */
-            if (appHandle->iface[iterPD->socketIdx].sock > *pNoDesc)
+            if (pDelta == NULL)
             {
-                *pNoDesc = (INT32) appHandle->iface[iterPD->socketIdx].sock;
+                pDelta = (PD_DELTA_T *) vos_memAlloc(sizeof(PD_DELTA_T));
+                if (pDelta == NULL)
+                {
+                    return TRUE;
+                }
+                pSub->pDelta = pDelta;
             }
+            memcpy(pDelta->key, pFrame->data, dataSize);
+            pDelta->keySize     = dataSize;
+            pDelta->keySeqCnt   = vos_ntohl(pFrame->frameHead.sequenceCounter);
+            pDelta->keySrcIp    = srcIpAddr;
         }
+        return TRUE;
     }
 
-    /*    Find packet in send queue which evntually has to be sent earlier:    */
+    if ((pDelta == NULL) ||
+        (pDelta->keySize == 0u) ||
+        (pDelta->keySrcIp != srcIpAddr) ||
+        (dataSize < TRDP_PD_DELTA_HEAD_SIZE) ||
+        ((((UINT32) pIn[0] << 24) | ((UINT32) pIn[1] << 16) | ((UINT32) pIn[2] << 8) | pIn[3]) != pDelta->keySeqCnt) ||
+        ((((UINT32) pIn[4] << 8) | pIn[5]) != pDelta->keySize))
+    {
+        return FALSE;
+    }
+    numRuns = ((UINT32) pIn[6] << 8) | pIn[7];
+
+    memcpy(pDelta->frame.data, pDelta->key, pDelta->keySize);
+    while (numRuns-- > 0u)
+    {
+        UINT32 offset;
+        UINT32 len;
+
+        if ((pos + TRDP_PD_DELTA_RUN_SIZE) > dataSize)
+        {
+            return FALSE;
+        }
+        offset  = ((UINT32) pIn[pos] << 8) | pIn[pos + 1u];
+        len     = ((UINT32) pIn[pos + 2u] << 8) | pIn[pos + 3u];
+        pos    += TRDP_PD_DELTA_RUN_SIZE;
+        if (((offset + len) > pDelta->keySize) || ((pos + len) > dataSize))
+        {
+            return FALSE;
+        }
+        memcpy(&pDelta->frame.data[offset], &pIn[pos], len);
+        pos += len;
+    }
+    memcpy(pFrame->data, pDelta->frame.data, pDelta->keySize);
+    pFrame->frameHead.datasetLength = vos_htonl(pDelta->keySize);
+    pFrame->frameHead.reserved      = 0u;
+    return TRUE;
+}
+
+/******************************************************************************/
+/** Send the prepared frame of a publisher, on its second interface as well
+ *  The frame is marshalled and its CRC computed once. Pulled frames are sent on the first interface only.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      iterPD              element to send
+ *  @param[in]      pLaunchTime         send at this time, NULL for now
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ */
+static TRDP_ERR_T trdp_pdSendIfaces (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *iterPD,
+    const TRDP_TIME_T   *pLaunchTime)
+{
+    TRDP_ERR_T      result;
+    BOOL8           pulled  = (iterPD->pullIpAddress != 0u);
+#if TRDP_RECORDER
+    TRDP_IP_ADDR_T  destIp  = pulled ? iterPD->pullIpAddress : iterPD->addr.destIpAddr;
+#endif
+
+    result = trdp_pdSend(appHandle->iface[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port, pLaunchTime);
+    if (result == TRDP_NO_ERR)
+    {
+        TRDP_REC(appHandle, TRDP_REC_PD_TX, appHandle->realIP, destIp, appHandle->pdDefault.port,
+                 &iterPD->pFrame->frameHead, iterPD->grossSize);
+    }
+
+    if ((iterPD->redSocketIdx != 0u) && !pulled)
+    {
+        TRDP_ERR_T redResult;
+
+        /*  The destination on the second network is passed as temporary address  */
+        iterPD->pullIpAddress = iterPD->redIpAddr;
+        redResult = trdp_pdSend(appHandle->iface[iterPD->redSocketIdx - 1u].sock, iterPD,
+                                appHandle->pdDefault.port, pLaunchTime);
+        iterPD->pullIpAddress = 0u;
+        if (redResult == TRDP_NO_ERR)
+        {
+            TRDP_REC(appHandle, TRDP_REC_PD_TX, iterPD->redIfaceAddr,
+                     (iterPD->redIpAddr != 0u) ? iterPD->redIpAddr : iterPD->addr.destIpAddr,
+                     appHandle->pdDefault.port, &iterPD->pFrame->frameHead, iterPD->grossSize);
+        }
+        else if (result == TRDP_NO_ERR)
+        {
+            result = redResult;
+        }
+    }
+    return result;
+}
+
+/******************************************************************************/
+/** Send one due PD message and compute its next due time
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      iterPD              element to send
+ *  @param[in]      pNow                current time
+ *  @param[out]     pRemoved            TRUE if the element was a one shot request and has been removed from the
+ *                                      schedule (and freed, unless called by tlc_processSend)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ *  @retval         TRDP_TOPO_ERR       topocount out of date
+ */
+static TRDP_ERR_T trdp_pdSendElement (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *iterPD,
+    const TRDP_TIME_T   *pNow,
+    BOOL8               *pRemoved)
+{
+    TRDP_ERR_T  err         = TRDP_NO_ERR;
+    UINT32      deltaSize   = 0u;
+
+    *pRemoved = FALSE;
+
+    /* send only if there is valid data (and, when sent on change, new data or a heartbeat is due) */
+    if (!(iterPD->privFlags & TRDP_INVALID_DATA) && !trdp_pdUnchanged(iterPD))
+    {
+        if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
+            (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))       /*  PULL packet?  */
+        {
+            iterPD->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PP);
+        }
+        /*  Update the sequence counter and re-compute CRC    */
+        trdp_pdUpdate(iterPD);
+
+        if (appHandle->deltaFirstComId != 0u)
+        {
+            deltaSize = trdp_pdDeltaEncode(appHandle, iterPD);
+        }
+
+        /* Publisher check from Table A.5:
+           Actual topography counter values <-> Locally stored with publish */
+        if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
+                                      appHandle->opTrnTopoCnt,
+                                      vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt),
+                                      vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt)))
+        {
+            err = TRDP_TOPO_ERR;
+            vos_printLogStr(VOS_LOG_INFO, "Sending PD: TopoCount is out of date!\n");
+        }
+        /*    In case we're sending on an uninitialized publisher; should never happen. */
+        else if (iterPD->socketIdx == TRDP_INVALID_SOCKET_INDEX)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Sending PD: Socket invalid!\n");
+            /* Try to send the other packets */
+        }
+#if TRDP_PD_SND_BATCH_SIZE > 1
+        /*    Plain cyclic frames are not touched until they are due again and are collected to be sent in one call.
+              Pulled and one shot frames are modified or freed right after sending, callbacks might modify other frames */
+        else if (!trdp_pdIsFollower(iterPD) &&
+                 !(iterPD->privFlags & TRDP_REQ_2B_SENT) &&
+                 !timerisset(&iterPD->txLead) &&
+                 (iterPD->pfCbFunction == NULL) &&
+                 (deltaSize == 0u) &&
+                 (iterPD->redSocketIdx == 0u) &&
+                 (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))
+        {
+            appHandle->pSndBatch[appHandle->sndBatchCnt++] = iterPD;
+            if (appHandle->sndBatchCnt == TRDP_PD_SND_BATCH_SIZE)
+            {
+                err = trdp_pdSendBatchFlush(appHandle);
+            }
+        }
+#endif
+        /*    Send the packet if it is not redundant    */
+        else if (!trdp_pdIsFollower(iterPD))
+        {
+            TRDP_ERR_T result;
+#if TRDP_PD_SND_BATCH_SIZE > 1
+            /*    Keep the sending order: collected frames go first    */
+            result = trdp_pdSendBatchFlush(appHandle);
+            if (result != TRDP_NO_ERR)
+            {
+                err = result;
+            }
+#endif
+            if (iterPD->pfCbFunction != NULL)
+            {
+                TRDP_PD_INFO_T theMessage;
+                theMessage.comId        = iterPD->addr.comId;
+                theMessage.srcIpAddr    = iterPD->addr.srcIpAddr;
+                theMessage.destIpAddr   = iterPD->addr.destIpAddr;
+                theMessage.etbTopoCnt   = vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt);
+                theMessage.opTrnTopoCnt = vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt);
+                theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(iterPD->pFrame->frameHead.msgType);
+                theMessage.seqCount     = iterPD->curSeqCnt;
+                theMessage.protVersion  = vos_ntohs(iterPD->pFrame->frameHead.protocolVersion);
+                theMessage.replyComId   = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
+                theMessage.replyIpAddr  = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
+                theMessage.pUserRef     = iterPD->pUserRef; /* User reference given with the local subscribe? */
+                theMessage.resultCode   = err;
+                timerclear(&theMessage.rxTime);
+                theMessage.numCoalesced = 0u;
+
+                TRDP_TRACE2(pd_callback, theMessage.comId, err);
+                iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
+                                     appHandle,
+                                     &theMessage,
+                                     iterPD->pFrame->data,
+                                     vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
+                TRDP_TRACE1(pd_callback_done, theMessage.comId);
+            }
+            /* We pass the error to the application, but we keep on going    */
+            if (deltaSize != 0u)
+            {
+                /*  Send the delta frame instead, the full frame stays the reference of the next one  */
+                PD_PACKET_T *pFull      = iterPD->pFrame;
+                UINT32      grossSize   = iterPD->grossSize;
+
+                iterPD->pFrame      = &iterPD->pDelta->frame;
+                iterPD->grossSize   = trdp_packetSizePD(deltaSize);
+                result = trdp_pdSendIfaces(appHandle, iterPD,
+                                           (timerisset(&iterPD->txLead) && !(iterPD->privFlags & TRDP_REQ_2B_SENT)) ?
+                                           &iterPD->timeToGo : NULL);
+                iterPD->pFrame      = pFull;
+                iterPD->grossSize   = grossSize;
+            }
+            else
+            {
+                result = trdp_pdSendIfaces(appHandle, iterPD,
+                                           (timerisset(&iterPD->txLead) && !(iterPD->privFlags & TRDP_REQ_2B_SENT)) ?
+                                           &iterPD->timeToGo : NULL);
+            }
+            if (result == TRDP_NO_ERR)
+            {
+                TRDP_STATS_INC(appHandle, pd.numSend);
+                iterPD->numRxTx++;
+            }
+            else
+            {
+                err = result;   /* pass last error to application  */
+            }
+        }
+    }
+
+    if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
+        (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PP)))       /*  PULL packet?  */
+    {
+        /* Do not reset timer, but restore msgType */
+        iterPD->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PD);
+    }
+    else if (timerisset(&iterPD->interval))
+    {
+#if TRDP_TIMING_STATS
+        if ((appHandle->option & TRDP_OPTION_TIMING_STATS) &&
+            !(iterPD->privFlags & TRDP_INVALID_DATA))
+        {
+            trdp_timingAdd(appHandle, TRDP_TIMING_PD_SEND_LATE, &iterPD->timeToGo, pNow);
+        }
+#endif
+        /*  Set timer if interval was set.
+            In case of a requested cyclically PD packet, this will lead to one time jump (jitter) in the interval
+        */
+        vos_addTime(&iterPD->timeToGo, &iterPD->interval);
+
+        if (vos_cmpTime(&iterPD->timeToGo, pNow) <= 0)
+        {
+            /* in case of a delay of more than one interval - avoid sending it in the next cycle again */
+            iterPD->timeToGo = *pNow;
+            vos_addTime(&iterPD->timeToGo, &iterPD->interval);
+        }
+    }
+
+    /* Reset "immediate" flag for request or requested packet */
+    iterPD->privFlags = (TRDP_PRIV_FLAGS_T) (iterPD->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_REQ_2B_SENT);
+
+
+    /* remove one shot messages after they have been sent */
+    if (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PR))    /* Ticket #172: remove element */
+    {
+        trdp_pdSchedRemove(appHandle, iterPD);
+        *pRemoved = TRUE;
+
+        /* tlc_processSend must not touch the socket pool, the request is freed by tlc_processTimeouts */
+        if (!appHandle->sndOnly)
+        {
+            trdp_pdFreeRequest(appHandle, iterPD);
+        }
+    }
+    return err;
+}
+
+/******************************************************************************/
+/** Free a sent PD request
+ *
+ *  @param[in]      appHandle           session pointer, locked including the send side
+ *  @param[in]      iterPD              one shot request element, not in the schedule
+ */
+static void trdp_pdFreeRequest (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *iterPD)
+{
+    /* Decrease the socket ref */
+    trdp_releaseSocket(appHandle->iface, iterPD->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+    /* Remove current element */
+    trdp_sndQueueDelElement(appHandle, iterPD);
+    iterPD->magic = 0u;
+    if (iterPD->pSeqCntList != NULL)
+    {
+        vos_memFree(iterPD->pSeqCntList);
+    }
+    if (iterPD->pDelta != NULL)
+    {
+        vos_memFree(iterPD->pDelta);
+    }
+    vos_memFree(iterPD->pFrame);
+    vos_memFree(iterPD);
+}
+
+/******************************************************************************/
+/** Free the PD requests sent by tlc_processSend
+ *
+ *  @param[in]      appHandle           session pointer, locked including the send side
+ */
+void trdp_pdPurgeRequests (
+    TRDP_SESSION_PT appHandle)
+{
+    PD_ELE_T *iterPD = appHandle->pSndQueue;
+
+    while (iterPD != NULL)
+    {
+        PD_ELE_T *pNext = iterPD->pNext;
+
+        if ((iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PR)) &&
+            !(iterPD->privFlags & TRDP_REQ_2B_SENT))
+        {
+            trdp_pdFreeRequest(appHandle, iterPD);
+        }
+        iterPD = pNext;
+    }
+}
+
+#if !TRDP_PD_SEND_SCHEDULER
+/******************************************************************************/
+/** Check if a cyclic PD message is due
+ *  Frames with launch time are due one lead time before their send time.
+ *
+ *  @param[in]      pPacket             send queue element
+ *  @param[in]      pNow                current time
+ *
+ *  @retval         TRUE                if the frame has to be sent now
+ */
+static BOOL8 trdp_pdIsDue (
+    const PD_ELE_T      *pPacket,
+    const TRDP_TIME_T   *pNow)
+{
+    TRDP_TIME_T horizon;
+
+    if (!timerisset(&pPacket->txLead))
+    {
+        return !timercmp(&pPacket->timeToGo, pNow, >);
+    }
+    horizon = *pNow;
+    vos_addTime(&horizon, &pPacket->txLead);
+    return !timercmp(&pPacket->timeToGo, &horizon, >);
+}
+#endif
+
+/******************************************************************************/
+/** Send all due PD messages
+ *  With TRDP_PD_SEND_SCHEDULER only the elements at the top of the schedule which are due are visited,
+ *  otherwise the whole send queue is scanned.
+ *  With TRDP_PD_SND_BATCH_SIZE > 1 the due frames of cyclic publishers are collected and sent per socket in one call.
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ */
+TRDP_ERR_T  trdp_pdSendQueued (
+    TRDP_SESSION_PT appHandle)
+{
+    PD_ELE_T    *iterPD;
+    TRDP_TIME_T now;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    TRDP_ERR_T  result;
+    BOOL8       removed;
+#if TRDP_PD_SEND_SCHEDULER
+    UINT32      prioClass;
+#endif
+
+    /*    Get the current time    */
+    trdp_getNow(appHandle, &now);
+
+#if TRDP_PD_SEND_SCHEDULER
+    /*    The due PDs of higher priority classes are sent first,
+          each schedule is ordered by due time, requests to be sent first    */
+    for (prioClass = TRDP_PD_PRIO_CLASSES; prioClass-- > 0u; )
+    {
+        TRDP_PD_SCHED_T *pSched = appHandle->pSndSched[prioClass];
+
+        while (appHandle->sndSchedCnt[prioClass] > 0u)
+        {
+            if ((pSched[0].immediate == 0u) &&
+                timercmp(&pSched[0].due, &now, >))
+            {
+                break;
+            }
+            iterPD = pSched[0].pElement;
+            result = trdp_pdSendElement(appHandle, iterPD, &now, &removed);
+            if (result != TRDP_NO_ERR)
+            {
+                err = result;   /* pass last error to application  */
+            }
+            if (!removed)
+            {
+                trdp_pdSchedUpdate(appHandle, iterPD);
+            }
+            pSched = appHandle->pSndSched[prioClass];   /* may have been enlarged by a new request */
+        }
+    }
+#else
+    iterPD = appHandle->pSndQueue;
+
+    /*    Find the packet which has to be sent next:    */
+    while (iterPD != NULL)
+    {
+        PD_ELE_T *pNext = iterPD->pNext;
+
+        /*  Is this a cyclic packet and
+         due to sent?
+         or is it a PD Request or a requested packet (PULL) ?
+         */
+        if ((timerisset(&iterPD->interval) &&                   /*  Request for immediate sending   */
+             trdp_pdIsDue(iterPD, &now)) ||
+            (iterPD->privFlags & TRDP_REQ_2B_SENT))
+        {
+            result = trdp_pdSendElement(appHandle, iterPD, &now, &removed);
+            if (result != TRDP_NO_ERR)
+            {
+                err = result;   /* pass last error to application  */
+            }
+        }
+        iterPD = pNext;
+    }
+#endif
+#if TRDP_PD_SND_BATCH_SIZE > 1
+    result = trdp_pdSendBatchFlush(appHandle);
+    if (result != TRDP_NO_ERR)
+    {
+        err = result;
+    }
+#endif
+    return err;
+}
+
+#if TRDP_PD_SEND_SCHEDULER || TRDP_PD_TIMEOUT_TABLE
+/******************************************************************************/
+/** Compare the due times of two schedule entries
+ *  Entries flagged for immediate sending are due before any cyclic entry.
+ *
+ *  @param[in]      pA                  first entry
+ *  @param[in]      pB                  second entry
+ *
+ *  @retval         TRUE                if pA is due before pB
+ */
+static BOOL8 trdp_pdSchedEarlier (
+    const TRDP_PD_SCHED_T   *pA,
+    const TRDP_PD_SCHED_T   *pB)
+{
+    if (pA->immediate != pB->immediate)
+    {
+        return (pA->immediate != 0u) ? TRUE : FALSE;
+    }
+    return vos_cmpTime(&pA->due, &pB->due) < 0;
+}
+
+/******************************************************************************/
+/** Swap two entries of a schedule
+ *
+ *  @param[in]      pHeap               send schedule or time out heap
+ *  @param[in]      i                   index of first entry
+ *  @param[in]      j                   index of second entry
+ */
+static void trdp_pdSchedSwap (
+    TRDP_PD_SCHED_T *pHeap,
+    UINT32          i,
+    UINT32          j)
+{
+    TRDP_PD_SCHED_T temp = pHeap[i];
+
+    pHeap[i]    = pHeap[j];
+    pHeap[j]    = temp;
+    pHeap[i].pElement->schedIdx = i + 1u;
+    pHeap[j].pElement->schedIdx = j + 1u;
+}
+
+/******************************************************************************/
+/** Restore the heap order for one entry
+ *
+ *  @param[in]      pHeap               send schedule or time out heap
+ *  @param[in]      cnt                 number of entries in the heap
+ *  @param[in]      idx                 index of the entry which changed
+ */
+static void trdp_pdSchedFix (
+    TRDP_PD_SCHED_T *pHeap,
+    UINT32          cnt,
+    UINT32          idx)
+{
+    /*  Move up, while earlier than parent  */
+    while ((idx > 0u) && trdp_pdSchedEarlier(&pHeap[idx], &pHeap[(idx - 1u) / 2u]))
+    {
+        trdp_pdSchedSwap(pHeap, idx, (idx - 1u) / 2u);
+        idx = (idx - 1u) / 2u;
+    }
+
+    /*  Move down, while a child is earlier  */
+    for (;; )
+    {
+        UINT32  child   = 2u * idx + 1u;
+        UINT32  least   = idx;
+
+        if ((child < cnt) && trdp_pdSchedEarlier(&pHeap[child], &pHeap[least]))
+        {
+            least = child;
+        }
+        if ((child + 1u < cnt) && trdp_pdSchedEarlier(&pHeap[child + 1u], &pHeap[least]))
+        {
+            least = child + 1u;
+        }
+        if (least == idx)
+        {
+            break;
+        }
+        trdp_pdSchedSwap(pHeap, idx, least);
+        idx = least;
+    }
+}
+#endif
+
+#if TRDP_PD_SEND_SCHEDULER
+/******************************************************************************/
+/** Remove an element from the send schedule
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            element to remove
+ */
+void trdp_pdSchedRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    UINT32          idx;
+    UINT32          prioClass;
+    TRDP_PD_SCHED_T *pSched;
+
+    if ((appHandle == NULL) || (pElement == NULL) || (pElement->schedIdx == 0u))
+    {
+        return;
+    }
+
+    prioClass   = TRDP_PD_PRIO_CLASS(pElement->prio);
+    pSched      = appHandle->pSndSched[prioClass];
+    idx         = pElement->schedIdx - 1u;
+    pElement->schedIdx = 0u;
+    appHandle->sndSchedCnt[prioClass]--;
+
+    if (idx != appHandle->sndSchedCnt[prioClass])
+    {
+        pSched[idx] = pSched[appHandle->sndSchedCnt[prioClass]];
+        pSched[idx].pElement->schedIdx = idx + 1u;
+        trdp_pdSchedFix(pSched, appHandle->sndSchedCnt[prioClass], idx);
+    }
+}
+
+/******************************************************************************/
+/** Insert, re-sort or remove an element of the send queue in the send schedule
+ *  Must be called whenever timeToGo, interval or TRDP_REQ_2B_SENT of a publisher was changed.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            changed element
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        schedule could not be enlarged
+ */
+TRDP_ERR_T trdp_pdSchedUpdate (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    TRDP_PD_SCHED_T *pEntry;
+    UINT32          prioClass;
+
+    if ((appHandle == NULL) || (pElement == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /*  Elements without interval are scheduled only if a sending was requested (PULL)   */
+    if (!timerisset(&pElement->interval) && !(pElement->privFlags & TRDP_REQ_2B_SENT))
+    {
+        trdp_pdSchedRemove(appHandle, pElement);
+        return TRDP_NO_ERR;
+    }
+
+    /*  The priority of a publisher does not change, it stays in the schedule of its class  */
+    prioClass = TRDP_PD_PRIO_CLASS(pElement->prio);
+    if (pElement->schedIdx == 0u)
+    {
+        if (appHandle->sndSchedCnt[prioClass] >= appHandle->sndSchedSize[prioClass])
+        {
+            UINT32          newSize     = (appHandle->sndSchedSize[prioClass] == 0u) ?
+                TRDP_PD_SCHED_START_SIZE : 2u * appHandle->sndSchedSize[prioClass];
+            TRDP_PD_SCHED_T *pNewSched  = (TRDP_PD_SCHED_T *) vos_memAlloc(newSize * sizeof(TRDP_PD_SCHED_T));
+
+            if (pNewSched == NULL)
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "trdp_pdSchedUpdate: Out of memory!\n");
+                return TRDP_MEM_ERR;
+            }
+            if (appHandle->pSndSched[prioClass] != NULL)
+            {
+                memcpy(pNewSched, appHandle->pSndSched[prioClass],
+                       appHandle->sndSchedCnt[prioClass] * sizeof(TRDP_PD_SCHED_T));
+                vos_memFree(appHandle->pSndSched[prioClass]);
+            }
+            appHandle->pSndSched[prioClass]     = pNewSched;
+            appHandle->sndSchedSize[prioClass]  = newSize;
+        }
+        appHandle->pSndSched[prioClass][appHandle->sndSchedCnt[prioClass]].pElement = pElement;
+        pElement->schedIdx = ++appHandle->sndSchedCnt[prioClass];
+    }
+
+    /*  Refresh the due time kept in the schedule    */
+    pEntry = &appHandle->pSndSched[prioClass][pElement->schedIdx - 1u];
+    pEntry->immediate   = (pElement->privFlags & TRDP_REQ_2B_SENT) ? 1u : 0u;
+    pEntry->due         = pElement->timeToGo;
+    vos_subTime(&pEntry->due, &pElement->txLead);
+
+    trdp_pdSchedFix(appHandle->pSndSched[prioClass], appHandle->sndSchedCnt[prioClass], pElement->schedIdx - 1u);
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Rebuild the send schedule from the send queue
+ *  Used after the due times of several elements have been changed (traffic shaping)
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_pdSchedRebuild (
+    TRDP_SESSION_PT appHandle)
+{
+    PD_ELE_T    *iterPD;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if (trdp_pdSchedUpdate(appHandle, iterPD) != TRDP_NO_ERR)
+        {
+            err = TRDP_MEM_ERR;
+        }
+    }
+    return err;
+}
+
+/******************************************************************************/
+/** Free the send schedules
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdSchedFree (
+    TRDP_SESSION_PT appHandle)
+{
+    UINT32 prioClass;
+
+    for (prioClass = 0u; prioClass < TRDP_PD_PRIO_CLASSES; prioClass++)
+    {
+        if (appHandle->pSndSched[prioClass] != NULL)
+        {
+            vos_memFree(appHandle->pSndSched[prioClass]);
+        }
+        appHandle->pSndSched[prioClass]     = NULL;
+        appHandle->sndSchedCnt[prioClass]   = 0u;
+        appHandle->sndSchedSize[prioClass]  = 0u;
+    }
+}
+#endif
+
+#if TRDP_PD_TIMEOUT_TABLE
+/******************************************************************************/
+/** Remove a subscription from the time out heap
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            subscription to remove
+ */
+void trdp_pdTimeoutRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    UINT32 idx;
+
+    if ((appHandle == NULL) || (pElement == NULL) || (pElement->schedIdx == 0u))
+    {
+        return;
+    }
+
+    idx = pElement->schedIdx - 1u;
+    pElement->schedIdx = 0u;
+    appHandle->rcvTimeoutCnt--;
+
+    if (idx != appHandle->rcvTimeoutCnt)
+    {
+        appHandle->pRcvTimeouts[idx] = appHandle->pRcvTimeouts[appHandle->rcvTimeoutCnt];
+        appHandle->pRcvTimeouts[idx].pElement->schedIdx = idx + 1u;
+        trdp_pdSchedFix(appHandle->pRcvTimeouts, appHandle->rcvTimeoutCnt, idx);
+    }
+}
+
+/******************************************************************************/
+/** Insert, refresh or remove a subscription in the time out heap
+ *  Must be called whenever timeToGo, interval or TRDP_TIMED_OUT of a subscription was changed.
+ *  A time out moved to a later time (the usual case on reception) is not re-sorted: the heap keeps the earlier
+ *  time, which is corrected by trdp_pdHandleTimeOuts() once it is reached (lazy update).
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            changed subscription
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        table could not be enlarged
+ */
+TRDP_ERR_T trdp_pdTimeoutUpdate (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement)
+{
+    if ((appHandle == NULL) || (pElement == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /*  Only supervised subscriptions which did not time out yet are kept, statistics are never reported    */
+    if (!timerisset(&pElement->interval) ||
+        !timerisset(&pElement->timeToGo) ||
+        (pElement->privFlags & TRDP_TIMED_OUT) ||
+        (pElement->addr.comId == TRDP_STATISTICS_PULL_COMID))
+    {
+        trdp_pdTimeoutRemove(appHandle, pElement);
+        return TRDP_NO_ERR;
+    }
+
+    if (pElement->schedIdx == 0u)
+    {
+        if (appHandle->rcvTimeoutCnt >= appHandle->rcvTimeoutSize)
+        {
+            UINT32          newSize     = (appHandle->rcvTimeoutSize == 0u) ?
+                TRDP_PD_TIMEOUT_START_SIZE : 2u * appHandle->rcvTimeoutSize;
+            TRDP_PD_SCHED_T *pNewTable  = (TRDP_PD_SCHED_T *) vos_memAlloc(newSize * sizeof(TRDP_PD_SCHED_T));
+
+            if (pNewTable == NULL)
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "trdp_pdTimeoutUpdate: Out of memory!\n");
+                return TRDP_MEM_ERR;
+            }
+            if (appHandle->pRcvTimeouts != NULL)
+            {
+                memcpy(pNewTable, appHandle->pRcvTimeouts, appHandle->rcvTimeoutCnt * sizeof(TRDP_PD_SCHED_T));
+                vos_memFree(appHandle->pRcvTimeouts);
+            }
+            appHandle->pRcvTimeouts     = pNewTable;
+            appHandle->rcvTimeoutSize   = newSize;
+        }
+        appHandle->pRcvTimeouts[appHandle->rcvTimeoutCnt].pElement  = pElement;
+        appHandle->pRcvTimeouts[appHandle->rcvTimeoutCnt].immediate = 0u;
+        appHandle->pRcvTimeouts[appHandle->rcvTimeoutCnt].due       = pElement->timeToGo;
+        pElement->schedIdx = ++appHandle->rcvTimeoutCnt;
+    }
+    else if (!timercmp(&pElement->timeToGo, &appHandle->pRcvTimeouts[pElement->schedIdx - 1u].due, <))
+    {
+        return TRDP_NO_ERR;                         /* later or same time out, corrected lazily */
+    }
+
+    appHandle->pRcvTimeouts[pElement->schedIdx - 1u].due = pElement->timeToGo;
+    trdp_pdSchedFix(appHandle->pRcvTimeouts, appHandle->rcvTimeoutCnt, pElement->schedIdx - 1u);
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Free the time out heap
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdTimeoutFree (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pRcvTimeouts != NULL)
+    {
+        vos_memFree(appHandle->pRcvTimeouts);
+    }
+    appHandle->pRcvTimeouts     = NULL;
+    appHandle->rcvTimeoutCnt    = 0u;
+    appHandle->rcvTimeoutSize   = 0u;
+}
+#endif
+
+#if TRDP_PD_PULL_HASH_SIZE > 0
+/******************************************************************************/
+/** Insert a pull request into the deadline list
+ *  Requests usually get the same time out, their deadlines are searched from the end of the list.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPull               request, not in the list
+ */
+static void trdp_pdPullLink (
+    TRDP_SESSION_PT appHandle,
+    TRDP_PD_PULL_T  *pPull)
+{
+    TRDP_PD_PULL_T *pIter = appHandle->pPullLast;
+
+    while ((pIter != NULL) && timercmp(&pIter->deadline, &pPull->deadline, >))
+    {
+        pIter = pIter->pPrev;
+    }
+    pPull->pPrev = pIter;
+    if (pIter == NULL)
+    {
+        pPull->pNext = appHandle->pPullFirst;
+        appHandle->pPullFirst = pPull;
+    }
+    else
+    {
+        pPull->pNext = pIter->pNext;
+        pIter->pNext = pPull;
+    }
+    if (pPull->pNext == NULL)
+    {
+        appHandle->pPullLast = pPull;
+    }
+    else
+    {
+        pPull->pNext->pPrev = pPull;
+    }
+}
+
+/******************************************************************************/
+/** Remove a pull request from the deadline list
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPull               request in the list
+ */
+static void trdp_pdPullUnlink (
+    TRDP_SESSION_PT appHandle,
+    TRDP_PD_PULL_T  *pPull)
+{
+    if (pPull->pPrev == NULL)
+    {
+        appHandle->pPullFirst = pPull->pNext;
+    }
+    else
+    {
+        pPull->pPrev->pNext = pPull->pNext;
+    }
+    if (pPull->pNext == NULL)
+    {
+        appHandle->pPullLast = pPull->pPrev;
+    }
+    else
+    {
+        pPull->pNext->pPrev = pPull->pPrev;
+    }
+    pPull->pPrev = NULL;
+    pPull->pNext = NULL;
+}
+
+/******************************************************************************/
+/** Remove a pull request from the index and free it
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPull               request in the index
+ */
+static void trdp_pdPullDelete (
+    TRDP_SESSION_PT appHandle,
+    TRDP_PD_PULL_T  *pPull)
+{
+    TRDP_PD_PULL_T * *ppIter;
+
+    for (ppIter = &appHandle->pPullHash[TRDP_PULL_HASH(pPull->replyComId, pPull->replierIpAddr)];
+         *ppIter != NULL;
+         ppIter = &(*ppIter)->pNextHash)
+    {
+        if (*ppIter == pPull)
+        {
+            *ppIter = pPull->pNextHash;
+            break;
+        }
+    }
+    trdp_pdPullUnlink(appHandle, pPull);
+    appHandle->pullCnt--;
+    vos_memFree(pPull);
+}
+
+/******************************************************************************/
+/** Find a pull request in the index
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      replyComId          comId of the reply
+ *  @param[in]      replierIpAddr       pulled device, 0 for multicast requests
+ *
+ *  @retval         != NULL             the request
+ *  @retval         NULL                none outstanding
+ */
+static TRDP_PD_PULL_T *trdp_pdPullFind (
+    TRDP_SESSION_PT appHandle,
+    UINT32          replyComId,
+    TRDP_IP_ADDR_T  replierIpAddr)
+{
+    TRDP_PD_PULL_T *pIter;
+
+    for (pIter = appHandle->pPullHash[TRDP_PULL_HASH(replyComId, replierIpAddr)];
+         pIter != NULL;
+         pIter = pIter->pNextHash)
+    {
+        if ((pIter->replyComId == replyComId) && (pIter->replierIpAddr == replierIpAddr))
+        {
+            return pIter;
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************/
+/** Enter an outstanding pull request into the index
+ *  A request repeated before the reply arrived only moves the deadline. If the in-flight limit is reached, expired
+ *  requests are dropped first.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSub                subscription receiving the reply
+ *  @param[in]      replyComId          comId of the reply
+ *  @param[in]      replierIpAddr       pulled device, 0 for multicast requests
+ *  @param[in]      pDeadline           the request is dropped unanswered at this time
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_QUEUE_FULL_ERR in-flight limit reached
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_pdPullAdd (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pSub,
+    UINT32              replyComId,
+    TRDP_IP_ADDR_T      replierIpAddr,
+    const TRDP_TIME_T   *pDeadline)
+{
+    TRDP_PD_PULL_T  *pPull = trdp_pdPullFind(appHandle, replyComId, replierIpAddr);
+    UINT32          idx;
+
+    if (pPull != NULL)
+    {
+        pPull->pSub     = pSub;
+        pPull->deadline = *pDeadline;
+        trdp_pdPullUnlink(appHandle, pPull);
+        trdp_pdPullLink(appHandle, pPull);
+        return TRDP_NO_ERR;
+    }
+
+    if ((appHandle->pullMax != 0u) && (appHandle->pullCnt >= appHandle->pullMax))
+    {
+        TRDP_TIME_T now;
+
+        trdp_getNow(appHandle, &now);
+        trdp_pdPullExpire(appHandle, &now);
+        if (appHandle->pullCnt >= appHandle->pullMax)
+        {
+            return TRDP_QUEUE_FULL_ERR;
+        }
+    }
+
+    pPull = (TRDP_PD_PULL_T *) vos_memAlloc(sizeof(TRDP_PD_PULL_T));
+    if (pPull == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pPull->replyComId       = replyComId;
+    pPull->replierIpAddr    = replierIpAddr;
+    pPull->pSub             = pSub;
+    pPull->deadline         = *pDeadline;
+
+    idx = TRDP_PULL_HASH(replyComId, replierIpAddr);
+    pPull->pNextHash        = appHandle->pPullHash[idx];
+    appHandle->pPullHash[idx] = pPull;
+    trdp_pdPullLink(appHandle, pPull);
+    appHandle->pullCnt++;
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Match a received pull reply to its request
+ *  A reply from the pulled device completes the request. Requests sent to a multicast group are answered by several
+ *  devices, they stay in the index until their deadline.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      comId               comId of the reply
+ *  @param[in]      srcIpAddr           source of the reply
+ *
+ *  @retval         != NULL             subscription of the request
+ *  @retval         NULL                no request outstanding
+ */
+PD_ELE_T *trdp_pdPullMatch (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr)
+{
+    TRDP_PD_PULL_T  *pPull = trdp_pdPullFind(appHandle, comId, srcIpAddr);
+    PD_ELE_T        *pSub;
+
+    if (pPull != NULL)
+    {
+        pSub = pPull->pSub;
+        trdp_pdPullDelete(appHandle, pPull);
+        return pSub;
+    }
+    pPull = trdp_pdPullFind(appHandle, comId, VOS_INADDR_ANY);
+    return (pPull != NULL) ? pPull->pSub : NULL;
+}
+
+/******************************************************************************/
+/** Drop the pull requests whose deadline has been reached
+ *  Only the expired requests at the head of the deadline list are visited.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pNow                current time
+ */
+void trdp_pdPullExpire (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pNow)
+{
+    while ((appHandle->pPullFirst != NULL) && !timercmp(&appHandle->pPullFirst->deadline, pNow, >))
+    {
+        if (appHandle->pPullFirst->replierIpAddr != VOS_INADDR_ANY)
+        {
+            appHandle->pullExpired++;
+            vos_printLog(VOS_LOG_DBG, "PD Request (comId: %u) to %s not answered\n",
+                         (unsigned int) appHandle->pPullFirst->replyComId,
+                         vos_ipDotted(appHandle->pPullFirst->replierIpAddr));
+        }
+        trdp_pdPullDelete(appHandle, appHandle->pPullFirst);
+    }
+}
+
+/******************************************************************************/
+/** Remove the pull requests of a subscription, or all
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSub                subscription, NULL for all requests
+ */
+void trdp_pdPullRemoveSub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pSub)
+{
+    TRDP_PD_PULL_T  *pIter = appHandle->pPullFirst;
+    TRDP_PD_PULL_T  *pNext;
+
+    while (pIter != NULL)
+    {
+        pNext = pIter->pNext;
+        if ((pSub == NULL) || (pIter->pSub == pSub))
+        {
+            trdp_pdPullDelete(appHandle, pIter);
+        }
+        pIter = pNext;
+    }
+}
+#endif
+
+/******************************************************************************/
+/** Call the callback of a subscription and of its further consumers (tlp_addConsumer)
+ *  Each callback is handed to the callback workers, if there are any, else it is called in place.
+ *  The consumers get the same message and data, with their own user reference.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            subscription
+ *  @param[in]      pMsg                message info with the user reference of the subscription
+ *  @param[in]      pData               received data or NULL
+ *  @param[in]      dataSize            size of the received data
+ */
+static void trdp_pdCallConsumers (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pElement,
+    TRDP_PD_INFO_T      *pMsg,
+    UINT8               *pData,
+    UINT32              dataSize)
+{
+    const TRDP_PD_CONSUMER_T    *pConsumer  = pElement->pConsumers;
+    TRDP_PD_CALLBACK_T          pfCbFunction = pElement->pfCbFunction;
+
+    while (pfCbFunction != NULL)
+    {
+        if ((appHandle->pCbDispatch == NULL) ||
+            (trdp_cbDispatchPd(appHandle, pfCbFunction, pMsg, pData, dataSize, pElement) != TRDP_NO_ERR))
+        {
+            TRDP_TRACE2(pd_callback, pMsg->comId, pMsg->resultCode);
+            pfCbFunction(appHandle->pdDefault.pRefCon, appHandle, pMsg, pData, dataSize);
+            TRDP_TRACE1(pd_callback_done, pMsg->comId);
+        }
+        if (pConsumer == NULL)
+        {
+            break;
+        }
+        pMsg->pUserRef  = pConsumer->pUserRef;
+        pfCbFunction    = pConsumer->pfCbFunction;
+        pConsumer       = pConsumer->pNext;
+    }
+}
+
+/******************************************************************************/
+/** Call the callback of a subscription with its current frame
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pElement            subscription
+ *  @param[in]      destIpAddr          destination IP of the frame
+ *  @param[in]      err                 result to report
+ *  @param[in]      numCoalesced        frames received before and not handed over
+ *  @param[in]      pRcvTime            reception time of the frame handled (timing statistics)
+ */
+static void trdp_pdCallSubscriber (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pElement,
+    TRDP_IP_ADDR_T      destIpAddr,
+    TRDP_ERR_T          err,
+    UINT32              numCoalesced,
+    const TRDP_TIME_T   *pRcvTime)
+{
+    TRDP_PD_INFO_T theMessage;
+#if TRDP_TIMING_STATS
+    if (appHandle->option & TRDP_OPTION_TIMING_STATS)
+    {
+        TRDP_TIME_T now;
+
+        vos_getTime(&now);
+        trdp_timingAdd(appHandle, TRDP_TIMING_PD_RCV_CB, pRcvTime, &now);
+    }
+#else
+    (void) pRcvTime;
+#endif
+    theMessage.comId        = pElement->addr.comId;
+    theMessage.srcIpAddr    = pElement->lastSrcIP;
+    theMessage.destIpAddr   = destIpAddr;
+    theMessage.etbTopoCnt   = vos_ntohl(pElement->pFrame->frameHead.etbTopoCnt);
+    theMessage.opTrnTopoCnt = vos_ntohl(pElement->pFrame->frameHead.opTrnTopoCnt);
+    theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(pElement->pFrame->frameHead.msgType);
+    theMessage.seqCount     = pElement->curSeqCnt;
+    theMessage.protVersion  = vos_ntohs(pElement->pFrame->frameHead.protocolVersion);
+    theMessage.replyComId   = vos_ntohl(pElement->pFrame->frameHead.replyComId);
+    theMessage.replyIpAddr  = vos_ntohl(pElement->pFrame->frameHead.replyIpAddress);
+    theMessage.pUserRef     = pElement->pUserRef;   /* User reference given with the local subscribe? */
+    theMessage.resultCode   = err;
+    theMessage.rxTime       = pElement->rxTime;
+    theMessage.numCoalesced = numCoalesced;
+
+    trdp_pdCallConsumers(appHandle, pElement, &theMessage, pElement->pFrame->data,
+                         vos_ntohl(pElement->pFrame->frameHead.datasetLength));
+}
+
+/******************************************************************************/
+/** Finish a receive pass: call the coalesced callbacks of the subscriptions with TRDP_FLAGS_PD_LATEST
+ *  Each subscription which received frames since the last call gets one callback with its newest frame, the number
+ *  of frames it skipped is reported in numCoalesced. Then the subscription groups are published.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdCallPending (
+    TRDP_SESSION_PT appHandle)
+{
+    while (appHandle->pCbPending != NULL)
+    {
+        PD_ELE_T    *pElement   = appHandle->pCbPending;
+        UINT32      numFrames   = pElement->cbPending;
+
+        /*  Unlink first, the callback may unsubscribe  */
+        appHandle->pCbPending   = pElement->pNextCb;
+        pElement->pNextCb       = NULL;
+        pElement->cbPending     = 0u;
+        trdp_pdCallSubscriber(appHandle, pElement, pElement->cbDestIpAddr, TRDP_NO_ERR, numFrames - 1u,
+                              &pElement->rxTime);
+    }
+    if (appHandle->pSubGroups != NULL)
+    {
+        trdp_pdGroupsPublish(appHandle);
+    }
+}
+
+/******************************************************************************/
+/** Find the subscription receiving a telegram on its second interface
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pAddr               addresses of the received telegram
+ *
+ *  @retval         != NULL             subscription whose second source sent the telegram
+ *  @retval         NULL                none
+ */
+static PD_ELE_T *trdp_pdFindRedSub (
+    TRDP_SESSION_PT         appHandle,
+    const TRDP_ADDRESSES_T  *pAddr)
+{
+    PD_ELE_T *iterPD;
+
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if ((iterPD->redIpAddr == pAddr->srcIpAddr) &&
+            (iterPD->addr.comId == pAddr->comId) &&
+            (iterPD->redIfaceAddr != 0u))
+        {
+            return iterPD;
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************/
+/** Handle a received PD frame
+ *  The frame has been read into appHandle->pNewFrame.
+ *  Check for protocol errors and compare the received data to the data in our receive queue.
+ *  If it is a new packet, check if it is a PD Request (PULL).
+ *  If it is an update, exchange the existing entry with the new one
+ *  Call user's callback if needed
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      recSize             size of the received frame
+ *  @param[in]      srcIpAddr           source IP of the received frame
+ *  @param[in]      destIpAddr          destination IP of the received frame
+ *  @param[in]      pFcs                header FCS computed for the whole batch (trdp_pdBatchFcs), NULL to compute
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_WIRE_ERR       protocol error (late packet, version mismatch)
+ *  @retval         TRDP_QUEUE_ERR      not in queue
+ *  @retval         TRDP_CRC_ERR        header checksum
+ *  @retval         TRDP_TOPOCOUNT_ERR  invalid topocount
+ */
+static TRDP_ERR_T  trdp_pdHandleFrame (
+    TRDP_SESSION_PT appHandle,
+    UINT32          recSize,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    TRDP_IP_ADDR_T  destIpAddr,
+    const UINT32    *pFcs)
+{
+    PD_HEADER_T         *pNewFrameHead      = &appHandle->pNewFrame->frameHead;
+    PD_ELE_T            *pExistingElement   = NULL;
+    PD_ELE_T            *pPulledElement;
+    TRDP_ERR_T          err             = TRDP_NO_ERR;
+    int                 informUser      = FALSE;
+    TRDP_ADDRESSES_T    subAddresses    = { 0u, 0u, 0u, 0u, 0u, 0u, 0u};
+
+    subAddresses.srcIpAddr  = srcIpAddr;
+    subAddresses.destIpAddr = destIpAddr;
+
+    TRDP_TRACE2(pd_receive, vos_ntohl(pNewFrameHead->comId), recSize);
+    TRDP_REC(appHandle, TRDP_REC_PD_RX, srcIpAddr, destIpAddr, appHandle->pdDefault.port, pNewFrameHead, recSize);
+
+    /*  Is packet sane?    */
+    err = trdp_pdCheck(pNewFrameHead, recSize, pFcs);
+
+    /*  Update statistics   */
+    switch (err)
+    {
+       case TRDP_NO_ERR:
+           TRDP_STATS_INC(appHandle, pd.numRcv);
+           break;
+       case TRDP_CRC_ERR:
+           TRDP_STATS_INC(appHandle, pd.numCrcErr);
+           return err;
+       case TRDP_WIRE_ERR:
+           TRDP_STATS_INC(appHandle, pd.numProtErr);
+           return err;
+       default:
+           return err;
+    }
+
+    /* First check incoming packet's topoCount against session topoCounts */
+    /* First subscriber check from Table A.5:
+       Actual topography counter values <-> Topography counters of received */
+    if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
+                                  appHandle->opTrnTopoCnt,
+                                  vos_ntohl(pNewFrameHead->etbTopoCnt),
+                                  vos_ntohl(pNewFrameHead->opTrnTopoCnt)))
+    {
+        TRDP_STATS_INC(appHandle, pd.numTopoErr);
+        return TRDP_TOPO_ERR;
+    }
+
+    /*  Compute the subscription handle */
+    subAddresses.comId          = vos_ntohl(pNewFrameHead->comId);
+    subAddresses.etbTopoCnt     = vos_ntohl(pNewFrameHead->etbTopoCnt);
+    subAddresses.opTrnTopoCnt   = vos_ntohl(pNewFrameHead->opTrnTopoCnt);
+
+    /*  It might be a PULL request, the publishers are guarded by the send mutex     */
+    if ((vos_ntohs(pNewFrameHead->msgType) == (UINT16) TRDP_MSG_PR) &&
+        (vos_mutexLock(appHandle->sndMutex) == VOS_NO_ERR))
+    {
+        /*  Handle statistics request  */
+        if (vos_ntohl(pNewFrameHead->comId) == TRDP_STATISTICS_PULL_COMID)
+        {
+            pPulledElement = trdp_sndQueueFindComId(appHandle, TRDP_GLOBAL_STATISTICS_COMID);
+            if (pPulledElement != NULL)
+            {
+                pPulledElement->addr.comId      = TRDP_GLOBAL_STATISTICS_COMID;
+                pPulledElement->addr.destIpAddr = vos_ntohl(pNewFrameHead->replyIpAddress);
+
+                trdp_pdInit(pPulledElement, TRDP_MSG_PP, appHandle->etbTopoCnt, appHandle->opTrnTopoCnt, 0u, 0u);
+
+                trdp_pdPrepareStats(appHandle, pPulledElement);
+            }
+            else
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "Statistics request failed, not published!\n");
+            }
+        }
+        else
+        {
+            UINT32 replyComId = vos_ntohl(pNewFrameHead->replyComId);
+
+            if (replyComId == 0u)
+            {
+                replyComId = vos_ntohl(pNewFrameHead->comId);
+            }
+
+            /*  Find requested publish element  */
+            pPulledElement = trdp_sndQueueFindComId(appHandle, replyComId);
+        }
+
+        if (pPulledElement != NULL)
+        {
+            TRDP_TIME_T now;
+            BOOL8       removed;
+
+            /*  Set the destination address of the requested telegram either to the replyIp or the source Ip of the
+                requester   */
+
+            if (pNewFrameHead->replyIpAddress != 0u)
+            {
+                pPulledElement->pullIpAddress = vos_ntohl(pNewFrameHead->replyIpAddress);
+            }
+            else
+            {
+                pPulledElement->pullIpAddress = subAddresses.srcIpAddr;
+            }
+
+            /*  Send the requested PD right away. The other publishers are not touched, they are sent when due.
+                The due time of a pulled cyclic PD does not change.  */
+            pPulledElement->privFlags |= TRDP_REQ_2B_SENT;
+            trdp_getNow(appHandle, &now);
+
+            if (trdp_pdSendElement(appHandle, pPulledElement, &now, &removed) != TRDP_NO_ERR)
+            {
+                /*  We do not break here, only report error */
+                vos_printLogStr(VOS_LOG_WARNING, "Error sending pulled PD packet\n");
+            }
+            if (!removed)
+            {
+                (void) trdp_pdSchedUpdate(appHandle, pPulledElement);
+            }
+
+            informUser = TRUE;
+        }
+        (void) vos_mutexUnlock(appHandle->sndMutex);
+    }
+
+    /*  A reply to one of our pull requests goes to the requesting subscription  */
+#if TRDP_PD_PULL_HASH_SIZE > 0
+    if ((appHandle->pullCnt != 0u) && (pNewFrameHead->msgType == vos_htons(TRDP_MSG_PP)))
+    {
+        pExistingElement = trdp_pdPullMatch(appHandle, subAddresses.comId, subAddresses.srcIpAddr);
+    }
+    if (pExistingElement == NULL)
+#endif
+    {
+        /*  Examine subscription queue, are we interested in this PD?   */
+        pExistingElement = trdp_rcvQueueFindSrc(appHandle, &subAddresses);
+    }
+
+    /*  The publisher of a subscription received on a second interface has another source address there  */
+    if ((pExistingElement == NULL) && (appHandle->redRcvCnt != 0u))
+    {
+        pExistingElement = trdp_pdFindRedSub(appHandle, &subAddresses);
+    }
+
+    if (pExistingElement == NULL)
+    {
+        /*
+        vos_printLog(VOS_LOG_INFO, "No subscription (SrcIp: %s comId %u)\n", vos_ipDotted(subAddresses.srcIpAddr),
+                        vos_ntohl(pNewFrame->frameHead.comId));
+        */
+        err = TRDP_NOSUB_ERR;
+    }
+    else
+    {
+        /*  We check for local communication
+         or if etbTopoCnt and opTrnTopoCnt of the subscription are zero or match */
+        if (((subAddresses.etbTopoCnt == 0) && (subAddresses.opTrnTopoCnt == 0))
+            ||
+            trdp_validTopoCounters(subAddresses.etbTopoCnt,
+                                   subAddresses.opTrnTopoCnt,
+                                   pExistingElement->addr.etbTopoCnt,
+                                   pExistingElement->addr.opTrnTopoCnt))
+        {
+            UINT32          newSeqCnt   = vos_ntohl(pNewFrameHead->sequenceCounter);
+            TRDP_IP_ADDR_T  seqSrcIp    = subAddresses.srcIpAddr;
+
+            /*  Both interfaces count as one source: the first copy of a telegram wins, the other is a duplicate */
+            if (pExistingElement->redIpAddr != 0u)
+            {
+                if (seqSrcIp == pExistingElement->redIpAddr)
+                {
+                    seqSrcIp = pExistingElement->addr.srcIpAddr;
+                }
+                /*  A restarted publisher sends sequence counter 0 on both interfaces, only the first copy resets  */
+                if ((newSeqCnt == 0u) && (pExistingElement->curSeqCnt == 0u) &&
+                    (pExistingElement->lastSrcIP != subAddresses.srcIpAddr) &&
+                    ((pExistingElement->lastSrcIP == pExistingElement->redIpAddr) ||
+                     (pExistingElement->lastSrcIP == pExistingElement->addr.srcIpAddr)))
+                {
+                    return TRDP_NO_ERR;
+                }
+            }
+            /* Save the source IP address of the received packet */
+            pExistingElement->lastSrcIP = subAddresses.srcIpAddr;
+            /* Save the real destination of the received packet (own IP or MC group) */
+            pExistingElement->addr.destIpAddr = subAddresses.destIpAddr;
+
+
+            if (newSeqCnt == 0u)  /* restarted or new sender */
+            {
+                trdp_resetSequenceCounter(pExistingElement, seqSrcIp,
+                                          (TRDP_MSG_T) vos_ntohs(pNewFrameHead->msgType));
+            }
+
+            /* find sender in our list */
+            switch (trdp_checkSequenceCounter(pExistingElement,
+                                              newSeqCnt,
+                                              seqSrcIp,
+                                              (TRDP_MSG_T) vos_ntohs(pNewFrameHead->msgType)))
+            {
+               case 0:                      /* Sequence counter is valid (at least 1 higher than previous one) */
+                   break;
+               case -1:                     /* List overflow */
+                   return TRDP_MEM_ERR;
+               case 1:
+                   vos_printLog(VOS_LOG_INFO, "Old PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
+                                    subAddresses.srcIpAddr), vos_ntohl(pNewFrameHead->comId));
+                   return TRDP_NO_ERR;      /* Ignore packet, too old or duplicate */
+            }
+
+            if ((newSeqCnt > 0u) && (newSeqCnt > (pExistingElement->curSeqCnt + 1u)))
+            {
+                pExistingElement->numMissed += newSeqCnt - pExistingElement->curSeqCnt - 1u;
+                TRDP_STATS_ADD(appHandle, pd.numMissed, newSeqCnt - pExistingElement->curSeqCnt - 1u);
+            }
+            else if (pExistingElement->curSeqCnt > newSeqCnt)
+            {
+                pExistingElement->numMissed += UINT32_MAX - pExistingElement->curSeqCnt + newSeqCnt;
+                TRDP_STATS_ADD(appHandle, pd.numMissed, UINT32_MAX - pExistingElement->curSeqCnt + newSeqCnt);
+            }
+
+            /* Store last received sequence counter here, too (pd_get et. al. may access it).   */
+            pExistingElement->curSeqCnt = vos_ntohl(pNewFrameHead->sequenceCounter);
+
+            /*  Delta frames are decoded against the last key frame, without it they are lost    */
+            if (((pNewFrameHead->reserved != 0u) || (appHandle->deltaFirstComId != 0u)) &&
+                !trdp_pdDeltaDecode(appHandle, pExistingElement, subAddresses.srcIpAddr))
+            {
+                pExistingElement->numMissed++;
+                TRDP_STATS_INC(appHandle, pd.numMissed);
+                return TRDP_NO_ERR;
+            }
+
+            /*  Vital data is validated before it replaces the last valid data  */
+            if ((pExistingElement->sdtIdx != 0u) &&
+                (trdp_sdtValidate(appHandle, pExistingElement, appHandle->pNewFrame->data,
+                                  vos_ntohl(pNewFrameHead->datasetLength)) != TRDP_NO_ERR))
+            {
+                pExistingElement->lastErr = TRDP_SAFETY_ERR;
+                err         = TRDP_SAFETY_ERR;
+                informUser  = TRUE;
+            }
+            else
+            {
+                /*  This might have not been set!   */
+                pExistingElement->dataSize  = vos_ntohl(pNewFrameHead->datasetLength);
+                pExistingElement->grossSize = trdp_packetSizePD(pExistingElement->dataSize);
+
+                /*  Has the data changed?   */
+                if (pExistingElement->pktFlags & TRDP_FLAGS_CALLBACK)
+                {
+                    if ((pExistingElement->pktFlags & TRDP_FLAGS_FORCE_CB) ||
+                        (pExistingElement->privFlags & TRDP_TIMED_OUT))
+                    {
+                        informUser = TRUE;                 /* Inform user anyway */
+                    }
+                    else if ((pExistingElement->grossSize > pExistingElement->frameSize) ||
+                             (0 != memcmp(appHandle->pNewFrame->data,
+                                          pExistingElement->pFrame->data,
+                                          pExistingElement->dataSize)))
+                    {
+                        informUser = TRUE;
+                    }
+                }
+
+                /*  Compute the next time this packet should be received, counted from its reception.  */
+                pExistingElement->rxTime    = appHandle->pdRcvTime;
+                pExistingElement->timeToGo  = appHandle->pdRcvTime;
+                vos_addTime(&pExistingElement->timeToGo, &pExistingElement->interval);
+
+                /*  Update some statistics  */
+                pExistingElement->numRxTx++;
+                pExistingElement->lastErr   = TRDP_NO_ERR;
+                pExistingElement->privFlags =
+                    (TRDP_PRIV_FLAGS_T) (pExistingElement->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_TIMED_OUT);
+                (void) trdp_pdTimeoutUpdate(appHandle, pExistingElement);
+
+                /* mark the data as valid */
+                pExistingElement->privFlags =
+                    (TRDP_PRIV_FLAGS_T) (pExistingElement->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
+
+#if TRDP_PD_RCV_COPY
+                /*  copy into the frame of the subscription, grown to the largest frame received   */
+                if (pExistingElement->grossSize > pExistingElement->frameSize)
+                {
+                    PD_PACKET_T *pFrame = (PD_PACKET_T *) vos_memAllocAligned(pExistingElement->grossSize,
+                                                                              TRDP_PD_FRAME_ALIGN);
+
+                    if (pFrame == NULL)
+                    {
+                        pExistingElement->dataSize  = 0u;
+                        pExistingElement->grossSize = pExistingElement->frameSize;
+                        pExistingElement->privFlags |= TRDP_INVALID_DATA;
+                        return TRDP_MEM_ERR;
+                    }
+                    if (trdp_pdFrameReclaim(pExistingElement, 0u) != NULL)
+                    {
+                        vos_memFree(pExistingElement->pFrame);
+                    }
+                    pExistingElement->pFrame    = pFrame;
+                    pExistingElement->frameSize = pExistingElement->grossSize;
+                }
+                else if (trdp_pdFrameReclaim(pExistingElement, pExistingElement->frameSize) == NULL)
+                {
+                    pExistingElement->dataSize  = 0u;
+                    pExistingElement->privFlags |= TRDP_INVALID_DATA;
+                    return TRDP_MEM_ERR;
+                }
+                memcpy(pExistingElement->pFrame, appHandle->pNewFrame,
+                       sizeof(PD_HEADER_T) + pExistingElement->dataSize);
+                pExistingElement->frameGen++;
+#else
+                /*  remove the old one, insert the new one  */
+                /*  -> always swap the frame pointers, a frame still used by queued callbacks is replaced  */
+                {
+                    PD_PACKET_T *pTemp = trdp_pdFrameReclaim(pExistingElement, TRDP_MAX_PD_PACKET_SIZE);
+
+                    if (pTemp == NULL)
+                    {
+                        pExistingElement->dataSize  = 0u;
+                        pExistingElement->privFlags |= TRDP_INVALID_DATA;
+                        return TRDP_MEM_ERR;
+                    }
+                    pExistingElement->pFrame    = appHandle->pNewFrame;
+                    appHandle->pNewFrame        = pTemp;
+                    pExistingElement->frameGen++;   /* the old frame will be overwritten by the next receive */
+                }
+#endif
+#if TRDP_PD_RCV_THREAD
+                if (pExistingElement->pSnap != NULL)
+                {
+                    trdp_pdSnapWrite(pExistingElement);
+                }
+#endif
+            }
+        }
+        else
+        {
+            TRDP_STATS_INC(appHandle, pd.numTopoErr);
+            pExistingElement->lastErr = TRDP_TOPO_ERR;
+            err         = TRDP_TOPO_ERR;
+            informUser  = TRUE;
+        }
+    }
+
+    if ((pExistingElement != NULL) &&
+        (informUser == TRUE))
+    {
+        /*  If a callback was provided, call it now or at the end of the receive pass (TRDP_FLAGS_PD_LATEST)  */
+        if ((pExistingElement->pktFlags & TRDP_FLAGS_CALLBACK)
+            && ((pExistingElement->pfCbFunction != NULL) || (pExistingElement->pConsumers != NULL)))
+        {
+            if ((pExistingElement->pktFlags & TRDP_FLAGS_PD_LATEST) && (err == TRDP_NO_ERR))
+            {
+                if (pExistingElement->cbPending == 0u)
+                {
+                    pExistingElement->pNextCb   = appHandle->pCbPending;
+                    appHandle->pCbPending       = pExistingElement;
+                }
+                pExistingElement->cbPending++;
+                pExistingElement->cbDestIpAddr = subAddresses.destIpAddr;
+            }
+            else
+            {
+                trdp_pdCallSubscriber(appHandle, pExistingElement, subAddresses.destIpAddr, err, 0u,
+                                      &appHandle->pdRcvTime);
+            }
+        }
+    }
+    return err;
+}
+
+/******************************************************************************/
+/** Receiving PD messages
+ *  Read the receive socket for arriving PDs, copy the packet to a new PD_ELE_T
+ *  and handle it (see trdp_pdHandleFrame).
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      sock                the socket to read from
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_WIRE_ERR       protocol error (late packet, version mismatch)
+ *  @retval         TRDP_QUEUE_ERR      not in queue
+ *  @retval         TRDP_CRC_ERR        header checksum
+ *  @retval         TRDP_TOPOCOUNT_ERR  invalid topocount
+ */
+TRDP_ERR_T  trdp_pdReceive (
+    TRDP_SESSION_PT appHandle,
+    SOCKET          sock)
+{
+    TRDP_ERR_T      err;
+    UINT32          recSize     = TRDP_MAX_PD_PACKET_SIZE;
+    TRDP_IP_ADDR_T  srcIpAddr   = 0u;
+    TRDP_IP_ADDR_T  destIpAddr  = 0u;
+
+    /*  Get the packet from the wire, with its reception time:  */
+    err = (TRDP_ERR_T) vos_sockReceiveUDPTime(sock,
+                                              (UINT8 *) &appHandle->pNewFrame->frameHead,
+                                              &recSize,
+                                              &srcIpAddr,
+                                              NULL,
+                                              &destIpAddr,
+                                              FALSE,
+                                              &appHandle->pdRcvTime);
+    if ( err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    /*  Frames of a shared socket are handed to the other sessions as well  */
+    if ((appHandle->shareCnt != 0u) &&
+        (trdp_shareDeliver(appHandle, sock, (UINT8 *) &appHandle->pNewFrame->frameHead, recSize, srcIpAddr,
+                           destIpAddr, &appHandle->pdRcvTime) == TRUE))
+    {
+        err = trdp_pdHandleFrame(appHandle, recSize, srcIpAddr, destIpAddr, NULL);
+        return (err == TRDP_NOSUB_ERR) ? TRDP_NO_ERR : err;
+    }
+
+    return trdp_pdHandleFrame(appHandle, recSize, srcIpAddr, destIpAddr, NULL);
+}
+
+/******************************************************************************/
+/** Handle a PD frame another session read from a shared socket
+ *  The frame is copied to appHandle->pNewFrame and handled as if the session had received it itself.
+ *
+ *  @param[in]      appHandle           session pointer, locked
+ *  @param[in]      pData               the frame
+ *  @param[in]      size                size of the frame
+ *  @param[in]      srcIpAddr           source IP of the frame
+ *  @param[in]      destIpAddr          destination IP of the frame
+ *  @param[in]      pRxTime             reception time
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_xxx_ERR        error of trdp_pdHandleFrame
+ */
+TRDP_ERR_T  trdp_pdHandleShared (
+    TRDP_SESSION_PT     appHandle,
+    const UINT8         *pData,
+    UINT32              size,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    TRDP_IP_ADDR_T      destIpAddr,
+    const TRDP_TIME_T   *pRxTime)
+{
+    memcpy(&appHandle->pNewFrame->frameHead, pData, size);
+    appHandle->pdRcvTime = *pRxTime;
+    return trdp_pdHandleFrame(appHandle, size, srcIpAddr, destIpAddr, NULL);
+}
+
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+/******************************************************************************/
+/** Receiving several PD messages with one socket call
+ *  Read up to TRDP_PD_RCV_BATCH_SIZE frames into the session's receive buffers and handle them one by one.
+ *  Frames which are taken over by a subscription are replaced by the subscription's previous buffer.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      sock                the socket to read from
+ *  @param[out]     pNoFrames           number of frames read
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_BLOCK_ERR      no data available
+ *  @retval         TRDP_xxx_ERR        last error of trdp_pdHandleFrame
+ */
+TRDP_ERR_T  trdp_pdReceiveBatch (
+    TRDP_SESSION_PT appHandle,
+    SOCKET          sock,
+    UINT32          *pNoFrames)
+{
+    VOS_SOCK_MSG_T  msgs[TRDP_PD_RCV_BATCH_SIZE];
+    UINT32          fcs[TRDP_PD_RCV_BATCH_SIZE];
+    TRDP_ERR_T      err;
+    TRDP_ERR_T      result = TRDP_NO_ERR;
+    UINT32          i;
+
+    for (i = 0u; i < TRDP_PD_RCV_BATCH_SIZE; i++)
+    {
+        msgs[i].pBuffer = (UINT8 *) appHandle->pRcvBatch[i];
+        msgs[i].size    = TRDP_MAX_PD_PACKET_SIZE;
+    }
+
+    *pNoFrames = 0u;
+
+    /*  Get the packets from the wire:  */
+    err = (TRDP_ERR_T) vos_sockReceiveUDPBatch(sock, msgs, TRDP_PD_RCV_BATCH_SIZE, pNoFrames);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    trdp_pdBatchFcs(msgs, *pNoFrames, fcs);
+    for (i = 0u; i < *pNoFrames; i++)
+    {
+        PD_PACKET_T *pTemp = appHandle->pNewFrame;
+
+        /*  Frames of a shared socket are handed to the other sessions as well  */
+        if (appHandle->shareCnt != 0u)
+        {
+            (void) trdp_shareDeliver(appHandle, sock, msgs[i].pBuffer, msgs[i].size, msgs[i].srcIPAddr,
+                                     msgs[i].dstIPAddr, &msgs[i].rxTime);
+        }
+
+        /*  Handle the frame as if it had been received into pNewFrame  */
+        appHandle->pNewFrame    = appHandle->pRcvBatch[i];
+        appHandle->pdRcvTime    = msgs[i].rxTime;
+        err = trdp_pdHandleFrame(appHandle, msgs[i].size, msgs[i].srcIPAddr, msgs[i].dstIPAddr, &fcs[i]);
+        appHandle->pRcvBatch[i] = appHandle->pNewFrame;
+        appHandle->pNewFrame    = pTemp;
+
+        if (err != TRDP_NO_ERR)
+        {
+            result = err;
+        }
+    }
+    return result;
+}
+#endif
+
+/******************************************************************************/
+/** Receiving PD messages from the AF_XDP socket of the session (tlp_openXdp)
+ *  Read the frames the XDP program redirected as long as available and handle them one by one (see
+ *  trdp_pdHandleFrame). As with trdp_pdReceiveBatch, frames taken over by a subscription are replaced by the
+ *  subscription's previous buffer.
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_xxx_ERR        last error of trdp_pdHandleFrame, except TRDP_NOSUB_ERR
+ */
+TRDP_ERR_T  trdp_pdReceiveXdp (
+    TRDP_SESSION_PT appHandle)
+{
+    VOS_SOCK_MSG_T  msgs[TRDP_PD_RCV_BATCH_SIZE];
+    UINT32          fcs[TRDP_PD_RCV_BATCH_SIZE];
+    TRDP_ERR_T      err;
+    TRDP_ERR_T      result      = TRDP_NO_ERR;
+    UINT32          noFrames    = 0u;
+    UINT32          i;
+
+    do
+    {
+        for (i = 0u; i < TRDP_PD_RCV_BATCH_SIZE; i++)
+        {
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+            msgs[i].pBuffer = (UINT8 *) appHandle->pRcvBatch[i];
+#else
+            msgs[i].pBuffer = (UINT8 *) appHandle->pNewFrame;
+#endif
+            msgs[i].size    = TRDP_MAX_PD_PACKET_SIZE;
+        }
+
+        if (vos_xdpReceive(appHandle->pdXdp, msgs, TRDP_PD_RCV_BATCH_SIZE, &noFrames) != VOS_NO_ERR)
+        {
+            break;
+        }
+        trdp_pdBatchFcs(msgs, noFrames, fcs);
+
+        for (i = 0u; i < noFrames; i++)
+        {
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+            PD_PACKET_T *pTemp = appHandle->pNewFrame;
+
+            appHandle->pNewFrame    = appHandle->pRcvBatch[i];
+#endif
+            appHandle->pdRcvTime    = msgs[i].rxTime;
+            err = trdp_pdHandleFrame(appHandle, msgs[i].size, msgs[i].srcIPAddr, msgs[i].dstIPAddr, &fcs[i]);
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+            appHandle->pRcvBatch[i] = appHandle->pNewFrame;
+            appHandle->pNewFrame    = pTemp;
+#endif
+            if ((err != TRDP_NO_ERR) && (err != TRDP_NOSUB_ERR))
+            {
+                vos_printLog(VOS_LOG_WARNING, "trdp_pdReceiveXdp() failed (Err: %d)\n", err);
+                result = err;
+            }
+        }
+    }
+    while (noFrames == TRDP_PD_RCV_BATCH_SIZE);
+
+    return result;
+}
+
+#if TRDP_PD_URING
+/******************************************************************************/
+/** Hand the PD receive sockets of the session to its io_uring
+ *  The ring is opened on first use. If it cannot be opened, or PD threads read the sockets, the sockets are read
+ *  with ordinary calls.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdUringArm (
+    TRDP_SESSION_PT appHandle)
+{
+    PD_ELE_T *iterPD;
+
+    if (appHandle->pdUringFailed || (appHandle->option & TRDP_OPTION_PD_THREAD))
+    {
+        return;
+    }
+    if (appHandle->pdUring == NULL)
+    {
+        if ((vos_uringOpen(&appHandle->pdUring, TRDP_PD_URING_BUFFERS, TRDP_MAX_PD_PACKET_SIZE) != VOS_NO_ERR) ||
+            (vos_uringGetFd(appHandle->pdUring, &appHandle->pdUringFd) != VOS_NO_ERR))
+        {
+            if (appHandle->pdUring != NULL)
+            {
+                (void) vos_uringClose(appHandle->pdUring);
+                appHandle->pdUring = NULL;
+            }
+            appHandle->pdUringFailed = TRUE;
+            vos_printLogStr(VOS_LOG_WARNING, "io_uring not available, PD sockets are read directly\n");
+            return;
+        }
+    }
+
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        TRDP_SOCKETS_T *pSock;
+
+        if (iterPD->socketIdx == TRDP_INVALID_SOCKET_INDEX)
+        {
+            continue;
+        }
+        pSock = &appHandle->iface[iterPD->socketIdx];
+        /*  Sockets shared with other sessions are read directly, each frame is handed on   */
+        if ((pSock->sock != VOS_INVALID_SOCKET) && (pSock->uring == NULL) && (pSock->shareIdx == 0u) &&
+            (vos_uringAddRecv(appHandle->pdUring, pSock->sock) == VOS_NO_ERR))
+        {
+            pSock->uring = appHandle->pdUring;
+        }
+    }
+}
+
+/******************************************************************************/
+/** Receiving PD messages from the io_uring of the session
+ *  Take the datagrams the multishot receives placed into the ring and handle them one by one (see
+ *  trdp_pdHandleFrame), as long as available and the budget of the call lasts. As with trdp_pdReceiveBatch, frames
+ *  taken over by a subscription are replaced by the subscription's previous buffer.
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_xxx_ERR        last error of trdp_pdHandleFrame, except TRDP_NOSUB_ERR
+ */
+TRDP_ERR_T  trdp_pdReceiveUring (
+    TRDP_SESSION_PT appHandle)
+{
+    VOS_SOCK_MSG_T  msgs[TRDP_PD_RCV_BATCH_SIZE];
+    UINT32          fcs[TRDP_PD_RCV_BATCH_SIZE];
+    TRDP_ERR_T      err;
+    TRDP_ERR_T      result      = TRDP_NO_ERR;
+    UINT32          noFrames    = 0u;
+    UINT32          i;
+
+    do
+    {
+        for (i = 0u; i < TRDP_PD_RCV_BATCH_SIZE; i++)
+        {
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+            msgs[i].pBuffer = (UINT8 *) appHandle->pRcvBatch[i];
+#else
+            msgs[i].pBuffer = (UINT8 *) appHandle->pNewFrame;
+#endif
+            msgs[i].size    = TRDP_MAX_PD_PACKET_SIZE;
+        }
+
+        if (vos_uringReceive(appHandle->pdUring, NULL, msgs, TRDP_PD_RCV_BATCH_SIZE, &noFrames) != VOS_NO_ERR)
+        {
+            break;
+        }
+        trdp_pdBatchFcs(msgs, noFrames, fcs);
+
+        for (i = 0u; i < noFrames; i++)
+        {
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+            PD_PACKET_T *pTemp = appHandle->pNewFrame;
+
+            appHandle->pNewFrame    = appHandle->pRcvBatch[i];
+#endif
+            appHandle->pdRcvTime    = msgs[i].rxTime;
+            err = trdp_pdHandleFrame(appHandle, msgs[i].size, msgs[i].srcIPAddr, msgs[i].dstIPAddr, &fcs[i]);
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+            appHandle->pRcvBatch[i] = appHandle->pNewFrame;
+            appHandle->pNewFrame    = pTemp;
+#endif
+            if ((err != TRDP_NO_ERR) && (err != TRDP_NOSUB_ERR))
+            {
+                vos_printLog(VOS_LOG_WARNING, "trdp_pdReceiveUring() failed (Err: %d)\n", err);
+                result = err;
+            }
+        }
+        trdp_budgetSpend(appHandle, noFrames);
+    }
+    while ((noFrames == TRDP_PD_RCV_BATCH_SIZE) && trdp_budgetLeft(appHandle));
+
+    return result;
+}
+#endif
+
+/******************************************************************************/
+/** Check for pending packets, set FD if non blocking
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pFileDesc           pointer to set of ready descriptors, NULL to compute the next job only
+ *  @param[in,out]  pNoDesc             pointer to number of ready descriptors
+ */
+void trdp_pdCheckPending (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_FDS_T          *pFileDesc,
+    INT32               *pNoDesc)
+{
+    PD_ELE_T *iterPD;
+
+    /*    Walk over the registered PDs, find pending packets */
+
+    timerclear(&appHandle->nextJob);
+
+#if TRDP_PD_URING
+    trdp_pdUringArm(appHandle);
+#endif
+
+    /*    Find the packet which has to be received next:    */
+#if TRDP_PD_TIMEOUT_TABLE
+    /*    The top of the heap is the earliest time out, possibly earlier than the actual one (lazy update)    */
+    if (appHandle->rcvTimeoutCnt > 0u)
+    {
+        appHandle->nextJob = appHandle->pRcvTimeouts[0].due;
+    }
+#endif
+
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+#if !TRDP_PD_TIMEOUT_TABLE
+        if ((!(iterPD->privFlags & TRDP_TIMED_OUT)) &&              /* Exempt already timed-out packet */
+            timerisset(&iterPD->interval) &&                        /* not PD PULL?                    */
+            (timercmp(&iterPD->timeToGo, &appHandle->nextJob, <) || /* earlier than current time-out?  */
+             !timerisset(&appHandle->nextJob)))                     /* or not set at all?              */
+        {
+            appHandle->nextJob = iterPD->timeToGo;                  /* set new next time value from queue element */
+        }
+#endif
+
+        /*    Check and set the socket file descriptor, if not already done and not read by the PD thread    */
+        if ((pFileDesc != NULL) &&
+            !(appHandle->option & TRDP_OPTION_PD_THREAD) &&
+            iterPD->socketIdx != -1 &&
+            appHandle->iface[iterPD->socketIdx].sock != -1 &&
+#if TRDP_PD_URING
+            (appHandle->iface[iterPD->socketIdx].uring == NULL) &&
+#endif
+            !FD_ISSET(appHandle->iface[iterPD->socketIdx].sock, (fd_set *)pFileDesc))     /*lint !e573
+                                                                                            signed/unsigned division
+                                                                                            in macro */
+        {
+            FD_SET(appHandle->iface[iterPD->socketIdx].sock, (fd_set *)pFileDesc);   /*lint !e573
+                                                                                       signed/unsigned division
+                                                                                       in macro */
+            if (appHandle->iface[iterPD->socketIdx].sock > *pNoDesc)
+            {
+                *pNoDesc = (INT32) appHandle->iface[iterPD->socketIdx].sock;
+            }
+        }
+    }
+
+    /*    The AF_XDP socket receives the PD of all subscriptions    */
+    if ((pFileDesc != NULL) &&
+        (appHandle->pdXdp != NULL) &&
+        !(appHandle->option & TRDP_OPTION_PD_THREAD))
+    {
+        FD_SET(appHandle->pdXdpSock, (fd_set *)pFileDesc);  /*lint !e573 */
+        if (appHandle->pdXdpSock > *pNoDesc)
+        {
+            *pNoDesc = (INT32) appHandle->pdXdpSock;
+        }
+    }
+
+#if TRDP_PD_URING
+    /*    The io_uring reads the PD sockets handed to it    */
+    if ((pFileDesc != NULL) &&
+        (appHandle->pdUring != NULL))
+    {
+        FD_SET(appHandle->pdUringFd, (fd_set *)pFileDesc);  /*lint !e573 */
+        if (appHandle->pdUringFd > *pNoDesc)
+        {
+            *pNoDesc = (INT32) appHandle->pdUringFd;
+        }
+    }
+#endif
+
+    if (vos_mutexLock(appHandle->sndMutex) != VOS_NO_ERR)
+    {
+        return;
+    }
+#if TRDP_PD_SEND_SCHEDULER
+    {
+        UINT32 prioClass;
+
+        /*    The first element of each schedule is the one of its class to be sent next:    */
+        for (prioClass = 0u; prioClass < TRDP_PD_PRIO_CLASSES; prioClass++)
+        {
+            TRDP_TIME_T nextSend;
+
+            if (appHandle->sndSchedCnt[prioClass] == 0u)
+            {
+                continue;
+            }
+            if (appHandle->pSndSched[prioClass][0].immediate != 0u)
+            {
+                vos_getTime(&nextSend);                             /* requested packet, send immediately */
+            }
+            else
+            {
+                nextSend = appHandle->pSndSched[prioClass][0].due;  /* launch time, frames are sent ahead */
+            }
+            if (timercmp(&nextSend, &appHandle->nextJob, <) || !timerisset(&appHandle->nextJob))
+            {
+                appHandle->nextJob = nextSend;
+            }
+        }
+    }
+#else
+    /*    Find packet in send queue which evntually has to be sent earlier:    */
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        TRDP_TIME_T nextSend = iterPD->timeToGo;
+
+        vos_subTime(&nextSend, &iterPD->txLead);                    /* launch time frames are sent ahead */
+        if (timerisset(&iterPD->interval) &&                        /* has a time out value?    */
+            (timercmp(&nextSend, &appHandle->nextJob, <) ||         /* earlier than current time-out? */
+             !timerisset(&appHandle->nextJob)))
+        {
+            appHandle->nextJob = nextSend;                          /* set new next time value from queue element */
+        }
+    }
+#endif
+    (void) vos_mutexUnlock(appHandle->sndMutex);
+}
+
+/******************************************************************************/
+/** Report the time out of a subscription to the application
+ *
+ *  @param[in]      appHandle         application handle
+ *  @param[in]      iterPD            subscription which timed out
+ */
+static void trdp_pdReportTimeOut (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *iterPD)
+{
+    /*  Update some statistics  */
+    TRDP_STATS_INC(appHandle, pd.numTimeout);
+    iterPD->lastErr = TRDP_TIMEOUT_ERR;
+
+    /* Packet is late! We inform the user about this:    */
+    if ((iterPD->pfCbFunction != NULL) || (iterPD->pConsumers != NULL))
+    {
+        TRDP_PD_INFO_T  theMessage;
+        UINT8           *pData = NULL;
+
+        memset(&theMessage, 0, sizeof(TRDP_PD_INFO_T));
+        theMessage.comId        = iterPD->addr.comId;
+        theMessage.srcIpAddr    = iterPD->addr.srcIpAddr;
+        theMessage.destIpAddr   = iterPD->addr.destIpAddr;
+        theMessage.pUserRef     = iterPD->pUserRef;
+        theMessage.resultCode   = TRDP_TIMEOUT_ERR;
+        theMessage.rxTime       = iterPD->rxTime;
+        if (iterPD->pFrame != NULL)
+        {
+            theMessage.etbTopoCnt   = vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt);
+            theMessage.opTrnTopoCnt = vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt);
+            theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(iterPD->pFrame->frameHead.msgType);
+            theMessage.seqCount     = vos_ntohl(iterPD->pFrame->frameHead.sequenceCounter);
+            theMessage.protVersion  = vos_ntohs(iterPD->pFrame->frameHead.protocolVersion);
+            theMessage.replyComId   = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
+            theMessage.replyIpAddr  = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
+            pData                   = iterPD->pFrame->data;
+        }
+        trdp_pdCallConsumers(appHandle, iterPD, &theMessage, pData, iterPD->dataSize);
+    }
+}
+
+/******************************************************************************/
+/** Check for time outs
+ *  With TRDP_PD_TIMEOUT_TABLE only the subscriptions whose time out has been reached are taken from the time out
+ *  heap; otherwise the whole receive queue is scanned.
+ *
+ *  @param[in]      appHandle         application handle
+ */
+void trdp_pdHandleTimeOuts (
+    TRDP_SESSION_PT appHandle)
+{
+    PD_ELE_T    *iterPD = NULL;
+    TRDP_TIME_T now;
+
+    /*    Update the current time    */
+    trdp_getNow(appHandle, &now);
+
+    /*    Unanswered pull requests    */
+    trdp_pdPullExpire(appHandle, &now);
+
+#if TRDP_PD_TIMEOUT_TABLE
+    /*    Only the subscriptions at the top of the heap whose time out has been reached are visited    */
+    while ((appHandle->rcvTimeoutCnt > 0u) &&
+           !timercmp(&appHandle->pRcvTimeouts[0].due, &now, >))
+    {
+        iterPD = appHandle->pRcvTimeouts[0].pElement;
+
+        if (timercmp(&iterPD->timeToGo, &now, >))
+        {
+            /*    Received meanwhile: move to its current time out    */
+            appHandle->pRcvTimeouts[0].due = iterPD->timeToGo;
+            trdp_pdSchedFix(appHandle->pRcvTimeouts, appHandle->rcvTimeoutCnt, 0u);
+            continue;
+        }
+
+        /*    Prevent repeated time out events    */
+        iterPD->privFlags |= TRDP_TIMED_OUT;
+        trdp_pdTimeoutRemove(appHandle, iterPD);
+
+        trdp_pdReportTimeOut(appHandle, iterPD);
+
+        /*    Update the current time    */
+        trdp_getNow(appHandle, &now);
+    }
+#else
+    /*    Examine receive queue for late packets    */
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if (timerisset(&iterPD->interval) &&
+            timerisset(&iterPD->timeToGo) &&                        /*  Prevent timing out of PULLed data too early */
+            !timercmp(&iterPD->timeToGo, &now, >) &&                /*  late?   */
+            !(iterPD->privFlags & TRDP_TIMED_OUT) &&                /*  and not already flagged ?   */
+            !(iterPD->addr.comId == TRDP_STATISTICS_PULL_COMID)) /*  Do not bother user with statistics timeout */
+        {
+            trdp_pdReportTimeOut(appHandle, iterPD);
+
+            /*    Prevent repeated time out events    */
+            iterPD->privFlags |= TRDP_TIMED_OUT;
+        }
+
+        /*    Update the current time    */
+        trdp_getNow(appHandle, &now);
+    }
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Account the overflows of a backlogged PD receive queue and grow its buffer
+ *  Called once per read of a socket which had TRDP_PD_RXQ_CHECK_FRAMES or more frames queued, idle sockets are
+ *  never checked. The buffer is doubled, up to TRDP_PD_RCVBUF_MAX, if the queue overflowed or was more than half full.
+ *
+ *  @param[in]      pSock               the backlogged socket
+ */
+static void trdp_pdCheckRxQueue (
+    TRDP_SOCKETS_T *pSock)
+{
+    VOS_SOCK_RXQ_T  rxq;
+    UINT32          newDrops;
+
+    if (vos_sockGetRxQueue(pSock->sock, &rxq) != VOS_NO_ERR)
+    {
+        return;
+    }
+
+    newDrops            = rxq.drops - pSock->rxDropsSeen;
+    pSock->rxDropsSeen  = rxq.drops;
+    if (newDrops > 0u)
+    {
+        pSock->rxDrops += newDrops;
+        vos_printLog(VOS_LOG_WARNING, "%u PD frames dropped, receive queue of socket %d full (%u bytes)\n",
+                     (unsigned int) newDrops, (int) pSock->sock, (unsigned int) rxq.bufSize);
+    }
+    if (rxq.queued > pSock->rxPeak)
+    {
+        pSock->rxPeak = rxq.queued;
+    }
+
+    pSock->rcvBufSize = rxq.bufSize;
+
+    if ((rxq.bufSize < TRDP_PD_RCVBUF_MAX) && !pSock->rcvBufFixed &&
+        ((newDrops > 0u) || (rxq.queued > rxq.bufSize / 2u)))
+    {
+        UINT32 newSize = (rxq.bufSize < TRDP_PD_RCVBUF_MAX / 2u) ? 2u * rxq.bufSize : TRDP_PD_RCVBUF_MAX;
+
+        if ((vos_sockSetRcvBuffer(pSock->sock, newSize) != VOS_NO_ERR) ||
+            (vos_sockGetRxQueue(pSock->sock, &rxq) != VOS_NO_ERR) ||
+            (rxq.bufSize <= pSock->rcvBufSize))
+        {
+            /*  System limit reached (Linux: net.core.rmem_max), do not try again  */
+            pSock->rcvBufFixed = TRUE;
+            vos_printLog(VOS_LOG_WARNING, "Receive buffer of socket %d limited to %u bytes\n",
+                         (int) pSock->sock, (unsigned int) pSock->rcvBufSize);
+        }
+        else
+        {
+            pSock->rcvBufSize = rxq.bufSize;
+            vos_printLog(VOS_LOG_INFO, "Receive buffer of socket %d grown to %u bytes\n",
+                         (int) pSock->sock, (unsigned int) rxq.bufSize);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Read all pending PD frames from a readable socket
+ *  Compare the received data to the data in our receive queue and call user's callback if data changed
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSock               the readable socket
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_BLOCK_ERR      socket drained
+ *  @retval         TRDP_NODATA_ERR     no data
+ *  @retval         TRDP_NOSUB_ERR      no subscription for the last frame
+ *  @retval         else                error reported by trdp_pdReceive()
+ */
+TRDP_ERR_T trdp_pdReceiveSocket (
+    TRDP_SESSION_PT appHandle,
+    TRDP_SOCKETS_T  *pSock)
+{
+    TRDP_ERR_T  err;
+    TRDP_ERR_T  result      = TRDP_NO_ERR;
+    BOOL8       nonBlocking = !(appHandle->option & TRDP_OPTION_BLOCK);
+    SOCKET      sock        = pSock->sock;
+    UINT32      frames      = 0u;
+
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+    if (nonBlocking)
+    {
+        UINT32 noFrames;
+        do
+        {
+            /* Read batches as long as data is available */
+            err = trdp_pdReceiveBatch(appHandle, sock, &noFrames);
+            if ((err == TRDP_NO_ERR) && (noFrames < TRDP_PD_RCV_BATCH_SIZE))
+            {
+                err = TRDP_BLOCK_ERR;   /* socket drained, no need to read again */
+            }
+            /* Check the queue while the backlog is still in it */
+            if ((frames < TRDP_PD_RXQ_CHECK_FRAMES) && (frames + noFrames >= TRDP_PD_RXQ_CHECK_FRAMES))
+            {
+                trdp_pdCheckRxQueue(pSock);
+            }
+            frames += noFrames;
+            trdp_budgetSpend(appHandle, noFrames);
+        }
+        while ((err == TRDP_NO_ERR) && trdp_budgetLeft(appHandle));
+    }
+    else
+#endif
+    {
+        do
+        {
+            /* Read as long as data is available */
+            err = trdp_pdReceive(appHandle, sock);
+            if (++frames == TRDP_PD_RXQ_CHECK_FRAMES)
+            {
+                trdp_pdCheckRxQueue(pSock);
+            }
+            trdp_budgetSpend(appHandle, 1u);
+        }
+        while (err == TRDP_NO_ERR && nonBlocking && trdp_budgetLeft(appHandle));
+    }
+
+    switch (err)
+    {
+       case TRDP_NO_ERR:
+           break;
+       case TRDP_NOSUB_ERR:         /* missing subscription should not lead to extensive error output */
+       case TRDP_BLOCK_ERR:
+       case TRDP_NODATA_ERR:
+           result = err;
+           break;
+       case TRDP_TOPO_ERR:
+       case TRDP_TIMEOUT_ERR:
+       default:
+           result = err;
+           vos_printLog(VOS_LOG_WARNING, "trdp_pdReceive() failed (Err: %d)\n", err);
+           break;
+    }
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Read the PD sockets reported ready
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pRfds               pointer to set of ready descriptors
+ *  @param[in,out]  pCount              pointer to number of ready descriptors
+ */
+static TRDP_ERR_T trdp_pdReadReady (
+    TRDP_SESSION_PT appHandle,
+    TRDP_FDS_T      *pRfds,
+    INT32           *pCount)
+{
+    PD_ELE_T    *iterPD = NULL;
+    TRDP_ERR_T  err;
+    TRDP_ERR_T  result  = TRDP_NO_ERR;
+
+    /*    Frames redirected to the AF_XDP socket    */
+    if ((appHandle->pdXdp != NULL) &&
+        FD_ISSET(appHandle->pdXdpSock, (fd_set *) pRfds) &&   /*lint !e573 */
+        trdp_budgetLeft(appHandle))
+    {
+        err = trdp_pdReceiveXdp(appHandle);
+        if (err != TRDP_NO_ERR)
+        {
+            result = err;
+        }
+        (*pCount)--;
+        FD_CLR(appHandle->pdXdpSock, (fd_set *)pRfds);      /*lint !e502 !e573 */
+    }
+
+#if TRDP_PD_URING
+    /*    Datagrams of the sockets read by the io_uring    */
+    if ((appHandle->pdUring != NULL) &&
+        FD_ISSET(appHandle->pdUringFd, (fd_set *) pRfds) &&   /*lint !e573 */
+        trdp_budgetLeft(appHandle))
+    {
+        err = trdp_pdReceiveUring(appHandle);
+        if (err != TRDP_NO_ERR)
+        {
+            result = err;
+        }
+        (*pCount)--;
+        FD_CLR(appHandle->pdUringFd, (fd_set *)pRfds);      /*lint !e502 !e573 */
+    }
+#endif
+
+    /*    Check the sockets for received PD packets    */
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if ((iterPD->socketIdx != -1) &&
+            (FD_ISSET(appHandle->iface[iterPD->socketIdx].sock, (fd_set *) pRfds)))  /*lint !e573 signed/unsigned
+                                                                                     division in macro */
+        {
+            /*  Budget spent: the socket stays readable and is read by the next call    */
+            if (!trdp_budgetLeft(appHandle))
+            {
+                break;
+            }
+            /*  PD frame received? */
+            err = trdp_pdReceiveSocket(appHandle, &appHandle->iface[iterPD->socketIdx]);
+            if (err != TRDP_NO_ERR)
+            {
+                result = err;
+            }
+            (*pCount)--;
+            FD_CLR(appHandle->iface[iterPD->socketIdx].sock, (fd_set *)pRfds); /*lint !e502 !e573 signed/unsigned division
+                                                                                 in macro */
+        }
+    }
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Checking receive connection requests and data
+ *  Call user's callback if needed
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pRfds               pointer to set of ready descriptors
+ *  @param[in,out]  pCount              pointer to number of ready descriptors
+ */
+TRDP_ERR_T   trdp_pdCheckListenSocks (
+    TRDP_SESSION_PT appHandle,
+    TRDP_FDS_T      *pRfds,
+    INT32           *pCount)
+{
+    TRDP_ERR_T  result = TRDP_NO_ERR;
+
+    /*  Check the input params, in case we are in polling mode, the application
+     is responsible to get any process data by calling tlp_get()    */
+    if ((pRfds == NULL) || (pCount == NULL))
+    {
+        /* polling mode */
+        return result;
+    }
+    if (*pCount > 0)
+    {
+        result = trdp_pdReadReady(appHandle, pRfds, pCount);
+    }
+    if ((appHandle->option & TRDP_OPTION_BUSY_POLL) && trdp_budgetLeft(appHandle))
+    {
+        trdp_pdBusyPoll(appHandle);
+    }
+    trdp_pdCallPending(appHandle);
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Spin on the PD receive sockets for the next frames (TRDP_OPTION_BUSY_POLL)
+ *  The sockets are polled without blocking until frames were read or the spin budget of the session is spent: a
+ *  frame arriving within the budget is read without the interrupt and wake-up latency of the next select(). The
+ *  session stays locked while spinning, the budget should be small against the process cycle.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_pdBusyPoll (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_FDS_T          rfds;
+    TRDP_FDS_T          readyFds;
+    VOS_TIMEVAL_T       now;
+    VOS_TIMEVAL_T       end;
+    VOS_TIMEVAL_T       budget;
+    INT32               highDesc = trdp_pdRcvFds(appHandle, &rfds);
+    INT32               noDesc;
+
+    if (highDesc < 0)
+    {
+        return;
+    }
+
+    budget.tv_sec   = (long) (appHandle->busyPollBudget / 1000000u);
+    budget.tv_usec  = (long) (appHandle->busyPollBudget % 1000000u);
+    vos_getTime(&end);
+    vos_addTime(&end, &budget);
+    do
+    {
+        VOS_TIMEVAL_T noWait = {0, 0};
+
+        readyFds    = rfds;
+        noDesc      = vos_select((SOCKET) highDesc + 1, &readyFds, NULL, NULL, &noWait);
+        if (noDesc > 0)
+        {
+            (void) trdp_pdReadReady(appHandle, &readyFds, &noDesc);
+            return;
+        }
+        vos_getTime(&now);
+    }
+    while (vos_cmpTime(&now, &end) < 0);
+}
+
+/******************************************************************************/
+/** Update the header values
+ *
+ *  @param[in]      pPacket         pointer to the packet to update
+ */
+void    trdp_pdUpdate (
+    PD_ELE_T *pPacket)
+{
+    UINT32 myCRC;
+
+    /* increment counter with each telegram */
+    if (pPacket->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PP))
+    {
+        pPacket->curSeqCnt4Pull++;
+        pPacket->pFrame->frameHead.sequenceCounter = vos_htonl(pPacket->curSeqCnt4Pull);
+    }
+    else
+    {
+        pPacket->curSeqCnt++;
+        pPacket->pFrame->frameHead.sequenceCounter = vos_htonl(pPacket->curSeqCnt);
+        TRDP_ATOMIC_STORE(pPacket->seqPub.seqCnt, pPacket->curSeqCnt);
+    }
+
+#if TRDP_PD_LAZY_FCS
+    {
+        PD_HEADER_T *pHead  = &pPacket->pFrame->frameHead;
+        UINT8       *pSeq   = (UINT8 *) &pHead->sequenceCounter;
+
+        /*  Only the sequence counter changes from cycle to cycle. CRC32 is linear: the FCS is the register value
+            of the header with a zero counter combined with the contribution of each counter byte.          */
+        if ((pPacket->fcsHeadType != pHead->msgType) ||
+            (pPacket->fcsHeadLen != pHead->datasetLength))
+        {
+            UINT32 seqCnt = pHead->sequenceCounter;
+
+            pHead->sequenceCounter  = 0u;
+            pPacket->fcsHead        = ~vos_crc32(INITFCS, (UINT8 *) pHead, sizeof(PD_HEADER_T) - SIZE_OF_FCS);
+            pPacket->fcsHeadType    = pHead->msgType;
+            pPacket->fcsHeadLen     = pHead->datasetLength;
+            pHead->sequenceCounter  = seqCnt;
+        }
+        myCRC = ~(pPacket->fcsHead ^
+                  sFcsSeqTable[0][pSeq[0]] ^ sFcsSeqTable[1][pSeq[1]] ^
+                  sFcsSeqTable[2][pSeq[2]] ^ sFcsSeqTable[3][pSeq[3]]);
+    }
+#else
+    /* Compute CRC32   */
+    myCRC = vos_crc32(INITFCS, (UINT8 *)&pPacket->pFrame->frameHead, sizeof(PD_HEADER_T) - SIZE_OF_FCS);
+#endif
+    pPacket->pFrame->frameHead.frameCheckSum = MAKE_LE(myCRC);
+}
+
+/******************************************************************************/
+/** Follow a change of the session topocounts (TRDP_OPTION_TOPO_FOLLOW)
+ *  Publishers, pull requests and subscriptions with a topocount equal to the former session value get the new
+ *  one. Queued frames are rewritten in place, their FCS is recomputed when sent next. Topocounts of 0 (don't care)
+ *  and explicitly differing values are kept.
+ *
+ *  @param[in]      appHandle           session pointer, holding the new topocounts
+ *  @param[in]      oldEtbTopoCnt       former ETB topocount of the session
+ *  @param[in]      oldOpTrnTopoCnt     former operational topocount of the session
+ */
+void    trdp_pdTopoFollow (
+    TRDP_SESSION_PT appHandle,
+    UINT32          oldEtbTopoCnt,
+    UINT32          oldOpTrnTopoCnt)
+{
+    PD_ELE_T    *iterPD;
+    UINT32      numPub  = 0u;
+    UINT32      numSub  = 0u;
+
     for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        if (timerisset(&iterPD->interval) &&                        /* has a time out value?    */
-            (timercmp(&iterPD->timeToGo, &appHandle->nextJob, <) ||  /* earlier than current time-out? */
-             !timerisset(&appHandle->nextJob)))
+        BOOL8 changed = FALSE;
+
+        /*  The header holds the topocounts a frame is sent with  */
+        if ((oldEtbTopoCnt != 0u) && (iterPD->pFrame->frameHead.etbTopoCnt == vos_htonl(oldEtbTopoCnt)))
+        {
+            iterPD->addr.etbTopoCnt = appHandle->etbTopoCnt;
+            iterPD->pFrame->frameHead.etbTopoCnt = vos_htonl(appHandle->etbTopoCnt);
+            changed = TRUE;
+        }
+        if ((oldOpTrnTopoCnt != 0u) && (iterPD->pFrame->frameHead.opTrnTopoCnt == vos_htonl(oldOpTrnTopoCnt)))
+        {
+            iterPD->addr.opTrnTopoCnt = appHandle->opTrnTopoCnt;
+            iterPD->pFrame->frameHead.opTrnTopoCnt = vos_htonl(appHandle->opTrnTopoCnt);
+            changed = TRUE;
+        }
+        if (changed)
+        {
+#if TRDP_PD_LAZY_FCS
+            iterPD->fcsHeadType = 0u;           /* header changed, recompute on next send */
+#endif
+            numPub++;
+        }
+    }
+
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        BOOL8 changed = FALSE;
+
+        if ((oldEtbTopoCnt != 0u) && (iterPD->addr.etbTopoCnt == oldEtbTopoCnt))
+        {
+            iterPD->addr.etbTopoCnt = appHandle->etbTopoCnt;
+            changed = TRUE;
+        }
+        if ((oldOpTrnTopoCnt != 0u) && (iterPD->addr.opTrnTopoCnt == oldOpTrnTopoCnt))
+        {
+            iterPD->addr.opTrnTopoCnt = appHandle->opTrnTopoCnt;
+            changed = TRUE;
+        }
+        if (changed)
+        {
+            numSub++;
+        }
+        else if (!trdp_validTopoCounters(appHandle->etbTopoCnt, appHandle->opTrnTopoCnt,
+                                         iterPD->addr.etbTopoCnt, iterPD->addr.opTrnTopoCnt))
+        {
+            vos_printLog(VOS_LOG_WARNING, "Subscription of comId %u does not match the new topocounts\n",
+                         iterPD->addr.comId);
+        }
+    }
+
+    vos_printLog(VOS_LOG_INFO, "Topocounts changed to %u/%u, updated %u publishers and %u subscriptions\n",
+                 appHandle->etbTopoCnt, appHandle->opTrnTopoCnt, numPub, numSub);
+}
+
+#if TRDP_PD_LAZY_FCS
+/******************************************************************************/
+/** Build the table used by trdp_pdUpdate to add the sequence counter to the FCS
+ *  Entry [k][b] is the CRC register (start value 0) of a header with byte k of the sequence counter set to b and
+ *  all other bytes zero.
+ */
+void    trdp_pdInitFcs (void)
+{
+    UINT8   header[sizeof(PD_HEADER_T) - SIZE_OF_FCS];
+    UINT32  k, b;
+
+    memset(header, 0, sizeof(header));
+    for (k = 0u; k < sizeof(UINT32); k++)
+    {
+        for (b = 0u; b < 256u; b++)
+        {
+            header[k] = (UINT8) b;
+            sFcsSeqTable[k][b] = ~vos_crc32(0u, header, sizeof(header));
+        }
+        header[k] = 0u;
+    }
+}
+#endif
+
+
+/******************************************************************************/
+/** Compute the header FCS of a batch of received frames at once
+ *  The frame headers are checked by vos_crc32Multi(), which computes several of them in parallel. Each receive
+ *  buffer holds at least a header, so frames too short for one are computed as well and rejected by trdp_pdCheck.
+ *
+ *  @param[in]      msgs            the received frames
+ *  @param[in]      noFrames        number of frames
+ *  @param[out]     fcs             header FCS of each frame, as computed (host order)
+ */
+static void trdp_pdBatchFcs (
+    const VOS_SOCK_MSG_T    msgs[],
+    UINT32                  noFrames,
+    UINT32                  fcs[])
+{
+    const UINT8 *pHeads[TRDP_PD_RCV_BATCH_SIZE];
+    UINT32      i;
+
+    for (i = 0u; i < noFrames; i++)
+    {
+        pHeads[i] = msgs[i].pBuffer;
+    }
+    vos_crc32Multi(INITFCS, pHeads, sizeof(PD_HEADER_T) - SIZE_OF_FCS, noFrames, fcs);
+}
+
+/******************************************************************************/
+/** Check if the PD header values and the CRCs are sane
+ *
+ *  @param[in]      pPacket         pointer to the packet to check
+ *  @param[in]      packetSize      max size to check
+ *  @param[in]      pFcs            header FCS already computed (trdp_pdBatchFcs), NULL to compute it here
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_CRC_ERR
+ */
+TRDP_ERR_T trdp_pdCheck (
+    PD_HEADER_T     *pPacket,
+    UINT32          packetSize,
+    const UINT32    *pFcs)
+{
+    UINT32      myCRC;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+
+    /*  Check size    */
+    if ((packetSize < TRDP_MIN_PD_HEADER_SIZE) ||
+        (packetSize > TRDP_MAX_PD_PACKET_SIZE))
+    {
+        vos_printLog(VOS_LOG_INFO, "PDframe size error (%u))\n", packetSize);
+        err = TRDP_WIRE_ERR;
+    }
+    else
+    {
+        /*    Check Header CRC (FCS)  */
+        myCRC = (pFcs != NULL) ? *pFcs : vos_crc32(INITFCS, (UINT8 *) pPacket, sizeof(PD_HEADER_T) - SIZE_OF_FCS);
+
+        if (pPacket->frameCheckSum != MAKE_LE(myCRC))
+        {
+            vos_printLog(VOS_LOG_INFO, "PDframe crc error (%08x != %08x))\n", pPacket->frameCheckSum, MAKE_LE(myCRC));
+            err = TRDP_CRC_ERR;
+        }
+        /*  Check protocol version  */
+        else if (((vos_ntohs(pPacket->protocolVersion) & TRDP_PROTOCOL_VERSION_CHECK_MASK)
+                  != (TRDP_PROTO_VER & TRDP_PROTOCOL_VERSION_CHECK_MASK)) ||
+                 (vos_ntohl(pPacket->datasetLength) > TRDP_MAX_PD_DATA_SIZE))
+        {
+            vos_printLog(VOS_LOG_INFO, "PDframe protocol error (%04x != %04x))\n",
+                         vos_ntohs(pPacket->protocolVersion),
+                         TRDP_PROTO_VER);
+            err = TRDP_WIRE_ERR;
+        }
+        /*  Check type  */
+        else if ((vos_ntohs(pPacket->msgType) != (UINT16) TRDP_MSG_PD) &&
+                 (vos_ntohs(pPacket->msgType) != (UINT16) TRDP_MSG_PP) &&
+                 (vos_ntohs(pPacket->msgType) != (UINT16) TRDP_MSG_PR) &&
+                 (vos_ntohs(pPacket->msgType) != (UINT16) TRDP_MSG_PE))
+        {
+            vos_printLog(VOS_LOG_INFO, "PDframe type error, received %04x\n", vos_ntohs(pPacket->msgType));
+            err = TRDP_WIRE_ERR;
+        }
+    }
+    return err;
+}
+
+/******************************************************************************/
+/** Send one PD packet
+ *
+ *  @param[in]      pdSock          socket descriptor
+ *  @param[in]      pPacket         pointer to packet to be sent
+ *  @param[in]      port            port on which to send
+ *  @param[in]      pLaunchTime     time the interface shall transmit the packet, NULL to send immediately
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_IO_ERR
+ */
+TRDP_ERR_T  trdp_pdSend (
+    SOCKET              pdSock,
+    PD_ELE_T            *pPacket,
+    UINT16              port,
+    const TRDP_TIME_T   *pLaunchTime)
+{
+    VOS_ERR_T   err     = VOS_NO_ERR;
+    UINT32      destIp  = pPacket->addr.destIpAddr;
+
+    /*  check for temporary address (PD PULL):  */
+    if (pPacket->pullIpAddress != 0u)
+    {
+        destIp = pPacket->pullIpAddress;
+        pPacket->pullIpAddress = 0u;
+    }
+
+    pPacket->sendSize = pPacket->grossSize;
+
+    TRDP_TRACE2(pd_send, pPacket->addr.comId, pPacket->grossSize);
+
+    if (pLaunchTime != NULL)
+    {
+        err = vos_sockSendUDPAt(pdSock,
+                                (UINT8 *)&pPacket->pFrame->frameHead,
+                                &pPacket->sendSize,
+                                destIp,
+                                port,
+                                pLaunchTime);
+    }
+#if TRDP_PD_QOS_PER_FRAME
+    else if (pPacket->qos != 0u)
+    {
+        VOS_SOCK_MSG_T msg;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.pBuffer     = (UINT8 *)&pPacket->pFrame->frameHead;
+        msg.size        = pPacket->sendSize;
+        msg.dstIPAddr   = destIp;
+        msg.dstIPPort   = port;
+        msg.qos         = pPacket->qos;
+        err = vos_sockSendUDPBatch(pdSock, &msg, 1u);
+        pPacket->sendSize = msg.size;
+    }
+#endif
+    else
+    {
+        err = vos_sockSendUDP(pdSock,
+                              (UINT8 *)&pPacket->pFrame->frameHead,
+                              &pPacket->sendSize,
+                              destIp,
+                              port);
+    }
+
+    if (err != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "trdp_pdSend failed\n");
+        return TRDP_IO_ERR;
+    }
+
+    if (pPacket->sendSize != pPacket->grossSize)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "trdp_pdSend incomplete\n");
+        return TRDP_IO_ERR;
+    }
+
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Interval of a PD packet in us
+ *
+ *  @param[in]      pPacket         pointer to the packet
+ *
+ *  @retval         interval in us, 0 for PULL-only packets
+ */
+static UINT32 trdp_pdIntervalUs (
+    const PD_ELE_T *pPacket)
+{
+    UINT64 usec = (UINT64) pPacket->interval.tv_sec * 1000000u + (UINT64) pPacket->interval.tv_usec;
+
+    return (usec > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) usec;
+}
+
+/******************************************************************************/
+/** Greatest common divisor
+ *
+ *  @param[in]      a               first value
+ *  @param[in]      b               second value
+ *
+ *  @retval         gcd of a and b
+ */
+static UINT32 trdp_gcd (
+    UINT32  a,
+    UINT32  b)
+{
+    while (b != 0u)
+    {
+        UINT32 r = a % b;
+        a   = b;
+        b   = r;
+    }
+    return a;
+}
+
+/******************************************************************************/
+/** Compare function for the placement order: shortest interval first, larger packets first
+ *
+ *  @param[in]      arg1            pointer to first element pointer
+ *  @param[in]      arg2            pointer to second element pointer
+ *
+ *  @retval         -1, 0, 1
+ */
+static int trdp_pdShapeCompare (
+    const void  *arg1,
+    const void  *arg2)
+{
+    const PD_ELE_T  *p1 = *(const PD_ELE_T * const *) arg1;
+    const PD_ELE_T  *p2 = *(const PD_ELE_T * const *) arg2;
+
+    if (p1->shapePeriod != p2->shapePeriod)
+    {
+        return (p1->shapePeriod < p2->shapePeriod) ? -1 : 1;
+    }
+    if (p1->grossSize != p2->grossSize)
+    {
+        return (p1->grossSize > p2->grossSize) ? -1 : 1;
+    }
+    return 0;
+}
+
+/******************************************************************************/
+/** Add or remove the bytes of a packet to/from its send slots
+ *
+ *  @param[in]      pShaping        slot table
+ *  @param[in]      pPacket         placed packet
+ *  @param[in]      add             TRUE to add, FALSE to remove
+ */
+static void trdp_pdShapeLoad (
+    TRDP_PD_SHAPING_T   *pShaping,
+    const PD_ELE_T      *pPacket,
+    BOOL8               add)
+{
+    UINT32  slot;
+    UINT32  i;
+
+    for (slot = pPacket->shapeSlot; slot < pShaping->slotCnt; slot += pPacket->shapePeriod)
+    {
+        if (add)
+        {
+            pShaping->pLoad[slot]   += pPacket->grossSize;
+            pShaping->totalLoad     += pPacket->grossSize;
+        }
+        else
+        {
+            pShaping->pLoad[slot]   -= pPacket->grossSize;
+            pShaping->totalLoad     -= pPacket->grossSize;
+        }
+    }
+
+    pShaping->peakLoad = 0u;
+    for (i = 0u; i < pShaping->slotCnt; i++)
+    {
+        if (pShaping->pLoad[i] > pShaping->peakLoad)
+        {
+            pShaping->peakLoad = pShaping->pLoad[i];
+        }
+    }
+}
+
+/******************************************************************************/
+/** Send time of a packet in one of its slots
+ *
+ *  Without an old send time this is the first time of the slot not in the past. With one it is the time of the slot
+ *  less than half an interval away from the old send time, so that subscribers do not time out when a publisher is
+ *  moved.
+ *
+ *  @param[in]      pShaping        slot table
+ *  @param[in]      pPacket         packet, shapePeriod is set
+ *  @param[in]      slot            first slot of the packet
+ *  @param[in]      now             current time in us
+ *  @param[in]      pOld            old send time in us, NULL for a new packet
+ *  @param[out]     pNext           send time in us
+ *
+ *  @retval         TRUE            the send time is not in the past and (with an old send time) moved less than half
+ *                                  an interval
+ *  @retval         FALSE           the slot would move the packet too far, pNext is the first time not in the past
+ */
+static BOOL8 trdp_pdShapeTime (
+    const TRDP_PD_SHAPING_T *pShaping,
+    const PD_ELE_T          *pPacket,
+    UINT32                  slot,
+    INT64                   now,
+    const INT64             *pOld,
+    INT64                   *pNext)
+{
+    INT64   interval    = (INT64) trdp_pdIntervalUs(pPacket);
+    INT64   start       = (INT64) pShaping->base.tv_sec * 1000000 + (INT64) pShaping->base.tv_usec +
+                          (INT64) slot * (INT64) pShaping->slotTime;
+    INT64   from        = (pOld != NULL) ? (*pOld - interval / 2) : now;
+    INT64   delta       = from - start;
+
+    /*  First time of the slot at or after 'from'   */
+    if (delta > 0)
+    {
+        start += ((delta + interval - 1) / interval) * interval;
+    }
+    else
+    {
+        start -= ((-delta) / interval) * interval;
+    }
+    *pNext = start;
+    if ((start >= now) && ((pOld == NULL) || ((start - *pOld) < interval / 2) || (interval < 2)))
+    {
+        return TRUE;
+    }
+    if (start < now)
+    {
+        *pNext = start + (((now - start) + interval - 1) / interval) * interval;
+    }
+    return FALSE;
+}
+
+/******************************************************************************/
+/** Assign the send slot with the lowest load to a packet and set its next send time
+ *
+ *  The slot is chosen within the first interval of the hyper-period, so that the highest load of all slots the packet
+ *  is sent in is minimal (ties: lowest sum, earliest slot). A new packet is sent next in its slot of the currently
+ *  running hyper-period; this delays it less than one interval. A packet already being sent only gets a slot less
+ *  than half an interval away from its next send time, as long as there is one.
+ *
+ *  @param[in]      pShaping        slot table
+ *  @param[in]      pPacket         packet to place, shapePeriod is set
+ *  @param[in]      pNow            current time
+ *  @param[in]      keepPhase       TRUE: the packet is already being sent, limit the move
+ */
+static void trdp_pdShapePlace (
+    TRDP_PD_SHAPING_T   *pShaping,
+    PD_ELE_T            *pPacket,
+    const TRDP_TIME_T   *pNow,
+    BOOL8               keepPhase)
+{
+    UINT32      range       = (pPacket->shapePeriod < pShaping->slotCnt) ? pPacket->shapePeriod : pShaping->slotCnt;
+    UINT32      bestMax     = 0xFFFFFFFFu;
+    UINT64      bestSum     = 0xFFFFFFFFFFFFFFFFull;
+    BOOL8       bestInReach = FALSE;
+    UINT32      first;
+    UINT32      slot;
+    INT64       now         = (INT64) pNow->tv_sec * 1000000 + (INT64) pNow->tv_usec;
+    INT64       old         = (INT64) pPacket->timeToGo.tv_sec * 1000000 + (INT64) pPacket->timeToGo.tv_usec;
+    INT64       next;
+    INT64       bestNext    = now;
+
+    pPacket->shapeSlot = 0u;
+
+    for (first = 0u; first < range; first++)
+    {
+        UINT32  max = 0u;
+        UINT64  sum = 0u;
+        BOOL8   inReach = trdp_pdShapeTime(pShaping, pPacket, first, now, (keepPhase == TRUE) ? &old : NULL, &next);
+
+        /*  A slot inReach to the old send time beats any load    */
+        if ((bestInReach == TRUE) && (inReach == FALSE))
+        {
+            continue;
+        }
+        for (slot = first; slot < pShaping->slotCnt; slot += pPacket->shapePeriod)
+        {
+            if (pShaping->pLoad[slot] > max)
+            {
+                max = pShaping->pLoad[slot];
+            }
+            sum += pShaping->pLoad[slot];
+        }
+        if (((inReach == TRUE) && (bestInReach == FALSE)) ||
+            (max < bestMax) || ((max == bestMax) && (sum < bestSum)))
+        {
+            bestInReach = inReach;
+            bestMax     = max;
+            bestSum     = sum;
+            bestNext    = next;
+            pPacket->shapeSlot = first;
+        }
+    }
+
+    trdp_pdShapeLoad(pShaping, pPacket, TRUE);
+
+    pPacket->timeToGo.tv_sec    = (long) (bestNext / 1000000);
+    pPacket->timeToGo.tv_usec   = (long) (bestNext % 1000000);
+}
+
+/******************************************************************************/
+/** Distribute send time of PD packets over time
+ *
+ *  The send times of all cyclic publishers are planned over the hyper-period (LCM of all intervals, at most
+ *  TRDP_PD_SHAPING_MAX_SLOTS), divided into slots of the greatest common divisor of the intervals (at least
+ *  TRDP_PD_SHAPING_SLOT). Each publisher gets the offset whose slots carry the fewest bytes (grossSize) so far,
+ *  publishers with shorter intervals and larger packets are placed first.
+ *  A new publisher whose interval fits into the current slot table is placed without touching the others; otherwise
+ *  the table is rebuilt. The publishers already being sent then only move to a slot less than half an interval away
+ *  from their next send time, so their subscribers do not time out; the new one is delayed less than one interval.
+ *  The hyper-periods start at multiples of their length on the clock of vos_getTime(): with a common time base
+ *  (vos_setTimeBase(), PTP) the slots of all devices of the train are in phase.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pNewPacket      the new publisher, NULL to redistribute all
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T  trdp_pdDistribute (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pNewPacket)
+{
+    TRDP_PD_SHAPING_T   *pShaping   = &appHandle->shaping;
+    PD_ELE_T            *pPacket;
+    PD_ELE_T            **pList;
+    TRDP_TIME_T         now;
+    UINT32              noOfPackets = 0u;
+    UINT32              slotTime    = 0u;
+    UINT64              slotCnt     = 1u;
+    UINT64              base;
+    UINT32              i;
+
+    vos_getTime(&now);
+
+    /*  Only the new packet needs a slot, if its interval is a multiple of the slot time and divides the period   */
+    if ((pNewPacket != NULL) && (pShaping->pLoad != NULL))
+    {
+        UINT32 interval = trdp_pdIntervalUs(pNewPacket);
+
+        if (interval == 0u)
+        {
+            return TRDP_NO_ERR;     /* PULL-only packets are not shaped */
+        }
+        if (((interval % pShaping->slotTime) == 0u) &&
+            ((pShaping->slotCnt % (interval / pShaping->slotTime)) == 0u))
+        {
+            pNewPacket->shapePeriod = interval / pShaping->slotTime;
+            trdp_pdShapePlace(pShaping, pNewPacket, &now, FALSE);
+            pShaping->numPub++;
+            vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: comId %u in slot %u, peak load %u bytes/slot\n",
+                         pNewPacket->addr.comId, pNewPacket->shapeSlot, pShaping->peakLoad);
+            return TRDP_NO_ERR;
+        }
+    }
+
+    /*  Rebuild the slot table: find the slot time and the hyper-period    */
+    for (pPacket = appHandle->pSndQueue; pPacket != NULL; pPacket = pPacket->pNext)
+    {
+        pPacket->shapePeriod = 0u;
+        if (timerisset(&pPacket->interval))     /*  Do not count PULL-only packets!  */
+        {
+            slotTime = trdp_gcd(slotTime, trdp_pdIntervalUs(pPacket));
+            noOfPackets++;
+        }
+    }
+
+    trdp_pdDistributeFree(appHandle);
+
+    if (noOfPackets < 2u)
+    {
+        return TRDP_NO_ERR;     /* Ticket #14: Nothing to shape is not an error */
+    }
+
+    if (slotTime < TRDP_PD_SHAPING_SLOT)
+    {
+        slotTime = TRDP_PD_SHAPING_SLOT;
+    }
+
+    pList = (PD_ELE_T * *) vos_memAlloc(noOfPackets * sizeof(PD_ELE_T *));
+    if (pList == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    for (i = 0u, pPacket = appHandle->pSndQueue; pPacket != NULL; pPacket = pPacket->pNext)
+    {
+        if (timerisset(&pPacket->interval))
+        {
+            pPacket->shapePeriod = (trdp_pdIntervalUs(pPacket) + slotTime / 2u) / slotTime;
+            if (pPacket->shapePeriod == 0u)
+            {
+                pPacket->shapePeriod = 1u;
+            }
+            if (slotCnt < TRDP_PD_SHAPING_MAX_SLOTS)
+            {
+                slotCnt = slotCnt / trdp_gcd((UINT32) slotCnt, pPacket->shapePeriod) * pPacket->shapePeriod;
+            }
+            pList[i++] = pPacket;
+        }
+    }
+    if (slotCnt > TRDP_PD_SHAPING_MAX_SLOTS)
+    {
+        slotCnt = TRDP_PD_SHAPING_MAX_SLOTS;
+    }
+
+    pShaping->pLoad = (UINT32 *) vos_memAlloc((UINT32) slotCnt * sizeof(UINT32));
+    if (pShaping->pLoad == NULL)
+    {
+        vos_memFree(pList);
+        return TRDP_MEM_ERR;
+    }
+    pShaping->slotTime  = slotTime;
+    pShaping->slotCnt   = (UINT32) slotCnt;
+    pShaping->numPub    = noOfPackets;
+
+    /*  Start of the running hyper-period, aligned to the time base    */
+    base = (UINT64) now.tv_sec * 1000000u + (UINT64) now.tv_usec;
+    base -= base % (slotCnt * slotTime);
+    pShaping->base.tv_sec   = (long) (base / 1000000u);
+    pShaping->base.tv_usec  = (long) (base % 1000000u);
+
+    vos_qsort(pList, noOfPackets, sizeof(PD_ELE_T *), trdp_pdShapeCompare);
+
+    for (i = 0u; i < noOfPackets; i++)
+    {
+        trdp_pdShapePlace(pShaping, pList[i], &now, (pList[i] != pNewPacket) ? TRUE : FALSE);
+    }
+    vos_memFree(pList);
+
+    vos_printLog(VOS_LOG_INFO,
+                 "trdp_pdDistribute: %u packets in %u slots of %u us, peak load %u bytes/slot\n",
+                 noOfPackets, pShaping->slotCnt, slotTime, pShaping->peakLoad);
+
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Release the send slots of a publisher
+ *  The other publishers keep their slots.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pPacket         publisher to be removed
+ */
+void trdp_pdDistributeRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket)
+{
+    if ((appHandle->shaping.pLoad != NULL) && (pPacket->shapePeriod != 0u))
+    {
+        trdp_pdShapeLoad(&appHandle->shaping, pPacket, FALSE);
+        appHandle->shaping.numPub--;
+        pPacket->shapePeriod = 0u;
+    }
+}
+
+/******************************************************************************/
+/** Free the send slot table
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_pdDistributeFree (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->shaping.pLoad != NULL)
+    {
+        vos_memFree(appHandle->shaping.pLoad);
+    }
+    memset(&appHandle->shaping, 0, sizeof(TRDP_PD_SHAPING_T));
+}
+
+/******************************************************************************/
+/** Find or create the redundancy group of a redId
+ *  Groups are only added (under the session mutex) and freed on session close, so lookups and switching the
+ *  state of a group need no lock. A new group starts as leader.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      redId           redundancy group ID
+ *  @param[in]      create          TRUE: create the group if it does not exist, session must be locked
+ *
+ *  @retval         the group, NULL if redId is zero, not found or out of memory
+ */
+TRDP_RED_GROUP_T *trdp_pdRedGroup (
+    TRDP_SESSION_PT appHandle,
+    UINT32          redId,
+    BOOL8           create)
+{
+    TRDP_RED_GROUP_T *pGroup;
+
+    if (redId == 0u)
+    {
+        return NULL;
+    }
+    for (pGroup = TRDP_ATOMIC_LOAD(appHandle->pRedGroups); pGroup != NULL; pGroup = pGroup->pNext)
+    {
+        if (pGroup->redId == redId)
+        {
+            return pGroup;
+        }
+    }
+    if (create == TRUE)
+    {
+        pGroup = (TRDP_RED_GROUP_T *) vos_memAlloc(sizeof(TRDP_RED_GROUP_T));
+        if (pGroup != NULL)
+        {
+            pGroup->redId   = redId;
+            pGroup->pNext   = appHandle->pRedGroups;
+            TRDP_ATOMIC_STORE(appHandle->pRedGroups, pGroup);
+        }
+    }
+    return pGroup;
+}
+
+/******************************************************************************/
+/** Free the redundancy groups
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_pdRedGroupsFree (
+    TRDP_SESSION_PT appHandle)
+{
+    while (appHandle->pRedGroups != NULL)
+    {
+        TRDP_RED_GROUP_T *pNext = appHandle->pRedGroups->pNext;
+
+        vos_memFree(appHandle->pRedGroups);
+        appHandle->pRedGroups = pNext;
+    }
+}
+
+/******************************************************************************/
+/** Publish the current frames of the members of a subscription group
+ *  Called with the session locked. The frames are written into the buffer not read at the moment, frames which did
+ *  not change since they were last written into this buffer are not copied again. Readers detect an overwrite by
+ *  the changed sequence number.
+ *
+ *  @param[in]      pGroup          the group
+ */
+static void trdp_pdGroupWrite (
+    PD_SUB_GROUP_T *pGroup)
+{
+    UINT32              version     = pGroup->version + 1u;
+    UINT32              idx         = version & 1u;
+    PD_GROUP_ENTRY_T    *pEntries   = pGroup->pBuffer[idx];
+    UINT32              i;
+
+#if TRDP_PD_GROUP_SEQLOCK
+    __atomic_store_n(&pGroup->seq[idx], pGroup->seq[idx] + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+#endif
+
+    for (i = 0u; i < pGroup->numSubs; i++)
+    {
+        PD_ELE_T            *pSub   = pGroup->pMembers[i].pSub;
+        PD_GROUP_ENTRY_T    *pEntry = &pEntries[i];
+
+        if (pSub == NULL)
+        {
+            pEntry->state = TRDP_NOSUB_ERR;
+            continue;
+        }
+        pGroup->pMembers[i].numRxTx = pSub->numRxTx;
+        pEntry->timeToGo            = pSub->timeToGo;
+        if (pSub->numRxTx == 0u)
+        {
+            pEntry->state = TRDP_NODATA_ERR;
+        }
+        else if ((pEntry->state != TRDP_NO_ERR) || (pEntry->numRxTx != pSub->numRxTx))
+        {
+            pEntry->state       = TRDP_NO_ERR;
+            pEntry->numRxTx     = pSub->numRxTx;
+            pEntry->srcIpAddr   = pSub->lastSrcIP;
+            pEntry->seqCnt      = pSub->curSeqCnt;
+            pEntry->dataSize    = (pSub->dataSize > TRDP_MAX_PD_DATA_SIZE) ? TRDP_MAX_PD_DATA_SIZE : pSub->dataSize;
+            pEntry->rxTime      = pSub->rxTime;
+            memcpy(&pEntry->frame, pSub->pFrame, sizeof(PD_HEADER_T) + pEntry->dataSize);
+        }
+    }
+    pGroup->changed = FALSE;
+
+#if TRDP_PD_GROUP_SEQLOCK
+    __atomic_store_n(&pGroup->seq[idx], pGroup->seq[idx] + 1u, __ATOMIC_RELEASE);
+    __atomic_store_n(&pGroup->version, version, __ATOMIC_RELEASE);
+#else
+    pGroup->version = version;
+#endif
+}
+
+/******************************************************************************/
+/** Publish the subscription groups with members received since their last publication
+ *  Called at the end of a receive pass with the session locked.
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+static void trdp_pdGroupsPublish (
+    TRDP_SESSION_PT appHandle)
+{
+    PD_SUB_GROUP_T *pGroup;
+
+    for (pGroup = appHandle->pSubGroups; pGroup != NULL; pGroup = pGroup->pNext)
+    {
+        BOOL8   changed = pGroup->changed;
+        UINT32  i;
+
+        for (i = 0u; (i < pGroup->numSubs) && (changed == FALSE); i++)
+        {
+            changed = (pGroup->pMembers[i].pSub != NULL) &&
+                      (pGroup->pMembers[i].pSub->numRxTx != pGroup->pMembers[i].numRxTx);
+        }
+        if (changed == TRUE)
+        {
+            trdp_pdGroupWrite(pGroup);
+        }
+    }
+}
+
+/******************************************************************************/
+/** Create a subscription group and publish the current state of its members
+ *  Called with the session locked, the handles are checked by the caller.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[out]     ppGroup         the new group
+ *  @param[in]      pSubHandles     the subscriptions
+ *  @param[in]      numSubs         number of subscriptions, 1...TRDP_PD_GROUP_MAX_SUBS
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_pdGroupCreate (
+    TRDP_SESSION_PT     appHandle,
+    PD_SUB_GROUP_T      **ppGroup,
+    const TRDP_SUB_T    *pSubHandles,
+    UINT32              numSubs)
+{
+    PD_SUB_GROUP_T  *pGroup;
+    UINT32          i;
+
+    pGroup = (PD_SUB_GROUP_T *) vos_memAlloc(sizeof(PD_SUB_GROUP_T));
+    if (pGroup == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pGroup->pMembers    = (PD_GROUP_MEMBER_T *) vos_memAlloc(numSubs * sizeof(PD_GROUP_MEMBER_T));
+    pGroup->pBuffer[0]  = (PD_GROUP_ENTRY_T *) vos_memAlloc(numSubs * sizeof(PD_GROUP_ENTRY_T));
+    pGroup->pBuffer[1]  = (PD_GROUP_ENTRY_T *) vos_memAlloc(numSubs * sizeof(PD_GROUP_ENTRY_T));
+    if ((pGroup->pMembers == NULL) || (pGroup->pBuffer[0] == NULL) || (pGroup->pBuffer[1] == NULL))
+    {
+        trdp_pdGroupFree(pGroup);
+        return TRDP_MEM_ERR;
+    }
+
+    pGroup->numSubs = numSubs;
+    for (i = 0u; i < numSubs; i++)
+    {
+        PD_ELE_T            *pSub       = (PD_ELE_T *) pSubHandles[i];
+        PD_GROUP_MEMBER_T   *pMember    = &pGroup->pMembers[i];
+
+        pMember->pSub       = pSub;
+        pMember->subHandle  = pSubHandles[i];
+        pMember->comId      = pSub->addr.comId;
+        pMember->destIpAddr = pSub->addr.destIpAddr;
+        pMember->cyclic     = timerisset(&pSub->interval) ? TRUE : FALSE;
+        pMember->pktFlags   = pSub->pktFlags;
+        pMember->toBehavior = pSub->toBehavior;
+        pMember->pUserRef   = pSub->pUserRef;
+        pMember->pCachedDS  = pSub->pCachedDS;
+        /*  Entries are written from scratch by the first publication of each buffer  */
+        pGroup->pBuffer[0][i].state = TRDP_NODATA_ERR;
+        pGroup->pBuffer[1][i].state = TRDP_NODATA_ERR;
+    }
+    trdp_pdGroupWrite(pGroup);
+
+    pGroup->magic       = TRDP_MAGIC_GROUP_HNDL_VALUE;
+    pGroup->pNext       = appHandle->pSubGroups;
+    appHandle->pSubGroups = pGroup;
+    *ppGroup = pGroup;
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Unlink a subscription group from the session, the session must be locked
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pGroup          the group
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      not a group of the session
+ */
+TRDP_ERR_T trdp_pdGroupUnlink (
+    TRDP_SESSION_PT appHandle,
+    PD_SUB_GROUP_T  *pGroup)
+{
+    PD_SUB_GROUP_T **ppIter;
+
+    for (ppIter = &appHandle->pSubGroups; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        if (*ppIter == pGroup)
+        {
+            *ppIter         = pGroup->pNext;
+            pGroup->magic   = 0u;
+            return TRDP_NO_ERR;
+        }
+    }
+    return TRDP_PARAM_ERR;
+}
+
+/******************************************************************************/
+/** Free a subscription group
+ *
+ *  @param[in]      pGroup          the group, unlinked
+ */
+void trdp_pdGroupFree (
+    PD_SUB_GROUP_T *pGroup)
+{
+    if (pGroup->pMembers != NULL)
+    {
+        vos_memFree(pGroup->pMembers);
+    }
+    if (pGroup->pBuffer[0] != NULL)
+    {
+        vos_memFree(pGroup->pBuffer[0]);
+    }
+    if (pGroup->pBuffer[1] != NULL)
+    {
+        vos_memFree(pGroup->pBuffer[1]);
+    }
+    vos_memFree(pGroup);
+}
+
+/******************************************************************************/
+/** Free the subscription groups of a session
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_pdGroupsFree (
+    TRDP_SESSION_PT appHandle)
+{
+    while (appHandle->pSubGroups != NULL)
+    {
+        PD_SUB_GROUP_T *pNext = appHandle->pSubGroups->pNext;
+
+        trdp_pdGroupFree(appHandle->pSubGroups);
+        appHandle->pSubGroups = pNext;
+    }
+}
+
+/******************************************************************************/
+/** Check if a subscription is member of a group, the session must be locked
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pSub            the subscription
+ *
+ *  @retval         TRUE            member of a group
+ *  @retval         FALSE           not a member
+ */
+BOOL8 trdp_pdGroupsHaveSub (
+    TRDP_SESSION_PT appHandle,
+    const PD_ELE_T  *pSub)
+{
+    PD_SUB_GROUP_T *pGroup;
+
+    for (pGroup = appHandle->pSubGroups; pGroup != NULL; pGroup = pGroup->pNext)
+    {
+        UINT32 i;
+
+        for (i = 0u; i < pGroup->numSubs; i++)
         {
-            appHandle->nextJob = iterPD->timeToGo;                  /* set new next time value from queue element */
+            if (pGroup->pMembers[i].pSub == pSub)
+            {
+                return TRUE;
+            }
         }
     }
+    return FALSE;
 }
 
 /******************************************************************************/
-/** Check for time outs
+/** Remove an unsubscribed subscription from the groups, the session must be locked
  *
- *  @param[in]      appHandle         application handle
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pSub            the subscription
  */
-void trdp_pdHandleTimeOuts (
-    TRDP_SESSION_PT appHandle)
+void trdp_pdGroupsRemoveSub (
+    TRDP_SESSION_PT appHandle,
+    const PD_ELE_T  *pSub)
 {
-    PD_ELE_T    *iterPD = NULL;
-    TRDP_TIME_T now;
-
-    /*    Update the current time    */
-    vos_getTime(&now);
+    PD_SUB_GROUP_T *pGroup;
 
-    /*    Examine receive queue for late packets    */
-    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    for (pGroup = appHandle->pSubGroups; pGroup != NULL; pGroup = pGroup->pNext)
     {
-        if (timerisset(&iterPD->interval) &&
-            timerisset(&iterPD->timeToGo) &&                        /*  Prevent timing out of PULLed data too early */
-            !timercmp(&iterPD->timeToGo, &now, >) &&                /*  late?   */
-            !(iterPD->privFlags & TRDP_TIMED_OUT) &&                /*  and not already flagged ?   */
-            !(iterPD->addr.comId == TRDP_STATISTICS_PULL_COMID)) /*  Do not bother user with statistics timeout */
-        {
-            /*  Update some statistics  */
-            appHandle->stats.pd.numTimeout++;
-            iterPD->lastErr = TRDP_TIMEOUT_ERR;
+        UINT32 i;
 
-            /* Packet is late! We inform the user about this:    */
-            if (iterPD->pfCbFunction != NULL)
+        for (i = 0u; i < pGroup->numSubs; i++)
+        {
+            if (pGroup->pMembers[i].pSub == pSub)
             {
-                TRDP_PD_INFO_T theMessage;
-                memset(&theMessage, 0, sizeof(TRDP_PD_INFO_T));
-                theMessage.comId        = iterPD->addr.comId;
-                theMessage.srcIpAddr    = iterPD->addr.srcIpAddr;
-                theMessage.destIpAddr   = iterPD->addr.destIpAddr;
-                theMessage.pUserRef     = iterPD->pUserRef;
-                theMessage.resultCode   = TRDP_TIMEOUT_ERR;
-                if (iterPD->pFrame != NULL)
-                {
-                    theMessage.etbTopoCnt   = vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt);
-                    theMessage.opTrnTopoCnt = vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt);
-                    theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(iterPD->pFrame->frameHead.msgType);
-                    theMessage.seqCount     = vos_ntohl(iterPD->pFrame->frameHead.sequenceCounter);
-                    theMessage.protVersion  = vos_ntohs(iterPD->pFrame->frameHead.protocolVersion);
-                    theMessage.replyComId   = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
-                    theMessage.replyIpAddr  = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
-
-                    iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                         appHandle,
-                                         &theMessage,
-                                         iterPD->pFrame->data,
-                                         iterPD->dataSize);
-                }
-                else
-                {
-                    iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                         appHandle,
-                                         &theMessage,
-                                         NULL,
-                                         iterPD->dataSize);
-                }
+                pGroup->pMembers[i].pSub    = NULL;
+                pGroup->changed             = TRUE;
             }
-
-            /*    Prevent repeated time out events    */
-            iterPD->privFlags |= TRDP_TIMED_OUT;
         }
-
-        /*    Update the current time    */
-        vos_getTime(&now);
     }
 }
 
-/**********************************************************************************************************************/
-/** Checking receive connection requests and data
- *  Call user's callback if needed
+/******************************************************************************/
+/** Copy one member of a subscription group into a tlp_getSubGroup() item
+ *  Same results as trdp_pdSnapGet().
  *
- *  @param[in]      appHandle           session pointer
- *  @param[in]      pRfds               pointer to set of ready descriptors
- *  @param[in,out]  pCount              pointer to number of ready descriptors
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pMember         the member
+ *  @param[in]      pEntry          its entry in the buffer read
+ *  @param[in]      pNow            current time
+ *  @param[in,out]  pItem           the item
  */
-TRDP_ERR_T   trdp_pdCheckListenSocks (
-    TRDP_SESSION_PT appHandle,
-    TRDP_FDS_T      *pRfds,
-    INT32           *pCount)
+static void trdp_pdGroupCopy (
+    TRDP_SESSION_PT         appHandle,
+    PD_GROUP_MEMBER_T       *pMember,
+    const PD_GROUP_ENTRY_T  *pEntry,
+    const TRDP_TIME_T       *pNow,
+    TRDP_GET_ITEM_T         *pItem)
 {
-    PD_ELE_T    *iterPD = NULL;
-    TRDP_ERR_T  err;
-    TRDP_ERR_T  result      = TRDP_NO_ERR;
-    BOOL8       nonBlocking = !(appHandle->option & TRDP_OPTION_BLOCK);
+    TRDP_ERR_T      ret         = TRDP_NO_ERR;
+    TRDP_PD_INFO_T  *pPdInfo    = &pItem->pdInfo;
+    UINT32          dataSize    = (pEntry->dataSize > TRDP_MAX_PD_DATA_SIZE) ? TRDP_MAX_PD_DATA_SIZE : pEntry->dataSize;
 
-    /*  Check the input params, in case we are in polling mode, the application
-     is responsible to get any process data by calling tlp_get()    */
-    if ((pRfds == NULL) || (pCount == NULL))
+    if (pEntry->state == TRDP_NOSUB_ERR)
     {
-        /* polling mode */
+        ret = TRDP_NOSUB_ERR;
+    }
+    else if ((pMember->cyclic == TRUE) && timercmp(&pEntry->timeToGo, pNow, <))
+    {
+        /*    Packet is late    */
+        if ((pMember->toBehavior == TRDP_TO_SET_TO_ZERO) && (pItem->pData != NULL))
+        {
+            memset(pItem->pData, 0, pItem->dataSize);
+        }
+        ret = TRDP_TIMEOUT_ERR;
+    }
+    else if (pEntry->state != TRDP_NO_ERR)
+    {
+        ret = TRDP_NODATA_ERR;
     }
-    else if ((pCount != NULL) && (*pCount > 0))
+    else if (pItem->pData != NULL)
     {
-        /*    Check the sockets for received PD packets    */
-        for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        if (!(pMember->pktFlags & TRDP_FLAGS_MARSHALL) || (appHandle->marshall.pfCbUnmarshall == NULL))
         {
-            if ((iterPD->socketIdx != -1) &&
-                (FD_ISSET(appHandle->iface[iterPD->socketIdx].sock, (fd_set *) pRfds)))  /*lint !e573 signed/unsigned
-                                                                                         division in macro */
+            if (pItem->dataSize >= dataSize)
+            {
+                pItem->dataSize = dataSize;
+                memcpy(pItem->pData, pEntry->frame.data, dataSize);
+            }
+            else
             {
-                VOS_LOG_T logType = VOS_LOG_ERROR;
+                ret = TRDP_PARAM_ERR;
+            }
+        }
+        else
+        {
+            ret = appHandle->marshall.pfCbUnmarshall(appHandle->marshall.pRefCon,
+                                                     pMember->comId,
+                                                     (UINT8 *) pEntry->frame.data,
+                                                     dataSize,
+                                                     pItem->pData,
+                                                     &pItem->dataSize,
+                                                     &pMember->pCachedDS);
+        }
+    }
+
+    pItem->result           = ret;
+    memset(pPdInfo, 0, sizeof(TRDP_PD_INFO_T));
+    pPdInfo->comId          = pMember->comId;
+    pPdInfo->destIpAddr     = pMember->destIpAddr;
+    pPdInfo->pUserRef       = pMember->pUserRef;
+    pPdInfo->resultCode     = ret;
+    if (pEntry->state != TRDP_NO_ERR)
+    {
+        return;
+    }
+    pPdInfo->srcIpAddr      = pEntry->srcIpAddr;
+    pPdInfo->etbTopoCnt     = vos_ntohl(pEntry->frame.frameHead.etbTopoCnt);
+    pPdInfo->opTrnTopoCnt   = vos_ntohl(pEntry->frame.frameHead.opTrnTopoCnt);
+    pPdInfo->msgType        = (TRDP_MSG_T) vos_ntohs(pEntry->frame.frameHead.msgType);
+    pPdInfo->seqCount       = pEntry->seqCnt;
+    pPdInfo->protVersion    = vos_ntohs(pEntry->frame.frameHead.protocolVersion);
+    pPdInfo->replyComId     = vos_ntohl(pEntry->frame.frameHead.replyComId);
+    pPdInfo->replyIpAddr    = vos_ntohl(pEntry->frame.frameHead.replyIpAddress);
+    pPdInfo->rxTime         = pEntry->rxTime;
+}
+
+/******************************************************************************/
+/** Copy the members of a subscription group from one publication
+ *  Without TRDP_PD_GROUP_SEQLOCK the caller must lock the session.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pGroup          the group
+ *  @param[in,out]  pItems          the items
+ *  @param[in]      numItems        number of items
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         other           result of the last failing item
+ */
+TRDP_ERR_T trdp_pdGroupGet (
+    TRDP_SESSION_PT     appHandle,
+    PD_SUB_GROUP_T      *pGroup,
+    TRDP_GET_ITEM_T     *pItems,
+    UINT32              numItems)
+{
+    TRDP_ERR_T  ret;
+    TRDP_TIME_T now;
+    UINT32      i;
 
-                /*  PD frame received? */
-                /*  Compare the received data to the data in our receive queue
-                   Call user's callback if data changed    */
+    vos_getTime(&now);
 
-                do
-                {
-                    /* Read as long as data is available */
-                    err = trdp_pdReceive(appHandle, appHandle->iface[iterPD->socketIdx].sock);
+    for (;; )
+    {
+        UINT32              version;
+        UINT32              seq     = 0u;
+        PD_GROUP_ENTRY_T    *pEntries;
 
-                }
-                while (err == TRDP_NO_ERR && nonBlocking);
+#if TRDP_PD_GROUP_SEQLOCK
+        version = __atomic_load_n(&pGroup->version, __ATOMIC_ACQUIRE);
+        seq     = __atomic_load_n(&pGroup->seq[version & 1u], __ATOMIC_ACQUIRE);
+        if (seq & 1u)
+        {
+            continue;                               /* being written */
+        }
+#else
+        version = pGroup->version;
+#endif
+        pEntries    = pGroup->pBuffer[version & 1u];
+        ret         = TRDP_NO_ERR;
+        for (i = 0u; i < numItems; i++)
+        {
+            UINT32 member;
 
-                switch (err)
+            for (member = 0u; member < pGroup->numSubs; member++)
+            {
+                if (pGroup->pMembers[member].subHandle == pItems[i].subHandle)
                 {
-                   case TRDP_NO_ERR:
-                       break;
-                   case TRDP_NOSUB_ERR:         /* missing subscription should not lead to extensive error output */
-                   case TRDP_BLOCK_ERR:
-                   case TRDP_NODATA_ERR:
-                       result = err;
-                       break;
-                   case TRDP_TOPO_ERR:
-                   case TRDP_TIMEOUT_ERR:
-                   default:
-                       result   = err;
-                       logType  = VOS_LOG_WARNING;
-                       vos_printLog(logType, "trdp_pdReceive() failed (Err: %d)\n", err);
-                       break;
+                    break;
                 }
-                (*pCount)--;
-                FD_CLR(appHandle->iface[iterPD->socketIdx].sock, (fd_set *)pRfds); /*lint !e502 !e573 signed/unsigned division
-                                                                                     in macro */
             }
+            if (member == pGroup->numSubs)
+            {
+                pItems[i].result = TRDP_NOSUB_ERR;
+            }
+            else
+            {
+                trdp_pdGroupCopy(appHandle, &pGroup->pMembers[member], &pEntries[member], &now, &pItems[i]);
+            }
+            if (pItems[i].result != TRDP_NO_ERR)
+            {
+                ret = pItems[i].result;
+            }
+        }
+#if TRDP_PD_GROUP_SEQLOCK
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&pGroup->seq[version & 1u], __ATOMIC_RELAXED) != seq)
+        {
+            continue;                               /* overwritten while copying, the items are copied again */
         }
+#else
+        (void) seq;
+#endif
+        break;
     }
-    return result;
+    return ret;
 }
 
+#if TRDP_PD_RCV_THREAD
 /******************************************************************************/
-/** Update the header values
+/** Find the socket of a receive thread for a bind address
  *
- *  @param[in]      pPacket         pointer to the packet to update
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      shard           receive thread no. + 1
+ *  @param[in]      bindAddr        bind address of the socket
+ *
+ *  @retval         index of the socket in the session's socket pool, TRDP_INVALID_SOCKET_INDEX if not open
  */
-void    trdp_pdUpdate (
-    PD_ELE_T *pPacket)
+static INT32 trdp_pdFindShardSocket (
+    TRDP_SESSION_PT appHandle,
+    UINT8           shard,
+    TRDP_IP_ADDR_T  bindAddr)
 {
-    UINT32 myCRC;
+    INT32 lIndex;
 
-    /* increment counter with each telegram */
-    if (pPacket->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PP))
-    {
-        pPacket->curSeqCnt4Pull++;
-        pPacket->pFrame->frameHead.sequenceCounter = vos_htonl(pPacket->curSeqCnt4Pull);
-    }
-    else
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
     {
-        pPacket->curSeqCnt++;
-        pPacket->pFrame->frameHead.sequenceCounter = vos_htonl(pPacket->curSeqCnt);
+        if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET) &&
+            (appHandle->iface[lIndex].shard == shard) &&
+            (appHandle->iface[lIndex].bindAddr == bindAddr))
+        {
+            return lIndex;
+        }
     }
-
-    /* Compute CRC32   */
-    myCRC = vos_crc32(INITFCS, (UINT8 *)&pPacket->pFrame->frameHead, sizeof(PD_HEADER_T) - SIZE_OF_FCS);
-    pPacket->pFrame->frameHead.frameCheckSum = MAKE_LE(myCRC);
+    return TRDP_INVALID_SOCKET_INDEX;
 }
 
-
 /******************************************************************************/
-/** Check if the PD header values and the CRCs are sane
+/** Open the sockets of all receive threads for a bind address
+ *  The sockets are bound one after the other, their index in the SO_REUSEPORT group is the thread no. the kernel
+ *  steers a comId to (comId % pdShardCnt). Each socket is held by its thread until the session is closed, closing
+ *  one would reorder the group.
  *
- *  @param[in]      pPacket         pointer to the packet to check
- *  @param[in]      packetSize      max size to check
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      bindAddr        address to bind to
  *
- *  @retval         TRDP_NO_ERR
- *  @retval         TRDP_CRC_ERR
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_SOCK_ERR   socket error, steering not supported
+ *  @retval         TRDP_MEM_ERR    socket pool exhausted
  */
-TRDP_ERR_T trdp_pdCheck (
-    PD_HEADER_T *pPacket,
-    UINT32      packetSize)
+static TRDP_ERR_T trdp_pdShardSockets (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IP_ADDR_T  bindAddr)
 {
-    UINT32      myCRC;
     TRDP_ERR_T  err = TRDP_NO_ERR;
+    INT32       lIndex;
+    UINT32      i;
 
-    /*  Check size    */
-    if ((packetSize < TRDP_MIN_PD_HEADER_SIZE) ||
-        (packetSize > TRDP_MAX_PD_PACKET_SIZE))
-    {
-        vos_printLog(VOS_LOG_INFO, "PDframe size error (%u))\n", packetSize);
-        err = TRDP_WIRE_ERR;
-    }
-    else
+    for (i = 0u; (i < appHandle->pdShardCnt) && (err == TRDP_NO_ERR); i++)
     {
-        /*    Check Header CRC (FCS)  */
-        myCRC = vos_crc32(INITFCS, (UINT8 *) pPacket, sizeof(PD_HEADER_T) - SIZE_OF_FCS);
-
-        if (pPacket->frameCheckSum != MAKE_LE(myCRC))
-        {
-            vos_printLog(VOS_LOG_INFO, "PDframe crc error (%08x != %08x))\n", pPacket->frameCheckSum, MAKE_LE(myCRC));
-            err = TRDP_CRC_ERR;
-        }
-        /*  Check protocol version  */
-        else if (((vos_ntohs(pPacket->protocolVersion) & TRDP_PROTOCOL_VERSION_CHECK_MASK)
-                  != (TRDP_PROTO_VER & TRDP_PROTOCOL_VERSION_CHECK_MASK)) ||
-                 (vos_ntohl(pPacket->datasetLength) > TRDP_MAX_PD_DATA_SIZE))
+        /*  trdp_requestSocket() does not hand out the sockets of a thread, each call opens a new one  */
+        err = trdp_requestSocket(appHandle->iface,
+                                 appHandle->pdDefault.port,
+                                 &appHandle->pdDefault.sendParam,
+                                 bindAddr,
+                                 0u,
+                                 TRDP_SOCK_PD,
+                                 appHandle->option,
+                                 TRUE,
+                                 -1,
+                                 &lIndex,
+                                 0u);
+        if (err == TRDP_NO_ERR)
         {
-            vos_printLog(VOS_LOG_INFO, "PDframe protocol error (%04x != %04x))\n",
-                         vos_ntohs(pPacket->protocolVersion),
-                         TRDP_PROTO_VER);
-            err = TRDP_WIRE_ERR;
+            appHandle->iface[lIndex].shard = (UINT8) (i + 1u);
+            err = (TRDP_ERR_T) vos_sockSetSteering(appHandle->iface[lIndex].sock,
+                                                   (UINT16) offsetof(PD_HEADER_T, comId),
+                                                   appHandle->pdShardCnt);
+            trdp_pdSetSockFilter(appHandle, lIndex);
         }
-        /*  Check type  */
-        else if ((vos_ntohs(pPacket->msgType) != (UINT16) TRDP_MSG_PD) &&
-                 (vos_ntohs(pPacket->msgType) != (UINT16) TRDP_MSG_PP) &&
-                 (vos_ntohs(pPacket->msgType) != (UINT16) TRDP_MSG_PR) &&
-                 (vos_ntohs(pPacket->msgType) != (UINT16) TRDP_MSG_PE))
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Opening the sockets of the PD receive threads failed (Err: %d)\n", err);
+        for (i = 1u; i <= appHandle->pdShardCnt; i++)
         {
-            vos_printLog(VOS_LOG_INFO, "PDframe type error, received %04x\n", vos_ntohs(pPacket->msgType));
-            err = TRDP_WIRE_ERR;
+            lIndex = trdp_pdFindShardSocket(appHandle, (UINT8) i, bindAddr);
+            if (lIndex != TRDP_INVALID_SOCKET_INDEX)
+            {
+                trdp_releaseSocket(appHandle->iface, lIndex, 0u, FALSE, VOS_INADDR_ANY);
+            }
         }
     }
     return err;
 }
+#endif
 
 /******************************************************************************/
-/** Send one PD packet
+/** Request the receive socket of a subscription
+ *  With receive threads of their own (pdShardCnt > 1), the subscription shares the socket of the thread its comId is
+ *  steered to. Otherwise a socket of the pool is requested with the session's PD defaults.
  *
- *  @param[in]      pdSock          socket descriptor
- *  @param[in]      pPacket         pointer to packet to be sent
- *  @param[in]      port            port on which to send
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      comId           subscribed comId
+ *  @param[in]      mcGroup         multicast group to join, 0 for unicast
+ *  @param[in]      cornerIp        source of a source specific join, 0 for any source
+ *  @param[out]     pIndex          index of the socket in the session's socket pool
  *
- *  @retval         TRDP_NO_ERR
- *  @retval         TRDP_IO_ERR
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_SOCK_ERR   socket error
+ *  @retval         TRDP_MEM_ERR    socket pool exhausted
  */
-TRDP_ERR_T  trdp_pdSend (
-    SOCKET      pdSock,
-    PD_ELE_T    *pPacket,
-    UINT16      port)
+TRDP_ERR_T trdp_pdRequestRcvSocket (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  mcGroup,
+    TRDP_IP_ADDR_T  cornerIp,
+    INT32           *pIndex)
 {
-    VOS_ERR_T   err     = VOS_NO_ERR;
-    UINT32      destIp  = pPacket->addr.destIpAddr;
-
-    /*  check for temporary address (PD PULL):  */
-    if (pPacket->pullIpAddress != 0u)
+#if TRDP_PD_RCV_THREAD
+    if (appHandle->pdShardCnt > 1u)
     {
-        destIp = pPacket->pullIpAddress;
-        pPacket->pullIpAddress = 0u;
-    }
-
-    pPacket->sendSize = pPacket->grossSize;
+        TRDP_IP_ADDR_T  bindAddr    = vos_determineBindAddr(appHandle->realIP, mcGroup, TRUE);
+        UINT8           shard       = (UINT8) (comId % appHandle->pdShardCnt + 1u);
+        INT32           lIndex      = trdp_pdFindShardSocket(appHandle, shard, bindAddr);
 
-    err = vos_sockSendUDP(pdSock,
-                          (UINT8 *)&pPacket->pFrame->frameHead,
-                          &pPacket->sendSize,
-                          destIp,
-                          port);
+        *pIndex = TRDP_INVALID_SOCKET_INDEX;
+        if (lIndex == TRDP_INVALID_SOCKET_INDEX)
+        {
+            TRDP_ERR_T err = trdp_pdShardSockets(appHandle, bindAddr);
 
-    if (err != VOS_NO_ERR)
-    {
-        vos_printLogStr(VOS_LOG_ERROR, "trdp_pdSend failed\n");
-        return TRDP_IO_ERR;
+            if (err != TRDP_NO_ERR)
+            {
+                return err;
+            }
+            lIndex = trdp_pdFindShardSocket(appHandle, shard, bindAddr);
+        }
+        if ((mcGroup != 0u) &&
+            (trdp_SockAddJoin(&appHandle->iface[lIndex], mcGroup, cornerIp, appHandle->realIP) == FALSE))
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "trdp_SockAddJoin() for UDP rcv failed!\n");
+            return TRDP_SOCK_ERR;
+        }
+        appHandle->iface[lIndex].usage++;
+        *pIndex = lIndex;
+        return TRDP_NO_ERR;
     }
-
-    if (pPacket->sendSize != pPacket->grossSize)
+#endif
+    /*  Sessions sharing their sockets need to read them in the calling thread, non-blocking    */
+    if ((appHandle->option & TRDP_OPTION_SHARE_SOCKETS) &&
+        !(appHandle->option & (TRDP_OPTION_PD_THREAD | TRDP_OPTION_BLOCK)))
     {
-        vos_printLogStr(VOS_LOG_ERROR, "trdp_pdSend incomplete\n");
-        return TRDP_IO_ERR;
+        return trdp_shareRequestSocket(appHandle, mcGroup, cornerIp, pIndex);
     }
-
-    return TRDP_NO_ERR;
+    return trdp_requestSocket(appHandle->iface,
+                              appHandle->pdDefault.port,
+                              &appHandle->pdDefault.sendParam,
+                              appHandle->realIP,
+                              mcGroup,
+                              TRDP_SOCK_PD,
+                              appHandle->option,
+                              TRUE,
+                              -1,
+                              pIndex,
+                              cornerIp);
 }
 
+#if TRDP_PD_SOCK_FILTER
 /******************************************************************************/
-/** Distribute send time of PD packets over time
+/** Install the kernel receive filter of a PD socket from its subscriptions
+ *  Only 'Pd' and 'Pp' frames with a subscribed comId and a matching source get through, requests always do.
+ *  Without subscriptions, with a subscription to any comId or if the filter can not be installed, the socket
+ *  receives everything and the frames are checked in user space only. The socket of a receive thread without
+ *  subscriptions receives requests only: the other threads get the multicast frames of the group as well.
  *
- *  The duration of PD packets on a 100MBit/s network ranges from 3us to 150us max.
- *  Because a cyclic thread scheduling below 5ms would put a too heavy load on the system, and
- *  PD packets cannot get larger than 1432 (+ UDP header), we will not account for differences in packet size.
- *  Another factor is the differences in intervals for different packets: We should only change the
- *  starting times of the packets within 1/2 the interval time. Otherwise a late addition of packets
- *  could lead to timeouts of already queued packets.
- *  Scheduling will be computed based on the smallest interval time.
- *
- *  @param[in]      pSndQueue       pointer to send queue
- *
- *  @retval         TRDP_NO_ERR
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      socketIdx       index of the socket in the session's socket pool
  */
-TRDP_ERR_T  trdp_pdDistribute (
-    PD_ELE_T *pSndQueue)
+void trdp_pdSetSockFilter (
+    TRDP_SESSION_PT appHandle,
+    INT32           socketIdx)
 {
-    PD_ELE_T    *pPacket    = pSndQueue;
-    TRDP_TIME_T deltaTmax   = {1000u, 0}; /*    Preset to highest value    */
-    TRDP_TIME_T tNull       = {0u, 0};
-    TRDP_TIME_T temp        = {0u, 0};
-    TRDP_TIME_T nextTime2Go;
-    UINT32      noOfPackets = 0u;
-    UINT32      packetIndex = 0u;
+    TRDP_SOCKETS_T          *pSock;
+    PD_ELE_T                *iterPD;
+    VOS_SOCK_FILTER_T       filter;
+    VOS_SOCK_FILTER_ENTRY_T *pEntries;
+    UINT32                  noOfEntries = 0u;
+    BOOL8                   anyComId    = FALSE;
 
-    if (pSndQueue == NULL)
+    if ((socketIdx < 0) || (socketIdx >= VOS_MAX_SOCKET_CNT) || (appHandle->pdBatch == TRUE))
     {
-        return TRDP_PARAM_ERR;
+        return;
     }
-
-    /*  Do nothing if only one packet is pending */
-    if (pSndQueue->pNext == NULL)
+    pSock = &appHandle->iface[socketIdx];
+    if ((pSock->sock == VOS_INVALID_SOCKET) || (pSock->type != TRDP_SOCK_PD) || (pSock->rcvMostly == FALSE))
     {
-        return TRDP_NO_ERR;
+        return;
+    }
+    /*  A shared socket receives the frames of all sessions sharing it */
+    if (pSock->shareIdx != 0u)
+    {
+        (void) vos_sockSetFilter(pSock->sock, NULL);
+        return;
     }
 
-    /*
-        Find delta tmax - the maximum time for which we will distribute the packets and the number of packets
-        to send within that time. Equals the smallest interval of any PD.
-        Find the next packet send time, as well.
-    */
-
-    while (pPacket)
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        /*  Do not count PULL-only packets!  */
-        if ((pPacket->interval.tv_sec != 0u) ||
-            (pPacket->interval.tv_usec != 0))
+        if (iterPD->socketIdx == socketIdx)
         {
-            if (vos_cmpTime(&deltaTmax, &pPacket->interval) > 0)
-            {
-                deltaTmax = pPacket->interval;
-            }
-            if (vos_cmpTime(&tNull, &pPacket->timeToGo) < 0)
-            {
-                tNull = pPacket->timeToGo;
-            }
-            noOfPackets++;
+            noOfEntries += (iterPD->redIpAddr != 0u) ? 2u : 1u;
+            anyComId = (iterPD->addr.comId == 0u) ? TRUE : anyComId;
         }
-        pPacket = pPacket->pNext;
     }
 
-    /*  Sanity check  */
-    if ((vos_cmpTime(&deltaTmax, &temp) == 0) ||
-        (noOfPackets == 0))
+    pEntries = ((noOfEntries == 0u) || (anyComId == TRUE)) ? NULL :
+        (VOS_SOCK_FILTER_ENTRY_T *) vos_memAlloc(noOfEntries * sizeof(VOS_SOCK_FILTER_ENTRY_T));
+    if ((pEntries == NULL) && ((noOfEntries != 0u) || (pSock->shard == 0u)))
     {
-        vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: no minimal interval in %d packets found!\n", noOfPackets);
-        return TRDP_NO_ERR;     /* Ticket #14: Nothing to shape is not an error */
+        (void) vos_sockSetFilter(pSock->sock, NULL);
+        return;
     }
 
-    /*  This is the delta time we can jitter...   */
-    vos_divTime(&deltaTmax, noOfPackets);
-
-    vos_printLog(VOS_LOG_INFO,
-                 "trdp_pdDistribute: deltaTmax   = %ld.%06u\n",
-                 (long) deltaTmax.tv_sec,
-                 (unsigned int)deltaTmax.tv_usec);
-    vos_printLog(VOS_LOG_INFO,
-                 "trdp_pdDistribute: tNull       = %ld.%06u\n",
-                 (long) tNull.tv_sec,
-                 (unsigned int)tNull.tv_usec);
-    vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: noOfPackets = %d\n", noOfPackets);
-
-    for (packetIndex = 0, pPacket = pSndQueue; packetIndex < noOfPackets && pPacket != NULL; )
+    noOfEntries = 0u;
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        /*  Ignore PULL-only packets!  */
-        if ((pPacket->interval.tv_sec != 0u) ||
-            (pPacket->interval.tv_usec != 0))
+        if (iterPD->socketIdx == socketIdx)
         {
-            nextTime2Go = tNull;
-            temp        = deltaTmax;
-            vos_mulTime(&temp, packetIndex);
-
-            vos_addTime(&nextTime2Go, &temp);
-            vos_mulTime(&temp, 2u);
-
-            if (vos_cmpTime(&temp, &pPacket->interval) > 0)
-            {
-                vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: packet [%d] with interval %lu.%06u could timeout...\n",
-                             packetIndex, (long) temp.tv_sec, (unsigned int)temp.tv_usec);
-                vos_printLogStr(VOS_LOG_INFO, "...no change in send time!\n");
-            }
-            else
+            pEntries[noOfEntries].key       = iterPD->addr.comId;
+            pEntries[noOfEntries].srcIpLo   = iterPD->addr.srcIpAddr;
+            pEntries[noOfEntries].srcIpHi   = iterPD->addr.srcIpAddr2;
+            noOfEntries++;
+            if (iterPD->redIpAddr != 0u)
             {
-                pPacket->timeToGo = nextTime2Go;
-                vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: nextTime2Go[%d] = %lu.%06u\n",
-                             packetIndex, (unsigned long) nextTime2Go.tv_sec, (unsigned int)nextTime2Go.tv_usec);
-
+                /*  source of the publisher on the second interface  */
+                pEntries[noOfEntries].key       = iterPD->addr.comId;
+                pEntries[noOfEntries].srcIpLo   = iterPD->redIpAddr;
+                pEntries[noOfEntries].srcIpHi   = 0u;
+                noOfEntries++;
             }
-            packetIndex++;
         }
-        pPacket = pPacket->pNext;
     }
 
-    return TRDP_NO_ERR;
+    memset(&filter, 0, sizeof(filter));
+    filter.typeOffset   = (UINT16) offsetof(PD_HEADER_T, msgType);
+    filter.noOfTypes    = 2u;
+    filter.types[0]     = TRDP_MSG_PD;
+    filter.types[1]     = TRDP_MSG_PP;
+    filter.keyOffset    = (UINT16) offsetof(PD_HEADER_T, comId);
+    filter.noOfEntries  = noOfEntries;
+    filter.pEntries     = pEntries;
+
+    if (vos_sockSetFilter(pSock->sock, &filter) != VOS_NO_ERR)
+    {
+        (void) vos_sockSetFilter(pSock->sock, NULL);
+    }
+    if (pEntries != NULL)
+    {
+        vos_memFree(pEntries);
+    }
 }
+#endif
@@ -35,6 +35,9 @@
  * DEFINES
  */
 
+/** TRUE if the redundancy group of a publisher is follower, the publisher is not sent */
+#define trdp_pdIsFollower(pElement) \
+    (((pElement)->pRedGroup != NULL) && (TRDP_ATOMIC_LOAD((pElement)->pRedGroup->follower) == TRUE))
 
 /*******************************************************************************
  * TYPEDEFS
@@ -55,6 +58,11 @@ void        trdp_pdInit(
 void        trdp_pdUpdate (
     PD_ELE_T *);
 
+void        trdp_pdTopoFollow (
+    TRDP_SESSION_PT appHandle,
+    UINT32          oldEtbTopoCnt,
+    UINT32          oldOpTrnTopoCnt);
+
 TRDP_ERR_T  trdp_pdPut (
     PD_ELE_T *,
     TRDP_MARSHALL_T func,
@@ -63,13 +71,15 @@ TRDP_ERR_T  trdp_pdPut (
     UINT32          dataSize);
 
 TRDP_ERR_T  trdp_pdCheck (
-    PD_HEADER_T *pPacket,
-    UINT32      packetSize);
+    PD_HEADER_T     *pPacket,
+    UINT32          packetSize,
+    const UINT32    *pFcs);
 
 TRDP_ERR_T  trdp_pdSend (
-    SOCKET      pdSock,
-    PD_ELE_T    *pPacket,
-    UINT16      port);
+    SOCKET              pdSock,
+    PD_ELE_T            *pPacket,
+    UINT16              port,
+    const TRDP_TIME_T   *pLaunchTime);
 
 TRDP_ERR_T trdp_pdGet (
     PD_ELE_T            *pPacket,
@@ -78,13 +88,59 @@ TRDP_ERR_T trdp_pdGet (
     const UINT8         *pData,
     UINT32              *pDataSize);
 
+#if TRDP_PD_LAZY_FCS
+void        trdp_pdInitFcs (void);
+#endif
+
+void        trdp_pdGetInfo (
+    const PD_ELE_T      *pPacket,
+    TRDP_PD_INFO_T      *pPdInfo,
+    TRDP_ERR_T          resultCode);
+
+#if TRDP_PD_RCV_THREAD
+TRDP_ERR_T  trdp_pdSnapCreate (
+    PD_ELE_T *pPacket);
+
+TRDP_ERR_T  trdp_pdSnapGet (
+    PD_ELE_T            *pPacket,
+    TRDP_UNMARSHALL_T   unmarshall,
+    void                *refCon,
+    TRDP_PD_INFO_T      *pPdInfo,
+    UINT8               *pData,
+    UINT32              *pDataSize);
+
+TRDP_ERR_T  trdp_pdRcvThreadStart (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_pdRcvThreadStop (
+    TRDP_SESSION_PT appHandle);
+#endif
+
 TRDP_ERR_T  trdp_pdSendQueued (
     TRDP_SESSION_PT appHandle);
 
+void        trdp_pdPurgeRequests (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_pdHandleShared (
+    TRDP_SESSION_PT     appHandle,
+    const UINT8         *pData,
+    UINT32              size,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    TRDP_IP_ADDR_T      destIpAddr,
+    const TRDP_TIME_T   *pRxTime);
+
 TRDP_ERR_T  trdp_pdReceive (
     TRDP_SESSION_PT pSessionHandle,
     SOCKET           sock);
 
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+TRDP_ERR_T  trdp_pdReceiveBatch (
+    TRDP_SESSION_PT pSessionHandle,
+    SOCKET          sock,
+    UINT32          *pNoFrames);
+#endif
+
 void        trdp_pdCheckPending (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_FDS_T          *pFileDesc,
@@ -93,12 +149,159 @@ void        trdp_pdCheckPending (
 void        trdp_pdHandleTimeOuts (
     TRDP_SESSION_PT appHandle);
 
+TRDP_ERR_T  trdp_pdReceiveSocket (
+    TRDP_SESSION_PT appHandle,
+    TRDP_SOCKETS_T  *pSock);
+
+TRDP_ERR_T  trdp_pdReceiveXdp (
+    TRDP_SESSION_PT appHandle);
+
+#if TRDP_PD_URING
+void        trdp_pdUringArm (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_pdReceiveUring (
+    TRDP_SESSION_PT appHandle);
+#endif
+
 TRDP_ERR_T  trdp_pdCheckListenSocks (
     TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
     INT32           *pCount);
 
-TRDP_ERR_T trdp_pdDistribute (
-    PD_ELE_T *pSndQueue);
+void        trdp_pdBusyPoll (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_pdCallPending (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_pdDistribute (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pNewPacket);
+
+void        trdp_pdDistributeRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket);
+
+void        trdp_pdDistributeFree (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_RED_GROUP_T *trdp_pdRedGroup (
+    TRDP_SESSION_PT appHandle,
+    UINT32          redId,
+    BOOL8           create);
+
+void        trdp_pdRedGroupsFree (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T  trdp_pdGroupCreate (
+    TRDP_SESSION_PT     appHandle,
+    PD_SUB_GROUP_T      **ppGroup,
+    const TRDP_SUB_T    *pSubHandles,
+    UINT32              numSubs);
+
+TRDP_ERR_T  trdp_pdGroupUnlink (
+    TRDP_SESSION_PT appHandle,
+    PD_SUB_GROUP_T  *pGroup);
+
+void        trdp_pdGroupFree (
+    PD_SUB_GROUP_T *pGroup);
+
+void        trdp_pdGroupsFree (
+    TRDP_SESSION_PT appHandle);
+
+BOOL8       trdp_pdGroupsHaveSub (
+    TRDP_SESSION_PT appHandle,
+    const PD_ELE_T  *pSub);
+
+void        trdp_pdGroupsRemoveSub (
+    TRDP_SESSION_PT appHandle,
+    const PD_ELE_T  *pSub);
+
+TRDP_ERR_T  trdp_pdGroupGet (
+    TRDP_SESSION_PT     appHandle,
+    PD_SUB_GROUP_T      *pGroup,
+    TRDP_GET_ITEM_T     *pItems,
+    UINT32              numItems);
+
+TRDP_ERR_T  trdp_pdRequestRcvSocket (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  mcGroup,
+    TRDP_IP_ADDR_T  cornerIp,
+    INT32           *pIndex);
+
+#if TRDP_PD_SOCK_FILTER
+void        trdp_pdSetSockFilter (
+    TRDP_SESSION_PT appHandle,
+    INT32           socketIdx);
+#else
+#define trdp_pdSetSockFilter(appHandle, socketIdx)
+#endif
+
+#if TRDP_PD_SEND_SCHEDULER
+TRDP_ERR_T  trdp_pdSchedUpdate (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void        trdp_pdSchedRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+TRDP_ERR_T  trdp_pdSchedRebuild (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_pdSchedFree (
+    TRDP_SESSION_PT appHandle);
+#else
+#define trdp_pdSchedUpdate(appHandle, pElement)     (TRDP_NO_ERR)
+#define trdp_pdSchedRemove(appHandle, pElement)
+#define trdp_pdSchedRebuild(appHandle)              (TRDP_NO_ERR)
+#define trdp_pdSchedFree(appHandle)
+#endif
+
+#if TRDP_PD_TIMEOUT_TABLE
+TRDP_ERR_T  trdp_pdTimeoutUpdate (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void        trdp_pdTimeoutRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pElement);
+
+void        trdp_pdTimeoutFree (
+    TRDP_SESSION_PT appHandle);
+#else
+#define trdp_pdTimeoutUpdate(appHandle, pElement)   (TRDP_NO_ERR)
+#define trdp_pdTimeoutRemove(appHandle, pElement)
+#define trdp_pdTimeoutFree(appHandle)
+#endif
+
+#if TRDP_PD_PULL_HASH_SIZE > 0
+TRDP_ERR_T  trdp_pdPullAdd (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pSub,
+    UINT32              replyComId,
+    TRDP_IP_ADDR_T      replierIpAddr,
+    const TRDP_TIME_T   *pDeadline);
+
+PD_ELE_T    *trdp_pdPullMatch (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr);
+
+void        trdp_pdPullExpire (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pNow);
+
+void        trdp_pdPullRemoveSub (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pSub);
+#else
+#define trdp_pdPullAdd(appHandle, pSub, replyComId, replierIpAddr, pDeadline)   (TRDP_NO_ERR)
+#define trdp_pdPullMatch(appHandle, comId, srcIpAddr)                           (NULL)
+#define trdp_pdPullExpire(appHandle, pNow)
+#define trdp_pdPullRemoveSub(appHandle, pSub)
+#endif
 
 #endif
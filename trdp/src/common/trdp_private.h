@@ -54,17 +54,374 @@
 #define TRDP_EVOLUTION          0u
 #endif
 
+/* Compact build for devices with little RAM (ESP32, small VxWorks targets), add -DTRDP_COMPACT=1 to CFLAGS:
+   small lookup tables, no batched send/receive, no receive threads, one block of statistics counters instead of
+   one per thread and subscription frames sized to the received data (TRDP_PD_RCV_COPY). Each setting below can
+   still be overridden. The timing statistics cost little memory and are switched at run time
+   (TRDP_OPTION_TIMING_STATS), build with TRDP_TIMING_STATS=0 to remove them from the code.
+
+   Memory cost (64 bit Linux, vos_mem block rounding not included, n = data size padded to 4 bytes):
+                                default                         TRDP_COMPACT
+   session                      34 KB + 17 x 1472 bytes         16 KB + 1472 bytes (one receive frame)
+   publisher                    312 + 40 + n                    288 + 40 + n
+   subscription                 312 + 1472 + seq. counters      288 + 40 + n + seq. counters
+   seq. counters (any source)   4 + 12 x 64 slots               4 + 12 x 8 slots (growing with the sources)
+   seq. counters (one source)   4 + 12 x 4 slots                4 + 12 x 4 slots
+   11 KB of the session are the socket table (VOS_MAX_SOCKET_CNT x 144 bytes). The per telegram state of delta
+   encoding and SDT is only allocated where used. Frames (1472, 40 + n) are cache line aligned by default, in a
+   vos_mem area this adds 80 bytes to each. */
+#ifndef TRDP_COMPACT
+#define TRDP_COMPACT                        0
+#endif
+
+#if TRDP_COMPACT
+#ifndef TRDP_PD_SUB_HASH_SIZE
+#define TRDP_PD_SUB_HASH_SIZE               16u
+#endif
+#ifndef TRDP_PD_PUB_HASH_SIZE
+#define TRDP_PD_PUB_HASH_SIZE               16u
+#endif
+#ifndef TRDP_MD_SESSION_HASH_SIZE
+#define TRDP_MD_SESSION_HASH_SIZE           64u
+#endif
+#ifndef TRDP_MD_LISTENER_HASH_SIZE
+#define TRDP_MD_LISTENER_HASH_SIZE          16u
+#endif
+#ifndef TRDP_SEQ_CNT_START_ARRAY_SIZE
+#define TRDP_SEQ_CNT_START_ARRAY_SIZE       8u
+#endif
+#ifndef TRDP_PD_RCV_BATCH_SIZE
+#define TRDP_PD_RCV_BATCH_SIZE              1u
+#endif
+#ifndef TRDP_PD_SND_BATCH_SIZE
+#define TRDP_PD_SND_BATCH_SIZE              1u
+#endif
+#ifndef TRDP_PD_RCV_THREAD
+#define TRDP_PD_RCV_THREAD                  0
+#endif
+#ifndef TRDP_PD_RCV_SHARDS_MAX
+#define TRDP_PD_RCV_SHARDS_MAX              1u
+#endif
+#ifndef TRDP_PD_LAZY_FCS
+#define TRDP_PD_LAZY_FCS                    0
+#endif
+#ifndef TRDP_STATS_BLOCKS
+#define TRDP_STATS_BLOCKS                   1u
+#endif
+#ifndef TRDP_PD_RCV_COPY
+#define TRDP_PD_RCV_COPY                    1
+#endif
+#ifndef TRDP_PD_SRC_TABLE
+#define TRDP_PD_SRC_TABLE                   0
+#endif
+#ifndef TRDP_PD_FRAME_ALIGN
+#define TRDP_PD_FRAME_ALIGN                 4u
+#endif
+#ifndef TRDP_RECORDER
+#define TRDP_RECORDER                       0
+#endif
+#endif
+
+/* Copy received PD into the frame of the subscription, grown to the largest frame received, instead of swapping
+   frames of maximum size (1472 bytes per subscription). The first frame received and larger ones allocate */
+#ifndef TRDP_PD_RCV_COPY
+#define TRDP_PD_RCV_COPY                    0
+#endif
+
 #define TRDP_TIMER_GRANULARITY              10000u                        /**< granularity in us                      */
 
 #define TRDP_DEBUG_DEFAULT_FILE_SIZE        65536u                        /**< Default maximum size of log file       */
 
 #define TRDP_MAGIC_PUB_HNDL_VALUE           0xCAFEBABEu
 #define TRDP_MAGIC_SUB_HNDL_VALUE           0xBABECAFEu
+#define TRDP_MAGIC_SESSION_VALUE            0xCAFED00Du
+#define TRDP_MAGIC_GROUP_HNDL_VALUE         0xBABED00Du
 
-#define TRDP_SEQ_CNT_START_ARRAY_SIZE       64u                           /**< This should be enough for the start    */
+#ifndef TRDP_SEQ_CNT_START_ARRAY_SIZE
+#define TRDP_SEQ_CNT_START_ARRAY_SIZE       64u     /**< Sequence counter table size for any source (power of 2)  */
+#endif
+#define TRDP_SEQ_CNT_MIN_ARRAY_SIZE         4u      /**< Sequence counter table size for one source (power of 2)  */
 
 #define TRDP_IF_WAIT_FOR_READY              120u    /**< 120 seconds (120 tries each second to bind to an IP address) */
 
+/* Poll set tags besides the socket indices: VOS_MAX_SOCKET_CNT is the TCP listener */
+#define TRDP_XDP_POLL_TAG                   (VOS_MAX_SOCKET_CNT + 1u)   /**< AF_XDP socket of tlp_openXdp()   */
+#define TRDP_URING_POLL_TAG                 (VOS_MAX_SOCKET_CNT + 2u)   /**< io_uring of the PD sockets       */
+
+/* Number of comId buckets used to look up subscriptions on receive, 0 disables the index (linear search) */
+#ifndef TRDP_PD_SUB_HASH_SIZE
+#define TRDP_PD_SUB_HASH_SIZE               64u
+#endif
+
+/** Bucket of a comId in the subscriber index */
+#define TRDP_SUB_HASH(comId)                (((comId) ^ ((comId) >> 16u)) % TRDP_PD_SUB_HASH_SIZE)
+
+/* Look up the subscriptions of a received PD in a sorted table of source IP segments per comId, built from the
+   source filters (single IPs and srcIpAddr..srcIpAddr2 ranges) after the subscriptions changed. 0 checks the filter
+   of each subscription of the comId bucket */
+#ifndef TRDP_PD_SRC_TABLE
+#define TRDP_PD_SRC_TABLE                   1
+#endif
+
+/* Number of comId buckets used to look up publishers on pull requests, 0 disables the index (linear search) */
+#ifndef TRDP_PD_PUB_HASH_SIZE
+#define TRDP_PD_PUB_HASH_SIZE               64u
+#endif
+
+/** Bucket of a comId in the publisher index */
+#define TRDP_PUB_HASH(comId)                (((comId) ^ ((comId) >> 16u)) % TRDP_PD_PUB_HASH_SIZE)
+
+/* Number of buckets of the index of outstanding PD pull requests (tlp_request) by reply comId and replier, replies
+   are matched to the requesting subscription by it. 0 disables the index and the in-flight limit */
+#ifndef TRDP_PD_PULL_HASH_SIZE
+#define TRDP_PD_PULL_HASH_SIZE              64u
+#endif
+
+/** Bucket of a reply comId and replier address in the pull request index */
+#define TRDP_PULL_HASH(comId, ip)           (((comId) ^ ((comId) >> 16u) ^ (ip) ^ ((ip) >> 16u)) % TRDP_PD_PULL_HASH_SIZE)
+
+/* Default max. number of outstanding PD pull requests of a session (tlp_setPullLimit), 0: no limit */
+#ifndef TRDP_PD_PULL_MAX
+#define TRDP_PD_PULL_MAX                    0u
+#endif
+
+/* Sessions with TRDP_OPTION_SHARE_SOCKETS: max. number of PD receive sockets shared in the process, of sessions
+   sharing one socket, and of frames queued for a session which is busy when another one reads a frame for it */
+#ifndef TRDP_SHARE_SOCK_MAX
+#define TRDP_SHARE_SOCK_MAX                 16u
+#endif
+#ifndef TRDP_SHARE_SESSION_MAX
+#define TRDP_SHARE_SESSION_MAX              8u
+#endif
+#ifndef TRDP_SHARE_QUEUE_MAX
+#define TRDP_SHARE_QUEUE_MAX                256u
+#endif
+
+/* Number of session ID buckets used to match MD replies/confirms to their session, 0 disables the index */
+#ifndef TRDP_MD_SESSION_HASH_SIZE
+#define TRDP_MD_SESSION_HASH_SIZE           1024u
+#endif
+
+/* Chunk size for TCP MD notifications handed to a TRDP_FLAGS_TCP_STREAM listener, 0 always reassembles messages */
+#ifndef TRDP_MD_STREAM_CHUNK_SIZE
+#define TRDP_MD_STREAM_CHUNK_SIZE           16384u
+#endif
+
+/* Bytes queued for sending on one MD TCP connection above which new messages are refused with TRDP_BLOCK_ERR,
+   until the queue drained to the low watermark; 0: no limit */
+#ifndef TRDP_MD_TCP_SNDQ_HIGH
+#define TRDP_MD_TCP_SNDQ_HIGH               (256u * 1024u)
+#endif
+#ifndef TRDP_MD_TCP_SNDQ_LOW
+#define TRDP_MD_TCP_SNDQ_LOW                (64u * 1024u)
+#endif
+
+/* 1: Cork a TCP connection while more than one MD message to it goes out in the same cycle, so small messages
+   share segments; 0 (default): every message is pushed on its own (TCP_NODELAY) */
+#ifndef TRDP_MD_TCP_CORK
+#define TRDP_MD_TCP_CORK                    0
+#endif
+
+/* Largest UDP MD datagram sent or received in segments with TRDP_OPTION_MD_UDP_SEGMENT (one Ethernet frame);
+   0: no segmentation offload */
+#ifndef TRDP_MD_UDP_SEG_SIZE
+#define TRDP_MD_UDP_SEG_SIZE                1472u
+#endif
+
+/* Data size up to which MD frames are kept in the per-session pool for reuse, 0: always use vos_memAlloc.
+   The default makes a pool frame as large as the initial receive buffer (1480 bytes), which is then pooled, too */
+#ifndef TRDP_MD_POOL_DATA_SIZE
+#define TRDP_MD_POOL_DATA_SIZE              1364u
+#endif
+
+/* Create MD session IDs from a per-session random prefix and a counter instead of vos_getUuid() per request */
+#ifndef TRDP_MD_FAST_UUID
+#define TRDP_MD_FAST_UUID                   1
+#endif
+
+/* Number of comId buckets used to find the listener of an incoming MD request/notification, 0: linear search */
+#ifndef TRDP_MD_LISTENER_HASH_SIZE
+#define TRDP_MD_LISTENER_HASH_SIZE          64u
+#endif
+
+/* Keep the MD sessions in a min-heap ordered by timeout, 0 scans both MD queues on each tlc_process() */
+#ifndef TRDP_MD_TIMEOUT_SCHEDULER
+#define TRDP_MD_TIMEOUT_SCHEDULER           1
+#endif
+
+/* Keep the publishers in a min-heap ordered by due time, 0 scans the whole send queue on each tlc_process() */
+#ifndef TRDP_PD_SEND_SCHEDULER
+#define TRDP_PD_SEND_SCHEDULER              1
+#endif
+
+/* Keep the subscriptions in a min-heap ordered by time out, 0 walks the receive queue on each tlc_process() */
+#ifndef TRDP_PD_TIMEOUT_TABLE
+#define TRDP_PD_TIMEOUT_TABLE               1
+#endif
+
+/* Priority classes of PD: the QoS 0..7 of a publisher or the priority of a subscription (tlp_setPriority) is
+   mapped to one of them. Due PDs of higher classes are sent first, sockets of higher classes are read first */
+#ifndef TRDP_PD_PRIO_CLASSES
+#define TRDP_PD_PRIO_CLASSES                8u
+#endif
+#define TRDP_PD_PRIO_MAX                    7u                            /**< Highest priority (QoS) of PD           */
+#define TRDP_PD_PRIO_CLASS(prio)            (((UINT32) (prio) * TRDP_PD_PRIO_CLASSES) / (TRDP_PD_PRIO_MAX + 1u))
+#define TRDP_PD_PRIO_OF(qos)                ((UINT8) (((qos) > TRDP_PD_PRIO_MAX) ? TRDP_PD_PRIO_MAX : (qos)))
+
+#define TRDP_PD_SCHED_START_SIZE            64u                           /**< Initial size of the send schedule      */
+#define TRDP_PD_TIMEOUT_START_SIZE          64u                           /**< Initial size of the time out heap      */
+#define TRDP_MD_SCHED_START_SIZE            64u                           /**< Initial size of the MD timeout schedule */
+
+/* Max. number of PD frames read from a socket with one call in non-blocking mode, 1 reads frame by frame */
+#ifndef TRDP_PD_RCV_BATCH_SIZE
+#define TRDP_PD_RCV_BATCH_SIZE              16u
+#endif
+
+/* Max. number of due PD frames collected before they are sent with one call, 1 sends frame by frame */
+#ifndef TRDP_PD_SND_BATCH_SIZE
+#define TRDP_PD_SND_BATCH_SIZE              16u
+#endif
+
+/* Receive and send PD through an io_uring of the VOS (built with VOS_URING=1): the subscription sockets are read by
+   multishot requests into shared buffers, the send batch goes out with one call for all sockets */
+#ifndef TRDP_PD_URING
+#ifdef VOS_IO_URING
+#define TRDP_PD_URING                       1
+#else
+#define TRDP_PD_URING                       0
+#endif
+#endif
+#ifndef TRDP_PD_URING_BUFFERS
+#define TRDP_PD_URING_BUFFERS               256u    /**< receive buffers of the io_uring (power of 2)      */
+#endif
+
+/* Default heartbeat of publishers with TRDP_FLAGS_PD_ON_CHANGE: unchanged data is sent every n-th interval */
+#ifndef TRDP_PD_HEARTBEAT_CYCLES
+#define TRDP_PD_HEARTBEAT_CYCLES            10u
+#endif
+
+/* Default distance of the key frames of delta encoded PD (tlp_setDeltaRange): every n-th frame is sent in full */
+#ifndef TRDP_PD_DELTA_KEY_CYCLES
+#define TRDP_PD_DELTA_KEY_CYCLES            10u
+#endif
+
+#define TRDP_PD_DELTA_TAG                   0x446C7461u                   /**< 'Dlta' in the reserved header field    */
+#define TRDP_PD_DELTA_HEAD_SIZE             8u                            /**< key seq. counter, data size, no. runs  */
+#define TRDP_PD_DELTA_RUN_SIZE              4u                            /**< offset and length of a changed run     */
+
+/* Compute the FCS of sent PD headers from a cached header part and the sequence counter, 0 hashes the whole header */
+#ifndef TRDP_PD_LAZY_FCS
+#define TRDP_PD_LAZY_FCS                    1
+#endif
+
+/* Support for TRDP_OPTION_PD_THREAD, needs atomic built-ins to hand over the received frames without locking */
+#ifndef TRDP_PD_RCV_THREAD
+#ifdef __GNUC__
+#define TRDP_PD_RCV_THREAD                  1
+#else
+#define TRDP_PD_RCV_THREAD                  0
+#endif
+#endif
+
+#define TRDP_PD_RCV_THREAD_POLL             10000u                        /**< select timeout of the receive thread   */
+
+/* Max. number of PD receive threads (TRDP_PROCESS_CONFIG_T.pdRcvShards), needs SO_REUSEPORT steering (Linux) */
+#ifndef TRDP_PD_RCV_SHARDS_MAX
+#ifdef __linux
+#define TRDP_PD_RCV_SHARDS_MAX              8u
+#else
+#define TRDP_PD_RCV_SHARDS_MAX              1u
+#endif
+#endif
+
+/* Max. no. of worker threads calling the user callbacks (TRDP_PROCESS_CONFIG_T.cbWorkers) */
+#ifndef TRDP_CB_WORKERS_MAX
+#define TRDP_CB_WORKERS_MAX                 8u
+#endif
+
+/* Strands of the callback dispatcher, the callbacks of comIds with the same comId % TRDP_CB_STRANDS run in order */
+#ifndef TRDP_CB_STRANDS
+#define TRDP_CB_STRANDS                     64u
+#endif
+
+/* Max. PD callbacks waiting for a worker thread, further PD callbacks are dropped (MD callbacks are never dropped) */
+#ifndef TRDP_CB_QUEUE_MAX
+#define TRDP_CB_QUEUE_MAX                   1024u
+#endif
+
+#define TRDP_CB_WORKER_POLL                 100000u                       /**< idle wait of a worker thread in us     */
+
+/* Alignment of PD frames: the header fields are aligned and the payload copies start on a cache line */
+#ifndef TRDP_PD_FRAME_ALIGN
+#define TRDP_PD_FRAME_ALIGN                 VOS_CACHE_LINE_SIZE
+#endif
+
+/* Lend the frame of a subscription to the callbacks queued for the workers instead of copying its data. The frame is
+   reference counted and replaced by a new one if it is still in use when the next frame is received */
+#ifndef TRDP_PD_SHARED_FRAMES
+#ifdef __GNUC__
+#define TRDP_PD_SHARED_FRAMES               1
+#else
+#define TRDP_PD_SHARED_FRAMES               0
+#endif
+#endif
+
+/* Min. send slot of the traffic shaping in us, the slot is the greatest common divisor of the intervals otherwise */
+#ifndef TRDP_PD_SHAPING_SLOT
+#define TRDP_PD_SHAPING_SLOT                1000u
+#endif
+
+#define TRDP_PD_SHAPING_MAX_SLOTS           10000u                        /**< max. slots of a hyper-period           */
+
+/* Time PD frames with launch time (TRDP_SEND_PARAM_T.txTime) are sent ahead, if no process cycle time is configured */
+#ifndef TRDP_PD_TXTIME_LEAD
+#define TRDP_PD_TXTIME_LEAD                 2000u
+#endif
+
+/* Set the QoS of sent PD frames per datagram (Linux: IP_TOS/SO_PRIORITY ancillary data), publishers of different QoS
+   share one socket. 0 opens a socket per QoS. Sockets with launch time keep a QoS per socket */
+#ifndef TRDP_PD_QOS_PER_FRAME
+#ifdef __linux
+#define TRDP_PD_QOS_PER_FRAME               1
+#else
+#define TRDP_PD_QOS_PER_FRAME               0
+#endif
+#endif
+
+/* Let the kernel drop PD frames of unsubscribed comIds/sources (Linux: socket BPF filter), 0 filters in user space */
+#ifndef TRDP_PD_SOCK_FILTER
+#define TRDP_PD_SOCK_FILTER                 1
+#endif
+
+/* Grow the receive buffer of a backlogged PD socket up to this size (kernel accounting), 0 keeps TRDP_SOCKBUF_SIZE */
+#ifndef TRDP_PD_RCVBUF_MAX
+#define TRDP_PD_RCVBUF_MAX                  (1024u * 1024u)
+#endif
+
+#define TRDP_PD_RXQ_CHECK_FRAMES            16u                           /**< backlog which triggers a queue check   */
+
+/* TRDP_OPTION_BUSY_POLL: spin time after reading the PD sockets in us, if the process configuration sets none */
+#ifndef TRDP_PD_BUSY_POLL_BUDGET
+#define TRDP_PD_BUSY_POLL_BUDGET            200u
+#endif
+
+#define TRDP_PD_BUSY_POLL_READ              50u                           /**< SO_BUSY_POLL time of PD sockets in us  */
+
+/* Support for TRDP_OPTION_TIMING_STATS, 0 removes the time measurements from the send and receive paths */
+#ifndef TRDP_TIMING_STATS
+#define TRDP_TIMING_STATS                   1
+#endif
+
+/* Take the timing statistics time stamps from the x86 time stamp counter (needs an invariant TSC) */
+#ifndef TRDP_TIMING_TSC
+#define TRDP_TIMING_TSC                     0
+#endif
+
+/* Read the clock once per tlc_process / tlc_processEvents, the send and time out handling reuse that time */
+#ifndef TRDP_PROCESS_TIME_CACHE
+#define TRDP_PROCESS_TIME_CACHE             1
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -103,9 +460,77 @@ typedef enum
 #define TRDP_PULL_SUB           0x10u       /**< if set, its a PULL subscription                        */
 #define TRDP_REDUNDANT          0x20u       /**< if set, packet should not be sent (redundant)          */
 #define TRDP_CHECK_COMID        0x40u       /**< if set, do filter comId (addListener)                  */
+#define TRDP_PUT_PENDING        0x80u       /**< if set, the frame is written by tlp_beginPut()         */
 
 typedef UINT8   TRDP_PRIV_FLAGS_T;
 
+/* Subscription groups are read without locking the session if atomic built-ins are available, else locked */
+#ifndef TRDP_PD_GROUP_SEQLOCK
+#ifdef __GNUC__
+#define TRDP_PD_GROUP_SEQLOCK               1
+#else
+#define TRDP_PD_GROUP_SEQLOCK               0
+#endif
+#endif
+
+#define TRDP_PD_GROUP_MAX_SUBS              64u     /**< max. members of a subscription group (two buffers of
+                                                         members * ~1.5kB each)                                 */
+
+/** The leader/follower state of a redundancy group is switched without the session mutex   */
+#ifdef __GNUC__
+#define TRDP_ATOMIC_LOAD(var)           __atomic_load_n(&(var), __ATOMIC_ACQUIRE)
+#define TRDP_ATOMIC_STORE(var, val)     __atomic_store_n(&(var), (val), __ATOMIC_RELEASE)
+#else
+#define TRDP_ATOMIC_LOAD(var)           (var)
+#define TRDP_ATOMIC_STORE(var, val)     ((var) = (val))
+#endif
+
+/** Number of counter blocks the event counters of a session are spread over. Each thread counts in one of them
+    (assigned round robin) with atomic adds, without the session mutex; reading sums them up. 1: a single block  */
+#ifndef TRDP_STATS_BLOCKS
+#ifdef __GNUC__
+#define TRDP_STATS_BLOCKS               4u
+#else
+#define TRDP_STATS_BLOCKS               1u
+#endif
+#endif
+
+#define TRDP_STATS_LINE                 64u         /**< the counter blocks are padded to whole cache lines     */
+
+/** Max. number of subscriptions and of publishers listed in the statistics export (tlc_exportStatistics) */
+#ifndef TRDP_EXPORT_MAX_ELE
+#define TRDP_EXPORT_MAX_ELE             256u
+#endif
+
+/** Black-box recorder of the telegrams of a session (tlc_record). Off, it costs one pointer test per telegram */
+#ifndef TRDP_RECORDER
+#define TRDP_RECORDER                   1
+#endif
+
+/** Event counters of the session statistics, laid out as TRDP_STATISTICS_T from pd on. The fields not counting
+    events (defaults, numSubs, numPub, numList) are not used here, they are kept in the session statistics     */
+typedef struct
+{
+    TRDP_PD_STATISTICS_T    pd;
+    TRDP_MD_STATISTICS_T    udpMd;
+    TRDP_MD_STATISTICS_T    tcpMd;
+} TRDP_STATS_CNT_T;
+
+/** Counter block of the threads of one slot */
+typedef union
+{
+    TRDP_STATS_CNT_T    cnt;
+    UINT8               pad[(sizeof(TRDP_STATS_CNT_T) + TRDP_STATS_LINE - 1u) / TRDP_STATS_LINE * TRDP_STATS_LINE];
+} TRDP_STATS_BLOCK_T;
+
+/** Redundancy group, shared by all publishers with the same redId. Kept until the session is closed   */
+typedef struct TRDP_RED_GROUP
+{
+    struct TRDP_RED_GROUP   *pNext;             /**< next group or NULL                                     */
+    UINT32                  redId;              /**< redundancy group ID, not zero                          */
+    BOOL8                   follower;           /**< TRUE: the publishers of the group are not sent         */
+} TRDP_RED_GROUP_T;
+
 /** Socket usage    */
 typedef enum
 {
@@ -134,11 +559,12 @@ typedef struct
     TRDP_MSG_T      msgType;                            /**< message type                               */
 } TRDP_SEQ_CNT_ENTRY_T;
 
+/** Hash table (open addressing) of the sequence counters per source IP/msgType, msgType 0 marks a free slot */
 typedef struct
 {
-    UINT16                  maxNoOfEntries;             /**< Max. no of entries the seq[] can hold      */
-    UINT16                  curNoOfEntries;             /**< Current no of entries in array             */
-    TRDP_SEQ_CNT_ENTRY_T    seq[1];                     /**< list of used sequence no.                  */
+    UINT16                  maxNoOfEntries;             /**< No of slots in seq[], power of 2           */
+    UINT16                  curNoOfEntries;             /**< Current no of used slots, at most half     */
+    TRDP_SEQ_CNT_ENTRY_T    seq[1];                     /**< slots of used sequence no.                 */
 } TRDP_SEQ_CNT_LIST_T;
 
 /** TCP parameters    */
@@ -151,9 +577,21 @@ typedef struct TRDP_SOCKET_TCP
     TRDP_TIME_T     sendingTimeout;                     /**< The timeout sending the message              */
     BOOL8           addFileDesc;                        /**< Ready to add the socket in the fd            */
     BOOL8           morituri;                           /**< about to die                                 */
+    BOOL8           connected;                          /**< connect() was done, the socket can be reused */
+    UINT32          queuedBytes;                        /**< Bytes of the messages waiting to be sent     */
+    BOOL8           throttled;                          /**< High watermark reached, refuse new messages  */
+    BOOL8           corked;                             /**< Held back by vos_sockSetCork() in this cycle */
+    UINT16          txBatch;                            /**< Messages to go out in this cycle             */
 }TRDP_SOCKET_TCP_T;
 
 
+/** Multicast membership of a socket */
+typedef struct
+{
+    TRDP_IP_ADDR_T  mcGroup;                            /**< Joined multicast group                       */
+    TRDP_IP_ADDR_T  srcIp;                              /**< Source of a source specific join, 0 for any  */
+} TRDP_MC_JOIN_T;
+
 /** Socket item    */
 typedef struct TRDP_SOCKETS
 {
@@ -164,7 +602,26 @@ typedef struct TRDP_SOCKETS
     BOOL8               rcvMostly;                       /**< Used for receiving                          */
     INT16               usage;                           /**< No. of current users of this socket         */
     TRDP_SOCKET_TCP_T   tcpParams;                       /**< Params used for TCP                         */
-    TRDP_IP_ADDR_T      mcGroups[VOS_MAX_MULTICAST_CNT]; /**< List of multicast addresses for this socket */
+    TRDP_MC_JOIN_T      *pMcJoins;                       /**< Multicast memberships of this socket        */
+    UINT32              mcJoinCnt;                       /**< No. of used entries in pMcJoins             */
+    UINT32              mcJoinSize;                      /**< No. of allocated entries in pMcJoins        */
+    BOOL8               polled;                          /**< Socket is registered in the session's poll set */
+    BOOL8               mcIfSet;                         /**< Multicast interface was set to bindAddr     */
+    UINT32              hashKey;                         /**< Hash of the socket parameters               */
+    INT32               hashNext;                        /**< Next socket in the same bucket, or -1       */
+    INT32               hashHead;                        /**< First socket of bucket #index, or -1        */
+    UINT32              rxDrops;                         /**< Datagrams dropped on the full receive queue */
+    UINT32              rxDropsSeen;                     /**< Drop counter of the system at the last check */
+    UINT32              rxPeak;                          /**< Max. bytes found in the receive queue       */
+    UINT32              rcvBufSize;                      /**< Receive buffer size at the last check       */
+    BOOL8               rcvBufFixed;                     /**< The system refused to grow the buffer       */
+    UINT8               shard;                           /**< PD receive thread no. + 1, 0 if not sharded */
+    UINT8               rcvPrio;                         /**< Highest priority of the subscriptions on it */
+    UINT8               shareIdx;                        /**< Entry + 1 in the registry of sockets shared
+                                                              with other sessions, 0 if not shared         */
+#if TRDP_PD_URING
+    VOS_URING_T         uring;                           /**< io_uring reading the socket, NULL if none   */
+#endif
 } TRDP_SOCKETS_T;
 
 #ifdef WIN32
@@ -225,50 +682,339 @@ typedef struct
 #pragma pack(pop)
 #endif
 
-/** Queue element for PD packets to send or receive    */
+#if TRDP_PD_RCV_THREAD
+/** One buffer of a PD snapshot, written by the receive thread and copied out by tlp_get()   */
+typedef struct
+{
+    UINT32              seq;                    /**< odd while the buffer is written                        */
+    TRDP_IP_ADDR_T      srcIpAddr;              /**< source IP the frame was received from                  */
+    UINT32              seqCnt;                 /**< sequence counter of the frame                          */
+    UINT32              dataSize;               /**< net data size                                          */
+    TRDP_TIME_T         timeToGo;               /**< time the next frame is expected                        */
+    TRDP_TIME_T         rxTime;                 /**< reception time of the frame                            */
+    PD_PACKET_T         frame;                  /**< copy of header and data                                */
+} PD_SNAP_BUF_T;
+
+/** Latest received frame of a subscription, double buffered and guarded by sequence numbers (seqlock)  */
+typedef struct
+{
+    UINT32              version;                /**< number of published frames, buffer[version & 1] is current */
+    PD_SNAP_BUF_T       buffer[2];
+} PD_SNAPSHOT_T;
+
+/** PD receive thread of a sharded session, reads its own sockets into its own buffers  */
+typedef struct PD_RCV_SHARD
+{
+    struct TRDP_SESSION *pSession;              /**< session the thread receives for                        */
+    UINT32              index;                  /**< thread no., receives comId % pdShardCnt == index        */
+    VOS_THREAD_T        thread;                 /**< the receive thread                                     */
+    VOS_SEMA_T          done;                   /**< given by the thread when it terminates                 */
+    PD_PACKET_T         *pRcvBatch[TRDP_PD_RCV_BATCH_SIZE];  /**< frames read without the session lock       */
+} PD_RCV_SHARD_T;
+#endif
+
+/** Frame of a subscription lent to queued callbacks (TRDP_PD_SHARED_FRAMES)  */
+typedef struct TRDP_PD_FRAME_REF
+{
+    UINT32              refCnt;                 /**< callbacks using the frame, + 1 while the subscription has it */
+    PD_PACKET_T         *pFrame;                /**< the frame, freed with the last reference               */
+} TRDP_PD_FRAME_REF_T;
+
+/** User callback queued to the callback dispatcher, followed by a copy of the data   */
+typedef struct TRDP_CB_JOB
+{
+    struct TRDP_CB_JOB  *pNext;                 /**< next callback of the same strand                       */
+    TRDP_PD_CALLBACK_T  pfPdCb;                 /**< PD callback, NULL for an MD callback                   */
+    TRDP_MD_CALLBACK_T  pfMdCb;                 /**< MD callback, NULL for a PD callback                    */
+    void                *pRefCon;               /**< user context of the session defaults                   */
+    UINT8               *pData;                 /**< copy of the data, NULL if there is none                */
+    UINT32              dataSize;               /**< size of the data                                       */
+    TRDP_PD_FRAME_REF_T *pFrameRef;             /**< frame holding pData if lent instead of copied, or NULL */
+    union
+    {
+        TRDP_PD_INFO_T  pd;
+        TRDP_MD_INFO_T  md;
+    } info;                                     /**< message info handed to the callback                    */
+} TRDP_CB_JOB_T;
+
+/** Callbacks running one after the other, at most one worker thread owns a strand at a time    */
+typedef struct
+{
+    TRDP_CB_JOB_T       *pHead;                 /**< oldest waiting callback                                */
+    TRDP_CB_JOB_T       *pTail;                 /**< newest waiting callback                                */
+    BOOL8               scheduled;              /**< the strand is in a run queue or its callback is running */
+} TRDP_CB_STRAND_T;
+
+/** Worker thread of the callback dispatcher with its run queue of strands   */
+typedef struct
+{
+    struct TRDP_CB_DISPATCH *pDispatch;         /**< dispatcher of the worker                               */
+    VOS_THREAD_T        thread;                 /**< the worker thread                                      */
+    VOS_SEMA_T          wake;                   /**< given when strands were queued for the worker          */
+    VOS_SEMA_T          done;                   /**< given by the thread when it terminates                 */
+    BOOL8               busy;                   /**< a callback is running                                  */
+    UINT32              head;                   /**< the worker takes strands from the head of its queue     */
+    UINT32              tail;                   /**< strands are queued and stolen at the tail              */
+    UINT16              runQueue[TRDP_CB_STRANDS];  /**< strand indices, ring of head..tail                 */
+} TRDP_CB_WORKER_T;
+
+/** Callback dispatcher of a session (TRDP_PROCESS_CONFIG_T.cbWorkers)
+ *  Each strand is queued to its home worker (strand % workerCnt), an idle worker steals strands queued last from
+ *  the busy ones. The dispatcher mutex only guards the queues, callbacks run without any lock.  */
+typedef struct TRDP_CB_DISPATCH
+{
+    struct TRDP_SESSION *pSession;              /**< session the callbacks are called for                   */
+    VOS_MUTEX_T         mutex;                  /**< guards strands and run queues                          */
+    volatile BOOL8      run;                    /**< cleared to stop the workers once the queues are empty  */
+    BOOL8               dropping;               /**< PD callbacks are dropped, the queue is full            */
+    UINT32              queued;                 /**< no. of callbacks waiting                               */
+    UINT32              dropped;                /**< no. of PD callbacks dropped                            */
+    UINT32              workerCnt;              /**< no. of worker threads                                  */
+    TRDP_CB_STRAND_T    strand[TRDP_CB_STRANDS];
+    TRDP_CB_WORKER_T    worker[TRDP_CB_WORKERS_MAX];
+} TRDP_CB_DISPATCH_T;
+
+/** Delta encoding state of a publisher or subscription in the comId range of tlp_setDeltaRange.
+    A delta frame carries the runs of data differing from the last key frame, a lost delta frame does not matter */
+typedef struct
+{
+    UINT32              keySeqCnt;              /**< sequence counter of the key frame                      */
+    UINT32              keySize;                /**< data size of the key frame, 0: none yet                */
+    TRDP_IP_ADDR_T      keySrcIp;               /**< source of the key frame (subscription)                 */
+    UINT32              cnt;                    /**< delta frames sent since the key frame                  */
+    UINT8               key[TRDP_MAX_PD_DATA_SIZE]; /**< data of the key frame                              */
+    PD_PACKET_T         frame;                  /**< delta frame to send or decoded data                    */
+} PD_DELTA_T;
+
+/** Further consumer of a subscription (tlp_addConsumer), called with the frame of the subscription  */
+typedef struct TRDP_PD_CONSUMER
+{
+    struct TRDP_PD_CONSUMER *pNext;             /**< next consumer or NULL                                  */
+    const void              *pUserRef;          /**< user reference passed to the callback                  */
+    TRDP_PD_CALLBACK_T      pfCbFunction;       /**< callback of the consumer                               */
+} TRDP_PD_CONSUMER_T;
+
+/** Queue element for PD packets to send or receive
+ *  The members used by the send scheduling, the time out supervision and the lookup of received frames come first,
+ *  to keep them together in the first cache lines; statistics and application data follow.
+ */
+/** Last sent sequence counter of a publisher, listed for trdp_getSeqCnt() of the other sessions   */
+typedef struct TRDP_SEQ_PUB
+{
+    struct TRDP_SEQ_PUB *pNext;                 /**< next listed publisher                                  */
+    UINT32              comId;                  /**< comId of the publisher                                 */
+    TRDP_IP_ADDR_T      srcIpAddr;              /**< source IP of the publisher                             */
+    UINT32              seqCnt;                 /**< copy of curSeqCnt, stored without lock when sent       */
+    BOOL8               listed;                 /**< in the list of publishers                              */
+} TRDP_SEQ_PUB_T;
+
 typedef struct PD_ELE
 {
     struct PD_ELE       *pNext;                 /**< pointer to next element or NULL                        */
+    struct PD_ELE       *pNextHash;             /**< pointer to next element in same comId bucket or NULL   */
+    TRDP_TIME_T         timeToGo;               /**< next time this packet must be sent/rcv                 */
+    TRDP_TIME_T         interval;               /**< time out value for received packets or
+                                                     interval for packets to send (set from ms)             */
+    TRDP_TIME_T         txLead;                 /**< sent this time ahead with timeToGo as launch time      */
+    TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
+    TRDP_FLAGS_T        pktFlags;               /**< flags                                                  */
+    UINT8               qos;                    /**< QoS set per sent frame, 0: QoS of the socket           */
+    UINT8               prio;                   /**< priority 0..TRDP_PD_PRIO_MAX, higher ones are served first */
+    INT32               socketIdx;              /**< index into the socket list                             */
+    UINT32              redSocketIdx;           /**< second interface: socket of a publisher + 1, 0 if none */
+    TRDP_IP_ADDR_T      redIfaceAddr;           /**< second interface: own address, 0 if none               */
+    TRDP_IP_ADDR_T      redIpAddr;              /**< second interface: destination of a publisher (0: same
+                                                     as addr.destIpAddr) or source of a subscriber          */
+    UINT32              schedIdx;               /**< position in send schedule (publisher) or time out
+                                                     heap (subscriber) + 1, 0 if not scheduled              */
     UINT32              magic;                  /**< prevent acces through dangeling pointer                */
     TRDP_ADDRESSES_T    addr;                   /**< handle of publisher/subscriber                         */
+    PD_PACKET_T         *pFrame;                /**< header ... data + FCS...                               */
+    UINT32              frameSize;              /**< allocated size of pFrame (subscription)                */
+    UINT32              dataSize;               /**< net data size                                          */
+    UINT32              grossSize;              /**< complete packet size (header, data)                    */
+    UINT32              sendSize;               /**< data size sent out                                     */
+    UINT32              curSeqCnt;              /**< the last sent or received sequence counter             */
+    UINT32              curSeqCnt4Pull;         /**< the last sent sequence counter for PULL                */
+    TRDP_SEQ_PUB_T      seqPub;                 /**< curSeqCnt of a publisher for the other sessions        */
+    UINT32              frameGen;               /**< incremented each time pFrame is replaced on receive    */
+    TRDP_PD_FRAME_REF_T *pFrameRef;             /**< pFrame is lent to queued callbacks, else NULL          */
+#if TRDP_PD_LAZY_FCS
+    UINT32              fcsHead;                /**< CRC register of the header with sequenceCounter 0      */
+    UINT32              fcsHeadLen;             /**< datasetLength (network order) fcsHead is valid for     */
+    UINT16              fcsHeadType;            /**< msgType (network order) fcsHead is valid for, 0: none  */
+#endif
     TRDP_IP_ADDR_T      lastSrcIP;              /**< last source IP a subscribed packet was received from   */
     TRDP_IP_ADDR_T      pullIpAddress;          /**< In case of pulling a PD this is the requested Ip       */
     UINT32              redId;                  /**< Redundancy group ID or zero                            */
-    UINT32              curSeqCnt;              /**< the last sent or received sequence counter             */
-    UINT32              curSeqCnt4Pull;         /**< the last sent sequence counter for PULL                */
-    TRDP_SEQ_CNT_LIST_T*pSeqCntList;            /**< pointer to list of received sequence numbers per comId */
+    TRDP_RED_GROUP_T    *pRedGroup;             /**< Redundancy group of redId, NULL if redId is zero       */
+    UINT32              shapeSlot;              /**< first send slot assigned by the traffic shaping        */
+    UINT32              shapePeriod;            /**< interval in send slots, 0 if not shaped                */
+    TRDP_TO_BEHAVIOR_T  toBehavior;             /**< timeout behavior for packets                           */
+    TRDP_ERR_T          lastErr;                /**< Last error (timeout)                                   */
+    TRDP_TIME_T         rxTime;                 /**< reception time of the current frame                    */
     UINT32              numRxTx;                /**< Counter for received packets (statistics)              */
     UINT32              updPkts;                /**< Counter for updated packets (statistics)               */
+    UINT32              txUpdPkts;              /**< updPkts at the last check of the data to send          */
+    UINT32              txCrc;                  /**< CRC of the data last sent (TRDP_FLAGS_PD_ON_CHANGE)    */
+    UINT16              hbCycles;               /**< send unchanged data every n-th interval, 0: default    */
+    UINT16              hbSkipped;              /**< intervals not sent since the data was last sent        */
     UINT32              getPkts;                /**< Counter for read packets (statistics)                  */
     UINT32              numMissed;              /**< Counter for skipped sequence number (statistics)       */
-    TRDP_ERR_T          lastErr;                /**< Last error (timeout)                                   */
-    TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
-    TRDP_FLAGS_T        pktFlags;               /**< flags                                                  */
-    TRDP_TIME_T         interval;               /**< time out value for received packets or
-                                                     interval for packets to send (set from ms)             */
-    TRDP_TIME_T         timeToGo;               /**< next time this packet must be sent/rcv                 */
-    TRDP_TO_BEHAVIOR_T  toBehavior;             /**< timeout behavior for packets                           */
-    UINT32              dataSize;               /**< net data size                                          */
-    UINT32              grossSize;              /**< complete packet size (header, data)                    */
-    UINT32              sendSize;               /**< data size sent out                                     */
+    UINT32              sdtIdx;                 /**< safe channel (index into pSdtChan) + 1, 0: not vital   */
+    TRDP_SEQ_CNT_LIST_T*pSeqCntList;            /**< pointer to list of received sequence numbers per comId */
     TRDP_DATASET_T      *pCachedDS;             /**< Pointer to dataset element if known                    */
-    INT32               socketIdx;              /**< index into the socket list                             */
     const void          *pUserRef;              /**< from subscribe()                                       */
     TRDP_PD_CALLBACK_T  pfCbFunction;           /**< Pointer to PD callback function                        */
-    PD_PACKET_T         *pFrame;                /**< header ... data + FCS...                               */
+    struct PD_ELE       *pNextCb;               /**< next subscription with a coalesced callback pending    */
+    UINT32              cbPending;              /**< frames received for the pending callback, 0: none      */
+    TRDP_IP_ADDR_T      cbDestIpAddr;           /**< destination IP of the newest of these frames           */
+#if TRDP_PD_RCV_THREAD
+    PD_SNAPSHOT_T       *pSnap;                 /**< latest frame for tlp_get(), TRDP_OPTION_PD_THREAD only */
+#endif
+    PD_DELTA_T          *pDelta;                /**< delta encoding state, NULL if not in the delta range   */
+    TRDP_PD_CONSUMER_T  *pConsumers;            /**< further consumers of a subscription, NULL if none      */
 } PD_ELE_T, *TRDP_PUB_PT, *TRDP_SUB_PT;
 
+/** A member of a subscription group as published at the end of a receive pass    */
+typedef struct
+{
+    TRDP_ERR_T          state;                  /**< TRDP_NO_ERR, TRDP_NODATA_ERR (nothing received yet) or
+                                                     TRDP_NOSUB_ERR (unsubscribed)                          */
+    UINT32              numRxTx;                /**< numRxTx of the subscription when the frame was copied  */
+    TRDP_IP_ADDR_T      srcIpAddr;              /**< source IP the frame was received from                  */
+    UINT32              seqCnt;                 /**< sequence counter of the frame                          */
+    UINT32              dataSize;               /**< net data size                                          */
+    TRDP_TIME_T         timeToGo;               /**< time the next frame is expected                        */
+    TRDP_TIME_T         rxTime;                 /**< reception time of the frame                            */
+    PD_PACKET_T         frame;                  /**< copy of header and data                                */
+} PD_GROUP_ENTRY_T;
+
+/** Member of a subscription group. Apart from pSub and numRxTx nothing changes after the group was created, the
+    readers of the group do not touch the subscription itself */
+typedef struct
+{
+    PD_ELE_T            *pSub;                  /**< the subscription, NULL once unsubscribed               */
+    UINT32              numRxTx;                /**< numRxTx of the subscription at the last publication    */
+    TRDP_SUB_T          subHandle;              /**< handle of the subscription, items are matched by it    */
+    UINT32              comId;                  /**< comId of the subscription                              */
+    TRDP_IP_ADDR_T      destIpAddr;             /**< destination IP of the subscription                     */
+    BOOL8               cyclic;                 /**< time out supervised (interval set)                     */
+    TRDP_FLAGS_T        pktFlags;               /**< flags of the subscription                              */
+    TRDP_TO_BEHAVIOR_T  toBehavior;             /**< timeout behavior of the subscription                   */
+    const void          *pUserRef;              /**< from subscribe()                                       */
+    TRDP_DATASET_T      *pCachedDS;             /**< dataset cache of the unmarshaller                      */
+} PD_GROUP_MEMBER_T;
+
+/** Subscription group: the latest frames of its members taken at the end of the same receive pass, double
+    buffered and guarded by sequence numbers (seqlock) like the snapshots of TRDP_OPTION_PD_THREAD  */
+typedef struct PD_SUB_GROUP
+{
+    struct PD_SUB_GROUP *pNext;                 /**< next group of the session                              */
+    UINT32              magic;                  /**< TRDP_MAGIC_GROUP_HNDL_VALUE while the group exists     */
+    UINT32              numSubs;                /**< number of members                                      */
+    BOOL8               changed;                /**< a member was unsubscribed, publish with the next pass  */
+    PD_GROUP_MEMBER_T   *pMembers;              /**< the members                                            */
+    UINT32              version;                /**< number of publications, pBuffer[version & 1] is current */
+    UINT32              seq[2];                 /**< odd while pBuffer[i] is written                        */
+    PD_GROUP_ENTRY_T    *pBuffer[2];            /**< numSubs entries each                                   */
+} PD_SUB_GROUP_T;
+
+/** State of a safe channel (SDT), kept in an array of the session to check many vital subscriptions without
+    allocating or chasing pointers per frame */
+typedef struct
+{
+    PD_ELE_T            *pSub;                  /**< the vital subscription                                 */
+    UINT32              sid1;                   /**< SC-32 seed (SID) of smi1                               */
+    UINT32              sid2;                   /**< SC-32 seed of smi2, 0: not used                        */
+    UINT32              txPeriod;               /**< source cycle in ms, 0: no latency supervision          */
+    UINT32              safeTime;               /**< nrxSafe sink cycles in ms, 0: no time supervision      */
+    UINT32              cmThr;                  /**< channel monitoring threshold, 0: not monitored         */
+    UINT32              cmCount;                /**< errors minus valid frames since the last reset         */
+    UINT16              udv;                    /**< expected user data version                             */
+    TRDP_TIME_T         freshTime;              /**< reception time of the last fresh valid frame           */
+    TRDP_TIME_T         freshDue;               /**< fresh data expected until then (nrxSafe, nGuard)       */
+    TRDP_SDT_STATUS_T   status;                 /**< state and counters for tlp_getSdtStatus()              */
+} TRDP_SDT_CHAN_T;
+
+/** Entry of the send schedule and the time out heap, the due time is copied to compare without touching the element */
+typedef struct
+{
+    TRDP_TIME_T         due;                    /**< send time (timeToGo - txLead) or time out              */
+    UINT32              immediate;              /**< != 0: sending was requested, due before cyclic entries */
+    PD_ELE_T            *pElement;              /**< the publisher or subscription                          */
+} TRDP_PD_SCHED_T;
+
+/** PD frame read from a shared socket for another session, queued while that session was busy */
+typedef struct TRDP_SHARE_FRAME
+{
+    struct TRDP_SHARE_FRAME *pNext;             /**< next queued frame                                      */
+    UINT32              size;                   /**< size of the frame                                      */
+    TRDP_IP_ADDR_T      srcIpAddr;              /**< source IP of the frame                                 */
+    TRDP_IP_ADDR_T      destIpAddr;             /**< destination IP of the frame                            */
+    TRDP_TIME_T         rxTime;                 /**< reception time                                         */
+    UINT8               data[TRDP_MAX_PD_PACKET_SIZE];  /**< the frame, allocated to its size               */
+} TRDP_SHARE_FRAME_T;
+
+/** Outstanding PD pull request, in its bucket of the pull index and in the list ordered by deadline */
+typedef struct TRDP_PD_PULL
+{
+    struct TRDP_PD_PULL *pNextHash;             /**< next request in the same bucket                        */
+    struct TRDP_PD_PULL *pPrev;                 /**< request with the previous deadline                     */
+    struct TRDP_PD_PULL *pNext;                 /**< request with the next deadline                         */
+    UINT32              replyComId;             /**< comId of the expected reply                            */
+    TRDP_IP_ADDR_T      replierIpAddr;          /**< pulled device, 0: any (multicast request)              */
+    PD_ELE_T            *pSub;                  /**< subscription receiving the reply                       */
+    TRDP_TIME_T         deadline;               /**< request is dropped from the index then                 */
+} TRDP_PD_PULL_T;
+
+/** Send slot usage of the traffic shaping over one hyper-period */
+typedef struct
+{
+    UINT32              slotTime;               /**< slot duration in us                                    */
+    UINT32              slotCnt;                /**< number of slots of the hyper-period                    */
+    UINT32              numPub;                 /**< number of publishers placed into the slots             */
+    UINT32              peakLoad;               /**< max. bytes of one slot                                 */
+    UINT64              totalLoad;              /**< bytes sent per hyper-period                            */
+    TRDP_TIME_T         base;                   /**< start time of slot 0                                   */
+    UINT32              *pLoad;                 /**< bytes sent per slot                                    */
+} TRDP_PD_SHAPING_T;
+
+#if TRDP_PD_SRC_TABLE
+/** Source IPs of one comId from firstIp up to the firstIp of the next segment, which match the same subscriptions */
+typedef struct
+{
+    UINT32              comId;                  /**< comId of the segment                                   */
+    TRDP_IP_ADDR_T      firstIp;                /**< first source IP of the segment                         */
+    UINT32              subIdx;                 /**< first matching subscription in TRDP_SRC_TABLE_T.ppSub  */
+    UINT32              subCnt;                 /**< number of matching subscriptions, 0: none              */
+} TRDP_SRC_SEG_T;
+
+/** Subscriptions by comId and source IP, sorted by comId and first source IP   */
+typedef struct
+{
+    BOOL8               valid;                  /**< FALSE: rebuild from the receive queue before use       */
+    UINT32              segCnt;                 /**< number of segments                                     */
+    TRDP_SRC_SEG_T      *pSeg;                  /**< the segments                                           */
+    struct PD_ELE       **ppSub;                /**< matching subscriptions of the segments in queue order  */
+} TRDP_SRC_TABLE_T;
+#endif
+
 #if MD_SUPPORT
 /** Queue element for MD listeners (UDP and TCP)   */
 typedef struct MD_LIS_ELE
 {
     struct MD_LIS_ELE   *pNext;                 /**< pointer to next element or NULL                        */
+    struct MD_LIS_ELE   *pNextHash;             /**< pointer to next element in same comId bucket           */
+    UINT32              order;                  /**< insertion number, the newest listener is matched first */
     TRDP_ADDRESSES_T    addr;                   /**< addressing values                                      */
     TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
     TRDP_FLAGS_T        pktFlags;               /**< flags                                                  */
     const void          *pUserRef;              /**< user reference for call_back                           */
     TRDP_URI_USER_T     srcURI;
     TRDP_URI_USER_T     destURI;
+    UINT32              srcUriHash;             /**< trdp_uriHash() of srcURI                               */
+    UINT32              destUriHash;            /**< trdp_uriHash() of destURI                              */
     INT32               socketIdx;              /**< index into the socket list                             */
     TRDP_MD_CALLBACK_T  pfCbFunction;           /**< Pointer to MD callback function                        */
     UINT32              numSessions;            /**< Number of received packets of all sessions             */
@@ -281,10 +1027,24 @@ typedef struct TRDP_MD_TCP
     BOOL8   msgUncomplete;                      /**< The receive message is uncomplete                      */
 } TRDP_MD_TCP_T;
 
+/** Replies collected for a request sent with TRDP_FLAGS_MD_COLLECT   */
+typedef struct
+{
+    TRDP_MD_REPLY_T     *pReplies;              /**< replies received so far                                */
+    UINT32              numReplies;             /**< number of entries used in pReplies                     */
+    UINT32              maxReplies;             /**< number of entries allocated for pReplies               */
+    UINT8               *pData;                 /**< data of all replies, one after the other               */
+    UINT32              dataSize;               /**< bytes used in pData                                    */
+    UINT32              maxDataSize;            /**< bytes allocated for pData                              */
+} MD_COLLECT_T;
+
 /** Session queue element for MD (UDP and TCP)  */
 typedef struct MD_ELE
 {
     struct MD_ELE       *pNext;                 /**< pointer to next element or NULL                        */
+    struct MD_ELE       *pNextHash;             /**< pointer to next element in same session ID bucket      */
+    struct MD_ELE       *pNextDue;              /**< pointer to next element with expired timeout           */
+    UINT32              schedIdx;               /**< position in timeout schedule + 1, 0 if not scheduled   */
     TRDP_ADDRESSES_T    addr;                   /**< handle of publisher/subscriber                         */
     UINT32              curSeqCnt;              /**< the last sent or received sequence counter             */
     TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
@@ -314,15 +1074,58 @@ typedef struct MD_ELE
     TRDP_URI_USER_T     srcURI;                 /**< incoming MD source URI for reply                       */
     TRDP_MD_TCP_T       tcpParameters;          /**< Tcp connection parameters                              */
     TRDP_MD_CALLBACK_T  pfCbFunction;           /**< Pointer to MD callback function                        */
+#if TRDP_TIMING_STATS
+    TRDP_TIME_T         sendTime;               /**< time the request was sent (TRDP_OPTION_TIMING_STATS)   */
+    TRDP_TIME_T         firstSendTime;          /**< time the request was sent before any retry             */
+#endif
     MD_PACKET_T         *pPacket;               /**< Packet header in network byte order                    */
                                                 /**< data ready to be sent (with CRCs)                      */
+    const UINT8         *pUserData;             /**< user buffer sent in place of pPacket->data
+                                                     (TRDP_FLAGS_TCP_NOCOPY), NULL if copied or sent        */
+    UINT32              queuedSize;             /**< bytes counted in the send queue of the TCP connection  */
+    MD_COLLECT_T        *pCollect;              /**< replies collected (TRDP_FLAGS_MD_COLLECT), NULL if none*/
+    BOOL8               poolPacket;             /**< pPacket is a frame of the MD frame pool                */
 } MD_ELE_T;
 
+#if MD_SUPPORT && (TRDP_MD_STREAM_CHUNK_SIZE > 0)
+/** TCP MD notification being handed to a listener in chunks (TRDP_FLAGS_TCP_STREAM)   */
+typedef struct
+{
+    SOCKET              sock;                   /**< TCP connection the message is read from                */
+    MD_HEADER_T         frameHead;              /**< header of the message in network byte order            */
+    TRDP_IP_ADDR_T      srcIpAddr;              /**< sender of the message                                  */
+    const void          *pUserRef;              /**< user reference of the listener                         */
+    TRDP_MD_CALLBACK_T  pfCbFunction;           /**< callback function of the listener                      */
+    UINT32              offset;                 /**< message data handed over so far                        */
+    UINT32              remaining;              /**< bytes (data and padding) still to read                 */
+    UINT8               chunk[TRDP_MD_STREAM_CHUNK_SIZE];   /**< receive buffer for one chunk               */
+} MD_STREAM_T;
+#endif
+
+#if MD_SUPPORT && (TRDP_MD_UDP_SEG_SIZE > 0)
+#define TRDP_MD_UDP_SEG_BUF_SIZE    65507u      /**< largest UDP payload                                    */
+
+/** UDP MD datagrams sent and received in segments (TRDP_OPTION_MD_UDP_SEGMENT)   */
+typedef struct
+{
+    SOCKET              sock;                   /**< socket the coalesced datagrams were read from          */
+    UINT32              size;                   /**< bytes in rxBuf                                         */
+    UINT32              offset;                 /**< start of the next datagram in rxBuf                    */
+    UINT32              segSize;                /**< size of one datagram in rxBuf                          */
+    TRDP_IP_ADDR_T      srcIpAddr;              /**< sender of the datagrams                                */
+    TRDP_IP_ADDR_T      destIpAddr;             /**< destination of the datagrams                           */
+    UINT16              srcPort;                /**< source port of the datagrams                           */
+    UINT8               rxBuf[TRDP_MD_UDP_SEG_BUF_SIZE];    /**< datagrams coalesced by the kernel          */
+    UINT8               txBuf[TRDP_MD_UDP_SEG_BUF_SIZE];    /**< notifications gathered for one send        */
+} MD_UDP_SEG_T;
+#endif
+
 /**    TCP file descriptor parameters   */
 typedef struct
 {
     SOCKET	listen_sd;          /**< TCP general socket listening connection requests   */
     SOCKET  max_sd;             /**< Maximum socket number in the file descriptor   */
+    SOCKET  polled_sd;          /**< Listening socket registered in the poll set    */
     /* fd_set  master_set;         / **< Local file descriptor   * / */
 } TRDP_TCP_FD_T;
 #endif
@@ -333,7 +1136,11 @@ struct TAU_TTDB;
 typedef struct TRDP_SESSION
 {
     struct TRDP_SESSION     *pNext;             /**< Pointer to next session                                */
+    UINT32                  magic;              /**< TRDP_MAGIC_SESSION_VALUE while the session is open     */
     VOS_MUTEX_T             mutex;              /**< protect this session                                   */
+    VOS_MUTEX_T             sndMutex;           /**< protect the PD send side (send queue, schedule), taken
+                                                     after mutex, alone by tlc_processSend                  */
+    BOOL8                   sndOnly;            /**< TRUE within tlc_processSend (sndMutex only held)       */
     TRDP_IP_ADDR_T          realIP;             /**< Real IP address                                        */
     TRDP_IP_ADDR_T          virtualIP;          /**< Virtual IP address                                     */
     UINT32                  etbTopoCnt;         /**< current valid topocount or zero                        */
@@ -342,24 +1149,152 @@ typedef struct TRDP_SESSION
     TRDP_PRINT_DBG_T        pPrintDebugString;  /**< Pointer to function to print debug information         */
     TRDP_MARSHALL_CONFIG_T  marshall;           /**< Marshalling(unMarshalling configuration                */
     TRDP_PD_CONFIG_T        pdDefault;          /**< Default configuration for process data                 */
+    UINT32                  deltaFirstComId;    /**< first comId sent delta encoded, 0: none                */
+    UINT32                  deltaLastComId;     /**< last comId sent delta encoded                          */
+    UINT32                  deltaKeyCycles;     /**< every n-th frame of the delta range is a key frame     */
+    UINT32                  redRcvCnt;          /**< subscriptions receiving on a second interface          */
     TRDP_MEM_CONFIG_T       memConfig;          /**< Internal memory handling configuration                 */
     TRDP_OPTION_T           option;             /**< Stack behavior options                                 */
+    UINT32                  busyPollBudget;     /**< Spin time of TRDP_OPTION_BUSY_POLL in us               */
+    UINT32                  budgetFrames;       /**< Max. frames received per tlc_process(), 0: unlimited    */
+    UINT32                  budgetTime;         /**< Max. receive time per tlc_process() in us, 0: unlimited */
+    UINT32                  budgetLeft;         /**< Frames left to receive in the current call             */
+    TRDP_TIME_T             budgetEnd;          /**< End of the receive time of the current call            */
+    BOOL8                   budgetArmed;        /**< A work budgeted call is running                        */
+    BOOL8                   backlog;            /**< Last call left frames unread, next interval is zero    */
     TRDP_SOCKETS_T          iface[VOS_MAX_SOCKET_CNT];  /**< Collection of sockets to use                   */
     PD_ELE_T                *pSndQueue;         /**< pointer to first element of send queue                 */
     PD_ELE_T                *pRcvQueue;         /**< pointer to first element of rcv queue                  */
+    PD_ELE_T                *pCbPending;        /**< subscriptions with a coalesced callback pending        */
+    PD_SUB_GROUP_T          *pSubGroups;        /**< subscription groups (tlp_createSubGroup)               */
+    TRDP_RED_GROUP_T        *pRedGroups;        /**< redundancy groups of the publishers                    */
+#if TRDP_PD_SUB_HASH_SIZE > 0
+    PD_ELE_T                *pRcvHash[TRDP_PD_SUB_HASH_SIZE];   /**< rcv queue elements indexed by comId    */
+#endif
+#if TRDP_PD_SRC_TABLE
+    TRDP_SRC_TABLE_T        srcTable;           /**< subscriptions by comId and source IP                   */
+#endif
+#if TRDP_PD_PUB_HASH_SIZE > 0
+    PD_ELE_T                *pSndHash[TRDP_PD_PUB_HASH_SIZE];   /**< send queue elements indexed by comId   */
+#endif
+#if TRDP_PD_SEND_SCHEDULER
+    TRDP_PD_SCHED_T         *pSndSched[TRDP_PD_PRIO_CLASSES];   /**< send queue elements of each priority class
+                                                                     as min-heap ordered by due time        */
+    UINT32                  sndSchedCnt[TRDP_PD_PRIO_CLASSES];  /**< number of elements in the schedules    */
+    UINT32                  sndSchedSize[TRDP_PD_PRIO_CLASSES]; /**< allocated entries of the schedules     */
+#endif
+#if TRDP_PD_TIMEOUT_TABLE
+    TRDP_PD_SCHED_T         *pRcvTimeouts;      /**< supervised subscriptions as min-heap ordered by time out */
+    UINT32                  rcvTimeoutCnt;      /**< number of entries in the time out heap                 */
+    UINT32                  rcvTimeoutSize;     /**< allocated entries of the time out heap                 */
+#endif
+#if TRDP_PD_PULL_HASH_SIZE > 0
+    TRDP_PD_PULL_T          *pPullHash[TRDP_PD_PULL_HASH_SIZE]; /**< outstanding pull requests by reply   */
+    TRDP_PD_PULL_T          *pPullFirst;        /**< outstanding pull request with the earliest deadline    */
+    TRDP_PD_PULL_T          *pPullLast;         /**< outstanding pull request with the latest deadline      */
+    UINT32                  pullCnt;            /**< number of outstanding pull requests                    */
+    UINT32                  pullMax;            /**< max. outstanding pull requests, 0: no limit            */
+    UINT32                  pullExpired;        /**< pull requests dropped unanswered                       */
+#endif
+    UINT32                  shareCnt;           /**< PD receive sockets shared with other sessions          */
+    UINT32                  shareBusy;          /**< reading frames, frames of other sessions are queued
+                                                     (both protected by the lock of the socket registry)    */
+    TRDP_SHARE_FRAME_T      *pShareFirst;       /**< frames read for us by other sessions, oldest first     */
+    TRDP_SHARE_FRAME_T      *pShareLast;        /**< last frame queued                                      */
+    UINT32                  shareQueued;        /**< number of frames queued                                */
+    UINT32                  shareDropped;       /**< frames dropped, queue full                             */
+    TRDP_SDT_CHAN_T         *pSdtChan;          /**< safe channels of the vital subscriptions               */
+    UINT32                  sdtChanCnt;         /**< number of safe channels                                */
+    UINT32                  sdtChanSize;        /**< allocated entries of pSdtChan                          */
+    TRDP_PD_SHAPING_T       shaping;            /**< send slots of TRDP_OPTION_TRAFFIC_SHAPING              */
+    BOOL8                   pdBatch;            /**< tlp_publish/subscribeBatch running, shaping and socket
+                                                     filters are updated at its end                           */
     PD_PACKET_T             *pNewFrame;         /**< pointer to received PD frame                           */
+#if TRDP_PD_RCV_BATCH_SIZE > 1
+    PD_PACKET_T             *pRcvBatch[TRDP_PD_RCV_BATCH_SIZE];  /**< preallocated frames for batched receive */
+#endif
+#if TRDP_PD_SND_BATCH_SIZE > 1
+    PD_ELE_T                *pSndBatch[TRDP_PD_SND_BATCH_SIZE];  /**< due publishers waiting to be sent     */
+    UINT32                  sndBatchCnt;        /**< number of entries in pSndBatch                         */
+#endif
+    VOS_POLL_T              pollSet;            /**< poll set of tlc_processEvents(), created on first use  */
+    VOS_XDP_T               pdXdp;              /**< AF_XDP socket of tlp_openXdp(), NULL if not used       */
+    SOCKET                  pdXdpSock;          /**< descriptor of pdXdp                                    */
+    BOOL8                   pdXdpPolled;        /**< pdXdpSock is part of the poll set                      */
+#if TRDP_PD_URING
+    VOS_URING_T             pdUring;            /**< io_uring of the PD sockets, NULL until the first use   */
+    SOCKET                  pdUringFd;          /**< descriptor of pdUring                                  */
+    BOOL8                   pdUringPolled;      /**< pdUringFd is part of the poll set                      */
+    BOOL8                   pdUringFailed;      /**< pdUring could not be opened, sockets are read directly */
+#endif
+#if TRDP_PD_RCV_THREAD
+    VOS_THREAD_T            pdRcvThread;        /**< PD receive thread (TRDP_OPTION_PD_THREAD)              */
+    VOS_SEMA_T              pdRcvDone;          /**< given by the receive thread when it terminates         */
+    volatile BOOL8          pdRcvRun;           /**< cleared to stop the receive thread                     */
+    UINT32                  pdShardCnt;         /**< no. of PD receive threads with own sockets, 0: one     */
+    PD_RCV_SHARD_T          *pPdShards;         /**< the receive threads if pdShardCnt > 1, else NULL        */
+#endif
+    UINT32                  cbWorkerCnt;        /**< no. of callback worker threads, 0: callbacks in place  */
+    TRDP_CB_DISPATCH_T      *pCbDispatch;       /**< callback dispatcher if cbWorkerCnt > 0, else NULL      */
     TRDP_TIME_T             initTime;           /**< initialization time of session                         */
     TRDP_STATISTICS_T       stats;              /**< statistics of this session                             */
+    TRDP_STATS_BLOCK_T      statsBlock[TRDP_STATS_BLOCKS];  /**< event counters, summed into stats on read  */
+    struct VOS_SHRD         *pExportShm;        /**< shared memory of the statistics export                 */
+    UINT8                   *pExport;           /**< statistics export area, NULL if not exported           */
+    TRDP_TIME_T             exportInterval;     /**< interval of the statistics export                      */
+    TRDP_TIME_T             nextExport;         /**< time of the next statistics export                     */
+#if TRDP_RECORDER
+    struct TRDP_REC         *pRecorder;         /**< telegram recorder (tlc_record), NULL if not recording  */
+#endif
+#if TRDP_TIMING_STATS
+    TRDP_TIMING_STATISTICS_T timing;            /**< timing statistics (TRDP_OPTION_TIMING_STATS)           */
+    UINT64                  timingSum[TRDP_TIMING_CNT];  /**< sum of the samples in ns for the mean         */
+#endif
+    TRDP_TIME_T             pdRcvTime;          /**< reception time of the PD frame being handled           */
+#if TRDP_PROCESS_TIME_CACHE
+    TRDP_TIME_T             processTime;        /**< time read at the start of tlc_process                  */
+    BOOL8                   processTimeValid;   /**< TRUE while processTime is valid                        */
+#endif
 #if MD_SUPPORT
     struct TAU_TTDB         *pTTDB;             /**< session related TTDB data                              */
     void                    *pUser;             /**< space for higher layer data                            */
     TRDP_TCP_FD_T           tcpFd;              /**< TCP file descriptor parameters                         */
     TRDP_MD_CONFIG_T        mdDefault;          /**< Default configuration for message data                 */
+    TRDP_TCP_CONN_STATISTICS_T tcpConnStats;    /**< usage of the TCP caller connections                    */
     MD_LIS_ELE_T            *pMDListenQueue;    /**< pointer to first element of listeners queue            */
     MD_ELE_T                *pMDSndQueue;       /**< pointer to first element of send MD queue (caller)     */
     MD_ELE_T                *pMDRcvQueue;       /**< pointer to first element of recv MD queue (replier)    */
+    UINT32                  numMDRcvSessions;   /**< number of elements in the recv MD queue                */
+#if TRDP_MD_LISTENER_HASH_SIZE > 0
+    MD_LIS_ELE_T            *pMDListenHash[TRDP_MD_LISTENER_HASH_SIZE]; /**< comId filtering listeners by comId */
+    MD_LIS_ELE_T            *pMDListenAny;      /**< listeners for any comId (tlm_addListener without comId)  */
+    UINT32                  mdListenOrder;      /**< insertion number of the newest listener                */
+#endif
+#if TRDP_MD_TIMEOUT_SCHEDULER
+    MD_ELE_T                **pMDSched;         /**< MD queue elements as min-heap ordered by timeToGo      */
+    UINT32                  mdSchedCnt;         /**< number of elements in the timeout schedule             */
+    UINT32                  mdSchedSize;        /**< allocated entries of the timeout schedule              */
+    BOOL8                   mdSchedIncomplete;  /**< some elements could not be scheduled (out of memory)   */
+#endif
+#if TRDP_MD_SESSION_HASH_SIZE > 0
+    MD_ELE_T                *pMDSndHash[TRDP_MD_SESSION_HASH_SIZE]; /**< send MD queue indexed by session ID */
+    MD_ELE_T                *pMDRcvHash[TRDP_MD_SESSION_HASH_SIZE]; /**< recv MD queue indexed by session ID */
+#endif
     MD_ELE_T                *pMDRcvEle;         /**< pointer to received MD element                         */
+#if TRDP_MD_FAST_UUID
+    UINT8                   mdUuidPrefix[8];    /**< random first half of the session IDs of this session   */
+    UINT64                  mdUuidCount;        /**< number of session IDs created, 0: prefix not yet set   */
+#endif
+    MD_ELE_T                *pMDElePool;        /**< free MD elements kept for reuse, linked by pNext       */
+    void                    *pMDFramePool;      /**< free MD frames kept for reuse, linked by their first word */
+    TRDP_MD_POOL_STATISTICS_T mdPoolStats;      /**< usage of the MD element and frame pool                 */
     MD_ELE_T                *uncompletedTCP[VOS_MAX_SOCKET_CNT];     /**< uncompleted TCP messages buffer   */
+#if TRDP_MD_STREAM_CHUNK_SIZE > 0
+    MD_STREAM_T             *pMDStream[VOS_MAX_SOCKET_CNT];          /**< streamed TCP notifications        */
+#endif
+#if TRDP_MD_UDP_SEG_SIZE > 0
+    MD_UDP_SEG_T            *pMDUdpSeg;         /**< segment buffers (TRDP_OPTION_MD_UDP_SEGMENT), on demand */
+#endif
 #endif
 } TRDP_SESSION_T, *TRDP_SESSION_PT;
 
@@ -0,0 +1,678 @@
+/******************************************************************************/
+/**
+ * @file            trdp_rec.c
+ *
+ * @brief           Black-box recorder of the PD and MD telegrams of a session
+ *
+ * @details         The telegrams sent and received by a session are appended to a ring in a shared memory area
+ *                  (memory-mapped file), each with time stamp, addresses and the frame, up to the snap length.
+ *                  Appending a record needs no system call. When the ring is full, the oldest records are
+ *                  overwritten, so the ring holds the traffic of the last minutes, depending on its size.
+ *                  The area stays in place if the process terminates abnormally. tlc_saveRecording() writes the
+ *                  records as pcapng file, from this or another process, while recording or afterwards.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "trdp_rec.h"
+#include "trdp_if_light.h"
+#include "trdp_if.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+#include "vos_shared_mem.h"
+
+#if TRDP_RECORDER
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TRDP_REC_MAGIC          0x54525243u     /* "TRRC" */
+#define TRDP_REC_VERSION        1u
+#define TRDP_REC_DEFAULT_SIZE   (4u * 1024u * 1024u)    /* default ring size                        */
+#define TRDP_REC_MIN_SIZE       (64u * 1024u)           /* smallest ring                            */
+#define TRDP_REC_ALIGN          8u                      /* alignment of the records in the ring     */
+#define TRDP_REC_RETRIES        100u                    /* tries to read a consistent ring state    */
+
+#define REC_ALIGNED(size)       (((size) + TRDP_REC_ALIGN - 1u) & ~(TRDP_REC_ALIGN - 1u))
+
+/*  The ring is read by other processes, a sequence number odd while the ring state changes guards it  */
+#ifdef __GNUC__
+#define REC_LOAD(pVal)          __atomic_load_n((pVal), __ATOMIC_ACQUIRE)
+#define REC_STORE(pVal, val)    __atomic_store_n((pVal), (val), __ATOMIC_RELEASE)
+#define REC_FENCE()             __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#else
+#define REC_LOAD(pVal)          (*(volatile UINT32 *)(pVal))
+#define REC_STORE(pVal, val)    (*(volatile UINT32 *)(pVal) = (val))
+#define REC_FENCE()
+#endif
+
+/*  pcapng block types, raw IPv4 link type and the header sizes of the synthesized datagrams    */
+#define PCAPNG_SHB              0x0A0D0D0Au
+#define PCAPNG_IDB              0x00000001u
+#define PCAPNG_EPB              0x00000006u
+#define PCAPNG_BOM              0x1A2B3C4Du
+#define LINKTYPE_RAW            101u
+#define REC_IP_UDP_SIZE         28u
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Header of the recorder area, the ring follows */
+typedef struct
+{
+    UINT32  magic;                  /**< TRDP_REC_MAGIC                                 */
+    UINT32  version;                /**< TRDP_REC_VERSION                               */
+    UINT32  ringSize;               /**< size of the ring                               */
+    UINT32  snapLen;                /**< max. bytes of a telegram recorded              */
+    UINT32  seq;                    /**< odd while the ring state below changes         */
+    UINT32  head;                   /**< offset of the next record                      */
+    UINT32  tail;                   /**< offset of the oldest record                    */
+    UINT32  used;                   /**< bytes between tail and head                    */
+    UINT32  nextRecNo;              /**< number of the next record                      */
+    UINT32  tailRecNo;              /**< number of the oldest record                    */
+    UINT32  ownIpAddr;              /**< IP address of the session                      */
+    UINT32  wallSec;                /**< wall clock (s since 1970) at ...               */
+    UINT32  monoSec;                /**< ... this time of vos_getTime()                 */
+    UINT32  monoUsec;
+    UINT32  reserved[2];
+} TRDP_REC_HEAD_T;
+
+/** A record in the ring, followed by capLen bytes of the frame. A record never wraps; space at the end of the ring
+    too short for a record header is skipped, longer space is filled by a TRDP_REC_PAD record */
+typedef struct
+{
+    UINT32  len;                    /**< length of the record incl. padding             */
+    UINT32  recNo;                  /**< number of the record                           */
+    UINT8   kind;                   /**< TRDP_REC_KIND_T                                */
+    UINT8   reserved;
+    UINT16  port;                   /**< UDP/TCP port                                   */
+    UINT32  srcIpAddr;              /**< source IP address                              */
+    UINT32  destIpAddr;             /**< destination IP address                         */
+    UINT32  sec;                    /**< vos_getTime() of the record                    */
+    UINT32  usec;
+    UINT32  origLen;                /**< size of the telegram                           */
+    UINT32  capLen;                 /**< bytes of the telegram recorded                 */
+} TRDP_REC_ENTRY_T;
+
+/** Recorder of a session */
+typedef struct TRDP_REC
+{
+    VOS_MUTEX_T     mutex;          /**< serializes send and receive side               */
+    VOS_SHRD_T      shm;            /**< shared memory of the area                      */
+    UINT8           *pArea;         /**< the area                                       */
+    TRDP_REC_HEAD_T *pHead;         /**< header of the area                             */
+    UINT8           *pRing;         /**< the ring                                       */
+} TRDP_REC_T;
+
+/******************************************************************************
+ *   Locals
+ */
+
+/******************************************************************************/
+/** Drop the oldest records until size bytes are free
+ *  Called with the sequence odd.
+ *
+ *  @param[in]      pRec            the recorder
+ *  @param[in]      size            bytes needed
+ */
+static void trdp_recReclaim (
+    TRDP_REC_T  *pRec,
+    UINT32      size)
+{
+    TRDP_REC_HEAD_T *pHead = pRec->pHead;
+
+    while (pHead->used + size > pHead->ringSize)
+    {
+        UINT32 len = pHead->ringSize - pHead->tail;
+
+        if (len >= sizeof(TRDP_REC_ENTRY_T))
+        {
+            const TRDP_REC_ENTRY_T *pEntry = (const TRDP_REC_ENTRY_T *) (pRec->pRing + pHead->tail);
+
+            len = pEntry->len;
+            pHead->tailRecNo++;
+        }
+        pHead->used -= len;
+        pHead->tail += len;
+        if (pHead->tail >= pHead->ringSize)
+        {
+            pHead->tail = 0u;
+        }
+    }
+}
+
+/******************************************************************************/
+/** Read a consistent copy of the ring state, written meanwhile by the session
+ *
+ *  @param[in]      pHead           header of the area
+ *  @param[out]     pState          copy of the header
+ *
+ *  @retval         TRUE            consistent copy read
+ */
+static BOOL8 trdp_recState (
+    const TRDP_REC_HEAD_T   *pHead,
+    TRDP_REC_HEAD_T         *pState)
+{
+    UINT32  seq;
+    UINT32  retry;
+
+    for (retry = 0u; retry < TRDP_REC_RETRIES; retry++)
+    {
+        seq = REC_LOAD(&pHead->seq);
+        if ((seq & 1u) == 0u)
+        {
+            memcpy(pState, pHead, sizeof(TRDP_REC_HEAD_T));
+            REC_FENCE();
+            if (REC_LOAD(&pHead->seq) == seq)
+            {
+                return TRUE;
+            }
+        }
+        (void) vos_threadDelay(1000u);
+    }
+    return FALSE;
+}
+
+/******************************************************************************/
+/** Write a 32 bit word of the pcapng file in host order
+ *
+ *  @param[in]      fp              the file
+ *  @param[in]      value           the word
+ *
+ *  @retval         TRUE            written
+ */
+static BOOL8 trdp_recPut32 (
+    FILE    *fp,
+    UINT32  value)
+{
+    return fwrite(&value, sizeof(value), 1u, fp) == 1u;
+}
+
+/******************************************************************************/
+/** Write a record as pcapng Enhanced Packet Block
+ *  The frame is wrapped in IPv4 and UDP headers, TCP MD telegrams become UDP datagrams as well.
+ *
+ *  @param[in]      fp              the file
+ *  @param[in]      pHead           header of the area
+ *  @param[in]      pEntry          the record
+ *  @param[in]      pFrame          the recorded bytes of the frame
+ *
+ *  @retval         TRUE            written
+ */
+static BOOL8 trdp_recPutPacket (
+    FILE                    *fp,
+    const TRDP_REC_HEAD_T   *pHead,
+    const TRDP_REC_ENTRY_T  *pEntry,
+    const UINT8             *pFrame)
+{
+    static const UINT8  cPad[4] = {0u, 0u, 0u, 0u};
+    UINT8               hdr[REC_IP_UDP_SIZE];
+    UINT32              capLen  = REC_IP_UDP_SIZE + pEntry->capLen;
+    UINT32              origLen = REC_IP_UDP_SIZE + pEntry->origLen;
+    UINT32              padLen  = (4u - (capLen & 3u)) & 3u;
+    UINT32              blockLen = 32u + capLen + padLen;
+    UINT64              stamp;
+    UINT32              sum = 0u;
+    UINT32              i;
+
+    /*  Wall clock time in us    */
+    stamp = ((UINT64) pHead->wallSec + pEntry->sec - pHead->monoSec) * 1000000u + pEntry->usec;
+    stamp -= pHead->monoUsec;
+
+    memset(hdr, 0, sizeof(hdr));
+    hdr[0]  = 0x45u;                                /* IPv4, 20 bytes header        */
+    hdr[2]  = (UINT8) ((origLen >> 8u) & 0xFFu);
+    hdr[3]  = (UINT8) (origLen & 0xFFu);
+    hdr[6]  = 0x40u;                                /* don't fragment               */
+    hdr[8]  = 64u;                                  /* TTL                          */
+    hdr[9]  = 17u;                                  /* UDP                          */
+    for (i = 0u; i < 4u; i++)
+    {
+        hdr[12u + i]    = (UINT8) (pEntry->srcIpAddr >> (24u - 8u * i));
+        hdr[16u + i]    = (UINT8) (pEntry->destIpAddr >> (24u - 8u * i));
+    }
+    for (i = 0u; i < 20u; i += 2u)
+    {
+        sum += ((UINT32) hdr[i] << 8u) | hdr[i + 1u];
+    }
+    sum     = (sum & 0xFFFFu) + (sum >> 16u);
+    sum     = ~((sum & 0xFFFFu) + (sum >> 16u));
+    hdr[10] = (UINT8) ((sum >> 8u) & 0xFFu);
+    hdr[11] = (UINT8) (sum & 0xFFu);
+    hdr[20] = hdr[22] = (UINT8) (pEntry->port >> 8u);
+    hdr[21] = hdr[23] = (UINT8) (pEntry->port & 0xFFu);
+    hdr[24] = (UINT8) (((pEntry->origLen + 8u) >> 8u) & 0xFFu);
+    hdr[25] = (UINT8) ((pEntry->origLen + 8u) & 0xFFu);
+
+    return trdp_recPut32(fp, PCAPNG_EPB) && trdp_recPut32(fp, blockLen) && trdp_recPut32(fp, 0u) &&
+           trdp_recPut32(fp, (UINT32) (stamp >> 32u)) && trdp_recPut32(fp, (UINT32) stamp) &&
+           trdp_recPut32(fp, capLen) && trdp_recPut32(fp, origLen) &&
+           (fwrite(hdr, sizeof(hdr), 1u, fp) == 1u) &&
+           ((pEntry->capLen == 0u) || (fwrite(pFrame, pEntry->capLen, 1u, fp) == 1u)) &&
+           ((padLen == 0u) || (fwrite(cPad, padLen, 1u, fp) == 1u)) &&
+           trdp_recPut32(fp, blockLen);
+}
+
+/******************************************************************************
+ *   Globals
+ */
+
+/******************************************************************************/
+/** Append a telegram to the recorder ring
+ *  The telegram is pFrame, followed by pData if the user data is sent from the user's buffer. At most snapLen bytes
+ *  are recorded.
+ *
+ *  @param[in]      pRec            the recorder of the session
+ *  @param[in]      kind            sent / received, PD / MD
+ *  @param[in]      srcIp           source IP address
+ *  @param[in]      destIp          destination IP address
+ *  @param[in]      port            UDP/TCP port
+ *  @param[in]      pFrame          the frame
+ *  @param[in]      size            size of the frame
+ *  @param[in]      pData           user data following the frame or NULL
+ *  @param[in]      dataSize        size of the user data
+ */
+void trdp_recWrite (
+    TRDP_REC_T      *pRec,
+    TRDP_REC_KIND_T kind,
+    TRDP_IP_ADDR_T  srcIp,
+    TRDP_IP_ADDR_T  destIp,
+    UINT16          port,
+    const UINT8     *pFrame,
+    UINT32          size,
+    const UINT8     *pData,
+    UINT32          dataSize)
+{
+    TRDP_REC_HEAD_T     *pHead  = pRec->pHead;
+    TRDP_REC_ENTRY_T    *pEntry;
+    TRDP_TIME_T         now;
+    UINT32              capLen  = size + dataSize;
+    UINT32              len;
+    UINT32              seq;
+
+    if (capLen > pHead->snapLen)
+    {
+        capLen = pHead->snapLen;
+    }
+    len = REC_ALIGNED(sizeof(TRDP_REC_ENTRY_T) + capLen);
+    vos_getTime(&now);
+
+    if (vos_mutexLock(pRec->mutex) != VOS_NO_ERR)
+    {
+        return;
+    }
+    seq = pHead->seq;
+    REC_STORE(&pHead->seq, seq + 1u);
+    REC_FENCE();
+
+    /*  A record does not wrap, the rest of the ring is skipped   */
+    if (pHead->head + len > pHead->ringSize)
+    {
+        UINT32 rest = pHead->ringSize - pHead->head;
+
+        trdp_recReclaim(pRec, rest);
+        if (rest >= sizeof(TRDP_REC_ENTRY_T))
+        {
+            pEntry          = (TRDP_REC_ENTRY_T *) (pRec->pRing + pHead->head);
+            memset(pEntry, 0, sizeof(TRDP_REC_ENTRY_T));
+            pEntry->len     = rest;
+            pEntry->recNo   = pHead->nextRecNo++;
+            pEntry->kind    = (UINT8) TRDP_REC_PAD;
+        }
+        pHead->used += rest;
+        pHead->head = 0u;
+    }
+    trdp_recReclaim(pRec, len);
+
+    pEntry              = (TRDP_REC_ENTRY_T *) (pRec->pRing + pHead->head);
+    pEntry->len         = len;
+    pEntry->recNo       = pHead->nextRecNo++;
+    pEntry->kind        = (UINT8) kind;
+    pEntry->reserved    = 0u;
+    pEntry->port        = port;
+    pEntry->srcIpAddr   = srcIp;
+    pEntry->destIpAddr  = destIp;
+    pEntry->sec         = (UINT32) now.tv_sec;
+    pEntry->usec        = (UINT32) now.tv_usec;
+    pEntry->origLen     = size + dataSize;
+    pEntry->capLen      = capLen;
+    if (capLen <= size)
+    {
+        memcpy(pEntry + 1, pFrame, capLen);
+    }
+    else
+    {
+        memcpy(pEntry + 1, pFrame, size);
+        memcpy((UINT8 *) (pEntry + 1) + size, pData, capLen - size);
+    }
+    pHead->used += len;
+    pHead->head += len;
+    if (pHead->head >= pHead->ringSize)
+    {
+        pHead->head = 0u;
+    }
+
+    REC_FENCE();
+    REC_STORE(&pHead->seq, seq + 2u);
+    (void) vos_mutexUnlock(pRec->mutex);
+}
+
+/******************************************************************************/
+/** Stop the recorder of a session
+ *  The area is removed, the records are lost unless saved before (tlc_saveRecording).
+ *
+ *  @param[in]      appHandle       the session
+ */
+void trdp_recStop (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_REC_T *pRec = appHandle->pRecorder;
+
+    if (pRec != NULL)
+    {
+        appHandle->pRecorder = NULL;
+        (void) vos_sharedClose(pRec->shm, pRec->pArea);
+        vos_mutexDelete(pRec->mutex);
+        vos_memFree(pRec);
+    }
+}
+
+#endif
+
+/**********************************************************************************************************************/
+/** Record the telegrams of a session.
+ *  Every PD and MD telegram sent or received by the session is appended to a ring in the shared memory area pName
+ *  (on POSIX a file in /dev/shm). When the ring is full the oldest records are overwritten. The area survives an
+ *  abnormal termination of the process; a new tlc_record() with the same name starts a new recording.
+ *  The records are saved as pcapng file by tlc_saveRecording(). Recording is stopped, and the area removed, by
+ *  pName NULL or closing the session.
+ *  A record takes 40 bytes plus the telegram (up to snapLen), rounded up to 8 bytes.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pName               name of the shared memory area (e.g. "/trdp-rec"), NULL to stop recording
+ *  @param[in]      size                size of the ring in bytes, 0 = 4 MB
+ *  @param[in]      snapLen             max. bytes recorded of a telegram, 0 = all
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        shared memory not available
+ */
+EXT_DECL TRDP_ERR_T tlc_record (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pName,
+    UINT32              size,
+    UINT32              snapLen)
+{
+#if TRDP_RECORDER
+    TRDP_ERR_T      err = TRDP_NO_ERR;
+    TRDP_REC_T      *pRec;
+    TRDP_TIME_T     now;
+    UINT32          areaSize;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (size == 0u)
+    {
+        size = TRDP_REC_DEFAULT_SIZE;
+    }
+    if ((pName != NULL) && ((size < TRDP_REC_MIN_SIZE) || (size > 0x7FFFFFFFu - sizeof(TRDP_REC_HEAD_T))))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if ((snapLen == 0u) || (snapLen > size / 4u))
+    {
+        snapLen = size / 4u;
+    }
+
+    if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_recStop(appHandle);
+
+    if (pName != NULL)
+    {
+        pRec = (TRDP_REC_T *) vos_memAlloc(sizeof(TRDP_REC_T));
+        if (pRec == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else if (vos_mutexCreate(&pRec->mutex) != VOS_NO_ERR)
+        {
+            vos_memFree(pRec);
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            size        = REC_ALIGNED(size);
+            areaSize    = sizeof(TRDP_REC_HEAD_T) + size;
+            if (vos_sharedOpen(pName, &pRec->shm, &pRec->pArea, &areaSize) != VOS_NO_ERR)
+            {
+                vos_printLog(VOS_LOG_ERROR, "Recording to %s failed\n", pName);
+                vos_mutexDelete(pRec->mutex);
+                vos_memFree(pRec);
+                err = TRDP_MEM_ERR;
+            }
+            else
+            {
+                pRec->pHead = (TRDP_REC_HEAD_T *) pRec->pArea;
+                pRec->pRing = pRec->pArea + sizeof(TRDP_REC_HEAD_T);
+
+                vos_getTime(&now);
+                pRec->pHead->version    = TRDP_REC_VERSION;
+                pRec->pHead->ringSize   = size;
+                pRec->pHead->snapLen    = snapLen;
+                pRec->pHead->ownIpAddr  = appHandle->realIP;
+                pRec->pHead->wallSec    = (UINT32) time(NULL);
+                pRec->pHead->monoSec    = (UINT32) now.tv_sec;
+                pRec->pHead->monoUsec   = (UINT32) now.tv_usec;
+                REC_STORE(&pRec->pHead->magic, TRDP_REC_MAGIC);
+                appHandle->pRecorder    = pRec;
+            }
+        }
+    }
+
+    (void) trdp_sessionUnlock(appHandle);
+    return err;
+#else
+    (void) appHandle;
+    (void) pName;
+    (void) size;
+    (void) snapLen;
+    return TRDP_UNKNOWN_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Save the telegrams recorded by tlc_record() as pcapng file.
+ *  The area pName is read while a session records into it, possibly in another process, or after the recording
+ *  process terminated. The telegrams are written oldest first, as UDP datagrams over raw IPv4 (TCP MD telegrams as
+ *  well), for the TRDP dissector. Records overwritten while they are read are left out.
+ *  The time stamps follow the monotonic clock of the stack, set off to the wall clock of the start of the
+ *  recording (1 s resolution).
+ *
+ *  @param[in]      pName               name of the shared memory area passed to tlc_record()
+ *  @param[in]      pFileName           name of the pcapng file to write
+ *  @param[out]     pNoRecords          number of telegrams written, may be NULL
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     no recording by that name
+ *  @retval         TRDP_IO_ERR         file could not be written
+ *  @retval         TRDP_BLOCK_ERR      no consistent ring state could be read
+ *  @retval         TRDP_WIRE_ERR       ring corrupt, the records before are saved
+ */
+EXT_DECL TRDP_ERR_T tlc_saveRecording (
+    const CHAR8 *pName,
+    const CHAR8 *pFileName,
+    UINT32      *pNoRecords)
+{
+#if TRDP_RECORDER
+    TRDP_ERR_T          err = TRDP_NO_ERR;
+    TRDP_REC_HEAD_T     *pHead;
+    TRDP_REC_HEAD_T     state;
+    TRDP_REC_HEAD_T     now;
+    TRDP_REC_ENTRY_T    entry;
+    VOS_SHRD_T          shm;
+    UINT8               *pArea;
+    UINT8               *pRing;
+    UINT8               *pFrame = NULL;
+    FILE                *fp;
+    UINT32              areaSize;
+    UINT32              resync = 0u;
+    UINT32              pos;
+    UINT32              recNo;
+    UINT32              noRecords = 0u;
+
+    if ((pName == NULL) || (pFileName == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (vos_sharedAttach(pName, &shm, &pArea, &areaSize) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pHead   = (TRDP_REC_HEAD_T *) pArea;
+    pRing   = pArea + sizeof(TRDP_REC_HEAD_T);
+    if ((areaSize < sizeof(TRDP_REC_HEAD_T)) ||
+        (REC_LOAD(&pHead->magic) != TRDP_REC_MAGIC) ||
+        (pHead->version != TRDP_REC_VERSION) ||
+        (pHead->ringSize > areaSize - sizeof(TRDP_REC_HEAD_T)) ||
+        (pHead->snapLen > pHead->ringSize))
+    {
+        (void) vos_sharedClose(shm, pArea);
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*  Ring state to start from    */
+    if (!trdp_recState(pHead, &state))
+    {
+        (void) vos_sharedClose(shm, pArea);
+        return TRDP_BLOCK_ERR;
+    }
+
+    pFrame  = (UINT8 *) vos_memAlloc(state.snapLen + 1u);
+    fp      = fopen(pFileName, "wb");
+    if ((pFrame == NULL) || (fp == NULL))
+    {
+        err = (pFrame == NULL) ? TRDP_MEM_ERR : TRDP_IO_ERR;
+    }
+    /*  Section header and one interface, raw IPv4  */
+    else if (!trdp_recPut32(fp, PCAPNG_SHB) || !trdp_recPut32(fp, 28u) || !trdp_recPut32(fp, PCAPNG_BOM) ||
+             !trdp_recPut32(fp, 1u) || !trdp_recPut32(fp, 0xFFFFFFFFu) || !trdp_recPut32(fp, 0xFFFFFFFFu) ||
+             !trdp_recPut32(fp, 28u) ||
+             !trdp_recPut32(fp, PCAPNG_IDB) || !trdp_recPut32(fp, 20u) || !trdp_recPut32(fp, LINKTYPE_RAW) ||
+             !trdp_recPut32(fp, 0xFFFFu) || !trdp_recPut32(fp, 20u))
+    {
+        err = TRDP_IO_ERR;
+    }
+    else
+    {
+        pos     = state.tail;
+        recNo   = state.tailRecNo;
+        while (recNo != state.nextRecNo)
+        {
+            if (state.ringSize - pos < sizeof(TRDP_REC_ENTRY_T))
+            {
+                pos = 0u;
+                continue;
+            }
+            memcpy(&entry, pRing + pos, sizeof(entry));
+            if (entry.kind != (UINT8) TRDP_REC_PAD)
+            {
+                /*  The entry may be overwritten meanwhile, copy within the ring only  */
+                UINT32 capLen = (entry.capLen < state.snapLen) ? entry.capLen : state.snapLen;
+
+                if (capLen > state.ringSize - pos - (UINT32) sizeof(entry))
+                {
+                    capLen = state.ringSize - pos - (UINT32) sizeof(entry);
+                }
+                memcpy(pFrame, pRing + pos + sizeof(entry), capLen);
+            }
+            /*  Still valid after the copy? A full ring overwrites its oldest record with every telegram  */
+            REC_FENCE();
+            if ((INT32) (recNo - REC_LOAD(&pHead->tailRecNo)) < 0)
+            {
+                /*  Continue with the oldest record left    */
+                if ((++resync > TRDP_REC_RETRIES) || !trdp_recState(pHead, &now) ||
+                    ((INT32) (now.tailRecNo - state.nextRecNo) >= 0))
+                {
+                    break;
+                }
+                pos     = now.tail;
+                recNo   = now.tailRecNo;
+                continue;
+            }
+            if ((entry.recNo != recNo) || (entry.len < sizeof(entry)) || (entry.len > state.ringSize - pos) ||
+                (entry.capLen > state.snapLen) || (entry.capLen > entry.len - sizeof(entry)))
+            {
+                err = TRDP_WIRE_ERR;
+                break;
+            }
+            if (entry.kind != (UINT8) TRDP_REC_PAD)
+            {
+                if (!trdp_recPutPacket(fp, &state, &entry, pFrame))
+                {
+                    err = TRDP_IO_ERR;
+                    break;
+                }
+                noRecords++;
+            }
+            pos += entry.len;
+            if (pos >= state.ringSize)
+            {
+                pos = 0u;
+            }
+            recNo++;
+        }
+    }
+
+    if (fp != NULL)
+    {
+        if (fclose(fp) != 0)
+        {
+            err = TRDP_IO_ERR;
+        }
+    }
+    if (pFrame != NULL)
+    {
+        vos_memFree(pFrame);
+    }
+    (void) vos_sharedClose(shm, pArea);
+    if (pNoRecords != NULL)
+    {
+        *pNoRecords = noRecords;
+    }
+    return err;
+#else
+    (void) pName;
+    (void) pFileName;
+    (void) pNoRecords;
+    return TRDP_UNKNOWN_ERR;
+#endif
+}
@@ -0,0 +1,84 @@
+/******************************************************************************/
+/**
+ * @file            trdp_rec.h
+ *
+ * @brief           Black-box recorder of the PD and MD telegrams of a session
+ *
+ * @details         See tlc_record()
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+
+#ifndef TRDP_REC_H
+#define TRDP_REC_H
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_private.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+/** Record a telegram, if the session records (tlc_record)  */
+#if TRDP_RECORDER
+#define TRDP_REC(appHandle, kind, srcIp, destIp, port, pFrame, size)                                    \
+    do                                                                                                  \
+    {                                                                                                   \
+        if ((appHandle)->pRecorder != NULL)                                                             \
+        {                                                                                               \
+            trdp_recWrite((appHandle)->pRecorder, (kind), (srcIp), (destIp), (port),                    \
+                          (const UINT8 *) (pFrame), (size), NULL, 0u);                                  \
+        }                                                                                               \
+    }                                                                                                   \
+    while (0)
+#else
+#define TRDP_REC(appHandle, kind, srcIp, destIp, port, pFrame, size)
+#endif
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Kinds of records */
+typedef enum
+{
+    TRDP_REC_PAD    = 0,            /**< unused space up to the end of the ring         */
+    TRDP_REC_PD_RX  = 1,            /**< PD telegram received                           */
+    TRDP_REC_PD_TX  = 2,            /**< PD telegram sent                               */
+    TRDP_REC_MD_RX  = 3,            /**< MD telegram received via UDP                   */
+    TRDP_REC_MD_TX  = 4,            /**< MD telegram sent via UDP                       */
+    TRDP_REC_TCP_RX = 5,            /**< MD telegram received via TCP                   */
+    TRDP_REC_TCP_TX = 6             /**< MD telegram sent via TCP                       */
+} TRDP_REC_KIND_T;
+
+/*******************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+#if TRDP_RECORDER
+void    trdp_recWrite (struct TRDP_REC    *pRec,
+                       TRDP_REC_KIND_T      kind,
+                       TRDP_IP_ADDR_T       srcIp,
+                       TRDP_IP_ADDR_T       destIp,
+                       UINT16               port,
+                       const UINT8          *pFrame,
+                       UINT32               size,
+                       const UINT8          *pData,
+                       UINT32               dataSize);
+void    trdp_recStop (TRDP_SESSION_PT appHandle);
+#endif
+
+#endif /* TRDP_REC_H */
@@ -0,0 +1,402 @@
+/******************************************************************************/
+/**
+ * @file            trdp_sdt.c
+ *
+ * @brief           Validation of vital process data (SDTv2)
+ *
+ * @details         The vital data (VDP) of a safe telegram ends with a 16 byte trailer: reserved (6 bytes), user
+ *                  data version (2), safe sequence counter SSC (4) and the safety code (4), all in network order.
+ *                  The safety code is the SC-32 of the VDP without the safety code, seeded with the SID, which is
+ *                  the SC-32 of the safe message identifier, the consist UUID and the safe topography counter.
+ *                  The state of all safe channels of a session is kept in one array, a received frame is checked
+ *                  right after its subscription was found, without allocation.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+
+#include "trdp_sdt.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TRDP_SDT_START_SIZE     16u             /**< initial size of the safe channel array     */
+
+/*******************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/** Read a big endian 32 bit value    */
+static UINT32 trdp_sdtGet32 (
+    const UINT8 *p)
+{
+    return ((UINT32) p[0] << 24) | ((UINT32) p[1] << 16) | ((UINT32) p[2] << 8) | (UINT32) p[3];
+}
+
+/** Write a big endian 32 bit value    */
+static void trdp_sdtPut32 (
+    UINT8   *p,
+    UINT32  value)
+{
+    p[0]    = (UINT8) (value >> 24);
+    p[1]    = (UINT8) (value >> 16);
+    p[2]    = (UINT8) (value >> 8);
+    p[3]    = (UINT8) value;
+}
+
+/******************************************************************************/
+/** Compute the SID of a safe message identifier
+ *  SC-32 over SMI, reserved (2 bytes), SDT version (2 bytes), consist UUID and safe topography counter.
+ *
+ *  @param[in]      smi                 safe message identifier
+ *  @param[in]      cstUUID             UUID of the consist of the source, all zero for consist local data
+ *  @param[in]      safeTopoCnt         safe topography counter, 0 for consist local data
+ *
+ *  @retval         SID
+ */
+static UINT32 trdp_sdtSid (
+    UINT32              smi,
+    const TRDP_UUID_T   cstUUID,
+    UINT32              safeTopoCnt)
+{
+    UINT8 buf[4u + 2u + 2u + sizeof(TRDP_UUID_T) + 4u];
+
+    trdp_sdtPut32(&buf[0], smi);
+    buf[4]  = 0u;
+    buf[5]  = 0u;
+    buf[6]  = 0u;
+    buf[7]  = (UINT8) TRDP_SDT_VERSION;
+    memcpy(&buf[8], cstUUID, sizeof(TRDP_UUID_T));
+    trdp_sdtPut32(&buf[8u + sizeof(TRDP_UUID_T)], safeTopoCnt);
+    return vos_sc32(0xFFFFFFFFu, buf, sizeof(buf));
+}
+
+/** Time between two points in us, 0 if pTo is before pFrom    */
+static UINT64 trdp_sdtElapsed (
+    const TRDP_TIME_T   *pFrom,
+    const TRDP_TIME_T   *pTo)
+{
+    TRDP_TIME_T diff = *pTo;
+
+    if (timercmp(pTo, pFrom, <))
+    {
+        return 0u;
+    }
+    vos_subTime(&diff, pFrom);
+    return (UINT64) diff.tv_sec * 1000000u + (UINT64) diff.tv_usec;
+}
+
+/** Deadline pFrom + ms    */
+static void trdp_sdtDue (
+    TRDP_TIME_T         *pDue,
+    const TRDP_TIME_T   *pFrom,
+    UINT32              ms)
+{
+    TRDP_TIME_T add;
+
+    add.tv_sec  = ms / 1000u;
+    add.tv_usec = (ms % 1000u) * 1000u;
+    *pDue       = *pFrom;
+    vos_addTime(pDue, &add);
+}
+
+/** Time supervision: no fresh data until freshDue    */
+static void trdp_sdtCheckTime (
+    TRDP_SDT_CHAN_T     *pChan,
+    const TRDP_TIME_T   *pNow)
+{
+    if (((pChan->status.state == TRDP_SDT_INIT) || (pChan->status.state == TRDP_SDT_VALID)) &&
+        timerisset(&pChan->freshDue) &&
+        timercmp(pNow, &pChan->freshDue, >))
+    {
+        pChan->status.state = TRDP_SDT_TIMEOUT;
+        pChan->status.numTimeout++;
+    }
+}
+
+/*******************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/******************************************************************************/
+/** Make a subscription vital or reset its safe channel
+ *  The channel starts in TRDP_SDT_INIT, fresh data is expected within nGuard sink cycles.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSub                subscription
+ *  @param[in]      pSdtPar             SDT parameters, NULL to remove the channel
+ *  @param[in]      cstUUID             UUID of the consist of the source
+ *  @param[in]      safeTopoCnt         safe topography counter
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+TRDP_ERR_T trdp_sdtSet (
+    TRDP_SESSION_PT         appHandle,
+    PD_ELE_T                *pSub,
+    const TRDP_SDT_PAR_T    *pSdtPar,
+    const TRDP_UUID_T       cstUUID,
+    UINT32                  safeTopoCnt)
+{
+    TRDP_SDT_CHAN_T *pChan;
+    TRDP_TIME_T     now;
+
+    if (pSdtPar == NULL)
+    {
+        trdp_sdtRemove(appHandle, pSub);
+        return TRDP_NO_ERR;
+    }
+
+    if (pSub->sdtIdx == 0u)
+    {
+        if (appHandle->sdtChanCnt >= appHandle->sdtChanSize)
+        {
+            UINT32          newSize     = (appHandle->sdtChanSize == 0u) ?
+                TRDP_SDT_START_SIZE : 2u * appHandle->sdtChanSize;
+            TRDP_SDT_CHAN_T *pNewChan   = (TRDP_SDT_CHAN_T *) vos_memAlloc(newSize * sizeof(TRDP_SDT_CHAN_T));
+
+            if (pNewChan == NULL)
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "trdp_sdtSet: Out of memory!\n");
+                return TRDP_MEM_ERR;
+            }
+            if (appHandle->pSdtChan != NULL)
+            {
+                memcpy(pNewChan, appHandle->pSdtChan, appHandle->sdtChanCnt * sizeof(TRDP_SDT_CHAN_T));
+                vos_memFree(appHandle->pSdtChan);
+            }
+            appHandle->pSdtChan     = pNewChan;
+            appHandle->sdtChanSize  = newSize;
+        }
+        pSub->sdtIdx = ++appHandle->sdtChanCnt;
+    }
+
+    pChan = &appHandle->pSdtChan[pSub->sdtIdx - 1u];
+    memset(pChan, 0, sizeof(TRDP_SDT_CHAN_T));
+    pChan->pSub     = pSub;
+    pChan->sid1     = trdp_sdtSid(pSdtPar->smi1, cstUUID, safeTopoCnt);
+    pChan->sid2     = (pSdtPar->smi2 != 0u) ? trdp_sdtSid(pSdtPar->smi2, cstUUID, safeTopoCnt) : 0u;
+    pChan->txPeriod = pSdtPar->txPeriod;
+    pChan->safeTime = (UINT32) pSdtPar->nrxSafe * pSdtPar->rxPeriod;
+    pChan->cmThr    = pSdtPar->cmThr;
+    pChan->udv      = pSdtPar->udv;
+    pChan->status.state = TRDP_SDT_INIT;
+
+    /*  Guard time for the first fresh data */
+    if ((pSdtPar->rxPeriod != 0u) && ((pSdtPar->nGuard != 0u) || (pSdtPar->nrxSafe != 0u)))
+    {
+        vos_getTime(&now);
+        trdp_sdtDue(&pChan->freshDue, &now,
+                    (UINT32) ((pSdtPar->nGuard != 0u) ? pSdtPar->nGuard : pSdtPar->nrxSafe) * pSdtPar->rxPeriod);
+    }
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Remove the safe channel of a subscription
+ *  The last channel takes the place of the removed one.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSub                subscription
+ */
+void trdp_sdtRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pSub)
+{
+    UINT32 idx = pSub->sdtIdx;
+
+    if (idx == 0u)
+    {
+        return;
+    }
+    pSub->sdtIdx = 0u;
+    if (idx < appHandle->sdtChanCnt)
+    {
+        appHandle->pSdtChan[idx - 1u] = appHandle->pSdtChan[appHandle->sdtChanCnt - 1u];
+        appHandle->pSdtChan[idx - 1u].pSub->sdtIdx = idx;
+    }
+    appHandle->sdtChanCnt--;
+}
+
+/******************************************************************************/
+/** Free the safe channels of a session
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_sdtFree (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pSdtChan != NULL)
+    {
+        vos_memFree(appHandle->pSdtChan);
+        appHandle->pSdtChan = NULL;
+    }
+    appHandle->sdtChanCnt   = 0u;
+    appHandle->sdtChanSize  = 0u;
+}
+
+/******************************************************************************/
+/** Validate received vital data
+ *  Called for a received frame of a vital subscription before it replaces the last valid data.
+ *  Checked are size, safety code (SID of smi1 or smi2), user data version and safe sequence counter. A repeated SSC
+ *  is accepted, but not fresh. A fresh SSC must account for the time since the last fresh data (latency
+ *  supervision): each missing source cycle is granted, a delay of more than nrxSafe sink cycles is not. After a time
+ *  out the SSC must still be newer, the latency is not checked for the first fresh data.
+ *  Each invalid frame increments the channel monitoring counter, each valid one decrements it. Exceeding cmThr
+ *  latches TRDP_SDT_ERROR.
+ *
+ *  @param[in]      appHandle           session pointer, pdRcvTime is the reception time
+ *  @param[in]      pSub                vital subscription
+ *  @param[in]      pData               received vital data
+ *  @param[in]      dataSize            size of the vital data
+ *
+ *  @retval         TRDP_NO_ERR         valid data
+ *  @retval         TRDP_SAFETY_ERR     data not valid, keep the last valid data
+ */
+TRDP_ERR_T trdp_sdtValidate (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pSub,
+    const UINT8     *pData,
+    UINT32          dataSize)
+{
+    TRDP_SDT_CHAN_T     *pChan      = &appHandle->pSdtChan[pSub->sdtIdx - 1u];
+    const TRDP_TIME_T   *pNow       = &appHandle->pdRcvTime;
+    const UINT8         *pTrailer   = pData + dataSize - TRDP_SDT_VDP_TRAILER_SIZE;
+    UINT32              *pErrCnt    = NULL;
+    UINT32              safetyCode;
+    UINT32              ssc         = 0u;
+    UINT32              delta       = 1u;
+
+    if (pChan->status.state == TRDP_SDT_ERROR)
+    {
+        return TRDP_SAFETY_ERR;
+    }
+    trdp_sdtCheckTime(pChan, pNow);
+
+    if ((dataSize < TRDP_SDT_VDP_TRAILER_SIZE) || ((dataSize & 3u) != 0u))
+    {
+        pErrCnt = &pChan->status.numScErr;
+    }
+    else
+    {
+        safetyCode = trdp_sdtGet32(pTrailer + 12u);
+        ssc        = trdp_sdtGet32(pTrailer + 8u);
+        if (pChan->status.state != TRDP_SDT_INIT)
+        {
+            delta = ssc - pChan->status.lastSsc;
+        }
+        if ((vos_sc32(pChan->sid1, pData, dataSize - 4u) != safetyCode) &&
+            ((pChan->sid2 == 0u) || (vos_sc32(pChan->sid2, pData, dataSize - 4u) != safetyCode)))
+        {
+            pErrCnt = &pChan->status.numScErr;
+        }
+        else if ((UINT16) (((UINT16) pTrailer[6] << 8) | pTrailer[7]) != pChan->udv)
+        {
+            pErrCnt = &pChan->status.numUdvErr;
+        }
+        else if (delta >= 0x80000000u)
+        {
+            pErrCnt = &pChan->status.numSscErr;
+        }
+        else if ((delta != 0u) &&
+                 (pChan->status.state == TRDP_SDT_VALID) &&
+                 (pChan->txPeriod != 0u) && (pChan->safeTime != 0u) &&
+                 (trdp_sdtElapsed(&pChan->freshTime, pNow) >
+                  ((UINT64) delta * pChan->txPeriod + pChan->safeTime) * 1000u))
+        {
+            pErrCnt = &pChan->status.numLatencyErr;
+        }
+    }
+
+    if (pErrCnt != NULL)
+    {
+        (*pErrCnt)++;
+        pChan->cmCount++;
+        if ((pChan->cmThr != 0u) && (pChan->cmCount > pChan->cmThr))
+        {
+            vos_printLog(VOS_LOG_WARNING, "SDT channel of comId %u failed\n", pSub->addr.comId);
+            pChan->status.state = TRDP_SDT_ERROR;
+        }
+        return TRDP_SAFETY_ERR;
+    }
+
+    pChan->status.numValid++;
+    if (delta == 0u)
+    {
+        /*  Valid, but not fresh   */
+        return (pChan->status.state == TRDP_SDT_VALID) ? TRDP_NO_ERR : TRDP_SAFETY_ERR;
+    }
+
+    /*  Fresh valid data    */
+    pChan->status.state     = TRDP_SDT_VALID;
+    pChan->status.lastSsc   = ssc;
+    pChan->freshTime        = *pNow;
+    if (pChan->safeTime != 0u)
+    {
+        trdp_sdtDue(&pChan->freshDue, pNow, pChan->safeTime);
+    }
+    if (pChan->cmCount > 0u)
+    {
+        pChan->cmCount--;
+    }
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Get the state of a safe channel
+ *  The time supervision is updated first.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSub                vital subscription
+ *  @param[in]      pNow                current time
+ *  @param[out]     pStatus             state and counters
+ */
+void trdp_sdtGetStatus (
+    TRDP_SESSION_PT     appHandle,
+    const PD_ELE_T      *pSub,
+    const TRDP_TIME_T   *pNow,
+    TRDP_SDT_STATUS_T   *pStatus)
+{
+    TRDP_SDT_CHAN_T *pChan = &appHandle->pSdtChan[pSub->sdtIdx - 1u];
+
+    trdp_sdtCheckTime(pChan, pNow);
+    *pStatus = pChan->status;
+}
+
+/******************************************************************************/
+/** Get the current state of a safe channel
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSub                vital subscription
+ *  @param[in]      pNow                current time
+ *
+ *  @retval         state of the channel
+ */
+TRDP_SDT_STATE_T trdp_sdtGetState (
+    TRDP_SESSION_PT     appHandle,
+    const PD_ELE_T      *pSub,
+    const TRDP_TIME_T   *pNow)
+{
+    TRDP_SDT_CHAN_T *pChan = &appHandle->pSdtChan[pSub->sdtIdx - 1u];
+
+    trdp_sdtCheckTime(pChan, pNow);
+    return pChan->status.state;
+}
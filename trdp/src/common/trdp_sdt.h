@@ -0,0 +1,64 @@
+/******************************************************************************/
+/**
+ * @file            trdp_sdt.h
+ *
+ * @brief           Validation of vital process data (SDTv2)
+ *
+ * @details         Safe data transmission according to IEC 61375-2-3 Annex B: safety code, user data version,
+ *                  safe sequence counter, latency and time supervision of subscribed vital data
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+
+#ifndef TRDP_SDT_H
+#define TRDP_SDT_H
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TRDP_SDT_VDP_TRAILER_SIZE   16u     /**< size of the VDP trailer at the end of vital data  */
+#define TRDP_SDT_VERSION            2u      /**< SDT protocol version used for the SID             */
+
+/*******************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+TRDP_ERR_T  trdp_sdtSet (TRDP_SESSION_PT        appHandle,
+                         PD_ELE_T               *pSub,
+                         const TRDP_SDT_PAR_T   *pSdtPar,
+                         const TRDP_UUID_T      cstUUID,
+                         UINT32                 safeTopoCnt);
+void        trdp_sdtRemove (TRDP_SESSION_PT appHandle,
+                            PD_ELE_T        *pSub);
+void        trdp_sdtFree (TRDP_SESSION_PT appHandle);
+TRDP_ERR_T  trdp_sdtValidate (TRDP_SESSION_PT   appHandle,
+                              PD_ELE_T          *pSub,
+                              const UINT8       *pData,
+                              UINT32            dataSize);
+void        trdp_sdtGetStatus (TRDP_SESSION_PT      appHandle,
+                               const PD_ELE_T       *pSub,
+                               const TRDP_TIME_T    *pNow,
+                               TRDP_SDT_STATUS_T    *pStatus);
+TRDP_SDT_STATE_T trdp_sdtGetState (TRDP_SESSION_PT    appHandle,
+                                   const PD_ELE_T     *pSub,
+                                   const TRDP_TIME_T  *pNow);
+
+#endif
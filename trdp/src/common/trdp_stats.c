@@ -31,6 +31,7 @@
  */
 
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "trdp_stats.h"
@@ -38,27 +39,241 @@
 #include "trdp_if.h"
 #include "trdp_private.h"
 #include "trdp_pdcom.h"
+#include "trdp_utils.h"
 #include "vos_mem.h"
 #include "vos_thread.h"
+#include "vos_shared_mem.h"
 
 /*******************************************************************************
  * DEFINES
  */
 
+#define TRDP_EXPORT_MAGIC       0x54525358u     /* "TRSX" */
+#define TRDP_EXPORT_VERSION     2u
+#define TRDP_EXPORT_INTERVAL    1000u           /* default export interval in ms */
+#define TRDP_EXPORT_RETRIES     100u            /* tries to read a consistent snapshot */
+#define TRDP_METRICS_LINE       256u            /* max. length of a metrics line */
+
+/*  The export area is read by other processes, a sequence number odd while writing guards the snapshot  */
+#ifdef __GNUC__
+#define EXPORT_SEQ_LOAD(pSeq)           __atomic_load_n((pSeq), __ATOMIC_ACQUIRE)
+#define EXPORT_SEQ_STORE(pSeq, val)     __atomic_store_n((pSeq), (val), __ATOMIC_RELEASE)
+#define EXPORT_SEQ_FENCE()              __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#else
+#define EXPORT_SEQ_LOAD(pSeq)           (*(volatile UINT32 *)(pSeq))
+#define EXPORT_SEQ_STORE(pSeq, val)     (*(volatile UINT32 *)(pSeq) = (val))
+#define EXPORT_SEQ_FENCE()
+#endif
+
 /*******************************************************************************
  * TYPEDEFS
  */
 
+/** Socket entry of the statistics export */
+typedef struct
+{
+    UINT32  type;                   /**< TRDP_SOCK_TYPE_T                               */
+    UINT32  bindAddr;               /**< interface address                              */
+    UINT32  usage;                  /**< number of users                                */
+    UINT32  mcJoinCnt;              /**< number of multicast memberships                */
+    UINT32  queuedBytes;            /**< bytes waiting to be sent (TCP)                 */
+    UINT32  rxDrops;                /**< datagrams dropped on the full receive queue    */
+    UINT32  rcvBufSize;             /**< receive buffer size, 0 if not checked yet      */
+} TRDP_EXPORT_SOCK_T;
+
+/** Header of the statistics export area.
+    The tables of maxEle subscriptions, maxEle publishers and numSock sockets follow.  */
+typedef struct
+{
+    UINT32                      magic;      /**< TRDP_EXPORT_MAGIC, set after the first snapshot     */
+    UINT32                      version;    /**< TRDP_EXPORT_VERSION                                  */
+    UINT32                      seq;        /**< snapshot sequence, odd while written                 */
+    UINT32                      size;       /**< size of the area                                     */
+    UINT32                      maxEle;     /**< size of the subscription and publisher tables        */
+    UINT32                      numSubs;    /**< used entries of the subscription table               */
+    UINT32                      numPub;     /**< used entries of the publisher table                  */
+    UINT32                      numSock;    /**< used entries of the socket table                     */
+    TRDP_STATISTICS_T           stats;      /**< session statistics                                   */
+    TRDP_TCP_CONN_STATISTICS_T  tcpConn;    /**< TCP connection statistics                            */
+} TRDP_EXPORT_HEAD_T;
+
+/** A session metric of the export, value at offset in TRDP_EXPORT_HEAD_T */
+typedef struct
+{
+    const CHAR8 *pName;             /**< metric family name                             */
+    const CHAR8 *pHelp;             /**< description                                    */
+    BOOL8       counter;            /**< TRUE: counter, FALSE: gauge                    */
+    const CHAR8 *pLabel;            /**< additional label or NULL                       */
+    UINT32      offset;             /**< offset of the UINT32 value                     */
+} TRDP_METRIC_T;
+
+/** Text output of the metrics */
+typedef struct
+{
+    CHAR8   *pText;                 /**< output buffer                                  */
+    UINT32  size;                   /**< size of the buffer                             */
+    UINT32  len;                    /**< length of the text, may exceed size            */
+} TRDP_METRICS_BUF_T;
+
 /******************************************************************************
  *   Locals
  */
 
 void trdp_UpdateStats (TRDP_APP_SESSION_T appHandle);
 
+#if TRDP_STATS_BLOCKS > 1
+static UINT32 sStatsNextSlot = 0u;      /* slot of the next thread counting */
+#endif
+
+#define EXPORT_VALUE(field)     offsetof(TRDP_EXPORT_HEAD_T, field)
+
+/* Consecutive entries of the same family share the header lines */
+static const TRDP_METRIC_T cSessionMetrics[] =
+{
+    {"trdp_up_time_seconds", "Time since the session was opened", FALSE, NULL, EXPORT_VALUE(stats.upTime)},
+    {"trdp_statistic_time_seconds", "Time since the statistics were reset", FALSE, NULL,
+     EXPORT_VALUE(stats.statisticTime)},
+    {"trdp_joins", "Multicast groups joined", FALSE, NULL, EXPORT_VALUE(stats.numJoin)},
+    {"trdp_mem_total_bytes", "Size of the TRDP memory area", FALSE, NULL, EXPORT_VALUE(stats.mem.total)},
+    {"trdp_mem_free_bytes", "Free memory of the TRDP memory area", FALSE, NULL, EXPORT_VALUE(stats.mem.free)},
+    {"trdp_mem_min_free_bytes", "Least free memory of the TRDP memory area", FALSE, NULL,
+     EXPORT_VALUE(stats.mem.minFree)},
+    {"trdp_mem_blocks", "Allocated memory blocks", FALSE, NULL, EXPORT_VALUE(stats.mem.numAllocBlocks)},
+    {"trdp_mem_alloc_errors", "Failed allocations", TRUE, NULL, EXPORT_VALUE(stats.mem.numAllocErr)},
+    {"trdp_mem_free_errors", "Failed frees", TRUE, NULL, EXPORT_VALUE(stats.mem.numFreeErr)},
+    {"trdp_pd_subscriptions", "PD subscriptions", FALSE, NULL, EXPORT_VALUE(stats.pd.numSubs)},
+    {"trdp_pd_publishers", "PD publishers", FALSE, NULL, EXPORT_VALUE(stats.pd.numPub)},
+    {"trdp_pd_received", "Received PD packets", TRUE, NULL, EXPORT_VALUE(stats.pd.numRcv)},
+    {"trdp_pd_crc_errors", "Received PD packets with CRC error", TRUE, NULL, EXPORT_VALUE(stats.pd.numCrcErr)},
+    {"trdp_pd_protocol_errors", "Received PD packets with protocol error", TRUE, NULL,
+     EXPORT_VALUE(stats.pd.numProtErr)},
+    {"trdp_pd_topo_errors", "Received PD packets with wrong topography counter", TRUE, NULL,
+     EXPORT_VALUE(stats.pd.numTopoErr)},
+    {"trdp_pd_no_subscriber", "Received PD packets without subscription", TRUE, NULL,
+     EXPORT_VALUE(stats.pd.numNoSubs)},
+    {"trdp_pd_no_publisher", "Received PD pull requests without publisher", TRUE, NULL,
+     EXPORT_VALUE(stats.pd.numNoPub)},
+    {"trdp_pd_timeouts", "PD subscription timeouts", TRUE, NULL, EXPORT_VALUE(stats.pd.numTimeout)},
+    {"trdp_pd_sent", "Sent PD packets", TRUE, NULL, EXPORT_VALUE(stats.pd.numSend)},
+    {"trdp_pd_missed", "PD packets missed by sequence counter", TRUE, NULL, EXPORT_VALUE(stats.pd.numMissed)},
+    {"trdp_md_listeners", "MD listeners", FALSE, "transport=\"udp\"", EXPORT_VALUE(stats.udpMd.numList)},
+    {"trdp_md_listeners", "MD listeners", FALSE, "transport=\"tcp\"", EXPORT_VALUE(stats.tcpMd.numList)},
+    {"trdp_md_received", "Received MD packets", TRUE, "transport=\"udp\"", EXPORT_VALUE(stats.udpMd.numRcv)},
+    {"trdp_md_received", "Received MD packets", TRUE, "transport=\"tcp\"", EXPORT_VALUE(stats.tcpMd.numRcv)},
+    {"trdp_md_crc_errors", "Received MD packets with CRC error", TRUE, "transport=\"udp\"",
+     EXPORT_VALUE(stats.udpMd.numCrcErr)},
+    {"trdp_md_crc_errors", "Received MD packets with CRC error", TRUE, "transport=\"tcp\"",
+     EXPORT_VALUE(stats.tcpMd.numCrcErr)},
+    {"trdp_md_protocol_errors", "Received MD packets with protocol error", TRUE, "transport=\"udp\"",
+     EXPORT_VALUE(stats.udpMd.numProtErr)},
+    {"trdp_md_protocol_errors", "Received MD packets with protocol error", TRUE, "transport=\"tcp\"",
+     EXPORT_VALUE(stats.tcpMd.numProtErr)},
+    {"trdp_md_topo_errors", "Received MD packets with wrong topography counter", TRUE, "transport=\"udp\"",
+     EXPORT_VALUE(stats.udpMd.numTopoErr)},
+    {"trdp_md_topo_errors", "Received MD packets with wrong topography counter", TRUE, "transport=\"tcp\"",
+     EXPORT_VALUE(stats.tcpMd.numTopoErr)},
+    {"trdp_md_no_listener", "Received MD packets without listener", TRUE, "transport=\"udp\"",
+     EXPORT_VALUE(stats.udpMd.numNoListener)},
+    {"trdp_md_no_listener", "Received MD packets without listener", TRUE, "transport=\"tcp\"",
+     EXPORT_VALUE(stats.tcpMd.numNoListener)},
+    {"trdp_md_reply_timeouts", "MD reply timeouts", TRUE, "transport=\"udp\"",
+     EXPORT_VALUE(stats.udpMd.numReplyTimeout)},
+    {"trdp_md_reply_timeouts", "MD reply timeouts", TRUE, "transport=\"tcp\"",
+     EXPORT_VALUE(stats.tcpMd.numReplyTimeout)},
+    {"trdp_md_confirm_timeouts", "MD confirm timeouts", TRUE, "transport=\"udp\"",
+     EXPORT_VALUE(stats.udpMd.numConfirmTimeout)},
+    {"trdp_md_confirm_timeouts", "MD confirm timeouts", TRUE, "transport=\"tcp\"",
+     EXPORT_VALUE(stats.tcpMd.numConfirmTimeout)},
+    {"trdp_md_sent", "Sent MD packets", TRUE, "transport=\"udp\"", EXPORT_VALUE(stats.udpMd.numSend)},
+    {"trdp_md_sent", "Sent MD packets", TRUE, "transport=\"tcp\"", EXPORT_VALUE(stats.tcpMd.numSend)},
+    {"trdp_tcp_connects", "New TCP caller connections", TRUE, NULL, EXPORT_VALUE(tcpConn.numConnect)},
+    {"trdp_tcp_reuses", "Requests sent over an open TCP connection", TRUE, NULL, EXPORT_VALUE(tcpConn.numReuse)},
+    {"trdp_tcp_idle_closes", "Idle TCP connections closed", TRUE, NULL, EXPORT_VALUE(tcpConn.numIdleClose)},
+    {"trdp_tcp_throttled", "MD messages refused, TCP send queue full", TRUE, NULL,
+     EXPORT_VALUE(tcpConn.numThrottled)},
+    {"trdp_tcp_open", "Open TCP caller connections", FALSE, NULL, EXPORT_VALUE(tcpConn.numOpen)},
+    {"trdp_tcp_idle", "Idle TCP caller connections", FALSE, NULL, EXPORT_VALUE(tcpConn.numIdle)}
+};
+
+static const CHAR8 *cSockTypeName[] = {"pd", "md_udp", "md_tcp"};
+
 /******************************************************************************
  *   Globals
  */
 
+#if TRDP_STATS_BLOCKS > 1
+__thread UINT32 trdp_statsThreadSlot = 0u;
+
+/**********************************************************************************************************************/
+/** Assign a counter block to the calling thread.
+ *  The threads are spread round robin over the blocks, the slot is the same in all sessions.
+ *
+ *  @retval         index of the counter block
+ */
+UINT32 trdp_statsNewSlot (void)
+{
+    UINT32 slot = __atomic_fetch_add(&sStatsNextSlot, 1u, __ATOMIC_RELAXED) % TRDP_STATS_BLOCKS;
+
+    trdp_statsThreadSlot = slot + 1u;
+    return slot;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Add the event counters of all counter blocks to the statistics.
+ *  The blocks are laid out as the statistics from pd on, the fields not counted in the blocks are 0 there.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pStatistics         the statistics to add to
+ */
+static void trdp_sumStats (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_STATISTICS_T   *pStatistics)
+{
+    UINT32          *pSum = (UINT32 *) &pStatistics->pd;
+    const UINT32    *pCnt;
+    unsigned int    block, i;
+
+    for (block = 0u; block < TRDP_STATS_BLOCKS; block++)
+    {
+        pCnt = (const UINT32 *) &appHandle->statsBlock[block].cnt;
+        for (i = 0u; i < sizeof(TRDP_STATS_CNT_T) / sizeof(UINT32); i++)
+        {
+#if TRDP_STATS_BLOCKS > 1
+            pSum[i] += __atomic_load_n(&pCnt[i], __ATOMIC_RELAXED);
+#else
+            pSum[i] += pCnt[i];
+#endif
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Clear the event counters of all counter blocks.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+static void trdp_clearStatsBlocks (
+    TRDP_APP_SESSION_T appHandle)
+{
+#if TRDP_STATS_BLOCKS > 1
+    UINT32          *pCnt;
+    unsigned int    block, i;
+
+    /*  Other threads may count meanwhile   */
+    for (block = 0u; block < TRDP_STATS_BLOCKS; block++)
+    {
+        pCnt = (UINT32 *) &appHandle->statsBlock[block].cnt;
+        for (i = 0u; i < sizeof(TRDP_STATS_CNT_T) / sizeof(UINT32); i++)
+        {
+            __atomic_store_n(&pCnt[i], 0u, __ATOMIC_RELAXED);
+        }
+    }
+#else
+    memset(appHandle->statsBlock, 0, sizeof(appHandle->statsBlock));
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Init statistics.
  *  Clear the stats structure for a session.
@@ -76,6 +291,7 @@ void trdp_initStats (
     }
 
     memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
+    trdp_clearStatsBlocks(appHandle);
 
     pVersion = tlc_getVersion();
     appHandle->stats.version = (UINT32) pVersion->ver << 24 | (UINT32) pVersion->rel << 16 |
@@ -102,16 +318,35 @@ void trdp_initStats (
 EXT_DECL TRDP_ERR_T tlc_resetStatistics (
     TRDP_APP_SESSION_T appHandle)
 {
-    TIMEDATE32 tempTime;
+    TIMEDATE32  tempTime;
+    UINT32      numSubs, numPub, numUdpList, numTcpList;
 
     if (!trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
     }
 
-    tempTime = appHandle->stats.upTime;
+    /*  Up time and the number of subscriptions, publishers and listeners are no counters, keep them */
+    tempTime    = appHandle->stats.upTime;
+    numSubs     = appHandle->stats.pd.numSubs;
+    numPub      = appHandle->stats.pd.numPub;
+    numUdpList  = appHandle->stats.udpMd.numList;
+    numTcpList  = appHandle->stats.tcpMd.numList;
     memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
-    appHandle->stats.upTime = tempTime;
+    appHandle->stats.upTime         = tempTime;
+    appHandle->stats.pd.numSubs     = numSubs;
+    appHandle->stats.pd.numPub      = numPub;
+    appHandle->stats.udpMd.numList  = numUdpList;
+    appHandle->stats.tcpMd.numList  = numTcpList;
+    trdp_clearStatsBlocks(appHandle);
+#if MD_SUPPORT
+    memset(&appHandle->tcpConnStats, 0, sizeof(TRDP_TCP_CONN_STATISTICS_T));
+#endif
+
+#if TRDP_TIMING_STATS
+    memset(&appHandle->timing, 0, sizeof(TRDP_TIMING_STATISTICS_T));
+    memset(appHandle->timingSum, 0, sizeof(appHandle->timingSum));
+#endif
 
     return TRDP_NO_ERR;
 }
@@ -142,10 +377,275 @@ EXT_DECL TRDP_ERR_T tlc_getStatistics (
     trdp_UpdateStats(appHandle);
 
     *pStatistics = appHandle->stats;
+    trdp_sumStats(appHandle, pStatistics);
 
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Return timing statistics.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to timing statistics for this application session
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getTimingStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_TIMING_STATISTICS_T    *pStatistics)
+{
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+#if TRDP_TIMING_STATS
+    {
+        unsigned int i;
+
+        *pStatistics = appHandle->timing;
+        for (i = 0u; i < TRDP_TIMING_CNT; i++)
+        {
+            if (pStatistics->hist[i].count > 0u)
+            {
+                pStatistics->hist[i].mean = (UINT32) (appHandle->timingSum[i] / pStatistics->hist[i].count / 1000u);
+            }
+        }
+    }
+#else
+    memset(pStatistics, 0, sizeof(TRDP_TIMING_STATISTICS_T));
+#endif
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return the send slot usage of the traffic shaping.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the slot usage of this application session
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getShapingStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_SHAPING_STATISTICS_T   *pStatistics)
+{
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    memset(pStatistics, 0, sizeof(TRDP_SHAPING_STATISTICS_T));
+    if (appHandle->shaping.pLoad != NULL)
+    {
+        pStatistics->slotTime       = appHandle->shaping.slotTime;
+        pStatistics->slotCnt        = appHandle->shaping.slotCnt;
+        pStatistics->numPub         = appHandle->shaping.numPub;
+        pStatistics->avgLoad        = (UINT32) (appHandle->shaping.totalLoad / appHandle->shaping.slotCnt);
+        pStatistics->peakLoad       = appHandle->shaping.peakLoad;
+        pStatistics->peakBandwidth  = (UINT32) ((UINT64) appHandle->shaping.peakLoad * 8000u /
+                                                appHandle->shaping.slotTime);
+    }
+
+    (void) trdp_sessionUnlock(appHandle);
+
+    return TRDP_NO_ERR;
+}
+
+#if TRDP_TIMING_STATS
+#if TRDP_TIMING_TSC && defined(__x86_64__)
+/* ns per TSC tick as 32.32 fixed point, 0 until calibrated */
+static UINT64 sTscNsPerTick = 0u;
+#endif
+
+/**********************************************************************************************************************/
+/** Prepare the timing time stamps.
+ *  With TRDP_TIMING_TSC the time stamp counter is calibrated against the monotonic clock once.
+ */
+void trdp_timingInit (void)
+{
+#if TRDP_TIMING_TSC && defined(__x86_64__)
+    TRDP_TIME_T t0, t1;
+    UINT64      c0, c1, ns;
+
+    if (sTscNsPerTick != 0u)
+    {
+        return;
+    }
+    vos_getTime(&t0);
+    c0 = __builtin_ia32_rdtsc();
+    (void) vos_threadDelay(2000u);
+    vos_getTime(&t1);
+    c1 = __builtin_ia32_rdtsc();
+    vos_subTime(&t1, &t0);
+    ns = (UINT64) t1.tv_sec * 1000000000u + (UINT64) t1.tv_usec * 1000u;
+    if (c1 > c0)
+    {
+        sTscNsPerTick = (UINT64) (((unsigned __int128) ns << 32) / (c1 - c0));
+    }
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Return a time stamp in ns for timing statistics.
+ *  Only differences of time stamps are meaningful. With TRDP_TIMING_TSC on x86-64 the time stamp counter is read,
+ *  which resolves well below 1us and costs a few ns; else the monotonic clock is read.
+ *
+ *  @retval         time stamp in ns
+ */
+UINT64 trdp_timingStamp (void)
+{
+    TRDP_TIME_T now;
+
+#if TRDP_TIMING_TSC && defined(__x86_64__)
+    if (sTscNsPerTick != 0u)
+    {
+        return (UINT64) (((unsigned __int128) __builtin_ia32_rdtsc() * sTscNsPerTick) >> 32);
+    }
+#endif
+    vos_getTime(&now);
+    return (UINT64) now.tv_sec * 1000000000u + (UINT64) now.tv_usec * 1000u;
+}
+
+/**********************************************************************************************************************/
+/** Add a duration to a timing histogram.
+ *  Negative durations (clock adjustments) are counted as 0.
+ *
+ *  @param[in]      appHandle           the session
+ *  @param[in]      id                  histogram index (TRDP_TIMING_PROCESS...)
+ *  @param[in]      pFrom               start of the measured duration
+ *  @param[in]      pTo                 end of the measured duration
+ */
+void trdp_timingAdd (
+    TRDP_SESSION_PT     appHandle,
+    UINT32              id,
+    const TRDP_TIME_T   *pFrom,
+    const TRDP_TIME_T   *pTo)
+{
+    INT64 diff;
+
+    diff = ((INT64) pTo->tv_sec - (INT64) pFrom->tv_sec) * 1000000 + ((INT64) pTo->tv_usec - (INT64) pFrom->tv_usec);
+    trdp_timingAddNs(appHandle, id, (diff > 0) ? (UINT64) diff * 1000u : 0u);
+}
+
+/**********************************************************************************************************************/
+/** Add a duration in ns to a timing histogram.
+ *  The histogram counts us, the mean is kept from the ns values.
+ *
+ *  @param[in]      appHandle           the session
+ *  @param[in]      id                  histogram index (TRDP_TIMING_PROCESS...)
+ *  @param[in]      ns                  measured duration
+ */
+void trdp_timingAddNs (
+    TRDP_SESSION_PT     appHandle,
+    UINT32              id,
+    UINT64              ns)
+{
+    TRDP_TIMING_HIST_T  *pHist  = &appHandle->timing.hist[id];
+    UINT32              usec;
+    UINT32              idx;
+    UINT32              exp;
+
+    /*  Time stamps of different CPUs may be slightly apart  */
+    if (ns > ((UINT64) 1u << 62))
+    {
+        ns = 0u;
+    }
+    usec = (ns / 1000u > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) (ns / 1000u);
+
+    /*  Two buckets per power of two: the exponent and the next bit below the leading one */
+    if (usec < 4u)
+    {
+        idx = usec;
+    }
+    else
+    {
+        exp = 2u;
+        while ((usec >> (exp + 1u)) != 0u)
+        {
+            exp++;
+        }
+        idx = 4u + 2u * (exp - 2u) + ((usec >> (exp - 1u)) & 1u);
+        if (idx >= TRDP_TIMING_BUCKETS)
+        {
+            idx = TRDP_TIMING_BUCKETS - 1u;
+        }
+    }
+
+    if ((pHist->count == 0u) || (usec < pHist->min))
+    {
+        pHist->min = usec;
+    }
+    if (usec > pHist->max)
+    {
+        pHist->max = usec;
+    }
+    pHist->count++;
+    pHist->bucket[idx]++;
+    appHandle->timingSum[id] += ns;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Fill the statistics of one subscription.
+ *
+ *  @param[in]      pElement            the subscription
+ *  @param[out]     pStatistics         the statistics entry to fill
+ */
+static void trdp_fillSubsStatistics (
+    const PD_ELE_T          *pElement,
+    TRDP_SUBS_STATISTICS_T  *pStatistics)
+{
+    pStatistics->comId      = pElement->addr.comId;                      /* Subscribed ComId            */
+    pStatistics->joinedAddr = pElement->addr.mcGroup;                    /* Joined IP address           */
+    pStatistics->filterAddr = pElement->addr.srcIpAddr;                  /* Filter IP address           */
+    pStatistics->callBack   = (pElement->pfCbFunction == NULL) ? 0 : 1;  /* > 0 if call back function is used */
+    pStatistics->userRef    = (pElement->pUserRef == NULL) ? 0 : 1;      /* > 0 if user reference if used  */
+    pStatistics->timeout    = (UINT32) pElement->interval.tv_usec + (UINT32) pElement->interval.tv_sec * 1000000;
+    /* Time-out value in us. 0 = No time-out supervision  */
+    pStatistics->toBehav    = pElement->toBehavior;     /* Behavior at time-out    */
+    pStatistics->numRecv    = pElement->numRxTx;        /* Number of packets received for this subscription.  */
+    pStatistics->numMissed  = pElement->numMissed;      /* Number of packets missed for this subscription.    */
+    pStatistics->status     = pElement->lastErr;        /* Receive status information  */
+}
+
+/**********************************************************************************************************************/
+/** Fill the statistics of one publisher.
+ *
+ *  @param[in]      pElement            the publisher
+ *  @param[out]     pStatistics         the statistics entry to fill
+ */
+static void trdp_fillPubStatistics (
+    const PD_ELE_T          *pElement,
+    TRDP_PUB_STATISTICS_T   *pStatistics)
+{
+    pStatistics->comId      = pElement->addr.comId;         /* Published ComId                                */
+    pStatistics->destAddr   = pElement->addr.destIpAddr;    /* IP address of destination for this publishing. */
+    pStatistics->redId      = pElement->redId;              /* Redundancy group id                            */
+    pStatistics->redState   = trdp_pdIsFollower(pElement) ? 1 : 0;  /* Redundancy state: 1 = Follower, 0 = Leader */
+    pStatistics->cycle      = (UINT32) pElement->interval.tv_usec + (UINT32) pElement->interval.tv_sec * 1000000;
+    /* Interval/cycle in us. 0 = No time-out supervision */
+    pStatistics->numSend    = pElement->numRxTx;            /* Number of packets sent for this publisher.       */
+    pStatistics->numPut     = pElement->updPkts;            /* Updated packets (via put)                        */
+}
+
 /**********************************************************************************************************************/
 /** Return PD subscription statistics.
  *  Memory for statistics information must be provided by the user.
@@ -163,10 +663,38 @@ EXT_DECL TRDP_ERR_T tlc_getSubsStatistics (
     TRDP_APP_SESSION_T      appHandle,
     UINT16                  *pNumSubs,
     TRDP_SUBS_STATISTICS_T  *pStatistics)
+{
+    return tlc_getSubsStatisticsPage(appHandle, 0u, 0u, pNumSubs, pStatistics);
+}
+
+/**********************************************************************************************************************/
+/** Return a page of the PD subscription statistics.
+ *  The session is locked while the page is copied only, a tool may fetch the statistics of many subscriptions
+ *  page by page without delaying tlc_process() for long. With a comId given, only the subscriptions of this comId
+ *  are returned (and, with TRDP_PD_SUB_HASH_SIZE, only these are looked at).
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      startIdx            number of (matching) subscriptions to skip
+ *  @param[in]      comId               return subscriptions of this comId only, 0 = all
+ *  @param[in,out]  pNumSubs            In: The number of subscriptions requested
+ *                                      Out: Number of subscriptions returned
+ *  @param[out]     pStatistics         Pointer to an array with the subscription statistics information
+ *  @retval         TRDP_NO_ERR         no error, no more subscriptions
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more subscriptions, continue at startIdx + *pNumSubs
+ */
+EXT_DECL TRDP_ERR_T tlc_getSubsStatisticsPage (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT16                  startIdx,
+    UINT32                  comId,
+    UINT16                  *pNumSubs,
+    TRDP_SUBS_STATISTICS_T  *pStatistics)
 {
     TRDP_ERR_T  err = TRDP_NO_ERR;
     PD_ELE_T    *iter;
-    UINT16      lIndex;
+    UINT16      lIndex  = 0u;
+    UINT32      skip    = startIdx;
 
     if (!trdp_isValidSession(appHandle))
     {
@@ -177,25 +705,61 @@ EXT_DECL TRDP_ERR_T tlc_getSubsStatistics (
     {
         return TRDP_PARAM_ERR;
     }
-    /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
-    for (lIndex = 0, iter = appHandle->pRcvQueue; lIndex < *pNumSubs && iter != NULL; lIndex++, iter = iter->pNext)
-    {
-        pStatistics[lIndex].comId       = iter->addr.comId;     /* Subscribed ComId            */
-        pStatistics[lIndex].joinedAddr  = iter->addr.mcGroup;   /* Joined IP address           */
-        pStatistics[lIndex].filterAddr  = iter->addr.srcIpAddr; /* Filter IP address           */
-        pStatistics[lIndex].callBack    = (iter->pfCbFunction == NULL)? 0 : 1;      /* > 0 if call back function is used */
-        pStatistics[lIndex].userRef     = (iter->pUserRef == NULL) ? 0 : 1;         /* > 0 if user reference if used  */
-        pStatistics[lIndex].timeout     = (UINT32) iter->interval.tv_usec + (UINT32) iter->interval.tv_sec * 1000000;
-        /* Time-out value in us. 0 = No time-out supervision  */
-        pStatistics[lIndex].toBehav     = iter->toBehavior;     /* Behavior at time-out    */
-        pStatistics[lIndex].numRecv     = iter->numRxTx;        /* Number of packets received for this subscription.  */
-        pStatistics[lIndex].numMissed   = iter->numMissed;      /* Number of packets received for this subscription.  */
-        pStatistics[lIndex].status      = iter->lastErr;        /* Receive status information  */
-    }
-    if (lIndex >= *pNumSubs && iter != NULL)
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        err = TRDP_MEM_ERR;
+        return TRDP_NOINIT_ERR;
     }
+
+#if TRDP_PD_SUB_HASH_SIZE > 0
+    if (comId != 0u)
+    {
+        /*  The comId bucket keeps the order of the receive queue   */
+        for (iter = appHandle->pRcvHash[TRDP_SUB_HASH(comId)]; iter != NULL; iter = iter->pNextHash)
+        {
+            if (iter->addr.comId != comId)
+            {
+                continue;
+            }
+            if (skip > 0u)
+            {
+                skip--;
+                continue;
+            }
+            if (lIndex >= *pNumSubs)
+            {
+                err = TRDP_MEM_ERR;
+                break;
+            }
+            trdp_fillSubsStatistics(iter, &pStatistics[lIndex++]);
+        }
+    }
+    else
+#endif
+    {
+        /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
+        for (iter = appHandle->pRcvQueue; iter != NULL; iter = iter->pNext)
+        {
+            if ((comId != 0u) && (iter->addr.comId != comId))
+            {
+                continue;
+            }
+            if (skip > 0u)
+            {
+                skip--;
+                continue;
+            }
+            if (lIndex >= *pNumSubs)
+            {
+                err = TRDP_MEM_ERR;
+                break;
+            }
+            trdp_fillSubsStatistics(iter, &pStatistics[lIndex++]);
+        }
+    }
+
+    (void) vos_mutexUnlock(appHandle->mutex);
+
     *pNumSubs = lIndex;
     return err;
 }
@@ -216,10 +780,36 @@ EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
     TRDP_APP_SESSION_T      appHandle,
     UINT16                  *pNumPub,
     TRDP_PUB_STATISTICS_T   *pStatistics)
+{
+    return tlc_getPubStatisticsPage(appHandle, 0u, 0u, pNumPub, pStatistics);
+}
+
+/**********************************************************************************************************************/
+/** Return a page of the PD publish statistics.
+ *  The session is locked while the page is copied only.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      startIdx            number of (matching) publishers to skip
+ *  @param[in]      comId               return publishers of this comId only, 0 = all
+ *  @param[in,out]  pNumPub             In: The number of publishers requested
+ *                                      Out: Number of publishers returned
+ *  @param[out]     pStatistics         Pointer to a list with the publish statistics information
+ *  @retval         TRDP_NO_ERR         no error, no more publishers
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more publishers, continue at startIdx + *pNumPub
+ */
+EXT_DECL TRDP_ERR_T tlc_getPubStatisticsPage (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT16                  startIdx,
+    UINT32                  comId,
+    UINT16                  *pNumPub,
+    TRDP_PUB_STATISTICS_T   *pStatistics)
 {
     TRDP_ERR_T  err = TRDP_NO_ERR;
     PD_ELE_T    *iter;
-    UINT16      lIndex;
+    UINT16      lIndex  = 0u;
+    UINT32      skip    = startIdx;
 
     if (!trdp_isValidSession(appHandle))
     {
@@ -231,25 +821,33 @@ EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
         return TRDP_PARAM_ERR;
     }
 
-    /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
-    for (lIndex = 0, iter = appHandle->pSndQueue; lIndex < *pNumPub && iter != NULL; lIndex++, iter = iter->pNext)
+    if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
     {
-        pStatistics[lIndex].comId       = iter->addr.comId;         /* Published ComId                                */
-        pStatistics[lIndex].destAddr    = iter->addr.destIpAddr;    /* IP address of destination for this publishing. */
-        pStatistics[lIndex].redId       = iter->redId;              /* Redundancy group id                            */
-        pStatistics[lIndex].redState    = (iter->privFlags & TRDP_REDUNDANT) ? 1 : 0; /* Redundancy state:
-                                                                                        1 = Follower
-                                                                                        0 = Leader                  */
-
-        pStatistics[lIndex].cycle = (UINT32) iter->interval.tv_usec + (UINT32)iter->interval.tv_sec * 1000000;
-        /* Interval/cycle in us. 0 = No time-out supervision */
-        pStatistics[lIndex].numSend = iter->numRxTx;            /* Number of packets sent for this publisher.       */
-        pStatistics[lIndex].numPut  = iter->updPkts;            /* Updated packets (via put)                        */
+        return TRDP_NOINIT_ERR;
     }
-    if (lIndex >= *pNumPub && iter != NULL)
+
+    /*  Loop over our publishers, but do not exceed user supplied buffers!    */
+    for (iter = appHandle->pSndQueue; iter != NULL; iter = iter->pNext)
     {
-        err = TRDP_MEM_ERR;
+        if ((comId != 0u) && (iter->addr.comId != comId))
+        {
+            continue;
+        }
+        if (skip > 0u)
+        {
+            skip--;
+            continue;
+        }
+        if (lIndex >= *pNumPub)
+        {
+            err = TRDP_MEM_ERR;
+            break;
+        }
+        trdp_fillPubStatistics(iter, &pStatistics[lIndex++]);
     }
+
+    (void) trdp_sessionUnlock(appHandle);
+
     *pNumPub = lIndex;
     return err;
 }
@@ -349,6 +947,85 @@ EXT_DECL TRDP_ERR_T tlc_getTcpListStatistics (
     *pNumList = lIndex;
     return TRDP_NO_ERR;
 }
+
+
+/**********************************************************************************************************************/
+/** Return the usage statistics of the TCP caller connections.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the connection statistics
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getTcpConnStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_TCP_CONN_STATISTICS_T  *pStatistics)
+{
+    INT32 lIndex;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    *pStatistics            = appHandle->tcpConnStats;
+    pStatistics->numOpen    = 0u;
+    pStatistics->numIdle    = 0u;
+    pStatistics->queuedBytes    = 0u;
+
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    {
+        if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP))
+        {
+            pStatistics->queuedBytes += appHandle->iface[lIndex].tcpParams.queuedBytes;
+        }
+        if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
+            && (appHandle->iface[lIndex].rcvMostly == FALSE))
+        {
+            pStatistics->numOpen++;
+            if (appHandle->iface[lIndex].usage == 0)
+            {
+                pStatistics->numIdle++;
+            }
+        }
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return the usage statistics of the MD element and frame pool.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the pool statistics
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getMdPoolStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_MD_POOL_STATISTICS_T   *pStatistics)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    *pStatistics = appHandle->mdPoolStats;
+    return TRDP_NO_ERR;
+}
 #endif
 
 /**********************************************************************************************************************/
@@ -381,7 +1058,7 @@ EXT_DECL TRDP_ERR_T tlc_getRedStatistics (
         if (iterPD->redId != 0)         /* redundant ID set?    */
         {
             pStatistics->id = iterPD->redId;
-            if (iterPD->privFlags & TRDP_REDUNDANT)
+            if (trdp_pdIsFollower(iterPD))
             {
                 pStatistics->state = TRDP_RED_FOLLOWER;
             }
@@ -453,8 +1130,7 @@ EXT_DECL TRDP_ERR_T tlc_getJoinStatistics (
 void    trdp_UpdateStats (
     TRDP_APP_SESSION_T appHandle)
 {
-    PD_ELE_T        *iter;
-    UINT16          lIndex, llIndex;
+    UINT16          lIndex;
     VOS_ERR_T       ret;
     VOS_TIMEVAL_T   temp, temp2;
     TIMEDATE32      diff;
@@ -487,35 +1163,14 @@ void    trdp_UpdateStats (
         vos_printLog(VOS_LOG_ERROR, "vos_memCount() failed (Err: %d)\n", ret);
     }
 
-    appHandle->stats.pd.numMissed = 0u;
-
-    /*  Count our subscriptions */
-    for (lIndex = 0u, iter = appHandle->pRcvQueue; iter != NULL; lIndex++, iter = iter->pNext)
-    {
-        appHandle->stats.pd.numMissed += iter->numMissed;
-    }
-
-    appHandle->stats.pd.numSubs = lIndex;
-
-    /*  Count our publishers */
-    for (lIndex = 0u, iter = appHandle->pSndQueue; iter != NULL; lIndex++, iter = iter->pNext)
-    {
-        ;
-    }
-
-    appHandle->stats.pd.numPub = lIndex;
+    /*  numSubs and numPub are kept up to date by (un)subscribe and (un)publish, the event counters are summed up
+        from the counter blocks by the caller  */
 
     /*  Count our joins */
     appHandle->stats.numJoin = 0u;
     for (lIndex = 0u; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
     {
-        for (llIndex = 0u; llIndex < VOS_MAX_MULTICAST_CNT; llIndex++)
-        {
-            if (appHandle->iface[lIndex].mcGroups[llIndex] != 0u)
-            {
-                appHandle->stats.numJoin++;
-            }
-        }
+        appHandle->stats.numJoin += appHandle->iface[lIndex].mcJoinCnt;
     }
 
 }
@@ -531,6 +1186,7 @@ void    trdp_pdPrepareStats (
     PD_ELE_T            *pPacket)
 {
     TRDP_STATISTICS_T   *pData;
+    UINT32              *pWord;
     unsigned int        i;
 
     if (pPacket == NULL || appHandle == NULL)
@@ -540,83 +1196,499 @@ void    trdp_pdPrepareStats (
 
     trdp_UpdateStats(appHandle);
 
-    /*  The statistics structure is naturally aligned - all 32 Bits, we can cast and just eventually swap the values! */
+    /*  The statistics structure is naturally aligned - all 32 Bits but the two labels, we can copy it and just
+        swap the words before and after the labels in place   */
 
     pData = (TRDP_STATISTICS_T *) pPacket->pFrame->data;
+    *pData = appHandle->stats;
+    trdp_sumStats(appHandle, pData);
 
-    /*  Fill in the values  */
-    pData->version = vos_htonl(appHandle->stats.version);
-    pData->timeStamp.tv_sec     = (UINT32)vos_htonl((UINT32)appHandle->stats.timeStamp.tv_sec);
-    pData->timeStamp.tv_usec    = (INT32)vos_htonl((UINT32)appHandle->stats.timeStamp.tv_usec);
-    pData->upTime           = vos_htonl(appHandle->stats.upTime);
-    pData->statisticTime    = vos_htonl(appHandle->stats.statisticTime);
-    pData->ownIpAddr        = vos_htonl(appHandle->stats.ownIpAddr);
-    pData->leaderIpAddr     = vos_htonl(appHandle->stats.leaderIpAddr);
-    pData->processPrio      = vos_htonl(appHandle->stats.processPrio);
-    pData->processCycle     = vos_htonl(appHandle->stats.processCycle);
-    vos_strncpy(pData->hostName, appHandle->stats.hostName, TRDP_MAX_LABEL_LEN - 1);
-    vos_strncpy(pData->leaderName, appHandle->stats.leaderName, TRDP_MAX_LABEL_LEN - 1);
-
-    /*  Memory  */
-    pData->mem.total            = vos_htonl(appHandle->stats.mem.total);
-    pData->mem.free             = vos_htonl(appHandle->stats.mem.free);
-    pData->mem.minFree          = vos_htonl(appHandle->stats.mem.minFree);
-    pData->mem.numAllocBlocks   = vos_htonl(appHandle->stats.mem.numAllocBlocks);
-    pData->mem.numAllocErr      = vos_htonl(appHandle->stats.mem.numAllocErr);
-    pData->mem.numFreeErr       = vos_htonl(appHandle->stats.mem.numFreeErr);
-
-    for (i = 0; i < VOS_MEM_NBLOCKSIZES; i++)
-    {
-        pData->mem.blockSize[i]     = vos_htonl(appHandle->stats.mem.blockSize[i]);
-        pData->mem.usedBlockSize[i] = vos_htonl(appHandle->stats.mem.usedBlockSize[i]);
-    }
-
-    /* Process data */
-    pData->pd.defQos        = vos_htonl(appHandle->stats.pd.defQos);
-    pData->pd.defTtl        = vos_htonl(appHandle->stats.pd.defTtl);
-    pData->pd.defTimeout    = vos_htonl(appHandle->stats.pd.defTimeout);
-    pData->pd.numSubs       = vos_htonl(appHandle->stats.pd.numSubs);
-    pData->pd.numPub        = vos_htonl(appHandle->stats.pd.numPub);
-    pData->pd.numRcv        = vos_htonl(appHandle->stats.pd.numRcv);
-    pData->pd.numCrcErr     = vos_htonl(appHandle->stats.pd.numCrcErr);
-    pData->pd.numProtErr    = vos_htonl(appHandle->stats.pd.numProtErr);
-    pData->pd.numTopoErr    = vos_htonl(appHandle->stats.pd.numTopoErr);
-    pData->pd.numNoSubs     = vos_htonl(appHandle->stats.pd.numNoSubs);
-    pData->pd.numNoPub      = vos_htonl(appHandle->stats.pd.numNoPub);
-    pData->pd.numTimeout    = vos_htonl(appHandle->stats.pd.numTimeout);
-    pData->pd.numSend       = vos_htonl(appHandle->stats.pd.numSend);
-    pData->pd.numMissed     = vos_htonl(appHandle->stats.pd.numMissed);
-
-    /* Message data */
-    pData->udpMd.defQos = vos_htonl(appHandle->stats.udpMd.defQos);
-    pData->udpMd.defTtl = vos_htonl(appHandle->stats.udpMd.defTtl);
-    pData->udpMd.defReplyTimeout    = vos_htonl(appHandle->stats.udpMd.defReplyTimeout);
-    pData->udpMd.defConfirmTimeout  = vos_htonl(appHandle->stats.udpMd.defConfirmTimeout);
-    pData->udpMd.numList            = vos_htonl(appHandle->stats.udpMd.numList);
-    pData->udpMd.numRcv             = vos_htonl(appHandle->stats.udpMd.numRcv);
-    pData->udpMd.numCrcErr          = vos_htonl(appHandle->stats.udpMd.numCrcErr);
-    pData->udpMd.numProtErr         = vos_htonl(appHandle->stats.udpMd.numProtErr);
-    pData->udpMd.numTopoErr         = vos_htonl(appHandle->stats.udpMd.numTopoErr);
-    pData->udpMd.numNoListener      = vos_htonl(appHandle->stats.udpMd.numNoListener);
-    pData->udpMd.numReplyTimeout    = vos_htonl(appHandle->stats.udpMd.numReplyTimeout);
-    pData->udpMd.numConfirmTimeout  = vos_htonl(appHandle->stats.udpMd.numConfirmTimeout);
-    pData->udpMd.numSend            = vos_htonl(appHandle->stats.udpMd.numSend);
-
-    pData->tcpMd.defQos = vos_htonl(appHandle->stats.tcpMd.defQos);
-    pData->tcpMd.defTtl = vos_htonl(appHandle->stats.tcpMd.defTtl);
-    pData->tcpMd.defReplyTimeout    = vos_htonl(appHandle->stats.tcpMd.defReplyTimeout);
-    pData->tcpMd.defConfirmTimeout  = vos_htonl(appHandle->stats.tcpMd.defConfirmTimeout);
-    pData->tcpMd.numList            = vos_htonl(appHandle->stats.tcpMd.numList);
-    pData->tcpMd.numRcv             = vos_htonl(appHandle->stats.tcpMd.numRcv);
-    pData->tcpMd.numCrcErr          = vos_htonl(appHandle->stats.tcpMd.numCrcErr);
-    pData->tcpMd.numProtErr         = vos_htonl(appHandle->stats.tcpMd.numProtErr);
-    pData->tcpMd.numTopoErr         = vos_htonl(appHandle->stats.tcpMd.numTopoErr);
-    pData->tcpMd.numNoListener      = vos_htonl(appHandle->stats.tcpMd.numNoListener);
-    pData->tcpMd.numReplyTimeout    = vos_htonl(appHandle->stats.tcpMd.numReplyTimeout);
-    pData->tcpMd.numConfirmTimeout  = vos_htonl(appHandle->stats.tcpMd.numConfirmTimeout);
-    pData->tcpMd.numSend            = vos_htonl(appHandle->stats.tcpMd.numSend);
+    pWord = (UINT32 *) pData;
+    for (i = 0; i < offsetof(TRDP_STATISTICS_T, hostName) / sizeof(UINT32); i++)
+    {
+        pWord[i] = vos_htonl(pWord[i]);
+    }
+    for (i = offsetof(TRDP_STATISTICS_T, ownIpAddr) / sizeof(UINT32);
+         i < sizeof(TRDP_STATISTICS_T) / sizeof(UINT32);
+         i++)
+    {
+        pWord[i] = vos_htonl(pWord[i]);
+    }
     pPacket->dataSize = sizeof(TRDP_STATISTICS_T);
 
+#if TRDP_TIMING_STATS
+    /*  The timing histograms are appended, if the packet was published with room for them */
+    if (((appHandle->option & TRDP_OPTION_TIMING_STATS) != 0u) &&
+        (pPacket->grossSize >= trdp_packetSizePD(sizeof(TRDP_STATISTICS_T) + sizeof(TRDP_TIMING_STATISTICS_T))))
+    {
+        TRDP_TIMING_STATISTICS_T    timing;
+        UINT32                      *pSrc = (UINT32 *) &timing;
+        UINT32                      *pDst = (UINT32 *) (pPacket->pFrame->data + sizeof(TRDP_STATISTICS_T));
+
+        (void) tlc_getTimingStatistics(appHandle, &timing);
+        for (i = 0; i < sizeof(TRDP_TIMING_STATISTICS_T) / sizeof(UINT32); i++)
+        {
+            pDst[i] = vos_htonl(pSrc[i]);
+        }
+        pPacket->dataSize += sizeof(TRDP_TIMING_STATISTICS_T);
+    }
+#endif
+    pPacket->pFrame->frameHead.datasetLength = vos_htonl(pPacket->dataSize);
+
     /* mark the data as valid */
     pPacket->privFlags = (TRDP_PRIV_FLAGS_T) (pPacket->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
 }
+
+/**********************************************************************************************************************/
+/** Export the statistics of a session to shared memory.
+ *  A snapshot of the session, memory, subscription, publisher and socket statistics is written to the shared memory
+ *  area pName by tlc_process() every interval ms. Other processes read it with tlc_getExportedMetrics() without
+ *  touching the session, e.g. a sidecar serving the metrics to a central scraper.
+ *  At most TRDP_EXPORT_MAX_ELE subscriptions and publishers are exported. The area is removed when the export is
+ *  stopped (pName NULL) or the session is closed.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pName               name of the shared memory area (e.g. "/trdp-stats"), NULL to stop the export
+ *  @param[in]      interval            export interval in ms, 0 = 1s
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_MEM_ERR        shared memory not available
+ */
+EXT_DECL TRDP_ERR_T tlc_exportStatistics (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pName,
+    UINT32              interval)
+{
+    TRDP_ERR_T          err = TRDP_NO_ERR;
+    TRDP_EXPORT_HEAD_T  *pHead;
+    VOS_SHRD_T          shm;
+    UINT8               *pArea;
+    UINT32              size;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (trdp_sessionLock(appHandle) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_exportStop(appHandle);
+
+    if (pName != NULL)
+    {
+        size = sizeof(TRDP_EXPORT_HEAD_T) + TRDP_EXPORT_MAX_ELE *
+            (sizeof(TRDP_SUBS_STATISTICS_T) + sizeof(TRDP_PUB_STATISTICS_T)) +
+            VOS_MAX_SOCKET_CNT * sizeof(TRDP_EXPORT_SOCK_T);
+
+        if (vos_sharedOpen(pName, &shm, &pArea, &size) != VOS_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "Statistics export to %s failed\n", pName);
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            pHead           = (TRDP_EXPORT_HEAD_T *) pArea;
+            pHead->version  = TRDP_EXPORT_VERSION;
+            pHead->size     = size;
+            pHead->maxEle   = TRDP_EXPORT_MAX_ELE;
+
+            if (interval == 0u)
+            {
+                interval = TRDP_EXPORT_INTERVAL;
+            }
+            appHandle->exportInterval.tv_sec    = interval / 1000u;
+            appHandle->exportInterval.tv_usec   = (INT32) (interval % 1000u) * 1000;
+            appHandle->pExportShm               = shm;
+            appHandle->pExport                  = pArea;
+
+            /*  Readers may find the area as soon as the first snapshot is there    */
+            vos_clearTime(&appHandle->nextExport);
+            trdp_exportStats(appHandle);
+            EXPORT_SEQ_STORE(&pHead->magic, TRDP_EXPORT_MAGIC);
+        }
+    }
+
+    (void) trdp_sessionUnlock(appHandle);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Stop the statistics export of a session and remove the export area.
+ *
+ *  @param[in]      appHandle           the session
+ */
+void trdp_exportStop (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pExport != NULL)
+    {
+        (void) vos_sharedClose(appHandle->pExportShm, appHandle->pExport);
+        appHandle->pExport      = NULL;
+        appHandle->pExportShm   = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write a snapshot of the statistics to the export area, if due.
+ *  Called by tlc_process() or tlc_processTimeouts() with the session locked.
+ *
+ *  @param[in]      appHandle           the session
+ */
+void trdp_exportStats (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_EXPORT_HEAD_T      *pHead;
+    TRDP_SUBS_STATISTICS_T  *pSubs;
+    TRDP_PUB_STATISTICS_T   *pPub;
+    TRDP_EXPORT_SOCK_T      *pSock;
+    PD_ELE_T                *iter;
+    TRDP_TIME_T             now;
+    UINT32                  seq;
+    UINT32                  i;
+    INT32                   lIndex;
+
+    if (appHandle->pExport == NULL)
+    {
+        return;
+    }
+    vos_getTime(&now);
+    if (timercmp(&now, &appHandle->nextExport, <))
+    {
+        return;
+    }
+    appHandle->nextExport = now;
+    vos_addTime(&appHandle->nextExport, &appHandle->exportInterval);
+
+    pHead   = (TRDP_EXPORT_HEAD_T *) appHandle->pExport;
+    pSubs   = (TRDP_SUBS_STATISTICS_T *) (pHead + 1);
+    pPub    = (TRDP_PUB_STATISTICS_T *) (pSubs + pHead->maxEle);
+    pSock   = (TRDP_EXPORT_SOCK_T *) (pPub + pHead->maxEle);
+
+    seq = pHead->seq + 1u;
+    EXPORT_SEQ_STORE(&pHead->seq, seq);
+    EXPORT_SEQ_FENCE();
+
+    trdp_UpdateStats(appHandle);
+    pHead->stats = appHandle->stats;
+    trdp_sumStats(appHandle, &pHead->stats);
+    pHead->stats.timeStamp.tv_sec   = (UINT32) now.tv_sec;
+    pHead->stats.timeStamp.tv_usec  = (INT32) now.tv_usec;
+#if MD_SUPPORT
+    (void) tlc_getTcpConnStatistics(appHandle, &pHead->tcpConn);
+#endif
+
+    for (i = 0u, iter = appHandle->pRcvQueue; (iter != NULL) && (i < pHead->maxEle); iter = iter->pNext)
+    {
+        trdp_fillSubsStatistics(iter, &pSubs[i++]);
+    }
+    pHead->numSubs = i;
+
+    i = 0u;
+    if (vos_mutexLock(appHandle->sndMutex) == VOS_NO_ERR)
+    {
+        for (iter = appHandle->pSndQueue; (iter != NULL) && (i < pHead->maxEle); iter = iter->pNext)
+        {
+            trdp_fillPubStatistics(iter, &pPub[i++]);
+        }
+        (void) vos_mutexUnlock(appHandle->sndMutex);
+    }
+    pHead->numPub = i;
+
+    for (i = 0u, lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    {
+        if (appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
+        {
+            pSock[i].type           = (UINT32) appHandle->iface[lIndex].type;
+            pSock[i].bindAddr       = appHandle->iface[lIndex].bindAddr;
+            pSock[i].usage          = (UINT32) appHandle->iface[lIndex].usage;
+            pSock[i].mcJoinCnt      = appHandle->iface[lIndex].mcJoinCnt;
+            pSock[i].queuedBytes    = appHandle->iface[lIndex].tcpParams.queuedBytes;
+            pSock[i].rxDrops        = appHandle->iface[lIndex].rxDrops;
+            pSock[i].rcvBufSize     = appHandle->iface[lIndex].rcvBufSize;
+            i++;
+        }
+    }
+    pHead->numSock = i;
+
+    EXPORT_SEQ_STORE(&pHead->seq, seq + 1u);
+}
+
+/**********************************************************************************************************************/
+/** Append a line to the metrics text.
+ *
+ *  @param[in,out]  pBuf                the output
+ *  @param[in]      pLine               the line
+ */
+static void trdp_metricsAppend (
+    TRDP_METRICS_BUF_T  *pBuf,
+    const CHAR8         *pLine)
+{
+    UINT32 len = (UINT32) strlen(pLine);
+
+    if (pBuf->len + len < pBuf->size)
+    {
+        memcpy(pBuf->pText + pBuf->len, pLine, len);
+    }
+    pBuf->len += len;
+}
+
+/**********************************************************************************************************************/
+/** Append the header lines of a metric family.
+ *
+ *  @param[in,out]  pBuf                the output
+ *  @param[in]      pName               family name
+ *  @param[in]      pHelp               description
+ *  @param[in]      counter             TRUE: counter, FALSE: gauge
+ */
+static void trdp_metricsFamily (
+    TRDP_METRICS_BUF_T  *pBuf,
+    const CHAR8         *pName,
+    const CHAR8         *pHelp,
+    BOOL8               counter)
+{
+    CHAR8 line[TRDP_METRICS_LINE];
+
+    (void) vos_snprintf(line, sizeof(line), "# TYPE %s %s\n# HELP %s %s\n",
+                        pName, counter ? "counter" : "gauge", pName, pHelp);
+    trdp_metricsAppend(pBuf, line);
+}
+
+/**********************************************************************************************************************/
+/** Append a sample.
+ *
+ *  @param[in,out]  pBuf                the output
+ *  @param[in]      pName               family name
+ *  @param[in]      counter             TRUE: counter, FALSE: gauge
+ *  @param[in]      pLabels             labels of the sample
+ *  @param[in]      value               value of the sample
+ */
+static void trdp_metricsSample (
+    TRDP_METRICS_BUF_T  *pBuf,
+    const CHAR8         *pName,
+    BOOL8               counter,
+    const CHAR8         *pLabels,
+    INT64               value)
+{
+    CHAR8 line[TRDP_METRICS_LINE];
+
+    (void) vos_snprintf(line, sizeof(line), "%s%s{%s} %lld\n", pName, counter ? "_total" : "", pLabels,
+                        (long long) value);
+    trdp_metricsAppend(pBuf, line);
+}
+
+/**********************************************************************************************************************/
+/** Format a snapshot of the statistics export as OpenMetrics text.
+ *
+ *  @param[in]      pArea               the snapshot
+ *  @param[out]     pText               the text
+ *  @param[in,out]  pSize               In: size of pText, Out: length of the text or size needed
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        pText too small
+ */
+static TRDP_ERR_T trdp_formatMetrics (
+    const UINT8 *pArea,
+    CHAR8       *pText,
+    UINT32      *pSize)
+{
+    const TRDP_EXPORT_HEAD_T        *pHead  = (const TRDP_EXPORT_HEAD_T *) pArea;
+    const TRDP_SUBS_STATISTICS_T    *pSubs  = (const TRDP_SUBS_STATISTICS_T *) (pHead + 1);
+    const TRDP_PUB_STATISTICS_T     *pPub   = (const TRDP_PUB_STATISTICS_T *) (pSubs + pHead->maxEle);
+    const TRDP_EXPORT_SOCK_T        *pSock  = (const TRDP_EXPORT_SOCK_T *) (pPub + pHead->maxEle);
+    TRDP_METRICS_BUF_T              buf;
+    CHAR8                           ip[16];
+    CHAR8                           labels[TRDP_METRICS_LINE / 2u];
+    UINT32                          i, fam;
+
+    buf.pText   = pText;
+    buf.size    = *pSize;
+    buf.len     = 0u;
+    vos_strncpy(ip, vos_ipDotted(pHead->stats.ownIpAddr), sizeof(ip) - 1u);
+    ip[sizeof(ip) - 1u] = 0;
+
+    /*  Session */
+    for (i = 0u; i < sizeof(cSessionMetrics) / sizeof(TRDP_METRIC_T); i++)
+    {
+        const TRDP_METRIC_T *pMetric = &cSessionMetrics[i];
+
+        if ((i == 0u) || (strcmp(pMetric->pName, cSessionMetrics[i - 1u].pName) != 0))
+        {
+            trdp_metricsFamily(&buf, pMetric->pName, pMetric->pHelp, pMetric->counter);
+        }
+        (void) vos_snprintf(labels, sizeof(labels), "ip=\"%s\"%s%s", ip, (pMetric->pLabel != NULL) ? "," : "",
+                            (pMetric->pLabel != NULL) ? pMetric->pLabel : "");
+        trdp_metricsSample(&buf, pMetric->pName, pMetric->counter, labels,
+                           *(const UINT32 *) (pArea + pMetric->offset));
+    }
+
+    /*  Subscriptions: received, missed, status  */
+    for (fam = 0u; fam < 3u; fam++)
+    {
+        static const CHAR8  *cName[] = {"trdp_pd_sub_received", "trdp_pd_sub_missed", "trdp_pd_sub_status"};
+        static const CHAR8  *cHelp[] = {"Received PD packets of a subscription",
+                                        "PD packets of a subscription missed by sequence counter",
+                                        "Receive status of a subscription (TRDP_ERR_T)"};
+
+        trdp_metricsFamily(&buf, cName[fam], cHelp[fam], fam < 2u);
+        for (i = 0u; i < pHead->numSubs; i++)
+        {
+            (void) vos_snprintf(labels, sizeof(labels), "ip=\"%s\",comid=\"%u\",src=\"%s\"", ip,
+                                pSubs[i].comId, vos_ipDotted(pSubs[i].filterAddr));
+            trdp_metricsSample(&buf, cName[fam], fam < 2u, labels,
+                               (fam == 0u) ? (INT64) pSubs[i].numRecv :
+                               (fam == 1u) ? (INT64) pSubs[i].numMissed : (INT64) pSubs[i].status);
+        }
+    }
+
+    /*  Publishers: sent, put, follower  */
+    for (fam = 0u; fam < 3u; fam++)
+    {
+        static const CHAR8  *cName[] = {"trdp_pd_pub_sent", "trdp_pd_pub_put", "trdp_pd_pub_follower"};
+        static const CHAR8  *cHelp[] = {"Sent PD packets of a publisher", "Updates of a publisher",
+                                        "1 if the redundancy group of a publisher is follower"};
+
+        trdp_metricsFamily(&buf, cName[fam], cHelp[fam], fam < 2u);
+        for (i = 0u; i < pHead->numPub; i++)
+        {
+            (void) vos_snprintf(labels, sizeof(labels), "ip=\"%s\",comid=\"%u\",dest=\"%s\"", ip,
+                                pPub[i].comId, vos_ipDotted(pPub[i].destAddr));
+            trdp_metricsSample(&buf, cName[fam], fam < 2u, labels,
+                               (fam == 0u) ? (INT64) pPub[i].numSend :
+                               (fam == 1u) ? (INT64) pPub[i].numPut : (INT64) pPub[i].redState);
+        }
+    }
+
+    /*  Sockets: users, multicast joins, queued bytes, receive drops, receive buffer size  */
+    for (fam = 0u; fam < 5u; fam++)
+    {
+        static const CHAR8  *cName[] = {"trdp_socket_users", "trdp_socket_mc_joins", "trdp_socket_queued_bytes",
+                                        "trdp_socket_rx_drops", "trdp_socket_rcvbuf_bytes"};
+        static const CHAR8  *cHelp[] = {"Users of a socket", "Multicast memberships of a socket",
+                                        "Bytes waiting to be sent on a TCP socket",
+                                        "Datagrams dropped on the full receive queue of a PD socket",
+                                        "Receive buffer size of a PD socket, 0 until its queue was backlogged"};
+        BOOL8               counter = (fam == 3u) ? TRUE : FALSE;
+
+        trdp_metricsFamily(&buf, cName[fam], cHelp[fam], counter);
+        for (i = 0u; i < pHead->numSock; i++)
+        {
+            (void) vos_snprintf(labels, sizeof(labels), "ip=\"%s\",socket=\"%u\",type=\"%s\",addr=\"%s\"", ip,
+                                i, cSockTypeName[(pSock[i].type < 3u) ? pSock[i].type : 0u],
+                                vos_ipDotted(pSock[i].bindAddr));
+            trdp_metricsSample(&buf, cName[fam], counter, labels,
+                               (fam == 0u) ? (INT64) pSock[i].usage :
+                               (fam == 1u) ? (INT64) pSock[i].mcJoinCnt :
+                               (fam == 2u) ? (INT64) pSock[i].queuedBytes :
+                               (fam == 3u) ? (INT64) pSock[i].rxDrops : (INT64) pSock[i].rcvBufSize);
+        }
+    }
+    trdp_metricsAppend(&buf, "# EOF\n");
+
+    if (buf.len >= buf.size)
+    {
+        *pSize = buf.len + 1u;
+        return TRDP_MEM_ERR;
+    }
+    pText[buf.len]  = 0;
+    *pSize          = buf.len;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return the statistics exported by a session as OpenMetrics text.
+ *  The shared memory area written by tlc_exportStatistics() of a session, possibly in another process, is read.
+ *  The session is not locked, the call may come from any process on the host which called tlc_init().
+ *
+ *  @param[in]      pName               name of the shared memory area
+ *  @param[out]     pText               buffer for the text, zero terminated
+ *  @param[in,out]  pSize               In: size of pText, Out: length of the text or, on TRDP_MEM_ERR, size needed
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     no statistics exported by that name
+ *  @retval         TRDP_MEM_ERR        pText too small or out of memory
+ *  @retval         TRDP_BLOCK_ERR      no consistent snapshot could be read
+ */
+EXT_DECL TRDP_ERR_T tlc_getExportedMetrics (
+    const CHAR8 *pName,
+    CHAR8       *pText,
+    UINT32      *pSize)
+{
+    TRDP_ERR_T          err = TRDP_NO_ERR;
+    TRDP_EXPORT_HEAD_T  *pHead;
+    VOS_SHRD_T          shm;
+    UINT8               *pArea;
+    UINT8               *pCopy;
+    UINT32              areaSize;
+    UINT32              size;
+    UINT32              seq;
+    UINT32              retry;
+
+    if ((pName == NULL) || (pText == NULL) || (pSize == NULL) || (*pSize == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_sharedAttach(pName, &shm, &pArea, &areaSize) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pHead = (TRDP_EXPORT_HEAD_T *) pArea;
+    if ((areaSize < sizeof(TRDP_EXPORT_HEAD_T)) ||
+        (EXPORT_SEQ_LOAD(&pHead->magic) != TRDP_EXPORT_MAGIC) ||
+        (pHead->version != TRDP_EXPORT_VERSION) ||
+        (pHead->size > areaSize) ||
+        (pHead->size < sizeof(TRDP_EXPORT_HEAD_T) + VOS_MAX_SOCKET_CNT * sizeof(TRDP_EXPORT_SOCK_T)) ||
+        (pHead->maxEle > (pHead->size - sizeof(TRDP_EXPORT_HEAD_T) - VOS_MAX_SOCKET_CNT * sizeof(TRDP_EXPORT_SOCK_T)) /
+         (sizeof(TRDP_SUBS_STATISTICS_T) + sizeof(TRDP_PUB_STATISTICS_T))))
+    {
+        err = TRDP_NOINIT_ERR;
+    }
+    else
+    {
+        size    = pHead->size;
+        pCopy   = (UINT8 *) vos_memAlloc(size);
+        if (pCopy == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            /*  Copy the snapshot, again if it was written meanwhile    */
+            for (retry = 0u; retry < TRDP_EXPORT_RETRIES; retry++)
+            {
+                seq = EXPORT_SEQ_LOAD(&pHead->seq);
+                if ((seq & 1u) == 0u)
+                {
+                    memcpy(pCopy, pArea, size);
+                    EXPORT_SEQ_FENCE();
+                    if (EXPORT_SEQ_LOAD(&pHead->seq) == seq)
+                    {
+                        break;
+                    }
+                }
+                (void) vos_threadDelay(1000u);
+            }
+            pHead = (TRDP_EXPORT_HEAD_T *) pCopy;
+            if (retry == TRDP_EXPORT_RETRIES)
+            {
+                err = TRDP_BLOCK_ERR;
+            }
+            else if ((pHead->numSubs > pHead->maxEle) || (pHead->numPub > pHead->maxEle) ||
+                     (pHead->numSock > VOS_MAX_SOCKET_CNT))
+            {
+                err = TRDP_NOINIT_ERR;
+            }
+            else
+            {
+                err = trdp_formatMetrics(pCopy, pText, pSize);
+            }
+            vos_memFree(pCopy);
+        }
+    }
+
+    (void) vos_sharedClose(shm, pArea);
+    return err;
+}
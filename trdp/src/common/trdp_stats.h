@@ -34,6 +34,18 @@
  * DEFINES
  */
 
+/*  The event counters of the statistics are counted in the block of the calling thread   */
+#if TRDP_STATS_BLOCKS > 1
+#define trdp_statsBlock(appHandle)                                                                    \
+    (&(appHandle)->statsBlock[(trdp_statsThreadSlot != 0u) ? trdp_statsThreadSlot - 1u : trdp_statsNewSlot()].cnt)
+#define TRDP_CNT_ADD(var, val)              (void) __atomic_fetch_add(&(var), (UINT32) (val), __ATOMIC_RELAXED)
+#else
+#define trdp_statsBlock(appHandle)          (&(appHandle)->statsBlock[0].cnt)
+#define TRDP_CNT_ADD(var, val)              ((var) += (UINT32) (val))
+#endif
+
+#define TRDP_STATS_ADD(appHandle, cnt, val) TRDP_CNT_ADD(trdp_statsBlock(appHandle)->cnt, val)
+#define TRDP_STATS_INC(appHandle, cnt)      TRDP_STATS_ADD(appHandle, cnt, 1u)
 
 /*******************************************************************************
  * TYPEDEFS
@@ -44,8 +56,22 @@
  * GLOBAL FUNCTIONS
  */
 
+#if TRDP_STATS_BLOCKS > 1
+extern __thread UINT32 trdp_statsThreadSlot;     /**< counter block of the thread + 1, 0: not assigned yet   */
+UINT32  trdp_statsNewSlot (void);
+#endif
+
 void    trdp_initStats(TRDP_APP_SESSION_T appHandle);
 void    trdp_pdPrepareStats (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pPacket);
+void    trdp_exportStats (TRDP_SESSION_PT appHandle);
+void    trdp_exportStop (TRDP_SESSION_PT appHandle);
+
+#if TRDP_TIMING_STATS
+void    trdp_timingInit (void);
+UINT64  trdp_timingStamp (void);
+void    trdp_timingAdd (TRDP_SESSION_PT appHandle, UINT32 id, const TRDP_TIME_T *pFrom, const TRDP_TIME_T *pTo);
+void    trdp_timingAddNs (TRDP_SESSION_PT appHandle, UINT32 id, UINT64 ns);
+#endif
 
 
 #endif
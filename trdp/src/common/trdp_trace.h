@@ -0,0 +1,76 @@
+/******************************************************************************/
+/**
+ * @file            trdp_trace.h
+ *
+ * @brief           Tracepoints in the PD/MD paths of the TRDP stack
+ *
+ * @details         With TRDP_TRACE set to 1 the stack contains static tracepoints, which cost a no-op instruction
+ *                  as long as no tracer is attached:
+ *                  - Linux: USDT probes of provider 'trdp' (needs <sys/sdt.h> of systemtap-sdt-dev), usable with
+ *                    perf, bpftrace, SystemTap and LTTng (--userspace-probe=sdt:...)
+ *                  - Windows: TraceLogging events of provider 'TCNOpen.TRDP' (ETW)
+ *                  Without TRDP_TRACE, or on other targets, the tracepoints compile to nothing.
+ *
+ *                  Tracepoints (arguments):
+ *                  - pd_receive (comId, size), pd_send (comId, size)
+ *                  - pd_callback (comId, resultCode), pd_callback_done (comId)
+ *                  - md_receive (comId, size), md_send (comId, size)
+ *                  - md_callback (comId, resultCode), md_callback_done (comId)
+ *                  - marshall/unmarshall (comId, srcSize), marshall_done/unmarshall_done (comId, destSize, err)
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TRDP_TRACE_H
+#define TRDP_TRACE_H
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#ifndef TRDP_TRACE
+#define TRDP_TRACE  0       /**< 1: compile the tracepoints into the stack  */
+#endif
+
+#if TRDP_TRACE && defined (__linux__)
+
+#include <sys/sdt.h>
+
+#define TRDP_TRACE1(probe, a1)              DTRACE_PROBE1(trdp, probe, (UINT32) (a1))
+#define TRDP_TRACE2(probe, a1, a2)          DTRACE_PROBE2(trdp, probe, (UINT32) (a1), (UINT32) (a2))
+#define TRDP_TRACE3(probe, a1, a2, a3)      DTRACE_PROBE3(trdp, probe, (UINT32) (a1), (UINT32) (a2), (UINT32) (a3))
+
+#elif TRDP_TRACE && defined (WIN32)
+
+#include <windows.h>
+#include <TraceLoggingProvider.h>
+
+TRACELOGGING_DECLARE_PROVIDER(trdp_traceProvider);
+
+#define TRDP_TRACE1(probe, a1)                                                                                  \
+    TraceLoggingWrite(trdp_traceProvider, #probe, TraceLoggingUInt32((UINT32) (a1), "arg1"))
+#define TRDP_TRACE2(probe, a1, a2)                                                                              \
+    TraceLoggingWrite(trdp_traceProvider, #probe, TraceLoggingUInt32((UINT32) (a1), "arg1"),                    \
+                      TraceLoggingUInt32((UINT32) (a2), "arg2"))
+#define TRDP_TRACE3(probe, a1, a2, a3)                                                                          \
+    TraceLoggingWrite(trdp_traceProvider, #probe, TraceLoggingUInt32((UINT32) (a1), "arg1"),                    \
+                      TraceLoggingUInt32((UINT32) (a2), "arg2"), TraceLoggingUInt32((UINT32) (a3), "arg3"))
+
+#else
+
+#define TRDP_TRACE1(probe, a1)
+#define TRDP_TRACE2(probe, a1, a2)
+#define TRDP_TRACE3(probe, a1, a2, a3)
+
+#endif
+
+#endif /* TRDP_TRACE_H */
@@ -42,30 +42,125 @@
 
 #include "trdp_if.h"
 #include "trdp_utils.h"
+#include "trdp_pdcom.h"
+#include "trdp_trace.h"
 
 /***********************************************************************************************************************
  * DEFINES
  */
 
+/** Bucket of a comId in the MD listener index */
+#define TRDP_LIS_HASH(comId)    (((comId) ^ ((comId) >> 16u)) % TRDP_MD_LISTENER_HASH_SIZE)
+
+#if MD_SUPPORT && (TRDP_MD_SESSION_HASH_SIZE > 0)
+static UINT32   trdp_MDsessionHash (const UINT8 *pSessionId);
+static MD_ELE_T **trdp_MDqueueHash (TRDP_SESSION_PT appHandle,
+                                    MD_ELE_T        * *ppHead);
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
+#if TRDP_PD_SRC_TABLE
+/** Source filter of a subscription while the source table is built */
+typedef struct
+{
+    UINT32          comId;
+    UINT32          order;                      /* position in the receive queue */
+    TRDP_IP_ADDR_T  lowIp;
+    TRDP_IP_ADDR_T  highIp;
+    PD_ELE_T        *pSub;
+} TRDP_SRC_FILTER_T;
+#endif
+
+/** Multicast membership of a shared socket, counted over the sessions */
+typedef struct
+{
+    TRDP_IP_ADDR_T  mcGroup;                    /* joined multicast group                   */
+    TRDP_IP_ADDR_T  srcIp;                      /* source of a source specific join, or 0   */
+    UINT32          refCnt;                     /* joins of the sessions                    */
+} TRDP_SHARE_JOIN_T;
+
+/** Session using a shared socket */
+typedef struct
+{
+    TRDP_SESSION_PT pSession;                   /* NULL while the session is closed         */
+    TRDP_SOCKETS_T  *pIface;                    /* socket pool of the session               */
+} TRDP_SHARE_MEMBER_T;
+
+/** PD receive socket shared by sessions with TRDP_OPTION_SHARE_SOCKETS, free if memberCnt is 0 */
+typedef struct
+{
+    SOCKET              sock;
+    TRDP_IP_ADDR_T      bindAddr;
+    UINT16              port;
+    TRDP_OPTION_T       option;                 /* options the socket was opened with       */
+    UINT32              memberCnt;
+    TRDP_SHARE_MEMBER_T member[TRDP_SHARE_SESSION_MAX];
+    TRDP_SHARE_JOIN_T   *pJoins;
+    UINT32              joinCnt;
+    UINT32              joinSize;
+} TRDP_SHARE_SOCK_T;
+
+/** Options a socket is opened with, sessions sharing it must agree on them */
+#define TRDP_SHARE_SOCK_OPTIONS (TRDP_OPTION_NO_REUSE_ADDR | TRDP_OPTION_RX_TIMESTAMPS | TRDP_OPTION_BUSY_POLL)
+
 /***********************************************************************************************************************
  *   Locals
  */
-static INT32 sCurrentMaxSocketCnt = 0;
+
+static TRDP_SHARE_SOCK_T    sShareSock[TRDP_SHARE_SOCK_MAX];    /* registry of the shared sockets   */
+static VOS_MUTEX_T          sShareMutex = NULL;                 /* protects the registry and the
+                                                                   share fields of the sessions     */
+static TRDP_SEQ_PUB_T       *sSeqPub    = NULL;                 /* publishers of all sessions       */
+static VOS_MUTEX_T          sSeqPubMutex = NULL;                /* protects sSeqPub, taken last     */
 
 /***********************************************************************************************************************
  *   Local Functions
  */
 static void     printSocketUsage (TRDP_SOCKETS_T iface[]);
-static BOOL8    trdp_SockIsJoined (const TRDP_IP_ADDR_T mcList[VOS_MAX_MULTICAST_CNT],
-                                   TRDP_IP_ADDR_T       mcGroup);
-static BOOL8    trdp_SockAddJoin (TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
-                                  TRDP_IP_ADDR_T    mcGroup);
-static BOOL8    trdp_SockDelJoin (TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
+static UINT32   trdp_sockHashKey (TRDP_IP_ADDR_T            bindAddr,
+                                  TRDP_SOCK_TYPE_T          usage,
+                                  const TRDP_SEND_PARAM_T   *params,
+                                  BOOL8                     rcvMostly,
+                                  TRDP_IP_ADDR_T            cornerIp);
+static void     trdp_sockHashLink (TRDP_SOCKETS_T iface[], INT32 lIndex, UINT32 key);
+static void     trdp_sockHashUnlink (TRDP_SOCKETS_T iface[], INT32 lIndex);
+static BOOL8    trdp_SockIsJoined (const TRDP_SOCKETS_T *pSock,
+                                   TRDP_IP_ADDR_T       mcGroup,
+                                   TRDP_IP_ADDR_T       srcIp);
+static BOOL8    trdp_SockDelJoin (TRDP_SOCKETS_T    *pSock,
                                   TRDP_IP_ADDR_T    mcGroup);
+static BOOL8    trdp_sockJoin (TRDP_SOCKETS_T   *pSock,
+                               TRDP_IP_ADDR_T   mcGroup,
+                               TRDP_IP_ADDR_T   srcIp,
+                               TRDP_IP_ADDR_T   ifAddr);
+static void     trdp_sockLeave (TRDP_SOCKETS_T  *pSock,
+                                TRDP_IP_ADDR_T  mcGroup,
+                                TRDP_IP_ADDR_T  srcIp,
+                                TRDP_IP_ADDR_T  ifAddr);
+static BOOL8    trdp_shareRelease (TRDP_SOCKETS_T   iface[],
+                                   INT32            lIndex);
+static BOOL8    trdp_subAddrMatches (const PD_ELE_T         *pSub,
+                                     const TRDP_ADDRESSES_T *addr);
+#if TRDP_PD_SRC_TABLE
+static int      trdp_srcFilterCompare (const void *pArg1,
+                                       const void *pArg2);
+static int      trdp_srcIpCompare (const void *pArg1,
+                                   const void *pArg2);
+static void     trdp_srcTableGroup (const TRDP_SRC_FILTER_T *pFilter,
+                                    UINT32                  filterCnt,
+                                    TRDP_IP_ADDR_T          *pBound,
+                                    TRDP_SRC_TABLE_T        *pTable,
+                                    UINT32                  *pSubCnt);
+static BOOL8    trdp_srcTableBuild (TRDP_SESSION_PT appHandle);
+#endif
+static void     trdp_cbFreeJob (TRDP_CB_JOB_T *pJob);
+static TRDP_SEQ_CNT_LIST_T  *trdp_seqCntAlloc (UINT16 size);
+static TRDP_SEQ_CNT_ENTRY_T *trdp_seqCntFind (TRDP_SEQ_CNT_LIST_T   *pList,
+                                              TRDP_IP_ADDR_T        srcIP,
+                                              TRDP_MSG_T            msgType);
 
 /**********************************************************************************************************************/
 /** Debug socket usage output
@@ -78,7 +173,7 @@ static void printSocketUsage (
 {
     INT32 lIndex = 0;
     vos_printLogStr(VOS_LOG_DBG, "------- Socket usage -------\n");
-    for (lIndex = 0; lIndex < sCurrentMaxSocketCnt; lIndex++)
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
     {
         if (iface[lIndex].sock == -1)
         {
@@ -97,83 +192,369 @@ static void printSocketUsage (
 }
 
 /**********************************************************************************************************************/
-/** Check if a mc group is in the list
+/** Compute the lookup key of a socket from the parameters trdp_requestSocket() matches on
+ *  The corner IP is only significant for TCP sockets.
+ *
+ *  @param[in]      bindAddr        bind address
+ *  @param[in]      usage           socket type
+ *  @param[in]      params          send parameters
+ *  @param[in]      rcvMostly       primarily used for receiving
+ *  @param[in]      cornerIp        TCP peer
+ *
+ *  @retval         hash key
+ */
+static UINT32 trdp_sockHashKey (
+    TRDP_IP_ADDR_T          bindAddr,
+    TRDP_SOCK_TYPE_T        usage,
+    const TRDP_SEND_PARAM_T *params,
+    BOOL8                   rcvMostly,
+    TRDP_IP_ADDR_T          cornerIp)
+{
+    UINT32 key = bindAddr;
+
+    key = key * 31u + (UINT32) usage;
+    key = key * 31u + params->qos;
+    key = key * 31u + params->ttl;
+    key = key * 31u + (((usage == TRDP_SOCK_PD) && params->txTime) ? 1u : 0u);
+    key = key * 31u + (rcvMostly ? 1u : 0u);
+    if (usage == TRDP_SOCK_MD_TCP)
+    {
+        key = key * 31u + cornerIp;
+    }
+    return key ^ (key >> 16u);
+}
+
+/**********************************************************************************************************************/
+/** Insert a socket into the lookup index
+ *  The bucket heads are kept in the socket entries themselves, bucket b lives in iface[b].hashHead.
+ *
+ *  @param[in,out]  iface           socket pool
+ *  @param[in]      lIndex          index of socket to insert
+ *  @param[in]      key             key returned by trdp_sockHashKey()
+ */
+static void trdp_sockHashLink (
+    TRDP_SOCKETS_T  iface[],
+    INT32           lIndex,
+    UINT32          key)
+{
+    INT32 bucket = (INT32) (key % VOS_MAX_SOCKET_CNT);
+
+    iface[lIndex].hashKey   = key;
+    iface[lIndex].hashNext  = iface[bucket].hashHead;
+    iface[bucket].hashHead  = lIndex;
+}
+
+/**********************************************************************************************************************/
+/** Remove a socket from the lookup index
+ *  Closed sockets are skipped while searching, so the entry is only unlinked when its slot is reused.
+ *
+ *  @param[in,out]  iface           socket pool
+ *  @param[in]      lIndex          index of socket to remove
+ */
+static void trdp_sockHashUnlink (
+    TRDP_SOCKETS_T  iface[],
+    INT32           lIndex)
+{
+    INT32 *pLink = &iface[iface[lIndex].hashKey % VOS_MAX_SOCKET_CNT].hashHead;
+
+    while (*pLink != -1)
+    {
+        if (*pLink == lIndex)
+        {
+            *pLink = iface[lIndex].hashNext;
+            break;
+        }
+        pLink = &iface[*pLink].hashNext;
+    }
+    iface[lIndex].hashNext = -1;
+}
+
+/**********************************************************************************************************************/
+/** Join a mc group on a socket
+ *  Sockets shared by sessions join a group once, for the first session.
  *
- *  @param[in]      mcList              List of multicast groups
+ *  @param[in,out]  pSock               socket
  *  @param[in]      mcGroup             multicast group
+ *  @param[in]      srcIp               source, 0 for any source
+ *  @param[in]      ifAddr              interface to join on
  *
- *  @retval         1           if found
- *                  0           if not found
+ *  @retval         1           if joined
+ *                  0           if the join failed or out of memory
  */
-static BOOL8 trdp_SockIsJoined (
-    const TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
-    TRDP_IP_ADDR_T          mcGroup)
+static BOOL8 trdp_sockJoin (
+    TRDP_SOCKETS_T  *pSock,
+    TRDP_IP_ADDR_T  mcGroup,
+    TRDP_IP_ADDR_T  srcIp,
+    TRDP_IP_ADDR_T  ifAddr)
 {
-    int i = 0;
+    TRDP_SHARE_SOCK_T   *pShare;
+    BOOL8               joined = FALSE;
+    UINT32              i;
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT && mcList[i] != mcGroup; i++)
+    if (pSock->shareIdx == 0u)
     {
-        ;
+        return (((srcIp != VOS_INADDR_ANY) ? vos_sockJoinSourceMC(pSock->sock, mcGroup, srcIp, ifAddr) :
+                 vos_sockJoinMC(pSock->sock, mcGroup, ifAddr)) == VOS_NO_ERR) ? TRUE : FALSE;
+    }
+
+    pShare = &sShareSock[pSock->shareIdx - 1u];
+    (void) vos_mutexLock(sShareMutex);
+    for (i = 0u; i < pShare->joinCnt; i++)
+    {
+        if ((pShare->pJoins[i].mcGroup == mcGroup) && (pShare->pJoins[i].srcIp == srcIp))
+        {
+            pShare->pJoins[i].refCnt++;
+            joined = TRUE;
+            break;
+        }
+    }
+    if (!joined && (pShare->joinCnt >= pShare->joinSize))
+    {
+        UINT32              newSize     = (pShare->joinSize == 0u) ? VOS_MAX_MULTICAST_CNT : 2u * pShare->joinSize;
+        TRDP_SHARE_JOIN_T   *pNewJoins  = (TRDP_SHARE_JOIN_T *) vos_memAlloc(newSize * sizeof(TRDP_SHARE_JOIN_T));
+
+        if (pNewJoins != NULL)
+        {
+            if (pShare->pJoins != NULL)
+            {
+                memcpy(pNewJoins, pShare->pJoins, pShare->joinCnt * sizeof(TRDP_SHARE_JOIN_T));
+                vos_memFree(pShare->pJoins);
+            }
+            pShare->pJoins      = pNewJoins;
+            pShare->joinSize    = newSize;
+        }
+    }
+    if (!joined && (pShare->joinCnt < pShare->joinSize) &&
+        ((((srcIp != VOS_INADDR_ANY) ? vos_sockJoinSourceMC(pSock->sock, mcGroup, srcIp, ifAddr) :
+           vos_sockJoinMC(pSock->sock, mcGroup, ifAddr))) == VOS_NO_ERR))
+    {
+        pShare->pJoins[pShare->joinCnt].mcGroup = mcGroup;
+        pShare->pJoins[pShare->joinCnt].srcIp   = srcIp;
+        pShare->pJoins[pShare->joinCnt].refCnt  = 1u;
+        pShare->joinCnt++;
+        joined = TRUE;
+    }
+    (void) vos_mutexUnlock(sShareMutex);
+    return joined;
+}
+
+/**********************************************************************************************************************/
+/** Leave a mc group on a socket
+ *  Sockets shared by sessions leave a group with the last session.
+ *
+ *  @param[in,out]  pSock               socket
+ *  @param[in]      mcGroup             multicast group
+ *  @param[in]      srcIp               source, 0 for any source
+ *  @param[in]      ifAddr              interface joined on
+ */
+static void trdp_sockLeave (
+    TRDP_SOCKETS_T  *pSock,
+    TRDP_IP_ADDR_T  mcGroup,
+    TRDP_IP_ADDR_T  srcIp,
+    TRDP_IP_ADDR_T  ifAddr)
+{
+    TRDP_SHARE_SOCK_T   *pShare;
+    UINT32              i;
+
+    if (pSock->shareIdx != 0u)
+    {
+        pShare = &sShareSock[pSock->shareIdx - 1u];
+        (void) vos_mutexLock(sShareMutex);
+        for (i = 0u; i < pShare->joinCnt; i++)
+        {
+            if ((pShare->pJoins[i].mcGroup == mcGroup) && (pShare->pJoins[i].srcIp == srcIp))
+            {
+                if (--pShare->pJoins[i].refCnt == 0u)
+                {
+                    pShare->pJoins[i] = pShare->pJoins[--pShare->joinCnt];
+                    break;
+                }
+                (void) vos_mutexUnlock(sShareMutex);
+                return;                             /* still joined for another session */
+            }
+        }
+        (void) vos_mutexUnlock(sShareMutex);
     }
 
-    return i < VOS_MAX_MULTICAST_CNT;
+    if (srcIp != VOS_INADDR_ANY)
+    {
+        (void) vos_sockLeaveSourceMC(pSock->sock, mcGroup, srcIp, ifAddr);
+    }
+    else
+    {
+        (void) vos_sockLeaveMC(pSock->sock, mcGroup, ifAddr);
+    }
 }
 
 /**********************************************************************************************************************/
-/** Add mc group to the list
+/** Check if a socket receives a mc group from a source
  *
- *  @param[in]      mcList          List of multicast groups
- *  @param[in]      mcGroup         multicast group
+ *  @param[in]      pSock               socket
+ *  @param[in]      mcGroup             multicast group
+ *  @param[in]      srcIp               source, 0 for any source
  *
- *  @retval         1           if added
- *                  0           if list is full
+ *  @retval         1           if joined for any source or for srcIp
+ *                  0           if not joined
  */
-static BOOL8 trdp_SockAddJoin (
-    TRDP_IP_ADDR_T  mcList[VOS_MAX_MULTICAST_CNT],
-    TRDP_IP_ADDR_T  mcGroup)
+static BOOL8 trdp_SockIsJoined (
+    const TRDP_SOCKETS_T    *pSock,
+    TRDP_IP_ADDR_T          mcGroup,
+    TRDP_IP_ADDR_T          srcIp)
 {
-    int i = 0;
+    UINT32 i;
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT; i++)
+    for (i = 0u; i < pSock->mcJoinCnt; i++)
     {
-        if (0 == mcList[i] || mcGroup == mcList[i])
+        if ((pSock->pMcJoins[i].mcGroup == mcGroup)
+            && ((pSock->pMcJoins[i].srcIp == VOS_INADDR_ANY) || (pSock->pMcJoins[i].srcIp == srcIp)))
         {
-            mcList[i] = mcGroup;
             return TRUE;
         }
     }
-
     return FALSE;
 }
 
 /**********************************************************************************************************************/
-/** remove mc group from the list
+/** Join a mc group on a socket and add it to the socket's membership list
+ *  With a source given, a source specific membership is tried first; the kernel then filters other senders.
+ *  A join for any source replaces the source specific joins of that group. The list grows as needed.
+ *
+ *  @param[in,out]  pSock               socket
+ *  @param[in]      mcGroup             multicast group
+ *  @param[in]      srcIp               source, 0 for any source
+ *  @param[in]      ifAddr              interface to join on
+ *
+ *  @retval         1           if joined
+ *                  0           if the join failed or out of memory
+ */
+BOOL8 trdp_SockAddJoin (
+    TRDP_SOCKETS_T  *pSock,
+    TRDP_IP_ADDR_T  mcGroup,
+    TRDP_IP_ADDR_T  srcIp,
+    TRDP_IP_ADDR_T  ifAddr)
+{
+    UINT32 i;
+
+    if (trdp_SockIsJoined(pSock, mcGroup, srcIp) == TRUE)
+    {
+        return TRUE;
+    }
+
+    if (pSock->mcJoinCnt >= pSock->mcJoinSize)
+    {
+        UINT32          newSize     = (pSock->mcJoinSize == 0u) ? VOS_MAX_MULTICAST_CNT : 2u * pSock->mcJoinSize;
+        TRDP_MC_JOIN_T  *pNewJoins  = (TRDP_MC_JOIN_T *) vos_memAlloc(newSize * sizeof(TRDP_MC_JOIN_T));
+
+        if (pNewJoins == NULL)
+        {
+            return FALSE;
+        }
+        if (pSock->pMcJoins != NULL)
+        {
+            memcpy(pNewJoins, pSock->pMcJoins, pSock->mcJoinCnt * sizeof(TRDP_MC_JOIN_T));
+            vos_memFree(pSock->pMcJoins);
+        }
+        pSock->pMcJoins     = pNewJoins;
+        pSock->mcJoinSize   = newSize;
+    }
+
+    if ((srcIp != VOS_INADDR_ANY)
+        && (trdp_sockJoin(pSock, mcGroup, srcIp, ifAddr) == TRUE))
+    {
+        pSock->pMcJoins[pSock->mcJoinCnt].mcGroup   = mcGroup;
+        pSock->pMcJoins[pSock->mcJoinCnt].srcIp     = srcIp;
+        pSock->mcJoinCnt++;
+        return TRUE;
+    }
+
+    /*  Any source: the source specific joins of this group have to go first */
+    for (i = 0u; i < pSock->mcJoinCnt; )
+    {
+        if (pSock->pMcJoins[i].mcGroup == mcGroup)
+        {
+            trdp_sockLeave(pSock, mcGroup, pSock->pMcJoins[i].srcIp, ifAddr);
+            pSock->pMcJoins[i] = pSock->pMcJoins[--pSock->mcJoinCnt];
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (trdp_sockJoin(pSock, mcGroup, VOS_INADDR_ANY, ifAddr) == FALSE)
+    {
+        return FALSE;
+    }
+    pSock->pMcJoins[pSock->mcJoinCnt].mcGroup   = mcGroup;
+    pSock->pMcJoins[pSock->mcJoinCnt].srcIp     = VOS_INADDR_ANY;
+    pSock->mcJoinCnt++;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Leave a mc group on a socket and remove it from the socket's membership list
  *
- *  @param[in]      mcList        List of multicast groups
- *  @param[in]      mcGroup         multicast group
+ *  @param[in,out]  pSock               socket
+ *  @param[in]      mcGroup             multicast group
  *
- *  @retval         1           if deleted
+ *  @retval         1           if left
  *                  0           was not in list
  */
 static BOOL8 trdp_SockDelJoin (
-    TRDP_IP_ADDR_T  mcList[VOS_MAX_MULTICAST_CNT],
+    TRDP_SOCKETS_T  *pSock,
     TRDP_IP_ADDR_T  mcGroup)
 {
-    int i = 0;
+    BOOL8   found = FALSE;
+    UINT32  i;
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT; i++)
+    for (i = 0u; i < pSock->mcJoinCnt; )
     {
-        if (mcGroup == mcList[i])
+        if (pSock->pMcJoins[i].mcGroup == mcGroup)
         {
-            mcList[i] = 0;
-            return TRUE;
+            trdp_sockLeave(pSock, mcGroup, pSock->pMcJoins[i].srcIp, pSock->bindAddr);
+            pSock->pMcJoins[i] = pSock->pMcJoins[--pSock->mcJoinCnt];
+            found = TRUE;
+        }
+        else
+        {
+            i++;
         }
     }
+    return found;
+}
 
+/**********************************************************************************************************************/
+/** Check if a received address matches a subscription
+ *  We match if comId is equal and the source IP is zero, equal or within the subscribed range
+ *
+ *  @param[in]      pSub            subscription element
+ *  @param[in]      addr            received addressing (comId, srcIP)
+ *
+ *  @retval         1           if matching
+ *                  0           if not matching
+ */
+static BOOL8 trdp_subAddrMatches (
+    const PD_ELE_T          *pSub,
+    const TRDP_ADDRESSES_T  *addr)
+{
+    if (pSub->addr.comId != addr->comId)
+    {
+        return FALSE;
+    }
+    if ((pSub->addr.srcIpAddr == VOS_INADDR_ANY) || (pSub->addr.srcIpAddr == addr->srcIpAddr))
+    {
+        return TRUE;
+    }
+    /* Check for IP range */
+    if ((pSub->addr.srcIpAddr2 != VOS_INADDR_ANY) &&
+        (addr->srcIpAddr >= pSub->addr.srcIpAddr) &&
+        (addr->srcIpAddr <= pSub->addr.srcIpAddr2))
+    {
+        return TRUE;
+    }
     return FALSE;
 }
 
-
 /***********************************************************************************************************************
  *   Globals
  */
@@ -361,23 +742,9 @@ PD_ELE_T *trdp_queueFindSubAddr (
 
     for (iterPD = pHead; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        /*  We match if src/dst/mc address is zero or matches */
-        if (iterPD->addr.comId == addr->comId)
+        if (trdp_subAddrMatches(iterPD, addr))
         {
-            if ((iterPD->addr.srcIpAddr == VOS_INADDR_ANY) || (iterPD->addr.srcIpAddr == addr->srcIpAddr))
-            {
-                return iterPD;
-            }
-            /* Check for IP range */
-            if (iterPD->addr.srcIpAddr2 != VOS_INADDR_ANY)
-            {
-                if ((addr->srcIpAddr >= iterPD->addr.srcIpAddr) &&
-                    (addr->srcIpAddr <= iterPD->addr.srcIpAddr2))
-                {
-                    return iterPD;
-                }
-            }
-
+            return iterPD;
         }
     }
     return NULL;
@@ -385,730 +752,3200 @@ PD_ELE_T *trdp_queueFindSubAddr (
 
 
 /**********************************************************************************************************************/
-/** Delete an element
+/** Return the subscription with same comId and IP addresses
+ *  If the comId index is enabled, only the bucket of the comId is searched. Elements in a bucket are kept in
+ *  the same order as in the receive queue, the result is the same as from trdp_queueFindSubAddr().
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pDelete         pointer to element to delete
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      addr            Sub handle (Address, ComID, srcIP & dest IP) to search for
+ *
+ *  @retval         != NULL         pointer to PD element
+ *  @retval         NULL            No PD element found
  */
-void    trdp_queueDelElement (
-    PD_ELE_T    * *ppHead,
-    PD_ELE_T    *pDelete)
+PD_ELE_T *trdp_rcvQueueFindSubAddr (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ADDRESSES_T    *addr)
 {
+#if TRDP_PD_SUB_HASH_SIZE > 0
     PD_ELE_T *iterPD;
 
-    if (ppHead == NULL || *ppHead == NULL || pDelete == NULL)
-    {
-        return;
-    }
-
-    /* handle removal of first element */
-    if (pDelete == *ppHead)
+    if (appHandle == NULL || addr == NULL)
     {
-        *ppHead = pDelete->pNext;
-        return;
+        return NULL;
     }
 
-    for (iterPD = *ppHead; iterPD != NULL; iterPD = iterPD->pNext)
+    for (iterPD = appHandle->pRcvHash[TRDP_SUB_HASH(addr->comId)]; iterPD != NULL; iterPD = iterPD->pNextHash)
     {
-        if (iterPD->pNext && iterPD->pNext == pDelete)
+        if (trdp_subAddrMatches(iterPD, addr))
         {
-            iterPD->pNext = pDelete->pNext;
-            return;
+            return iterPD;
         }
     }
+    return NULL;
+#else
+    if (appHandle == NULL)
+    {
+        return NULL;
+    }
+    return trdp_queueFindSubAddr(appHandle->pRcvQueue, addr);
+#endif
 }
 
 
 /**********************************************************************************************************************/
-/** Check topography counters
- *  The applied conformance pattern follows Table A.5/A.21 (positive match):
- *  Telegram to be sent   Locally stored value (appSession)
- *  Case etbTopoCnt opTrnTopoCnt etbTopoCntFilter opTrnTopoCntFilter
- *  1    any        any          0                0
- *  2    any        equal        0                equal
- *  3    equal      any          equal            0
- *  4    equal      equal        equal            equal
+/** Set the receive priority of a PD socket to the highest priority of its subscriptions
  *
- *  @param[in]      etbTopoCnt              ETB topography counter to be checked
- *  @param[in]      opTrnTopoCnt            Operational topography counter to be checked
- *  @param[in]      etbTopoCntFilter        ETB topography counter filter value
- *  @param[in]      opTrnTopoCntFilter      Operational topography counter filter value
- *
- *  @retval         TRUE           Filter criteria matched
- *                  FALSE          Filter criteria not matched
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      socketIdx       index of the socket in the session's socket pool
  */
-BOOL8 trdp_validTopoCounters (
-    UINT32  etbTopoCnt,
-    UINT32  opTrnTopoCnt,
-    UINT32  etbTopoCntFilter,
-    UINT32  opTrnTopoCntFilter)
+void    trdp_rcvSockPrio (
+    TRDP_SESSION_PT appHandle,
+    INT32           socketIdx)
 {
-    if (((etbTopoCntFilter == 0) || (etbTopoCnt == etbTopoCntFilter))
-        &&
-        ((opTrnTopoCntFilter == 0) || (opTrnTopoCnt == opTrnTopoCntFilter)))
+    PD_ELE_T    *iterPD;
+    UINT8       prio = 0u;
+
+    if ((appHandle == NULL) || (socketIdx < 0) || (socketIdx >= VOS_MAX_SOCKET_CNT))
     {
-        return TRUE;
+        return;
     }
-    else
+
+    /*  The receive queue is ordered by priority, the first subscription found has the highest  */
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        return FALSE;
+        if (iterPD->socketIdx == socketIdx)
+        {
+            prio = iterPD->prio;
+            break;
+        }
     }
+    appHandle->iface[socketIdx].rcvPrio = prio;
 }
 
-#if MD_SUPPORT
+#if TRDP_PD_SUB_HASH_SIZE > 0
 /**********************************************************************************************************************/
-/** Return the element with same comId from MD queue
- *
- *  @param[in]      pHead           pointer to head of queue
- *  @param[in]      addr            Pub/Sub handle (Address, ComID, srcIP & dest IP) to search for
+/** Link a subscription into its comId bucket at the position it has in the receive queue
+ *  The element is inserted before the next element of the queue which is in the same bucket, bucket order stays
+ *  queue order.
  *
- *  @retval         != NULL         pointer to PD element
- *  @retval         NULL            No PD element found
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pNew            pointer to element already in the receive queue
  */
-MD_ELE_T *trdp_MDqueueFindAddr (
-    MD_ELE_T            *pHead,
-    TRDP_ADDRESSES_T    *addr)
+static void trdp_rcvHashLink (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pNew)
 {
-    MD_ELE_T *iterMD;
+    UINT32      bucket = TRDP_SUB_HASH(pNew->addr.comId);
+    PD_ELE_T    *pNextInBucket;
+    PD_ELE_T    * *ppIter;
 
-    if (pHead == NULL || addr == NULL)
+    for (pNextInBucket = pNew->pNext; pNextInBucket != NULL; pNextInBucket = pNextInBucket->pNext)
     {
-        return NULL;
+        if (TRDP_SUB_HASH(pNextInBucket->addr.comId) == bucket)
+        {
+            break;
+        }
     }
 
-    for (iterMD = pHead; iterMD != NULL; iterMD = iterMD->pNext)
+    for (ppIter = &appHandle->pRcvHash[bucket]; (*ppIter != NULL) && (*ppIter != pNextInBucket);
+         ppIter = &(*ppIter)->pNextHash)
     {
-        /*  We match if src/dst address is zero or found */
-        if ((iterMD->addr.comId == addr->comId)
-            && ((addr->srcIpAddr == 0) || (iterMD->addr.srcIpAddr == addr->srcIpAddr))
-            && ((addr->destIpAddr == 0) || (iterMD->addr.destIpAddr == addr->destIpAddr)))
-        {
-            return iterMD;
-        }
+        ;
     }
-    return NULL;
+    pNew->pNextHash = *ppIter;
+    *ppIter         = pNew;
 }
 
 /**********************************************************************************************************************/
-/** Delete an element from MD queue
+/** Unlink a subscription from its comId bucket
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pDelete         pointer to element to delete
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pDelete         pointer to element to unlink
  */
-void    trdp_MDqueueDelElement (
-    MD_ELE_T    * *ppHead,
-    MD_ELE_T    *pDelete)
+static void trdp_rcvHashUnlink (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pDelete)
 {
-    MD_ELE_T *iterMD;
-
-    if (ppHead == NULL || *ppHead == NULL || pDelete == NULL)
-    {
-        return;
-    }
-
-    /*    handle removal of first element    */
-    if (pDelete == *ppHead)
-    {
-        *ppHead = pDelete->pNext;
-        return;
-    }
+    PD_ELE_T * *ppIter;
 
-    for (iterMD = *ppHead; iterMD != NULL; iterMD = iterMD->pNext)
+    for (ppIter = &appHandle->pRcvHash[TRDP_SUB_HASH(pDelete->addr.comId)]; *ppIter != NULL;
+         ppIter = &(*ppIter)->pNextHash)
     {
-        if (iterMD->pNext && iterMD->pNext == pDelete)
+        if (*ppIter == pDelete)
         {
-            iterMD->pNext = pDelete->pNext;
-            return;
+            *ppIter = pDelete->pNextHash;
+            break;
         }
     }
+    pDelete->pNextHash = NULL;
 }
+#endif
 
 /**********************************************************************************************************************/
-/** Append an element at end of queue
+/** Append a subscription at end of its priority in the receive queue (and at the same position in its comId bucket)
+ *  The sockets of subscriptions with higher priority are read first.
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
  *  @param[in]      pNew            pointer to element to append
  */
-void    trdp_MDqueueAppLast (
-    MD_ELE_T    * *ppHead,
-    MD_ELE_T    *pNew)
+void    trdp_rcvQueueAppLast (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pNew)
 {
-    MD_ELE_T *iterMD;
-
-    if (ppHead == NULL || pNew == NULL)
+    if (appHandle == NULL || pNew == NULL)
     {
         return;
     }
 
-    /* Ensure this element is last! */
-    pNew->pNext = NULL;
-
-    if (*ppHead == NULL)
-    {
-        *ppHead = pNew;
-        return;
-    }
+    trdp_queueInsPrio(&appHandle->pRcvQueue, pNew, FALSE);
+    trdp_rcvSockPrio(appHandle, pNew->socketIdx);
+    appHandle->stats.pd.numSubs++;
+    trdp_srcTableFree(appHandle);
 
-    for (iterMD = *ppHead; iterMD->pNext != NULL; iterMD = iterMD->pNext)
-    {
-        ;
-    }
-    iterMD->pNext = pNew;
+#if TRDP_PD_SUB_HASH_SIZE > 0
+    trdp_rcvHashLink(appHandle, pNew);
+#endif
 }
 
+
 /**********************************************************************************************************************/
-/** Insert an element at front of MD queue
+/** Move a subscription behind the others of a new priority in the receive queue (and in its comId bucket)
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pNew            pointer to element to insert
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pEle            pointer to element to move
+ *  @param[in]      prio            new priority
  */
-void    trdp_MDqueueInsFirst (
-    MD_ELE_T    * *ppHead,
-    MD_ELE_T    *pNew)
+void    trdp_rcvQueueSetPrio (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pEle,
+    UINT8           prio)
 {
-    if (ppHead == NULL || pNew == NULL)
+    if (appHandle == NULL || pEle == NULL || pEle->prio == prio)
     {
         return;
     }
 
-    pNew->pNext = *ppHead;
-    *ppHead     = pNew;
+#if TRDP_PD_SUB_HASH_SIZE > 0
+    trdp_rcvHashUnlink(appHandle, pEle);
+#endif
+    trdp_queueDelElement(&appHandle->pRcvQueue, pEle);
+    pEle->prio = prio;
+    trdp_queueInsPrio(&appHandle->pRcvQueue, pEle, FALSE);
+#if TRDP_PD_SUB_HASH_SIZE > 0
+    trdp_rcvHashLink(appHandle, pEle);
+#endif
+    trdp_rcvSockPrio(appHandle, pEle->socketIdx);
+    trdp_srcTableFree(appHandle);
 }
 
+
 /**********************************************************************************************************************/
-/** Initialize the UncompletedTCP pointers to null
+/** Remove a subscription from the receive queue (and its comId bucket)
  *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pDelete         pointer to element to delete
  */
-void trdp_initUncompletedTCP (TRDP_APP_SESSION_T appHandle)
+void    trdp_rcvQueueDelElement (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pDelete)
 {
-    int lIndex;
-    /* Initialize the pointers to Null */
-    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    if (appHandle == NULL || pDelete == NULL)
     {
-        appHandle->uncompletedTCP[lIndex] = NULL;
+        return;
     }
-}
+
+    trdp_queueDelElement(&appHandle->pRcvQueue, pDelete);
+    trdp_rcvSockPrio(appHandle, pDelete->socketIdx);
+    appHandle->stats.pd.numSubs--;
+    trdp_srcTableFree(appHandle);
+
+    /*  A coalesced callback must not be called for a deleted subscription  */
+    if (pDelete->cbPending != 0u)
+    {
+        PD_ELE_T * *ppPending;
+
+        for (ppPending = &appHandle->pCbPending; *ppPending != NULL; ppPending = &(*ppPending)->pNextCb)
+        {
+            if (*ppPending == pDelete)
+            {
+                *ppPending = pDelete->pNextCb;
+                break;
+            }
+        }
+        pDelete->pNextCb    = NULL;
+        pDelete->cbPending  = 0u;
+    }
+
+#if TRDP_PD_SUB_HASH_SIZE > 0
+    trdp_rcvHashUnlink(appHandle, pDelete);
 #endif
+}
 
+
+#if TRDP_PD_SRC_TABLE
 /**********************************************************************************************************************/
-/** Append an element at end of queue
+/** Order source filters by comId and position in the receive queue
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pNew            pointer to element to append
+ *  @param[in]      pArg1           first filter
+ *  @param[in]      pArg2           second filter
+ *
+ *  @retval         -1, 0, 1
  */
-void    trdp_queueAppLast (
-    PD_ELE_T    * *ppHead,
-    PD_ELE_T    *pNew)
+static int trdp_srcFilterCompare (
+    const void  *pArg1,
+    const void  *pArg2)
 {
-    PD_ELE_T *iterPD;
-
-    if (ppHead == NULL || pNew == NULL)
-    {
-        return;
-    }
-
-    /* Ensure this element is last! */
-    pNew->pNext = NULL;
+    const TRDP_SRC_FILTER_T *pFilter1   = (const TRDP_SRC_FILTER_T *) pArg1;
+    const TRDP_SRC_FILTER_T *pFilter2   = (const TRDP_SRC_FILTER_T *) pArg2;
 
-    if (*ppHead == NULL)
+    if (pFilter1->comId != pFilter2->comId)
     {
-        *ppHead = pNew;
-        return;
+        return (pFilter1->comId < pFilter2->comId) ? -1 : 1;
     }
-
-    for (iterPD = *ppHead; iterPD->pNext != NULL; iterPD = iterPD->pNext)
+    if (pFilter1->order != pFilter2->order)
     {
-        ;
+        return (pFilter1->order < pFilter2->order) ? -1 : 1;
     }
-    iterPD->pNext = pNew;
+    return 0;
 }
 
 /**********************************************************************************************************************/
-/** Insert an element at front of queue
+/** Order IP addresses
  *
- *  @param[in]      ppHead          pointer to pointer to head of queue
- *  @param[in]      pNew            pointer to element to insert
+ *  @param[in]      pArg1           first address
+ *  @param[in]      pArg2           second address
+ *
+ *  @retval         -1, 0, 1
  */
-void    trdp_queueInsFirst (
-    PD_ELE_T    * *ppHead,
-    PD_ELE_T    *pNew)
+static int trdp_srcIpCompare (
+    const void  *pArg1,
+    const void  *pArg2)
 {
-    if (ppHead == NULL || pNew == NULL)
-    {
-        return;
-    }
+    TRDP_IP_ADDR_T  ip1 = *(const TRDP_IP_ADDR_T *) pArg1;
+    TRDP_IP_ADDR_T  ip2 = *(const TRDP_IP_ADDR_T *) pArg2;
 
-    pNew->pNext = *ppHead;
-    *ppHead     = pNew;
+    return (ip1 < ip2) ? -1 : ((ip1 > ip2) ? 1 : 0);
 }
 
 /**********************************************************************************************************************/
-/** Handle the socket pool: Initialize it
+/** Append the segments of one comId to the source table
+ *  A segment starts at 0, at the first IP of a filter or behind its last IP, if the set of filters covering it
+ *  differs from the segment before. If pTable->pSeg is NULL, the segments and their subscriptions are only counted.
  *
- *  @param[in]      iface          pointer to the socket pool
+ *  @param[in]      pFilter         filters of the comId in queue order
+ *  @param[in]      filterCnt       number of filters
+ *  @param[in]      pBound          buffer for 2 * filterCnt + 1 segment bounds
+ *  @param[in,out]  pTable          source table, segCnt is incremented
+ *  @param[in,out]  pSubCnt         number of subscription entries, incremented
  */
-void trdp_initSockets (TRDP_SOCKETS_T iface[])
+static void trdp_srcTableGroup (
+    const TRDP_SRC_FILTER_T *pFilter,
+    UINT32                  filterCnt,
+    TRDP_IP_ADDR_T          *pBound,
+    TRDP_SRC_TABLE_T        *pTable,
+    UINT32                  *pSubCnt)
 {
-    int lIndex;
-    /* Clear the socket pool */
-    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    UINT32  boundCnt = 1u;
+    UINT32  i;
+    UINT32  j;
+
+    pBound[0] = VOS_INADDR_ANY;
+    for (i = 0u; i < filterCnt; i++)
     {
-        iface[lIndex].sock = VOS_INVALID_SOCKET;
+        pBound[boundCnt++] = pFilter[i].lowIp;
+        if (pFilter[i].highIp != 0xFFFFFFFFu)
+        {
+            pBound[boundCnt++] = pFilter[i].highIp + 1u;
+        }
+    }
+    vos_qsort(pBound, boundCnt, sizeof(TRDP_IP_ADDR_T), trdp_srcIpCompare);
+
+    for (i = 0u; i < boundCnt; i++)
+    {
+        BOOL8           changed = (i == 0u);
+        TRDP_SRC_SEG_T  *pSeg   = NULL;
+
+        for (j = 0u; (j < filterCnt) && !changed && (pBound[i] != pBound[i - 1u]); j++)
+        {
+            changed = ((pBound[i] >= pFilter[j].lowIp) && (pBound[i] <= pFilter[j].highIp)) !=
+                      ((pBound[i - 1u] >= pFilter[j].lowIp) && (pBound[i - 1u] <= pFilter[j].highIp));
+        }
+        if (!changed)
+        {
+            continue;
+        }
+        if (pTable->pSeg != NULL)
+        {
+            pSeg            = &pTable->pSeg[pTable->segCnt];
+            pSeg->comId     = pFilter[0].comId;
+            pSeg->firstIp   = pBound[i];
+            pSeg->subIdx    = *pSubCnt;
+            pSeg->subCnt    = 0u;
+        }
+        for (j = 0u; j < filterCnt; j++)
+        {
+            if ((pBound[i] >= pFilter[j].lowIp) && (pBound[i] <= pFilter[j].highIp))
+            {
+                if (pSeg != NULL)
+                {
+                    pTable->ppSub[*pSubCnt] = pFilter[j].pSub;
+                    pSeg->subCnt++;
+                }
+                (*pSubCnt)++;
+            }
+        }
+        pTable->segCnt++;
     }
 }
 
 /**********************************************************************************************************************/
-/** Handle the socket pool: Request a socket from our socket pool
- *  First we loop through the socket pool and check if there is already a socket
- *  which would suit us. If a multicast group should be joined, we do that on an otherwise suitable socket - up to 20
- *  multicast goups can be joined per socket.
- *  If a socket for multicast publishing is requested, we also use the source IP to determine the interface for outgoing
- *  multicast traffic.
+/** Build the source table from the filters of the receive queue
+ *  A subscription without source IP covers all sources, one with a range covers srcIpAddr...srcIpAddr2, else
+ *  srcIpAddr only (as trdp_subAddrMatches()).
  *
- *  @param[in,out]  iface           socket pool
- *  @param[in]      port            port to use
- *  @param[in]      params          parameters to use
- *  @param[in]      srcIP           IP to bind to (0 = any address)
- *  @param[in]      mcGroup         MC group to join (0 = do not join)
- *  @param[in]      usage           type and port to bind to (PD, MD/UDP, MD/TCP)
- *  @param[in]      options         blocking/nonblocking
- *  @param[in]      rcvMostly       primarily used for receiving (tbd: bind on sender, too?)
- *  @param[out]     useSocket       socket to use, do not open a new one
- *  @param[out]     pIndex          returned index of socket pool
- *  @param[in]      cornerIp        only used for receiving
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
  *
- *  @retval         TRDP_NO_ERR
- *  @retval         TRDP_PARAM_ERR
+ *  @retval         TRUE            table valid
+ *  @retval         FALSE           out of memory
  */
-TRDP_ERR_T  trdp_requestSocket (
-    TRDP_SOCKETS_T          iface[],
-    UINT16                  port,
-    const TRDP_SEND_PARAM_T *params,
-    TRDP_IP_ADDR_T          srcIP,
-    TRDP_IP_ADDR_T          mcGroup,
-    TRDP_SOCK_TYPE_T        usage,
-    TRDP_OPTION_T           options,
-    BOOL8                   rcvMostly,
-    SOCKET                  useSocket,
-    INT32                   *pIndex,
-    TRDP_IP_ADDR_T          cornerIp)
+static BOOL8 trdp_srcTableBuild (
+    TRDP_SESSION_PT appHandle)
 {
-    VOS_SOCK_OPT_T  sock_options;
-    INT32           lIndex;
-    INT32           emptySockIdx = -1;  /* was emptySock, renamed to avoid confusion */
-    TRDP_ERR_T      err         = TRDP_NO_ERR;
-    TRDP_IP_ADDR_T  bindAddr    = vos_determineBindAddr(srcIP, mcGroup, rcvMostly);
-
-    if (iface == NULL || params == NULL || pIndex == NULL)
+    TRDP_SRC_TABLE_T    *pTable     = &appHandle->srcTable;
+    TRDP_SRC_FILTER_T   *pFilter    = NULL;
+    TRDP_IP_ADDR_T      *pBound     = NULL;
+    PD_ELE_T            *iterPD;
+    UINT32              filterCnt   = 0u;
+    UINT32              subCnt      = 0u;
+    UINT32              pass;
+    UINT32              i;
+    UINT32              j;
+
+    trdp_srcTableFree(appHandle);
+
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        return TRDP_PARAM_ERR;
+        filterCnt++;
+    }
+    if (filterCnt == 0u)
+    {
+        pTable->valid = TRUE;
+        return TRUE;
     }
 
-    /*  We loop through the table of open/used sockets,
-     if we find a usable one (with the same socket options) we take it.
-     if we search for a multicast group enabled socket, we also search the list of mc groups (max. 20)
-     and possibly add that group, if everything else fits.
-     We remember already closed sockets on the way to be able to fill up gaps  */
+    pFilter = (TRDP_SRC_FILTER_T *) vos_memAlloc(filterCnt * sizeof(TRDP_SRC_FILTER_T));
+    pBound  = (TRDP_IP_ADDR_T *) vos_memAlloc((2u * filterCnt + 1u) * sizeof(TRDP_IP_ADDR_T));
+    if ((pFilter == NULL) || (pBound == NULL))
+    {
+        goto failed;
+    }
 
-    for (lIndex = 0; lIndex < sCurrentMaxSocketCnt; lIndex++)
+    for (i = 0u, iterPD = appHandle->pRcvQueue; iterPD != NULL; i++, iterPD = iterPD->pNext)
     {
-        /*  Check if the wanted socket is already in our list; if yes, increment usage */
-        if (useSocket != VOS_INVALID_SOCKET &&
-            useSocket == iface[lIndex].sock)
+        pFilter[i].comId    = iterPD->addr.comId;
+        pFilter[i].order    = i;
+        pFilter[i].pSub     = iterPD;
+        if (iterPD->addr.srcIpAddr == VOS_INADDR_ANY)
         {
-            /* Use that socket */
-            *pIndex = lIndex;
-            iface[lIndex].usage++;
-            err = TRDP_NO_ERR;
-            goto err_exit;
+            pFilter[i].lowIp    = VOS_INADDR_ANY;
+            pFilter[i].highIp   = 0xFFFFFFFFu;
         }
-        else if ((iface[lIndex].sock != VOS_INVALID_SOCKET)
-                 && (iface[lIndex].bindAddr == bindAddr)
-                 && (iface[lIndex].type == usage)
-                 && (iface[lIndex].sendParam.qos == params->qos)
-                 && (iface[lIndex].sendParam.ttl == params->ttl)
-                 && (iface[lIndex].rcvMostly == rcvMostly)
-                 && ((usage != TRDP_SOCK_MD_TCP)
-                     || ((usage == TRDP_SOCK_MD_TCP) && (iface[lIndex].tcpParams.cornerIp == cornerIp))))
+        else
         {
-            /*  Did this socket join the required multicast group?  */
-            if (mcGroup != 0 && trdp_SockIsJoined(iface[lIndex].mcGroups, mcGroup) == FALSE)
+            pFilter[i].lowIp    = iterPD->addr.srcIpAddr;
+            pFilter[i].highIp   = (iterPD->addr.srcIpAddr2 > iterPD->addr.srcIpAddr) ?
+                                  iterPD->addr.srcIpAddr2 : iterPD->addr.srcIpAddr;
+        }
+    }
+    vos_qsort(pFilter, filterCnt, sizeof(TRDP_SRC_FILTER_T), trdp_srcFilterCompare);
+
+    /*  Count the segments first, then fill them in   */
+    for (pass = 0u; pass < 2u; pass++)
+    {
+        pTable->segCnt  = 0u;
+        subCnt          = 0u;
+        for (i = 0u; i < filterCnt; i = j)
+        {
+            for (j = i + 1u; (j < filterCnt) && (pFilter[j].comId == pFilter[i].comId); j++)
             {
-                /*  No, but can we add it? */
-                if (trdp_SockAddJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
-                {
-                    continue;   /* No, socket cannot join more MC groups */
-                }
-                else
-                {
-                    if (vos_sockJoinMC(iface[lIndex].sock, mcGroup, srcIP) != VOS_NO_ERR)
-                    {
-                        if (trdp_SockDelJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
-                        {
-                            vos_printLogStr(VOS_LOG_ERROR, "trdp_SockDelJoin() failed!\n");
-                        }
-                        continue;   /* No, socket cannot join more MC groups */
-                    }
-                }
+                ;
             }
-
-/* add_start TOSHIBA 0306 */
-            if ((usage != TRDP_SOCK_MD_TCP)
-                && (iface[lIndex].bindAddr != 0)
-                && !vos_isMulticast(iface[lIndex].bindAddr))
+            trdp_srcTableGroup(&pFilter[i], j - i, pBound, pTable, &subCnt);
+        }
+        if (pass == 0u)
+        {
+            pTable->pSeg    = (TRDP_SRC_SEG_T *) vos_memAlloc(pTable->segCnt * sizeof(TRDP_SRC_SEG_T));
+            pTable->ppSub   = (PD_ELE_T * *) vos_memAlloc(subCnt * sizeof(PD_ELE_T *));
+            if ((pTable->pSeg == NULL) || (pTable->ppSub == NULL))
             {
-                err = (TRDP_ERR_T) vos_sockSetMulticastIf(iface[lIndex].sock, iface[lIndex].bindAddr);
-                if (err != TRDP_NO_ERR)
-                {
-                    /* Avoid to excessive error reporting:
-                    vos_printLog(VOS_LOG_WARNING, "vos_sockSetMulticastIf() for UDP snd failed! (Err: %d)\n", err); */
-                }
+                goto failed;
             }
-/* add_end TOSHIBA */
+        }
+    }
 
-            /* Use that socket */
-            *pIndex = lIndex;
+    vos_memFree(pFilter);
+    vos_memFree(pBound);
+    pTable->valid = TRUE;
+    return TRUE;
 
-            /*  Ticket #174: Usage should always be counted up, except
-             if there was an error (multicast IF) */
-            if (err == TRDP_NO_ERR)
-            {
-                iface[lIndex].usage++;
-            }
+failed:
+    vos_printLogStr(VOS_LOG_WARNING, "Source table not built, out of memory\n");
+    if (pFilter != NULL)
+    {
+        vos_memFree(pFilter);
+    }
+    if (pBound != NULL)
+    {
+        vos_memFree(pBound);
+    }
+    trdp_srcTableFree(appHandle);
+    return FALSE;
+}
 
-            goto err_exit;
-        }
-        else if ((iface[lIndex].sock == VOS_INVALID_SOCKET) && (emptySockIdx == -1))
-        {
-            /* Remember the first empty slot */
-            emptySockIdx = lIndex;
-        }
+/**********************************************************************************************************************/
+/** Return all subscriptions of a comId matching a source IP, in the order of the receive queue
+ *  The source table is rebuilt first, if the subscriptions changed since the last lookup.
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      comId           received comId
+ *  @param[in]      srcIpAddr       received source IP
+ *  @param[out]     pppSub          matching subscriptions, NULL if none
+ *  @param[out]     pSubCnt         number of matching subscriptions
+ *
+ *  @retval         TRUE            looked up
+ *  @retval         FALSE           no source table (out of memory), search the receive queue
+ */
+BOOL8 trdp_srcTableFind (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    PD_ELE_T        * * *pppSub,
+    UINT32          *pSubCnt)
+{
+    const TRDP_SRC_TABLE_T  *pTable = &appHandle->srcTable;
+    UINT32                  low     = 0u;
+    UINT32                  high;
+
+    if (!pTable->valid && !trdp_srcTableBuild(appHandle))
+    {
+        return FALSE;
     }
 
-    /* Not found, create a new socket entry */
-    if (lIndex < VOS_MAX_SOCKET_CNT)
+    /*  Find the last segment starting at or below (comId, srcIpAddr)   */
+    high = pTable->segCnt;
+    while (low < high)
     {
-        if ((emptySockIdx != -1)
-            && (lIndex != emptySockIdx))
+        UINT32 mid = low + (high - low) / 2u;
+
+        if ((pTable->pSeg[mid].comId < comId) ||
+            ((pTable->pSeg[mid].comId == comId) && (pTable->pSeg[mid].firstIp <= srcIpAddr)))
         {
-            lIndex = emptySockIdx;
+            low = mid + 1u;
         }
         else
         {
-            sCurrentMaxSocketCnt = lIndex + 1;
+            high = mid;
         }
+    }
 
-        iface[lIndex].sock          = VOS_INVALID_SOCKET;
-        iface[lIndex].bindAddr      = bindAddr /* was srcIP (ID #125) */;
-        iface[lIndex].type          = usage;
-        iface[lIndex].sendParam.qos = params->qos;
-        iface[lIndex].sendParam.ttl = params->ttl;
-        iface[lIndex].rcvMostly     = rcvMostly;
-        iface[lIndex].tcpParams.connectionTimeout.tv_sec    = 0;
-        iface[lIndex].tcpParams.connectionTimeout.tv_usec   = 0;
-        iface[lIndex].tcpParams.cornerIp    = cornerIp;
-        iface[lIndex].tcpParams.sendNotOk   = FALSE;
-        iface[lIndex].usage = 0;
-        iface[lIndex].tcpParams.notSend     = FALSE;
+    *pppSub     = NULL;
+    *pSubCnt    = 0u;
+    if ((low > 0u) && (pTable->pSeg[low - 1u].comId == comId) && (pTable->pSeg[low - 1u].subCnt > 0u))
+    {
+        *pppSub     = &pTable->ppSub[pTable->pSeg[low - 1u].subIdx];
+        *pSubCnt    = pTable->pSeg[low - 1u].subCnt;
+    }
+    return TRUE;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Release the source table, it is rebuilt on the next lookup
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ */
+void trdp_srcTableFree (
+    TRDP_SESSION_PT appHandle)
+{
+#if TRDP_PD_SRC_TABLE
+    if (appHandle->srcTable.pSeg != NULL)
+    {
+        vos_memFree(appHandle->srcTable.pSeg);
+    }
+    if (appHandle->srcTable.ppSub != NULL)
+    {
+        vos_memFree(appHandle->srcTable.ppSub);
+    }
+    appHandle->srcTable.pSeg    = NULL;
+    appHandle->srcTable.ppSub   = NULL;
+    appHandle->srcTable.segCnt  = 0u;
+    appHandle->srcTable.valid   = FALSE;
+#else
+    (void) appHandle;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Build the source table now instead of on the next lookup (TRDP_OPTION_PREALLOCATE)
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ */
+void trdp_srcTablePrepare (
+    TRDP_SESSION_PT appHandle)
+{
+#if TRDP_PD_SRC_TABLE
+    if (!appHandle->srcTable.valid)
+    {
+        (void) trdp_srcTableBuild(appHandle);
+    }
+#else
+    (void) appHandle;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Return the first subscription matching a received PD
+ *  Looks the subscription up in the source table, if enabled, else searches the comId bucket.
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      addr            received addressing (comId, srcIP)
+ *
+ *  @retval         != NULL         pointer to PD element
+ *  @retval         NULL            No PD element found
+ */
+PD_ELE_T *trdp_rcvQueueFindSrc (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ADDRESSES_T    *addr)
+{
+#if TRDP_PD_SRC_TABLE
+    PD_ELE_T    * *ppSub;
+    UINT32      subCnt;
+
+    if (trdp_srcTableFind(appHandle, addr->comId, addr->srcIpAddr, &ppSub, &subCnt))
+    {
+        return (subCnt > 0u) ? ppSub[0] : NULL;
+    }
+#endif
+    return trdp_rcvQueueFindSubAddr(appHandle, addr);
+}
+
+
+/**********************************************************************************************************************/
+/** Return the publisher with the given comId
+ *  If the comId index is enabled, only the bucket of the comId is searched. New publishers are inserted at the head
+ *  of the send queue and of their bucket, the result is the same as from trdp_queueFindComId().
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      comId           ComID to search for
+ *
+ *  @retval         != NULL         pointer to PD element
+ *  @retval         NULL            No PD element found
+ */
+PD_ELE_T *trdp_sndQueueFindComId (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId)
+{
+#if TRDP_PD_PUB_HASH_SIZE > 0
+    PD_ELE_T *iterPD;
+
+    if (appHandle == NULL)
+    {
+        return NULL;
+    }
+
+    for (iterPD = appHandle->pSndHash[TRDP_PUB_HASH(comId)]; iterPD != NULL; iterPD = iterPD->pNextHash)
+    {
+        if (iterPD->addr.comId == comId)
+        {
+            return iterPD;
+        }
+    }
+    return NULL;
+#else
+    if (appHandle == NULL)
+    {
+        return NULL;
+    }
+    return trdp_queueFindComId(appHandle->pSndQueue, comId);
+#endif
+}
+
+
+/**********************************************************************************************************************/
+/** Insert a publisher at the front of its priority in the send queue (and at the front of its comId bucket)
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pNew            pointer to element to insert
+ */
+void    trdp_sndQueueInsFirst (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pNew)
+{
+    if (appHandle == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    trdp_queueInsPrio(&appHandle->pSndQueue, pNew, TRUE);
+    trdp_seqPubList(pNew);
+
+#if TRDP_PD_PUB_HASH_SIZE > 0
+    pNew->pNextHash = appHandle->pSndHash[TRDP_PUB_HASH(pNew->addr.comId)];
+    appHandle->pSndHash[TRDP_PUB_HASH(pNew->addr.comId)] = pNew;
+#endif
+}
+
+
+/**********************************************************************************************************************/
+/** Remove a publisher from the send queue (and its comId bucket)
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pDelete         pointer to element to delete
+ */
+void    trdp_sndQueueDelElement (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pDelete)
+{
+#if TRDP_PD_PUB_HASH_SIZE > 0
+    PD_ELE_T * *ppIter;
+#endif
+
+    if (appHandle == NULL || pDelete == NULL)
+    {
+        return;
+    }
+
+    trdp_queueDelElement(&appHandle->pSndQueue, pDelete);
+    trdp_seqPubUnlist(pDelete);
+
+#if TRDP_PD_PUB_HASH_SIZE > 0
+    for (ppIter = &appHandle->pSndHash[TRDP_PUB_HASH(pDelete->addr.comId)]; *ppIter != NULL;
+         ppIter = &(*ppIter)->pNextHash)
+    {
+        if (*ppIter == pDelete)
+        {
+            *ppIter = pDelete->pNextHash;
+            break;
+        }
+    }
+    pDelete->pNextHash = NULL;
+#endif
+}
+
+
+/**********************************************************************************************************************/
+/** Delete an element
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pDelete         pointer to element to delete
+ */
+void    trdp_queueDelElement (
+    PD_ELE_T    * *ppHead,
+    PD_ELE_T    *pDelete)
+{
+    PD_ELE_T *iterPD;
+
+    if (ppHead == NULL || *ppHead == NULL || pDelete == NULL)
+    {
+        return;
+    }
+
+    /* handle removal of first element */
+    if (pDelete == *ppHead)
+    {
+        *ppHead = pDelete->pNext;
+        return;
+    }
+
+    for (iterPD = *ppHead; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if (iterPD->pNext && iterPD->pNext == pDelete)
+        {
+            iterPD->pNext = pDelete->pNext;
+            return;
+        }
+    }
+}
+
+
+/**********************************************************************************************************************/
+/** Check topography counters
+ *  The applied conformance pattern follows Table A.5/A.21 (positive match):
+ *  Telegram to be sent   Locally stored value (appSession)
+ *  Case etbTopoCnt opTrnTopoCnt etbTopoCntFilter opTrnTopoCntFilter
+ *  1    any        any          0                0
+ *  2    any        equal        0                equal
+ *  3    equal      any          equal            0
+ *  4    equal      equal        equal            equal
+ *
+ *  @param[in]      etbTopoCnt              ETB topography counter to be checked
+ *  @param[in]      opTrnTopoCnt            Operational topography counter to be checked
+ *  @param[in]      etbTopoCntFilter        ETB topography counter filter value
+ *  @param[in]      opTrnTopoCntFilter      Operational topography counter filter value
+ *
+ *  @retval         TRUE           Filter criteria matched
+ *                  FALSE          Filter criteria not matched
+ */
+BOOL8 trdp_validTopoCounters (
+    UINT32  etbTopoCnt,
+    UINT32  opTrnTopoCnt,
+    UINT32  etbTopoCntFilter,
+    UINT32  opTrnTopoCntFilter)
+{
+    if (((etbTopoCntFilter == 0) || (etbTopoCnt == etbTopoCntFilter))
+        &&
+        ((opTrnTopoCntFilter == 0) || (opTrnTopoCnt == opTrnTopoCntFilter)))
+    {
+        return TRUE;
+    }
+    else
+    {
+        return FALSE;
+    }
+}
+
+#if MD_SUPPORT
+/**********************************************************************************************************************/
+/** Return the element with same comId from MD queue
+ *
+ *  @param[in]      pHead           pointer to head of queue
+ *  @param[in]      addr            Pub/Sub handle (Address, ComID, srcIP & dest IP) to search for
+ *
+ *  @retval         != NULL         pointer to PD element
+ *  @retval         NULL            No PD element found
+ */
+MD_ELE_T *trdp_MDqueueFindAddr (
+    MD_ELE_T            *pHead,
+    TRDP_ADDRESSES_T    *addr)
+{
+    MD_ELE_T *iterMD;
+
+    if (pHead == NULL || addr == NULL)
+    {
+        return NULL;
+    }
+
+    for (iterMD = pHead; iterMD != NULL; iterMD = iterMD->pNext)
+    {
+        /*  We match if src/dst address is zero or found */
+        if ((iterMD->addr.comId == addr->comId)
+            && ((addr->srcIpAddr == 0) || (iterMD->addr.srcIpAddr == addr->srcIpAddr))
+            && ((addr->destIpAddr == 0) || (iterMD->addr.destIpAddr == addr->destIpAddr)))
+        {
+            return iterMD;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Delete an element from MD queue
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pDelete         pointer to element to delete
+ */
+void    trdp_MDqueueDelElement (
+    MD_ELE_T    * *ppHead,
+    MD_ELE_T    *pDelete)
+{
+    MD_ELE_T *iterMD;
+
+    if (ppHead == NULL || *ppHead == NULL || pDelete == NULL)
+    {
+        return;
+    }
+
+    /*    handle removal of first element    */
+    if (pDelete == *ppHead)
+    {
+        *ppHead = pDelete->pNext;
+        return;
+    }
+
+    for (iterMD = *ppHead; iterMD != NULL; iterMD = iterMD->pNext)
+    {
+        if (iterMD->pNext && iterMD->pNext == pDelete)
+        {
+            iterMD->pNext = pDelete->pNext;
+            return;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Append an element at end of queue
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pNew            pointer to element to append
+ */
+void    trdp_MDqueueAppLast (
+    MD_ELE_T    * *ppHead,
+    MD_ELE_T    *pNew)
+{
+    MD_ELE_T *iterMD;
+
+    if (ppHead == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    /* Ensure this element is last! */
+    pNew->pNext = NULL;
+
+    if (*ppHead == NULL)
+    {
+        *ppHead = pNew;
+        return;
+    }
+
+    for (iterMD = *ppHead; iterMD->pNext != NULL; iterMD = iterMD->pNext)
+    {
+        ;
+    }
+    iterMD->pNext = pNew;
+}
+
+/**********************************************************************************************************************/
+/** Insert an element at front of MD queue
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pNew            pointer to element to insert
+ */
+void    trdp_MDqueueInsFirst (
+    MD_ELE_T    * *ppHead,
+    MD_ELE_T    *pNew)
+{
+    if (ppHead == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    pNew->pNext = *ppHead;
+    *ppHead     = pNew;
+}
+
+#if TRDP_MD_SESSION_HASH_SIZE > 0
+/**********************************************************************************************************************/
+/** Bucket of a session ID in the MD session index (FNV-1a over the UUID)
+ *
+ *  @param[in]      pSessionId      UUID as a byte stream
+ *
+ *  @retval         bucket index
+ */
+static UINT32 trdp_MDsessionHash (
+    const UINT8 *pSessionId)
+{
+    UINT32  hash = 2166136261u;
+    UINT32  i;
+
+    for (i = 0u; i < TRDP_SESS_ID_SIZE; i++)
+    {
+        hash = (hash ^ pSessionId[i]) * 16777619u;
+    }
+    return hash % TRDP_MD_SESSION_HASH_SIZE;
+}
+
+/**********************************************************************************************************************/
+/** Return the session ID index belonging to an MD queue
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      ppHead          pointer to the head of the send or the receive queue of the session
+ *
+ *  @retval         bucket array of the queue
+ */
+static MD_ELE_T **trdp_MDqueueHash (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        * *ppHead)
+{
+    return (ppHead == &appHandle->pMDSndQueue) ? appHandle->pMDSndHash : appHandle->pMDRcvHash;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Insert an MD session into the send or receive queue of the session (and its session ID bucket)
+ *  The session ID of the element must be set and must not change until trdp_MDqueueDelSession().
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      ppHead          &appHandle->pMDSndQueue or &appHandle->pMDRcvQueue
+ *  @param[in]      pNew            pointer to element to insert
+ *  @param[in]      appendLast      TRUE to append the element, FALSE to insert it at the front
+ */
+void    trdp_MDqueueInsSession (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        * *ppHead,
+    MD_ELE_T        *pNew,
+    BOOL8           appendLast)
+{
+#if TRDP_MD_SESSION_HASH_SIZE > 0
+    MD_ELE_T * *pHash;
+    UINT32      bucket;
+#endif
+
+    if (appHandle == NULL || ppHead == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    if (appendLast == TRUE)
+    {
+        trdp_MDqueueAppLast(ppHead, pNew);
+    }
+    else
+    {
+        trdp_MDqueueInsFirst(ppHead, pNew);
+    }
+    if (ppHead == &appHandle->pMDRcvQueue)
+    {
+        appHandle->numMDRcvSessions++;
+    }
+
+#if TRDP_MD_SESSION_HASH_SIZE > 0
+    pHash           = trdp_MDqueueHash(appHandle, ppHead);
+    bucket          = trdp_MDsessionHash(pNew->sessionID);
+    pNew->pNextHash = pHash[bucket];
+    pHash[bucket]   = pNew;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Remove an MD session from the send or receive queue of the session (and its session ID bucket)
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      ppHead          &appHandle->pMDSndQueue or &appHandle->pMDRcvQueue
+ *  @param[in]      pDelete         pointer to element to delete
+ */
+void    trdp_MDqueueDelSession (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        * *ppHead,
+    MD_ELE_T        *pDelete)
+{
+#if TRDP_MD_SESSION_HASH_SIZE > 0
+    MD_ELE_T * *ppIter;
+#endif
+
+    if (appHandle == NULL || ppHead == NULL || pDelete == NULL)
+    {
+        return;
+    }
+
+    trdp_MDqueueDelElement(ppHead, pDelete);
+    if ((ppHead == &appHandle->pMDRcvQueue) && (appHandle->numMDRcvSessions > 0u))
+    {
+        appHandle->numMDRcvSessions--;
+    }
+
+#if TRDP_MD_SESSION_HASH_SIZE > 0
+    for (ppIter = &trdp_MDqueueHash(appHandle, ppHead)[trdp_MDsessionHash(pDelete->sessionID)]; *ppIter != NULL;
+         ppIter = &(*ppIter)->pNextHash)
+    {
+        if (*ppIter == pDelete)
+        {
+            *ppIter = pDelete->pNextHash;
+            break;
+        }
+    }
+    pDelete->pNextHash = NULL;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Return the next MD session with the given session ID from the send or receive queue
+ *  If the session ID index is enabled, only the bucket of the session ID is searched.
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      ppHead          &appHandle->pMDSndQueue or &appHandle->pMDRcvQueue
+ *  @param[in]      pSessionId      session ID to search for
+ *  @param[in]      pPrev           element returned by the previous call, NULL to start the search
+ *
+ *  @retval         != NULL         pointer to MD element
+ *  @retval         NULL            No (further) MD element found
+ */
+MD_ELE_T *trdp_MDqueueFindSession (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        * *ppHead,
+    const UINT8     *pSessionId,
+    const MD_ELE_T  *pPrev)
+{
+    MD_ELE_T *iterMD;
+
+    if (appHandle == NULL || ppHead == NULL || pSessionId == NULL)
+    {
+        return NULL;
+    }
+
+#if TRDP_MD_SESSION_HASH_SIZE > 0
+    iterMD = (pPrev != NULL) ? pPrev->pNextHash :
+             trdp_MDqueueHash(appHandle, ppHead)[trdp_MDsessionHash(pSessionId)];
+    for (; iterMD != NULL; iterMD = iterMD->pNextHash)
+#else
+    iterMD = (pPrev != NULL) ? pPrev->pNext : *ppHead;
+    for (; iterMD != NULL; iterMD = iterMD->pNext)
+#endif
+    {
+        if (0 == memcmp(iterMD->sessionID, pSessionId, TRDP_SESS_ID_SIZE))
+        {
+            return iterMD;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Insert a listener at the front of the listener queue of the session (and into its comId bucket)
+ *  comId and TRDP_CHECK_COMID of the listener must be set and must not change until trdp_MDlistenerDel().
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pNew            pointer to listener to insert
+ */
+void    trdp_MDlistenerIns (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pNew)
+{
+#if TRDP_MD_LISTENER_HASH_SIZE > 0
+    MD_LIS_ELE_T * *ppChain;
+#endif
+
+    if (appHandle == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    pNew->pNext = appHandle->pMDListenQueue;
+    appHandle->pMDListenQueue = pNew;
+
+#if TRDP_MD_LISTENER_HASH_SIZE > 0
+    ppChain = ((pNew->privFlags & TRDP_CHECK_COMID) != 0) ?
+        &appHandle->pMDListenHash[TRDP_LIS_HASH(pNew->addr.comId)] : &appHandle->pMDListenAny;
+    pNew->order     = ++appHandle->mdListenOrder;
+    pNew->pNextHash = *ppChain;
+    *ppChain        = pNew;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Remove a listener from the listener queue of the session (and from its comId bucket)
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pDelete         pointer to listener to delete
+ *
+ *  @retval         TRUE            listener was found and removed
+ *  @retval         FALSE           listener is not queued
+ */
+BOOL8   trdp_MDlistenerDel (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pDelete)
+{
+    MD_LIS_ELE_T * *ppIter;
+
+    if (appHandle == NULL || pDelete == NULL)
+    {
+        return FALSE;
+    }
+
+    for (ppIter = &appHandle->pMDListenQueue; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        if (*ppIter == pDelete)
+        {
+            break;
+        }
+    }
+    if (*ppIter == NULL)
+    {
+        return FALSE;
+    }
+    *ppIter = pDelete->pNext;
+
+#if TRDP_MD_LISTENER_HASH_SIZE > 0
+    ppIter = ((pDelete->privFlags & TRDP_CHECK_COMID) != 0) ?
+        &appHandle->pMDListenHash[TRDP_LIS_HASH(pDelete->addr.comId)] : &appHandle->pMDListenAny;
+    for (; *ppIter != NULL; ppIter = &(*ppIter)->pNextHash)
+    {
+        if (*ppIter == pDelete)
+        {
+            *ppIter = pDelete->pNextHash;
+            break;
+        }
+    }
+    pDelete->pNextHash = NULL;
+#endif
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Start iterating over the listeners which may accept the given comId
+ *  With the listener index enabled, only the comId bucket and the listeners for any comId are visited. The comId,
+ *  URI and address filters still have to be applied by the caller.
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      comId           comId of the received message
+ *  @param[out]     pIter           cursor to pass to trdp_MDlistenerNext()
+ */
+void    trdp_MDlistenerFirst (
+    TRDP_SESSION_PT     appHandle,
+    UINT32              comId,
+    TRDP_MD_LIS_ITER_T  *pIter)
+{
+#if TRDP_MD_LISTENER_HASH_SIZE > 0
+    pIter->pComId   = appHandle->pMDListenHash[TRDP_LIS_HASH(comId)];
+    pIter->pAny     = appHandle->pMDListenAny;
+#else
+    (void) comId;
+    pIter->pComId   = appHandle->pMDListenQueue;
+    pIter->pAny     = NULL;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Return the next listener candidate in the order of the listener queue (newest first)
+ *
+ *  @param[in,out]  pIter           cursor set up by trdp_MDlistenerFirst()
+ *
+ *  @retval         != NULL         pointer to listener
+ *  @retval         NULL            no further listener
+ */
+MD_LIS_ELE_T *trdp_MDlistenerNext (
+    TRDP_MD_LIS_ITER_T *pIter)
+{
+    MD_LIS_ELE_T *pListener;
+
+#if TRDP_MD_LISTENER_HASH_SIZE > 0
+    /* merge both chains, each is sorted by descending insertion number */
+    if ((pIter->pAny != NULL) &&
+        ((pIter->pComId == NULL) || (pIter->pAny->order > pIter->pComId->order)))
+    {
+        pListener   = pIter->pAny;
+        pIter->pAny = pListener->pNextHash;
+    }
+    else
+    {
+        pListener = pIter->pComId;
+        if (pListener != NULL)
+        {
+            pIter->pComId = pListener->pNextHash;
+        }
+    }
+#else
+    pListener = pIter->pComId;
+    if (pListener != NULL)
+    {
+        pIter->pComId = pListener->pNext;
+    }
+#endif
+    return pListener;
+}
+
+/**********************************************************************************************************************/
+/** Initialize the UncompletedTCP pointers to null
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+void trdp_initUncompletedTCP (TRDP_APP_SESSION_T appHandle)
+{
+    int lIndex;
+    /* Initialize the pointers to Null */
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    {
+        appHandle->uncompletedTCP[lIndex] = NULL;
+    }
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Append an element at end of queue
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pNew            pointer to element to append
+ */
+void    trdp_queueAppLast (
+    PD_ELE_T    * *ppHead,
+    PD_ELE_T    *pNew)
+{
+    PD_ELE_T *iterPD;
+
+    if (ppHead == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    /* Ensure this element is last! */
+    pNew->pNext = NULL;
+
+    if (*ppHead == NULL)
+    {
+        *ppHead = pNew;
+        return;
+    }
+
+    for (iterPD = *ppHead; iterPD->pNext != NULL; iterPD = iterPD->pNext)
+    {
+        ;
+    }
+    iterPD->pNext = pNew;
+}
+
+/**********************************************************************************************************************/
+/** Insert an element at front of queue
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pNew            pointer to element to insert
+ */
+void    trdp_queueInsFirst (
+    PD_ELE_T    * *ppHead,
+    PD_ELE_T    *pNew)
+{
+    if (ppHead == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    pNew->pNext = *ppHead;
+    *ppHead     = pNew;
+}
+
+/**********************************************************************************************************************/
+/** Insert an element into a queue ordered by descending priority
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pNew            pointer to element to insert
+ *  @param[in]      first           TRUE: in front of the elements of the same priority, FALSE: behind them
+ */
+void    trdp_queueInsPrio (
+    PD_ELE_T    * *ppHead,
+    PD_ELE_T    *pNew,
+    BOOL8       first)
+{
+    PD_ELE_T * *ppIter;
+
+    if (ppHead == NULL || pNew == NULL)
+    {
+        return;
+    }
+
+    for (ppIter = ppHead; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        if (((*ppIter)->prio < pNew->prio) ||
+            (first && ((*ppIter)->prio == pNew->prio)))
+        {
+            break;
+        }
+    }
+    pNew->pNext = *ppIter;
+    *ppIter     = pNew;
+}
+
+/**********************************************************************************************************************/
+/** Handle the socket pool: Initialize it
+ *
+ *  @param[in]      iface          pointer to the socket pool
+ */
+void trdp_initSockets (TRDP_SOCKETS_T iface[])
+{
+    int lIndex;
+    /* Clear the socket pool */
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    {
+        iface[lIndex].sock = VOS_INVALID_SOCKET;
+        iface[lIndex].polled = FALSE;
+        iface[lIndex].hashKey   = 0u;
+        iface[lIndex].hashNext  = -1;
+        iface[lIndex].hashHead  = -1;
+        iface[lIndex].pMcJoins  = NULL;
+        iface[lIndex].mcJoinCnt = 0u;
+        iface[lIndex].mcJoinSize = 0u;
+        iface[lIndex].shareIdx  = 0u;
+#if TRDP_PD_URING
+        iface[lIndex].uring = NULL;
+#endif
+    }
+}
+
+/**********************************************************************************************************************/
+/** Handle the socket pool: Free the memberships lists of sockets still open when the session is closed
+ *
+ *  @param[in]      iface          pointer to the socket pool
+ */
+void trdp_freeSockets (TRDP_SOCKETS_T iface[])
+{
+    int lIndex;
+
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    {
+        /*  A shared socket still open is left, other sessions may read it  */
+        if ((iface[lIndex].sock != VOS_INVALID_SOCKET) && (iface[lIndex].shareIdx != 0u)
+            && (trdp_shareRelease(iface, lIndex) == FALSE))
+        {
+            iface[lIndex].sock = VOS_INVALID_SOCKET;
+        }
+        if (iface[lIndex].pMcJoins != NULL)
+        {
+            vos_memFree(iface[lIndex].pMcJoins);
+            iface[lIndex].pMcJoins = NULL;
+        }
+        iface[lIndex].mcJoinCnt     = 0u;
+        iface[lIndex].mcJoinSize    = 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Handle the socket pool: Request a socket from our socket pool
+ *  First we look up the sockets with the same parameter hash and check if there is already a socket
+ *  which would suit us. If a multicast group should be joined, we do that on an otherwise suitable socket - the
+ *  list of joined groups of a socket grows as needed.
+ *  If a socket for multicast publishing is requested, we also use the source IP to determine the interface for outgoing
+ *  multicast traffic.
+ *
+ *  @param[in,out]  iface           socket pool
+ *  @param[in]      port            port to use
+ *  @param[in]      params          parameters to use
+ *  @param[in]      srcIP           IP to bind to (0 = any address)
+ *  @param[in]      mcGroup         MC group to join (0 = do not join)
+ *  @param[in]      usage           type and port to bind to (PD, MD/UDP, MD/TCP)
+ *  @param[in]      options         blocking/nonblocking
+ *  @param[in]      rcvMostly       primarily used for receiving (tbd: bind on sender, too?)
+ *  @param[out]     useSocket       socket to use, do not open a new one
+ *  @param[out]     pIndex          returned index of socket pool
+ *  @param[in]      cornerIp        TCP: peer address; UDP: source of a source specific MC join (0 = any source)
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_PARAM_ERR
+ */
+TRDP_ERR_T  trdp_requestSocket (
+    TRDP_SOCKETS_T          iface[],
+    UINT16                  port,
+    const TRDP_SEND_PARAM_T *params,
+    TRDP_IP_ADDR_T          srcIP,
+    TRDP_IP_ADDR_T          mcGroup,
+    TRDP_SOCK_TYPE_T        usage,
+    TRDP_OPTION_T           options,
+    BOOL8                   rcvMostly,
+    SOCKET                  useSocket,
+    INT32                   *pIndex,
+    TRDP_IP_ADDR_T          cornerIp)
+{
+    VOS_SOCK_OPT_T  sock_options;
+    INT32           lIndex;
+    UINT32          key;
+    TRDP_ERR_T      err         = TRDP_NO_ERR;
+    TRDP_IP_ADDR_T  bindAddr    = vos_determineBindAddr(srcIP, mcGroup, rcvMostly);
+#if TRDP_PD_QOS_PER_FRAME
+    TRDP_SEND_PARAM_T   pdParams;
+#endif
+
+    if (iface == NULL || params == NULL || pIndex == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+#if TRDP_PD_QOS_PER_FRAME
+    /*  PD frames carry their QoS, one socket serves all QoS classes (launch time sockets excepted)   */
+    if ((usage == TRDP_SOCK_PD) && !params->txTime && (params->qos != 0u))
+    {
+        pdParams        = *params;
+        pdParams.qos    = 0u;
+        params          = &pdParams;
+    }
+#endif
+
+    key = trdp_sockHashKey(bindAddr, usage, params, rcvMostly, cornerIp);
+
+    /*  Check if the wanted socket is already in our list; if yes, increment usage */
+    if (useSocket != VOS_INVALID_SOCKET)
+    {
+        for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+        {
+            if (useSocket == iface[lIndex].sock)
+            {
+                /* Use that socket */
+                *pIndex = lIndex;
+                iface[lIndex].usage++;
+                err = TRDP_NO_ERR;
+                goto err_exit;
+            }
+        }
+    }
+
+    /*  We walk the bucket of sockets with the same parameter hash,
+     if we find a usable one (with the same socket options) we take it.
+     if we search for a multicast group enabled socket, we also search the list of mc groups (max. 20)
+     and possibly add that group, if everything else fits.   */
+
+    for (lIndex = iface[key % VOS_MAX_SOCKET_CNT].hashHead; lIndex != -1; lIndex = iface[lIndex].hashNext)
+    {
+        if ((iface[lIndex].sock != VOS_INVALID_SOCKET)
+            && (iface[lIndex].hashKey == key)
+            && (iface[lIndex].bindAddr == bindAddr)
+            && (iface[lIndex].type == usage)
+            && (iface[lIndex].sendParam.qos == params->qos)
+            && (iface[lIndex].sendParam.ttl == params->ttl)
+            && (iface[lIndex].sendParam.txTime == ((usage == TRDP_SOCK_PD) && params->txTime))
+            && (iface[lIndex].rcvMostly == rcvMostly)
+            && (iface[lIndex].shard == 0u)
+            && ((usage != TRDP_SOCK_MD_TCP)
+                || ((usage == TRDP_SOCK_MD_TCP) && (iface[lIndex].tcpParams.cornerIp == cornerIp)
+                    && (iface[lIndex].tcpParams.morituri == FALSE))))
+        {
+            /*  Did this socket join the required multicast group?  */
+            if ((mcGroup != 0) && (trdp_SockAddJoin(&iface[lIndex], mcGroup, cornerIp, srcIP) == FALSE))
+            {
+                continue;   /* No, socket cannot join the MC group */
+            }
+
+/* add_start TOSHIBA 0306 */
+            if ((usage != TRDP_SOCK_MD_TCP)
+                && (iface[lIndex].bindAddr != 0)
+                && !vos_isMulticast(iface[lIndex].bindAddr)
+                && (iface[lIndex].mcIfSet == FALSE))    /* the option sticks, set it once per socket */
+            {
+                err = (TRDP_ERR_T) vos_sockSetMulticastIf(iface[lIndex].sock, iface[lIndex].bindAddr);
+                if (err != TRDP_NO_ERR)
+                {
+                    /* Avoid to excessive error reporting:
+                    vos_printLog(VOS_LOG_WARNING, "vos_sockSetMulticastIf() for UDP snd failed! (Err: %d)\n", err); */
+                }
+                else
+                {
+                    iface[lIndex].mcIfSet = TRUE;
+                }
+            }
+/* add_end TOSHIBA */
+
+            /* Use that socket */
+            *pIndex = lIndex;
+
+            /*  Ticket #174: Usage should always be counted up, except
+             if there was an error (multicast IF) */
+            if (err == TRDP_NO_ERR)
+            {
+                iface[lIndex].usage++;
+            }
+
+            goto err_exit;
+        }
+    }
+
+    /* Not found, fill up the first gap left by a closed socket */
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    {
+        if (iface[lIndex].sock == VOS_INVALID_SOCKET)
+        {
+            break;
+        }
+    }
+
+    /* Create a new socket entry */
+    if (lIndex < VOS_MAX_SOCKET_CNT)
+    {
+        trdp_sockHashUnlink(iface, lIndex);
+        trdp_sockHashLink(iface, lIndex, key);
+
+        iface[lIndex].sock          = VOS_INVALID_SOCKET;
+        iface[lIndex].polled        = FALSE;
+        iface[lIndex].mcIfSet       = FALSE;
+        iface[lIndex].bindAddr      = bindAddr /* was srcIP (ID #125) */;
+        iface[lIndex].type          = usage;
+        iface[lIndex].sendParam.qos = params->qos;
+        iface[lIndex].sendParam.ttl = params->ttl;
+        iface[lIndex].sendParam.txTime  = (usage == TRDP_SOCK_PD) && params->txTime;
+        iface[lIndex].rcvMostly     = rcvMostly;
+        iface[lIndex].tcpParams.connectionTimeout.tv_sec    = 0;
+        iface[lIndex].tcpParams.connectionTimeout.tv_usec   = 0;
+        iface[lIndex].tcpParams.cornerIp    = cornerIp;
+        iface[lIndex].tcpParams.sendNotOk   = FALSE;
+        iface[lIndex].usage = 0;
+        iface[lIndex].tcpParams.notSend     = FALSE;
         iface[lIndex].tcpParams.morituri    = FALSE;
+        iface[lIndex].tcpParams.connected   = FALSE;
+        iface[lIndex].tcpParams.queuedBytes = 0u;
+        iface[lIndex].tcpParams.throttled   = FALSE;
         iface[lIndex].tcpParams.sendingTimeout.tv_sec   = 0;
         iface[lIndex].tcpParams.sendingTimeout.tv_usec  = 0;
+        iface[lIndex].rxDrops       = 0u;
+        iface[lIndex].rxDropsSeen   = 0u;
+        iface[lIndex].rxPeak        = 0u;
+        iface[lIndex].rcvBufSize    = 0u;
+        iface[lIndex].rcvBufFixed   = FALSE;
+        iface[lIndex].shard         = 0u;
+        iface[lIndex].shareIdx      = 0u;
+
+        /* Add to the file desc only if it's an accepted socket */
+        if (rcvMostly == TRUE)
+        {
+            iface[lIndex].tcpParams.addFileDesc = TRUE;
+        }
+        else
+        {
+            iface[lIndex].tcpParams.addFileDesc = FALSE;
+        }
+
+        iface[lIndex].mcJoinCnt = 0u;
+
+        /* if a socket descriptor was supplied, take that one (for the TCP connection)   */
+        if (useSocket != VOS_INVALID_SOCKET)
+        {
+            iface[lIndex].sock  = useSocket;
+            iface[lIndex].usage = 1;         /* Mark as used */
+            *pIndex = lIndex;
+            goto err_exit;
+        }
+
+        sock_options.qos    = params->qos;
+        sock_options.ttl    = params->ttl;
+        sock_options.reuseAddrPort  = (options & TRDP_OPTION_NO_REUSE_ADDR) ? FALSE : TRUE;
+        sock_options.nonBlocking    = (options & TRDP_OPTION_BLOCK) ? FALSE : TRUE;
+        sock_options.ttl_multicast  = (usage != TRDP_SOCK_MD_TCP) ? params->ttl : 0;
+        sock_options.no_mc_loop     = ((usage != TRDP_SOCK_MD_TCP) && (options & TRDP_OPTION_NO_MC_LOOP_BACK)) ? 1 : 0;
+        sock_options.no_udp_crc     = ((usage != TRDP_SOCK_MD_TCP) && (options & TRDP_OPTION_NO_UDP_CHK)) ? 1 : 0;
+        sock_options.txTime         = iface[lIndex].sendParam.txTime;
+        sock_options.rxTime         = ((usage == TRDP_SOCK_PD) && (options & TRDP_OPTION_RX_TIMESTAMPS)) ? TRUE : FALSE;
+        sock_options.busyPoll       = ((usage == TRDP_SOCK_PD) && (options & TRDP_OPTION_BUSY_POLL)) ?
+            TRDP_PD_BUSY_POLL_READ : 0u;
+        sock_options.tcpNoDelay     = (usage == TRDP_SOCK_MD_TCP) ? TRUE : FALSE;
+        sock_options.udpGro         = ((usage == TRDP_SOCK_MD_UDP) && (options & TRDP_OPTION_MD_UDP_SEGMENT)) ?
+            TRUE : FALSE;
+
+        switch (usage)
+        {
+           case TRDP_SOCK_MD_UDP:
+               sock_options.nonBlocking = TRUE;  /* MD UDP sockets are always non blocking because they are polled */
+           case TRDP_SOCK_PD:
+               err = (TRDP_ERR_T) vos_sockOpenUDP(&iface[lIndex].sock, &sock_options);
+               if (err != TRDP_NO_ERR)
+               {
+                   vos_printLog(VOS_LOG_ERROR, "vos_sockOpenUDP failed! (Err: %d)\n", err);
+                   *pIndex = TRDP_INVALID_SOCKET_INDEX;
+               }
+               else
+               {
+                   iface[lIndex].usage = 1;
+                   *pIndex = lIndex;
+
+                   if (rcvMostly)
+                   {
+                       /*  Only bind to local IP if we are not a multicast listener  */
+                       if (0 == mcGroup)
+                       {
+                           err = (TRDP_ERR_T) vos_sockBind(iface[lIndex].sock, iface[lIndex].bindAddr, port);
+                       }
+                       else
+                       {
+                           err = (TRDP_ERR_T) vos_sockBind(iface[lIndex].sock, 0 /*mcGroup*/, port);
+                       }
+
+                       if (err != TRDP_NO_ERR)
+                       {
+                           vos_printLog(VOS_LOG_ERROR, "vos_sockBind() for UDP rcv failed! (Err: %d)\n", err);
+                           *pIndex = TRDP_INVALID_SOCKET_INDEX;
+                           break;
+                       }
+
+                       if ((0 != mcGroup)
+                           && (trdp_SockAddJoin(&iface[lIndex], mcGroup, cornerIp, srcIP) == FALSE))
+                       {
+                           vos_printLogStr(VOS_LOG_ERROR, "trdp_SockAddJoin() for UDP rcv failed!\n");
+                           err = TRDP_SOCK_ERR;
+                           *pIndex = TRDP_INVALID_SOCKET_INDEX;
+                           break;
+                       }
+                   }
+                   else if (iface[lIndex].bindAddr != 0)
+                   {
+                       (void) vos_sockBind(iface[lIndex].sock, iface[lIndex].bindAddr, 0);
+                   }
+
+                   /*    Multicast sender shall be bound to an interface    */
+                   if (iface[lIndex].bindAddr != 0 && !vos_isMulticast(iface[lIndex].bindAddr))
+                   {
+                       err = (TRDP_ERR_T) vos_sockSetMulticastIf(iface[lIndex].sock, iface[lIndex].bindAddr);
+                       if (err != TRDP_NO_ERR)
+                       {
+                           /* Avoid to excessive error reporting:
+                            vos_printLog(VOS_LOG_ERROR, "vos_sockSetMulticastIf() for UDP snd failed! (Err: %d)\n", err); */
+                           *pIndex = TRDP_INVALID_SOCKET_INDEX;
+                           break;
+                       }
+                   }
+
+               }
+               break;
+           case TRDP_SOCK_MD_TCP:
+               err = (TRDP_ERR_T) vos_sockOpenTCP(&iface[lIndex].sock, &sock_options);
+               if (err != TRDP_NO_ERR)
+               {
+                   vos_printLog(VOS_LOG_ERROR, "vos_sockOpenTCP() failed! (Err: %d)\n", err);
+                   *pIndex = TRDP_INVALID_SOCKET_INDEX;
+               }
+               else
+               {
+                   iface[lIndex].usage = 1;
+                   *pIndex = lIndex;
+               }
+
+               if (iface[lIndex].bindAddr != 0)
+               {
+                   (void) vos_sockBind(iface[lIndex].sock, iface[lIndex].bindAddr, 0);
+               }
+               break;
+           default:
+               *pIndex  = TRDP_INVALID_SOCKET_INDEX;
+               err      = TRDP_SOCK_ERR;
+               break;
+        }
+
+        if (err != TRDP_NO_ERR)
+        {
+            /* Release socket in case of error */
+            trdp_releaseSocket(iface, lIndex, 0, FALSE, VOS_INADDR_ANY);
+        }
+    }
+    else
+    {
+        err = TRDP_MEM_ERR;
+    }
+
+err_exit:
+
+    printSocketUsage(iface);
+
+    return err;
+}
+
+
+/**********************************************************************************************************************/
+/** Handle the socket pool: if a received TCP socket is unused, the socket connection timeout is started.
+ *  In Udp, Release a socket from our socket pool
+ *  @param[in,out]  iface           socket pool
+ *  @param[in]      lIndex          index of socket to release
+ *  @param[in]      connectTimeout  time out
+ *  @param[in]      checkAll        release all TCP pending sockets
+ *  @param[in]      mcGroupUsed     release MC group subscription
+ *
+ */
+void  trdp_releaseSocket (
+    TRDP_SOCKETS_T  iface[],
+    INT32           lIndex,
+    UINT32          connectTimeout,
+    BOOL8           checkAll,
+    TRDP_IP_ADDR_T  mcGroupUsed)
+{
+    TRDP_ERR_T err = TRDP_PARAM_ERR;
+
+    if (iface == NULL)
+    {
+        return;
+    }
+
+#if MD_SUPPORT
+    if (checkAll == TRUE)
+    {
+        /* Check all the sockets */
+        /* Close the morituri = TRUE sockets */
+        for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+        {
+            if (iface[lIndex].tcpParams.morituri == TRUE)
+            {
+                vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) will be closed\n", (int) iface[lIndex].sock);
+
+                err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
+                if (err != TRDP_NO_ERR)
+                {
+                    vos_printLog(VOS_LOG_ERROR, "vos_sockClose() failed (Err:%d)\n", err);
+                }
+
+                /* Delete the socket from the iface */
+                vos_printLog(VOS_LOG_INFO,
+                             "Deleting socket from the iface (Sock: %d, lIndex: %d)\n",
+                             (int) iface[lIndex].sock, lIndex);
+                iface[lIndex].sock = TRDP_INVALID_SOCKET_INDEX;
+                iface[lIndex].polled = FALSE;
+                iface[lIndex].sendParam.qos = 0;
+                iface[lIndex].sendParam.ttl = 0;
+                iface[lIndex].usage         = 0;
+                iface[lIndex].bindAddr      = 0;
+                iface[lIndex].type      = (TRDP_SOCK_TYPE_T) 0;
+                iface[lIndex].rcvMostly = FALSE;
+                iface[lIndex].tcpParams.cornerIp = 0;
+                iface[lIndex].tcpParams.connectionTimeout.tv_sec    = 0;
+                iface[lIndex].tcpParams.connectionTimeout.tv_usec   = 0;
+                iface[lIndex].tcpParams.addFileDesc = FALSE;
+                iface[lIndex].tcpParams.morituri    = FALSE;
+                iface[lIndex].tcpParams.connected   = FALSE;
+                iface[lIndex].tcpParams.queuedBytes = 0u;
+                iface[lIndex].tcpParams.throttled   = FALSE;
+            }
+        }
+
+    }
+    else
+#endif
+    {
+        /* Handle a specified socket */
+        if (iface[lIndex].sock != VOS_INVALID_SOCKET &&
+            (iface[lIndex].type == TRDP_SOCK_MD_UDP ||
+             iface[lIndex].type == TRDP_SOCK_PD))
+        {
+            vos_printLog(VOS_LOG_DBG,
+                         "Decrement the socket %d usage = %d\n",
+                         (int) iface[lIndex].sock,
+                         iface[lIndex].usage);
+            iface[lIndex].usage--;
+
+            if (iface[lIndex].sock != VOS_INVALID_SOCKET &&
+                iface[lIndex].usage <= 0)
+            {
+#if TRDP_PD_URING
+                /* The io_uring must not read the socket any more */
+                if (iface[lIndex].uring != NULL)
+                {
+                    (void) vos_uringRemoveRecv(iface[lIndex].uring, iface[lIndex].sock);
+                    iface[lIndex].uring = NULL;
+                }
+#endif
+                /* Close that socket, nobody uses it anymore - if shared, only the last session does */
+                if ((iface[lIndex].shareIdx != 0u) && (trdp_shareRelease(iface, lIndex) == FALSE))
+                {
+                    vos_printLog(VOS_LOG_DBG, "Left shared socket %d\n", (int) iface[lIndex].sock);
+                }
+                else
+                {
+                    err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
+                    if (err != TRDP_NO_ERR)
+                    {
+                        vos_printLogStr(VOS_LOG_DBG, "Trying to close socket again?\n");
+                    }
+                    else
+                    {
+                        vos_printLog(VOS_LOG_DBG, "Closed socket %d\n", (int) iface[lIndex].sock);
+                    }
+                }
+                iface[lIndex].sock = VOS_INVALID_SOCKET;
+                iface[lIndex].polled = FALSE;
+                if (iface[lIndex].pMcJoins != NULL)     /* closing the socket left its groups */
+                {
+                    vos_memFree(iface[lIndex].pMcJoins);
+                    iface[lIndex].pMcJoins = NULL;
+                }
+                iface[lIndex].mcJoinCnt     = 0u;
+                iface[lIndex].mcJoinSize    = 0u;
+            }
+            else if (mcGroupUsed != VOS_INADDR_ANY) /* Check for MC usage (close socket will unjoin MC anyway) */
+            {
+                /* remove MC group from socket list:
+                    we do that only if the caller is the only user of this MC group on this socket! */
+                if (trdp_SockDelJoin(&iface[lIndex], mcGroupUsed) == FALSE)
+                {
+                    vos_printLogStr(VOS_LOG_WARNING, "trdp_SockDelJoin() failed!\n");
+                }
+            }
+            else
+            {}
+        }
+#if MD_SUPPORT
+        else /* TCP socket */
+        {
+            if (iface[lIndex].sock != VOS_INVALID_SOCKET &&
+                iface[lIndex].rcvMostly == FALSE)
+            {
+                vos_printLog(VOS_LOG_DBG,
+                             "Decrement the socket %d usage = %d\n",
+                             (int) iface[lIndex].sock,
+                             iface[lIndex].usage);
+
+                iface[lIndex].usage--;
+
+                if (iface[lIndex].usage <= 0)
+                {
+                    /* Start the socket connection timeout */
+                    TRDP_TIME_T tmpt_interval, tmpt_now;
+
+                    iface[lIndex].usage = 0;
+
+                    vos_printLog(VOS_LOG_INFO,
+                                 "The Socket (Num = %d usage=0) ConnectionTimeout will be started\n",
+                                 (int) iface[lIndex].sock);
+
+                    tmpt_interval.tv_sec    = connectTimeout / 1000000;
+                    tmpt_interval.tv_usec   = connectTimeout % 1000000;
+
+                    vos_getTime(&tmpt_now);
+                    vos_addTime(&tmpt_now, &tmpt_interval);
+
+                    memcpy(&iface[lIndex].tcpParams.connectionTimeout,
+                           &tmpt_now,
+                           sizeof(TRDP_TIME_T));
+                }
+            }
+        }
+#endif
+    }
+}
+
+/**********************************************************************************************************************/
+/** Socket sharing: create the lock of the registry of shared sockets
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MUTEX_ERR      mutex could not be created
+ */
+TRDP_ERR_T trdp_shareInit (void)
+{
+    memset(sShareSock, 0, sizeof(sShareSock));
+    return (TRDP_ERR_T) vos_mutexCreate(&sShareMutex);
+}
+
+/**********************************************************************************************************************/
+/** Socket sharing: delete the lock of the registry, all sessions are closed
+ */
+void trdp_shareTerm (void)
+{
+    vos_mutexDelete(sShareMutex);
+    sShareMutex = NULL;
+}
+
+/**********************************************************************************************************************/
+/** Sequence counters: create the lock of the list of publishers
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MUTEX_ERR      mutex could not be created
+ */
+TRDP_ERR_T trdp_seqPubInit (void)
+{
+    sSeqPub = NULL;
+    return (TRDP_ERR_T) vos_mutexCreate(&sSeqPubMutex);
+}
+
+/**********************************************************************************************************************/
+/** Sequence counters: delete the lock of the list of publishers, all sessions are closed
+ */
+void trdp_seqPubTerm (void)
+{
+    vos_mutexDelete(sSeqPubMutex);
+    sSeqPubMutex = NULL;
+}
+
+/**********************************************************************************************************************/
+/** Sequence counters: list a publisher or update its address, called with its session locked
+ *
+ *  @param[in]      pElement        publisher
+ */
+void trdp_seqPubList (
+    PD_ELE_T *pElement)
+{
+    TRDP_SEQ_PUB_T *pSeqPub = &pElement->seqPub;
+
+    (void) vos_mutexLock(sSeqPubMutex);
+    pSeqPub->comId      = pElement->addr.comId;
+    pSeqPub->srcIpAddr  = pElement->addr.srcIpAddr;
+    TRDP_ATOMIC_STORE(pSeqPub->seqCnt, pElement->curSeqCnt);
+    if (!pSeqPub->listed)
+    {
+        pSeqPub->pNext  = sSeqPub;
+        pSeqPub->listed = TRUE;
+        sSeqPub         = pSeqPub;
+    }
+    (void) vos_mutexUnlock(sSeqPubMutex);
+}
+
+/**********************************************************************************************************************/
+/** Sequence counters: remove a publisher from the list before it is freed, called with its session locked
+ *
+ *  @param[in]      pElement        publisher
+ */
+void trdp_seqPubUnlist (
+    PD_ELE_T *pElement)
+{
+    TRDP_SEQ_PUB_T **ppIter;
+
+    (void) vos_mutexLock(sSeqPubMutex);
+    for (ppIter = &sSeqPub; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        if (*ppIter == &pElement->seqPub)
+        {
+            *ppIter = pElement->seqPub.pNext;
+            pElement->seqPub.listed = FALSE;
+            break;
+        }
+    }
+    (void) vos_mutexUnlock(sSeqPubMutex);
+}
+
+/**********************************************************************************************************************/
+/** Socket sharing: request the receive socket of a subscription from the registry of shared sockets
+ *  If another session with TRDP_OPTION_SHARE_SOCKETS already reads the port on the same address with the same socket
+ *  options, its socket is entered into our socket pool. Otherwise a socket of our own is requested and registered
+ *  for the sessions to come. The multicast groups are joined once per socket, the registry counts the sessions.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      mcGroup         multicast group to join, 0 for unicast
+ *  @param[in]      cornerIp        source of a source specific join, 0 for any source
+ *  @param[out]     pIndex          index of the socket in the session's socket pool
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_SOCK_ERR   socket error
+ *  @retval         TRDP_MEM_ERR    socket pool exhausted
+ */
+TRDP_ERR_T trdp_shareRequestSocket (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IP_ADDR_T  mcGroup,
+    TRDP_IP_ADDR_T  cornerIp,
+    INT32           *pIndex)
+{
+    TRDP_IP_ADDR_T      bindAddr    = vos_determineBindAddr(appHandle->realIP, mcGroup, TRUE);
+    TRDP_OPTION_T       option      = appHandle->option & TRDP_SHARE_SOCK_OPTIONS;
+    TRDP_SHARE_SOCK_T   *pShare     = NULL;
+    TRDP_SOCKETS_T      *pSock;
+    TRDP_ERR_T          err;
+    UINT32              i;
+
+    (void) vos_mutexLock(sShareMutex);
+
+    for (i = 0u; i < TRDP_SHARE_SOCK_MAX; i++)
+    {
+        if ((sShareSock[i].memberCnt != 0u)
+            && (sShareSock[i].bindAddr == bindAddr)
+            && (sShareSock[i].port == appHandle->pdDefault.port)
+            && (sShareSock[i].option == option))
+        {
+            pShare = &sShareSock[i];
+            break;
+        }
+    }
+
+    if (pShare != NULL)
+    {
+        for (i = 0u; (i < pShare->memberCnt) && (pShare->member[i].pIface != appHandle->iface); i++)
+        {
+            ;
+        }
+        if ((i == pShare->memberCnt) && (pShare->memberCnt >= TRDP_SHARE_SESSION_MAX))
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "Too many sessions share a socket, opening another one\n");
+            pShare = NULL;
+        }
+    }
+
+    if (pShare != NULL)
+    {
+        /*  Enter the shared socket into our pool, the groups are joined below  */
+        err = trdp_requestSocket(appHandle->iface,
+                                 appHandle->pdDefault.port,
+                                 &appHandle->pdDefault.sendParam,
+                                 appHandle->realIP,
+                                 mcGroup,
+                                 TRDP_SOCK_PD,
+                                 appHandle->option,
+                                 TRUE,
+                                 pShare->sock,
+                                 pIndex,
+                                 0u);
+        if (err == TRDP_NO_ERR)
+        {
+            pSock = &appHandle->iface[*pIndex];
+            if (pSock->shareIdx == 0u)
+            {
+                pSock->shareIdx = (UINT8) (pShare - sShareSock + 1);
+                pShare->member[pShare->memberCnt].pSession  = appHandle;
+                pShare->member[pShare->memberCnt].pIface    = appHandle->iface;
+                pShare->memberCnt++;
+                appHandle->shareCnt++;
+            }
+            if ((mcGroup != 0u) && (trdp_SockAddJoin(pSock, mcGroup, cornerIp, appHandle->realIP) == FALSE))
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "trdp_SockAddJoin() for UDP rcv failed!\n");
+                trdp_releaseSocket(appHandle->iface, *pIndex, 0u, FALSE, VOS_INADDR_ANY);
+                *pIndex = TRDP_INVALID_SOCKET_INDEX;
+                err     = TRDP_SOCK_ERR;
+            }
+        }
+    }
+    else
+    {
+        err = trdp_requestSocket(appHandle->iface,
+                                 appHandle->pdDefault.port,
+                                 &appHandle->pdDefault.sendParam,
+                                 appHandle->realIP,
+                                 mcGroup,
+                                 TRDP_SOCK_PD,
+                                 appHandle->option,
+                                 TRUE,
+                                 VOS_INVALID_SOCKET,
+                                 pIndex,
+                                 cornerIp);
+        pSock = (err == TRDP_NO_ERR) ? &appHandle->iface[*pIndex] : NULL;
+
+        /*  Register a socket just opened for the sessions to come  */
+        for (i = 0u; (pSock != NULL) && (pSock->usage == 1) && (pSock->shareIdx == 0u) && (i < TRDP_SHARE_SOCK_MAX);
+             i++)
+        {
+            if (sShareSock[i].memberCnt == 0u)
+            {
+                pShare = &sShareSock[i];
+                if (pSock->mcJoinCnt != 0u)
+                {
+                    pShare->pJoins = (TRDP_SHARE_JOIN_T *) vos_memAlloc(pSock->mcJoinSize * sizeof(TRDP_SHARE_JOIN_T));
+                    if (pShare->pJoins == NULL)
+                    {
+                        break;      /* the socket is not shared */
+                    }
+                    pShare->joinSize = pSock->mcJoinSize;
+                }
+                for (pShare->joinCnt = 0u; pShare->joinCnt < pSock->mcJoinCnt; pShare->joinCnt++)
+                {
+                    pShare->pJoins[pShare->joinCnt].mcGroup = pSock->pMcJoins[pShare->joinCnt].mcGroup;
+                    pShare->pJoins[pShare->joinCnt].srcIp   = pSock->pMcJoins[pShare->joinCnt].srcIp;
+                    pShare->pJoins[pShare->joinCnt].refCnt  = 1u;
+                }
+                pShare->sock        = pSock->sock;
+                pShare->bindAddr    = bindAddr;
+                pShare->port        = appHandle->pdDefault.port;
+                pShare->option      = option;
+                pShare->member[0].pSession  = appHandle;
+                pShare->member[0].pIface    = appHandle->iface;
+                pShare->memberCnt   = 1u;
+                pSock->shareIdx     = (UINT8) (i + 1u);
+                appHandle->shareCnt++;
+                break;
+            }
+        }
+    }
+
+    (void) vos_mutexUnlock(sShareMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Socket sharing: a session leaves a shared socket which it does not use any more
+ *  The groups joined for the session are left unless other sessions still need them.
+ *
+ *  @param[in,out]  iface           socket pool of the session
+ *  @param[in]      lIndex          index of the shared socket
+ *
+ *  @retval         TRUE            the session was the last one, the socket is to be closed
+ *  @retval         FALSE           other sessions still use the socket
+ */
+static BOOL8 trdp_shareRelease (
+    TRDP_SOCKETS_T  iface[],
+    INT32           lIndex)
+{
+    TRDP_SOCKETS_T      *pSock  = &iface[lIndex];
+    TRDP_SHARE_SOCK_T   *pShare = &sShareSock[pSock->shareIdx - 1u];
+    BOOL8               last    = FALSE;
+    UINT32              i;
+
+    (void) vos_mutexLock(sShareMutex);
+
+    for (i = 0u; i < pSock->mcJoinCnt; i++)
+    {
+        trdp_sockLeave(pSock, pSock->pMcJoins[i].mcGroup, pSock->pMcJoins[i].srcIp, pSock->bindAddr);
+    }
+
+    for (i = 0u; i < pShare->memberCnt; i++)
+    {
+        if (pShare->member[i].pIface == iface)
+        {
+            TRDP_SESSION_PT pSession = pShare->member[i].pSession;
+
+            if (pSession != NULL)
+            {
+                pSession->shareCnt--;
+                /*  The socket stays open, the session must not wait for it any more  */
+                if (pSock->polled && (pSession->pollSet != NULL))
+                {
+                    (void) vos_pollRemove(pSession->pollSet, pSock->sock);
+                }
+            }
+            pShare->member[i] = pShare->member[--pShare->memberCnt];
+            break;
+        }
+    }
+
+    if (pShare->memberCnt == 0u)
+    {
+        if (pShare->pJoins != NULL)
+        {
+            vos_memFree(pShare->pJoins);
+        }
+        memset(pShare, 0, sizeof(TRDP_SHARE_SOCK_T));
+        last = TRUE;
+    }
+    pSock->shareIdx = 0u;
+
+    (void) vos_mutexUnlock(sShareMutex);
+    return last;
+}
+
+/**********************************************************************************************************************/
+/** Socket sharing: detach a closing session from the registry
+ *  No more frames are handed to the session; frames being handled for it are waited for, queued frames are dropped.
+ *  The sockets are left when the session releases them.
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_shareDetach (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_SHARE_FRAME_T  *pFrame;
+    UINT32              i, j;
+
+    if (!(appHandle->option & TRDP_OPTION_SHARE_SOCKETS) || (sShareMutex == NULL))
+    {
+        return;
+    }
+
+    (void) vos_mutexLock(sShareMutex);
+    for (i = 0u; i < TRDP_SHARE_SOCK_MAX; i++)
+    {
+        for (j = 0u; j < sShareSock[i].memberCnt; j++)
+        {
+            if (sShareSock[i].member[j].pSession == appHandle)
+            {
+                sShareSock[i].member[j].pSession = NULL;
+            }
+        }
+    }
+    appHandle->shareCnt = 0u;
+    while (appHandle->shareBusy != 0u)
+    {
+        (void) vos_mutexUnlock(sShareMutex);
+        (void) vos_threadDelay(1000u);
+        (void) vos_mutexLock(sShareMutex);
+    }
+    while (appHandle->pShareFirst != NULL)
+    {
+        pFrame = appHandle->pShareFirst;
+        appHandle->pShareFirst = pFrame->pNext;
+        vos_memFree(pFrame);
+    }
+    appHandle->pShareLast   = NULL;
+    appHandle->shareQueued  = 0u;
+    (void) vos_mutexUnlock(sShareMutex);
+}
+
+/**********************************************************************************************************************/
+/** Socket sharing: the session starts reading frames
+ *  Frames which other sessions read for it meanwhile are queued. To be called with the session locked.
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_shareRxBegin (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->option & TRDP_OPTION_SHARE_SOCKETS)
+    {
+        (void) vos_mutexLock(sShareMutex);
+        appHandle->shareBusy++;
+        (void) vos_mutexUnlock(sShareMutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Socket sharing: the session stops reading frames
+ *  The frames queued for the session are handled before it is left, new ones are handed over directly afterwards.
+ *  To be called with the session locked.
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_shareRxEnd (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_SHARE_FRAME_T *pFrame;
+
+    if (!(appHandle->option & TRDP_OPTION_SHARE_SOCKETS))
+    {
+        return;
+    }
+
+    for (;; )
+    {
+        (void) vos_mutexLock(sShareMutex);
+        pFrame = appHandle->pShareFirst;
+        if ((appHandle->shareBusy > 1u) || (pFrame == NULL))
+        {
+            /*  The outermost reader handles the queue  */
+            appHandle->shareBusy--;
+            (void) vos_mutexUnlock(sShareMutex);
+            return;
+        }
+        appHandle->pShareFirst = pFrame->pNext;
+        if (appHandle->pShareFirst == NULL)
+        {
+            appHandle->pShareLast = NULL;
+        }
+        appHandle->shareQueued--;
+        (void) vos_mutexUnlock(sShareMutex);
+
+        (void) trdp_pdHandleShared(appHandle, pFrame->data, pFrame->size, pFrame->srcIpAddr, pFrame->destIpAddr,
+                                   &pFrame->rxTime);
+        vos_memFree(pFrame);
+        trdp_pdCallPending(appHandle);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Socket sharing: hand a frame read from a shared socket to the other sessions sharing it
+ *  A session which is idle is locked and handles the frame at once; it is never waited for, to rule out deadlocks
+ *  between sessions reading each others frames. A busy session finds the frame in its queue when it stops reading.
+ *
+ *  @param[in]      appHandle       session which read the frame
+ *  @param[in]      sock            the socket read
+ *  @param[in]      pData           the frame
+ *  @param[in]      size            size of the frame
+ *  @param[in]      srcIpAddr       source IP of the frame
+ *  @param[in]      destIpAddr      destination IP of the frame
+ *  @param[in]      pRxTime         reception time
+ *
+ *  @retval         TRUE            the frame was handed to another session
+ */
+BOOL8 trdp_shareDeliver (
+    TRDP_SESSION_PT     appHandle,
+    SOCKET              sock,
+    const UINT8         *pData,
+    UINT32              size,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    TRDP_IP_ADDR_T      destIpAddr,
+    const TRDP_TIME_T   *pRxTime)
+{
+    TRDP_SESSION_PT     pSessions[TRDP_SHARE_SESSION_MAX];
+    TRDP_SHARE_SOCK_T   *pShare     = NULL;
+    TRDP_SHARE_FRAME_T  *pFrame;
+    UINT32              cnt         = 0u;
+    BOOL8               delivered   = FALSE;
+    UINT32              i, j;
+
+    (void) vos_mutexLock(sShareMutex);
+
+    for (i = 0u; i < TRDP_SHARE_SOCK_MAX; i++)
+    {
+        if ((sShareSock[i].memberCnt != 0u) && (sShareSock[i].sock == sock))
+        {
+            pShare = &sShareSock[i];
+            for (j = 0u; j < pShare->memberCnt; j++)
+            {
+                if ((pShare->member[j].pSession != NULL) && (pShare->member[j].pSession != appHandle))
+                {
+                    pSessions[cnt++] = pShare->member[j].pSession;
+                }
+            }
+            break;
+        }
+    }
+
+    for (i = 0u; i < cnt; i++)
+    {
+        TRDP_SESSION_PT pSession = pSessions[i];
+
+        /*  The session may have left the socket while we handed the frame to the one before    */
+        for (j = 0u; (pShare->sock == sock) && (j < pShare->memberCnt) && (pShare->member[j].pSession != pSession); j++)
+        {
+            ;
+        }
+        if ((pShare->sock != sock) || (j == pShare->memberCnt))
+        {
+            continue;
+        }
+
+        delivered = TRUE;
+        if ((pSession->shareBusy == 0u) && (vos_mutexTryLock(pSession->mutex) == VOS_NO_ERR))
+        {
+            pSession->shareBusy++;
+            (void) vos_mutexUnlock(sShareMutex);
+            (void) trdp_pdHandleShared(pSession, pData, size, srcIpAddr, destIpAddr, pRxTime);
+            trdp_pdCallPending(pSession);
+            trdp_shareRxEnd(pSession);
+            (void) vos_mutexUnlock(pSession->mutex);
+            (void) vos_mutexLock(sShareMutex);
+            continue;
+        }
+
+        pFrame = (pSession->shareQueued < TRDP_SHARE_QUEUE_MAX) ?
+            (TRDP_SHARE_FRAME_T *) vos_memAlloc((UINT32) offsetof(TRDP_SHARE_FRAME_T, data) + size) : NULL;
+        if (pFrame == NULL)
+        {
+            pSession->shareDropped++;
+            continue;
+        }
+        memcpy(pFrame->data, pData, size);
+        pFrame->size        = size;
+        pFrame->srcIpAddr   = srcIpAddr;
+        pFrame->destIpAddr  = destIpAddr;
+        pFrame->rxTime      = *pRxTime;
+        if (pSession->pShareLast != NULL)
+        {
+            pSession->pShareLast->pNext = pFrame;
+        }
+        else
+        {
+            pSession->pShareFirst = pFrame;
+        }
+        pSession->pShareLast = pFrame;
+        pSession->shareQueued++;
+    }
+
+    (void) vos_mutexUnlock(sShareMutex);
+    return delivered;
+}
+
+/**********************************************************************************************************************/
+/** Update the poll set of a session from its socket pool
+ *  The poll set holds the same sockets tlc_getInterval() sets in the descriptor set: all PD sockets with a subscriber,
+ *  all MD UDP sockets, the MD TCP connections ready to be read and the TCP listening socket. The tag of a socket is its
+ *  index in the socket pool, the listening socket is tagged VOS_MAX_SOCKET_CNT.
+ *  Only changed entries cause a system call; a socket closed by the stack has already been removed by the OS.
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_SOCK_ERR       a socket could not be added
+ */
+TRDP_ERR_T trdp_syncPollSet (
+    TRDP_SESSION_PT appHandle)
+{
+    BOOL8       wanted[VOS_MAX_SOCKET_CNT];
+    PD_ELE_T    *iterPD;
+    INT32       lIndex;
+    TRDP_ERR_T  result = TRDP_NO_ERR;
+
+    memset(wanted, 0, sizeof(wanted));
+
+#if TRDP_PD_URING
+    trdp_pdUringArm(appHandle);
+#endif
+
+    /*    PD sockets are only read if a subscription uses them, no PD thread is running and no io_uring reads them   */
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if ((iterPD->socketIdx != TRDP_INVALID_SOCKET_INDEX) &&
+            !(appHandle->option & TRDP_OPTION_PD_THREAD))
+        {
+#if TRDP_PD_URING
+            wanted[iterPD->socketIdx] = (appHandle->iface[iterPD->socketIdx].uring == NULL) ? TRUE : FALSE;
+#else
+            wanted[iterPD->socketIdx] = TRUE;
+#endif
+        }
+    }
+
+    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    {
+        TRDP_SOCKETS_T *pSock = &appHandle->iface[lIndex];
+
+        if (pSock->sock == VOS_INVALID_SOCKET)
+        {
+            pSock->polled = FALSE;
+            continue;
+        }
+#if MD_SUPPORT
+        if ((pSock->type == TRDP_SOCK_MD_UDP) ||
+            ((pSock->type == TRDP_SOCK_MD_TCP) && (pSock->tcpParams.addFileDesc == TRUE)))
+        {
+            wanted[lIndex] = TRUE;
+        }
+#endif
+        if (wanted[lIndex] && !pSock->polled)
+        {
+            if (vos_pollAdd(appHandle->pollSet, pSock->sock, (UINT32) lIndex) == VOS_NO_ERR)
+            {
+                pSock->polled = TRUE;
+            }
+            else
+            {
+                result = TRDP_SOCK_ERR;
+            }
+        }
+        else if (!wanted[lIndex] && pSock->polled)
+        {
+            (void) vos_pollRemove(appHandle->pollSet, pSock->sock);
+            pSock->polled = FALSE;
+        }
+    }
+
+    /*    The AF_XDP socket, if any, is read unless a PD thread is running    */
+    if ((appHandle->pdXdp != NULL) && !appHandle->pdXdpPolled && !(appHandle->option & TRDP_OPTION_PD_THREAD))
+    {
+        if (vos_pollAdd(appHandle->pollSet, appHandle->pdXdpSock, TRDP_XDP_POLL_TAG) == VOS_NO_ERR)
+        {
+            appHandle->pdXdpPolled = TRUE;
+        }
+        else
+        {
+            result = TRDP_SOCK_ERR;
+        }
+    }
+
+#if TRDP_PD_URING
+    /*    The io_uring, if any, carries the completions of all PD sockets it reads    */
+    if ((appHandle->pdUring != NULL) && !appHandle->pdUringPolled)
+    {
+        if (vos_pollAdd(appHandle->pollSet, appHandle->pdUringFd, TRDP_URING_POLL_TAG) == VOS_NO_ERR)
+        {
+            appHandle->pdUringPolled = TRUE;
+        }
+        else
+        {
+            result = TRDP_SOCK_ERR;
+        }
+    }
+#endif
+
+#if MD_SUPPORT
+    if (appHandle->tcpFd.listen_sd != appHandle->tcpFd.polled_sd)
+    {
+        if (appHandle->tcpFd.listen_sd != VOS_INVALID_SOCKET)
+        {
+            if (vos_pollAdd(appHandle->pollSet, appHandle->tcpFd.listen_sd, VOS_MAX_SOCKET_CNT) == VOS_NO_ERR)
+            {
+                appHandle->tcpFd.polled_sd = appHandle->tcpFd.listen_sd;
+            }
+            else
+            {
+                result = TRDP_SOCK_ERR;
+            }
+        }
+        else
+        {
+            appHandle->tcpFd.polled_sd = VOS_INVALID_SOCKET;
+        }
+    }
+#endif
+    return result;
+}
+
+
+
+/**********************************************************************************************************************/
+/** Find the sequence counter of a publisher in a send queue
+ *
+ *  @param[in]      pSendElement    first element of the send queue
+ *  @param[in]      comId           comID to look for
+ *  @param[in]      srcIpAddr       Source IP address
+ *  @param[out]     pSeqCnt         the sequence counter found
+ *
+ *  @retval         TRUE            found
+ */
+static BOOL8 trdp_findSeqCnt (
+    const PD_ELE_T  *pSendElement,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    UINT32          *pSeqCnt)
+{
+    for (; pSendElement != NULL; pSendElement = pSendElement->pNext)
+    {
+        if ((pSendElement->addr.comId == comId) &&
+            ((srcIpAddr == 0) || (pSendElement->addr.srcIpAddr != srcIpAddr)))
+        {
+            *pSeqCnt = pSendElement->curSeqCnt;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Get the current time.
+ *  Within tlc_process / tlc_processEvents the time read at their start is returned, so the send and time out
+ *  handling of one cycle read the clock once instead of per element.
+ *
+ *  @param[in]      appHandle       session, locked by the caller
+ *  @param[out]     pNow            current time
+ */
+
+void trdp_getNow (
+    TRDP_SESSION_PT appHandle,
+    TRDP_TIME_T     *pNow)
+{
+#if TRDP_PROCESS_TIME_CACHE
+    if (appHandle->processTimeValid == TRUE)
+    {
+        *pNow = appHandle->processTime;
+        return;
+    }
+#endif
+    vos_getTime(pNow);
+}
+
+/**********************************************************************************************************************/
+/** Lock the session including its PD send side.
+ *  The session mutex is taken first, then the send mutex: a thread in tlc_processSend() holds the send mutex only
+ *  and never waits for the session mutex.
+ *
+ *  @param[in]      appHandle       session
+ *
+ *  @retval         VOS_NO_ERR      both locked
+ *  @retval         != VOS_NO_ERR   none locked
+ */
+
+VOS_ERR_T trdp_sessionLock (
+    TRDP_SESSION_PT appHandle)
+{
+    VOS_ERR_T err = vos_mutexLock(appHandle->mutex);
+
+    if (err == VOS_NO_ERR)
+    {
+        err = vos_mutexLock(appHandle->sndMutex);
+        if (err != VOS_NO_ERR)
+        {
+            (void) vos_mutexUnlock(appHandle->mutex);
+        }
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Unlock the session locked by trdp_sessionLock().
+ *
+ *  @param[in]      appHandle       session
+ *
+ *  @retval         VOS_NO_ERR      both unlocked
+ */
+
+VOS_ERR_T trdp_sessionUnlock (
+    TRDP_SESSION_PT appHandle)
+{
+    VOS_ERR_T err = vos_mutexUnlock(appHandle->sndMutex);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        err = VOS_MUTEX_ERR;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Start the work budget of a tlc_process() call, the session is locked by the caller.
+ *  Without a configured budget the call is not limited.
+ *
+ *  @param[in]      appHandle       session
+ */
+
+void trdp_budgetStart (
+    TRDP_SESSION_PT appHandle)
+{
+    appHandle->backlog = FALSE;
+    if ((appHandle->budgetFrames == 0u) && (appHandle->budgetTime == 0u))
+    {
+        return;
+    }
+    appHandle->budgetLeft = (appHandle->budgetFrames != 0u) ? appHandle->budgetFrames : 0xFFFFFFFFu;
+    vos_clearTime(&appHandle->budgetEnd);
+    if (appHandle->budgetTime != 0u)
+    {
+        TRDP_TIME_T budget;
 
+        budget.tv_sec   = (long) (appHandle->budgetTime / 1000000u);
+        budget.tv_usec  = (long) (appHandle->budgetTime % 1000000u);
+        vos_getTime(&appHandle->budgetEnd);
+        vos_addTime(&appHandle->budgetEnd, &budget);
+    }
+    appHandle->budgetArmed = TRUE;
+}
 
-        /* Add to the file desc only if it's an accepted socket */
-        if (rcvMostly == TRUE)
+/**********************************************************************************************************************/
+/** End the work budget of a tlc_process() call.
+ *  The receive thread of TRDP_OPTION_PD_THREAD reads with the session locked, it never sees an armed budget.
+ *
+ *  @param[in]      appHandle       session
+ */
+
+void trdp_budgetStop (
+    TRDP_SESSION_PT appHandle)
+{
+    appHandle->budgetArmed = FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Account frames received against the work budget.
+ *
+ *  @param[in]      appHandle       session
+ *  @param[in]      frames          no. of frames read
+ */
+
+void trdp_budgetSpend (
+    TRDP_SESSION_PT appHandle,
+    UINT32          frames)
+{
+    if (appHandle->budgetArmed)
+    {
+        appHandle->budgetLeft = (frames < appHandle->budgetLeft) ? (appHandle->budgetLeft - frames) : 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check whether the work budget allows to read on.
+ *  If it is spent, the caller leaves the rest for the next call: the session reports a backlog and tlc_getInterval()
+ *  returns a zero interval.
+ *
+ *  @param[in]      appHandle       session
+ *
+ *  @retval         TRUE            go on reading
+ *  @retval         FALSE           budget spent
+ */
+
+BOOL8 trdp_budgetLeft (
+    TRDP_SESSION_PT appHandle)
+{
+    if (!appHandle->budgetArmed)
+    {
+        return TRUE;
+    }
+    if ((appHandle->budgetLeft != 0u) && timerisset(&appHandle->budgetEnd))
+    {
+        TRDP_TIME_T now;
+
+        vos_getTime(&now);
+        if (!timercmp(&now, &appHandle->budgetEnd, <))
         {
-            iface[lIndex].tcpParams.addFileDesc = TRUE;
+            appHandle->budgetLeft = 0u;
         }
-        else
+    }
+    if (appHandle->budgetLeft == 0u)
+    {
+        appHandle->backlog = TRUE;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Take the next strand for a worker of the callback dispatcher, the dispatcher is locked by the caller.
+ *  The worker takes the oldest strand of its own run queue. If that is empty, it steals the strand queued last to
+ *  the worker with the longest queue, that is the one its owner would get to last.
+ *
+ *  @param[in]      pDispatch       callback dispatcher
+ *  @param[in]      pWorker         worker looking for work
+ *
+ *  @retval         index of the strand, -1 if there is no work
+ */
+static INT32 trdp_cbNextStrand (
+    TRDP_CB_DISPATCH_T  *pDispatch,
+    TRDP_CB_WORKER_T    *pWorker)
+{
+    TRDP_CB_WORKER_T    *pVictim    = NULL;
+    UINT32              longest     = 0u;
+    UINT32              i;
+
+    if (pWorker->head != pWorker->tail)
+    {
+        return (INT32) pWorker->runQueue[pWorker->head++ % TRDP_CB_STRANDS];
+    }
+    for (i = 0u; i < pDispatch->workerCnt; i++)
+    {
+        if ((pDispatch->worker[i].tail - pDispatch->worker[i].head) > longest)
         {
-            iface[lIndex].tcpParams.addFileDesc = FALSE;
+            pVictim = &pDispatch->worker[i];
+            longest = pVictim->tail - pVictim->head;
         }
+    }
+    if (pVictim == NULL)
+    {
+        return -1;
+    }
+    return (INT32) pVictim->runQueue[--pVictim->tail % TRDP_CB_STRANDS];
+}
 
-        memset(iface[lIndex].mcGroups, 0, sizeof(iface[lIndex].mcGroups));
+/**********************************************************************************************************************/
+/** Worker thread of the callback dispatcher.
+ *  Runs one callback of a strand at a time and queues the strand again behind the others while it has callbacks
+ *  left. The thread terminates when the dispatcher is stopped and no work is left.
+ *
+ *  @param[in]      pArg            the worker
+ */
+static void trdp_cbWorkerThread (
+    void *pArg)
+{
+    TRDP_CB_WORKER_T    *pWorker    = (TRDP_CB_WORKER_T *) pArg;
+    TRDP_CB_DISPATCH_T  *pDispatch  = pWorker->pDispatch;
 
-        /* if a socket descriptor was supplied, take that one (for the TCP connection)   */
-        if (useSocket != VOS_INVALID_SOCKET)
+    for (;; )
+    {
+        TRDP_CB_STRAND_T    *pStrand    = NULL;
+        TRDP_CB_JOB_T       *pJob       = NULL;
+        INT32               idx;
+
+        if (vos_mutexLock(pDispatch->mutex) != VOS_NO_ERR)
         {
-            iface[lIndex].sock  = useSocket;
-            iface[lIndex].usage = 1;         /* Mark as used */
-            *pIndex = lIndex;
-            goto err_exit;
+            break;
         }
+        idx = trdp_cbNextStrand(pDispatch, pWorker);
+        if (idx >= 0)
+        {
+            pStrand         = &pDispatch->strand[idx];
+            pJob            = pStrand->pHead;
+            pStrand->pHead  = pJob->pNext;
+            if (pStrand->pHead == NULL)
+            {
+                pStrand->pTail = NULL;
+            }
+            pDispatch->queued--;
+            pWorker->busy = TRUE;
+        }
+        (void) vos_mutexUnlock(pDispatch->mutex);
 
-        sock_options.qos    = params->qos;
-        sock_options.ttl    = params->ttl;
-        sock_options.reuseAddrPort  = (options & TRDP_OPTION_NO_REUSE_ADDR) ? FALSE : TRUE;
-        sock_options.nonBlocking    = (options & TRDP_OPTION_BLOCK) ? FALSE : TRUE;
-        sock_options.ttl_multicast  = (usage != TRDP_SOCK_MD_TCP) ? params->ttl : 0;
-        sock_options.no_mc_loop     = ((usage != TRDP_SOCK_MD_TCP) && (options & TRDP_OPTION_NO_MC_LOOP_BACK)) ? 1 : 0;
-        sock_options.no_udp_crc     = ((usage != TRDP_SOCK_MD_TCP) && (options & TRDP_OPTION_NO_UDP_CHK)) ? 1 : 0;
-
-        switch (usage)
+        if (pJob == NULL)
         {
-           case TRDP_SOCK_MD_UDP:
-               sock_options.nonBlocking = TRUE;  /* MD UDP sockets are always non blocking because they are polled */
-           case TRDP_SOCK_PD:
-               err = (TRDP_ERR_T) vos_sockOpenUDP(&iface[lIndex].sock, &sock_options);
-               if (err != TRDP_NO_ERR)
-               {
-                   vos_printLog(VOS_LOG_ERROR, "vos_sockOpenUDP failed! (Err: %d)\n", err);
-                   *pIndex = TRDP_INVALID_SOCKET_INDEX;
-               }
-               else
-               {
-                   iface[lIndex].usage = 1;
-                   *pIndex = lIndex;
+            if (!pDispatch->run)
+            {
+                break;
+            }
+            (void) vos_semaTake(pWorker->wake, TRDP_CB_WORKER_POLL);
+            continue;
+        }
 
-                   if (rcvMostly)
-                   {
-                       /*  Only bind to local IP if we are not a multicast listener  */
-                       if (0 == mcGroup)
-                       {
-                           err = (TRDP_ERR_T) vos_sockBind(iface[lIndex].sock, iface[lIndex].bindAddr, port);
-                       }
-                       else
-                       {
-                           err = (TRDP_ERR_T) vos_sockBind(iface[lIndex].sock, 0 /*mcGroup*/, port);
-                       }
+        if (pJob->pfPdCb != NULL)
+        {
+            TRDP_TRACE2(pd_callback, pJob->info.pd.comId, pJob->info.pd.resultCode);
+            pJob->pfPdCb(pJob->pRefCon, pDispatch->pSession, &pJob->info.pd, pJob->pData, pJob->dataSize);
+            TRDP_TRACE1(pd_callback_done, pJob->info.pd.comId);
+        }
+        else
+        {
+            TRDP_TRACE2(md_callback, pJob->info.md.comId, pJob->info.md.resultCode);
+            pJob->pfMdCb(pJob->pRefCon, pDispatch->pSession, &pJob->info.md, pJob->pData, pJob->dataSize);
+            TRDP_TRACE1(md_callback_done, pJob->info.md.comId);
+        }
+        trdp_cbFreeJob(pJob);
 
-                       if (err != TRDP_NO_ERR)
-                       {
-                           vos_printLog(VOS_LOG_ERROR, "vos_sockBind() for UDP rcv failed! (Err: %d)\n", err);
-                           *pIndex = TRDP_INVALID_SOCKET_INDEX;
-                           break;
-                       }
+        if (vos_mutexLock(pDispatch->mutex) != VOS_NO_ERR)
+        {
+            break;
+        }
+        pWorker->busy = FALSE;
+        if (pStrand->pHead != NULL)
+        {
+            pWorker->runQueue[pWorker->tail++ % TRDP_CB_STRANDS] = (UINT16) idx;
+        }
+        else
+        {
+            pStrand->scheduled = FALSE;
+        }
+        (void) vos_mutexUnlock(pDispatch->mutex);
+    }
+    vos_semaGive(pWorker->done);
+}
 
-                       if (0 != mcGroup)
-                       {
+/**********************************************************************************************************************/
+/** Allocate a queue element of the callback dispatcher with a copy of the data
+ *
+ *  @param[in]      pData           data handed to the callback, NULL if none
+ *  @param[in]      dataSize        size of the data
+ *
+ *  @retval         the element, NULL if out of memory
+ */
+static TRDP_CB_JOB_T *trdp_cbNewJob (
+    const UINT8 *pData,
+    UINT32      dataSize)
+{
+    TRDP_CB_JOB_T *pJob = (TRDP_CB_JOB_T *) vos_memAlloc(sizeof(TRDP_CB_JOB_T) + ((pData != NULL) ? dataSize : 0u));
 
-                           err = (TRDP_ERR_T) vos_sockJoinMC(iface[lIndex].sock, mcGroup, srcIP);
-                           if (err != TRDP_NO_ERR)
-                           {
-                               vos_printLog(VOS_LOG_ERROR, "vos_sockJoinMC() for UDP rcv failed! (Err: %d)\n", err);
-                               *pIndex = TRDP_INVALID_SOCKET_INDEX;
-                               break;
-                           }
-                           else
-                           {
-                               if (trdp_SockAddJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
-                               {
-                                   vos_printLogStr(VOS_LOG_ERROR, "trdp_SockAddJoin() failed!\n");
-                               }
-                           }
-                       }
-                   }
-                   else if (iface[lIndex].bindAddr != 0)
-                   {
-                       (void) vos_sockBind(iface[lIndex].sock, iface[lIndex].bindAddr, 0);
-                   }
+    if (pJob != NULL)
+    {
+        if (pData != NULL)
+        {
+            pJob->pData = (UINT8 *) (pJob + 1);
+            memcpy(pJob->pData, pData, dataSize);
+        }
+        pJob->dataSize = dataSize;
+    }
+    return pJob;
+}
 
-                   /*    Multicast sender shall be bound to an interface    */
-                   if (iface[lIndex].bindAddr != 0 && !vos_isMulticast(iface[lIndex].bindAddr))
-                   {
-                       err = (TRDP_ERR_T) vos_sockSetMulticastIf(iface[lIndex].sock, iface[lIndex].bindAddr);
-                       if (err != TRDP_NO_ERR)
-                       {
-                           /* Avoid to excessive error reporting:
-                            vos_printLog(VOS_LOG_ERROR, "vos_sockSetMulticastIf() for UDP snd failed! (Err: %d)\n", err); */
-                           *pIndex = TRDP_INVALID_SOCKET_INDEX;
-                           break;
-                       }
-                   }
+/**********************************************************************************************************************/
+/** Free a queue element of the callback dispatcher, a lent frame is released
+ *
+ *  @param[in]      pJob            the element
+ */
+static void trdp_cbFreeJob (
+    TRDP_CB_JOB_T *pJob)
+{
+#if TRDP_PD_SHARED_FRAMES
+    TRDP_PD_FRAME_REF_T *pRef = pJob->pFrameRef;
 
-               }
-               break;
-           case TRDP_SOCK_MD_TCP:
-               err = (TRDP_ERR_T) vos_sockOpenTCP(&iface[lIndex].sock, &sock_options);
-               if (err != TRDP_NO_ERR)
-               {
-                   vos_printLog(VOS_LOG_ERROR, "vos_sockOpenTCP() failed! (Err: %d)\n", err);
-                   *pIndex = TRDP_INVALID_SOCKET_INDEX;
-               }
-               else
-               {
-                   iface[lIndex].usage = 1;
-                   *pIndex = lIndex;
-               }
+    /*  The last user frees the frame, the subscription has replaced it  */
+    if ((pRef != NULL) && (__atomic_sub_fetch(&pRef->refCnt, 1u, __ATOMIC_ACQ_REL) == 0u))
+    {
+        vos_memFree(pRef->pFrame);
+        vos_memFree(pRef);
+    }
+#endif
+    vos_memFree(pJob);
+}
 
-               if (iface[lIndex].bindAddr != 0)
-               {
-                   (void) vos_sockBind(iface[lIndex].sock, iface[lIndex].bindAddr, 0);
-               }
-               break;
-           default:
-               *pIndex  = TRDP_INVALID_SOCKET_INDEX;
-               err      = TRDP_SOCK_ERR;
-               break;
-        }
+/**********************************************************************************************************************/
+/** Take the frame of a subscription back from the queued callbacks it was lent to, before it is overwritten or freed.
+ *  If callbacks still use it, they keep the frame (the last one frees it) and the subscription gets a new one.
+ *
+ *  @param[in]      pElement        subscription, the session is locked by the caller
+ *  @param[in]      frameSize       size of a new frame, 0 if the frame is to be freed
+ *
+ *  @retval         pElement->pFrame, which may be overwritten or freed now (a new frame if the former one is in use)
+ *  @retval         NULL            frameSize 0: the frame is still in use, else: out of memory, nothing changed
+ */
+PD_PACKET_T *trdp_pdFrameReclaim (
+    PD_ELE_T    *pElement,
+    UINT32      frameSize)
+{
+#if TRDP_PD_SHARED_FRAMES
+    TRDP_PD_FRAME_REF_T *pRef   = pElement->pFrameRef;
+    PD_PACKET_T         *pSpare = NULL;
 
-        if (err != TRDP_NO_ERR)
+    if (pRef == NULL)
+    {
+        return pElement->pFrame;
+    }
+    if (frameSize != 0u)
+    {
+        pSpare = (PD_PACKET_T *) vos_memAllocAligned(frameSize, TRDP_PD_FRAME_ALIGN);
+        if (pSpare == NULL)
         {
-            /* Release socket in case of error */
-            trdp_releaseSocket(iface, lIndex, 0, FALSE, VOS_INADDR_ANY);
+            return NULL;
         }
     }
-    else
+    pElement->pFrameRef = NULL;
+    if (__atomic_sub_fetch(&pRef->refCnt, 1u, __ATOMIC_ACQ_REL) == 0u)
     {
-        err = TRDP_MEM_ERR;
+        /*  The callbacks are done with it  */
+        vos_memFree(pRef);
+        if (pSpare != NULL)
+        {
+            vos_memFree(pSpare);
+        }
+        return pElement->pFrame;
     }
+    pElement->pFrame = pSpare;
+    return pSpare;
+#else
+    (void) frameSize;
+    return pElement->pFrame;
+#endif
+}
 
-err_exit:
-
-    printSocketUsage(iface);
+#if TRDP_PD_SHARED_FRAMES
+/**********************************************************************************************************************/
+/** Lend the frame of a subscription to a queued callback
+ *
+ *  @param[in]      pElement        subscription, the session is locked by the caller
+ *
+ *  @retval         reference to hand to the callback, NULL if out of memory
+ */
+static TRDP_PD_FRAME_REF_T *trdp_pdFrameLend (
+    PD_ELE_T *pElement)
+{
+    TRDP_PD_FRAME_REF_T *pRef = pElement->pFrameRef;
 
-    return err;
+    if (pRef == NULL)
+    {
+        pRef = (TRDP_PD_FRAME_REF_T *) vos_memAlloc(sizeof(TRDP_PD_FRAME_REF_T));
+        if (pRef == NULL)
+        {
+            return NULL;
+        }
+        pRef->refCnt        = 1u;           /* the subscription */
+        pRef->pFrame        = pElement->pFrame;
+        pElement->pFrameRef = pRef;
+    }
+    (void) __atomic_add_fetch(&pRef->refCnt, 1u, __ATOMIC_RELAXED);
+    return pRef;
 }
-
+#endif
 
 /**********************************************************************************************************************/
-/** Handle the socket pool: if a received TCP socket is unused, the socket connection timeout is started.
- *  In Udp, Release a socket from our socket pool
- *  @param[in,out]  iface           socket pool
- *  @param[in]      lIndex          index of socket to release
- *  @param[in]      connectTimeout  time out
- *  @param[in]      checkAll        release all TCP pending sockets
- *  @param[in]      mcGroupUsed     release MC group subscription
+/** Queue a callback to its strand, the strand to its home worker if it is not scheduled yet.
+ *  If the home worker is busy, an idle worker is woken up to steal the strand.
+ *
+ *  @param[in]      pDispatch       callback dispatcher
+ *  @param[in]      comId           comId of the callback, selects the strand
+ *  @param[in]      pJob            the callback, freed if it is dropped
+ *  @param[in]      mayDrop         the callback is dropped if TRDP_CB_QUEUE_MAX callbacks are waiting
  *
+ *  @retval         TRDP_NO_ERR     callback queued or dropped
+ *  @retval         TRDP_MUTEX_ERR  dispatcher could not be locked, the callback is freed
  */
-void  trdp_releaseSocket (
-    TRDP_SOCKETS_T  iface[],
-    INT32           lIndex,
-    UINT32          connectTimeout,
-    BOOL8           checkAll,
-    TRDP_IP_ADDR_T  mcGroupUsed)
+static TRDP_ERR_T trdp_cbQueue (
+    TRDP_CB_DISPATCH_T  *pDispatch,
+    UINT32              comId,
+    TRDP_CB_JOB_T       *pJob,
+    BOOL8               mayDrop)
 {
-    TRDP_ERR_T err = TRDP_PARAM_ERR;
+    UINT32              idx         = comId % TRDP_CB_STRANDS;
+    TRDP_CB_STRAND_T    *pStrand    = &pDispatch->strand[idx];
+    TRDP_CB_WORKER_T    *pWake      = NULL;
+    UINT32              i;
 
-    if (iface == NULL)
+    if (vos_mutexLock(pDispatch->mutex) != VOS_NO_ERR)
+    {
+        trdp_cbFreeJob(pJob);
+        return TRDP_MUTEX_ERR;
+    }
+    if (mayDrop && (pDispatch->queued >= TRDP_CB_QUEUE_MAX))
+    {
+        if (!pDispatch->dropping)
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "Callback queue full, PD callbacks are dropped\n");
+            pDispatch->dropping = TRUE;
+        }
+        pDispatch->dropped++;
+        (void) vos_mutexUnlock(pDispatch->mutex);
+        trdp_cbFreeJob(pJob);
+        return TRDP_NO_ERR;
+    }
+    if (mayDrop && pDispatch->dropping)
+    {
+        vos_printLog(VOS_LOG_WARNING, "%u PD callbacks dropped\n", (unsigned int) pDispatch->dropped);
+        pDispatch->dropping = FALSE;
+        pDispatch->dropped  = 0u;
+    }
+
+    if (pStrand->pTail != NULL)
+    {
+        pStrand->pTail->pNext = pJob;
+    }
+    else
     {
-        return;
+        pStrand->pHead = pJob;
     }
+    pStrand->pTail = pJob;
+    pDispatch->queued++;
 
-#if MD_SUPPORT
-    if (checkAll == TRUE)
+    if (!pStrand->scheduled)
     {
-        /* Check all the sockets */
-        /* Close the morituri = TRUE sockets */
-        for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+        TRDP_CB_WORKER_T *pHome = &pDispatch->worker[idx % pDispatch->workerCnt];
+
+        pStrand->scheduled = TRUE;
+        pHome->runQueue[pHome->tail++ % TRDP_CB_STRANDS] = (UINT16) idx;
+        pWake = pHome;
+        for (i = 0u; (i < pDispatch->workerCnt) && pHome->busy; i++)
         {
-            if (iface[lIndex].tcpParams.morituri == TRUE)
+            if (!pDispatch->worker[i].busy && (pDispatch->worker[i].head == pDispatch->worker[i].tail))
             {
-                vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) will be closed\n", (int) iface[lIndex].sock);
-
-                err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
-                if (err != TRDP_NO_ERR)
-                {
-                    vos_printLog(VOS_LOG_ERROR, "vos_sockClose() failed (Err:%d)\n", err);
-                }
-
-                /* Delete the socket from the iface */
-                vos_printLog(VOS_LOG_INFO,
-                             "Deleting socket from the iface (Sock: %d, lIndex: %d)\n",
-                             (int) iface[lIndex].sock, lIndex);
-                iface[lIndex].sock = TRDP_INVALID_SOCKET_INDEX;
-                iface[lIndex].sendParam.qos = 0;
-                iface[lIndex].sendParam.ttl = 0;
-                iface[lIndex].usage         = 0;
-                iface[lIndex].bindAddr      = 0;
-                iface[lIndex].type      = (TRDP_SOCK_TYPE_T) 0;
-                iface[lIndex].rcvMostly = FALSE;
-                iface[lIndex].tcpParams.cornerIp = 0;
-                iface[lIndex].tcpParams.connectionTimeout.tv_sec    = 0;
-                iface[lIndex].tcpParams.connectionTimeout.tv_usec   = 0;
-                iface[lIndex].tcpParams.addFileDesc = FALSE;
-                iface[lIndex].tcpParams.morituri    = FALSE;
+                pWake = &pDispatch->worker[i];
+                break;
             }
         }
+    }
+    (void) vos_mutexUnlock(pDispatch->mutex);
+    if (pWake != NULL)
+    {
+        vos_semaGive(pWake->wake);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Hand a PD callback over to the callback dispatcher of the session
+ *
+ *  @param[in]      appHandle       session, locked by the caller
+ *  @param[in]      pfCbFunction    callback to call
+ *  @param[in]      pMsg            message info, copied
+ *  @param[in]      pData           data, copied
+ *  @param[in]      dataSize        size of the data
+ *  @param[in]      pElement        subscription whose frame holds pData, the frame is lent instead of copied;
+ *                                  NULL to copy the data
+ *
+ *  @retval         TRDP_NO_ERR     callback queued, or dropped because the queue is full
+ *  @retval         TRDP_NOINIT_ERR no dispatcher, the caller calls the callback in place
+ *  @retval         TRDP_MEM_ERR    out of memory, the caller calls the callback in place
+ */
+TRDP_ERR_T trdp_cbDispatchPd (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_PD_CALLBACK_T      pfCbFunction,
+    const TRDP_PD_INFO_T    *pMsg,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    PD_ELE_T                *pElement)
+{
+    TRDP_CB_JOB_T *pJob = NULL;
 
+    if (appHandle->pCbDispatch == NULL)
+    {
+        return TRDP_NOINIT_ERR;
     }
-    else
-#endif
+#if TRDP_PD_SHARED_FRAMES
+    if ((pElement != NULL) && (pData != NULL))
     {
-        /* Handle a specified socket */
-        if (iface[lIndex].sock != VOS_INVALID_SOCKET &&
-            (iface[lIndex].type == TRDP_SOCK_MD_UDP ||
-             iface[lIndex].type == TRDP_SOCK_PD))
+        pJob = trdp_cbNewJob(NULL, 0u);
+        if (pJob != NULL)
         {
-            vos_printLog(VOS_LOG_DBG,
-                         "Decrement the socket %d usage = %d\n",
-                         (int) iface[lIndex].sock,
-                         iface[lIndex].usage);
-            iface[lIndex].usage--;
-
-            if (iface[lIndex].sock != VOS_INVALID_SOCKET &&
-                iface[lIndex].usage <= 0)
+            pJob->pFrameRef = trdp_pdFrameLend(pElement);
+            if (pJob->pFrameRef == NULL)
             {
-                /* Close that socket, nobody uses it anymore */
-                err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
-                if (err != TRDP_NO_ERR)
-                {
-                    vos_printLogStr(VOS_LOG_DBG, "Trying to close socket again?\n");
-                }
-                else
-                {
-                    vos_printLog(VOS_LOG_DBG, "Closed socket %d\n", (int) iface[lIndex].sock);
-                }
-                iface[lIndex].sock = VOS_INVALID_SOCKET;
+                vos_memFree(pJob);
+                pJob = NULL;
             }
-            else if (mcGroupUsed != VOS_INADDR_ANY) /* Check for MC usage (close socket will unjoin MC anyway) */
+            else
             {
-                /* remove MC group from socket list:
-                    we do that only if the caller is the only user of this MC group on this socket! */
-                if (trdp_SockDelJoin(iface[lIndex].mcGroups, mcGroupUsed) == FALSE)
-                {
-                    vos_printLogStr(VOS_LOG_WARNING, "trdp_SockDelJoin() failed!\n");
-                }
-                else    /* and unjoin MC group */
-                {
-                    vos_sockLeaveMC(iface[lIndex].sock, mcGroupUsed, iface[lIndex].bindAddr);
-                }
+                pJob->pData     = (UINT8 *) pData;
+                pJob->dataSize  = dataSize;
             }
-            else
-            {}
         }
-#if MD_SUPPORT
-        else /* TCP socket */
-        {
-            if (iface[lIndex].sock != VOS_INVALID_SOCKET &&
-                iface[lIndex].rcvMostly == FALSE)
-            {
-                vos_printLog(VOS_LOG_DBG,
-                             "Decrement the socket %d usage = %d\n",
-                             (int) iface[lIndex].sock,
-                             iface[lIndex].usage);
-
-                iface[lIndex].usage--;
+    }
+#else
+    (void) pElement;
+#endif
+    if (pJob == NULL)
+    {
+        pJob = trdp_cbNewJob(pData, dataSize);
+    }
+    if (pJob == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pJob->pfPdCb    = pfCbFunction;
+    pJob->pRefCon   = appHandle->pdDefault.pRefCon;
+    pJob->info.pd   = *pMsg;
+    return trdp_cbQueue(appHandle->pCbDispatch, pMsg->comId, pJob, TRUE);
+}
 
-                if (iface[lIndex].usage <= 0)
-                {
-                    /* Start the socket connection timeout */
-                    TRDP_TIME_T tmpt_interval, tmpt_now;
+#if MD_SUPPORT
+/**********************************************************************************************************************/
+/** Hand an MD callback over to the callback dispatcher of the session, MD callbacks are never dropped
+ *
+ *  @param[in]      appHandle       session, locked by the caller
+ *  @param[in]      pfCbFunction    callback to call
+ *  @param[in]      pMsg            message info, copied
+ *  @param[in]      pData           data, copied
+ *  @param[in]      dataSize        size of the data
+ *
+ *  @retval         TRDP_NO_ERR     callback queued
+ *  @retval         TRDP_NOINIT_ERR no dispatcher, the caller calls the callback in place
+ *  @retval         TRDP_MEM_ERR    out of memory, the caller calls the callback in place
+ */
+TRDP_ERR_T trdp_cbDispatchMd (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_MD_CALLBACK_T      pfCbFunction,
+    const TRDP_MD_INFO_T    *pMsg,
+    const UINT8             *pData,
+    UINT32                  dataSize)
+{
+    TRDP_CB_JOB_T *pJob;
 
-                    iface[lIndex].usage = 0;
+    if (appHandle->pCbDispatch == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pJob = trdp_cbNewJob(pData, dataSize);
+    if (pJob == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pJob->pfMdCb    = pfCbFunction;
+    pJob->pRefCon   = appHandle->mdDefault.pRefCon;
+    pJob->info.md   = *pMsg;
+    return trdp_cbQueue(appHandle->pCbDispatch, pMsg->comId, pJob, FALSE);
+}
+#endif
 
-                    vos_printLog(VOS_LOG_INFO,
-                                 "The Socket (Num = %d usage=0) ConnectionTimeout will be started\n",
-                                 (int) iface[lIndex].sock);
+/**********************************************************************************************************************/
+/** Start the callback dispatcher of a session with cbWorkerCnt worker threads
+ *
+ *  @param[in]      appHandle       session pointer
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ *  @retval         TRDP_MUTEX_ERR  no mutex available
+ *  @retval         TRDP_SEMA_ERR   no semaphore available
+ *  @retval         TRDP_THREAD_ERR thread could not be created
+ */
+TRDP_ERR_T trdp_cbDispatchStart (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_CB_DISPATCH_T  *pDispatch;
+    TRDP_ERR_T          ret = TRDP_NO_ERR;
+    UINT32              i;
 
-                    tmpt_interval.tv_sec    = connectTimeout / 1000000;
-                    tmpt_interval.tv_usec   = connectTimeout % 1000000;
+    pDispatch = (TRDP_CB_DISPATCH_T *) vos_memAlloc(sizeof(TRDP_CB_DISPATCH_T));
+    if (pDispatch == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    if (vos_mutexCreate(&pDispatch->mutex) != VOS_NO_ERR)
+    {
+        vos_memFree(pDispatch);
+        return TRDP_MUTEX_ERR;
+    }
+    pDispatch->pSession     = appHandle;
+    pDispatch->run          = TRUE;
+    pDispatch->workerCnt    = appHandle->cbWorkerCnt;
+    appHandle->pCbDispatch  = pDispatch;
 
-                    vos_getTime(&tmpt_now);
-                    vos_addTime(&tmpt_now, &tmpt_interval);
+    for (i = 0u; (i < pDispatch->workerCnt) && (ret == TRDP_NO_ERR); i++)
+    {
+        TRDP_CB_WORKER_T    *pWorker = &pDispatch->worker[i];
+        CHAR8               name[16];
+        VOS_ERR_T           err;
 
-                    memcpy(&iface[lIndex].tcpParams.connectionTimeout,
-                           &tmpt_now,
-                           sizeof(TRDP_TIME_T));
-                }
-            }
+        pWorker->pDispatch = pDispatch;
+        if ((vos_semaCreate(&pWorker->wake, VOS_SEMA_EMPTY) != VOS_NO_ERR) ||
+            (vos_semaCreate(&pWorker->done, VOS_SEMA_EMPTY) != VOS_NO_ERR))
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_semaCreate() failed\n");
+            ret = TRDP_SEMA_ERR;
+            break;
+        }
+        (void) vos_snprintf(name, sizeof(name), "trdpCb%u", (unsigned int) i);
+        err = vos_threadCreate(&pWorker->thread, name, VOS_THREAD_POLICY_OTHER,
+                               0u, 0u, 0u, trdp_cbWorkerThread, pWorker);
+        if (err != VOS_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "vos_threadCreate() failed (Err: %d)\n", err);
+            pWorker->thread = NULL;
+            ret             = TRDP_THREAD_ERR;
         }
-#endif
     }
+    if (ret != TRDP_NO_ERR)
+    {
+        trdp_cbDispatchStop(appHandle);
+    }
+    return ret;
 }
 
+/**********************************************************************************************************************/
+/** Stop the callback dispatcher of a session
+ *  The worker threads call the callbacks still waiting before they terminate. Must not be called with the session
+ *  locked, the callbacks may call into the stack.
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_cbDispatchStop (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_CB_DISPATCH_T  *pDispatch = appHandle->pCbDispatch;
+    UINT32              i;
+
+    if (pDispatch == NULL)
+    {
+        return;
+    }
+    pDispatch->run = FALSE;
+    for (i = 0u; i < pDispatch->workerCnt; i++)
+    {
+        TRDP_CB_WORKER_T *pWorker = &pDispatch->worker[i];
+
+        if (pWorker->thread != NULL)
+        {
+            vos_semaGive(pWorker->wake);
+            (void) vos_semaTake(pWorker->done, VOS_SEMA_WAIT_FOREVER);
+        }
+        if (pWorker->wake != NULL)
+        {
+            vos_semaDelete(pWorker->wake);
+        }
+        if (pWorker->done != NULL)
+        {
+            vos_semaDelete(pWorker->done);
+        }
+    }
+    /*  Left over only if the workers could not be started  */
+    for (i = 0u; i < TRDP_CB_STRANDS; i++)
+    {
+        while (pDispatch->strand[i].pHead != NULL)
+        {
+            TRDP_CB_JOB_T *pNext = pDispatch->strand[i].pHead->pNext;
 
+            trdp_cbFreeJob(pDispatch->strand[i].pHead);
+            pDispatch->strand[i].pHead = pNext;
+        }
+    }
+    vos_mutexDelete(pDispatch->mutex);
+    vos_memFree(pDispatch);
+    appHandle->pCbDispatch = NULL;
+}
 
 /**********************************************************************************************************************/
 /** Get the initial sequence counter for the comID/message type and subnet (source IP).
@@ -1117,7 +3954,11 @@ void  trdp_releaseSocket (
  *
  *  Note: The standard demands that sequenceCounter is managed per comID/msgType at each publisher,
  *        but shall be the same for redundant telegrams (subnet/srcIP).
+ *        The redundant publisher may belong to another session (subnet). The publishers of the other sessions
+ *        are found in the list of publishers (trdp_seqPubList) without their session mutex.
+ *        Lock order: the caller's session mutex, then sSeqPubMutex, no lock is taken while holding it.
  *
+ *  @param[in]      appHandle       session to look in first, locked by the caller
  *  @param[in]      comId           comID to look for
  *  @param[in]      msgType         PD/MD type
  *  @param[in]      srcIpAddr       Source IP address
@@ -1126,12 +3967,13 @@ void  trdp_releaseSocket (
  */
 
 UINT32  trdp_getSeqCnt (
+    TRDP_SESSION_PT appHandle,
     UINT32          comId,
     TRDP_MSG_T      msgType,
     TRDP_IP_ADDR_T  srcIpAddr)
 {
-    TRDP_SESSION_PT pSession        = (TRDP_SESSION_PT)trdp_sessionQueue();
-    PD_ELE_T        *pSendElement   = NULL;
+    TRDP_SEQ_PUB_T  *pSeqPub;
+    UINT32          seqCnt = 0u;
 
     if (0 == comId)
     {
@@ -1139,28 +3981,81 @@ UINT32  trdp_getSeqCnt (
     }
 
     /*    For process data look at the PD send queue only    */
-    if ((TRDP_MSG_PD == msgType) ||
-        (TRDP_MSG_PP == msgType) ||
-        (TRDP_MSG_PR == msgType))
+    if ((TRDP_MSG_PD != msgType) &&
+        (TRDP_MSG_PP != msgType) &&
+        (TRDP_MSG_PR != msgType))
+    {
+        return 0;
+    }
+
+    if ((appHandle != NULL) && trdp_findSeqCnt(appHandle->pSndQueue, comId, srcIpAddr, &seqCnt))
     {
-        /*    Loop thru all sessions    */
-        while (pSession)
+        return seqCnt;
+    }
+
+    /*    Look at the publishers of the other sessions, ours did not match above    */
+    (void) vos_mutexLock(sSeqPubMutex);
+    for (pSeqPub = sSeqPub; pSeqPub != NULL; pSeqPub = pSeqPub->pNext)
+    {
+        if ((pSeqPub->comId == comId) &&
+            ((srcIpAddr == 0) || (pSeqPub->srcIpAddr != srcIpAddr)))
         {
-            pSendElement = pSession->pSndQueue;
-            while (pSendElement)
-            {
-                if ((pSendElement->addr.comId == comId) &&
-                    ((srcIpAddr == 0) || (pSendElement->addr.srcIpAddr != srcIpAddr)))
-                {
-                    return pSendElement->curSeqCnt;
-                }
-                pSendElement = pSendElement->pNext;
-            }
-            pSession = pSession->pNext;
+            seqCnt = TRDP_ATOMIC_LOAD(pSeqPub->seqCnt);
+            break;
         }
     }
+    (void) vos_mutexUnlock(sSeqPubMutex);
+
+    return seqCnt;   /*    Not found, initial value is zero    */
+}
+
+/**********************************************************************************************************************/
+/** Allocate an empty sequence counter table
+ *
+ *  @param[in]      size                number of slots, power of 2
+ *
+ *  @retval         pointer to the table, NULL on memory error
+ */
+static TRDP_SEQ_CNT_LIST_T *trdp_seqCntAlloc (
+    UINT16 size)
+{
+    TRDP_SEQ_CNT_LIST_T *pList = (TRDP_SEQ_CNT_LIST_T *) vos_memAlloc(size * sizeof(TRDP_SEQ_CNT_ENTRY_T) +
+                                                                      sizeof(TRDP_SEQ_CNT_LIST_T));
+    if (pList != NULL)
+    {
+        pList->maxNoOfEntries = size;   /* vos_memAlloc cleared all slots */
+    }
+    return pList;
+}
+
+/**********************************************************************************************************************/
+/** Find the slot of a source in the sequence counter table
+ *  Linear probing from the hashed source IP/msgType; the table is at most half full, so a free slot terminates the search.
+ *
+ *  @param[in]      pList               sequence counter table
+ *  @param[in]      srcIP               Source IP address
+ *  @param[in]      msgType             message type
+ *
+ *  @retval         slot of the source, or the free slot to insert it
+ */
+static TRDP_SEQ_CNT_ENTRY_T *trdp_seqCntFind (
+    TRDP_SEQ_CNT_LIST_T *pList,
+    TRDP_IP_ADDR_T      srcIP,
+    TRDP_MSG_T          msgType)
+{
+    UINT32  mask    = (UINT32) pList->maxNoOfEntries - 1u;
+    UINT32  l_index = ((srcIP ^ ((UINT32) msgType << 16)) * 0x9E3779B1u) >> 16;    /* Fibonacci hashing */
+
+    for (;; l_index++)
+    {
+        TRDP_SEQ_CNT_ENTRY_T *pSlot = &pList->seq[l_index & mask];
 
-    return 0;   /*    Not found, initial value is zero    */
+        if ((pSlot->msgType == 0) ||
+            ((pSlot->srcIpAddr == srcIP) && (pSlot->msgType == msgType)))
+        {
+            return pSlot;
+        }
+    }
 }
 
 /**********************************************************************************************************************/
@@ -1180,21 +4075,50 @@ void trdp_resetSequenceCounter (
     TRDP_IP_ADDR_T  srcIP,
     TRDP_MSG_T      msgType)
 {
-    int l_index;
+    TRDP_SEQ_CNT_ENTRY_T *pSlot;
 
     if (pElement == NULL || pElement->pSeqCntList == NULL)
     {
         return;
     }
-    /* Loop over entries */
-    for (l_index = 0; l_index < pElement->pSeqCntList->curNoOfEntries; ++l_index)
+    pSlot = trdp_seqCntFind(pElement->pSeqCntList, srcIP, msgType);
+    if (pSlot->msgType != 0)
     {
-        if ((srcIP == pElement->pSeqCntList->seq[l_index].srcIpAddr) &&
-            (msgType == pElement->pSeqCntList->seq[l_index].msgType))
-        {
-            pElement->pSeqCntList->seq[l_index].lastSeqCnt = 0;
-        }
+        pSlot->lastSeqCnt = 0;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Allocate the sequence counter table of a subscription, if not yet done.
+ *  The table is sized for the expected number of sources: one, a range or any.
+ *
+ *  @param[in]      pElement            subscription element
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+
+TRDP_ERR_T trdp_initSequenceCounter (
+    PD_ELE_T *pElement)
+{
+    UINT32  sources = TRDP_SEQ_CNT_START_ARRAY_SIZE / 2u;
+    UINT16  size    = TRDP_SEQ_CNT_MIN_ARRAY_SIZE;
+
+    if (pElement->pSeqCntList != NULL)
+    {
+        return TRDP_NO_ERR;
+    }
+    if (pElement->addr.srcIpAddr != VOS_INADDR_ANY)
+    {
+        sources = (pElement->addr.srcIpAddr2 > pElement->addr.srcIpAddr) ?
+            (pElement->addr.srcIpAddr2 - pElement->addr.srcIpAddr + 1u) : 1u;
     }
+    while ((size < 2u * sources) && (size < TRDP_SEQ_CNT_START_ARRAY_SIZE))
+    {
+        size *= 2u;
+    }
+    pElement->pSeqCntList = trdp_seqCntAlloc(size);
+    return (pElement->pSeqCntList != NULL) ? TRDP_NO_ERR : TRDP_MEM_ERR;
 }
 
 /**********************************************************************************************************************/
@@ -1219,7 +4143,7 @@ int trdp_checkSequenceCounter (
     TRDP_IP_ADDR_T  srcIP,
     TRDP_MSG_T      msgType)
 {
-    int l_index;
+    TRDP_SEQ_CNT_ENTRY_T *pSlot;
 
     if (pElement == NULL)
     {
@@ -1227,76 +4151,68 @@ int trdp_checkSequenceCounter (
         return -1;
     }
 
-    if (pElement->pSeqCntList == NULL)
+    if (trdp_initSequenceCounter(pElement) != TRDP_NO_ERR)
     {
-        /* Allocate some space */
-        pElement->pSeqCntList = (TRDP_SEQ_CNT_LIST_T *) vos_memAlloc(TRDP_SEQ_CNT_START_ARRAY_SIZE *
-                                                                     sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-                                                                     sizeof(TRDP_SEQ_CNT_LIST_T));
-        if (pElement->pSeqCntList == NULL)
-        {
-            return -1;
-        }
-        pElement->pSeqCntList->maxNoOfEntries   = TRDP_SEQ_CNT_START_ARRAY_SIZE;
-        pElement->pSeqCntList->curNoOfEntries   = 0;
+        return -1;
     }
-    /* Loop over entries */
-    for (l_index = 0; l_index < pElement->pSeqCntList->curNoOfEntries; ++l_index)
+
+    pSlot = trdp_seqCntFind(pElement->pSeqCntList, srcIP, msgType);
+    if (pSlot->msgType != 0)
     {
-        if ((srcIP == pElement->pSeqCntList->seq[l_index].srcIpAddr) &&
-            (msgType == pElement->pSeqCntList->seq[l_index].msgType))
+        /*        Is this packet a duplicate?    */
+        if ((pSlot->lastSeqCnt == 0) ||    /* first time after timeout */
+            (sequenceCounter > pSlot->lastSeqCnt))
         {
-            /*        Is this packet a duplicate?    */
-            if ((pElement->pSeqCntList->seq[l_index].lastSeqCnt == 0) ||    /* first time after timeout */
-                (sequenceCounter > pElement->pSeqCntList->seq[l_index].lastSeqCnt))
-            {
-                /*
-                 vos_printLog(VOS_LOG_DBG,
-                 "Rcv sequence: %u    last seq: %u\n",
-                 sequenceCounter,
-                 pElement->pSeqCntList->seq[l_index].lastSeqCnt);
-                 vos_printLog(VOS_LOG_DBG, "-> new PD data found (SrcIp: %s comId %u)\n", vos_ipDotted(
-                 srcIP), pElement->addr.comId);
-                 */
-                pElement->pSeqCntList->seq[l_index].lastSeqCnt = sequenceCounter;
-                return 0;
-            }
-            else
-            {
-                vos_printLog(VOS_LOG_DBG,
-                             "Rcv sequence: %u    last seq: %u\n",
-                             sequenceCounter,
-                             pElement->pSeqCntList->seq[l_index].lastSeqCnt);
-                vos_printLog(VOS_LOG_DBG, "-> duplicated PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
-                                 srcIP), pElement->addr.comId);
-                return 1;
-            }
+            pSlot->lastSeqCnt = sequenceCounter;
+            return 0;
+        }
+        else
+        {
+            vos_printLog(VOS_LOG_DBG,
+                         "Rcv sequence: %u    last seq: %u\n",
+                         sequenceCounter,
+                         pSlot->lastSeqCnt);
+            vos_printLog(VOS_LOG_DBG, "-> duplicated PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
+                             srcIP), pElement->addr.comId);
+            return 1;
         }
     }
 
-    /* Not found in list, add new entry */
-    if (pElement->pSeqCntList->curNoOfEntries >= pElement->pSeqCntList->maxNoOfEntries)
+    /* Not found in table, add new entry; keep the table at most half full */
+    if (2u * (pElement->pSeqCntList->curNoOfEntries + 1u) > pElement->pSeqCntList->maxNoOfEntries)
     {
         /* Allocate some more space */
-        UINT16 newSize = 2 * pElement->pSeqCntList->curNoOfEntries;
-        TRDP_SEQ_CNT_LIST_T *newList = (TRDP_SEQ_CNT_LIST_T *) vos_memAlloc(newSize * sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-                                                                            sizeof(TRDP_SEQ_CNT_LIST_T));
+        TRDP_SEQ_CNT_LIST_T *newList;
+        UINT32              l_index;
+
+        if (pElement->pSeqCntList->maxNoOfEntries > (UINT16_MAX / 2u))
+        {
+            return -1;
+        }
+        newList = trdp_seqCntAlloc((UINT16) (2u * pElement->pSeqCntList->maxNoOfEntries));
         if (newList == NULL)
         {
             return -1;
         }
 
-        /* Copy old data into new, larger area */
-        memcpy(newList, pElement->pSeqCntList, pElement->pSeqCntList->maxNoOfEntries *
-               sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-               sizeof(TRDP_SEQ_CNT_LIST_T));
+        /* Rehash old entries into the new, larger table */
+        for (l_index = 0u; l_index < pElement->pSeqCntList->maxNoOfEntries; l_index++)
+        {
+            const TRDP_SEQ_CNT_ENTRY_T *pOld = &pElement->pSeqCntList->seq[l_index];
+
+            if (pOld->msgType != 0)
+            {
+                *trdp_seqCntFind(newList, pOld->srcIpAddr, pOld->msgType) = *pOld;
+            }
+        }
+        newList->curNoOfEntries = pElement->pSeqCntList->curNoOfEntries;
         vos_memFree(pElement->pSeqCntList);     /* Free old area */
         pElement->pSeqCntList = newList;
-        pElement->pSeqCntList->maxNoOfEntries = newSize;
+        pSlot = trdp_seqCntFind(newList, srcIP, msgType);
     }
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].lastSeqCnt    = sequenceCounter;
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].srcIpAddr     = srcIP;
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].msgType       = msgType;
+    pSlot->lastSeqCnt   = sequenceCounter;
+    pSlot->srcIpAddr    = srcIP;
+    pSlot->msgType      = msgType;
     pElement->pSeqCntList->curNoOfEntries++;
     vos_printLog(VOS_LOG_DBG, "Rcv sequence: %u\n", sequenceCounter);
     vos_printLog(VOS_LOG_DBG, "*** new sequence entry (SrcIp: %s comId %u)\n", vos_ipDotted(
@@ -1305,6 +4221,33 @@ int trdp_checkSequenceCounter (
     return 0;
 }
 
+/**********************************************************************************************************************/
+/** Case insensitive hash of a user URI
+ *  Covers the characters trdp_isAddressed() compares, URIs it finds equal have the same hash.
+ *
+ *  @param[in]      pUri          URI, terminated by 0 or after TRDP_USR_URI_SIZE characters
+ *
+ *  @retval         hash (FNV-1a)
+ */
+
+UINT32 trdp_uriHash (const CHAR8 *pUri)
+{
+    UINT32  hash = 2166136261u;
+    UINT32  i;
+
+    for (i = 0u; (i < TRDP_USR_URI_SIZE) && (pUri[i] != 0); i++)
+    {
+        UINT8 c = (UINT8) pUri[i];
+
+        if ((c >= 'A') && (c <= 'Z'))
+        {
+            c = (UINT8) (c + ('a' - 'A'));
+        }
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
 /**********************************************************************************************************************/
 /** Check if listener URI is in addressing range of destination URI.
  *
@@ -47,6 +47,15 @@
  * TYPEDEFS
  */
 
+#if MD_SUPPORT
+/** Cursor over the listener candidates of a comId, newest listener first */
+typedef struct
+{
+    MD_LIS_ELE_T    *pComId;                    /**< next listener of the comId bucket (or of the queue)    */
+    MD_LIS_ELE_T    *pAny;                      /**< next listener for any comId                            */
+} TRDP_MD_LIS_ITER_T;
+#endif
+
 /*******************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -62,6 +71,58 @@ PD_ELE_T            *trdp_queueFindSubAddr (
     PD_ELE_T            *pHead,
     TRDP_ADDRESSES_T    *pAddr);
 
+PD_ELE_T            *trdp_rcvQueueFindSubAddr (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ADDRESSES_T    *pAddr);
+
+PD_ELE_T            *trdp_rcvQueueFindSrc (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_ADDRESSES_T    *pAddr);
+
+#if TRDP_PD_SRC_TABLE
+BOOL8   trdp_srcTableFind (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  srcIpAddr,
+    PD_ELE_T        * * *pppSub,
+    UINT32          *pSubCnt);
+#endif
+
+void    trdp_srcTableFree (
+    TRDP_SESSION_PT appHandle);
+
+void    trdp_srcTablePrepare (
+    TRDP_SESSION_PT appHandle);
+
+void    trdp_rcvSockPrio (
+    TRDP_SESSION_PT appHandle,
+    INT32           socketIdx);
+
+void    trdp_rcvQueueAppLast (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pNew);
+
+void    trdp_rcvQueueSetPrio (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pEle,
+    UINT8           prio);
+
+void    trdp_rcvQueueDelElement (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pDelete);
+
+PD_ELE_T            *trdp_sndQueueFindComId (
+    TRDP_SESSION_PT appHandle,
+    UINT32          comId);
+
+void    trdp_sndQueueInsFirst (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pNew);
+
+void    trdp_sndQueueDelElement (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pDelete);
+
 PD_ELE_T            *trdp_queueFindPubAddr (
     PD_ELE_T            *pHead,
     TRDP_ADDRESSES_T    *addr);
@@ -78,6 +139,11 @@ void    trdp_queueInsFirst (
     PD_ELE_T    * *pHead,
     PD_ELE_T    *pNew);
 
+void    trdp_queueInsPrio (
+    PD_ELE_T    * *pHead,
+    PD_ELE_T    *pNew,
+    BOOL8       first);
+
 #if MD_SUPPORT
 MD_ELE_T    *trdp_MDqueueFindAddr (
     MD_ELE_T            *pHead,
@@ -94,6 +160,39 @@ void        trdp_MDqueueAppLast (
 void        trdp_MDqueueInsFirst (
     MD_ELE_T    * *ppHead,
     MD_ELE_T    *pNew);
+
+void        trdp_MDqueueInsSession (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        * *ppHead,
+    MD_ELE_T        *pNew,
+    BOOL8           appendLast);
+
+void        trdp_MDqueueDelSession (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        * *ppHead,
+    MD_ELE_T        *pDelete);
+
+MD_ELE_T    *trdp_MDqueueFindSession (
+    TRDP_SESSION_PT appHandle,
+    MD_ELE_T        * *ppHead,
+    const UINT8     *pSessionId,
+    const MD_ELE_T  *pPrev);
+
+void        trdp_MDlistenerIns (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pNew);
+
+BOOL8       trdp_MDlistenerDel (
+    TRDP_SESSION_PT appHandle,
+    MD_LIS_ELE_T    *pDelete);
+
+void        trdp_MDlistenerFirst (
+    TRDP_SESSION_PT     appHandle,
+    UINT32              comId,
+    TRDP_MD_LIS_ITER_T  *pIter);
+
+MD_LIS_ELE_T *trdp_MDlistenerNext (
+    TRDP_MD_LIS_ITER_T *pIter);
 #endif
 
 /*********************************************************************************************************************/
@@ -105,6 +204,15 @@ void        trdp_MDqueueInsFirst (
 void trdp_initSockets(
     TRDP_SOCKETS_T iface[]);
 
+/*********************************************************************************************************************/
+/** Handle the socket pool: Free the memberships lists of sockets still open when the session is closed
+ *
+ *  @param[in]      iface          pointer to the socket pool
+ */
+
+void trdp_freeSockets(
+    TRDP_SOCKETS_T iface[]);
+
 
 /**********************************************************************************************************************/
 /** ???
@@ -132,6 +240,18 @@ void trdp_resetSequenceCounter (
     TRDP_IP_ADDR_T  srcIP,
     TRDP_MSG_T      msgType);
 
+/**********************************************************************************************************************/
+/** Allocate the sequence counter table of a subscription, if not yet done.
+ *
+ *  @param[in]      pElement            subscription element
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+
+TRDP_ERR_T trdp_initSequenceCounter (
+    PD_ELE_T *pElement);
+
 /**********************************************************************************************************************/
 /** Check an MC group not used by other sockets / subscribers/ listeners
  *
@@ -158,7 +278,7 @@ TRDP_IP_ADDR_T trdp_findMCjoins(
  *  @param[in]      rcvMostly       only used for receiving
  *  @param[out]     useSocket       socket to use, do not open a new one
  *  @param[out]     pIndex          returned index of socket pool
- *  @param[in]      cornerIp        only used for receiving
+ *  @param[in]      cornerIp        TCP: peer address; UDP: source of a source specific MC join (0 = any source)
  *
  *  @retval         TRDP_NO_ERR
  *  @retval         TRDP_PARAM_ERR
@@ -177,6 +297,24 @@ TRDP_ERR_T trdp_requestSocket(
     INT32                   * pIndex,
     TRDP_IP_ADDR_T cornerIp);
 
+/*********************************************************************************************************************/
+/** Join a mc group on a socket, for a single source if srcIp is set
+ *
+ *  @param[in,out]  pSock           socket
+ *  @param[in]      mcGroup         multicast group
+ *  @param[in]      srcIp           source, 0 for any source
+ *  @param[in]      ifAddr          interface to join on
+ *
+ *  @retval         TRUE            joined
+ *  @retval         FALSE           join failed or out of memory
+ */
+
+BOOL8 trdp_SockAddJoin(
+    TRDP_SOCKETS_T  *pSock,
+    TRDP_IP_ADDR_T  mcGroup,
+    TRDP_IP_ADDR_T  srcIp,
+    TRDP_IP_ADDR_T  ifAddr);
+
 /*********************************************************************************************************************/
 /** Handle the socket pool: Release a socket from our socket pool
  *
@@ -195,6 +333,120 @@ void trdp_releaseSocket(
     BOOL8 checkAll,
     TRDP_IP_ADDR_T  mcGroupUsed);
 
+/*********************************************************************************************************************/
+/** Socket sharing: create / delete the lock of the registry of shared sockets
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MUTEX_ERR      mutex could not be created
+ */
+
+TRDP_ERR_T trdp_shareInit(
+    void);
+
+void trdp_shareTerm(
+    void);
+
+/*********************************************************************************************************************/
+/** Sequence counters: create / delete the lock of the list of publishers
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MUTEX_ERR      mutex could not be created
+ */
+
+TRDP_ERR_T trdp_seqPubInit(
+    void);
+
+void trdp_seqPubTerm(
+    void);
+
+/*********************************************************************************************************************/
+/** Sequence counters: list a publisher (or update its address) for trdp_getSeqCnt of the other sessions, remove it
+ *  before it is freed. Called with the session of the publisher locked.
+ *
+ *  @param[in]      pElement        publisher
+ */
+
+void trdp_seqPubList(
+    PD_ELE_T *pElement);
+
+void trdp_seqPubUnlist(
+    PD_ELE_T *pElement);
+
+/*********************************************************************************************************************/
+/** Socket sharing: request the receive socket of a subscription from the registry of shared sockets
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      mcGroup         multicast group to join, 0 for unicast
+ *  @param[in]      cornerIp        source of a source specific join, 0 for any source
+ *  @param[out]     pIndex          index of the socket in the session's socket pool
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_SOCK_ERR   socket error
+ *  @retval         TRDP_MEM_ERR    socket pool exhausted
+ */
+
+TRDP_ERR_T trdp_shareRequestSocket(
+    TRDP_SESSION_PT appHandle,
+    TRDP_IP_ADDR_T  mcGroup,
+    TRDP_IP_ADDR_T  cornerIp,
+    INT32           *pIndex);
+
+/*********************************************************************************************************************/
+/** Socket sharing: detach a closing session, no more frames are handed to it
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+
+void trdp_shareDetach(
+    TRDP_SESSION_PT appHandle);
+
+/*********************************************************************************************************************/
+/** Socket sharing: enclose the reading of frames, frames read for the session meanwhile are handled at the end
+ *
+ *  @param[in]      appHandle       session pointer, locked
+ */
+
+void trdp_shareRxBegin(
+    TRDP_SESSION_PT appHandle);
+
+void trdp_shareRxEnd(
+    TRDP_SESSION_PT appHandle);
+
+/*********************************************************************************************************************/
+/** Socket sharing: hand a frame read from a shared socket to the other sessions sharing it
+ *
+ *  @param[in]      appHandle       session which read the frame
+ *  @param[in]      sock            the socket read
+ *  @param[in]      pData           the frame
+ *  @param[in]      size            size of the frame
+ *  @param[in]      srcIpAddr       source IP of the frame
+ *  @param[in]      destIpAddr      destination IP of the frame
+ *  @param[in]      pRxTime         reception time
+ *
+ *  @retval         TRUE            the frame was handed to another session
+ */
+
+BOOL8 trdp_shareDeliver(
+    TRDP_SESSION_PT     appHandle,
+    SOCKET              sock,
+    const UINT8         *pData,
+    UINT32              size,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    TRDP_IP_ADDR_T      destIpAddr,
+    const TRDP_TIME_T   *pRxTime);
+
+/*********************************************************************************************************************/
+/** Update the poll set of a session from its socket pool
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_SOCK_ERR       a socket could not be added
+ */
+
+TRDP_ERR_T trdp_syncPollSet(
+    TRDP_SESSION_PT appHandle);
+
 
 /*********************************************************************************************************************/
 /** Get the packet size from the raw data size
@@ -227,7 +479,9 @@ UINT32 trdp_packetSizeMD (
  *
  *  Note: The standard demands that sequenceCounter is managed per comID/msgType at each publisher,
  *        but shall be the same for redundant telegrams (subnet/srcIP).
+ *        Publishers of the other sessions are found without their session mutex (trdp_seqPubList).
  *
+ *  @param[in]      appHandle       session to look in
  *  @param[in]      comID           comID to look for
  *  @param[in]      msgType         PD/MD type
  *  @param[in]      srcIP           Source IP address
@@ -236,6 +490,7 @@ UINT32 trdp_packetSizeMD (
  */
 
 UINT32 trdp_getSeqCnt (
+    TRDP_SESSION_PT appHandle,
     UINT32          comID,
     TRDP_MSG_T      msgType,
     TRDP_IP_ADDR_T  srcIP);
@@ -278,6 +533,89 @@ BOOL8 trdp_isAddressed (
     const TRDP_URI_USER_T   listUri,
     const TRDP_URI_USER_T   destUri);
 
+/**********************************************************************************************************************/
+/** Case insensitive hash of a user URI
+ *
+ *  @param[in]      pUri          URI, terminated by 0 or after TRDP_USR_URI_SIZE characters
+ *
+ *  @retval         hash
+ */
+
+UINT32 trdp_uriHash (
+    const CHAR8 *pUri);
+
+
+/**********************************************************************************************************************/
+/** Get the current time.
+ *  Within tlc_process the time read at its start is returned, else the clock is read.
+ *
+ *  @param[in]      appHandle     session, locked by the caller
+ *  @param[out]     pNow          current time
+ */
+
+void trdp_getNow (
+    TRDP_SESSION_PT appHandle,
+    TRDP_TIME_T     *pNow);
+
+/**********************************************************************************************************************/
+/** Lock / unlock the session including its PD send side (mutex, then sndMutex).
+ *  Used by all functions changing publishers, tlc_processSend() takes sndMutex only.
+ *
+ *  @param[in]      appHandle     session
+ */
+
+VOS_ERR_T trdp_sessionLock (
+    TRDP_SESSION_PT appHandle);
+
+VOS_ERR_T trdp_sessionUnlock (
+    TRDP_SESSION_PT appHandle);
+
+/**********************************************************************************************************************/
+/** Work budget of tlc_process() (TRDP_PROCESS_CONFIG_T.budgetFrames/budgetTime)
+ *
+ *  @param[in]      appHandle     session
+ */
+
+void trdp_budgetStart (
+    TRDP_SESSION_PT appHandle);
+
+void trdp_budgetStop (
+    TRDP_SESSION_PT appHandle);
+
+void trdp_budgetSpend (
+    TRDP_SESSION_PT appHandle,
+    UINT32          frames);
+
+BOOL8 trdp_budgetLeft (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T trdp_cbDispatchStart (
+    TRDP_SESSION_PT appHandle);
+
+void trdp_cbDispatchStop (
+    TRDP_SESSION_PT appHandle);
+
+TRDP_ERR_T trdp_cbDispatchPd (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_PD_CALLBACK_T      pfCbFunction,
+    const TRDP_PD_INFO_T    *pMsg,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    PD_ELE_T                *pElement);
+
+PD_PACKET_T *trdp_pdFrameReclaim (
+    PD_ELE_T    *pElement,
+    UINT32      frameSize);
+
+#if MD_SUPPORT
+TRDP_ERR_T trdp_cbDispatchMd (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_MD_CALLBACK_T      pfCbFunction,
+    const TRDP_MD_INFO_T    *pMsg,
+    const UINT8             *pData,
+    UINT32                  dataSize);
+#endif
+
 
 BOOL8 trdp_validTopoCounters (
     UINT32  etbTopoCnt,
@@ -44,6 +44,90 @@
 *  LOCAL FUNCTIONS
 */
 
+/**********************************************************************************************************************/
+/** Read the next part of the file into the buffer.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         TRUE        data available
+ *                  FALSE       end of document
+ */
+static BOOL8 trdp_XMLFill (
+    XML_HANDLE_T *pXML)
+{
+    if (pXML->infile == NULL)
+    {
+        return FALSE;
+    }
+    pXML->bufOffset += (long) pXML->fill;
+    pXML->fill      = (UINT32) fread(pXML->pBuffer, 1u, pXML->bufSize, pXML->infile);
+    pXML->pos       = 0u;
+    return (pXML->fill > 0u) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Return the next character, EOF at the end of the document.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         character or EOF
+ */
+static int trdp_XMLGetc (
+    XML_HANDLE_T *pXML)
+{
+    if ((pXML->pos >= pXML->fill) && (trdp_XMLFill(pXML) == FALSE))
+    {
+        pXML->eof = TRUE;
+        return EOF;
+    }
+    return (int) (UINT8) pXML->pBuffer[pXML->pos++];
+}
+
+/**********************************************************************************************************************/
+/** Push back the character read last.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      ch          character read last
+ */
+static void trdp_XMLUngetc (
+    XML_HANDLE_T    *pXML,
+    int             ch)
+{
+    if ((ch != EOF) && (pXML->pos > 0u))
+    {
+        pXML->pos--;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Continue reading at a document offset.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      offset      offset from the start of the document
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *                  TRDP_IO_ERR     file could not be positioned
+ */
+static TRDP_ERR_T trdp_XMLSeek (
+    XML_HANDLE_T    *pXML,
+    long            offset)
+{
+    pXML->eof = FALSE;
+    if ((offset >= pXML->bufOffset) && (offset <= pXML->bufOffset + (long) pXML->fill))
+    {
+        pXML->pos = (UINT32) (offset - pXML->bufOffset);
+        return TRDP_NO_ERR;
+    }
+    if ((pXML->infile == NULL) || (fseek(pXML->infile, offset, SEEK_SET) == -1))
+    {
+        return TRDP_IO_ERR;
+    }
+    pXML->bufOffset = offset;
+    pXML->fill      = 0u;
+    pXML->pos       = 0u;
+    return TRDP_NO_ERR;
+}
+
 /***********************************************************************************************************************
 NAME:       trdp_XMLNextToken
 ABSTRACT:   Returns next XML token.
@@ -70,14 +154,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
     for (;;)
     {
         /* Skip whitespace */
-        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) <= ' ') /*lint !e160 Lint objects a GNU warning
+        while ((pXML->eof == FALSE) && (ch = trdp_XMLGetc(pXML)) <= ' ') /*lint !e160 Lint objects a GNU warning
                                                                            suppression macro - OK */
         {
             ;
         }
 
         /* Check for EOF */
-        if (feof(pXML->infile)) /*lint !e611 Lint for VxWorks gets lost in macro defintions*/
+        if (pXML->eof == TRUE) /*lint !e611 Lint for VxWorks gets lost in macro defintions*/
         {
             return TOK_EOF;
         }
@@ -86,7 +170,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
         if (ch == '"')
         {
             p = pXML->tokenValue;
-            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '"') /*lint !e160 Lint objects a GNU warning
+            while ((pXML->eof == FALSE) && (ch = trdp_XMLGetc(pXML)) != '"') /*lint !e160 Lint objects a GNU warning
                                                                                suppression macro - OK */
             {
                 if (p < (pXML->tokenValue + MAX_TOK_LEN - 1))
@@ -101,22 +185,22 @@ static XML_TOKEN_T trdp_XMLNextToken (
         else if (ch == '<')
         {
             /* Tag start character */
-            ch = fgetc(pXML->infile);    /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            ch = trdp_XMLGetc(pXML);    /*lint !e160 Lint objects a GNU warning suppression macro - OK */
 
             if (ch == '?') /* Skip processing instruction */
             {
-                while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU warning
+                while ((pXML->eof == FALSE) && (ch = trdp_XMLGetc(pXML))) /*lint !e160 Lint objects a GNU warning
                                                                             suppression macro - OK */
                 {
                     if (ch == '?')
                     {
-                        if ((ch = fgetc(pXML->infile)) == '>')
+                        if ((ch = trdp_XMLGetc(pXML)) == '>')
                         {
                             break;
                         }
                         else
                         {
-                            (void) ungetc(ch, pXML->infile);
+                            trdp_XMLUngetc(pXML, ch);
                         }
                     }
                 }
@@ -124,14 +208,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
             else if (ch == '!')
             {
                 /* Is it a comment? */
-                if (!feof(pXML->infile) && (ch = fgetc(pXML->infile)))
+                if ((pXML->eof == FALSE) && (ch = trdp_XMLGetc(pXML)))
                 {
                     if (ch == '-')
                     {
-                        if ((ch = fgetc(pXML->infile) == '-'))
+                        if ((ch = trdp_XMLGetc(pXML) == '-'))
                         {
                             int endTagCnt = 0;
-                            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU
+                            while ((pXML->eof == FALSE) && (ch = trdp_XMLGetc(pXML))) /*lint !e160 Lint objects a GNU
                                                                                         warning suppression macro - OK
                                                                                         */
                             {
@@ -150,7 +234,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
                                 }
                             }
                             /* Exit on unexpected end-of-file */
-                            if (endTagCnt != 2 && feof(pXML->infile))
+                            if (endTagCnt != 2 && (pXML->eof == TRUE))
                             {
                                 pXML->error = TRDP_XML_PARSER_ERR;
                                 return TOK_EOF;
@@ -159,14 +243,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
                     }
                     else
                     {
-                        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '>')
+                        while ((pXML->eof == FALSE) && (ch = trdp_XMLGetc(pXML)) != '>')
                         {
                             ;
                         }
                     }
                 }
                 /* Exit on unexpected end-of-file */
-                if (feof(pXML->infile))
+                if (pXML->eof == TRUE)
                 {
                     pXML->error = TRDP_XML_PARSER_ERR;
                     return TOK_EOF;
@@ -178,20 +262,20 @@ static XML_TOKEN_T trdp_XMLNextToken (
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                trdp_XMLUngetc(pXML, ch);
                 return TOK_OPEN;
             }
         }
         else if (ch == '/')
         {
-            ch = fgetc(pXML->infile); /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            ch = trdp_XMLGetc(pXML); /*lint !e160 Lint objects a GNU warning suppression macro - OK */
             if (ch == '>')
             {
                 return TOK_CLOSE_EMPTY;
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                trdp_XMLUngetc(pXML, ch);
             }
         }
         else if (ch == '>')
@@ -207,8 +291,8 @@ static XML_TOKEN_T trdp_XMLNextToken (
             /* Unquoted identifier */
             p       = pXML->tokenValue;
             *(p++)  = (char) ch;
-            while ((!feof(pXML->infile)) &&
-                   ((ch = fgetc(pXML->infile)) != '<') /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            while ((pXML->eof == FALSE) &&
+                   ((ch = trdp_XMLGetc(pXML)) != '<') /*lint !e160 Lint objects a GNU warning suppression macro - OK */
                    && (ch != '>')
                    && (ch != '=')
                    && (ch != '/')
@@ -224,7 +308,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
 
             if ((ch == '<') || (ch == '>') || (ch == '=') || (ch == '/'))
             {
-                (void) ungetc(ch, pXML->infile);
+                trdp_XMLUngetc(pXML, ch);
             }
 
             return TOK_ID;
@@ -299,27 +383,191 @@ static XML_TOKEN_T trdp_XMLNextTokenHl (
 
 /**********************************************************************************************************************/
 /** Opens the XML parsing.
+ *  The file is read into memory as a whole if possible, otherwise through a buffer of TRDP_XML_CHUNK_SIZE bytes.
  *
  *  @param[in]      pXML        Pointer to local data
  *  @param[in]      file        Pathname of XML file
  *
- *  @retval         none
+ *  @retval         TRDP_NO_ERR     no error
+ *                  TRDP_IO_ERR     file could not be read
+ *                  TRDP_MEM_ERR    no memory for the read buffer
  */
 TRDP_ERR_T trdp_XMLOpen (
     XML_HANDLE_T    *pXML,
     const char      *file)
 {
-    if ((pXML->infile = fopen(file, "r")) == NULL)
+    long size;
+
+    if ((pXML->infile = fopen(file, "rb")) == NULL)
     {
         return TRDP_IO_ERR;
     }
 
+    pXML->pBuffer   = NULL;
+    pXML->fill      = 0u;
+    pXML->pos       = 0u;
+    pXML->bufOffset = 0;
+    pXML->eof       = FALSE;
+    pXML->ownBuffer = TRUE;
+
+    if ((fseek(pXML->infile, 0, SEEK_END) == 0) && ((size = ftell(pXML->infile)) > 0) &&
+        (fseek(pXML->infile, 0, SEEK_SET) == 0))
+    {
+        pXML->pBuffer = (char *) vos_memAlloc((UINT32) size);
+        if ((pXML->pBuffer != NULL) &&
+            (fread(pXML->pBuffer, 1u, (size_t) size, pXML->infile) == (size_t) size))
+        {
+            /* the whole document is in memory, the file is not needed any more */
+            pXML->bufSize   = (UINT32) size;
+            pXML->fill      = (UINT32) size;
+            (void) fclose(pXML->infile);
+            pXML->infile    = NULL;
+        }
+        else if (pXML->pBuffer != NULL)
+        {
+            vos_memFree((UINT8 *) pXML->pBuffer);
+            pXML->pBuffer = NULL;
+        }
+    }
+
+    if (pXML->infile != NULL)
+    {
+        pXML->bufSize   = TRDP_XML_CHUNK_SIZE;
+        pXML->pBuffer   = (char *) vos_memAlloc(TRDP_XML_CHUNK_SIZE);
+        if ((pXML->pBuffer == NULL) || (fseek(pXML->infile, 0, SEEK_SET) == -1))
+        {
+            if (pXML->pBuffer != NULL)
+            {
+                vos_memFree((UINT8 *) pXML->pBuffer);
+            }
+            (void) fclose(pXML->infile);
+            pXML->infile = NULL;
+            return (pXML->pBuffer == NULL) ? TRDP_MEM_ERR : TRDP_IO_ERR;
+        }
+    }
+
     pXML->tagDepth      = 0;
     pXML->tagDepthSeek  = 0;
     pXML->error         = TRDP_NO_ERR;
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Opens the XML parsing of a document in memory.
+ *  The buffer is not copied, it must stay valid until trdp_XMLClose().
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      pBuffer     XML document
+ *  @param[in]      size        Size of the document
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *                  TRDP_PARAM_ERR  no document
+ */
+TRDP_ERR_T trdp_XMLOpenMem (
+    XML_HANDLE_T    *pXML,
+    const char      *pBuffer,
+    UINT32          size)
+{
+    if (pBuffer == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    pXML->infile        = NULL;
+    pXML->pBuffer       = (char *) pBuffer;
+    pXML->bufSize       = size;
+    pXML->fill          = size;
+    pXML->pos           = 0u;
+    pXML->bufOffset     = 0;
+    pXML->eof           = FALSE;
+    pXML->ownBuffer     = FALSE;
+    pXML->tagDepth      = 0;
+    pXML->tagDepthSeek  = 0;
+    pXML->error         = TRDP_NO_ERR;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Opens the XML parsing of the content of an element in memory.
+ *  The buffer starts behind the tag name of the element, i.e. with its attributes, the parser behaves as if
+ *  trdp_XMLSeekStartTag() had just found the element on the first level.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      pBuffer     Element text
+ *  @param[in]      size        Size of the text
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *                  TRDP_PARAM_ERR  no text
+ */
+TRDP_ERR_T trdp_XMLOpenElement (
+    XML_HANDLE_T    *pXML,
+    const char      *pBuffer,
+    UINT32          size)
+{
+    TRDP_ERR_T err = trdp_XMLOpenMem(pXML, pBuffer, size);
+
+    if (err == TRDP_NO_ERR)
+    {
+        pXML->tagDepth      = 1;
+        pXML->tagDepthSeek  = 1;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Return the current read position.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         offset from the start of the document
+ */
+long trdp_XMLTell (
+    const XML_HANDLE_T *pXML)
+{
+    return pXML->bufOffset + (long) pXML->pos;
+}
+
+/**********************************************************************************************************************/
+/** Copy a part of the document, the read position is kept.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      offset      offset from the start of the document
+ *  @param[in]      size        number of bytes to copy
+ *  @param[out]     pDest       destination
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *                  TRDP_IO_ERR     the part could not be read
+ */
+TRDP_ERR_T trdp_XMLCopy (
+    XML_HANDLE_T    *pXML,
+    long            offset,
+    UINT32          size,
+    char            *pDest)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    if ((offset >= pXML->bufOffset) && (offset + (long) size <= pXML->bufOffset + (long) pXML->fill))
+    {
+        memcpy(pDest, pXML->pBuffer + (offset - pXML->bufOffset), size);
+        return TRDP_NO_ERR;
+    }
+    if (pXML->infile == NULL)
+    {
+        return TRDP_IO_ERR;
+    }
+    if ((fseek(pXML->infile, offset, SEEK_SET) == -1) || (fread(pDest, 1u, size, pXML->infile) != size))
+    {
+        err = TRDP_IO_ERR;
+    }
+    /* continue reading behind the buffer */
+    if (fseek(pXML->infile, pXML->bufOffset + (long) pXML->fill, SEEK_SET) == -1)
+    {
+        pXML->error = TRDP_IO_ERR;
+        err         = TRDP_IO_ERR;
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Rewind to start.
  *
@@ -330,11 +578,11 @@ TRDP_ERR_T trdp_XMLOpen (
 void trdp_XMLRewind (
     XML_HANDLE_T *pXML)
 {
-    if (pXML->infile == NULL)
+    if (pXML->pBuffer == NULL)
     {
         pXML->error = TRDP_XML_PARSER_ERR;
     }
-    else if (fseek(pXML->infile, 0, SEEK_SET) == -1)
+    else if (trdp_XMLSeek(pXML, 0) != TRDP_NO_ERR)
     {
         pXML->error = TRDP_IO_ERR;
     }
@@ -356,7 +604,16 @@ void trdp_XMLRewind (
 void trdp_XMLClose (
     XML_HANDLE_T *pXML)
 {
-    fclose(pXML->infile);
+    if (pXML->infile != NULL)
+    {
+        (void) fclose(pXML->infile);
+        pXML->infile = NULL;
+    }
+    if ((pXML->ownBuffer == TRUE) && (pXML->pBuffer != NULL))
+    {
+        vos_memFree((UINT8 *) pXML->pBuffer);
+    }
+    pXML->pBuffer = NULL;
 }
 
 /**********************************************************************************************************************/
@@ -444,7 +701,6 @@ int trdp_XMLCountStartTag (
     int             count = 0;
 
     XML_HANDLE_T    safe        = *pXML;
-    off_t           last_read   = ftell(pXML->infile);
 
     do
     {
@@ -457,7 +713,13 @@ int trdp_XMLCountStartTag (
     while (ret == 0);
 
     *pXML = safe;
-    fseek(pXML->infile, (long) last_read, SEEK_SET);
+    /* the buffer may have been refilled meanwhile */
+    if ((pXML->infile != NULL) &&
+        (fseek(pXML->infile, pXML->bufOffset, SEEK_SET) == 0) &&
+        (fread(pXML->pBuffer, 1u, pXML->fill, pXML->infile) != pXML->fill))
+    {
+        pXML->error = TRDP_IO_ERR;
+    }
     return count;
 }
 
@@ -37,6 +37,11 @@
  * DEFINES
  */
 
+/* Size of the read buffer if the XML file does not fit into memory as a whole */
+#ifndef TRDP_XML_CHUNK_SIZE
+#define TRDP_XML_CHUNK_SIZE     65536u
+#endif
+
 /*******************************************************************************
  * TYPEDEFS
  */
@@ -67,7 +72,14 @@ typedef enum
 
 typedef struct XML_HANDLE
 {
-    FILE    *infile;
+    FILE    *infile;        /* NULL if the whole document is in pBuffer */
+    char    *pBuffer;       /* document or the part of the file read last */
+    UINT32  bufSize;        /* allocated size of pBuffer */
+    UINT32  fill;           /* bytes valid in pBuffer */
+    UINT32  pos;            /* read position in pBuffer */
+    long    bufOffset;      /* file offset of pBuffer[0] */
+    BOOL8   ownBuffer;      /* pBuffer was allocated by trdp_XMLOpen */
+    BOOL8   eof;            /* read past the end of the document */
     char    tokenValue[MAX_TOK_LEN];
     int     tagDepth;
     int     tagDepthSeek;
@@ -81,7 +93,18 @@ typedef struct XML_HANDLE
 
 TRDP_ERR_T  trdp_XMLOpen (XML_HANDLE_T  *pXML,
                           const char    *file);
+TRDP_ERR_T  trdp_XMLOpenMem (XML_HANDLE_T   *pXML,
+                             const char     *pBuffer,
+                             UINT32         size);
+TRDP_ERR_T  trdp_XMLOpenElement (XML_HANDLE_T   *pXML,
+                                 const char     *pBuffer,
+                                 UINT32         size);
 void        trdp_XMLClose (XML_HANDLE_T *pXML);
+long        trdp_XMLTell (const XML_HANDLE_T *pXML);
+TRDP_ERR_T  trdp_XMLCopy (XML_HANDLE_T  *pXML,
+                          long          offset,
+                          UINT32        size,
+                          char          *pDest);
 int         trdp_XMLCountStartTag (
     XML_HANDLE_T    *pXML,
     const char      *tag);
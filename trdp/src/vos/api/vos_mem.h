@@ -45,6 +45,45 @@ extern "C" {
 
 #define VOS_MEM_MAX_PREALLOCATE     10u  /**< Max blocks to pre-allocate */
 #define VOS_MEM_NBLOCKSIZES         15u  /**< No of pre-defined block sizes */
+#define VOS_CACHE_LINE_SIZE         64u  /**< Cache line size assumed for aligned buffers */
+
+/** Per thread caches of free blocks (POSIX only): vos_memAlloc/vos_memFree take the memory semaphore only to refill
+    or drain a cache. Blocks cached by a thread are counted as free memory, but can only be used by this thread until
+    it terminates. */
+#ifndef VOS_MEM_THREAD_CACHE
+#define VOS_MEM_THREAD_CACHE        0
+#endif
+#define VOS_MEM_CACHE_DEPTH         16u  /**< Max. cached blocks per block size and thread */
+
+/** Allocate the memory area of vos_memInit() on the NUMA node of the calling CPU and fault it in (Linux only, else
+    the heap is used). Bind the initialising thread to the CPUs of the TRDP cycle before calling vos_memInit(). */
+#ifndef VOS_MEM_NUMA_LOCAL
+#define VOS_MEM_NUMA_LOCAL          1
+#endif
+
+/** Back the memory area of vos_memInit() by huge pages (Linux only): reserved huge pages (MAP_HUGETLB) if available,
+    else transparent huge pages. The area is rounded up to full huge pages. */
+#ifndef VOS_MEM_HUGE_PAGES
+#define VOS_MEM_HUGE_PAGES          0
+#endif
+
+/** Lock the memory area of vos_memInit() into RAM (Linux only), needs a sufficient RLIMIT_MEMLOCK. */
+#ifndef VOS_MEM_LOCK
+#define VOS_MEM_LOCK                0
+#endif
+
+/** Check for allocations after vos_memSetOperational(TRUE): 0 - count them only, 1 - also log an error,
+    2 - also assert (debug builds) */
+#ifndef VOS_MEM_CHECK_OPERATIONAL
+#define VOS_MEM_CHECK_OPERATIONAL   0
+#endif
+
+/** Profile the memory area of vos_memInit() per block size and per call site of vos_memAlloc(), see vos_memProfile().
+    Meant to size VOS_MEM_PREALLOCATE and the memory area, costs a semaphore per vos_memAlloc()/vos_memFree(). */
+#ifndef VOS_MEM_PROFILE
+#define VOS_MEM_PROFILE             0
+#endif
+#define VOS_MEM_PROFILE_SITES       64u  /**< Max. call sites of vos_memAlloc() profiled */
 
 /** Queue policy matching pthread/Posix defines    */
 typedef enum
@@ -90,6 +129,49 @@ typedef enum
 typedef struct VOS_QUEUE *VOS_QUEUE_T;
 typedef struct VOS_QUEUE_ELEM *VOS_QUEUE_ELEM_T;
 
+/** Opaque ring queue define  */
+typedef struct VOS_RING *VOS_RING_T;
+
+/** Producer model of a ring queue, there is always a single consumer   */
+typedef enum
+{
+    VOS_RING_SPSC = 0,              /*  One producer thread              */
+    VOS_RING_MPSC = 1               /*  Any number of producer threads   */
+} VOS_RING_TYPE_T;
+
+/** Profile of a block size (VOS_MEM_PROFILE) */
+typedef struct
+{
+    UINT32  blockSize;                  /**< block size                                             */
+    UINT32  used;                       /**< blocks in use                                          */
+    UINT32  highWater;                  /**< max. blocks in use at the same time                    */
+    UINT32  allocCnt;                   /**< allocations                                            */
+    UINT32  minSize;                    /**< smallest requested size, 0 if none                     */
+    UINT32  maxSize;                    /**< largest requested size                                 */
+    UINT64  requested;                  /**< sum of the requested sizes                             */
+    UINT64  wasted;                     /**< sum of the bytes lost by rounding up to the block size */
+} VOS_MEM_CLASS_PROFILE_T;
+
+/** Profile of a call site of vos_memAlloc() (VOS_MEM_PROFILE) */
+typedef struct
+{
+    const void  *pSite;                 /**< return address of the call, NULL if unknown (no GCC)   */
+    UINT32      used;                   /**< blocks in use                                          */
+    UINT32      highWater;              /**< max. blocks in use at the same time                    */
+    UINT32      allocCnt;               /**< allocations                                            */
+    UINT64      requested;              /**< sum of the requested sizes                             */
+} VOS_MEM_SITE_PROFILE_T;
+
+/** Profile of the memory area, counters since vos_memInit() or vos_memProfileReset() */
+typedef struct
+{
+    VOS_TIMEVAL_T           duration;   /**< time since vos_memInit() or vos_memProfileReset()      */
+    UINT32                  numSites;   /**< entries of site used                                   */
+    UINT32                  lostCnt;    /**< allocations of call sites not fitting into site        */
+    VOS_MEM_CLASS_PROFILE_T sizeClass[VOS_MEM_NBLOCKSIZES];    /**< per block size                 */
+    VOS_MEM_SITE_PROFILE_T  site[VOS_MEM_PROFILE_SITES];       /**< per call site                  */
+} VOS_MEM_PROFILE_T;
+
 /***********************************************************************************************************************
  * PROTOTYPES
  */
@@ -116,6 +198,27 @@ EXT_DECL VOS_ERR_T vos_memInit (
     UINT32          size,
     const UINT32    fragMem[VOS_MEM_NBLOCKSIZES]);
 
+/**********************************************************************************************************************/
+/** Initialize the memory unit with application defined block sizes.
+ *  As vos_memInit(), the block sizes replace VOS_MEM_BLOCKSIZES, e.g. sized to the PD and MD telegrams of the
+ *  application (see test_memSizes). They are rounded up to a multiple of UINT32 and must be ascending. Fewer than
+ *  VOS_MEM_NBLOCKSIZES sizes are ended by a 0, fragMem refers to the same indices.
+ *
+ *  @param[in]      pMemoryArea     Pointer to memory area to use
+ *  @param[in]      size            Size of provided memory area
+ *  @param[in]      fragMem         Pointer to list of preallocate block sizes, used to fragment memory for large blocks
+ *  @param[in]      blockSizes      Block sizes, NULL for VOS_MEM_BLOCKSIZES
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR     no memory available
+ */
+
+EXT_DECL VOS_ERR_T vos_memInitBlockSizes (
+    UINT8           *pMemoryArea,
+    UINT32          size,
+    const UINT32    fragMem[VOS_MEM_NBLOCKSIZES],
+    const UINT32    blockSizes[VOS_MEM_NBLOCKSIZES]);
+
 /**********************************************************************************************************************/
 /** Delete the memory area.
  *  This will eventually invalidate any previously allocated memory blocks! It should be called last before the
@@ -139,6 +242,21 @@ EXT_DECL void vos_memDelete (
 EXT_DECL UINT8 *vos_memAlloc (
     UINT32 size);
 
+/**********************************************************************************************************************/
+/** Allocate a block of memory with an aligned data area (from memory area above).
+ *  Costs alignment plus a block header more than vos_memAlloc(), the block is returned with vos_memFree().
+ *
+ *  @param[in]      size            Size of requested block
+ *  @param[in]      alignment       Alignment of the data area, a power of two (e.g. VOS_CACHE_LINE_SIZE)
+ *
+ *  @retval         Pointer to memory area
+ *  @retval         NULL if no memory available or alignment invalid
+ */
+
+EXT_DECL UINT8 *vos_memAllocAligned (
+    UINT32  size,
+    UINT32  alignment);
+
 /**********************************************************************************************************************/
 /** Deallocate a block of memory (from memory area above).
  *
@@ -173,6 +291,44 @@ EXT_DECL VOS_ERR_T vos_memCount(
     UINT32 blockSize[VOS_MEM_NBLOCKSIZES],
     UINT32 usedBlockSize[VOS_MEM_NBLOCKSIZES]);
 
+/**********************************************************************************************************************/
+/** Enter or leave the operational phase.
+ *  While operational, every vos_memAlloc() is counted and, depending on VOS_MEM_CHECK_OPERATIONAL, logged or
+ *  asserted. Used to verify that an application does not allocate memory once its start up is done.
+ *  @param[in]      operational     TRUE: start up is done
+ */
+
+EXT_DECL void vos_memSetOperational (
+    BOOL8 operational);
+
+/**********************************************************************************************************************/
+/** Return the number of vos_memAlloc() calls in the operational phase.
+ *  @retval         number of allocations while operational since vos_memInit()
+ */
+
+EXT_DECL UINT32 vos_memOperationalAllocs (void);
+
+/**********************************************************************************************************************/
+/** Return the profile of the memory area (VOS_MEM_PROFILE).
+ *  Allocation rates are the counters divided by the duration. Blocks used are counted for the block size actually
+ *  taken, which is a larger one if the free area is exhausted.
+ *
+ *  @param[out]     pProfile        Pointer to the profile
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_INIT_ERR    not profiled: VOS_MEM_PROFILE is 0 or the heap is used
+ */
+
+EXT_DECL VOS_ERR_T vos_memProfile (
+    VOS_MEM_PROFILE_T *pProfile);
+
+/**********************************************************************************************************************/
+/** Restart the profile of the memory area (VOS_MEM_PROFILE), e.g. once the start up is done.
+ *  The counters and sizes are cleared, the high water marks are set to the blocks in use.
+ */
+
+EXT_DECL void vos_memProfileReset (void);
+
 /**********************************************************************************************************************/
 /*  Sorting/Searching                                                                                                 */
 /**********************************************************************************************************************/
@@ -344,6 +500,25 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
     UINT32      *pSize,
     UINT32      usTimeout );
 
+/**********************************************************************************************************************/
+/** Get a message, wait until a deadline.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     ppData          Pointer to data pointer to be received
+ *  @param[out]     pSize           Size of receive data
+ *  @param[in]      pDeadline       Latest time to wait for a message, a time returned by vos_getTime()
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_QUEUE_ERR   no message until the deadline
+ */
+
+EXT_DECL VOS_ERR_T vos_queueReceiveUntil (
+    VOS_QUEUE_T         queueHandle,
+    UINT8               * *ppData,
+    UINT32              *pSize,
+    const VOS_TIMEVAL_T *pDeadline);
+
 
 /**********************************************************************************************************************/
 /** Destroy a message queue.
@@ -360,6 +535,85 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
 EXT_DECL VOS_ERR_T vos_queueDestroy (
     VOS_QUEUE_T queueHandle);
 
+/**********************************************************************************************************************/
+/*    Ring queues
+                                                                                                               */
+/**********************************************************************************************************************/
+
+/**********************************************************************************************************************/
+/** Initialize a ring queue.
+ *  A ring queue is a bounded FIFO with a fixed number of slots of fixed size. Messages are copied into the slots,
+ *  no memory is allocated per message and no lock is taken. The receiver only blocks if the queue is empty.
+ *
+ *  @param[in]      type            VOS_RING_SPSC for one, VOS_RING_MPSC for several producer threads
+ *  @param[in]      maxNoOfMsg      Maximum number of messages, rounded up to a power of 2
+ *  @param[in]      maxMsgSize      Maximum size of a message
+ *  @param[out]     pRing           Handle of created ring queue
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid, or the ring would exceed 4GB
+ *  @retval         VOS_MEM_ERR     no memory available
+ *  @retval         VOS_SEMA_ERR    no semaphore available
+ *  @retval         VOS_INIT_ERR    not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_ringCreate (
+    VOS_RING_TYPE_T type,
+    UINT32          maxNoOfMsg,
+    UINT32          maxMsgSize,
+    VOS_RING_T      *pRing);
+
+/**********************************************************************************************************************/
+/** Send a message, the data is copied into the ring queue.
+ *
+ *  @param[in]      ring            Ring queue handle
+ *  @param[in]      pData           Pointer to data to be sent
+ *  @param[in]      size            Size of data to be sent
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_PARAM_ERR       parameter out of range/invalid
+ *  @retval         VOS_QUEUE_FULL_ERR  no free slot
+ */
+
+EXT_DECL VOS_ERR_T vos_ringSend (
+    VOS_RING_T  ring,
+    const UINT8 *pData,
+    UINT32      size);
+
+/**********************************************************************************************************************/
+/** Get a message. Must only be called by one thread at a time.
+ *
+ *  @param[in]      ring            Ring queue handle
+ *  @param[out]     pData           Pointer to buffer for the message
+ *  @param[in,out]  pSize           In: size of the buffer, out: size of the message
+ *  @param[in]      usTimeout       Maximum time to wait for a message (in usec), 0: don't wait,
+ *                                  VOS_SEMA_WAIT_FOREVER: wait forever
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR     buffer too small, the message stays in the queue
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+
+EXT_DECL VOS_ERR_T vos_ringReceive (
+    VOS_RING_T  ring,
+    UINT8       *pData,
+    UINT32      *pSize,
+    UINT32      usTimeout);
+
+/**********************************************************************************************************************/
+/** Destroy a ring queue.
+ *  Free all resources used by this ring queue, no thread may use it anymore.
+ *
+ *  @param[in]      ring            Ring queue handle
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_ringDestroy (
+    VOS_RING_T ring);
+
 
 #ifdef __cplusplus
 }
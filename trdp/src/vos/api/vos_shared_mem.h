@@ -80,6 +80,27 @@ EXT_DECL VOS_ERR_T vos_sharedOpen (
     UINT32      *pSize);
 
 
+/**********************************************************************************************************************/
+/** Attach to an existing shared memory area.
+ *  The area must have been created by vos_sharedOpen(), its contents are left intact.
+ *    This function is not available in each target implementation.
+ *
+ *  @param[in]      pKey            Unique identifier (file name)
+ *  @param[out]     pHandle         Pointer to returned handle
+ *  @param[out]     ppMemoryArea    Pointer to pointer to memory area
+ *  @param[out]     pSize           Pointer to actual size of the area
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     area does not exist or could not be mapped
+ */
+
+EXT_DECL VOS_ERR_T vos_sharedAttach (
+    const CHAR8 *pKey,
+    VOS_SHRD_T  *pHandle,
+    UINT8       **ppMemoryArea,
+    UINT32      *pSize);
+
+
 /**********************************************************************************************************************/
 /** Close connection to the shared memory area.
  *  If the area was created by the calling process, the area will be closed (freed). If the area was attached,
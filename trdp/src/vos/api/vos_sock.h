@@ -69,7 +69,7 @@ extern "C" {
 #define VOS_MAX_SOCKET_CNT  80      /**< The maximum number of concurrent usable sockets per application session */
 #endif
 #ifndef VOS_MAX_MULTICAST_CNT
-#define VOS_MAX_MULTICAST_CNT  20   /**< The maximum number of multicast groups one socket can join              */
+#define VOS_MAX_MULTICAST_CNT  20   /**< Initial number of multicast memberships per socket, grows on demand     */
 #endif
 
 #else
@@ -78,7 +78,7 @@ extern "C" {
 #define VOS_MAX_SOCKET_CNT  4       /**< The maximum number of concurrent usable sockets per application session */
 #endif
 #ifndef VOS_MAX_MULTICAST_CNT
-#define VOS_MAX_MULTICAST_CNT  5    /**< The maximum number of multicast groups one socket can join              */
+#define VOS_MAX_MULTICAST_CNT  5    /**< Initial number of multicast memberships per socket, grows on demand     */
 #endif
 
 #endif
@@ -104,6 +104,22 @@ extern "C" {
 #endif
 #endif
 
+#ifndef VOS_MAX_SOCK_BATCH          /**< The maximum number of datagrams handled by one batched socket call */
+#define VOS_MAX_SOCK_BATCH  32u
+#endif
+
+#ifndef VOS_MAX_SOCK_SEGS           /**< The maximum number of buffer segments of one gathered TCP send */
+#define VOS_MAX_SOCK_SEGS   8u
+#endif
+
+#ifndef VOS_MAX_UDP_SEGS            /**< The maximum number of datagrams of one segmented UDP send (UDP_SEGMENT) */
+#define VOS_MAX_UDP_SEGS    64u
+#endif
+
+#ifndef VOS_SOCK_FILTER_TYPES       /**< The maximum number of datagram types a receive filter applies to */
+#define VOS_SOCK_FILTER_TYPES   4u
+#endif
+
 #define VOS_INVALID_SOCKET  -1      /**< Invalid socket number */
 
 #define VOS_INADDR_ANY      INADDR_ANY
@@ -130,10 +146,71 @@ typedef struct
     BOOL8   nonBlocking;    /**< use non blocking calls                             */
     BOOL8   no_mc_loop;     /**< no multicast loop back                             */
     BOOL8   no_udp_crc;     /**< supress udp crc computation                        */
+    BOOL8   txTime;         /**< accept launch times (vos_sockSendUDPAt, SO_TXTIME) */
+    BOOL8   rxTime;         /**< report receive time stamps (SO_TIMESTAMPING)       */
+    UINT32  busyPoll;       /**< busy poll the device for this time in us on reads (SO_BUSY_POLL), 0: off */
+    BOOL8   tcpNoDelay;     /**< send small TCP segments at once (TCP_NODELAY)     */
+    BOOL8   udpGro;         /**< take datagrams coalesced by the kernel (UDP_GRO), read them with
+                                 vos_sockReceiveUDPSeg                                   */
 } VOS_SOCK_OPT_T;
 
 typedef fd_set VOS_FDS_T;
 
+/** Opaque poll set define (epoll/kqueue)  */
+typedef struct VOS_POLL *VOS_POLL_T;
+
+typedef struct VOS_XDP *VOS_XDP_T;
+
+/** Opaque io_uring define  */
+typedef struct VOS_URING *VOS_URING_T;
+
+/** Datagram descriptor for batched socket calls  */
+typedef struct
+{
+    UINT8   *pBuffer;       /**< pointer to data buffer                             */
+    UINT32  size;           /**< in: size of buffer, out: size of datagram          */
+    UINT32  srcIPAddr;      /**< source IP of received datagram                     */
+    UINT16  srcIPPort;      /**< source port of received datagram                   */
+    UINT32  dstIPAddr;      /**< destination IP of received or sent datagram        */
+    UINT16  dstIPPort;      /**< destination port of sent datagram                  */
+    VOS_TIMEVAL_T rxTime;   /**< reception time of received datagram                */
+    UINT8   qos;            /**< QoS 1...7 of sent datagram, 0: as set for socket   */
+} VOS_SOCK_MSG_T;
+
+/** Buffer segment for gathered socket calls  */
+typedef struct
+{
+    const UINT8 *pBuffer;   /**< pointer to data of the segment                     */
+    UINT32      size;       /**< size of the segment                                */
+} VOS_SOCK_SEG_T;
+
+/** Entry of a receive filter: datagrams with this key from a source in [srcIpLo, srcIpHi] pass  */
+typedef struct
+{
+    UINT32  key;            /**< value of the key field                             */
+    UINT32  srcIpLo;        /**< source IP, 0 for any source                        */
+    UINT32  srcIpHi;        /**< last source IP of a range, 0 for srcIpLo only      */
+} VOS_SOCK_FILTER_ENTRY_T;
+
+/** Receive filter of a UDP socket (vos_sockSetFilter), fields are read in network byte order  */
+typedef struct
+{
+    UINT16  typeOffset;     /**< payload offset of the 16 bit type field            */
+    UINT16  noOfTypes;      /**< no. of types in types[], other types always pass   */
+    UINT16  types[VOS_SOCK_FILTER_TYPES];   /**< datagram types the filter applies to */
+    UINT16  keyOffset;      /**< payload offset of the 32 bit key field             */
+    UINT32  noOfEntries;    /**< no. of entries in pEntries                         */
+    const VOS_SOCK_FILTER_ENTRY_T *pEntries;    /**< keys and sources to pass       */
+} VOS_SOCK_FILTER_T;
+
+/** Receive queue state of a socket (vos_sockGetRxQueue), sizes as accounted by the kernel  */
+typedef struct
+{
+    UINT32  drops;          /**< datagrams dropped on a full queue since opening, 0 if unknown */
+    UINT32  queued;         /**< bytes waiting in the receive queue                 */
+    UINT32  bufSize;        /**< size of the receive buffer                         */
+} VOS_SOCK_RXQ_T;
+
 typedef struct
 {
     CHAR8           name[VOS_MAX_IF_NAME_SIZE]; /**< interface adapter name         */
@@ -213,6 +290,18 @@ EXT_DECL UINT64 vos_htonll (
 EXT_DECL UINT64 vos_ntohll (
     UINT64 val);
 
+/*  Network order is host order on big endian hosts: the conversions become plain loads instead of calls.
+    The functions are still exported, vos_sock.c defines VOS_SOCK_BYTE_ORDER_FUNCTIONS to implement them. */
+#if (defined(B_ENDIAN) || (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__))) && \
+    !defined(L_ENDIAN) && !defined(VOS_SOCK_BYTE_ORDER_FUNCTIONS)
+#define vos_htons(val)      ((UINT16) (val))
+#define vos_ntohs(val)      ((UINT16) (val))
+#define vos_htonl(val)      ((UINT32) (val))
+#define vos_ntohl(val)      ((UINT32) (val))
+#define vos_htonll(val)     ((UINT64) (val))
+#define vos_ntohll(val)     ((UINT64) (val))
+#endif
+
 /**********************************************************************************************************************/
 /** Convert IP address from dotted dec. to !host! endianess
  *
@@ -297,6 +386,310 @@ EXT_DECL INT32 vos_select (
     VOS_FDS_T       *pErrorFD,
     VOS_TIMEVAL_T   *pTimeOut);
 
+/**********************************************************************************************************************/
+/** Create a poll set.
+ *  A poll set reports readable sockets without rescanning all registered descriptors. It is backed by epoll on Linux
+ *  and kqueue on macOS, QNX and BSD. Other targets return VOS_UNKNOWN_ERR, select() has to be used there.
+ *
+ *  @param[out]     pPoll           pointer to the handle of the poll set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    the poll set could not be created
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollCreate (
+    VOS_POLL_T *pPoll);
+
+/**********************************************************************************************************************/
+/** Add a socket to a poll set.
+ *  The tag is reported by vos_pollWait() when the socket becomes readable. Adding a socket again updates its tag.
+ *  A closed socket is removed from the poll set by the OS.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      tag             value to report for this socket
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    the socket could not be added
+ */
+
+EXT_DECL VOS_ERR_T vos_pollAdd (
+    VOS_POLL_T  poll,
+    SOCKET      sock,
+    UINT32      tag);
+
+/**********************************************************************************************************************/
+/** Remove a socket from a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    the socket was not part of the poll set
+ */
+
+EXT_DECL VOS_ERR_T vos_pollRemove (
+    VOS_POLL_T  poll,
+    SOCKET      sock);
+
+/**********************************************************************************************************************/
+/** Wait for readable sockets of a poll set.
+ *  Only the tags of the sockets ready to be read are returned.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pTags           array to receive the tags of the readable sockets
+ *  @param[in,out]  pNoOfTags       in: size of pTags, out: number of readable sockets
+ *  @param[in]      pTimeOut        pointer to time out value, NULL waits forever, zero time out does not block
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      waiting failed
+ */
+
+EXT_DECL VOS_ERR_T vos_pollWait (
+    VOS_POLL_T          poll,
+    UINT32              *pTags,
+    UINT32              *pNoOfTags,
+    const VOS_TIMEVAL_T *pTimeOut);
+
+/**********************************************************************************************************************/
+/** Get the descriptor of a poll set.
+ *  The descriptor becomes readable as soon as one of the sockets of the poll set is readable. It can be used in the
+ *  application's own select(), poll() or epoll loop.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pFd             pointer to the descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollGetFd (
+    VOS_POLL_T  poll,
+    SOCKET      *pFd);
+
+/**********************************************************************************************************************/
+/** Delete a poll set.
+ *  The sockets of the poll set are not closed.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDelete (
+    VOS_POLL_T poll);
+
+/**********************************************************************************************************************/
+/** Open an AF_XDP socket receiving the UDP frames for a port.
+ *  An XDP program attached to the interface redirects the IPv4/UDP frames for the port arriving on the receive queue
+ *  into frame buffers (UMEM) shared with the application; they bypass the network stack. Zero copy mode is used if
+ *  the driver supports it. Multicast groups still have to be joined by ordinary sockets.
+ *  Linux only (5.9 or later), needs the CAP_NET_ADMIN and CAP_BPF (or CAP_SYS_ADMIN) capabilities.
+ *
+ *  @param[out]     pXdp            pointer to the handle of the AF_XDP socket
+ *  @param[in]      pIfName         name of the interface
+ *  @param[in]      queueId         receive queue of the interface
+ *  @param[in]      port            UDP destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    socket, frame buffers or XDP program could not be set up
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpOpen (
+    VOS_XDP_T       *pXdp,
+    const CHAR8     *pIfName,
+    UINT32          queueId,
+    UINT16          port);
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams from an AF_XDP socket.
+ *  The headers are parsed in the shared frame buffers, only the UDP payload is copied into the buffers supplied by
+ *  pMsgs[]. IP and UDP checksums are not verified. The call does not block.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *  @param[in,out]  pMsgs           array of datagram descriptors (buffer and size in, size, addresses and
+ *                                  reception time out)
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_BLOCK_ERR   no data available
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpReceive (
+    VOS_XDP_T       xdp,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs);
+
+/**********************************************************************************************************************/
+/** Get the descriptor of an AF_XDP socket.
+ *  The descriptor becomes readable when frames were received, it can be used with select() or a poll set.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *  @param[out]     pFd             pointer to the descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpGetFd (
+    VOS_XDP_T   xdp,
+    SOCKET      *pFd);
+
+/**********************************************************************************************************************/
+/** Close an AF_XDP socket.
+ *  The XDP program is detached from the interface, the frame buffers are released.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpClose (
+    VOS_XDP_T xdp);
+
+/**********************************************************************************************************************/
+/** Open an io_uring for receiving and sending UDP datagrams.
+ *  Sockets added with vos_uringAddRecv() are read by multishot receive requests: the kernel keeps placing datagrams
+ *  into a ring of noOfBuffers buffers of bufSize bytes each, shared with the application, without a system call per
+ *  datagram. Sends are queued and submitted with one system call.
+ *  Linux only (6.0 or later), the stack has to be built with VOS_URING=1.
+ *
+ *  @param[out]     pRing           pointer to the handle of the ring
+ *  @param[in]      noOfBuffers     number of receive buffers, a power of 2
+ *  @param[in]      bufSize         size of a receive buffer, at least the largest datagram expected
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    the ring could not be set up
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringOpen (
+    VOS_URING_T *pRing,
+    UINT32      noOfBuffers,
+    UINT32      bufSize);
+
+/**********************************************************************************************************************/
+/** Start receiving from a UDP socket through an io_uring.
+ *  The socket should be non-blocking. Its datagrams are fetched with vos_uringReceive() from now on, the socket must
+ *  not be read otherwise. Before the socket is closed it has to be removed with vos_uringRemoveRecv().
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_QUEUE_FULL_ERR no room for the request
+ */
+
+EXT_DECL VOS_ERR_T vos_uringAddRecv (
+    VOS_URING_T ring,
+    SOCKET      sock);
+
+/**********************************************************************************************************************/
+/** Stop receiving from a UDP socket through an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_uringRemoveRecv (
+    VOS_URING_T ring,
+    SOCKET      sock);
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams from the sockets of an io_uring.
+ *  The completions are reaped from the shared completion queue, the payload is copied into the buffers supplied by
+ *  pMsgs[] and the ring buffers are handed back to the kernel. The receiving socket of a datagram is reported in
+ *  pSocks[]. The call does not block.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pSocks          array of maxMsgs receiving sockets, NULL if not needed
+ *  @param[in,out]  pMsgs           array of datagram descriptors (buffer and size in, size, addresses and
+ *                                  reception time out, see vos_sockReceiveUDPTime)
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_BLOCK_ERR   no data available
+ */
+
+EXT_DECL VOS_ERR_T vos_uringReceive (
+    VOS_URING_T     ring,
+    SOCKET          *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs);
+
+/**********************************************************************************************************************/
+/** Send several UDP datagrams, possibly on different sockets, with one call.
+ *  Entry i of pMsgs[] is sent on pSocks[i]. All datagrams are submitted with one system call, which returns when they
+ *  have been handed to the network stack. On return, the size of each entry holds the number of bytes sent, 0 if the
+ *  datagram could not be sent.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      pSocks          array of noMsgs sending sockets
+ *  @param[in,out]  pMsgs           array of datagram descriptors (size in: to send, out: bytes sent)
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ */
+
+EXT_DECL VOS_ERR_T vos_uringSend (
+    VOS_URING_T     ring,
+    const SOCKET    *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs);
+
+/**********************************************************************************************************************/
+/** Get the descriptor of an io_uring.
+ *  The descriptor becomes readable when receive completions are pending, it can be used with select() or a poll set.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pFd             pointer to the descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_uringGetFd (
+    VOS_URING_T ring,
+    SOCKET      *pFd);
+
+/**********************************************************************************************************************/
+/** Close an io_uring.
+ *  Pending requests are cancelled, the buffers are released. The sockets are not closed.
+ *
+ *  @param[in]      ring            handle of the ring
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_uringClose (
+    VOS_URING_T ring);
+
 /*    Sockets    */
 
 /**********************************************************************************************************************/
@@ -394,6 +787,95 @@ EXT_DECL VOS_ERR_T vos_sockSetOptions (
     SOCKET                   sock,
     const VOS_SOCK_OPT_T    *pOptions);
 
+/**********************************************************************************************************************/
+/** Install a receive filter in the kernel (Linux: classic BPF, SO_ATTACH_FILTER).
+ *  Datagrams of one of the filtered types pass only if their key field and source match an entry, all other
+ *  datagrams pass. An installed filter is replaced, pFilter == NULL removes it.
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      pFilter           filter to install, NULL to remove the filter
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid, filter too large
+ *  @retval         VOS_MEM_ERR       out of memory
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetFilter (
+    SOCKET                  sock,
+    const VOS_SOCK_FILTER_T *pFilter);
+
+/**********************************************************************************************************************/
+/** Steer the datagrams of a group of sockets bound to the same address and port (SO_REUSEPORT).
+ *  A datagram goes to the socket with the index key % noOfSocks, counted in the order the sockets were bound. All
+ *  sockets of the group must be bound before the first datagram arrives, none may be closed while the group is in use.
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor, any socket of the group
+ *  @param[in]      keyOffset         payload offset of the 32 bit key field (network byte order)
+ *  @param[in]      noOfSocks         number of sockets of the group
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetSteering (
+    SOCKET  sock,
+    UINT16  keyOffset,
+    UINT32  noOfSocks);
+
+/**********************************************************************************************************************/
+/** Cork or uncork a TCP socket.
+ *  While corked, the writes to the socket are held back and go out in full segments. Uncorking sends what is left
+ *  at once, also on a socket with TCP_NODELAY set.
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      cork              TRUE: hold back partial segments, FALSE: send pending data
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetCork (
+    SOCKET  sock,
+    BOOL8   cork);
+
+/**********************************************************************************************************************/
+/** Get the state of the receive queue of a socket.
+ *  On Linux the values are read with SO_MEMINFO, drops is the counter SO_RXQ_OVFL reports. Other targets report the
+ *  pending bytes and the buffer size only.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[out]     pQueue            receive queue state
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetRxQueue (
+    SOCKET          sock,
+    VOS_SOCK_RXQ_T  *pQueue);
+
+/**********************************************************************************************************************/
+/** Set the size of the receive buffer of a socket.
+ *  The size is given in the unit of VOS_SOCK_RXQ_T.bufSize. The system may limit the size (Linux: rmem_max), read
+ *  back the size set with vos_sockGetRxQueue().
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      size              receive buffer size
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_SOCK_ERR      size could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetRcvBuffer (
+    SOCKET  sock,
+    UINT32  size);
+
 /**********************************************************************************************************************/
 /** Join a multicast group.
  *  Note: Some target systems might not support this option.
@@ -432,6 +914,74 @@ EXT_DECL VOS_ERR_T vos_sockLeaveMC (
     UINT32  mcAddress,
     UINT32  ipAddress);
 
+/**********************************************************************************************************************/
+/** Join a multicast group for one source only (source specific multicast, IGMPv3).
+ *  The kernel drops datagrams to that group from other sources. Can be called repeatedly to add sources.
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to join
+ *  @param[in]      srcAddress        source to receive from
+ *  @param[in]      ipAddress         depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress);
+
+/**********************************************************************************************************************/
+/** Leave a source specific multicast membership.
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to leave
+ *  @param[in]      srcAddress        source joined with vos_sockJoinSourceMC
+ *  @param[in]      ipAddress         depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress);
+
+/**********************************************************************************************************************/
+/** Send UDP data at a given time.
+ *  Hand the datagram to the network stack with a launch time, the interface transmits it at that time (Linux:
+ *  SO_TXTIME with the ETF or taprio qdisc). The socket must have been opened with the txTime option.
+ *  On targets without launch time support, or if the launch time has passed, the datagram is sent immediately.
+ *
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      pBuffer            pointer to data to send
+ *  @param[in,out]  pSize              In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress          destination IP
+ *  @param[in]      port               destination port
+ *  @param[in]      pLaunchTime        transmit time (time base of vos_getTime), NULL to send immediately
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ *  @retval         VOS_IO_ERR         data could not be sent
+ *  @retval         VOS_BLOCK_ERR      Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPAt (
+    SOCKET              sock,
+    const UINT8         *pBuffer,
+    UINT32              *pSize,
+    UINT32              ipAddress,
+    UINT16              port,
+    const VOS_TIMEVAL_T *pLaunchTime);
+
 /**********************************************************************************************************************/
 /** Send UDP data.
  *  Send data to the given address and port.
@@ -455,6 +1005,56 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     UINT32      ipAddress,
     UINT16      port);
 
+/**********************************************************************************************************************/
+/** Send several UDP datagrams with one call.
+ *  Each entry of pMsgs[] describes one datagram (buffer, size, destination IP and port). On return, the size of each
+ *  entry holds the number of bytes sent, 0 if the datagram could not be sent. A datagram which cannot be sent does not
+ *  stop the remaining ones from being sent, unless the call would block.
+ *  On Linux sendmmsg() is used, on other targets vos_sockSendUDP() is called repeatedly.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (size in: to send, out: bytes sent)
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs);
+
+/**********************************************************************************************************************/
+/** Send consecutive UDP datagrams of equal size from one buffer.
+ *  The buffer holds datagrams of segSize bytes each, the last one may be shorter. All go to the same destination.
+ *  On Linux they are handed to the kernel with one call per VOS_MAX_UDP_SEGS datagrams (UDP_SEGMENT), which splits
+ *  them late or lets the NIC do it. A datagram must fit into one IP packet then, if the kernel refuses the segmented
+ *  send, or on other targets, the datagrams are sent one by one.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to the datagrams to send
+ *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      segSize         size of one datagram
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPSeg (
+    SOCKET      sock,
+    const UINT8 *pBuffer,
+    UINT32      *pSize,
+    UINT32      segSize,
+    UINT32      ipAddress,
+    UINT16      port);
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -488,6 +1088,95 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     UINT32  *pDstIPAddr,
     BOOL8   peek);
 
+/**********************************************************************************************************************/
+/** Receive UDP data with its reception time.
+ *  As vos_sockReceiveUDP(), additionally the time the datagram was received is reported. If the socket was opened
+ *  with the rxTime option, the kernel (software) or NIC (hardware) time stamp is taken (Linux: SO_TIMESTAMPING).
+ *  On targets without receive time stamps, or if none was delivered, the time of the call is reported.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[in]      peek            if true, leave data in queue
+ *  @param[out]     pRxTime         pointer to the reception time (time base of vos_getTime), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPTime (
+    SOCKET          sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    BOOL8           peek,
+    VOS_TIMEVAL_T   *pRxTime);
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams with one call.
+ *  Up to maxMsgs datagrams (at most VOS_MAX_SOCK_BATCH) are read into the buffers supplied by pMsgs[]. The call returns
+ *  as soon as at least one datagram was read and no more datagrams are pending.
+ *  On Linux recvmmsg() is used, on Windows overlapped receives whose completions are taken from an I/O completion
+ *  port in one call. On other targets vos_sockReceiveUDP() is called repeatedly; there, the socket should be
+ *  non-blocking if maxMsgs is greater than one.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (buffer and size in, size, addresses and
+ *                                  reception time out, see vos_sockReceiveUDPTime)
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received (or ICMP port unreachable)
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs);
+
+/**********************************************************************************************************************/
+/** Receive UDP datagrams the kernel may have coalesced.
+ *  On a socket opened with the udpGro option (Linux: UDP_GRO), the kernel delivers consecutive datagrams of one flow
+ *  and of equal size in one piece. They follow each other in the buffer, each segSize bytes long, the last one may be
+ *  shorter. The buffer should hold 64 KB. Otherwise, or on other targets, one datagram is read and *pSegSize is its size.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSegSize        pointer to the size of one datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPSeg (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pSegSize,
+    UINT32  *pSrcIPAddr,
+    UINT16  *pSrcIPPort,
+    UINT32  *pDstIPAddr);
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -583,6 +1272,28 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     const UINT8 *pBuffer,
     UINT32      *pSize);
 
+/**********************************************************************************************************************/
+/** Send TCP data gathered from several buffers.
+ *  The segments are sent in order as one byte stream, without copying them into one buffer first.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pSegs           array of buffer segments
+ *  @param[in]      noSegs          number of entries in pSegs (at most VOS_MAX_SOCK_SEGS)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked in blocking mode, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET                  sock,
+    const VOS_SOCK_SEG_T    *pSegs,
+    UINT32                  noSegs,
+    UINT32                  *pSize);
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -126,6 +126,9 @@ typedef enum
 /** Hidden mutex handle definition    */
 typedef struct VOS_MUTEX *VOS_MUTEX_T;
 
+/** Hidden read/write lock handle definition    */
+typedef struct VOS_RWLOCK *VOS_RWLOCK_T;
+
 /** Hidden semaphore handle definition    */
 typedef struct VOS_SEMA *VOS_SEMA_T;
 
@@ -193,9 +196,43 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     VOS_THREAD_FUNC_T       pFunction,
     void                    *pArguments);
 
+/**********************************************************************************************************************/
+/** Create a thread bound to a set of CPUs.
+ *  As vos_threadCreate(), the thread runs on the CPUs set in cpuMask only. With an interval, the thread function is
+ *  called by vos_cyclicThread() at absolute release times. The priority is limited to the range of the policy.
+ *
+ *  @param[out]     pThread           Pointer to returned thread handle
+ *  @param[in]      pName             Pointer to name of the thread (optional)
+ *  @param[in]      policy            Scheduling policy (FIFO, Round Robin or other)
+ *  @param[in]      priority          Scheduling priority (1...255 (highest), default 0)
+ *  @param[in]      interval          Interval for cyclic threads in us (optional)
+ *  @param[in]      stackSize         Minimum stacksize, default 0: 16kB
+ *  @param[in]      cpuMask           CPUs the thread may run on (bit 0: CPU 0), 0: all
+ *  @param[in]      pFunction         Pointer to the thread function
+ *  @param[in]      pArguments        Pointer to the thread function parameters
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_INIT_ERR      module not initialised
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR       out of memory
+ *  @retval         VOS_THREAD_ERR    thread creation error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadCreateAffine (
+    VOS_THREAD_T            *pThread,
+    const CHAR8             *pName,
+    VOS_THREAD_POLICY_T     policy,
+    VOS_THREAD_PRIORITY_T   priority,
+    UINT32                  interval,
+    UINT32                  stackSize,
+    UINT32                  cpuMask,
+    VOS_THREAD_FUNC_T       pFunction,
+    void                    *pArguments);
+
 /**********************************************************************************************************************/
 /** Cyclic thread functions.
  *  Wrapper for cyclic threads. The thread function will be called cyclically with interval.
+ *  The release times are absolute deadlines, missed releases are skipped and counted as overruns.
  *
  *  @param[in]      interval        Interval for cyclic threads in us (incl. runtime)
  *  @param[in]      pFunction       Pointer to the thread function
@@ -208,6 +245,23 @@ EXT_DECL void vos_cyclicThread (
     VOS_THREAD_FUNC_T   pFunction,
     void                *pArguments);
 
+/**********************************************************************************************************************/
+/** Get the statistics of a cyclic thread.
+ *
+ *  @param[in]      thread            Thread handle of a thread running vos_cyclicThread()
+ *  @param[out]     pCycles           Pointer to number of cycles run (optional)
+ *  @param[out]     pOverruns         Pointer to number of release times missed (optional)
+ *  @param[out]     pMaxRunTime       Pointer to max. time from release to end of a cycle in us (optional)
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     no cyclic thread with statistics
+ */
+
+EXT_DECL VOS_ERR_T vos_cyclicThreadStatistics (
+    VOS_THREAD_T    thread,
+    UINT32          *pCycles,
+    UINT32          *pOverruns,
+    UINT32          *pMaxRunTime);
+
 /**********************************************************************************************************************/
 /** Terminate a thread.
  *  This call will terminate the thread with the given threadId and release all resources. Depending on the
@@ -277,6 +331,23 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
 EXT_DECL void vos_getTime (
     VOS_TIMEVAL_T *pTime);
 
+/**********************************************************************************************************************/
+/** Select the time base of vos_getTime().
+ *  With a PTP hardware clock (e.g. "/dev/ptp0") kept in sync by a PTP daemon, vos_getTime() returns the common time
+ *  of the train: send slots and latencies become comparable between devices. The clock may step while the daemon
+ *  synchronises, it should be settled before the stack is started.
+ *  All times taken before are invalid afterwards, call it before tlc_openSession() or any other use of the stack.
+ *  Cyclic threads keep their period on the local monotonic clock.
+ *
+ *  @param[in]      pPtpDevice      PTP clock device, NULL for the local monotonic clock (default)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    device cannot be opened or read, or not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_setTimeBase (
+    const CHAR8 *pPtpDevice);
+
 
 /**********************************************************************************************************************/
 /** Get a time-stamp string.
@@ -446,6 +517,68 @@ EXT_DECL VOS_ERR_T vos_mutexTryLock (
 EXT_DECL VOS_ERR_T vos_mutexUnlock (
     VOS_MUTEX_T pMutex);
 
+/**********************************************************************************************************************/
+/** Create a read/write lock.
+ *  Any number of readers or one writer hold the lock. The lock is not recursive, readers are preferred.
+ *
+ *  @param[out]     pLock             Pointer to read/write lock handle
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     pLock == NULL
+ *  @retval         VOS_MEM_ERR       out of memory
+ *  @retval         VOS_MUTEX_ERR     no lock available
+ */
+
+EXT_DECL VOS_ERR_T vos_rwlockCreate (
+    VOS_RWLOCK_T *pLock);
+
+/**********************************************************************************************************************/
+/** Delete a read/write lock.
+ *  Release the resources taken by the lock.
+ *
+ *  @param[in]      lock              Read/write lock handle
+ */
+
+EXT_DECL void vos_rwlockDelete (
+    VOS_RWLOCK_T lock);
+
+/**********************************************************************************************************************/
+/** Take a read/write lock for reading.
+ *  Wait until no writer holds the lock.
+ *
+ *  @param[in]      lock              Read/write lock handle
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     lock == NULL or wrong type
+ *  @retval         VOS_MUTEX_ERR     lock could not be taken
+ */
+
+EXT_DECL VOS_ERR_T vos_rwlockRead (
+    VOS_RWLOCK_T lock);
+
+/**********************************************************************************************************************/
+/** Take a read/write lock for writing.
+ *  Wait until neither a reader nor a writer holds the lock.
+ *
+ *  @param[in]      lock              Read/write lock handle
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     lock == NULL or wrong type
+ *  @retval         VOS_MUTEX_ERR     lock could not be taken
+ */
+
+EXT_DECL VOS_ERR_T vos_rwlockWrite (
+    VOS_RWLOCK_T lock);
+
+/**********************************************************************************************************************/
+/** Release a read/write lock taken for reading or writing.
+ *
+ *  @param[in]      lock              Read/write lock handle
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     lock == NULL or wrong type
+ *  @retval         VOS_MUTEX_ERR     lock was not taken
+ */
+
+EXT_DECL VOS_ERR_T vos_rwlockUnlock (
+    VOS_RWLOCK_T lock);
+
 /**********************************************************************************************************************/
 /** Create a semaphore.
  *  Return a semaphore handle. Depending on the initial state the semaphore will be available on creation or not.
@@ -491,6 +624,23 @@ EXT_DECL VOS_ERR_T vos_semaTake (
     VOS_SEMA_T  sema,
     UINT32      timeout);
 
+/**********************************************************************************************************************/
+/** Take a semaphore until a deadline.
+ *  The deadline is a time returned by vos_getTime() (monotonic clock), it is not shifted by steps of the system time
+ *  (NTP, PTP). Loops waiting repeatedly keep their period by advancing the deadline instead of the timeout.
+ *
+ *  @param[in]      sema            semaphore handle
+ *  @param[in]      pDeadline       Latest time to take the semaphore, a past deadline means no wait
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_SEMA_ERR    could not get semaphore in time
+ */
+
+EXT_DECL VOS_ERR_T vos_semaTakeUntil (
+    VOS_SEMA_T          sema,
+    const VOS_TIMEVAL_T *pDeadline);
+
 
 /**********************************************************************************************************************/
 /** Give a semaphore.
@@ -50,6 +50,45 @@ extern void *gRefCon;
 #define VOS_MAX_FRMT_SIZE       64u          /**< Max. size of the 'format' part */
 #define VOS_MAX_ERR_STR_SIZE    (VOS_MAX_PRNT_STR_SIZE - VOS_MAX_FRMT_SIZE) /**< Max. size of the error part */
 
+/** Deferred logging: vos_printLog() stores the format arguments in a lock-free ring, a background thread formats
+    them and calls the debug output function. Repeated errors and warnings of a call site are rate limited. */
+#ifndef VOS_LOG_DEFERRED
+#define VOS_LOG_DEFERRED        0
+#endif
+
+#if VOS_LOG_DEFERRED
+#ifndef __GNUC__
+#error "VOS_LOG_DEFERRED needs the GCC atomic built-ins"
+#endif
+#ifndef VOS_LOG_RING_SIZE
+#define VOS_LOG_RING_SIZE       256u        /**< log records in the ring, power of 2                */
+#endif
+#ifndef VOS_LOG_MAX_ARGS
+#define VOS_LOG_MAX_ARGS        8u          /**< format arguments kept per record                   */
+#endif
+#ifndef VOS_LOG_STR_SIZE
+#define VOS_LOG_STR_SIZE        160u        /**< space per record for copies of string arguments    */
+#endif
+#ifndef VOS_LOG_FLUSH_INTERVAL
+#define VOS_LOG_FLUSH_INTERVAL  10000u      /**< polling interval of the log thread in us           */
+#endif
+#ifndef VOS_LOG_RATE_BURST
+#define VOS_LOG_RATE_BURST      10u         /**< errors/warnings of one call site per period        */
+#endif
+#ifndef VOS_LOG_RATE_PERIOD
+#define VOS_LOG_RATE_PERIOD     1u          /**< rate limiting period in s                          */
+#endif
+#endif
+
+/** Highest log level compiled in, messages of higher levels (less important) are removed together with their
+    format strings, e.g. VOS_LOG_ERROR keeps the errors only */
+#ifndef VOS_LOG_MAX_LEVEL
+#define VOS_LOG_MAX_LEVEL       VOS_LOG_USR
+#endif
+
+/** Condition of the debug output macros, constant for the levels above VOS_LOG_MAX_LEVEL */
+#define VOS_LOG_ON(level)       (((level) <= VOS_LOG_MAX_LEVEL) && (gPDebugFunction != NULL))
+
 /** This is a helper define for separating a path in debug output */
 #ifdef WIN32
 #define VOS_DIR_SEP     '\\'
@@ -69,8 +108,27 @@ extern void *gRefCon;
     snprintf(str, size, format, ## args)    /*lint !e586 logging output needed */
 #endif
 
+#if VOS_LOG_DEFERRED
+
+/** Debug output macros, the call site is the format id of the log records */
+#define vos_printLogStr(level, string)                                                     \
+    {if (VOS_LOG_ON(level))                                                                \
+     {   static VOS_LOG_SITE_T vosLogSite = {"%s", (__FILE__), (UINT16)(__LINE__), 0u, 0u, 0u}; \
+         vos_logDeferred(&vosLogSite, (level), (string));                                  \
+     }                                                                                     \
+    }
+
+#define vos_printLog(level, format, args ...)                                              \
+    {if (VOS_LOG_ON(level))                                                                \
+     {   static VOS_LOG_SITE_T vosLogSite = {(format), (__FILE__), (UINT16)(__LINE__), 0u, 0u, 0u}; \
+         vos_logDeferred(&vosLogSite, (level), ## args);                                   \
+     }                                                                                     \
+    }
+
+#else
+
 /** Debug output macro without formatting options */
-#define vos_printLogStr(level, string)  {if (gPDebugFunction != NULL)         \
+#define vos_printLogStr(level, string)  {if (VOS_LOG_ON(level))               \
                                          {gPDebugFunction(gRefCon,            \
                                                           (level),            \
                                                           vos_getTimeStamp(), \
@@ -81,7 +139,7 @@ extern void *gRefCon;
 /** Debug output macro with formatting options */
 #ifdef WIN32
     #define vos_printLog(level, format, ...)                                   \
-    {if (gPDebugFunction != NULL)                                              \
+    {if (VOS_LOG_ON(level))                                                    \
      {   char str[VOS_MAX_PRNT_STR_SIZE];                                      \
          (void) _snprintf_s(str, sizeof(str), _TRUNCATE, format, __VA_ARGS__); \
          vos_printLogStr(level, str);                                          \
@@ -89,7 +147,7 @@ extern void *gRefCon;
     }
 #elif defined(__clang__)
     #define vos_printLog(level, format, ...)                    \
-    {if (gPDebugFunction != NULL)                               \
+    {if (VOS_LOG_ON(level))                                     \
      {   char str[VOS_MAX_PRNT_STR_SIZE];                       \
          (void)snprintf(str, sizeof(str), format, __VA_ARGS__); \
          vos_printLogStr(level, str);                           \
@@ -97,7 +155,7 @@ extern void *gRefCon;
     }
 #else
     #define vos_printLog(level, format, args ...)            \
-    {if (gPDebugFunction != NULL)                            \
+    {if (VOS_LOG_ON(level))                                  \
      {   char str[VOS_MAX_PRNT_STR_SIZE];                    \
          (void) snprintf(str, sizeof(str), format, ## args); \
          vos_printLogStr(level, str);                        \
@@ -105,6 +163,8 @@ extern void *gRefCon;
     }
 #endif
 
+#endif /* VOS_LOG_DEFERRED */
+
 
 /** Alignment macros  */
 #ifdef WIN32
@@ -157,6 +217,27 @@ extern void *gRefCon;
  * TYPEDEFS
  */
 
+/** CRC implementations  */
+typedef enum
+{
+    VOS_CRC_BYTEWISE    = 0,    /**< byte-by-byte table lookup (reference)          */
+    VOS_CRC_SLICE8      = 1,    /**< slice-by-8 table lookup                        */
+    VOS_CRC_HW          = 2     /**< CRC instructions (ARMv8 CRC32/PMULL, x86 PCLMULQDQ) */
+} VOS_CRC_IMPL_T;
+
+#if VOS_LOG_DEFERRED
+/** Call site of vos_printLog(), identifies the format of its log records */
+typedef struct
+{
+    const CHAR8 *pFormat;           /**< format string                                  */
+    const CHAR8 *pFile;             /**< source file                                    */
+    UINT16      line;               /**< source line                                    */
+    UINT32      period;             /**< current rate limiting period                   */
+    UINT32      count;              /**< messages in the current period                 */
+    UINT32      suppressed;         /**< messages suppressed and not reported yet       */
+} VOS_LOG_SITE_T;
+#endif
+
 /***********************************************************************************************************************
  * PROTOTYPES
  */
@@ -176,6 +257,26 @@ EXT_DECL UINT32 vos_crc32 (
     const UINT8 *pData,
     UINT32      dataLen);
 
+/**********************************************************************************************************************/
+/** Calculate the CRC of several buffers of the same length at once.
+ *  pCrc[i] is the same as vos_crc32(crc, ppData[i], dataLen). With VOS_CRC_HW the buffers are processed in SIMD lanes
+ *  (16 with AVX-512, 8 with AVX2) or interleaved (ARMv8 CRC32), which is faster than one call per buffer for short
+ *  buffers like frame headers.
+ *
+ *  @param[in]          crc             Initial value.
+ *  @param[in]          ppData          Pointers to the buffers.
+ *  @param[in]          dataLen         length in bytes of each buffer.
+ *  @param[in]          noOfBufs        number of buffers.
+ *  @param[out]         pCrc            crc32 according to IEEE802.3 of each buffer.
+ */
+
+EXT_DECL void vos_crc32Multi (
+    UINT32              crc,
+    const UINT8 *const  ppData[],
+    UINT32              dataLen,
+    UINT32              noOfBufs,
+    UINT32              pCrc[]);
+
 /**********************************************************************************************************************/
 /** Compute crc32 according to IEC 61375-2-3 B.7
  *  Note: Returned CRC is inverted
@@ -191,6 +292,18 @@ EXT_DECL UINT32 vos_sc32 (
     const UINT8 *pData,
     UINT32      dataLen);
 
+/**********************************************************************************************************************/
+/** Select the CRC implementation used by vos_crc32() and vos_sc32().
+ *  vos_init() selects the fastest implementation available on the target.
+ *
+ *  @param[in]          impl            implementation to use
+ *  @retval             VOS_NO_ERR      no error
+ *  @retval             VOS_PARAM_ERR   implementation not available on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_crcSelect (
+    VOS_CRC_IMPL_T impl);
+
 /**********************************************************************************************************************/
 /** Initialize the vos library.
  *  This is used to set the output function for all VOS error and debug output.
@@ -240,6 +353,30 @@ EXT_DECL const VOS_VERSION_T *vos_getVersion (void);
 
 EXT_DECL const CHAR8 *vos_getErrorString (VOS_ERR_T error);
 
+#if VOS_LOG_DEFERRED
+/**********************************************************************************************************************/
+/** Store a log record for the background thread.
+ *  Called by vos_printLog(). Integer, floating point and pointer arguments are stored as they are, strings are
+ *  copied. Without running log thread the message is formatted and output at once.
+ *
+ *  @param[in,out]      pSite           call site
+ *  @param[in]          level           log category
+ *  @param[in]          ...             arguments of the format
+ */
+
+EXT_DECL void vos_logDeferred (
+    VOS_LOG_SITE_T  *pSite,
+    VOS_LOG_T       level,
+    ...);
+#endif
+
+/**********************************************************************************************************************/
+/** Wait until all deferred log records have been output.
+ *  Returns at once without deferred logging.
+ */
+
+EXT_DECL void vos_logFlush (void);
+
 
 
 #ifdef __cplusplus
@@ -57,6 +57,13 @@
 #include <pthread.h>
 #endif
 
+#if defined(__linux__) && defined(__GNUC__)
+#include <time.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <linux/futex.h>
+#endif
+
 #ifndef PTHREAD_MUTEX_INITIALIZER
 #define PTHREAD_MUTEX_INITIALIZER  0 /* Dummy */
 #endif
@@ -67,10 +74,35 @@
 #include "vos_thread.h"
 #include "vos_private.h"
 
+#if VOS_MEM_CHECK_OPERATIONAL > 1
+#include <assert.h>
+#endif
+
+#ifndef VOS_MUTEX_INITIALIZER
+#define VOS_MUTEX_INITIALIZER  {0, PTHREAD_MUTEX_INITIALIZER}
+#endif
+
 /***********************************************************************************************************************
  * DEFINITIONS
  */
 
+#if VOS_MEM_THREAD_CACHE && defined(POSIX) && defined(__GNUC__)
+#define VOS_MEM_CACHE  1
+#endif
+
+#if defined(__linux__) && defined(__GNUC__)
+#if VOS_MEM_NUMA_LOCAL && defined(SYS_mbind) && defined(SYS_getcpu)
+#define VOS_MEM_NUMA        1
+#define MEM_MPOL_PREFERRED  1           /* MPOL_PREFERRED of linux/mempolicy.h */
+#endif
+#if VOS_MEM_NUMA || VOS_MEM_HUGE_PAGES || VOS_MEM_LOCK
+#define VOS_MEM_MAP         1           /* the memory area is mapped by memAreaMap */
+#endif
+#endif
+
+#define MEM_HUGE_PAGE_SIZE  0x200000u   /* default huge page size of x86-64 and arm64 */
+#define MEM_ALIGNED_MARK    0xA11A11EDu /* size of the header in front of a vos_memAllocAligned() block */
+
 typedef struct memBlock
 {
     UINT32          size;           /* Size of the data part of the block */
@@ -99,6 +131,7 @@ typedef struct
     UINT32              allocSize;      /* Size of allocated area */
     UINT32              noOfBlocks;     /* No of blocks */
     BOOL8               wasMalloced;    /* needs to be freed in the end */
+    BOOL8               wasMapped;      /* allocated by memAreaMap, needs to be unmapped in the end */
 
     /* Free block header array, one entry for each possible free block size */
     struct
@@ -107,8 +140,50 @@ typedef struct
         MEM_BLOCK_T *pFirst;            /* Pointer to first free block */
     } freeBlock[VOS_MEM_NBLOCKSIZES];
     MEM_STATISTIC_T memCnt;             /* Statistic counters */
+    UINT8           firstBlock[33];     /* First block size index per bit length of (size - 1) */
 } MEM_CONTROL_T;
 
+#if VOS_MEM_CACHE
+/** Per thread cache of free blocks, one magazine per block size */
+typedef struct
+{
+    UINT32      generation;                                     /* gMemGeneration the blocks belong to */
+    BOOL8       registered;                                     /* thread exit handler installed */
+    UINT32      count[VOS_MEM_NBLOCKSIZES];                     /* No of cached blocks per block size */
+    MEM_BLOCK_T *pBlock[VOS_MEM_NBLOCKSIZES][VOS_MEM_CACHE_DEPTH];
+} MEM_CACHE_T;
+#endif
+
+#ifdef __GNUC__
+/* Statistics are updated outside the memory semaphore */
+#define MEM_CNT_ATOMIC         1
+#define MEM_CNT_ADD(cnt, val)  (void) __atomic_add_fetch(&(cnt), (val), __ATOMIC_RELAXED)
+#define MEM_CNT_SUB(cnt, val)  __atomic_sub_fetch(&(cnt), (val), __ATOMIC_RELAXED)
+#else
+#define MEM_CNT_ADD(cnt, val)  (void) ((cnt) += (val))
+#define MEM_CNT_SUB(cnt, val)  ((cnt) -= (val))
+#endif
+
+#if VOS_MEM_PROFILE && defined(__GNUC__)
+#define MEM_CALLER()    __builtin_return_address(0)
+#else
+#define MEM_CALLER()    NULL
+#endif
+
+#if VOS_MEM_PROFILE
+#define MEM_SITE_NONE   VOS_MEM_PROFILE_SITES   /* allocation counted per block size only */
+
+/* Profile of the memory area. The pNext of an allocated block holds the index of its call site + 1, 0 if the block
+   is not profiled */
+typedef struct
+{
+    struct VOS_MUTEX    mutex;          /* protects the profile */
+    BOOL8               valid;          /* profiling, mutex created */
+    VOS_TIMEVAL_T       start;          /* time of vos_memInit or vos_memProfileReset */
+    VOS_MEM_PROFILE_T   profile;
+} MEM_PROFILE_CONTROL_T;
+#endif
+
 typedef struct
 {
     UINT32  queueAllocated;      /* No of allocated queues */
@@ -139,18 +214,58 @@ struct VOS_QUEUE_ELEM
     UINT32  size;
 };
 
+#ifdef __GNUC__
+#define VOS_RING_SUPPORTED  1
+#ifdef __linux__
+#define VOS_RING_FUTEX      1       /* block the receiver on a futex instead of a semaphore */
+#endif
+#endif
+
+#define VOS_RING_PAD        64u     /* keep producer and consumer indices in different cache lines */
+#define VOS_RING_SPIN       2000u   /* polls of an empty ring queue before the receiver blocks */
+
+/* Slot header of a ring queue, the message data follows */
+typedef struct
+{
+    UINT32  seq;                    /* sequence number, tells whether the slot is free or filled */
+    UINT32  size;                   /* size of the message */
+} RING_SLOT_T;
+
+/* Ring queue header struct */
+struct VOS_RING
+{
+    UINT32          magicNumber;
+    VOS_RING_TYPE_T type;
+    UINT32          mask;           /* No of slots - 1 */
+    UINT32          slotSize;       /* Slot header and data, multiple of 8 */
+    UINT32          maxMsgSize;
+    UINT32          spin;           /* polls before blocking, 0 on single processor systems */
+    UINT8           *pSlots;
+#ifndef VOS_RING_FUTEX
+    VOS_SEMA_T      semaphore;      /* wakes up the waiting receiver */
+#endif
+    UINT8           pad1[VOS_RING_PAD];
+    UINT32          head;           /* next slot to write */
+    UINT8           pad2[VOS_RING_PAD];
+    UINT32          tail;           /* next slot to read */
+    UINT32          waiting;        /* receiver is about to block */
+    UINT32          event;          /* futex word, incremented for each wake up */
+    UINT8           pad3[VOS_RING_PAD];
+};
+
 /* Forward declaration, Mutex size is target dependent! */
 VOS_ERR_T       vos_mutexLocalCreate (struct VOS_MUTEX *pMutex);
 void            vos_mutexLocalDelete (struct VOS_MUTEX *pMutex);
 
 const UINT32    cQueueMagic = 0xE5E1E5E1;
+const UINT32    cRingMagic  = 0xE5E1A5A1;
 /***********************************************************************************************************************
  *  LOCALS
  */
 
 static MEM_CONTROL_T gMem =
 {
-    {0, PTHREAD_MUTEX_INITIALIZER}, NULL, NULL, 0L, 0L, 0L, FALSE,
+    VOS_MUTEX_INITIALIZER, NULL, NULL, 0L, 0L, 0L, FALSE, FALSE,
     {
         {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL},
         {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}
@@ -158,253 +273,918 @@ static MEM_CONTROL_T gMem =
     {0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, VOS_MEM_PREALLOCATE}
 };
 
-/***********************************************************************************************************************
- * GLOBAL FUNCTIONS
- */
+#if defined(ESP32) && VOS_ESP_STATIC
+/* Memory area used if the application passes none: internal RAM, no heap */
+static UINT8 gMemStaticArea[VOS_ESP_MEM_SIZE] __attribute__ ((aligned(8)));
+#endif
 
+/* Set by vos_memSetOperational, allocations while set are counted */
+static BOOL8            gMemOperational = FALSE;
+static UINT32           gMemOperationalAllocs = 0u;
 
-/**********************************************************************************************************************/
-/*    Memory                                                                                                          */
-/**********************************************************************************************************************/
+#if VOS_MEM_PROFILE
+static MEM_PROFILE_CONTROL_T gMemProfile;
+#endif
+
+#if VOS_MEM_CACHE
+/* Incremented on vos_memInit / vos_memDelete, invalidates the blocks cached by the threads */
+static UINT32           gMemGeneration = 0u;
+
+static __thread MEM_CACHE_T sMemCache;
+static pthread_key_t    sMemCacheKey;
+static pthread_once_t   sMemCacheOnce = PTHREAD_ONCE_INIT;
+#endif
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
 
 /**********************************************************************************************************************/
-/** Initialize the memory unit.
- *  Init a supplied block of memory and prepare it for use with vos_memAlloc and vos_memFree. The used block sizes can
- *  be supplied and will be preallocated.
- *  If half of the overall size of the requested memory area would be pre-allocated, either by the default
- *  pre-allocation table or a provided one, no pre-allocation takes place.
+/** Update the statistics for an allocated block.
  *
- *  @param[in]      pMemoryArea        Pointer to memory area to use
- *  @param[in]      size               Size of provided memory area
- *  @param[in]      fragMem            Pointer to list of preallocated block sizes, used to fragment memory for large blocks
- *  @retval         VOS_NO_ERR         no error
- *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
- *  @retval         VOS_MEM_ERR        no memory available
- *  @retval         VOS_MUTEX_ERR      no mutex available
+ *  @param[in]      blockSize       Size of the data part of the block
  */
 
-EXT_DECL VOS_ERR_T vos_memInit (
-    UINT8           *pMemoryArea,
-    UINT32          size,
-    const UINT32    fragMem[VOS_MEM_NBLOCKSIZES])
+static INLINE void memCountAlloc (
+    UINT32 blockSize)
 {
-    UINT32  i, j, max;
-    UINT32  minSize = 0;
-    UINT32  blockSize[VOS_MEM_NBLOCKSIZES] = VOS_MEM_BLOCKSIZES;        /* Different block sizes */
-    UINT8   *p[VOS_MEM_MAX_PREALLOCATE];
+    UINT32 freeSize = MEM_CNT_SUB(gMem.memCnt.freeSize, blockSize + sizeof(MEM_BLOCK_T));
 
-    /* Initialize memory */
-    gMem.memSize = size;
-    gMem.allocSize = 0;
-    gMem.noOfBlocks         = 0;
-    gMem.memCnt.freeSize    = size;
-    gMem.memCnt.minFreeSize = size;
-    gMem.memCnt.allocCnt    = 0;
-    gMem.memCnt.allocErrCnt = 0;
-    gMem.memCnt.freeErrCnt  = 0;
+#if MEM_CNT_ATOMIC
+    UINT32 minFree = __atomic_load_n(&gMem.memCnt.minFreeSize, __ATOMIC_RELAXED);
 
-    /*  Create the memory mutex   */
-    if (vos_mutexLocalCreate(&gMem.mutex) != VOS_NO_ERR)
+    while ((freeSize < minFree) &&
+           !__atomic_compare_exchange_n(&gMem.memCnt.minFreeSize, &minFree, freeSize, FALSE,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
     {
-        vos_printLogStr(VOS_LOG_ERROR, "vos_memInit Mutex creation failed\n");
-        return VOS_MUTEX_ERR;
+        ;
     }
-
-    for (i = 0; i < VOS_MEM_MAX_PREALLOCATE; i++)
+#else
+    if (freeSize < gMem.memCnt.minFreeSize)
     {
-        p[i] = NULL;
+        gMem.memCnt.minFreeSize = freeSize;
     }
+#endif
+    MEM_CNT_ADD(gMem.memCnt.allocCnt, 1u);
+}
 
-    /*  Check if we should prealloc some memory */
-    if (fragMem != NULL)
-    {
-        for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
-        {
-            if (fragMem[i] != 0)
-            {
-                break;
-            }
-        }
+/**********************************************************************************************************************/
+/** Update the statistics for a returned block.
+ *
+ *  @param[in]      blockSize       Size of the data part of the block
+ */
 
-        if (i < (UINT32) VOS_MEM_NBLOCKSIZES)
-        {
-            for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
-            {
-                gMem.memCnt.preAlloc[i] = fragMem[i];
-                minSize += gMem.memCnt.preAlloc[i] * blockSize[i];
-            }
-        }
-    }
+static INLINE void memCountFree (
+    UINT32 blockSize)
+{
+    MEM_CNT_ADD(gMem.memCnt.freeSize, blockSize + sizeof(MEM_BLOCK_T));
+    (void) MEM_CNT_SUB(gMem.memCnt.allocCnt, 1u);
+}
 
-    if (pMemoryArea == NULL && size == 0)           /* This means we will use standard malloc calls    */
-    {
-        gMem.noOfBlocks = 0;
-        gMem.memSize    = 0;
-        gMem.pArea      = NULL;
-        return VOS_NO_ERR;
-    }
+/**********************************************************************************************************************/
+/** Count (and report) an allocation in the operational phase.
+ *
+ *  @param[in]      size            Requested size
+ */
 
-    if (size != 0)
+static INLINE void memCheckOperational (
+    UINT32 size)
+{
+    if (gMemOperational)
     {
-        if (pMemoryArea == NULL)                    /* We must allocate memory from the heap once   */
-        {
-            gMem.pArea = (UINT8 *) malloc(size);    /*lint !e421 !e586 optional use of heap memory for debugging/development
-                                                      */
-            if (gMem.pArea == NULL)
-            {
-                return VOS_MEM_ERR;
-            }
-            gMem.wasMalloced = TRUE;
-        }
-        else                                        /* Use the memory provided from calling application */
-        {
-            gMem.pArea = pMemoryArea;
-        }
+        MEM_CNT_ADD(gMemOperationalAllocs, 1u);
+#if VOS_MEM_CHECK_OPERATIONAL > 0
+        vos_printLog(VOS_LOG_ERROR, "vos_memAlloc(%u) while operational\n", size);
+#endif
+#if VOS_MEM_CHECK_OPERATIONAL > 1
+        assert(!gMemOperational);
+#endif
     }
-    else
+    (void) size;
+}
+
+/**********************************************************************************************************************/
+/** Number of significant bits of a value, 0 for 0.
+ *
+ *  @param[in]      value           Value
+ *
+ *  @retval         0..32
+ */
+
+static INLINE UINT32 memBitLength (
+    UINT32 value)
+{
+#ifdef __GNUC__
+    return (value == 0u) ? 0u : 32u - (UINT32) __builtin_clz(value);
+#else
+    UINT32 bits = 0u;
+
+    while (value != 0u)
     {
-        return VOS_PARAM_ERR;
+        value >>= 1;
+        bits++;
     }
+    return bits;
+#endif
+}
 
-    /*  Can we pre-allocate the memory? If more than half of the memory would be occupied, we don't even try...  */
-    if (minSize > size / 2)
+/**********************************************************************************************************************/
+/** Index of the smallest block size a size fits into.
+ *  The sizes with the same bit length share a start index, only the block sizes of that power of two range are
+ *  compared.
+ *
+ *  @param[in]      size            Size, not 0
+ *
+ *  @retval         Index of the block size, gMem.noOfBlocks if too large
+ */
+
+static INLINE UINT32 memBlockIndex (
+    UINT32 size)
+{
+    UINT32 i = gMem.firstBlock[memBitLength(size - 1u)];
+
+    while ((i < gMem.noOfBlocks) && (size > gMem.freeBlock[i].size))
     {
-        for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
-        {
-            gMem.memCnt.preAlloc[i] = 0;
-        }
-        vos_printLogStr(VOS_LOG_INFO, "vos_memInit() Pre-Allocation disabled\n");
+        i++;
     }
+    return i;
+}
 
-    minSize = 0;
+/**********************************************************************************************************************/
+/** Set the block sizes and the start indices of memBlockIndex().
+ *
+ *  @param[in]      blockSize       Ascending block sizes, a 0 ends the table
+ */
 
-    gMem.pFreeArea  = gMem.pArea;
-    gMem.noOfBlocks = (UINT32) VOS_MEM_NBLOCKSIZES;
-    gMem.memSize    = size;
+static void memSetBlockSizes (
+    const UINT32 blockSize[VOS_MEM_NBLOCKSIZES])
+{
+    UINT32 i, bits;
 
-    /* Initialize free block headers */
+    gMem.noOfBlocks = 0u;
     for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
     {
         gMem.freeBlock[i].pFirst    = (MEM_BLOCK_T *)NULL;
         gMem.freeBlock[i].size      = blockSize[i];
-        max     = gMem.memCnt.preAlloc[i];
-        minSize += blockSize[i];
-
-        if (max > VOS_MEM_MAX_PREALLOCATE)
+        if (blockSize[i] != 0u)
         {
-            max = VOS_MEM_MAX_PREALLOCATE;
+            gMem.noOfBlocks++;
         }
+    }
 
-        for (j = 0; j < max; j++)
-        {
-            p[j] = vos_memAlloc(blockSize[i]);
-            if (p[j] == NULL)
-            {
-                vos_printLog(VOS_LOG_ERROR,
-                             "vos_memInit() Pre-Allocation size exceeds overall memory size!!! (%u > %u)\n",
-                             minSize,
-                             size);
-                break;
-            }
-        }
+    /* Sizes of bit length n - 1 are 2^(n - 1) + 1 ... 2^n */
+    for (bits = 0u, i = 0u; bits < sizeof(gMem.firstBlock); bits++)
+    {
+        UINT32 minSize = (bits == 0u) ? 1u : (1u << (bits - 1u)) + 1u;
 
-        for (j = 0; j < max; j++)
+        while ((i < gMem.noOfBlocks) && (gMem.freeBlock[i].size < minSize))
         {
-            if (p[j])
-            {
-                vos_memFree(p[j]);
-            }
+            i++;
         }
+        gMem.firstBlock[bits] = (UINT8) i;
     }
-
-    return VOS_NO_ERR;
 }
 
+#if VOS_MEM_PROFILE
 /**********************************************************************************************************************/
-/** Delete the memory area.
- *    This will eventually invalidate any previously allocated memory blocks! It should be called last before the
- *  application quits. No further access to the memory blocks is allowed after this call.
- *
- *  @param[in]      pMemoryArea        Pointer to memory area used
+/** Start the profile of a new memory area, no block is in use.
  */
 
-EXT_DECL void vos_memDelete (
-    UINT8 *pMemoryArea)
+static void memProfileStart (void)
 {
-    if (pMemoryArea != NULL && pMemoryArea != gMem.pArea)
+    UINT32 i;
+
+    if (!gMemProfile.valid && (vos_mutexLocalCreate(&gMemProfile.mutex) != VOS_NO_ERR))
     {
-        vos_printLogStr(VOS_LOG_ERROR, "vos_memDelete() ERROR wrong pointer/parameter\n");
+        vos_printLogStr(VOS_LOG_ERROR, "vos_memInit profile mutex creation failed\n");
+        return;
     }
-
-    /* we will nevertheless clear the memory area because it makes no sence to report to the application... */
-    vos_mutexLocalDelete(&gMem.mutex);
-    if (gMem.wasMalloced && gMem.pArea != NULL)
+    memset(&gMemProfile.profile, 0, sizeof(gMemProfile.profile));
+    for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
     {
-        free(gMem.pArea);    /*lint !e421 !e586 optional use of heap memory for debugging/development */
+        gMemProfile.profile.sizeClass[i].blockSize = gMem.freeBlock[i].size;
     }
-    memset(&gMem, 0, sizeof(gMem));
+    vos_getTime(&gMemProfile.start);
+    gMemProfile.valid = TRUE;
 }
 
 /**********************************************************************************************************************/
-/** Allocate a block of memory (from memory area above).
- *
- *  @param[in]      size            Size of requested block
+/** Profile an allocated block.
  *
- *  @retval         Pointer to memory area
- *  @retval         NULL if no memory available
+ *  @param[in]      pBlock          Block taken
+ *  @param[in]      blockSize       Size of the data part of the block
+ *  @param[in]      size            Requested size
+ *  @param[in]      pSite           Return address of vos_memAlloc()
  */
 
-EXT_DECL UINT8 *vos_memAlloc (
-    UINT32 size)
+static void memProfileAlloc (
+    MEM_BLOCK_T *pBlock,
+    UINT32      blockSize,
+    UINT32      size,
+    const void  *pSite)
 {
-    UINT32      i, blockSize;
-    MEM_BLOCK_T *pBlock;
+    VOS_MEM_PROFILE_T       *pProfile = &gMemProfile.profile;
+    VOS_MEM_CLASS_PROFILE_T *pClass;
+    UINT32                  i;
 
-    if (size == 0)
+    pBlock->pNext = NULL;
+    if (!gMemProfile.valid || (vos_mutexLock(&gMemProfile.mutex) != VOS_NO_ERR))
     {
-        gMem.memCnt.allocErrCnt++;
-        vos_printLog(VOS_LOG_ERROR, "vos_memAlloc Requested size = %u\n", size);
-        return NULL;
+        return;
     }
 
-    /*    Use standard heap memory    */
-    if (gMem.memSize == 0 && gMem.pArea == NULL)
+    for (i = 0; (i < (UINT32) VOS_MEM_NBLOCKSIZES - 1u) && (pProfile->sizeClass[i].blockSize != blockSize); i++)
     {
-        UINT8 *p = (UINT8 *) malloc(size);    /*lint !e421 !e586 optional use of heap memory for debugging/development */
-        if (p != NULL)
-        {
-            memset(p, 0, size);
-        }
-        vos_printLog(VOS_LOG_DBG, "vos_memAlloc() %p, size\t%u\n", (void *) p, size);
-
-        return p;
+        ;
     }
-
-    /* Adjust size to get one which is a multiple of UINT32's */
-    size = ((size + sizeof(UINT32) - 1) / sizeof(UINT32)) * sizeof(UINT32);
-
-    /* Find appropriate blocksize */
-    for (i = 0; i < gMem.noOfBlocks; i++)
+    pClass = &pProfile->sizeClass[i];
+    if (++pClass->used > pClass->highWater)
     {
-        if (size <= gMem.freeBlock[i].size)
-        {
-            break;
+        pClass->highWater = pClass->used;
+    }
+    pClass->allocCnt++;
+    if ((pClass->minSize == 0u) || (size < pClass->minSize))
+    {
+        pClass->minSize = size;
+    }
+    if (size > pClass->maxSize)
+    {
+        pClass->maxSize = size;
+    }
+    pClass->requested   += size;
+    pClass->wasted      += blockSize - size;
+
+    for (i = 0; (i < pProfile->numSites) && (pProfile->site[i].pSite != pSite); i++)
+    {
+        ;
+    }
+    if ((i == pProfile->numSites) && (i < VOS_MEM_PROFILE_SITES))
+    {
+        pProfile->site[i].pSite = pSite;
+        pProfile->numSites++;
+    }
+    if (i < pProfile->numSites)
+    {
+        if (++pProfile->site[i].used > pProfile->site[i].highWater)
+        {
+            pProfile->site[i].highWater = pProfile->site[i].used;
+        }
+        pProfile->site[i].allocCnt++;
+        pProfile->site[i].requested += size;
+    }
+    else
+    {
+        pProfile->lostCnt++;
+        i = MEM_SITE_NONE;
+    }
+    pBlock->pNext = (MEM_BLOCK_T *) (uintptr_t) (i + 1u);
+
+    (void) vos_mutexUnlock(&gMemProfile.mutex);
+}
+
+/**********************************************************************************************************************/
+/** Profile a returned block.
+ *
+ *  @param[in]      pBlock          Block returned
+ *  @param[in]      i               Index of its block size
+ */
+
+static void memProfileFree (
+    MEM_BLOCK_T *pBlock,
+    UINT32      i)
+{
+    VOS_MEM_PROFILE_T   *pProfile = &gMemProfile.profile;
+    UINT32              site = (UINT32) (uintptr_t) pBlock->pNext;
+
+    pBlock->pNext = NULL;
+    if ((site == 0u) || !gMemProfile.valid || (vos_mutexLock(&gMemProfile.mutex) != VOS_NO_ERR))
+    {
+        return;
+    }
+    if (pProfile->sizeClass[i].used > 0u)
+    {
+        pProfile->sizeClass[i].used--;
+    }
+    if ((site <= pProfile->numSites) && (pProfile->site[site - 1u].used > 0u))
+    {
+        pProfile->site[site - 1u].used--;
+    }
+    (void) vos_mutexUnlock(&gMemProfile.mutex);
+}
+#endif
+
+#if VOS_MEM_MAP
+/**********************************************************************************************************************/
+/** Size of the mapping of a memory area.
+ *
+ *  @param[in]      size            Size of the memory area
+ *  @retval         Size rounded up to full huge pages, if they are used
+ */
+
+static size_t memAreaSize (
+    UINT32 size)
+{
+#if VOS_MEM_HUGE_PAGES
+    return ((size_t) size + MEM_HUGE_PAGE_SIZE - 1u) & ~((size_t) MEM_HUGE_PAGE_SIZE - 1u);
+#else
+    return (size_t) size;
+#endif
+}
+
+#if VOS_MEM_HUGE_PAGES
+/**********************************************************************************************************************/
+/** Map memory backed by huge pages.
+ *  Reserved huge pages are used if the system provides enough of them. Otherwise the mapping is aligned to the huge
+ *  page size and transparent huge pages are requested.
+ *
+ *  @param[in]      mapSize         Size of the mapping, a multiple of the huge page size
+ *  @retval         Pointer to the mapping, MAP_FAILED if mapping failed
+ */
+
+static void *memAreaMapHuge (
+    size_t mapSize)
+{
+    UINT8       *pMap;
+    UINT8       *pArea = MAP_FAILED;
+    uintptr_t   aligned;
+
+#ifdef MAP_HUGETLB
+    pArea = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (pArea != MAP_FAILED)
+    {
+        vos_printLog(VOS_LOG_INFO, "vos_memInit() %lu bytes on reserved huge pages\n", (unsigned long) mapSize);
+        return pArea;
+    }
+    vos_printLog(VOS_LOG_WARNING,
+                 "vos_memInit() no reserved huge pages (Err: %d), using transparent huge pages\n", errno);
+#endif
+
+    /* map one huge page more and trim it to get an aligned area */
+    pMap = mmap(NULL, mapSize + MEM_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pMap == MAP_FAILED)
+    {
+        return MAP_FAILED;
+    }
+    aligned = ((uintptr_t) pMap + MEM_HUGE_PAGE_SIZE - 1u) & ~((uintptr_t) MEM_HUGE_PAGE_SIZE - 1u);
+    pArea   = (UINT8 *) aligned;
+    if (pArea > pMap)
+    {
+        (void) munmap(pMap, (size_t) (pArea - pMap));
+    }
+    if (pArea + mapSize < pMap + mapSize + MEM_HUGE_PAGE_SIZE)
+    {
+        (void) munmap(pArea + mapSize, (size_t) ((pMap + mapSize + MEM_HUGE_PAGE_SIZE) - (pArea + mapSize)));
+    }
+#ifdef MADV_HUGEPAGE
+    if (madvise(pArea, mapSize, MADV_HUGEPAGE) != 0)
+    {
+        vos_printLog(VOS_LOG_WARNING,
+                     "vos_memInit() no transparent huge pages (Err: %d), using normal pages\n", errno);
+    }
+#else
+    vos_printLogStr(VOS_LOG_WARNING, "vos_memInit() no transparent huge pages, using normal pages\n");
+#endif
+    return pArea;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Map the memory area.
+ *  Depending on the configuration the area is placed on the NUMA node of the calling CPU, backed by huge pages and
+ *  locked into RAM. The pages are faulted in after the node policy is set, the first allocations in the cycle do
+ *  not fault.
+ *
+ *  @param[in]      size            Size of the memory area
+ *  @retval         Pointer to the memory area, NULL if mapping failed
+ */
+
+static UINT8 *memAreaMap (
+    UINT32 size)
+{
+    size_t          mapSize = memAreaSize(size);
+    void            *pArea;
+#if VOS_MEM_NUMA
+    unsigned int    cpu     = 0u;
+    unsigned int    node    = 0u;
+    unsigned long   nodeMask;
+#endif
+
+#if VOS_MEM_HUGE_PAGES
+    pArea = memAreaMapHuge(mapSize);
+#else
+    pArea = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#endif
+    if (pArea == MAP_FAILED)
+    {
+        return NULL;
+    }
+#if VOS_MEM_NUMA
+    if ((syscall(SYS_getcpu, &cpu, &node, NULL) == 0) && (node < (8u * sizeof(nodeMask) - 1u)))
+    {
+        nodeMask = 1ul << node;
+        /* Fails without NUMA support in the kernel, the first touch below places the pages locally anyway */
+        (void) syscall(SYS_mbind, pArea, (unsigned long) mapSize, MEM_MPOL_PREFERRED, &nodeMask,
+                       (unsigned long) (8u * sizeof(nodeMask)), 0u);
+    }
+#endif
+    memset(pArea, 0, mapSize);
+#if VOS_MEM_LOCK
+    if (mlock(pArea, mapSize) != 0)
+    {
+        vos_printLog(VOS_LOG_WARNING,
+                     "vos_memInit() memory area not locked (Err: %d), check RLIMIT_MEMLOCK\n", errno);
+    }
+#endif
+    return (UINT8 *) pArea;
+}
+#endif
+
+#if VOS_MEM_CACHE
+/**********************************************************************************************************************/
+/** Return the cache of the calling thread, emptied if it holds blocks of a former memory area.
+ *
+ *  @retval         Pointer to the cache
+ */
+
+static INLINE MEM_CACHE_T *memCacheOfThread (void)
+{
+    UINT32 generation = __atomic_load_n(&gMemGeneration, __ATOMIC_ACQUIRE);
+
+    if (sMemCache.generation != generation)
+    {
+        memset(sMemCache.count, 0, sizeof(sMemCache.count));
+        sMemCache.generation = generation;
+    }
+    return &sMemCache;
+}
+
+/**********************************************************************************************************************/
+/** Return the cached blocks of a terminating thread to the free lists.
+ *
+ *  @param[in]      pArg            Pointer to the cache of the thread
+ */
+
+static void memCacheFlush (
+    void *pArg)
+{
+    MEM_CACHE_T *pCache = (MEM_CACHE_T *) pArg;
+    UINT32      i;
+
+    if ((pCache->generation != __atomic_load_n(&gMemGeneration, __ATOMIC_ACQUIRE)) ||
+        (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR))
+    {
+        return;
+    }
+    for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+    {
+        while (pCache->count[i] > 0)
+        {
+            MEM_BLOCK_T *pBlock = pCache->pBlock[i][--pCache->count[i]];
+            pBlock->pNext = gMem.freeBlock[i].pFirst;
+            gMem.freeBlock[i].pFirst = pBlock;
+        }
+    }
+    (void) vos_mutexUnlock(&gMem.mutex);
+}
+
+/**********************************************************************************************************************/
+/** Create the key used to flush the caches of terminating threads.
+ */
+
+static void memCacheCreateKey (void)
+{
+    (void) pthread_key_create(&sMemCacheKey, memCacheFlush);
+}
+
+/**********************************************************************************************************************/
+/** Put a returned block into the cache of the calling thread. If the cache is full, half of it is moved to the
+ *  free list with one semaphore access.
+ *
+ *  @param[in]      i               Index of the block size
+ *  @param[in]      pBlock          Returned block
+ *
+ *  @retval         TRUE            block was cached
+ *  @retval         FALSE           block must be returned to the free list
+ */
+
+static BOOL8 memCachePut (
+    UINT32      i,
+    MEM_BLOCK_T *pBlock)
+{
+    MEM_CACHE_T *pCache = memCacheOfThread();
+
+    if (!pCache->registered)
+    {
+        (void) pthread_once(&sMemCacheOnce, memCacheCreateKey);
+        if (pthread_setspecific(sMemCacheKey, pCache) != 0)
+        {
+            return FALSE;
+        }
+        pCache->registered = TRUE;
+    }
+
+    if (pCache->count[i] >= VOS_MEM_CACHE_DEPTH)
+    {
+        if (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR)
+        {
+            return FALSE;
+        }
+        while (pCache->count[i] > VOS_MEM_CACHE_DEPTH / 2)
+        {
+            MEM_BLOCK_T *pOld = pCache->pBlock[i][--pCache->count[i]];
+            pOld->pNext = gMem.freeBlock[i].pFirst;
+            gMem.freeBlock[i].pFirst = pOld;
+        }
+        (void) vos_mutexUnlock(&gMem.mutex);
+    }
+    pCache->pBlock[i][pCache->count[i]++] = pBlock;
+    return TRUE;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Prepare an allocated block for the caller.
+ *
+ *  @param[in]      pBlock          Allocated block
+ *  @param[in]      blockSize       Size of the data part of the block
+ *  @param[in]      size            Requested size
+ *  @param[in]      pSite           Return address of vos_memAlloc() (VOS_MEM_PROFILE)
+ *
+ *  @retval         Pointer to the data area
+ */
+
+static UINT8 *memBlockInit (
+    MEM_BLOCK_T *pBlock,
+    UINT32      blockSize,
+    UINT32      size,
+    const void  *pSite)
+{
+    /* Fill in size in memory header of the block. To be used when it is returned.*/
+    pBlock->size = blockSize;
+    memCountAlloc(blockSize);
+#if VOS_MEM_PROFILE
+    memProfileAlloc(pBlock, blockSize, size, pSite);
+#else
+    (void) pSite;
+#endif
+
+    /* Clear returned memory area to be compliant with malloc'ed version */
+    memset((UINT8 *) pBlock + sizeof(MEM_BLOCK_T), 0, blockSize);
+
+    /* Return pointer to data area, not the memory block itself */
+    vos_printLog(VOS_LOG_DBG,
+                 "vos_memAlloc() %p, size\t%u\n",
+                 (void *) ((UINT8 *) pBlock + sizeof(MEM_BLOCK_T)),
+                 size);
+    return (UINT8 *) pBlock + sizeof(MEM_BLOCK_T);
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+
+/**********************************************************************************************************************/
+/*    Memory                                                                                                          */
+/**********************************************************************************************************************/
+
+/**********************************************************************************************************************/
+/** Initialize the memory unit.
+ *  Init a supplied block of memory and prepare it for use with vos_memAlloc and vos_memFree. The used block sizes can
+ *  be supplied and will be preallocated.
+ *  If half of the overall size of the requested memory area would be pre-allocated, either by the default
+ *  pre-allocation table or a provided one, no pre-allocation takes place.
+ *
+ *  @param[in]      pMemoryArea        Pointer to memory area to use
+ *  @param[in]      size               Size of provided memory area
+ *  @param[in]      fragMem            Pointer to list of preallocated block sizes, used to fragment memory for large blocks
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR        no memory available
+ *  @retval         VOS_MUTEX_ERR      no mutex available
+ */
+
+EXT_DECL VOS_ERR_T vos_memInit (
+    UINT8           *pMemoryArea,
+    UINT32          size,
+    const UINT32    fragMem[VOS_MEM_NBLOCKSIZES])
+{
+    return vos_memInitBlockSizes(pMemoryArea, size, fragMem, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Initialize the memory unit with application defined block sizes.
+ *  As vos_memInit(), the block sizes replace VOS_MEM_BLOCKSIZES. They are rounded up to a multiple of UINT32 and
+ *  must be ascending. Fewer than VOS_MEM_NBLOCKSIZES sizes are ended by a 0, fragMem refers to the same indices.
+ *
+ *  @param[in]      pMemoryArea        Pointer to memory area to use
+ *  @param[in]      size               Size of provided memory area
+ *  @param[in]      fragMem            Pointer to list of preallocated block sizes, used to fragment memory for large blocks
+ *  @param[in]      blockSizes         Block sizes, NULL for VOS_MEM_BLOCKSIZES
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR        no memory available
+ *  @retval         VOS_MUTEX_ERR      no mutex available
+ */
+
+EXT_DECL VOS_ERR_T vos_memInitBlockSizes (
+    UINT8           *pMemoryArea,
+    UINT32          size,
+    const UINT32    fragMem[VOS_MEM_NBLOCKSIZES],
+    const UINT32    blockSizes[VOS_MEM_NBLOCKSIZES])
+{
+    UINT32  i, j, max;
+    UINT32  minSize = 0;
+    UINT32  blockSize[VOS_MEM_NBLOCKSIZES] = VOS_MEM_BLOCKSIZES;        /* Different block sizes */
+    UINT8   *p[VOS_MEM_MAX_PREALLOCATE];
+
+    if (blockSizes != NULL)
+    {
+        for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+        {
+            blockSize[i] = ((blockSizes[i] + sizeof(UINT32) - 1u) / sizeof(UINT32)) * sizeof(UINT32);
+            if ((blockSizes[i] > 0x7FFFFFFFu) ||
+                ((i == 0u) && (blockSize[i] == 0u)) ||
+                ((i > 0u) && (blockSize[i] != 0u) && ((blockSize[i - 1u] == 0u) || (blockSize[i] <= blockSize[i - 1u]))))
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "vos_memInit() block sizes not ascending\n");
+                return VOS_PARAM_ERR;
+            }
+        }
+    }
+
+#if defined(ESP32) && VOS_ESP_STATIC
+    if (pMemoryArea == NULL)                        /* No heap in the static build: use the built-in area */
+    {
+        if (size > sizeof(gMemStaticArea))
+        {
+            return VOS_MEM_ERR;
+        }
+        pMemoryArea = gMemStaticArea;
+        size        = (size == 0) ? (UINT32) sizeof(gMemStaticArea) : size;
+    }
+#endif
+
+#if VOS_MEM_CACHE
+    /* Blocks still cached by threads belong to a former memory area */
+    (void) __atomic_add_fetch(&gMemGeneration, 1u, __ATOMIC_RELEASE);
+#endif
+
+    /* Initialize memory */
+    gMem.memSize = size;
+    gMem.allocSize = 0;
+    gMem.noOfBlocks         = 0;
+    gMem.memCnt.freeSize    = size;
+    gMem.memCnt.minFreeSize = size;
+    gMem.memCnt.allocCnt    = 0;
+    gMem.memCnt.allocErrCnt = 0;
+    gMem.memCnt.freeErrCnt  = 0;
+    gMemOperationalAllocs   = 0u;
+
+    /*  Create the memory mutex   */
+    if (vos_mutexLocalCreate(&gMem.mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_memInit Mutex creation failed\n");
+        return VOS_MUTEX_ERR;
+    }
+
+    for (i = 0; i < VOS_MEM_MAX_PREALLOCATE; i++)
+    {
+        p[i] = NULL;
+    }
+
+    /*  Check if we should prealloc some memory */
+    if (fragMem != NULL)
+    {
+        for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+        {
+            if (fragMem[i] != 0)
+            {
+                break;
+            }
+        }
+
+        if (i < (UINT32) VOS_MEM_NBLOCKSIZES)
+        {
+            for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+            {
+                gMem.memCnt.preAlloc[i] = fragMem[i];
+                minSize += gMem.memCnt.preAlloc[i] * blockSize[i];
+            }
+        }
+    }
+
+    if (pMemoryArea == NULL && size == 0)           /* This means we will use standard malloc calls    */
+    {
+        gMem.noOfBlocks = 0;
+        gMem.memSize    = 0;
+        gMem.pArea      = NULL;
+        return VOS_NO_ERR;
+    }
+
+    if (size != 0)
+    {
+        if (pMemoryArea == NULL)                    /* We must allocate memory from the heap once   */
+        {
+            gMem.pArea = NULL;
+#if VOS_MEM_MAP
+            gMem.pArea      = memAreaMap(size);
+            gMem.wasMapped  = (gMem.pArea != NULL) ? TRUE : FALSE;
+#endif
+            if (gMem.pArea == NULL)
+            {
+                gMem.pArea = (UINT8 *) malloc(size);    /*lint !e421 !e586 optional use of heap memory for debugging/
+                                                          development */
+            }
+            if (gMem.pArea == NULL)
+            {
+                return VOS_MEM_ERR;
+            }
+            gMem.wasMalloced = TRUE;
+        }
+        else                                        /* Use the memory provided from calling application */
+        {
+            gMem.pArea = pMemoryArea;
+        }
+    }
+    else
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /*  Can we pre-allocate the memory? If more than half of the memory would be occupied, we don't even try...  */
+    if (minSize > size / 2)
+    {
+        for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+        {
+            gMem.memCnt.preAlloc[i] = 0;
+        }
+        vos_printLogStr(VOS_LOG_INFO, "vos_memInit() Pre-Allocation disabled\n");
+    }
+
+    minSize = 0;
+
+    gMem.pFreeArea  = gMem.pArea;
+    gMem.memSize    = size;
+
+    /* Initialize free block headers */
+    memSetBlockSizes(blockSize);
+
+    for (i = 0; i < gMem.noOfBlocks; i++)
+    {
+        max     = gMem.memCnt.preAlloc[i];
+        minSize += blockSize[i];
+
+        if (max > VOS_MEM_MAX_PREALLOCATE)
+        {
+            max = VOS_MEM_MAX_PREALLOCATE;
+        }
+
+        for (j = 0; j < max; j++)
+        {
+            p[j] = vos_memAlloc(blockSize[i]);
+            if (p[j] == NULL)
+            {
+                vos_printLog(VOS_LOG_ERROR,
+                             "vos_memInit() Pre-Allocation size exceeds overall memory size!!! (%u > %u)\n",
+                             minSize,
+                             size);
+                break;
+            }
+        }
+
+        for (j = 0; j < max; j++)
+        {
+            if (p[j])
+            {
+                vos_memFree(p[j]);
+            }
+        }
+    }
+
+#if VOS_MEM_PROFILE
+    /* The pre-allocation is not profiled */
+    memProfileStart();
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Delete the memory area.
+ *    This will eventually invalidate any previously allocated memory blocks! It should be called last before the
+ *  application quits. No further access to the memory blocks is allowed after this call.
+ *
+ *  @param[in]      pMemoryArea        Pointer to memory area used
+ */
+
+EXT_DECL void vos_memDelete (
+    UINT8 *pMemoryArea)
+{
+    if (pMemoryArea != NULL && pMemoryArea != gMem.pArea)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_memDelete() ERROR wrong pointer/parameter\n");
+    }
+
+#if VOS_MEM_CACHE
+    (void) __atomic_add_fetch(&gMemGeneration, 1u, __ATOMIC_RELEASE);
+#endif
+
+    /* we will nevertheless clear the memory area because it makes no sence to report to the application... */
+    vos_mutexLocalDelete(&gMem.mutex);
+#if VOS_MEM_PROFILE
+    if (gMemProfile.valid)
+    {
+        gMemProfile.valid = FALSE;
+        vos_mutexLocalDelete(&gMemProfile.mutex);
+    }
+#endif
+    if (gMem.wasMalloced && gMem.pArea != NULL)
+    {
+#if VOS_MEM_MAP
+        if (gMem.wasMapped)
+        {
+            (void) munmap(gMem.pArea, memAreaSize(gMem.memSize));
+        }
+        else
+#endif
+        {
+            free(gMem.pArea);    /*lint !e421 !e586 optional use of heap memory for debugging/development */
+        }
+    }
+    memset(&gMem, 0, sizeof(gMem));
+}
+
+/**********************************************************************************************************************/
+/** Allocate a block of memory (from memory area above).
+ *
+ *  @param[in]      size            Size of requested block
+ *  @param[in]      pSite           Return address of vos_memAlloc() (VOS_MEM_PROFILE)
+ *
+ *  @retval         Pointer to memory area
+ *  @retval         NULL if no memory available
+ */
+
+static UINT8 *memAlloc (
+    UINT32      size,
+    const void  *pSite)
+{
+    UINT32      i, blockSize;
+    MEM_BLOCK_T *pBlock;
+
+    if (size == 0)
+    {
+        MEM_CNT_ADD(gMem.memCnt.allocErrCnt, 1u);
+        vos_printLog(VOS_LOG_ERROR, "vos_memAlloc Requested size = %u\n", size);
+        return NULL;
+    }
+
+    memCheckOperational(size);
+
+    /*    Use standard heap memory    */
+    if (gMem.memSize == 0 && gMem.pArea == NULL)
+    {
+        UINT8 *p = (UINT8 *) malloc(size);    /*lint !e421 !e586 optional use of heap memory for debugging/development */
+        if (p != NULL)
+        {
+            memset(p, 0, size);
         }
+        vos_printLog(VOS_LOG_DBG, "vos_memAlloc() %p, size\t%u\n", (void *) p, size);
+
+        return p;
     }
 
+    /* Adjust size to get one which is a multiple of UINT32's */
+    size = ((size + sizeof(UINT32) - 1) / sizeof(UINT32)) * sizeof(UINT32);
+
+    /* Find appropriate blocksize */
+    i = memBlockIndex(size);
+
     if (i >= gMem.noOfBlocks)
     {
-        gMem.memCnt.allocErrCnt++;
+        MEM_CNT_ADD(gMem.memCnt.allocErrCnt, 1u);
 
         vos_printLog(VOS_LOG_ERROR, "vos_memAlloc No block size big enough. Requested size=%d\n", size);
 
         return NULL; /* No block size big enough */
     }
 
+#if VOS_MEM_CACHE
+    /* Take a block from the cache of this thread, without the semaphore */
+    {
+        MEM_CACHE_T *pCache = memCacheOfThread();
+
+        if (pCache->count[i] > 0)
+        {
+            pBlock = pCache->pBlock[i][--pCache->count[i]];
+            return memBlockInit(pBlock, gMem.freeBlock[i].size, size, pSite);
+        }
+    }
+#endif
+
     /* Get memory sempahore */
     if (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR)
     {
-        gMem.memCnt.allocErrCnt++;
+        MEM_CNT_ADD(gMem.memCnt.allocErrCnt, 1u);
 
         vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc can't get semaphore\n");
 
@@ -421,6 +1201,19 @@ EXT_DECL UINT8 *vos_memAlloc (
             /* There is, get it. */
             /* Set start pointer to next free block in the linked list */
             gMem.freeBlock[i].pFirst = pBlock->pNext;
+
+#if VOS_MEM_CACHE
+            /* Refill the cache of this thread while we hold the semaphore */
+            {
+                MEM_CACHE_T *pCache = memCacheOfThread();
+
+                while ((pCache->count[i] < VOS_MEM_CACHE_DEPTH / 2) && (gMem.freeBlock[i].pFirst != NULL))
+                {
+                    pCache->pBlock[i][pCache->count[i]++]   = gMem.freeBlock[i].pFirst;
+                    gMem.freeBlock[i].pFirst                = gMem.freeBlock[i].pFirst->pNext;
+                }
+            }
+#endif
         }
         else
         {
@@ -465,35 +1258,96 @@ EXT_DECL UINT8 *vos_memAlloc (
 
         if (pBlock != NULL)
         {
-            /* Fill in size in memory header of the block. To be used when it is returned.*/
-            pBlock->size = blockSize;
-            gMem.memCnt.freeSize -= blockSize + sizeof(MEM_BLOCK_T);
-            if (gMem.memCnt.freeSize < gMem.memCnt.minFreeSize)
-            {
-                gMem.memCnt.minFreeSize = gMem.memCnt.freeSize;
-            }
-            gMem.memCnt.allocCnt++;
-
-            /* Clear returned memory area to be compliant with malloc'ed version */
-            memset((UINT8 *) pBlock + sizeof(MEM_BLOCK_T), 0, blockSize);
-
-            /* Return pointer to data area, not the memory block itself */
-            vos_printLog(VOS_LOG_DBG,
-                         "vos_memAlloc() %p, size\t%u\n",
-                         (void *) ((UINT8 *) pBlock + sizeof(MEM_BLOCK_T)),
-                         size);
-            return (UINT8 *) pBlock + sizeof(MEM_BLOCK_T);
+            return memBlockInit(pBlock, blockSize, size, pSite);
         }
         else
         {
             /* Not enough memory */
             vos_printLog(VOS_LOG_ERROR, "vos_memAlloc() Not enough memory, size %u\n", size);
-            gMem.memCnt.allocErrCnt++;
+            MEM_CNT_ADD(gMem.memCnt.allocErrCnt, 1u);
             return NULL;
         }
     }
 }
 
+/**********************************************************************************************************************/
+/** Allocate a block of memory (from memory area above).
+ *
+ *  @param[in]      size            Size of requested block
+ *
+ *  @retval         Pointer to memory area
+ *  @retval         NULL if no memory available
+ */
+
+EXT_DECL UINT8 *vos_memAlloc (
+    UINT32 size)
+{
+    return memAlloc(size, MEM_CALLER());
+}
+
+/**********************************************************************************************************************/
+/** Allocate a block of memory with an aligned data area (from memory area above).
+ *  The block is cut from a larger one of vos_memAlloc(), a header in front of the aligned data refers to it.
+ *  Standard heap memory is aligned by posix_memalign() on POSIX, other targets get the alignment of malloc().
+ *
+ *  @param[in]      size            Size of requested block
+ *  @param[in]      alignment       Alignment of the data area, a power of two
+ *
+ *  @retval         Pointer to memory area, to be returned with vos_memFree()
+ *  @retval         NULL if no memory available or alignment invalid
+ */
+
+EXT_DECL UINT8 *vos_memAllocAligned (
+    UINT32  size,
+    UINT32  alignment)
+{
+    UINT8       *p;
+    UINT8       *pAligned;
+    MEM_BLOCK_T *pHead;
+
+    if ((size == 0u) || (alignment == 0u) || ((alignment & (alignment - 1u)) != 0u))
+    {
+        MEM_CNT_ADD(gMem.memCnt.allocErrCnt, 1u);
+        vos_printLog(VOS_LOG_ERROR, "vos_memAllocAligned Requested size = %u, alignment = %u\n", size, alignment);
+        return NULL;
+    }
+
+    /*    Use standard heap memory    */
+    if (gMem.memSize == 0 && gMem.pArea == NULL)
+    {
+#ifdef POSIX
+        void *pHeap = NULL;
+
+        memCheckOperational(size);
+        if (posix_memalign(&pHeap, (alignment < sizeof(void *)) ? sizeof(void *) : alignment, size) != 0)
+        {
+            return NULL;
+        }
+        memset(pHeap, 0, size);
+        vos_printLog(VOS_LOG_DBG, "vos_memAllocAligned() %p, size\t%u\n", pHeap, size);
+        return (UINT8 *) pHeap;
+#else
+        return vos_memAlloc(size);
+#endif
+    }
+
+    /* Data areas of the memory area are aligned to UINT32 */
+    if (alignment <= sizeof(UINT32))
+    {
+        return memAlloc(size, MEM_CALLER());
+    }
+
+    p = memAlloc(size + alignment + (UINT32) sizeof(MEM_BLOCK_T), MEM_CALLER());
+    if ((p == NULL) || (((uintptr_t) p & (alignment - 1u)) == 0u))
+    {
+        return p;
+    }
+    pAligned = (UINT8 *) (((uintptr_t) p + sizeof(MEM_BLOCK_T) + alignment - 1u) & ~((uintptr_t) alignment - 1u));
+    pHead = (MEM_BLOCK_T *) (void *) (pAligned - sizeof(MEM_BLOCK_T));
+    pHead->size     = MEM_ALIGNED_MARK;
+    pHead->pNext    = (MEM_BLOCK_T *) (void *) p;
+    return pAligned;
+}
 
 /**********************************************************************************************************************/
 /** Deallocate a block of memory (from memory area above).
@@ -510,7 +1364,7 @@ EXT_DECL void vos_memFree (void *pMemBlock)
     /* Param check */
     if (pMemBlock == NULL)
     {
-        gMem.memCnt.freeErrCnt++;
+        MEM_CNT_ADD(gMem.memCnt.freeErrCnt, 1u);
         vos_printLogStr(VOS_LOG_ERROR, "vos_memFree() ERROR NULL pointer\n");
         return;
     }
@@ -527,52 +1381,64 @@ EXT_DECL void vos_memFree (void *pMemBlock)
     if (((UINT8 *)pMemBlock < gMem.pArea) ||
         ((UINT8 *)pMemBlock >= (gMem.pArea + gMem.memSize)))
     {
-        gMem.memCnt.freeErrCnt++;
+        MEM_CNT_ADD(gMem.memCnt.freeErrCnt, 1u);
         vos_printLogStr(VOS_LOG_ERROR, "vos_memFree ERROR returned memory not within allocated memory\n");
         return;
     }
 
+    /* Set block pointer to start of block, before the returned pointer */
+    pBlock      = (MEM_BLOCK_T *) ((UINT8 *) pMemBlock - sizeof(MEM_BLOCK_T));
+
+    /* Aligned block: return the block it was cut from */
+    if (pBlock->size == MEM_ALIGNED_MARK)
+    {
+        pBlock->size    = 0u;
+        pMemBlock       = (void *) pBlock->pNext;
+        pBlock          = (MEM_BLOCK_T *) ((UINT8 *) pMemBlock - sizeof(MEM_BLOCK_T));
+    }
+    blockSize   = pBlock->size;
+
+    /* Find appropriate free block item */
+    i = ((blockSize - 1u) < 0x7FFFFFFFu) ? memBlockIndex(blockSize) : gMem.noOfBlocks;
+
+    if ((i >= gMem.noOfBlocks) || (blockSize != gMem.freeBlock[i].size))
+    {
+        MEM_CNT_ADD(gMem.memCnt.freeErrCnt, 1u);
+
+        vos_printLogStr(VOS_LOG_ERROR, "vos_memFree illegal sized memory\n");
+        return;
+    }
+
+    vos_printLog(VOS_LOG_DBG, "vos_memFree() %p, size %u\n", pMemBlock, pBlock->size);
+    /* Destroy the size first in the block. If user tries to return same memory this will then fail. */
+    pBlock->size = 0;
+#if VOS_MEM_PROFILE
+    memProfileFree(pBlock, i);
+#endif
+
+#if VOS_MEM_CACHE
+    /* Keep the block in the cache of this thread, without the semaphore */
+    if (memCachePut(i, pBlock) == TRUE)
+    {
+        memCountFree(blockSize);
+        return;
+    }
+#endif
+
     /* Get memory sempahore */
     if (vos_mutexLock(&gMem.mutex) != VOS_NO_ERR)
     {
-        gMem.memCnt.freeErrCnt++;
+        MEM_CNT_ADD(gMem.memCnt.freeErrCnt, 1u);
 
         vos_printLogStr(VOS_LOG_ERROR, "vos_memFree can't get semaphore\n");
     }
     else
     {
-        /* Set block pointer to start of block, before the returned pointer */
-        pBlock      = (MEM_BLOCK_T *) ((UINT8 *) pMemBlock - sizeof(MEM_BLOCK_T));
-        blockSize   = pBlock->size;
-
-        /* Find appropriate free block item */
-        for (i = 0; i < gMem.noOfBlocks; i++)
-        {
-            if (blockSize == gMem.freeBlock[i].size)
-            {
-                break;
-            }
-        }
-
-        if (i >= gMem.noOfBlocks)
-        {
-            gMem.memCnt.freeErrCnt++;
+        memCountFree(blockSize);
 
-            vos_printLogStr(VOS_LOG_ERROR, "vos_memFree illegal sized memory\n");
-        }
-        else
-        {
-            gMem.memCnt.freeSize += blockSize + sizeof(MEM_BLOCK_T);
-            gMem.memCnt.allocCnt--;
-
-            /* Put the returned block first in the linked list */
-            pBlock->pNext = gMem.freeBlock[i].pFirst;
-            gMem.freeBlock[i].pFirst = pBlock;
-
-            vos_printLog(VOS_LOG_DBG, "vos_memFree() %p, size %u\n", pMemBlock, pBlock->size);
-            /* Destroy the size first in the block. If user tries to return same memory this will then fail. */
-            pBlock->size = 0;
-        }
+        /* Put the returned block first in the linked list */
+        pBlock->pNext = gMem.freeBlock[i].pFirst;
+        gMem.freeBlock[i].pFirst = pBlock;
 
         /* Release semaphore */
         if (vos_mutexUnlock(&gMem.mutex) != VOS_NO_ERR)
@@ -641,6 +1507,107 @@ EXT_DECL VOS_ERR_T vos_memCount (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Enter or leave the operational phase.
+ *  While operational, every vos_memAlloc() is counted and, depending on VOS_MEM_CHECK_OPERATIONAL, logged or
+ *  asserted.
+ *
+ *  @param[in]      operational     TRUE: start up is done
+ */
+
+EXT_DECL void vos_memSetOperational (
+    BOOL8 operational)
+{
+    gMemOperational = operational;
+}
+
+/**********************************************************************************************************************/
+/** Return the number of vos_memAlloc() calls in the operational phase.
+ *
+ *  @retval         number of allocations while operational since vos_memInit()
+ */
+
+EXT_DECL UINT32 vos_memOperationalAllocs (void)
+{
+    return gMemOperationalAllocs;
+}
+
+/**********************************************************************************************************************/
+/** Return the profile of the memory area (VOS_MEM_PROFILE).
+ *
+ *  @param[out]     pProfile        Pointer to the profile
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_INIT_ERR    not profiled: VOS_MEM_PROFILE is 0 or the heap is used
+ *  @retval         VOS_MUTEX_ERR   mutex not available
+ */
+
+EXT_DECL VOS_ERR_T vos_memProfile (
+    VOS_MEM_PROFILE_T *pProfile)
+{
+#if VOS_MEM_PROFILE
+    VOS_TIMEVAL_T now;
+
+    if (pProfile == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (!gMemProfile.valid)
+    {
+        return VOS_INIT_ERR;
+    }
+    if (vos_mutexLock(&gMemProfile.mutex) != VOS_NO_ERR)
+    {
+        return VOS_MUTEX_ERR;
+    }
+    *pProfile = gMemProfile.profile;
+    vos_getTime(&now);
+    vos_subTime(&now, &gMemProfile.start);
+    pProfile->duration = now;
+    (void) vos_mutexUnlock(&gMemProfile.mutex);
+    return VOS_NO_ERR;
+#else
+    (void) pProfile;
+    return VOS_INIT_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Restart the profile of the memory area (VOS_MEM_PROFILE).
+ *  The counters and sizes are cleared, the high water marks are set to the blocks in use.
+ */
+
+EXT_DECL void vos_memProfileReset (void)
+{
+#if VOS_MEM_PROFILE
+    VOS_MEM_PROFILE_T   *pProfile = &gMemProfile.profile;
+    UINT32              i;
+
+    if (!gMemProfile.valid || (vos_mutexLock(&gMemProfile.mutex) != VOS_NO_ERR))
+    {
+        return;
+    }
+    for (i = 0; i < (UINT32) VOS_MEM_NBLOCKSIZES; i++)
+    {
+        pProfile->sizeClass[i].highWater    = pProfile->sizeClass[i].used;
+        pProfile->sizeClass[i].allocCnt     = 0u;
+        pProfile->sizeClass[i].minSize      = 0u;
+        pProfile->sizeClass[i].maxSize      = 0u;
+        pProfile->sizeClass[i].requested    = 0u;
+        pProfile->sizeClass[i].wasted       = 0u;
+    }
+    for (i = 0; i < pProfile->numSites; i++)
+    {
+        pProfile->site[i].highWater = pProfile->site[i].used;
+        pProfile->site[i].allocCnt  = 0u;
+        pProfile->site[i].requested = 0u;
+    }
+    pProfile->lostCnt = 0u;
+    vos_getTime(&gMemProfile.start);
+    (void) vos_mutexUnlock(&gMemProfile.mutex);
+#endif
+}
+
 
 /**********************************************************************************************************************/
 /** Sort an array.
@@ -987,7 +1954,56 @@ EXT_DECL VOS_ERR_T vos_queueSend (
             }
         }
     }
-    return retVal;
+    return retVal;
+}
+
+/**********************************************************************************************************************/
+/** Take the first message of a queue, its semaphore has been taken.
+ *
+ *  @param[in]      queueHandle      Queue handle
+ *  @param[out]     ppData           Pointer to data pointer to be received
+ *  @param[out]     pSize            Size of receive data
+ *
+ *  @retval         VOS_NO_ERR       no error
+ *  @retval         VOS_MUTEX_ERR    queue could not be locked
+ */
+
+static VOS_ERR_T vos_queueGet (
+    VOS_QUEUE_T queueHandle,
+    UINT8       * *ppData,
+    UINT32      *pSize)
+{
+    if (vos_mutexLock(queueHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR could not lock mutex\n");
+        return VOS_MUTEX_ERR;
+    }
+    *ppData = queueHandle->pQueue[queueHandle->firstElem].pData;
+    *pSize  = queueHandle->pQueue[queueHandle->firstElem].size;
+    queueHandle->pQueue[queueHandle->firstElem].pData   = NULL;
+    queueHandle->pQueue[queueHandle->firstElem].size    = 0;
+    if (queueHandle->firstElem != queueHandle->lastElem)
+    {
+        if (queueHandle->firstElem < queueHandle->maxNoOfMsg - 1)
+        {
+            queueHandle->firstElem++;
+        }
+        else
+        {
+            queueHandle->firstElem = 0;
+        }
+    }
+    else
+    {
+        /* do nothing here, queue is now empty again */
+    }
+    if (vos_mutexUnlock(queueHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR could not unlock mutex\n");
+        return VOS_MUTEX_ERR;
+    }
+    /* Element received successfully */
+    return VOS_NO_ERR;
 }
 
 /**********************************************************************************************************************/
@@ -1011,73 +2027,63 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
     UINT32      *pSize,
     UINT32      usTimeout )
 {
-    VOS_ERR_T   retVal  = VOS_UNKNOWN_ERR;
-    VOS_ERR_T   err     = VOS_UNKNOWN_ERR;
-
     if ((queueHandle == (VOS_QUEUE_T) NULL)
         || (queueHandle->magicNumber != cQueueMagic))
     {
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR invalid parameter\n");
-        retVal = VOS_PARAM_ERR;
+        return VOS_PARAM_ERR;
     }
-    else
+
+    /* wait for semaphore indicating new message in queue */
+    if (vos_semaTake(queueHandle->semaphore, usTimeout) != VOS_NO_ERR)
     {
-        /* wait for semaphore indicating new message in queue */
-        err = vos_semaTake(queueHandle->semaphore, usTimeout);
-        if (err != VOS_NO_ERR)
-        {
-            if (usTimeout != 0)
-            {
-                vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() could not take semaphore\n");
-            }
-            *ppData = NULL;
-            *pSize  = 0;
-            retVal  = VOS_QUEUE_ERR;
-        }
-        else
+        if (usTimeout != 0)
         {
-            err = vos_mutexLock(queueHandle->mutex);
-            if (err != VOS_NO_ERR)
-            {
-                vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR could not lock mutex\n");
-                retVal = VOS_MUTEX_ERR;
-            }
-            else
-            {
-                *ppData = queueHandle->pQueue[queueHandle->firstElem].pData;
-                *pSize  = queueHandle->pQueue[queueHandle->firstElem].size;
-                queueHandle->pQueue[queueHandle->firstElem].pData   = NULL;
-                queueHandle->pQueue[queueHandle->firstElem].size    = 0;
-                if (queueHandle->firstElem != queueHandle->lastElem)
-                {
-                    if (queueHandle->firstElem < queueHandle->maxNoOfMsg - 1)
-                    {
-                        queueHandle->firstElem++;
-                    }
-                    else
-                    {
-                        queueHandle->firstElem = 0;
-                    }
-                }
-                else
-                {
-                    /* do nothing here, queue is now empty again */
-                }
-                err = vos_mutexUnlock(queueHandle->mutex);
-                if (err != VOS_NO_ERR)
-                {
-                    vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR could not unlock mutex\n");
-                    retVal = VOS_MUTEX_ERR;
-                }
-                else
-                {
-                    /* Element received successfully */
-                    retVal = VOS_NO_ERR;
-                }
-            }
+            vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() could not take semaphore\n");
         }
+        *ppData = NULL;
+        *pSize  = 0;
+        return VOS_QUEUE_ERR;
     }
-    return retVal;
+    return vos_queueGet(queueHandle, ppData, pSize);
+}
+
+/**********************************************************************************************************************/
+/** Get a message, wait until a deadline.
+ *  The deadline is a time returned by vos_getTime(), a consumer loop advancing it by its period does not drift.
+ *
+ *  @param[in]      queueHandle      Queue handle
+ *  @param[out]     ppData           Pointer to data pointer to be received
+ *  @param[out]     pSize            Size of receive data
+ *  @param[in]      pDeadline        Latest time to wait for a message
+ *
+ *  @retval         VOS_NO_ERR       no error
+ *  @retval         VOS_PARAM_ERR    parameter out of range/invalid
+ *  @retval         VOS_QUEUE_ERR    no message until the deadline
+ */
+
+EXT_DECL VOS_ERR_T vos_queueReceiveUntil (
+    VOS_QUEUE_T         queueHandle,
+    UINT8               * *ppData,
+    UINT32              *pSize,
+    const VOS_TIMEVAL_T *pDeadline)
+{
+    if ((queueHandle == (VOS_QUEUE_T) NULL)
+        || (queueHandle->magicNumber != cQueueMagic)
+        || (pDeadline == NULL))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceiveUntil() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+
+    /* a timeout is the expected result of a deadline, it is not logged */
+    if (vos_semaTakeUntil(queueHandle->semaphore, pDeadline) != VOS_NO_ERR)
+    {
+        *ppData = NULL;
+        *pSize  = 0;
+        return VOS_QUEUE_ERR;
+    }
+    return vos_queueGet(queueHandle, ppData, pSize);
 }
 
 /**********************************************************************************************************************/
@@ -1134,3 +2140,402 @@ EXT_DECL VOS_ERR_T vos_queueDestroy (
     }
     return retVal;
 }
+
+/**********************************************************************************************************************/
+/*    Ring queues                                                                                                     */
+/**********************************************************************************************************************/
+
+#ifdef VOS_RING_SUPPORTED
+/**********************************************************************************************************************/
+/** Return a slot of a ring queue.
+ *
+ *  @param[in]      ring            Ring queue handle
+ *  @param[in]      pos             head or tail position
+ *
+ *  @retval         Pointer to the slot
+ */
+
+static INLINE RING_SLOT_T *ringSlot (
+    VOS_RING_T  ring,
+    UINT32      pos)
+{
+    return (RING_SLOT_T *) (void *) (ring->pSlots + (pos & ring->mask) * ring->slotSize);
+}
+
+/**********************************************************************************************************************/
+/** Sleep until the ring queue was signalled or the timeout expired.
+ *
+ *  @param[in]      ring            Ring queue handle
+ *  @param[in]      event           event counter read before the queue was found empty
+ *  @param[in]      usTimeout       Maximum time to wait (in usec) or VOS_SEMA_WAIT_FOREVER
+ */
+
+static void ringWait (
+    VOS_RING_T  ring,
+    UINT32      event,
+    UINT32      usTimeout)
+{
+#ifdef VOS_RING_FUTEX
+    struct timespec timeout;
+
+    timeout.tv_sec  = (time_t) (usTimeout / 1000000u);
+    timeout.tv_nsec = (long) (usTimeout % 1000000u) * 1000;
+    (void) syscall(SYS_futex, &ring->event, FUTEX_WAIT_PRIVATE, event,
+                   (usTimeout == VOS_SEMA_WAIT_FOREVER) ? NULL : &timeout, NULL, 0);
+#else
+    (void) event;
+    (void) vos_semaTake(ring->semaphore, usTimeout);
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Wake up the receiver of a ring queue, if it is waiting.
+ *
+ *  @param[in]      ring            Ring queue handle
+ */
+
+static INLINE void ringSignal (
+    VOS_RING_T ring)
+{
+    /* pairs with the fence in vos_ringReceive: either the receiver sees the message or we see it waiting */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if ((__atomic_load_n(&ring->waiting, __ATOMIC_RELAXED) != 0u) &&
+        (__atomic_exchange_n(&ring->waiting, 0u, __ATOMIC_RELAXED) != 0u))
+    {
+        /* only the first message after the receiver went to sleep has to wake it up */
+        (void) __atomic_add_fetch(&ring->event, 1u, __ATOMIC_RELEASE);
+#ifdef VOS_RING_FUTEX
+        (void) syscall(SYS_futex, &ring->event, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+        vos_semaGive(ring->semaphore);
+#endif
+    }
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Initialize a ring queue.
+ *  A ring queue is a bounded FIFO with a fixed number of slots of fixed size. Messages are copied into the slots,
+ *  no memory is allocated per message and no lock is taken. The receiver only blocks if the queue is empty.
+ *
+ *  @param[in]      type            VOS_RING_SPSC for one, VOS_RING_MPSC for several producer threads
+ *  @param[in]      maxNoOfMsg      Maximum number of messages, rounded up to a power of 2
+ *  @param[in]      maxMsgSize      Maximum size of a message
+ *  @param[out]     pRing           Handle of created ring queue
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid, or the ring would exceed 4GB
+ *  @retval         VOS_MEM_ERR     no memory available
+ *  @retval         VOS_SEMA_ERR    no semaphore available
+ *  @retval         VOS_INIT_ERR    not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_ringCreate (
+    VOS_RING_TYPE_T type,
+    UINT32          maxNoOfMsg,
+    UINT32          maxMsgSize,
+    VOS_RING_T      *pRing)
+{
+#ifdef VOS_RING_SUPPORTED
+    VOS_RING_T  ring;
+    UINT32      noOfSlots = 1u;
+    UINT32      slotSize;
+    UINT32      i;
+
+    if ((pRing == NULL)
+        || ((type != VOS_RING_SPSC) && (type != VOS_RING_MPSC))
+        || (maxNoOfMsg == 0u) || (maxNoOfMsg > 0x40000000u)
+        || (maxMsgSize == 0u) || (maxMsgSize > 0xFFFFFFFFu - sizeof(RING_SLOT_T) - 7u))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_ringCreate() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+
+    while (noOfSlots < maxNoOfMsg)
+    {
+        noOfSlots <<= 1u;
+    }
+
+    /* the slot buffer must not wrap around when its size is computed */
+    slotSize = (UINT32) ((sizeof(RING_SLOT_T) + maxMsgSize + 7u) & ~7u);
+    if (noOfSlots > 0xFFFFFFFFu / slotSize)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_ringCreate() ERROR ring too large\n");
+        return VOS_PARAM_ERR;
+    }
+
+    ring = (VOS_RING_T) vos_memAlloc(sizeof(struct VOS_RING));
+    if (ring == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_ringCreate() ERROR could not allocate memory\n");
+        return VOS_MEM_ERR;
+    }
+
+    ring->type          = type;
+    ring->mask          = noOfSlots - 1u;
+    ring->maxMsgSize    = maxMsgSize;
+    ring->slotSize      = slotSize;
+#ifdef _SC_NPROCESSORS_ONLN
+    ring->spin          = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? VOS_RING_SPIN : 0u;
+#else
+    ring->spin          = VOS_RING_SPIN;
+#endif
+    ring->pSlots        = vos_memAlloc(noOfSlots * ring->slotSize);
+    if (ring->pSlots == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_ringCreate() ERROR could not allocate memory\n");
+        vos_memFree(ring);
+        return VOS_MEM_ERR;
+    }
+#ifndef VOS_RING_FUTEX
+    if (vos_semaCreate(&ring->semaphore, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_ringCreate() ERROR could not create semaphore\n");
+        vos_memFree(ring->pSlots);
+        vos_memFree(ring);
+        return VOS_SEMA_ERR;
+    }
+#endif
+
+    /* slot i is free for the write at position i */
+    for (i = 0u; i < noOfSlots; i++)
+    {
+        ringSlot(ring, i)->seq = i;
+    }
+    ring->head          = 0u;
+    ring->tail          = 0u;
+    ring->waiting       = 0u;
+    ring->event         = 0u;
+    ring->magicNumber   = cRingMagic;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    *pRing = ring;
+    return VOS_NO_ERR;
+#else
+    (void) type;
+    (void) maxNoOfMsg;
+    (void) maxMsgSize;
+    (void) pRing;
+    vos_printLogStr(VOS_LOG_ERROR, "vos_ringCreate() not supported on this target\n");
+    return VOS_INIT_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Send a message, the data is copied into the ring queue.
+ *
+ *  @param[in]      ring            Ring queue handle
+ *  @param[in]      pData           Pointer to data to be sent
+ *  @param[in]      size            Size of data to be sent
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_PARAM_ERR       parameter out of range/invalid
+ *  @retval         VOS_QUEUE_FULL_ERR  no free slot
+ */
+
+EXT_DECL VOS_ERR_T vos_ringSend (
+    VOS_RING_T  ring,
+    const UINT8 *pData,
+    UINT32      size)
+{
+#ifdef VOS_RING_SUPPORTED
+    RING_SLOT_T *pSlot;
+    UINT32      pos;
+    INT32       diff;
+
+    if ((ring == NULL)
+        || (ring->magicNumber != cRingMagic)
+        || (pData == NULL)
+        || (size == 0u)
+        || (size > ring->maxMsgSize))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_ringSend() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+
+    pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    for (;; )
+    {
+        pSlot   = ringSlot(ring, pos);
+        diff    = (INT32) (__atomic_load_n(&pSlot->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff < 0)
+        {
+            /* the slot still holds the message of the previous round */
+            return VOS_QUEUE_FULL_ERR;
+        }
+        if (ring->type == VOS_RING_SPSC)
+        {
+            /* we are the only writer, the slot is ours */
+            __atomic_store_n(&ring->head, pos + 1u, __ATOMIC_RELAXED);
+            break;
+        }
+        if ((diff == 0) &&
+            __atomic_compare_exchange_n(&ring->head, &pos, pos + 1u, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+        if (diff > 0)
+        {
+            /* another producer took this slot */
+            pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy((UINT8 *) pSlot + sizeof(RING_SLOT_T), pData, size);
+    pSlot->size = size;
+    __atomic_store_n(&pSlot->seq, pos + 1u, __ATOMIC_RELEASE);
+
+    ringSignal(ring);
+    return VOS_NO_ERR;
+#else
+    (void) ring;
+    (void) pData;
+    (void) size;
+    return VOS_INIT_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Get a message. Must only be called by one thread at a time.
+ *
+ *  @param[in]      ring            Ring queue handle
+ *  @param[out]     pData           Pointer to buffer for the message
+ *  @param[in,out]  pSize           In: size of the buffer, out: size of the message
+ *  @param[in]      usTimeout       Maximum time to wait for a message (in usec), 0: don't wait,
+ *                                  VOS_SEMA_WAIT_FOREVER: wait forever
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR     buffer too small, the message stays in the queue
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+
+EXT_DECL VOS_ERR_T vos_ringReceive (
+    VOS_RING_T  ring,
+    UINT8       *pData,
+    UINT32      *pSize,
+    UINT32      usTimeout)
+{
+#ifdef VOS_RING_SUPPORTED
+    RING_SLOT_T     *pSlot;
+    UINT32          pos;
+    UINT32          event;
+    UINT32          spin;
+    VOS_TIMEVAL_T   now, left, end = {0, 0};
+
+    if ((ring == NULL)
+        || (ring->magicNumber != cRingMagic)
+        || (pData == NULL)
+        || (pSize == NULL))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_ringReceive() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+
+    if ((usTimeout != 0u) && (usTimeout != VOS_SEMA_WAIT_FOREVER))
+    {
+        VOS_TIMEVAL_T timeout;
+
+        timeout.tv_sec  = usTimeout / 1000000u;
+        timeout.tv_usec = (INT32) (usTimeout % 1000000u);
+        vos_getTime(&end);
+        vos_addTime(&end, &timeout);
+    }
+
+    pos     = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    pSlot   = ringSlot(ring, pos);
+
+    while (__atomic_load_n(&pSlot->seq, __ATOMIC_ACQUIRE) != pos + 1u)
+    {
+        UINT32 remaining = usTimeout;
+
+        if (usTimeout == 0u)
+        {
+            *pSize = 0u;
+            return VOS_QUEUE_ERR;
+        }
+        if (usTimeout != VOS_SEMA_WAIT_FOREVER)
+        {
+            vos_getTime(&now);
+            if (vos_cmpTime(&now, &end) >= 0)
+            {
+                *pSize = 0u;
+                return VOS_QUEUE_ERR;
+            }
+            left = end;
+            vos_subTime(&left, &now);
+            remaining = left.tv_sec * 1000000u + (UINT32) left.tv_usec;
+        }
+
+        /* a producer which is just writing is faster than a sleep and wake up */
+        for (spin = 0u; spin < ring->spin; spin++)
+        {
+            if (__atomic_load_n(&pSlot->seq, __ATOMIC_ACQUIRE) == pos + 1u)
+            {
+                break;
+            }
+        }
+        if (spin < ring->spin)
+        {
+            break;
+        }
+
+        /* announce the wait, then check again to not miss a message sent in between */
+        event = __atomic_load_n(&ring->event, __ATOMIC_ACQUIRE);
+        __atomic_store_n(&ring->waiting, 1u, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&pSlot->seq, __ATOMIC_ACQUIRE) != pos + 1u)
+        {
+            ringWait(ring, event, remaining);
+        }
+        __atomic_store_n(&ring->waiting, 0u, __ATOMIC_RELAXED);
+    }
+
+    if (pSlot->size > *pSize)
+    {
+        *pSize = pSlot->size;
+        return VOS_MEM_ERR;
+    }
+    *pSize = pSlot->size;
+    memcpy(pData, (UINT8 *) pSlot + sizeof(RING_SLOT_T), pSlot->size);
+
+    /* free the slot for the write in the next round */
+    __atomic_store_n(&pSlot->seq, pos + ring->mask + 1u, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->tail, pos + 1u, __ATOMIC_RELAXED);
+    return VOS_NO_ERR;
+#else
+    (void) ring;
+    (void) pData;
+    (void) pSize;
+    (void) usTimeout;
+    return VOS_INIT_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Destroy a ring queue.
+ *  Free all resources used by this ring queue, no thread may use it anymore.
+ *
+ *  @param[in]      ring            Ring queue handle
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_ringDestroy (
+    VOS_RING_T ring)
+{
+    if ((ring == NULL)
+        || (ring->magicNumber != cRingMagic))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_ringDestroy() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+    ring->magicNumber = 0u;
+#ifndef VOS_RING_FUTEX
+    vos_semaDelete(ring->semaphore);
+#endif
+    vos_memFree(ring->pSlots);
+    vos_memFree(ring);
+    return VOS_NO_ERR;
+}
@@ -32,6 +32,9 @@
  */
 
 #include <string.h>
+#if VOS_LOG_DEFERRED
+#include <stdarg.h>
+#endif
 
 #include "vos_utils.h"
 #include "vos_sock.h"
@@ -44,11 +47,31 @@
 #define pgm_read_dword(a)  (*(a))
 #endif
 
+/* Slice-by-8 CRC tables need 16KB of RAM, set to 0 on small targets to keep the byte tables only */
+#ifndef VOS_CRC_SLICE_BY_8
+#define VOS_CRC_SLICE_BY_8  1
+#endif
+
+/* Hardware CRC32 paths, define VOS_CRC_NO_HW to disable */
+#if !defined(VOS_CRC_NO_HW) && VOS_CRC_SLICE_BY_8 && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VOS_CRC_PCLMUL      1
+#include <immintrin.h>
+#endif
+#if !defined(VOS_CRC_NO_HW) && defined(__ARM_FEATURE_CRC32)
+#define VOS_CRC_ARMV8       1
+#include <arm_acle.h>
+#endif
+#if !defined(VOS_CRC_NO_HW) && VOS_CRC_SLICE_BY_8 && defined(__aarch64__) && defined(__AARCH64EL__) && \
+    defined(__ARM_FEATURE_CRYPTO)
+#define VOS_CRC_PMULL       1
+#include <arm_neon.h>
+#endif
+
 /***********************************************************************************************************************
  * DEFINITIONS
  */
 
-#define NO_OF_ERROR_STRINGS  52u
+#define NO_OF_ERROR_STRINGS  53u
 
 /***********************************************************************************************************************
  * GLOBALS
@@ -63,6 +86,388 @@ void *gRefCon = NULL;
 
 static const VOS_VERSION_T vosVersion = {VOS_VERSION, VOS_RELEASE, VOS_UPDATE, VOS_EVOLUTION};
 
+#if VOS_LOG_DEFERRED
+
+#define VOS_LOG_NULL_STR    0xFFFFFFFFu     /* offset of a NULL string argument */
+
+/** Argument of a log record */
+typedef union
+{
+    UINT64      u;                      /**< integer, string offset */
+    double      d;                      /**< floating point         */
+    const void  *p;                     /**< pointer                */
+} VOS_LOG_ARG_T;
+
+/** Log record, a slot of the ring */
+typedef struct
+{
+    UINT32                  seq;        /**< ring position + 1 if filled, ring position if free     */
+    VOS_LOG_T               level;      /**< log category                                           */
+    const VOS_LOG_SITE_T    *pSite;     /**< call site, gives format, file and line                 */
+    UINT32                  suppressed; /**< messages of the site suppressed before this one        */
+    UINT32                  numArgs;    /**< arguments stored                                       */
+    VOS_LOG_ARG_T           arg[VOS_LOG_MAX_ARGS];
+    CHAR8                   str[VOS_LOG_STR_SIZE];  /**< copies of the string arguments             */
+} VOS_LOG_REC_T;
+
+/*  Bounded multi producer / single consumer ring: producers claim a slot by the tail, the slot's sequence
+    tells whether it is free or filled    */
+static VOS_LOG_REC_T    sLogRing[VOS_LOG_RING_SIZE];
+static UINT32           sLogTail    = 0u;       /* next position to fill, producers    */
+static UINT32           sLogHead    = 0u;       /* next position to output, log thread */
+static UINT32           sLogDropped = 0u;       /* records lost with full ring         */
+static BOOL8            sLogRun     = FALSE;    /* log thread shall run                */
+static BOOL8            sLogActive  = FALSE;    /* log thread is running               */
+static VOS_THREAD_T     sLogThread  = NULL;
+
+/**********************************************************************************************************************/
+/** Skip flags, width, precision and length of a conversion specification
+ *
+ *  @param[in]          p               pointer behind the '%'
+ *  @param[out]         pNumStar        number of '*' (int arguments) found
+ *  @param[out]         pLong           length modifier: 0 none/h/hh, 1 l, 2 ll/j, 3 z/t, 4 L
+ *  @retval             pointer to the conversion character
+ */
+static const CHAR8 *vos_logSkipSpec (
+    const CHAR8 *p,
+    UINT32      *pNumStar,
+    UINT32      *pLong)
+{
+    *pNumStar   = 0u;
+    *pLong      = 0u;
+    while ((*p != '\0') && (strchr("-+ #0123456789.*", *p) != NULL))
+    {
+        if (*p == '*')
+        {
+            (*pNumStar)++;
+        }
+        p++;
+    }
+    while ((*p != '\0') && (strchr("hljztL", *p) != NULL))
+    {
+        switch (*p)
+        {
+            case 'l':
+                *pLong = (*pLong == 1u) ? 2u : 1u;
+                break;
+            case 'j':
+                *pLong = 2u;
+                break;
+            case 'z':
+            case 't':
+                *pLong = 3u;
+                break;
+            case 'L':
+                *pLong = 4u;
+                break;
+            default:
+                break;
+        }
+        p++;
+    }
+    return p;
+}
+
+/**********************************************************************************************************************/
+/** Store the arguments of a format in a log record
+ *
+ *  @param[in,out]      pRec            log record, pSite set
+ *  @param[in]          pArgs           arguments
+ */
+static void vos_logCapture (
+    VOS_LOG_REC_T   *pRec,
+    va_list         *pArgs)
+{
+    const CHAR8 *p      = pRec->pSite->pFormat;
+    UINT32      strUsed = 0u;
+    UINT32      numStar;
+    UINT32      lenMod;
+    UINT32      i;
+
+    pRec->numArgs = 0u;
+    while ((p = strchr(p, '%')) != NULL)
+    {
+        p++;
+        if (*p == '%')
+        {
+            p++;
+            continue;
+        }
+        p = vos_logSkipSpec(p, &numStar, &lenMod);
+        if ((pRec->numArgs + numStar + 1u) > VOS_LOG_MAX_ARGS)
+        {
+            return;
+        }
+        for (i = 0u; i < numStar; i++)
+        {
+            pRec->arg[pRec->numArgs++].u = (UINT64) (INT64) va_arg(*pArgs, int);
+        }
+        switch (*p)
+        {
+            case 'd':
+            case 'i':
+                pRec->arg[pRec->numArgs].u =
+                    (lenMod == 2u) ? (UINT64) va_arg(*pArgs, long long) :
+                    (lenMod == 1u) ? (UINT64) (INT64) va_arg(*pArgs, long) :
+                    (lenMod == 3u) ? (UINT64) (INT64) va_arg(*pArgs, ptrdiff_t) :
+                    (UINT64) (INT64) va_arg(*pArgs, int);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'c':
+                pRec->arg[pRec->numArgs].u =
+                    (lenMod == 2u) ? (UINT64) va_arg(*pArgs, unsigned long long) :
+                    (lenMod == 1u) ? (UINT64) va_arg(*pArgs, unsigned long) :
+                    (lenMod == 3u) ? (UINT64) va_arg(*pArgs, size_t) :
+                    (UINT64) va_arg(*pArgs, unsigned int);
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                pRec->arg[pRec->numArgs].d =
+                    (lenMod == 4u) ? (double) va_arg(*pArgs, long double) : va_arg(*pArgs, double);
+                break;
+            case 'p':
+                pRec->arg[pRec->numArgs].p = va_arg(*pArgs, void *);
+                break;
+            case 's':
+            {
+                const CHAR8 *pStr = va_arg(*pArgs, const CHAR8 *);
+                if (pStr == NULL)
+                {
+                    pRec->arg[pRec->numArgs].u = VOS_LOG_NULL_STR;
+                }
+                else
+                {
+                    /* the copy is truncated to the space left */
+                    UINT32 len = (UINT32) strlen(pStr);
+                    if (len >= (VOS_LOG_STR_SIZE - strUsed))
+                    {
+                        len = VOS_LOG_STR_SIZE - strUsed - 1u;
+                    }
+                    memcpy(&pRec->str[strUsed], pStr, len);
+                    pRec->str[strUsed + len]    = '\0';
+                    pRec->arg[pRec->numArgs].u  = strUsed;
+                    strUsed += len + ((strUsed + len + 1u < VOS_LOG_STR_SIZE) ? 1u : 0u);
+                }
+                break;
+            }
+            default:
+                /* unsupported conversion, the rest of the format is output as it is */
+                return;
+        }
+        pRec->numArgs++;
+        p++;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Format a log record and pass it to the debug output function
+ *
+ *  @param[in]          pRec            log record
+ */
+static void vos_logOutput (
+    const VOS_LOG_REC_T *pRec)
+{
+    CHAR8       text[VOS_MAX_PRNT_STR_SIZE];
+    CHAR8       spec[32];
+    const CHAR8 *p      = pRec->pSite->pFormat;
+    UINT32      len     = 0u;
+    UINT32      argIdx  = 0u;
+    UINT32      numStar;
+    UINT32      lenMod;
+    int         n;
+
+    if (gPDebugFunction == NULL)
+    {
+        return;
+    }
+    if (pRec->suppressed > 0u)
+    {
+        (void) vos_snprintf(text, sizeof(text), "%u similar messages suppressed\n", (unsigned int) pRec->suppressed);
+        gPDebugFunction(gRefCon, pRec->level, vos_getTimeStamp(), pRec->pSite->pFile, pRec->pSite->line, text);
+    }
+
+    while ((*p != '\0') && (len < (sizeof(text) - 1u)))
+    {
+        const CHAR8 *pSpec = p;
+        UINT32      specLen = 0u;
+
+        if ((*p != '%') || (p[1] == '%') || (argIdx >= pRec->numArgs))
+        {
+            /* literal text, "%%" or a conversion without stored argument */
+            text[len++] = *p;
+            p += ((*p == '%') && (p[1] == '%')) ? 2 : 1;
+            continue;
+        }
+        p = vos_logSkipSpec(p + 1, &numStar, &lenMod);
+
+        /* rebuild the specification: '*' replaced by the stored values, integers as long long */
+        for (; (pSpec < p) && (specLen < (sizeof(spec) - 16u)); pSpec++)
+        {
+            if (*pSpec == '*')
+            {
+                specLen += (UINT32) vos_snprintf(&spec[specLen], sizeof(spec) - specLen, "%d",
+                                                 (int) (INT64) pRec->arg[argIdx++].u);
+            }
+            else if (strchr("hljztL", *pSpec) == NULL)
+            {
+                spec[specLen++] = *pSpec;
+            }
+        }
+        if (strchr("diuxXo", *p) != NULL)
+        {
+            spec[specLen++] = 'l';
+            spec[specLen++] = 'l';
+        }
+        spec[specLen++] = *p;
+        spec[specLen]   = '\0';
+
+        switch (*p)
+        {
+            case 'd':
+            case 'i':
+                n = vos_snprintf(&text[len], sizeof(text) - len, spec, (long long) pRec->arg[argIdx].u);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                n = vos_snprintf(&text[len], sizeof(text) - len, spec, (unsigned long long) pRec->arg[argIdx].u);
+                break;
+            case 'c':
+                n = vos_snprintf(&text[len], sizeof(text) - len, spec, (int) pRec->arg[argIdx].u);
+                break;
+            case 'p':
+                n = vos_snprintf(&text[len], sizeof(text) - len, spec, pRec->arg[argIdx].p);
+                break;
+            case 's':
+                n = vos_snprintf(&text[len], sizeof(text) - len, spec,
+                                 (pRec->arg[argIdx].u == VOS_LOG_NULL_STR) ? "(null)" : &pRec->str[pRec->arg[argIdx].u]);
+                break;
+            default:
+                n = vos_snprintf(&text[len], sizeof(text) - len, spec, pRec->arg[argIdx].d);
+                break;
+        }
+        argIdx++;
+        p++;
+        if (n > 0)
+        {
+            len += (UINT32) n;
+        }
+    }
+    if (len >= sizeof(text))
+    {
+        len = sizeof(text) - 1u;
+    }
+    text[len] = '\0';
+    gPDebugFunction(gRefCon, pRec->level, vos_getTimeStamp(), pRec->pSite->pFile, pRec->pSite->line, text);
+}
+
+/**********************************************************************************************************************/
+/** Output all filled log records, in order
+ */
+static void vos_logDrain (void)
+{
+    UINT32 dropped;
+
+    for (;; )
+    {
+        VOS_LOG_REC_T *pRec = &sLogRing[sLogHead & (VOS_LOG_RING_SIZE - 1u)];
+
+        if (__atomic_load_n(&pRec->seq, __ATOMIC_ACQUIRE) != (sLogHead + 1u))
+        {
+            break;
+        }
+        vos_logOutput(pRec);
+        __atomic_store_n(&pRec->seq, sLogHead + VOS_LOG_RING_SIZE, __ATOMIC_RELEASE);
+        __atomic_store_n(&sLogHead, sLogHead + 1u, __ATOMIC_RELEASE);
+    }
+
+    dropped = __atomic_exchange_n(&sLogDropped, 0u, __ATOMIC_RELAXED);
+    if ((dropped > 0u) && (gPDebugFunction != NULL))
+    {
+        CHAR8 text[64];
+
+        (void) vos_snprintf(text, sizeof(text), "%u log messages dropped, ring full\n", (unsigned int) dropped);
+        gPDebugFunction(gRefCon, VOS_LOG_WARNING, vos_getTimeStamp(), __FILE__, (UINT16) __LINE__, text);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Log thread, outputs the log records
+ *
+ *  @param[in]          pArg            unused
+ */
+static void vos_logThread (
+    void *pArg)
+{
+    (void) pArg;
+    while (__atomic_load_n(&sLogRun, __ATOMIC_ACQUIRE))
+    {
+        vos_logDrain();
+        (void) vos_threadDelay(VOS_LOG_FLUSH_INTERVAL);
+    }
+    vos_logDrain();
+    __atomic_store_n(&sLogActive, FALSE, __ATOMIC_RELEASE);
+}
+
+/**********************************************************************************************************************/
+/** Start the log thread
+ */
+static void vos_logStart (void)
+{
+    UINT32 i;
+
+    if (__atomic_load_n(&sLogActive, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+    for (i = 0u; i < VOS_LOG_RING_SIZE; i++)
+    {
+        sLogRing[i].seq = i;
+    }
+    sLogHead    = 0u;
+    sLogTail    = 0u;
+    sLogDropped = 0u;
+    sLogRun     = TRUE;
+    sLogActive  = TRUE;
+    if (vos_threadCreate(&sLogThread, "vosLog", VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
+                         vos_logThread, NULL) != VOS_NO_ERR)
+    {
+        /* log synchronously */
+        sLogRun     = FALSE;
+        sLogActive  = FALSE;
+        sLogThread  = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Stop the log thread after it has output all records
+ */
+static void vos_logStop (void)
+{
+    if (sLogThread != NULL)
+    {
+        __atomic_store_n(&sLogRun, FALSE, __ATOMIC_RELEASE);
+        while (__atomic_load_n(&sLogActive, __ATOMIC_ACQUIRE))
+        {
+            (void) vos_threadDelay(1000u);
+        }
+        sLogThread = NULL;
+        /* records stored while the thread ran out */
+        vos_logDrain();
+    }
+}
+#endif
+
 /** Table of CRC-32s of all single-byte values according to IEEE802.3 / IEC 61375-2-3 A.3
  *  The FCS-32 generator polynomial:
  *  x**0 + x**1 + x**2 + x**4 + x**5 + x**7 + x**8 + x**10 + x**11 + x**12 + x**16
@@ -251,10 +656,18 @@ const CHAR8         *cErrStrings[NO_OF_ERROR_STRINGS] PROGMEM =
     "TRDP_XML_PARSER_ERR (error while parsing XML file)",               /**< Returned by the tau_xml subsystem        */
     "TRDP_INUSE_ERR (Resource is in use)",                              /**< Resource is still in use                 */
     "TRDP_MARSHALLING_ERR (Mismatch between source and dataset size)",  /**< Source size exceeded, dataset mismatch   */
+    "TRDP_SAFETY_ERR (vital data not valid)",                           /**< SDT: vital data not valid                */
     "TRDP_UNKNOWN_ERR (Unspecified error)"                              /**< Unspecified error                        */
 };
 #endif
 
+#if VOS_CRC_SLICE_BY_8
+/** Slice-by-8 tables, derived from the byte tables above by vos_crcSelect()  */
+static UINT32   fcs_table8[8u][256u];
+static UINT32   sc32_table8[8u][256u];
+static BOOL8    sCrcTablesValid = FALSE;
+#endif
+
 #ifdef DEBUG
 static BOOL8 sIsBigEndian = FALSE;
 
@@ -284,6 +697,661 @@ static void vos_printStructSizes ()
 }
 #endif
 
+/**********************************************************************************************************************/
+/** CRC32 (IEEE802.3) byte-by-byte reference implementation.
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             new CRC register value (not inverted)
+ */
+
+static UINT32 vos_crc32Bytewise (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    UINT32 i;
+    for (i = 0u; i < dataLen; i++)
+    {
+        crc = (crc >> 8u) ^ pgm_read_dword(&fcs_table[(crc ^ pData[i]) & 0xffu]);
+    }
+    return crc;
+}
+
+/**********************************************************************************************************************/
+/** SC-32 (IEC 61375-2-3 B.7) byte-by-byte reference implementation.
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             new CRC register value
+ */
+
+static UINT32 vos_sc32Bytewise (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    UINT32 i;
+    for (i = 0u; i < dataLen; i++)
+    {
+        crc = pgm_read_dword(&sc32_table[((UINT32)(crc >> 24u) ^ pData[i]) & 0xffu]) ^ (crc << 8);
+    }
+    return crc;
+}
+
+#if VOS_CRC_SLICE_BY_8
+/**********************************************************************************************************************/
+/** Build the slice-by-8 tables from the byte tables.
+ *  Entry [k][i] is the CRC of byte i followed by k zero bytes.
+ */
+
+static void vos_crcInitTables (void)
+{
+    UINT32 i, k;
+
+    for (i = 0u; i < 256u; i++)
+    {
+        fcs_table8[0][i]    = pgm_read_dword(&fcs_table[i]);
+        sc32_table8[0][i]   = pgm_read_dword(&sc32_table[i]);
+    }
+    for (k = 1u; k < 8u; k++)
+    {
+        for (i = 0u; i < 256u; i++)
+        {
+            fcs_table8[k][i] = (fcs_table8[k - 1u][i] >> 8u) ^ fcs_table8[0][fcs_table8[k - 1u][i] & 0xffu];
+            sc32_table8[k][i] = (sc32_table8[k - 1u][i] << 8u) ^ sc32_table8[0][sc32_table8[k - 1u][i] >> 24u];
+        }
+    }
+    sCrcTablesValid = TRUE;
+}
+
+/**********************************************************************************************************************/
+/** CRC32 (IEEE802.3) slice-by-8 implementation, 8 bytes per step.
+ *  Data is read bytewise, so neither alignment nor endianess matter.
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             new CRC register value (not inverted)
+ */
+
+static UINT32 vos_crc32Slice8 (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    UINT32 one, two;
+
+    while (dataLen >= 8u)
+    {
+        one = crc ^ ((UINT32) pData[0] | ((UINT32) pData[1] << 8u) |
+                     ((UINT32) pData[2] << 16u) | ((UINT32) pData[3] << 24u));
+        two = (UINT32) pData[4] | ((UINT32) pData[5] << 8u) |
+              ((UINT32) pData[6] << 16u) | ((UINT32) pData[7] << 24u);
+        crc = fcs_table8[7][one & 0xffu] ^ fcs_table8[6][(one >> 8u) & 0xffu] ^
+              fcs_table8[5][(one >> 16u) & 0xffu] ^ fcs_table8[4][one >> 24u] ^
+              fcs_table8[3][two & 0xffu] ^ fcs_table8[2][(two >> 8u) & 0xffu] ^
+              fcs_table8[1][(two >> 16u) & 0xffu] ^ fcs_table8[0][two >> 24u];
+        pData   += 8u;
+        dataLen -= 8u;
+    }
+    return vos_crc32Bytewise(crc, pData, dataLen);
+}
+
+/**********************************************************************************************************************/
+/** SC-32 (IEC 61375-2-3 B.7) slice-by-8 implementation, 8 bytes per step.
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             new CRC register value
+ */
+
+static UINT32 vos_sc32Slice8 (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    UINT32 one, two;
+
+    while (dataLen >= 8u)
+    {
+        one = crc ^ (((UINT32) pData[0] << 24u) | ((UINT32) pData[1] << 16u) |
+                     ((UINT32) pData[2] << 8u) | (UINT32) pData[3]);
+        two = ((UINT32) pData[4] << 24u) | ((UINT32) pData[5] << 16u) |
+              ((UINT32) pData[6] << 8u) | (UINT32) pData[7];
+        crc = sc32_table8[7][one >> 24u] ^ sc32_table8[6][(one >> 16u) & 0xffu] ^
+              sc32_table8[5][(one >> 8u) & 0xffu] ^ sc32_table8[4][one & 0xffu] ^
+              sc32_table8[3][two >> 24u] ^ sc32_table8[2][(two >> 16u) & 0xffu] ^
+              sc32_table8[1][(two >> 8u) & 0xffu] ^ sc32_table8[0][two & 0xffu];
+        pData   += 8u;
+        dataLen -= 8u;
+    }
+    return vos_sc32Bytewise(crc, pData, dataLen);
+}
+#endif
+
+#if VOS_CRC_PCLMUL
+/* Bit-reflected folding constants x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32), x^64 mod P(x),
+   P(x) and the Barrett constant u' */
+static const UINT64 __attribute__((aligned(16))) k1k2[2] = {0x0154442bd4ull, 0x01c6e41596ull};
+static const UINT64 __attribute__((aligned(16))) k3k4[2] = {0x01751997d0ull, 0x00ccaa009eull};
+static const UINT64 __attribute__((aligned(16))) k5k0[2] = {0x0163cd6124ull, 0x0000000000ull};
+static const UINT64 __attribute__((aligned(16))) poly[2] = {0x01db710641ull, 0x01f7011641ull};
+
+/**********************************************************************************************************************/
+/** Reduce 128 folded bits to the CRC32 register value (x^64 mod P(x), then Barrett).
+ *
+ *  @param[in]          x1          folded 128 bits
+ *  @retval             CRC register value (not inverted)
+ */
+
+__attribute__((target("sse4.1,pclmul")))
+static inline UINT32 vos_crc32PclmulReduce (
+    __m128i x1)
+{
+    __m128i x0, x2, x3;
+
+    /* Reduce 128 to 64 bits */
+    x0  = _mm_load_si128((const __m128i *)(const void *)k3k4);
+    x2  = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3  = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1  = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0  = _mm_loadl_epi64((const __m128i *)(const void *)k5k0);
+    x2  = _mm_srli_si128(x1, 4);
+    x1  = _mm_and_si128(x1, x3);
+    x1  = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1  = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduction to 32 bits */
+    x0  = _mm_load_si128((const __m128i *)(const void *)poly);
+    x2  = _mm_and_si128(x1, x3);
+    x2  = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2  = _mm_and_si128(x2, x3);
+    x2  = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1  = _mm_xor_si128(x1, x2);
+    return (UINT32) _mm_extract_epi32(x1, 1);
+}
+
+/**********************************************************************************************************************/
+/** CRC32 (IEEE802.3) by carry-less multiplication folding (Intel, "Fast CRC Computation for Generic Polynomials
+ *  Using PCLMULQDQ Instruction"), 64 bytes per step. Blocks of 16 to 63 bytes are folded 16 bytes per step, shorter
+ *  blocks and the tail are handled by the table implementation.
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             new CRC register value (not inverted)
+ */
+
+__attribute__((target("sse4.1,pclmul")))
+static UINT32 vos_crc32Pclmul (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    if (dataLen < 16u)
+    {
+        return vos_crc32Slice8(crc, pData, dataLen);
+    }
+    if (dataLen < 64u)
+    {
+        x1  = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)pData), _mm_cvtsi32_si128((int) crc));
+        x0  = _mm_load_si128((const __m128i *)(const void *)k3k4);
+        pData   += 16u;
+        dataLen -= 16u;
+        while (dataLen >= 16u)
+        {
+            x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1  = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)(const void *)pData)), x5);
+            pData   += 16u;
+            dataLen -= 16u;
+        }
+        return vos_crc32Slice8(vos_crc32PclmulReduce(x1), pData, dataLen);
+    }
+
+    x1  = _mm_loadu_si128((const __m128i *)(const void *)(pData + 0x00u));
+    x2  = _mm_loadu_si128((const __m128i *)(const void *)(pData + 0x10u));
+    x3  = _mm_loadu_si128((const __m128i *)(const void *)(pData + 0x20u));
+    x4  = _mm_loadu_si128((const __m128i *)(const void *)(pData + 0x30u));
+    x1  = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+    x0  = _mm_load_si128((const __m128i *)(const void *)k1k2);
+    pData   += 64u;
+    dataLen -= 64u;
+
+    /* Fold four lanes 64 bytes at a time */
+    while (dataLen >= 64u)
+    {
+        x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6  = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7  = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8  = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2  = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3  = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4  = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1  = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(const void *)(pData + 0x00u)));
+        x2  = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(const void *)(pData + 0x10u)));
+        x3  = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(const void *)(pData + 0x20u)));
+        x4  = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(const void *)(pData + 0x30u)));
+        pData   += 64u;
+        dataLen -= 64u;
+    }
+
+    /* Fold the four lanes into one */
+    x0  = _mm_load_si128((const __m128i *)(const void *)k3k4);
+    x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1  = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1  = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1  = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Fold remaining 16 byte blocks */
+    while (dataLen >= 16u)
+    {
+        x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1  = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)(const void *)pData)), x5);
+        pData   += 16u;
+        dataLen -= 16u;
+    }
+
+    return vos_crc32Slice8(vos_crc32PclmulReduce(x1), pData, dataLen);
+}
+
+/**********************************************************************************************************************/
+/** SC-32 (IEC 61375-2-3 B.7) by carry-less multiplication folding, 64 bytes per step.
+ *  SC-32 is not bit-reflected: the blocks are loaded big-endian and folded by x^D mod P(x). The folded 128 bits R
+ *  are reduced by the table implementation, the SC-32 of R with start value 0 being R * x^32 mod P(x).
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             new CRC register value
+ */
+
+__attribute__((target("sse4.1,pclmul")))
+static UINT32 vos_sc32Pclmul (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    /* x^(4*128) and x^(4*128+64), x^128 and x^(128+64) mod P(x) = 0x1f4acfb13 */
+    static const UINT64 __attribute__((aligned(16))) k512[2]    = {0xe1d04ae3ull, 0x5ecf6cd1ull};
+    static const UINT64 __attribute__((aligned(16))) k128[2]    = {0x052e2a05ull, 0xbda13578ull};
+    UINT8   __attribute__((aligned(16))) rest[16];
+    __m128i swap, x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    if (dataLen < 64u)
+    {
+        return vos_sc32Slice8(crc, pData, dataLen);
+    }
+
+    swap    = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    x1      = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(pData + 0x00u)), swap);
+    x2      = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(pData + 0x10u)), swap);
+    x3      = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(pData + 0x20u)), swap);
+    x4      = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(pData + 0x30u)), swap);
+    x1      = _mm_xor_si128(x1, _mm_set_epi32((int) crc, 0, 0, 0));
+    x0      = _mm_load_si128((const __m128i *)(const void *)k512);
+    pData   += 64u;
+    dataLen -= 64u;
+
+    /* Fold four lanes 64 bytes at a time */
+    while (dataLen >= 64u)
+    {
+        x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6  = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7  = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8  = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2  = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3  = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4  = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1  = _mm_xor_si128(_mm_xor_si128(x1, x5),
+                            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(pData + 0x00u)), swap));
+        x2  = _mm_xor_si128(_mm_xor_si128(x2, x6),
+                            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(pData + 0x10u)), swap));
+        x3  = _mm_xor_si128(_mm_xor_si128(x3, x7),
+                            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(pData + 0x20u)), swap));
+        x4  = _mm_xor_si128(_mm_xor_si128(x4, x8),
+                            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(pData + 0x30u)), swap));
+        pData   += 64u;
+        dataLen -= 64u;
+    }
+
+    /* Fold the four lanes into one */
+    x0  = _mm_load_si128((const __m128i *)(const void *)k128);
+    x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1  = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1  = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1  = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Fold remaining 16 byte blocks */
+    while (dataLen >= 16u)
+    {
+        x5  = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1  = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1  = _mm_xor_si128(_mm_xor_si128(x1, x5),
+                            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)pData), swap));
+        pData   += 16u;
+        dataLen -= 16u;
+    }
+
+    /* Reduce the 128 bits by the tables */
+    _mm_store_si128((__m128i *)(void *)rest, _mm_shuffle_epi8(x1, swap));
+    crc = vos_sc32Slice8(0u, rest, 16u);
+
+    return vos_sc32Slice8(crc, pData, dataLen);
+}
+#endif
+
+#if VOS_CRC_ARMV8
+/**********************************************************************************************************************/
+/** CRC32 (IEEE802.3) using the ARMv8 CRC32 instructions, 8 bytes per step.
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             new CRC register value (not inverted)
+ */
+
+static UINT32 vos_crc32Armv8 (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    UINT64 word;
+
+    while (dataLen >= 8u)
+    {
+        memcpy(&word, pData, sizeof(word));
+#ifdef B_ENDIAN
+        word = __builtin_bswap64(word);
+#endif
+        crc     = __crc32d(crc, word);
+        pData   += 8u;
+        dataLen -= 8u;
+    }
+    while (dataLen > 0u)
+    {
+        crc = __crc32b(crc, *pData++);
+        dataLen--;
+    }
+    return crc;
+}
+#endif
+
+#if VOS_CRC_PMULL
+/**********************************************************************************************************************/
+/** Load 16 bytes as a big-endian 128 bit polynomial (lane 1 holds the higher coefficients)  */
+static inline uint64x2_t vos_sc32Load (
+    const UINT8 *pData)
+{
+    uint8x16_t v = vrev64q_u8(vld1q_u8(pData));
+
+    return vreinterpretq_u64_u8(vextq_u8(v, v, 8));
+}
+
+/** Multiply a 128 bit polynomial by x^D mod P(x) (k: x^D, x^(D+64)) and add the next block  */
+static inline uint64x2_t vos_sc32Fold (
+    uint64x2_t  x,
+    poly64x2_t  k,
+    uint64x2_t  next)
+{
+    poly64x2_t  p   = vreinterpretq_p64_u64(x);
+    uint64x2_t  lo  = vreinterpretq_u64_p128(vmull_p64(vgetq_lane_p64(p, 0), vgetq_lane_p64(k, 0)));
+    uint64x2_t  hi  = vreinterpretq_u64_p128(vmull_high_p64(p, k));
+
+    return veorq_u64(veorq_u64(lo, hi), next);
+}
+
+/**********************************************************************************************************************/
+/** SC-32 (IEC 61375-2-3 B.7) by carry-less multiplication folding (ARMv8 PMULL), 64 bytes per step.
+ *  Same folding as vos_sc32Pclmul().
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          pData       Pointer to data.
+ *  @param[in]          dataLen     length in bytes of data.
+ *  @retval             new CRC register value
+ */
+
+static UINT32 vos_sc32Pmull (
+    UINT32      crc,
+    const UINT8 *pData,
+    UINT32      dataLen)
+{
+    static const UINT64 k512[2] = {0xe1d04ae3ull, 0x5ecf6cd1ull};
+    static const UINT64 k128[2] = {0x052e2a05ull, 0xbda13578ull};
+    UINT8       rest[16];
+    uint64x2_t  x1, x2, x3, x4;
+    poly64x2_t  k;
+    uint8x16_t  v;
+
+    if (dataLen < 64u)
+    {
+        return vos_sc32Slice8(crc, pData, dataLen);
+    }
+
+    x1  = veorq_u64(vos_sc32Load(pData), vcombine_u64(vcreate_u64(0u), vcreate_u64((UINT64) crc << 32u)));
+    x2  = vos_sc32Load(pData + 0x10u);
+    x3  = vos_sc32Load(pData + 0x20u);
+    x4  = vos_sc32Load(pData + 0x30u);
+    k   = vreinterpretq_p64_u64(vld1q_u64(k512));
+    pData   += 64u;
+    dataLen -= 64u;
+
+    /* Fold four lanes 64 bytes at a time */
+    while (dataLen >= 64u)
+    {
+        x1  = vos_sc32Fold(x1, k, vos_sc32Load(pData + 0x00u));
+        x2  = vos_sc32Fold(x2, k, vos_sc32Load(pData + 0x10u));
+        x3  = vos_sc32Fold(x3, k, vos_sc32Load(pData + 0x20u));
+        x4  = vos_sc32Fold(x4, k, vos_sc32Load(pData + 0x30u));
+        pData   += 64u;
+        dataLen -= 64u;
+    }
+
+    /* Fold the four lanes into one, then the remaining 16 byte blocks */
+    k   = vreinterpretq_p64_u64(vld1q_u64(k128));
+    x1  = vos_sc32Fold(x1, k, x2);
+    x1  = vos_sc32Fold(x1, k, x3);
+    x1  = vos_sc32Fold(x1, k, x4);
+    while (dataLen >= 16u)
+    {
+        x1  = vos_sc32Fold(x1, k, vos_sc32Load(pData));
+        pData   += 16u;
+        dataLen -= 16u;
+    }
+
+    /* Reduce the 128 bits by the tables */
+    v = vreinterpretq_u8_u64(x1);
+    vst1q_u8(rest, vrev64q_u8(vextq_u8(v, v, 8)));
+    crc = vos_sc32Slice8(0u, rest, 16u);
+
+    return vos_sc32Slice8(crc, pData, dataLen);
+}
+#endif
+
+#if VOS_CRC_PCLMUL
+/**********************************************************************************************************************/
+/** CRC32 (IEEE802.3) of several buffers by carry-less multiplication folding with VPCLMULQDQ, the four 128 bit lanes
+ *  of an AVX-512 register holding the folding state of four buffers. Two registers are folded side by side, so eight
+ *  buffers are in flight. The 128 bits of each lane are reduced as in vos_crc32Pclmul(), the tail by the tables.
+ *  Buffers shorter than 16 bytes and those beyond the last group of four are computed by vos_crc32Pclmul().
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          ppData      Pointers to the buffers.
+ *  @param[in]          dataLen     length in bytes of each buffer.
+ *  @param[in]          noOfBufs    number of buffers.
+ *  @param[out]         pCrc        new CRC register value of each buffer (not inverted)
+ */
+
+__attribute__((target("avx512f,avx512bw,vpclmulqdq,sse4.1,pclmul")))
+static void vos_crc32MultiVpclmul (
+    UINT32              crc,
+    const UINT8 *const  ppData[],
+    UINT32              dataLen,
+    UINT32              noOfBufs,
+    UINT32              pCrc[])
+{
+    const __m512i   fold    = _mm512_broadcast_i32x4(_mm_load_si128((const __m128i *)(const void *)k3k4));
+    const __m512i   k5      = _mm512_broadcast_i32x4(_mm_loadl_epi64((const __m128i *)(const void *)k5k0));
+    const __m512i   p       = _mm512_broadcast_i32x4(_mm_load_si128((const __m128i *)(const void *)poly));
+    const __m512i   mask    = _mm512_broadcast_i32x4(_mm_setr_epi32(~0, 0, ~0, 0));
+    const __m512i   init    = _mm512_broadcast_i32x4(_mm_cvtsi32_si128((int) crc));
+    UINT32 __attribute__((aligned(64))) lanes[2][16];
+    __m512i         x[2], y;
+    UINT32          inLanes = (dataLen < 16u) ? 0u : noOfBufs;
+    UINT32          n, k, g, pos;
+
+    for (n = 0u; n + 4u <= inLanes; n += 4u * g)
+    {
+        g = (n + 8u <= inLanes) ? 2u : 1u;
+        for (k = 0u; k < g; k++)
+        {
+            const UINT8 *const *ppBuf = ppData + n + 4u * k;
+
+            x[k] = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *)(const void *)ppBuf[0]));
+            x[k] = _mm512_inserti32x4(x[k], _mm_loadu_si128((const __m128i *)(const void *)ppBuf[1]), 1);
+            x[k] = _mm512_inserti32x4(x[k], _mm_loadu_si128((const __m128i *)(const void *)ppBuf[2]), 2);
+            x[k] = _mm512_inserti32x4(x[k], _mm_loadu_si128((const __m128i *)(const void *)ppBuf[3]), 3);
+            x[k] = _mm512_xor_si512(x[k], init);
+        }
+        for (pos = 16u; pos + 16u <= dataLen; pos += 16u)
+        {
+            for (k = 0u; k < g; k++)
+            {
+                const UINT8 *const *ppBuf = ppData + n + 4u * k;
+
+                y = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *)(const void *)(ppBuf[0] + pos)));
+                y = _mm512_inserti32x4(y, _mm_loadu_si128((const __m128i *)(const void *)(ppBuf[1] + pos)), 1);
+                y = _mm512_inserti32x4(y, _mm_loadu_si128((const __m128i *)(const void *)(ppBuf[2] + pos)), 2);
+                y = _mm512_inserti32x4(y, _mm_loadu_si128((const __m128i *)(const void *)(ppBuf[3] + pos)), 3);
+                x[k] = _mm512_xor_si512(_mm512_xor_si512(_mm512_clmulepi64_epi128(x[k], fold, 0x00),
+                                                         _mm512_clmulepi64_epi128(x[k], fold, 0x11)), y);
+            }
+        }
+        for (k = 0u; k < g; k++)
+        {
+            /* Reduce 128 to 64 bits */
+            y       = _mm512_clmulepi64_epi128(x[k], fold, 0x10);
+            x[k]    = _mm512_xor_si512(_mm512_bsrli_epi128(x[k], 8), y);
+            y       = _mm512_bsrli_epi128(x[k], 4);
+            x[k]    = _mm512_xor_si512(_mm512_clmulepi64_epi128(_mm512_and_si512(x[k], mask), k5, 0x00), y);
+
+            /* Barrett reduction to 32 bits */
+            y       = _mm512_clmulepi64_epi128(_mm512_and_si512(x[k], mask), p, 0x10);
+            y       = _mm512_clmulepi64_epi128(_mm512_and_si512(y, mask), p, 0x00);
+            _mm512_store_si512((void *) lanes[k], _mm512_xor_si512(x[k], y));
+        }
+        for (k = 0u; k < 4u * g; k++)
+        {
+            pCrc[n + k] = vos_crc32Slice8(lanes[k / 4u][4u * (k % 4u) + 1u], ppData[n + k] + pos, dataLen - pos);
+        }
+    }
+    for (; n < noOfBufs; n++)
+    {
+        pCrc[n] = vos_crc32Pclmul(crc, ppData[n], dataLen);
+    }
+}
+#endif
+#if VOS_CRC_ARMV8
+/**********************************************************************************************************************/
+/** CRC32 (IEEE802.3) of several buffers with the ARMv8 CRC32 instructions, 4 buffers interleaved.
+ *  NEON has no table gather; interleaving the independent CRC chains hides the latency of the CRC32 instruction.
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          ppData      Pointers to the buffers.
+ *  @param[in]          dataLen     length in bytes of each buffer.
+ *  @param[in]          noOfBufs    number of buffers.
+ *  @param[out]         pCrc        new CRC register value of each buffer (not inverted)
+ */
+
+static void vos_crc32MultiArmv8 (
+    UINT32              crc,
+    const UINT8 *const  ppData[],
+    UINT32              dataLen,
+    UINT32              noOfBufs,
+    UINT32              pCrc[])
+{
+    UINT32  c[4];
+    UINT64  word;
+    UINT32  n, k, pos;
+
+    for (n = 0u; n + 4u <= noOfBufs; n += 4u)
+    {
+        c[0] = c[1] = c[2] = c[3] = crc;
+        for (pos = 0u; pos + 8u <= dataLen; pos += 8u)
+        {
+            for (k = 0u; k < 4u; k++)
+            {
+                memcpy(&word, ppData[n + k] + pos, sizeof(word));
+#ifdef B_ENDIAN
+                word = __builtin_bswap64(word);
+#endif
+                c[k] = __crc32d(c[k], word);
+            }
+        }
+        for (k = 0u; k < 4u; k++)
+        {
+            pCrc[n + k] = vos_crc32Armv8(c[k], ppData[n + k] + pos, dataLen - pos);
+        }
+    }
+    for (; n < noOfBufs; n++)
+    {
+        pCrc[n] = vos_crc32Armv8(crc, ppData[n], dataLen);
+    }
+}
+#endif
+
+/** CRC update functions in use, the byte-by-byte reference until vos_crcSelect() is called  */
+static UINT32   (*sCrc32Update)(UINT32 crc, const UINT8 *pData, UINT32 dataLen) = vos_crc32Bytewise;
+static UINT32   (*sSc32Update)(UINT32 crc, const UINT8 *pData, UINT32 dataLen)  = vos_sc32Bytewise;
+
+/**********************************************************************************************************************/
+/** CRC32 (IEEE802.3) of several buffers, one after the other with the selected implementation.
+ *
+ *  @param[in]          crc         Current CRC register value.
+ *  @param[in]          ppData      Pointers to the buffers.
+ *  @param[in]          dataLen     length in bytes of each buffer.
+ *  @param[in]          noOfBufs    number of buffers.
+ *  @param[out]         pCrc        new CRC register value of each buffer (not inverted)
+ */
+
+static void vos_crc32MultiSerial (
+    UINT32              crc,
+    const UINT8 *const  ppData[],
+    UINT32              dataLen,
+    UINT32              noOfBufs,
+    UINT32              pCrc[])
+{
+    UINT32 n;
+
+    for (n = 0u; n < noOfBufs; n++)
+    {
+        pCrc[n] = sCrc32Update(crc, ppData[n], dataLen);
+    }
+}
+
+/** Multi-buffer CRC function in use  */
+static void     (*sCrc32MultiUpdate)(UINT32 crc, const UINT8 *const ppData[], UINT32 dataLen, UINT32 noOfBufs,
+                                     UINT32 pCrc[]) = vos_crc32MultiSerial;
+
 /**********************************************************************************************************************/
 /** Pre-compute alignment and endianess.
  *
@@ -448,6 +1516,14 @@ VOS_ERR_T vos_init (
     {
         return VOS_UNKNOWN_ERR;
     }
+#if VOS_LOG_DEFERRED
+    vos_logStart();
+#endif
+    /* Use the fastest CRC implementation available */
+    if (vos_crcSelect(VOS_CRC_HW) != VOS_NO_ERR)
+    {
+        (void) vos_crcSelect(VOS_CRC_SLICE8);
+    }
     return vos_sockInit();
 }
 
@@ -458,11 +1534,96 @@ VOS_ERR_T vos_init (
  */
 EXT_DECL void vos_terminate (void)
 {
+#if VOS_LOG_DEFERRED
+    vos_logStop();
+#endif
     vos_sockTerm();
     vos_threadTerm();
     vos_memDelete(NULL);
 }
 
+/**********************************************************************************************************************/
+/** Select the CRC implementation.
+ *  vos_init() selects the hardware implementation if available, slice-by-8 otherwise. The byte-by-byte table
+ *  implementation is the reference and is used until vos_crcSelect() is called.
+ *  SC-32 has no hardware implementation, VOS_CRC_HW selects slice-by-8 for it.
+ *  VOS_CRC_HW also selects the SIMD kernel of vos_crc32Multi() if the CPU has one (AVX-512, AVX2, ARMv8 CRC32).
+ *
+ *  @param[in]          impl        implementation to use
+ *  @retval             VOS_NO_ERR      no error
+ *  @retval             VOS_PARAM_ERR   implementation not available on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_crcSelect (
+    VOS_CRC_IMPL_T impl)
+{
+    switch (impl)
+    {
+        case VOS_CRC_BYTEWISE:
+            sCrc32Update        = vos_crc32Bytewise;
+            sSc32Update         = vos_sc32Bytewise;
+            sCrc32MultiUpdate   = vos_crc32MultiSerial;
+            return VOS_NO_ERR;
+#if VOS_CRC_SLICE_BY_8
+        case VOS_CRC_SLICE8:
+            if (!sCrcTablesValid)
+            {
+                vos_crcInitTables();
+            }
+            sCrc32Update        = vos_crc32Slice8;
+            sSc32Update         = vos_sc32Slice8;
+            sCrc32MultiUpdate   = vos_crc32MultiSerial;
+            return VOS_NO_ERR;
+#endif
+#if VOS_CRC_PCLMUL
+        case VOS_CRC_HW:
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("pclmul") || !__builtin_cpu_supports("sse4.1"))
+            {
+                return VOS_PARAM_ERR;
+            }
+            if (!sCrcTablesValid)
+            {
+                vos_crcInitTables();
+            }
+            sCrc32Update    = vos_crc32Pclmul;
+            sSc32Update     = vos_sc32Pclmul;
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                __builtin_cpu_supports("vpclmulqdq"))
+            {
+                sCrc32MultiUpdate = vos_crc32MultiVpclmul;
+            }
+            else
+            {
+                sCrc32MultiUpdate = vos_crc32MultiSerial;
+            }
+            return VOS_NO_ERR;
+#elif VOS_CRC_ARMV8
+        case VOS_CRC_HW:
+#if VOS_CRC_PMULL
+            if (!sCrcTablesValid)
+            {
+                vos_crcInitTables();
+            }
+            sSc32Update     = vos_sc32Pmull;
+#elif VOS_CRC_SLICE_BY_8
+            if (!sCrcTablesValid)
+            {
+                vos_crcInitTables();
+            }
+            sSc32Update     = vos_sc32Slice8;
+#else
+            sSc32Update     = vos_sc32Bytewise;
+#endif
+            sCrc32Update        = vos_crc32Armv8;
+            sCrc32MultiUpdate   = vos_crc32MultiArmv8;
+            return VOS_NO_ERR;
+#endif
+        default:
+            return VOS_PARAM_ERR;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Compute crc32 according to IEEE802.3. / to IEC 61375-2-3 A.3
  *  Note: Returned CRC is inverted
@@ -478,13 +1639,34 @@ UINT32 vos_crc32 (
     const UINT8 *pData,
     UINT32      dataLen)
 {
+    return ~sCrc32Update(crc, pData, dataLen);
+}
 
-    UINT32 i;
-    for (i = 0u; i < dataLen; i++)
+/**********************************************************************************************************************/
+/** Compute crc32 according to IEEE802.3 of several buffers of the same length.
+ *  Note: Returned CRCs are inverted
+ *
+ *  @param[in]          crc         Initial value.
+ *  @param[in]          ppData      Pointers to the buffers.
+ *  @param[in]          dataLen     length in bytes of each buffer.
+ *  @param[in]          noOfBufs    number of buffers.
+ *  @param[out]         pCrc        crc32 according to IEEE802.3 of each buffer
+ */
+
+void vos_crc32Multi (
+    UINT32              crc,
+    const UINT8 *const  ppData[],
+    UINT32              dataLen,
+    UINT32              noOfBufs,
+    UINT32              pCrc[])
+{
+    UINT32 n;
+
+    sCrc32MultiUpdate(crc, ppData, dataLen, noOfBufs, pCrc);
+    for (n = 0u; n < noOfBufs; n++)
     {
-        crc = (crc >> 8u) ^ pgm_read_dword(&fcs_table[(crc ^ pData[i]) & 0xffu]);
+        pCrc[n] = ~pCrc[n];
     }
-    return ~crc;
 }
 
 /**********************************************************************************************************************/
@@ -502,13 +1684,7 @@ UINT32 vos_sc32 (
     const UINT8 *pData,
     UINT32      dataLen)
 {
-
-    UINT32 i;
-    for (i = 0u; i < dataLen; i++)
-    {
-        crc = pgm_read_dword(&sc32_table[((UINT32)(crc >> 24u) ^ pData[i]) & 0xffu]) ^ (crc << 8);
-    }
-    return crc;
+    return sSc32Update(crc, pData, dataLen);
 }
 
 /**********************************************************************************************************************/
@@ -566,3 +1742,107 @@ EXT_DECL const CHAR8 *vos_getErrorString (VOS_ERR_T error)
 #endif
     return buf;
 }
+
+#if VOS_LOG_DEFERRED
+/**********************************************************************************************************************/
+/** Store a log record for the background thread.
+ *  Called by vos_printLog(). Integer, floating point and pointer arguments are stored as they are, strings are
+ *  copied. Without running log thread the message is formatted and output at once.
+ *
+ *  @param[in,out]      pSite           call site
+ *  @param[in]          level           log category
+ *  @param[in]          ...             arguments of the format
+ */
+EXT_DECL void vos_logDeferred (
+    VOS_LOG_SITE_T  *pSite,
+    VOS_LOG_T       level,
+    ...)
+{
+    VOS_LOG_REC_T   localRec;
+    VOS_LOG_REC_T   *pRec       = &localRec;
+    UINT32          suppressed  = 0u;
+    UINT32          pos         = 0u;
+    BOOL8           deferred    = __atomic_load_n(&sLogRun, __ATOMIC_ACQUIRE);
+    va_list         args;
+
+    /*  Rate limiting of repeated errors and warnings of a call site  */
+    if ((level == VOS_LOG_ERROR) || (level == VOS_LOG_WARNING))
+    {
+        VOS_TIMEVAL_T   now;
+        UINT32          period;
+
+        vos_getTime(&now);
+        period = (UINT32) now.tv_sec / VOS_LOG_RATE_PERIOD;
+        if (__atomic_load_n(&pSite->period, __ATOMIC_RELAXED) != period)
+        {
+            __atomic_store_n(&pSite->period, period, __ATOMIC_RELAXED);
+            __atomic_store_n(&pSite->count, 0u, __ATOMIC_RELAXED);
+        }
+        if (__atomic_add_fetch(&pSite->count, 1u, __ATOMIC_RELAXED) > VOS_LOG_RATE_BURST)
+        {
+            (void) __atomic_add_fetch(&pSite->suppressed, 1u, __ATOMIC_RELAXED);
+            return;
+        }
+        suppressed = __atomic_exchange_n(&pSite->suppressed, 0u, __ATOMIC_RELAXED);
+    }
+
+    if (deferred)
+    {
+        pos = __atomic_load_n(&sLogTail, __ATOMIC_RELAXED);
+        for (;; )
+        {
+            INT32 diff;
+
+            pRec    = &sLogRing[pos & (VOS_LOG_RING_SIZE - 1u)];
+            diff    = (INT32) (__atomic_load_n(&pRec->seq, __ATOMIC_ACQUIRE) - pos);
+            if (diff == 0)
+            {
+                if (__atomic_compare_exchange_n(&sLogTail, &pos, pos + 1u, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                (void) __atomic_add_fetch(&sLogDropped, 1u + suppressed, __ATOMIC_RELAXED);
+                return;
+            }
+            else
+            {
+                pos = __atomic_load_n(&sLogTail, __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    pRec->level         = level;
+    pRec->pSite         = pSite;
+    pRec->suppressed    = suppressed;
+    va_start(args, level);
+    vos_logCapture(pRec, &args);
+    va_end(args);
+
+    if (deferred)
+    {
+        __atomic_store_n(&pRec->seq, pos + 1u, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        vos_logOutput(pRec);
+    }
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Wait until all deferred log records have been output.
+ *  Returns at once without deferred logging.
+ */
+EXT_DECL void vos_logFlush (void)
+{
+#if VOS_LOG_DEFERRED
+    while (__atomic_load_n(&sLogRun, __ATOMIC_ACQUIRE)
+           && (__atomic_load_n(&sLogHead, __ATOMIC_ACQUIRE) != __atomic_load_n(&sLogTail, __ATOMIC_RELAXED)))
+    {
+        (void) vos_threadDelay(VOS_LOG_FLUSH_INTERVAL);
+    }
+#endif
+}
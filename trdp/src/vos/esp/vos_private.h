@@ -30,6 +30,9 @@
 #include <string.h>
 #include <pthread.h>
 #include <lwip/sockets.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "vos_types.h"
 #include "vos_thread.h"
 
@@ -49,15 +52,42 @@ extern "C" {
 #define VOS_EVOLUTION          0u
 #endif
 
+#ifndef VOS_ESP_STATIC          /**< Static memory build: no heap use by the VOS after start-up (needs
+                                     configSUPPORT_STATIC_ALLOCATION) */
+#define VOS_ESP_STATIC          0
+#endif
+
+#if VOS_ESP_STATIC
+#ifndef VOS_ESP_MEM_SIZE        /**< Size of the memory area of vos_memAlloc in internal RAM, if none is given */
+#define VOS_ESP_MEM_SIZE        (64u * 1024u)
+#endif
+#ifndef VOS_ESP_MAX_THREADS     /**< Number of threads which can be created */
+#define VOS_ESP_MAX_THREADS     4u
+#endif
+#ifndef VOS_ESP_STACK_SIZE      /**< Stack size in bytes of every thread */
+#define VOS_ESP_STACK_SIZE      (4u * 1024u)
+#endif
+
+#define VOS_MUTEX_INITIALIZER   {0u, NULL}
+#endif
+
 struct VOS_MUTEX
 {
     UINT32          magicNo;
+#if VOS_ESP_STATIC
+    SemaphoreHandle_t   mutexId;
+    StaticSemaphore_t   mutexBuffer;
+#else
     pthread_mutex_t mutexId;
+#endif
 };
 
 struct VOS_SEMA
 {
     SemaphoreHandle_t   semHandle;
+#if VOS_ESP_STATIC
+    StaticSemaphore_t   semBuffer;
+#endif
 };
 
 
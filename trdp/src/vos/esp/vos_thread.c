@@ -70,6 +70,73 @@ int             vosThreadInitialised = FALSE;
  *  LOCALS
  */
 
+#if VOS_ESP_STATIC
+/** Statically allocated task: control block and stack in internal RAM  */
+typedef struct
+{
+    StaticTask_t        tcb;
+    StackType_t         stack[VOS_ESP_STACK_SIZE / sizeof(StackType_t)];
+    TaskHandle_t        handle;         /**< NULL: slot was never used          */
+    volatile BOOL8      finished;       /**< thread function has returned       */
+    VOS_THREAD_FUNC_T   pFunction;
+    void                *pArguments;
+} VOS_ESP_TASK_T;
+
+static VOS_ESP_TASK_T   sTasks[VOS_ESP_MAX_THREADS];
+static SemaphoreHandle_t sTaskLock = NULL;
+static StaticSemaphore_t sTaskLockBuffer;
+
+/**********************************************************************************************************************/
+/** Entry of the static tasks: FreeRTOS tasks must not return.
+ *  A finished task suspends itself and is deleted when its slot is reused: a task deleting itself would be
+ *  cleaned up later by the idle task, while its stack might already be reused.
+ *
+ *  @param[in]      pArg            task slot
+ */
+static void espTaskEntry (
+    void *pArg)
+{
+    VOS_ESP_TASK_T *pTask = (VOS_ESP_TASK_T *) pArg;
+
+    pTask->pFunction(pTask->pArguments);
+    pTask->finished = TRUE;
+    for (;; )
+    {
+        vTaskSuspend(NULL);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Take a free task slot.
+ *
+ *  @retval         slot, NULL if all are in use
+ */
+static VOS_ESP_TASK_T *espTaskAlloc (void)
+{
+    VOS_ESP_TASK_T  *pTask = NULL;
+    UINT32          i;
+
+    (void) xSemaphoreTake(sTaskLock, portMAX_DELAY);
+    for (i = 0u; i < VOS_ESP_MAX_THREADS; i++)
+    {
+        if ((sTasks[i].finished == TRUE) && (eTaskGetState(sTasks[i].handle) == eSuspended))
+        {
+            vTaskDelete(sTasks[i].handle);
+            sTasks[i].handle = NULL;
+        }
+        if (sTasks[i].handle == NULL)
+        {
+            pTask           = &sTasks[i];
+            pTask->handle   = (TaskHandle_t) pTask;     /* reserved until created */
+            pTask->finished = FALSE;
+            break;
+        }
+    }
+    (void) xSemaphoreGive(sTaskLock);
+    return pTask;
+}
+#endif
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -146,7 +213,9 @@ EXT_DECL void vos_cyclicThread (
                          (unsigned int)interval, (long)afterCall.tv_sec);
         }
         (void) vos_threadDelay(waitingTime);
+#if !VOS_ESP_STATIC
         pthread_testcancel();
+#endif
     }
 }
 
@@ -161,6 +230,15 @@ EXT_DECL void vos_cyclicThread (
 EXT_DECL VOS_ERR_T vos_threadInit (
     void)
 {
+#if VOS_ESP_STATIC
+    vos_printLog(VOS_LOG_INFO, "static VOS: %u bytes memory area, %u threads of %u bytes (%u bytes)\n",
+                 (unsigned int) VOS_ESP_MEM_SIZE, (unsigned int) VOS_ESP_MAX_THREADS,
+                 (unsigned int) VOS_ESP_STACK_SIZE, (unsigned int) sizeof(sTasks));
+    if (sTaskLock == NULL)
+    {
+        sTaskLock = xSemaphoreCreateMutexStatic(&sTaskLockBuffer);
+    }
+#endif
     vosThreadInitialised = TRUE;
 
     return VOS_NO_ERR;
@@ -208,10 +286,15 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     VOS_THREAD_FUNC_T       pFunction,
     void                    *pArguments)
 {
+#if VOS_ESP_STATIC
+    VOS_ESP_TASK_T      *pTask;
+    UBaseType_t         espPriority;
+#else
     pthread_t           hThread;
     pthread_attr_t      threadAttrib;
     struct sched_param  schedParam;  /* scheduling priority */
     int         retCode;
+#endif
 
     if (!vosThreadInitialised)
     {
@@ -233,6 +316,36 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
         return VOS_INIT_ERR;
     }
 
+#if VOS_ESP_STATIC
+    (void) policy;
+    if (stackSize > VOS_ESP_STACK_SIZE)
+    {
+        vos_printLog(VOS_LOG_ERROR, "%s stack of %u bytes exceeds VOS_ESP_STACK_SIZE\n", pName, stackSize);
+        return VOS_PARAM_ERR;
+    }
+    pTask = espTaskAlloc();
+    if (pTask == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "%s no thread left (VOS_ESP_MAX_THREADS)\n", pName);
+        return VOS_THREAD_ERR;
+    }
+
+    /* 1...255 onto the FreeRTOS priorities above idle */
+    espPriority = 1u + ((UBaseType_t) priority * (configMAX_PRIORITIES - 2u)) / 255u;
+
+    pTask->pFunction    = pFunction;
+    pTask->pArguments   = pArguments;
+    pTask->handle       = xTaskCreateStatic(espTaskEntry, pName, VOS_ESP_STACK_SIZE / sizeof(StackType_t),
+                                            pTask, espPriority, pTask->stack, &pTask->tcb);
+    if (pTask->handle == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "%s xTaskCreateStatic() failed\n", pName);
+        return VOS_THREAD_ERR;
+    }
+    *pThread = (VOS_THREAD_T) pTask->handle;
+    return VOS_NO_ERR;
+#else
+
     /* Initialize thread attributes to default values */
     retCode = pthread_attr_init(&threadAttrib);
     if (retCode != 0)
@@ -351,6 +464,44 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
         return VOS_THREAD_ERR;
     }
     return VOS_NO_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Create a thread bound to a set of CPUs.
+ *  CPU affinity is not supported on ESP32, cpuMask is ignored.
+ *
+ *  @param[out]     pThread         Pointer to returned thread handle
+ *  @param[in]      pName           Pointer to name of the thread (optional)
+ *  @param[in]      policy          Scheduling policy (FIFO, Round Robin or other)
+ *  @param[in]      priority        Scheduling priority (1...255 (highest), default 0)
+ *  @param[in]      interval        Interval for cyclic threads in us (optional)
+ *  @param[in]      stackSize       Minimum stacksize, default 0: 16kB
+ *  @param[in]      cpuMask         CPUs the thread may run on (bit 0: CPU 0), 0: all
+ *  @param[in]      pFunction       Pointer to the thread function
+ *  @param[in]      pArguments      Pointer to the thread function parameters
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  thread creation error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadCreateAffine (
+    VOS_THREAD_T            *pThread,
+    const CHAR8             *pName,
+    VOS_THREAD_POLICY_T     policy,
+    VOS_THREAD_PRIORITY_T   priority,
+    UINT32                  interval,
+    UINT32                  stackSize,
+    UINT32                  cpuMask,
+    VOS_THREAD_FUNC_T       pFunction,
+    void                    *pArguments)
+{
+    if (cpuMask != 0u)
+    {
+        vos_printLog(VOS_LOG_WARNING, "%s CPU affinity not supported, ignored\n", (pName != NULL) ? pName : "");
+    }
+    return vos_threadCreate(pThread, pName, policy, priority, interval, stackSize, pFunction, pArguments);
 }
 
 /**********************************************************************************************************************/
@@ -366,6 +517,39 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
 EXT_DECL VOS_ERR_T vos_threadTerminate (
     VOS_THREAD_T thread)
 {
+#if VOS_ESP_STATIC
+    TaskHandle_t    self = xTaskGetCurrentTaskHandle();
+    UINT32          i;
+
+    if (thread == NULL)
+    {
+        thread = (VOS_THREAD_T) self;
+    }
+    (void) xSemaphoreTake(sTaskLock, portMAX_DELAY);
+    for (i = 0u; (i < VOS_ESP_MAX_THREADS) && (sTasks[i].handle != (TaskHandle_t) thread); i++)
+    {
+        ;
+    }
+    if (i == VOS_ESP_MAX_THREADS)
+    {
+        (void) xSemaphoreGive(sTaskLock);
+        return VOS_THREAD_ERR;
+    }
+    if ((TaskHandle_t) thread == self)
+    {
+        /* Deleted when the slot is reused, see espTaskEntry */
+        sTasks[i].finished = TRUE;
+        (void) xSemaphoreGive(sTaskLock);
+        for (;; )
+        {
+            vTaskSuspend(NULL);
+        }
+    }
+    vTaskDelete((TaskHandle_t) thread);
+    sTasks[i].handle = NULL;
+    (void) xSemaphoreGive(sTaskLock);
+    return VOS_NO_ERR;
+#else
     int retCode;
 
     retCode = pthread_cancel((pthread_t)thread);
@@ -377,6 +561,7 @@ EXT_DECL VOS_ERR_T vos_threadTerminate (
         return VOS_THREAD_ERR;
     }
     return VOS_NO_ERR;
+#endif
 }
 
 
@@ -411,7 +596,11 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
         return VOS_PARAM_ERR;
     }
 
+#if VOS_ESP_STATIC
+    *pThread = (VOS_THREAD_T) xTaskGetCurrentTaskHandle();
+#else
     *pThread = (VOS_THREAD_T *) pthread_self();
+#endif
 
     return VOS_NO_ERR;
 }
@@ -492,6 +681,27 @@ EXT_DECL void vos_getTime (
     }
 }
 
+/**********************************************************************************************************************/
+/** Select the time base of vos_getTime().
+ *  PTP hardware clocks are not supported by this target, only the local clock.
+ *
+ *  @param[in]      pPtpDevice      PTP clock device, NULL for the local clock (default)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_setTimeBase (
+    const CHAR8 *pPtpDevice)
+{
+    if (pPtpDevice == NULL)
+    {
+        return VOS_NO_ERR;
+    }
+    vos_printLogStr(VOS_LOG_ERROR, "vos_setTimeBase() PTP clock not supported\n");
+    return VOS_INIT_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Get a time-stamp string.
  *  Get a time-stamp string for debugging in the form "yyyymmdd-hh:mm:ss.ms"
@@ -759,6 +969,11 @@ EXT_DECL VOS_ERR_T vos_mutexCreate (
         return VOS_MEM_ERR;
     }
 
+#if VOS_ESP_STATIC
+    (void) attr;
+    (*pMutex)->mutexId = xSemaphoreCreateRecursiveMutexStatic(&(*pMutex)->mutexBuffer);
+    err = ((*pMutex)->mutexId == NULL) ? -1 : 0;
+#else
     err = pthread_mutexattr_init(&attr);
     if (err == 0)
     {
@@ -769,6 +984,7 @@ EXT_DECL VOS_ERR_T vos_mutexCreate (
         }
         pthread_mutexattr_destroy(&attr); /*lint !e534 ignore return value */
     }
+#endif
 
     if (err == 0)
     {
@@ -807,6 +1023,11 @@ EXT_DECL VOS_ERR_T vos_mutexLocalCreate (
         return VOS_PARAM_ERR;
     }
 
+#if VOS_ESP_STATIC
+    (void) attr;
+    pMutex->mutexId = xSemaphoreCreateRecursiveMutexStatic(&pMutex->mutexBuffer);
+    err = (pMutex->mutexId == NULL) ? -1 : 0;
+#else
     err = pthread_mutexattr_init(&attr);
     if (err == 0)
     {
@@ -817,6 +1038,7 @@ EXT_DECL VOS_ERR_T vos_mutexLocalCreate (
         }
         pthread_mutexattr_destroy(&attr); /*lint !e534 ignore return value */
     }
+#endif
 
     if (err == 0)
     {
@@ -850,7 +1072,12 @@ EXT_DECL void vos_mutexDelete (
     {
         int err;
 
+#if VOS_ESP_STATIC
+        vSemaphoreDelete(pMutex->mutexId);
+        err = 0;
+#else
         err = pthread_mutex_destroy((pthread_mutex_t *)&pMutex->mutexId);
+#endif
         if (err == 0)
         {
             pMutex->magicNo = 0;
@@ -882,7 +1109,12 @@ EXT_DECL void vos_mutexLocalDelete (
     {
         int err;
 
+#if VOS_ESP_STATIC
+        vSemaphoreDelete(pMutex->mutexId);
+        err = 0;
+#else
         err = pthread_mutex_destroy((pthread_mutex_t *)&pMutex->mutexId);
+#endif
         if (err == 0)
         {
             pMutex->magicNo = 0;
@@ -915,7 +1147,11 @@ EXT_DECL VOS_ERR_T vos_mutexLock (
         return VOS_PARAM_ERR;
     }
 
+#if VOS_ESP_STATIC
+    err = (xSemaphoreTakeRecursive(pMutex->mutexId, portMAX_DELAY) == pdTRUE) ? 0 : EINVAL;
+#else
     err = pthread_mutex_lock((pthread_mutex_t *)&pMutex->mutexId);
+#endif
     if (err != 0)
     {
         vos_printLog(VOS_LOG_ERROR, "Unable to lock Mutex (pthread err=%d)\n", (int)err);
@@ -946,7 +1182,11 @@ EXT_DECL VOS_ERR_T vos_mutexTryLock (
         return VOS_PARAM_ERR;
     }
 
+#if VOS_ESP_STATIC
+    err = (xSemaphoreTakeRecursive(pMutex->mutexId, 0) == pdTRUE) ? 0 : EBUSY;
+#else
     err = pthread_mutex_trylock((pthread_mutex_t *)&pMutex->mutexId);
+#endif
     if (err == EBUSY)
     {
         return VOS_INUSE_ERR;
@@ -981,7 +1221,11 @@ EXT_DECL VOS_ERR_T vos_mutexUnlock (
     {
         int err;
 
+#if VOS_ESP_STATIC
+        err = (xSemaphoreGiveRecursive(pMutex->mutexId) == pdTRUE) ? 0 : EPERM;
+#else
         err = pthread_mutex_unlock((pthread_mutex_t *)&pMutex->mutexId);   /*lint !e455 was not unlocked */
+#endif
         if (err != 0)
         {
             vos_printLog(VOS_LOG_ERROR, "Unable to unlock Mutex (pthread err=%d)\n", (int)err);
@@ -1026,18 +1270,28 @@ EXT_DECL VOS_ERR_T vos_semaCreate (
     else
     {
         /* Parameters are OK */
-        *ppSema = (VOS_SEMA_T) vos_memAlloc(sizeof (SemaphoreHandle_t));
+        *ppSema = (VOS_SEMA_T) vos_memAlloc(sizeof (struct VOS_SEMA));
 
         if (*ppSema == NULL)
         {
             return VOS_MEM_ERR;
         }
-        (*ppSema)->semHandle = (SemaphoreHandle_t) xSemaphoreCreateMutex();
+#if VOS_ESP_STATIC
+        (*ppSema)->semHandle = xSemaphoreCreateBinaryStatic(&(*ppSema)->semBuffer);
+#else
+        (*ppSema)->semHandle = xSemaphoreCreateBinary();
+#endif
+        if ((NULL != (*ppSema)->semHandle) && (initialState == VOS_SEMA_FULL))
+        {
+            (void) xSemaphoreGive((*ppSema)->semHandle);
+        }
 
         if (NULL == (*ppSema)->semHandle)
         {
             /*Semaphore init failed*/
             vos_printLog(VOS_LOG_ERROR, "vos_semaCreate() ERROR (%d) Semaphore could not be initialized\n", errno);
+            vos_memFree(*ppSema);
+            *ppSema = NULL;
             retVal = VOS_SEMA_ERR;
         }
         else
@@ -1070,6 +1324,7 @@ EXT_DECL void vos_semaDelete (VOS_SEMA_T sema)
     {
         vSemaphoreDelete(sema->semHandle);
         sema->semHandle = NULL;
+        vos_memFree(sema);
     }
     return;
 }
@@ -1113,9 +1368,9 @@ EXT_DECL VOS_ERR_T vos_semaTake (
     }
     else
     {
-        rc = xSemaphoreTake(sema->semHandle, timeout / 1000);
+        rc = xSemaphoreTake(sema->semHandle, pdMS_TO_TICKS(timeout / 1000));
     }
-    if (0 != rc)
+    if (pdTRUE != rc)
     {
         /* Could not take Semaphore in time */
         retVal = VOS_SEMA_ERR;
@@ -1128,6 +1383,44 @@ EXT_DECL VOS_ERR_T vos_semaTake (
     return retVal;
 }
 
+/**********************************************************************************************************************/
+/** Take a semaphore until a deadline.
+ *  The deadline is a time returned by vos_getTime(), it is converted to the remaining timeout.
+ *
+ *  @param[in]      sema            semaphore handle
+ *  @param[in]      pDeadline       Latest time to take the semaphore, a past deadline means no wait
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_SEMA_ERR    could not get semaphore in time
+ */
+
+EXT_DECL VOS_ERR_T vos_semaTakeUntil (
+    VOS_SEMA_T          sema,
+    const VOS_TIMEVAL_T *pDeadline)
+{
+    VOS_TIMEVAL_T   remaining;
+    UINT32          timeout = 0u;
+
+    if (pDeadline == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    vos_getTime(&remaining);
+    if (vos_cmpTime(pDeadline, &remaining) > 0)
+    {
+        VOS_TIMEVAL_T now = remaining;
+
+        remaining = *pDeadline;
+        vos_subTime(&remaining, &now);
+        /* round up, a timeout of 0 would not wait at all */
+        timeout = (remaining.tv_sec >= 4000) ? 4000000000u :
+            (UINT32) remaining.tv_sec * 1000000u + (UINT32) remaining.tv_usec;
+        timeout = (timeout == 0u) ? 1u : timeout;
+    }
+    return vos_semaTake(sema, timeout);
+}
+
 
 
 /**********************************************************************************************************************/
@@ -1151,7 +1444,7 @@ EXT_DECL void vos_semaGive (
     {
         /* release semaphore */
         rc = xSemaphoreGive(sema->semHandle);
-        if (0 == rc)
+        if (pdTRUE == rc)
         {
             /* Semaphore released */
         }
@@ -47,16 +47,50 @@ extern "C" {
 #define VOS_EVOLUTION          0u
 #endif
 
+/** Mutexes on Linux futexes: the recursive mutex spins VOS_MUTEX_SPIN attempts before it sleeps in the kernel.
+    0: pthread mutexes and read/write locks */
+#ifndef VOS_MUTEX_FUTEX
+#define VOS_MUTEX_FUTEX     0
+#endif
+#if VOS_MUTEX_FUTEX && !(defined(__linux__) && defined(__GNUC__))
+#undef VOS_MUTEX_FUTEX
+#define VOS_MUTEX_FUTEX     0
+#endif
+
 struct VOS_MUTEX
 {
     UINT32          magicNo;
+#if VOS_MUTEX_FUTEX
+    UINT32          state;          /* futex word, 0: free, 1: locked, 2: locked with waiters */
+    UINT32          count;          /* recursive locks of the owner */
+    pthread_t       owner;          /* owning thread, 0 if free */
+#else
     pthread_mutex_t mutexId;
+#endif
+};
+
+#if VOS_MUTEX_FUTEX
+#define VOS_MUTEX_INITIALIZER   {0u, 0u, 0u, (pthread_t) 0}
+#else
+#define VOS_MUTEX_INITIALIZER   {0u, PTHREAD_MUTEX_INITIALIZER}
+#endif
+
+struct VOS_RWLOCK
+{
+    UINT32              magicNo;
+#if VOS_MUTEX_FUTEX
+    UINT32              state;      /* futex word, number of readers | VOS_RWLOCK_WRITER | VOS_RWLOCK_WAITERS */
+#else
+    pthread_rwlock_t    lockId;
+#endif
 };
 
 struct VOS_SHRD
 {
     INT32   fd;                     /* File descriptor */
     CHAR8   *sharedMemoryName;      /* shared memory Name */
+    UINT32  size;                   /* mapped size */
+    BOOL8   attached;               /* TRUE if attached by vos_sharedAttach() */
 };
 
 VOS_ERR_T   vos_mutexLocalCreate (struct VOS_MUTEX *pMutex);
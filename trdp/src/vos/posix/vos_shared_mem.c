@@ -134,12 +134,88 @@ EXT_DECL VOS_ERR_T vos_sharedOpen (
     else
     {
         (*pHandle)->fd = fd;
+        (*pHandle)->size = (UINT32) sharedMemoryStat.st_size;
+        /* The name is needed to remove the area on close */
+        (*pHandle)->sharedMemoryName = (CHAR8 *) vos_memAlloc((UINT32) strlen(pKey) + 1u);
+        if ((*pHandle)->sharedMemoryName != NULL)
+        {
+            memcpy((*pHandle)->sharedMemoryName, pKey, strlen(pKey) + 1u);
+        }
     }
 
     ret = VOS_NO_ERR;
     return ret;
 }
 
+/**********************************************************************************************************************/
+/** Attach to an existing shared memory area.
+ *  Unlike vos_sharedOpen() the area is neither created, resized nor cleared, its contents stay intact.
+ *  The area is detached by vos_sharedClose(), which leaves it to its creator.
+ *
+ *  @param[in]      pKey               Unique identifier (file name)
+ *  @param[out]     pHandle            Pointer to returned handle
+ *  @param[out]     ppMemoryArea       Pointer to pointer to memory area
+ *  @param[out]     pSize              Pointer to actual size of the area
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter error
+ *  @retval         VOS_MEM_ERR        area does not exist or could not be mapped
+ */
+EXT_DECL VOS_ERR_T vos_sharedAttach (
+    const CHAR8 *pKey,
+    VOS_SHRD_T  *pHandle,
+    UINT8       * *ppMemoryArea,
+    UINT32      *pSize)
+{
+    INT32           fd;                      /* Shared Memory file descriptor */
+    struct    stat  sharedMemoryStat;        /* Shared Memory Stat */
+    UINT8           *pArea;
+
+    if ((pKey == NULL) || (pHandle == NULL) || (ppMemoryArea == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /* Shared Memory Open, must have been created by vos_sharedOpen() */
+    fd = shm_open(pKey, O_RDWR, 0);
+    if (fd == -1)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Shared Memory %s attach failed (Err: %d)\n", pKey, errno);
+        return VOS_MEM_ERR;
+    }
+    if ((fstat(fd, &sharedMemoryStat) == -1) || (sharedMemoryStat.st_size <= 0))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Size failed\n");
+        (void) close(fd);
+        return VOS_MEM_ERR;
+    }
+
+    /* Mapping Shared Memory */
+    pArea = (UINT8 *) mmap(NULL, (size_t) sharedMemoryStat.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pArea == MAP_FAILED)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory memory-mapping failed\n");
+        (void) close(fd);
+        return VOS_MEM_ERR;
+    }
+
+    /* Handle */
+    *pHandle = (VOS_SHRD_T) vos_memAlloc(sizeof (struct VOS_SHRD));
+    if (*pHandle == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Handle create failed\n");
+        (void) munmap(pArea, (size_t) sharedMemoryStat.st_size);
+        (void) close(fd);
+        return VOS_MEM_ERR;
+    }
+    (*pHandle)->fd          = fd;
+    (*pHandle)->size        = (UINT32) sharedMemoryStat.st_size;
+    (*pHandle)->attached    = TRUE;
+
+    *ppMemoryArea   = pArea;
+    *pSize          = (UINT32) sharedMemoryStat.st_size;
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Close connection to the shared memory area.
  *  If the area was created by the calling process, the area will be closed (freed). If the area was attached,
@@ -156,17 +232,32 @@ EXT_DECL VOS_ERR_T vos_sharedClose (
     VOS_SHRD_T  handle,
     const UINT8 *pMemoryArea)
 {
-    pMemoryArea = pMemoryArea;
+    VOS_ERR_T ret = VOS_NO_ERR;
+
+    if (handle->attached == TRUE)
+    {
+        /* Detach only, the creator removes the area */
+        (void) munmap((void *) pMemoryArea, (size_t) handle->size);
+        (void) close(handle->fd);
+        vos_memFree(handle);
+        return VOS_NO_ERR;
+    }
 
+    (void) munmap((void *) pMemoryArea, (size_t) handle->size);
     if (close(handle->fd) == -1)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory file close failed\n");
         return VOS_MEM_ERR;
     }
-    if (shm_unlink(handle->sharedMemoryName) == -1)
+    if ((handle->sharedMemoryName == NULL) || (shm_unlink(handle->sharedMemoryName) == -1))
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory unLink failed\n");
-        return VOS_MEM_ERR;
+        ret = VOS_MEM_ERR;
     }
-    return VOS_NO_ERR;
+    if (handle->sharedMemoryName != NULL)
+    {
+        vos_memFree(handle->sharedMemoryName);
+    }
+    vos_memFree(handle);
+    return ret;
 }
@@ -37,6 +37,8 @@
  * INCLUDES
  */
 
+#define VOS_SOCK_BYTE_ORDER_FUNCTIONS   /* vos_htonl() etc. are implemented here, see vos_sock.h */
+
 #include <stdio.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -47,6 +49,7 @@
 #include <fcntl.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 
 #ifdef INTEGRITY
 #   include <sys/uio.h>
@@ -60,13 +63,61 @@
 #endif
 
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 
 #include <sys/types.h>
 #include <ifaddrs.h>
 
+#if defined(__linux)
+#   include <sys/epoll.h>
+#   define VOS_POLL_EPOLL   1
+#   if defined(SO_TXTIME) || defined(SO_TIMESTAMPING)
+#       include <time.h>
+#       include <linux/net_tstamp.h>
+#   endif
+#   if defined(SO_TXTIME)
+#       define VOS_SOCK_TXTIME  1
+#   endif
+#   if defined(SO_TIMESTAMPING)
+#       define VOS_SOCK_RXTIME  1
+#   endif
+#   if defined(SO_ATTACH_FILTER)
+#       include <linux/filter.h>
+#       define VOS_SOCK_FILTER  1
+#   endif
+#   include <netinet/udp.h>
+#   if defined(UDP_SEGMENT) && defined(UDP_GRO)
+#       define VOS_SOCK_UDP_SEG 1
+#   endif
+#   if defined(SO_MEMINFO)
+#       include <linux/sock_diag.h>
+#       define VOS_SOCK_MEMINFO 1
+#   endif
+#   if defined(VOS_IO_URING)
+#       include <sys/mman.h>
+#       include <sys/syscall.h>
+#       include <linux/io_uring.h>
+#       define VOS_SOCK_URING   1
+#   endif
+#   if defined(AF_XDP)
+#       include <sys/mman.h>
+#       include <sys/syscall.h>
+#       include <linux/if_xdp.h>
+#       include <linux/bpf.h>
+#       define VOS_SOCK_XDP     1
+#       ifndef SOL_XDP
+#           define SOL_XDP      283
+#       endif
+#   endif
+#elif defined(__APPLE__) || defined(__QNXNTO__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+#   include <sys/event.h>
+#   define VOS_POLL_KQUEUE  1
+#endif
+
 #include "vos_utils.h"
 #include "vos_sock.h"
+#include "vos_mem.h"
 #include "vos_thread.h"
 #include "vos_private.h"
 
@@ -80,6 +131,102 @@ const CHAR8 *cDefaultIface = "en0";
 const CHAR8 *cDefaultIface = "eth0";
 #endif
 
+/* Room for the destination address and the receive time stamps of a datagram */
+#define VOS_SOCK_CONTROL_SIZE   128u
+
+/* Room for the IP_TOS and SO_PRIORITY of a sent datagram */
+#define VOS_SOCK_QOS_CONTROL_SIZE   64u
+
+#if defined(VOS_POLL_EPOLL) || defined(VOS_POLL_KQUEUE)
+#define VOS_MAX_POLL_EVENTS     64u         /**< max. number of events fetched with one call   */
+
+/** Poll set */
+struct VOS_POLL
+{
+    int fd;                                 /**< epoll or kqueue descriptor                     */
+};
+#endif
+
+#ifdef VOS_SOCK_XDP
+#define VOS_XDP_RING_SIZE       2048u       /**< descriptors per ring, also the number of UMEM frames   */
+#define VOS_XDP_FRAME_SIZE      2048u       /**< size of one UMEM frame, holds a full Ethernet frame     */
+#define VOS_XDP_MAX_QUEUES      64u         /**< size of the XSKMAP, highest usable receive queue + 1    */
+#define VOS_XDP_HEADER_SIZE     42u         /**< Ethernet, IPv4 without options and UDP header           */
+
+/** Shared ring of an AF_XDP socket */
+typedef struct
+{
+    UINT32  *pProducer;                     /**< producer index                                 */
+    UINT32  *pConsumer;                     /**< consumer index                                 */
+    UINT32  *pFlags;                        /**< XDP_RING_NEED_WAKEUP                           */
+    void    *pDesc;                         /**< descriptors                                    */
+    void    *pMap;                          /**< mapped area                                    */
+    size_t  mapSize;                        /**< size of the mapped area                        */
+} VOS_XDP_RING_T;
+
+/** AF_XDP receive socket with its UMEM and XDP program */
+struct VOS_XDP
+{
+    int             fd;                     /**< AF_XDP socket                                  */
+    int             mapFd;                  /**< XSKMAP the program redirects to                */
+    int             progFd;                 /**< XDP program                                    */
+    int             linkFd;                 /**< program attachment, closing detaches           */
+    UINT8           *pUmem;                 /**< frame buffers shared with the kernel           */
+    VOS_XDP_RING_T  rx;                     /**< received frames                                */
+    VOS_XDP_RING_T  fill;                   /**< frames handed to the kernel                    */
+    VOS_XDP_RING_T  comp;                   /**< completion ring (needed by the UMEM, unused)   */
+};
+#endif
+
+#ifdef VOS_SOCK_URING
+#define VOS_URING_RX_ENTRIES    128u        /**< submission entries of the receive ring                 */
+#define VOS_URING_TX_ENTRIES    64u         /**< submission entries of the send ring, datagrams per call */
+#define VOS_URING_BGID          0u          /**< group of the provided receive buffers                  */
+#define VOS_URING_CANCEL        0xFFFFFFFFFFFFFFFFull   /**< user data of cancel requests               */
+
+/** Shared submission and completion queues of an io_uring */
+typedef struct
+{
+    int                 fd;                 /**< io_uring descriptor                            */
+    UINT32              *pSqHead;           /**< submission queue head, moved by the kernel     */
+    UINT32              *pSqTail;           /**< submission queue tail                          */
+    UINT32              sqTail;             /**< local tail, published on submission           */
+    UINT32              sqEntries;          /**< size of the submission queue                   */
+    struct io_uring_sqe *pSqes;             /**< submission queue entries                       */
+    UINT32              *pCqHead;           /**< completion queue head                          */
+    UINT32              *pCqTail;           /**< completion queue tail, moved by the kernel     */
+    UINT32              cqMask;             /**< completion queue index mask                    */
+    struct io_uring_cqe *pCqes;             /**< completion queue entries                       */
+    void                *pMap;              /**< mapped rings                                   */
+    size_t              mapSize;            /**< size of the mapped rings                       */
+    size_t              sqesSize;           /**< size of the mapped submission entries          */
+} VOS_URING_RING_T;
+
+/** io_uring receiving with multishot requests into provided buffers and sending in batches */
+struct VOS_URING
+{
+    VOS_URING_RING_T            rx;         /**< multishot receives and their cancellation      */
+    VOS_URING_RING_T            tx;         /**< sends, submitted and completed in one call     */
+    struct io_uring_buf_ring    *pBufRing;  /**< buffers handed to the kernel                   */
+    UINT8                       *pBufs;     /**< receive buffers                                */
+    UINT32                      noOfBuffers;    /**< number of receive buffers                  */
+    UINT32                      bufSize;    /**< size of a buffer including the recvmsg header  */
+    UINT16                      bufTail;    /**< local tail of the buffer ring                  */
+    struct msghdr               rcvHdr;     /**< name and control space of the receives         */
+    SOCKET                      socks[VOS_MAX_SOCKET_CNT];  /**< receiving sockets, -1 if free  */
+    UINT32                      gen[VOS_MAX_SOCKET_CNT];    /**< request generation of a socket */
+    UINT32                      nextGen;    /**< generation of the next request                 */
+    struct msghdr               txHdr[VOS_URING_TX_ENTRIES];    /**< headers of the sends       */
+    struct iovec                txIov[VOS_URING_TX_ENTRIES];    /**< data of the sends          */
+    struct sockaddr_in          txAddr[VOS_URING_TX_ENTRIES];   /**< destinations of the sends  */
+    union
+    {
+        struct cmsghdr  cm;
+        char            raw[VOS_SOCK_QOS_CONTROL_SIZE];
+    } txControl[VOS_URING_TX_ENTRIES];      /**< QoS of the sends                               */
+};
+#endif
+
 /***********************************************************************************************************************
  *  LOCALS
  */
@@ -88,6 +235,24 @@ BOOL8           vosSockInitialised = FALSE;
 
 struct ifreq    gIfr;
 
+#if !defined(SO_NET_SERVICE_TYPE) || defined(__linux)
+/* QoS (0...7) to DSCP, ECN set to 0 */
+static const int cDscpMap[] = {0, 8, 18, 24, 34, 40, 48, 56};
+#endif
+
+#if defined(__linux) && defined(SO_PRIORITY)
+/* SO_PRIORITY is accepted as ancillary data since Linux 5.17, cleared on the first refusal */
+static BOOL8    sSendPrioCmsg = TRUE;
+#endif
+
+#ifdef VOS_SOCK_UDP_SEG
+/* largest UDP payload of one segmented send */
+#define VOS_SOCK_UDP_SEG_MAX    65507u
+
+/* UDP_SEGMENT is known to the kernel since Linux 4.18, cleared if it is refused */
+static BOOL8    sUdpSegment = TRUE;
+#endif
+
 /***********************************************************************************************************************
  * LOCAL FUNCTIONS
  */
@@ -95,6 +260,164 @@ struct ifreq    gIfr;
 BOOL8       vos_getMacAddress (UINT8        *pMacAddr,
                                const char   *pIfName);
 VOS_ERR_T   vos_sockSetBuffer (SOCKET sock);
+static void vos_sockGetDstAddr (struct msghdr   *pMsg,
+                                UINT32          *pDstIPAddr);
+static void vos_sockGetRxTime (struct msghdr    *pMsg,
+                               VOS_TIMEVAL_T    *pRxTime);
+#ifdef __linux
+static void vos_sockQosControl (struct msghdr   *pHdr,
+                                char            *pControl,
+                                UINT8           qos);
+#endif
+static VOS_ERR_T vos_sockRecvMsg (SOCKET        sock,
+                                  UINT8         *pBuffer,
+                                  UINT32        *pSize,
+                                  UINT32        *pSrcIPAddr,
+                                  UINT16        *pSrcIPPort,
+                                  UINT32        *pDstIPAddr,
+                                  BOOL8         peek,
+                                  VOS_TIMEVAL_T *pRxTime,
+                                  UINT32        *pSegSize);
+
+/**********************************************************************************************************************/
+/** Get the destination address of a received datagram from the control messages.
+ *
+ *  @param[in]          pMsg            pointer to the message header filled by recvmsg()
+ *  @param[out]         pDstIPAddr      pointer to destination IP, unchanged if not available
+ */
+static void vos_sockGetDstAddr (
+    struct msghdr   *pMsg,
+    UINT32          *pDstIPAddr)
+{
+    struct cmsghdr *cmsg;
+
+    for (cmsg = CMSG_FIRSTHDR(pMsg); cmsg != NULL; cmsg = CMSG_NXTHDR(pMsg, cmsg))
+    {
+        #if defined(IP_RECVDSTADDR)
+        if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVDSTADDR)
+        {
+            struct in_addr *pia = (struct in_addr *)CMSG_DATA(cmsg);
+            *pDstIPAddr = (UINT32)vos_ntohl(pia->s_addr);
+            /* vos_printLog(VOS_LOG_DBG, "udp message dest IP: %s\n", vos_ipDotted(*pDstIPAddr)); */
+        }
+        #elif defined(IP_PKTINFO)
+        if (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_PKTINFO)
+        {
+            struct in_pktinfo *pia = (struct in_pktinfo *)CMSG_DATA(cmsg);
+            *pDstIPAddr = (UINT32)vos_ntohl(pia->ipi_addr.s_addr);
+            /* vos_printLog(VOS_LOG_DBG, "udp message dest IP: %s\n", vos_ipDotted(*pDstIPAddr)); */
+        }
+        #endif
+    }
+}
+
+/**********************************************************************************************************************/
+/** Get the reception time of a received datagram from the control messages.
+ *  The kernel reports CLOCK_REALTIME (software) or NIC clock (hardware) time stamps. A hardware time stamp is preferred;
+ *  the NIC clock is expected to be synchronised to CLOCK_TAI (e.g. by phc2sys). The time stamp is converted to the
+ *  time base of vos_getTime() by its age. Without a time stamp, the current time is returned.
+ *
+ *  @param[in]          pMsg            pointer to the message header filled by recvmsg()
+ *  @param[out]         pRxTime         pointer to the reception time
+ */
+static void vos_sockGetRxTime (
+    struct msghdr   *pMsg,
+    VOS_TIMEVAL_T   *pRxTime)
+{
+#ifdef VOS_SOCK_RXTIME
+    struct cmsghdr  *cmsg;
+    struct timespec stamp   = {0, 0};
+    clockid_t       clockId = CLOCK_REALTIME;
+
+    for (cmsg = CMSG_FIRSTHDR(pMsg); cmsg != NULL; cmsg = CMSG_NXTHDR(pMsg, cmsg))
+    {
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_TIMESTAMPING))
+        {
+            /* [0]: software, [1]: unused, [2]: raw hardware time stamp */
+            struct timespec ts[3];
+
+            memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+            if ((ts[2].tv_sec != 0) || (ts[2].tv_nsec != 0))
+            {
+                stamp   = ts[2];
+                clockId = CLOCK_TAI;
+            }
+            else
+            {
+                stamp = ts[0];
+            }
+        }
+        else if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_TIMESTAMPNS))
+        {
+            memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+        }
+    }
+
+    if ((stamp.tv_sec != 0) || (stamp.tv_nsec != 0))
+    {
+        struct timespec now;
+        VOS_TIMEVAL_T   base;
+        INT64           age;
+
+        (void) clock_gettime(clockId, &now);
+        vos_getTime(&base);
+        age = ((INT64) now.tv_sec - (INT64) stamp.tv_sec) * 1000000000 + ((INT64) now.tv_nsec - (INT64) stamp.tv_nsec);
+        if (age < 0)
+        {
+            age = 0;                                    /* clocks not in sync, take the current time */
+        }
+        age = ((INT64) base.tv_sec * 1000000 + (INT64) base.tv_usec) - age / 1000;
+        pRxTime->tv_sec     = (time_t) (age / 1000000);
+        pRxTime->tv_usec    = (suseconds_t) (age % 1000000);
+        return;
+    }
+#else
+    (void) pMsg;
+#endif
+    vos_getTime(pRxTime);
+}
+
+#ifdef __linux
+/**********************************************************************************************************************/
+/** Attach the QoS of a datagram to be sent as control messages.
+ *  The QoS is set as IP TOS and, if the kernel accepts it, as SO_PRIORITY (VLAN PCP), overriding the socket setting.
+ *
+ *  @param[in,out]      pHdr            pointer to the message header to send
+ *  @param[in]          pControl        control buffer of VOS_SOCK_QOS_CONTROL_SIZE bytes
+ *  @param[in]          qos             QoS 1...7
+ */
+static void vos_sockQosControl (
+    struct msghdr   *pHdr,
+    char            *pControl,
+    UINT8           qos)
+{
+    struct cmsghdr *pCmsg;
+
+    pHdr->msg_control       = pControl;
+    pHdr->msg_controllen    = CMSG_SPACE(sizeof(int));
+#ifdef SO_PRIORITY
+    if (sSendPrioCmsg == TRUE)
+    {
+        pHdr->msg_controllen += CMSG_SPACE(sizeof(int));
+    }
+#endif
+    pCmsg = CMSG_FIRSTHDR(pHdr);
+    pCmsg->cmsg_level   = IPPROTO_IP;
+    pCmsg->cmsg_type    = IP_TOS;
+    pCmsg->cmsg_len     = CMSG_LEN(sizeof(int));
+    *(int *)CMSG_DATA(pCmsg) = cDscpMap[qos];
+#ifdef SO_PRIORITY
+    if (sSendPrioCmsg == TRUE)
+    {
+        pCmsg = CMSG_NXTHDR(pHdr, pCmsg);
+        pCmsg->cmsg_level   = SOL_SOCKET;
+        pCmsg->cmsg_type    = SO_PRIORITY;
+        pCmsg->cmsg_len     = CMSG_LEN(sizeof(int));
+        *(int *)CMSG_DATA(pCmsg) = (int) qos;
+    }
+#endif
+}
+#endif
 
 /**********************************************************************************************************************/
 /** Get the MAC address for a named interface.
@@ -399,662 +722,3026 @@ EXT_DECL INT32 vos_select (
 }
 
 /**********************************************************************************************************************/
-/** Get a list of interface addresses
- *  The caller has to provide an array of interface records to be filled.
+/** Create a poll set.
+ *  A poll set reports readable sockets without rescanning all registered descriptors. It is backed by epoll on Linux
+ *  and kqueue on macOS, QNX and BSD. Other targets return VOS_UNKNOWN_ERR, select() has to be used there.
  *
- *  @param[in,out]  pAddrCnt          in:   pointer to array size of interface record
- *                                    out:  pointer to number of interface records read
- *  @param[in,out]  ifAddrs           array of interface records
+ *  @param[out]     pPoll           pointer to the handle of the poll set
  *
  *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   pMAC == NULL
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    the poll set could not be created
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
  */
-EXT_DECL VOS_ERR_T vos_getInterfaces (
-    UINT32          *pAddrCnt,
-    VOS_IF_REC_T    ifAddrs[])
-{
-    int success;
-    struct ifaddrs  *addrs;
-    struct ifaddrs  *cursor;
-    unsigned int    count = 0;
 
-    if (pAddrCnt == NULL ||
-        *pAddrCnt == 0 ||
-        ifAddrs == NULL)
+EXT_DECL VOS_ERR_T vos_pollCreate (
+    VOS_POLL_T *pPoll)
+{
+#if defined(VOS_POLL_EPOLL) || defined(VOS_POLL_KQUEUE)
+    if (pPoll == NULL)
     {
         return VOS_PARAM_ERR;
     }
 
-    success = getifaddrs(&addrs) == 0;
-    if (success)
+    *pPoll = (VOS_POLL_T) vos_memAlloc(sizeof(struct VOS_POLL));
+    if (*pPoll == NULL)
     {
-        cursor = addrs;
-        while (cursor != 0 && count < *pAddrCnt)
-        {
-            if (cursor->ifa_addr != NULL && cursor->ifa_addr->sa_family == AF_INET)
-            {
-                memcpy(&ifAddrs[count].ipAddr, &cursor->ifa_addr->sa_data[2], 4);
-                ifAddrs[count].ipAddr = vos_ntohl(ifAddrs[count].ipAddr);
-                memcpy(&ifAddrs[count].netMask, &cursor->ifa_netmask->sa_data[2], 4);
-                ifAddrs[count].netMask = vos_ntohl(ifAddrs[count].netMask);
-                if (cursor->ifa_name != NULL)
-                {
-                    strncpy((char *) ifAddrs[count].name, cursor->ifa_name, VOS_MAX_IF_NAME_SIZE);
-                    ifAddrs[count].name[VOS_MAX_IF_NAME_SIZE - 1] = 0;
-                }
-                vos_printLog(VOS_LOG_INFO, "IP-Addr for '%s': %u.%u.%u.%u\n",
-                             ifAddrs[count].name,
-                             (unsigned int)(ifAddrs[count].ipAddr >> 24) & 0xFF,
-                             (unsigned int)(ifAddrs[count].ipAddr >> 16) & 0xFF,
-                             (unsigned int)(ifAddrs[count].ipAddr >> 8)  & 0xFF,
-                             (unsigned int)(ifAddrs[count].ipAddr        & 0xFF));
-                if (vos_getMacAddress(ifAddrs[count].mac, ifAddrs[count].name) == TRUE)
-                {
-                    vos_printLog(VOS_LOG_INFO, "Mac-Addr for '%s': %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                 ifAddrs[count].name,
-                                 (unsigned int)ifAddrs[count].mac[0],
-                                 (unsigned int)ifAddrs[count].mac[1],
-                                 (unsigned int)ifAddrs[count].mac[2],
-                                 (unsigned int)ifAddrs[count].mac[3],
-                                 (unsigned int)ifAddrs[count].mac[4],
-                                 (unsigned int)ifAddrs[count].mac[5]);
-                }
-                if (cursor->ifa_flags & IFF_RUNNING)
-                {
-                    ifAddrs[count].linkState = TRUE;
-                }
-                else
-                {
-                    ifAddrs[count].linkState = FALSE;
-                }
-                count++;
-            }
-            cursor = cursor->ifa_next;
-        }
-
-        freeifaddrs(addrs);
+        return VOS_MEM_ERR;
     }
-    else
+
+#ifdef VOS_POLL_EPOLL
+    (*pPoll)->fd = epoll_create1(EPOLL_CLOEXEC);
+#else
+    (*pPoll)->fd = kqueue();
+#endif
+
+    if ((*pPoll)->fd == -1)
     {
-        return VOS_PARAM_ERR;
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "creating poll set failed (Err: %s)\n", buff);
+        vos_memFree(*pPoll);
+        *pPoll = NULL;
+        return VOS_SOCK_ERR;
     }
-
-    *pAddrCnt = count;
     return VOS_NO_ERR;
+#else
+    if (pPoll != NULL)
+    {
+        *pPoll = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "poll sets are not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+#endif
 }
 
 /**********************************************************************************************************************/
-/** Get the state of an interface
+/** Add a socket to a poll set.
+ *  The tag is reported by vos_pollWait() when the socket becomes readable. Adding a socket again updates its tag.
+ *  A closed socket is removed from the poll set by the OS.
  *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      tag             value to report for this socket
  *
- *  @param[in]      ifAddress       address of interface to check
- *
- *  @retval         TRUE            interface is up and ready
- *                  FALSE           interface is down / not ready
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    the socket could not be added
  */
-EXT_DECL BOOL8 vos_netIfUp (
-    VOS_IP4_ADDR_T ifAddress)
+
+EXT_DECL VOS_ERR_T vos_pollAdd (
+    VOS_POLL_T  poll,
+    SOCKET      sock,
+    UINT32      tag)
 {
-    struct ifaddrs  *addrs;
-    struct ifaddrs  *cursor;
-    VOS_IF_REC_T    ifAddrs;
+#if defined(VOS_POLL_EPOLL) || defined(VOS_POLL_KQUEUE)
+    int result;
 
-    ifAddrs.linkState = FALSE;
+    if ((poll == NULL) || (sock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
 
-    if (getifaddrs(&addrs) == 0)
+#ifdef VOS_POLL_EPOLL
     {
-        cursor = addrs;
-        while (cursor != 0)
+        struct epoll_event ev;
+
+        memset(&ev, 0, sizeof(ev));
+        ev.events   = EPOLLIN;
+        ev.data.u32 = tag;
+        result      = epoll_ctl(poll->fd, EPOLL_CTL_ADD, sock, &ev);
+        if ((result == -1) && (errno == EEXIST))
         {
-            if (cursor->ifa_addr != NULL && cursor->ifa_addr->sa_family == AF_INET)
-            {
-                memcpy(&ifAddrs.ipAddr, &cursor->ifa_addr->sa_data[2], 4);
-                ifAddrs.ipAddr = vos_ntohl(ifAddrs.ipAddr);
-                /* Exit if first (default) interface matches */
-                if (ifAddress == VOS_INADDR_ANY || ifAddress == ifAddrs.ipAddr)
-                {
-                    if (cursor->ifa_flags & IFF_UP)
-                    {
-                        ifAddrs.linkState = TRUE;
-                    }
-                    /* vos_printLog(VOS_LOG_INFO, "cursor->ifa_flags = 0x%x\n", cursor->ifa_flags); */
-                    break;
-                }
-            }
-            cursor = cursor->ifa_next;
+            result = epoll_ctl(poll->fd, EPOLL_CTL_MOD, sock, &ev);
         }
+    }
+#else
+    {
+        struct kevent ev;
 
-        freeifaddrs(addrs);
+        EV_SET(&ev, (uintptr_t) sock, EVFILT_READ, EV_ADD, 0, 0, (void *) (uintptr_t) tag);
+        result = kevent(poll->fd, &ev, 1, NULL, 0, NULL);
+    }
+#endif
 
+    if (result == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "adding socket %d to poll set failed (Err: %s)\n", (int) sock, buff);
+        return VOS_SOCK_ERR;
     }
-    return ifAddrs.linkState;
+    return VOS_NO_ERR;
+#else
+    (void) poll;
+    (void) sock;
+    (void) tag;
+    return VOS_PARAM_ERR;
+#endif
 }
 
-/*    Sockets    */
-
 /**********************************************************************************************************************/
-/** Initialize the socket library.
- *  Must be called once before any other call
+/** Remove a socket from a poll set.
  *
- *  @retval         VOS_NO_ERR          no error
- *  @retval         VOS_SOCK_ERR        sockets not supported
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_SOCK_ERR    the socket was not part of the poll set
  */
 
-EXT_DECL VOS_ERR_T vos_sockInit (void)
+EXT_DECL VOS_ERR_T vos_pollRemove (
+    VOS_POLL_T  poll,
+    SOCKET      sock)
 {
-    memset(&gIfr, 0, sizeof(gIfr));
-    vosSockInitialised = TRUE;
+#if defined(VOS_POLL_EPOLL) || defined(VOS_POLL_KQUEUE)
+    int result;
 
-    return VOS_NO_ERR;
+    if ((poll == NULL) || (sock == VOS_INVALID_SOCKET))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+#ifdef VOS_POLL_EPOLL
+    {
+        struct epoll_event ev;      /* ignored, but needed by kernels before 2.6.9 */
+
+        memset(&ev, 0, sizeof(ev));
+        result = epoll_ctl(poll->fd, EPOLL_CTL_DEL, sock, &ev);
+    }
+#else
+    {
+        struct kevent ev;
+
+        EV_SET(&ev, (uintptr_t) sock, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+        result = kevent(poll->fd, &ev, 1, NULL, 0, NULL);
+    }
+#endif
+
+    return (result == -1) ? VOS_SOCK_ERR : VOS_NO_ERR;
+#else
+    (void) poll;
+    (void) sock;
+    return VOS_PARAM_ERR;
+#endif
 }
 
 /**********************************************************************************************************************/
-/** De-Initialize the socket library.
- *  Must be called after last socket call
+/** Wait for readable sockets of a poll set.
+ *  Only the tags of the sockets ready to be read are returned.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pTags           array to receive the tags of the readable sockets
+ *  @param[in,out]  pNoOfTags       in: size of pTags, out: number of readable sockets
+ *  @param[in]      pTimeOut        pointer to time out value, NULL waits forever, zero time out does not block
  *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      waiting failed
  */
 
-EXT_DECL void vos_sockTerm (void)
+EXT_DECL VOS_ERR_T vos_pollWait (
+    VOS_POLL_T          poll,
+    UINT32              *pTags,
+    UINT32              *pNoOfTags,
+    const VOS_TIMEVAL_T *pTimeOut)
 {
-    vosSockInitialised = FALSE;
+#if defined(VOS_POLL_EPOLL) || defined(VOS_POLL_KQUEUE)
+    int     noOfEvents;
+    int     i;
+    UINT32  maxEvents;
+
+    if ((poll == NULL) || (pTags == NULL) || (pNoOfTags == NULL) || (*pNoOfTags == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    maxEvents = (*pNoOfTags < VOS_MAX_POLL_EVENTS) ? *pNoOfTags : VOS_MAX_POLL_EVENTS;
+    *pNoOfTags = 0u;
+
+#ifdef VOS_POLL_EPOLL
+    {
+        struct epoll_event  ev[VOS_MAX_POLL_EVENTS];
+        int                 timeOut = -1;
+
+        if (pTimeOut != NULL)
+        {
+            /* round up, a short time out must not degrade into busy polling */
+            timeOut = (int) (pTimeOut->tv_sec * 1000 + (pTimeOut->tv_usec + 999) / 1000);
+        }
+        noOfEvents = epoll_wait(poll->fd, ev, (int) maxEvents, timeOut);
+        for (i = 0; i < noOfEvents; i++)
+        {
+            pTags[i] = ev[i].data.u32;
+        }
+    }
+#else
+    {
+        struct kevent   ev[VOS_MAX_POLL_EVENTS];
+        struct timespec timeOut;
+
+        if (pTimeOut != NULL)
+        {
+            timeOut.tv_sec  = pTimeOut->tv_sec;
+            timeOut.tv_nsec = pTimeOut->tv_usec * 1000;
+        }
+        noOfEvents = kevent(poll->fd, NULL, 0, ev, (int) maxEvents, (pTimeOut != NULL) ? &timeOut : NULL);
+        for (i = 0; i < noOfEvents; i++)
+        {
+            pTags[i] = (UINT32) (uintptr_t) ev[i].udata;
+        }
+    }
+#endif
+
+    if (noOfEvents == -1)
+    {
+        if (errno == EINTR)
+        {
+            return VOS_NO_ERR;
+        }
+        return VOS_IO_ERR;
+    }
+    *pNoOfTags = (UINT32) noOfEvents;
+    return VOS_NO_ERR;
+#else
+    (void) poll;
+    (void) pTags;
+    (void) pTimeOut;
+    if (pNoOfTags != NULL)
+    {
+        *pNoOfTags = 0u;
+    }
+    return VOS_PARAM_ERR;
+#endif
 }
 
 /**********************************************************************************************************************/
-/** Return the MAC address of the default adapter.
+/** Get the descriptor of a poll set.
+ *  The descriptor becomes readable as soon as one of the sockets of the poll set is readable. It can be used in the
+ *  application's own select(), poll() or epoll loop.
  *
- *  @param[out]     pMAC            return MAC address.
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pFd             pointer to the descriptor
  *
  *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   pMAC == NULL
- *  @retval         VOS_SOCK_ERR    socket not available or option not supported
+ *  @retval         VOS_PARAM_ERR   parameter error
  */
 
-EXT_DECL VOS_ERR_T vos_sockGetMAC (
-    UINT8 pMAC[VOS_MAC_SIZE])
+EXT_DECL VOS_ERR_T vos_pollGetFd (
+    VOS_POLL_T  poll,
+    SOCKET      *pFd)
 {
-    if (pMAC == NULL)
+    if ((poll == NULL) || (pFd == NULL))
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
         return VOS_PARAM_ERR;
     }
+#if defined(VOS_POLL_EPOLL) || defined(VOS_POLL_KQUEUE)
+    *pFd = poll->fd;
+    return VOS_NO_ERR;
+#else
+    return VOS_PARAM_ERR;
+#endif
+}
 
-    if (vos_getMacAddress(pMAC, cDefaultIface) == TRUE)
+/**********************************************************************************************************************/
+/** Delete a poll set.
+ *  The sockets of the poll set are not closed.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDelete (
+    VOS_POLL_T poll)
+{
+    if (poll == NULL)
     {
-        return VOS_NO_ERR;
+        return VOS_PARAM_ERR;
     }
+#if defined(VOS_POLL_EPOLL) || defined(VOS_POLL_KQUEUE)
+    (void) close(poll->fd);
+    vos_memFree(poll);
+    return VOS_NO_ERR;
+#else
+    return VOS_PARAM_ERR;
+#endif
+}
 
-    return VOS_SOCK_ERR;
+#ifdef VOS_SOCK_XDP
+/**********************************************************************************************************************/
+/** Issue a bpf() system call
+ *
+ *  @param[in]      cmd             BPF command
+ *  @param[in,out]  pAttr           command attributes
+ *
+ *  @retval         result of the system call, -1 on error
+ */
+static int vos_bpf (
+    int             cmd,
+    union bpf_attr  *pAttr)
+{
+    return (int) syscall(SYS_bpf, cmd, pAttr, sizeof(*pAttr));
 }
 
 /**********************************************************************************************************************/
-/** Create an UDP socket.
- *  Return a socket descriptor for further calls. The socket options are optional and can be
- *  applied later.
- *  Note: Some targeted systems might not support every option.
+/** Map one ring of an AF_XDP socket
  *
- *  @param[out]     pSock           pointer to socket descriptor returned
- *  @param[in]      pOptions        pointer to socket options (optional)
+ *  @param[in]      fd              AF_XDP socket
+ *  @param[in]      pOffsets        offsets of the ring's members
+ *  @param[in]      descSize        size of one descriptor
+ *  @param[in]      pgOffset        mmap offset selecting the ring
+ *  @param[out]     pRing           ring to set up
  *
  *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   pSock == NULL
- *  @retval         VOS_SOCK_ERR    socket not available or option not supported
+ *  @retval         VOS_SOCK_ERR    ring could not be mapped
  */
-
-EXT_DECL VOS_ERR_T vos_sockOpenUDP (
-    SOCKET                  *pSock,
-    const VOS_SOCK_OPT_T    *pOptions)
+static VOS_ERR_T vos_xdpMapRing (
+    int                             fd,
+    const struct xdp_ring_offset    *pOffsets,
+    size_t                          descSize,
+    off_t                           pgOffset,
+    VOS_XDP_RING_T                  *pRing)
 {
-    int sock;
+    UINT8 *pMap;
 
-    if (!vosSockInitialised)
+    pRing->mapSize  = pOffsets->desc + VOS_XDP_RING_SIZE * descSize;
+    pMap            = (UINT8 *) mmap(NULL, pRing->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                     pgOffset);
+    if (pMap == (UINT8 *) MAP_FAILED)
     {
-        return VOS_INIT_ERR;
+        pRing->pMap = NULL;
+        return VOS_SOCK_ERR;
     }
+    pRing->pMap         = pMap;
+    pRing->pProducer    = (UINT32 *) (pMap + pOffsets->producer);
+    pRing->pConsumer    = (UINT32 *) (pMap + pOffsets->consumer);
+    pRing->pFlags       = (UINT32 *) (pMap + pOffsets->flags);
+    pRing->pDesc        = pMap + pOffsets->desc;
+    return VOS_NO_ERR;
+}
 
-    if (pSock == NULL)
+/**********************************************************************************************************************/
+/** Load the XDP program redirecting the frames for a UDP port to the XSKMAP
+ *  IPv4 frames without IP options and fragmentation are redirected to the AF_XDP socket of the receiving queue,
+ *  all other frames (and frames of queues without socket) are passed to the network stack.
+ *
+ *  @param[in]      mapFd           XSKMAP
+ *  @param[in]      port            UDP destination port
+ *
+ *  @retval         program descriptor, -1 on error
+ */
+static int vos_xdpLoadProgram (
+    int     mapFd,
+    UINT16  port)
+{
+    /*  16 bit fields are loaded in host byte order from the frame: compare with the network ordered values */
+    const INT32     ethIp   = (INT32) vos_htons(0x0800u);
+    const INT32     frag    = (INT32) vos_htons(0x3FFFu);       /* MF flag and fragment offset */
+    const INT32     udpPort = (INT32) vos_htons(port);
+    struct bpf_insn prog[] =
+    {
+        /*  r6 = ctx, r2 = data, r3 = data_end  */
+        {BPF_ALU64 | BPF_MOV | BPF_X, 6, 1, 0, 0},
+        {BPF_LDX | BPF_W | BPF_MEM, 2, 6, 0, 0},
+        {BPF_LDX | BPF_W | BPF_MEM, 3, 6, 4, 0},
+        /*  if (data + 42 > data_end) pass  */
+        {BPF_ALU64 | BPF_MOV | BPF_X, 4, 2, 0, 0},
+        {BPF_ALU64 | BPF_ADD | BPF_K, 4, 0, 0, VOS_XDP_HEADER_SIZE},
+        {BPF_JMP | BPF_JGT | BPF_X, 4, 3, 17, 0},
+        /*  Ethernet type IPv4, IHL 5, protocol UDP, not fragmented, destination port   */
+        {BPF_LDX | BPF_H | BPF_MEM, 5, 2, 12, 0},
+        {BPF_JMP | BPF_JNE | BPF_K, 5, 0, 15, ethIp},
+        {BPF_LDX | BPF_B | BPF_MEM, 5, 2, 14, 0},
+        {BPF_JMP | BPF_JNE | BPF_K, 5, 0, 13, 0x45},
+        {BPF_LDX | BPF_B | BPF_MEM, 5, 2, 23, 0},
+        {BPF_JMP | BPF_JNE | BPF_K, 5, 0, 11, IPPROTO_UDP},
+        {BPF_LDX | BPF_H | BPF_MEM, 5, 2, 20, 0},
+        {BPF_ALU64 | BPF_AND | BPF_K, 5, 0, 0, frag},
+        {BPF_JMP | BPF_JNE | BPF_K, 5, 0, 8, 0},
+        {BPF_LDX | BPF_H | BPF_MEM, 5, 2, 36, 0},
+        {BPF_JMP | BPF_JNE | BPF_K, 5, 0, 6, udpPort},
+        /*  return bpf_redirect_map(&xsks, ctx->rx_queue_index, XDP_PASS)   */
+        {BPF_LD | BPF_DW | BPF_IMM, 1, BPF_PSEUDO_MAP_FD, 0, mapFd},
+        {0, 0, 0, 0, 0},
+        {BPF_LDX | BPF_W | BPF_MEM, 2, 6, 16, 0},
+        {BPF_ALU64 | BPF_MOV | BPF_K, 3, 0, 0, XDP_PASS},
+        {BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map},
+        {BPF_JMP | BPF_EXIT, 0, 0, 0, 0},
+        /*  pass: return XDP_PASS   */
+        {BPF_ALU64 | BPF_MOV | BPF_K, 0, 0, 0, XDP_PASS},
+        {BPF_JMP | BPF_EXIT, 0, 0, 0, 0}
+    };
+    static const char   license[] = "Dual MPL/GPL";
+    union bpf_attr      attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.prog_type  = BPF_PROG_TYPE_XDP;
+    attr.insns      = (UINT64) (uintptr_t) prog;
+    attr.insn_cnt   = sizeof(prog) / sizeof(prog[0]);
+    attr.license    = (UINT64) (uintptr_t) license;
+    return vos_bpf(BPF_PROG_LOAD, &attr);
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Open an AF_XDP socket receiving the UDP frames for a port.
+ *  An XDP program attached to the interface redirects the IPv4/UDP frames for the port arriving on the receive queue
+ *  into frame buffers (UMEM) shared with the application; they bypass the network stack. Zero copy mode is used if
+ *  the driver supports it. Multicast groups still have to be joined by ordinary sockets.
+ *  Needs Linux 5.9 or later and the CAP_NET_ADMIN and CAP_BPF (or CAP_SYS_ADMIN) capabilities.
+ *
+ *  @param[out]     pXdp            pointer to the handle of the AF_XDP socket
+ *  @param[in]      pIfName         name of the interface
+ *  @param[in]      queueId         receive queue of the interface
+ *  @param[in]      port            UDP destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    socket, frame buffers or XDP program could not be set up
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpOpen (
+    VOS_XDP_T       *pXdp,
+    const CHAR8     *pIfName,
+    UINT32          queueId,
+    UINT16          port)
+{
+#ifdef VOS_SOCK_XDP
+    struct VOS_XDP          *pNew;
+    struct xdp_umem_reg     umemReg;
+    struct xdp_mmap_offsets offsets;
+    struct sockaddr_xdp     addr;
+    struct ifreq            ifr;
+    union bpf_attr          attr;
+    socklen_t               optLen      = sizeof(offsets);
+    int                     ringSize    = VOS_XDP_RING_SIZE;
+    int                     sd;
+    UINT32                  i;
+
+    if ((pXdp == NULL) || (pIfName == NULL) || (queueId >= VOS_XDP_MAX_QUEUES))
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
         return VOS_PARAM_ERR;
     }
+    *pXdp = NULL;
 
-    if ((sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1)
+    pNew = (struct VOS_XDP *) vos_memAlloc(sizeof(struct VOS_XDP));
+    if (pNew == NULL)
     {
-        char buff[VOS_MAX_ERR_STR_SIZE];
-        STRING_ERR(buff);
-        vos_printLog(VOS_LOG_ERROR, "socket() failed (Err: %s)\n", buff);
-        return VOS_SOCK_ERR;
+        return VOS_MEM_ERR;
     }
+    pNew->mapFd     = -1;
+    pNew->progFd    = -1;
+    pNew->linkFd    = -1;
 
-    if ((vos_sockSetOptions(sock, pOptions) != VOS_NO_ERR)
-        || (vos_sockSetBuffer(sock) != VOS_NO_ERR))
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, pIfName, IFNAMSIZ - 1);
+    sd = socket(AF_INET, SOCK_DGRAM, 0);
+    if ((sd == -1) || (ioctl(sd, SIOCGIFINDEX, &ifr) == -1))
     {
-        close(sock);
-        vos_printLogStr(VOS_LOG_ERROR, "socket() failed, setsockoptions or buffer failed!\n");
-        return VOS_SOCK_ERR;
+        if (sd != -1)
+        {
+            (void) close(sd);
+        }
+        pNew->fd = -1;
+        goto sock_err;
     }
+    (void) close(sd);
 
-    *pSock = (SOCKET) sock;
+    pNew->fd = socket(AF_XDP, SOCK_RAW, 0);
+    if (pNew->fd == -1)
+    {
+        goto sock_err;
+    }
 
-    vos_printLog(VOS_LOG_DBG, "vos_sockOpenUDP: socket()=%d success\n", (int)sock);
+    /*  Frame buffers, all of them are handed to the kernel by the fill ring  */
+    pNew->pUmem = (UINT8 *) mmap(NULL, VOS_XDP_RING_SIZE * VOS_XDP_FRAME_SIZE, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pNew->pUmem == (UINT8 *) MAP_FAILED)
+    {
+        pNew->pUmem = NULL;
+        goto sock_err;
+    }
+    memset(&umemReg, 0, sizeof(umemReg));
+    umemReg.addr        = (UINT64) (uintptr_t) pNew->pUmem;
+    umemReg.len         = VOS_XDP_RING_SIZE * VOS_XDP_FRAME_SIZE;
+    umemReg.chunk_size  = VOS_XDP_FRAME_SIZE;
+    if ((setsockopt(pNew->fd, SOL_XDP, XDP_UMEM_REG, &umemReg, sizeof(umemReg)) == -1) ||
+        (setsockopt(pNew->fd, SOL_XDP, XDP_UMEM_FILL_RING, &ringSize, sizeof(ringSize)) == -1) ||
+        (setsockopt(pNew->fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &ringSize, sizeof(ringSize)) == -1) ||
+        (setsockopt(pNew->fd, SOL_XDP, XDP_RX_RING, &ringSize, sizeof(ringSize)) == -1) ||
+        (getsockopt(pNew->fd, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &optLen) == -1) ||
+        (vos_xdpMapRing(pNew->fd, &offsets.rx, sizeof(struct xdp_desc), XDP_PGOFF_RX_RING, &pNew->rx) != VOS_NO_ERR) ||
+        (vos_xdpMapRing(pNew->fd, &offsets.fr, sizeof(UINT64), XDP_UMEM_PGOFF_FILL_RING, &pNew->fill) != VOS_NO_ERR) ||
+        (vos_xdpMapRing(pNew->fd, &offsets.cr, sizeof(UINT64), XDP_UMEM_PGOFF_COMPLETION_RING,
+                        &pNew->comp) != VOS_NO_ERR))
+    {
+        goto sock_err;
+    }
+    for (i = 0u; i < VOS_XDP_RING_SIZE; i++)
+    {
+        ((UINT64 *) pNew->fill.pDesc)[i] = (UINT64) i * VOS_XDP_FRAME_SIZE;
+    }
+    __atomic_store_n(pNew->fill.pProducer, VOS_XDP_RING_SIZE, __ATOMIC_RELEASE);
+
+    /*  Bind to the queue, zero copy if the driver supports it  */
+    memset(&addr, 0, sizeof(addr));
+    addr.sxdp_family    = AF_XDP;
+    addr.sxdp_ifindex   = (UINT32) ifr.ifr_ifindex;
+    addr.sxdp_queue_id  = queueId;
+    addr.sxdp_flags     = XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP;
+    if (bind(pNew->fd, (struct sockaddr *) &addr, sizeof(addr)) == -1)
+    {
+        addr.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+        if (bind(pNew->fd, (struct sockaddr *) &addr, sizeof(addr)) == -1)
+        {
+            goto sock_err;
+        }
+    }
+
+    /*  XSKMAP[queueId] = socket, then load and attach the program  */
+    memset(&attr, 0, sizeof(attr));
+    attr.map_type       = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size       = sizeof(UINT32);
+    attr.value_size     = sizeof(UINT32);
+    attr.max_entries    = VOS_XDP_MAX_QUEUES;
+    pNew->mapFd         = vos_bpf(BPF_MAP_CREATE, &attr);
+    if (pNew->mapFd == -1)
+    {
+        goto sock_err;
+    }
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = (UINT32) pNew->mapFd;
+    attr.key    = (UINT64) (uintptr_t) &queueId;
+    attr.value  = (UINT64) (uintptr_t) &pNew->fd;
+    if (vos_bpf(BPF_MAP_UPDATE_ELEM, &attr) == -1)
+    {
+        goto sock_err;
+    }
+    pNew->progFd = vos_xdpLoadProgram(pNew->mapFd, port);
+    if (pNew->progFd == -1)
+    {
+        goto sock_err;
+    }
+    memset(&attr, 0, sizeof(attr));
+    attr.link_create.prog_fd        = (UINT32) pNew->progFd;
+    attr.link_create.target_ifindex = (UINT32) ifr.ifr_ifindex;
+    attr.link_create.attach_type    = BPF_XDP;
+    pNew->linkFd = vos_bpf(BPF_LINK_CREATE, &attr);
+    if (pNew->linkFd == -1)
+    {
+        goto sock_err;
+    }
+
+    vos_printLog(VOS_LOG_INFO, "AF_XDP socket on %s queue %u (%s mode)\n", pIfName, queueId,
+                 (addr.sxdp_flags & XDP_ZEROCOPY) ? "zero copy" : "copy");
+    *pXdp = pNew;
     return VOS_NO_ERR;
+
+sock_err:
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "AF_XDP socket on %s could not be set up (Err: %s)\n", pIfName, buff);
+    }
+    (void) vos_xdpClose(pNew);
+    return VOS_SOCK_ERR;
+#else
+    if (pXdp != NULL)
+    {
+        *pXdp = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "AF_XDP is not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+#endif
 }
 
 /**********************************************************************************************************************/
-/** Create a TCP socket.
- *  Return a socket descriptor for further calls. The socket options are optional and can be
- *  applied later.
+/** Receive several UDP datagrams from an AF_XDP socket.
+ *  The headers are parsed in the shared frame buffers, only the UDP payload is copied into the buffers supplied by
+ *  pMsgs[]; the frame buffers are returned to the kernel at once. IP and UDP checksums are not verified.
+ *  The call does not block.
  *
- *  @param[out]     pSock           pointer to socket descriptor returned
- *  @param[in]      pOptions        pointer to socket options (optional)
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *  @param[in,out]  pMsgs           array of datagram descriptors (buffer and size in, size, addresses and
+ *                                  reception time out)
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
  *
- *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   pSock == NULL
- *  @retval         VOS_SOCK_ERR    socket not available or option not supported
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_BLOCK_ERR   no data available
  */
 
-EXT_DECL VOS_ERR_T vos_sockOpenTCP (
-    SOCKET                  *pSock,
-    const VOS_SOCK_OPT_T    *pOptions)
+EXT_DECL VOS_ERR_T vos_xdpReceive (
+    VOS_XDP_T       xdp,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
 {
-    int sock;
-
-    if (!vosSockInitialised)
-    {
-        return VOS_INIT_ERR;
-    }
+#ifdef VOS_SOCK_XDP
+    const UINT32    mask = VOS_XDP_RING_SIZE - 1u;
+    UINT32          rxCons, rxProd, fillProd;
+    VOS_TIMEVAL_T   now;
 
-    if (pSock == NULL)
+    if ((xdp == NULL) || (pMsgs == NULL) || (pNoMsgs == NULL))
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
         return VOS_PARAM_ERR;
     }
 
-    if ((sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)) == -1)
+    *pNoMsgs    = 0u;
+    rxCons      = *xdp->rx.pConsumer;
+    rxProd      = __atomic_load_n(xdp->rx.pProducer, __ATOMIC_ACQUIRE);
+    fillProd    = *xdp->fill.pProducer;
+    vos_getTime(&now);
+
+    while ((rxCons != rxProd) && (*pNoMsgs < maxMsgs))
     {
-        char buff[VOS_MAX_ERR_STR_SIZE];
-        STRING_ERR(buff);
-        vos_printLog(VOS_LOG_ERROR, "socket() failed (Err: %s)\n", buff);
-        return VOS_SOCK_ERR;
+        const struct xdp_desc   *pDesc      = &((const struct xdp_desc *) xdp->rx.pDesc)[rxCons & mask];
+        const UINT8             *pFrame     = xdp->pUmem + pDesc->addr;
+        VOS_SOCK_MSG_T          *pMsg       = &pMsgs[*pNoMsgs];
+        UINT32                  ipHdrLen    = (UINT32) (pFrame[14] & 0x0Fu) * 4u;
+        UINT32                  udpLen;
+
+        /*  The XDP program passed IPv4/UDP frames without options only, check the lengths anyway  */
+        udpLen = ((UINT32) pFrame[14u + ipHdrLen + 4u] << 8) | pFrame[14u + ipHdrLen + 5u];
+        if ((pDesc->len >= VOS_XDP_HEADER_SIZE) && (ipHdrLen == 20u) &&
+            (udpLen >= 8u) && (udpLen <= pDesc->len - 34u))
+        {
+            udpLen -= 8u;
+            if (udpLen > pMsg->size)
+            {
+                udpLen = pMsg->size;
+            }
+            memcpy(pMsg->pBuffer, pFrame + VOS_XDP_HEADER_SIZE, udpLen);
+            pMsg->size      = udpLen;
+            pMsg->srcIPAddr = ((UINT32) pFrame[26] << 24) | ((UINT32) pFrame[27] << 16) |
+                ((UINT32) pFrame[28] << 8) | pFrame[29];
+            pMsg->dstIPAddr = ((UINT32) pFrame[30] << 24) | ((UINT32) pFrame[31] << 16) |
+                ((UINT32) pFrame[32] << 8) | pFrame[33];
+            pMsg->srcIPPort = (UINT16) (((UINT32) pFrame[34] << 8) | pFrame[35]);
+            pMsg->dstIPPort = (UINT16) (((UINT32) pFrame[36] << 8) | pFrame[37]);
+            pMsg->rxTime    = now;
+            (*pNoMsgs)++;
+        }
+
+        /*  Hand the frame buffer back to the kernel  */
+        ((UINT64 *) xdp->fill.pDesc)[fillProd & mask] = pDesc->addr & ~(UINT64) (VOS_XDP_FRAME_SIZE - 1u);
+        fillProd++;
+        rxCons++;
     }
 
-    if ((vos_sockSetOptions(sock, pOptions) != VOS_NO_ERR)
-        || (vos_sockSetBuffer(sock) != VOS_NO_ERR))
+    __atomic_store_n(xdp->fill.pProducer, fillProd, __ATOMIC_RELEASE);
+    __atomic_store_n(xdp->rx.pConsumer, rxCons, __ATOMIC_RELEASE);
+    if (__atomic_load_n(xdp->fill.pFlags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP)
     {
-        close(sock);
-        return VOS_SOCK_ERR;
+        (void) recvfrom(xdp->fd, NULL, 0, MSG_DONTWAIT, NULL, NULL);
     }
 
-    *pSock = (SOCKET) sock;
+    return (*pNoMsgs > 0u) ? VOS_NO_ERR : VOS_BLOCK_ERR;
+#else
+    (void) xdp;
+    (void) pMsgs;
+    (void) maxMsgs;
+    (void) pNoMsgs;
+    return VOS_PARAM_ERR;
+#endif
+}
 
-    vos_printLog(VOS_LOG_INFO, "vos_sockOpenTCP: socket()=%d success\n", (int)sock);
+/**********************************************************************************************************************/
+/** Get the descriptor of an AF_XDP socket.
+ *  The descriptor becomes readable when frames were received, it can be used with select() or a poll set.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *  @param[out]     pFd             pointer to the descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpGetFd (
+    VOS_XDP_T   xdp,
+    SOCKET      *pFd)
+{
+    if ((xdp == NULL) || (pFd == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+#ifdef VOS_SOCK_XDP
+    *pFd = xdp->fd;
     return VOS_NO_ERR;
+#else
+    return VOS_PARAM_ERR;
+#endif
 }
 
 /**********************************************************************************************************************/
-/** Close a socket.
- *  Release any resources aquired by this socket
+/** Close an AF_XDP socket.
+ *  The XDP program is detached from the interface, the frame buffers are released.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
  *
- *  @param[in]      sock            socket descriptor
  *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   sock descriptor unknown
+ *  @retval         VOS_PARAM_ERR   parameter error
  */
 
-EXT_DECL VOS_ERR_T vos_sockClose (
-    SOCKET sock)
+EXT_DECL VOS_ERR_T vos_xdpClose (
+    VOS_XDP_T xdp)
 {
-    if (close(sock) == -1)
+    if (xdp == NULL)
     {
-        vos_printLog(VOS_LOG_ERROR,
-                     "vos_sockClose(%d) called with unknown descriptor\n", (int)sock);
         return VOS_PARAM_ERR;
     }
-    else
+#ifdef VOS_SOCK_XDP
+    if (xdp->linkFd != -1)
     {
-        vos_printLog(VOS_LOG_DBG,
-                     "vos_sockClose(%d) okay\n", (int)sock);
+        (void) close(xdp->linkFd);
     }
-
+    if (xdp->progFd != -1)
+    {
+        (void) close(xdp->progFd);
+    }
+    if (xdp->mapFd != -1)
+    {
+        (void) close(xdp->mapFd);
+    }
+    if (xdp->rx.pMap != NULL)
+    {
+        (void) munmap(xdp->rx.pMap, xdp->rx.mapSize);
+    }
+    if (xdp->fill.pMap != NULL)
+    {
+        (void) munmap(xdp->fill.pMap, xdp->fill.mapSize);
+    }
+    if (xdp->comp.pMap != NULL)
+    {
+        (void) munmap(xdp->comp.pMap, xdp->comp.mapSize);
+    }
+    if (xdp->fd != -1)
+    {
+        (void) close(xdp->fd);
+    }
+    if (xdp->pUmem != NULL)
+    {
+        (void) munmap(xdp->pUmem, VOS_XDP_RING_SIZE * VOS_XDP_FRAME_SIZE);
+    }
+    vos_memFree(xdp);
     return VOS_NO_ERR;
+#else
+    return VOS_PARAM_ERR;
+#endif
 }
 
+#ifdef VOS_SOCK_URING
 /**********************************************************************************************************************/
-/** Set socket options.
- *  Note: Some targeted systems might not support every option.
+/** Set up and map the queues of an io_uring
  *
- *  @param[in]      sock            socket descriptor
- *  @param[in]      pOptions        pointer to socket options (optional)
+ *  @param[in]      sqEntries       entries of the submission queue
+ *  @param[in]      cqEntries       entries of the completion queue, 0 for the default
+ *  @param[out]     pRing           queues to set up, fd is -1 on error
  *
  *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   sock descriptor unknown
+ *  @retval         VOS_SOCK_ERR    io_uring could not be set up
  */
-
-EXT_DECL VOS_ERR_T vos_sockSetOptions (
-    SOCKET                  sock,
-    const VOS_SOCK_OPT_T    *pOptions)
+static VOS_ERR_T vos_uringSetup (
+    UINT32              sqEntries,
+    UINT32              cqEntries,
+    VOS_URING_RING_T    *pRing)
 {
-    int sockOptValue = 0;
+    struct io_uring_params  params;
+    UINT8                   *pMap;
+    UINT32                  *pArray;
+    UINT32                  i;
+
+    memset(pRing, 0, sizeof(VOS_URING_RING_T));
+    memset(&params, 0, sizeof(params));
+    if (cqEntries != 0u)
+    {
+        params.flags        = IORING_SETUP_CQSIZE;
+        params.cq_entries   = cqEntries;
+    }
+    pRing->fd = (int) syscall(__NR_io_uring_setup, sqEntries, &params);
+    if (pRing->fd == -1)
+    {
+        return VOS_SOCK_ERR;
+    }
+    /*  Submission and completion queue share one mapping since Linux 5.4  */
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP))
+    {
+        return VOS_SOCK_ERR;
+    }
 
-    if (pOptions)
+    pRing->mapSize = params.sq_off.array + params.sq_entries * sizeof(UINT32);
+    if (pRing->mapSize < params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe))
     {
-        if (1 == pOptions->reuseAddrPort)
-        {
-            sockOptValue = 1;
-#ifdef SO_REUSEPORT
-            if (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &sockOptValue,
-                           sizeof(sockOptValue)) == -1)
-            {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_REUSEPORT failed (Err: %s)\n", buff);
-            }
+        pRing->mapSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    }
+    pMap = (UINT8 *) mmap(NULL, pRing->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pRing->fd,
+                          (off_t) IORING_OFF_SQ_RING);
+    if (pMap == (UINT8 *) MAP_FAILED)
+    {
+        return VOS_SOCK_ERR;
+    }
+    pRing->pMap     = pMap;
+    pRing->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    pRing->pSqes    = (struct io_uring_sqe *) mmap(NULL, pRing->sqesSize, PROT_READ | PROT_WRITE,
+                                                   MAP_SHARED | MAP_POPULATE, pRing->fd, (off_t) IORING_OFF_SQES);
+    if (pRing->pSqes == (struct io_uring_sqe *) MAP_FAILED)
+    {
+        pRing->pSqes = NULL;
+        return VOS_SOCK_ERR;
+    }
+
+    pRing->pSqHead      = (UINT32 *) (pMap + params.sq_off.head);
+    pRing->pSqTail      = (UINT32 *) (pMap + params.sq_off.tail);
+    pRing->sqTail       = *pRing->pSqTail;
+    pRing->sqEntries    = params.sq_entries;
+    pRing->pCqHead      = (UINT32 *) (pMap + params.cq_off.head);
+    pRing->pCqTail      = (UINT32 *) (pMap + params.cq_off.tail);
+    pRing->cqMask       = *(UINT32 *) (pMap + params.cq_off.ring_mask);
+    pRing->pCqes        = (struct io_uring_cqe *) (pMap + params.cq_off.cqes);
+
+    /*  Submission entry i is always found in slot i  */
+    pArray = (UINT32 *) (pMap + params.sq_off.array);
+    for (i = 0u; i < params.sq_entries; i++)
+    {
+        pArray[i] = i;
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release the queues of an io_uring
+ *
+ *  @param[in]      pRing           queues to release
+ */
+static void vos_uringTeardown (
+    VOS_URING_RING_T *pRing)
+{
+    if (pRing->pSqes != NULL)
+    {
+        (void) munmap(pRing->pSqes, pRing->sqesSize);
+    }
+    if (pRing->pMap != NULL)
+    {
+        (void) munmap(pRing->pMap, pRing->mapSize);
+    }
+    if (pRing->fd != -1)
+    {
+        (void) close(pRing->fd);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Get a cleared submission entry
+ *
+ *  @param[in]      pRing           queues
+ *
+ *  @retval         pointer to the entry, NULL if the submission queue is full
+ */
+static struct io_uring_sqe *vos_uringGetSqe (
+    VOS_URING_RING_T *pRing)
+{
+    struct io_uring_sqe *pSqe;
+
+    if (pRing->sqTail - __atomic_load_n(pRing->pSqHead, __ATOMIC_ACQUIRE) >= pRing->sqEntries)
+    {
+        return NULL;
+    }
+    pSqe = &pRing->pSqes[pRing->sqTail & (pRing->sqEntries - 1u)];
+    memset(pSqe, 0, sizeof(struct io_uring_sqe));
+    pRing->sqTail++;
+    return pSqe;
+}
+
+/**********************************************************************************************************************/
+/** Submit the queued entries and wait for completions
+ *
+ *  @param[in]      pRing           queues
+ *  @param[in]      minComplete     completions to wait for
+ *
+ *  @retval         number of entries submitted, -1 on error
+ */
+static int vos_uringEnter (
+    VOS_URING_RING_T    *pRing,
+    UINT32              minComplete)
+{
+    int ret;
+
+    __atomic_store_n(pRing->pSqTail, pRing->sqTail, __ATOMIC_RELEASE);
+    do
+    {
+        ret = (int) syscall(__NR_io_uring_enter, pRing->fd,
+                            pRing->sqTail - __atomic_load_n(pRing->pSqHead, __ATOMIC_ACQUIRE), minComplete,
+                            (minComplete > 0u) ? IORING_ENTER_GETEVENTS : 0u, NULL, 0);
+    }
+    while ((ret == -1) && (errno == EINTR));
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Queue a multishot receive for a socket
+ *  The datagrams are placed into the provided buffers, each behind a struct io_uring_recvmsg_out and the name and
+ *  control space of rcvHdr. The request is tagged with the socket's slot and generation.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      slot            slot of the socket
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_QUEUE_FULL_ERR no room for the request
+ */
+static VOS_ERR_T vos_uringQueueRecv (
+    VOS_URING_T ring,
+    UINT32      slot)
+{
+    struct io_uring_sqe *pSqe = vos_uringGetSqe(&ring->rx);
+
+    if (pSqe == NULL)
+    {
+        return VOS_QUEUE_FULL_ERR;
+    }
+    pSqe->opcode    = IORING_OP_RECVMSG;
+    pSqe->fd        = ring->socks[slot];
+    pSqe->addr      = (UINT64) (uintptr_t) &ring->rcvHdr;
+    pSqe->len       = 1u;
+    pSqe->ioprio    = IORING_RECV_MULTISHOT;
+    pSqe->flags     = IOSQE_BUFFER_SELECT;
+    pSqe->buf_group = VOS_URING_BGID;
+    pSqe->user_data = ((UINT64) ring->gen[slot] << 32) | slot;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Hand a receive buffer back to the kernel
+ *  The buffer ring's tail is published by the caller.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      bid             buffer id
+ */
+static void vos_uringRecycle (
+    VOS_URING_T ring,
+    UINT16      bid)
+{
+    struct io_uring_buf *pBuf = &ring->pBufRing->bufs[ring->bufTail & (ring->noOfBuffers - 1u)];
+
+    pBuf->addr  = (UINT64) (uintptr_t) (ring->pBufs + (size_t) bid * ring->bufSize);
+    pBuf->len   = ring->bufSize;
+    pBuf->bid   = bid;
+    ring->bufTail++;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Open an io_uring for receiving and sending UDP datagrams.
+ *  Sockets added with vos_uringAddRecv() are read by multishot receive requests: the kernel keeps placing datagrams
+ *  into a ring of noOfBuffers buffers of bufSize bytes each, shared with the application, without a system call per
+ *  datagram. Sends are queued and submitted with one system call.
+ *  Needs Linux 6.0 or later and a build with VOS_URING=1.
+ *
+ *  @param[out]     pRing           pointer to the handle of the ring
+ *  @param[in]      noOfBuffers     number of receive buffers, a power of 2
+ *  @param[in]      bufSize         size of a receive buffer, at least the largest datagram expected
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    the ring could not be set up
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringOpen (
+    VOS_URING_T *pRing,
+    UINT32      noOfBuffers,
+    UINT32      bufSize)
+{
+#ifdef VOS_SOCK_URING
+    struct VOS_URING        *pNew;
+    struct io_uring_buf_reg bufReg;
+    UINT32                  i;
+
+    if ((pRing == NULL) || (noOfBuffers == 0u) || (noOfBuffers > 32768u) ||
+        ((noOfBuffers & (noOfBuffers - 1u)) != 0u) || (bufSize == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+    *pRing = NULL;
+
+    pNew = (struct VOS_URING *) vos_memAlloc(sizeof(struct VOS_URING));
+    if (pNew == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    pNew->rx.fd         = -1;
+    pNew->tx.fd         = -1;
+    pNew->noOfBuffers   = noOfBuffers;
+    pNew->bufSize       = (UINT32) (sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_in)) +
+        VOS_SOCK_CONTROL_SIZE + bufSize;
+    pNew->rcvHdr.msg_namelen    = sizeof(struct sockaddr_in);
+    pNew->rcvHdr.msg_controllen = VOS_SOCK_CONTROL_SIZE;
+    for (i = 0u; i < VOS_MAX_SOCKET_CNT; i++)
+    {
+        pNew->socks[i] = -1;
+    }
+
+    /*  Room for a completion per buffer: a multishot receive stops when the completion queue overflows  */
+    if ((vos_uringSetup(VOS_URING_RX_ENTRIES, 2u * noOfBuffers, &pNew->rx) != VOS_NO_ERR) ||
+        (vos_uringSetup(VOS_URING_TX_ENTRIES, 0u, &pNew->tx) != VOS_NO_ERR))
+    {
+        goto sock_err;
+    }
+
+    /*  Provided buffers, all of them are handed to the kernel  */
+    pNew->pBufRing = (struct io_uring_buf_ring *) mmap(NULL, noOfBuffers * sizeof(struct io_uring_buf),
+                                                       PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pNew->pBufRing == (struct io_uring_buf_ring *) MAP_FAILED)
+    {
+        pNew->pBufRing = NULL;
+        goto sock_err;
+    }
+    pNew->pBufs = (UINT8 *) mmap(NULL, (size_t) noOfBuffers * pNew->bufSize, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pNew->pBufs == (UINT8 *) MAP_FAILED)
+    {
+        pNew->pBufs = NULL;
+        goto sock_err;
+    }
+    memset(&bufReg, 0, sizeof(bufReg));
+    bufReg.ring_addr    = (UINT64) (uintptr_t) pNew->pBufRing;
+    bufReg.ring_entries = noOfBuffers;
+    bufReg.bgid         = VOS_URING_BGID;
+    if (syscall(__NR_io_uring_register, pNew->rx.fd, IORING_REGISTER_PBUF_RING, &bufReg, 1) == -1)
+    {
+        goto sock_err;
+    }
+    for (i = 0u; i < noOfBuffers; i++)
+    {
+        vos_uringRecycle(pNew, (UINT16) i);
+    }
+    __atomic_store_n(&pNew->pBufRing->tail, pNew->bufTail, __ATOMIC_RELEASE);
+
+    vos_printLog(VOS_LOG_INFO, "io_uring with %u receive buffers\n", noOfBuffers);
+    *pRing = pNew;
+    return VOS_NO_ERR;
+
+sock_err:
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "io_uring could not be set up (Err: %s)\n", buff);
+    }
+    (void) vos_uringClose(pNew);
+    return VOS_SOCK_ERR;
 #else
-            if (setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &sockOptValue,
-                           sizeof(sockOptValue)) == -1)
-            {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_REUSEADDR failed (Err: %s)\n", buff);
-            }
+    (void) noOfBuffers;
+    (void) bufSize;
+    if (pRing != NULL)
+    {
+        *pRing = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "io_uring is not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
 #endif
+}
+
+/**********************************************************************************************************************/
+/** Start receiving from a UDP socket through an io_uring.
+ *  The socket should be non-blocking. Its datagrams are fetched with vos_uringReceive() from now on, the socket must
+ *  not be read otherwise. Before the socket is closed it has to be removed with vos_uringRemoveRecv().
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_QUEUE_FULL_ERR no room for the request
+ */
+
+EXT_DECL VOS_ERR_T vos_uringAddRecv (
+    VOS_URING_T ring,
+    SOCKET      sock)
+{
+#ifdef VOS_SOCK_URING
+    VOS_ERR_T   err;
+    UINT32      slot    = VOS_MAX_SOCKET_CNT;
+    UINT32      i;
+
+    if ((ring == NULL) || (sock == -1))
+    {
+        return VOS_PARAM_ERR;
+    }
+    for (i = 0u; i < VOS_MAX_SOCKET_CNT; i++)
+    {
+        if (ring->socks[i] == sock)
+        {
+            return VOS_NO_ERR;
         }
-        if (1 == pOptions->nonBlocking)
+        if ((ring->socks[i] == -1) && (slot == VOS_MAX_SOCKET_CNT))
         {
-            if (fcntl(sock, F_SETFL, O_NONBLOCK) == -1)
+            slot = i;
+        }
+    }
+    if (slot == VOS_MAX_SOCKET_CNT)
+    {
+        return VOS_QUEUE_FULL_ERR;
+    }
+    ring->socks[slot]   = sock;
+    ring->gen[slot]     = ring->nextGen++;
+    err = vos_uringQueueRecv(ring, slot);
+    if ((err != VOS_NO_ERR) || (vos_uringEnter(&ring->rx, 0u) == -1))
+    {
+        ring->socks[slot] = -1;
+        return VOS_QUEUE_FULL_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    (void) ring;
+    (void) sock;
+    return VOS_PARAM_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Stop receiving from a UDP socket through an io_uring.
+ *  The multishot receive is cancelled. Datagrams it still delivers are dropped by vos_uringReceive().
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_uringRemoveRecv (
+    VOS_URING_T ring,
+    SOCKET      sock)
+{
+#ifdef VOS_SOCK_URING
+    struct io_uring_sqe *pSqe;
+    UINT32              slot;
+
+    if ((ring == NULL) || (sock == -1))
+    {
+        return VOS_PARAM_ERR;
+    }
+    for (slot = 0u; (slot < VOS_MAX_SOCKET_CNT) && (ring->socks[slot] != sock); slot++)
+    {
+        ;
+    }
+    if (slot == VOS_MAX_SOCKET_CNT)
+    {
+        return VOS_PARAM_ERR;
+    }
+    pSqe = vos_uringGetSqe(&ring->rx);
+    if (pSqe != NULL)
+    {
+        pSqe->opcode    = IORING_OP_ASYNC_CANCEL;
+        pSqe->addr      = ((UINT64) ring->gen[slot] << 32) | slot;
+        pSqe->user_data = VOS_URING_CANCEL;
+        (void) vos_uringEnter(&ring->rx, 0u);
+    }
+    ring->socks[slot] = -1;
+    return VOS_NO_ERR;
+#else
+    (void) ring;
+    (void) sock;
+    return VOS_PARAM_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams from the sockets of an io_uring.
+ *  The completions are reaped from the shared completion queue, the payload is copied into the buffers supplied by
+ *  pMsgs[] and the ring buffers are handed back to the kernel. A multishot receive the kernel stopped (e.g. when it
+ *  ran out of buffers) is queued again. The call does not block.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pSocks          array of maxMsgs receiving sockets, NULL if not needed
+ *  @param[in,out]  pMsgs           array of datagram descriptors (buffer and size in, size, addresses and
+ *                                  reception time out, see vos_sockReceiveUDPTime)
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_BLOCK_ERR   no data available
+ */
+
+EXT_DECL VOS_ERR_T vos_uringReceive (
+    VOS_URING_T     ring,
+    SOCKET          *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+#ifdef VOS_SOCK_URING
+    UINT32  cqHead, cqTail;
+    UINT32  rearm = 0u;
+
+    if ((ring == NULL) || (pMsgs == NULL) || (pNoMsgs == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pNoMsgs    = 0u;
+    cqHead      = *ring->rx.pCqHead;
+    cqTail      = __atomic_load_n(ring->rx.pCqTail, __ATOMIC_ACQUIRE);
+
+    while ((cqHead != cqTail) && (*pNoMsgs < maxMsgs))
+    {
+        const struct io_uring_cqe   *pCqe   = &ring->rx.pCqes[cqHead & ring->rx.cqMask];
+        UINT32                      slot    = (UINT32) (pCqe->user_data & 0xFFFFFFFFu);
+        BOOL8                       active;
+
+        active = (pCqe->user_data != VOS_URING_CANCEL) && (slot < VOS_MAX_SOCKET_CNT) &&
+            (ring->socks[slot] != -1) && (ring->gen[slot] == (UINT32) (pCqe->user_data >> 32));
+
+        if (pCqe->flags & IORING_CQE_F_BUFFER)
+        {
+            UINT16                              bid     = (UINT16) (pCqe->flags >> IORING_CQE_BUFFER_SHIFT);
+            UINT8                               *pBuf   = ring->pBufs + (size_t) bid * ring->bufSize;
+            const struct io_uring_recvmsg_out   *pOut   = (const struct io_uring_recvmsg_out *) pBuf;
+            UINT32                              offset  = (UINT32) (sizeof(struct io_uring_recvmsg_out) +
+                                                                    sizeof(struct sockaddr_in)) + VOS_SOCK_CONTROL_SIZE;
+
+            if (active && (pCqe->res >= (INT32) offset))
             {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() O_NONBLOCK failed (Err: %s)\n", buff);
-                return VOS_SOCK_ERR;
+                VOS_SOCK_MSG_T              *pMsg   = &pMsgs[*pNoMsgs];
+                const struct sockaddr_in    *pName  = (const struct sockaddr_in *) (pOut + 1);
+                struct msghdr               hdr;
+                UINT32                      size    = pOut->payloadlen;
+
+                if (size > (UINT32) pCqe->res - offset)
+                {
+                    size = (UINT32) pCqe->res - offset;
+                }
+                if (size > pMsg->size)
+                {
+                    size = pMsg->size;
+                }
+                memcpy(pMsg->pBuffer, pBuf + offset, size);
+                pMsg->size      = size;
+                pMsg->srcIPAddr = vos_ntohl(pName->sin_addr.s_addr);
+                pMsg->srcIPPort = vos_ntohs(pName->sin_port);
+                pMsg->dstIPAddr = 0u;
+                pMsg->dstIPPort = 0u;
+
+                /*  The control messages are read as if returned by recvmsg()  */
+                memset(&hdr, 0, sizeof(hdr));
+                hdr.msg_control     = pBuf + sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_in);
+                hdr.msg_controllen  = pOut->controllen;
+                vos_sockGetDstAddr(&hdr, &pMsg->dstIPAddr);
+                vos_sockGetRxTime(&hdr, &pMsg->rxTime);
+                if (pSocks != NULL)
+                {
+                    pSocks[*pNoMsgs] = ring->socks[slot];
+                }
+                (*pNoMsgs)++;
             }
+            vos_uringRecycle(ring, bid);
         }
-        if (pOptions->qos > 0 && pOptions->qos < 8)
+
+        /*  Stopped by the kernel, not cancelled: queue the receive again  */
+        if (active && !(pCqe->flags & IORING_CQE_F_MORE))
         {
-#ifdef SO_NET_SERVICE_TYPE
-            /* Darwin/BSD: Depending on socket typ, sets the layer 2 priority as well.
-             NET_SERVICE_TYPE_BE    0  Best effort
-             NET_SERVICE_TYPE_BK    1  Background system initiated
-             NET_SERVICE_TYPE_SIG   2  Signaling
-             NET_SERVICE_TYPE_VI    3  Interactive Video
-             NET_SERVICE_TYPE_VO    4  Interactive Voice
-             NET_SERVICE_TYPE_RV    5  Responsive Multimedia Audio/Video
-             NET_SERVICE_TYPE_AV    6  Multimedia Audio/Video Streaming
-             NET_SERVICE_TYPE_OAM   7  Operations, Administration, and Management
-             NET_SERVICE_TYPE_RD    8  Responsive Data
-             */
-            sockOptValue = (int) pOptions->qos + 1;
-            if (sockOptValue == 1) /* Best effort and background share same priority */
+            if ((pCqe->res >= 0) || (pCqe->res == -ENOBUFS))
             {
-                sockOptValue = 0;
+                if (vos_uringQueueRecv(ring, slot) == VOS_NO_ERR)
+                {
+                    rearm++;
+                }
             }
-            if (setsockopt(sock, SOL_SOCKET, SO_NET_SERVICE_TYPE, &sockOptValue,
-                           sizeof(sockOptValue)) == -1)
+            else
             {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_NET_SERVICE_TYPE failed (Err: %s)\n", buff);
+                vos_printLog(VOS_LOG_ERROR, "io_uring receive on socket %d stopped (Err: %d)\n",
+                             ring->socks[slot], -pCqe->res);
             }
-#else
-            /* The QoS value (0-7) was mapped to MSB bits 7-5, bit 2 was set for local use.
-             TOS field is deprecated and has been succeeded by RFC 2474 and RFC 3168. Usage depends on IP-routers.
-             This field is now called the "DS" (Differentiated Services) field and the upper 6 bits contain
-             a value called the "DSCP" (Differentiated Services Code Point).
-             QoS as priority value is now mapped to DSCP values and the Explicit Congestion Notification (ECN)
-             is set to 0 */
+        }
+        cqHead++;
+    }
 
-            /*  old:
-                sockOptValue = (int) ((pOptions->qos << 5) | 4);
-                New: */
-            const int dscpMap[] = {0, 8, 18, 24, 34, 40, 48, 56};
-            sockOptValue = (int) dscpMap[pOptions->qos];
-            if (setsockopt(sock, IPPROTO_IP, IP_TOS, (char *)&sockOptValue,
-                           sizeof(sockOptValue)) == -1)
-            {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_WARNING, "setsockopt() IP_TOS failed (Err: %s)\n", buff);
-            }
+    __atomic_store_n(ring->rx.pCqHead, cqHead, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->pBufRing->tail, ring->bufTail, __ATOMIC_RELEASE);
+    if (rearm > 0u)
+    {
+        (void) vos_uringEnter(&ring->rx, 0u);
+    }
+
+    return (*pNoMsgs > 0u) ? VOS_NO_ERR : VOS_BLOCK_ERR;
+#else
+    (void) ring;
+    (void) pSocks;
+    (void) pMsgs;
+    (void) maxMsgs;
+    (void) pNoMsgs;
+    return VOS_PARAM_ERR;
 #endif
+}
 
-#ifdef SO_PRIORITY
-            /* if available (and the used socket is tagged) set the VLAN PCP field as well. */
-            sockOptValue = (int) pOptions->qos;
-            if (setsockopt(sock, SOL_SOCKET, SO_PRIORITY, &sockOptValue,
-                           sizeof(sockOptValue)) == -1)
+/**********************************************************************************************************************/
+/** Send several UDP datagrams, possibly on different sockets, with one call.
+ *  Entry i of pMsgs[] is sent on pSocks[i]. Up to VOS_URING_TX_ENTRIES datagrams are submitted with one system call,
+ *  which returns when they have been handed to the network stack. A QoS given with a datagram is set as its IP TOS
+ *  and SO_PRIORITY. A datagram the ring could not send is sent with vos_sockSendUDPBatch(). On return, the size of
+ *  each entry holds the number of bytes sent, 0 if the datagram could not be sent.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      pSocks          array of noMsgs sending sockets
+ *  @param[in,out]  pMsgs           array of datagram descriptors (size in: to send, out: bytes sent)
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ */
+
+EXT_DECL VOS_ERR_T vos_uringSend (
+    VOS_URING_T     ring,
+    const SOCKET    *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs)
+{
+#ifdef VOS_SOCK_URING
+    VOS_ERR_T   err     = VOS_NO_ERR;
+    UINT32      done    = 0u;
+    UINT32      chunk;
+    UINT32      queued;
+    UINT32      submitted;
+    UINT32      reaped;
+    UINT32      i;
+    BOOL8       sent[VOS_URING_TX_ENTRIES];
+    int         ret;
+
+    if ((ring == NULL) || (pSocks == NULL) || (pMsgs == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    while (done < noMsgs)
+    {
+        chunk = noMsgs - done;
+        if (chunk > VOS_URING_TX_ENTRIES)
+        {
+            chunk = VOS_URING_TX_ENTRIES;
+        }
+
+        for (i = 0u, queued = 0u; i < chunk; i++)
+        {
+            VOS_SOCK_MSG_T      *pMsg   = &pMsgs[done + i];
+            struct io_uring_sqe *pSqe   = vos_uringGetSqe(&ring->tx);
+
+            sent[i] = FALSE;
+            if (pSqe == NULL)
             {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_PRIORITY failed (Err: %s)\n", buff);
+                continue;
             }
-#endif
+            memset(&ring->txHdr[i], 0, sizeof(struct msghdr));
+            memset(&ring->txAddr[i], 0, sizeof(struct sockaddr_in));
+            ring->txAddr[i].sin_family      = AF_INET;
+            ring->txAddr[i].sin_addr.s_addr = vos_htonl(pMsg->dstIPAddr);
+            ring->txAddr[i].sin_port        = vos_htons(pMsg->dstIPPort);
+            ring->txIov[i].iov_base         = pMsg->pBuffer;
+            ring->txIov[i].iov_len          = pMsg->size;
+            ring->txHdr[i].msg_iov          = &ring->txIov[i];
+            ring->txHdr[i].msg_iovlen       = 1;
+            ring->txHdr[i].msg_name         = &ring->txAddr[i];
+            ring->txHdr[i].msg_namelen      = sizeof(struct sockaddr_in);
+            if ((pMsg->qos > 0u) && (pMsg->qos < 8u))
+            {
+                vos_sockQosControl(&ring->txHdr[i], ring->txControl[i].raw, pMsg->qos);
+            }
+            pSqe->opcode    = IORING_OP_SENDMSG;
+            pSqe->fd        = pSocks[done + i];
+            pSqe->addr      = (UINT64) (uintptr_t) &ring->txHdr[i];
+            pSqe->len       = 1u;
+            pSqe->user_data = i;
+            queued++;
         }
-        if (pOptions->ttl > 0)
+
+        ret         = vos_uringEnter(&ring->tx, queued);
+        submitted   = (ret > 0) ? (UINT32) ret : 0u;
+        if (submitted < queued)
         {
-            sockOptValue = pOptions->ttl;
-            if (setsockopt(sock, IPPROTO_IP, IP_TTL, &sockOptValue,
-                           sizeof(sockOptValue)) == -1)
+            /*  Take back what the kernel did not consume  */
+            ring->tx.sqTail -= queued - submitted;
+            __atomic_store_n(ring->tx.pSqTail, ring->tx.sqTail, __ATOMIC_RELEASE);
+        }
+
+        for (reaped = 0u; reaped < submitted; )
+        {
+            UINT32  cqHead  = *ring->tx.pCqHead;
+            UINT32  cqTail  = __atomic_load_n(ring->tx.pCqTail, __ATOMIC_ACQUIRE);
+
+            if (cqHead == cqTail)
             {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_TTL failed (Err: %s)\n", buff);
+                if (vos_uringEnter(&ring->tx, submitted - reaped) == -1)
+                {
+                    break;
+                }
+                continue;
+            }
+            for (; cqHead != cqTail; cqHead++, reaped++)
+            {
+                const struct io_uring_cqe *pCqe = &ring->tx.pCqes[cqHead & ring->tx.cqMask];
+
+                i = (UINT32) pCqe->user_data;
+                if ((i < chunk) && (pCqe->res >= 0))
+                {
+                    pMsgs[done + i].size    = (UINT32) pCqe->res;
+                    sent[i]                 = TRUE;
+                }
             }
+            __atomic_store_n(ring->tx.pCqHead, cqHead, __ATOMIC_RELEASE);
         }
-        if (pOptions->ttl_multicast > 0)
+
+        /*  Datagrams refused by the ring, or not submitted, are sent directly  */
+        for (i = 0u; i < chunk; i++)
         {
-            sockOptValue = pOptions->ttl_multicast;
-            if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, &sockOptValue,
-                           sizeof(sockOptValue)) == -1)
+            if (!sent[i] && (vos_sockSendUDPBatch(pSocks[done + i], &pMsgs[done + i], 1u) != VOS_NO_ERR))
             {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_MULTICAST_TTL failed (Err: %s)\n", buff);
+                err = VOS_IO_ERR;
             }
         }
-        if (pOptions->no_mc_loop > 0)
+        done += chunk;
+    }
+    return err;
+#else
+    (void) ring;
+    (void) pSocks;
+    (void) pMsgs;
+    (void) noMsgs;
+    return VOS_PARAM_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of an io_uring.
+ *  The descriptor becomes readable when receive completions are pending, it can be used with select() or a poll set.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pFd             pointer to the descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_uringGetFd (
+    VOS_URING_T ring,
+    SOCKET      *pFd)
+{
+    if ((ring == NULL) || (pFd == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+#ifdef VOS_SOCK_URING
+    *pFd = ring->rx.fd;
+    return VOS_NO_ERR;
+#else
+    return VOS_PARAM_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Close an io_uring.
+ *  Pending requests are cancelled by the kernel, the buffers are released. The sockets are not closed.
+ *
+ *  @param[in]      ring            handle of the ring
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_uringClose (
+    VOS_URING_T ring)
+{
+    if (ring == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+#ifdef VOS_SOCK_URING
+    vos_uringTeardown(&ring->rx);
+    vos_uringTeardown(&ring->tx);
+    if (ring->pBufRing != NULL)
+    {
+        (void) munmap(ring->pBufRing, ring->noOfBuffers * sizeof(struct io_uring_buf));
+    }
+    if (ring->pBufs != NULL)
+    {
+        (void) munmap(ring->pBufs, (size_t) ring->noOfBuffers * ring->bufSize);
+    }
+    vos_memFree(ring);
+    return VOS_NO_ERR;
+#else
+    return VOS_PARAM_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Get a list of interface addresses
+ *  The caller has to provide an array of interface records to be filled.
+ *
+ *  @param[in,out]  pAddrCnt          in:   pointer to array size of interface record
+ *                                    out:  pointer to number of interface records read
+ *  @param[in,out]  ifAddrs           array of interface records
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pMAC == NULL
+ */
+EXT_DECL VOS_ERR_T vos_getInterfaces (
+    UINT32          *pAddrCnt,
+    VOS_IF_REC_T    ifAddrs[])
+{
+    int success;
+    struct ifaddrs  *addrs;
+    struct ifaddrs  *cursor;
+    unsigned int    count = 0;
+
+    if (pAddrCnt == NULL ||
+        *pAddrCnt == 0 ||
+        ifAddrs == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    success = getifaddrs(&addrs) == 0;
+    if (success)
+    {
+        cursor = addrs;
+        while (cursor != 0 && count < *pAddrCnt)
+        {
+            if (cursor->ifa_addr != NULL && cursor->ifa_addr->sa_family == AF_INET)
+            {
+                memcpy(&ifAddrs[count].ipAddr, &cursor->ifa_addr->sa_data[2], 4);
+                ifAddrs[count].ipAddr = vos_ntohl(ifAddrs[count].ipAddr);
+                memcpy(&ifAddrs[count].netMask, &cursor->ifa_netmask->sa_data[2], 4);
+                ifAddrs[count].netMask = vos_ntohl(ifAddrs[count].netMask);
+                if (cursor->ifa_name != NULL)
+                {
+                    strncpy((char *) ifAddrs[count].name, cursor->ifa_name, VOS_MAX_IF_NAME_SIZE);
+                    ifAddrs[count].name[VOS_MAX_IF_NAME_SIZE - 1] = 0;
+                }
+                vos_printLog(VOS_LOG_INFO, "IP-Addr for '%s': %u.%u.%u.%u\n",
+                             ifAddrs[count].name,
+                             (unsigned int)(ifAddrs[count].ipAddr >> 24) & 0xFF,
+                             (unsigned int)(ifAddrs[count].ipAddr >> 16) & 0xFF,
+                             (unsigned int)(ifAddrs[count].ipAddr >> 8)  & 0xFF,
+                             (unsigned int)(ifAddrs[count].ipAddr        & 0xFF));
+                if (vos_getMacAddress(ifAddrs[count].mac, ifAddrs[count].name) == TRUE)
+                {
+                    vos_printLog(VOS_LOG_INFO, "Mac-Addr for '%s': %02x:%02x:%02x:%02x:%02x:%02x\n",
+                                 ifAddrs[count].name,
+                                 (unsigned int)ifAddrs[count].mac[0],
+                                 (unsigned int)ifAddrs[count].mac[1],
+                                 (unsigned int)ifAddrs[count].mac[2],
+                                 (unsigned int)ifAddrs[count].mac[3],
+                                 (unsigned int)ifAddrs[count].mac[4],
+                                 (unsigned int)ifAddrs[count].mac[5]);
+                }
+                if (cursor->ifa_flags & IFF_RUNNING)
+                {
+                    ifAddrs[count].linkState = TRUE;
+                }
+                else
+                {
+                    ifAddrs[count].linkState = FALSE;
+                }
+                count++;
+            }
+            cursor = cursor->ifa_next;
+        }
+
+        freeifaddrs(addrs);
+    }
+    else
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pAddrCnt = count;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the state of an interface
+ *
+ *
+ *  @param[in]      ifAddress       address of interface to check
+ *
+ *  @retval         TRUE            interface is up and ready
+ *                  FALSE           interface is down / not ready
+ */
+EXT_DECL BOOL8 vos_netIfUp (
+    VOS_IP4_ADDR_T ifAddress)
+{
+    struct ifaddrs  *addrs;
+    struct ifaddrs  *cursor;
+    VOS_IF_REC_T    ifAddrs;
+
+    ifAddrs.linkState = FALSE;
+
+    if (getifaddrs(&addrs) == 0)
+    {
+        cursor = addrs;
+        while (cursor != 0)
+        {
+            if (cursor->ifa_addr != NULL && cursor->ifa_addr->sa_family == AF_INET)
+            {
+                memcpy(&ifAddrs.ipAddr, &cursor->ifa_addr->sa_data[2], 4);
+                ifAddrs.ipAddr = vos_ntohl(ifAddrs.ipAddr);
+                /* Exit if first (default) interface matches */
+                if (ifAddress == VOS_INADDR_ANY || ifAddress == ifAddrs.ipAddr)
+                {
+                    if (cursor->ifa_flags & IFF_UP)
+                    {
+                        ifAddrs.linkState = TRUE;
+                    }
+                    /* vos_printLog(VOS_LOG_INFO, "cursor->ifa_flags = 0x%x\n", cursor->ifa_flags); */
+                    break;
+                }
+            }
+            cursor = cursor->ifa_next;
+        }
+
+        freeifaddrs(addrs);
+
+    }
+    return ifAddrs.linkState;
+}
+
+/*    Sockets    */
+
+/**********************************************************************************************************************/
+/** Initialize the socket library.
+ *  Must be called once before any other call
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_SOCK_ERR        sockets not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockInit (void)
+{
+    memset(&gIfr, 0, sizeof(gIfr));
+    vosSockInitialised = TRUE;
+
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** De-Initialize the socket library.
+ *  Must be called after last socket call
+ *
+ */
+
+EXT_DECL void vos_sockTerm (void)
+{
+    vosSockInitialised = FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Return the MAC address of the default adapter.
+ *
+ *  @param[out]     pMAC            return MAC address.
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pMAC == NULL
+ *  @retval         VOS_SOCK_ERR    socket not available or option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetMAC (
+    UINT8 pMAC[VOS_MAC_SIZE])
+{
+    if (pMAC == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
+        return VOS_PARAM_ERR;
+    }
+
+    if (vos_getMacAddress(pMAC, cDefaultIface) == TRUE)
+    {
+        return VOS_NO_ERR;
+    }
+
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create an UDP socket.
+ *  Return a socket descriptor for further calls. The socket options are optional and can be
+ *  applied later.
+ *  Note: Some targeted systems might not support every option.
+ *
+ *  @param[out]     pSock           pointer to socket descriptor returned
+ *  @param[in]      pOptions        pointer to socket options (optional)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pSock == NULL
+ *  @retval         VOS_SOCK_ERR    socket not available or option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenUDP (
+    SOCKET                  *pSock,
+    const VOS_SOCK_OPT_T    *pOptions)
+{
+    int sock;
+
+    if (!vosSockInitialised)
+    {
+        return VOS_INIT_ERR;
+    }
+
+    if (pSock == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
+        return VOS_PARAM_ERR;
+    }
+
+    if ((sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "socket() failed (Err: %s)\n", buff);
+        return VOS_SOCK_ERR;
+    }
+
+    if ((vos_sockSetOptions(sock, pOptions) != VOS_NO_ERR)
+        || (vos_sockSetBuffer(sock) != VOS_NO_ERR))
+    {
+        close(sock);
+        vos_printLogStr(VOS_LOG_ERROR, "socket() failed, setsockoptions or buffer failed!\n");
+        return VOS_SOCK_ERR;
+    }
+
+    *pSock = (SOCKET) sock;
+
+    vos_printLog(VOS_LOG_DBG, "vos_sockOpenUDP: socket()=%d success\n", (int)sock);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create a TCP socket.
+ *  Return a socket descriptor for further calls. The socket options are optional and can be
+ *  applied later.
+ *
+ *  @param[out]     pSock           pointer to socket descriptor returned
+ *  @param[in]      pOptions        pointer to socket options (optional)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pSock == NULL
+ *  @retval         VOS_SOCK_ERR    socket not available or option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenTCP (
+    SOCKET                  *pSock,
+    const VOS_SOCK_OPT_T    *pOptions)
+{
+    int sock;
+
+    if (!vosSockInitialised)
+    {
+        return VOS_INIT_ERR;
+    }
+
+    if (pSock == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
+        return VOS_PARAM_ERR;
+    }
+
+    if ((sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "socket() failed (Err: %s)\n", buff);
+        return VOS_SOCK_ERR;
+    }
+
+    if ((vos_sockSetOptions(sock, pOptions) != VOS_NO_ERR)
+        || (vos_sockSetBuffer(sock) != VOS_NO_ERR))
+    {
+        close(sock);
+        return VOS_SOCK_ERR;
+    }
+
+    *pSock = (SOCKET) sock;
+
+    vos_printLog(VOS_LOG_INFO, "vos_sockOpenTCP: socket()=%d success\n", (int)sock);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Close a socket.
+ *  Release any resources aquired by this socket
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown
+ */
+
+EXT_DECL VOS_ERR_T vos_sockClose (
+    SOCKET sock)
+{
+    if (close(sock) == -1)
+    {
+        vos_printLog(VOS_LOG_ERROR,
+                     "vos_sockClose(%d) called with unknown descriptor\n", (int)sock);
+        return VOS_PARAM_ERR;
+    }
+    else
+    {
+        vos_printLog(VOS_LOG_DBG,
+                     "vos_sockClose(%d) okay\n", (int)sock);
+    }
+
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Set socket options.
+ *  Note: Some targeted systems might not support every option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pOptions        pointer to socket options (optional)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetOptions (
+    SOCKET                  sock,
+    const VOS_SOCK_OPT_T    *pOptions)
+{
+    int sockOptValue = 0;
+
+    if (pOptions)
+    {
+        if (1 == pOptions->reuseAddrPort)
+        {
+            sockOptValue = 1;
+#ifdef SO_REUSEPORT
+            if (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_REUSEPORT failed (Err: %s)\n", buff);
+            }
+#else
+            if (setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_REUSEADDR failed (Err: %s)\n", buff);
+            }
+#endif
+        }
+        if (1 == pOptions->nonBlocking)
+        {
+            if (fcntl(sock, F_SETFL, O_NONBLOCK) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() O_NONBLOCK failed (Err: %s)\n", buff);
+                return VOS_SOCK_ERR;
+            }
+        }
+        if (pOptions->qos > 0 && pOptions->qos < 8)
+        {
+#ifdef SO_NET_SERVICE_TYPE
+            /* Darwin/BSD: Depending on socket typ, sets the layer 2 priority as well.
+             NET_SERVICE_TYPE_BE    0  Best effort
+             NET_SERVICE_TYPE_BK    1  Background system initiated
+             NET_SERVICE_TYPE_SIG   2  Signaling
+             NET_SERVICE_TYPE_VI    3  Interactive Video
+             NET_SERVICE_TYPE_VO    4  Interactive Voice
+             NET_SERVICE_TYPE_RV    5  Responsive Multimedia Audio/Video
+             NET_SERVICE_TYPE_AV    6  Multimedia Audio/Video Streaming
+             NET_SERVICE_TYPE_OAM   7  Operations, Administration, and Management
+             NET_SERVICE_TYPE_RD    8  Responsive Data
+             */
+            sockOptValue = (int) pOptions->qos + 1;
+            if (sockOptValue == 1) /* Best effort and background share same priority */
+            {
+                sockOptValue = 0;
+            }
+            if (setsockopt(sock, SOL_SOCKET, SO_NET_SERVICE_TYPE, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_NET_SERVICE_TYPE failed (Err: %s)\n", buff);
+            }
+#else
+            /* The QoS value (0-7) was mapped to MSB bits 7-5, bit 2 was set for local use.
+             TOS field is deprecated and has been succeeded by RFC 2474 and RFC 3168. Usage depends on IP-routers.
+             This field is now called the "DS" (Differentiated Services) field and the upper 6 bits contain
+             a value called the "DSCP" (Differentiated Services Code Point).
+             QoS as priority value is now mapped to DSCP values and the Explicit Congestion Notification (ECN)
+             is set to 0 */
+
+            /*  old:
+                sockOptValue = (int) ((pOptions->qos << 5) | 4);
+                New: */
+            sockOptValue = cDscpMap[pOptions->qos];
+            if (setsockopt(sock, IPPROTO_IP, IP_TOS, (char *)&sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() IP_TOS failed (Err: %s)\n", buff);
+            }
+#endif
+
+#ifdef SO_PRIORITY
+            /* if available (and the used socket is tagged) set the VLAN PCP field as well. */
+            sockOptValue = (int) pOptions->qos;
+            if (setsockopt(sock, SOL_SOCKET, SO_PRIORITY, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_PRIORITY failed (Err: %s)\n", buff);
+            }
+#endif
+        }
+        if (pOptions->ttl > 0)
+        {
+            sockOptValue = pOptions->ttl;
+            if (setsockopt(sock, IPPROTO_IP, IP_TTL, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_TTL failed (Err: %s)\n", buff);
+            }
+        }
+        if (pOptions->ttl_multicast > 0)
+        {
+            sockOptValue = pOptions->ttl_multicast;
+            if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_MULTICAST_TTL failed (Err: %s)\n", buff);
+            }
+        }
+        if (pOptions->no_mc_loop > 0)
+        {
+            /* Default behavior is ON * / */
+            sockOptValue = 0;
+            if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_LOOP, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_MULTICAST_LOOP failed (Err: %s)\n", buff);
+            }
+        }
+#ifdef VOS_SOCK_TXTIME
+        if (1 == pOptions->txTime)
+        {
+            /* Launch times are given in TAI, the clock the ETF qdisc works with */
+            struct sock_txtime txTimeCfg;
+
+            txTimeCfg.clockid   = CLOCK_TAI;
+            txTimeCfg.flags     = 0u;
+            if (setsockopt(sock, SOL_SOCKET, SO_TXTIME, &txTimeCfg, sizeof(txTimeCfg)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_TXTIME failed (Err: %s)\n", buff);
+            }
+        }
+#endif
+#ifdef VOS_SOCK_RXTIME
+        if (1 == pOptions->rxTime)
+        {
+            /* Hardware time stamps need the interface to be configured (SIOCSHWTSTAMP), software ones always work */
+            sockOptValue = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+                SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+            if (setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPING, &sockOptValue, sizeof(sockOptValue)) == -1)
+            {
+                sockOptValue = 1;
+                if (setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPNS, &sockOptValue, sizeof(sockOptValue)) == -1)
+                {
+                    char buff[VOS_MAX_ERR_STR_SIZE];
+                    STRING_ERR(buff);
+                    vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_TIMESTAMPING failed (Err: %s)\n", buff);
+                }
+            }
+        }
+#endif
+#ifdef SO_BUSY_POLL
+        if (pOptions->busyPoll > 0u)
+        {
+            /* Raising the time above net.core.busy_read needs CAP_NET_ADMIN */
+            sockOptValue = (int) pOptions->busyPoll;
+            if (setsockopt(sock, SOL_SOCKET, SO_BUSY_POLL, &sockOptValue, sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_BUSY_POLL failed (Err: %s)\n", buff);
+            }
+#ifdef SO_PREFER_BUSY_POLL
+            sockOptValue = 1;
+            (void) setsockopt(sock, SOL_SOCKET, SO_PREFER_BUSY_POLL, &sockOptValue, sizeof(sockOptValue));
+#endif
+        }
+#endif
+#ifdef SO_NO_CHECK
+        if (pOptions->no_udp_crc > 0)
+        {
+            sockOptValue = 1;
+            if (setsockopt(sock, SOL_SOCKET, SO_NO_CHECK, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_NO_CHECK failed (Err: %s)\n", buff);
+            }
+        }
+#endif
+        if (pOptions->tcpNoDelay == TRUE)
+        {
+            sockOptValue = 1;
+            if (setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &sockOptValue, sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() TCP_NODELAY failed (Err: %s)\n", buff);
+            }
+        }
+        if (pOptions->udpGro == TRUE)
+        {
+#ifdef VOS_SOCK_UDP_SEG
+            sockOptValue = 1;
+            if (setsockopt(sock, SOL_UDP, UDP_GRO, &sockOptValue, sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() UDP_GRO failed (Err: %s)\n", buff);
+            }
+#else
+            vos_printLogStr(VOS_LOG_WARNING, "UDP_GRO not supported on this target\n");
+#endif
+        }
+    }
+    /*  Include struct in_pktinfo in the message "ancilliary" control data.
+        This way we can get the destination IP address for received UDP packets */
+    sockOptValue = 1;
+#if defined(IP_RECVDSTADDR)
+    if (setsockopt(sock, IPPROTO_IP, IP_RECVDSTADDR, &sockOptValue, sizeof(sockOptValue)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_RECVDSTADDR failed (Err: %s)\n", buff);
+    }
+#elif defined(IP_PKTINFO)
+    if (setsockopt(sock, IPPROTO_IP, IP_PKTINFO, &sockOptValue, sizeof(sockOptValue)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_PKTINFO failed (Err: %s)\n", buff);
+    }
+#endif
+
+    return VOS_NO_ERR;
+}
+
+
+/**********************************************************************************************************************/
+/** Join a multicast group.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group to join
+ *  @param[in]      ipAddress       depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  ipAddress)
+{
+    struct ip_mreq  mreq;
+    VOS_ERR_T       result = VOS_NO_ERR;
+    char buff[VOS_MAX_ERR_STR_SIZE];
+
+    if (sock == -1)
+    {
+        result = VOS_PARAM_ERR;
+    }
+    /* Is this a multicast address? */
+    else if (IN_MULTICAST(mcAddress))
+    {
+        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
+        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+
+        {
+            char    mcStr[16];
+            char    ifStr[16];
+
+            strncpy(mcStr, inet_ntoa(mreq.imr_multiaddr), sizeof(mcStr));
+            mcStr[sizeof(mcStr) - 1] = 0;
+            strncpy(ifStr, inet_ntoa(mreq.imr_interface), sizeof(ifStr));
+            ifStr[sizeof(ifStr) - 1] = 0;
+
+            vos_printLog(VOS_LOG_INFO, "joining MC: %s on iface %s\n", mcStr, ifStr);
+        }
+
+        /*errno = 0;*/
+        if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) == -1 &&
+            errno != EADDRINUSE)
+        {
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_ADD_MEMBERSHIP failed (Err: %s)\n", buff);
+            result = VOS_SOCK_ERR;
+        }
+        else
+        {
+            result = VOS_NO_ERR;
+        }
+
+        /* Disable multicast loop back */
+        /* only useful for streaming
+        {
+            UINT32 enMcLb = 0;
+
+
+            if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_LOOP, &enMcLb, sizeof(enMcLb)) == -1
+                 && errno != 0)
+            {
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_MULTICAST_LOOP failed (%s)\n", buff);
+                result = VOS_SOCK_ERR;
+            }
+            else
+            {
+                result = (result == VOS_SOCK_ERR) ? VOS_SOCK_ERR : VOS_NO_ERR;
+            }
+        }
+        */
+    }
+    else
+    {
+        result = VOS_PARAM_ERR;
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Leave a multicast group.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group to join
+ *  @param[in]      ipAddress       depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  ipAddress)
+{
+    struct ip_mreq  mreq;
+    VOS_ERR_T       result = VOS_NO_ERR;
+
+    if (sock == -1)
+    {
+        result = VOS_PARAM_ERR;
+    }
+    /* Is this a multicast address? */
+    else if (IN_MULTICAST(mcAddress))
+    {
+        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
+        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+
+        {
+            char    mcStr[16];
+            char    ifStr[16];
+
+            strncpy(mcStr, inet_ntoa(mreq.imr_multiaddr), sizeof(mcStr));
+            mcStr[sizeof(mcStr) - 1] = 0;
+            strncpy(ifStr, inet_ntoa(mreq.imr_interface), sizeof(ifStr));
+            ifStr[sizeof(ifStr) - 1] = 0;
+
+            vos_printLog(VOS_LOG_INFO, "leaving MC: %s on iface %s\n", mcStr, ifStr);
+        }
+
+        /*errno = 0;*/
+        if (setsockopt(sock, IPPROTO_IP, IP_DROP_MEMBERSHIP, &mreq, sizeof(mreq)) == -1)
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_DROP_MEMBERSHIP failed (Err: %s)\n", buff);
+
+            result = VOS_SOCK_ERR;
+        }
+        else
+        {
+            result = VOS_NO_ERR;
+        }
+    }
+    else
+    {
+        result = VOS_PARAM_ERR;
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Install a receive filter in the kernel (Linux: classic BPF, SO_ATTACH_FILTER).
+ *  Datagrams of one of the filtered types pass only if their key field and source match an entry, all other
+ *  datagrams pass. An installed filter is replaced, pFilter == NULL removes it.
+ *  The filter of a UDP socket sees the datagram from the UDP header on, the source IP is read from the IP header.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      pFilter           filter to install, NULL to remove the filter
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid, filter too large
+ *  @retval         VOS_MEM_ERR       out of memory
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetFilter (
+    SOCKET                  sock,
+    const VOS_SOCK_FILTER_T *pFilter)
+{
+#ifdef VOS_SOCK_FILTER
+    const UINT32        cUdpHdrSize = 8u;
+    const UINT32        cPass       = 0xFFFFFFFFu;
+    struct sock_filter  *pCode;
+    struct sock_fprog   prog;
+    UINT32              noOfInsns;
+    UINT32              pc = 0u;
+    UINT32              i;
+    VOS_ERR_T           result = VOS_NO_ERR;
+
+    if (sock == -1)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (pFilter == NULL)
+    {
+        int dummy = 0;
+
+        if ((setsockopt(sock, SOL_SOCKET, SO_DETACH_FILTER, &dummy, sizeof(dummy)) == -1) && (errno != ENOENT))
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_DETACH_FILTER failed (Err: %s)\n", buff);
+            return VOS_SOCK_ERR;
+        }
+        return VOS_NO_ERR;
+    }
+
+    if ((pFilter->noOfTypes > VOS_SOCK_FILTER_TYPES)
+        || ((pFilter->noOfEntries > 0u) && (pFilter->pEntries == NULL)))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /*  type check, load key, final drop, per entry: key compare plus source check  */
+    noOfInsns = ((pFilter->noOfTypes > 0u) ? (pFilter->noOfTypes + 2u) : 0u) + 2u;
+    for (i = 0u; i < pFilter->noOfEntries; i++)
+    {
+        noOfInsns += (pFilter->pEntries[i].srcIpLo == 0u) ? 2u : ((pFilter->pEntries[i].srcIpHi == 0u) ? 5u : 6u);
+        if (noOfInsns > BPF_MAXINSNS)
+        {
+            return VOS_PARAM_ERR;
+        }
+    }
+
+    pCode = (struct sock_filter *) vos_memAlloc(noOfInsns * sizeof(struct sock_filter));
+    if (pCode == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+
+    if (pFilter->noOfTypes > 0u)
+    {
+        struct sock_filter ldType = BPF_STMT(BPF_LD | BPF_H | BPF_ABS, cUdpHdrSize + pFilter->typeOffset);
+        struct sock_filter pass = BPF_STMT(BPF_RET | BPF_K, cPass);
+
+        pCode[pc++] = ldType;
+        for (i = 0u; i < pFilter->noOfTypes; i++)
+        {
+            /*  a filtered type jumps over the final pass of the unfiltered ones  */
+            struct sock_filter isType = BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, pFilter->types[i],
+                                                 pFilter->noOfTypes - i, 0);
+            pCode[pc++] = isType;
+        }
+        pCode[pc++] = pass;
+    }
+    {
+        struct sock_filter ldKey = BPF_STMT(BPF_LD | BPF_W | BPF_ABS, cUdpHdrSize + pFilter->keyOffset);
+        pCode[pc++] = ldKey;
+    }
+
+    for (i = 0u; i < pFilter->noOfEntries; i++)
+    {
+        const VOS_SOCK_FILTER_ENTRY_T   *pEntry = &pFilter->pEntries[i];
+        struct sock_filter              ldKey   = BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+                                                           cUdpHdrSize + pFilter->keyOffset);
+        struct sock_filter              ldSrc   = BPF_STMT(BPF_LD | BPF_W | BPF_ABS, SKF_NET_OFF + 12);
+        struct sock_filter              pass    = BPF_STMT(BPF_RET | BPF_K, cPass);
+
+        if (pEntry->srcIpLo == 0u)
+        {
+            struct sock_filter isKey = BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, pEntry->key, 0, 1);
+            pCode[pc++] = isKey;
+            pCode[pc++] = pass;
+        }
+        else if (pEntry->srcIpHi == 0u)
+        {
+            struct sock_filter isKey = BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, pEntry->key, 0, 4);
+            struct sock_filter isSrc = BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, pEntry->srcIpLo, 0, 1);
+            pCode[pc++] = isKey;
+            pCode[pc++] = ldSrc;
+            pCode[pc++] = isSrc;
+            pCode[pc++] = pass;
+            pCode[pc++] = ldKey;
+        }
+        else
+        {
+            struct sock_filter isKey    = BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, pEntry->key, 0, 5);
+            struct sock_filter aboveLo  = BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, pEntry->srcIpLo, 0, 2);
+            struct sock_filter aboveHi  = BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, pEntry->srcIpHi, 1, 0);
+            pCode[pc++] = isKey;
+            pCode[pc++] = ldSrc;
+            pCode[pc++] = aboveLo;
+            pCode[pc++] = aboveHi;
+            pCode[pc++] = pass;
+            pCode[pc++] = ldKey;
+        }
+    }
+    {
+        struct sock_filter drop = BPF_STMT(BPF_RET | BPF_K, 0);
+        pCode[pc++] = drop;
+    }
+
+    prog.len    = (unsigned short) pc;
+    prog.filter = pCode;
+    if (setsockopt(sock, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_ATTACH_FILTER failed (Err: %s)\n", buff);
+        result = VOS_SOCK_ERR;
+    }
+    vos_memFree(pCode);
+    return result;
+#else
+    (void) sock;
+    return (pFilter == NULL) ? VOS_NO_ERR : VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Steer the datagrams of a group of sockets bound to the same address and port (Linux: SO_ATTACH_REUSEPORT_CBPF).
+ *  A datagram goes to the socket with the index key % noOfSocks, counted in the order the sockets were bound.
+ *  The program of a reuse port group sees the datagram from the UDP payload on.
+ *
+ *  @param[in]      sock              socket descriptor, any socket of the group
+ *  @param[in]      keyOffset         payload offset of the 32 bit key field (network byte order)
+ *  @param[in]      noOfSocks         number of sockets of the group
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetSteering (
+    SOCKET  sock,
+    UINT16  keyOffset,
+    UINT32  noOfSocks)
+{
+#if defined(VOS_SOCK_FILTER) && defined(SO_ATTACH_REUSEPORT_CBPF)
+    struct sock_filter  code[] =
+    {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 0),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, 1),
+        BPF_STMT(BPF_RET | BPF_A, 0)
+    };
+    struct sock_fprog   prog;
+
+    if ((sock == -1) || (noOfSocks == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    code[0].k   = keyOffset;
+    code[1].k   = noOfSocks;
+    prog.len    = (unsigned short) (sizeof(code) / sizeof(code[0]));
+    prog.filter = code;
+    if (setsockopt(sock, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_ATTACH_REUSEPORT_CBPF failed (Err: %s)\n", buff);
+        return VOS_SOCK_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    (void) sock;
+    (void) keyOffset;
+    (void) noOfSocks;
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Cork or uncork a TCP socket (Linux: TCP_CORK, BSD: TCP_NOPUSH).
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      cork              TRUE: hold back partial segments, FALSE: send pending data
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetCork (
+    SOCKET  sock,
+    BOOL8   cork)
+{
+#if defined(TCP_CORK) || defined(TCP_NOPUSH)
+    int sockOptValue = (cork == TRUE) ? 1 : 0;
+
+#   if defined(TCP_CORK)
+    if (setsockopt(sock, IPPROTO_TCP, TCP_CORK, &sockOptValue, sizeof(sockOptValue)) == -1)
+#   else
+    if (setsockopt(sock, IPPROTO_TCP, TCP_NOPUSH, &sockOptValue, sizeof(sockOptValue)) == -1)
+#   endif
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_WARNING, "setsockopt() TCP_CORK failed (Err: %s)\n", buff);
+        return VOS_SOCK_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    (void) sock;
+    (void) cork;
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Get the state of the receive queue of a socket.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[out]     pQueue            receive queue state
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetRxQueue (
+    SOCKET          sock,
+    VOS_SOCK_RXQ_T  *pQueue)
+{
+#ifdef VOS_SOCK_MEMINFO
+    UINT32      memInfo[SK_MEMINFO_VARS];
+    socklen_t   optLen = sizeof(memInfo);
+#else
+    int         optval  = 0;
+    int         pending = 0;
+    socklen_t   optLen  = sizeof(optval);
+#endif
+
+    if ((sock == -1) || (pQueue == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+#ifdef VOS_SOCK_MEMINFO
+    /* One call for the queue and the drop counter, the latter is the one SO_RXQ_OVFL reports per datagram */
+    if ((getsockopt(sock, SOL_SOCKET, SO_MEMINFO, memInfo, &optLen) == -1) ||
+        (optLen < sizeof(memInfo)))
+    {
+        return VOS_SOCK_ERR;
+    }
+    pQueue->drops   = memInfo[SK_MEMINFO_DROPS];
+    pQueue->queued  = memInfo[SK_MEMINFO_RMEM_ALLOC];
+    pQueue->bufSize = memInfo[SK_MEMINFO_RCVBUF];
+#else
+    if ((getsockopt(sock, SOL_SOCKET, SO_RCVBUF, &optval, &optLen) == -1) ||
+        (ioctl(sock, FIONREAD, &pending) == -1))
+    {
+        return VOS_SOCK_ERR;
+    }
+    pQueue->drops   = 0u;
+    pQueue->queued  = (UINT32) pending;
+    pQueue->bufSize = (UINT32) optval;
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Set the size of the receive buffer of a socket.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      size              receive buffer size
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_SOCK_ERR      size could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetRcvBuffer (
+    SOCKET  sock,
+    UINT32  size)
+{
+#ifdef __linux
+    int optval = (int) (size / 2u);     /* Linux doubles the value for its bookkeeping overhead */
+#else
+    int optval = (int) size;
+#endif
+
+    if (setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &optval, sizeof(optval)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_RCVBUF failed (Err: %s)\n", buff);
+        return VOS_SOCK_ERR;
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Join or leave a source specific multicast membership.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      join              TRUE to join, FALSE to leave
+ *  @param[in]      mcAddress         multicast group
+ *  @param[in]      srcAddress        source address
+ *  @param[in]      ipAddress         interface, 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+static VOS_ERR_T vos_sockSourceMC (
+    SOCKET  sock,
+    BOOL8   join,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+#if defined(IP_ADD_SOURCE_MEMBERSHIP) && defined(IP_DROP_SOURCE_MEMBERSHIP)
+    struct ip_mreq_source   mreq;
+    int option = (join == TRUE) ? IP_ADD_SOURCE_MEMBERSHIP : IP_DROP_SOURCE_MEMBERSHIP;
+
+    if ((sock == -1) || !IN_MULTICAST(mcAddress) || (srcAddress == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
+    mreq.imr_sourceaddr.s_addr  = vos_htonl(srcAddress);
+    mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+
+    {
+        char    mcStr[16];
+        char    srcStr[16];
+
+        strncpy(mcStr, inet_ntoa(mreq.imr_multiaddr), sizeof(mcStr));
+        mcStr[sizeof(mcStr) - 1] = 0;
+        strncpy(srcStr, inet_ntoa(mreq.imr_sourceaddr), sizeof(srcStr));
+        srcStr[sizeof(srcStr) - 1] = 0;
+
+        vos_printLog(VOS_LOG_INFO, "%s MC: %s from source %s\n", (join == TRUE) ? "joining" : "leaving", mcStr, srcStr);
+    }
+
+    if ((setsockopt(sock, IPPROTO_IP, option, &mreq, sizeof(mreq)) == -1)
+        && ((join == FALSE) || (errno != EADDRINUSE)))
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "setsockopt() %s failed (Err: %s)\n",
+                     (join == TRUE) ? "IP_ADD_SOURCE_MEMBERSHIP" : "IP_DROP_SOURCE_MEMBERSHIP", buff);
+        return VOS_SOCK_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    (void) sock;
+    (void) join;
+    (void) mcAddress;
+    (void) srcAddress;
+    (void) ipAddress;
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Join a multicast group for one source only (source specific multicast, IGMPv3).
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to join
+ *  @param[in]      srcAddress        source to receive from
+ *  @param[in]      ipAddress         depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    return vos_sockSourceMC(sock, TRUE, mcAddress, srcAddress, ipAddress);
+}
+
+/**********************************************************************************************************************/
+/** Leave a source specific multicast membership.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to leave
+ *  @param[in]      srcAddress        source joined with vos_sockJoinSourceMC
+ *  @param[in]      ipAddress         depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    return vos_sockSourceMC(sock, FALSE, mcAddress, srcAddress, ipAddress);
+}
+
+/**********************************************************************************************************************/
+/** Send UDP data.
+ *  Send data to the supplied address and port.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to data to send
+ *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDP (
+    SOCKET      sock,
+    const UINT8 *pBuffer,
+    UINT32      *pSize,
+    UINT32      ipAddress,
+    UINT16      port)
+{
+    struct sockaddr_in destAddr;
+    ssize_t sendSize    = 0;
+    size_t  size        = 0;
+
+    if (sock == -1 || pBuffer == NULL || pSize == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    size    = *pSize;
+    *pSize  = 0;
+
+    /*      We send UDP packets to the address  */
+    memset(&destAddr, 0, sizeof(destAddr));
+    destAddr.sin_family         = AF_INET;
+    destAddr.sin_addr.s_addr    = vos_htonl(ipAddress);
+    destAddr.sin_port           = vos_htons(port);
+
+    do
+    {
+        /*errno       = 0;*/
+        sendSize = sendto(sock,
+                          (const char *)pBuffer,
+                          size,
+                          0,
+                          (struct sockaddr *) &destAddr,
+                          sizeof(destAddr));
+
+        if (sendSize >= 0)
         {
-            /* Default behavior is ON * / */
-            sockOptValue = 0;
-            if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_LOOP, &sockOptValue,
-                           sizeof(sockOptValue)) == -1)
-            {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_MULTICAST_LOOP failed (Err: %s)\n", buff);
-            }
+            *pSize += (UINT32) sendSize;
         }
-#ifdef SO_NO_CHECK
-        if (pOptions->no_udp_crc > 0)
+
+        if (sendSize == -1 && errno == EWOULDBLOCK)
         {
-            sockOptValue = 1;
-            if (setsockopt(sock, SOL_SOCKET, SO_NO_CHECK, &sockOptValue,
-                           sizeof(sockOptValue)) == -1)
-            {
-                char buff[VOS_MAX_ERR_STR_SIZE];
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_NO_CHECK failed (Err: %s)\n", buff);
-            }
+            return VOS_BLOCK_ERR;
         }
-#endif
-    }
-    /*  Include struct in_pktinfo in the message "ancilliary" control data.
-        This way we can get the destination IP address for received UDP packets */
-    sockOptValue = 1;
-#if defined(IP_RECVDSTADDR)
-    if (setsockopt(sock, IPPROTO_IP, IP_RECVDSTADDR, &sockOptValue, sizeof(sockOptValue)) == -1)
-    {
-        char buff[VOS_MAX_ERR_STR_SIZE];
-        STRING_ERR(buff);
-        vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_RECVDSTADDR failed (Err: %s)\n", buff);
     }
-#elif defined(IP_PKTINFO)
-    if (setsockopt(sock, IPPROTO_IP, IP_PKTINFO, &sockOptValue, sizeof(sockOptValue)) == -1)
+    while (sendSize == -1 && errno == EINTR);
+
+    if (sendSize == -1)
     {
         char buff[VOS_MAX_ERR_STR_SIZE];
         STRING_ERR(buff);
-        vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_PKTINFO failed (Err: %s)\n", buff);
+        vos_printLog(VOS_LOG_ERROR, "sendto() to %s:%u failed (Err: %s)\n",
+                     inet_ntoa(destAddr.sin_addr), (unsigned int)port, buff);
+        return VOS_IO_ERR;
     }
-#endif
-
     return VOS_NO_ERR;
 }
 
-
 /**********************************************************************************************************************/
-/** Join a multicast group.
- *  Note: Some targeted systems might not support this option.
+/** Send UDP data at a given time.
+ *  The launch time is converted from the monotonic time base of vos_getTime to TAI and passed as SCM_TXTIME.
  *
- *  @param[in]      sock            socket descriptor
- *  @param[in]      mcAddress       multicast group to join
- *  @param[in]      ipAddress       depicts interface on which to join, default 0 for any
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      pBuffer            pointer to data to send
+ *  @param[in,out]  pSize              In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress          destination IP
+ *  @param[in]      port               destination port
+ *  @param[in]      pLaunchTime        transmit time (time base of vos_getTime), NULL to send immediately
  *
- *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
- *  @retval         VOS_SOCK_ERR    option not supported
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ *  @retval         VOS_IO_ERR         data could not be sent
+ *  @retval         VOS_BLOCK_ERR      Call would have blocked in blocking mode
  */
-
-EXT_DECL VOS_ERR_T vos_sockJoinMC (
-    SOCKET  sock,
-    UINT32  mcAddress,
-    UINT32  ipAddress)
+EXT_DECL VOS_ERR_T vos_sockSendUDPAt (
+    SOCKET              sock,
+    const UINT8         *pBuffer,
+    UINT32              *pSize,
+    UINT32              ipAddress,
+    UINT16              port,
+    const VOS_TIMEVAL_T *pLaunchTime)
 {
-    struct ip_mreq  mreq;
-    VOS_ERR_T       result = VOS_NO_ERR;
-    char buff[VOS_MAX_ERR_STR_SIZE];
+#ifdef VOS_SOCK_TXTIME
+    struct sockaddr_in  destAddr;
+    struct msghdr       msg;
+    struct iovec        iov;
+    struct cmsghdr      *pCmsg;
+    union
+    {
+        char            buf[CMSG_SPACE(sizeof(UINT64))];
+        struct cmsghdr  align;
+    } control;
+    struct timespec     tai;
+    VOS_TIMEVAL_T       now;
+    VOS_TIMEVAL_T       delay;
+    UINT64              launchTime;
+    ssize_t             sendSize;
 
-    if (sock == -1)
+    if (sock == -1 || pBuffer == NULL || pSize == NULL)
     {
-        result = VOS_PARAM_ERR;
+        return VOS_PARAM_ERR;
     }
-    /* Is this a multicast address? */
-    else if (IN_MULTICAST(mcAddress))
+
+    vos_getTime(&now);
+    if ((pLaunchTime == NULL) ||
+        (vos_cmpTime(pLaunchTime, &now) <= 0) ||
+        (clock_gettime(CLOCK_TAI, &tai) != 0))
     {
-        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
-        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+        return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+    }
 
-        {
-            char    mcStr[16];
-            char    ifStr[16];
+    delay = *pLaunchTime;
+    vos_subTime(&delay, &now);
+    launchTime = (UINT64) tai.tv_sec * 1000000000u + (UINT64) tai.tv_nsec +
+        (UINT64) delay.tv_sec * 1000000000u + (UINT64) delay.tv_usec * 1000u;
 
-            strncpy(mcStr, inet_ntoa(mreq.imr_multiaddr), sizeof(mcStr));
-            mcStr[sizeof(mcStr) - 1] = 0;
-            strncpy(ifStr, inet_ntoa(mreq.imr_interface), sizeof(ifStr));
-            ifStr[sizeof(ifStr) - 1] = 0;
+    memset(&destAddr, 0, sizeof(destAddr));
+    destAddr.sin_family         = AF_INET;
+    destAddr.sin_addr.s_addr    = vos_htonl(ipAddress);
+    destAddr.sin_port           = vos_htons(port);
 
-            vos_printLog(VOS_LOG_INFO, "joining MC: %s on iface %s\n", mcStr, ifStr);
-        }
+    iov.iov_base    = (void *) pBuffer;
+    iov.iov_len     = *pSize;
 
-        /*errno = 0;*/
-        if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) == -1 &&
-            errno != EADDRINUSE)
-        {
-            STRING_ERR(buff);
-            vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_ADD_MEMBERSHIP failed (Err: %s)\n", buff);
-            result = VOS_SOCK_ERR;
-        }
-        else
+    memset(&msg, 0, sizeof(msg));
+    memset(&control, 0, sizeof(control));
+    msg.msg_name        = &destAddr;
+    msg.msg_namelen     = sizeof(destAddr);
+    msg.msg_iov         = &iov;
+    msg.msg_iovlen      = 1;
+    msg.msg_control     = control.buf;
+    msg.msg_controllen  = sizeof(control.buf);
+
+    pCmsg = CMSG_FIRSTHDR(&msg);
+    pCmsg->cmsg_level   = SOL_SOCKET;
+    pCmsg->cmsg_type    = SCM_TXTIME;
+    pCmsg->cmsg_len     = CMSG_LEN(sizeof(UINT64));
+    memcpy(CMSG_DATA(pCmsg), &launchTime, sizeof(UINT64));
+
+    *pSize = 0u;
+
+    do
+    {
+        sendSize = sendmsg(sock, &msg, 0);
+
+        if (sendSize >= 0)
         {
-            result = VOS_NO_ERR;
+            *pSize = (UINT32) sendSize;
         }
 
-        /* Disable multicast loop back */
-        /* only useful for streaming
+        if (sendSize == -1 && errno == EWOULDBLOCK)
         {
-            UINT32 enMcLb = 0;
-
-
-            if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_LOOP, &enMcLb, sizeof(enMcLb)) == -1
-                 && errno != 0)
-            {
-                STRING_ERR(buff);
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_MULTICAST_LOOP failed (%s)\n", buff);
-                result = VOS_SOCK_ERR;
-            }
-            else
-            {
-                result = (result == VOS_SOCK_ERR) ? VOS_SOCK_ERR : VOS_NO_ERR;
-            }
+            return VOS_BLOCK_ERR;
         }
-        */
     }
-    else
+    while (sendSize == -1 && errno == EINTR);
+
+    if (sendSize == -1)
     {
-        result = VOS_PARAM_ERR;
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "sendmsg() to %s:%u failed (Err: %s)\n",
+                     inet_ntoa(destAddr.sin_addr), (unsigned int)port, buff);
+        return VOS_IO_ERR;
     }
-
-    return result;
+    return VOS_NO_ERR;
+#else
+    (void) pLaunchTime;
+    return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+#endif
 }
 
 /**********************************************************************************************************************/
-/** Leave a multicast group.
- *  Note: Some targeted systems might not support this option.
+/** Send several UDP datagrams with one call.
+ *  Each entry of pMsgs[] describes one datagram (buffer, size, destination IP and port). On return, the size of each
+ *  entry holds the number of bytes sent, 0 if the datagram could not be sent. A datagram which cannot be sent does not
+ *  stop the remaining ones from being sent, unless the call would block.
+ *  On Linux sendmmsg() is used and a QoS given with a datagram is set as its IP TOS and SO_PRIORITY (VLAN PCP),
+ *  overriding the setting of the socket. On other targets vos_sockSendUDP() is called repeatedly and the QoS of the
+ *  socket applies.
  *
  *  @param[in]      sock            socket descriptor
- *  @param[in]      mcAddress       multicast group to join
- *  @param[in]      ipAddress       depicts interface on which to leave, default 0 for any
+ *  @param[in,out]  pMsgs           array of datagram descriptors (size in: to send, out: bytes sent)
+ *  @param[in]      noMsgs          number of entries in pMsgs
  *
  *  @retval         VOS_NO_ERR      no error
  *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
- *  @retval         VOS_SOCK_ERR    option not supported
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
  */
 
-EXT_DECL VOS_ERR_T vos_sockLeaveMC (
-    SOCKET  sock,
-    UINT32  mcAddress,
-    UINT32  ipAddress)
+EXT_DECL VOS_ERR_T vos_sockSendUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs)
 {
-    struct ip_mreq  mreq;
-    VOS_ERR_T       result = VOS_NO_ERR;
-
-    if (sock == -1)
+#ifdef __linux
+    struct sockaddr_in  destAddr[VOS_MAX_SOCK_BATCH];
+    struct mmsghdr      msgs[VOS_MAX_SOCK_BATCH];
+    struct iovec        iov[VOS_MAX_SOCK_BATCH];
+    union
     {
-        result = VOS_PARAM_ERR;
-    }
-    /* Is this a multicast address? */
-    else if (IN_MULTICAST(mcAddress))
+        struct cmsghdr  cm;
+        char            raw[VOS_SOCK_QOS_CONTROL_SIZE];
+    } control_un[VOS_MAX_SOCK_BATCH];
+    VOS_ERR_T           err     = VOS_NO_ERR;
+    UINT32              done    = 0u;
+    UINT32              chunk;
+    UINT32              i;
+    int                 sendCnt;
+
+    if ((sock == -1) || (pMsgs == NULL))
     {
-        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
-        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+        return VOS_PARAM_ERR;
+    }
 
+    while (done < noMsgs)
+    {
+        chunk = noMsgs - done;
+        if (chunk > VOS_MAX_SOCK_BATCH)
         {
-            char    mcStr[16];
-            char    ifStr[16];
+            chunk = VOS_MAX_SOCK_BATCH;
+        }
 
-            strncpy(mcStr, inet_ntoa(mreq.imr_multiaddr), sizeof(mcStr));
-            mcStr[sizeof(mcStr) - 1] = 0;
-            strncpy(ifStr, inet_ntoa(mreq.imr_interface), sizeof(ifStr));
-            ifStr[sizeof(ifStr) - 1] = 0;
+        memset(msgs, 0, chunk * sizeof(struct mmsghdr));
+        memset(destAddr, 0, chunk * sizeof(struct sockaddr_in));
 
-            vos_printLog(VOS_LOG_INFO, "leaving MC: %s on iface %s\n", mcStr, ifStr);
+        for (i = 0u; i < chunk; i++)
+        {
+            destAddr[i].sin_family      = AF_INET;
+            destAddr[i].sin_addr.s_addr = vos_htonl(pMsgs[done + i].dstIPAddr);
+            destAddr[i].sin_port        = vos_htons(pMsgs[done + i].dstIPPort);
+            iov[i].iov_base = pMsgs[done + i].pBuffer;
+            iov[i].iov_len  = pMsgs[done + i].size;
+            msgs[i].msg_hdr.msg_iov     = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen  = 1;
+            msgs[i].msg_hdr.msg_name    = &destAddr[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(destAddr[i]);
+            if ((pMsgs[done + i].qos > 0u) && (pMsgs[done + i].qos < 8u))
+            {
+                vos_sockQosControl(&msgs[i].msg_hdr, control_un[i].raw, pMsgs[done + i].qos);
+            }
         }
 
-        /*errno = 0;*/
-        if (setsockopt(sock, IPPROTO_IP, IP_DROP_MEMBERSHIP, &mreq, sizeof(mreq)) == -1)
+        do
         {
-            char buff[VOS_MAX_ERR_STR_SIZE];
-            STRING_ERR(buff);
-            vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_DROP_MEMBERSHIP failed (Err: %s)\n", buff);
+            sendCnt = sendmmsg(sock, msgs, chunk, 0);
+        }
+        while (sendCnt == -1 && errno == EINTR);
 
-            result = VOS_SOCK_ERR;
+#ifdef SO_PRIORITY
+        if ((sendCnt == -1) && ((errno == EINVAL) || (errno == EPERM)) && (sSendPrioCmsg == TRUE) &&
+            (msgs[0].msg_hdr.msg_control != NULL))
+        {
+            /* older kernel or priority 7 without CAP_NET_ADMIN: go on with the IP TOS only */
+            vos_printLogStr(VOS_LOG_WARNING, "SO_PRIORITY per datagram refused, only IP TOS is set\n");
+            sSendPrioCmsg = FALSE;
+            continue;
+        }
+#endif
+
+        if (sendCnt == -1)
+        {
+            if (errno == EWOULDBLOCK)
+            {
+                for (i = done; i < noMsgs; i++)
+                {
+                    pMsgs[i].size = 0u;
+                }
+                return VOS_BLOCK_ERR;
+            }
+            else
+            {
+                /* the first datagram of the chunk failed, skip it and go on with the next one */
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_ERROR, "sendmmsg() to %s:%u failed (Err: %s)\n",
+                             inet_ntoa(destAddr[0].sin_addr), (unsigned int)pMsgs[done].dstIPPort, buff);
+                pMsgs[done].size = 0u;
+                done++;
+                err = VOS_IO_ERR;
+            }
         }
         else
         {
-            result = VOS_NO_ERR;
+            for (i = 0u; i < (UINT32) sendCnt; i++)
+            {
+                pMsgs[done + i].size = (UINT32) msgs[i].msg_len;
+            }
+            done += (UINT32) sendCnt;
         }
     }
-    else
+    return err;
+#else
+    VOS_ERR_T   err = VOS_NO_ERR;
+    VOS_ERR_T   result;
+    UINT32      i;
+
+    if (pMsgs == NULL)
     {
-        result = VOS_PARAM_ERR;
+        return VOS_PARAM_ERR;
     }
 
-    return result;
+    for (i = 0u; i < noMsgs; i++)
+    {
+        if (err == VOS_BLOCK_ERR)
+        {
+            pMsgs[i].size = 0u;
+            continue;
+        }
+        result = vos_sockSendUDP(sock, pMsgs[i].pBuffer, &pMsgs[i].size, pMsgs[i].dstIPAddr, pMsgs[i].dstIPPort);
+        if (result != VOS_NO_ERR)
+        {
+            pMsgs[i].size   = 0u;
+            err             = result;
+        }
+    }
+    return err;
+#endif
 }
 
 /**********************************************************************************************************************/
-/** Send UDP data.
- *  Send data to the supplied address and port.
+/** Send consecutive UDP datagrams of equal size from one buffer.
+ *  On Linux the datagrams are passed with UDP_SEGMENT, up to VOS_MAX_UDP_SEGS datagrams and 64 KB per sendmsg().
+ *  If the kernel does not know UDP_SEGMENT, or the interface cannot segment (no checksum offload), they are sent one
+ *  by one.
  *
  *  @param[in]      sock            socket descriptor
- *  @param[in]      pBuffer         pointer to data to send
+ *  @param[in]      pBuffer         pointer to the datagrams to send
  *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      segSize         size of one datagram
  *  @param[in]      ipAddress       destination IP
  *  @param[in]      port            destination port
  *
@@ -1064,62 +3751,125 @@ EXT_DECL VOS_ERR_T vos_sockLeaveMC (
  *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
  */
 
-EXT_DECL VOS_ERR_T vos_sockSendUDP (
+EXT_DECL VOS_ERR_T vos_sockSendUDPSeg (
     SOCKET      sock,
     const UINT8 *pBuffer,
     UINT32      *pSize,
+    UINT32      segSize,
     UINT32      ipAddress,
     UINT16      port)
 {
-    struct sockaddr_in destAddr;
-    ssize_t sendSize    = 0;
-    size_t  size        = 0;
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      size;
+    UINT32      done = 0u;
+    UINT32      chunk;
 
-    if (sock == -1 || pBuffer == NULL || pSize == NULL)
+    if ((sock == -1) || (pBuffer == NULL) || (pSize == NULL) || (segSize == 0u))
     {
         return VOS_PARAM_ERR;
     }
 
     size    = *pSize;
-    *pSize  = 0;
-
-    /*      We send UDP packets to the address  */
-    memset(&destAddr, 0, sizeof(destAddr));
-    destAddr.sin_family         = AF_INET;
-    destAddr.sin_addr.s_addr    = vos_htonl(ipAddress);
-    destAddr.sin_port           = vos_htons(port);
+    *pSize  = 0u;
 
-    do
+#ifdef VOS_SOCK_UDP_SEG
+    if ((sUdpSegment == TRUE) && (size > segSize) && (segSize <= (VOS_SOCK_UDP_SEG_MAX / 2u)))
     {
-        /*errno       = 0;*/
-        sendSize = sendto(sock,
-                          (const char *)pBuffer,
-                          size,
-                          0,
-                          (struct sockaddr *) &destAddr,
-                          sizeof(destAddr));
-
-        if (sendSize >= 0)
+        struct sockaddr_in  destAddr;
+        struct msghdr       msg;
+        struct iovec        iov;
+        struct cmsghdr      *pCmsg;
+        union
         {
-            *pSize += (UINT32) sendSize;
-        }
-
-        if (sendSize == -1 && errno == EWOULDBLOCK)
+            struct cmsghdr  cm;
+            char            raw[CMSG_SPACE(sizeof(uint16_t))];
+        } control_un;
+        ssize_t             sendSize;
+        uint16_t            gsoSize = (uint16_t) segSize;
+
+        memset(&destAddr, 0, sizeof(destAddr));
+        destAddr.sin_family         = AF_INET;
+        destAddr.sin_addr.s_addr    = vos_htonl(ipAddress);
+        destAddr.sin_port           = vos_htons(port);
+
+        while (done < size)
         {
-            return VOS_BLOCK_ERR;
+            chunk = size - done;
+            if (chunk > (segSize * VOS_MAX_UDP_SEGS))
+            {
+                chunk = segSize * VOS_MAX_UDP_SEGS;
+            }
+            if (chunk > VOS_SOCK_UDP_SEG_MAX)
+            {
+                chunk = (VOS_SOCK_UDP_SEG_MAX / segSize) * segSize;
+            }
+
+            memset(&msg, 0, sizeof(msg));
+            iov.iov_base        = (void *) (pBuffer + done);
+            iov.iov_len         = chunk;
+            msg.msg_iov         = &iov;
+            msg.msg_iovlen      = 1;
+            msg.msg_name        = &destAddr;
+            msg.msg_namelen     = sizeof(destAddr);
+            if (chunk > segSize)
+            {
+                msg.msg_control     = control_un.raw;
+                msg.msg_controllen  = sizeof(control_un.raw);
+                pCmsg = CMSG_FIRSTHDR(&msg);
+                pCmsg->cmsg_level   = SOL_UDP;
+                pCmsg->cmsg_type    = UDP_SEGMENT;
+                pCmsg->cmsg_len     = CMSG_LEN(sizeof(uint16_t));
+                memcpy(CMSG_DATA(pCmsg), &gsoSize, sizeof(gsoSize));
+            }
+
+            do
+            {
+                sendSize = sendmsg(sock, &msg, 0);
+            }
+            while ((sendSize == -1) && (errno == EINTR));
+
+            if (sendSize == -1)
+            {
+                if (errno == EWOULDBLOCK)
+                {
+                    return VOS_BLOCK_ERR;
+                }
+                if ((errno == ENOPROTOOPT) || (errno == EINVAL))
+                {
+                    /* kernel without UDP_SEGMENT */
+                    vos_printLogStr(VOS_LOG_WARNING, "UDP_SEGMENT refused, datagrams are sent one by one\n");
+                    sUdpSegment = FALSE;
+                }
+                else if (errno != EIO)
+                {
+                    char buff[VOS_MAX_ERR_STR_SIZE];
+                    STRING_ERR(buff);
+                    vos_printLog(VOS_LOG_ERROR, "sendmsg() to %s:%u failed (Err: %s)\n",
+                                 inet_ntoa(destAddr.sin_addr), (unsigned int)port, buff);
+                    return VOS_IO_ERR;
+                }
+                /* EIO: the interface cannot segment, send the rest one by one */
+                break;
+            }
+            done    += (UINT32) sendSize;
+            *pSize  = done;
         }
     }
-    while (sendSize == -1 && errno == EINTR);
+#endif
 
-    if (sendSize == -1)
+    /* one datagram per call */
+    while ((done < size) && (err == VOS_NO_ERR))
     {
-        char buff[VOS_MAX_ERR_STR_SIZE];
-        STRING_ERR(buff);
-        vos_printLog(VOS_LOG_ERROR, "sendto() to %s:%u failed (Err: %s)\n",
-                     inet_ntoa(destAddr.sin_addr), (unsigned int)port, buff);
-        return VOS_IO_ERR;
+        chunk = size - done;
+        if (chunk > segSize)
+        {
+            chunk = segSize;
+        }
+        err = vos_sockSendUDP(sock, pBuffer + done, &chunk, ipAddress, port);
+        done    += chunk;
+        *pSize  = done;
     }
-    return VOS_NO_ERR;
+    return err;
 }
 
 /**********************************************************************************************************************/
@@ -1154,18 +3904,121 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     UINT16  *pSrcIPPort,
     UINT32  *pDstIPAddr,
     BOOL8   peek)
+{
+    return vos_sockReceiveUDPTime(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, peek, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP data with its reception time.
+ *  As vos_sockReceiveUDP(), additionally the time the datagram was received is reported. If the socket was opened
+ *  with the rxTime option, the kernel (software) or NIC (hardware) time stamp is taken, else the time of the call.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[in]      peek            if true, leave data in queue
+ *  @param[out]     pRxTime         pointer to the reception time (time base of vos_getTime), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPTime (
+    SOCKET          sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    BOOL8           peek,
+    VOS_TIMEVAL_T   *pRxTime)
+{
+    return vos_sockRecvMsg(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, peek, pRxTime, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP datagrams the kernel may have coalesced.
+ *  On Linux the size of one datagram is taken from the UDP_GRO control message, if there is none, the data was not
+ *  coalesced and *pSegSize is set to *pSize.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSegSize        pointer to the size of one datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPSeg (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pSegSize,
+    UINT32  *pSrcIPAddr,
+    UINT16  *pSrcIPPort,
+    UINT32  *pDstIPAddr)
+{
+    if (pSegSize == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    return vos_sockRecvMsg(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, FALSE, NULL, pSegSize);
+}
+
+/**********************************************************************************************************************/
+/** Receive one UDP datagram with recvmsg() and evaluate its control messages.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP, may be NULL
+ *  @param[out]     pSrcIPPort      pointer to source port, may be NULL
+ *  @param[out]     pDstIPAddr      pointer to dest IP, may be NULL
+ *  @param[in]      peek            if true, leave data in queue
+ *  @param[out]     pRxTime         pointer to the reception time, may be NULL
+ *  @param[out]     pSegSize        pointer to the size of one coalesced datagram, may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+static VOS_ERR_T vos_sockRecvMsg (
+    SOCKET          sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    BOOL8           peek,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT32          *pSegSize)
 {
     union
     {
         struct cmsghdr  cm;
-        char            raw[32];
+        char            raw[VOS_SOCK_CONTROL_SIZE];
     } control_un;
     struct sockaddr_in  srcAddr;
     socklen_t           sockLen = sizeof(srcAddr);
     ssize_t rcvSize = 0;
     struct msghdr       msg;
     struct iovec        iov;
-    struct cmsghdr      *cmsg;
 
     if (sock == -1 || pBuffer == NULL || pSize == NULL)
     {
@@ -1198,27 +4051,38 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
         {
             if (pDstIPAddr != NULL)
             {
-                for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
+                vos_sockGetDstAddr(&msg, pDstIPAddr);
+            }
+
+            if (pRxTime != NULL)
+            {
+                vos_sockGetRxTime(&msg, pRxTime);
+            }
+
+            if (pSegSize != NULL)
+            {
+                *pSegSize = (UINT32) rcvSize;
+#ifdef VOS_SOCK_UDP_SEG
                 {
-                    #if defined(IP_RECVDSTADDR)
-                    if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVDSTADDR)
-                    {
-                        struct in_addr *pia = (struct in_addr *)CMSG_DATA(cmsg);
-                        *pDstIPAddr = (UINT32)vos_ntohl(pia->s_addr);
-                        /* vos_printLog(VOS_LOG_DBG, "udp message dest IP: %s\n", vos_ipDotted(*pDstIPAddr)); */
-                    }
-                    #elif defined(IP_PKTINFO)
-                    if (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_PKTINFO)
+                    struct cmsghdr *cmsg;
+
+                    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
                     {
-                        struct in_pktinfo *pia = (struct in_pktinfo *)CMSG_DATA(cmsg);
-                        *pDstIPAddr = (UINT32)vos_ntohl(pia->ipi_addr.s_addr);
-                        /* vos_printLog(VOS_LOG_DBG, "udp message dest IP: %s\n", vos_ipDotted(*pDstIPAddr)); */
+                        if ((cmsg->cmsg_level == SOL_UDP) && (cmsg->cmsg_type == UDP_GRO))
+                        {
+                            int gsoSize;
+
+                            memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(gsoSize));
+                            if ((gsoSize > 0) && (gsoSize < rcvSize))
+                            {
+                                *pSegSize = (UINT32) gsoSize;
+                            }
+                        }
                     }
-                    #endif
                 }
+#endif
             }
 
-
             if (pSrcIPAddr != NULL)
             {
                 *pSrcIPAddr = (uint32_t) vos_ntohl(srcAddr.sin_addr.s_addr);
@@ -1264,6 +4128,145 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     }
 }
 
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams with one call.
+ *  Up to maxMsgs datagrams (at most VOS_MAX_SOCK_BATCH) are read into the buffers supplied by pMsgs[]. The call returns
+ *  as soon as at least one datagram was read and no more datagrams are pending.
+ *  On Linux recvmmsg() is used, on other targets vos_sockReceiveUDP() is called repeatedly; there, the socket should be
+ *  non-blocking if maxMsgs is greater than one.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (buffer and size in, size and addresses out)
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received (or ICMP port unreachable)
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+#ifdef __linux
+    union
+    {
+        struct cmsghdr  cm;
+        char            raw[VOS_SOCK_CONTROL_SIZE];
+    } control_un[VOS_MAX_SOCK_BATCH];
+    struct sockaddr_in  srcAddr[VOS_MAX_SOCK_BATCH];
+    struct mmsghdr      msgs[VOS_MAX_SOCK_BATCH];
+    struct iovec        iov[VOS_MAX_SOCK_BATCH];
+    int                 rcvCnt;
+    UINT32              i;
+
+    if ((sock == -1) || (pMsgs == NULL) || (pNoMsgs == NULL) || (maxMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (maxMsgs > VOS_MAX_SOCK_BATCH)
+    {
+        maxMsgs = VOS_MAX_SOCK_BATCH;
+    }
+
+    *pNoMsgs = 0u;
+
+    /* clear our address buffers */
+    memset(msgs, 0, maxMsgs * sizeof(struct mmsghdr));
+    memset(control_un, 0, maxMsgs * sizeof(control_un[0]));
+
+    for (i = 0u; i < maxMsgs; i++)
+    {
+        iov[i].iov_base = pMsgs[i].pBuffer;
+        iov[i].iov_len  = pMsgs[i].size;
+        msgs[i].msg_hdr.msg_iov         = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen      = 1;
+        msgs[i].msg_hdr.msg_name        = &srcAddr[i];
+        msgs[i].msg_hdr.msg_namelen     = sizeof(srcAddr[i]);
+        msgs[i].msg_hdr.msg_control     = &control_un[i].cm;
+        msgs[i].msg_hdr.msg_controllen  = sizeof(control_un[i]);
+    }
+
+    /* MSG_WAITFORONE: block (if blocking socket) only for the first datagram */
+    do
+    {
+        rcvCnt = recvmmsg(sock, msgs, maxMsgs, MSG_WAITFORONE, NULL);
+    }
+    while (rcvCnt == -1 && errno == EINTR);
+
+    if (rcvCnt == -1)
+    {
+        if (errno == EWOULDBLOCK)
+        {
+            return VOS_BLOCK_ERR;
+        }
+        else if (errno == ECONNRESET)
+        {
+            /* ICMP port unreachable received (result of previous send), treat this as no error */
+            return VOS_NO_ERR;
+        }
+        else
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "recvmmsg() failed (Err: %s)\n", buff);
+            return VOS_IO_ERR;
+        }
+    }
+    else if (rcvCnt == 0)
+    {
+        return VOS_NODATA_ERR;
+    }
+
+    for (i = 0u; i < (UINT32) rcvCnt; i++)
+    {
+        pMsgs[i].size       = (UINT32) msgs[i].msg_len;
+        pMsgs[i].srcIPAddr  = (UINT32) vos_ntohl(srcAddr[i].sin_addr.s_addr);
+        pMsgs[i].srcIPPort  = (UINT16) vos_ntohs(srcAddr[i].sin_port);
+        pMsgs[i].dstIPAddr  = 0u;
+        vos_sockGetDstAddr(&msgs[i].msg_hdr, &pMsgs[i].dstIPAddr);
+        vos_sockGetRxTime(&msgs[i].msg_hdr, &pMsgs[i].rxTime);
+    }
+    *pNoMsgs = (UINT32) rcvCnt;
+    return VOS_NO_ERR;
+#else
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      i;
+
+    if ((pMsgs == NULL) || (pNoMsgs == NULL) || (maxMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pNoMsgs = 0u;
+
+    for (i = 0u; (i < maxMsgs) && (i < VOS_MAX_SOCK_BATCH); i++)
+    {
+        err = vos_sockReceiveUDPTime(sock,
+                                     pMsgs[i].pBuffer,
+                                     &pMsgs[i].size,
+                                     &pMsgs[i].srcIPAddr,
+                                     &pMsgs[i].srcIPPort,
+                                     &pMsgs[i].dstIPAddr,
+                                     FALSE,
+                                     &pMsgs[i].rxTime);
+        if ((err != VOS_NO_ERR) || (pMsgs[i].size == 0u))
+        {
+            break;
+        }
+        (*pNoMsgs)++;
+    }
+
+    return (*pNoMsgs > 0u) ? VOS_NO_ERR : err;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -1551,6 +4554,102 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data gathered from several buffers.
+ *  The segments are sent in order as one byte stream with writev(), without copying them into one buffer first.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pSegs           array of buffer segments
+ *  @param[in]      noSegs          number of entries in pSegs (at most VOS_MAX_SOCK_SEGS)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET                  sock,
+    const VOS_SOCK_SEG_T    *pSegs,
+    UINT32                  noSegs,
+    UINT32                  *pSize)
+{
+    struct iovec    iov[VOS_MAX_SOCK_SEGS];
+    struct iovec    *pIov   = iov;
+    int             iovCnt  = 0;
+    ssize_t         sendSize = 0;
+    UINT32          i;
+
+    if (sock == -1 || pSegs == NULL || pSize == NULL || noSegs > VOS_MAX_SOCK_SEGS)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0u;
+    for (i = 0u; i < noSegs; i++)
+    {
+        if (pSegs[i].size > 0u)
+        {
+            iov[iovCnt].iov_base    = (void *) pSegs[i].pBuffer;
+            iov[iovCnt].iov_len     = (size_t) pSegs[i].size;
+            iovCnt++;
+        }
+    }
+
+    /* Keep on sending until we got rid of all data or we received an unrecoverable error */
+    while (iovCnt > 0)
+    {
+        sendSize = writev(sock, pIov, iovCnt);
+        if (sendSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EWOULDBLOCK)
+            {
+                return VOS_BLOCK_ERR;
+            }
+            break;
+        }
+        *pSize += (UINT32) sendSize;
+
+        /* skip the segments sent completely, adjust a partially sent one */
+        while ((iovCnt > 0) && ((size_t) sendSize >= pIov->iov_len))
+        {
+            sendSize -= (ssize_t) pIov->iov_len;
+            pIov++;
+            iovCnt--;
+        }
+        if (iovCnt > 0)
+        {
+            pIov->iov_base  = (UINT8 *) pIov->iov_base + sendSize;
+            pIov->iov_len   -= (size_t) sendSize;
+        }
+    }
+
+    if (sendSize == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_WARNING, "writev() failed (Err: %s)\n", buff);
+
+        if ((errno == ENOTCONN)
+            || (errno == ECONNREFUSED)
+            || (errno == EHOSTUNREACH))
+        {
+            return VOS_NOCONN_ERR;
+        }
+        else
+        {
+            return VOS_IO_ERR;
+        }
+    }
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -36,6 +36,8 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <errno.h>
 #include <sys/time.h>
@@ -50,12 +52,21 @@
 #include "vos_sock.h"
 #endif
 
+#if defined(__linux__) && defined(CLOCK_MONOTONIC)
+#include <fcntl.h>
+#endif
+
 #include "vos_types.h"
 #include "vos_thread.h"
 #include "vos_mem.h"
 #include "vos_utils.h"
 #include "vos_private.h"
 
+#if VOS_MUTEX_FUTEX
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
 /***********************************************************************************************************************
  * DEFINITIONS
  */
@@ -64,11 +75,84 @@
 #define PTHREAD_MUTEX_RECURSIVE  PTHREAD_MUTEX_RECURSIVE_NP     /*lint !e652 Does Lint ignore the #ifndef ? */
 #endif
 
+/* sem_clockwait() waits for a deadline on the monotonic clock (glibc 2.30 and later) */
+#if defined(__GLIBC__) && defined(_GNU_SOURCE) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 30)))
+#define VOS_SEM_CLOCKWAIT   1
+#else
+#define VOS_SEM_CLOCKWAIT   0
+#endif
+
+/* The clock of vos_getTime() can be a PTP hardware clock, opened as dynamic POSIX clock (Linux) */
+#if defined(__linux__) && defined(CLOCK_MONOTONIC)
+#define VOS_PTP_CLOCK           1
+#define VOS_FD_TO_CLOCKID(fd)   ((~(clockid_t) (fd) << 3) | 3)
+#define VOS_PTP_ACTIVE          (sPtpFd >= 0)
+#else
+#define VOS_PTP_CLOCK           0
+#define VOS_PTP_ACTIVE          FALSE
+#endif
+
+/* Clock of the deadline passed to sem_clockwait() or sem_timedwait() */
+#if VOS_SEM_CLOCKWAIT || defined(__QNXNTO__)
+#define VOS_SEM_WAIT_CLOCK      CLOCK_MONOTONIC
+#else
+#define VOS_SEM_WAIT_CLOCK      CLOCK_REALTIME
+#endif
+
+#ifndef VOS_MAX_CYCLIC_THREADS
+#define VOS_MAX_CYCLIC_THREADS  16u     /**< Cyclic threads with statistics    */
+#endif
+
+/** Statistics of a cyclic thread, registered while vos_cyclicThread() is running    */
+typedef struct
+{
+    pthread_t   thread;
+    BOOL8       used;
+    UINT32      cycles;                 /**< cycles run                                         */
+    UINT32      overruns;               /**< release times missed                               */
+    UINT32      maxRunTime;             /**< max. time from release to end of the cycle in us   */
+} VOS_CYCLIC_STAT_T;
+
+/** Start parameters of a cyclic thread created by vos_threadCreate()    */
+typedef struct
+{
+    UINT32              interval;
+    VOS_THREAD_FUNC_T   pFunction;
+    void                *pArguments;
+} VOS_CYCLIC_START_T;
+
+#if VOS_MUTEX_FUTEX
+#define VOS_MUTEX_SPIN      100u            /**< Lock attempts before a contended mutex sleeps */
+#define VOS_RWLOCK_WRITER   0x80000000u     /**< Read/write lock taken by a writer */
+#define VOS_RWLOCK_WAITERS  0x40000000u     /**< Threads are sleeping on the read/write lock */
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VOS_CPU_PAUSE()     __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define VOS_CPU_PAUSE()     __asm__ __volatile__ ("yield")
+#else
+#define VOS_CPU_PAUSE()     __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif
+#endif
+
 const size_t    cDefaultStackSize   = 4u * PTHREAD_STACK_MIN;
 const UINT32    cMutextMagic        = 0x1234FEDCu;
+const UINT32    cRwlockMagic        = 0x1234FEDDu;
 
 int             vosThreadInitialised = FALSE;
 
+#if VOS_MUTEX_FUTEX
+static UINT32               sMutexSpin = VOS_MUTEX_SPIN;    /* 0 on single processor systems */
+#endif
+
+static VOS_CYCLIC_STAT_T    sCyclicStat[VOS_MAX_CYCLIC_THREADS];
+static pthread_mutex_t      sCyclicStatMutex = PTHREAD_MUTEX_INITIALIZER;
+
+#if VOS_PTP_CLOCK
+static int                  sPtpFd      = -1;               /* open PTP clock device, -1: monotonic clock */
+static clockid_t            sTimeClock  = CLOCK_MONOTONIC;  /* clock of vos_getTime() */
+#endif
+
 /***********************************************************************************************************************
  *  LOCALS
  */
@@ -131,9 +215,76 @@ int sem_init (sem_t *pSema, int flags, unsigned int mode)
 /**********************************************************************************************************************/
 /*  Threads
                                                                                                                */
+/**********************************************************************************************************************/
+/** Register the calling thread for cycle statistics
+ *
+ *  @retval         pointer to the statistics entry, NULL if all entries are in use
+ */
+
+static VOS_CYCLIC_STAT_T *vos_cyclicRegister (void)
+{
+    VOS_CYCLIC_STAT_T   *pStat = NULL;
+    UINT32              i;
+
+    (void) pthread_mutex_lock(&sCyclicStatMutex);
+    for (i = 0u; i < VOS_MAX_CYCLIC_THREADS; i++)
+    {
+        if (sCyclicStat[i].used == FALSE)
+        {
+            pStat = &sCyclicStat[i];
+            memset(pStat, 0, sizeof(VOS_CYCLIC_STAT_T));
+            pStat->thread   = pthread_self();
+            pStat->used     = TRUE;
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sCyclicStatMutex);
+
+    if (pStat == NULL)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "no statistics for cyclic thread, increase VOS_MAX_CYCLIC_THREADS\n");
+    }
+    return pStat;
+}
+
+/**********************************************************************************************************************/
+/** Release the statistics entry of a cyclic thread, called on cancellation
+ *
+ *  @param[in]      pArg            Pointer to the statistics entry (may be NULL)
+ */
+
+static void vos_cyclicRelease (void *pArg)
+{
+    VOS_CYCLIC_STAT_T *pStat = (VOS_CYCLIC_STAT_T *) pArg;
+
+    if (pStat != NULL)
+    {
+        (void) pthread_mutex_lock(&sCyclicStatMutex);
+        pStat->used = FALSE;
+        (void) pthread_mutex_unlock(&sCyclicStatMutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Start routine of cyclic threads created by vos_threadCreate()
+ *
+ *  @param[in]      pArg            Pointer to the start parameters, released here
+ */
+
+static void vos_cyclicStart (void *pArg)
+{
+    VOS_CYCLIC_START_T start = *(VOS_CYCLIC_START_T *) pArg;
+
+    vos_memFree(pArg);
+    vos_cyclicThread(start.interval, start.pFunction, start.pArguments);
+}
+
 /**********************************************************************************************************************/
 /** Cyclic thread functions.
  *  Wrapper for cyclic threads. The thread function will be called cyclically with interval.
+ *  The release times are absolute deadlines on the monotonic clock, the period does not drift by the run time of
+ *  the thread function. If a cycle runs past the next release time, the missed releases are skipped and counted as
+ *  overruns, the thread stays in phase.
  *
  *  @param[in]      interval        Interval for cyclic threads in us (incl. runtime)
  *  @param[in]      pFunction       Pointer to the thread function
@@ -144,6 +295,7 @@ int sem_init (sem_t *pSema, int flags, unsigned int mode)
 #define NSECS_PER_USEC  1000u
 #define USECS_PER_MSEC  1000u
 #define MSECS_PER_SEC   1000u
+#define NSECS_PER_SEC   1000000000
 
 /* This define holds the max amount os seconds to get stored in 32bit holding micro seconds        */
 /* It is the result when using the common time struct with tv_sec and tv_usec as on a 32 bit value */
@@ -151,6 +303,83 @@ int sem_init (sem_t *pSema, int flags, unsigned int mode)
 /* are remaining to represent the seconds, which in turn give 0x10C5 seconds or in decimal 4293    */
 #define MAXSEC_FOR_USECPRESENTATION  4293
 
+#if defined(CLOCK_MONOTONIC) && !defined(__APPLE__)
+
+/* Nanoseconds from pB to pA */
+#define VOS_TIMESPEC_DIFF(pA, pB)   ((((INT64)(pA)->tv_sec - (INT64)(pB)->tv_sec) * NSECS_PER_SEC) + \
+                                     ((INT64)(pA)->tv_nsec - (INT64)(pB)->tv_nsec))
+
+static void vos_timespecAdd (
+    struct timespec *pTime,
+    INT64           ns)
+{
+    pTime->tv_sec   += (time_t) (ns / NSECS_PER_SEC);
+    pTime->tv_nsec  += (long) (ns % NSECS_PER_SEC);
+    if (pTime->tv_nsec >= NSECS_PER_SEC)
+    {
+        pTime->tv_sec++;
+        pTime->tv_nsec -= NSECS_PER_SEC;
+    }
+}
+
+EXT_DECL void vos_cyclicThread (
+    UINT32              interval,
+    VOS_THREAD_FUNC_T   pFunction,
+    void                *pArguments)
+{
+    const INT64         period = (INT64) interval * NSECS_PER_USEC;
+    VOS_CYCLIC_STAT_T   *pStat;
+    struct timespec     release;
+    struct timespec     now;
+    INT64               late;
+    INT64               runTime;
+    UINT32              missed;
+
+    pStat = vos_cyclicRegister();
+    pthread_cleanup_push(vos_cyclicRelease, pStat);
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &release);
+    for (;; )
+    {
+        pFunction(pArguments);    /* perform thread function */
+
+        (void) clock_gettime(CLOCK_MONOTONIC, &now);
+        runTime = VOS_TIMESPEC_DIFF(&now, &release);
+        vos_timespecAdd(&release, period);
+        late = VOS_TIMESPEC_DIFF(&now, &release);
+        missed = 0u;
+        if ((late > 0) && (period > 0))
+        {
+            /* skip the releases already passed, stay on the grid */
+            missed = (UINT32) (late / period) + 1u;
+            vos_timespecAdd(&release, (INT64) missed * period);
+            vos_printLog(VOS_LOG_WARNING,
+                         "cyclic thread with interval %u usec was running %u usec, %u cycle(s) skipped\n",
+                         (unsigned int)interval, (unsigned int) (runTime / NSECS_PER_USEC), (unsigned int) missed);
+        }
+        if (pStat != NULL)
+        {
+            __atomic_store_n(&pStat->cycles, pStat->cycles + 1u, __ATOMIC_RELAXED);
+            __atomic_store_n(&pStat->overruns, pStat->overruns + missed, __ATOMIC_RELAXED);
+            if ((UINT32) (runTime / NSECS_PER_USEC) > pStat->maxRunTime)
+            {
+                __atomic_store_n(&pStat->maxRunTime, (UINT32) (runTime / NSECS_PER_USEC), __ATOMIC_RELAXED);
+            }
+        }
+
+        /* clock_nanosleep() returns the error, it does not set errno */
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &release, NULL) == EINTR)
+        {
+            ;
+        }
+        pthread_testcancel();
+    }
+
+    pthread_cleanup_pop(1);     /*lint !e527 unreachable, pairs the push */
+}
+
+#else
+
 EXT_DECL void vos_cyclicThread (
     UINT32              interval,
     VOS_THREAD_FUNC_T   pFunction,
@@ -203,6 +432,53 @@ EXT_DECL void vos_cyclicThread (
     }
 }
 
+#endif
+
+/**********************************************************************************************************************/
+/** Get the statistics of a cyclic thread.
+ *
+ *  @param[in]      thread          Thread handle of a thread running vos_cyclicThread()
+ *  @param[out]     pCycles         Pointer to number of cycles run (optional)
+ *  @param[out]     pOverruns       Pointer to number of release times missed (optional)
+ *  @param[out]     pMaxRunTime     Pointer to max. time from release to end of a cycle in us (optional)
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   no cyclic thread with statistics
+ */
+
+EXT_DECL VOS_ERR_T vos_cyclicThreadStatistics (
+    VOS_THREAD_T    thread,
+    UINT32          *pCycles,
+    UINT32          *pOverruns,
+    UINT32          *pMaxRunTime)
+{
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+    UINT32      i;
+
+    (void) pthread_mutex_lock(&sCyclicStatMutex);
+    for (i = 0u; i < VOS_MAX_CYCLIC_THREADS; i++)
+    {
+        if ((sCyclicStat[i].used == TRUE) && (pthread_equal(sCyclicStat[i].thread, (pthread_t) thread) != 0))
+        {
+            if (pCycles != NULL)
+            {
+                *pCycles = __atomic_load_n(&sCyclicStat[i].cycles, __ATOMIC_RELAXED);
+            }
+            if (pOverruns != NULL)
+            {
+                *pOverruns = __atomic_load_n(&sCyclicStat[i].overruns, __ATOMIC_RELAXED);
+            }
+            if (pMaxRunTime != NULL)
+            {
+                *pMaxRunTime = __atomic_load_n(&sCyclicStat[i].maxRunTime, __ATOMIC_RELAXED);
+            }
+            err = VOS_NO_ERR;
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sCyclicStatMutex);
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Initialize the thread library.
  *  Must be called once before any other call
@@ -214,6 +490,10 @@ EXT_DECL void vos_cyclicThread (
 EXT_DECL VOS_ERR_T vos_threadInit (
     void)
 {
+#if VOS_MUTEX_FUTEX && defined(_SC_NPROCESSORS_ONLN)
+    /* spinning only helps if the owner runs on another processor */
+    sMutexSpin = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? VOS_MUTEX_SPIN : 0u;
+#endif
     vosThreadInitialised = TRUE;
 
     return VOS_NO_ERR;
@@ -260,31 +540,60 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     UINT32                  stackSize,
     VOS_THREAD_FUNC_T       pFunction,
     void                    *pArguments)
+{
+    return vos_threadCreateAffine(pThread, pName, policy, priority, interval, stackSize, 0u, pFunction, pArguments);
+}
+
+/**********************************************************************************************************************/
+/** Create a thread bound to a set of CPUs.
+ *  As vos_threadCreate(), the thread runs on the CPUs set in cpuMask only. With an interval, the thread function is
+ *  called by vos_cyclicThread() at absolute release times. The priority is limited to the range of the policy
+ *  (1...99 for FIFO and Round Robin on Linux).
+ *
+ *  @param[out]     pThread         Pointer to returned thread handle
+ *  @param[in]      pName           Pointer to name of the thread (optional)
+ *  @param[in]      policy          Scheduling policy (FIFO, Round Robin or other)
+ *  @param[in]      priority        Scheduling priority (1...255 (highest), default 0)
+ *  @param[in]      interval        Interval for cyclic threads in us (optional)
+ *  @param[in]      stackSize       Minimum stacksize, default 0: 16kB
+ *  @param[in]      cpuMask         CPUs the thread may run on (bit 0: CPU 0), 0: all
+ *  @param[in]      pFunction       Pointer to the thread function
+ *  @param[in]      pArguments      Pointer to the thread function parameters
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_THREAD_ERR  thread creation error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadCreateAffine (
+    VOS_THREAD_T            *pThread,
+    const CHAR8             *pName,
+    VOS_THREAD_POLICY_T     policy,
+    VOS_THREAD_PRIORITY_T   priority,
+    UINT32                  interval,
+    UINT32                  stackSize,
+    UINT32                  cpuMask,
+    VOS_THREAD_FUNC_T       pFunction,
+    void                    *pArguments)
 {
     pthread_t           hThread;
     pthread_attr_t      threadAttrib;
     struct sched_param  schedParam;  /* scheduling priority */
     int         retCode;
+    VOS_CYCLIC_START_T  *pStart = NULL;
 
     if (!vosThreadInitialised)
     {
         return VOS_INIT_ERR;
     }
 
-    if ((pThread == NULL) || (pName == NULL))
+    if ((pThread == NULL) || (pName == NULL) || (pFunction == NULL))
     {
         return VOS_PARAM_ERR;
     }
 
     *pThread = NULL;
-    
-    if (interval > 0u)
-    {
-        vos_printLog(VOS_LOG_ERROR,
-                     "%s cyclic threads not implemented yet\n",
-                     pName);
-        return VOS_INIT_ERR;
-    }
 
     /* Initialize thread attributes to default values */
     retCode = pthread_attr_init(&threadAttrib);
@@ -350,8 +659,19 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
         }
     }
 
-    /* Set the scheduling priority of the thread */
+    /* Set the scheduling priority of the thread, within the range of the policy */
     schedParam.sched_priority = priority;
+    if (policy != VOS_THREAD_POLICY_OTHER)
+    {
+        if (schedParam.sched_priority < sched_get_priority_min((int)policy))
+        {
+            schedParam.sched_priority = sched_get_priority_min((int)policy);
+        }
+        else if (schedParam.sched_priority > sched_get_priority_max((int)policy))
+        {
+            schedParam.sched_priority = sched_get_priority_max((int)policy);
+        }
+    }
     retCode = pthread_attr_setschedparam(&threadAttrib, &schedParam);
     if (retCode != 0)
     {
@@ -377,6 +697,52 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
         return VOS_THREAD_ERR;
     }
 
+    /* Bind the thread to the CPUs */
+    if (cpuMask != 0u)
+    {
+#if defined(__linux__) && defined(_GNU_SOURCE)
+        cpu_set_t   cpuSet;
+        UINT32      cpu;
+
+        CPU_ZERO(&cpuSet);
+        for (cpu = 0u; cpu < 32u; cpu++)
+        {
+            if ((cpuMask & (1u << cpu)) != 0u)
+            {
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+        retCode = pthread_attr_setaffinity_np(&threadAttrib, sizeof(cpuSet), &cpuSet);
+        if (retCode != 0)
+        {
+            vos_printLog(
+                VOS_LOG_ERROR,
+                "%s pthread_attr_setaffinity_np(0x%x) failed (Err:%d)\n",
+                pName,
+                (unsigned int)cpuMask,
+                (int)retCode );
+        }
+#else
+        vos_printLog(VOS_LOG_WARNING, "%s CPU affinity not supported, ignored\n", pName);
+#endif
+    }
+
+    /* Cyclic threads are run by vos_cyclicThread() */
+    if (interval > 0u)
+    {
+        pStart = (VOS_CYCLIC_START_T *) vos_memAlloc(sizeof(VOS_CYCLIC_START_T));
+        if (pStart == NULL)
+        {
+            (void) pthread_attr_destroy(&threadAttrib);
+            return VOS_MEM_ERR;
+        }
+        pStart->interval    = interval;
+        pStart->pFunction   = pFunction;
+        pStart->pArguments  = pArguments;
+        pFunction           = vos_cyclicStart;
+        pArguments          = pStart;
+    }
+
     /* Create the thread */
     retCode = pthread_create(&hThread, &threadAttrib, (void *(*)(
                                                            void *))pFunction,
@@ -387,6 +753,11 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
                      "%s pthread_create() failed (Err:%d)\n",
                      pName,
                      (int)retCode );
+        if (pStart != NULL)
+        {
+            vos_memFree(pStart);
+        }
+        (void) pthread_attr_destroy(&threadAttrib);
         return VOS_THREAD_ERR;
     }
 
@@ -527,7 +898,10 @@ EXT_DECL VOS_ERR_T vos_threadDelay (
 
 /**********************************************************************************************************************/
 /** Return the current time in sec and us
- *
+ *  The monotonic clock is read through the vDSO on Linux, no system call is made.
+ *  With VOS_COARSE_CLOCK defined, CLOCK_MONOTONIC_COARSE is read instead: it is cheaper still, but only advances
+ *  with the kernel tick (1...10ms) and therefore suits process cycle times well above the tick only.
+ *  After vos_setTimeBase() the PTP hardware clock is read, by a system call.
  *
  *  @param[out]     pTime           Pointer to time value
  */
@@ -555,7 +929,20 @@ EXT_DECL void vos_getTime (
 
         struct timespec currentTime;
 
-        (void)clock_gettime(CLOCK_MONOTONIC, &currentTime);
+#if VOS_PTP_CLOCK
+        if (VOS_PTP_ACTIVE)
+        {
+            (void)clock_gettime(sTimeClock, &currentTime);
+        }
+        else
+#endif
+        {
+#if defined(VOS_COARSE_CLOCK) && defined(CLOCK_MONOTONIC_COARSE)
+            (void)clock_gettime(CLOCK_MONOTONIC_COARSE, &currentTime);
+#else
+            (void)clock_gettime(CLOCK_MONOTONIC, &currentTime);
+#endif
+        }
 
         myTime.tv_sec   = currentTime.tv_sec;               \
         myTime.tv_usec  = (int) currentTime.tv_nsec / 1000; \
@@ -567,6 +954,61 @@ EXT_DECL void vos_getTime (
     }
 }
 
+/**********************************************************************************************************************/
+/** Select the time base of vos_getTime().
+ *  The PTP device is opened as dynamic POSIX clock and read once to check it.
+ *
+ *  @param[in]      pPtpDevice      PTP clock device, NULL for the local monotonic clock (default)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    device cannot be opened or read, or not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_setTimeBase (
+    const CHAR8 *pPtpDevice)
+{
+#if VOS_PTP_CLOCK
+    int fd = -1;
+
+    if (pPtpDevice != NULL)
+    {
+        struct timespec now;
+
+        fd = open(pPtpDevice, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            vos_printLog(VOS_LOG_ERROR, "vos_setTimeBase() cannot open %s (errno %d)\n", pPtpDevice, errno);
+            return VOS_INIT_ERR;
+        }
+        if (clock_gettime(VOS_FD_TO_CLOCKID(fd), &now) != 0)
+        {
+            vos_printLog(VOS_LOG_ERROR, "vos_setTimeBase() %s is no PTP clock (errno %d)\n", pPtpDevice, errno);
+            (void) close(fd);
+            return VOS_INIT_ERR;
+        }
+        sTimeClock = VOS_FD_TO_CLOCKID(fd);
+    }
+    else
+    {
+        sTimeClock = CLOCK_MONOTONIC;
+    }
+    if (sPtpFd >= 0)
+    {
+        (void) close(sPtpFd);
+    }
+    sPtpFd = fd;
+    vos_printLog(VOS_LOG_INFO, "vos_getTime() reads %s\n", (pPtpDevice != NULL) ? pPtpDevice : "CLOCK_MONOTONIC");
+    return VOS_NO_ERR;
+#else
+    if (pPtpDevice == NULL)
+    {
+        return VOS_NO_ERR;
+    }
+    vos_printLogStr(VOS_LOG_ERROR, "vos_setTimeBase() PTP clock not supported\n");
+    return VOS_INIT_ERR;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Get a time-stamp string.
  *  Get a time-stamp string for debugging in the form "yyyymmdd-hh:mm:ss.ms"
@@ -806,53 +1248,159 @@ EXT_DECL void vos_getUuid (
 /**********************************************************************************************************************/
 
 /**********************************************************************************************************************/
-/** Create a recursive mutex.
- *  Return a mutex handle. The mutex will be available at creation.
+/** Initialise a recursive mutex.
  *
- *  @param[out]     pMutex          Pointer to mutex handle
- *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_INIT_ERR    module not initialised
- *  @retval         VOS_PARAM_ERR   pMutex == NULL
- *  @retval         VOS_MUTEX_ERR   no mutex available
+ *  @param[in]      pMutex          Pointer to mutex struct
+ *  @retval         0               no error
+ *  @retval         else            pthread error
  */
 
-EXT_DECL VOS_ERR_T vos_mutexCreate (
-    VOS_MUTEX_T *pMutex)
+static int mutexInit (
+    struct VOS_MUTEX *pMutex)
 {
-    int err = 0;
+#if VOS_MUTEX_FUTEX
+    pMutex->state   = 0u;
+    pMutex->count   = 0u;
+    pMutex->owner   = (pthread_t) 0;
+    return 0;
+#else
+    int err;
     pthread_mutexattr_t attr;
 
-    if (pMutex == NULL)
-    {
-        return VOS_PARAM_ERR;
-    }
-
-    *pMutex = (VOS_MUTEX_T) vos_memAlloc(sizeof (struct VOS_MUTEX));
-
-    if (*pMutex == NULL)
-    {
-        return VOS_MEM_ERR;
-    }
-
     err = pthread_mutexattr_init(&attr);
     if (err == 0)
     {
         err = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
         if (err == 0)
         {
-            err = pthread_mutex_init((pthread_mutex_t *)&(*pMutex)->mutexId, &attr);
+            err = pthread_mutex_init((pthread_mutex_t *)&pMutex->mutexId, &attr);
         }
         pthread_mutexattr_destroy(&attr); /*lint !e534 ignore return value */
     }
+    return err;
+#endif
+}
 
-    if (err == 0)
-    {
-        (*pMutex)->magicNo = cMutextMagic;
-    }
-    else
-    {
-        vos_printLog(VOS_LOG_ERROR, "Can not create Mutex(pthread err=%d)\n", (int)err);
-        vos_memFree(*pMutex);
+/**********************************************************************************************************************/
+/** Destroy a mutex.
+ *
+ *  @param[in]      pMutex          Pointer to mutex struct
+ *  @retval         0               no error
+ *  @retval         else            pthread error
+ */
+
+static int mutexDestroy (
+    struct VOS_MUTEX *pMutex)
+{
+#if VOS_MUTEX_FUTEX
+    return (__atomic_load_n(&pMutex->state, __ATOMIC_RELAXED) == 0u) ? 0 : EBUSY;
+#else
+    return pthread_mutex_destroy((pthread_mutex_t *)&pMutex->mutexId);
+#endif
+}
+
+#if VOS_MUTEX_FUTEX
+/**********************************************************************************************************************/
+/** Lock a contended mutex.
+ *  Spin while the owner is likely to release the mutex soon, then mark the mutex contended and sleep on the futex.
+ *
+ *  @param[in]      pMutex          Pointer to mutex struct
+ */
+
+static void mutexLockContended (
+    struct VOS_MUTEX *pMutex)
+{
+    UINT32  state;
+    UINT32  i;
+
+    for (i = 0u; i < sMutexSpin; i++)
+    {
+        state = 0u;
+        if ((__atomic_load_n(&pMutex->state, __ATOMIC_RELAXED) == 0u) &&
+            __atomic_compare_exchange_n(&pMutex->state, &state, 1u, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            return;
+        }
+        VOS_CPU_PAUSE();
+    }
+
+    /* from now on the owner has to wake a waiter when unlocking */
+    state = __atomic_exchange_n(&pMutex->state, 2u, __ATOMIC_ACQUIRE);
+    while (state != 0u)
+    {
+        (void) syscall(SYS_futex, &pMutex->state, FUTEX_WAIT_PRIVATE, 2u, NULL, NULL, 0);
+        state = __atomic_exchange_n(&pMutex->state, 2u, __ATOMIC_ACQUIRE);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Wait until the state of a read/write lock changes.
+ *  Spin first, then mark the lock as waited for and sleep on the futex.
+ *
+ *  @param[in]      pLock           Pointer to read/write lock struct
+ *  @param[in]      state           State which prevented taking the lock
+ *  @param[in,out]  pSpin           Spin counter
+ */
+
+static void rwlockWait (
+    struct VOS_RWLOCK   *pLock,
+    UINT32              state,
+    UINT32              *pSpin)
+{
+    if (*pSpin < sMutexSpin)
+    {
+        (*pSpin)++;
+        VOS_CPU_PAUSE();
+        return;
+    }
+    if (((state & VOS_RWLOCK_WAITERS) == 0u) &&
+        !__atomic_compare_exchange_n(&pLock->state, &state, state | VOS_RWLOCK_WAITERS, FALSE,
+                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+    (void) syscall(SYS_futex, &pLock->state, FUTEX_WAIT_PRIVATE, state | VOS_RWLOCK_WAITERS, NULL, NULL, 0);
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Create a recursive mutex.
+ *  Return a mutex handle. The mutex will be available at creation.
+ *
+ *  @param[out]     pMutex          Pointer to mutex handle
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised
+ *  @retval         VOS_PARAM_ERR   pMutex == NULL
+ *  @retval         VOS_MUTEX_ERR   no mutex available
+ */
+
+EXT_DECL VOS_ERR_T vos_mutexCreate (
+    VOS_MUTEX_T *pMutex)
+{
+    int err = 0;
+
+    if (pMutex == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pMutex = (VOS_MUTEX_T) vos_memAlloc(sizeof (struct VOS_MUTEX));
+
+    if (*pMutex == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+
+    err = mutexInit(*pMutex);
+
+    if (err == 0)
+    {
+        (*pMutex)->magicNo = cMutextMagic;
+    }
+    else
+    {
+        vos_printLog(VOS_LOG_ERROR, "Can not create Mutex(pthread err=%d)\n", (int)err);
+        vos_memFree(*pMutex);
         *pMutex = NULL;
         return VOS_MUTEX_ERR;
     }
@@ -875,23 +1423,13 @@ EXT_DECL VOS_ERR_T vos_mutexLocalCreate (
     struct VOS_MUTEX *pMutex)
 {
     int err = 0;
-    pthread_mutexattr_t attr;
 
     if (pMutex == NULL)
     {
         return VOS_PARAM_ERR;
     }
 
-    err = pthread_mutexattr_init(&attr);
-    if (err == 0)
-    {
-        err = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-        if (err == 0)
-        {
-            err = pthread_mutex_init((pthread_mutex_t *)&pMutex->mutexId, &attr);
-        }
-        pthread_mutexattr_destroy(&attr); /*lint !e534 ignore return value */
-    }
+    err = mutexInit(pMutex);
 
     if (err == 0)
     {
@@ -925,7 +1463,7 @@ EXT_DECL void vos_mutexDelete (
     {
         int err;
 
-        err = pthread_mutex_destroy((pthread_mutex_t *)&pMutex->mutexId);
+        err = mutexDestroy(pMutex);
         if (err == 0)
         {
             pMutex->magicNo = 0;
@@ -957,7 +1495,7 @@ EXT_DECL void vos_mutexLocalDelete (
     {
         int err;
 
-        err = pthread_mutex_destroy((pthread_mutex_t *)&pMutex->mutexId);
+        err = mutexDestroy(pMutex);
         if (err == 0)
         {
             pMutex->magicNo = 0;
@@ -983,6 +1521,28 @@ EXT_DECL void vos_mutexLocalDelete (
 EXT_DECL VOS_ERR_T vos_mutexLock (
     VOS_MUTEX_T pMutex)
 {
+#if VOS_MUTEX_FUTEX
+    pthread_t   self = pthread_self();
+    UINT32      state = 0u;
+
+    if ((pMutex == NULL) || (pMutex->magicNo != cMutextMagic))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /* only the owner itself can find its id here */
+    if (pthread_equal(__atomic_load_n(&pMutex->owner, __ATOMIC_RELAXED), self) != 0)
+    {
+        pMutex->count++;
+        return VOS_NO_ERR;
+    }
+    if (!__atomic_compare_exchange_n(&pMutex->state, &state, 1u, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        mutexLockContended(pMutex);
+    }
+    __atomic_store_n(&pMutex->owner, self, __ATOMIC_RELAXED);
+    pMutex->count = 1u;
+#else
     int err;
 
     if ((pMutex == NULL) || (pMutex->magicNo != cMutextMagic))
@@ -996,6 +1556,7 @@ EXT_DECL VOS_ERR_T vos_mutexLock (
         vos_printLog(VOS_LOG_ERROR, "Unable to lock Mutex (pthread err=%d)\n", (int)err);
         return VOS_MUTEX_ERR;   /*lint !e454 was not locked! */
     }
+#endif
 
     return VOS_NO_ERR;   /*lint !e454 was locked */
 }/*lint !e454 was locked */
@@ -1014,6 +1575,27 @@ EXT_DECL VOS_ERR_T vos_mutexLock (
 EXT_DECL VOS_ERR_T vos_mutexTryLock (
     VOS_MUTEX_T pMutex)
 {
+#if VOS_MUTEX_FUTEX
+    pthread_t   self = pthread_self();
+    UINT32      state = 0u;
+
+    if ((pMutex == NULL) || (pMutex->magicNo != cMutextMagic))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (pthread_equal(__atomic_load_n(&pMutex->owner, __ATOMIC_RELAXED), self) != 0)
+    {
+        pMutex->count++;
+        return VOS_NO_ERR;
+    }
+    if (!__atomic_compare_exchange_n(&pMutex->state, &state, 1u, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        return VOS_INUSE_ERR;
+    }
+    __atomic_store_n(&pMutex->owner, self, __ATOMIC_RELAXED);
+    pMutex->count = 1u;
+#else
     int err;
 
     if ((pMutex == NULL) || (pMutex->magicNo != cMutextMagic))
@@ -1031,6 +1613,7 @@ EXT_DECL VOS_ERR_T vos_mutexTryLock (
         vos_printLog(VOS_LOG_ERROR, "Unable to trylock Mutex (pthread err=%d)\n", (int)err);
         return VOS_MUTEX_ERR;
     }
+#endif
 
     return VOS_NO_ERR;
 }
@@ -1054,6 +1637,21 @@ EXT_DECL VOS_ERR_T vos_mutexUnlock (
     }
     else
     {
+#if VOS_MUTEX_FUTEX
+        if (pthread_equal(__atomic_load_n(&pMutex->owner, __ATOMIC_RELAXED), pthread_self()) == 0)
+        {
+            vos_printLog(VOS_LOG_ERROR, "Unable to unlock Mutex (pthread err=%d)\n", (int)EPERM);
+            return VOS_MUTEX_ERR;
+        }
+        if (--pMutex->count == 0u)
+        {
+            __atomic_store_n(&pMutex->owner, (pthread_t) 0, __ATOMIC_RELAXED);
+            if (__atomic_exchange_n(&pMutex->state, 0u, __ATOMIC_RELEASE) == 2u)
+            {
+                (void) syscall(SYS_futex, &pMutex->state, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+            }
+        }
+#else
         int err;
 
         err = pthread_mutex_unlock((pthread_mutex_t *)&pMutex->mutexId);   /*lint !e455 was not unlocked */
@@ -1062,12 +1660,259 @@ EXT_DECL VOS_ERR_T vos_mutexUnlock (
             vos_printLog(VOS_LOG_ERROR, "Unable to unlock Mutex (pthread err=%d)\n", (int)err);
             return VOS_MUTEX_ERR;   /*lint !e455 was not unlocked */
         }
+#endif
     }
 
     return VOS_NO_ERR;   /*lint !e455 was not unlocked */
 }
 
 
+/**********************************************************************************************************************/
+/** Create a read/write lock.
+ *  Any number of readers or one writer hold the lock. The lock is not recursive, readers are preferred.
+ *
+ *  @param[out]     pLock           Pointer to read/write lock handle
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pLock == NULL
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_MUTEX_ERR   no lock available
+ */
+
+EXT_DECL VOS_ERR_T vos_rwlockCreate (
+    VOS_RWLOCK_T *pLock)
+{
+    int err = 0;
+
+    if (pLock == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pLock = (VOS_RWLOCK_T) vos_memAlloc(sizeof (struct VOS_RWLOCK));
+    if (*pLock == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+
+#if VOS_MUTEX_FUTEX
+    (*pLock)->state = 0u;
+#else
+    err = pthread_rwlock_init(&(*pLock)->lockId, NULL);
+#endif
+    if (err != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Can not create read/write lock (pthread err=%d)\n", (int)err);
+        vos_memFree(*pLock);
+        *pLock = NULL;
+        return VOS_MUTEX_ERR;
+    }
+    (*pLock)->magicNo = cRwlockMagic;
+
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Delete a read/write lock.
+ *  Release the resources taken by the lock.
+ *
+ *  @param[in]      lock            Read/write lock handle
+ */
+
+EXT_DECL void vos_rwlockDelete (
+    VOS_RWLOCK_T lock)
+{
+    int err;
+
+    if ((lock == NULL) || (lock->magicNo != cRwlockMagic))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_rwlockDelete() ERROR invalid parameter");
+        return;
+    }
+
+#if VOS_MUTEX_FUTEX
+    err = ((__atomic_load_n(&lock->state, __ATOMIC_RELAXED) & ~VOS_RWLOCK_WAITERS) == 0u) ? 0 : EBUSY;
+#else
+    err = pthread_rwlock_destroy(&lock->lockId);
+#endif
+    if (err == 0)
+    {
+        lock->magicNo = 0u;
+        vos_memFree(lock);
+    }
+    else
+    {
+        vos_printLog(VOS_LOG_ERROR, "Can not destroy read/write lock (pthread err=%d)\n", (int)err);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Take a read/write lock for reading.
+ *  Wait until no writer holds the lock.
+ *
+ *  @param[in]      lock            Read/write lock handle
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   lock == NULL or wrong type
+ *  @retval         VOS_MUTEX_ERR   lock could not be taken
+ */
+
+EXT_DECL VOS_ERR_T vos_rwlockRead (
+    VOS_RWLOCK_T lock)
+{
+#if VOS_MUTEX_FUTEX
+    UINT32  state;
+    UINT32  spin = 0u;
+#else
+    int     err;
+#endif
+
+    if ((lock == NULL) || (lock->magicNo != cRwlockMagic))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+#if VOS_MUTEX_FUTEX
+    for (;; )
+    {
+        state = __atomic_load_n(&lock->state, __ATOMIC_RELAXED);
+        if ((state & VOS_RWLOCK_WRITER) == 0u)
+        {
+            if (__atomic_compare_exchange_n(&lock->state, &state, state + 1u, FALSE,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else
+        {
+            rwlockWait(lock, state, &spin);
+        }
+    }
+#else
+    err = pthread_rwlock_rdlock(&lock->lockId);
+    if (err != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Unable to read lock (pthread err=%d)\n", (int)err);
+        return VOS_MUTEX_ERR;
+    }
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Take a read/write lock for writing.
+ *  Wait until neither a reader nor a writer holds the lock.
+ *
+ *  @param[in]      lock            Read/write lock handle
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   lock == NULL or wrong type
+ *  @retval         VOS_MUTEX_ERR   lock could not be taken
+ */
+
+EXT_DECL VOS_ERR_T vos_rwlockWrite (
+    VOS_RWLOCK_T lock)
+{
+#if VOS_MUTEX_FUTEX
+    UINT32  state;
+    UINT32  spin = 0u;
+#else
+    int     err;
+#endif
+
+    if ((lock == NULL) || (lock->magicNo != cRwlockMagic))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+#if VOS_MUTEX_FUTEX
+    for (;; )
+    {
+        state = __atomic_load_n(&lock->state, __ATOMIC_RELAXED);
+        if ((state & ~VOS_RWLOCK_WAITERS) == 0u)
+        {
+            /* the waiters flag is kept, the writer wakes them on unlock */
+            if (__atomic_compare_exchange_n(&lock->state, &state, state | VOS_RWLOCK_WRITER, FALSE,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else
+        {
+            rwlockWait(lock, state, &spin);
+        }
+    }
+#else
+    err = pthread_rwlock_wrlock(&lock->lockId);
+    if (err != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Unable to write lock (pthread err=%d)\n", (int)err);
+        return VOS_MUTEX_ERR;
+    }
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release a read/write lock taken for reading or writing.
+ *
+ *  @param[in]      lock            Read/write lock handle
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   lock == NULL or wrong type
+ *  @retval         VOS_MUTEX_ERR   lock was not taken
+ */
+
+EXT_DECL VOS_ERR_T vos_rwlockUnlock (
+    VOS_RWLOCK_T lock)
+{
+#if VOS_MUTEX_FUTEX
+    UINT32  state;
+#else
+    int     err;
+#endif
+
+    if ((lock == NULL) || (lock->magicNo != cRwlockMagic))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_rwlockUnlock() ERROR invalid parameter");
+        return VOS_PARAM_ERR;
+    }
+
+#if VOS_MUTEX_FUTEX
+    state = __atomic_load_n(&lock->state, __ATOMIC_RELAXED);
+    if ((state & ~VOS_RWLOCK_WAITERS) == 0u)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_rwlockUnlock() ERROR lock not taken");
+        return VOS_MUTEX_ERR;
+    }
+    if ((state & VOS_RWLOCK_WRITER) != 0u)
+    {
+        state = __atomic_exchange_n(&lock->state, 0u, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        /* the last reader clears the waiters flag, unless the lock was taken again meanwhile */
+        state = VOS_RWLOCK_WAITERS;
+        if ((__atomic_sub_fetch(&lock->state, 1u, __ATOMIC_RELEASE) != VOS_RWLOCK_WAITERS) ||
+            !__atomic_compare_exchange_n(&lock->state, &state, 0u, FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            state = 0u;
+        }
+    }
+    if ((state & VOS_RWLOCK_WAITERS) != 0u)
+    {
+        (void) syscall(SYS_futex, &lock->state, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+#else
+    err = pthread_rwlock_unlock(&lock->lockId);
+    if (err != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Unable to unlock read/write lock (pthread err=%d)\n", (int)err);
+        return VOS_MUTEX_ERR;
+    }
+#endif
+    return VOS_NO_ERR;
+}
+
+
 
 /**********************************************************************************************************************/
 /** Create a semaphore.
@@ -1209,9 +2054,8 @@ EXT_DECL VOS_ERR_T vos_semaTake (
     VOS_SEMA_T  sema,
     UINT32      timeout)
 {
-    int rc = 0;
-    VOS_ERR_T       retVal = VOS_SEMA_ERR;
-    struct timespec waitTimeSpec = {0u, 0};
+    int             rc = 0;
+    VOS_TIMEVAL_T   deadline;
 
     /* Check parameter */
     if (sema == NULL)
@@ -1231,64 +2075,100 @@ EXT_DECL VOS_ERR_T vos_semaTake (
     }
     else
     {
-        /* Get time and convert it to timespec format */
-#ifdef __APPLE__
-        VOS_TIMEVAL_T waitTimeVos = {0u, 0};
-        vos_getTime(&waitTimeVos);
-        waitTimeSpec.tv_sec     = waitTimeVos.tv_sec;
-        waitTimeSpec.tv_nsec    = waitTimeVos.tv_usec * (suseconds_t) NSECS_PER_USEC;
-#else
-        (void) clock_gettime(CLOCK_REALTIME, &waitTimeSpec);
+        /* take semaphore with specified timeout */
+        vos_getTime(&deadline);
+        deadline.tv_sec     += (long) (timeout / (USECS_PER_MSEC * MSECS_PER_SEC));
+        deadline.tv_usec    += (long) (timeout % (USECS_PER_MSEC * MSECS_PER_SEC));
+        if (deadline.tv_usec >= (long) (USECS_PER_MSEC * MSECS_PER_SEC))
+        {
+            deadline.tv_sec++;
+            deadline.tv_usec -= (long) (USECS_PER_MSEC * MSECS_PER_SEC);
+        }
+        return vos_semaTakeUntil(sema, &deadline);
+    }
+    if (0 != rc)
+    {
+        /* Could not take Semaphore in time */
+        return VOS_SEMA_ERR;
+    }
+    /* Semaphore take success */
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Take a semaphore until a deadline.
+ *  The deadline is a time returned by vos_getTime() (monotonic clock), it is not shifted by steps of the system time
+ *  (NTP, PTP). A wait interrupted by a signal is resumed with the same deadline.
+ *  With a PTP time base (vos_setTimeBase()) the remaining time is waited on the local clock.
+ *
+ *  @param[in]      sema            semaphore handle
+ *  @param[in]      pDeadline       Latest time to take the semaphore, a past deadline means no wait
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_SEMA_ERR    could not get semaphore in time
+ */
+
+EXT_DECL VOS_ERR_T vos_semaTakeUntil (
+    VOS_SEMA_T          sema,
+    const VOS_TIMEVAL_T *pDeadline)
+{
+    struct timespec waitTimeSpec;
+    int             rc;
+
+    if ((sema == NULL) || (pDeadline == NULL))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_semaTakeUntil() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+
+#if VOS_SEM_CLOCKWAIT || defined(__QNXNTO__) || defined(__APPLE__) || !defined(CLOCK_MONOTONIC)
+    if (!VOS_PTP_ACTIVE)
+    {
+        /* the wait uses the clock of vos_getTime() */
+        waitTimeSpec.tv_sec     = pDeadline->tv_sec;
+        waitTimeSpec.tv_nsec    = (long) pDeadline->tv_usec * (long) NSECS_PER_USEC;
+    }
+    else
 #endif
+    {
+        /* sem_timedwait() only knows CLOCK_REALTIME, sem_clockwait() no PTP clock: the remaining time is converted
+           once, a step of the system time during the wait still shortens or extends it */
+        VOS_TIMEVAL_T remaining = *pDeadline;
+        VOS_TIMEVAL_T now;
 
-        /* add offset */
-        if (timeout >= (USECS_PER_MSEC * MSECS_PER_SEC))
+        vos_getTime(&now);
+        if (vos_cmpTime(&remaining, &now) > 0)
         {
-            /* Timeout longer than 1 sec, add sec and nsec seperately */
-            waitTimeSpec.tv_sec     += timeout / (USECS_PER_MSEC * MSECS_PER_SEC);
-            waitTimeSpec.tv_nsec    += (timeout % (USECS_PER_MSEC * MSECS_PER_SEC)) * NSECS_PER_USEC;
+            vos_subTime(&remaining, &now);
         }
         else
         {
-            /* Timeout shorter than 1 sec, only add nsecs */
-            waitTimeSpec.tv_nsec += timeout * NSECS_PER_USEC;
+            timerclear(&remaining);
         }
-        /* Carry if tv_nsec > 1.000.000.000 */
-        if (waitTimeSpec.tv_nsec >= (long) (NSECS_PER_USEC * USECS_PER_MSEC * MSECS_PER_SEC))
+        (void) clock_gettime(VOS_SEM_WAIT_CLOCK, &waitTimeSpec);
+        waitTimeSpec.tv_sec     += remaining.tv_sec;
+        waitTimeSpec.tv_nsec    += (long) remaining.tv_usec * (long) NSECS_PER_USEC;
+        if (waitTimeSpec.tv_nsec >= NSECS_PER_SEC)
         {
             waitTimeSpec.tv_sec++;
-            waitTimeSpec.tv_nsec -= (long) (NSECS_PER_USEC * USECS_PER_MSEC * MSECS_PER_SEC);
-        }
-        else
-        {
-            /* carry not necessary */
+            waitTimeSpec.tv_nsec -= NSECS_PER_SEC;
         }
-        /* take semaphore with specified timeout */
-        /* BL 2013-05-06:
-           This call will fail under LINUX, because it depends on CLOCK_REALTIME (opposed to CLOCK_MONOTONIC)!
-        */
-#ifdef __QNXNTO__
+    }
+
+    do
+    {
+#if VOS_SEM_CLOCKWAIT
+        rc = sem_clockwait((sem_t *)sema, CLOCK_MONOTONIC, &waitTimeSpec);
+#elif defined(__QNXNTO__)
         rc = sem_timedwait_monotonic((sem_t *)sema, &waitTimeSpec);
 #else
-        /* BL 2013-11-28:
-           Currently, under Linux, there is no semaphore call which will work with CLOCK_MONOTONIC; the semaphore
-           will fail if the clock was changed by the system (NTP, adjtime etc.).
-           See also http://sourceware.org/bugzilla/show_bug.cgi?id=14717
-        */
         rc = sem_timedwait((sem_t *)sema, &waitTimeSpec);
 #endif
     }
-    if (0 != rc)
-    {
-        /* Could not take Semaphore in time */
-        retVal = VOS_SEMA_ERR;
-    }
-    else
-    {
-        /* Semaphore take success */
-        retVal = VOS_NO_ERR;
-    }
-    return retVal;
+    while ((rc != 0) && (errno == EINTR));
+
+    return (rc == 0) ? VOS_NO_ERR : VOS_SEMA_ERR;
 }
 
 
@@ -0,0 +1,120 @@
+/**********************************************************************************************************************/
+/**
+ * @file            sim/vos_sim.h
+ *
+ * @brief           Control of the simulated network of the in-memory socket backend
+ *
+ * @details         With VOS_SIM the socket functions of the VOS do not use the OS network stack: datagrams and TCP
+ *                  streams are handed between the sockets of this process in memory. Every virtual device is a
+ *                  session with its own IP address; a link model delays, drops and throttles the traffic
+ *                  deterministically (seeded generator), so PD/MD processing can be load tested and profiled without
+ *                  a network.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef VOS_SIM_H
+#define VOS_SIM_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "vos_types.h"
+#include "vos_sock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef VOS_SIM_MAX_IF              /**< The maximum number of virtual interfaces reported by vos_getInterfaces() */
+#define VOS_SIM_MAX_IF  VOS_MAX_NUM_IF
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Link model, applied to every datagram and TCP segment sent  */
+typedef struct
+{
+    UINT32  latency;        /**< one way delay in us                                            */
+    UINT32  jitter;         /**< additional random delay of 0...jitter us (may reorder datagrams) */
+    UINT32  lossPpm;        /**< datagrams lost per million (UDP only)                          */
+    UINT32  bandwidth;      /**< transmit rate of each socket in bit/s, 0: unlimited                    */
+    UINT32  seed;           /**< seed of the loss and jitter generator, 0: 1                    */
+} VOS_SIM_CONFIG_T;
+
+/** Counters of the simulated network  */
+typedef struct
+{
+    UINT32  sent;           /**< datagrams sent                                                 */
+    UINT32  lost;           /**< datagrams dropped by the link model                            */
+    UINT32  delivered;      /**< copies queued to receiving sockets                             */
+    UINT32  dropped;        /**< datagrams dropped on full send or receive buffers              */
+    UINT32  unreachable;    /**< datagrams without any receiving socket                         */
+    UINT32  tcpBytes;       /**< bytes sent over TCP connections                                */
+    UINT32  openSockets;    /**< sockets currently open                                         */
+} VOS_SIM_STATS_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/** Set the link model of the simulated network.
+ *  Can be changed at any time, it applies to the data sent afterwards. The generator is reseeded.
+ *
+ *  @param[in]      pConfig         link model, NULL for an ideal network (no delay, loss or rate limit)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ */
+
+EXT_DECL VOS_ERR_T vos_simConfig (
+    const VOS_SIM_CONFIG_T *pConfig);
+
+/**********************************************************************************************************************/
+/** Add a virtual interface, reported by vos_getInterfaces().
+ *  The interface 'sim0' with 127.0.0.1 always exists. Sessions may use any address, this is only needed by code
+ *  looking up its interfaces (e.g. the DNR).
+ *
+ *  @param[in]      ipAddr          IP address of the interface
+ *  @param[in]      netMask         subnet mask
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_MEM_ERR     too many interfaces (VOS_SIM_MAX_IF)
+ */
+
+EXT_DECL VOS_ERR_T vos_simAddInterface (
+    VOS_IP4_ADDR_T  ipAddr,
+    VOS_IP4_ADDR_T  netMask);
+
+/**********************************************************************************************************************/
+/** Read the counters of the simulated network.
+ *
+ *  @param[out]     pStats          counters
+ *  @param[in]      reset           clear the counters (except openSockets) after reading
+ */
+
+EXT_DECL void vos_simGetStatistics (
+    VOS_SIM_STATS_T *pStats,
+    BOOL8           reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOS_SIM_H */
@@ -0,0 +1,2994 @@
+/**********************************************************************************************************************/
+/**
+ * @file            sim/vos_sock.c
+ *
+ * @brief           Socket functions of the simulated network
+ *
+ * @details         In-memory implementation of the VOS socket API for load tests and profiling without a network.
+ *                  Sockets are entries of a process wide table, their descriptors are small numbers usable with
+ *                  fd_set (at most FD_SETSIZE). A datagram sent is copied to the receive queue of every matching
+ *                  socket:
+ *                  - unicast: the sockets bound to the destination address and port, else those bound to any
+ *                    address; of several sockets sharing address and port (reuse) one gets it (steering or source
+ *                    hash), as on Linux
+ *                  - multicast: every socket bound to the port (any or group address) that joined the group
+ *                  A socket bound to any address takes the interface of its first vos_sockJoinMC() or
+ *                  vos_sockSetMulticastIf() as its own address; thus many virtual devices share one process.
+ *                  TCP connections are pairs of sockets exchanging byte streams. The link model of vos_simConfig()
+ *                  sets the time a datagram or segment becomes readable.
+ *                  Only simulated sockets can be waited for with vos_select() and poll sets; the poll sets have no
+ *                  descriptor of their own. AF_XDP is not available.
+ *                  Threads, memory and shared memory are taken from the POSIX VOS.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef POSIX
+#error \
+    "You are trying to compile the simulated vos_sock.c - it needs the POSIX VOS, define POSIX!"
+#endif
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#define VOS_SOCK_BYTE_ORDER_FUNCTIONS   /* vos_htonl() etc. are implemented here, see vos_sock.h */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+
+#include "vos_utils.h"
+#include "vos_sock.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+#include "vos_private.h"
+#include "vos_sim.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+const CHAR8 *cDefaultIface = "sim0";
+
+#define VOS_SIM_SOCK_BASE       3           /**< first descriptor, keeps clear of stdin/out/err         */
+#ifndef VOS_SIM_MAX_SOCKETS
+#define VOS_SIM_MAX_SOCKETS     (FD_SETSIZE - VOS_SIM_SOCK_BASE)    /**< simulated sockets of the process */
+#endif
+#define VOS_SIM_HASH_SIZE       1024u       /**< buckets of the address/port index, power of 2          */
+#define VOS_SIM_EPHEMERAL       49152u      /**< first port assigned to unbound sockets                 */
+#define VOS_SIM_MAX_REUSE       64u         /**< max. sockets sharing address and port                  */
+#define VOS_SIM_LOOPBACK        0x7F000001u
+#ifndef VOS_SIM_TX_BACKLOG
+#define VOS_SIM_TX_BACKLOG      (1024u * 1024u)         /**< bytes a rate limited UDP socket may queue (qdisc) */
+#endif
+#ifndef VOS_SIM_TCP_WINDOW
+#define VOS_SIM_TCP_WINDOW      (4u * 1024u * 1024u)    /**< unread bytes of a TCP stream, as autotuned by Linux */
+#endif
+
+#define SIM_IDX(sock)           ((INT32) (sock) - VOS_SIM_SOCK_BASE)
+#define SIM_SOCK(idx)           ((SOCKET) ((idx) + VOS_SIM_SOCK_BASE))
+
+/** Datagram or TCP segment in a receive queue */
+typedef struct SIM_BUF
+{
+    struct SIM_BUF  *pNext;
+    VOS_TIMEVAL_T   deliverAt;              /**< readable from this time on                     */
+    UINT32          srcIP;
+    UINT16          srcPort;
+    UINT32          dstIP;
+    UINT32          size;
+    UINT32          offset;                 /**< TCP: bytes already read                        */
+    UINT8           data[1];
+} SIM_BUF_T;
+
+/** Multicast membership, source 0 for any source */
+typedef struct
+{
+    UINT32  group;
+    UINT32  source;
+} SIM_MC_T;
+
+/** Simulated socket */
+typedef struct
+{
+    BOOL8               inUse;
+    BOOL8               tcp;
+    BOOL8               listening;
+    BOOL8               connected;
+    BOOL8               peerClosed;         /**< TCP: the peer closed, reads return end of stream   */
+    BOOL8               hashed;             /**< in the address/port index                      */
+    BOOL8               mcListed;           /**< in the multicast list of its port              */
+    VOS_SOCK_OPT_T      options;
+    UINT32              bindIP;
+    UINT16              bindPort;
+    UINT32              hostIP;             /**< address unicasts are received on, 0: any       */
+    UINT32              mcIf;
+    SIM_MC_T            *pMc;
+    UINT32              noOfMc;
+    UINT32              maxMc;
+    SIM_BUF_T           *pHead;
+    SIM_BUF_T           *pTail;
+    UINT32              queued;             /**< bytes in the receive queue, TCP: the window in use */
+    UINT32              arrived;            /**< UDP: bytes of the queue before pFlight         */
+    SIM_BUF_T           *pFlight;           /**< UDP: first datagram still on the wire          */
+    UINT32              bufSize;
+    UINT32              drops;
+    VOS_TIMEVAL_T       txBusy;             /**< the link of the socket is busy sending until   */
+    INT32               hashNext;
+    INT32               mcNext;
+    INT32               peer;               /**< TCP: socket at the other end, -1 if none       */
+    INT32               pendingHead;        /**< TCP listener: connections not yet accepted     */
+    INT32               pendingNext;
+    UINT32              peerIP;
+    UINT16              peerPort;
+    VOS_SOCK_FILTER_T   filter;
+    BOOL8               hasFilter;
+    UINT16              steerOffset;
+    UINT32              steerSocks;         /**< steer by key if > 0                            */
+} SIM_SOCK_T;
+
+/** Poll set: a tag per socket */
+struct VOS_POLL
+{
+    struct VOS_POLL *pNext;
+    BOOL8           member[VOS_SIM_MAX_SOCKETS];
+    UINT32          tag[VOS_SIM_MAX_SOCKETS];
+};
+
+/***********************************************************************************************************************
+ *  LOCALS
+ */
+
+static pthread_mutex_t  sSimMutex       = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   sSimCond;
+static BOOL8            sSimCondInit    = FALSE;
+static SIM_SOCK_T       sSock[VOS_SIM_MAX_SOCKETS];
+static INT32            sUcHash[VOS_SIM_HASH_SIZE];
+static INT32            sMcHash[VOS_SIM_HASH_SIZE];
+static INT32            sNextFree       = 0;
+static UINT16           sNextPort       = VOS_SIM_EPHEMERAL;
+static VOS_SIM_CONFIG_T sConfig;
+static UINT32           sRandom         = 1u;
+static VOS_SIM_STATS_T  sStats;
+static struct VOS_POLL  *sPollSets      = NULL;
+static VOS_IF_REC_T     sIf[VOS_SIM_MAX_IF] = {{"sim0", VOS_SIM_LOOPBACK, 0xFF000000u, {2u, 0u, 0u, 0u, 0u, 1u}, TRUE}};
+static UINT32           sNoOfIf         = 1u;
+
+BOOL8                   vosSockInitialised = FALSE;
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/** Deterministic generator for loss and jitter (xorshift32) */
+static UINT32 simRandom (void)
+{
+    sRandom ^= sRandom << 13;
+    sRandom ^= sRandom >> 17;
+    sRandom ^= sRandom << 5;
+    return sRandom;
+}
+
+static UINT32 simUcKey (
+    UINT32  ip,
+    UINT16  port)
+{
+    return ((ip * 2654435761u) ^ port) & (VOS_SIM_HASH_SIZE - 1u);
+}
+
+static UINT32 simMcKey (
+    UINT16 port)
+{
+    return ((UINT32) port * 2654435761u >> 16) & (VOS_SIM_HASH_SIZE - 1u);
+}
+
+/** Socket of a descriptor, NULL if it is not an open simulated socket */
+static SIM_SOCK_T *simGet (
+    SOCKET sock)
+{
+    INT32 idx = SIM_IDX(sock);
+
+    if ((idx < 0) || (idx >= (INT32) VOS_SIM_MAX_SOCKETS) || !sSock[idx].inUse)
+    {
+        return NULL;
+    }
+    return &sSock[idx];
+}
+
+static void simUnlink (
+    INT32   *pHead,
+    INT32   idx,
+    BOOL8   mcList)
+{
+    INT32 *pLink = pHead;
+
+    while (*pLink != -1)
+    {
+        if (*pLink == idx)
+        {
+            *pLink = mcList ? sSock[idx].mcNext : sSock[idx].hashNext;
+            return;
+        }
+        pLink = mcList ? &sSock[*pLink].mcNext : &sSock[*pLink].hashNext;
+    }
+}
+
+/** Append to a chain, keeping the bind order (steering counts the sockets in that order) */
+static void simAppend (
+    INT32   *pHead,
+    INT32   idx,
+    BOOL8   mcList)
+{
+    INT32 *pLink = pHead;
+
+    while (*pLink != -1)
+    {
+        pLink = mcList ? &sSock[*pLink].mcNext : &sSock[*pLink].hashNext;
+    }
+    *pLink = idx;
+    if (mcList)
+    {
+        sSock[idx].mcNext = -1;
+    }
+    else
+    {
+        sSock[idx].hashNext = -1;
+    }
+}
+
+/** (Re-)insert a socket into the indices after its address, port or memberships changed */
+static void simRehash (
+    INT32 idx)
+{
+    SIM_SOCK_T *pSock = &sSock[idx];
+
+    if (pSock->hashed)
+    {
+        simUnlink(&sUcHash[simUcKey(pSock->hostIP, pSock->bindPort)], idx, FALSE);
+        pSock->hashed = FALSE;
+    }
+    if (pSock->mcListed)
+    {
+        simUnlink(&sMcHash[simMcKey(pSock->bindPort)], idx, TRUE);
+        pSock->mcListed = FALSE;
+    }
+    if (!pSock->inUse || (pSock->bindPort == 0u))
+    {
+        return;
+    }
+    if (pSock->bindIP != 0u)
+    {
+        pSock->hostIP = pSock->bindIP;
+    }
+    else if (pSock->mcIf != 0u)
+    {
+        pSock->hostIP = pSock->mcIf;
+    }
+    if (!vos_isMulticast(pSock->hostIP))
+    {
+        simAppend(&sUcHash[simUcKey(pSock->hostIP, pSock->bindPort)], idx, FALSE);
+        pSock->hashed = TRUE;
+    }
+    if (!pSock->tcp && (pSock->noOfMc > 0u))
+    {
+        simAppend(&sMcHash[simMcKey(pSock->bindPort)], idx, TRUE);
+        pSock->mcListed = TRUE;
+    }
+}
+
+/** Next free port for an unbound socket */
+static UINT16 simEphemeralPort (
+    BOOL8 tcp)
+{
+    UINT32 tries;
+
+    for (tries = 0u; tries < 65536u - VOS_SIM_EPHEMERAL; tries++)
+    {
+        UINT16  port    = sNextPort;
+        INT32   idx;
+        BOOL8   used    = FALSE;
+
+        sNextPort = (sNextPort == 65535u) ? VOS_SIM_EPHEMERAL : (UINT16) (sNextPort + 1u);
+        for (idx = 0; idx < (INT32) VOS_SIM_MAX_SOCKETS; idx++)
+        {
+            if (sSock[idx].inUse && (sSock[idx].bindPort == port) && (sSock[idx].tcp == tcp))
+            {
+                used = TRUE;
+                break;
+            }
+        }
+        if (!used)
+        {
+            return port;
+        }
+    }
+    return 0u;
+}
+
+/** Source address of data sent by a socket */
+static UINT32 simSourceIP (
+    const SIM_SOCK_T *pSock)
+{
+    if ((pSock->hostIP != 0u) && !vos_isMulticast(pSock->hostIP))
+    {
+        return pSock->hostIP;
+    }
+    return (pSock->mcIf != 0u) ? pSock->mcIf : VOS_SIM_LOOPBACK;
+}
+
+/** Time the data of a socket becomes readable at the other end, advances the busy time of its link */
+static void simDeliveryTime (
+    SIM_SOCK_T          *pSock,
+    UINT32              size,
+    const VOS_TIMEVAL_T *pLaunchTime,
+    VOS_TIMEVAL_T       *pDeliverAt)
+{
+    VOS_TIMEVAL_T   start;
+    VOS_TIMEVAL_T   delay;
+    UINT32          us = 0u;
+
+    vos_getTime(&start);
+    if ((pLaunchTime != NULL) && (vos_cmpTime(pLaunchTime, &start) > 0))
+    {
+        start = *pLaunchTime;
+    }
+    if (vos_cmpTime(&pSock->txBusy, &start) > 0)
+    {
+        start = pSock->txBusy;
+    }
+    if (sConfig.bandwidth != 0u)
+    {
+        us = (UINT32) (((UINT64) size * 8u * 1000000u) / sConfig.bandwidth);
+    }
+    delay.tv_sec    = us / 1000000u;
+    delay.tv_usec   = us % 1000000u;
+    vos_addTime(&start, &delay);
+    pSock->txBusy = start;
+
+    us = sConfig.latency + ((sConfig.jitter != 0u) ? simRandom() % (sConfig.jitter + 1u) : 0u);
+    delay.tv_sec    = us / 1000000u;
+    delay.tv_usec   = us % 1000000u;
+    *pDeliverAt     = start;
+    vos_addTime(pDeliverAt, &delay);
+}
+
+/** Is the send buffer of a rate limited socket full? Then the datagram is dropped, as by a full qdisc. */
+static BOOL8 simTxFull (
+    SIM_SOCK_T          *pSock,
+    const VOS_TIMEVAL_T *pLaunchTime)
+{
+    VOS_TIMEVAL_T   limit;
+    VOS_TIMEVAL_T   backlog;
+    UINT32          us;
+
+    if (sConfig.bandwidth == 0u)
+    {
+        return FALSE;
+    }
+    vos_getTime(&limit);
+    if ((pLaunchTime != NULL) && (vos_cmpTime(pLaunchTime, &limit) > 0))
+    {
+        limit = *pLaunchTime;
+    }
+    us = (UINT32) (((UINT64) VOS_SIM_TX_BACKLOG * 8u * 1000000u) / sConfig.bandwidth);
+    backlog.tv_sec  = us / 1000000u;
+    backlog.tv_usec = us % 1000000u;
+    vos_addTime(&limit, &backlog);
+    if (vos_cmpTime(&pSock->txBusy, &limit) > 0)
+    {
+        sStats.sent++;
+        sStats.dropped++;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/** Does the receive filter of a socket pass a datagram? */
+static BOOL8 simFilterPass (
+    const SIM_SOCK_T    *pSock,
+    const UINT8         *pData,
+    UINT32              size,
+    UINT32              srcIP)
+{
+    const VOS_SOCK_FILTER_T *pFilter = &pSock->filter;
+    UINT16  type;
+    UINT32  key;
+    UINT32  i;
+
+    if (!pSock->hasFilter || (size < (UINT32) pFilter->typeOffset + 2u))
+    {
+        return TRUE;
+    }
+    type = (UINT16) ((pData[pFilter->typeOffset] << 8) | pData[pFilter->typeOffset + 1u]);
+    for (i = 0u; i < pFilter->noOfTypes; i++)
+    {
+        if (pFilter->types[i] == type)
+        {
+            break;
+        }
+    }
+    if (i == pFilter->noOfTypes)
+    {
+        return TRUE;
+    }
+    if (size < (UINT32) pFilter->keyOffset + 4u)
+    {
+        return FALSE;
+    }
+    key = ((UINT32) pData[pFilter->keyOffset] << 24) | ((UINT32) pData[pFilter->keyOffset + 1u] << 16) |
+          ((UINT32) pData[pFilter->keyOffset + 2u] << 8) | pData[pFilter->keyOffset + 3u];
+    for (i = 0u; i < pFilter->noOfEntries; i++)
+    {
+        const VOS_SOCK_FILTER_ENTRY_T *pEntry = &pFilter->pEntries[i];
+
+        if ((pEntry->key == key) &&
+            ((pEntry->srcIpLo == 0u) ||
+             ((srcIP >= pEntry->srcIpLo) && (srcIP <= ((pEntry->srcIpHi != 0u) ? pEntry->srcIpHi : pEntry->srcIpLo)))))
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/** Count the datagrams that reached the socket by now. Datagrams on the wire do not take up the receive buffer. */
+static void simArrive (
+    SIM_SOCK_T          *pSock,
+    const VOS_TIMEVAL_T *pNow)
+{
+    while ((pSock->pFlight != NULL) && (vos_cmpTime(&pSock->pFlight->deliverAt, pNow) <= 0))
+    {
+        pSock->arrived  += pSock->pFlight->size;
+        pSock->pFlight  = pSock->pFlight->pNext;
+    }
+}
+
+/** Queue a copy of data at a socket, ordered by delivery time */
+static BOOL8 simEnqueue (
+    SIM_SOCK_T          *pSock,
+    const UINT8         *pData,
+    UINT32              size,
+    UINT32              srcIP,
+    UINT16              srcPort,
+    UINT32              dstIP,
+    const VOS_TIMEVAL_T *pDeliverAt)
+{
+    SIM_BUF_T       *pBuf;
+    VOS_TIMEVAL_T   now;
+
+    vos_getTime(&now);
+    simArrive(pSock, &now);
+    if ((pSock->tcp ? pSock->queued : pSock->arrived) + size > pSock->bufSize)
+    {
+        pSock->drops++;
+        sStats.dropped++;
+        return FALSE;
+    }
+    pBuf = (SIM_BUF_T *) vos_memAlloc(sizeof(SIM_BUF_T) + size);
+    if (pBuf == NULL)
+    {
+        pSock->drops++;
+        sStats.dropped++;
+        return FALSE;
+    }
+    memcpy(pBuf->data, pData, size);
+    pBuf->size      = size;
+    pBuf->srcIP     = srcIP;
+    pBuf->srcPort   = srcPort;
+    pBuf->dstIP     = dstIP;
+    pBuf->deliverAt = *pDeliverAt;
+    pSock->queued   += size;
+    sStats.delivered++;
+
+    if ((pSock->pTail == NULL) || (vos_cmpTime(&pSock->pTail->deliverAt, pDeliverAt) <= 0))
+    {
+        if (pSock->pTail == NULL)
+        {
+            pSock->pHead = pBuf;
+        }
+        else
+        {
+            pSock->pTail->pNext = pBuf;
+        }
+        pSock->pTail = pBuf;
+        if (pSock->pFlight == NULL)
+        {
+            pSock->pFlight = pBuf;
+        }
+    }
+    else
+    {
+        /* overtakes queued datagrams (jitter) */
+        SIM_BUF_T **ppLink = &pSock->pHead;
+
+        while (vos_cmpTime(&(*ppLink)->deliverAt, pDeliverAt) <= 0)
+        {
+            ppLink = &(*ppLink)->pNext;
+        }
+        if (*ppLink == pSock->pFlight)
+        {
+            pSock->pFlight = pBuf;
+        }
+        pBuf->pNext = *ppLink;
+        *ppLink     = pBuf;
+    }
+    return TRUE;
+}
+
+/** Hand a datagram to the receiving sockets */
+static void simDeliverUDP (
+    const SIM_SOCK_T    *pSender,
+    const UINT8         *pData,
+    UINT32              size,
+    UINT32              dstIP,
+    UINT16              dstPort,
+    const VOS_TIMEVAL_T *pDeliverAt)
+{
+    UINT32  srcIP       = simSourceIP(pSender);
+    UINT32  received    = 0u;
+    INT32   idx;
+
+    sStats.sent++;
+    if ((sConfig.lossPpm != 0u) && ((simRandom() % 1000000u) < sConfig.lossPpm))
+    {
+        sStats.lost++;
+        return;
+    }
+
+    if (vos_isMulticast(dstIP))
+    {
+        for (idx = sMcHash[simMcKey(dstPort)]; idx != -1; idx = sSock[idx].mcNext)
+        {
+            SIM_SOCK_T  *pSock = &sSock[idx];
+            UINT32      i;
+
+            if ((pSock->bindPort != dstPort) || ((pSock->bindIP != 0u) && (pSock->bindIP != dstIP)) ||
+                (pSender->options.no_mc_loop && (pSock->hostIP == srcIP)))
+            {
+                continue;
+            }
+            for (i = 0u; i < pSock->noOfMc; i++)
+            {
+                if ((pSock->pMc[i].group == dstIP) && ((pSock->pMc[i].source == 0u) || (pSock->pMc[i].source == srcIP)))
+                {
+                    if (simFilterPass(pSock, pData, size, srcIP))
+                    {
+                        (void) simEnqueue(pSock, pData, size, srcIP, pSender->bindPort, dstIP, pDeliverAt);
+                    }
+                    received++;
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        INT32   group[VOS_SIM_MAX_REUSE];
+        UINT32  noOfGroup   = 0u;
+        UINT32  pass;
+
+        /* the sockets bound to the address take it, else those bound to any address */
+        for (pass = 0u; (pass < 2u) && (noOfGroup == 0u); pass++)
+        {
+            UINT32 hostIP = (pass == 0u) ? dstIP : 0u;
+
+            for (idx = sUcHash[simUcKey(hostIP, dstPort)]; idx != -1; idx = sSock[idx].hashNext)
+            {
+                if (!sSock[idx].tcp && (sSock[idx].hostIP == hostIP) && (sSock[idx].bindPort == dstPort) &&
+                    (noOfGroup < VOS_SIM_MAX_REUSE))
+                {
+                    group[noOfGroup++] = idx;
+                }
+            }
+        }
+        if (noOfGroup > 0u)
+        {
+            SIM_SOCK_T  *pSock  = &sSock[group[0]];
+            UINT32      pick    = 0u;
+
+            if (noOfGroup > 1u)
+            {
+                if ((pSock->steerSocks != 0u) && (size >= (UINT32) pSock->steerOffset + 4u))
+                {
+                    const UINT8 *pKey = pData + pSock->steerOffset;
+
+                    pick = ((((UINT32) pKey[0] << 24) | ((UINT32) pKey[1] << 16) | ((UINT32) pKey[2] << 8) | pKey[3])
+                            % pSock->steerSocks) % noOfGroup;
+                }
+                else
+                {
+                    pick = ((srcIP * 2654435761u) ^ pSender->bindPort) % noOfGroup;
+                }
+                pSock = &sSock[group[pick]];
+            }
+            if (simFilterPass(pSock, pData, size, srcIP))
+            {
+                (void) simEnqueue(pSock, pData, size, srcIP, pSender->bindPort, dstIP, pDeliverAt);
+            }
+            received++;
+        }
+    }
+    if (received == 0u)
+    {
+        sStats.unreachable++;
+    }
+    else
+    {
+        (void) pthread_cond_broadcast(&sSimCond);
+    }
+}
+
+/** Can a socket be read without blocking? Else the time it will be, if known */
+static BOOL8 simReadable (
+    const SIM_SOCK_T    *pSock,
+    const VOS_TIMEVAL_T *pNow,
+    VOS_TIMEVAL_T       *pNext)
+{
+    if (pSock->listening)
+    {
+        return pSock->pendingHead != -1;
+    }
+    if (pSock->pHead != NULL)
+    {
+        if (vos_cmpTime(&pSock->pHead->deliverAt, pNow) <= 0)
+        {
+            return TRUE;
+        }
+        if ((pNext != NULL) && (!timerisset(pNext) || (vos_cmpTime(&pSock->pHead->deliverAt, pNext) < 0)))
+        {
+            *pNext = pSock->pHead->deliverAt;
+        }
+        return FALSE;
+    }
+    return pSock->tcp && pSock->peerClosed;
+}
+
+/** Wait for new data or until a time, NULL: until new data. Called with the mutex held.
+ *  @retval         FALSE       the time has passed
+ */
+static BOOL8 simWait (
+    const VOS_TIMEVAL_T *pUntil)
+{
+    struct timespec abstime;
+    VOS_TIMEVAL_T   now;
+
+    if (pUntil == NULL)
+    {
+        (void) pthread_cond_wait(&sSimCond, &sSimMutex);
+        return TRUE;
+    }
+    vos_getTime(&now);
+    if (vos_cmpTime(pUntil, &now) <= 0)
+    {
+        return FALSE;
+    }
+    abstime.tv_sec  = pUntil->tv_sec;
+    abstime.tv_nsec = (long) pUntil->tv_usec * 1000;
+    (void) pthread_cond_timedwait(&sSimCond, &sSimMutex, &abstime);
+    return TRUE;
+}
+
+/** Remove the head of the receive queue */
+static void simDequeue (
+    SIM_SOCK_T *pSock)
+{
+    SIM_BUF_T *pBuf = pSock->pHead;
+
+    pSock->pHead = pBuf->pNext;
+    if (pSock->pHead == NULL)
+    {
+        pSock->pTail = NULL;
+    }
+    pSock->queued -= pBuf->size;
+    if (pBuf == pSock->pFlight)
+    {
+        pSock->pFlight = pBuf->pNext;
+    }
+    else
+    {
+        pSock->arrived -= pBuf->size;
+    }
+    vos_memFree(pBuf);
+}
+
+/** Release a socket. Called with the mutex held. */
+static void simRelease (
+    INT32 idx)
+{
+    SIM_SOCK_T      *pSock = &sSock[idx];
+    struct VOS_POLL *pPoll;
+
+    while (pSock->pHead != NULL)
+    {
+        simDequeue(pSock);
+    }
+    pSock->inUse = FALSE;
+    simRehash(idx);
+    if (pSock->tcp)
+    {
+        if (pSock->peer != -1)
+        {
+            sSock[pSock->peer].peerClosed   = TRUE;
+            sSock[pSock->peer].peer         = -1;
+        }
+        /* connections never accepted */
+        while (pSock->pendingHead != -1)
+        {
+            INT32 pending = pSock->pendingHead;
+
+            pSock->pendingHead          = sSock[pending].pendingNext;
+            sSock[pending].pendingHead  = -1;
+            simRelease(pending);
+        }
+    }
+    for (pPoll = sPollSets; pPoll != NULL; pPoll = pPoll->pNext)
+    {
+        pPoll->member[idx] = FALSE;
+    }
+    if (pSock->pMc != NULL)
+    {
+        vos_memFree(pSock->pMc);
+    }
+    if (pSock->filter.pEntries != NULL)
+    {
+        vos_memFree((void *) pSock->filter.pEntries);
+    }
+    memset(pSock, 0, sizeof(SIM_SOCK_T));
+    sStats.openSockets--;
+    (void) pthread_cond_broadcast(&sSimCond);
+}
+
+/** Allocate a socket. Called with the mutex held.
+ *  @retval         -1          table full
+ */
+static INT32 simAlloc (
+    BOOL8                   tcp,
+    const VOS_SOCK_OPT_T    *pOptions)
+{
+    INT32 i;
+
+    for (i = 0; i < (INT32) VOS_SIM_MAX_SOCKETS; i++)
+    {
+        INT32 idx = (sNextFree + i) % (INT32) VOS_SIM_MAX_SOCKETS;
+
+        if (!sSock[idx].inUse)
+        {
+            SIM_SOCK_T *pSock = &sSock[idx];
+
+            memset(pSock, 0, sizeof(SIM_SOCK_T));
+            pSock->inUse        = TRUE;
+            pSock->tcp          = tcp;
+            pSock->bufSize      = tcp ? VOS_SIM_TCP_WINDOW : TRDP_SOCKBUF_SIZE;
+            pSock->hashNext     = -1;
+            pSock->mcNext       = -1;
+            pSock->peer         = -1;
+            pSock->pendingHead  = -1;
+            pSock->pendingNext  = -1;
+            if (pOptions != NULL)
+            {
+                pSock->options = *pOptions;
+            }
+            sNextFree = (idx + 1) % (INT32) VOS_SIM_MAX_SOCKETS;
+            sStats.openSockets++;
+            return idx;
+        }
+    }
+    vos_printLog(VOS_LOG_ERROR, "no free simulated socket (max. %d)\n", (int) VOS_SIM_MAX_SOCKETS);
+    return -1;
+}
+
+/** Give an unbound socket an ephemeral port. Called with the mutex held. */
+static void simAutoBind (
+    SIM_SOCK_T *pSock)
+{
+    if (pSock->bindPort == 0u)
+    {
+        pSock->bindPort = simEphemeralPort(pSock->tcp);
+        simRehash((INT32) (pSock - sSock));
+    }
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Set the link model of the simulated network.
+ *
+ *  @param[in]      pConfig         link model, NULL for an ideal network (no delay, loss or rate limit)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ */
+
+EXT_DECL VOS_ERR_T vos_simConfig (
+    const VOS_SIM_CONFIG_T *pConfig)
+{
+    (void) pthread_mutex_lock(&sSimMutex);
+    if (pConfig == NULL)
+    {
+        memset(&sConfig, 0, sizeof(sConfig));
+    }
+    else
+    {
+        sConfig = *pConfig;
+    }
+    sRandom = (sConfig.seed != 0u) ? sConfig.seed : 1u;
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Add a virtual interface, reported by vos_getInterfaces().
+ *
+ *  @param[in]      ipAddr          IP address of the interface
+ *  @param[in]      netMask         subnet mask
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_MEM_ERR     too many interfaces (VOS_SIM_MAX_IF)
+ */
+
+EXT_DECL VOS_ERR_T vos_simAddInterface (
+    VOS_IP4_ADDR_T  ipAddr,
+    VOS_IP4_ADDR_T  netMask)
+{
+    VOS_ERR_T err = VOS_MEM_ERR;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    if (sNoOfIf < VOS_SIM_MAX_IF)
+    {
+        VOS_IF_REC_T *pIf = &sIf[sNoOfIf];
+
+        (void) snprintf(pIf->name, sizeof(pIf->name), "sim%u", (unsigned int) sNoOfIf);
+        pIf->ipAddr     = ipAddr;
+        pIf->netMask    = netMask;
+        pIf->mac[0]     = 2u;   /* locally administered */
+        pIf->mac[2]     = (UINT8) (ipAddr >> 24);
+        pIf->mac[3]     = (UINT8) (ipAddr >> 16);
+        pIf->mac[4]     = (UINT8) (ipAddr >> 8);
+        pIf->mac[5]     = (UINT8) ipAddr;
+        pIf->linkState  = TRUE;
+        sNoOfIf++;
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Read the counters of the simulated network.
+ *
+ *  @param[out]     pStats          counters
+ *  @param[in]      reset           clear the counters (except openSockets) after reading
+ */
+
+EXT_DECL void vos_simGetStatistics (
+    VOS_SIM_STATS_T *pStats,
+    BOOL8           reset)
+{
+    (void) pthread_mutex_lock(&sSimMutex);
+    if (pStats != NULL)
+    {
+        *pStats = sStats;
+    }
+    if (reset)
+    {
+        UINT32 openSockets = sStats.openSockets;
+
+        memset(&sStats, 0, sizeof(sStats));
+        sStats.openSockets = openSockets;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+}
+
+/**********************************************************************************************************************/
+/** Byte swapping.
+ *
+ *  @param[in]          val             Initial value.
+ *
+ *  @retval             swapped value
+ */
+
+EXT_DECL UINT16 vos_htons (
+    UINT16 val)
+{
+    return htons(val);
+}
+
+EXT_DECL UINT16 vos_ntohs (
+    UINT16 val)
+{
+    return ntohs(val);
+}
+
+EXT_DECL UINT32 vos_htonl (
+    UINT32 val)
+{
+    return htonl(val);
+}
+
+EXT_DECL UINT32 vos_ntohl (
+    UINT32 val)
+{
+    return ntohl(val);
+}
+
+EXT_DECL UINT64 vos_htonll (
+    UINT64 val)
+{
+#ifdef L_ENDIAN
+    return ((UINT64) htonl((UINT32) val) << 32) | htonl((UINT32) (val >> 32));
+#else
+    return val;
+#endif
+}
+
+EXT_DECL UINT64 vos_ntohll (
+    UINT64 val)
+{
+    return vos_htonll(val);
+}
+
+/**********************************************************************************************************************/
+/** Convert IP address from dotted dec. to !host! endianess
+ *
+ *  @param[in]          pDottedIP     IP address as dotted decimal.
+ *
+ *  @retval             address in UINT32 in host endianess
+ *                      0 (Zero) if error
+ */
+EXT_DECL UINT32 vos_dottedIP (
+    const CHAR8 *pDottedIP)
+{
+    struct in_addr addr;
+
+    if (inet_aton(pDottedIP, &addr) <= 0)
+    {
+        return VOS_INADDR_ANY;          /* Prevent returning broadcast address on error */
+    }
+    return vos_ntohl(addr.s_addr);
+}
+
+/**********************************************************************************************************************/
+/** Convert IP address to dotted dec. from !host! endianess.
+ *
+ *  @param[in]          ipAddress   address in UINT32 in host endianess
+ *
+ *  @retval             IP address as dotted decimal.
+ */
+
+EXT_DECL const CHAR8 *vos_ipDotted (
+    UINT32 ipAddress)
+{
+    static CHAR8 dotted[16];
+
+    (void)snprintf(dotted, sizeof(dotted), "%u.%u.%u.%u",
+                   (unsigned int)(ipAddress >> 24),
+                   (unsigned int)((ipAddress >> 16) & 0xFF),
+                   (unsigned int)((ipAddress >> 8) & 0xFF),
+                   (unsigned int)(ipAddress & 0xFF));
+
+    return dotted;
+}
+
+/**********************************************************************************************************************/
+/** Check if the supplied address is a multicast group address.
+ *
+ *  @param[in]          ipAddress   IP address to check.
+ *
+ *  @retval             TRUE        address is multicast
+ *  @retval             FALSE       address is not a multicast address
+ */
+
+EXT_DECL BOOL8 vos_isMulticast (
+    UINT32 ipAddress)
+{
+    return IN_MULTICAST(ipAddress);
+}
+
+/**********************************************************************************************************************/
+/** select function.
+ *  Only simulated sockets are reported, other descriptors are removed from the sets. Simulated sockets are always
+ *  writeable and never in error.
+ *
+ *  @param[in]      highDesc          max. socket descriptor + 1
+ *  @param[in,out]  pReadableFD       pointer to readable socket set
+ *  @param[in,out]  pWriteableFD      pointer to writeable socket set
+ *  @param[in,out]  pErrorFD          pointer to error socket set
+ *  @param[in]      pTimeOut          pointer to time out value
+ *
+ *  @retval         number of ready file descriptors
+ */
+
+EXT_DECL INT32 vos_select (
+    SOCKET          highDesc,
+    VOS_FDS_T       *pReadableFD,
+    VOS_FDS_T       *pWriteableFD,
+    VOS_FDS_T       *pErrorFD,
+    VOS_TIMEVAL_T   *pTimeOut)
+{
+    VOS_FDS_T       rIn;
+    VOS_TIMEVAL_T   deadline;
+    INT32           count = 0;
+    SOCKET          sock;
+
+    if (highDesc > FD_SETSIZE)
+    {
+        highDesc = FD_SETSIZE;
+    }
+    if (pReadableFD != NULL)
+    {
+        rIn = *pReadableFD;
+        FD_ZERO(pReadableFD);
+    }
+    else
+    {
+        FD_ZERO(&rIn);
+    }
+    if (pTimeOut != NULL)
+    {
+        vos_getTime(&deadline);
+        vos_addTime(&deadline, pTimeOut);
+    }
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    for (;; )
+    {
+        VOS_TIMEVAL_T   now;
+        VOS_TIMEVAL_T   next;
+
+        vos_getTime(&now);
+        timerclear(&next);
+        for (sock = 0; sock < highDesc; sock++)
+        {
+            SIM_SOCK_T *pSock;
+
+            if (FD_ISSET(sock, &rIn) && ((pSock = simGet(sock)) != NULL) && simReadable(pSock, &now, &next))
+            {
+                FD_SET(sock, pReadableFD);
+                count++;
+            }
+        }
+        if (pWriteableFD != NULL)
+        {
+            for (sock = 0; sock < highDesc; sock++)
+            {
+                if (FD_ISSET(sock, pWriteableFD))
+                {
+                    if (simGet(sock) != NULL)
+                    {
+                        count++;
+                    }
+                    else
+                    {
+                        FD_CLR(sock, pWriteableFD);
+                    }
+                }
+            }
+        }
+        if ((count > 0) || ((pTimeOut != NULL) && !timerisset(pTimeOut)))
+        {
+            break;
+        }
+        /* sleep until the time out, the next datagram becomes readable or new data arrives */
+        if ((pTimeOut != NULL) && (!timerisset(&next) || (vos_cmpTime(&deadline, &next) < 0)))
+        {
+            next = deadline;
+        }
+        if (!simWait(timerisset(&next) ? &next : NULL) && (pTimeOut != NULL) &&
+            (vos_cmpTime(&next, &deadline) == 0))
+        {
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+
+    if (pErrorFD != NULL)
+    {
+        FD_ZERO(pErrorFD);
+    }
+    return count;
+}
+
+/**********************************************************************************************************************/
+/** Create a poll set.
+ *  The poll set of the simulated network has no descriptor, vos_pollGetFd() is not supported.
+ *
+ *  @param[out]     pPoll           pointer to the handle of the poll set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ */
+
+EXT_DECL VOS_ERR_T vos_pollCreate (
+    VOS_POLL_T *pPoll)
+{
+    if (pPoll == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    *pPoll = (VOS_POLL_T) vos_memAlloc(sizeof(struct VOS_POLL));
+    if (*pPoll == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    (*pPoll)->pNext = sPollSets;
+    sPollSets       = *pPoll;
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Add a socket to a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      tag             value to report for this socket
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollAdd (
+    VOS_POLL_T  poll,
+    SOCKET      sock,
+    UINT32      tag)
+{
+    VOS_ERR_T err = VOS_PARAM_ERR;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    if ((poll != NULL) && (simGet(sock) != NULL))
+    {
+        poll->member[SIM_IDX(sock)] = TRUE;
+        poll->tag[SIM_IDX(sock)]    = tag;
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Remove a socket from a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollRemove (
+    VOS_POLL_T  poll,
+    SOCKET      sock)
+{
+    INT32 idx = SIM_IDX(sock);
+
+    if ((poll == NULL) || (idx < 0) || (idx >= (INT32) VOS_SIM_MAX_SOCKETS))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    poll->member[idx] = FALSE;
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Wait for readable sockets of a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pTags           array to receive the tags of the readable sockets
+ *  @param[in,out]  pNoOfTags       in: size of pTags, out: number of readable sockets
+ *  @param[in]      pTimeOut        pointer to time out value, NULL waits forever, zero time out does not block
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollWait (
+    VOS_POLL_T          poll,
+    UINT32              *pTags,
+    UINT32              *pNoOfTags,
+    const VOS_TIMEVAL_T *pTimeOut)
+{
+    VOS_TIMEVAL_T   deadline;
+    UINT32          maxTags;
+
+    if ((poll == NULL) || (pTags == NULL) || (pNoOfTags == NULL) || (*pNoOfTags == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+    maxTags     = *pNoOfTags;
+    *pNoOfTags  = 0u;
+    if (pTimeOut != NULL)
+    {
+        vos_getTime(&deadline);
+        vos_addTime(&deadline, pTimeOut);
+    }
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    for (;; )
+    {
+        VOS_TIMEVAL_T   now;
+        VOS_TIMEVAL_T   next;
+        INT32           idx;
+
+        vos_getTime(&now);
+        timerclear(&next);
+        for (idx = 0; (idx < (INT32) VOS_SIM_MAX_SOCKETS) && (*pNoOfTags < maxTags); idx++)
+        {
+            if (poll->member[idx] && sSock[idx].inUse && simReadable(&sSock[idx], &now, &next))
+            {
+                pTags[(*pNoOfTags)++] = poll->tag[idx];
+            }
+        }
+        if ((*pNoOfTags > 0u) || ((pTimeOut != NULL) && !timerisset(pTimeOut)))
+        {
+            break;
+        }
+        if ((pTimeOut != NULL) && (!timerisset(&next) || (vos_cmpTime(&deadline, &next) < 0)))
+        {
+            next = deadline;
+        }
+        if (!simWait(timerisset(&next) ? &next : NULL) && (pTimeOut != NULL) &&
+            (vos_cmpTime(&next, &deadline) == 0))
+        {
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of a poll set.
+ *  Not supported by the simulated network.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pFd             set to VOS_INVALID_SOCKET
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollGetFd (
+    VOS_POLL_T  poll,
+    SOCKET      *pFd)
+{
+    (void) poll;
+    if (pFd != NULL)
+    {
+        *pFd = VOS_INVALID_SOCKET;
+    }
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Delete a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDelete (
+    VOS_POLL_T poll)
+{
+    struct VOS_POLL **ppLink;
+
+    if (poll == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    for (ppLink = &sPollSets; *ppLink != NULL; ppLink = &(*ppLink)->pNext)
+    {
+        if (*ppLink == poll)
+        {
+            *ppLink = poll->pNext;
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    vos_memFree(poll);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** AF_XDP is not available in the simulated network.
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpOpen (
+    VOS_XDP_T       *pXdp,
+    const CHAR8     *pIfName,
+    UINT32          queueId,
+    UINT16          port)
+{
+    (void) pIfName;
+    (void) queueId;
+    (void) port;
+    if (pXdp != NULL)
+    {
+        *pXdp = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "AF_XDP is not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+EXT_DECL VOS_ERR_T vos_xdpReceive (
+    VOS_XDP_T       xdp,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    (void) xdp;
+    (void) pMsgs;
+    (void) maxMsgs;
+    if (pNoMsgs != NULL)
+    {
+        *pNoMsgs = 0u;
+    }
+    return VOS_PARAM_ERR;
+}
+
+EXT_DECL VOS_ERR_T vos_xdpGetFd (
+    VOS_XDP_T   xdp,
+    SOCKET      *pFd)
+{
+    (void) xdp;
+    (void) pFd;
+    return VOS_PARAM_ERR;
+}
+
+EXT_DECL VOS_ERR_T vos_xdpClose (
+    VOS_XDP_T xdp)
+{
+    (void) xdp;
+    return VOS_PARAM_ERR;
+}
+
+/*    io_uring    */
+
+/**********************************************************************************************************************/
+/** Open an io_uring for receiving and sending UDP datagrams.
+ *
+ *  @param[out]     pRing           returns NULL
+ *  @param[in]      noOfBuffers     number of receive buffers
+ *  @param[in]      bufSize         size of a receive buffer
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringOpen (
+    VOS_URING_T *pRing,
+    UINT32      noOfBuffers,
+    UINT32      bufSize)
+{
+    (void) noOfBuffers;
+    (void) bufSize;
+    if (pRing != NULL)
+    {
+        *pRing = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "io_uring is not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Start receiving from a UDP socket through an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringAddRecv (
+    VOS_URING_T ring,
+    SOCKET      sock)
+{
+    (void) ring;
+    (void) sock;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop receiving from a UDP socket through an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringRemoveRecv (
+    VOS_URING_T ring,
+    SOCKET      sock)
+{
+    (void) ring;
+    (void) sock;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams from the sockets of an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pSocks          array of receiving sockets
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringReceive (
+    VOS_URING_T     ring,
+    SOCKET          *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    (void) ring;
+    (void) pSocks;
+    (void) pMsgs;
+    (void) maxMsgs;
+    if (pNoMsgs != NULL)
+    {
+        *pNoMsgs = 0u;
+    }
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Send several UDP datagrams, possibly on different sockets, with one call.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      pSocks          array of sending sockets
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringSend (
+    VOS_URING_T     ring,
+    const SOCKET    *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs)
+{
+    (void) ring;
+    (void) pSocks;
+    (void) pMsgs;
+    (void) noMsgs;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pFd             descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringGetFd (
+    VOS_URING_T ring,
+    SOCKET      *pFd)
+{
+    (void) ring;
+    (void) pFd;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Close an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringClose (
+    VOS_URING_T ring)
+{
+    (void) ring;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get a list of interface addresses
+ *  The virtual interfaces are reported: 'sim0' (127.0.0.1) and those added by vos_simAddInterface().
+ *
+ *  @param[in,out]  pAddrCnt          in:   pointer to array size of interface record
+ *                                    out:  pointer to number of interface records read
+ *  @param[in,out]  ifAddrs           array of interface records
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pMAC == NULL
+ */
+EXT_DECL VOS_ERR_T vos_getInterfaces (
+    UINT32          *pAddrCnt,
+    VOS_IF_REC_T    ifAddrs[])
+{
+    UINT32 i;
+
+    if ((pAddrCnt == NULL) || (*pAddrCnt == 0u) || (ifAddrs == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    for (i = 0u; (i < sNoOfIf) && (i < *pAddrCnt); i++)
+    {
+        ifAddrs[i] = sIf[i];
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    *pAddrCnt = i;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the state of an interface
+ *  Virtual interfaces are always up.
+ *
+ *  @param[in]      ifAddress       address of interface to check
+ *
+ *  @retval         TRUE            interface is up and ready
+ */
+EXT_DECL BOOL8 vos_netIfUp (
+    VOS_IP4_ADDR_T ifAddress)
+{
+    (void) ifAddress;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Initialize the socket library.
+ *  Must be called once before any other call
+ *
+ *  @retval         VOS_NO_ERR            no error
+ *  @retval         VOS_SOCK_ERR          sockets not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockInit (void)
+{
+    UINT32 i;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    if (!sSimCondInit)
+    {
+        pthread_condattr_t attr;
+
+        /* timed waits on the clock of vos_getTime() */
+        (void) pthread_condattr_init(&attr);
+        (void) pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        if (pthread_cond_init(&sSimCond, &attr) != 0)
+        {
+            (void) pthread_condattr_destroy(&attr);
+            (void) pthread_mutex_unlock(&sSimMutex);
+            return VOS_SOCK_ERR;
+        }
+        (void) pthread_condattr_destroy(&attr);
+        sSimCondInit = TRUE;
+        for (i = 0u; i < VOS_SIM_HASH_SIZE; i++)
+        {
+            sUcHash[i]  = -1;
+            sMcHash[i]  = -1;
+        }
+        sRandom = (sConfig.seed != 0u) ? sConfig.seed : 1u;
+    }
+    vosSockInitialised = TRUE;
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** De-Initialize the socket library.
+ *  Must be called after last socket call
+ *
+ */
+
+EXT_DECL void vos_sockTerm (void)
+{
+    vosSockInitialised = FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Return the MAC address of the default adapter.
+ *
+ *  @param[out]     pMAC            return MAC address.
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pMAC == NULL
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetMAC (
+    UINT8 pMAC[VOS_MAC_SIZE])
+{
+    if (pMAC == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
+        return VOS_PARAM_ERR;
+    }
+    memcpy(pMAC, sIf[0].mac, VOS_MAC_SIZE);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create an UDP socket.
+ *
+ *  @param[out]     pSock           pointer to socket descriptor returned
+ *  @param[in]      pOptions        pointer to socket options (optional)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pSock == NULL
+ *  @retval         VOS_SOCK_ERR    no simulated socket left
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenUDP (
+    SOCKET                  *pSock,
+    const VOS_SOCK_OPT_T    *pOptions)
+{
+    INT32 idx;
+
+    if (!vosSockInitialised || (pSock == NULL))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    idx = simAlloc(FALSE, pOptions);
+    (void) pthread_mutex_unlock(&sSimMutex);
+    if (idx < 0)
+    {
+        return VOS_SOCK_ERR;
+    }
+    *pSock = SIM_SOCK(idx);
+    vos_printLog(VOS_LOG_DBG, "vos_sockOpenUDP: socket()=%d success\n", (int) *pSock);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create a TCP socket.
+ *
+ *  @param[out]     pSock           pointer to socket descriptor returned
+ *  @param[in]      pOptions        pointer to socket options (optional)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   pSock == NULL
+ *  @retval         VOS_SOCK_ERR    no simulated socket left
+ */
+
+EXT_DECL VOS_ERR_T vos_sockOpenTCP (
+    SOCKET                  *pSock,
+    const VOS_SOCK_OPT_T    *pOptions)
+{
+    INT32 idx;
+
+    if (!vosSockInitialised || (pSock == NULL))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Parameter error\n");
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    idx = simAlloc(TRUE, pOptions);
+    (void) pthread_mutex_unlock(&sSimMutex);
+    if (idx < 0)
+    {
+        return VOS_SOCK_ERR;
+    }
+    *pSock = SIM_SOCK(idx);
+    vos_printLog(VOS_LOG_INFO, "vos_sockOpenTCP: socket()=%d success\n", (int) *pSock);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Close a socket.
+ *  The receive queue is released, the peer of a TCP connection reads the end of the stream.
+ *
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown
+ */
+
+EXT_DECL VOS_ERR_T vos_sockClose (
+    SOCKET sock)
+{
+    VOS_ERR_T err = VOS_PARAM_ERR;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    if (simGet(sock) != NULL)
+    {
+        simRelease(SIM_IDX(sock));
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    if (err != VOS_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "vos_sockClose(%d) called with unknown descriptor\n", (int) sock);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Set socket options.
+ *  QoS, TTL and time stamp options have no effect on the simulated network.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pOptions        pointer to socket options (optional)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetOptions (
+    SOCKET                  sock,
+    const VOS_SOCK_OPT_T    *pOptions)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if (pSock != NULL)
+    {
+        if (pOptions != NULL)
+        {
+            pSock->options = *pOptions;
+        }
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Install a receive filter.
+ *  The filter is evaluated when a datagram is queued, as the kernel filter would.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      pFilter           filter to install, NULL to remove the filter
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR       out of memory
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetFilter (
+    SOCKET                  sock,
+    const VOS_SOCK_FILTER_T *pFilter)
+{
+    SIM_SOCK_T              *pSock;
+    VOS_SOCK_FILTER_ENTRY_T *pEntries = NULL;
+    VOS_ERR_T               err = VOS_PARAM_ERR;
+
+    if ((pFilter != NULL) &&
+        ((pFilter->noOfTypes > VOS_SOCK_FILTER_TYPES) || ((pFilter->noOfEntries > 0u) && (pFilter->pEntries == NULL))))
+    {
+        return VOS_PARAM_ERR;
+    }
+    if ((pFilter != NULL) && (pFilter->noOfEntries > 0u))
+    {
+        pEntries = (VOS_SOCK_FILTER_ENTRY_T *) vos_memAlloc(pFilter->noOfEntries * sizeof(VOS_SOCK_FILTER_ENTRY_T));
+        if (pEntries == NULL)
+        {
+            return VOS_MEM_ERR;
+        }
+        memcpy(pEntries, pFilter->pEntries, pFilter->noOfEntries * sizeof(VOS_SOCK_FILTER_ENTRY_T));
+    }
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if (pSock != NULL)
+    {
+        if (pSock->filter.pEntries != NULL)
+        {
+            vos_memFree((void *) pSock->filter.pEntries);
+        }
+        memset(&pSock->filter, 0, sizeof(pSock->filter));
+        pSock->hasFilter = (pFilter != NULL);
+        if (pFilter != NULL)
+        {
+            pSock->filter           = *pFilter;
+            pSock->filter.pEntries  = pEntries;
+        }
+        pEntries    = NULL;
+        err         = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    if (pEntries != NULL)
+    {
+        vos_memFree(pEntries);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Steer the datagrams of a group of sockets bound to the same address and port.
+ *
+ *  @param[in]      sock              socket descriptor, any socket of the group
+ *  @param[in]      keyOffset         payload offset of the 32 bit key field (network byte order)
+ *  @param[in]      noOfSocks         number of sockets of the group
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetSteering (
+    SOCKET  sock,
+    UINT16  keyOffset,
+    UINT32  noOfSocks)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+    INT32       idx;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if ((pSock != NULL) && (noOfSocks > 0u) && pSock->hashed)
+    {
+        for (idx = sUcHash[simUcKey(pSock->hostIP, pSock->bindPort)]; idx != -1; idx = sSock[idx].hashNext)
+        {
+            if ((sSock[idx].hostIP == pSock->hostIP) && (sSock[idx].bindPort == pSock->bindPort))
+            {
+                sSock[idx].steerOffset  = keyOffset;
+                sSock[idx].steerSocks   = noOfSocks;
+            }
+        }
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Cork or uncork a TCP socket.
+ *  The simulated network delivers whole messages, there is nothing to hold back.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      cork              TRUE: hold back partial segments, FALSE: send pending data
+ *
+ *  @retval         VOS_NO_ERR        no error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetCork (
+    SOCKET  sock,
+    BOOL8   cork)
+{
+    (void) sock;
+    (void) cork;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the state of the receive queue of a socket.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[out]     pQueue            receive queue state
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetRxQueue (
+    SOCKET          sock,
+    VOS_SOCK_RXQ_T  *pQueue)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+
+    if (pQueue == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if (pSock != NULL)
+    {
+        VOS_TIMEVAL_T now;
+
+        vos_getTime(&now);
+        simArrive(pSock, &now);
+        pQueue->drops   = pSock->drops;
+        pQueue->queued  = pSock->tcp ? pSock->queued : pSock->arrived;
+        pQueue->bufSize = pSock->bufSize;
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Set the size of the receive buffer of a socket.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      size              receive buffer size in bytes of payload
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_SOCK_ERR      size could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetRcvBuffer (
+    SOCKET  sock,
+    UINT32  size)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_SOCK_ERR;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if ((pSock != NULL) && (size > 0u))
+    {
+        pSock->bufSize  = size;
+        err             = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Add or remove a multicast membership. Called with the mutex held. */
+static VOS_ERR_T simMembership (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress,
+    BOOL8   join)
+{
+    SIM_SOCK_T  *pSock = simGet(sock);
+    UINT32      i;
+
+    if ((pSock == NULL) || pSock->tcp || !vos_isMulticast(mcAddress))
+    {
+        return VOS_PARAM_ERR;
+    }
+    for (i = 0u; i < pSock->noOfMc; i++)
+    {
+        if ((pSock->pMc[i].group == mcAddress) && (pSock->pMc[i].source == srcAddress))
+        {
+            break;
+        }
+    }
+    if (!join)
+    {
+        if (i == pSock->noOfMc)
+        {
+            return VOS_PARAM_ERR;
+        }
+        pSock->pMc[i] = pSock->pMc[--pSock->noOfMc];
+    }
+    else if (i == pSock->noOfMc)
+    {
+        if (pSock->noOfMc == pSock->maxMc)
+        {
+            UINT32      newMax  = (pSock->maxMc == 0u) ? VOS_MAX_MULTICAST_CNT : pSock->maxMc * 2u;
+            SIM_MC_T    *pNew   = (SIM_MC_T *) vos_memAlloc(newMax * sizeof(SIM_MC_T));
+
+            if (pNew == NULL)
+            {
+                return VOS_MEM_ERR;
+            }
+            if (pSock->pMc != NULL)
+            {
+                memcpy(pNew, pSock->pMc, pSock->noOfMc * sizeof(SIM_MC_T));
+                vos_memFree(pSock->pMc);
+            }
+            pSock->pMc      = pNew;
+            pSock->maxMc    = newMax;
+        }
+        pSock->pMc[pSock->noOfMc].group     = mcAddress;
+        pSock->pMc[pSock->noOfMc].source    = srcAddress;
+        pSock->noOfMc++;
+        if ((pSock->mcIf == 0u) && (ipAddress != 0u))
+        {
+            pSock->mcIf = ipAddress;
+        }
+    }
+    simRehash(SIM_IDX(sock));
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Join a multicast group.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to join
+ *  @param[in]      ipAddress         depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR       out of memory
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  ipAddress)
+{
+    VOS_ERR_T err;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    err = simMembership(sock, mcAddress, 0u, ipAddress, TRUE);
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Leave a multicast group.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to join
+ *  @param[in]      ipAddress         depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  ipAddress)
+{
+    VOS_ERR_T err;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    err = simMembership(sock, mcAddress, 0u, ipAddress, FALSE);
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Join a multicast group for one source only.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to join
+ *  @param[in]      srcAddress        source to receive from
+ *  @param[in]      ipAddress         depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR       out of memory
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    VOS_ERR_T err;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    err = simMembership(sock, mcAddress, srcAddress, ipAddress, TRUE);
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Leave a source specific multicast membership.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to leave
+ *  @param[in]      srcAddress        source joined with vos_sockJoinSourceMC
+ *  @param[in]      ipAddress         depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    VOS_ERR_T err;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    err = simMembership(sock, mcAddress, srcAddress, ipAddress, FALSE);
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Send UDP data at a given time.
+ *  The datagram becomes readable at the launch time plus the delay of the link model.
+ *
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      pBuffer            pointer to data to send
+ *  @param[in,out]  pSize              In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress          destination IP
+ *  @param[in]      port               destination port
+ *  @param[in]      pLaunchTime        transmit time (time base of vos_getTime), NULL to send immediately
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPAt (
+    SOCKET              sock,
+    const UINT8         *pBuffer,
+    UINT32              *pSize,
+    UINT32              ipAddress,
+    UINT16              port,
+    const VOS_TIMEVAL_T *pLaunchTime)
+{
+    SIM_SOCK_T      *pSock;
+    VOS_TIMEVAL_T   deliverAt;
+    VOS_ERR_T       err = VOS_PARAM_ERR;
+
+    if ((pBuffer == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if ((pSock != NULL) && !pSock->tcp)
+    {
+        simAutoBind(pSock);
+        if (!simTxFull(pSock, pLaunchTime))
+        {
+            simDeliveryTime(pSock, *pSize, pLaunchTime, &deliverAt);
+            simDeliverUDP(pSock, pBuffer, *pSize, ipAddress, port, &deliverAt);
+        }
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    if (err != VOS_NO_ERR)
+    {
+        *pSize = 0u;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Send UDP data.
+ *
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      pBuffer            pointer to data to send
+ *  @param[in,out]  pSize              In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress          destination IP
+ *  @param[in]      port               destination port
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDP (
+    SOCKET      sock,
+    const UINT8 *pBuffer,
+    UINT32      *pSize,
+    UINT32      ipAddress,
+    UINT16      port)
+{
+    return vos_sockSendUDPAt(sock, pBuffer, pSize, ipAddress, port, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Send several UDP datagrams with one call.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (size in: to send, out: bytes sent)
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+    UINT32      i;
+
+    if ((pMsgs == NULL) || (noMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if ((pSock != NULL) && !pSock->tcp)
+    {
+        simAutoBind(pSock);
+        for (i = 0u; i < noMsgs; i++)
+        {
+            VOS_TIMEVAL_T deliverAt;
+
+            if (simTxFull(pSock, NULL))
+            {
+                continue;
+            }
+            simDeliveryTime(pSock, pMsgs[i].size, NULL, &deliverAt);
+            simDeliverUDP(pSock, pMsgs[i].pBuffer, pMsgs[i].size, pMsgs[i].dstIPAddr, pMsgs[i].dstIPPort,
+                          &deliverAt);
+        }
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP data with its reception time.
+ *  The reception time is the time the datagram became readable.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[in]      peek            if true, leave data in queue
+ *  @param[out]     pRxTime         pointer to the reception time (time base of vos_getTime), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_NODATA_ERR  no data
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPTime (
+    SOCKET          sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    BOOL8           peek,
+    VOS_TIMEVAL_T   *pRxTime)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+
+    if ((pBuffer == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sSimMutex);
+    for (;; )
+    {
+        VOS_TIMEVAL_T   now;
+        VOS_TIMEVAL_T   next;
+
+        pSock = simGet(sock);
+        if ((pSock == NULL) || pSock->tcp)
+        {
+            err = VOS_PARAM_ERR;
+            break;
+        }
+        vos_getTime(&now);
+        timerclear(&next);
+        if (simReadable(pSock, &now, &next))
+        {
+            SIM_BUF_T *pBuf = pSock->pHead;
+
+            if (*pSize > pBuf->size)
+            {
+                *pSize = pBuf->size;
+            }
+            memcpy(pBuffer, pBuf->data, *pSize);
+            if (pSrcIPAddr != NULL)
+            {
+                *pSrcIPAddr = pBuf->srcIP;
+            }
+            if (pSrcIPPort != NULL)
+            {
+                *pSrcIPPort = pBuf->srcPort;
+            }
+            if (pDstIPAddr != NULL)
+            {
+                *pDstIPAddr = pBuf->dstIP;
+            }
+            if (pRxTime != NULL)
+            {
+                *pRxTime = pBuf->deliverAt;
+            }
+            if (!peek)
+            {
+                simDequeue(pSock);  /* the rest of a truncated datagram is lost, as with recvfrom() */
+            }
+            err = VOS_NO_ERR;
+            break;
+        }
+        if (pSock->options.nonBlocking)
+        {
+            err = VOS_NODATA_ERR;
+            break;
+        }
+        (void) simWait(timerisset(&next) ? &next : NULL);
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    if (err != VOS_NO_ERR)
+    {
+        *pSize = 0u;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP data.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[in]      peek            if true, leave data in queue
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_NODATA_ERR  no data
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pSrcIPAddr,
+    UINT16  *pSrcIPPort,
+    UINT32  *pDstIPAddr,
+    BOOL8   peek)
+{
+    return vos_sockReceiveUDPTime(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, peek, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams with one call.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_NODATA_ERR  no data
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    SIM_SOCK_T      *pSock;
+    VOS_TIMEVAL_T   now;
+    VOS_ERR_T       err;
+
+    if ((pMsgs == NULL) || (pNoMsgs == NULL) || (maxMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (maxMsgs > VOS_MAX_SOCK_BATCH)
+    {
+        maxMsgs = VOS_MAX_SOCK_BATCH;
+    }
+    *pNoMsgs = 0u;
+
+    /* the first one may block */
+    err = vos_sockReceiveUDPTime(sock, pMsgs[0].pBuffer, &pMsgs[0].size, &pMsgs[0].srcIPAddr, &pMsgs[0].srcIPPort,
+                                 &pMsgs[0].dstIPAddr, FALSE, &pMsgs[0].rxTime);
+    if (err != VOS_NO_ERR)
+    {
+        return err;
+    }
+    *pNoMsgs = 1u;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    vos_getTime(&now);
+    while ((pSock != NULL) && (*pNoMsgs < maxMsgs) && simReadable(pSock, &now, NULL))
+    {
+        VOS_SOCK_MSG_T  *pMsg = &pMsgs[*pNoMsgs];
+        SIM_BUF_T       *pBuf = pSock->pHead;
+
+        if (pMsg->size > pBuf->size)
+        {
+            pMsg->size = pBuf->size;
+        }
+        memcpy(pMsg->pBuffer, pBuf->data, pMsg->size);
+        pMsg->srcIPAddr = pBuf->srcIP;
+        pMsg->srcIPPort = pBuf->srcPort;
+        pMsg->dstIPAddr = pBuf->dstIP;
+        pMsg->rxTime    = pBuf->deliverAt;
+        simDequeue(pSock);
+        (*pNoMsgs)++;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Send consecutive UDP datagrams of equal size from one buffer.
+ *  There is no segmentation offload on this target, the datagrams are sent one by one.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to the datagrams to send
+ *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      segSize         size of one datagram
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPSeg (
+    SOCKET      sock,
+    const UINT8 *pBuffer,
+    UINT32      *pSize,
+    UINT32      segSize,
+    UINT32      ipAddress,
+    UINT16      port)
+{
+    VOS_ERR_T   err     = VOS_NO_ERR;
+    UINT32      done    = 0u;
+    UINT32      size;
+    UINT32      chunk;
+
+    if ((pBuffer == NULL) || (pSize == NULL) || (segSize == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    size    = *pSize;
+    *pSize  = 0u;
+
+    while ((done < size) && (err == VOS_NO_ERR))
+    {
+        chunk = size - done;
+        if (chunk > segSize)
+        {
+            chunk = segSize;
+        }
+        err = vos_sockSendUDP(sock, pBuffer + done, &chunk, ipAddress, port);
+        done    += chunk;
+        *pSize  = done;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP datagrams the kernel may have coalesced.
+ *  There is no receive offload on this target, one datagram is read and *pSegSize is its size.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSegSize        pointer to the size of one datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPSeg (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pSegSize,
+    UINT32  *pSrcIPAddr,
+    UINT16  *pSrcIPPort,
+    UINT32  *pDstIPAddr)
+{
+    VOS_ERR_T err;
+
+    if (pSegSize == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    err = vos_sockReceiveUDP(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, FALSE);
+    *pSegSize = (pSize != NULL) ? *pSize : 0u;
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Bind a socket to an address and port.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      ipAddress         source IP to receive from, 0 for any
+ *  @param[in]      port              port to receive from, 0 for an ephemeral port
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_IO_ERR        address and port in use
+ */
+
+EXT_DECL VOS_ERR_T vos_sockBind (
+    SOCKET  sock,
+    UINT32  ipAddress,
+    UINT16  port)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+    INT32       idx;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if (pSock != NULL)
+    {
+        err = VOS_NO_ERR;
+        if (port != 0u)
+        {
+            /* sockets sharing address and port all need the reuse option */
+            for (idx = 0; idx < (INT32) VOS_SIM_MAX_SOCKETS; idx++)
+            {
+                SIM_SOCK_T *pOther = &sSock[idx];
+
+                if (pOther->inUse && (pOther != pSock) && (pOther->tcp == pSock->tcp) && (pOther->bindPort == port) &&
+                    (pOther->bindIP == ipAddress) && (pOther->peer == -1) &&
+                    !(pOther->options.reuseAddrPort && pSock->options.reuseAddrPort))
+                {
+                    vos_printLog(VOS_LOG_ERROR, "binding to %s:%hu failed (address in use)\n",
+                                 vos_ipDotted(ipAddress), port);
+                    err = VOS_IO_ERR;
+                    break;
+                }
+            }
+        }
+        if (err == VOS_NO_ERR)
+        {
+            pSock->bindIP   = ipAddress;
+            pSock->bindPort = (port != 0u) ? port : simEphemeralPort(pSock->tcp);
+            simRehash(SIM_IDX(sock));
+        }
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Listen for incoming TCP connections.
+ *
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      backlog            maximum connection attempts if system is busy
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_sockListen (
+    SOCKET  sock,
+    UINT32  backlog)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+
+    (void) backlog;
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if ((pSock != NULL) && pSock->tcp)
+    {
+        simAutoBind(pSock);
+        pSock->listening    = TRUE;
+        err                 = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Accept an incoming TCP connection.
+ *  Without pending connection a non-blocking socket returns VOS_NO_ERR and *pSock = -1, as on POSIX.
+ *
+ *  @param[in]      sock               Socket descriptor
+ *  @param[out]     pSock              Pointer to socket descriptor, on exit new socket
+ *  @param[out]     pIPAddress         source IP of the connection
+ *  @param[out]     pPort              source port of the connection
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      NULL parameter, parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_sockAccept (
+    SOCKET  sock,
+    SOCKET  *pSock,
+    UINT32  *pIPAddress,
+    UINT16  *pPort)
+{
+    SIM_SOCK_T  *pListener;
+    VOS_ERR_T   err = VOS_NO_ERR;
+
+    if ((pSock == NULL) || (pIPAddress == NULL) || (pPort == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    *pSock = VOS_INVALID_SOCKET;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    for (;; )
+    {
+        pListener = simGet(sock);
+        if ((pListener == NULL) || !pListener->listening)
+        {
+            err = VOS_PARAM_ERR;
+            break;
+        }
+        if (pListener->pendingHead != -1)
+        {
+            INT32 idx = pListener->pendingHead;
+
+            pListener->pendingHead  = sSock[idx].pendingNext;
+            sSock[idx].pendingNext  = -1;
+            *pSock                  = SIM_SOCK(idx);
+            *pIPAddress             = sSock[idx].peerIP;
+            *pPort                  = sSock[idx].peerPort;
+            break;
+        }
+        if (pListener->options.nonBlocking)
+        {
+            break;
+        }
+        (void) simWait(NULL);
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Open a TCP connection.
+ *  The connection is established at once, if a socket listens on the address and port.
+ *
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      ipAddress          destination IP
+ *  @param[in]      port               destination port
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ *  @retval         VOS_IO_ERR         connection refused
+ */
+
+EXT_DECL VOS_ERR_T vos_sockConnect (
+    SOCKET  sock,
+    UINT32  ipAddress,
+    UINT16  port)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err         = VOS_PARAM_ERR;
+    INT32       listener    = -1;
+    UINT32      pass;
+    INT32       idx;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if ((pSock != NULL) && pSock->tcp && !pSock->listening)
+    {
+        if (pSock->connected)
+        {
+            err = VOS_NO_ERR;
+        }
+        else
+        {
+            for (pass = 0u; (pass < 2u) && (listener == -1); pass++)
+            {
+                UINT32 hostIP = (pass == 0u) ? ipAddress : 0u;
+
+                for (idx = sUcHash[simUcKey(hostIP, port)]; idx != -1; idx = sSock[idx].hashNext)
+                {
+                    if (sSock[idx].listening && (sSock[idx].hostIP == hostIP) && (sSock[idx].bindPort == port))
+                    {
+                        listener = idx;
+                        break;
+                    }
+                }
+            }
+            idx = (listener != -1) ? simAlloc(TRUE, &sSock[listener].options) : -1;
+            if (idx == -1)
+            {
+                vos_printLog(VOS_LOG_WARNING, "connect() to %s:%hu refused\n", vos_ipDotted(ipAddress), port);
+                err = VOS_IO_ERR;
+            }
+            else
+            {
+                SIM_SOCK_T  *pServer = &sSock[idx];
+                INT32       *pLink;
+
+                simAutoBind(pSock);
+                pServer->bindIP     = ipAddress;
+                pServer->bindPort   = port;
+                pServer->hostIP     = ipAddress;
+                pServer->connected  = TRUE;
+                pServer->peer       = SIM_IDX(sock);
+                pServer->peerIP     = simSourceIP(pSock);
+                pServer->peerPort   = pSock->bindPort;
+                pSock->connected    = TRUE;
+                pSock->peer         = idx;
+                pSock->peerIP       = ipAddress;
+                pSock->peerPort     = port;
+
+                for (pLink = &sSock[listener].pendingHead; *pLink != -1; pLink = &sSock[*pLink].pendingNext)
+                {
+                    ;
+                }
+                *pLink = idx;
+                (void) pthread_cond_broadcast(&sSimCond);
+                err = VOS_NO_ERR;
+            }
+        }
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Send TCP data gathered from several buffers.
+ *  The segments are appended to the stream of the peer in order.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pSegs           array of buffer segments
+ *  @param[in]      noSegs          number of entries in pSegs (at most VOS_MAX_SOCK_SEGS)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      the peer closed the connection
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   the window of the peer is full, *pSize bytes were sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET                  sock,
+    const VOS_SOCK_SEG_T    *pSegs,
+    UINT32                  noSegs,
+    UINT32                  *pSize)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      i;
+
+    if ((pSegs == NULL) || (pSize == NULL) || (noSegs == 0u) || (noSegs > VOS_MAX_SOCK_SEGS))
+    {
+        return VOS_PARAM_ERR;
+    }
+    *pSize = 0u;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if ((pSock == NULL) || !pSock->tcp)
+    {
+        err = VOS_PARAM_ERR;
+    }
+    else if (pSock->peer == -1)
+    {
+        err = pSock->peerClosed ? VOS_IO_ERR : VOS_NOCONN_ERR;
+    }
+    else
+    {
+        SIM_SOCK_T *pPeer = &sSock[pSock->peer];
+
+        for (i = 0u; (i < noSegs) && (err == VOS_NO_ERR); i++)
+        {
+            VOS_TIMEVAL_T   deliverAt;
+            UINT32          size = pSegs[i].size;
+
+            if (size == 0u)
+            {
+                continue;
+            }
+            /* take what fits into the window of the peer */
+            if (size > pPeer->bufSize - pPeer->queued)
+            {
+                size    = pPeer->bufSize - pPeer->queued;
+                err     = VOS_BLOCK_ERR;
+                if (size == 0u)
+                {
+                    break;
+                }
+            }
+            simDeliveryTime(pSock, size, NULL, &deliverAt);
+            /* the stream keeps its order */
+            if ((pPeer->pTail != NULL) && (vos_cmpTime(&pPeer->pTail->deliverAt, &deliverAt) > 0))
+            {
+                deliverAt = pPeer->pTail->deliverAt;
+            }
+            if (!simEnqueue(pPeer, pSegs[i].pBuffer, size, pPeer->peerIP, pPeer->peerPort, pSock->peerIP,
+                            &deliverAt))
+            {
+                err = VOS_BLOCK_ERR;
+                break;
+            }
+            *pSize          += size;
+            sStats.tcpBytes += size;
+        }
+        (void) pthread_cond_broadcast(&sSimCond);
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Send TCP data.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to data to send
+ *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      the peer closed the connection
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   the receive buffer of the peer is full
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCP (
+    SOCKET      sock,
+    const UINT8 *pBuffer,
+    UINT32      *pSize)
+{
+    VOS_SOCK_SEG_T seg;
+
+    if ((pBuffer == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (*pSize == 0u)
+    {
+        return VOS_NO_ERR;
+    }
+    seg.pBuffer = pBuffer;
+    seg.size    = *pSize;
+    return vos_sockSendTCPv(sock, &seg, 1u, pSize);
+}
+
+/**********************************************************************************************************************/
+/** Receive TCP data.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_NODATA_ERR  the peer closed the connection
+ *  @retval         VOS_BLOCK_ERR   no data in non-blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveTCP (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err         = VOS_NO_ERR;
+    UINT32      bufferSize;
+
+    if ((pBuffer == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    bufferSize  = *pSize;
+    *pSize      = 0u;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    for (;; )
+    {
+        VOS_TIMEVAL_T   now;
+        VOS_TIMEVAL_T   next;
+
+        pSock = simGet(sock);
+        if ((pSock == NULL) || !pSock->tcp)
+        {
+            err = VOS_PARAM_ERR;
+            break;
+        }
+        vos_getTime(&now);
+        timerclear(&next);
+        while ((bufferSize > 0u) && (pSock->pHead != NULL) && (vos_cmpTime(&pSock->pHead->deliverAt, &now) <= 0))
+        {
+            SIM_BUF_T   *pBuf   = pSock->pHead;
+            UINT32      chunk   = pBuf->size - pBuf->offset;
+
+            if (chunk > bufferSize)
+            {
+                chunk = bufferSize;
+            }
+            memcpy(pBuffer + *pSize, pBuf->data + pBuf->offset, chunk);
+            pBuf->offset    += chunk;
+            *pSize          += chunk;
+            bufferSize      -= chunk;
+            if (pBuf->offset == pBuf->size)
+            {
+                simDequeue(pSock);
+            }
+        }
+        if (*pSize > 0u)
+        {
+            break;
+        }
+        if (pSock->peerClosed && (pSock->pHead == NULL))
+        {
+            err = VOS_NODATA_ERR;
+            break;
+        }
+        if (pSock->options.nonBlocking)
+        {
+            err = VOS_BLOCK_ERR;
+            break;
+        }
+        (void) simReadable(pSock, &now, &next);
+        (void) simWait(timerisset(&next) ? &next : NULL);
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Set Using Multicast I/F
+ *  A socket bound to any address receives the unicasts to this address.
+ *
+ *  @param[in]      sock                       socket descriptor
+ *  @param[in]      mcIfAddress                using Multicast I/F Address
+ *
+ *  @retval         VOS_NO_ERR                 no error
+ *  @retval         VOS_PARAM_ERR              sock descriptor unknown, parameter error
+ */
+EXT_DECL VOS_ERR_T vos_sockSetMulticastIf (
+    SOCKET  sock,
+    UINT32  mcIfAddress)
+{
+    SIM_SOCK_T  *pSock;
+    VOS_ERR_T   err = VOS_PARAM_ERR;
+
+    (void) pthread_mutex_lock(&sSimMutex);
+    pSock = simGet(sock);
+    if (pSock != NULL)
+    {
+        pSock->mcIf = mcIfAddress;
+        simRehash(SIM_IDX(sock));
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sSimMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Determines the address to bind to, as on Linux: receivers of multicasts bind to any address.
+ *
+ *  @param[in]      srcIP           IP to bind to (0 = any address)
+ *  @param[in]      mcGroup         MC group to join (0 = do not join)
+ *  @param[in]      rcvMostly       primarily used for receiving (tbd: bind on sender, too?)
+ *
+ *  @retval         Address to bind to
+ */
+EXT_DECL VOS_IP4_ADDR_T vos_determineBindAddr ( VOS_IP4_ADDR_T  srcIP,
+                                                VOS_IP4_ADDR_T  mcGroup,
+                                                VOS_IP4_ADDR_T  rcvMostly)
+{
+    if (vos_isMulticast(mcGroup) && rcvMostly)
+    {
+        return 0;
+    }
+    else
+    {
+        return srcIP;
+    }
+}
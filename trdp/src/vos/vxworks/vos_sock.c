@@ -30,6 +30,8 @@
 /***********************************************************************************************************************
  * INCLUDES
  */
+#define VOS_SOCK_BYTE_ORDER_FUNCTIONS   /* vos_htonl() etc. are implemented here, see vos_sock.h */
+
 #include "vxWorks.h"
 #include "vos_sock.h"
 #include "vos_types.h"
@@ -45,6 +47,22 @@
  * DEFINITIONS
  */
 
+#ifndef VOS_SOCK_ZBUF       /**< Filter received datagrams in the network buffers (zbufSockLib, INCLUDE_ZBUF_SOCK) */
+#define VOS_SOCK_ZBUF   0
+#endif
+
+#if VOS_SOCK_ZBUF
+#include "semLib.h"
+#include "zbufSockLib.h"
+
+/** Receive filter of a socket, evaluated on the zbuf of a datagram before it is copied  */
+typedef struct VOS_ZBUF_FILTER
+{
+    struct VOS_ZBUF_FILTER  *pNext;
+    SOCKET                  sock;
+    VOS_SOCK_FILTER_T       filter;         /**< pEntries points behind this structure   */
+} VOS_ZBUF_FILTER_T;
+#endif
 
 
 /***********************************************************************************************************************
@@ -57,9 +75,247 @@ BOOL8           vosSockInitialised = FALSE;
 
 struct ifreq    gIfr;
 
+#if VOS_SOCK_ZBUF
+static SEM_ID               sZbufFilterSem  = NULL;
+static VOS_ZBUF_FILTER_T    *sZbufFilters   = NULL;
+#endif
+
 /***********************************************************************************************************************
  * LOCAL FUNCTIONS
- *//**********************************************************************************************************************/
+ */
+
+#if VOS_SOCK_ZBUF
+/**********************************************************************************************************************/
+/** Read a big endian field of a datagram held in a zbuf.
+ *  The field is read in place if the first segment holds it, else it is copied out.
+ *
+ *  @param[in]      zbufId          zbuf of the datagram
+ *  @param[in]      offset          offset of the field
+ *  @param[in]      size            2 or 4
+ *  @param[out]     pValue          value of the field
+ *
+ *  @retval         TRUE            field read
+ *  @retval         FALSE           datagram too short
+ */
+static BOOL8 zbufField (
+    ZBUF_ID zbufId,
+    int     offset,
+    int     size,
+    UINT32  *pValue)
+{
+    ZBUF_SEG    seg = zbufSegFind(zbufId, NULL, &offset);
+    const UINT8 *pData;
+    UINT8       field[4];
+    int         i;
+
+    if ((seg != NULL) && (offset + size <= zbufSegLength(zbufId, seg)))
+    {
+        pData = (const UINT8 *) zbufSegData(zbufId, seg) + offset;
+    }
+    else if ((seg != NULL) && (zbufExtractCopy(zbufId, seg, offset, (caddr_t) field, size) == size))
+    {
+        pData = field;
+    }
+    else
+    {
+        return FALSE;
+    }
+
+    *pValue = 0u;
+    for (i = 0; i < size; i++)
+    {
+        *pValue = (*pValue << 8u) | pData[i];
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Check a received datagram against a receive filter (see vos_sockSetFilter).
+ *
+ *  @param[in]      pFilter         receive filter
+ *  @param[in]      zbufId          zbuf of the datagram
+ *  @param[in]      srcIPAddr       source IP of the datagram
+ *
+ *  @retval         TRUE            datagram passes
+ *  @retval         FALSE           datagram is dropped
+ */
+static BOOL8 zbufFilterPasses (
+    const VOS_SOCK_FILTER_T *pFilter,
+    ZBUF_ID                 zbufId,
+    UINT32                  srcIPAddr)
+{
+    const VOS_SOCK_FILTER_ENTRY_T *pEntry;
+    UINT32  type;
+    UINT32  key;
+    UINT32  i;
+
+    /*  Short datagrams are left to the checks of the caller  */
+    if (zbufField(zbufId, (int) pFilter->typeOffset, 2, &type) == FALSE)
+    {
+        return TRUE;
+    }
+    for (i = 0u; (i < pFilter->noOfTypes) && (pFilter->types[i] != (UINT16) type); i++)
+    {
+        ;
+    }
+    if ((i == pFilter->noOfTypes) ||
+        (zbufField(zbufId, (int) pFilter->keyOffset, 4, &key) == FALSE))
+    {
+        return TRUE;
+    }
+
+    for (pEntry = pFilter->pEntries; pEntry < pFilter->pEntries + pFilter->noOfEntries; pEntry++)
+    {
+        if ((pEntry->key == key) &&
+            ((pEntry->srcIpLo == 0u) ||
+             (pEntry->srcIpLo == srcIPAddr) ||
+             ((pEntry->srcIpHi != 0u) && (srcIPAddr >= pEntry->srcIpLo) && (srcIPAddr <= pEntry->srcIpHi))))
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Remove the receive filter of a socket.
+ *
+ *  @param[in]      sock            socket descriptor
+ */
+static void zbufFilterRemove (
+    SOCKET sock)
+{
+    VOS_ZBUF_FILTER_T   **ppFilter;
+    VOS_ZBUF_FILTER_T   *pFilter;
+
+    (void) semTake(sZbufFilterSem, WAIT_FOREVER);
+    for (ppFilter = &sZbufFilters; *ppFilter != NULL; ppFilter = &(*ppFilter)->pNext)
+    {
+        if ((*ppFilter)->sock == sock)
+        {
+            pFilter     = *ppFilter;
+            *ppFilter   = pFilter->pNext;
+            vos_memFree(pFilter);
+            break;
+        }
+    }
+    (void) semGive(sZbufFilterSem);
+}
+
+/**********************************************************************************************************************/
+/** Receive a datagram through the receive filter of its socket without copying dropped datagrams.
+ *  The datagram is taken from the socket as zbuf, its header is inspected in the network buffers and only
+ *  datagrams which pass are copied to the caller's buffer. The destination IP is not available with zbufs.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP, set to 0
+ *
+ *  @retval         VOS_NO_ERR      datagram received (or ICMP port unreachable, *pSize == 0)
+ *  @retval         VOS_UNKNOWN_ERR no filter installed on this socket
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+static VOS_ERR_T zbufReceive (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pSrcIPAddr,
+    UINT16  *pSrcIPPort,
+    UINT32  *pDstIPAddr)
+{
+    VOS_ZBUF_FILTER_T   *pFilter;
+    struct sockaddr_in  srcAddr;
+    int                 srcLen;
+    int                 len;
+    ZBUF_ID             zbufId;
+    UINT32              srcIPAddr;
+    BOOL8               passes = FALSE;
+
+    if (sZbufFilters == NULL)
+    {
+        return VOS_UNKNOWN_ERR;
+    }
+    (void) semTake(sZbufFilterSem, WAIT_FOREVER);
+    for (pFilter = sZbufFilters; (pFilter != NULL) && (pFilter->sock != sock); pFilter = pFilter->pNext)
+    {
+        ;
+    }
+    (void) semGive(sZbufFilterSem);
+    if (pFilter == NULL)
+    {
+        return VOS_UNKNOWN_ERR;
+    }
+
+    /*  Dropped datagrams are skipped, as a kernel filter would do  */
+    do
+    {
+        do
+        {
+            len     = (int) *pSize;
+            srcLen  = sizeof(srcAddr);
+            memset(&srcAddr, 0, sizeof(srcAddr));
+            zbufId  = zbufSockRecvfrom(sock, 0, &len, (struct sockaddr *) &srcAddr, &srcLen);
+        }
+        while ((zbufId == NULL) && (errno == EINTR));
+
+        if (zbufId == NULL)
+        {
+            *pSize = 0u;
+            if (errno == EWOULDBLOCK)
+            {
+                return VOS_BLOCK_ERR;
+            }
+            if (errno == ECONNRESET)
+            {
+                /* ICMP port unreachable received (result of previous send), treat this as no error */
+                return VOS_NO_ERR;
+            }
+            vos_printLog(VOS_LOG_ERROR, "zbufSockRecvfrom() failed (Err: %d)\n", errno);
+            return VOS_IO_ERR;
+        }
+
+        srcIPAddr = (UINT32) vos_ntohl(srcAddr.sin_addr.s_addr);
+
+        /*  The filter may have been replaced meanwhile: evaluate it under the lock  */
+        (void) semTake(sZbufFilterSem, WAIT_FOREVER);
+        for (pFilter = sZbufFilters; (pFilter != NULL) && (pFilter->sock != sock); pFilter = pFilter->pNext)
+        {
+            ;
+        }
+        passes = (pFilter == NULL) || zbufFilterPasses(&pFilter->filter, zbufId, srcIPAddr);
+        (void) semGive(sZbufFilterSem);
+
+        if (passes == TRUE)
+        {
+            len = zbufExtractCopy(zbufId, NULL, 0, (caddr_t) pBuffer, len);
+        }
+        (void) zbufDelete(zbufId);
+    }
+    while (passes == FALSE);
+
+    *pSize = (len > 0) ? (UINT32) len : 0u;
+
+    if (pSrcIPAddr != NULL)
+    {
+        *pSrcIPAddr = srcIPAddr;
+    }
+    if (pSrcIPPort != NULL)
+    {
+        *pSrcIPPort = (UINT16) vos_ntohs(srcAddr.sin_port);
+    }
+    if (pDstIPAddr != NULL)
+    {
+        *pDstIPAddr = 0u;
+    }
+    return VOS_NO_ERR;
+}
+#endif
+
+/**********************************************************************************************************************/
 /** Get the MAC address for a named interface.
  *
  *  @param[out]         pMacAddr   pointer to array of MAC address to return
@@ -329,6 +585,365 @@ EXT_DECL INT32 vos_select (
                   (fd_set *) pErrorFD, (struct timeval *) pTimeOut);
 }
 
+/**********************************************************************************************************************/
+/** Create a poll set.
+ *  Poll sets are not supported on this target, select() has to be used.
+ *
+ *  @param[out]     pPoll           pointer to the handle of the poll set
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollCreate (
+    VOS_POLL_T *pPoll)
+{
+    if (pPoll != NULL)
+    {
+        *pPoll = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "poll sets are not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Add a socket to a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      tag             value to report for this socket
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollAdd (
+    VOS_POLL_T  poll,
+    SOCKET      sock,
+    UINT32      tag)
+{
+    (void) poll;
+    (void) sock;
+    (void) tag;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Remove a socket from a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollRemove (
+    VOS_POLL_T  poll,
+    SOCKET      sock)
+{
+    (void) poll;
+    (void) sock;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Wait for readable sockets of a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pTags           array to receive the tags of the readable sockets
+ *  @param[in,out]  pNoOfTags       in: size of pTags, out: number of readable sockets
+ *  @param[in]      pTimeOut        pointer to time out value
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollWait (
+    VOS_POLL_T          poll,
+    UINT32              *pTags,
+    UINT32              *pNoOfTags,
+    const VOS_TIMEVAL_T *pTimeOut)
+{
+    (void) poll;
+    (void) pTags;
+    (void) pTimeOut;
+    if (pNoOfTags != NULL)
+    {
+        *pNoOfTags = 0u;
+    }
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pFd             pointer to the descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollGetFd (
+    VOS_POLL_T  poll,
+    SOCKET      *pFd)
+{
+    (void) poll;
+    (void) pFd;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Delete a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDelete (
+    VOS_POLL_T poll)
+{
+    (void) poll;
+    return VOS_PARAM_ERR;
+}
+
+/*    AF_XDP    */
+
+/**********************************************************************************************************************/
+/** Open an AF_XDP socket for the UDP datagrams to a port.
+ *
+ *  @param[out]     pXdp            returns NULL
+ *  @param[in]      pIfName         interface name
+ *  @param[in]      queueId         receive queue of the interface
+ *  @param[in]      port            UDP destination port
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpOpen (
+    VOS_XDP_T       *pXdp,
+    const CHAR8     *pIfName,
+    UINT32          queueId,
+    UINT16          port)
+{
+    (void) pIfName;
+    (void) queueId;
+    (void) port;
+    if (pXdp != NULL)
+    {
+        *pXdp = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "AF_XDP is not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams from an AF_XDP socket.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpReceive (
+    VOS_XDP_T       xdp,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    (void) xdp;
+    (void) pMsgs;
+    (void) maxMsgs;
+    if (pNoMsgs != NULL)
+    {
+        *pNoMsgs = 0u;
+    }
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of an AF_XDP socket.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *  @param[out]     pFd             descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpGetFd (
+    VOS_XDP_T   xdp,
+    SOCKET      *pFd)
+{
+    (void) xdp;
+    (void) pFd;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Close an AF_XDP socket.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpClose (
+    VOS_XDP_T xdp)
+{
+    (void) xdp;
+    return VOS_PARAM_ERR;
+}
+
+/*    io_uring    */
+
+/**********************************************************************************************************************/
+/** Open an io_uring for receiving and sending UDP datagrams.
+ *
+ *  @param[out]     pRing           returns NULL
+ *  @param[in]      noOfBuffers     number of receive buffers
+ *  @param[in]      bufSize         size of a receive buffer
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringOpen (
+    VOS_URING_T *pRing,
+    UINT32      noOfBuffers,
+    UINT32      bufSize)
+{
+    (void) noOfBuffers;
+    (void) bufSize;
+    if (pRing != NULL)
+    {
+        *pRing = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "io_uring is not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Start receiving from a UDP socket through an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringAddRecv (
+    VOS_URING_T ring,
+    SOCKET      sock)
+{
+    (void) ring;
+    (void) sock;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop receiving from a UDP socket through an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringRemoveRecv (
+    VOS_URING_T ring,
+    SOCKET      sock)
+{
+    (void) ring;
+    (void) sock;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams from the sockets of an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pSocks          array of receiving sockets
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringReceive (
+    VOS_URING_T     ring,
+    SOCKET          *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    (void) ring;
+    (void) pSocks;
+    (void) pMsgs;
+    (void) maxMsgs;
+    if (pNoMsgs != NULL)
+    {
+        *pNoMsgs = 0u;
+    }
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Send several UDP datagrams, possibly on different sockets, with one call.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      pSocks          array of sending sockets
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringSend (
+    VOS_URING_T     ring,
+    const SOCKET    *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs)
+{
+    (void) ring;
+    (void) pSocks;
+    (void) pMsgs;
+    (void) noMsgs;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pFd             descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringGetFd (
+    VOS_URING_T ring,
+    SOCKET      *pFd)
+{
+    (void) ring;
+    (void) pFd;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Close an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringClose (
+    VOS_URING_T ring)
+{
+    (void) ring;
+    return VOS_PARAM_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Get a list of interface addresses
  *  The caller has to provide an array of interface records to be filled.
@@ -434,6 +1049,16 @@ EXT_DECL BOOL8 vos_netIfUp (
 EXT_DECL VOS_ERR_T vos_sockInit (void)
 {
     memset(&gIfr, 0, sizeof(gIfr));
+#if VOS_SOCK_ZBUF
+    if (sZbufFilterSem == NULL)
+    {
+        sZbufFilterSem = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE);
+        if (sZbufFilterSem == NULL)
+        {
+            return VOS_SOCK_ERR;
+        }
+    }
+#endif
     vosSockInitialised = TRUE;
 
     return VOS_NO_ERR;
@@ -592,6 +1217,9 @@ EXT_DECL VOS_ERR_T vos_sockOpenTCP (
 EXT_DECL VOS_ERR_T vos_sockClose (
     SOCKET sock)
 {
+#if VOS_SOCK_ZBUF
+    zbufFilterRemove(sock);
+#endif
     if (close(sock) == -1)
     {
         vos_printLog(VOS_LOG_ERROR,
@@ -735,6 +1363,18 @@ EXT_DECL VOS_ERR_T vos_sockSetOptions (
                 vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_NO_CHECK failed (Err: %s)\n", buff);
             }
         }
+#endif
+#ifdef TCP_NODELAY
+        if (pOptions->tcpNoDelay == TRUE)
+        {
+            sockOptValue = 1;
+            if (setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (char *)&sockOptValue, sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() TCP_NODELAY failed (Err: %s)\n", buff);
+            }
+        }
 #endif
     }
     /*  Include struct in_pktinfo in the message "ancilliary" control data.
@@ -842,72 +1482,281 @@ EXT_DECL VOS_ERR_T vos_sockJoinMC (
         result = VOS_PARAM_ERR;
     }
 
-    return result;
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Leave a multicast group.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group to join
+ *  @param[in]      ipAddress       depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  ipAddress)
+{
+    struct ip_mreq  mreq;
+    VOS_ERR_T       result = VOS_NO_ERR;
+
+    if (sock == -1)
+    {
+        result = VOS_PARAM_ERR;
+    }
+    /* Is this a multicast address? */
+    else if (IN_MULTICAST(mcAddress))
+    {
+        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
+        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+
+        {
+            char    mcStr[16];
+            char    ifStr[16];
+
+            strncpy(mcStr, inet_ntoa(mreq.imr_multiaddr), sizeof(mcStr));
+            mcStr[sizeof(mcStr) - 1] = 0;
+            strncpy(ifStr, inet_ntoa(mreq.imr_interface), sizeof(ifStr));
+            ifStr[sizeof(ifStr) - 1] = 0;
+
+            vos_printLog(VOS_LOG_INFO, "leaving MC: %s on iface %s\n", mcStr, ifStr);
+        }
+
+        /*errno = 0;*/
+        if (setsockopt(sock, IPPROTO_IP, IP_DROP_MEMBERSHIP, (char *) &mreq, sizeof(mreq)) == -1)
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_DROP_MEMBERSHIP failed (Err: %s)\n", buff);
+
+            result = VOS_SOCK_ERR;
+        }
+        else
+        {
+            result = VOS_NO_ERR;
+        }
+    }
+    else
+    {
+        result = VOS_PARAM_ERR;
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Install a receive filter.
+ *  With VOS_SOCK_ZBUF, datagrams are received as zbufs and checked in the network buffers; dropped datagrams are
+ *  never copied (filter semantics as vos_sockSetFilter of the POSIX target). Otherwise receive filters are not
+ *  supported on this target, the datagrams are filtered after reception.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      pFilter           filter to install, NULL to remove the filter
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR       out of memory
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetFilter (
+    SOCKET                  sock,
+    const VOS_SOCK_FILTER_T *pFilter)
+{
+#if VOS_SOCK_ZBUF
+    VOS_ZBUF_FILTER_T *pNew;
+
+    if ((pFilter != NULL) &&
+        ((pFilter->noOfTypes > VOS_SOCK_FILTER_TYPES) || ((pFilter->pEntries == NULL) && (pFilter->noOfEntries > 0u))))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    zbufFilterRemove(sock);
+    if (pFilter == NULL)
+    {
+        return VOS_NO_ERR;
+    }
+
+    pNew = (VOS_ZBUF_FILTER_T *) vos_memAlloc(sizeof(VOS_ZBUF_FILTER_T) +
+                                              pFilter->noOfEntries * sizeof(VOS_SOCK_FILTER_ENTRY_T));
+    if (pNew == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    pNew->sock              = sock;
+    pNew->filter            = *pFilter;
+    pNew->filter.pEntries   = (const VOS_SOCK_FILTER_ENTRY_T *) (pNew + 1);
+    if (pFilter->noOfEntries > 0u)
+    {
+        memcpy(pNew + 1, pFilter->pEntries, pFilter->noOfEntries * sizeof(VOS_SOCK_FILTER_ENTRY_T));
+    }
+
+    (void) semTake(sZbufFilterSem, WAIT_FOREVER);
+    pNew->pNext     = sZbufFilters;
+    sZbufFilters    = pNew;
+    (void) semGive(sZbufFilterSem);
+    return VOS_NO_ERR;
+#else
+    (void) sock;
+    return (pFilter == NULL) ? VOS_NO_ERR : VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Steer the datagrams of a group of sockets bound to the same address and port.
+ *  Steering is not supported on this target.
+ *
+ *  @param[in]      sock              socket descriptor, any socket of the group
+ *  @param[in]      keyOffset         payload offset of the 32 bit key field (network byte order)
+ *  @param[in]      noOfSocks         number of sockets of the group
+ *
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetSteering (
+    SOCKET  sock,
+    UINT16  keyOffset,
+    UINT32  noOfSocks)
+{
+    (void) sock;
+    (void) keyOffset;
+    (void) noOfSocks;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Cork or uncork a TCP socket.
+ *  Corking is not supported on this target.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      cork              TRUE: hold back partial segments, FALSE: send pending data
+ *
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetCork (
+    SOCKET  sock,
+    BOOL8   cork)
+{
+    (void) sock;
+    (void) cork;
+    return VOS_SOCK_ERR;
 }
 
 /**********************************************************************************************************************/
-/** Leave a multicast group.
- *  Note: Some targeted systems might not support this option.
+/** Get the state of the receive queue of a socket.
+ *  VxWorks reports the pending bytes and the buffer size, not the drops.
  *
- *  @param[in]      sock            socket descriptor
- *  @param[in]      mcAddress       multicast group to join
- *  @param[in]      ipAddress       depicts interface on which to leave, default 0 for any
+ *  @param[in]      sock              socket descriptor
+ *  @param[out]     pQueue            receive queue state
  *
- *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
- *  @retval         VOS_SOCK_ERR    option not supported
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
  */
 
-EXT_DECL VOS_ERR_T vos_sockLeaveMC (
-    SOCKET  sock,
-    UINT32  mcAddress,
-    UINT32  ipAddress)
+EXT_DECL VOS_ERR_T vos_sockGetRxQueue (
+    SOCKET          sock,
+    VOS_SOCK_RXQ_T  *pQueue)
 {
-    struct ip_mreq  mreq;
-    VOS_ERR_T       result = VOS_NO_ERR;
+    int optval  = 0;
+    int optLen  = sizeof(optval);
+    int pending = 0;
 
-    if (sock == -1)
+    if ((sock == -1) || (pQueue == NULL))
     {
-        result = VOS_PARAM_ERR;
+        return VOS_PARAM_ERR;
     }
-    /* Is this a multicast address? */
-    else if (IN_MULTICAST(mcAddress))
+    if ((getsockopt(sock, SOL_SOCKET, SO_RCVBUF, (char *) &optval, &optLen) == -1) ||
+        (ioctl(sock, FIONREAD, &pending) == -1))
     {
-        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
-        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
-
-        {
-            char    mcStr[16];
-            char    ifStr[16];
-
-            strncpy(mcStr, inet_ntoa(mreq.imr_multiaddr), sizeof(mcStr));
-            mcStr[sizeof(mcStr) - 1] = 0;
-            strncpy(ifStr, inet_ntoa(mreq.imr_interface), sizeof(ifStr));
-            ifStr[sizeof(ifStr) - 1] = 0;
+        return VOS_SOCK_ERR;
+    }
+    pQueue->drops   = 0u;
+    pQueue->queued  = (UINT32) pending;
+    pQueue->bufSize = (UINT32) optval;
+    return VOS_NO_ERR;
+}
 
-            vos_printLog(VOS_LOG_INFO, "leaving MC: %s on iface %s\n", mcStr, ifStr);
-        }
+/**********************************************************************************************************************/
+/** Set the size of the receive buffer of a socket.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      size              receive buffer size
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_SOCK_ERR      size could not be set
+ */
 
-        /*errno = 0;*/
-        if (setsockopt(sock, IPPROTO_IP, IP_DROP_MEMBERSHIP, (char *) &mreq, sizeof(mreq)) == -1)
-        {
-            char buff[VOS_MAX_ERR_STR_SIZE];
-            STRING_ERR(buff);
-            vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_DROP_MEMBERSHIP failed (Err: %s)\n", buff);
+EXT_DECL VOS_ERR_T vos_sockSetRcvBuffer (
+    SOCKET  sock,
+    UINT32  size)
+{
+    int optval = (int) size;
 
-            result = VOS_SOCK_ERR;
-        }
-        else
-        {
-            result = VOS_NO_ERR;
-        }
-    }
-    else
+    if (setsockopt(sock, SOL_SOCKET, SO_RCVBUF, (char *) &optval, sizeof(optval)) == -1)
     {
-        result = VOS_PARAM_ERR;
+        vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_RCVBUF failed (Err: %d)\n", errno);
+        return VOS_SOCK_ERR;
     }
+    return VOS_NO_ERR;
+}
 
-    return result;
+/**********************************************************************************************************************/
+/** Join a multicast group for one source only (source specific multicast, IGMPv3).
+ *  Source specific memberships are not supported on this target, the caller falls back to vos_sockJoinMC().
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to join
+ *  @param[in]      srcAddress        source to receive from
+ *  @param[in]      ipAddress         depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    (void) sock;
+    (void) mcAddress;
+    (void) srcAddress;
+    (void) ipAddress;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Leave a source specific multicast membership.
+ *  Source specific memberships are not supported on this target.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to leave
+ *  @param[in]      srcAddress        source joined with vos_sockJoinSourceMC
+ *  @param[in]      ipAddress         depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    (void) sock;
+    (void) mcAddress;
+    (void) srcAddress;
+    (void) ipAddress;
+    return VOS_SOCK_ERR;
 }
 
 /**********************************************************************************************************************/
@@ -984,6 +1833,79 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send UDP data at a given time.
+ *  Launch times are not supported on this target, the datagram is sent immediately.
+ *
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      pBuffer            pointer to data to send
+ *  @param[in,out]  pSize              In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress          destination IP
+ *  @param[in]      port               destination port
+ *  @param[in]      pLaunchTime        transmit time (ignored)
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ *  @retval         VOS_IO_ERR         data could not be sent
+ *  @retval         VOS_BLOCK_ERR      Call would have blocked in blocking mode
+ */
+EXT_DECL VOS_ERR_T vos_sockSendUDPAt (
+    SOCKET              sock,
+    const UINT8         *pBuffer,
+    UINT32              *pSize,
+    UINT32              ipAddress,
+    UINT16              port,
+    const VOS_TIMEVAL_T *pLaunchTime)
+{
+    (void) pLaunchTime;
+    return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+}
+
+/**********************************************************************************************************************/
+/** Send several UDP datagrams with one call.
+ *  Fallback implementation: vos_sockSendUDP() is called for each datagram.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (size in: to send, out: bytes sent)
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    VOS_ERR_T   result;
+    UINT32      i;
+
+    if (pMsgs == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    for (i = 0u; i < noMsgs; i++)
+    {
+        if (err == VOS_BLOCK_ERR)
+        {
+            pMsgs[i].size = 0u;
+            continue;
+        }
+        result = vos_sockSendUDP(sock, pMsgs[i].pBuffer, &pMsgs[i].size, pMsgs[i].dstIPAddr, pMsgs[i].dstIPPort);
+        if (result != VOS_NO_ERR)
+        {
+            pMsgs[i].size   = 0u;
+            err             = result;
+        }
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -1034,6 +1956,18 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
         return VOS_PARAM_ERR;
     }
 
+#if VOS_SOCK_ZBUF
+    if (peek == FALSE)
+    {
+        VOS_ERR_T err = zbufReceive(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr);
+
+        if (err != VOS_UNKNOWN_ERR)
+        {
+            return err;
+        }
+    }
+#endif
+
     /* clear our address buffers */
     memset(&msg, 0, sizeof(msg));
     memset(&control_un, 0, sizeof(control_un));
@@ -1126,6 +2060,190 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     }
 }
 
+/**********************************************************************************************************************/
+/** Receive UDP data with its reception time.
+ *  As vos_sockReceiveUDP(), additionally the time the datagram was received is reported.
+ *  Receive time stamps are not supported by this target, the time of the call is reported.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[in]      peek            if true, leave data in queue
+ *  @param[out]     pRxTime         pointer to the reception time (time base of vos_getTime), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPTime (
+    SOCKET          sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    BOOL8           peek,
+    VOS_TIMEVAL_T   *pRxTime)
+{
+    VOS_ERR_T err = vos_sockReceiveUDP(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, peek);
+
+    if ((err == VOS_NO_ERR) && (pRxTime != NULL))
+    {
+        vos_getTime(pRxTime);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams with one call.
+ *  Fallback implementation: vos_sockReceiveUDP() is called until maxMsgs datagrams were read or no more data is
+ *  pending. Use a non-blocking socket if maxMsgs is greater than one.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (buffer and size in, size and addresses out)
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      i;
+
+    if ((pMsgs == NULL) || (pNoMsgs == NULL) || (maxMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pNoMsgs = 0u;
+
+    for (i = 0u; (i < maxMsgs) && (i < VOS_MAX_SOCK_BATCH); i++)
+    {
+        err = vos_sockReceiveUDPTime(sock,
+                                     pMsgs[i].pBuffer,
+                                     &pMsgs[i].size,
+                                     &pMsgs[i].srcIPAddr,
+                                     &pMsgs[i].srcIPPort,
+                                     &pMsgs[i].dstIPAddr,
+                                     FALSE,
+                                     &pMsgs[i].rxTime);
+        if ((err != VOS_NO_ERR) || (pMsgs[i].size == 0u))
+        {
+            break;
+        }
+        (*pNoMsgs)++;
+    }
+
+    return (*pNoMsgs > 0u) ? VOS_NO_ERR : err;
+}
+
+/**********************************************************************************************************************/
+/** Send consecutive UDP datagrams of equal size from one buffer.
+ *  There is no segmentation offload on this target, the datagrams are sent one by one.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to the datagrams to send
+ *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      segSize         size of one datagram
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPSeg (
+    SOCKET      sock,
+    const UINT8 *pBuffer,
+    UINT32      *pSize,
+    UINT32      segSize,
+    UINT32      ipAddress,
+    UINT16      port)
+{
+    VOS_ERR_T   err     = VOS_NO_ERR;
+    UINT32      done    = 0u;
+    UINT32      size;
+    UINT32      chunk;
+
+    if ((pBuffer == NULL) || (pSize == NULL) || (segSize == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    size    = *pSize;
+    *pSize  = 0u;
+
+    while ((done < size) && (err == VOS_NO_ERR))
+    {
+        chunk = size - done;
+        if (chunk > segSize)
+        {
+            chunk = segSize;
+        }
+        err = vos_sockSendUDP(sock, pBuffer + done, &chunk, ipAddress, port);
+        done    += chunk;
+        *pSize  = done;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP datagrams the kernel may have coalesced.
+ *  There is no receive offload on this target, one datagram is read and *pSegSize is its size.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSegSize        pointer to the size of one datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPSeg (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pSegSize,
+    UINT32  *pSrcIPAddr,
+    UINT16  *pSrcIPPort,
+    UINT32  *pDstIPAddr)
+{
+    VOS_ERR_T err;
+
+    if (pSegSize == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    err = vos_sockReceiveUDP(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, FALSE);
+    *pSegSize = (pSize != NULL) ? *pSize : 0u;
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -1403,6 +2521,51 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data gathered from several buffers.
+ *  Fallback implementation: vos_sockSendTCP() is called for each segment.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pSegs           array of buffer segments
+ *  @param[in]      noSegs          number of entries in pSegs (at most VOS_MAX_SOCK_SEGS)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET                  sock,
+    const VOS_SOCK_SEG_T    *pSegs,
+    UINT32                  noSegs,
+    UINT32                  *pSize)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      segSize;
+    UINT32      i;
+
+    if ((pSegs == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0u;
+    for (i = 0u; (i < noSegs) && (err == VOS_NO_ERR); i++)
+    {
+        segSize = pSegs[i].size;
+        if (segSize == 0u)
+        {
+            continue;
+        }
+        err     = vos_sockSendTCP(sock, pSegs[i].pBuffer, &segSize);
+        *pSize  += segSize;
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
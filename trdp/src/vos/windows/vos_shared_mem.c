@@ -204,6 +204,31 @@ EXT_DECL VOS_ERR_T vos_sharedOpen (
     return retVal;
 }
 
+/**********************************************************************************************************************/
+/** Attach to an existing shared memory area.
+*  Not implemented, vos_sharedOpen() attaches to an existing file mapping on this target.
+*  The area must have been created by vos_sharedOpen(), its contents are left intact.
+*    This function is not available in each target implementation.
+*
+*  @param[in]      pKey               Unique identifier (file name)
+*  @param[out]     pHandle            Pointer to returned handle
+*  @param[out]     ppMemoryArea       Pointer to pointer to memory area
+*  @param[out]     pSize              Pointer to actual size of the area
+*  @retval         VOS_UNKNOWN_ERR    not implemented
+*/
+EXT_DECL VOS_ERR_T vos_sharedAttach (
+    const CHAR8 *pKey,
+    VOS_SHRD_T  *pHandle,
+    UINT8       * *ppMemoryArea,
+    UINT32      *pSize)
+{
+    (void) pKey;
+    (void) pHandle;
+    (void) ppMemoryArea;
+    (void) pSize;
+    return VOS_UNKNOWN_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Close connection to the shared memory area.
 *  If the area was created by the calling process, the area will be closed (freed). If the area was attached,
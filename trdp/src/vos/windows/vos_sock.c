@@ -35,6 +35,8 @@
  * INCLUDES
  */
 
+#define VOS_SOCK_BYTE_ORDER_FUNCTIONS   /* vos_htonl() etc. are implemented here, see vos_sock.h */
+
 #include <stdio.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -87,6 +89,25 @@
 #define CMSG_FIRSTHDR   WSA_CMSG_FIRSTHDR
 #define CMSGSize        64       /* size of buffer for destination address */
 
+#ifndef VOS_SOCK_IOCP           /**< Batched receive by overlapped I/O and a completion port, 0: vos_sockReceiveUDP loop */
+#define VOS_SOCK_IOCP   1
+#endif
+
+#if VOS_SOCK_IOCP
+/** Overlapped receive state of a socket, created by the first vos_sockReceiveUDPBatch() on it  */
+typedef struct VOS_IOCP_SOCK
+{
+    struct VOS_IOCP_SOCK    *pNext;
+    SOCKET                  sock;
+    HANDLE                  iocp;                                   /**< completion port of this socket only    */
+    WSAOVERLAPPED           ov[VOS_MAX_SOCK_BATCH];
+    WSAMSG                  msg[VOS_MAX_SOCK_BATCH];
+    WSABUF                  buf[VOS_MAX_SOCK_BATCH];
+    struct sockaddr_in      srcAddr[VOS_MAX_SOCK_BATCH];
+    char                    control[VOS_MAX_SOCK_BATCH][CMSGSize];
+} VOS_IOCP_SOCK_T;
+#endif
+
 /***********************************************************************************************************************
  *  LOCALS
  */
@@ -94,11 +115,45 @@
 BOOL8   vosSockInitialised = FALSE;
 UINT8   mac[VOS_MAC_SIZE];
 
+static LPFN_WSARECVMSG  sWSARecvMsg = NULL;     /* extension function, the same for all UDP sockets */
+
+#if VOS_SOCK_IOCP
+static CRITICAL_SECTION sIocpLock;
+static VOS_IOCP_SOCK_T  *sIocpSockets = NULL;
+#endif
+
 
 /***********************************************************************************************************************
  * LOCAL FUNCTIONS
  */
 
+/**********************************************************************************************************************/
+/** Get the WSARecvMsg extension function.
+ *  The pointer is looked up once and kept, instead of one WSAIoctl per received datagram.
+ *
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         function pointer, NULL on error
+ */
+static LPFN_WSARECVMSG getWSARecvMsg (SOCKET sock)
+{
+    GUID            WSARecvMsg_GUID = WSAID_WSARECVMSG;
+    LPFN_WSARECVMSG WSARecvMsg      = sWSARecvMsg;
+    DWORD           numBytes        = 0;
+
+    if (WSARecvMsg == NULL)
+    {
+        if (WSAIoctl(sock, SIO_GET_EXTENSION_FUNCTION_POINTER,
+                     &WSARecvMsg_GUID, sizeof(WSARecvMsg_GUID), &WSARecvMsg,
+                     sizeof(WSARecvMsg), &numBytes, NULL, NULL) != 0)
+        {
+            return NULL;
+        }
+        sWSARecvMsg = WSARecvMsg;
+    }
+    return WSARecvMsg;
+}
+
 /**********************************************************************************************************************/
 /** Receive a message including sender address information.
  *
@@ -110,13 +165,14 @@ UINT8   mac[VOS_MAC_SIZE];
  */
 INT32 recvmsg (SOCKET sock, struct msghdr *pMessage, int flags)
 {
-    GUID    WSARecvMsg_GUID = WSAID_WSARECVMSG;
-    LPFN_WSARECVMSG WSARecvMsg;
-    DWORD   numBytes    = 0;
-    int     res         = WSAIoctl(sock, SIO_GET_EXTENSION_FUNCTION_POINTER,
-                                   &WSARecvMsg_GUID, sizeof(WSARecvMsg_GUID), &WSARecvMsg,
-                                   sizeof(WSARecvMsg), &numBytes, NULL, NULL);
+    LPFN_WSARECVMSG WSARecvMsg  = getWSARecvMsg(sock);
+    DWORD           numBytes    = 0;
+    int             res;
 
+    if (WSARecvMsg == NULL)
+    {
+        return -1;
+    }
     pMessage->dwFlags = flags;
     res = WSARecvMsg(sock, pMessage, &numBytes, NULL, NULL);
     if (0 != res)
@@ -130,6 +186,250 @@ INT32 recvmsg (SOCKET sock, struct msghdr *pMessage, int flags)
     return numBytes;
 }
 
+#if VOS_SOCK_IOCP
+/**********************************************************************************************************************/
+/** Get the overlapped receive state of a socket, create it on first use.
+ *  Every socket gets its own completion port, so threads receiving on different sockets do not take each other's
+ *  completions.
+ *
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         pointer to the state, NULL on error
+ */
+static VOS_IOCP_SOCK_T *iocpSocket (SOCKET sock)
+{
+    VOS_IOCP_SOCK_T *pIocp;
+
+    EnterCriticalSection(&sIocpLock);
+    for (pIocp = sIocpSockets; pIocp != NULL; pIocp = pIocp->pNext)
+    {
+        if (pIocp->sock == sock)
+        {
+            LeaveCriticalSection(&sIocpLock);
+            return pIocp;
+        }
+    }
+
+    pIocp = (VOS_IOCP_SOCK_T *) vos_memAlloc(sizeof(VOS_IOCP_SOCK_T));
+    if (pIocp != NULL)
+    {
+        pIocp->sock = sock;
+        pIocp->iocp = CreateIoCompletionPort((HANDLE) sock, NULL, (ULONG_PTR) sock, 1);
+        if (pIocp->iocp == NULL)
+        {
+            vos_printLog(VOS_LOG_WARNING, "CreateIoCompletionPort() failed (Err: %d)\n", (int) GetLastError());
+            vos_memFree(pIocp);
+            pIocp = NULL;
+        }
+        else
+        {
+            pIocp->pNext    = sIocpSockets;
+            sIocpSockets    = pIocp;
+        }
+    }
+    LeaveCriticalSection(&sIocpLock);
+    return pIocp;
+}
+
+/**********************************************************************************************************************/
+/** Release the overlapped receive state of a socket.
+ *
+ *  @param[in]      sock            socket descriptor
+ */
+static void iocpRelease (SOCKET sock)
+{
+    VOS_IOCP_SOCK_T **ppIocp;
+    VOS_IOCP_SOCK_T *pIocp;
+
+    EnterCriticalSection(&sIocpLock);
+    for (ppIocp = &sIocpSockets; *ppIocp != NULL; ppIocp = &(*ppIocp)->pNext)
+    {
+        if ((*ppIocp)->sock == sock)
+        {
+            pIocp   = *ppIocp;
+            *ppIocp = pIocp->pNext;
+            (void) CloseHandle(pIocp->iocp);
+            vos_memFree(pIocp);
+            break;
+        }
+    }
+    LeaveCriticalSection(&sIocpLock);
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams by overlapped receives.
+ *  Receives are posted until one has to wait, that one is cancelled, then all completions are taken from the
+ *  completion port with as few calls as possible. No receive stays posted after the call, hence datagrams
+ *  arriving later are signalled by select() as usual.
+ *
+ *  @param[in]      pIocp           overlapped receive state of the socket
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      maxMsgs         number of entries in pMsgs, at most VOS_MAX_SOCK_BATCH
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received (or ICMP port unreachable)
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_BLOCK_ERR   no data pending
+ */
+static VOS_ERR_T iocpReceive (
+    VOS_IOCP_SOCK_T *pIocp,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    LPFN_WSARECVMSG     WSARecvMsg = getWSARecvMsg(pIocp->sock);
+    OVERLAPPED_ENTRY    entries[VOS_MAX_SOCK_BATCH];
+    BOOL                done[VOS_MAX_SOCK_BATCH];
+    VOS_TIMEVAL_T       now;
+    VOS_ERR_T           err         = VOS_BLOCK_ERR;
+    UINT32              posted      = 0u;   /* slots used          */
+    UINT32              pending     = 0u;   /* completions to take */
+    UINT32              harvested   = 0u;
+    UINT32              i;
+    ULONG               noEntries;
+    ULONG               j;
+    int                 lastErr = 0;
+
+    if (WSARecvMsg == NULL)
+    {
+        return VOS_IO_ERR;
+    }
+
+    /*  Post receives as long as datagrams are queued, the first one which has to wait ends the batch  */
+    while (posted < maxMsgs)
+    {
+        i = posted;
+        memset(&pIocp->ov[i], 0, sizeof(WSAOVERLAPPED));
+        memset(&pIocp->srcAddr[i], 0, sizeof(struct sockaddr_in));
+        pIocp->buf[i].buf           = (CHAR *) pMsgs[i].pBuffer;
+        pIocp->buf[i].len           = pMsgs[i].size;
+        pIocp->msg[i].name          = (struct sockaddr *) &pIocp->srcAddr[i];
+        pIocp->msg[i].namelen       = sizeof(struct sockaddr_in);
+        pIocp->msg[i].lpBuffers     = &pIocp->buf[i];
+        pIocp->msg[i].dwBufferCount = 1;
+        pIocp->msg[i].Control.buf   = pIocp->control[i];
+        pIocp->msg[i].Control.len   = CMSGSize;
+        pIocp->msg[i].dwFlags       = 0;
+        done[i] = FALSE;
+        posted++;
+
+        if (WSARecvMsg(pIocp->sock, &pIocp->msg[i], NULL, &pIocp->ov[i], NULL) == 0)
+        {
+            pending++;
+            continue;
+        }
+        lastErr = WSAGetLastError();
+        if (lastErr == WSA_IO_PENDING)
+        {
+            /*  Nothing queued any more: take this one back  */
+            pending++;
+            (void) CancelIoEx((HANDLE) pIocp->sock, &pIocp->ov[i]);
+            break;
+        }
+        posted--;
+        if (lastErr == WSAECONNRESET)
+        {
+            /* ICMP port unreachable received (result of previous send), treat this as no error */
+            err = VOS_NO_ERR;
+            continue;
+        }
+        if (lastErr == WSAEMSGSIZE)
+        {
+            /*  Truncated datagram, dropped: use the slot for the next one  */
+            continue;
+        }
+        break;
+    }
+
+    /*  Every receive which did not fail immediately completes exactly once, successfully or cancelled  */
+    while (harvested < pending)
+    {
+        if (!GetQueuedCompletionStatusEx(pIocp->iocp, entries, (ULONG) (pending - harvested), &noEntries,
+                                         INFINITE, FALSE))
+        {
+            vos_printLog(VOS_LOG_ERROR, "GetQueuedCompletionStatusEx() failed (Err: %d)\n", (int) GetLastError());
+            return VOS_IO_ERR;
+        }
+        for (j = 0; j < noEntries; j++)
+        {
+            i = (UINT32) ((WSAOVERLAPPED *) entries[j].lpOverlapped - pIocp->ov);
+            if ((i < posted) && !done[i])
+            {
+                done[i] = TRUE;
+                harvested++;
+            }
+        }
+    }
+
+    vos_getTime(&now);
+    *pNoMsgs = 0u;
+
+    /*  Report in posting order, which is the order the datagrams were queued. Datagrams stay in the buffer they
+        were received into, unless an earlier slot failed: the caller expects them in its first buffers.  */
+    for (i = 0u; i < posted; i++)
+    {
+        DWORD       flags = 0;
+        DWORD       size;
+        WSACMSGHDR  *pCMsgHdr;
+
+        if (!done[i])
+        {
+            continue;
+        }
+        if (!WSAGetOverlappedResult(pIocp->sock, &pIocp->ov[i], &size, FALSE, &flags))
+        {
+            lastErr = WSAGetLastError();
+            if ((lastErr == WSA_OPERATION_ABORTED) || (lastErr == WSAEMSGSIZE))
+            {
+                continue;
+            }
+            if (lastErr == WSAECONNRESET)
+            {
+                /* ICMP port unreachable received (result of previous send), treat this as no error */
+                err = VOS_NO_ERR;
+                continue;
+            }
+            vos_printLog(VOS_LOG_ERROR, "WSARecvMsg() failed (Err: %d)\n", lastErr);
+            err = VOS_IO_ERR;
+            continue;
+        }
+
+        if (*pNoMsgs != i)
+        {
+            if (size > pIocp->buf[*pNoMsgs].len)
+            {
+                continue;
+            }
+            memcpy(pMsgs[*pNoMsgs].pBuffer, pMsgs[i].pBuffer, size);
+        }
+        pMsgs[*pNoMsgs].size        = (UINT32) size;
+        pMsgs[*pNoMsgs].srcIPAddr   = (UINT32) vos_ntohl(pIocp->srcAddr[i].sin_addr.s_addr);
+        pMsgs[*pNoMsgs].srcIPPort   = vos_ntohs(pIocp->srcAddr[i].sin_port);
+        pMsgs[*pNoMsgs].dstIPAddr   = 0u;
+        pMsgs[*pNoMsgs].rxTime      = now;
+
+        pCMsgHdr = WSA_CMSG_FIRSTHDR(&pIocp->msg[i]);
+        if ((pCMsgHdr != NULL) && (pCMsgHdr->cmsg_type == IP_PKTINFO))
+        {
+            struct in_pktinfo *pPktInfo = (struct in_pktinfo *) WSA_CMSG_DATA(pCMsgHdr);
+            pMsgs[*pNoMsgs].dstIPAddr = (UINT32) vos_ntohl(pPktInfo->ipi_addr.S_un.S_addr);
+        }
+        (*pNoMsgs)++;
+    }
+
+    if (*pNoMsgs > 0u)
+    {
+        return VOS_NO_ERR;
+    }
+    if ((posted == 0u) && (lastErr != 0) && (lastErr != WSAEWOULDBLOCK))
+    {
+        vos_printLog(VOS_LOG_ERROR, "WSARecvMsg() failed (Err: %d)\n", lastErr);
+        return VOS_IO_ERR;
+    }
+    return err;
+}
+#endif
+
 /**********************************************************************************************************************/
 /** Enlarge send and receive buffers to TRDP_SOCKBUF_SIZE if necessary.
  *
@@ -475,6 +775,365 @@ EXT_DECL INT32 vos_select (
                   (fd_set *) pErrorFD, (struct timeval *) pTimeOut);
 }
 
+/**********************************************************************************************************************/
+/** Create a poll set.
+ *  Poll sets are not supported on this target, select() has to be used.
+ *
+ *  @param[out]     pPoll           pointer to the handle of the poll set
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollCreate (
+    VOS_POLL_T *pPoll)
+{
+    if (pPoll != NULL)
+    {
+        *pPoll = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "poll sets are not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Add a socket to a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      tag             value to report for this socket
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollAdd (
+    VOS_POLL_T  poll,
+    SOCKET      sock,
+    UINT32      tag)
+{
+    (void) poll;
+    (void) sock;
+    (void) tag;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Remove a socket from a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollRemove (
+    VOS_POLL_T  poll,
+    SOCKET      sock)
+{
+    (void) poll;
+    (void) sock;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Wait for readable sockets of a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pTags           array to receive the tags of the readable sockets
+ *  @param[in,out]  pNoOfTags       in: size of pTags, out: number of readable sockets
+ *  @param[in]      pTimeOut        pointer to time out value
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollWait (
+    VOS_POLL_T          poll,
+    UINT32              *pTags,
+    UINT32              *pNoOfTags,
+    const VOS_TIMEVAL_T *pTimeOut)
+{
+    (void) poll;
+    (void) pTags;
+    (void) pTimeOut;
+    if (pNoOfTags != NULL)
+    {
+        *pNoOfTags = 0u;
+    }
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *  @param[out]     pFd             pointer to the descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollGetFd (
+    VOS_POLL_T  poll,
+    SOCKET      *pFd)
+{
+    (void) poll;
+    (void) pFd;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Delete a poll set.
+ *
+ *  @param[in]      poll            handle of the poll set
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_pollDelete (
+    VOS_POLL_T poll)
+{
+    (void) poll;
+    return VOS_PARAM_ERR;
+}
+
+/*    AF_XDP    */
+
+/**********************************************************************************************************************/
+/** Open an AF_XDP socket for the UDP datagrams to a port.
+ *
+ *  @param[out]     pXdp            returns NULL
+ *  @param[in]      pIfName         interface name
+ *  @param[in]      queueId         receive queue of the interface
+ *  @param[in]      port            UDP destination port
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpOpen (
+    VOS_XDP_T       *pXdp,
+    const CHAR8     *pIfName,
+    UINT32          queueId,
+    UINT16          port)
+{
+    (void) pIfName;
+    (void) queueId;
+    (void) port;
+    if (pXdp != NULL)
+    {
+        *pXdp = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "AF_XDP is not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams from an AF_XDP socket.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpReceive (
+    VOS_XDP_T       xdp,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    (void) xdp;
+    (void) pMsgs;
+    (void) maxMsgs;
+    if (pNoMsgs != NULL)
+    {
+        *pNoMsgs = 0u;
+    }
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of an AF_XDP socket.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *  @param[out]     pFd             descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpGetFd (
+    VOS_XDP_T   xdp,
+    SOCKET      *pFd)
+{
+    (void) xdp;
+    (void) pFd;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Close an AF_XDP socket.
+ *
+ *  @param[in]      xdp             handle of the AF_XDP socket
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_xdpClose (
+    VOS_XDP_T xdp)
+{
+    (void) xdp;
+    return VOS_PARAM_ERR;
+}
+
+/*    io_uring    */
+
+/**********************************************************************************************************************/
+/** Open an io_uring for receiving and sending UDP datagrams.
+ *
+ *  @param[out]     pRing           returns NULL
+ *  @param[in]      noOfBuffers     number of receive buffers
+ *  @param[in]      bufSize         size of a receive buffer
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringOpen (
+    VOS_URING_T *pRing,
+    UINT32      noOfBuffers,
+    UINT32      bufSize)
+{
+    (void) noOfBuffers;
+    (void) bufSize;
+    if (pRing != NULL)
+    {
+        *pRing = NULL;
+    }
+    vos_printLogStr(VOS_LOG_WARNING, "io_uring is not supported on this target\n");
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Start receiving from a UDP socket through an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringAddRecv (
+    VOS_URING_T ring,
+    SOCKET      sock)
+{
+    (void) ring;
+    (void) sock;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop receiving from a UDP socket through an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringRemoveRecv (
+    VOS_URING_T ring,
+    SOCKET      sock)
+{
+    (void) ring;
+    (void) sock;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams from the sockets of an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pSocks          array of receiving sockets
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringReceive (
+    VOS_URING_T     ring,
+    SOCKET          *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    (void) ring;
+    (void) pSocks;
+    (void) pMsgs;
+    (void) maxMsgs;
+    if (pNoMsgs != NULL)
+    {
+        *pNoMsgs = 0u;
+    }
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Send several UDP datagrams, possibly on different sockets, with one call.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[in]      pSocks          array of sending sockets
+ *  @param[in,out]  pMsgs           array of datagram descriptors
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringSend (
+    VOS_URING_T     ring,
+    const SOCKET    *pSocks,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs)
+{
+    (void) ring;
+    (void) pSocks;
+    (void) pMsgs;
+    (void) noMsgs;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the descriptor of an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *  @param[out]     pFd             descriptor
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringGetFd (
+    VOS_URING_T ring,
+    SOCKET      *pFd)
+{
+    (void) ring;
+    (void) pFd;
+    return VOS_PARAM_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Close an io_uring.
+ *
+ *  @param[in]      ring            handle of the ring
+ *
+ *  @retval         VOS_PARAM_ERR   not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_uringClose (
+    VOS_URING_T ring)
+{
+    (void) ring;
+    return VOS_PARAM_ERR;
+}
+
 /*    Sockets    */
 
 /**********************************************************************************************************************/
@@ -500,6 +1159,9 @@ EXT_DECL VOS_ERR_T vos_sockInit (void)
     }
 
     memset(mac, 0, sizeof(mac));
+#if VOS_SOCK_IOCP
+    InitializeCriticalSection(&sIocpLock);
+#endif
     vosSockInitialised = TRUE;
 
     return VOS_NO_ERR;
@@ -513,6 +1175,16 @@ EXT_DECL VOS_ERR_T vos_sockInit (void)
 
 EXT_DECL void vos_sockTerm (void)
 {
+#if VOS_SOCK_IOCP
+    if (vosSockInitialised)
+    {
+        while (sIocpSockets != NULL)
+        {
+            iocpRelease(sIocpSockets->sock);
+        }
+        DeleteCriticalSection(&sIocpLock);
+    }
+#endif
     vosSockInitialised = FALSE;
 }
 
@@ -733,6 +1405,9 @@ EXT_DECL VOS_ERR_T vos_sockClose (
         vos_printLog(VOS_LOG_ERROR, "closesocket() failed (Err: %d)\n", err);
         return VOS_PARAM_ERR;
     }
+#if VOS_SOCK_IOCP
+    iocpRelease(sock);
+#endif
     return VOS_NO_ERR;
 }
 
@@ -874,6 +1549,18 @@ EXT_DECL VOS_ERR_T vos_sockSetOptions (
                 vos_printLog(VOS_LOG_ERROR, "setsockopt() UDP_CHECKSUM_COVERAGE failed (Err: %d)\n", err);
             }
         }
+        if (pOptions->tcpNoDelay == TRUE)
+        {
+            DWORD optValue = TRUE;
+            if (setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char *)&optValue,
+                           sizeof(optValue)) == SOCKET_ERROR)
+            {
+                int err = WSAGetLastError();
+
+                err = err;     /* for lint */
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() TCP_NODELAY failed (Err: %d)\n", err);
+            }
+        }
 
     }
     /*   This seems to be unsupported on XP (but IP_RECVDSTADDR is defined!)   */
@@ -954,89 +1641,299 @@ EXT_DECL VOS_ERR_T vos_sockJoinMC (
             mreq.imr_multiaddr.s_addr   = 0;
             mreq.imr_interface.s_addr   = 0;
 
-            if (setsockopt((SOCKET)sock, IPPROTO_IP, IP_MULTICAST_LOOP, (const char *)&mreq, sizeof(mreq)) == SOCKET_ERROR)
-            {
-                int err = WSAGetLastError();
+            if (setsockopt((SOCKET)sock, IPPROTO_IP, IP_MULTICAST_LOOP, (const char *)&mreq, sizeof(mreq)) == SOCKET_ERROR)
+            {
+                int err = WSAGetLastError();
+
+                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_MULTICAST_LOOP failed (Err: %d)\n", result);
+                result = VOS_SOCK_ERR;
+            }
+            else
+            {
+                result = (result == VOS_SOCK_ERR) ? VOS_SOCK_ERR : VOS_NO_ERR;
+            }
+        }
+        */
+    }
+    else
+    {
+        result = VOS_PARAM_ERR;
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Leave a multicast group.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group to join
+ *  @param[in]      ipAddress       depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  ipAddress)
+{
+    struct ip_mreq  mreq;
+    VOS_ERR_T       result = VOS_NO_ERR;
+
+    if (sock == (SOCKET)INVALID_SOCKET )
+    {
+        result = VOS_PARAM_ERR;
+    }
+    /*    Is this a multicast address?    */
+    else if (IN_MULTICAST(mcAddress))
+    {
+
+        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
+        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+
+        {
+            char    mcStr[16];
+            char    ifStr[16];
+
+            (void) strcpy_s(mcStr, sizeof(mcStr), inet_ntoa(mreq.imr_multiaddr));
+            (void) strcpy_s(ifStr, sizeof(mcStr), inet_ntoa(mreq.imr_interface));
+            vos_printLog(VOS_LOG_INFO, "leaving MC: %s on iface %s\n", mcStr, ifStr);
+        }
+
+        if (setsockopt((SOCKET)sock, IPPROTO_IP, IP_DROP_MEMBERSHIP, (const char *)&mreq,
+                       sizeof(mreq)) == SOCKET_ERROR)
+        {
+            int err = WSAGetLastError();
+
+            err = err;     /* for lint */
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_DROP_MEMBERSHIP failed (Err: %d)\n", err);
+            result = VOS_SOCK_ERR;
+        }
+        else
+        {
+            result = VOS_NO_ERR;
+        }
+    }
+    else
+    {
+        result = VOS_PARAM_ERR;
+    }
+
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Join or leave a source specific multicast membership.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      join              TRUE to join, FALSE to leave
+ *  @param[in]      mcAddress         multicast group
+ *  @param[in]      srcAddress        source address
+ *  @param[in]      ipAddress         interface, 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+static VOS_ERR_T vos_sockSourceMC (
+    SOCKET  sock,
+    BOOL8   join,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    struct ip_mreq_source mreq;
+
+    if ((sock == (SOCKET)INVALID_SOCKET) || !IN_MULTICAST(mcAddress) || (srcAddress == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
+    mreq.imr_sourceaddr.s_addr  = vos_htonl(srcAddress);
+    mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+
+    if (setsockopt((SOCKET)sock, IPPROTO_IP, (join == TRUE) ? IP_ADD_SOURCE_MEMBERSHIP : IP_DROP_SOURCE_MEMBERSHIP,
+                   (const char *)&mreq, sizeof(mreq)) == SOCKET_ERROR)
+    {
+        int err = WSAGetLastError();
+
+        if ((join == FALSE) || (WSAEADDRINUSE != err))
+        {
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() %s failed (Err: %d)\n",
+                         (join == TRUE) ? "IP_ADD_SOURCE_MEMBERSHIP" : "IP_DROP_SOURCE_MEMBERSHIP", err);
+            return VOS_SOCK_ERR;
+        }
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Install a receive filter in the kernel.
+ *  Receive filters are not supported on this target, the datagrams are filtered after reception.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      pFilter           filter to install, NULL to remove the filter
+ *
+ *  @retval         VOS_NO_ERR        no filter to remove
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetFilter (
+    SOCKET                  sock,
+    const VOS_SOCK_FILTER_T *pFilter)
+{
+    (void) sock;
+    return (pFilter == NULL) ? VOS_NO_ERR : VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Steer the datagrams of a group of sockets bound to the same address and port.
+ *  Steering is not supported on this target.
+ *
+ *  @param[in]      sock              socket descriptor, any socket of the group
+ *  @param[in]      keyOffset         payload offset of the 32 bit key field (network byte order)
+ *  @param[in]      noOfSocks         number of sockets of the group
+ *
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetSteering (
+    SOCKET  sock,
+    UINT16  keyOffset,
+    UINT32  noOfSocks)
+{
+    (void) sock;
+    (void) keyOffset;
+    (void) noOfSocks;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Cork or uncork a TCP socket.
+ *  Corking is not supported on this target.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      cork              TRUE: hold back partial segments, FALSE: send pending data
+ *
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetCork (
+    SOCKET  sock,
+    BOOL8   cork)
+{
+    (void) sock;
+    (void) cork;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the state of the receive queue of a socket.
+ *  Windows reports the pending bytes and the buffer size, not the drops.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[out]     pQueue            receive queue state
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetRxQueue (
+    SOCKET          sock,
+    VOS_SOCK_RXQ_T  *pQueue)
+{
+    int     optval  = 0;
+    int     optLen  = sizeof(optval);
+    u_long  pending = 0;
 
-                vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_MULTICAST_LOOP failed (Err: %d)\n", result);
-                result = VOS_SOCK_ERR;
-            }
-            else
-            {
-                result = (result == VOS_SOCK_ERR) ? VOS_SOCK_ERR : VOS_NO_ERR;
-            }
-        }
-        */
+    if ((sock == (SOCKET)INVALID_SOCKET) || (pQueue == NULL))
+    {
+        return VOS_PARAM_ERR;
     }
-    else
+    if ((getsockopt(sock, SOL_SOCKET, SO_RCVBUF, (char *) &optval, &optLen) == SOCKET_ERROR) ||
+        (ioctlsocket(sock, (long) FIONREAD, &pending) == SOCKET_ERROR))
     {
-        result = VOS_PARAM_ERR;
+        return VOS_SOCK_ERR;
     }
-
-    return result;
+    pQueue->drops   = 0u;
+    pQueue->queued  = (UINT32) pending;
+    pQueue->bufSize = (UINT32) optval;
+    return VOS_NO_ERR;
 }
 
 /**********************************************************************************************************************/
-/** Leave a multicast group.
- *  Note: Some targeted systems might not support this option.
+/** Set the size of the receive buffer of a socket.
  *
- *  @param[in]      sock            socket descriptor
- *  @param[in]      mcAddress       multicast group to join
- *  @param[in]      ipAddress       depicts interface on which to leave, default 0 for any
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      size              receive buffer size
  *
- *  @retval         VOS_NO_ERR      no error
- *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
- *  @retval         VOS_SOCK_ERR    option not supported
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_SOCK_ERR      size could not be set
  */
 
-EXT_DECL VOS_ERR_T vos_sockLeaveMC (
+EXT_DECL VOS_ERR_T vos_sockSetRcvBuffer (
     SOCKET  sock,
-    UINT32  mcAddress,
-    UINT32  ipAddress)
+    UINT32  size)
 {
-    struct ip_mreq  mreq;
-    VOS_ERR_T       result = VOS_NO_ERR;
+    int optval = (int) size;
 
-    if (sock == (SOCKET)INVALID_SOCKET )
+    if (setsockopt(sock, SOL_SOCKET, SO_RCVBUF, (const char *) &optval, sizeof(optval)) == SOCKET_ERROR)
     {
-        result = VOS_PARAM_ERR;
+        vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_RCVBUF failed (Err: %d)\n", WSAGetLastError());
+        return VOS_SOCK_ERR;
     }
-    /*    Is this a multicast address?    */
-    else if (IN_MULTICAST(mcAddress))
-    {
-
-        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
-        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
-
-        {
-            char    mcStr[16];
-            char    ifStr[16];
+    return VOS_NO_ERR;
+}
 
-            (void) strcpy_s(mcStr, sizeof(mcStr), inet_ntoa(mreq.imr_multiaddr));
-            (void) strcpy_s(ifStr, sizeof(mcStr), inet_ntoa(mreq.imr_interface));
-            vos_printLog(VOS_LOG_INFO, "leaving MC: %s on iface %s\n", mcStr, ifStr);
-        }
+/**********************************************************************************************************************/
+/** Join a multicast group for one source only (source specific multicast, IGMPv3).
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to join
+ *  @param[in]      srcAddress        source to receive from
+ *  @param[in]      ipAddress         depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
 
-        if (setsockopt((SOCKET)sock, IPPROTO_IP, IP_DROP_MEMBERSHIP, (const char *)&mreq,
-                       sizeof(mreq)) == SOCKET_ERROR)
-        {
-            int err = WSAGetLastError();
+EXT_DECL VOS_ERR_T vos_sockJoinSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    return vos_sockSourceMC(sock, TRUE, mcAddress, srcAddress, ipAddress);
+}
 
-            err = err;     /* for lint */
-            vos_printLog(VOS_LOG_ERROR, "setsockopt() IP_DROP_MEMBERSHIP failed (Err: %d)\n", err);
-            result = VOS_SOCK_ERR;
-        }
-        else
-        {
-            result = VOS_NO_ERR;
-        }
-    }
-    else
-    {
-        result = VOS_PARAM_ERR;
-    }
+/**********************************************************************************************************************/
+/** Leave a source specific multicast membership.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to leave
+ *  @param[in]      srcAddress        source joined with vos_sockJoinSourceMC
+ *  @param[in]      ipAddress         depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
 
-    return result;
+EXT_DECL VOS_ERR_T vos_sockLeaveSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    return vos_sockSourceMC(sock, FALSE, mcAddress, srcAddress, ipAddress);
 }
 
 /**********************************************************************************************************************/
@@ -1114,6 +2011,79 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send UDP data at a given time.
+ *  Launch times are not supported on this target, the datagram is sent immediately.
+ *
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      pBuffer            pointer to data to send
+ *  @param[in,out]  pSize              In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress          destination IP
+ *  @param[in]      port               destination port
+ *  @param[in]      pLaunchTime        transmit time (ignored)
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ *  @retval         VOS_IO_ERR         data could not be sent
+ *  @retval         VOS_BLOCK_ERR      Call would have blocked in blocking mode
+ */
+EXT_DECL VOS_ERR_T vos_sockSendUDPAt (
+    SOCKET              sock,
+    const UINT8         *pBuffer,
+    UINT32              *pSize,
+    UINT32              ipAddress,
+    UINT16              port,
+    const VOS_TIMEVAL_T *pLaunchTime)
+{
+    (void) pLaunchTime;
+    return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+}
+
+/**********************************************************************************************************************/
+/** Send several UDP datagrams with one call.
+ *  Fallback implementation: vos_sockSendUDP() is called for each datagram.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (size in: to send, out: bytes sent)
+ *  @param[in]      noMsgs          number of entries in pMsgs
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      at least one datagram could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          noMsgs)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    VOS_ERR_T   result;
+    UINT32      i;
+
+    if (pMsgs == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    for (i = 0u; i < noMsgs; i++)
+    {
+        if (err == VOS_BLOCK_ERR)
+        {
+            pMsgs[i].size = 0u;
+            continue;
+        }
+        result = vos_sockSendUDP(sock, pMsgs[i].pBuffer, &pMsgs[i].size, pMsgs[i].dstIPAddr, pMsgs[i].dstIPPort);
+        if (result != VOS_NO_ERR)
+        {
+            pMsgs[i].size   = 0u;
+            err             = result;
+        }
+    }
+    return err;
+}
+
 
 
 /**********************************************************************************************************************/
@@ -1248,6 +2218,203 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
 
 }
 
+/**********************************************************************************************************************/
+/** Receive UDP data with its reception time.
+ *  As vos_sockReceiveUDP(), additionally the time the datagram was received is reported.
+ *  Receive time stamps are not supported by this target, the time of the call is reported.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[in]      peek            if true, leave data in queue
+ *  @param[out]     pRxTime         pointer to the reception time (time base of vos_getTime), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPTime (
+    SOCKET          sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    BOOL8           peek,
+    VOS_TIMEVAL_T   *pRxTime)
+{
+    VOS_ERR_T err = vos_sockReceiveUDP(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, peek);
+
+    if ((err == VOS_NO_ERR) && (pRxTime != NULL))
+    {
+        vos_getTime(pRxTime);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Receive several UDP datagrams with one call.
+ *  With VOS_SOCK_IOCP, overlapped receives are posted while datagrams are queued and their completions are taken
+ *  from the socket's I/O completion port in one call; the socket need not be non-blocking. Otherwise, or if no
+ *  completion port can be attached, vos_sockReceiveUDP() is called until maxMsgs datagrams were read or no more
+ *  data is pending; then use a non-blocking socket if maxMsgs is greater than one.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in,out]  pMsgs           array of datagram descriptors (buffer and size in, size and addresses out)
+ *  @param[in]      maxMsgs         number of entries in pMsgs
+ *  @param[out]     pNoMsgs         number of datagrams received
+ *
+ *  @retval         VOS_NO_ERR      no error, at least one datagram received
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPBatch (
+    SOCKET          sock,
+    VOS_SOCK_MSG_T  *pMsgs,
+    UINT32          maxMsgs,
+    UINT32          *pNoMsgs)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      i;
+
+    if ((pMsgs == NULL) || (pNoMsgs == NULL) || (maxMsgs == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pNoMsgs = 0u;
+
+#if VOS_SOCK_IOCP
+    {
+        VOS_IOCP_SOCK_T *pIocp = iocpSocket(sock);
+
+        if (pIocp != NULL)
+        {
+            return iocpReceive(pIocp, pMsgs, (maxMsgs < VOS_MAX_SOCK_BATCH) ? maxMsgs : VOS_MAX_SOCK_BATCH, pNoMsgs);
+        }
+    }
+#endif
+
+    for (i = 0u; (i < maxMsgs) && (i < VOS_MAX_SOCK_BATCH); i++)
+    {
+        err = vos_sockReceiveUDPTime(sock,
+                                     pMsgs[i].pBuffer,
+                                     &pMsgs[i].size,
+                                     &pMsgs[i].srcIPAddr,
+                                     &pMsgs[i].srcIPPort,
+                                     &pMsgs[i].dstIPAddr,
+                                     FALSE,
+                                     &pMsgs[i].rxTime);
+        if ((err != VOS_NO_ERR) || (pMsgs[i].size == 0u))
+        {
+            break;
+        }
+        (*pNoMsgs)++;
+    }
+
+    return (*pNoMsgs > 0u) ? VOS_NO_ERR : err;
+}
+
+/**********************************************************************************************************************/
+/** Send consecutive UDP datagrams of equal size from one buffer.
+ *  There is no segmentation offload on this target, the datagrams are sent one by one.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to the datagrams to send
+ *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      segSize         size of one datagram
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPSeg (
+    SOCKET      sock,
+    const UINT8 *pBuffer,
+    UINT32      *pSize,
+    UINT32      segSize,
+    UINT32      ipAddress,
+    UINT16      port)
+{
+    VOS_ERR_T   err     = VOS_NO_ERR;
+    UINT32      done    = 0u;
+    UINT32      size;
+    UINT32      chunk;
+
+    if ((pBuffer == NULL) || (pSize == NULL) || (segSize == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    size    = *pSize;
+    *pSize  = 0u;
+
+    while ((done < size) && (err == VOS_NO_ERR))
+    {
+        chunk = size - done;
+        if (chunk > segSize)
+        {
+            chunk = segSize;
+        }
+        err = vos_sockSendUDP(sock, pBuffer + done, &chunk, ipAddress, port);
+        done    += chunk;
+        *pSize  = done;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP datagrams the kernel may have coalesced.
+ *  There is no receive offload on this target, one datagram is read and *pSegSize is its size.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSegSize        pointer to the size of one datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPSeg (
+    SOCKET  sock,
+    UINT8   *pBuffer,
+    UINT32  *pSize,
+    UINT32  *pSegSize,
+    UINT32  *pSrcIPAddr,
+    UINT16  *pSrcIPPort,
+    UINT32  *pDstIPAddr)
+{
+    VOS_ERR_T err;
+
+    if (pSegSize == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    err = vos_sockReceiveUDP(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, FALSE);
+    *pSegSize = (pSize != NULL) ? *pSize : 0u;
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -1531,6 +2698,51 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data gathered from several buffers.
+ *  Fallback implementation: vos_sockSendTCP() is called for each segment.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pSegs           array of buffer segments
+ *  @param[in]      noSegs          number of entries in pSegs (at most VOS_MAX_SOCK_SEGS)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET                  sock,
+    const VOS_SOCK_SEG_T    *pSegs,
+    UINT32                  noSegs,
+    UINT32                  *pSize)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      segSize;
+    UINT32      i;
+
+    if ((pSegs == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0u;
+    for (i = 0u; (i < noSegs) && (err == VOS_NO_ERR); i++)
+    {
+        segSize = pSegs[i].size;
+        if (segSize == 0u)
+        {
+            continue;
+        }
+        err     = vos_sockSendTCP(sock, pSegs[i].pBuffer, &segSize);
+        *pSize  += segSize;
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -382,6 +382,43 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
 }
 
 
+/**********************************************************************************************************************/
+/** Create a thread bound to a set of CPUs.
+ *  CPU affinity is not supported with the pthread library on Windows, cpuMask is ignored.
+ *
+ *  @param[out]     pThread         Pointer to returned thread handle
+ *  @param[in]      pName           Pointer to name of the thread (optional)
+ *  @param[in]      policy          Scheduling policy (FIFO, Round Robin or other)
+ *  @param[in]      priority        Scheduling priority (1...255 (highest), default 0)
+ *  @param[in]      interval        Interval for cyclic threads in us (optional)
+ *  @param[in]      stackSize       Minimum stacksize, default 0: 16kB
+ *  @param[in]      cpuMask         CPUs the thread may run on (bit 0: CPU 0), 0: all
+ *  @param[in]      pFunction       Pointer to the thread function
+ *  @param[in]      pArguments      Pointer to the thread function parameters
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  thread creation error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadCreateAffine (
+    VOS_THREAD_T            *pThread,
+    const CHAR8             *pName,
+    VOS_THREAD_POLICY_T     policy,
+    VOS_THREAD_PRIORITY_T   priority,
+    UINT32                  interval,
+    UINT32                  stackSize,
+    UINT32                  cpuMask,
+    VOS_THREAD_FUNC_T       pFunction,
+    void                    *pArguments)
+{
+    if (cpuMask != 0u)
+    {
+        vos_printLog(VOS_LOG_WARNING, "%s CPU affinity not supported, ignored\n", (pName != NULL) ? pName : "");
+    }
+    return vos_threadCreate(pThread, pName, policy, priority, interval, stackSize, pFunction, pArguments);
+}
+
 /**********************************************************************************************************************/
 /** Terminate a thread.
  *  This call will terminate the thread with the given threadId and release all resources. Depending on the
@@ -540,6 +577,27 @@ EXT_DECL void vos_getTime (
     }
 }
 
+/**********************************************************************************************************************/
+/** Select the time base of vos_getTime().
+ *  PTP hardware clocks are not supported by this target, only the local clock.
+ *
+ *  @param[in]      pPtpDevice      PTP clock device, NULL for the local clock (default)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_setTimeBase (
+    const CHAR8 *pPtpDevice)
+{
+    if (pPtpDevice == NULL)
+    {
+        return VOS_NO_ERR;
+    }
+    vos_printLogStr(VOS_LOG_ERROR, "vos_setTimeBase() PTP clock not supported\n");
+    return VOS_INIT_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Get a time-stamp string.
  *  Get a time-stamp string for debugging in the form "yyyymmdd-hh:mm:ss.ms"
@@ -1254,6 +1312,44 @@ EXT_DECL VOS_ERR_T vos_semaTake (
     return retVal;
 }
 
+/**********************************************************************************************************************/
+/** Take a semaphore until a deadline.
+ *  The deadline is a time returned by vos_getTime(), it is converted to the remaining timeout.
+ *
+ *  @param[in]      sema            semaphore handle
+ *  @param[in]      pDeadline       Latest time to take the semaphore, a past deadline means no wait
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_SEMA_ERR    could not get semaphore in time
+ */
+
+EXT_DECL VOS_ERR_T vos_semaTakeUntil (
+    VOS_SEMA_T          sema,
+    const VOS_TIMEVAL_T *pDeadline)
+{
+    VOS_TIMEVAL_T   remaining;
+    UINT32          timeout = 0u;
+
+    if (pDeadline == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    vos_getTime(&remaining);
+    if (vos_cmpTime(pDeadline, &remaining) > 0)
+    {
+        VOS_TIMEVAL_T now = remaining;
+
+        remaining = *pDeadline;
+        vos_subTime(&remaining, &now);
+        /* round up, a timeout of 0 would not wait at all */
+        timeout = (remaining.tv_sec >= 4000) ? 4000000000u :
+            (UINT32) remaining.tv_sec * 1000000u + (UINT32) remaining.tv_usec;
+        timeout = (timeout == 0u) ? 1u : timeout;
+    }
+    return vos_semaTake(sema, timeout);
+}
+
 
 /**********************************************************************************************************************/
 /** Give a semaphore.
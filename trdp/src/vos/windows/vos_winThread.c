@@ -51,17 +51,90 @@ const UINT32    cMutextMagic        = 0x1234FEDC;
 #define USECS_PER_MSEC  1000u
 #define MSECS_PER_SEC   1000u
 
-/* This define holds the max amount of seconds to get stored in 32bit holding micro seconds        */
-/* It is the result when using the common time struct with tv_sec and tv_usec as on a 32 bit value */
-/* so far 0..999999 gets used for the tv_usec field as per definition, then 0xFFF0BDC0 usec        */
-/* are remaining to represent the seconds, which in turn give 0x10C5 seconds or in decimal 4293    */
-#define MAXSEC_FOR_USECPRESENTATION  4293
+/* Windows 10 1803 and later: timer expiring at the requested time instead of the next scheduler tick (15.6ms) */
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION   0x00000002
+#endif
 
 /***********************************************************************************************************************
  *  LOCALS
  */
 
-static BOOL8 vosThreadInitialised = FALSE;
+/** Start parameters of a cyclic thread created by vos_threadCreate()    */
+typedef struct
+{
+    UINT32              interval;
+    VOS_THREAD_FUNC_T   pFunction;
+    void                *pArguments;
+} VOS_CYCLIC_START_T;
+
+static BOOL8    vosThreadInitialised = FALSE;
+static INT64    sQpcFrequency = 0;          /* performance counter ticks per s, 0 until first read */
+
+/**********************************************************************************************************************/
+/** Read the performance counter in us
+ *
+ *  @retval         us since system start
+ */
+
+static INT64 vos_qpcTime (void)
+{
+    LARGE_INTEGER count;
+
+    if (sQpcFrequency == 0)
+    {
+        LARGE_INTEGER frequency;
+
+        (void) QueryPerformanceFrequency(&frequency);   /* never fails on XP and later */
+        sQpcFrequency = frequency.QuadPart;
+    }
+    (void) QueryPerformanceCounter(&count);
+
+    /* split to avoid the overflow of count * 1000000 */
+    return (count.QuadPart / sQpcFrequency) * 1000000 + ((count.QuadPart % sQpcFrequency) * 1000000) / sQpcFrequency;
+}
+
+/**********************************************************************************************************************/
+/** Create a waitable timer for the calling thread
+ *  A high resolution timer is requested, older Windows versions fall back to a timer of scheduler resolution.
+ *
+ *  @retval         timer handle, NULL on error
+ */
+
+static HANDLE vos_timerCreate (void)
+{
+    HANDLE hTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+    if (hTimer == NULL)
+    {
+        hTimer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+    }
+    return hTimer;
+}
+
+/**********************************************************************************************************************/
+/** Wait on a waitable timer
+ *
+ *  @param[in]      hTimer          timer handle
+ *  @param[in]      delay           delay in us
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   timer could not be set
+ */
+
+static VOS_ERR_T vos_timerWait (
+    HANDLE  hTimer,
+    INT64   delay)
+{
+    LARGE_INTEGER dueTime;
+
+    dueTime.QuadPart = -delay * 10;                     /* relative, in 100ns units */
+    if (!SetWaitableTimer(hTimer, &dueTime, 0, NULL, NULL, FALSE))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) WaitForSingleObject(hTimer, INFINITE);
+    return VOS_NO_ERR;
+}
 
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
@@ -75,6 +148,8 @@ static BOOL8 vosThreadInitialised = FALSE;
 /**********************************************************************************************************************/
 /** Cyclic thread functions.
  *  Wrapper for cyclic threads. The thread function will be called cyclically with interval.
+ *  The release times are absolute deadlines on the performance counter, the period does not drift by the run time
+ *  of the thread function. If a cycle runs past the next release time, the missed releases are skipped.
  *
  *  @param[in]      interval        Interval for cyclic threads in us (incl. runtime)
  *  @param[in]      pFunction       Pointer to the thread function
@@ -82,57 +157,56 @@ static BOOL8 vosThreadInitialised = FALSE;
  *  @retval         void
  */
 
-
 void vos_cyclicThread (
     UINT32              interval,
     VOS_THREAD_FUNC_T   pFunction,
     void                *pArguments)
 {
-    VOS_TIMEVAL_T   priorCall;
-    VOS_TIMEVAL_T   afterCall;
-    UINT32          execTime;
-    UINT32          waitingTime;
+    HANDLE  hTimer  = vos_timerCreate();
+    INT64   release = vos_qpcTime();
+    INT64   now;
+    INT64   missed;
+
     for (;; )
     {
-        vos_getTime(&priorCall);  /* get initial time */
         pFunction(pArguments);    /* perform thread function */
-        vos_getTime(&afterCall);  /* get time after function ghas returned */
-        /* subtract in the pattern after - prior to get the runtime of function() */
-        vos_subTime(&afterCall, &priorCall);
-        /* afterCall holds now the time difference within a structure not compatible with interval */
-        /* check if UINT32 fits to hold the waiting time value */
-        if (afterCall.tv_sec <= MAXSEC_FOR_USECPRESENTATION)
+
+        now     = vos_qpcTime();
+        release += interval;
+        if ((now > release) && (interval > 0u))
         {
-            /*           sec to usec conversion                               value normalized from 0 .. 999999*/
-            execTime = ((afterCall.tv_sec * MSECS_PER_SEC * USECS_PER_MSEC) + (UINT32)afterCall.tv_usec);
-            if (execTime > interval)
-            {
-                /*severe error: cyclic task time violated*/
-                waitingTime = 0U;
-                /* Log the runtime violation */
-                vos_printLog(VOS_LOG_ERROR,
-                             "cyclic thread with interval %d usec was running  %d usec\n",
-                             interval, execTime);
-            }
-            else
-            {
-                waitingTime = interval - execTime;
-            }
+            /* skip the releases already passed, stay on the grid */
+            missed  = (now - release) / interval + 1;
+            vos_printLog(VOS_LOG_WARNING,
+                         "cyclic thread with interval %u usec was running %u usec, %u cycle(s) skipped\n",
+                         (unsigned int) interval, (unsigned int) (now - release + interval),
+                         (unsigned int) missed);
+            release += missed * interval;
         }
-        else
+        /* the due time is set relative to the performance counter, a change of the system time does not matter */
+        if ((hTimer == NULL) || (vos_timerWait(hTimer, release - now) != VOS_NO_ERR))
         {
-            /* seems a very critical overflow has happened - or simply a misconfiguration */
-            /* as a rough first guess use zero waiting time here */
-            waitingTime = 0U;
-            /* Have this value range violation logged */
-            vos_printLog(VOS_LOG_ERROR,
-                         "cyclic thread with interval %d usec exceeded time out by running %d sec\n",
-                         interval, afterCall.tv_sec);
+            Sleep((DWORD) ((release - now) / 1000));
         }
-        (void) vos_threadDelay(waitingTime);
     }
 }
 
+/**********************************************************************************************************************/
+/** Start routine of cyclic threads created by vos_threadCreate()
+ *
+ *  @param[in]      pArg            Pointer to the start parameters, released here
+ *  @retval         0
+ */
+
+static DWORD WINAPI vos_cyclicStart (LPVOID pArg)
+{
+    VOS_CYCLIC_START_T start = *(VOS_CYCLIC_START_T *) pArg;
+
+    vos_memFree(pArg);
+    vos_cyclicThread(start.interval, start.pFunction, start.pArguments);
+    return 0;
+}
+
 /**********************************************************************************************************************/
 /** Initialize the thread library.
  *  Must be called once before any other call
@@ -191,8 +265,9 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     VOS_THREAD_FUNC_T       pFunction,
     void                    *pArguments)
 {
-    HANDLE  hThread = NULL;
-    DWORD   threadId;
+    HANDLE              hThread = NULL;
+    DWORD               threadId;
+    VOS_CYCLIC_START_T  *pStart = NULL;
 
     if (!vosThreadInitialised)
     {
@@ -209,8 +284,15 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
 
     if (interval > 0)
     {
-        vos_printLog(VOS_LOG_ERROR, "%s cyclic threads not implemented yet\n", pName);
-        return VOS_INIT_ERR;
+        /* the thread function is called by vos_cyclicThread() */
+        pStart = (VOS_CYCLIC_START_T *) vos_memAlloc(sizeof(VOS_CYCLIC_START_T));
+        if (pStart == NULL)
+        {
+            return VOS_MEM_ERR;
+        }
+        pStart->interval    = interval;
+        pStart->pFunction   = pFunction;
+        pStart->pArguments  = pArguments;
     }
 
     /* Create the thread to begin execution on its own. */
@@ -218,8 +300,8 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     hThread = CreateThread(
             NULL,                                           /* default security attributes */
             (stackSize == 0) ? cDefaultStackSize : stackSize, /* use default stack size */
-            (LPTHREAD_START_ROUTINE) pFunction,             /* thread function name */
-            (LPVOID) pArguments,                            /* argument to thread function */
+            (pStart != NULL) ? vos_cyclicStart : (LPTHREAD_START_ROUTINE) pFunction, /* thread function name */
+            (pStart != NULL) ? (LPVOID) pStart : (LPVOID) pArguments, /* argument to thread function */
             0,                                              /* use default creation flags */
             &threadId);                                     /* returns the thread identifier */
 
@@ -227,6 +309,10 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     if (hThread == NULL)
     {
         vos_printLog(VOS_LOG_ERROR, "%s CreateThread() failed\n", pName);
+        if (pStart != NULL)
+        {
+            vos_memFree(pStart);
+        }
         return VOS_THREAD_ERR;
     }
 
@@ -259,6 +345,43 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
 }
 
 
+/**********************************************************************************************************************/
+/** Create a thread bound to a set of CPUs.
+ *  CPU affinity is not supported on Windows yet, cpuMask is ignored.
+ *
+ *  @param[out]     pThread         Pointer to returned thread handle
+ *  @param[in]      pName           Pointer to name of the thread (optional)
+ *  @param[in]      policy          Scheduling policy (FIFO, Round Robin or other)
+ *  @param[in]      priority        Scheduling priority (1...255 (highest), default 0)
+ *  @param[in]      interval        Interval for cyclic threads in us (optional)
+ *  @param[in]      stackSize       Minimum stacksize, default 0: 16kB
+ *  @param[in]      cpuMask         CPUs the thread may run on (bit 0: CPU 0), 0: all
+ *  @param[in]      pFunction       Pointer to the thread function
+ *  @param[in]      pArguments      Pointer to the thread function parameters
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  thread creation error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadCreateAffine (
+    VOS_THREAD_T            *pThread,
+    const CHAR8             *pName,
+    VOS_THREAD_POLICY_T     policy,
+    VOS_THREAD_PRIORITY_T   priority,
+    UINT32                  interval,
+    UINT32                  stackSize,
+    UINT32                  cpuMask,
+    VOS_THREAD_FUNC_T       pFunction,
+    void                    *pArguments)
+{
+    if (cpuMask != 0u)
+    {
+        vos_printLog(VOS_LOG_WARNING, "%s CPU affinity not supported, ignored\n", (pName != NULL) ? pName : "");
+    }
+    return vos_threadCreate(pThread, pName, policy, priority, interval, stackSize, pFunction, pArguments);
+}
+
 /**********************************************************************************************************************/
 /** Terminate a thread.
  *  This call will terminate the thread with the given threadId and release all resources. Depending on the
@@ -342,9 +465,9 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
 
 /**********************************************************************************************************************/
 /** Delay the execution of the current thread by the given delay in us.
+ *  A high resolution waitable timer is used, delays below the scheduler tick of 15.6ms are kept.
  *
- *
- *  @param[in]      delay           Delay in us
+ *  @param[in]      delay           Delay in us, 0: yield
  *  @retval         VOS_NO_ERR      no error
  *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
  */
@@ -352,21 +475,31 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
 EXT_DECL VOS_ERR_T vos_threadDelay (
     UINT32 delay)
 {
-    /* We cannot delay less than 1ms */
-    if (delay < 1000)
+    HANDLE      hTimer;
+    VOS_ERR_T   err;
+
+    if (delay == 0u)
     {
-        vos_printLog(VOS_LOG_WARNING, "Win: thread delays < 1ms are not supported!\n");
-        return VOS_PARAM_ERR;
+        /*    yield cpu to other threads   */
+        (void) SwitchToThread();
+        return VOS_NO_ERR;
     }
 
-    Sleep(delay / 1000u);
+    hTimer = vos_timerCreate();
+    if (hTimer == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "CreateWaitableTimerEx() failed (Err: %d)\n", GetLastError());
+        return VOS_PARAM_ERR;
+    }
+    err = vos_timerWait(hTimer, (INT64) delay);
+    (void) CloseHandle(hTimer);
 
-    return VOS_NO_ERR;
+    return err;
 }
 
 /**********************************************************************************************************************/
 /** Return the current time in sec and us
- *
+ *  The performance counter is read, the time is monotonic with us resolution and counts from system start.
  *
  *  @param[out]     pTime           Pointer to time value
  */
@@ -374,7 +507,7 @@ EXT_DECL VOS_ERR_T vos_threadDelay (
 EXT_DECL void vos_getTime (
     VOS_TIMEVAL_T *pTime)
 {
-    struct __timeb32 curTime;
+    INT64 now;
 
     if (pTime == NULL)
     {
@@ -382,27 +515,33 @@ EXT_DECL void vos_getTime (
     }
     else
     {
-#ifdef __GNUC__
-    #ifdef MINGW_HAS_SECURE_API
-        if (_ftime_s( &curTime ) == 0)
-    #else /*MINGW_HAS_SECURE_API*/
-        if (_ftime( &curTime ) == 0)
-    #endif  /*MINGW_HAS_SECURE_API*/
-#else /*__GNUC__*/
-        if (_ftime32_s( &curTime ) == 0)
-#endif /*__GNUC__*/
-        {
-            pTime->tv_sec   = curTime.time;
-            pTime->tv_usec  = curTime.millitm * 1000;
-        }
-        else
-        {
-            pTime->tv_sec   = 0;
-            pTime->tv_usec  = 0;
-        }
+        now = vos_qpcTime();
+        pTime->tv_sec   = (long) (now / 1000000);
+        pTime->tv_usec  = (long) (now % 1000000);
     }
 }
 
+/**********************************************************************************************************************/
+/** Select the time base of vos_getTime().
+ *  PTP hardware clocks are not supported by this target, only the local clock.
+ *
+ *  @param[in]      pPtpDevice      PTP clock device, NULL for the local clock (default)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_setTimeBase (
+    const CHAR8 *pPtpDevice)
+{
+    if (pPtpDevice == NULL)
+    {
+        return VOS_NO_ERR;
+    }
+    vos_printLogStr(VOS_LOG_ERROR, "vos_setTimeBase() PTP clock not supported\n");
+    return VOS_INIT_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Get a time-stamp string.
  *  Get a time-stamp string for debugging in the form "yyyymmdd-hh:mm:ss.ms"
@@ -1016,6 +1155,44 @@ EXT_DECL VOS_ERR_T vos_semaTake (
     return retVal;
 }
 
+/**********************************************************************************************************************/
+/** Take a semaphore until a deadline.
+ *  The deadline is a time returned by vos_getTime(), it is converted to the remaining timeout.
+ *
+ *  @param[in]      sema            semaphore handle
+ *  @param[in]      pDeadline       Latest time to take the semaphore, a past deadline means no wait
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_SEMA_ERR    could not get semaphore in time
+ */
+
+EXT_DECL VOS_ERR_T vos_semaTakeUntil (
+    VOS_SEMA_T          sema,
+    const VOS_TIMEVAL_T *pDeadline)
+{
+    VOS_TIMEVAL_T   remaining;
+    UINT32          timeout = 0u;
+
+    if (pDeadline == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    vos_getTime(&remaining);
+    if (vos_cmpTime(pDeadline, &remaining) > 0)
+    {
+        VOS_TIMEVAL_T now = remaining;
+
+        remaining = *pDeadline;
+        vos_subTime(&remaining, &now);
+        /* round up, a timeout of 0 would not wait at all */
+        timeout = (remaining.tv_sec >= 4000) ? 4000000000u :
+            (UINT32) remaining.tv_sec * 1000000u + (UINT32) remaining.tv_usec;
+        timeout = (timeout == 0u) ? 1u : timeout;
+    }
+    return vos_semaTake(sema, timeout);
+}
+
 
 /**********************************************************************************************************************/
 /** Give a semaphore.
@@ -15,6 +15,9 @@
  * $Id$
  *
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
+ *
+ *      Called with -p <file> the per-operation costs of the hot paths are checked against the baselines in <file>
+ *      (make perfcheck), -w <file> measures them and writes the baselines (make perfbaseline).
  */
 
 /*******************************************************************************
@@ -46,6 +49,8 @@
 #include "vos_sock.h"
 #include "vos_utils.h"
 #include "vos_mem.h"
+#include "trdp_if_light.h"
+#include "tau_marshall.h"
 
 int testTimeCompare()
 {
@@ -216,6 +221,121 @@ int testCRCcalculation()
     return 0; /* all time tests succeeded */
 }
 
+static UINT32 testReflect(UINT32 value, int bits)
+{
+    UINT32  result = 0;
+    int     i;
+
+    for (i = 0; i < bits; i++)
+    {
+        result = (result << 1) | ((value >> i) & 1);
+    }
+    return result;
+}
+
+int testSC32calculation()
+{
+    /* Vectors of the SCADE reference model (sc32/test_crc.xscade). The model computes the reflected form (AUTOSAR
+       CRC32P4: LSB first, start and final XOR 0xFFFFFFFF) of the polynomial vos_sc32() computes MSB first, hence
+       the vectors are checked with bit reversed data and result */
+    static const UINT8 v1[] = { 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39 };
+    static const UINT8 v2[] = { 0x00, 0x00, 0x00, 0x00 };
+    static const UINT8 v3[] = { 0xf2, 0x01, 0x83 };
+    static const UINT8 v4[] = { 0x0f, 0xaa, 0x00, 0x55 };
+    static const UINT8 v5[] = { 0x00, 0xff, 0x55, 0x11 };
+    static const UINT8 v6[] = { 0x33, 0x22, 0x55, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF };
+    static const UINT8 v7[] = { 0x92, 0x6b, 0x55 };
+    static const UINT8 v8[] = { 0xff, 0xff, 0xff, 0xff };
+    static const struct
+    {
+        const UINT8 *pData;
+        UINT32      length;
+        UINT32      result;
+    } vectors[] =
+    {
+        { v1, sizeof(v1), 0x1697d06a }, { v2, sizeof(v2), 0x6FB32240 }, { v3, sizeof(v3), 0x4F721A25 },
+        { v4, sizeof(v4), 0x20662DF8 }, { v5, sizeof(v5), 0x9BD7996E }, { v6, sizeof(v6), 0xA65A343D },
+        { v7, sizeof(v7), 0xEE688A78 }, { v8, sizeof(v8), 0xFFFFFFFF }
+    };
+    static UINT8 buffer[2048];
+    UINT8   rev[16];
+    int     impl;
+    UINT32  i, j, len, ref, crc;
+
+    for (i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = (UINT8) (i * 7 + (i >> 5));
+    }
+    for (impl = VOS_CRC_BYTEWISE; impl <= VOS_CRC_HW; impl++)
+    {
+        if (vos_crcSelect((VOS_CRC_IMPL_T) impl) != VOS_NO_ERR)
+        {
+            continue;       /* not available on this target */
+        }
+        for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++)
+        {
+            for (j = 0; j < vectors[i].length; j++)
+            {
+                rev[j] = (UINT8) testReflect(vectors[i].pData[j], 8);
+            }
+            crc = vos_sc32(0xFFFFFFFF, rev, vectors[i].length);
+            if ((testReflect(crc, 32) ^ 0xFFFFFFFF) != vectors[i].result)
+            {
+                printf("SC-32 implementation %d: vector %u wrong\n", impl, i + 1);
+                return 1;
+            }
+        }
+        /* the block implementations against the reference */
+        for (len = 0; len <= sizeof(buffer) - 3; len += 29)
+        {
+            (void) vos_crcSelect(VOS_CRC_BYTEWISE);
+            ref = vos_sc32(0xFFFFFFFF, buffer + 3, len);
+            (void) vos_crcSelect((VOS_CRC_IMPL_T) impl);
+            if (vos_sc32(0xFFFFFFFF, buffer + 3, len) != ref)
+            {
+                printf("SC-32 implementation %d: length %u wrong\n", impl, len);
+                return 1;
+            }
+        }
+        printf("SC-32 implementation %d\tok\n", impl);
+    }
+    (void) vos_crcSelect(VOS_CRC_HW);
+    return 0;
+}
+
+int testRing()
+{
+    VOS_RING_T  ring = NULL;
+    UINT8       data[100];
+    UINT32      size = sizeof(data);
+    VOS_ERR_T   err;
+
+    err = vos_ringCreate(VOS_RING_SPSC, 16u, sizeof(data), &ring);
+    if (err == VOS_INIT_ERR)
+    {
+        return 0;       /* not available on this target */
+    }
+    if ((err != VOS_NO_ERR)
+        || (vos_ringSend(ring, (const UINT8 *) "ring", 5u) != VOS_NO_ERR)
+        || (vos_ringReceive(ring, data, &size, 0u) != VOS_NO_ERR)
+        || (size != 5u) || (memcmp(data, "ring", 5u) != 0))
+    {
+        printf("Ring send/receive failed\n");
+        return 1;
+    }
+    (void) vos_ringDestroy(ring);
+
+    /* slot count times slot size must not wrap around in 32 bits */
+    if ((vos_ringCreate(VOS_RING_SPSC, 0x40000000u, 64u, &ring) != VOS_PARAM_ERR)
+        || (vos_ringCreate(VOS_RING_MPSC, 2u, 0xFFFFFFF0u, &ring) != VOS_PARAM_ERR)
+        || (vos_ringCreate(VOS_RING_MPSC, 17u, 0x08000000u, &ring) != VOS_PARAM_ERR))
+    {
+        printf("Ring size overflow not detected\n");
+        return 1;
+    }
+    return 0;
+}
+
 int testNetwork()
 {
     UINT8 MAC[6];
@@ -300,8 +420,373 @@ int testInterfaces()
     return 0; /* all time tests succeeded */
 }
 
+/*******************************************************************************
+ * Performance regression checks
+ *
+ * Each hot path is timed in slices of PERF_SLICE_US, the fastest of PERF_REPEAT slices counts. The cost is given in
+ * multiples of a reference loop measured the same way, so the baselines hold for machines of different speed as
+ * long as the relation of CPU and memory speed is similar. A cost above its baseline plus tolerance is measured
+ * once more before it is reported as regression.
+ */
+
+#define PERF_SLICE_US       20000u      /* length of one measurement slice                  */
+#define PERF_REPEAT         7u          /* slices per measurement, the fastest one counts   */
+#define PERF_BATCH          64u         /* calls between two time stamps                    */
+#define PERF_REF_LOOPS      100u        /* iterations of the reference loop, one cost unit  */
+#define PERF_ELEMENTS       100u        /* publishers and subscribers of the session        */
+#define PERF_PAYLOAD        64u         /* bytes per telegram                               */
+#define PERF_COMID          41000u      /* first comId of the session                       */
+#define PERF_DS_COMID       41999u      /* comId and dataset of the marshalling check       */
+#define PERF_TOLERANCE      25u         /* default tolerance of new baselines, percent      */
+#define PERF_MAX_LINE       160u
+
+typedef struct
+{
+    const char  *name;                  /* key in the baseline file     */
+    void        (*pfOp)(void);          /* one operation                */
+    double      cost;                   /* measured, in reference units */
+    double      baseline;               /* from the file, 0 if missing  */
+    UINT32      tolerance;              /* percent                      */
+} PERF_TEST_T;
+
+static volatile UINT32      gPerfSink;
+static TRDP_APP_SESSION_T   gPerfApp        = NULL;     /* publishing session   */
+static TRDP_APP_SESSION_T   gPerfRcv        = NULL;     /* subscribing session  */
+static TRDP_PUB_T           gPerfPub[PERF_ELEMENTS];
+static TRDP_SUB_T           gPerfSub[PERF_ELEMENTS];
+static UINT32               gPerfNext       = 0u;
+static void                 *gPerfRefCon    = NULL;
+static UINT8                gPerfData[PERF_PAYLOAD];
+static UINT8                gPerfHost[256];
+static UINT8                gPerfWire[256];
+
+static TRDP_DATASET_T       gPerfDataset =
+{
+    PERF_DS_COMID,  /*    dataset id      */
+    0,              /*    reserved        */
+    8,              /*    No of elements  */
+    {               /*    TRDP_DATASET_ELEMENT_T[]    */
+        { TRDP_UINT8, 1, NULL, 0, 0, NULL },
+        { TRDP_UINT16, 1, NULL, 0, 0, NULL },
+        { TRDP_UINT32, 4, NULL, 0, 0, NULL },
+        { TRDP_INT64, 1, NULL, 0, 0, NULL },
+        { TRDP_REAL32, 2, NULL, 0, 0, NULL },
+        { TRDP_CHAR8, 16, NULL, 0, 0, NULL },
+        { TRDP_TIMEDATE64, 1, NULL, 0, 0, NULL },
+        { TRDP_UINT16, 8, NULL, 0, 0, NULL }
+    }
+};
+static TRDP_DATASET_T       *gPerfDatasets[] = { &gPerfDataset };
+static TRDP_COMID_DSID_MAP_T gPerfMap[] = { { PERF_DS_COMID, PERF_DS_COMID } };
+
+/* The reference loop: a dependent chain of shifts and table reads */
+static void perfReference(void)
+{
+    static const UINT8 table[256] = { 1, 2, 3, 5, 7, 11, 13, 17 };
+    UINT32  x   = gPerfSink | 1u;
+    UINT32  sum = 0u;
+    UINT32  i;
+
+    for (i = 0u; i < PERF_REF_LOOPS; i++)
+    {
+        x   ^= x << 13;
+        x   ^= x >> 17;
+        x   ^= x << 5;
+        sum += table[x & 0xFFu];
+    }
+    gPerfSink = sum;
+}
+
+static void perfMemAlloc(void)
+{
+    UINT8 *p = vos_memAlloc(PERF_PAYLOAD * 4u);
+
+    vos_memFree(p);
+}
+
+static void perfPublish(void)
+{
+    TRDP_PUB_T pubHandle;
+
+    if (tlp_publish(gPerfApp, &pubHandle, NULL, NULL, PERF_COMID + PERF_ELEMENTS, 0u, 0u, 0u,
+                    vos_dottedIP("127.0.0.2"), 1000000u, 0u, TRDP_FLAGS_NONE, NULL, gPerfData,
+                    PERF_PAYLOAD) == TRDP_NO_ERR)
+    {
+        (void) tlp_unpublish(gPerfApp, pubHandle);
+    }
+}
+
+static void perfPut(void)
+{
+    gPerfData[0]++;
+    (void) tlp_put(gPerfApp, gPerfPub[gPerfNext++ % PERF_ELEMENTS], gPerfData, PERF_PAYLOAD);
+}
+
+static void perfGet(void)
+{
+    TRDP_PD_INFO_T  pdInfo;
+    UINT8           data[PERF_PAYLOAD];
+    UINT32          size = sizeof(data);
+
+    (void) tlp_get(gPerfRcv, gPerfSub[0], &pdInfo, data, &size);
+}
+
+static void perfProcess(void)
+{
+    (void) tlc_process(gPerfApp, NULL, NULL);
+    (void) tlc_process(gPerfRcv, NULL, NULL);
+}
+
+static void perfMarshall(void)
+{
+    TRDP_DATASET_T  *pCachedDs = NULL;
+    UINT32          size = sizeof(gPerfWire);
+
+    (void) tau_marshall(gPerfRefCon, PERF_DS_COMID, gPerfHost, sizeof(gPerfHost), gPerfWire, &size, &pCachedDs);
+}
+
+/* Nanoseconds per call, the fastest of PERF_REPEAT slices */
+static double perfMeasure(void (*pfOp)(void))
+{
+    VOS_TIMEVAL_T   start;
+    VOS_TIMEVAL_T   now;
+    double          best = 0.0;
+    double          ns;
+    UINT32          calls;
+    UINT32          rep, i;
+
+    for (rep = 0u; rep < PERF_REPEAT; rep++)
+    {
+        calls = 0u;
+        vos_getTime(&start);
+        do
+        {
+            for (i = 0u; i < PERF_BATCH; i++)
+            {
+                pfOp();
+            }
+            calls += PERF_BATCH;
+            vos_getTime(&now);
+            vos_subTime(&now, &start);
+        }
+        while ((UINT32) (now.tv_sec * 1000000 + now.tv_usec) < PERF_SLICE_US);
+
+        ns = (double) (now.tv_sec * 1000000 + now.tv_usec) * 1000.0 / (double) calls;
+        if ((rep == 0u) || (ns < best))
+        {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+/* Two sessions on the loopback interface, the first one publishes to the second one. Data is received on the
+   first subscription. */
+static int perfSetup(void)
+{
+    TRDP_PROCESS_CONFIG_T   processConfig = {"vostest", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_IP_ADDR_T          ownIP = vos_dottedIP("127.0.0.1");
+    TRDP_IP_ADDR_T          rcvIP = vos_dottedIP("127.0.0.2");
+    TRDP_PD_INFO_T          pdInfo;
+    UINT8                   data[PERF_PAYLOAD];
+    UINT32                  size;
+    UINT32                  i;
+
+    if ((tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR) ||
+        (tlc_openSession(&gPerfApp, ownIP, 0u, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&gPerfRcv, rcvIP, 0u, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR))
+    {
+        printf("Cannot open the sessions on 127.0.0.1 and 127.0.0.2\n");
+        return 1;
+    }
+    for (i = 0u; i < PERF_ELEMENTS; i++)
+    {
+        if ((tlp_subscribe(gPerfRcv, &gPerfSub[i], NULL, NULL, PERF_COMID + i, 0u, 0u, 0u, 0u, rcvIP,
+                           TRDP_FLAGS_NONE, 10000000u, TRDP_TO_KEEP_LAST_VALUE) != TRDP_NO_ERR) ||
+            (tlp_publish(gPerfApp, &gPerfPub[i], NULL, NULL, PERF_COMID + i, 0u, 0u, 0u, rcvIP, 1000000u, 0u,
+                         TRDP_FLAGS_NONE, NULL, gPerfData, PERF_PAYLOAD) != TRDP_NO_ERR))
+        {
+            printf("Cannot publish or subscribe comId %u\n", PERF_COMID + i);
+            return 1;
+        }
+    }
+    /* the telegrams are sent first after their interval of 1s */
+    for (i = 0u; i < 1000u; i++)
+    {
+        (void) tlc_processEvents(gPerfApp);
+        (void) tlc_processEvents(gPerfRcv);
+        size = sizeof(data);
+        if (tlp_get(gPerfRcv, gPerfSub[0], &pdInfo, data, &size) == TRDP_NO_ERR)
+        {
+            break;
+        }
+        (void) vos_threadDelay(2000u);
+    }
+    if (i == 1000u)
+    {
+        printf("No telegram received on %s\n", vos_ipDotted(rcvIP));
+        return 1;
+    }
+    if (tau_initMarshall(&gPerfRefCon, 1u, gPerfMap, 1u, gPerfDatasets) != TRDP_NO_ERR)
+    {
+        printf("Cannot initialise the marshalling\n");
+        return 1;
+    }
+    return 0;
+}
+
+static void perfTeardown(void)
+{
+    if (gPerfRefCon != NULL)
+    {
+        (void) tau_deInitMarshall(gPerfRefCon);
+        gPerfRefCon = NULL;
+    }
+    if (gPerfApp != NULL)
+    {
+        (void) tlc_closeSession(gPerfApp);
+        gPerfApp = NULL;
+    }
+    if (gPerfRcv != NULL)
+    {
+        (void) tlc_closeSession(gPerfRcv);
+        gPerfRcv = NULL;
+    }
+    (void) tlc_terminate();
+}
+
+/* Read the baselines, lines of name, cost and tolerance; '#' starts a comment */
+static void perfReadBaselines(const char *pFile, PERF_TEST_T *pTests, UINT32 numTests)
+{
+    char    line[PERF_MAX_LINE];
+    char    name[PERF_MAX_LINE];
+    double  cost;
+    UINT32  tolerance;
+    UINT32  i;
+    FILE    *fp = fopen(pFile, "r");
+
+    if (fp == NULL)
+    {
+        return;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if ((line[0] == '#') || (sscanf(line, "%159s %lf %u", name, &cost, &tolerance) != 3))
+        {
+            continue;
+        }
+        for (i = 0u; i < numTests; i++)
+        {
+            if (strcmp(name, pTests[i].name) == 0)
+            {
+                pTests[i].baseline  = cost;
+                pTests[i].tolerance = tolerance;
+            }
+        }
+    }
+    fclose(fp);
+}
+
+static int perfWriteBaselines(const char *pFile, const PERF_TEST_T *pTests, UINT32 numTests)
+{
+    UINT32  i;
+    FILE    *fp = fopen(pFile, "w");
+
+    if (fp == NULL)
+    {
+        printf("Cannot write %s\n", pFile);
+        return 1;
+    }
+    fprintf(fp, "# Per-operation costs of the hot paths, checked by 'make perfcheck' (test/diverse/LibraryTests.c).\n"
+            "# Costs are multiples of the reference loop, written by 'make perfbaseline'; tolerances are kept.\n"
+            "# name                      cost    tolerance[%%]\n");
+    for (i = 0u; i < numTests; i++)
+    {
+        fprintf(fp, "%-24s %9.4f    %u\n", pTests[i].name, pTests[i].cost, pTests[i].tolerance);
+    }
+    fclose(fp);
+    return 0;
+}
+
+/* Measure the hot paths and compare them to the baselines in pFile, or write them there */
+int testPerformance(const char *pFile, int write)
+{
+    PERF_TEST_T tests[] =
+    {
+        { "vos_memAlloc",           perfMemAlloc,   0.0, 0.0, PERF_TOLERANCE },
+        { "tlp_publish",            perfPublish,    0.0, 0.0, PERF_TOLERANCE },
+        { "tlp_put",                perfPut,        0.0, 0.0, PERF_TOLERANCE },
+        { "tlp_get",                perfGet,        0.0, 0.0, PERF_TOLERANCE },
+        { "tlc_process_100",        perfProcess,    0.0, 0.0, PERF_TOLERANCE },
+        { "tau_marshall",           perfMarshall,   0.0, 0.0, PERF_TOLERANCE }
+    };
+    const UINT32    numTests = sizeof(tests) / sizeof(tests[0]);
+    double          unit;
+    double          limit;
+    int             rv = 0;
+    UINT32          i;
+
+    if (perfSetup() != 0)
+    {
+        perfTeardown();
+        return 1;
+    }
+    perfReadBaselines(pFile, tests, numTests);
+
+    unit = perfMeasure(perfReference);
+    printf("reference loop\t%.1f ns\n", unit);
+
+    for (i = 0u; i < numTests; i++)
+    {
+        tests[i].cost = perfMeasure(tests[i].pfOp) / unit;
+        limit = tests[i].baseline * (1.0 + tests[i].tolerance / 100.0);
+        if ((write == 0) && (tests[i].baseline > 0.0) && (tests[i].cost > limit))
+        {
+            /* a busy machine is more likely than a regression, measure once more */
+            unit            = perfMeasure(perfReference);
+            tests[i].cost   = perfMeasure(tests[i].pfOp) / unit;
+        }
+        printf("%-24s %9.4f (%.0f ns)", tests[i].name, tests[i].cost, tests[i].cost * unit);
+        if (write != 0)
+        {
+            printf("\n");
+        }
+        else if (tests[i].baseline <= 0.0)
+        {
+            printf("\tno baseline\n");
+        }
+        else if (tests[i].cost > limit)
+        {
+            printf("\tSLOWER than baseline %.4f + %u%%\n", tests[i].baseline, tests[i].tolerance);
+            rv = 1;
+        }
+        else
+        {
+            printf("\tok (baseline %.4f)\n", tests[i].baseline);
+        }
+    }
+    perfTeardown();
+
+    if (write != 0)
+    {
+        return perfWriteBaselines(pFile, tests, numTests);
+    }
+    return rv;
+}
+
 int main(int argc, char *argv[])
 {
+    if ((argc == 3) && ((strcmp(argv[1], "-p") == 0) || (strcmp(argv[1], "-w") == 0)))
+    {
+        if (testPerformance(argv[2], strcmp(argv[1], "-w") == 0))
+        {
+            printf("Performance check failed\n");
+            return 1;
+        }
+        printf("Performance check finished.\n");
+        return 0;
+    }
+
     printf("Starting tests\n");
     if (testInterfaces())
     {
@@ -327,6 +812,18 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if (testRing())
+    {
+        printf("Ring queue test failed\n");
+        return 1;
+    }
+
+    if(testSC32calculation())
+    {
+        printf("SC-32 calculation failed\n");
+        return 1;
+    }
+
     if(testCRCcalculation())
     {
         printf("CRC calculation failed\n");
@@ -0,0 +1,230 @@
+/**********************************************************************************************************************/
+/**
+ * @file            crc-bench.c
+ *
+ * @brief           Microbenchmark for the crc implementations
+ *
+ * @details         Verifies that all CRC implementations available on the target deliver the same results as the
+ *                  byte-by-byte reference and measures their throughput for typical TRDP buffer sizes, and
+ *                  for batches of PD headers computed one by one or with vos_crc32Multi().
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2013. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "vos_utils.h"
+#include "vos_thread.h"
+
+#define BENCH_BUFFER_SIZE   1500u           /* max. UDP payload                         */
+#define BENCH_BYTES         (64u * 1024u * 1024u)   /* bytes to process per measurement */
+#define BENCH_MULTI_BUFS    19u             /* buffers for vos_crc32Multi: 16 + 2 + 1 lanes */
+#define BENCH_HEADER_SIZE   36u             /* PD header without FCS                    */
+
+static const char *cImplNames[] = {"bytewise", "slice-by-8", "hardware"};
+
+/* Buffer sizes: PD header, small PD, SDTv2 payload, max. PD, odd sizes for the tail handling */
+static const UINT32 cSizes[] = {36u, 64u, 123u, 256u, 1000u, 1432u};
+
+static UINT8 gBuffer[BENCH_BUFFER_SIZE];
+
+/**********************************************************************************************************************/
+/** Compare all implementations against the reference
+ *
+ *  @retval         number of mismatches
+ */
+static int verify (void)
+{
+    UINT32      len, offset, n;
+    UINT32      refCrc, refSc;
+    const UINT8 *pBufs[BENCH_MULTI_BUFS];
+    UINT32      crcs[BENCH_MULTI_BUFS];
+    int         impl;
+    int         errors = 0;
+
+    /* all lengths and misalignments, to cover the head and tail handling of each variant */
+    for (offset = 0u; offset < 8u; offset++)
+    {
+        for (len = 0u; len <= 300u; len++)
+        {
+            (void) vos_crcSelect(VOS_CRC_BYTEWISE);
+            refCrc  = vos_crc32(INITFCS, gBuffer + offset, len);
+            refSc   = vos_sc32(INITFCS, gBuffer + offset, len);
+
+            for (impl = VOS_CRC_SLICE8; impl <= VOS_CRC_HW; impl++)
+            {
+                if (vos_crcSelect((VOS_CRC_IMPL_T) impl) != VOS_NO_ERR)
+                {
+                    continue;
+                }
+                if ((vos_crc32(INITFCS, gBuffer + offset, len) != refCrc) ||
+                    (vos_sc32(INITFCS, gBuffer + offset, len) != refSc))
+                {
+                    printf("%s: mismatch at offset %u, length %u\n", cImplNames[impl], offset, len);
+                    errors++;
+                }
+            }
+        }
+    }
+
+    /* multi-buffer: every buffer at another misalignment, compared to single calls of the reference */
+    for (len = 0u; len <= 100u; len++)
+    {
+        for (n = 0u; n < BENCH_MULTI_BUFS; n++)
+        {
+            pBufs[n] = gBuffer + n * 67u + (n % 8u);
+        }
+        for (impl = VOS_CRC_BYTEWISE; impl <= VOS_CRC_HW; impl++)
+        {
+            if (vos_crcSelect((VOS_CRC_IMPL_T) impl) != VOS_NO_ERR)
+            {
+                continue;
+            }
+            vos_crc32Multi(INITFCS, pBufs, len, BENCH_MULTI_BUFS, crcs);
+            (void) vos_crcSelect(VOS_CRC_BYTEWISE);
+            for (n = 0u; n < BENCH_MULTI_BUFS; n++)
+            {
+                if (crcs[n] != vos_crc32(INITFCS, pBufs[n], len))
+                {
+                    printf("%s: multi-buffer mismatch at buffer %u, length %u\n", cImplNames[impl], n, len);
+                    errors++;
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+/**********************************************************************************************************************/
+/** Measure the selected implementation on a batch of 16 PD headers, one call per header or one vos_crc32Multi call
+ *
+ *  @param[in]      multi           TRUE to use vos_crc32Multi
+ *
+ *  @retval         nanoseconds per header
+ */
+static double measureBatch (BOOL8 multi)
+{
+    VOS_TIMEVAL_T   start, end;
+    const UINT8     *pBufs[16];
+    UINT32          crcs[16];
+    UINT32          loops = BENCH_BYTES / (16u * BENCH_HEADER_SIZE);
+    UINT32          i, n;
+    volatile UINT32 crc = 0u;
+
+    for (n = 0u; n < 16u; n++)
+    {
+        pBufs[n] = gBuffer + n * 64u;
+    }
+    vos_getTime(&start);
+    for (i = 0u; i < loops; i++)
+    {
+        if (multi)
+        {
+            vos_crc32Multi(INITFCS, pBufs, BENCH_HEADER_SIZE, 16u, crcs);
+        }
+        else
+        {
+            for (n = 0u; n < 16u; n++)
+            {
+                crcs[n] = vos_crc32(INITFCS, pBufs[n], BENCH_HEADER_SIZE);
+            }
+        }
+        crc ^= crcs[i % 16u];
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+
+    return ((double) end.tv_sec * 1e9 + (double) end.tv_usec * 1e3) / ((double) loops * 16.0);
+}
+
+/**********************************************************************************************************************/
+/** Measure the throughput of the selected implementation
+ *
+ *  @param[in]      sc32            TRUE to measure vos_sc32
+ *  @param[in]      len             buffer size
+ *
+ *  @retval         nanoseconds per call
+ */
+static double measure (BOOL8 sc32, UINT32 len)
+{
+    VOS_TIMEVAL_T   start, end;
+    UINT32          loops = BENCH_BYTES / len;
+    UINT32          i;
+    volatile UINT32 crc = 0u;
+
+    vos_getTime(&start);
+    for (i = 0u; i < loops; i++)
+    {
+        crc ^= (sc32) ? vos_sc32(INITFCS, gBuffer, len) : vos_crc32(INITFCS, gBuffer, len);
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+
+    return ((double) end.tv_sec * 1e9 + (double) end.tv_usec * 1e3) / (double) loops;
+}
+
+int main ()
+{
+    UINT32  i, j;
+    int     impl;
+    int     errors;
+
+    for (i = 0u; i < BENCH_BUFFER_SIZE; i++)
+    {
+        gBuffer[i] = (UINT8) rand();
+    }
+
+    /* check value of the reference: CRC of "123456789" */
+    (void) vos_crcSelect(VOS_CRC_BYTEWISE);
+    printf("crc32(\"123456789\") = %08x (expected cbf43926)\n",
+           vos_crc32(INITFCS, (const UINT8 *) "123456789", 9u));
+
+    errors = verify();
+    printf("Verification: %s\n", (errors == 0) ? "all implementations match the reference" : "FAILED");
+
+    printf("\n%-12s %-6s", "variant", "crc");
+    for (j = 0u; j < sizeof(cSizes) / sizeof(cSizes[0]); j++)
+    {
+        printf(" %8u B", cSizes[j]);
+    }
+    printf("   (ns per call)\n");
+
+    for (impl = VOS_CRC_BYTEWISE; impl <= VOS_CRC_HW; impl++)
+    {
+        if (vos_crcSelect((VOS_CRC_IMPL_T) impl) != VOS_NO_ERR)
+        {
+            printf("%-12s not available\n", cImplNames[impl]);
+            continue;
+        }
+        for (i = 0u; i < 2u; i++)
+        {
+            printf("%-12s %-6s", cImplNames[impl], (i == 0u) ? "crc32" : "sc32");
+            for (j = 0u; j < sizeof(cSizes) / sizeof(cSizes[0]); j++)
+            {
+                printf(" %10.1f", measure((BOOL8) i, cSizes[j]));
+            }
+            printf("\n");
+        }
+    }
+
+    printf("\n%-12s %10s %10s   (ns per header, batch of 16)\n", "variant", "single", "multi");
+    for (impl = VOS_CRC_BYTEWISE; impl <= VOS_CRC_HW; impl++)
+    {
+        if (vos_crcSelect((VOS_CRC_IMPL_T) impl) == VOS_NO_ERR)
+        {
+            printf("%-12s %10.1f %10.1f\n", cImplNames[impl], measureBatch(FALSE), measureBatch(TRUE));
+        }
+    }
+    return (errors == 0) ? 0 : 1;
+}
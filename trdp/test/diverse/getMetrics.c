@@ -0,0 +1,188 @@
+/**********************************************************************************************************************/
+/**
+ * @file            getMetrics.c
+ *
+ * @brief           Sidecar serving the statistics exported by a TRDP session as OpenMetrics text
+ *
+ * @details         Reads the shared memory snapshot written by tlc_exportStatistics() of a session on this host.
+ *                  The text is printed or, for the textfile collector of a Prometheus node exporter, written to
+ *                  a file, once or periodically. The TRDP session is neither locked nor contacted.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif defined (WIN32)
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "trdp_types.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+#define APP_VERSION         "0.0.1.0"
+
+#define RESERVED_MEMORY     1000000u
+#define METRICS_SIZE        512000u             /* text buffer, enough for TRDP_EXPORT_MAX_ELE telegrams */
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void usage (const char *);
+int writeMetrics (const CHAR8 *pName, const char *pFile, CHAR8 *pText);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool prints the statistics exported by a TRDP session (tlc_exportStatistics) as OpenMetrics.\n"
+           "Arguments are:\n"
+           "-n <name>     name of the export (default /trdp-stats)\n"
+           "-f <file>     write to file instead of stdout (replaced atomically)\n"
+           "-i <seconds>  repeat every <seconds>, default: once\n"
+           "-v print version and quit\n"
+           );
+}
+
+/**********************************************************************************************************************/
+/** Read the exported statistics and write them out
+ *
+ *  @param[in]      pName           name of the export
+ *  @param[in]      pFile           file to write or NULL for stdout
+ *  @param[in]      pText           text buffer of METRICS_SIZE
+ *
+ *  @retval         0               no error
+ *  @retval         1               some error
+ */
+int writeMetrics (const CHAR8 *pName, const char *pFile, CHAR8 *pText)
+{
+    UINT32      size = METRICS_SIZE;
+    TRDP_ERR_T  err;
+    char        tmpFile[256];
+    FILE        *fp;
+
+    err = tlc_getExportedMetrics(pName, pText, &size);
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "tlc_getExportedMetrics(%s) failed (Err: %d)\n", pName, err);
+        return 1;
+    }
+
+    if (pFile == NULL)
+    {
+        fputs(pText, stdout);
+        fflush(stdout);
+        return 0;
+    }
+
+    /* The collector must never see a partly written file */
+    (void) vos_snprintf(tmpFile, sizeof(tmpFile), "%s.tmp", pFile);
+    fp = fopen(tmpFile, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Cannot write %s\n", tmpFile);
+        return 1;
+    }
+    fputs(pText, fp);
+    fclose(fp);
+    if (rename(tmpFile, pFile) != 0)
+    {
+        fprintf(stderr, "Cannot rename %s\n", tmpFile);
+        return 1;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_MEM_CONFIG_T   dynamicConfig   = {NULL, RESERVED_MEMORY, {0}};
+    const CHAR8         *pName          = "/trdp-stats";
+    const char          *pFile          = NULL;
+    unsigned int        interval        = 0u;
+    CHAR8               *pText;
+    int                 rv;
+    int                 ch;
+
+    while ((ch = getopt(argc, argv, "n:f:i:h?v")) != -1)
+    {
+        switch (ch)
+        {
+            case 'n':
+                pName = optarg;
+                break;
+            case 'f':
+                pFile = optarg;
+                break;
+            case 'i':
+                if (sscanf(optarg, "%u", &interval) < 1)
+                {
+                    usage(argv[0]);
+                    exit(1);
+                }
+                break;
+            case 'v':   /*  version */
+                printf("%s: Version %s\t(%s - %s)\n",
+                       argv[0], APP_VERSION, __DATE__, __TIME__);
+                exit(0);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    /*    Only the VOS is needed to attach to the shared memory, no session is opened    */
+    if (tlc_init(NULL, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+
+    pText = (CHAR8 *) malloc(METRICS_SIZE);
+    if (pText == NULL)
+    {
+        printf("Out of memory\n");
+        return 1;
+    }
+
+    do
+    {
+        rv = writeMetrics(pName, pFile, pText);
+        if (interval > 0u)
+        {
+            (void) vos_threadDelay(interval * 1000000u);
+        }
+    }
+    while (interval > 0u);
+
+    free(pText);
+    (void) tlc_terminate();
+    return rv;
+}
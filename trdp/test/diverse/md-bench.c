@@ -0,0 +1,650 @@
+/**********************************************************************************************************************/
+/**
+ * @file            md-bench.c
+ *
+ * @brief           Benchmark for MD request/reply over UDP and TCP
+ *
+ * @details         Two sessions on one host, each run by its own thread: the caller keeps a number of requests
+ *                  outstanding to the replier, whose listener answers every request with a reply of the same size.
+ *                  A new request is sent from the reply callback. For every combination of concurrency and payload
+ *                  size the benchmark measures
+ *                  - completed requests per second
+ *                  - round trip time from tlm_request() until the reply callback
+ *                  - memory of the TRDP memory pool in use (peak of samples taken during the run) and its blocks
+ *                  The results are written as JSON lines, one object per run, to be tracked across releases.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#include <signal.h>
+#elif defined (WIN32)
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "vos_thread.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION         "1.0"
+
+#define BENCH_COMID         31000u      /* ComId of request and reply                   */
+#define BENCH_MAX_CONC      256u        /* max. outstanding requests                    */
+#define BENCH_MAX_RUNS      16u         /* max. entries of the concurrency/size lists   */
+#define BENCH_HIST_SIZE     100000u     /* histogram buckets of 1us                     */
+#define BENCH_WARMUP        200000u     /* us before measuring                          */
+#define BENCH_REPLY_TO      1000000u    /* reply timeout, us                            */
+#define BENCH_LOOP_MAX      10000       /* max. select time of the session threads, us  */
+#define BENCH_MEM_SAMPLE    10000u      /* us between memory samples                    */
+#define RESERVED_MEMORY     64000000u   /* memory pool of the stack                     */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Session run by a thread */
+typedef struct
+{
+    TRDP_APP_SESSION_T  appHandle;
+    TRDP_IP_ADDR_T      ifaceIP;
+    VOS_THREAD_T        threadId;
+    volatile BOOL8      threadRun;
+    volatile BOOL8      threadDone;
+} BENCH_SESSION_T;
+
+/** Histogram of times in us, the last bucket takes the overflow */
+typedef struct
+{
+    UINT64  count;
+    UINT64  sum;
+    UINT32  max;
+    UINT32  bucket[BENCH_HIST_SIZE];
+} BENCH_HIST_T;
+
+/** An outstanding request */
+typedef struct
+{
+    TRDP_TIME_T     sent;
+    volatile BOOL8  pending;
+    volatile BOOL8  retry;      /**< request could not be sent, e.g. TCP send queue full */
+} BENCH_SLOT_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+static BENCH_SESSION_T  gCaller;
+static BENCH_SESSION_T  gReplier;
+static BENCH_SLOT_T     gSlot[BENCH_MAX_CONC];
+static BENCH_HIST_T     gRtt;
+static UINT8            gData[TRDP_MAX_MD_DATA_SIZE];
+static volatile BOOL8   gRunning    = FALSE;
+static volatile BOOL8   gMeasuring  = FALSE;
+static volatile UINT32  gCompleted  = 0u;
+static volatile UINT32  gErrors     = 0u;
+static UINT32           gPayload    = 0u;
+static UINT32           gDuration   = 2000u;
+static TRDP_FLAGS_T     gFlags      = TRDP_FLAGS_CALLBACK;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void usage (const char *);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool measures MD request/reply throughput and round trip time between two sessions on this host.\n"
+           "Arguments are:\n"
+           "-o <own IP address>     caller session (default 127.0.0.1)\n"
+           "-i <second IP address>  replier session (default 127.0.0.2)\n"
+           "-n <n,n,...>            outstanding requests (default 1,8,64)\n"
+           "-s <n,n,...>            payload sizes in bytes (default 64,1400,16384,65388)\n"
+           "-t                      use TCP (default UDP)\n"
+           "-d <ms>                 duration of each run (default 2000)\n"
+           "-f <file>               write the results to file (default stdout)\n"
+           "-v print version and quit\n"
+           );
+}
+
+/**********************************************************************************************************************/
+/** Time in us  */
+static UINT32 benchUs (
+    const TRDP_TIME_T *pTime)
+{
+    if (pTime->tv_sec < 0)
+    {
+        return 0u;
+    }
+    return (UINT32) pTime->tv_sec * 1000000u + (UINT32) pTime->tv_usec;
+}
+
+/**********************************************************************************************************************/
+/** Add a value to a histogram  */
+static void benchHistAdd (
+    BENCH_HIST_T    *pHist,
+    UINT32          us)
+{
+    pHist->count++;
+    pHist->sum += us;
+    if (us > pHist->max)
+    {
+        pHist->max = us;
+    }
+    pHist->bucket[(us < BENCH_HIST_SIZE) ? us : BENCH_HIST_SIZE - 1u]++;
+}
+
+/**********************************************************************************************************************/
+/** Percentile of a histogram in us  */
+static UINT32 benchHistPercentile (
+    const BENCH_HIST_T  *pHist,
+    UINT32              permille)
+{
+    UINT64  limit   = (pHist->count * permille + 999u) / 1000u;
+    UINT64  sum     = 0u;
+    UINT32  i;
+
+    for (i = 0u; i < BENCH_HIST_SIZE; i++)
+    {
+        sum += pHist->bucket[i];
+        if ((sum >= limit) && (sum > 0u))
+        {
+            return i;
+        }
+    }
+    return pHist->max;
+}
+
+/**********************************************************************************************************************/
+/** Write a histogram as JSON object  */
+static void benchHistPrint (
+    FILE                *fp,
+    const CHAR8         *pName,
+    const BENCH_HIST_T  *pHist)
+{
+    fprintf(fp, "\"%s\":{\"mean\":%.1f,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"p999\":%u,\"max\":%u}",
+            pName,
+            (pHist->count > 0u) ? (double) pHist->sum / (double) pHist->count : 0.0,
+            benchHistPercentile(pHist, 500u),
+            benchHistPercentile(pHist, 900u),
+            benchHistPercentile(pHist, 990u),
+            benchHistPercentile(pHist, 999u),
+            pHist->max);
+}
+
+/**********************************************************************************************************************/
+/** Send the request of a slot
+ */
+static TRDP_ERR_T benchRequest (
+    BENCH_SLOT_T *pSlot)
+{
+    TRDP_UUID_T sessionId;
+    TRDP_ERR_T  err;
+
+    pSlot->pending = TRUE;
+    vos_getTime(&pSlot->sent);
+    err = tlm_request(gCaller.appHandle, pSlot, NULL, &sessionId, BENCH_COMID, 0u, 0u,
+                      0u, gReplier.ifaceIP, gFlags, 1u, BENCH_REPLY_TO, NULL, gData, gPayload, NULL, NULL);
+    if (err != TRDP_NO_ERR)
+    {
+        pSlot->pending  = FALSE;
+        pSlot->retry    = (err == TRDP_BLOCK_ERR);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Send the requests again, which were blocked
+ */
+static void benchRetry (
+    UINT32 numConc)
+{
+    UINT32 i;
+
+    for (i = 0u; i < numConc; i++)
+    {
+        if (gSlot[i].retry)
+        {
+            gSlot[i].retry = FALSE;
+            (void) benchRequest(&gSlot[i]);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Callback of the caller: reply received or timed out, send the next request
+ */
+static void benchCallerCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    BENCH_SLOT_T    *pSlot = (BENCH_SLOT_T *) pMsg->pUserRef;
+    TRDP_TIME_T     now;
+
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+
+    if ((pSlot == NULL) || !pSlot->pending)
+    {
+        return;
+    }
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MP) && (dataSize == gPayload))
+    {
+        if (gMeasuring)
+        {
+            vos_getTime(&now);
+            vos_subTime(&now, &pSlot->sent);
+            benchHistAdd(&gRtt, benchUs(&now));
+            gCompleted++;
+        }
+    }
+    else if (gMeasuring)
+    {
+        gErrors++;
+    }
+    pSlot->pending = FALSE;
+
+    if (gRunning && (benchRequest(pSlot) != TRDP_NO_ERR) && !pSlot->retry && gMeasuring)
+    {
+        gErrors++;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Callback of the replier: answer every request with the same payload size
+ */
+static void benchReplierCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) pData;
+
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MR))
+    {
+        (void) tlm_reply(appHandle, &pMsg->sessionId, BENCH_COMID, 0u, NULL, gData, dataSize);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Processing loop of a session (thread)
+ */
+static void benchLoop (
+    void *pArg)
+{
+    BENCH_SESSION_T *pSession = (BENCH_SESSION_T *) pArg;
+    TRDP_TIME_T     maxTv   = {0, BENCH_LOOP_MAX};
+    INT32           ready   = 0;
+
+    while (pSession->threadRun)
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc;
+        INT32       rv;
+        TRDP_TIME_T tv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(pSession->appHandle, &tv, &rfds, &noDesc);
+        if (ready > 0)
+        {
+            /*  Messages queued by the callbacks are sent with the next tlc_process(), do not wait for it */
+            vos_clearTime(&tv);
+        }
+        else if (vos_cmpTime(&tv, &maxTv) > 0)
+        {
+            tv = maxTv;
+        }
+        rv      = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        ready   = rv;
+        (void) tlc_process(pSession->appHandle, &rfds, &rv);
+    }
+    pSession->threadDone = TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Open a session and start its thread
+ */
+static TRDP_ERR_T benchOpen (
+    BENCH_SESSION_T *pSession,
+    const CHAR8     *pName,
+    TRDP_MD_CALLBACK_T pfCbFunction)
+{
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_MD_CONFIG_T        mdConfig        = {NULL, NULL, TRDP_MD_DEFAULT_SEND_PARAM, TRDP_FLAGS_CALLBACK,
+                                               BENCH_REPLY_TO, TRDP_MD_DEFAULT_CONFIRM_TIMEOUT,
+                                               TRDP_MD_DEFAULT_CONNECTION_TIMEOUT,
+                                               TRDP_MD_DEFAULT_SENDING_TIMEOUT, TRDP_MD_UDP_PORT,
+                                               TRDP_MD_TCP_PORT, TRDP_MD_MAX_NUM_SESSIONS, 0u};
+    TRDP_ERR_T              err;
+
+    mdConfig.pfCbFunction = pfCbFunction;
+    err = tlc_openSession(&pSession->appHandle, pSession->ifaceIP, 0u, NULL, NULL, &mdConfig, &processConfig);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    pSession->threadRun     = TRUE;
+    pSession->threadDone    = FALSE;
+    if (vos_threadCreate(&pSession->threadId, pName, VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
+                         benchLoop, pSession) != VOS_NO_ERR)
+    {
+        (void) tlc_closeSession(pSession->appHandle);
+        return TRDP_THREAD_ERR;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop the thread of a session and close it
+ */
+static void benchClose (
+    BENCH_SESSION_T *pSession)
+{
+    pSession->threadRun = FALSE;
+    while (!pSession->threadDone)
+    {
+        (void) vos_threadDelay(1000u);
+    }
+    (void) tlc_closeSession(pSession->appHandle);
+    pSession->appHandle = NULL;
+}
+
+/**********************************************************************************************************************/
+/** Memory of the pool in use
+ *
+ *  @param[out]     pBlocks     number of allocated blocks
+ *
+ *  @retval         bytes in use
+ */
+static UINT32 benchMemUsed (
+    UINT32 *pBlocks)
+{
+    UINT32  allocated, freeSize, minFree, numAllocErr, numFreeErr;
+    UINT32  blockSize[VOS_MEM_NBLOCKSIZES];
+    UINT32  usedBlockSize[VOS_MEM_NBLOCKSIZES];
+
+    *pBlocks = 0u;
+    if (vos_memCount(&allocated, &freeSize, &minFree, pBlocks, &numAllocErr, &numFreeErr,
+                     blockSize, usedBlockSize) != VOS_NO_ERR)
+    {
+        return 0u;
+    }
+    return allocated - freeSize;
+}
+
+/**********************************************************************************************************************/
+/** One benchmark run
+ *
+ *  @param[in]      fp          output
+ *  @param[in]      numConc     number of outstanding requests
+ *  @param[in]      payload     payload size
+ *
+ *  @retval         0           no error
+ *  @retval         1           some error
+ */
+static int benchRun (
+    FILE    *fp,
+    UINT32  numConc,
+    UINT32  payload)
+{
+    TRDP_LIS_T  listenHandle;
+    TRDP_TIME_T start;
+    TRDP_TIME_T end;
+    TRDP_ERR_T  err;
+    double      seconds;
+    UINT32      memBase, memPeak, memUsed, blocksBase, blocksPeak, blocks;
+    UINT32      elapsed;
+    UINT32      i;
+
+    memset(gSlot, 0, sizeof(gSlot));
+    memset(&gRtt, 0, sizeof(gRtt));
+    gPayload    = payload;
+    gCompleted  = 0u;
+    gErrors     = 0u;
+    memBase     = benchMemUsed(&blocksBase);
+
+    err = benchOpen(&gReplier, "benchReplier", benchReplierCallback);
+    if (err == TRDP_NO_ERR)
+    {
+        err = benchOpen(&gCaller, "benchCaller", benchCallerCallback);
+        if (err != TRDP_NO_ERR)
+        {
+            benchClose(&gReplier);
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "tlc_openSession failed (Err: %d)\n", err);
+        return 1;
+    }
+
+    err = tlm_addListener(gReplier.appHandle, &listenHandle, NULL, NULL, TRUE, BENCH_COMID, 0u, 0u,
+                          0u, 0u, 0u, gFlags, NULL, NULL);
+    gRunning = TRUE;
+    for (i = 0u; (i < numConc) && (err == TRDP_NO_ERR); i++)
+    {
+        err = benchRequest(&gSlot[i]);
+        if (err == TRDP_BLOCK_ERR)
+        {
+            err = TRDP_NO_ERR;
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "tlm_addListener/tlm_request failed (Err: %d)\n", err);
+    }
+    else
+    {
+        for (elapsed = 0u; elapsed < BENCH_WARMUP; elapsed += BENCH_MEM_SAMPLE)
+        {
+            (void) vos_threadDelay(BENCH_MEM_SAMPLE);
+            benchRetry(numConc);
+        }
+
+        memPeak     = 0u;
+        blocksPeak  = 0u;
+        vos_getTime(&start);
+        gMeasuring  = TRUE;
+        for (elapsed = 0u; elapsed < gDuration * 1000u; elapsed += BENCH_MEM_SAMPLE)
+        {
+            (void) vos_threadDelay(BENCH_MEM_SAMPLE);
+            benchRetry(numConc);
+            memUsed = benchMemUsed(&blocks);
+            if (memUsed > memPeak)
+            {
+                memPeak = memUsed;
+            }
+            if (blocks > blocksPeak)
+            {
+                blocksPeak = blocks;
+            }
+        }
+        gMeasuring  = FALSE;
+        vos_getTime(&end);
+
+        vos_subTime(&end, &start);
+        seconds = (double) benchUs(&end) / 1000000.0;
+
+        fprintf(fp, "{\"bench\":\"md\",\"version\":\"%s\",\"transport\":\"%s\",\"concurrency\":%u,"
+                "\"payload\":%u,\"duration_s\":%.3f,\"completed\":%u,\"errors\":%u,\"requests_per_s\":%.0f,",
+                tlc_getVersionString(), ((gFlags & TRDP_FLAGS_TCP) != 0u) ? "tcp" : "udp", numConc,
+                payload, seconds, gCompleted, gErrors, (double) gCompleted / seconds);
+        benchHistPrint(fp, "rtt_us", &gRtt);
+        fprintf(fp, ",\"mem_peak_bytes\":%u,\"mem_peak_blocks\":%u}\n",
+                (memPeak > memBase) ? memPeak - memBase : 0u,
+                (blocksPeak > blocksBase) ? blocksPeak - blocksBase : 0u);
+        fflush(fp);
+    }
+
+    /*  Let the outstanding requests complete before closing the sessions   */
+    gRunning = FALSE;
+    for (elapsed = 0u; elapsed < BENCH_REPLY_TO; elapsed += 1000u)
+    {
+        for (i = 0u; (i < numConc) && !gSlot[i].pending; i++)
+        {
+            ;
+        }
+        if (i == numConc)
+        {
+            break;
+        }
+        (void) vos_threadDelay(1000u);
+    }
+
+    benchClose(&gCaller);
+    benchClose(&gReplier);
+    return (err == TRDP_NO_ERR) ? 0 : 1;
+}
+
+/**********************************************************************************************************************/
+/** Parse a comma separated list of numbers
+ *
+ *  @retval         number of entries
+ */
+static UINT32 benchParseList (
+    char    *pList,
+    UINT32  *pValues,
+    UINT32  max)
+{
+    UINT32  num = 0u;
+    char    *pToken;
+
+    for (pToken = strtok(pList, ","); (pToken != NULL) && (num < max); pToken = strtok(NULL, ","))
+    {
+        pValues[num++] = (UINT32) strtoul(pToken, NULL, 10);
+    }
+    return num;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_MEM_CONFIG_T memConfig             = {NULL, RESERVED_MEMORY, {0}};
+    UINT32  concurrency[BENCH_MAX_RUNS]     = {1u, 8u, 64u};
+    UINT32  payloads[BENCH_MAX_RUNS]        = {64u, 1400u, 16384u, TRDP_MAX_MD_DATA_SIZE};
+    UINT32  numConcurrency  = 3u;
+    UINT32  numPayloads     = 4u;
+    FILE    *fp             = stdout;
+    int     rv              = 0;
+    int     ch;
+    UINT32  i, j;
+    unsigned int ip[4];
+
+    gCaller.ifaceIP     = vos_dottedIP("127.0.0.1");
+    gReplier.ifaceIP    = vos_dottedIP("127.0.0.2");
+
+    while ((ch = getopt(argc, argv, "o:i:n:s:td:f:h?v")) != -1)
+    {
+        switch (ch)
+        {
+            case 'o':
+            case 'i':
+                if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+                {
+                    usage(argv[0]);
+                    exit(1);
+                }
+                ((ch == 'o') ? &gCaller : &gReplier)->ifaceIP =
+                    (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+                break;
+            case 'n':
+                numConcurrency = benchParseList(optarg, concurrency, BENCH_MAX_RUNS);
+                break;
+            case 's':
+                numPayloads = benchParseList(optarg, payloads, BENCH_MAX_RUNS);
+                break;
+            case 't':
+                gFlags |= TRDP_FLAGS_TCP;
+                break;
+            case 'd':
+                gDuration = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                fp = fopen(optarg, "w");
+                if (fp == NULL)
+                {
+                    fprintf(stderr, "Cannot write %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'v':   /*  version */
+                printf("%s: Version %s\t(%s - %s)\n",
+                       argv[0], APP_VERSION, __DATE__, __TIME__);
+                exit(0);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+#if defined (POSIX)
+    /*    A TCP peer closing its connection must not terminate the benchmark    */
+    (void) signal(SIGPIPE, SIG_IGN);
+#endif
+
+    /*    No debug output, it would disturb the measurement    */
+    if (tlc_init(NULL, NULL, &memConfig) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Initialization error\n");
+        return 1;
+    }
+    memset(gData, 0x55, sizeof(gData));
+
+    for (i = 0u; i < numConcurrency; i++)
+    {
+        for (j = 0u; j < numPayloads; j++)
+        {
+            if ((concurrency[i] == 0u) || (concurrency[i] > BENCH_MAX_CONC) ||
+                (payloads[j] == 0u) || (payloads[j] > TRDP_MAX_MD_DATA_SIZE))
+            {
+                fprintf(stderr, "Skipping %u requests with %u bytes\n", concurrency[i], payloads[j]);
+                continue;
+            }
+            rv |= benchRun(fp, concurrency[i], payloads[j]);
+        }
+    }
+
+    (void) tlc_terminate();
+    if (fp != stdout)
+    {
+        fclose(fp);
+    }
+    return rv;
+}
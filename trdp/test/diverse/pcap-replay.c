@@ -0,0 +1,990 @@
+/**********************************************************************************************************************/
+/**
+ * @file            pcap-replay.c
+ *
+ * @brief           Replay of recorded TRDP traffic into a session
+ *
+ * @details         Reads a pcap or pcapng capture, extracts the UDP PD and MD frames (IPv4 over Ethernet, VLAN,
+ *                  Linux cooked or raw IP) and sends them over the loopback interface to a session on this host,
+ *                  which subscribes to every PD comId and listens to every MD comId found in the capture.
+ *                  Frames are sent as fast as the session takes them (at most n frames in flight) or with the
+ *                  timing of the capture. Sequence counters (and MD session IDs) are rewritten with a running
+ *                  number, so the frames are not dropped as duplicates when the capture is replayed in a loop.
+ *                  The tool reports
+ *                  - frames sent and processed (callbacks) per second
+ *                  - send to callback latency
+ *                  - CPU time per frame
+ *                  as one JSON line per replay, to be tracked across releases.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif defined (WIN32)
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "vos_thread.h"
+#include "vos_sock.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION         "1.0"
+
+#define REPLAY_MAX_COMIDS   10000u      /* max. distinct comIds of PD and MD each       */
+#define REPLAY_RING         65536u      /* send time stamps, power of 2, > window       */
+#define REPLAY_HIST_SIZE    20000u      /* histogram buckets of 1us                     */
+#define REPLAY_LOOP_MAX     10000       /* max. select time of the session thread, us   */
+#define REPLAY_STALL        10000u      /* us to wait for a callback of a full window   */
+#define REPLAY_MAX_IF       16u         /* pcapng interfaces per section                */
+
+#define PCAP_MAGIC_US       0xA1B2C3D4u
+#define PCAP_MAGIC_NS       0xA1B23C4Du
+#define PCAPNG_SHB          0x0A0D0D0Au
+#define PCAPNG_IDB          0x00000001u
+#define PCAPNG_SPB          0x00000003u
+#define PCAPNG_EPB          0x00000006u
+#define PCAPNG_BOM          0x1A2B3C4Du
+
+#define LINKTYPE_NULL       0u
+#define LINKTYPE_ETHERNET   1u
+#define LINKTYPE_RAW        101u
+#define LINKTYPE_RAW_OLD    12u
+#define LINKTYPE_SLL        113u
+#define LINKTYPE_SLL2       276u
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Frame of the capture, the UDP payload points into the file buffer */
+typedef struct
+{
+    UINT64  tsUs;           /**< capture time stamp in us   */
+    UINT8   *pData;         /**< UDP payload (TRDP frame)   */
+    UINT32  size;           /**< UDP payload size           */
+    UINT16  port;           /**< UDP destination port       */
+    BOOL8   windowed;       /**< a callback is expected     */
+} REPLAY_FRAME_T;
+
+/** pcapng interface */
+typedef struct
+{
+    UINT32  linkType;
+    UINT64  tsDiv;          /**< time stamp units per us (0: multiply by tsMul) */
+    UINT64  tsMul;
+} REPLAY_IF_T;
+
+/** Histogram of times in us, the last bucket takes the overflow */
+typedef struct
+{
+    UINT64  count;
+    UINT64  sum;
+    UINT32  max;
+    UINT32  bucket[REPLAY_HIST_SIZE];
+} REPLAY_HIST_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+static TRDP_APP_SESSION_T   gAppHandle  = NULL;
+static VOS_THREAD_T         gThreadId;
+static volatile BOOL8       gThreadRun  = FALSE;
+static volatile BOOL8       gThreadDone = FALSE;
+static TRDP_IP_ADDR_T       gIfaceIP    = 0x7F000001u;
+
+static REPLAY_FRAME_T       *gFrames    = NULL;
+static UINT32               gNumFrames  = 0u;
+static UINT32               gMaxFrames  = 0u;
+static UINT32               gPdComIds[REPLAY_MAX_COMIDS];
+static UINT32               gNumPdComIds = 0u;
+static UINT32               gMdComIds[REPLAY_MAX_COMIDS];
+static UINT32               gNumMdComIds = 0u;
+static UINT32               gSkipped    = 0u;
+
+static TRDP_TIME_T          gSendTime[REPLAY_RING];
+static REPLAY_HIST_T        gLatency;
+static volatile UINT32      gCallbacks  = 0u;
+static UINT32               gCbWorkers  = 0u;
+static VOS_MUTEX_T          gHistMutex  = NULL;     /* callbacks of worker threads run in parallel */
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void usage (const char *);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool replays the TRDP frames of a pcap/pcapng capture into a session on this host.\n"
+           "Arguments are:\n"
+           "-r <file>               capture to replay (pcap or pcapng)\n"
+           "-o <own IP address>     session address the frames are sent to (default 127.0.0.1)\n"
+           "-l <n>                  replay the capture n times (default 1)\n"
+           "-T                      keep the timing of the capture (default: as fast as possible)\n"
+           "-x <factor>             speed up the capture timing by factor (default 1.0)\n"
+           "-n <n>                  max. frames in flight without timing (default 64)\n"
+           "-w <n>                  call the callbacks from n worker threads (cbWorkers)\n"
+           "-f <file>               write the results to file (default stdout)\n"
+           "-v print version and quit\n"
+           );
+}
+
+/**********************************************************************************************************************/
+/** Time in us  */
+static UINT32 replayUs (
+    const TRDP_TIME_T *pTime)
+{
+    if (pTime->tv_sec < 0)
+    {
+        return 0u;
+    }
+    return (UINT32) pTime->tv_sec * 1000000u + (UINT32) pTime->tv_usec;
+}
+
+/**********************************************************************************************************************/
+/** Add a value to a histogram  */
+static void replayHistAdd (
+    REPLAY_HIST_T   *pHist,
+    UINT32          us)
+{
+    pHist->count++;
+    pHist->sum += us;
+    if (us > pHist->max)
+    {
+        pHist->max = us;
+    }
+    pHist->bucket[(us < REPLAY_HIST_SIZE) ? us : REPLAY_HIST_SIZE - 1u]++;
+}
+
+/**********************************************************************************************************************/
+/** Percentile of a histogram in us  */
+static UINT32 replayHistPercentile (
+    const REPLAY_HIST_T *pHist,
+    UINT32              percent)
+{
+    UINT64  limit   = (pHist->count * percent + 99u) / 100u;
+    UINT64  sum     = 0u;
+    UINT32  i;
+
+    for (i = 0u; i < REPLAY_HIST_SIZE; i++)
+    {
+        sum += pHist->bucket[i];
+        if ((sum >= limit) && (sum > 0u))
+        {
+            return i;
+        }
+    }
+    return pHist->max;
+}
+
+/**********************************************************************************************************************/
+/** Read 16/32 bit values of the capture in its byte order  */
+static UINT16 replayGet16 (
+    const UINT8 *p,
+    BOOL8       swap)
+{
+    return swap ? (UINT16) ((p[0] << 8) | p[1]) : (UINT16) ((p[1] << 8) | p[0]);
+}
+
+static UINT32 replayGet32 (
+    const UINT8 *p,
+    BOOL8       swap)
+{
+    return swap ? ((UINT32) p[0] << 24) | ((UINT32) p[1] << 16) | ((UINT32) p[2] << 8) | p[3]
+           : ((UINT32) p[3] << 24) | ((UINT32) p[2] << 16) | ((UINT32) p[1] << 8) | p[0];
+}
+
+/**********************************************************************************************************************/
+/** Insert a comId into a sorted list, if not yet there  */
+static void replayAddComId (
+    UINT32  *pList,
+    UINT32  *pNum,
+    UINT32  comId)
+{
+    UINT32  lo  = 0u;
+    UINT32  hi  = *pNum;
+
+    while (lo < hi)
+    {
+        UINT32 mid = (lo + hi) / 2u;
+        if (pList[mid] < comId)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (((lo < *pNum) && (pList[lo] == comId)) || (*pNum >= REPLAY_MAX_COMIDS))
+    {
+        return;
+    }
+    memmove(&pList[lo + 1u], &pList[lo], (*pNum - lo) * sizeof(UINT32));
+    pList[lo] = comId;
+    (*pNum)++;
+}
+
+/**********************************************************************************************************************/
+/** Take a captured packet: strip the link, IPv4 and UDP headers and keep TRDP frames
+ *
+ *  @param[in]      linkType    link type of the capture
+ *  @param[in]      tsUs        time stamp in us
+ *  @param[in]      pPkt        captured bytes
+ *  @param[in]      capLen      number of captured bytes
+ */
+static void replayAddPacket (
+    UINT32  linkType,
+    UINT64  tsUs,
+    UINT8   *pPkt,
+    UINT32  capLen)
+{
+    UINT32          offset;
+    UINT32          etherType   = 0x0800u;
+    UINT32          ihl;
+    UINT32          udpLen;
+    UINT16          port;
+    UINT16          msgType;
+    REPLAY_FRAME_T  *pFrame;
+
+    switch (linkType)
+    {
+        case LINKTYPE_ETHERNET:
+            if (capLen < 14u)
+            {
+                return;
+            }
+            offset      = 14u;
+            etherType   = (UINT32) ((pPkt[12] << 8) | pPkt[13]);
+            while (((etherType == 0x8100u) || (etherType == 0x88A8u)) && (capLen >= offset + 4u))
+            {
+                etherType   = (UINT32) ((pPkt[offset + 2u] << 8) | pPkt[offset + 3u]);
+                offset      += 4u;
+            }
+            break;
+        case LINKTYPE_SLL:
+            if (capLen < 16u)
+            {
+                return;
+            }
+            offset      = 16u;
+            etherType   = (UINT32) ((pPkt[14] << 8) | pPkt[15]);
+            break;
+        case LINKTYPE_SLL2:
+            if (capLen < 20u)
+            {
+                return;
+            }
+            offset      = 20u;
+            etherType   = (UINT32) ((pPkt[0] << 8) | pPkt[1]);
+            break;
+        case LINKTYPE_NULL:
+            offset = 4u;
+            break;
+        case LINKTYPE_RAW:
+        case LINKTYPE_RAW_OLD:
+            offset = 0u;
+            break;
+        default:
+            gSkipped++;
+            return;
+    }
+
+    /* IPv4, UDP, not fragmented */
+    if ((etherType != 0x0800u) || (capLen < offset + 20u) || ((pPkt[offset] >> 4) != 4u) ||
+        (pPkt[offset + 9u] != 17u) || (((pPkt[offset + 6u] & 0x3Fu) | pPkt[offset + 7u]) != 0u))
+    {
+        return;
+    }
+    ihl     = (pPkt[offset] & 0x0Fu) * 4u;
+    offset  += ihl;
+    if (capLen < offset + 8u)
+    {
+        return;
+    }
+    port    = (UINT16) ((pPkt[offset + 2u] << 8) | pPkt[offset + 3u]);
+    udpLen  = (UINT32) ((pPkt[offset + 4u] << 8) | pPkt[offset + 5u]);
+    if ((port != TRDP_PD_UDP_PORT) && (port != TRDP_MD_UDP_PORT))
+    {
+        return;
+    }
+    offset  += 8u;
+    udpLen  = (udpLen >= 8u) ? udpLen - 8u : 0u;
+    if (udpLen > capLen - offset)
+    {
+        gSkipped++;     /* truncated by the snap length */
+        return;
+    }
+    if (udpLen < ((port == TRDP_PD_UDP_PORT) ? sizeof(PD_HEADER_T) : sizeof(MD_HEADER_T)))
+    {
+        gSkipped++;
+        return;
+    }
+
+    if (gNumFrames == gMaxFrames)
+    {
+        REPLAY_FRAME_T *pNew;
+
+        gMaxFrames  = (gMaxFrames == 0u) ? 4096u : gMaxFrames * 2u;
+        pNew        = (REPLAY_FRAME_T *) realloc(gFrames, gMaxFrames * sizeof(REPLAY_FRAME_T));
+        if (pNew == NULL)
+        {
+            gSkipped++;
+            gMaxFrames = gNumFrames;
+            return;
+        }
+        gFrames = pNew;
+    }
+    pFrame          = &gFrames[gNumFrames++];
+    pFrame->tsUs    = tsUs;
+    pFrame->pData   = pPkt + offset;
+    pFrame->size    = udpLen;
+    pFrame->port    = port;
+
+    if (port == TRDP_PD_UDP_PORT)
+    {
+        const PD_HEADER_T *pHead = (const PD_HEADER_T *) pFrame->pData;
+
+        msgType = vos_ntohs(pHead->msgType);
+        pFrame->windowed = (msgType == TRDP_MSG_PD) || (msgType == TRDP_MSG_PP);
+        if (pFrame->windowed)
+        {
+            replayAddComId(gPdComIds, &gNumPdComIds, vos_ntohl(pHead->comId));
+        }
+    }
+    else
+    {
+        const MD_HEADER_T *pHead = (const MD_HEADER_T *) pFrame->pData;
+
+        msgType = vos_ntohs(pHead->msgType);
+        pFrame->windowed = (msgType == TRDP_MSG_MN) || (msgType == TRDP_MSG_MR);
+        if (pFrame->windowed)
+        {
+            replayAddComId(gMdComIds, &gNumMdComIds, vos_ntohl(pHead->comId));
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Parse a classic pcap file in memory
+ *
+ *  @retval         0           no error
+ *  @retval         1           not a valid pcap file
+ */
+static int replayParsePcap (
+    UINT8   *pBuf,
+    UINT32  size)
+{
+    UINT32  magic       = replayGet32(pBuf, FALSE);
+    BOOL8   swap        = FALSE;
+    BOOL8   nano        = FALSE;
+    UINT32  linkType;
+    UINT32  offset      = 24u;
+
+    if ((magic == PCAP_MAGIC_US) || (magic == PCAP_MAGIC_NS))
+    {
+        nano = (magic == PCAP_MAGIC_NS);
+    }
+    else
+    {
+        magic = replayGet32(pBuf, TRUE);
+        if ((magic != PCAP_MAGIC_US) && (magic != PCAP_MAGIC_NS))
+        {
+            return 1;
+        }
+        swap    = TRUE;
+        nano    = (magic == PCAP_MAGIC_NS);
+    }
+    linkType = replayGet32(pBuf + 20, swap) & 0xFFFFu;
+
+    while (offset + 16u <= size)
+    {
+        UINT64  sec     = replayGet32(pBuf + offset, swap);
+        UINT64  frac    = replayGet32(pBuf + offset + 4u, swap);
+        UINT32  capLen  = replayGet32(pBuf + offset + 8u, swap);
+
+        offset += 16u;
+        if (capLen > size - offset)
+        {
+            break;
+        }
+        replayAddPacket(linkType, sec * 1000000u + (nano ? frac / 1000u : frac), pBuf + offset, capLen);
+        offset += capLen;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Parse a pcapng file in memory
+ *
+ *  @retval         0           no error
+ *  @retval         1           not a valid pcapng file
+ */
+static int replayParsePcapng (
+    UINT8   *pBuf,
+    UINT32  size)
+{
+    REPLAY_IF_T ifs[REPLAY_MAX_IF];
+    UINT32      numIfs  = 0u;
+    UINT32      offset  = 0u;
+    BOOL8       swap    = FALSE;
+
+    while (offset + 12u <= size)
+    {
+        UINT32  type    = replayGet32(pBuf + offset, swap);
+        UINT32  len;
+        UINT8   *pBody;
+
+        if (type == PCAPNG_SHB)
+        {
+            /* the byte order magic follows the length; a new section resets the interfaces */
+            swap    = (replayGet32(pBuf + offset + 8u, FALSE) != PCAPNG_BOM);
+            numIfs  = 0u;
+        }
+        len = replayGet32(pBuf + offset + 4u, swap);
+        if ((len < 12u) || (len > size - offset) || ((len & 3u) != 0u))
+        {
+            return (offset == 0u) ? 1 : 0;
+        }
+        pBody = pBuf + offset + 8u;
+
+        if ((type == PCAPNG_IDB) && (len >= 20u) && (numIfs < REPLAY_MAX_IF))
+        {
+            UINT32 opt = 8u;
+
+            ifs[numIfs].linkType    = replayGet16(pBody, swap);
+            ifs[numIfs].tsDiv       = 1u;
+            ifs[numIfs].tsMul       = 1u;
+            while (opt + 4u <= len - 12u)
+            {
+                UINT16  code    = replayGet16(pBody + opt, swap);
+                UINT16  optLen  = replayGet16(pBody + opt + 2u, swap);
+
+                if (code == 0u)
+                {
+                    break;
+                }
+                if ((code == 9u) && (optLen == 1u))  /* if_tsresol */
+                {
+                    UINT8   res     = pBody[opt + 4u];
+                    UINT64  units   = 1u;
+                    UINT32  i;
+
+                    for (i = 0u; i < (res & 0x7Fu) && i < 63u; i++)
+                    {
+                        units *= (res & 0x80u) ? 2u : 10u;
+                    }
+                    /* units per second -> per us */
+                    if (units >= 1000000u)
+                    {
+                        ifs[numIfs].tsDiv = units / 1000000u;
+                    }
+                    else
+                    {
+                        ifs[numIfs].tsMul = 1000000u / units;
+                    }
+                }
+                opt += 4u + ((optLen + 3u) & ~3u);
+            }
+            numIfs++;
+        }
+        else if ((type == PCAPNG_EPB) && (len >= 32u))
+        {
+            UINT32  ifId    = replayGet32(pBody, swap);
+            UINT64  ts      = ((UINT64) replayGet32(pBody + 4u, swap) << 32) | replayGet32(pBody + 8u, swap);
+            UINT32  capLen  = replayGet32(pBody + 12u, swap);
+
+            if ((ifId < numIfs) && (capLen <= len - 32u))
+            {
+                replayAddPacket(ifs[ifId].linkType, ts / ifs[ifId].tsDiv * ifs[ifId].tsMul, pBody + 20u, capLen);
+            }
+        }
+        else if ((type == PCAPNG_SPB) && (len >= 16u) && (numIfs > 0u))
+        {
+            UINT32 capLen = replayGet32(pBody, swap);
+
+            if (capLen > len - 16u)
+            {
+                capLen = len - 16u;
+            }
+            /* no time stamp, keep the one of the last frame */
+            replayAddPacket(ifs[0].linkType, (gNumFrames > 0u) ? gFrames[gNumFrames - 1u].tsUs : 0u,
+                            pBody + 4u, capLen);
+        }
+        offset += len;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Read a capture file into memory and extract its TRDP frames
+ *
+ *  @retval         NULL        error
+ *  @retval         != NULL     file buffer, the frames point into it
+ */
+static UINT8 *replayLoad (
+    const char *pFileName)
+{
+    FILE    *fp     = fopen(pFileName, "rb");
+    UINT8   *pBuf   = NULL;
+    long    size;
+    int     err     = 1;
+
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Cannot read %s\n", pFileName);
+        return NULL;
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) && ((size = ftell(fp)) >= 24) && (fseek(fp, 0, SEEK_SET) == 0))
+    {
+        pBuf = (UINT8 *) malloc((size_t) size);
+        if ((pBuf != NULL) && (fread(pBuf, 1u, (size_t) size, fp) == (size_t) size))
+        {
+            if (replayGet32(pBuf, FALSE) == PCAPNG_SHB)
+            {
+                err = replayParsePcapng(pBuf, (UINT32) size);
+            }
+            else
+            {
+                err = replayParsePcap(pBuf, (UINT32) size);
+            }
+        }
+    }
+    fclose(fp);
+    if (err != 0)
+    {
+        fprintf(stderr, "%s is no pcap or pcapng file\n", pFileName);
+        free(pBuf);
+        return NULL;
+    }
+    return pBuf;
+}
+
+/**********************************************************************************************************************/
+/** Latency of a callback by the sequence counter we gave its frame  */
+static void replayCount (
+    UINT32 seqCount)
+{
+    TRDP_TIME_T now;
+
+    vos_getTime(&now);
+    vos_subTime(&now, &gSendTime[seqCount & (REPLAY_RING - 1u)]);
+    if (gHistMutex != NULL)
+    {
+        (void) vos_mutexLock(gHistMutex);
+    }
+    replayHistAdd(&gLatency, replayUs(&now));
+    gCallbacks++;
+    if (gHistMutex != NULL)
+    {
+        (void) vos_mutexUnlock(gHistMutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Callback of the subscriptions  */
+static void replayPdCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        replayCount(pMsg->seqCount);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Callback of the listeners, requests are answered without data  */
+static void replayMdCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) pData;
+    (void) dataSize;
+
+    if (pMsg->resultCode != TRDP_NO_ERR)
+    {
+        return;
+    }
+    if (pMsg->msgType == TRDP_MSG_MR)
+    {
+        (void) tlm_reply(appHandle, &pMsg->sessionId, pMsg->comId, 0u, NULL, NULL, 0u);
+    }
+    replayCount(pMsg->seqCount);
+}
+
+/**********************************************************************************************************************/
+/** Processing loop of the session (thread)  */
+static void replayLoop (
+    void *pArg)
+{
+    TRDP_TIME_T maxTv = {0, REPLAY_LOOP_MAX};
+
+    (void) pArg;
+    while (gThreadRun)
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc;
+        INT32       rv;
+        TRDP_TIME_T tv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(gAppHandle, &tv, &rfds, &noDesc);
+        if (vos_cmpTime(&tv, &maxTv) > 0)
+        {
+            tv = maxTv;
+        }
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(gAppHandle, &rfds, &rv);
+    }
+    gThreadDone = TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Open the session, subscribe and listen to the comIds of the capture and start the session thread
+ */
+static TRDP_ERR_T replayOpen (void)
+{
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_MD_CONFIG_T        mdConfig        = {NULL, NULL, TRDP_MD_DEFAULT_SEND_PARAM, TRDP_FLAGS_CALLBACK,
+                                               TRDP_MD_DEFAULT_REPLY_TIMEOUT, TRDP_MD_DEFAULT_CONFIRM_TIMEOUT,
+                                               TRDP_MD_DEFAULT_CONNECTION_TIMEOUT,
+                                               TRDP_MD_DEFAULT_SENDING_TIMEOUT, TRDP_MD_UDP_PORT,
+                                               TRDP_MD_TCP_PORT, TRDP_MD_MAX_NUM_SESSIONS, 0u};
+    TRDP_ERR_T              err;
+    UINT32                  i;
+
+    processConfig.cbWorkers = gCbWorkers;
+    mdConfig.pfCbFunction   = replayMdCallback;
+    err = tlc_openSession(&gAppHandle, gIfaceIP, 0u, NULL, NULL, &mdConfig, &processConfig);
+    for (i = 0u; (i < gNumPdComIds) && (err == TRDP_NO_ERR); i++)
+    {
+        TRDP_SUB_T subHandle;
+
+        err = tlp_subscribe(gAppHandle, &subHandle, NULL, replayPdCallback, gPdComIds[i],
+                            0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                            TRDP_INFINITE_TIMEOUT, TRDP_TO_DEFAULT);
+    }
+    for (i = 0u; (i < gNumMdComIds) && (err == TRDP_NO_ERR); i++)
+    {
+        TRDP_LIS_T listenHandle;
+
+        err = tlm_addListener(gAppHandle, &listenHandle, NULL, NULL, TRUE, gMdComIds[i], 0u, 0u,
+                              0u, 0u, 0u, TRDP_FLAGS_CALLBACK, NULL, NULL);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        if (gAppHandle != NULL)
+        {
+            (void) tlc_closeSession(gAppHandle);
+        }
+        return err;
+    }
+    gThreadRun  = TRUE;
+    gThreadDone = FALSE;
+    if (vos_threadCreate(&gThreadId, "replay", VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
+                         replayLoop, NULL) != VOS_NO_ERR)
+    {
+        (void) tlc_closeSession(gAppHandle);
+        return TRDP_THREAD_ERR;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Give a frame the running sequence counter (and MD session ID) and recalculate its header CRC  */
+static void replayPatch (
+    REPLAY_FRAME_T  *pFrame,
+    UINT32          seqCount)
+{
+    if (pFrame->port == TRDP_PD_UDP_PORT)
+    {
+        PD_HEADER_T *pHead = (PD_HEADER_T *) pFrame->pData;
+
+        pHead->sequenceCounter  = vos_htonl(seqCount);
+        pHead->frameCheckSum    = MAKE_LE(vos_crc32(INITFCS, (UINT8 *) pHead, sizeof(PD_HEADER_T) - SIZE_OF_FCS));
+    }
+    else
+    {
+        MD_HEADER_T *pHead = (MD_HEADER_T *) pFrame->pData;
+
+        pHead->sequenceCounter  = vos_htonl(seqCount);
+        pHead->sessionID[12]    = (UINT8) (seqCount >> 24);
+        pHead->sessionID[13]    = (UINT8) (seqCount >> 16);
+        pHead->sessionID[14]    = (UINT8) (seqCount >> 8);
+        pHead->sessionID[15]    = (UINT8) seqCount;
+        pHead->frameCheckSum    = MAKE_LE(vos_crc32(INITFCS, (UINT8 *) pHead, sizeof(MD_HEADER_T) - SIZE_OF_FCS));
+    }
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    const char          *pCapture   = NULL;
+    FILE                *fp         = stdout;
+    UINT8               *pBuf;
+    UINT32              loops       = 1u;
+    UINT32              window      = 64u;
+    BOOL8               timed       = FALSE;
+    double              speed       = 1.0;
+    SOCKET              sock;
+    VOS_SOCK_OPT_T      sockOpts;
+    TRDP_STATISTICS_T   stats;
+    TRDP_TIME_T         start;
+    TRDP_TIME_T         end;
+    TRDP_TIME_T         now;
+    clock_t             cpuStart;
+    clock_t             cpuEnd;
+    UINT32              seqCount    = 0u;
+    UINT32              windowed    = 0u;
+    UINT32              stalled     = 0u;
+    UINT32              sendErrors  = 0u;
+    double              seconds;
+    double              cpuUs;
+    UINT32              l, i;
+    int                 ch;
+    unsigned int        ip[4];
+
+    while ((ch = getopt(argc, argv, "r:o:l:Tx:n:w:f:h?v")) != -1)
+    {
+        switch (ch)
+        {
+            case 'r':
+                pCapture = optarg;
+                break;
+            case 'o':
+                if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+                {
+                    usage(argv[0]);
+                    exit(1);
+                }
+                gIfaceIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+                break;
+            case 'l':
+                loops = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'T':
+                timed = TRUE;
+                break;
+            case 'x':
+                speed = strtod(optarg, NULL);
+                break;
+            case 'n':
+                window = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                gCbWorkers = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                fp = fopen(optarg, "w");
+                if (fp == NULL)
+                {
+                    fprintf(stderr, "Cannot write %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'v':   /*  version */
+                printf("%s: Version %s\t(%s - %s)\n",
+                       argv[0], APP_VERSION, __DATE__, __TIME__);
+                exit(0);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if ((pCapture == NULL) || (loops == 0u) || (window == 0u) || (window >= REPLAY_RING) || (speed <= 0.0))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    pBuf = replayLoad(pCapture);
+    if (pBuf == NULL)
+    {
+        return 1;
+    }
+    if (gNumFrames == 0u)
+    {
+        fprintf(stderr, "No TRDP frames in %s\n", pCapture);
+        free(pBuf);
+        return 1;
+    }
+
+    /*    No debug output, it would disturb the measurement    */
+    if (tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Initialization error\n");
+        return 1;
+    }
+    if ((gCbWorkers > 0u) && (vos_mutexCreate(&gHistMutex) != VOS_NO_ERR))
+    {
+        fprintf(stderr, "vos_mutexCreate failed\n");
+        return 1;
+    }
+    memset(&sockOpts, 0, sizeof(sockOpts));
+    if ((replayOpen() != TRDP_NO_ERR) || (vos_sockOpenUDP(&sock, &sockOpts) != VOS_NO_ERR))
+    {
+        fprintf(stderr, "Cannot open the session\n");
+        (void) tlc_terminate();
+        return 1;
+    }
+    (void) tlc_resetStatistics(gAppHandle);
+
+    vos_getTime(&start);
+    cpuStart = clock();
+    for (l = 0u; l < loops; l++)
+    {
+        TRDP_TIME_T loopStart;
+
+        vos_getTime(&loopStart);
+        for (i = 0u; i < gNumFrames; i++)
+        {
+            REPLAY_FRAME_T  *pFrame = &gFrames[i];
+            UINT32          size    = pFrame->size;
+
+            if (timed)
+            {
+                /* release time of the frame relative to the start of this loop */
+                UINT64 due = (UINT64) ((double) (pFrame->tsUs - gFrames[0].tsUs) / speed);
+
+                for (;; )
+                {
+                    vos_getTime(&now);
+                    vos_subTime(&now, &loopStart);
+                    if ((UINT64) now.tv_sec * 1000000u + (UINT64) now.tv_usec >= due)
+                    {
+                        break;
+                    }
+                    (void) vos_threadDelay(0u);
+                }
+            }
+            else if (pFrame->windowed)
+            {
+                /* wait for the session to catch up, frames it drops must not stall the replay */
+                TRDP_TIME_T stallStart;
+
+                vos_getTime(&stallStart);
+                while ((windowed - gCallbacks) >= window)
+                {
+                    vos_getTime(&now);
+                    vos_subTime(&now, &stallStart);
+                    if (replayUs(&now) > REPLAY_STALL)
+                    {
+                        stalled     += windowed - gCallbacks;
+                        windowed    = gCallbacks;
+                        break;
+                    }
+                    (void) vos_threadDelay(0u);
+                }
+            }
+
+            seqCount++;
+            replayPatch(pFrame, seqCount);
+            vos_getTime(&gSendTime[seqCount & (REPLAY_RING - 1u)]);
+            if (pFrame->windowed)
+            {
+                windowed++;
+            }
+            if (vos_sockSendUDP(sock, pFrame->pData, &size, gIfaceIP, pFrame->port) != VOS_NO_ERR)
+            {
+                sendErrors++;
+            }
+        }
+    }
+
+    /* let the session take the rest */
+    vos_getTime(&end);
+    do
+    {
+        (void) vos_threadDelay(1000u);
+        vos_getTime(&now);
+        vos_subTime(&now, &end);
+    }
+    while (((windowed - gCallbacks) > 0u) && (replayUs(&now) < REPLAY_STALL * 10u));
+    cpuEnd = clock();
+    vos_getTime(&end);
+
+    gThreadRun = FALSE;
+    while (!gThreadDone)
+    {
+        (void) vos_threadDelay(1000u);
+    }
+    (void) tlc_getStatistics(gAppHandle, &stats);
+
+    vos_subTime(&end, &start);
+    seconds = (double) replayUs(&end) / 1000000.0;
+    cpuUs   = (double) (cpuEnd - cpuStart) * 1000000.0 / (double) CLOCKS_PER_SEC;
+
+    fprintf(fp, "{\"bench\":\"replay\",\"version\":\"%s\",\"capture\":\"%s\",\"frames\":%u,\"skipped\":%u,"
+            "\"pd_comids\":%u,\"md_comids\":%u,\"loops\":%u,\"timed\":%s,\"duration_s\":%.3f,"
+            "\"sent\":%u,\"send_errors\":%u,\"callbacks\":%u,\"unanswered\":%u,\"pd_received\":%u,"
+            "\"md_received\":%u,\"sent_per_s\":%.0f,\"processed_per_s\":%.0f,",
+            tlc_getVersionString(), pCapture, gNumFrames, gSkipped, gNumPdComIds, gNumMdComIds, loops,
+            timed ? "true" : "false", seconds, seqCount, sendErrors, gCallbacks,
+            stalled + (windowed - gCallbacks), stats.pd.numRcv, stats.udpMd.numRcv,
+            (double) seqCount / seconds, (double) gCallbacks / seconds);
+    fprintf(fp, "\"latency_us\":{\"mean\":%.1f,\"p50\":%u,\"p99\":%u,\"max\":%u},\"cpu_us_per_frame\":%.2f}\n",
+            (gLatency.count > 0u) ? (double) gLatency.sum / (double) gLatency.count : 0.0,
+            replayHistPercentile(&gLatency, 50u), replayHistPercentile(&gLatency, 99u), gLatency.max,
+            cpuUs / (double) ((seqCount > 0u) ? seqCount : 1u));
+
+    (void) vos_sockClose(sock);
+    (void) tlc_closeSession(gAppHandle);
+    if (gHistMutex != NULL)
+    {
+        vos_mutexDelete(gHistMutex);
+    }
+    (void) tlc_terminate();
+    free(gFrames);
+    free(pBuf);
+    if (fp != stdout)
+    {
+        fclose(fp);
+    }
+    return 0;
+}
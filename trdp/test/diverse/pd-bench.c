@@ -0,0 +1,596 @@
+/**********************************************************************************************************************/
+/**
+ * @file            pd-bench.c
+ *
+ * @brief           Benchmark for PD throughput and latency
+ *
+ * @details         Two sessions on one host, each run by its own thread: the first publishes n telegrams to the
+ *                  second, which subscribes to them with a callback for every frame. For every combination of
+ *                  publisher count and payload size the benchmark measures
+ *                  - frames sent and received per second
+ *                  - send jitter: deviation of the inter-arrival time of a telegram from its interval
+ *                  - receive to callback latency: reception time of the frame until its callback is called
+ *                  - CPU time per frame (process time of sending and receiving)
+ *                  The results are written as JSON lines, one object per run, to be tracked across releases.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif defined (WIN32)
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+#ifdef VOS_SIM
+#include "vos_sim.h"
+#endif
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION         "1.0"
+
+#define BENCH_COMID         30000u      /* ComId of the first telegram                  */
+#define BENCH_MAX_PUB       1000u       /* max. telegrams per run                       */
+#define BENCH_MAX_RUNS      16u         /* max. entries of the publisher/size lists     */
+#define BENCH_HIST_SIZE     20000u      /* histogram buckets of 1us                     */
+#define BENCH_WARMUP        200000u     /* us before measuring                          */
+#define BENCH_LOOP_MAX      10000       /* max. select time of the session threads, us  */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Session run by a thread */
+typedef struct
+{
+    TRDP_APP_SESSION_T  appHandle;
+    TRDP_IP_ADDR_T      ifaceIP;
+    VOS_THREAD_T        threadId;
+    volatile BOOL8      threadRun;
+    volatile BOOL8      threadDone;
+} BENCH_SESSION_T;
+
+/** Histogram of times in us, the last bucket takes the overflow */
+typedef struct
+{
+    UINT64  count;
+    UINT64  sum;
+    UINT32  max;
+    UINT32  bucket[BENCH_HIST_SIZE];
+} BENCH_HIST_T;
+
+/** Receive state of a telegram */
+typedef struct
+{
+    TRDP_TIME_T lastRx;
+    UINT32      received;
+} BENCH_SUB_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+static BENCH_SESSION_T  gPub;
+static BENCH_SESSION_T  gSub;
+static BENCH_SUB_T      gSubState[BENCH_MAX_PUB];
+static BENCH_HIST_T     gJitter;
+static BENCH_HIST_T     gLatency;
+static volatile BOOL8   gMeasuring  = FALSE;
+static UINT32           gInterval   = 10000u;
+static UINT32           gDuration   = 2000u;
+static TRDP_OPTION_T    gOptions    = TRDP_OPTION_NONE;
+static UINT32           gRcvShards  = 0u;
+static UINT32           gCbWorkers  = 0u;
+static VOS_MUTEX_T      gHistMutex  = NULL;     /* callbacks of worker threads run in parallel */
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void usage (const char *);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool measures PD throughput and latency between two sessions on this host.\n"
+           "Arguments are:\n"
+           "-o <own IP address>     publisher session (default 127.0.0.1)\n"
+           "-i <second IP address>  subscriber session (default 127.0.0.2)\n"
+           "-p <n,n,...>            publisher counts (default 1,10,100,1000)\n"
+           "-s <n,n,...>            payload sizes in bytes (default 64,512,1400)\n"
+           "-c <us>                 interval of the telegrams (default and min. 10000)\n"
+           "-d <ms>                 duration of each run (default 2000)\n"
+           "-f <file>               write the results to file (default stdout)\n"
+           "-t                      take the reception time from kernel time stamps\n"
+           "-b                      busy poll the PD sockets (TRDP_OPTION_BUSY_POLL)\n"
+           "-r <n>                  receive with n PD threads in the subscriber session (pdRcvShards)\n"
+           "-w <n>                  call the subscriber callbacks from n worker threads (cbWorkers)\n"
+#ifdef VOS_SIM
+           "-n <us,us,ppm,bit/s>    link model of the simulated network: latency, jitter, loss, bandwidth\n"
+#endif
+           "-v print version and quit\n"
+           );
+}
+
+/**********************************************************************************************************************/
+/** Time in us  */
+static UINT32 benchUs (
+    const TRDP_TIME_T *pTime)
+{
+    if (pTime->tv_sec < 0)
+    {
+        return 0u;
+    }
+    return (UINT32) pTime->tv_sec * 1000000u + (UINT32) pTime->tv_usec;
+}
+
+/**********************************************************************************************************************/
+/** Add a value to a histogram  */
+static void benchHistAdd (
+    BENCH_HIST_T    *pHist,
+    UINT32          us)
+{
+    pHist->count++;
+    pHist->sum += us;
+    if (us > pHist->max)
+    {
+        pHist->max = us;
+    }
+    pHist->bucket[(us < BENCH_HIST_SIZE) ? us : BENCH_HIST_SIZE - 1u]++;
+}
+
+/**********************************************************************************************************************/
+/** Percentile of a histogram in us  */
+static UINT32 benchHistPercentile (
+    const BENCH_HIST_T  *pHist,
+    UINT32              percent)
+{
+    UINT64  limit   = (pHist->count * percent + 99u) / 100u;
+    UINT64  sum     = 0u;
+    UINT32  i;
+
+    for (i = 0u; i < BENCH_HIST_SIZE; i++)
+    {
+        sum += pHist->bucket[i];
+        if ((sum >= limit) && (sum > 0u))
+        {
+            return i;
+        }
+    }
+    return pHist->max;
+}
+
+/**********************************************************************************************************************/
+/** Write a histogram as JSON object  */
+static void benchHistPrint (
+    FILE                *fp,
+    const CHAR8         *pName,
+    const BENCH_HIST_T  *pHist)
+{
+    fprintf(fp, "\"%s\":{\"mean\":%.1f,\"p50\":%u,\"p99\":%u,\"max\":%u}",
+            pName,
+            (pHist->count > 0u) ? (double) pHist->sum / (double) pHist->count : 0.0,
+            benchHistPercentile(pHist, 50u),
+            benchHistPercentile(pHist, 99u),
+            pHist->max);
+}
+
+/**********************************************************************************************************************/
+/** Callback of the subscriptions, called for every frame
+ */
+static void benchRcvCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    BENCH_SUB_T *pState = (BENCH_SUB_T *) pMsg->pUserRef;
+    TRDP_TIME_T now;
+    TRDP_TIME_T delta;
+    UINT32      us;
+
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pState == NULL))
+    {
+        return;
+    }
+    if (!gMeasuring)
+    {
+        timerclear(&pState->lastRx);
+        return;
+    }
+
+    vos_getTime(&now);
+    delta = now;
+    vos_subTime(&delta, &pMsg->rxTime);
+    if (gHistMutex != NULL)
+    {
+        (void) vos_mutexLock(gHistMutex);
+    }
+    benchHistAdd(&gLatency, benchUs(&delta));
+
+    if (timerisset(&pState->lastRx))
+    {
+        delta = pMsg->rxTime;
+        vos_subTime(&delta, &pState->lastRx);
+        us = benchUs(&delta);
+        benchHistAdd(&gJitter, (us > gInterval) ? us - gInterval : gInterval - us);
+    }
+    if (gHistMutex != NULL)
+    {
+        (void) vos_mutexUnlock(gHistMutex);
+    }
+    pState->lastRx = pMsg->rxTime;
+    pState->received++;
+}
+
+/**********************************************************************************************************************/
+/** Processing loop of a session (thread)
+ */
+static void benchLoop (
+    void *pArg)
+{
+    BENCH_SESSION_T *pSession = (BENCH_SESSION_T *) pArg;
+    TRDP_TIME_T     maxTv = {0, BENCH_LOOP_MAX};
+
+    while (pSession->threadRun)
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc;
+        INT32       rv;
+        TRDP_TIME_T tv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(pSession->appHandle, &tv, &rfds, &noDesc);
+        if (vos_cmpTime(&tv, &maxTv) > 0)
+        {
+            tv = maxTv;
+        }
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(pSession->appHandle, &rfds, &rv);
+    }
+    pSession->threadDone = TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Open a session and start its thread
+ */
+static TRDP_ERR_T benchOpen (
+    BENCH_SESSION_T *pSession,
+    const CHAR8     *pName)
+{
+    TRDP_PROCESS_CONFIG_T   processConfig = {"", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_ERR_T              err;
+
+    processConfig.options = gOptions;
+    if ((pSession == &gSub) && (gRcvShards > 0u))
+    {
+        processConfig.options       |= TRDP_OPTION_PD_THREAD;
+        processConfig.pdRcvShards   = gRcvShards;
+    }
+    if (pSession == &gSub)
+    {
+        processConfig.cbWorkers = gCbWorkers;
+    }
+    err = tlc_openSession(&pSession->appHandle, pSession->ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    pSession->threadRun     = TRUE;
+    pSession->threadDone    = FALSE;
+    if (vos_threadCreate(&pSession->threadId, pName, VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
+                         benchLoop, pSession) != VOS_NO_ERR)
+    {
+        (void) tlc_closeSession(pSession->appHandle);
+        return TRDP_THREAD_ERR;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop the thread of a session and close it
+ */
+static void benchClose (
+    BENCH_SESSION_T *pSession)
+{
+    pSession->threadRun = FALSE;
+    while (!pSession->threadDone)
+    {
+        (void) vos_threadDelay(1000u);
+    }
+    (void) tlc_closeSession(pSession->appHandle);
+    pSession->appHandle = NULL;
+}
+
+/**********************************************************************************************************************/
+/** One benchmark run
+ *
+ *  @param[in]      fp          output
+ *  @param[in]      numPub      number of telegrams
+ *  @param[in]      payload     payload size
+ *
+ *  @retval         0           no error
+ *  @retval         1           some error
+ */
+static int benchRun (
+    FILE    *fp,
+    UINT32  numPub,
+    UINT32  payload)
+{
+    static UINT8        data[TRDP_MAX_PD_DATA_SIZE];
+    TRDP_STATISTICS_T   pubStats;
+    TRDP_STATISTICS_T   subStats;
+    TRDP_TIME_T         start;
+    TRDP_TIME_T         end;
+    clock_t             cpuStart;
+    clock_t             cpuEnd;
+    TRDP_ERR_T          err;
+    double              seconds;
+    double              cpuUs;
+    UINT32              i;
+
+    memset(gSubState, 0, sizeof(gSubState));
+    memset(&gJitter, 0, sizeof(gJitter));
+    memset(&gLatency, 0, sizeof(gLatency));
+    memset(data, 0x55, sizeof(data));
+
+    err = benchOpen(&gSub, "benchSub");
+    if (err == TRDP_NO_ERR)
+    {
+        err = benchOpen(&gPub, "benchPub");
+        if (err != TRDP_NO_ERR)
+        {
+            benchClose(&gSub);
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "tlc_openSession failed (Err: %d)\n", err);
+        return 1;
+    }
+
+    for (i = 0u; (i < numPub) && (err == TRDP_NO_ERR); i++)
+    {
+        TRDP_SUB_T  subHandle;
+        TRDP_PUB_T  pubHandle;
+
+        err = tlp_subscribe(gSub.appHandle, &subHandle, &gSubState[i], benchRcvCallback, BENCH_COMID + i,
+                            0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                            gInterval * 3u, TRDP_TO_DEFAULT);
+        if (err == TRDP_NO_ERR)
+        {
+            err = tlp_publish(gPub.appHandle, &pubHandle, NULL, NULL, BENCH_COMID + i, 0u, 0u,
+                              0u, gSub.ifaceIP, gInterval, 0u, TRDP_FLAGS_NONE, NULL, data, payload);
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "tlp_subscribe/tlp_publish failed (Err: %d)\n", err);
+    }
+    else
+    {
+        (void) vos_threadDelay(BENCH_WARMUP);
+        (void) tlc_resetStatistics(gPub.appHandle);
+        (void) tlc_resetStatistics(gSub.appHandle);
+
+        vos_getTime(&start);
+        cpuStart    = clock();
+        gMeasuring  = TRUE;
+        (void) vos_threadDelay(gDuration * 1000u);
+        gMeasuring  = FALSE;
+        cpuEnd      = clock();
+        vos_getTime(&end);
+
+        (void) tlc_getStatistics(gPub.appHandle, &pubStats);
+        (void) tlc_getStatistics(gSub.appHandle, &subStats);
+
+        vos_subTime(&end, &start);
+        seconds = (double) benchUs(&end) / 1000000.0;
+        cpuUs   = (double) (cpuEnd - cpuStart) * 1000000.0 / (double) CLOCKS_PER_SEC;
+
+        fprintf(fp, "{\"bench\":\"pd\",\"version\":\"%s\",\"publishers\":%u,\"payload\":%u,\"interval_us\":%u,"
+                "\"duration_s\":%.3f,\"sent\":%u,\"received\":%u,\"missed\":%u,\"timeouts\":%u,"
+                "\"sent_per_s\":%.0f,\"received_per_s\":%.0f,",
+                tlc_getVersionString(), numPub, payload, gInterval, seconds,
+                pubStats.pd.numSend, subStats.pd.numRcv, subStats.pd.numMissed, subStats.pd.numTimeout,
+                (double) pubStats.pd.numSend / seconds, (double) subStats.pd.numRcv / seconds);
+        benchHistPrint(fp, "jitter_us", &gJitter);
+        fprintf(fp, ",");
+        benchHistPrint(fp, "latency_us", &gLatency);
+        fprintf(fp, ",\"cpu_us_per_frame\":%.2f}\n",
+                cpuUs / (double) (((pubStats.pd.numSend + subStats.pd.numRcv) > 0u) ?
+                                  (pubStats.pd.numSend + subStats.pd.numRcv) : 1u));
+        fflush(fp);
+    }
+
+    benchClose(&gPub);
+    benchClose(&gSub);
+    return (err == TRDP_NO_ERR) ? 0 : 1;
+}
+
+/**********************************************************************************************************************/
+/** Parse a comma separated list of numbers
+ *
+ *  @retval         number of entries
+ */
+static UINT32 benchParseList (
+    char    *pList,
+    UINT32  *pValues,
+    UINT32  max)
+{
+    UINT32  num = 0u;
+    char    *pToken;
+
+    for (pToken = strtok(pList, ","); (pToken != NULL) && (num < max); pToken = strtok(NULL, ","))
+    {
+        pValues[num++] = (UINT32) strtoul(pToken, NULL, 10);
+    }
+    return num;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    UINT32  pubCounts[BENCH_MAX_RUNS]   = {1u, 10u, 100u, 1000u};
+    UINT32  payloads[BENCH_MAX_RUNS]    = {64u, 512u, 1400u};
+    UINT32  numPubCounts    = 4u;
+    UINT32  numPayloads     = 3u;
+    FILE    *fp             = stdout;
+    int     rv              = 0;
+    int     ch;
+    UINT32  i, j;
+    unsigned int ip[4];
+#ifdef VOS_SIM
+    VOS_SIM_CONFIG_T simConfig = {0u, 0u, 0u, 0u, 1u};
+#endif
+
+    gPub.ifaceIP    = vos_dottedIP("127.0.0.1");
+    gSub.ifaceIP    = vos_dottedIP("127.0.0.2");
+
+    while ((ch = getopt(argc, argv, "o:i:p:s:c:d:f:tbr:w:n:h?v")) != -1)
+    {
+        switch (ch)
+        {
+            case 'o':
+            case 'i':
+                if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+                {
+                    usage(argv[0]);
+                    exit(1);
+                }
+                ((ch == 'o') ? &gPub : &gSub)->ifaceIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+                break;
+            case 'p':
+                numPubCounts = benchParseList(optarg, pubCounts, BENCH_MAX_RUNS);
+                break;
+            case 's':
+                numPayloads = benchParseList(optarg, payloads, BENCH_MAX_RUNS);
+                break;
+            case 'c':
+                gInterval = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                gDuration = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                fp = fopen(optarg, "w");
+                if (fp == NULL)
+                {
+                    fprintf(stderr, "Cannot write %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 't':
+                gOptions |= TRDP_OPTION_RX_TIMESTAMPS;
+                break;
+            case 'b':
+                gOptions |= TRDP_OPTION_BUSY_POLL;
+                break;
+            case 'r':
+                gRcvShards = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                gCbWorkers = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+#ifdef VOS_SIM
+            case 'n':
+                if (sscanf(optarg, "%u,%u,%u,%u", &simConfig.latency, &simConfig.jitter, &simConfig.lossPpm,
+                           &simConfig.bandwidth) < 1)
+                {
+                    usage(argv[0]);
+                    exit(1);
+                }
+                break;
+#endif
+            case 'v':   /*  version */
+                printf("%s: Version %s\t(%s - %s)\n",
+                       argv[0], APP_VERSION, __DATE__, __TIME__);
+                exit(0);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (gInterval < 10000u)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /*    No debug output, it would disturb the measurement    */
+    if (tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Initialization error\n");
+        return 1;
+    }
+#ifdef VOS_SIM
+    (void) vos_simConfig(&simConfig);
+#endif
+    if ((gCbWorkers > 0u) && (vos_mutexCreate(&gHistMutex) != VOS_NO_ERR))
+    {
+        fprintf(stderr, "vos_mutexCreate failed\n");
+        return 1;
+    }
+
+    for (i = 0u; i < numPubCounts; i++)
+    {
+        for (j = 0u; j < numPayloads; j++)
+        {
+            if ((pubCounts[i] == 0u) || (pubCounts[i] > BENCH_MAX_PUB) ||
+                (payloads[j] == 0u) || (payloads[j] > TRDP_MAX_PD_DATA_SIZE))
+            {
+                fprintf(stderr, "Skipping %u publishers with %u bytes\n", pubCounts[i], payloads[j]);
+                continue;
+            }
+            rv |= benchRun(fp, pubCounts[i], payloads[j]);
+        }
+    }
+
+    if (gHistMutex != NULL)
+    {
+        vos_mutexDelete(gHistMutex);
+    }
+    (void) tlc_terminate();
+    if (fp != stdout)
+    {
+        fclose(fp);
+    }
+    return rv;
+}
@@ -0,0 +1,118 @@
+/**********************************************************************************************************************/
+/**
+ * @file            rec2pcapng.c
+ *
+ * @brief           Save the telegrams recorded by a TRDP session as pcapng file
+ *
+ * @details         Reads the recorder ring written by tlc_record() of a session on this host, while it records or
+ *                  after the process terminated, and writes the telegrams as pcapng file for the TRDP dissector.
+ *                  The TRDP session is neither locked nor contacted.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif defined (WIN32)
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "trdp_types.h"
+
+#define APP_VERSION         "0.0.1.0"
+
+#define RESERVED_MEMORY     1000000u
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void usage (const char *);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool saves the telegrams recorded by a TRDP session (tlc_record) as pcapng file.\n"
+           "Arguments are:\n"
+           "-n <name>     name of the recording (default /trdp-rec)\n"
+           "-f <file>     pcapng file to write (default trdp-rec.pcapng)\n"
+           "-v print version and quit\n"
+           );
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_MEM_CONFIG_T   dynamicConfig   = {NULL, RESERVED_MEMORY, {0}};
+    const CHAR8         *pName          = "/trdp-rec";
+    const CHAR8         *pFile          = "trdp-rec.pcapng";
+    UINT32              noRecords       = 0u;
+    TRDP_ERR_T          err;
+    int                 ch;
+
+    while ((ch = getopt(argc, argv, "n:f:h?v")) != -1)
+    {
+        switch (ch)
+        {
+            case 'n':
+                pName = optarg;
+                break;
+            case 'f':
+                pFile = optarg;
+                break;
+            case 'v':   /*  version */
+                printf("%s: Version %s\t(%s - %s)\n",
+                       argv[0], APP_VERSION, __DATE__, __TIME__);
+                exit(0);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    /*    Only the VOS is needed to attach to the shared memory, no session is opened    */
+    if (tlc_init(NULL, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+
+    err = tlc_saveRecording(pName, pFile, &noRecords);
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "tlc_saveRecording(%s, %s) failed (Err: %d)\n", pName, pFile, err);
+    }
+    else
+    {
+        printf("%u telegrams saved to %s\n", (unsigned int) noRecords, pFile);
+    }
+
+    (void) tlc_terminate();
+    return (err == TRDP_NO_ERR) ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+/**********************************************************************************************************************/
+/**
+ * @file            ring-bench.c
+ *
+ * @brief           Benchmark for the ring queue
+ *
+ * @details         Hands messages from producer threads to a consumer, once through vos_queueSend/vos_queueReceive
+ *                  (one vos_memAlloc per message) and once through the SPSC/MPSC ring queues. The order of the
+ *                  messages of each producer is verified.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2013. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vos_utils.h"
+#include "vos_thread.h"
+#include "vos_mem.h"
+
+#define BENCH_MESSAGES      1000000u    /* messages per producer                        */
+#define BENCH_MSG_SIZE      64u         /* about the size of a callback notification    */
+#define BENCH_QUEUE_SIZE    1024u
+#define BENCH_MAX_PRODUCER  4u
+
+typedef struct
+{
+    UINT32  producer;
+    UINT32  seq;
+    UINT8   payload[BENCH_MSG_SIZE - 2u * sizeof(UINT32)];
+} BENCH_MSG_T;
+
+typedef struct
+{
+    UINT32      producer;
+    VOS_QUEUE_T queue;
+    VOS_RING_T  ring;
+} BENCH_ARG_T;
+
+static BENCH_ARG_T gArgs[BENCH_MAX_PRODUCER];
+
+/**********************************************************************************************************************/
+/** Producer for vos_queue: every message is allocated and handed over by pointer
+ */
+static void queueProducer (void *pArg)
+{
+    BENCH_ARG_T *pBench = (BENCH_ARG_T *) pArg;
+    BENCH_MSG_T *pMsg;
+    UINT32      i;
+
+    for (i = 0u; i < BENCH_MESSAGES; i++)
+    {
+        pMsg = (BENCH_MSG_T *) vos_memAlloc(sizeof(BENCH_MSG_T));
+        if (pMsg == NULL)
+        {
+            i--;
+            (void) vos_threadDelay(10u);
+            continue;
+        }
+        pMsg->producer  = pBench->producer;
+        pMsg->seq       = i;
+        while (vos_queueSend(pBench->queue, (UINT8 *) pMsg, sizeof(BENCH_MSG_T)) == VOS_QUEUE_FULL_ERR)
+        {
+            (void) vos_threadDelay(10u);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Producer for the ring queues: messages are copied into the slots
+ */
+static void ringProducer (void *pArg)
+{
+    BENCH_ARG_T *pBench = (BENCH_ARG_T *) pArg;
+    BENCH_MSG_T msg;
+    UINT32      i;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.producer = pBench->producer;
+    for (i = 0u; i < BENCH_MESSAGES; i++)
+    {
+        msg.seq = i;
+        while (vos_ringSend(pBench->ring, (UINT8 *) &msg, sizeof(msg)) == VOS_QUEUE_FULL_ERR)
+        {
+            (void) vos_threadDelay(10u);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Start the producers
+ */
+static void startProducers (UINT32 noOfProducers, VOS_QUEUE_T queue, VOS_RING_T ring, VOS_THREAD_FUNC_T pFunc)
+{
+    VOS_THREAD_T    thread;
+    UINT32          i;
+
+    for (i = 0u; i < noOfProducers; i++)
+    {
+        gArgs[i].producer   = i;
+        gArgs[i].queue      = queue;
+        gArgs[i].ring       = ring;
+        (void) vos_threadCreate(&thread, "producer", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u, pFunc, &gArgs[i]);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check the order of the messages of each producer
+ */
+static int checkMsg (const BENCH_MSG_T *pMsg, UINT32 next[])
+{
+    if ((pMsg->producer >= BENCH_MAX_PRODUCER) || (pMsg->seq != next[pMsg->producer]))
+    {
+        printf("message %u of producer %u out of order\n", pMsg->seq, pMsg->producer);
+        return 1;
+    }
+    next[pMsg->producer]++;
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Measure vos_queue
+ *
+ *  @retval         nanoseconds per message, < 0 on error
+ */
+static double benchQueue (UINT32 noOfProducers)
+{
+    VOS_QUEUE_T     queue;
+    VOS_TIMEVAL_T   start, end;
+    BENCH_MSG_T     *pMsg;
+    UINT32          size;
+    UINT32          next[BENCH_MAX_PRODUCER] = {0u};
+    UINT32          n;
+    int             errors = 0;
+
+    if (vos_queueCreate(VOS_QUEUE_POLICY_FIFO, BENCH_QUEUE_SIZE, &queue) != VOS_NO_ERR)
+    {
+        return -1.0;
+    }
+    vos_getTime(&start);
+    startProducers(noOfProducers, queue, NULL, queueProducer);
+    for (n = 0u; n < noOfProducers * BENCH_MESSAGES; n++)
+    {
+        if (vos_queueReceive(queue, (UINT8 * *) &pMsg, &size, VOS_SEMA_WAIT_FOREVER) != VOS_NO_ERR)
+        {
+            n--;
+            continue;
+        }
+        errors += checkMsg(pMsg, next);
+        vos_memFree(pMsg);
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+    (void) vos_queueDestroy(queue);
+
+    return (errors != 0) ? -1.0 : ((double) end.tv_sec * 1e9 + (double) end.tv_usec * 1e3) / (double) n;
+}
+
+/**********************************************************************************************************************/
+/** Measure the ring queue
+ *
+ *  @retval         nanoseconds per message, < 0 on error
+ */
+static double benchRing (VOS_RING_TYPE_T type, UINT32 noOfProducers)
+{
+    VOS_RING_T      ring;
+    VOS_TIMEVAL_T   start, end;
+    BENCH_MSG_T     msg;
+    UINT32          size;
+    UINT32          next[BENCH_MAX_PRODUCER] = {0u};
+    UINT32          n;
+    int             errors = 0;
+
+    if (vos_ringCreate(type, BENCH_QUEUE_SIZE, sizeof(BENCH_MSG_T), &ring) != VOS_NO_ERR)
+    {
+        return -1.0;
+    }
+    vos_getTime(&start);
+    startProducers(noOfProducers, NULL, ring, ringProducer);
+    for (n = 0u; n < noOfProducers * BENCH_MESSAGES; n++)
+    {
+        size = sizeof(msg);
+        if (vos_ringReceive(ring, (UINT8 *) &msg, &size, VOS_SEMA_WAIT_FOREVER) != VOS_NO_ERR)
+        {
+            printf("vos_ringReceive failed\n");
+            return -1.0;
+        }
+        errors += checkMsg(&msg, next);
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+    (void) vos_ringDestroy(ring);
+
+    return (errors != 0) ? -1.0 : ((double) end.tv_sec * 1e9 + (double) end.tv_usec * 1e3) / (double) n;
+}
+
+int main ()
+{
+    double  t;
+    int     errors = 0;
+
+    if (vos_init(NULL, NULL) != VOS_NO_ERR)
+    {
+        printf("vos_init failed\n");
+        return 1;
+    }
+
+    printf("%-24s %12s\n", "variant", "ns per msg");
+
+    t = benchQueue(1u);
+    errors += (t < 0.0);
+    printf("%-24s %12.1f\n", "vos_queue, 1 producer", t);
+
+    t = benchRing(VOS_RING_SPSC, 1u);
+    errors += (t < 0.0);
+    printf("%-24s %12.1f\n", "ring SPSC, 1 producer", t);
+
+    t = benchQueue(BENCH_MAX_PRODUCER);
+    errors += (t < 0.0);
+    printf("%-24s %12.1f\n", "vos_queue, 4 producers", t);
+
+    t = benchRing(VOS_RING_MPSC, BENCH_MAX_PRODUCER);
+    errors += (t < 0.0);
+    printf("%-24s %12.1f\n", "ring MPSC, 4 producers", t);
+
+    vos_terminate();
+    return (errors == 0) ? 0 : 1;
+}
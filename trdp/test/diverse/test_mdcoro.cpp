@@ -0,0 +1,198 @@
+/**********************************************************************************************************************/
+/**
+ * @file            test_mdcoro.cpp
+ *
+ * @brief           Test of the MD coroutine adapter (trdp_coro.hpp)
+ *
+ * @details         Two sessions on one host, processed by one thread. Many client coroutines send requests
+ *                  concurrently to a server coroutine which echoes them; further checks cover a reply with
+ *                  confirmation and a request to a comId nobody listens to.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "trdp_coro.hpp"
+#include "vos_sock.h"
+#include "vos_utils.h"
+
+#define TEST_CALLER_IP  0x7F000001u     /* 127.0.0.1 */
+#define TEST_REPLIER_IP 0x7F000002u     /* 127.0.0.2 */
+#define TEST_ECHO_COMID     4001u
+#define TEST_QUERY_COMID    4002u
+#define TEST_NOLIS_COMID    4003u
+#define TEST_CLIENTS        200u
+
+static UINT32   gEchoOk     = 0u;
+static UINT32   gEchoFailed = 0u;
+static int      gQueryState = 0;    /* 1: reply received by the caller, 2: and confirmed */
+static int      gNoListener = 0;
+
+/**********************************************************************************************************************/
+/* Coroutines */
+/**********************************************************************************************************************/
+static trdp::Task echoServer (trdp::MdListener &listener)
+{
+    for (;;)
+    {
+        trdp::MdMessage request = co_await listener.receive();
+
+        if (listener.reply(request, 0u, request.data.data(), (UINT32) request.data.size()) != TRDP_NO_ERR)
+        {
+            gEchoFailed++;
+        }
+    }
+}
+
+static trdp::Task echoClient (trdp::MdCaller &caller, UINT32 no)
+{
+    UINT32          value = vos_htonl(no);
+    trdp::MdResult  result = co_await caller.request(TEST_ECHO_COMID, TEST_REPLIER_IP, (const UINT8 *) &value,
+                                                     sizeof(value), 1u, 2000000u);
+
+    if ((result.resultCode == TRDP_NO_ERR) && (result.replies.size() == 1u) &&
+        (result.replies[0].data.size() == sizeof(value)) &&
+        (std::memcmp(result.replies[0].data.data(), &value, sizeof(value)) == 0))
+    {
+        gEchoOk++;
+    }
+    else
+    {
+        printf("### client %u: result %d, %u replies\n", no, result.resultCode, (UINT32) result.replies.size());
+        gEchoFailed++;
+    }
+}
+
+static trdp::Task queryServer (trdp::MdListener &listener)
+{
+    trdp::MdMessage request = co_await listener.receive();
+    TRDP_ERR_T      err     = co_await listener.replyQuery(request, 7u, 1000000u, request.data.data(),
+                                                           (UINT32) request.data.size());
+
+    if ((err == TRDP_NO_ERR) && (gQueryState == 1))
+    {
+        gQueryState = 2;
+    }
+}
+
+static trdp::Task queryClient (trdp::MdCaller &caller)
+{
+    static const UINT8  cData[] = "query";
+    trdp::MdResult      result  = co_await caller.request(TEST_QUERY_COMID, TEST_REPLIER_IP, cData, sizeof(cData),
+                                                          1u, 2000000u);
+
+    if ((result.resultCode == TRDP_NO_ERR) && (result.replies.size() == 1u) &&
+        (result.replies[0].info.msgType == TRDP_MSG_MQ) && (result.replies[0].info.userStatus == 7u))
+    {
+        gQueryState = 1;
+    }
+}
+
+static trdp::Task noListenerClient (trdp::MdCaller &caller)
+{
+    static const UINT8  cData[] = "nobody";
+    trdp::MdResult      result  = co_await caller.request(TEST_NOLIS_COMID, TEST_REPLIER_IP, cData, sizeof(cData),
+                                                          1u, 500000u);
+
+    gNoListener = (result.resultCode != TRDP_NO_ERR) ? 1 : -1;
+}
+
+/**********************************************************************************************************************/
+/* Session loop */
+/**********************************************************************************************************************/
+static void process (TRDP_APP_SESSION_T appHandle1, TRDP_APP_SESSION_T appHandle2, UINT32 ms)
+{
+    for (UINT32 i = 0u; i < ms; i++)
+    {
+        TRDP_APP_SESSION_T  sessions[2] = { appHandle1, appHandle2 };
+
+        for (TRDP_APP_SESSION_T appHandle : sessions)
+        {
+            TRDP_FDS_T  rfds;
+            TRDP_TIME_T tv;
+            TRDP_TIME_T maxTv   = {0, 500};
+            INT32       noDesc  = 0;
+            INT32       rv;
+
+            FD_ZERO(&rfds);
+            (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+            if (vos_cmpTime(&tv, &maxTv) > 0)
+            {
+                tv = maxTv;
+            }
+            rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+            (void) tlc_process(appHandle, &rfds, &rv);
+        }
+    }
+}
+
+int main ()
+{
+    TRDP_PROCESS_CONFIG_T   processConfig = {"", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_APP_SESSION_T      appHandle1 = NULL;
+    TRDP_APP_SESSION_T      appHandle2 = NULL;
+    int                     result = 1;
+
+    if ((tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle1, TEST_CALLER_IP, 0u, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle2, TEST_REPLIER_IP, 0u, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR))
+    {
+        printf("### session setup failed\n");
+        return 1;
+    }
+
+    {
+        trdp::MdCaller      caller(appHandle1);
+        trdp::MdListener    echoListener;
+        trdp::MdListener    queryListener;
+
+        if ((echoListener.add(appHandle2, TEST_ECHO_COMID) != TRDP_NO_ERR) ||
+            (queryListener.add(appHandle2, TEST_QUERY_COMID) != TRDP_NO_ERR))
+        {
+            printf("### tlm_addListener failed\n");
+        }
+        else
+        {
+            echoServer(echoListener);
+            queryServer(queryListener);
+            for (UINT32 i = 0u; i < TEST_CLIENTS; i++)
+            {
+                echoClient(caller, i);
+            }
+            queryClient(caller);
+            noListenerClient(caller);
+
+            for (UINT32 i = 0u; (i < 200u) && (caller.pending() > 0u); i++)
+            {
+                process(appHandle1, appHandle2, 10u);
+            }
+            process(appHandle1, appHandle2, 20u);
+
+            printf("%u of %u concurrent requests answered, reply query %s, request without listener %s\n",
+                   gEchoOk, TEST_CLIENTS, (gQueryState == 2) ? "confirmed" : "failed",
+                   (gNoListener == 1) ? "failed as expected" : "not reported");
+            if ((gEchoOk == TEST_CLIENTS) && (gEchoFailed == 0u) && (gQueryState == 2) && (gNoListener == 1) &&
+                (caller.pending() == 0u))
+            {
+                result = 0;
+            }
+        }
+    }
+
+    (void) tlc_closeSession(appHandle1);
+    (void) tlc_closeSession(appHandle2);
+    (void) tlc_terminate();
+    printf((result == 0) ? "Success\n" : "Failed\n");
+    return result;
+}
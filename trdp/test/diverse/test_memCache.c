@@ -0,0 +1,280 @@
+/**********************************************************************************************************************/
+/**
+ * @file            test_memCache.c
+ *
+ * @brief           Test of the per thread block caches of vos_mem.c
+ *
+ * @details         Several threads allocate, check and free blocks of all sizes of a memory area. Part of the blocks
+ *                  is passed on to other threads and freed there, so the caches are refilled from and drained to the
+ *                  free lists. After the threads terminated, every block must be back in the free lists: the main
+ *                  thread must get all of them without creating new ones. Built with vos_mem.c compiled for
+ *                  VOS_MEM_THREAD_CACHE (see Makefile), POSIX only.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2013. All rights reserved.
+ *
+ * $Id$
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "vos_types.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define NO_OF_THREADS       8u
+#define NO_OF_ROUNDS        2u          /* the threads are started twice, the second round reuses the flushed blocks */
+#define NO_OF_LOOPS         200000u     /* allocations per thread and round */
+#define NO_OF_LIVE          48u         /* blocks held by a thread at a time */
+#define NO_OF_EXCHANGE      64u         /* slots to pass blocks to other threads */
+#define MEM_AREA_SIZE       (16u * 1024u * 1024u)
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+typedef struct
+{
+    UINT32  seed;           /* pattern of the block */
+    UINT32  size;           /* requested size */
+} BLOCK_HEAD_T;
+
+typedef struct
+{
+    UINT32  id;
+    UINT32  random;
+    UINT32  errors;
+} THREAD_ARG_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT8        gMemArea[MEM_AREA_SIZE];
+static UINT8        *gExchange[NO_OF_EXCHANGE];
+static const UINT32 cSizes[] = { 8u, 30u, 64u, 100u, 250u, 480u, 1000u, 1500u, 3000u, 9000u };
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+static UINT32 nextRandom (UINT32 *pState)
+{
+    *pState = *pState * 1103515245u + 12345u;
+    return *pState >> 8;
+}
+
+static UINT8 *blockGet (UINT32 seed, UINT32 size)
+{
+    BLOCK_HEAD_T    *pHead = (BLOCK_HEAD_T *) (void *) vos_memAlloc(size);
+
+    if (pHead != NULL)
+    {
+        pHead->seed = seed;
+        pHead->size = size;
+        memset(pHead + 1, (int) (seed & 0xFFu), size - sizeof(BLOCK_HEAD_T));
+    }
+    return (UINT8 *) pHead;
+}
+
+/* Check the pattern and free the block, returns the number of errors */
+static UINT32 blockPut (UINT8 *pBlock)
+{
+    const BLOCK_HEAD_T  *pHead  = (const BLOCK_HEAD_T *) (void *) pBlock;
+    const UINT8         *pData  = (const UINT8 *) (pHead + 1);
+    UINT32              errors  = 0u;
+    UINT32              i;
+
+    for (i = 0u; i < pHead->size - sizeof(BLOCK_HEAD_T); i++)
+    {
+        if (pData[i] != (UINT8) (pHead->seed & 0xFFu))
+        {
+            errors++;
+            break;
+        }
+    }
+    vos_memFree(pBlock);
+    return errors;
+}
+
+static void *testThread (void *pArg)
+{
+    THREAD_ARG_T    *pThreadArg = (THREAD_ARG_T *) pArg;
+    UINT8           *pLive[NO_OF_LIVE];
+    UINT32          loop;
+    UINT32          i;
+
+    memset(pLive, 0, sizeof(pLive));
+
+    for (loop = 0u; loop < NO_OF_LOOPS; loop++)
+    {
+        UINT32  slot    = nextRandom(&pThreadArg->random) % NO_OF_LIVE;
+        UINT32  size    = cSizes[nextRandom(&pThreadArg->random) % (sizeof(cSizes) / sizeof(cSizes[0]))];
+
+        if (pLive[slot] != NULL)
+        {
+            if ((nextRandom(&pThreadArg->random) & 3u) == 0u)
+            {
+                /* Pass the block on, free the one found in the slot: blocks change the thread */
+                UINT32  exchange    = nextRandom(&pThreadArg->random) % NO_OF_EXCHANGE;
+                UINT8   *pOther     = __atomic_exchange_n(&gExchange[exchange], pLive[slot], __ATOMIC_ACQ_REL);
+
+                if (pOther != NULL)
+                {
+                    pThreadArg->errors += blockPut(pOther);
+                }
+            }
+            else
+            {
+                pThreadArg->errors += blockPut(pLive[slot]);
+            }
+        }
+        pLive[slot] = blockGet((pThreadArg->id << 24) ^ loop, size);
+        if (pLive[slot] == NULL)
+        {
+            printf("thread %u: vos_memAlloc(%u) failed\n", pThreadArg->id, size);
+            pThreadArg->errors++;
+            break;
+        }
+    }
+
+    for (i = 0u; i < NO_OF_LIVE; i++)
+    {
+        if (pLive[i] != NULL)
+        {
+            pThreadArg->errors += blockPut(pLive[i]);
+        }
+    }
+    /* the blocks cached by this thread are returned by the thread exit handler */
+    return NULL;
+}
+
+/* Allocate all blocks of each size from the main thread, none may be missing */
+static UINT32 checkAllBlocksFree (void)
+{
+    UINT32  allocated, freeMem, minFree, numAllocBlocks, numAllocErr, numFreeErr;
+    UINT32  blockSize[VOS_MEM_NBLOCKSIZES];
+    UINT32  usedBlockSize[VOS_MEM_NBLOCKSIZES];
+    UINT32  blockCnt[VOS_MEM_NBLOCKSIZES];
+    UINT32  errors = 0u;
+    UINT32  i;
+    UINT32  j;
+
+    (void) vos_memCount(&allocated, &freeMem, &minFree, &numAllocBlocks, &numAllocErr, &numFreeErr,
+                        blockSize, usedBlockSize);
+    if ((numAllocBlocks != 0u) || (freeMem != allocated) || (numAllocErr != 0u) || (numFreeErr != 0u))
+    {
+        printf("memory not returned: %u blocks allocated, %u of %u bytes free, %u/%u errors\n",
+               numAllocBlocks, freeMem, allocated, numAllocErr, numFreeErr);
+        errors++;
+    }
+    memcpy(blockCnt, usedBlockSize, sizeof(blockCnt));
+
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        UINT8 **ppBlock;
+
+        if (blockCnt[i] == 0u)
+        {
+            continue;
+        }
+        ppBlock = (UINT8 * *) malloc(blockCnt[i] * sizeof(UINT8 *));
+        if (ppBlock == NULL)
+        {
+            return errors + 1u;
+        }
+        for (j = 0u; j < blockCnt[i]; j++)
+        {
+            ppBlock[j] = vos_memAlloc(blockSize[i]);
+        }
+        (void) vos_memCount(&allocated, &freeMem, &minFree, &numAllocBlocks, &numAllocErr, &numFreeErr,
+                            blockSize, usedBlockSize);
+        if (usedBlockSize[i] != blockCnt[i])
+        {
+            printf("block size %u: %u of %u blocks lost in thread caches\n",
+                   blockSize[i], usedBlockSize[i] - blockCnt[i], blockCnt[i]);
+            errors++;
+        }
+        for (j = 0u; j < blockCnt[i]; j++)
+        {
+            if (ppBlock[j] != NULL)
+            {
+                vos_memFree(ppBlock[j]);
+            }
+        }
+        free(ppBlock);
+    }
+    return errors;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+int main (void)
+{
+    pthread_t       thread[NO_OF_THREADS];
+    THREAD_ARG_T    threadArg[NO_OF_THREADS];
+    UINT32          errors = 0u;
+    UINT32          round;
+    UINT32          i;
+
+    if (vos_memInit(gMemArea, sizeof(gMemArea), NULL) != VOS_NO_ERR)
+    {
+        printf("vos_memInit() failed\n");
+        return 1;
+    }
+
+    for (round = 0u; round < NO_OF_ROUNDS; round++)
+    {
+        for (i = 0u; i < NO_OF_THREADS; i++)
+        {
+            threadArg[i].id     = i;
+            threadArg[i].random = (round + 1u) * 7919u + i;
+            threadArg[i].errors = 0u;
+            if (pthread_create(&thread[i], NULL, testThread, &threadArg[i]) != 0)
+            {
+                printf("pthread_create() failed\n");
+                return 1;
+            }
+        }
+        for (i = 0u; i < NO_OF_THREADS; i++)
+        {
+            (void) pthread_join(thread[i], NULL);
+            errors += threadArg[i].errors;
+        }
+        for (i = 0u; i < NO_OF_EXCHANGE; i++)
+        {
+            if (gExchange[i] != NULL)
+            {
+                errors += blockPut(gExchange[i]);
+                gExchange[i] = NULL;
+            }
+        }
+        errors += checkAllBlocksFree();
+        printf("round %u: %u errors\n", round + 1u, errors);
+    }
+
+    vos_memDelete(gMemArea);
+
+    if (errors != 0u)
+    {
+        printf("test_memCache FAILED\n");
+        return 1;
+    }
+    printf("test_memCache passed\n");
+    return 0;
+}
@@ -4,6 +4,11 @@
  *
  * @brief           Test application for TRDP
  *
+ * @details         Sends and receives PD telegrams for some time, then prints the profile of the memory area per block
+ *                  size and per call site of vos_memAlloc() and recommends a VOS_MEM_PREALLOCATE table, block sizes
+ *                  for vos_memInitBlockSizes() and the size of the memory area. Built with vos_mem.c compiled for
+ *                  VOS_MEM_PROFILE (see Makefile).
+ *
  * @note            Project: TCNOpen TRDP prototype stack
  *
  * @author          Bernd Loehr, NewTec GmbH
@@ -26,6 +31,9 @@
 #if defined (POSIX)
 #include <unistd.h>
 #include <sys/select.h>
+#endif
+#if defined (__linux__)
+#include <dlfcn.h>
 #elif defined (WIN32)
 #include "getopt.h"
 #endif
@@ -48,9 +56,11 @@
 /* We use dynamic memory    */
 #define RESERVED_MEMORY     1000000u
 
-#define APP_VERSION         "0.1"
+#define APP_VERSION         "0.2"
 
-#define MAX_NO_OF_PKTS      1u
+#define MAX_NO_OF_PKTS      4u
+#define RUN_TIME            10u             /* default seconds of traffic profiled */
+#define WASTE_PERCENT       25u             /* hint for a smaller block size if it saves more */
 
 typedef struct pd_demo_pkt
 {
@@ -81,6 +91,8 @@ PD_PKT_T    gSubPackets[] =
 
 UINT32      gOwnIP  = 0;
 UINT32      gDestIP = 0xEF000000;
+UINT32      gNoOfPkts = 1u;
+BOOL8       gVerbose = FALSE;
 
 const UINT8 cDemoData[] = " "
     "Far out in the uncharted backwaters of the unfashionable end of the western spiral arm of the Galaxy lies a small unregarded yellow sun. Orbiting this at a distance of roughly ninety-two million miles is an utterly insignificant little blue green planet whose ape-descended life forms are so amazingly primitive that they still think digital watches are a pretty neat idea.\n"
@@ -107,6 +119,8 @@ void dbgOut (void *, TRDP_LOG_T , const CHAR8 *, const CHAR8 *, UINT16 , const C
 void usage (const char *);
 void myPDcallBack (void *, TRDP_APP_SESSION_T,const TRDP_PD_INFO_T *, UINT8 *, UINT32 );
 void initPacketList (UINT32  pubBaseComId, UINT32  subBaseComId);
+void printSite (const void *pSite);
+void printProfile (const VOS_MEM_PROFILE_T *pProfile, UINT32 areaSize, UINT32 peakUse);
 
 
 void initPacketList (
@@ -114,7 +128,7 @@ void initPacketList (
     UINT32  subBaseComId)
 {
     unsigned int i;
-    for (i = 0u; i < MAX_NO_OF_PKTS; i++)
+    for (i = 0u; i < gNoOfPkts; i++)
     {
         memcpy(gPubPackets[i].data, cDemoData, gPubPackets[i].dataSize);
         memset(gSubPackets[i].data, 0, TRDP_MAX_PD_DATA_SIZE);
@@ -172,7 +186,10 @@ void myPDcallBack (
     switch (pMsg->resultCode)
     {
         case TRDP_NO_ERR:
-            printf("> ComID %d received\n", pMsg->comId);
+            if (gVerbose)
+            {
+                printf("> ComID %d received\n", pMsg->comId);
+            }
             break;
 
         case TRDP_TIMEOUT_ERR:
@@ -195,12 +212,123 @@ void myPDcallBack (
 void usage (const char *appName)
 {
     printf("Usage of %s\n", appName);
-    printf("This tool sends PD messages to an ED and displays received PD packages.\n"
+    printf("This tool sends and receives PD messages and recommends a memory configuration.\n"
            "Arguments are:\n"
            "-o own IP address\n"
            "-t target IP address\n"
-           "-v print version and quit\n"
-           );
+           "-n number of telegrams published and subscribed (1..4, default 1)\n"
+           "-d seconds of traffic profiled (default %u)\n"
+           "-r print received telegrams\n"
+           "-v print version and quit\n",
+           RUN_TIME);
+}
+
+/**********************************************************************************************************************/
+/** Print a call site of vos_memAlloc(), by symbol if the tool is linked with -rdynamic
+ *
+ *  @param[in]      pSite           return address of the call
+ */
+void printSite (const void *pSite)
+{
+#if defined (__linux__)
+    Dl_info info;
+
+    if ((pSite != NULL) && (dladdr(pSite, &info) != 0) && (info.dli_sname != NULL))
+    {
+        printf("%s+0x%lx", info.dli_sname, (unsigned long) ((const char *) pSite - (const char *) info.dli_saddr));
+        return;
+    }
+#endif
+    printf("%p", pSite);
+}
+
+/**********************************************************************************************************************/
+/** Print the profile and the recommended configuration
+ *
+ *  @param[in]      pProfile        profile of the memory area
+ *  @param[in]      areaSize        size of the memory area
+ *  @param[in]      peakUse         max. bytes used of the memory area
+ */
+void printProfile (const VOS_MEM_PROFILE_T *pProfile, UINT32 areaSize, UINT32 peakUse)
+{
+    double  seconds = (double) pProfile->duration.tv_sec + (double) pProfile->duration.tv_usec / 1e6;
+    UINT32  i;
+
+    if (seconds <= 0.0)
+    {
+        seconds = 1.0;
+    }
+    printf("\nProfile of %.1f s\n", seconds);
+    printf("%8s %6s %6s %10s %9s %7s %7s %6s\n",
+           "block", "used", "peak", "allocs", "allocs/s", "min", "max", "waste");
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        const VOS_MEM_CLASS_PROFILE_T *pClass = &pProfile->sizeClass[i];
+        UINT64 blockBytes = pClass->requested + pClass->wasted;
+
+        if (pClass->highWater == 0u)
+        {
+            continue;
+        }
+        printf("%8u %6u %6u %10u %9.1f %7u %7u %5.1f%%\n",
+               pClass->blockSize, pClass->used, pClass->highWater, pClass->allocCnt,
+               (double) pClass->allocCnt / seconds, pClass->minSize, pClass->maxSize,
+               (blockBytes != 0u) ? 100.0 * (double) pClass->wasted / (double) blockBytes : 0.0);
+    }
+
+    printf("\n%6s %6s %10s %9s  %s\n", "used", "peak", "allocs", "allocs/s", "call site");
+    for (i = 0u; i < pProfile->numSites; i++)
+    {
+        const VOS_MEM_SITE_PROFILE_T *pSite = &pProfile->site[i];
+
+        printf("%6u %6u %10u %9.1f  ", pSite->used, pSite->highWater, pSite->allocCnt,
+               (double) pSite->allocCnt / seconds);
+        printSite(pSite->pSite);
+        printf("\n");
+    }
+    if (pProfile->lostCnt != 0u)
+    {
+        printf("%u allocations of further call sites (VOS_MEM_PROFILE_SITES)\n", pProfile->lostCnt);
+    }
+
+    /* Pre-allocate the peak use of each block size, vos_memInit() takes VOS_MEM_MAX_PREALLOCATE at most */
+    printf("\nRecommended configuration:\n#define VOS_MEM_PREALLOCATE  {");
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        UINT32 preAlloc = pProfile->sizeClass[i].highWater;
+
+        printf("%uu%s", (preAlloc > VOS_MEM_MAX_PREALLOCATE) ? VOS_MEM_MAX_PREALLOCATE : preAlloc,
+               (i < VOS_MEM_NBLOCKSIZES - 1u) ? ", " : "}\n");
+    }
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        const VOS_MEM_CLASS_PROFILE_T *pClass = &pProfile->sizeClass[i];
+        UINT32 fitSize = (pClass->maxSize + 7u) & ~7u;
+
+        if (pClass->highWater > VOS_MEM_MAX_PREALLOCATE)
+        {
+            printf("/* %u blocks of %u bytes in use at peak, more than VOS_MEM_MAX_PREALLOCATE */\n",
+                   pClass->highWater, pClass->blockSize);
+        }
+        if ((fitSize != 0u) && (fitSize * 100u <= pClass->blockSize * (100u - WASTE_PERCENT)))
+        {
+            printf("/* requests of %u..%u bytes in %u byte blocks: consider a block size of %u */\n",
+                   pClass->minSize, pClass->maxSize, pClass->blockSize, fitSize);
+        }
+    }
+
+    /* The same block sizes with the hints applied, for TRDP_MEM_CONFIG_T.blockSize / vos_memInitBlockSizes() */
+    printf("/* block sizes {");
+    for (i = 0u; i < VOS_MEM_NBLOCKSIZES; i++)
+    {
+        const VOS_MEM_CLASS_PROFILE_T *pClass = &pProfile->sizeClass[i];
+        UINT32 fitSize = (pClass->maxSize + 7u) & ~7u;
+
+        printf("%uu%s", ((fitSize != 0u) && (fitSize * 100u <= pClass->blockSize * (100u - WASTE_PERCENT))) ?
+               fitSize : pClass->blockSize, (i < VOS_MEM_NBLOCKSIZES - 1u) ? ", " : "} */\n");
+    }
+    printf("/* memory area: %u bytes used at peak of %u, reserve %u */\n", peakUse, areaSize,
+           peakUse + peakUse / 4u);
 }
 
 /**********************************************************************************************************************/
@@ -217,6 +345,12 @@ int main (int argc, char * *argv)
                                                10000000u, TRDP_TO_SET_TO_ZERO, 0u};
     TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, RESERVED_MEMORY, {}};
     TRDP_PROCESS_CONFIG_T   processConfig   = {"Me", "", 0u, 0u, TRDP_OPTION_BLOCK};
+    VOS_MEM_PROFILE_T       profile;
+    VOS_TIMEVAL_T           endTime;
+    VOS_TIMEVAL_T           now;
+    UINT32                  runTime = RUN_TIME;
+    UINT32                  allocated, freeMem, minFree, numAllocBlocks, numAllocErr, numFreeErr;
+    UINT32                  blockSize[VOS_MEM_NBLOCKSIZES], usedBlockSize[VOS_MEM_NBLOCKSIZES];
     int rv = 0;
     int ch;
     unsigned int ip[4], i;
@@ -224,7 +358,7 @@ int main (int argc, char * *argv)
 
     /****** Parsing the command line arguments */
 
-    while ((ch = getopt(argc, argv, "t:o:h?v")) != -1)
+    while ((ch = getopt(argc, argv, "t:o:n:d:rh?v")) != -1)
     {
         switch (ch)
         {
@@ -250,6 +384,27 @@ int main (int argc, char * *argv)
                 gDestIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
                 break;
             }
+            case 'n':
+            {
+                if ((sscanf(optarg, "%u", &gNoOfPkts) < 1) || (gNoOfPkts == 0u) || (gNoOfPkts > MAX_NO_OF_PKTS))
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            }
+            case 'd':
+            {
+                if (sscanf(optarg, "%u", &runTime) < 1)
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            }
+            case 'r':
+                gVerbose = TRUE;
+                break;
             case 'v':   /*  version */
                 printf("%s: Version %s\t(%s - %s)\n",
                        argv[0], APP_VERSION, __DATE__, __TIME__);
@@ -296,7 +451,7 @@ int main (int argc, char * *argv)
 
     initPacketList(0, 0);
 
-    for (i = 0u; i < MAX_NO_OF_PKTS; i++)
+    for (i = 0u; i < gNoOfPkts; i++)
     {
         printf("Subscribing dataSize: %u Bytes\n", gSubPackets[i].dataSize);
         err = tlp_subscribe(appHandle,                  /*    our application identifier           */
@@ -350,7 +505,9 @@ int main (int argc, char * *argv)
     /*
      Enter the main processing loop.
      */
-    while (1)
+    vos_getTime(&endTime);
+    endTime.tv_sec += runTime;
+    do
     {
         VOS_FDS_T       rfds;
         INT32           noOfDesc;
@@ -431,12 +588,27 @@ int main (int argc, char * *argv)
          memset(gInputBuffer, 0, sizeof(gInputBuffer));
          }
          */
+        vos_getTime(&now);
     }   /*    Bottom of while-loop    */
+    while (vos_cmpTime(&now, &endTime) < 0);
+
+    if (vos_memProfile(&profile) != VOS_NO_ERR)
+    {
+        printf("No profile, vos_mem.c must be compiled with VOS_MEM_PROFILE\n");
+        rv = 1;
+    }
+    else
+    {
+        (void) vos_memCount(&allocated, &freeMem, &minFree, &numAllocBlocks, &numAllocErr, &numFreeErr,
+                            blockSize, usedBlockSize);
+        printProfile(&profile, allocated, allocated - minFree);
+        rv = 0;
+    }
 
     /*
      *    We always clean up behind us!
      */
-    for (i = 0u; i < MAX_NO_OF_PKTS; i++)
+    for (i = 0u; i < gNoOfPkts; i++)
     {
         tlp_unpublish(appHandle, gPubPackets[i].pubHandle);
         tlp_unsubscribe(appHandle, gSubPackets[i].subHandle);
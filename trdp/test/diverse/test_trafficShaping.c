@@ -275,7 +275,18 @@ int main (int argc, char *argv[])
             return 1;
         }
     }
-    
+
+    /*    Show the resulting send slot usage    */
+    {
+        TRDP_SHAPING_STATISTICS_T shaping;
+
+        if (tlc_getShapingStatistics(appHandle, &shaping) == TRDP_NO_ERR)
+        {
+            printf("%u publishers in %u slots of %u us\n", shaping.numPub, shaping.slotCnt, shaping.slotTime);
+            printf("load per slot: average %u bytes, peak %u bytes (%u kbit/s)\n",
+                   shaping.avgLoad, shaping.peakLoad, shaping.peakBandwidth);
+        }
+    }
     
     /*
      Enter the main processing loop.
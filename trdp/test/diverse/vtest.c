@@ -22,6 +22,10 @@
 
 #include "vtest.h"
 
+#ifdef POSIX
+#include <pthread.h>
+#endif
+
 MEM_ERR_T L3_test_mem_init()
 {
     TRDP_MEM_CONFIG_T   dynamicConfig = {NULL, RESERVED_MEMORY, {0}};
@@ -58,6 +62,13 @@ MEM_ERR_T L3_test_mem_alloc()
         retVal = MEM_ALLOC_ERR;
     }
     vos_memFree(ptr); /* undo mem_alloc */
+    ptr = (UINT32*)vos_memAllocAligned(100, VOS_CACHE_LINE_SIZE);
+    if ((ptr == NULL) || (((uintptr_t) ptr & (VOS_CACHE_LINE_SIZE - 1u)) != 0u))
+    {
+        printOut(OUTPUT_ADVANCED,"[MEM_ALLOC] vos_memAllocAligned() error\n");
+        retVal = MEM_ALLOC_ERR;
+    }
+    vos_memFree(ptr); /* undo mem_alloc */
     printOut(OUTPUT_ADVANCED,"[MEM_ALLOC] finished\n");
     return retVal;
 }
@@ -280,6 +291,60 @@ MEM_ERR_T L3_test_mem_count()
     return retVal;
 }
 
+MEM_ERR_T L3_test_mem_sizes()
+{
+    MEM_ERR_T retVal = MEM_NO_ERR;
+    UINT8 *ptr1 = 0, *ptr2 = 0, *ptr3 = 0;
+    UINT32  allocatedMemory = 0;
+    UINT32  freeMemory = 0;
+    UINT32  minFree = 0;
+    UINT32  numAllocBlocks = 0;
+    UINT32  numAllocErr = 0;
+    UINT32  numFreeErr = 0;
+    UINT32  blockSize[VOS_MEM_NBLOCKSIZES];
+    UINT32  usedBlockSize[VOS_MEM_NBLOCKSIZES];
+    const UINT32 sizes[VOS_MEM_NBLOCKSIZES] = {64, 1486, 4096};     /* 1486 is rounded up to 1488 */
+    const UINT32 badSizes[VOS_MEM_NBLOCKSIZES] = {64, 0, 4096};
+
+    printOut(OUTPUT_ADVANCED,"[MEM_SIZES] start...\n");
+    vos_memDelete(NULL);
+    if (vos_memInitBlockSizes(NULL, RESERVED_MEMORY, NULL, badSizes) != VOS_PARAM_ERR)
+    {
+        printOut(OUTPUT_ADVANCED,"[MEM_SIZES] Test 1 Error\n");
+        retVal = MEM_SIZES_ERR;
+    }
+    if (vos_memInitBlockSizes(NULL, RESERVED_MEMORY, NULL, sizes) != VOS_NO_ERR)
+    {
+        printOut(OUTPUT_ADVANCED,"[MEM_SIZES] vos_memInitBlockSizes() error\n");
+        return MEM_SIZES_ERR;
+    }
+    ptr1 = vos_memAlloc(1432 + 40);
+    ptr2 = vos_memAlloc(65);
+    ptr3 = vos_memAlloc(4097);
+    vos_memCount(&allocatedMemory,&freeMemory,&minFree,&numAllocBlocks,&numAllocErr,&numFreeErr,blockSize,usedBlockSize);
+    if (ptr1 == NULL || ptr2 == NULL || ptr3 != NULL
+            || blockSize[1] != 1488 || blockSize[3] != 0
+            || usedBlockSize[0] != 0 || usedBlockSize[1] != 2 || usedBlockSize[2] != 0
+            || numAllocBlocks != 2
+            || numAllocErr != 1)
+    {
+        printOut(OUTPUT_ADVANCED,"[MEM_SIZES] Test 2 Error\n");
+        retVal = MEM_SIZES_ERR;
+    }
+    vos_memFree(ptr1);
+    vos_memFree(ptr2);
+    vos_memCount(&allocatedMemory,&freeMemory,&minFree,&numAllocBlocks,&numAllocErr,&numFreeErr,blockSize,usedBlockSize);
+    if (freeMemory != RESERVED_MEMORY
+            || numAllocBlocks != 0
+            || numFreeErr != 0)
+    {
+        printOut(OUTPUT_ADVANCED,"[MEM_SIZES] Test 3 Error\n");
+        retVal = MEM_SIZES_ERR;
+    }
+    printOut(OUTPUT_ADVANCED,"[MEM_SIZES] finished\n");
+    return retVal;
+}
+
 MEM_ERR_T L3_test_mem_delete()
 {
     /* tested with debugger, it seems to be ok */
@@ -843,12 +908,27 @@ THREAD_ERR_T L3_test_thread_init()
 THREAD_ERR_T L3_test_thread_getTime()
 {
     VOS_TIMEVAL_T sysTime;
+    VOS_TIMEVAL_T laterTime;
+    THREAD_ERR_T retVal = THREAD_NO_ERR;
 
     printOut(OUTPUT_ADVANCED,"[THREAD_GETTIME] start...\n");
     vos_getTime(&sysTime);
     printOut(OUTPUT_FULL,"[THREAD_GETTIME] time is: %lu:%lu\n",(long unsigned int)sysTime.tv_sec, (long unsigned int)sysTime.tv_usec);
+
+    /* a device which is no PTP clock is refused, the local clock stays */
+    if ((vos_setTimeBase("/dev/null") != VOS_INIT_ERR) || (vos_setTimeBase(NULL) != VOS_NO_ERR))
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_GETTIME] vos_setTimeBase() Error\n");
+        retVal = THREAD_GETTIME_ERR;
+    }
+    vos_getTime(&laterTime);
+    if (vos_cmpTime(&laterTime, &sysTime) < 0)
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_GETTIME] time went back\n");
+        retVal = THREAD_GETTIME_ERR;
+    }
     printOut(OUTPUT_ADVANCED,"[THREAD_GETTIME] finished \n");
-    return THREAD_NO_ERR;
+    return retVal;
 }
 
 THREAD_ERR_T L3_test_thread_getTimeStamp()
@@ -1250,6 +1330,332 @@ THREAD_ERR_T L3_test_thread_mutex()
     return retVal;
 }
 
+#define MUTEX_BENCH_LOOPS    1000000u
+#define MUTEX_BENCH_THREADS  4u
+#define MUTEX_BENCH_SHARED   200000u
+
+typedef struct
+{
+    VOS_MUTEX_T     mutex;
+    VOS_RWLOCK_T    rwlock;
+#ifdef POSIX
+    pthread_mutex_t *pPthreadMutex;
+#endif
+    UINT32          counter;
+    UINT32          pair[2];
+    UINT32          errors;
+    UINT32          done;
+} TEST_ARGS_MUTEX_BENCH;
+
+/* ns per loop since start */
+static UINT32 L3_bench_ns(const VOS_TIMEVAL_T *pStart, UINT32 loops)
+{
+    VOS_TIMEVAL_T now;
+
+    vos_getTime(&now);
+    vos_subTime(&now, pStart);
+    return (UINT32) ((((UINT64) now.tv_sec * 1000000u) + (UINT64) now.tv_usec) * 1000u / loops);
+}
+
+static void L3_bench_wait(TEST_ARGS_MUTEX_BENCH *pArgs, UINT32 threads)
+{
+    while (__atomic_load_n(&pArgs->done, __ATOMIC_ACQUIRE) < threads)
+    {
+        (void) vos_threadDelay(1000u);
+    }
+    pArgs->done = 0u;
+}
+
+VOS_THREAD_FUNC_T L3_test_thread_mutex_contend(void* arguments)
+{
+    TEST_ARGS_MUTEX_BENCH *pArgs = (TEST_ARGS_MUTEX_BENCH*) arguments;
+    UINT32 i;
+
+    for (i = 0u; i < MUTEX_BENCH_SHARED; i++)
+    {
+        (void) vos_mutexLock(pArgs->mutex);
+        pArgs->counter++;
+        (void) vos_mutexUnlock(pArgs->mutex);
+    }
+    (void) __atomic_add_fetch(&pArgs->done, 1u, __ATOMIC_RELEASE);
+    return arguments;
+}
+
+#ifdef POSIX
+VOS_THREAD_FUNC_T L3_test_thread_pthread_contend(void* arguments)
+{
+    TEST_ARGS_MUTEX_BENCH *pArgs = (TEST_ARGS_MUTEX_BENCH*) arguments;
+    UINT32 i;
+
+    for (i = 0u; i < MUTEX_BENCH_SHARED; i++)
+    {
+        (void) pthread_mutex_lock(pArgs->pPthreadMutex);
+        pArgs->counter++;
+        (void) pthread_mutex_unlock(pArgs->pPthreadMutex);
+    }
+    (void) __atomic_add_fetch(&pArgs->done, 1u, __ATOMIC_RELEASE);
+    return arguments;
+}
+#endif
+
+/* the first thread writes, the others read and check that the pair is consistent */
+VOS_THREAD_FUNC_T L3_test_thread_rwlock_contend(void* arguments)
+{
+    TEST_ARGS_MUTEX_BENCH *pArgs = (TEST_ARGS_MUTEX_BENCH*) arguments;
+    BOOL8 writer = (__atomic_fetch_add(&pArgs->counter, 1u, __ATOMIC_RELAXED) == 0u);
+    UINT32 i;
+
+    for (i = 0u; i < MUTEX_BENCH_SHARED; i++)
+    {
+        if (writer)
+        {
+            (void) vos_rwlockWrite(pArgs->rwlock);
+            pArgs->pair[0]++;
+            pArgs->pair[1]++;
+        }
+        else
+        {
+            (void) vos_rwlockRead(pArgs->rwlock);
+            if (pArgs->pair[0] != pArgs->pair[1])
+            {
+                (void) __atomic_add_fetch(&pArgs->errors, 1u, __ATOMIC_RELAXED);
+            }
+        }
+        (void) vos_rwlockUnlock(pArgs->rwlock);
+    }
+    (void) __atomic_add_fetch(&pArgs->done, 1u, __ATOMIC_RELEASE);
+    return arguments;
+}
+
+THREAD_ERR_T L3_test_thread_mutex_bench()
+{
+    /* uncontended and contended cost of vos_mutex, compared to a recursive pthread mutex, and of vos_rwlock */
+    THREAD_ERR_T retVal = THREAD_NO_ERR;
+    TEST_ARGS_MUTEX_BENCH args;
+    VOS_THREAD_T thread;
+    VOS_TIMEVAL_T start;
+    UINT32 i;
+#ifdef POSIX
+    pthread_mutex_t pthreadMutex;
+    pthread_mutexattr_t attr;
+#endif
+
+    printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] start...\n");
+    memset(&args, 0, sizeof(args));
+    if ((vos_threadInit() != VOS_NO_ERR) ||
+        (vos_mutexCreate(&args.mutex) != VOS_NO_ERR) || (vos_rwlockCreate(&args.rwlock) != VOS_NO_ERR))
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] create Error\n");
+        return THREAD_MUTEX_BENCH_ERR;
+    }
+
+    vos_getTime(&start);
+    for (i = 0u; i < MUTEX_BENCH_LOOPS; i++)
+    {
+        (void) vos_mutexLock(args.mutex);
+        (void) vos_mutexUnlock(args.mutex);
+    }
+    printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] vos_mutex uncontended:   %u ns\n", L3_bench_ns(&start, MUTEX_BENCH_LOOPS));
+
+    vos_getTime(&start);
+    for (i = 0u; i < MUTEX_BENCH_LOOPS; i++)
+    {
+        (void) vos_rwlockRead(args.rwlock);
+        (void) vos_rwlockUnlock(args.rwlock);
+    }
+    printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] vos_rwlock read:         %u ns\n", L3_bench_ns(&start, MUTEX_BENCH_LOOPS));
+
+    vos_getTime(&start);
+    for (i = 0u; i < MUTEX_BENCH_THREADS; i++)
+    {
+        if (vos_threadCreate(&thread, "mutexBench", THREAD_POLICY, 0, 0, 0,
+                             (void*)L3_test_thread_mutex_contend, (void*)&args) != VOS_NO_ERR)
+        {
+            printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] threadCreate Error\n");
+            retVal = THREAD_MUTEX_BENCH_ERR;
+            break;
+        }
+    }
+    L3_bench_wait(&args, i);
+    printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] vos_mutex %u threads:     %u ns\n", MUTEX_BENCH_THREADS,
+             L3_bench_ns(&start, MUTEX_BENCH_THREADS * MUTEX_BENCH_SHARED));
+    if (args.counter != MUTEX_BENCH_THREADS * MUTEX_BENCH_SHARED)
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] vos_mutex lost %u updates\n",
+                 MUTEX_BENCH_THREADS * MUTEX_BENCH_SHARED - args.counter);
+        retVal = THREAD_MUTEX_BENCH_ERR;
+    }
+
+    args.counter = 0u;
+    vos_getTime(&start);
+    for (i = 0u; i < MUTEX_BENCH_THREADS; i++)
+    {
+        if (vos_threadCreate(&thread, "rwlockBench", THREAD_POLICY, 0, 0, 0,
+                             (void*)L3_test_thread_rwlock_contend, (void*)&args) != VOS_NO_ERR)
+        {
+            printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] threadCreate Error\n");
+            retVal = THREAD_MUTEX_BENCH_ERR;
+            break;
+        }
+    }
+    L3_bench_wait(&args, i);
+    printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] vos_rwlock %u threads:    %u ns\n", MUTEX_BENCH_THREADS,
+             L3_bench_ns(&start, MUTEX_BENCH_THREADS * MUTEX_BENCH_SHARED));
+    if ((args.errors != 0u) || (args.pair[0] != MUTEX_BENCH_SHARED))
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] vos_rwlock %u inconsistent reads\n", args.errors);
+        retVal = THREAD_MUTEX_BENCH_ERR;
+    }
+
+#ifdef POSIX
+    (void) pthread_mutexattr_init(&attr);
+    (void) pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void) pthread_mutex_init(&pthreadMutex, &attr);
+    (void) pthread_mutexattr_destroy(&attr);
+    args.pPthreadMutex = &pthreadMutex;
+
+    vos_getTime(&start);
+    for (i = 0u; i < MUTEX_BENCH_LOOPS; i++)
+    {
+        (void) pthread_mutex_lock(&pthreadMutex);
+        (void) pthread_mutex_unlock(&pthreadMutex);
+    }
+    printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] pthread uncontended:     %u ns\n", L3_bench_ns(&start, MUTEX_BENCH_LOOPS));
+
+    args.counter = 0u;
+    vos_getTime(&start);
+    for (i = 0u; i < MUTEX_BENCH_THREADS; i++)
+    {
+        if (vos_threadCreate(&thread, "pthreadBench", THREAD_POLICY, 0, 0, 0,
+                             (void*)L3_test_thread_pthread_contend, (void*)&args) != VOS_NO_ERR)
+        {
+            printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] threadCreate Error\n");
+            retVal = THREAD_MUTEX_BENCH_ERR;
+            break;
+        }
+    }
+    L3_bench_wait(&args, i);
+    printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] pthread %u threads:       %u ns\n", MUTEX_BENCH_THREADS,
+             L3_bench_ns(&start, MUTEX_BENCH_THREADS * MUTEX_BENCH_SHARED));
+    (void) pthread_mutex_destroy(&pthreadMutex);
+#endif
+
+    vos_rwlockDelete(args.rwlock);
+    vos_mutexDelete(args.mutex);
+    vos_threadTerm();
+    printOut(OUTPUT_ADVANCED,"[THREAD_MUTEX_BENCH] finished\n");
+    return retVal;
+}
+
+#define JITTER_DELAY        1000u           /* us, below the Windows scheduler tick */
+#define JITTER_DELAYS       200u
+#define JITTER_INTERVAL     10000u          /* us, PD cycle */
+#define JITTER_CYCLES       200u
+
+typedef struct
+{
+    VOS_TIMEVAL_T   release[JITTER_CYCLES];
+    UINT32          cycles;
+} TEST_ARGS_JITTER;
+
+/* us from pFrom to pTo */
+static INT32 L3_jitter_us(const VOS_TIMEVAL_T *pFrom, const VOS_TIMEVAL_T *pTo)
+{
+    VOS_TIMEVAL_T diff = *pTo;
+
+    vos_subTime(&diff, pFrom);
+    return (INT32) (diff.tv_sec * 1000000 + diff.tv_usec);
+}
+
+static void L3_jitter_cycle(void *arguments)
+{
+    TEST_ARGS_JITTER *pArgs = (TEST_ARGS_JITTER*) arguments;
+    UINT32 cycle = __atomic_load_n(&pArgs->cycles, __ATOMIC_RELAXED);
+
+    if (cycle < JITTER_CYCLES)
+    {
+        vos_getTime(&pArgs->release[cycle]);
+        __atomic_store_n(&pArgs->cycles, cycle + 1u, __ATOMIC_RELEASE);
+    }
+}
+
+THREAD_ERR_T L3_test_thread_jitter()
+{
+    /* achieved delay and cycle times of vos_threadDelay() and cyclic threads */
+    THREAD_ERR_T retVal = THREAD_NO_ERR;
+    static TEST_ARGS_JITTER args;
+    VOS_THREAD_T thread;
+    VOS_TIMEVAL_T start, end;
+    INT32 us, minUs = 0x7FFFFFFF, maxUs = 0, sumUs = 0, maxDev = 0;
+    UINT32 i;
+
+    printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] start...\n");
+    if (vos_threadInit() != VOS_NO_ERR)
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] vos_threadInit() Error\n");
+        return THREAD_JITTER_ERR;
+    }
+
+    for (i = 0u; i < JITTER_DELAYS; i++)
+    {
+        vos_getTime(&start);
+        if (vos_threadDelay(JITTER_DELAY) != VOS_NO_ERR)
+        {
+            printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] vos_threadDelay() Error\n");
+            retVal = THREAD_JITTER_ERR;
+            break;
+        }
+        vos_getTime(&end);
+        us = L3_jitter_us(&start, &end);
+        minUs = (us < minUs) ? us : minUs;
+        maxUs = (us > maxUs) ? us : maxUs;
+        sumUs += us;
+    }
+    printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] vos_threadDelay(%u): min %d, mean %d, max %d us\n",
+             JITTER_DELAY, minUs, sumUs / (INT32) JITTER_DELAYS, maxUs);
+    if ((i == JITTER_DELAYS) && (minUs < (INT32) JITTER_DELAY))
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] vos_threadDelay() returned early\n");
+        retVal = THREAD_JITTER_ERR;
+    }
+
+    memset(&args, 0, sizeof(args));
+    if (vos_threadCreate(&thread, "jitter", THREAD_POLICY, 0, JITTER_INTERVAL, 0,
+                         (VOS_THREAD_FUNC_T)L3_jitter_cycle, (void*)&args) != VOS_NO_ERR)
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] cyclic threadCreate Error\n");
+        vos_threadTerm();
+        return THREAD_JITTER_ERR;
+    }
+    for (i = 0u; (i < 2u * JITTER_CYCLES) && (__atomic_load_n(&args.cycles, __ATOMIC_ACQUIRE) < JITTER_CYCLES); i++)
+    {
+        (void) vos_threadDelay(JITTER_INTERVAL);
+    }
+    (void) vos_threadTerminate(thread);
+    if (args.cycles < JITTER_CYCLES)
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] %u of %u cycles run\n", args.cycles, JITTER_CYCLES);
+        retVal = THREAD_JITTER_ERR;
+    }
+    else
+    {
+        /* deviation of each release from the grid of the first one */
+        for (i = 1u; i < JITTER_CYCLES; i++)
+        {
+            us = L3_jitter_us(&args.release[0], &args.release[i]) - (INT32) (i * JITTER_INTERVAL);
+            us = (us < 0) ? -us : us;
+            maxDev = (us > maxDev) ? us : maxDev;
+        }
+        printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] cyclic thread %u us: %u cycles in %d us, max. jitter %d us\n",
+                 JITTER_INTERVAL, JITTER_CYCLES, L3_jitter_us(&args.release[0], &args.release[JITTER_CYCLES - 1u]),
+                 maxDev);
+    }
+
+    vos_threadTerm();
+    printOut(OUTPUT_ADVANCED,"[THREAD_JITTER] finished\n");
+    return retVal;
+}
+
 THREAD_ERR_T L3_test_thread_sema()
 {
     /* create take give delete */
@@ -1297,6 +1703,25 @@ THREAD_ERR_T L3_test_thread_sema()
         printOut(OUTPUT_ADVANCED,"[THREAD_SEMA] semaTake Timeout ERROR\n");
         retVal = THREAD_SEMA_ERR;
     }
+    /* absolute deadline on the clock of vos_getTime() */
+    vos_getTime(&startTime);
+    endTime = startTime;
+    vos_addTime(&endTime, &timeout);
+    res = vos_semaTakeUntil(sema, &endTime);
+    vos_getTime(&endTime);
+    vos_subTime(&endTime, &timeout);
+    if ((res == VOS_NO_ERR) || (vos_cmpTime(&endTime, &startTime) < 0))
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_SEMA] semaTakeUntil Timeout ERROR\n");
+        retVal = THREAD_SEMA_ERR;
+    }
+    vos_semaGive(sema);
+    res = vos_semaTakeUntil(sema, &startTime);  /* past deadline, available */
+    if (res != VOS_NO_ERR)
+    {
+        printOut(OUTPUT_ADVANCED,"[THREAD_SEMA] semaTakeUntil Error\n");
+        retVal = THREAD_SEMA_ERR;
+    }
     vos_semaDelete(sema);
     printOut(OUTPUT_ADVANCED,"[THREAD_SEMA] finished\n");
     return retVal;
@@ -2294,6 +2719,7 @@ MEM_ERR_T L2_test_mem()
     errcnt += L3_test_mem_queue();
     errcnt += L3_test_mem_help();
     errcnt += L3_test_mem_count();
+    errcnt += L3_test_mem_sizes();
     errcnt += L3_test_mem_delete();
     printOut(OUTPUT_ADVANCED,"\n*********************************************************************\n");
     printOut(OUTPUT_ADVANCED,"*   [MEM] Test finished with errcnt = %i\n",errcnt);
@@ -2318,6 +2744,8 @@ THREAD_ERR_T L2_test_thread()
     errcnt += L3_test_thread_clearTime();
     errcnt += L3_test_thread_getUUID();
     errcnt += L3_test_thread_mutex();
+    errcnt += L3_test_thread_mutex_bench();
+    errcnt += L3_test_thread_jitter();
     errcnt += L3_test_thread_sema();
     printOut(OUTPUT_ADVANCED,"\n*********************************************************************\n");
     printOut(OUTPUT_ADVANCED,"*   [THREAD] Test finished with errcnt = %i\n",errcnt);
@@ -2436,6 +2864,15 @@ void L1_testEvaluation(MEM_ERR_T memErr, THREAD_ERR_T threadErr, SOCK_ERR_T sock
         printOut(OUTPUT_BASIC,"[OK] ");
     }
     printOut(OUTPUT_BASIC," MEM_COUNT\n");
+    if (memErr & MEM_SIZES_ERR)
+    {
+        printOut(OUTPUT_BASIC,"[ERR]");
+    }
+    else
+    {
+        printOut(OUTPUT_BASIC,"[OK] ");
+    }
+    printOut(OUTPUT_BASIC," MEM_SIZES\n");
     if (memErr & MEM_DELETE_ERR)
     {
         printOut(OUTPUT_BASIC,"[ERR]");
@@ -2548,6 +2985,15 @@ void L1_testEvaluation(MEM_ERR_T memErr, THREAD_ERR_T threadErr, SOCK_ERR_T sock
         printOut(OUTPUT_BASIC,"[OK] ");
     }
     printOut(OUTPUT_BASIC," THREAD_MUTEX\n");
+    if (threadErr & THREAD_MUTEX_BENCH_ERR)
+    {
+        printOut(OUTPUT_BASIC,"[ERR]");
+    }
+    else
+    {
+        printOut(OUTPUT_BASIC,"[OK] ");
+    }
+    printOut(OUTPUT_BASIC," THREAD_MUTEX_BENCH\n");
     if (threadErr & THREAD_SEMA_ERR)
     {
         printOut(OUTPUT_BASIC,"[ERR]");
@@ -65,7 +65,8 @@ typedef enum
     MEM_HELP_ERR    =  8,
     MEM_COUNT_ERR   = 16,
     MEM_DELETE_ERR  = 32,
-    MEM_ALL_ERR     = 63
+    MEM_SIZES_ERR   = 64,
+    MEM_ALL_ERR     = 127
 } MEM_ERR_T;
 
 typedef enum
@@ -83,7 +84,9 @@ typedef enum
     THREAD_UUID_ERR             =  512,
     THREAD_MUTEX_ERR            = 1024,
     THREAD_SEMA_ERR             = 2048,
-    THREAD_ALL_ERR              = 4095
+    THREAD_MUTEX_BENCH_ERR      = 4096,
+    THREAD_JITTER_ERR           = 8192,
+    THREAD_ALL_ERR              = 16383
 } THREAD_ERR_T;
 
 typedef enum
@@ -51,6 +51,10 @@ typedef int (test_func_t)(int argc, char *argv[]);
 UINT32          gDestMC = 0xEF000202u;
 int             gFailed;
 int             gFullLog = FALSE;
+int             gUseEventFd = FALSE;        /* use tlc_getEventFd()/tlc_processEvents() in trdp_loop */
+int             gSplitProcess = FALSE;      /* trdp_loop receives and times out only, PD is sent by the test */
+TRDP_OPTION_T   gOptions    = TRDP_OPTION_NONE; /* session options used by test_init */
+UINT32          gBudgetFrames = 0u;             /* work budget of tlc_process used by test_init */
 
 static FILE     *gFp    = NULL;
 
@@ -383,7 +387,7 @@ static void trdp_loop (void* pArg)
     /*
         Enter the main processing loop.
      */
-    while (pSession->threadId)
+    while (pSession->threadRun)
     {
         TRDP_FDS_T  rfds;
         INT32       noDesc;
@@ -392,6 +396,30 @@ static void trdp_loop (void* pArg)
         TRDP_TIME_T  max_tv = {0u, 20000};
         TRDP_TIME_T  min_tv = {0u, 5000};
         
+        if (gUseEventFd)
+        {
+            SOCKET  eventFd;
+
+            /*
+             Only one descriptor has to be watched, tlc_processEvents()
+             reads just the sockets which are ready.
+             */
+            if (tlc_getEventFd(pSession->appHandle, &tv, &eventFd) != TRDP_NO_ERR)
+            {
+                vos_threadDelay(5000);
+                continue;
+            }
+            if (vos_cmpTime(&tv, &max_tv) > 0)
+            {
+                tv = max_tv;
+            }
+            FD_ZERO(&rfds);
+            FD_SET(eventFd, &rfds);
+            (void) vos_select(eventFd + 1, &rfds, NULL, NULL, &tv);
+            (void) tlc_processEvents(pSession->appHandle);
+            continue;
+        }
+
         /*
          Prepare the file descriptor set for the select call.
          Additional descriptors can be added here.
@@ -435,6 +463,12 @@ static void trdp_loop (void* pArg)
          The callback function will be called from within the tlc_process
          function (in it's context and thread)!
          */
+        if (gSplitProcess)
+        {
+            (void) tlc_processReceive(pSession->appHandle, &rfds, &rv);
+            (void) tlc_processTimeouts(pSession->appHandle);
+            continue;
+        }
         (void) tlc_process(pSession->appHandle, &rfds, &rv);
         
     }
@@ -500,12 +534,18 @@ static TRDP_APP_SESSION_T test_init (
     }
     if (err == TRDP_NO_ERR)                 /* We ignore double init here */
     {
-        tlc_openSession(&pSession->appHandle, pSession->ifaceIP, 0u, NULL, NULL, NULL, NULL);
+        TRDP_PROCESS_CONFIG_T   processConfig = {"", "", 0u, 0u, TRDP_OPTION_NONE};
+
+        processConfig.options       = gOptions;
+        processConfig.budgetFrames  = gBudgetFrames;
+        tlc_openSession(&pSession->appHandle, pSession->ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
         /* On error the handle will be NULL... */
     }
     
     if (err == TRDP_NO_ERR)
     {
+        /* set before the thread starts, threadId is assigned after it may already be running */
+        pSession->threadRun = 1;
         (void) vos_threadCreate(&pSession->threadId, name, VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
                                trdp_loop, pSession);
     }
@@ -522,18 +562,25 @@ static void test_deinit (
     TRDP_THREAD_SESSION_T   *pSession1,
     TRDP_THREAD_SESSION_T   *pSession2)
 {
-    if (pSession1)
+    gSplitProcess = FALSE;                  /* ends a send thread of the test, too */
+    if (pSession1 && pSession1->threadId)
     {
-        pSession1->threadRun = 0;
+        /* cancel before the loop may end on its own, the thread must still exist */
         vos_threadTerminate(pSession1->threadId);
+        pSession1->threadRun = 0;
         vos_threadDelay(100000);
     }
-    if (pSession2)
+    if (pSession2 && pSession2->threadId)
     {
-        pSession2->threadRun = 0;
+        /* cancel before the loop may end on its own, the thread must still exist */
         vos_threadTerminate(pSession2->threadId);
+        pSession2->threadRun = 0;
         vos_threadDelay(100000);
     }
+    gUseEventFd = FALSE;
+    gOptions    = TRDP_OPTION_NONE;
+    gBudgetFrames = 0u;
+    vos_memSetOperational(FALSE);
     tlc_terminate();
 }
 
@@ -1836,6 +1883,4159 @@ static int test14 (int argc, char *argv[])
 
 
 
+/**********************************************************************************************************************/
+/** test15 PD and TCP MD using the event descriptor
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test15 (int argc, char *argv[])
+{
+    PREPARE("Event descriptor: Publish & Subscribe, TCP MD Request - Reply - Confirm", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_UUID_T         sessionId1;
+        TRDP_LIS_T          listenHandle;
+        TRDP_URI_USER_T     destURI1 = "12345678901234567890123456789012";   // 32 chars
+        TRDP_URI_USER_T     destURI2 = "12345678901234567890123456789012";   // 32 chars
+        TRDP_URI_USER_T     srcURI   = "12345678901234567890123456789012";   // 32 chars
+        char                data1[1432u];
+        int                 counter = 0;
+
+#define TEST15_COMID     1000u
+#define TEST15_INTERVAL  100000u
+
+        gUseEventFd         = TRUE;
+        gTest14CBCounter    = 0;
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST15_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST15_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, NULL, 0u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, data1, test14PDcallBack,
+                            TEST15_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST15_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test5CBFunction,
+                              TRUE,
+                              TEST5_STRING_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, destURI1);
+        IF_ERROR("tlm_addListener");
+
+        err = tlm_request(appHandle1, NULL, test5CBFunction, &sessionId1,
+                          TEST5_STRING_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP,
+                          TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, 1u, 1000000u, NULL,
+                          (UINT8*)TEST5_STRING_REQUEST, 63*1024,
+                          srcURI, destURI2);
+        IF_ERROR("tlm_request");
+        fprintf(gFp, "->> MD TCP Request sent\n");
+
+        while (counter < 10)         /* 1 second */
+        {
+            sprintf(data1, "Just a Counter: %08d", counter++);
+
+            err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data1, (UINT32) strlen(data1));
+            IF_ERROR("tlp_put");
+
+            vos_threadDelay(TEST15_INTERVAL);
+        }
+
+        fprintf(gFp, "%u PD callbacks received\n", gTest14CBCounter);
+        if (gTest14CBCounter < 5u)
+        {
+            FAILED("PD not received");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test16 PD received by the PD thread, lock-free tlp_get
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test16 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_PD_THREAD;
+
+    PREPARE("PD receive thread: Publish & Subscribe, polling", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        UINT32          lastSeq     = 0u;
+        UINT32          noOfGets    = 0u;
+        UINT32          noOfUpdates = 0u;
+        int             counter     = 0;
+
+#define TEST16_COMID     1000u
+#define TEST16_INTERVAL  10000u
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST16_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST16_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, NULL, 0u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL,
+                            TEST16_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST16_INTERVAL * 30, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        while (counter < 100)         /* 1 second */
+        {
+            char            data1[1432u];
+            char            data2[1432u];
+            int             i;
+
+            sprintf(data1, "Just a Counter: %08d", counter++);
+
+            err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data1, (UINT32) strlen(data1));
+            IF_ERROR("tlp_put");
+
+            /* No tlc_process() of session 2 is needed, the data is there as soon as the thread received it */
+            for (i = 0; i < 100; i++)
+            {
+                UINT32          dataSize2 = sizeof(data2) - 1u;
+                TRDP_PD_INFO_T  pdInfo;
+                int             value;
+
+                err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, (UINT8 *) data2, &dataSize2);
+                if (err == TRDP_NODATA_ERR)
+                {
+                    continue;
+                }
+                IF_ERROR("tlp_get");
+                noOfGets++;
+
+                /* A torn copy would show up as a broken string or a sequence counter going backwards */
+                data2[dataSize2] = 0;
+                if ((sscanf(data2, "Just a Counter: %08d", &value) != 1) || (dataSize2 != 24u) ||
+                    (pdInfo.seqCount < lastSeq))
+                {
+                    fprintf(gFp, "### inconsistent data (seq: %u, size: %u)\n", pdInfo.seqCount, dataSize2);
+                    FAILED("tlp_get");
+                }
+                if (pdInfo.seqCount != lastSeq)
+                {
+                    noOfUpdates++;
+                    lastSeq = pdInfo.seqCount;
+                }
+            }
+            vos_threadDelay(TEST16_INTERVAL);
+        }
+
+        fprintf(gFp, "%u tlp_get calls, %u updates received\n", noOfGets, noOfUpdates);
+        if (noOfUpdates < 20u)
+        {
+            FAILED("PD not received");
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test17 PD publish and subscribe without copying the data
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test17 (int argc, char *argv[])
+{
+    PREPARE("Zero-copy PD: tlp_beginPut/tlp_commitPut, tlp_getBufferRef/tlp_releaseBufferRef", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        UINT32          noOfMatches = 0u;
+        int             counter     = 0;
+
+#define TEST17_COMID     1000u
+#define TEST17_INTERVAL  100000u
+#define TEST17_DATA_LEN  24u
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST17_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST17_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, NULL, TEST17_DATA_LEN);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL,
+                            TEST17_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST17_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlp_commitPut(gSession1.appHandle, pubHandle);
+        if (err != TRDP_STATE_ERR)
+        {
+            FAILED("tlp_commitPut without tlp_beginPut");
+        }
+
+        while (counter < 20)         /* 2 seconds */
+        {
+            char            data1[TEST17_DATA_LEN + 1u];
+            UINT8           *pPutData;
+            const UINT8     *pGetData;
+            UINT32          dataSize;
+            UINT32          generation;
+            TRDP_PD_INFO_T  pdInfo;
+
+            sprintf(data1, "Just a Counter: %08d", counter++);
+
+            err = tlp_beginPut(gSession1.appHandle, pubHandle, &pPutData, &dataSize);
+            IF_ERROR("tlp_beginPut");
+            if (dataSize != TEST17_DATA_LEN)
+            {
+                FAILED("tlp_beginPut: wrong size");
+            }
+            memcpy(pPutData, data1, TEST17_DATA_LEN);
+            err = tlp_commitPut(gSession1.appHandle, pubHandle);
+            IF_ERROR("tlp_commitPut");
+
+            vos_threadDelay(TEST17_INTERVAL);
+
+            err = tlp_getBufferRef(gSession2.appHandle, subHandle, &pdInfo, &pGetData, &dataSize, &generation);
+            if (err == TRDP_NODATA_ERR)
+            {
+                continue;
+            }
+            IF_ERROR("tlp_getBufferRef");
+
+            if ((dataSize == TEST17_DATA_LEN) && (memcmp(pGetData, data1, TEST17_DATA_LEN) == 0))
+            {
+                noOfMatches++;
+            }
+
+            err = tlp_releaseBufferRef(gSession2.appHandle, subHandle, generation);
+            if (err == TRDP_STATE_ERR)
+            {
+                fprintf(gFp, "frame was replaced while reading (seq: %u)\n", pdInfo.seqCount);
+                continue;
+            }
+            IF_ERROR("tlp_releaseBufferRef");
+        }
+
+        fprintf(gFp, "%u frames received without copy\n", noOfMatches);
+        if (noOfMatches < 10u)
+        {
+            FAILED("PD not received");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test18 timing statistics
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test18 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_TIMING_STATS;
+
+    PREPARE("Timing statistics: tlc_process duration and PD send delay", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T                  pubHandle;
+        TRDP_SUB_T                  subHandle;
+        TRDP_SUB_T                  mcSubHandle;
+        TRDP_TIMING_STATISTICS_T    timing;
+        UINT32                      i, j, sum;
+
+#define TEST18_COMID     1000u
+#define TEST18_INTERVAL  10000u
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST18_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST18_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "Hello", 5u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL,
+                            TEST18_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST18_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        /*  A multicast membership to be joined again by tlc_reinitSession   */
+        err = tlp_subscribe(gSession1.appHandle, &mcSubHandle, NULL, NULL,
+                            TEST18_COMID + 1u, 0u, 0u, 0u, 0u, gDestMC,
+                            TRDP_FLAGS_DEFAULT, TEST18_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        vos_threadDelay(500000u);
+
+        err = tlc_reinitSession(gSession1.appHandle);
+        IF_ERROR("tlc_reinitSession");
+
+        err = tlc_getTimingStatistics(gSession1.appHandle, &timing);
+        IF_ERROR("tlc_getTimingStatistics");
+
+        for (i = 0u; i < TRDP_TIMING_CNT; i++)
+        {
+            sum = 0u;
+            for (j = 0u; j < TRDP_TIMING_BUCKETS; j++)
+            {
+                sum += timing.hist[i].bucket[j];
+            }
+            fprintf(gFp, "hist %u: count %u, min %u, max %u, mean %u us\n", i, timing.hist[i].count,
+                    timing.hist[i].min, timing.hist[i].max, timing.hist[i].mean);
+            if ((sum != timing.hist[i].count) ||
+                ((timing.hist[i].count > 0u) &&
+                 ((timing.hist[i].min > timing.hist[i].mean) || (timing.hist[i].mean > timing.hist[i].max))))
+            {
+                FAILED("inconsistent histogram");
+            }
+        }
+        if ((timing.hist[TRDP_TIMING_PROCESS].count == 0u) || (timing.hist[TRDP_TIMING_PD_SEND_LATE].count == 0u))
+        {
+            FAILED("no timing recorded");
+        }
+        if (timing.hist[TRDP_TIMING_REINIT].count != 1u)
+        {
+            FAILED("no reinit duration recorded");
+        }
+
+        err = tlc_resetStatistics(gSession1.appHandle);
+        IF_ERROR("tlc_resetStatistics");
+        err = tlc_getTimingStatistics(gSession1.appHandle, &timing);
+        IF_ERROR("tlc_getTimingStatistics");
+        if (timing.hist[TRDP_TIMING_PD_SEND_LATE].count > 10u)
+        {
+            FAILED("tlc_resetStatistics");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test19 traffic shaping: send slots of publishers with different intervals and sizes
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test19 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_TRAFFIC_SHAPING;
+
+    PREPARE("Traffic shaping: slot scheduler", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T                  pubHandle[5];
+        TRDP_SHAPING_STATISTICS_T   shaping;
+        UINT8                       data[1000u] = {0};
+        const UINT32                interval[5] = {20000u, 20000u, 100000u, 100000u, 100000u};
+        const UINT32                size[5]     = {100u, 100u, 1000u, 1000u, 1000u};
+        UINT32                      i;
+
+        /* The large packets must not be sent in the same slot */
+        for (i = 0u; i < 5u; i++)
+        {
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, 1000u + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, interval[i],
+                              0u, TRDP_FLAGS_DEFAULT, NULL, data, size[i]);
+            IF_ERROR("tlp_publish");
+        }
+
+        err = tlc_getShapingStatistics(gSession1.appHandle, &shaping);
+        IF_ERROR("tlc_getShapingStatistics");
+        fprintf(gFp, "%u publishers in %u slots of %u us, avg %u, peak %u bytes/slot (%u kbit/s)\n",
+                shaping.numPub, shaping.slotCnt, shaping.slotTime, shaping.avgLoad, shaping.peakLoad,
+                shaping.peakBandwidth);
+        if ((shaping.numPub != 5u) || (shaping.slotTime != 20000u) || (shaping.slotCnt != 5u) ||
+            (shaping.peakLoad >= 2000u))
+        {
+            FAILED("tlc_getShapingStatistics");
+        }
+
+        /* Unpublish keeps the other slots, a new publisher takes the free one */
+        err = tlp_unpublish(gSession1.appHandle, pubHandle[4]);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_publish(gSession1.appHandle, &pubHandle[4], NULL, NULL, 1004u, 0u, 0u,
+                          0u, gSession2.ifaceIP, interval[4],
+                          0u, TRDP_FLAGS_DEFAULT, NULL, data, size[4]);
+        IF_ERROR("tlp_publish");
+
+        err = tlc_getShapingStatistics(gSession1.appHandle, &shaping);
+        IF_ERROR("tlc_getShapingStatistics");
+        if ((shaping.numPub != 5u) || (shaping.peakLoad >= 2000u))
+        {
+            FAILED("incremental placement");
+        }
+
+        for (i = 2u; i < 5u; i++)
+        {
+            err = tlp_unpublish(gSession1.appHandle, pubHandle[i]);
+            IF_ERROR("tlp_unpublish");
+        }
+        err = tlc_getShapingStatistics(gSession1.appHandle, &shaping);
+        IF_ERROR("tlc_getShapingStatistics");
+        if ((shaping.numPub != 2u) || (shaping.peakLoad >= 1000u))
+        {
+            FAILED("tlp_unpublish");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test20 PD sent ahead with launch time (SO_TXTIME)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test20 (int argc, char *argv[])
+{
+    PREPARE("PD with launch time: Publish & Subscribe", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_SEND_PARAM_T   sendParam   = {TRDP_PD_DEFAULT_QOS, TRDP_PD_DEFAULT_TTL, 0u, TRUE};
+        UINT32              lastSeq     = 0u;
+        UINT32              noOfUpdates = 0u;
+        int                 counter     = 0;
+
+#define TEST20_COMID     1000u
+#define TEST20_INTERVAL  10000u
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST20_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST20_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, &sendParam, NULL, 0u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL,
+                            TEST20_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST20_INTERVAL * 30, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        while (counter < 100)         /* 1 second */
+        {
+            char            data1[32u];
+            char            data2[1432u];
+            UINT32          dataSize2 = sizeof(data2);
+            TRDP_PD_INFO_T  pdInfo;
+
+            sprintf(data1, "Just a Counter: %08d", counter++);
+
+            err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data1, (UINT32) strlen(data1));
+            IF_ERROR("tlp_put");
+
+            vos_threadDelay(TEST20_INTERVAL);
+
+            err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, (UINT8 *) data2, &dataSize2);
+            if (err == TRDP_NODATA_ERR)
+            {
+                continue;
+            }
+            IF_ERROR("tlp_get");
+            if (pdInfo.seqCount != lastSeq)
+            {
+                noOfUpdates++;
+                lastSeq = pdInfo.seqCount;
+            }
+        }
+
+        fprintf(gFp, "%u updates received\n", noOfUpdates);
+        if (noOfUpdates < 20u)
+        {
+            FAILED("PD not received");
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test21 PD reception time from kernel time stamps
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test21 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_RX_TIMESTAMPS;
+
+    PREPARE("PD receive time stamps", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        UINT32          noOfStamps  = 0u;
+        int             counter     = 0;
+
+#define TEST21_COMID     1000u
+#define TEST21_INTERVAL  10000u
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST21_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST21_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, NULL, 0u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL,
+                            TEST21_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST21_INTERVAL * 30, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        while (counter < 50)         /* 0.5 seconds */
+        {
+            char            data1[32u];
+            char            data2[1432u];
+            UINT32          dataSize2 = sizeof(data2);
+            TRDP_PD_INFO_T  pdInfo;
+            TRDP_TIME_T     now, age;
+
+            sprintf(data1, "Just a Counter: %08d", counter++);
+
+            err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data1, (UINT32) strlen(data1));
+            IF_ERROR("tlp_put");
+
+            vos_threadDelay(TEST21_INTERVAL);
+
+            err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, (UINT8 *) data2, &dataSize2);
+            if (err == TRDP_NODATA_ERR)
+            {
+                continue;
+            }
+            IF_ERROR("tlp_get");
+
+            /* The data must have been received within the last timeout period */
+            vos_getTime(&now);
+            age = now;
+            vos_subTime(&age, &pdInfo.rxTime);
+            if (!timerisset(&pdInfo.rxTime) || (vos_cmpTime(&pdInfo.rxTime, &now) > 0) ||
+                (age.tv_sec > 0) || (age.tv_usec > (TEST21_INTERVAL * 30)))
+            {
+                fprintf(gFp, "rxTime %ld.%06ld, now %ld.%06ld\n", (long) pdInfo.rxTime.tv_sec,
+                        (long) pdInfo.rxTime.tv_usec, (long) now.tv_sec, (long) now.tv_usec);
+                FAILED("implausible reception time");
+            }
+            noOfStamps++;
+        }
+
+        fprintf(gFp, "%u reception times checked\n", noOfStamps);
+        if (noOfStamps < 10u)
+        {
+            FAILED("PD not received");
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test22 PD reception through an AF_XDP socket
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test22 (int argc, char *argv[])
+{
+    PREPARE("PD reception via AF_XDP", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        UINT32          noOfUpdates = 0u;
+        UINT32          lastSeq     = 0u;
+        int             counter     = 0;
+
+#define TEST22_COMID     1000u
+#define TEST22_INTERVAL  10000u
+
+        /* needs root privileges and a kernel with AF_XDP, the loopback interface runs in copy mode */
+        err = tlp_openXdp(gSession2.appHandle, "lo", 0u);
+        if (err != TRDP_NO_ERR)
+        {
+            fprintf(gFp, "AF_XDP not available (Err: %d), test skipped\n", err);
+            err = TRDP_NO_ERR;
+            goto end;
+        }
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST22_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST22_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, NULL, 0u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL,
+                            TEST22_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST22_INTERVAL * 30, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        while (counter < 50)         /* 0.5 seconds */
+        {
+            char            data1[32u];
+            char            data2[1432u];
+            UINT32          dataSize2 = sizeof(data2);
+            TRDP_PD_INFO_T  pdInfo;
+
+            sprintf(data1, "Just a Counter: %08d", counter++);
+
+            err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data1, (UINT32) strlen(data1));
+            IF_ERROR("tlp_put");
+
+            vos_threadDelay(TEST22_INTERVAL);
+
+            err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, (UINT8 *) data2, &dataSize2);
+            if (err == TRDP_NODATA_ERR)
+            {
+                continue;
+            }
+            IF_ERROR("tlp_get");
+
+            if (pdInfo.seqCount != lastSeq)
+            {
+                lastSeq = pdInfo.seqCount;
+                noOfUpdates++;
+            }
+        }
+
+        fprintf(gFp, "%u updates received\n", noOfUpdates);
+        if (noOfUpdates < 10u)
+        {
+            FAILED("PD not received via AF_XDP");
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test23 MD timeouts from the timeout schedule
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static UINT32   gTest23ReplyTimeouts    = 0u;
+static UINT32   gTest23AppTimeouts      = 0u;
+
+static void  test23CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    /* the request is never replied */
+    if (pMsg->resultCode == TRDP_REPLYTO_ERR)
+    {
+        gTest23ReplyTimeouts++;
+    }
+    else if (pMsg->resultCode == TRDP_APP_REPLYTO_ERR)
+    {
+        gTest23AppTimeouts++;
+    }
+}
+
+static int test23 (int argc, char *argv[])
+{
+    PREPARE("MD reply timeouts, next job time", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_UUID_T         sessionId1;
+        TRDP_LIS_T          listenHandle;
+        TRDP_TIME_T         interval;
+        TRDP_FDS_T          rfds;
+        INT32               noDesc = 0;
+
+#define TEST23_COMID     2000u
+#define TEST23_TIMEOUT   200000u
+
+        gTest23ReplyTimeouts    = 0u;
+        gTest23AppTimeouts      = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test23CBFunction,
+                              TRUE,
+                              TEST23_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tlm_request(appHandle1, NULL, test23CBFunction, &sessionId1,
+                          TEST23_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP,
+                          TRDP_FLAGS_CALLBACK, 1u, TEST23_TIMEOUT, NULL,
+                          (UINT8 *)"Hello", 6u, NULL, NULL);
+        IF_ERROR("tlm_request");
+
+        /* Without PD, the pending reply timeout is the next job */
+        FD_ZERO(&rfds);
+        err = tlc_getInterval(appHandle1, &interval, &rfds, &noDesc);
+        IF_ERROR("tlc_getInterval");
+        if ((interval.tv_sec > 0) || (interval.tv_usec > (INT32) TEST23_TIMEOUT))
+        {
+            fprintf(gFp, "interval %ld.%06ld\n", (long) interval.tv_sec, (long) interval.tv_usec);
+            FAILED("MD timeout not reported by tlc_getInterval");
+        }
+
+        /* retries included */
+        vos_threadDelay(TEST23_TIMEOUT * (TRDP_MD_DEFAULT_RETRIES + 1u) + 500000u);
+
+        fprintf(gFp, "%u reply timeouts, %u application reply timeouts\n", gTest23ReplyTimeouts, gTest23AppTimeouts);
+        if ((gTest23ReplyTimeouts != 1u) || (gTest23AppTimeouts < 1u))
+        {
+            FAILED("MD timeouts not reported");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test24 MD listener selection by comId index
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static const void *gTest24UserRef = NULL;
+
+static void  test24CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MN))
+    {
+        gTest24UserRef = pMsg->pUserRef;
+    }
+}
+
+static int test24 (int argc, char *argv[])
+{
+    PREPARE("MD listener lookup by comId", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        static const char   cAny1[] = "any1", cAny2[] = "any2", cComId[] = "comId";
+        TRDP_LIS_T          lisAny1, lisAny2, lisComId;
+
+#define TEST24_COMID     2001u
+#define TEST24_OTHER     2002u
+#define TEST24_NOTIFY(comId, expected)                                                                      \
+    gTest24UserRef = NULL;                                                                                  \
+    err = tlm_notify(appHandle1, NULL, NULL, (comId), 0u, 0u, 0u, gSession2.ifaceIP,                        \
+                     TRDP_FLAGS_CALLBACK, NULL, (UINT8 *)"Hello", 6u, NULL, NULL);                          \
+    IF_ERROR("tlm_notify");                                                                                 \
+    vos_threadDelay(300000u);                                                                               \
+    if (gTest24UserRef != (const void *)(expected))                                                         \
+    {                                                                                                       \
+        fprintf(gFp, "comId %u received by '%s'\n", (comId),                                                \
+                (gTest24UserRef != NULL) ? (const char *)gTest24UserRef : "none");                          \
+        FAILED("wrong listener");                                                                           \
+    }
+
+        /* listener for any comId first, then a comId listener, which is newer and wins */
+        err = tlm_addListener(appHandle2, &lisAny1, cAny1, test24CBFunction, FALSE, 0u, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        err = tlm_addListener(appHandle2, &lisComId, cComId, test24CBFunction, TRUE, TEST24_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        TEST24_NOTIFY(TEST24_COMID, cComId);
+        TEST24_NOTIFY(TEST24_OTHER, cAny1);
+
+        /* a newer listener for any comId takes precedence again */
+        err = tlm_addListener(appHandle2, &lisAny2, cAny2, test24CBFunction, FALSE, 0u, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        TEST24_NOTIFY(TEST24_COMID, cAny2);
+
+        err = tlm_delListener(appHandle2, lisAny2);
+        IF_ERROR("tlm_delListener");
+        TEST24_NOTIFY(TEST24_COMID, cComId);
+
+        err = tlm_delListener(appHandle2, lisComId);
+        IF_ERROR("tlm_delListener");
+        TEST24_NOTIFY(TEST24_COMID, cAny1);
+
+        err = tlm_delListener(appHandle2, lisAny1);
+        IF_ERROR("tlm_delListener");
+        TEST24_NOTIFY(TEST24_COMID, NULL);
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test25 TCP MD request/reply with the user buffers sent in place
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST25_COMID     2010u
+#define TEST25_SIZE      60001u                 /* odd size, needs padding */
+
+static UINT8    gTest25Request[TEST25_SIZE];
+static UINT8    gTest25Reply[TEST25_SIZE];
+static UINT32   gTest25SentRequest  = 0u;
+static UINT32   gTest25SentReply    = 0u;
+static UINT32   gTest25GotRequest   = 0u;
+static UINT32   gTest25GotReply     = 0u;
+
+static void  test25CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pMsg->comId != TEST25_COMID))
+    {
+        return;
+    }
+    if (pData == gTest25Request)
+    {
+        /* send complete of the request */
+        gTest25SentRequest++;
+    }
+    else if (pData == gTest25Reply)
+    {
+        /* send complete of the reply */
+        gTest25SentReply++;
+    }
+    else if (pMsg->msgType == TRDP_MSG_MR)
+    {
+        if ((dataSize == TEST25_SIZE) && (memcmp(pData, gTest25Request, TEST25_SIZE) == 0))
+        {
+            gTest25GotRequest++;
+        }
+        (void) tlm_reply(appHandle, &pMsg->sessionId, TEST25_COMID, 0u, NULL, gTest25Reply, TEST25_SIZE);
+    }
+    else if (pMsg->msgType == TRDP_MSG_MP)
+    {
+        if ((dataSize == TEST25_SIZE) && (memcmp(pData, gTest25Reply, TEST25_SIZE) == 0))
+        {
+            gTest25GotReply++;
+        }
+    }
+}
+
+static int test25 (int argc, char *argv[])
+{
+    PREPARE("TCP MD Request - Reply without packet copy", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_UUID_T         sessionId1;
+        TRDP_LIS_T          listenHandle;
+        UINT32              i;
+
+        for (i = 0u; i < TEST25_SIZE; i++)
+        {
+            gTest25Request[i]   = (UINT8) i;
+            gTest25Reply[i]     = (UINT8) (i * 7u);
+        }
+        gTest25SentRequest  = 0u;
+        gTest25SentReply    = 0u;
+        gTest25GotRequest   = 0u;
+        gTest25GotReply     = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test25CBFunction,
+                              TRUE,
+                              TEST25_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP | TRDP_FLAGS_TCP_NOCOPY, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tlm_request(appHandle1, NULL, test25CBFunction, &sessionId1,
+                          TEST25_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP,
+                          TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP | TRDP_FLAGS_TCP_NOCOPY, 1u, 2000000u, NULL,
+                          gTest25Request, TEST25_SIZE, NULL, NULL);
+        IF_ERROR("tlm_request");
+
+        vos_threadDelay(2000000u);
+
+        fprintf(gFp, "request sent %u, received %u; reply sent %u, received %u\n",
+                gTest25SentRequest, gTest25GotRequest, gTest25SentReply, gTest25GotReply);
+        if ((gTest25SentRequest != 1u) || (gTest25GotRequest != 1u) ||
+            (gTest25SentReply != 1u) || (gTest25GotReply != 1u))
+        {
+            FAILED("TCP MD without packet copy");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test26 TCP MD notification handed to the listener in chunks
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST26_COMID     2011u
+#define TEST26_SIZE      60001u
+
+static UINT8    gTest26Data[TEST26_SIZE];
+static UINT32   gTest26Received = 0u;
+static UINT32   gTest26Chunks   = 0u;
+static UINT32   gTest26Errors   = 0u;
+
+static void  test26CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->comId != TEST26_COMID) || (pMsg->msgType != TRDP_MSG_MN))
+    {
+        return;
+    }
+    if ((pMsg->resultCode != TRDP_NO_ERR) ||
+        (pMsg->totalLength != TEST26_SIZE) ||
+        (pMsg->chunkOffset != gTest26Received) ||
+        (pMsg->chunkOffset + dataSize > TEST26_SIZE) ||
+        (memcmp(pData, gTest26Data + pMsg->chunkOffset, dataSize) != 0))
+    {
+        gTest26Errors++;
+        return;
+    }
+    gTest26Received += dataSize;
+    gTest26Chunks++;
+}
+
+static int test26 (int argc, char *argv[])
+{
+    PREPARE("TCP MD Notify handed over in chunks", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T          listenHandle;
+        UINT32              i;
+
+        for (i = 0u; i < TEST26_SIZE; i++)
+        {
+            gTest26Data[i] = (UINT8) (i * 13u);
+        }
+        gTest26Received = 0u;
+        gTest26Chunks   = 0u;
+        gTest26Errors   = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test26CBFunction,
+                              TRUE,
+                              TEST26_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP | TRDP_FLAGS_TCP_STREAM, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tlm_notify(appHandle1, NULL, NULL, TEST26_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                         TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, gTest26Data, TEST26_SIZE, NULL, NULL);
+        IF_ERROR("tlm_notify");
+
+        vos_threadDelay(2000000u);
+
+        fprintf(gFp, "%u bytes in %u chunks, %u errors\n", gTest26Received, gTest26Chunks, gTest26Errors);
+        if ((gTest26Received != TEST26_SIZE) || (gTest26Chunks < 2u) || (gTest26Errors != 0u))
+        {
+            FAILED("TCP MD notification not streamed");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test27 TCP MD connection reuse
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST27_COMID     2012u
+#define TEST27_COUNT     3u
+
+static UINT32   gTest27Received = 0u;
+
+static void  test27CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->comId == TEST27_COMID) && (pMsg->msgType == TRDP_MSG_MN))
+    {
+        gTest27Received++;
+    }
+}
+
+static int test27 (int argc, char *argv[])
+{
+    PREPARE("TCP MD connection reuse", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T                  listenHandle;
+        TRDP_TCP_CONN_STATISTICS_T  before, after;
+        UINT8                       data[] = "Hello over a kept alive connection";
+        UINT32                      i;
+
+        gTest27Received = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test27CBFunction,
+                              TRUE,
+                              TEST27_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tlc_getTcpConnStatistics(appHandle1, &before);
+        IF_ERROR("tlc_getTcpConnStatistics");
+
+        for (i = 0u; i < TEST27_COUNT; i++)
+        {
+            err = tlm_notify(appHandle1, NULL, NULL, TEST27_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                             TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, data, sizeof(data), NULL, NULL);
+            IF_ERROR("tlm_notify");
+
+            vos_threadDelay(500000u);
+        }
+
+        err = tlc_getTcpConnStatistics(appHandle1, &after);
+        IF_ERROR("tlc_getTcpConnStatistics");
+
+        fprintf(gFp, "received %u, connects %u, reuses %u, open %u, idle %u\n",
+                gTest27Received, after.numConnect - before.numConnect, after.numReuse - before.numReuse,
+                after.numOpen, after.numIdle);
+        if ((gTest27Received != TEST27_COUNT) ||
+            (after.numConnect - before.numConnect > 1u) ||
+            (after.numConnect - before.numConnect + after.numReuse - before.numReuse != TEST27_COUNT) ||
+            (after.numOpen != 1u) || (after.numIdle != 1u))
+        {
+            FAILED("TCP connection not reused");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test28 UDP MD replies collected into one callback
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST28_COMID     2013u
+#define TEST28_REPLY     "Reply collected until the session timed out"
+
+static UINT32   gTest28Callbacks    = 0u;
+static UINT32   gTest28Replies      = 0u;
+
+static void  test28CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if (pMsg->msgType == TRDP_MSG_MR)
+    {
+        (void) tlm_reply(appHandle, &pMsg->sessionId, TEST28_COMID, 0u, NULL,
+                         (UINT8 *)TEST28_REPLY, (UINT32) sizeof(TEST28_REPLY));
+    }
+    else if ((pMsg->comId == TEST28_COMID) && (pData != NULL))
+    {
+        const TRDP_MD_REPLY_T   *pReplies = (const TRDP_MD_REPLY_T *) pData;
+        UINT32                  i;
+
+        gTest28Callbacks++;
+        for (i = 0u; i < dataSize / sizeof(TRDP_MD_REPLY_T); i++)
+        {
+            if ((pReplies[i].dataSize == sizeof(TEST28_REPLY)) &&
+                (memcmp(pReplies[i].pData, TEST28_REPLY, sizeof(TEST28_REPLY)) == 0))
+            {
+                gTest28Replies++;
+            }
+        }
+    }
+}
+
+static int test28 (int argc, char *argv[])
+{
+    PREPARE("UDP MD replies collected into one callback", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_UUID_T sessionId;
+        TRDP_LIS_T  listenHandle;
+        UINT8       data[] = "Who is there?";
+
+        gTest28Callbacks    = 0u;
+        gTest28Replies      = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test28CBFunction,
+                              TRUE,
+                              TEST28_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        /* unknown number of replies: the session ends with the reply timeout */
+        err = tlm_request(appHandle1, NULL, test28CBFunction, &sessionId,
+                          TEST28_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                          TRDP_FLAGS_CALLBACK | TRDP_FLAGS_MD_COLLECT, 0u, 500000u, NULL,
+                          data, sizeof(data), NULL, NULL);
+        IF_ERROR("tlm_request");
+
+        vos_threadDelay(2000000u);
+
+        fprintf(gFp, "%u callback(s), %u reply(ies)\n", gTest28Callbacks, gTest28Replies);
+        if ((gTest28Callbacks != 1u) || (gTest28Replies != 1u))
+        {
+            FAILED("MD replies not collected");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test29 UDP MD notifications reuse pooled elements and frames
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST29_COMID     2014u
+#define TEST29_COUNT     10u
+
+static int test29 (int argc, char *argv[])
+{
+    PREPARE("UDP MD element and frame pool", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_MD_POOL_STATISTICS_T   stats;
+        UINT8                       data[] = "Notification from the pool";
+        UINT32                      i;
+
+        for (i = 0u; i < TEST29_COUNT; i++)
+        {
+            err = tlm_notify(appHandle1, NULL, NULL, TEST29_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                             TRDP_FLAGS_NONE, NULL, data, sizeof(data), NULL, NULL);
+            IF_ERROR("tlm_notify");
+
+            vos_threadDelay(100000u);
+        }
+
+        err = tlc_getMdPoolStatistics(appHandle1, &stats);
+        IF_ERROR("tlc_getMdPoolStatistics");
+
+        fprintf(gFp, "elements: %u hits, %u allocated; frames: %u hits, %u allocated\n",
+                stats.numEleHit, stats.numEleAlloc, stats.numFrameHit, stats.numFrameAlloc);
+        if ((stats.numEleHit < TEST29_COUNT - 1u) || (stats.numFrameHit < TEST29_COUNT - 1u) ||
+            (stats.numFrameAlloc > 1u))
+        {
+            FAILED("MD elements and frames not reused");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test30 MD session IDs are distinct RFC 4122 UUIDs
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST30_COMID     2015u
+#define TEST30_COUNT     16u
+
+static int test30 (int argc, char *argv[])
+{
+    PREPARE("MD session ID generation", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_UUID_T sessionId[TEST30_COUNT];
+        UINT8       data[] = "Anybody?";
+        UINT32      i, j;
+
+        for (i = 0u; i < TEST30_COUNT; i++)
+        {
+            err = tlm_request(appHandle1, NULL, NULL, &sessionId[i], TEST30_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                              TRDP_FLAGS_NONE, 1u, 100000u, NULL, data, sizeof(data), NULL, NULL);
+            IF_ERROR("tlm_request");
+
+            if (((sessionId[i][6] & 0xF0u) != 0x40u) || ((sessionId[i][8] & 0xC0u) != 0x80u))
+            {
+                FAILED("session ID is no RFC 4122 version 4 UUID");
+            }
+            for (j = 0u; j < i; j++)
+            {
+                if (memcmp(sessionId[i], sessionId[j], sizeof(TRDP_UUID_T)) == 0)
+                {
+                    FAILED("session ID not unique");
+                }
+            }
+        }
+        vos_threadDelay(500000u);
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test31 Batch publish and subscribe
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST31_COMID     2020u
+#define TEST31_COUNT     4u
+#define TEST31_INTERVAL  100000u
+
+static int test31 (int argc, char *argv[])
+{
+    PREPARE("Batch publish and subscribe", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_ENTRY_T    pub[TEST31_COUNT + 1u];
+        TRDP_SUB_ENTRY_T    sub[TEST31_COUNT];
+        CHAR8               data[TEST31_COUNT][16];
+        UINT32              i;
+
+        memset(pub, 0, sizeof(pub));
+        memset(sub, 0, sizeof(sub));
+        for (i = 0u; i < TEST31_COUNT; i++)
+        {
+            sprintf(data[i], "Batch %u", i);
+            pub[i].comId        = TEST31_COMID + i;
+            pub[i].destIpAddr   = gSession2.ifaceIP;
+            pub[i].interval     = TEST31_INTERVAL;
+            pub[i].pData        = (const UINT8 *) data[i];
+            pub[i].dataSize     = sizeof(data[i]);
+
+            sub[i].comId        = TEST31_COMID + i;
+            sub[i].timeout      = TEST31_INTERVAL * 3u;
+        }
+        /* the last entry duplicates the first one and must be refused */
+        pub[TEST31_COUNT] = pub[0];
+
+        err = tlp_publishBatch(appHandle1, pub, TEST31_COUNT + 1u);
+        if ((err != TRDP_NOPUB_ERR) || (pub[TEST31_COUNT].result != TRDP_NOPUB_ERR))
+        {
+            FAILED("duplicate publisher not refused");
+        }
+        for (i = 0u; i < TEST31_COUNT; i++)
+        {
+            if ((pub[i].result != TRDP_NO_ERR) || (pub[i].pubHandle == NULL))
+            {
+                FAILED("tlp_publishBatch");
+            }
+        }
+
+        err = tlp_subscribeBatch(appHandle2, sub, TEST31_COUNT);
+        IF_ERROR("tlp_subscribeBatch");
+
+        vos_threadDelay(3u * TEST31_INTERVAL);
+
+        for (i = 0u; i < TEST31_COUNT; i++)
+        {
+            TRDP_PD_INFO_T  pdInfo;
+            CHAR8           buffer[16];
+            UINT32          dataSize = sizeof(buffer);
+
+            err = tlp_get(appHandle2, sub[i].subHandle, &pdInfo, (UINT8 *) buffer, &dataSize);
+            IF_ERROR("tlp_get");
+            if ((dataSize != sizeof(data[i])) || (memcmp(buffer, data[i], dataSize) != 0))
+            {
+                FAILED("received data does not match");
+            }
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test32 Socket reuse across publishers with different send parameters
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST32_COMID     2040u
+#define TEST32_COUNT     12u
+#define TEST32_INTERVAL  100000u
+
+static int test32 (int argc, char *argv[])
+{
+    PREPARE("Socket lookup by send parameters", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle[TEST32_COUNT];
+        TRDP_SUB_T          subHandle[TEST32_COUNT];
+        TRDP_SEND_PARAM_T   sendParam[TEST32_COUNT];
+        CHAR8               data[TEST32_COUNT][16];
+        UINT32              i;
+
+        /* three different qos values share three sockets */
+        for (i = 0u; i < TEST32_COUNT; i++)
+        {
+            sprintf(data[i], "Socket %u", i);
+            sendParam[i].qos        = (UINT8) (3u + i % 3u);
+            sendParam[i].ttl        = 64u;
+            sendParam[i].retries    = 0u;
+            sendParam[i].txTime     = FALSE;
+
+            err = tlp_publish(appHandle1, &pubHandle[i], NULL, NULL, TEST32_COMID + i, 0u, 0u, 0u,
+                              gSession2.ifaceIP, TEST32_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, &sendParam[i],
+                              (const UINT8 *) data[i], sizeof(data[i]));
+            IF_ERROR("tlp_publish");
+
+            err = tlp_subscribe(appHandle2, &subHandle[i], NULL, NULL, TEST32_COMID + i, 0u, 0u,
+                                VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_DEFAULT,
+                                TEST32_INTERVAL * 3u, TRDP_TO_SET_TO_ZERO);
+            IF_ERROR("tlp_subscribe");
+        }
+
+        /* close one socket completely and republish its telegrams with new parameters */
+        for (i = 1u; i < TEST32_COUNT; i += 3u)
+        {
+            err = tlp_unpublish(appHandle1, pubHandle[i]);
+            IF_ERROR("tlp_unpublish");
+        }
+        for (i = 1u; i < TEST32_COUNT; i += 3u)
+        {
+            sendParam[i].qos = 7u;
+            err = tlp_publish(appHandle1, &pubHandle[i], NULL, NULL, TEST32_COMID + i, 0u, 0u, 0u,
+                              gSession2.ifaceIP, TEST32_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, &sendParam[i],
+                              (const UINT8 *) data[i], sizeof(data[i]));
+            IF_ERROR("tlp_publish (republish)");
+        }
+
+        vos_threadDelay(3u * TEST32_INTERVAL);
+
+        for (i = 0u; i < TEST32_COUNT; i++)
+        {
+            TRDP_PD_INFO_T  pdInfo;
+            CHAR8           buffer[16];
+            UINT32          dataSize = sizeof(buffer);
+
+            err = tlp_get(appHandle2, subHandle[i], &pdInfo, (UINT8 *) buffer, &dataSize);
+            IF_ERROR("tlp_get");
+            if ((dataSize != sizeof(data[i])) || (memcmp(buffer, data[i], dataSize) != 0))
+            {
+                FAILED("received data does not match");
+            }
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test33 Many multicast groups on one socket, partly source specific
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST33_COMID     2060u
+#define TEST33_COUNT     30u            /* more than VOS_MAX_MULTICAST_CNT */
+#define TEST33_MCBASE    0xEF000300u
+#define TEST33_INTERVAL  100000u
+
+static int test33 (int argc, char *argv[])
+{
+    PREPARE("Multicast joins beyond VOS_MAX_MULTICAST_CNT", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle[TEST33_COUNT];
+        TRDP_SUB_T      subHandle[TEST33_COUNT];
+        CHAR8           data[TEST33_COUNT][16];
+        UINT32          i;
+
+        for (i = 0u; i < TEST33_COUNT; i++)
+        {
+            /* every second subscription names its source: a source specific join */
+            sprintf(data[i], "Group %u", i);
+            err = tlp_subscribe(appHandle2, &subHandle[i], NULL, NULL, TEST33_COMID + i, 0u, 0u,
+                                (i & 1u) ? VOS_INADDR_ANY : gSession1.ifaceIP, VOS_INADDR_ANY,
+                                TEST33_MCBASE + i, TRDP_FLAGS_DEFAULT, TEST33_INTERVAL * 3u, TRDP_TO_SET_TO_ZERO);
+            IF_ERROR("tlp_subscribe");
+
+            err = tlp_publish(appHandle1, &pubHandle[i], NULL, NULL, TEST33_COMID + i, 0u, 0u, 0u,
+                              TEST33_MCBASE + i, TEST33_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                              (const UINT8 *) data[i], sizeof(data[i]));
+            IF_ERROR("tlp_publish");
+        }
+
+        vos_threadDelay(3u * TEST33_INTERVAL);
+
+        for (i = 0u; i < TEST33_COUNT; i++)
+        {
+            TRDP_PD_INFO_T  pdInfo;
+            CHAR8           buffer[16];
+            UINT32          dataSize = sizeof(buffer);
+
+            err = tlp_get(appHandle2, subHandle[i], &pdInfo, (UINT8 *) buffer, &dataSize);
+            IF_ERROR("tlp_get");
+            if ((dataSize != sizeof(data[i])) || (memcmp(buffer, data[i], dataSize) != 0))
+            {
+                FAILED("received data does not match");
+            }
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test34 Kernel side filtering of unsubscribed comIds and sources
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST34_COMID     2100u
+#define TEST34_INTERVAL  100000u
+#define TEST34_CYCLES    10u
+
+static int test34 (int argc, char *argv[])
+{
+    PREPARE("PD socket filter", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle[3];
+        TRDP_SUB_T          subHandle[2];
+        TRDP_STATISTICS_T   stats;
+        UINT8               data[16] = "Filter";
+        UINT32              numRcv;
+        UINT32              i;
+
+        /* comId +0 is subscribed from session 1, comId +1 from another source, comId +2 not at all */
+        err = tlp_subscribe(appHandle2, &subHandle[0], NULL, NULL, TEST34_COMID, 0u, 0u,
+                            gSession1.ifaceIP, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_DEFAULT,
+                            TEST34_INTERVAL * 3u, TRDP_TO_SET_TO_ZERO);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_subscribe(appHandle2, &subHandle[1], NULL, NULL, TEST34_COMID + 1u, 0u, 0u,
+                            vos_dottedIP("10.99.99.99"), VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_DEFAULT,
+                            TEST34_INTERVAL * 3u, TRDP_TO_SET_TO_ZERO);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlc_getStatistics(appHandle2, &stats);
+        IF_ERROR("tlc_getStatistics");
+        numRcv = stats.pd.numRcv;
+
+        for (i = 0u; i < 3u; i++)
+        {
+            err = tlp_publish(appHandle1, &pubHandle[i], NULL, NULL, TEST34_COMID + i, 0u, 0u, 0u,
+                              gSession2.ifaceIP, TEST34_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                              data, sizeof(data));
+            IF_ERROR("tlp_publish");
+        }
+
+        vos_threadDelay(TEST34_CYCLES * TEST34_INTERVAL);
+
+        {
+            TRDP_PD_INFO_T  pdInfo;
+            UINT8           buffer[16];
+            UINT32          dataSize = sizeof(buffer);
+
+            err = tlp_get(appHandle2, subHandle[0], &pdInfo, buffer, &dataSize);
+            IF_ERROR("tlp_get");
+        }
+
+        err = tlc_getStatistics(appHandle2, &stats);
+        IF_ERROR("tlc_getStatistics");
+        numRcv = stats.pd.numRcv - numRcv;
+        fprintf(gFp, "received %u frames of %u sent\n", numRcv, 3u * TEST34_CYCLES);
+#if defined(__linux) && (!defined(TRDP_PD_SOCK_FILTER) || TRDP_PD_SOCK_FILTER)
+        /* only the subscribed telegram reaches user space */
+        if (numRcv > TEST34_CYCLES + 3u)
+        {
+            FAILED("unsubscribed frames were not filtered");
+        }
+#endif
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test35 Time out supervision of many subscriptions
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST35_COMID     2120u
+#define TEST35_COUNT     8u
+#define TEST35_INTERVAL  100000u
+
+static UINT32 gTest35Timeouts[TEST35_COUNT];
+
+static void test35PDcallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_TIMEOUT_ERR) &&
+        (pMsg->comId >= TEST35_COMID) && (pMsg->comId < TEST35_COMID + TEST35_COUNT))
+    {
+        gTest35Timeouts[pMsg->comId - TEST35_COMID]++;
+    }
+}
+
+static int test35 (int argc, char *argv[])
+{
+    PREPARE("PD time out table", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle[TEST35_COUNT / 2u];
+        TRDP_SUB_T      subHandle[TEST35_COUNT];
+        UINT8           data[16] = "Timeout";
+        UINT32          i;
+
+        memset(gTest35Timeouts, 0, sizeof(gTest35Timeouts));
+
+        /* only the even comIds are published, the odd ones time out once */
+        for (i = 0u; i < TEST35_COUNT; i++)
+        {
+            err = tlp_subscribe(appHandle2, &subHandle[i], NULL, test35PDcallBack, TEST35_COMID + i, 0u, 0u,
+                                VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_DEFAULT,
+                                TEST35_INTERVAL * 3u, TRDP_TO_SET_TO_ZERO);
+            IF_ERROR("tlp_subscribe");
+        }
+        for (i = 0u; i < TEST35_COUNT / 2u; i++)
+        {
+            err = tlp_publish(appHandle1, &pubHandle[i], NULL, NULL, TEST35_COMID + 2u * i, 0u, 0u, 0u,
+                              gSession2.ifaceIP, TEST35_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                              data, sizeof(data));
+            IF_ERROR("tlp_publish");
+        }
+
+        /* a removed subscription must not be supervised any longer */
+        err = tlp_unsubscribe(appHandle2, subHandle[1]);
+        IF_ERROR("tlp_unsubscribe");
+
+        vos_threadDelay(10u * TEST35_INTERVAL);
+
+        for (i = 0u; i < TEST35_COUNT; i++)
+        {
+            TRDP_PD_INFO_T  pdInfo;
+            UINT8           buffer[16];
+            UINT32          dataSize = sizeof(buffer);
+            UINT32          expected = ((i & 1u) && (i != 1u)) ? 1u : 0u;
+
+            if (gTest35Timeouts[i] != expected)
+            {
+                fprintf(gFp, "comId %u: %u time outs, expected %u\n", TEST35_COMID + i, gTest35Timeouts[i], expected);
+                FAILED("wrong number of time outs");
+            }
+            if (i == 1u)
+            {
+                continue;
+            }
+            err = tlp_get(appHandle2, subHandle[i], &pdInfo, buffer, &dataSize);
+            if (err != ((i & 1u) ? TRDP_TIMEOUT_ERR : TRDP_NO_ERR))
+            {
+                FAILED("tlp_get reported wrong state");
+            }
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test36 PD time outs ordered by deadline, next job time
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST36_COMID     2140u
+#define TEST36_INTERVAL  100000u
+#define TEST36_TIMEOUT   5000000u
+
+static int test36 (int argc, char *argv[])
+{
+    PREPARE("PD time out heap, next job time", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle[2];
+        TRDP_TIME_T     interval;
+        TRDP_FDS_T      rfds;
+        INT32           noDesc = 0;
+        UINT8           data[16] = "Deadline";
+
+        memset(gTest35Timeouts, 0, sizeof(gTest35Timeouts));
+
+        /* A silent subscription: its time out is the next job of the session */
+        err = tlp_subscribe(appHandle2, &subHandle[0], NULL, test35PDcallBack, TEST35_COMID, 0u, 0u,
+                            VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_DEFAULT,
+                            TEST36_TIMEOUT, TRDP_TO_SET_TO_ZERO);
+        IF_ERROR("tlp_subscribe");
+
+        FD_ZERO(&rfds);
+        err = tlc_getInterval(appHandle2, &interval, &rfds, &noDesc);
+        IF_ERROR("tlc_getInterval");
+        if ((interval.tv_sec > (INT32) (TEST36_TIMEOUT / 1000000u)) ||
+            ((interval.tv_sec == (INT32) (TEST36_TIMEOUT / 1000000u)) && (interval.tv_usec > 0)))
+        {
+            fprintf(gFp, "interval %ld.%06ld\n", (long) interval.tv_sec, (long) interval.tv_usec);
+            FAILED("PD time out not reported by tlc_getInterval");
+        }
+
+        /* A received subscription keeps its stale deadline in the heap until it is reached */
+        err = tlp_subscribe(appHandle2, &subHandle[1], NULL, test35PDcallBack, TEST35_COMID + 1u, 0u, 0u,
+                            VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_DEFAULT,
+                            TEST36_INTERVAL * 3u, TRDP_TO_SET_TO_ZERO);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, TEST35_COMID + 1u, 0u, 0u, 0u,
+                          gSession2.ifaceIP, TEST36_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(10u * TEST36_INTERVAL);
+        if (gTest35Timeouts[1] != 0u)
+        {
+            FAILED("received subscription timed out");
+        }
+
+        /* Stop sending, the time out is reported once */
+        err = tlp_unpublish(appHandle1, pubHandle);
+        IF_ERROR("tlp_unpublish");
+        vos_threadDelay(10u * TEST36_INTERVAL);
+
+        fprintf(gFp, "%u / %u time outs\n", gTest35Timeouts[0], gTest35Timeouts[1]);
+        if ((gTest35Timeouts[0] != 0u) || (gTest35Timeouts[1] != 1u))
+        {
+            FAILED("wrong number of time outs");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test37 Cyclic thread with absolute release times and overrun statistics
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST37_INTERVAL  1000u
+#define TEST37_CYCLES    200u
+#define TEST37_SLOW      10u            /* this cycle runs 3.5 intervals */
+
+static UINT32 gTest37Cycles;
+
+static void test37Cycle (void *pArg)
+{
+    (void) pArg;
+    if (++gTest37Cycles == TEST37_SLOW)
+    {
+        (void) vos_threadDelay(TEST37_INTERVAL * 7u / 2u);
+    }
+}
+
+static int test37 (int argc, char *argv[])
+{
+    PREPARE("Cyclic thread", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        VOS_THREAD_T    thread;
+        UINT32          cycles      = 0u;
+        UINT32          overruns    = 0u;
+        UINT32          maxRunTime  = 0u;
+        VOS_ERR_T       vosErr;
+
+        gTest37Cycles = 0u;
+        vosErr = vos_threadCreateAffine(&thread, "test37", VOS_THREAD_POLICY_OTHER, 0u, TEST37_INTERVAL, 0u, 1u,
+                                        test37Cycle, NULL);
+        if (vosErr != VOS_NO_ERR)
+        {
+            FAILED("vos_threadCreateAffine");
+        }
+        vos_threadDelay(TEST37_CYCLES * TEST37_INTERVAL);
+
+        vosErr = vos_cyclicThreadStatistics(thread, &cycles, &overruns, &maxRunTime);
+        (void) vos_threadTerminate(thread);
+        fprintf(gFp, "%u cycles, %u overruns, max. %u us\n", cycles, overruns, maxRunTime);
+        if (vosErr != VOS_NO_ERR)
+        {
+            FAILED("vos_cyclicThreadStatistics");
+        }
+
+        /* the skipped releases are not run, all others are */
+        if ((overruns < 3u) || (maxRunTime < TEST37_INTERVAL * 7u / 2u) ||
+            ((cycles + overruns) < TEST37_CYCLES * 8u / 10u) || ((cycles + overruns) > TEST37_CYCLES + 2u))
+        {
+            FAILED("wrong cycle statistics");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test38 No allocation during PD and MD traffic after tlc_setOperational with TRDP_OPTION_PREALLOCATE
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST38_PD_COMID     1000u
+#define TEST38_MD_COMID     1001u
+#define TEST38_INTERVAL     10000u
+#define TEST38_NOTIFIES     20u
+
+static UINT32 gTest38Notifies;
+
+static void  test38CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MN))
+    {
+        gTest38Notifies++;
+    }
+}
+
+static int test38 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_PREALLOCATE;
+
+    PREPARE("Preallocation, no vos_memAlloc while operational", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T  pubHandle;
+        TRDP_SUB_T  subHandle;
+        TRDP_LIS_T  listenHandle;
+        UINT32      i;
+
+        gTest38Notifies = 0u;
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST38_PD_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST38_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "Hello", 5u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL,
+                            TEST38_PD_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST38_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test38CBFunction, TRUE,
+                              TEST38_MD_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK,
+                              NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tlc_setOperational(appHandle1, TRUE);
+        IF_ERROR("tlc_setOperational");
+        err = tlc_setOperational(appHandle2, TRUE);
+        IF_ERROR("tlc_setOperational");
+
+        for (i = 0u; i < TEST38_NOTIFIES; i++)
+        {
+            err = tlm_notify(appHandle1, NULL, NULL, TEST38_MD_COMID, 0u, 0u, 0u,
+                             gSession2.ifaceIP, TRDP_FLAGS_NONE, NULL,
+                             (UINT8 *) "Hello", 5u, NULL, NULL);
+            IF_ERROR("tlm_notify");
+            vos_threadDelay(TEST38_INTERVAL);
+        }
+        vos_threadDelay(100000u);
+
+        fprintf(gFp, "%u notifications received, %u allocations while operational\n", gTest38Notifies,
+                vos_memOperationalAllocs());
+        if (gTest38Notifies != TEST38_NOTIFIES)
+        {
+            FAILED("notifications lost");
+        }
+        if (vos_memOperationalAllocs() != 0u)
+        {
+            FAILED("memory allocated while operational");
+        }
+
+        err = tlc_setOperational(appHandle1, FALSE);
+        IF_ERROR("tlc_setOperational");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test39 Redundancy groups: tlp_setRedundant switches all publishers of a group
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST39_COMID        1000u
+#define TEST39_INTERVAL     10000u
+#define TEST39_PUBS         3u              /* the last one is in group 2, the others in group 1 */
+
+static int test39 (int argc, char *argv[])
+{
+    PREPARE("Redundancy groups", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle[TEST39_PUBS + 1u];
+        TRDP_SUB_T      subHandle[TEST39_PUBS + 1u];
+        TRDP_PD_INFO_T  pdInfo;
+        UINT8           data[32];
+        UINT32          dataSize;
+        BOOL8           leader;
+        UINT32          i;
+
+        for (i = 0u; i <= TEST39_PUBS; i++)
+        {
+            err = tlp_subscribe(gSession2.appHandle, &subHandle[i], NULL, NULL, TEST39_COMID + i, 0u, 0u, 0u, 0u, 0u,
+                                TRDP_FLAGS_DEFAULT, TEST39_INTERVAL * 3, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+        }
+        for (i = 0u; i < TEST39_PUBS; i++)
+        {
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, TEST39_COMID + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, TEST39_INTERVAL, (i < TEST39_PUBS - 1u) ? 1u : 2u,
+                              TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "Hello", 5u);
+            IF_ERROR("tlp_publish");
+        }
+
+        err = tlp_setRedundant(gSession1.appHandle, 3u, FALSE);
+        if (err != TRDP_PARAM_ERR)
+        {
+            FAILED("tlp_setRedundant of an unknown group");
+        }
+
+        /* group 1 becomes follower, a publisher joining it later follows, too */
+        err = tlp_setRedundant(gSession1.appHandle, 1u, FALSE);
+        IF_ERROR("tlp_setRedundant");
+        err = tlp_publish(gSession1.appHandle, &pubHandle[TEST39_PUBS], NULL, NULL, TEST39_COMID + TEST39_PUBS, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST39_INTERVAL, 1u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "Hello", 5u);
+        IF_ERROR("tlp_publish");
+        err = tlp_getRedundant(gSession1.appHandle, 1u, &leader);
+        IF_ERROR("tlp_getRedundant");
+        if (leader != FALSE)
+        {
+            FAILED("group 1 should be follower");
+        }
+
+        vos_threadDelay(TEST39_INTERVAL * 10u);
+        for (i = 0u; i <= TEST39_PUBS; i++)
+        {
+            dataSize = sizeof(data);
+            err = tlp_get(gSession2.appHandle, subHandle[i], &pdInfo, data, &dataSize);
+            fprintf(gFp, "follower: comId %u: %d\n", TEST39_COMID + i, err);
+            if ((i == TEST39_PUBS - 1u) ? (err != TRDP_NO_ERR) : (err != TRDP_TIMEOUT_ERR))
+            {
+                FAILED("group 1 not stopped or group 2 stopped");
+            }
+        }
+
+        /* all groups become leader */
+        err = tlp_setRedundant(gSession1.appHandle, 0u, TRUE);
+        IF_ERROR("tlp_setRedundant");
+
+        vos_threadDelay(TEST39_INTERVAL * 10u);
+        for (i = 0u; i <= TEST39_PUBS; i++)
+        {
+            dataSize = sizeof(data);
+            err = tlp_get(gSession2.appHandle, subHandle[i], &pdInfo, data, &dataSize);
+            fprintf(gFp, "leader: comId %u: %d\n", TEST39_COMID + i, err);
+            if (err != TRDP_NO_ERR)
+            {
+                FAILED("group 1 not sent again");
+            }
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test40 Paged and filtered subscription / publisher statistics
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST40_COMID        1000u
+#define TEST40_NUM          10u
+#define TEST40_PAGE         3u
+
+static int test40 (int argc, char *argv[])
+{
+    PREPARE("Paged subscription and publisher statistics", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T              pubHandle;
+        TRDP_SUB_T              subHandle;
+        TRDP_STATISTICS_T       stats;
+        TRDP_SUBS_STATISTICS_T  subsStats[TEST40_PAGE];
+        TRDP_PUB_STATISTICS_T   pubStats[TEST40_PAGE];
+        UINT16                  num;
+        UINT16                  start;
+        UINT32                  i;
+
+        /* one more subscription of the first comId, filtered by another source */
+        for (i = 0u; i <= TEST40_NUM; i++)
+        {
+            err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST40_COMID + i % TEST40_NUM, 0u, 0u,
+                                (i < TEST40_NUM) ? gSession1.ifaceIP : gSession2.ifaceIP, 0u, 0u,
+                                TRDP_FLAGS_DEFAULT, 100000u, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+        }
+        for (i = 0u; i < TEST40_NUM; i++)
+        {
+            err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST40_COMID + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, 100000u, 0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "Hello", 5u);
+            IF_ERROR("tlp_publish");
+        }
+
+        /* page through all subscriptions */
+        start = 0u;
+        do
+        {
+            num = TEST40_PAGE;
+            err = tlc_getSubsStatisticsPage(gSession2.appHandle, start, 0u, &num, subsStats);
+            start += num;
+        }
+        while (err == TRDP_MEM_ERR);
+        IF_ERROR("tlc_getSubsStatisticsPage");
+        err = tlc_getStatistics(gSession2.appHandle, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "subscriptions: %u paged, %u counted\n", start, stats.pd.numSubs);
+        if ((start != stats.pd.numSubs) || (start < TEST40_NUM + 1u))
+        {
+            FAILED("subscription pages incomplete");
+        }
+
+        /* filtered by comId */
+        num = TEST40_PAGE;
+        err = tlc_getSubsStatisticsPage(gSession2.appHandle, 0u, TEST40_COMID, &num, subsStats);
+        IF_ERROR("tlc_getSubsStatisticsPage");
+        if ((num != 2u) || (subsStats[0].comId != TEST40_COMID) || (subsStats[1].filterAddr != gSession2.ifaceIP))
+        {
+            FAILED("subscriptions of one comId");
+        }
+
+        /* page through all publishers */
+        start = 0u;
+        do
+        {
+            num = TEST40_PAGE;
+            err = tlc_getPubStatisticsPage(gSession1.appHandle, start, 0u, &num, pubStats);
+            start += num;
+        }
+        while (err == TRDP_MEM_ERR);
+        IF_ERROR("tlc_getPubStatisticsPage");
+        err = tlc_getStatistics(gSession1.appHandle, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "publishers: %u paged, %u counted\n", start, stats.pd.numPub);
+        if ((start != stats.pd.numPub) || (start < TEST40_NUM))
+        {
+            FAILED("publisher pages incomplete");
+        }
+
+        num = TEST40_PAGE;
+        err = tlc_getPubStatisticsPage(gSession1.appHandle, 0u, TEST40_COMID + TEST40_NUM - 1u, &num, pubStats);
+        IF_ERROR("tlc_getPubStatisticsPage");
+        if ((num != 1u) || (pubStats[0].comId != TEST40_COMID + TEST40_NUM - 1u))
+        {
+            FAILED("publishers of one comId");
+        }
+
+        /* the number of publishers survives a reset of the statistics, unpublishing counts down */
+        err = tlc_resetStatistics(gSession1.appHandle);
+        IF_ERROR("tlc_resetStatistics");
+        err = tlp_unpublish(gSession1.appHandle, pubHandle);
+        IF_ERROR("tlp_unpublish");
+        err = tlc_getStatistics(gSession1.appHandle, &stats);
+        IF_ERROR("tlc_getStatistics");
+        if (stats.pd.numPub != start - 1u)
+        {
+            FAILED("numPub after reset and unpublish");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test41 Statistics counted by the PD receive thread and the sending thread
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST41_COMID        1000u
+#define TEST41_INTERVAL     10000u
+
+static int test41 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_PD_THREAD;
+
+    PREPARE("Statistics of the receive thread", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_STATISTICS_T   stats1;
+        TRDP_STATISTICS_T   stats2;
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST41_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST41_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST41_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST41_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "Hello", 5u);
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(TEST41_INTERVAL * 50u);
+
+        err = tlc_getStatistics(gSession1.appHandle, &stats1);
+        IF_ERROR("tlc_getStatistics");
+        err = tlc_getStatistics(gSession2.appHandle, &stats2);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "sent: %u, received: %u\n", stats1.pd.numSend, stats2.pd.numRcv);
+        if ((stats1.pd.numSend < 10u) || (stats2.pd.numRcv < 10u) || (stats2.pd.numRcv > stats1.pd.numSend + 2u))
+        {
+            FAILED("send and receive counters");
+        }
+
+        /* the counters of all threads are cleared */
+        err = tlc_resetStatistics(gSession2.appHandle);
+        IF_ERROR("tlc_resetStatistics");
+        err = tlc_getStatistics(gSession2.appHandle, &stats1);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "received after reset: %u\n", stats1.pd.numRcv);
+        if ((stats1.pd.numRcv >= stats2.pd.numRcv) || (stats1.pd.numSubs != stats2.pd.numSubs))
+        {
+            FAILED("tlc_resetStatistics");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test42 Statistics export to shared memory, read as OpenMetrics text
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST42_COMID        1000u
+#define TEST42_INTERVAL     10000u
+#define TEST42_EXPORT       "/trdp-api-test42"
+
+static int test42 (int argc, char *argv[])
+{
+    PREPARE("Statistics export", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T  pubHandle;
+        TRDP_SUB_T  subHandle;
+        static CHAR8 text[64000];
+        UINT32      size;
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST42_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST42_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST42_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST42_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "Hello", 5u);
+        IF_ERROR("tlp_publish");
+
+        err = tlc_exportStatistics(gSession1.appHandle, TEST42_EXPORT, 10u);
+        IF_ERROR("tlc_exportStatistics");
+
+        vos_threadDelay(TEST42_INTERVAL * 20u);
+
+        size = sizeof(text);
+        err = tlc_getExportedMetrics(TEST42_EXPORT, text, &size);
+        IF_ERROR("tlc_getExportedMetrics");
+        fprintf(gFp, "%u bytes of metrics\n", size);
+        if ((strstr(text, "# TYPE trdp_pd_sent counter\n") == NULL) ||
+            (strstr(text, "trdp_pd_pub_sent_total{ip=") == NULL) ||
+            (strstr(text, "comid=\"1000\"") == NULL) ||
+            (strcmp(text + size - 6u, "# EOF\n") != 0))
+        {
+            fprintf(gFp, "%s", text);
+            FAILED("metrics text");
+        }
+
+        size = 100u;
+        err = tlc_getExportedMetrics(TEST42_EXPORT, text, &size);
+        if ((err != TRDP_MEM_ERR) || (size < 100u))
+        {
+            FAILED("metrics into a small buffer");
+        }
+
+        err = tlc_exportStatistics(gSession1.appHandle, NULL, 0u);
+        IF_ERROR("tlc_exportStatistics");
+        size = sizeof(text);
+        err = tlc_getExportedMetrics(TEST42_EXPORT, text, &size);
+        if (err != TRDP_NOINIT_ERR)
+        {
+            FAILED("export not removed");
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test43 Log output: formatting of vos_printLog(), rate limiting of repeated errors with deferred logging
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST43_REPEAT       50u
+
+static UINT32   gTest43Count;
+static CHAR8    gTest43Text[VOS_MAX_PRNT_STR_SIZE];
+
+static void test43Out (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      lineNumber,
+    const CHAR8 *pMsgStr)
+{
+    if (strncmp(pMsgStr, "test43", 6u) == 0)
+    {
+        gTest43Count++;
+        vos_strncpy(gTest43Text, pMsgStr, sizeof(gTest43Text) - 1u);
+    }
+}
+
+static int test43 (int argc, char *argv[])
+{
+    PREPARE("Log output", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        VOS_PRINT_DBG_T pPrevOut = gPDebugFunction;
+        CHAR8           expected[VOS_MAX_PRNT_STR_SIZE];
+        CHAR8           name[16] = "comId";
+        UINT32          i;
+        UINT32          maxCount;
+
+        vos_logFlush();
+        gPDebugFunction = test43Out;
+        gTest43Count    = 0u;
+
+        vos_printLog(VOS_LOG_USR, "test43 %s=%-6u|%*d|%5.2f|%lld|%x|%c|%%\n",
+                     name, 1000u, 4, -7, 3.14159, -123456789012LL, 0xBEEFu, 'T');
+        (void) vos_snprintf(expected, sizeof(expected), "test43 %s=%-6u|%*d|%5.2f|%lld|%x|%c|%%\n",
+                            name, 1000u, 4, -7, 3.14159, -123456789012LL, 0xBEEFu, 'T');
+        /* the argument may change after the call */
+        strcpy(name, "xxx");
+        vos_logFlush();
+        if ((gTest43Count != 1u) || (strcmp(gTest43Text, expected) != 0))
+        {
+            gPDebugFunction = pPrevOut;
+            fprintf(gFp, "got: %s", gTest43Text);
+            FAILED("vos_printLog formatting");
+        }
+
+        gTest43Count = 0u;
+        for (i = 0u; i < TEST43_REPEAT; i++)
+        {
+            vos_printLog(VOS_LOG_ERROR, "test43 repeated error %u\n", i);
+        }
+        vos_logFlush();
+        gPDebugFunction = pPrevOut;
+#if VOS_LOG_DEFERRED
+        /* the repetitions may fall into two periods */
+        maxCount = 2u * VOS_LOG_RATE_BURST;
+#else
+        maxCount = TEST43_REPEAT;
+#endif
+        fprintf(gFp, "%u of %u repeated errors logged\n", gTest43Count, TEST43_REPEAT);
+        if ((gTest43Count == 0u) || (gTest43Count > maxCount))
+        {
+            FAILED("rate limiting");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test44 SDT: validation of vital data, channel monitoring and time supervision
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST44_COMID        1000u
+#define TEST44_INTERVAL     10000u
+#define TEST44_SMI          0x12345678u
+#define TEST44_UDV          0x0102u
+#define TEST44_VDP_SIZE     32u
+
+/* SID of consist local data, see IEC 61375-2-3 B.9 */
+static UINT32 test44Sid (UINT32 smi)
+{
+    UINT8 buf[28];
+
+    memset(buf, 0, sizeof(buf));
+    buf[0]  = (UINT8) (smi >> 24);
+    buf[1]  = (UINT8) (smi >> 16);
+    buf[2]  = (UINT8) (smi >> 8);
+    buf[3]  = (UINT8) smi;
+    buf[7]  = 2u;                   /* SDT version */
+    return vos_sc32(0xFFFFFFFFu, buf, sizeof(buf));
+}
+
+/* vital data with trailer: user data version, safe sequence counter, safety code */
+static void test44Vdp (UINT8 *pVdp, UINT32 sid, UINT16 udv, UINT32 ssc)
+{
+    UINT32 sc;
+
+    memset(pVdp, 0, TEST44_VDP_SIZE);
+    memset(pVdp, (int) (ssc & 0xFFu), TEST44_VDP_SIZE - 16u);
+    pVdp[TEST44_VDP_SIZE - 10u] = (UINT8) (udv >> 8);
+    pVdp[TEST44_VDP_SIZE - 9u]  = (UINT8) udv;
+    pVdp[TEST44_VDP_SIZE - 8u]  = (UINT8) (ssc >> 24);
+    pVdp[TEST44_VDP_SIZE - 7u]  = (UINT8) (ssc >> 16);
+    pVdp[TEST44_VDP_SIZE - 6u]  = (UINT8) (ssc >> 8);
+    pVdp[TEST44_VDP_SIZE - 5u]  = (UINT8) ssc;
+    sc = vos_sc32(sid, pVdp, TEST44_VDP_SIZE - 4u);
+    pVdp[TEST44_VDP_SIZE - 4u]  = (UINT8) (sc >> 24);
+    pVdp[TEST44_VDP_SIZE - 3u]  = (UINT8) (sc >> 16);
+    pVdp[TEST44_VDP_SIZE - 2u]  = (UINT8) (sc >> 8);
+    pVdp[TEST44_VDP_SIZE - 1u]  = (UINT8) sc;
+}
+
+static int test44 (int argc, char *argv[])
+{
+    PREPARE("SDT validation", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_SDT_PAR_T      sdtPar;
+        TRDP_SDT_STATUS_T   status;
+        TRDP_UUID_T         cstUUID;
+        UINT8               vdp[TEST44_VDP_SIZE];
+        UINT8               data[TEST44_VDP_SIZE];
+        UINT32              dataSize;
+        UINT32              sid = test44Sid(TEST44_SMI);
+        UINT32              ssc = 1u;
+        UINT32              i;
+
+        memset(&sdtPar, 0, sizeof(sdtPar));
+        sdtPar.smi1     = TEST44_SMI;
+        sdtPar.udv      = TEST44_UDV;
+        sdtPar.rxPeriod = 20u;
+        sdtPar.txPeriod = 10u;
+        sdtPar.nrxSafe  = 5u;
+        sdtPar.nGuard   = 50u;
+        sdtPar.cmThr    = 3u;
+        memset(cstUUID, 0, sizeof(cstUUID));
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST44_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST44_INTERVAL * 100u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_setSdt(gSession2.appHandle, subHandle, &sdtPar, cstUUID, 0u);
+        IF_ERROR("tlp_setSdt");
+        test44Vdp(vdp, sid, TEST44_UDV, ssc);
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST44_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST44_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, vdp, sizeof(vdp));
+        IF_ERROR("tlp_publish");
+
+        /* valid vital data, the SSC counts each source cycle */
+        for (i = 0u; i < 20u; i++)
+        {
+            test44Vdp(vdp, sid, TEST44_UDV, ++ssc);
+            err = tlp_put(gSession1.appHandle, pubHandle, vdp, sizeof(vdp));
+            IF_ERROR("tlp_put");
+            vos_threadDelay(TEST44_INTERVAL);
+        }
+        err = tlp_getSdtStatus(gSession2.appHandle, subHandle, &status);
+        IF_ERROR("tlp_getSdtStatus");
+        fprintf(gFp, "state %u, SSC %u, valid %u, errors %u/%u/%u/%u\n", status.state, status.lastSsc,
+                status.numValid, status.numScErr, status.numUdvErr, status.numSscErr, status.numLatencyErr);
+        if ((status.state != TRDP_SDT_VALID) || (status.lastSsc + 3u < ssc) ||
+            (status.numScErr != 0u) || (status.numUdvErr != 0u) || (status.numSscErr != 0u))
+        {
+            FAILED("valid vital data");
+        }
+        dataSize = sizeof(data);
+        err = tlp_get(gSession2.appHandle, subHandle, NULL, data, &dataSize);
+        IF_ERROR("tlp_get");
+
+        /* wrong user data version and safety code: the last valid data is kept, the channel fails */
+        test44Vdp(vdp, sid, TEST44_UDV + 1u, ++ssc);
+        err = tlp_put(gSession1.appHandle, pubHandle, vdp, sizeof(vdp));
+        IF_ERROR("tlp_put");
+        vos_threadDelay(TEST44_INTERVAL * 3u);
+        for (i = 0u; i < 10u; i++)
+        {
+            test44Vdp(vdp, sid + 1u, TEST44_UDV, ++ssc);
+            err = tlp_put(gSession1.appHandle, pubHandle, vdp, sizeof(vdp));
+            IF_ERROR("tlp_put");
+            vos_threadDelay(TEST44_INTERVAL);
+        }
+        err = tlp_getSdtStatus(gSession2.appHandle, subHandle, &status);
+        IF_ERROR("tlp_getSdtStatus");
+        fprintf(gFp, "state %u, SSC %u, valid %u, errors %u/%u/%u/%u\n", status.state, status.lastSsc,
+                status.numValid, status.numScErr, status.numUdvErr, status.numSscErr, status.numLatencyErr);
+        if ((status.state != TRDP_SDT_ERROR) || (status.numUdvErr == 0u) || (status.numScErr == 0u))
+        {
+            FAILED("invalid vital data");
+        }
+        dataSize = sizeof(data);
+        err = tlp_get(gSession2.appHandle, subHandle, NULL, data, &dataSize);
+        if (err != TRDP_SAFETY_ERR)
+        {
+            FAILED("tlp_get of a failed channel");
+        }
+
+        /* the failure is latched until the channel is reset */
+        for (i = 0u; i < 5u; i++)
+        {
+            test44Vdp(vdp, sid, TEST44_UDV, ++ssc);
+            err = tlp_put(gSession1.appHandle, pubHandle, vdp, sizeof(vdp));
+            IF_ERROR("tlp_put");
+            vos_threadDelay(TEST44_INTERVAL);
+        }
+        err = tlp_getSdtStatus(gSession2.appHandle, subHandle, &status);
+        IF_ERROR("tlp_getSdtStatus");
+        if (status.state != TRDP_SDT_ERROR)
+        {
+            FAILED("channel failure not latched");
+        }
+        err = tlp_setSdt(gSession2.appHandle, subHandle, &sdtPar, cstUUID, 0u);
+        IF_ERROR("tlp_setSdt");
+        for (i = 0u; i < 5u; i++)
+        {
+            test44Vdp(vdp, sid, TEST44_UDV, ++ssc);
+            err = tlp_put(gSession1.appHandle, pubHandle, vdp, sizeof(vdp));
+            IF_ERROR("tlp_put");
+            vos_threadDelay(TEST44_INTERVAL);
+        }
+        dataSize = sizeof(data);
+        err = tlp_get(gSession2.appHandle, subHandle, NULL, data, &dataSize);
+        IF_ERROR("tlp_get after reset");
+
+        /* time supervision: the source stops updating, the repeated SSC is not fresh */
+        vos_threadDelay(TEST44_INTERVAL * 15u);
+        err = tlp_getSdtStatus(gSession2.appHandle, subHandle, &status);
+        IF_ERROR("tlp_getSdtStatus");
+        fprintf(gFp, "state %u, time outs %u\n", status.state, status.numTimeout);
+        if ((status.state != TRDP_SDT_TIMEOUT) || (status.numTimeout == 0u))
+        {
+            FAILED("time supervision");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test45 Publishers and subscriptions follow a change of the topocounts (TRDP_OPTION_TOPO_FOLLOW)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST45_COMID        1000u
+#define TEST45_INTERVAL     10000u
+#define TEST45_DATA         "Hello World!"
+
+static int test45 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_TOPO_FOLLOW;
+
+    PREPARE("Topocount change without republish", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        TRDP_PD_INFO_T  pdInfo;
+        UINT8           data[32];
+        UINT32          dataSize;
+
+        err = tlc_setTopoCounts(gSession1.appHandle, 1u, 1u);
+        IF_ERROR("tlc_setTopoCounts");
+        err = tlc_setTopoCounts(gSession2.appHandle, 1u, 1u);
+        IF_ERROR("tlc_setTopoCounts");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST45_COMID, 1u, 1u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST45_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST45_COMID, 1u, 1u,
+                          0u, gSession2.ifaceIP, TEST45_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) TEST45_DATA, sizeof(TEST45_DATA));
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(TEST45_INTERVAL * 10u);
+        dataSize = sizeof(data);
+        err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, data, &dataSize);
+        IF_ERROR("tlp_get");
+
+        /* new inauguration: both sides follow, the telegram keeps flowing with the new counters */
+        err = tlc_setTopoCounts(gSession1.appHandle, 2u, 3u);
+        IF_ERROR("tlc_setTopoCounts");
+        err = tlc_setETBTopoCount(gSession2.appHandle, 2u);
+        IF_ERROR("tlc_setETBTopoCount");
+        err = tlc_setOpTrainTopoCount(gSession2.appHandle, 3u);
+        IF_ERROR("tlc_setOpTrainTopoCount");
+
+        vos_threadDelay(TEST45_INTERVAL * 10u);
+        dataSize = sizeof(data);
+        err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, data, &dataSize);
+        IF_ERROR("tlp_get after topocount change");
+        fprintf(gFp, "received comId %u with topocounts %u/%u\n", pdInfo.comId, pdInfo.etbTopoCnt,
+                pdInfo.opTrnTopoCnt);
+        if ((pdInfo.etbTopoCnt != 2u) || (pdInfo.opTrnTopoCnt != 3u))
+        {
+            FAILED("topocounts not followed");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test46 Update several publishers at once with tlp_putMulti
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST46_COMID        1000u
+#define TEST46_INTERVAL     10000u
+#define TEST46_NUM          3u
+
+static int test46 (int argc, char *argv[])
+{
+    PREPARE("tlp_putMulti", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle[TEST46_NUM];
+        TRDP_SUB_T      subHandle[TEST46_NUM];
+        TRDP_PUT_ITEM_T items[TEST46_NUM + 1u];
+        CHAR8           data[TEST46_NUM][16];
+        CHAR8           rcvData[16];
+        UINT32          dataSize;
+        UINT32          i;
+
+        for (i = 0u; i < TEST46_NUM; i++)
+        {
+            err = tlp_subscribe(gSession2.appHandle, &subHandle[i], NULL, NULL, TEST46_COMID + i, 0u, 0u,
+                                0u, 0u, 0u, TRDP_FLAGS_DEFAULT, TEST46_INTERVAL * 10u, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, TEST46_COMID + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, TEST46_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                              NULL, sizeof(data[i]));
+            IF_ERROR("tlp_publish");
+
+            (void) vos_snprintf(data[i], sizeof(data[i]), "Telegram %u", i);
+            items[i].pubHandle  = pubHandle[i];
+            items[i].pData      = (const UINT8 *) data[i];
+            items[i].dataSize   = sizeof(data[i]);
+        }
+        /* an invalid item does not stop the others */
+        items[TEST46_NUM].pubHandle = NULL;
+        items[TEST46_NUM].pData     = NULL;
+        items[TEST46_NUM].dataSize  = 0u;
+
+        err = tlp_putMulti(gSession1.appHandle, items, TEST46_NUM + 1u);
+        if ((err != TRDP_PARAM_ERR) || (items[TEST46_NUM].result != TRDP_PARAM_ERR))
+        {
+            FAILED("tlp_putMulti with invalid item");
+        }
+
+        vos_threadDelay(TEST46_INTERVAL * 10u);
+
+        for (i = 0u; i < TEST46_NUM; i++)
+        {
+            if (items[i].result != TRDP_NO_ERR)
+            {
+                FAILED("tlp_putMulti item result");
+            }
+            dataSize = sizeof(rcvData);
+            err = tlp_get(gSession2.appHandle, subHandle[i], NULL, (UINT8 *) rcvData, &dataSize);
+            IF_ERROR("tlp_get");
+            if (strcmp(rcvData, data[i]) != 0)
+            {
+                FAILED("wrong data received");
+            }
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test47 Read several subscriptions at once with tlp_getMulti
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST47_COMID        1000u
+#define TEST47_INTERVAL     10000u
+#define TEST47_NUM          3u
+
+static int test47 (int argc, char *argv[])
+{
+    PREPARE("tlp_getMulti", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle[TEST47_NUM];
+        TRDP_SUB_T      subHandle[TEST47_NUM];
+        TRDP_GET_ITEM_T items[TEST47_NUM + 1u];
+        CHAR8           data[TEST47_NUM][16];
+        CHAR8           rcvData[TEST47_NUM][16];
+        UINT32          i;
+
+        for (i = 0u; i < TEST47_NUM; i++)
+        {
+            (void) vos_snprintf(data[i], sizeof(data[i]), "Telegram %u", i);
+            err = tlp_subscribe(gSession2.appHandle, &subHandle[i], NULL, NULL, TEST47_COMID + i, 0u, 0u,
+                                0u, 0u, 0u, TRDP_FLAGS_DEFAULT, TEST47_INTERVAL * 10u, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, TEST47_COMID + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, TEST47_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                              (UINT8 *) data[i], sizeof(data[i]));
+            IF_ERROR("tlp_publish");
+
+            items[i].subHandle  = subHandle[i];
+            items[i].pData      = (UINT8 *) rcvData[i];
+            items[i].dataSize   = sizeof(rcvData[i]);
+        }
+        /* an invalid item does not stop the others */
+        items[TEST47_NUM].subHandle = NULL;
+        items[TEST47_NUM].pData     = NULL;
+        items[TEST47_NUM].dataSize  = 0u;
+
+        vos_threadDelay(TEST47_INTERVAL * 10u);
+
+        err = tlp_getMulti(gSession2.appHandle, items, TEST47_NUM + 1u);
+        if ((err != TRDP_PARAM_ERR) || (items[TEST47_NUM].result != TRDP_PARAM_ERR))
+        {
+            FAILED("tlp_getMulti with invalid item");
+        }
+        for (i = 0u; i < TEST47_NUM; i++)
+        {
+            fprintf(gFp, "item %u: result %d, comId %u, seq %u, size %u\n", i, items[i].result,
+                    items[i].pdInfo.comId, items[i].pdInfo.seqCount, items[i].dataSize);
+            if ((items[i].result != TRDP_NO_ERR) ||
+                (items[i].pdInfo.comId != TEST47_COMID + i) ||
+                (items[i].dataSize != sizeof(data[i])) ||
+                (strcmp(rcvData[i], data[i]) != 0))
+            {
+                FAILED("tlp_getMulti item");
+            }
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test48 Publish on change with heartbeat (TRDP_FLAGS_PD_ON_CHANGE)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST48_COMID        1000u
+#define TEST48_INTERVAL     10000u
+#define TEST48_HEARTBEAT    100000u
+
+static int test48 (int argc, char *argv[])
+{
+    PREPARE("Publish on change with heartbeat", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        TRDP_PD_INFO_T  pdInfo;
+        CHAR8           data[16] = "Unchanged";
+        CHAR8           rcvData[16];
+        UINT32          dataSize;
+        UINT32          seqCount;
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST48_COMID, 0u, 0u,
+                            0u, 0u, 0u, TRDP_FLAGS_DEFAULT, TEST48_HEARTBEAT * 3u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST48_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST48_INTERVAL, 0u, TRDP_FLAGS_PD_ON_CHANGE, NULL,
+                          (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_publish");
+        err = tlp_setHeartbeat(gSession1.appHandle, pubHandle, TEST48_HEARTBEAT);
+        IF_ERROR("tlp_setHeartbeat");
+
+        vos_threadDelay(TEST48_INTERVAL * 5u);
+        dataSize = sizeof(rcvData);
+        err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, (UINT8 *) rcvData, &dataSize);
+        IF_ERROR("tlp_get");
+        seqCount = pdInfo.seqCount;
+
+        /* putting the same data again must not be sent, only the heartbeat is */
+        err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_put");
+        vos_threadDelay(TEST48_HEARTBEAT * 5u);
+        dataSize = sizeof(rcvData);
+        err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, (UINT8 *) rcvData, &dataSize);
+        IF_ERROR("tlp_get unchanged");
+        fprintf(gFp, "unchanged data: seq %u -> %u\n", seqCount, pdInfo.seqCount);
+        if (((pdInfo.seqCount - seqCount) < 3u) || ((pdInfo.seqCount - seqCount) > 8u))
+        {
+            FAILED("unchanged data not sent as heartbeat");
+        }
+
+        /* changed data is sent with the next interval */
+        vos_strncpy(data, "Changed", sizeof(data) - 1u);
+        err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_put changed");
+        vos_threadDelay(TEST48_INTERVAL * 3u);
+        dataSize = sizeof(rcvData);
+        err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, (UINT8 *) rcvData, &dataSize);
+        IF_ERROR("tlp_get changed");
+        if (strcmp(rcvData, data) != 0)
+        {
+            FAILED("changed data not received");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test49 Delta encoded PD (tlp_setDeltaRange)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST49_COMID        1000u
+#define TEST49_INTERVAL     10000u
+#define TEST49_KEY_CYCLES   4u
+#define TEST49_SIZE         1000u
+
+static int test49 (int argc, char *argv[])
+{
+    PREPARE("Delta encoded PD", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        TRDP_PD_INFO_T  pdInfo;
+        static UINT8    data[TEST49_SIZE];
+        static UINT8    rcvData[TEST49_SIZE];
+        UINT32          dataSize;
+        UINT32          i;
+
+        for (i = 0u; i < TEST49_SIZE; i++)
+        {
+            data[i] = (UINT8) i;
+        }
+        err = tlp_setDeltaRange(gSession1.appHandle, TEST49_COMID, TEST49_COMID, TEST49_KEY_CYCLES);
+        IF_ERROR("tlp_setDeltaRange");
+        err = tlp_setDeltaRange(gSession2.appHandle, TEST49_COMID, TEST49_COMID, TEST49_KEY_CYCLES);
+        IF_ERROR("tlp_setDeltaRange");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST49_COMID, 0u, 0u,
+                            0u, 0u, 0u, TRDP_FLAGS_DEFAULT, TEST49_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST49_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST49_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        /* change a few bytes per update, spanning several key frames */
+        for (i = 0u; i < 3u * TEST49_KEY_CYCLES; i++)
+        {
+            data[(i * 97u) % TEST49_SIZE]++;
+            data[TEST49_SIZE - 1u - i] = (UINT8) i;
+            err = tlp_put(gSession1.appHandle, pubHandle, data, sizeof(data));
+            IF_ERROR("tlp_put");
+            vos_threadDelay(TEST49_INTERVAL * 3u);
+
+            dataSize = sizeof(rcvData);
+            err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, rcvData, &dataSize);
+            IF_ERROR("tlp_get");
+            if ((dataSize != sizeof(data)) || (memcmp(rcvData, data, sizeof(data)) != 0))
+            {
+                fprintf(gFp, "update %u: received %u bytes (seq %u)\n", i, dataSize, pdInfo.seqCount);
+                FAILED("delta encoded data not received");
+            }
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test50 Source IP ranges of subscriptions (source table)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST50_COMID        1000u
+#define TEST50_INTERVAL     10000u
+
+static int test50 (int argc, char *argv[])
+{
+    PREPARE("Source IP ranges of subscriptions", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle1;
+        TRDP_SUB_T      subHandle2;
+        TRDP_PD_INFO_T  pdInfo;
+        CHAR8           data[16] = "Range";
+        CHAR8           rcvData[16];
+        UINT32          dataSize;
+        UINT32          seqCount;
+        TRDP_IP_ADDR_T  srcIp = gSession1.ifaceIP;
+
+        /* the first subscription does not cover the publisher, the second one does */
+        err = tlp_subscribe(gSession2.appHandle, &subHandle1, NULL, NULL, TEST50_COMID, 0u, 0u,
+                            srcIp + 4u, srcIp + 8u, 0u, TRDP_FLAGS_DEFAULT, TEST50_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe 1");
+        err = tlp_subscribe(gSession2.appHandle, &subHandle2, NULL, NULL, TEST50_COMID, 0u, 0u,
+                            srcIp, srcIp + 2u, 0u, TRDP_FLAGS_DEFAULT, TEST50_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe 2");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST50_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST50_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(TEST50_INTERVAL * 5u);
+        dataSize = sizeof(rcvData);
+        err = tlp_get(gSession2.appHandle, subHandle2, &pdInfo, (UINT8 *) rcvData, &dataSize);
+        IF_ERROR("tlp_get 2");
+        dataSize = sizeof(rcvData);
+        if (tlp_get(gSession2.appHandle, subHandle1, &pdInfo, (UINT8 *) rcvData, &dataSize) == TRDP_NO_ERR)
+        {
+            FAILED("received outside of the source range");
+        }
+
+        /* widened to the publisher, the first subscription in the queue gets the data */
+        err = tlp_resubscribe(gSession2.appHandle, subHandle1, 0u, 0u, srcIp, srcIp + 8u, 0u);
+        IF_ERROR("tlp_resubscribe");
+        vos_threadDelay(TEST50_INTERVAL * 5u);
+        dataSize = sizeof(rcvData);
+        err = tlp_get(gSession2.appHandle, subHandle1, &pdInfo, (UINT8 *) rcvData, &dataSize);
+        IF_ERROR("tlp_get 1");
+        dataSize = sizeof(rcvData);
+        err = tlp_get(gSession2.appHandle, subHandle2, &pdInfo, (UINT8 *) rcvData, &dataSize);
+        IF_ERROR("tlp_get 2");
+        seqCount = pdInfo.seqCount;
+
+        /* without the first subscription the second one gets the data again */
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle1);
+        IF_ERROR("tlp_unsubscribe");
+        vos_threadDelay(TEST50_INTERVAL * 5u);
+        dataSize = sizeof(rcvData);
+        err = tlp_get(gSession2.appHandle, subHandle2, &pdInfo, (UINT8 *) rcvData, &dataSize);
+        IF_ERROR("tlp_get 2");
+        fprintf(gFp, "second subscription: seq %u -> %u\n", seqCount, pdInfo.seqCount);
+        if ((pdInfo.seqCount == seqCount) || (strcmp(rcvData, data) != 0))
+        {
+            FAILED("data not received after unsubscribe");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test51 Consumers of one subscription (tlp_addConsumer)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST51_COMID        1000u
+#define TEST51_INTERVAL     10000u
+
+static UINT32 gTest51Count[3];
+
+static void test51PDcallBack (
+                   void                    *pRefCon,
+                   TRDP_APP_SESSION_T      appHandle,
+                   const TRDP_PD_INFO_T    *pMsg,
+                   UINT8                   *pData,
+                   UINT32                  dataSize)
+{
+    UINT32 *pCount = (UINT32 *) pMsg->pUserRef;
+
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pCount != NULL) && (dataSize == 16u) &&
+        (strcmp((const char *) pData, "Fan-out") == 0))
+    {
+        (*pCount)++;
+    }
+}
+
+static int test51 (int argc, char *argv[])
+{
+    PREPARE("Consumers of one subscription", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        CHAR8           data[16] = "Fan-out";
+        UINT32          count[3];
+
+        memset(gTest51Count, 0, sizeof(gTest51Count));
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, &gTest51Count[0], test51PDcallBack, TEST51_COMID,
+                            0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                            TEST51_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_addConsumer(gSession2.appHandle, subHandle, &gTest51Count[1], test51PDcallBack);
+        IF_ERROR("tlp_addConsumer 1");
+        err = tlp_addConsumer(gSession2.appHandle, subHandle, &gTest51Count[2], test51PDcallBack);
+        IF_ERROR("tlp_addConsumer 2");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST51_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST51_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(TEST51_INTERVAL * 10u);
+        memcpy(count, gTest51Count, sizeof(count));
+        fprintf(gFp, "callbacks: %u %u %u\n", count[0], count[1], count[2]);
+        if ((count[0] == 0u) || (count[1] < count[0] - 1u) || (count[2] < count[0] - 1u))
+        {
+            FAILED("consumers not called with the subscription");
+        }
+
+        /* a removed consumer is not called anymore */
+        err = tlp_delConsumer(gSession2.appHandle, subHandle, &gTest51Count[1], test51PDcallBack);
+        IF_ERROR("tlp_delConsumer");
+        if (tlp_delConsumer(gSession2.appHandle, subHandle, &gTest51Count[1], test51PDcallBack) != TRDP_PARAM_ERR)
+        {
+            FAILED("consumer removed twice");
+        }
+        vos_threadDelay(TEST51_INTERVAL * 2u);
+        count[1] = gTest51Count[1];
+        count[2] = gTest51Count[2];
+        vos_threadDelay(TEST51_INTERVAL * 10u);
+        fprintf(gFp, "callbacks: %u %u %u\n", gTest51Count[0], gTest51Count[1], gTest51Count[2]);
+        if ((gTest51Count[1] != count[1]) || (gTest51Count[2] == count[2]))
+        {
+            FAILED("removed consumer called");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test52 Sending from an own thread (tlc_processSend), receiving by tlc_processReceive / tlc_processTimeouts
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST52_COMID        1000u
+#define TEST52_PULL_COMID   1001u
+#define TEST52_INTERVAL     10000u
+
+static UINT32   gTest52Count;
+
+static void test52SendLoop (void *pArg)
+{
+    while (gSplitProcess)
+    {
+        (void) tlc_processSend(gSession1.appHandle);
+        (void) tlc_processSend(gSession2.appHandle);
+        (void) vos_threadDelay(1000u);
+    }
+}
+
+static void test52PDcallBack (
+                   void                    *pRefCon,
+                   TRDP_APP_SESSION_T      appHandle,
+                   const TRDP_PD_INFO_T    *pMsg,
+                   UINT8                   *pData,
+                   UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (dataSize == 16u) && (strcmp((const char *) pData, "Split") == 0))
+    {
+        gTest52Count++;
+    }
+}
+
+static int test52 (int argc, char *argv[])
+{
+    PREPARE("Separate send and receive threads", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle, pullPubHandle;
+        TRDP_SUB_T      subHandle, pullSubHandle;
+        CHAR8           data[16] = "Split";
+        CHAR8           pulled[16];
+        UINT32          pulledSize;
+        TRDP_PD_INFO_T  pdInfo;
+        VOS_THREAD_T    sendThread;
+        int             i;
+
+        gSplitProcess   = TRUE;
+        gTest52Count    = 0u;
+        if (vos_threadCreate(&sendThread, "test52Send", VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
+                             test52SendLoop, NULL) != VOS_NO_ERR)
+        {
+            FAILED("vos_threadCreate");
+        }
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test52PDcallBack, TEST52_COMID,
+                            0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST52_INTERVAL * 10u,
+                            TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST52_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST52_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        /* a pull request is sent by the send thread, answered by the receiving session */
+        err = tlp_publish(gSession1.appHandle, &pullPubHandle, NULL, NULL, TEST52_PULL_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, 0u, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_publish pull");
+        err = tlp_subscribe(gSession2.appHandle, &pullSubHandle, NULL, NULL, TEST52_PULL_COMID,
+                            0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_DEFAULT, 0u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe pull");
+
+        for (i = 0; i < 10; i++)
+        {
+            /* data changed while the send thread runs */
+            err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data, sizeof(data));
+            IF_ERROR("tlp_put");
+            err = tlp_request(gSession2.appHandle, pullSubHandle, TEST52_PULL_COMID, 0u, 0u,
+                              gSession2.ifaceIP, gSession1.ifaceIP, 0u, TRDP_FLAGS_NONE, NULL, NULL, 0u,
+                              TEST52_PULL_COMID, gSession2.ifaceIP);
+            IF_ERROR("tlp_request");
+            vos_threadDelay(TEST52_INTERVAL * 2u);
+        }
+
+        fprintf(gFp, "%u callbacks\n", gTest52Count);
+        if (gTest52Count < 10u)
+        {
+            FAILED("cyclic PD not received");
+        }
+
+        pulledSize = sizeof(pulled);
+        err = tlp_get(gSession2.appHandle, pullSubHandle, &pdInfo, (UINT8 *) pulled, &pulledSize);
+        IF_ERROR("tlp_get pulled");
+        if ((pulledSize != sizeof(data)) || (strcmp(pulled, data) != 0))
+        {
+            FAILED("pulled data wrong");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test53 Work budget of tlc_process: one frame per call, the rest is read by the next calls
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST53_COMID        1000u
+#define TEST53_NO_TLG       8u
+#define TEST53_INTERVAL     10000u
+
+static UINT32   gTest53Count[TEST53_NO_TLG];
+
+static void test53PDcallBack (
+                   void                    *pRefCon,
+                   TRDP_APP_SESSION_T      appHandle,
+                   const TRDP_PD_INFO_T    *pMsg,
+                   UINT8                   *pData,
+                   UINT32                  dataSize)
+{
+    UINT32 *pCount = (UINT32 *) pMsg->pUserRef;
+
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pCount != NULL))
+    {
+        (*pCount)++;
+    }
+}
+
+static int test53 (int argc, char *argv[])
+{
+    gBudgetFrames = 1u;
+
+    PREPARE("Work budgeted tlc_process", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle[TEST53_NO_TLG];
+        TRDP_SUB_T      subHandle[TEST53_NO_TLG];
+        CHAR8           data[16] = "Budget";
+        UINT32          i;
+
+        memset(gTest53Count, 0, sizeof(gTest53Count));
+        for (i = 0u; i < TEST53_NO_TLG; i++)
+        {
+            err = tlp_subscribe(gSession2.appHandle, &subHandle[i], &gTest53Count[i], test53PDcallBack,
+                                TEST53_COMID + i, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                                TEST53_INTERVAL * 10u, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, TEST53_COMID + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, TEST53_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                              (UINT8 *) data, sizeof(data));
+            IF_ERROR("tlp_publish");
+        }
+
+        vos_threadDelay(TEST53_INTERVAL * 30u);
+
+        /* all frames are read although every call stops after the first one */
+        for (i = 0u; i < TEST53_NO_TLG; i++)
+        {
+            fprintf(gFp, "comId %u: %u callbacks\n", TEST53_COMID + i, gTest53Count[i]);
+            if (gTest53Count[i] < 20u)
+            {
+                FAILED("telegrams left unread");
+            }
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test54 Priority classes: due PD of a higher QoS is sent first
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST54_LOW_COMID    1000u
+#define TEST54_HIGH_COMID   1001u
+#define TEST54_INTERVAL     10000u
+
+static UINT32   gTest54Order[4];
+static UINT32   gTest54Count;
+
+static void test54PDcallBack (
+                   void                    *pRefCon,
+                   TRDP_APP_SESSION_T      appHandle,
+                   const TRDP_PD_INFO_T    *pMsg,
+                   UINT8                   *pData,
+                   UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (gTest54Count < 4u))
+    {
+        gTest54Order[gTest54Count++] = pMsg->comId;
+    }
+}
+
+static int test54 (int argc, char *argv[])
+{
+    PREPARE("PD priority classes", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubLow, pubHigh;
+        TRDP_SUB_T          subLow, subHigh;
+        TRDP_SEND_PARAM_T   lowParam    = {1u, 64u, 0u, FALSE};
+        TRDP_SEND_PARAM_T   highParam   = {6u, 64u, 0u, FALSE};
+        CHAR8               data[16]    = "Priority";
+
+        /* the loops only receive, sending is up to the test */
+        gSplitProcess   = TRUE;
+        gTest54Count    = 0u;
+
+        err = tlp_subscribe(gSession2.appHandle, &subLow, NULL, test54PDcallBack, TEST54_LOW_COMID,
+                            0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, 0u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe low");
+        err = tlp_subscribe(gSession2.appHandle, &subHigh, NULL, test54PDcallBack, TEST54_HIGH_COMID,
+                            0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, 0u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe high");
+        err = tlp_setPriority(gSession2.appHandle, subHigh, 6u);
+        IF_ERROR("tlp_setPriority");
+        if (tlp_setPriority(gSession2.appHandle, subHigh, 8u) != TRDP_PARAM_ERR)
+        {
+            FAILED("invalid priority accepted");
+        }
+
+        /* the low priority telegram is due first */
+        err = tlp_publish(gSession1.appHandle, &pubLow, NULL, NULL, TEST54_LOW_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST54_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, &lowParam,
+                          (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_publish low");
+        vos_threadDelay(1000u);
+        err = tlp_publish(gSession1.appHandle, &pubHigh, NULL, NULL, TEST54_HIGH_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST54_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, &highParam,
+                          (UINT8 *) data, sizeof(data));
+        IF_ERROR("tlp_publish high");
+
+        /* both are overdue, one call sends them */
+        vos_threadDelay(TEST54_INTERVAL * 2u);
+        err = tlc_processSend(gSession1.appHandle);
+        IF_ERROR("tlc_processSend");
+        vos_threadDelay(TEST54_INTERVAL * 2u);
+
+        fprintf(gFp, "%u frames, first comId %u\n", gTest54Count, gTest54Order[0]);
+        if ((gTest54Count < 2u) || (gTest54Order[0] != TEST54_HIGH_COMID))
+        {
+            FAILED("high priority telegram not sent first");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test55 UDP notifications of equal size sent and received in segments (TRDP_OPTION_MD_UDP_SEGMENT)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST55_COMID        1055u
+#define TEST55_COUNT        16u
+#define TEST55_SIZE         100u
+
+static UINT32   gTest55Received;
+static UINT32   gTest55Mask;
+
+static void test55CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT32 no;
+
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MN) && (pMsg->comId == TEST55_COMID) &&
+        (pData != NULL) && (dataSize == TEST55_SIZE) && (sscanf((char *) pData, "Segment %u", &no) == 1) &&
+        (no < TEST55_COUNT))
+    {
+        gTest55Received++;
+        gTest55Mask |= 1u << no;
+    }
+}
+
+static int test55 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_MD_UDP_SEGMENT;
+
+    PREPARE("UDP MD notifications in segments", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T  listenHandle;
+        UINT8       data[TEST55_SIZE];
+        UINT32      i;
+
+        gTest55Received = 0u;
+        gTest55Mask     = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test55CBFunction, TRUE,
+                              TEST55_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK,
+                              NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        /* queued in one go, they are sent in the same cycle */
+        for (i = 0u; i < TEST55_COUNT; i++)
+        {
+            memset(data, 0, sizeof(data));
+            (void) snprintf((char *) data, sizeof(data), "Segment %u", (unsigned int) i);
+            err = tlm_notify(appHandle1, NULL, NULL, TEST55_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                             TRDP_FLAGS_NONE, NULL, data, sizeof(data), NULL, NULL);
+            IF_ERROR("tlm_notify");
+        }
+
+        vos_threadDelay(500000u);
+
+        fprintf(gFp, "%u of %u notifications received\n", gTest55Received, TEST55_COUNT);
+        if ((gTest55Received != TEST55_COUNT) || (gTest55Mask != ((1u << TEST55_COUNT) - 1u)))
+        {
+            FAILED("notifications lost");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test56 Consistent reads of a subscription group
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST56_COMID        1000u
+#define TEST56_INTERVAL     10000u
+#define TEST56_NUM          3u
+
+static int test56 (int argc, char *argv[])
+{
+    PREPARE("tlp_createSubGroup / tlp_getSubGroup", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle[TEST56_NUM];
+        TRDP_SUB_T          subHandle[TEST56_NUM];
+        TRDP_SUB_GROUP_T    groupHandle = NULL;
+        TRDP_GET_ITEM_T     items[TEST56_NUM];
+        CHAR8               data[TEST56_NUM][16];
+        CHAR8               rcvData[TEST56_NUM][16];
+        UINT32              i;
+
+        for (i = 0u; i < TEST56_NUM; i++)
+        {
+            (void) vos_snprintf(data[i], sizeof(data[i]), "Telegram %u", i);
+            err = tlp_subscribe(gSession2.appHandle, &subHandle[i], NULL, NULL, TEST56_COMID + i, 0u, 0u,
+                                0u, 0u, 0u, TRDP_FLAGS_DEFAULT, TEST56_INTERVAL * 10u, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, TEST56_COMID + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, TEST56_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                              (UINT8 *) data[i], sizeof(data[i]));
+            IF_ERROR("tlp_publish");
+        }
+
+        err = tlp_createSubGroup(gSession2.appHandle, &groupHandle, subHandle, 0u);
+        if (err != TRDP_PARAM_ERR)
+        {
+            FAILED("tlp_createSubGroup without subscriptions");
+        }
+        err = tlp_createSubGroup(gSession2.appHandle, &groupHandle, subHandle, TEST56_NUM);
+        IF_ERROR("tlp_createSubGroup");
+
+        vos_threadDelay(TEST56_INTERVAL * 10u);
+
+        /* items in reverse order of the group members */
+        for (i = 0u; i < TEST56_NUM; i++)
+        {
+            items[i].subHandle  = subHandle[TEST56_NUM - 1u - i];
+            items[i].pData      = (UINT8 *) rcvData[i];
+            items[i].dataSize   = sizeof(rcvData[i]);
+        }
+        err = tlp_getSubGroup(gSession2.appHandle, groupHandle, items, TEST56_NUM);
+        IF_ERROR("tlp_getSubGroup");
+        for (i = 0u; i < TEST56_NUM; i++)
+        {
+            fprintf(gFp, "item %u: result %d, comId %u, seq %u, size %u\n", i, items[i].result,
+                    items[i].pdInfo.comId, items[i].pdInfo.seqCount, items[i].dataSize);
+            if ((items[i].result != TRDP_NO_ERR) ||
+                (items[i].pdInfo.comId != TEST56_COMID + TEST56_NUM - 1u - i) ||
+                (items[i].dataSize != sizeof(data[0])) ||
+                (strcmp(rcvData[i], data[TEST56_NUM - 1u - i]) != 0))
+            {
+                FAILED("tlp_getSubGroup item");
+            }
+        }
+
+        /* a member unsubscribed later is reported, the others are still delivered */
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle[0]);
+        IF_ERROR("tlp_unsubscribe");
+        vos_threadDelay(TEST56_INTERVAL * 2u);
+        for (i = 0u; i < TEST56_NUM; i++)
+        {
+            items[i].dataSize = sizeof(rcvData[i]);
+        }
+        err = tlp_getSubGroup(gSession2.appHandle, groupHandle, items, TEST56_NUM);
+        if ((err != TRDP_NOSUB_ERR) || (items[TEST56_NUM - 1u].result != TRDP_NOSUB_ERR) ||
+            (items[0].result != TRDP_NO_ERR) || (items[1].result != TRDP_NO_ERR))
+        {
+            FAILED("tlp_getSubGroup after tlp_unsubscribe");
+        }
+
+        err = tlp_deleteSubGroup(gSession2.appHandle, groupHandle);
+        IF_ERROR("tlp_deleteSubGroup");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test57 Black-box recorder, ring wrap and pcapng file
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST57_COMID        1000u
+#define TEST57_INTERVAL     10000u
+#define TEST57_DATA         1000u
+#define TEST57_RING         65536u
+#define TEST57_RECORDING    "/trdp-api-test57"
+#define TEST57_FILE         "/tmp/trdp-api-test57.pcapng"
+
+static int test57 (int argc, char *argv[])
+{
+    PREPARE("tlc_record / tlc_saveRecording", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_STATISTICS_T   stats;
+        static UINT8        data[TEST57_DATA];
+        UINT32              noRecords   = 0u;
+        UINT32              maxRecords;
+        UINT32              magic       = 0u;
+        FILE                *fp;
+
+        err = tlc_record(gSession2.appHandle, TEST57_RECORDING, TEST57_RING, 0u);
+        IF_ERROR("tlc_record");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST57_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST57_INTERVAL * 3u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST57_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST57_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, data, TEST57_DATA);
+        IF_ERROR("tlp_publish");
+
+        /* long enough to wrap the ring */
+        vos_threadDelay(TEST57_INTERVAL * 150u);
+
+        err = tlc_saveRecording(TEST57_RECORDING, TEST57_FILE, &noRecords);
+        IF_ERROR("tlc_saveRecording");
+        err = tlc_getStatistics(gSession2.appHandle, &stats);
+        IF_ERROR("tlc_getStatistics");
+
+        /* a record takes 40 bytes and the telegram, 40 bytes header and the data */
+        maxRecords = TEST57_RING / (40u + 40u + TEST57_DATA);
+        fprintf(gFp, "received: %u, saved: %u\n", stats.pd.numRcv, noRecords);
+        if ((noRecords < 10u) || (noRecords > maxRecords) ||
+            ((stats.pd.numRcv > maxRecords + 10u) && (noRecords < maxRecords - 10u)))
+        {
+            FAILED("number of records");
+        }
+
+        fp = fopen(TEST57_FILE, "rb");
+        if (fp != NULL)
+        {
+            (void) fread(&magic, sizeof(magic), 1u, fp);
+            fclose(fp);
+            (void) remove(TEST57_FILE);
+        }
+        if (magic != 0x0A0D0D0Au)
+        {
+            FAILED("pcapng section header");
+        }
+
+        err = tlc_record(gSession2.appHandle, NULL, 0u, 0u);
+        IF_ERROR("tlc_record");
+        err = tlc_saveRecording(TEST57_RECORDING, TEST57_FILE, NULL);
+        if (err != TRDP_NOINIT_ERR)
+        {
+            FAILED("recording not removed");
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test58 UDP MD request retransmitted after a reply timeout
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST58_COMID        2058u
+#define TEST58_TIMEOUT      200000u
+
+static UINT32   gTest58GotRequest   = 0u;
+static UINT32   gTest58GotReply     = 0u;
+
+static void  test58CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pMsg->comId != TEST58_COMID))
+    {
+        return;
+    }
+    if (pMsg->msgType == TRDP_MSG_MR)
+    {
+        /* the first request is lost for the caller */
+        if (gTest58GotRequest++ > 0u)
+        {
+            (void) tlm_reply(appHandle, &pMsg->sessionId, TEST58_COMID, 0u, NULL, (UINT8 *) "Reply", 6u);
+        }
+    }
+    else if (pMsg->msgType == TRDP_MSG_MP)
+    {
+        gTest58GotReply++;
+    }
+}
+
+static int test58 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_TIMING_STATS;
+
+    PREPARE("UDP MD Request retransmission", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_UUID_T                 sessionId1;
+        TRDP_LIS_T                  listenHandle;
+        TRDP_SEND_PARAM_T           sendParam = {TRDP_MD_DEFAULT_QOS, TRDP_MD_DEFAULT_TTL, 2u, FALSE};
+        TRDP_TIMING_STATISTICS_T    timing;
+        TRDP_TIMING_HIST_T          *pHist = &timing.hist[TRDP_TIMING_MD_RETRY];
+
+        gTest58GotRequest   = 0u;
+        gTest58GotReply     = 0u;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test58CBFunction,
+                              TRUE,
+                              TEST58_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tlm_request(appHandle1, NULL, test58CBFunction, &sessionId1,
+                          TEST58_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP,
+                          TRDP_FLAGS_CALLBACK, 1u, TEST58_TIMEOUT, &sendParam,
+                          (UINT8 *) "Request", 8u, NULL, NULL);
+        IF_ERROR("tlm_request");
+
+        vos_threadDelay(4u * TEST58_TIMEOUT);
+
+        err = tlc_getTimingStatistics(appHandle1, &timing);
+        IF_ERROR("tlc_getTimingStatistics");
+
+        fprintf(gFp, "requests received %u, replies received %u, retried: count %u, min %u, max %u us\n",
+                gTest58GotRequest, gTest58GotReply, pHist->count, pHist->min, pHist->max);
+        if ((gTest58GotRequest < 2u) || (gTest58GotReply != 1u))
+        {
+            FAILED("request not retransmitted");
+        }
+        if ((pHist->count != 1u) || (pHist->min < TEST58_TIMEOUT))
+        {
+            FAILED("retry latency not recorded");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test59 PD sent on two interfaces, the subscriber takes the first copy
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST59_COMID        5900u
+#define TEST59_INTERVAL     50000u
+#define TEST59_OTHER_MC     0xEF0002FEu                 /* nobody subscribed */
+#define TEST59_RED_IP       (gSession1.ifaceIP + 2u)    /* second interface, another loopback address */
+
+static UINT32   gTest59Received;
+static UINT32   gTest59Duplicates;
+static UINT32   gTest59LastSeq;
+
+static void test59PDcallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        if ((gTest59Received > 0u) && (pMsg->seqCount <= gTest59LastSeq))
+        {
+            gTest59Duplicates++;
+        }
+        gTest59LastSeq = pMsg->seqCount;
+        gTest59Received++;
+    }
+}
+
+static int test59 (int argc, char *argv[])
+{
+    PREPARE("PD redundant send on two interfaces", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T  pubHandle;
+        TRDP_SUB_T  subHandle;
+        char        data1[] = "Sent twice, received once";
+
+        gTest59Received     = 0u;
+        gTest59Duplicates   = 0u;
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST59_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST59_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) data1, sizeof(data1));
+        IF_ERROR("tlp_publish");
+        err = tlp_addSendInterface(gSession1.appHandle, pubHandle, TEST59_RED_IP, 0u);
+        IF_ERROR("tlp_addSendInterface");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test59PDcallBack,
+                            TEST59_COMID, 0u, 0u,
+                            gSession1.ifaceIP, 0u, 0u,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST59_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_addRecvInterface(gSession2.appHandle, subHandle, gSession2.ifaceIP, 0u);
+        if (err != TRDP_PARAM_ERR)
+        {
+            FAILED("tlp_addRecvInterface without source");
+        }
+        err = tlp_addRecvInterface(gSession2.appHandle, subHandle, gSession2.ifaceIP, TEST59_RED_IP);
+        IF_ERROR("tlp_addRecvInterface");
+
+        /* Both copies arrive, each sequence counter is delivered once */
+        vos_threadDelay(20u * TEST59_INTERVAL);
+        fprintf(gFp, "both interfaces: received %u, duplicates %u\n", gTest59Received, gTest59Duplicates);
+        if ((gTest59Received < 10u) || (gTest59Duplicates != 0u))
+        {
+            FAILED("duplicates not dropped");
+        }
+
+        /* Only the second interface reaches the subscriber */
+        err = tlp_addSendInterface(gSession1.appHandle, pubHandle, TEST59_RED_IP, gSession2.ifaceIP);
+        IF_ERROR("tlp_addSendInterface");
+        err = tlp_republish(gSession1.appHandle, pubHandle, 0u, 0u, 0u, TEST59_OTHER_MC);
+        IF_ERROR("tlp_republish");
+        vos_threadDelay(2u * TEST59_INTERVAL);
+        gTest59Received = 0u;
+        vos_threadDelay(20u * TEST59_INTERVAL);
+        fprintf(gFp, "second interface: received %u, duplicates %u\n", gTest59Received, gTest59Duplicates);
+        if ((gTest59Received < 10u) || (gTest59Duplicates != 0u))
+        {
+            FAILED("second interface not received");
+        }
+
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlp_unpublish(gSession1.appHandle, pubHandle);
+        IF_ERROR("tlp_unpublish");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test60 PD pull requests: replies matched by the pull index, in-flight limit, unanswered requests expire
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST60_COMID        6000u                       /* published for pulling                */
+#define TEST60_NOREPLY      6001u                       /* nobody publishes it                  */
+#define TEST60_TIMEOUT      300000u
+
+static UINT32 gTest60Received;
+
+static void test60PDcallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_PP))
+    {
+        gTest60Received++;
+    }
+}
+
+static int test60 (int argc, char *argv[])
+{
+    PREPARE("PD pull request index and in-flight limit", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T  pubHandle;
+        TRDP_SUB_T  subHandle;
+        TRDP_SUB_T  noReplyHandle;
+        UINT32      pending = 0u;
+        UINT32      expired = 0u;
+        char        data1[] = "Pulled";
+
+        gTest60Received = 0u;
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST60_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, 0u,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) data1, sizeof(data1));
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test60PDcallBack,
+                            TEST60_COMID, 0u, 0u,
+                            0u, 0u, 0u,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST60_TIMEOUT, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_subscribe(gSession2.appHandle, &noReplyHandle, NULL, test60PDcallBack,
+                            TEST60_NOREPLY, 0u, 0u,
+                            0u, 0u, 0u,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST60_TIMEOUT, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_setPullLimit(gSession2.appHandle, 2u);
+        IF_ERROR("tlp_setPullLimit");
+
+        /* An answered request leaves the index */
+        err = tlp_request(gSession2.appHandle, subHandle, TEST60_COMID, 0u, 0u, 0u, gSession1.ifaceIP,
+                          0u, TRDP_FLAGS_NONE, NULL, NULL, 0u, 0u, 0u);
+        IF_ERROR("tlp_request");
+        vos_threadDelay(100000u);
+        err = tlp_getPullStatus(gSession2.appHandle, &pending, &expired);
+        IF_ERROR("tlp_getPullStatus");
+        fprintf(gFp, "answered: received %u, pending %u, expired %u\n", gTest60Received, pending, expired);
+        if ((gTest60Received != 1u) || (pending != 0u) || (expired != 0u))
+        {
+            FAILED("reply not matched");
+        }
+
+        /* A repeated request to the same device is counted once, the third device exceeds the limit */
+        err = tlp_request(gSession2.appHandle, noReplyHandle, TEST60_NOREPLY, 0u, 0u, 0u, gSession1.ifaceIP,
+                          0u, TRDP_FLAGS_NONE, NULL, NULL, 0u, 0u, 0u);
+        IF_ERROR("tlp_request");
+        err = tlp_request(gSession2.appHandle, noReplyHandle, TEST60_NOREPLY, 0u, 0u, 0u, gSession1.ifaceIP,
+                          0u, TRDP_FLAGS_NONE, NULL, NULL, 0u, 0u, 0u);
+        IF_ERROR("tlp_request");
+        err = tlp_request(gSession2.appHandle, noReplyHandle, TEST60_NOREPLY, 0u, 0u, 0u, gSession1.ifaceIP + 5u,
+                          0u, TRDP_FLAGS_NONE, NULL, NULL, 0u, 0u, 0u);
+        IF_ERROR("tlp_request");
+        err = tlp_request(gSession2.appHandle, noReplyHandle, TEST60_NOREPLY, 0u, 0u, 0u, gSession1.ifaceIP + 6u,
+                          0u, TRDP_FLAGS_NONE, NULL, NULL, 0u, 0u, 0u);
+        if (err != TRDP_QUEUE_FULL_ERR)
+        {
+            FAILED("in-flight limit not applied");
+        }
+        (void) tlp_getPullStatus(gSession2.appHandle, &pending, &expired);
+        fprintf(gFp, "unanswered: pending %u, expired %u\n", pending, expired);
+        if (pending != 2u)
+        {
+            FAILED("requests not indexed");
+        }
+
+        /* Unanswered requests expire after the time out of the subscription */
+        vos_threadDelay(3u * TEST60_TIMEOUT);
+        (void) tlp_getPullStatus(gSession2.appHandle, &pending, &expired);
+        fprintf(gFp, "expired: pending %u, expired %u\n", pending, expired);
+        if ((pending != 0u) || (expired != 2u))
+        {
+            FAILED("requests not expired");
+        }
+
+        err = tlp_request(gSession2.appHandle, subHandle, TEST60_COMID, 0u, 0u, 0u, gSession1.ifaceIP,
+                          0u, TRDP_FLAGS_NONE, NULL, NULL, 0u, 0u, 0u);
+        IF_ERROR("tlp_request");
+        vos_threadDelay(100000u);
+        if (gTest60Received != 2u)
+        {
+            FAILED("no reply after expiry");
+        }
+
+        err = tlp_unsubscribe(gSession2.appHandle, noReplyHandle);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlp_unpublish(gSession1.appHandle, pubHandle);
+        IF_ERROR("tlp_unpublish");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test61 Sessions on the same address share their PD receive socket, frames reach the subscribing session
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST61_COMID_A      6100u                       /* subscribed by session A              */
+#define TEST61_COMID_B      6101u                       /* subscribed by session B              */
+#define TEST61_INTERVAL     20000u
+
+static UINT32 gTest61Received[2];
+
+static void test61PDcallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        gTest61Received[pMsg->comId - TEST61_COMID_A]++;
+    }
+}
+
+/*  Drive the sessions which are not run by a thread of the test    */
+static void test61Process (
+    TRDP_APP_SESSION_T  sessionA,
+    TRDP_APP_SESSION_T  sessionB,
+    UINT32              cycles)
+{
+    while (cycles-- > 0u)
+    {
+        if (sessionA != NULL)
+        {
+            (void) tlc_processEvents(sessionA);
+        }
+        if (sessionB != NULL)
+        {
+            (void) tlc_processEvents(sessionB);
+        }
+        vos_threadDelay(TEST61_INTERVAL / 2u);
+    }
+}
+
+static int test61 (int argc, char *argv[])
+{
+    PREPARE("PD receive sockets shared between sessions", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PROCESS_CONFIG_T   processConfig = {"", "", 0u, 0u, TRDP_OPTION_SHARE_SOCKETS};
+        TRDP_APP_SESSION_T      sessionA = NULL;
+        TRDP_APP_SESSION_T      sessionB = NULL;
+        TRDP_PUB_T              pubHandleA;
+        TRDP_PUB_T              pubHandleB;
+        TRDP_SUB_T              subHandleA;
+        TRDP_SUB_T              subHandleB;
+        char                    data1[] = "For session A";
+        char                    data2[] = "For session B";
+
+        memset(gTest61Received, 0, sizeof(gTest61Received));
+
+        err = tlc_openSession(&sessionA, gSession1.ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
+        IF_ERROR("tlc_openSession");
+        err = tlc_openSession(&sessionB, gSession1.ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
+        IF_ERROR("tlc_openSession");
+
+        err = tlp_publish(gSession2.appHandle, &pubHandleA, NULL, NULL, TEST61_COMID_A, 0u, 0u,
+                          0u, gDestMC, TEST61_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) data1, sizeof(data1));
+        IF_ERROR("tlp_publish");
+        err = tlp_publish(gSession2.appHandle, &pubHandleB, NULL, NULL, TEST61_COMID_B, 0u, 0u,
+                          0u, gDestMC, TEST61_INTERVAL,
+                          0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) data2, sizeof(data2));
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(sessionA, &subHandleA, NULL, test61PDcallBack,
+                            TEST61_COMID_A, 0u, 0u,
+                            0u, 0u, gDestMC,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST61_INTERVAL * 10, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_subscribe(sessionB, &subHandleB, NULL, test61PDcallBack,
+                            TEST61_COMID_B, 0u, 0u,
+                            0u, 0u, gDestMC,
+                            TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST61_INTERVAL * 10, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        /* Both sessions processed */
+        test61Process(sessionA, sessionB, 20u);
+        fprintf(gFp, "both processed: A %u, B %u\n", gTest61Received[0], gTest61Received[1]);
+        if ((gTest61Received[0] < 5u) || (gTest61Received[1] < 5u))
+        {
+            FAILED("frames not received");
+        }
+
+        /* Only A reads the socket, the frames of B are handed over */
+        test61Process(sessionA, NULL, 2u);
+        memset(gTest61Received, 0, sizeof(gTest61Received));
+        test61Process(sessionA, NULL, 20u);
+        fprintf(gFp, "A processed: A %u, B %u\n", gTest61Received[0], gTest61Received[1]);
+        if ((gTest61Received[0] < 5u) || (gTest61Received[1] < 5u))
+        {
+            FAILED("frames not handed over");
+        }
+
+        /* A leaves the socket, B keeps it */
+        err = tlp_unsubscribe(sessionA, subHandleA);
+        IF_ERROR("tlp_unsubscribe");
+        test61Process(NULL, sessionB, 2u);
+        memset(gTest61Received, 0, sizeof(gTest61Received));
+        test61Process(NULL, sessionB, 20u);
+        fprintf(gFp, "A left: A %u, B %u\n", gTest61Received[0], gTest61Received[1]);
+        if ((gTest61Received[0] != 0u) || (gTest61Received[1] < 5u))
+        {
+            FAILED("socket not kept");
+        }
+
+        err = tlp_unsubscribe(sessionB, subHandleB);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlp_unpublish(gSession2.appHandle, pubHandleB);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_unpublish(gSession2.appHandle, pubHandleA);
+        IF_ERROR("tlp_unpublish");
+        err = tlc_closeSession(sessionB);
+        IF_ERROR("tlc_closeSession");
+        err = tlc_closeSession(sessionA);
+        IF_ERROR("tlc_closeSession");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test62 SDT with TRDP_OPTION_PD_THREAD: tlp_get and tlp_getMulti check the channel, no vital group members
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test62 (int argc, char *argv[])
+{
+    gOptions = TRDP_OPTION_PD_THREAD;
+
+    PREPARE("SDT validation with the PD receive thread", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_SUB_GROUP_T    groupHandle;
+        TRDP_SDT_PAR_T      sdtPar;
+        TRDP_SDT_STATUS_T   status;
+        TRDP_UUID_T         cstUUID;
+        TRDP_GET_ITEM_T     item;
+        UINT8               vdp[TEST44_VDP_SIZE];
+        UINT8               data[TEST44_VDP_SIZE];
+        UINT32              dataSize;
+        UINT32              sid = test44Sid(TEST44_SMI);
+        UINT32              ssc = 1u;
+        UINT32              i;
+
+        memset(&sdtPar, 0, sizeof(sdtPar));
+        sdtPar.smi1     = TEST44_SMI;
+        sdtPar.udv      = TEST44_UDV;
+        sdtPar.rxPeriod = 20u;
+        sdtPar.txPeriod = 10u;
+        sdtPar.nrxSafe  = 5u;
+        sdtPar.nGuard   = 50u;
+        sdtPar.cmThr    = 3u;
+        memset(cstUUID, 0, sizeof(cstUUID));
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, NULL, TEST44_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST44_INTERVAL * 100u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_setSdt(gSession2.appHandle, subHandle, &sdtPar, cstUUID, 0u);
+        IF_ERROR("tlp_setSdt");
+        test44Vdp(vdp, sid, TEST44_UDV, ssc);
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST44_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST44_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, vdp, sizeof(vdp));
+        IF_ERROR("tlp_publish");
+
+        /* a group member would be read without checking the channel */
+        err = tlp_createSubGroup(gSession2.appHandle, &groupHandle, &subHandle, 1u);
+        if (err != TRDP_PARAM_ERR)
+        {
+            FAILED("vital group member accepted");
+        }
+
+        for (i = 0u; i < 20u; i++)
+        {
+            test44Vdp(vdp, sid, TEST44_UDV, ++ssc);
+            err = tlp_put(gSession1.appHandle, pubHandle, vdp, sizeof(vdp));
+            IF_ERROR("tlp_put");
+            vos_threadDelay(TEST44_INTERVAL);
+        }
+        dataSize = sizeof(data);
+        err = tlp_get(gSession2.appHandle, subHandle, NULL, data, &dataSize);
+        IF_ERROR("tlp_get");
+
+        /* wrong safety code: the channel fails and stays latched although the last valid frame is kept */
+        for (i = 0u; i < 10u; i++)
+        {
+            test44Vdp(vdp, sid + 1u, TEST44_UDV, ++ssc);
+            err = tlp_put(gSession1.appHandle, pubHandle, vdp, sizeof(vdp));
+            IF_ERROR("tlp_put");
+            vos_threadDelay(TEST44_INTERVAL);
+        }
+        err = tlp_getSdtStatus(gSession2.appHandle, subHandle, &status);
+        IF_ERROR("tlp_getSdtStatus");
+        fprintf(gFp, "state %u, SSC %u, valid %u, errors %u/%u/%u/%u\n", status.state, status.lastSsc,
+                status.numValid, status.numScErr, status.numUdvErr, status.numSscErr, status.numLatencyErr);
+        if (status.state != TRDP_SDT_ERROR)
+        {
+            FAILED("invalid vital data");
+        }
+        dataSize = sizeof(data);
+        err = tlp_get(gSession2.appHandle, subHandle, NULL, data, &dataSize);
+        if (err != TRDP_SAFETY_ERR)
+        {
+            FAILED("tlp_get of a failed channel");
+        }
+        memset(&item, 0, sizeof(item));
+        item.subHandle  = subHandle;
+        item.pData      = data;
+        item.dataSize   = sizeof(data);
+        (void) tlp_getMulti(gSession2.appHandle, &item, 1u);
+        if (item.result != TRDP_SAFETY_ERR)
+        {
+            FAILED("tlp_getMulti of a failed channel");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test63 A publisher of a comId already published by another session continues its sequence counter
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST63_COMID        6300u
+#define TEST63_INTERVAL     10000u
+#define TEST63_DATA         "Hello World!"
+
+static int test63 (int argc, char *argv[])
+{
+    PREPARE("Sequence counter of a comId published by two sessions", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T      pubHandle1;
+        TRDP_PUB_T      pubHandle2;
+        TRDP_SUB_T      subHandle;
+        TRDP_PD_INFO_T  pdInfo;
+        UINT8           data[32];
+        UINT32          dataSize;
+        UINT32          i;
+
+        /* frames of session 2's publisher are received by session 1 */
+        err = tlp_subscribe(gSession1.appHandle, &subHandle, NULL, NULL, TEST63_COMID, 0u, 0u,
+                            gSession2.ifaceIP, 0u, 0u, TRDP_FLAGS_DEFAULT, TEST63_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle1, NULL, NULL, TEST63_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST63_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) TEST63_DATA, sizeof(TEST63_DATA));
+        IF_ERROR("tlp_publish");
+
+        /* session 1 is processed by its thread while session 2 publishes the same comId */
+        vos_threadDelay(TEST63_INTERVAL * 20u);
+        err = tlp_publish(gSession2.appHandle, &pubHandle2, NULL, NULL, TEST63_COMID, 0u, 0u,
+                          0u, gSession1.ifaceIP, TEST63_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) TEST63_DATA, sizeof(TEST63_DATA));
+        IF_ERROR("tlp_publish");
+
+        for (i = 0u; i < 50u; i++)
+        {
+            vos_threadDelay(TEST63_INTERVAL);
+            dataSize = sizeof(data);
+            err = tlp_get(gSession1.appHandle, subHandle, &pdInfo, data, &dataSize);
+            if (err == TRDP_NO_ERR)
+            {
+                break;
+            }
+        }
+        IF_ERROR("tlp_get");
+        fprintf(gFp, "first sequence counter of the second publisher: %u\n", pdInfo.seqCount);
+        if (pdInfo.seqCount < 10u)
+        {
+            FAILED("sequence counter restarted");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
 /**********************************************************************************************************************/
 /* This array holds pointers to the m-th test (m = 1 will execute test1...)                                           */
 /**********************************************************************************************************************/
@@ -1856,6 +6056,55 @@ test_func_t *testArray[] =
     test12,
     test13,
     test14,
+    test15,
+    test16,
+    test17,
+    test18,
+    test19,
+    test20,
+    test21,
+    test22,
+    test23,
+    test24,
+    test25,
+    test26,
+    test27,
+    test28,
+    test29,
+    test30,
+    test31,
+    test32,
+    test33,
+    test34,
+    test35,
+    test36,
+    test37,
+    test38,
+    test39,
+    test40,
+    test41,
+    test42,
+    test43,
+    test44,
+    test45,
+    test46,
+    test47,
+    test48,
+    test49,
+    test50,
+    test51,
+    test52,
+    test53,
+    test54,
+    test55,
+    test56,
+    test57,
+    test58,
+    test59,
+    test60,
+    test61,
+    test62,
+    test63,
     NULL
 };
 
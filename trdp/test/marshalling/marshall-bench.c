@@ -0,0 +1,558 @@
+/**********************************************************************************************************************/
+/**
+ * @file            marshall-bench.c
+ *
+ * @brief           Benchmark for tau_marshall, tau_unmarshall and tau_calcDatasetSize
+ *
+ * @details         The datasets and their ComIds are read from an XML corpus (default marshall-corpus.xml, with
+ *                  nested datasets, variable-length arrays and large REAL32 arrays). For every ComId a number of
+ *                  random instances in network format is generated from the dataset description: random values and
+ *                  random lengths of the variable-length arrays, reproducible by the seed. Each instance must
+ *                  survive unmarshalling and marshalling unchanged, then the three functions are timed on them.
+ *                  The results are written as JSON lines, one object per ComId, in ns per byte of network data,
+ *                  to compare changes of the marshalling engine.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif defined (WIN32)
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "tau_marshall.h"
+#include "tau_xml.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION         "1.0"
+
+#define BENCH_MAX_INSTANCES 64u                     /* max. random instances per ComId          */
+#define BENCH_MAX_SIZE      TRDP_MAX_MD_DATA_SIZE   /* max. size of an instance                 */
+#define BENCH_CHECK_TIME    16u                     /* iterations between reading the time      */
+
+/** The timed functions */
+typedef enum
+{
+    BENCH_MARSHALL      = 0,
+    BENCH_UNMARSHALL    = 1,
+    BENCH_CALCSIZE      = 2
+} BENCH_OP_T;
+
+/** A random instance of a dataset in network and host format */
+typedef struct
+{
+    UINT8   *pWire;
+    UINT32  wireSize;
+    UINT8   *pHost;
+    UINT32  hostSize;
+} BENCH_INSTANCE_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+static UINT32               gNumDataset     = 0u;
+static apTRDP_DATASET_T     gapDataset      = NULL;
+static UINT32               gSeed           = 1u;
+static UINT32               gMaxVar         = 32u;
+static UINT32               gNumInstances   = 8u;
+static UINT32               gDuration       = 200u;
+static BOOL8                gLazy           = FALSE;
+static BENCH_INSTANCE_T     gInstance[BENCH_MAX_INSTANCES];
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void usage (const char *);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool measures the marshalling functions on random instances of the datasets of an XML corpus.\n"
+           "Arguments are:\n"
+           "-x <file>      XML corpus (default test/marshalling/marshall-corpus.xml)\n"
+           "-c <comId>     only this ComId (default all)\n"
+           "-n <count>     random instances per ComId (default 8, max. 64)\n"
+           "-m <items>     max. items of variable-length arrays (default 32)\n"
+           "-r <seed>      seed of the random instances (default 1)\n"
+           "-d <ms>        duration of each measurement (default 200)\n"
+           "-f <file>      write the results to file (default stdout)\n"
+           "-l             load the datasets on first use (tau_initMarshallLazy)\n"
+           "-v print version and quit\n"
+           );
+}
+
+/**********************************************************************************************************************/
+/** Pseudo random number, xorshift32  */
+static UINT32 benchRandom (void)
+{
+    gSeed   ^= gSeed << 13;
+    gSeed   ^= gSeed >> 17;
+    gSeed   ^= gSeed << 5;
+    return gSeed;
+}
+
+/**********************************************************************************************************************/
+/** Size of an element of a basic type in network format  */
+static UINT32 benchWireSize (
+    UINT32 type)
+{
+    switch (type)
+    {
+        case TRDP_BITSET8:
+        case TRDP_CHAR8:
+        case TRDP_INT8:
+        case TRDP_UINT8:
+            return 1u;
+        case TRDP_UTF16:
+        case TRDP_INT16:
+        case TRDP_UINT16:
+            return 2u;
+        case TRDP_INT32:
+        case TRDP_UINT32:
+        case TRDP_REAL32:
+        case TRDP_TIMEDATE32:
+            return 4u;
+        case TRDP_TIMEDATE48:
+            return 6u;
+        case TRDP_INT64:
+        case TRDP_UINT64:
+        case TRDP_REAL64:
+        case TRDP_TIMEDATE64:
+            return 8u;
+        default:
+            return 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Find a dataset of the corpus  */
+static TRDP_DATASET_T *benchFindDs (
+    UINT32 dsId)
+{
+    UINT32 i;
+
+    for (i = 0u; i < gNumDataset; i++)
+    {
+        if (gapDataset[i]->id == dsId)
+        {
+            return gapDataset[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Generate a random instance of a dataset in network format.
+ *  The size of a variable-length array is taken from the first item of the preceding 8, 16 or 32 bit element,
+ *  as the marshalling does. If the next element is such an array, a random length is written there.
+ *
+ *  @param[in]      pDataset    dataset
+ *  @param[in,out]  ppPos       write position
+ *  @param[in]      pEnd        end of the buffer
+ *  @param[in]      level       nesting level
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        instance does not fit the buffer
+ *  @retval         TRDP_COMID_ERR      nested dataset unknown
+ *  @retval         TRDP_STATE_ERR      nested too deep
+ */
+static TRDP_ERR_T benchGenerate (
+    const TRDP_DATASET_T    *pDataset,
+    UINT8                   **ppPos,
+    const UINT8             *pEnd,
+    UINT32                  level)
+{
+    UINT32      varSize = 0u;
+    UINT32      i, j;
+    TRDP_ERR_T  err;
+
+    if (level > TAU_MAX_DS_LEVEL)
+    {
+        return TRDP_STATE_ERR;
+    }
+
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        const TRDP_DATASET_ELEMENT_T *pElement = &pDataset->pElement[i];
+        UINT32  count       = (pElement->size == TRDP_VAR_SIZE) ? varSize : pElement->size;
+        BOOL8   nextIsVar   = ((i + 1u) < pDataset->numElement) &&
+            (pDataset->pElement[i + 1u].size == TRDP_VAR_SIZE);
+
+        if (pElement->type > (UINT32) TRDP_TYPE_MAX)
+        {
+            const TRDP_DATASET_T *pNested = benchFindDs(pElement->type);
+
+            if (pNested == NULL)
+            {
+                return TRDP_COMID_ERR;
+            }
+            for (j = 0u; j < count; j++)
+            {
+                err = benchGenerate(pNested, ppPos, pEnd, level + 1u);
+                if (err != TRDP_NO_ERR)
+                {
+                    return err;
+                }
+            }
+        }
+        else
+        {
+            UINT32  itemSize    = benchWireSize(pElement->type);
+            UINT8   *pItem      = *ppPos;
+
+            if ((UINT32) (pEnd - *ppPos) < count * itemSize)
+            {
+                return TRDP_MEM_ERR;
+            }
+            for (j = 0u; j < count * itemSize; j++)
+            {
+                *(*ppPos)++ = (UINT8) benchRandom();
+            }
+            if ((count > 0u) && (itemSize <= 4u))
+            {
+                if (nextIsVar)
+                {
+                    UINT32 len = benchRandom() % (gMaxVar + 1u);
+
+                    for (j = itemSize; j > 0u; j--, len >>= 8)
+                    {
+                        pItem[j - 1u] = (UINT8) len;
+                    }
+                }
+                for (varSize = 0u, j = 0u; j < itemSize; j++)
+                {
+                    varSize = (varSize << 8) | pItem[j];
+                }
+            }
+        }
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Time one of the functions on all instances
+ *
+ *  @retval         ns per call
+ */
+static double benchTime (
+    void        *pRefCon,
+    UINT32      comId,
+    UINT32      dsId,
+    BENCH_OP_T  op)
+{
+    static UINT8    wire[BENCH_MAX_SIZE];
+    TRDP_DATASET_T  *pCachedDs = NULL;
+    TRDP_TIME_T     start;
+    TRDP_TIME_T     now;
+    UINT32          limit = gDuration * 1000u;
+    UINT32          calls = 0u;
+    UINT32          elapsed;
+    UINT32          size;
+
+    vos_getTime(&start);
+    do
+    {
+        UINT32 i;
+
+        for (i = 0u; i < BENCH_CHECK_TIME; i++)
+        {
+            BENCH_INSTANCE_T *pInst = &gInstance[(calls + i) % gNumInstances];
+
+            switch (op)
+            {
+                case BENCH_MARSHALL:
+                    size = BENCH_MAX_SIZE;
+                    (void) tau_marshall(pRefCon, comId, pInst->pHost, pInst->hostSize, wire, &size, &pCachedDs);
+                    break;
+                case BENCH_UNMARSHALL:
+                    size = pInst->hostSize;
+                    (void) tau_unmarshall(pRefCon, comId, pInst->pWire, pInst->wireSize, pInst->pHost, &size,
+                                          &pCachedDs);
+                    break;
+                default:
+                    (void) tau_calcDatasetSize(pRefCon, dsId, pInst->pWire, pInst->wireSize, &size, &pCachedDs);
+                    break;
+            }
+        }
+        calls += BENCH_CHECK_TIME;
+        vos_getTime(&now);
+        vos_subTime(&now, &start);
+        elapsed = (UINT32) now.tv_sec * 1000000u + (UINT32) now.tv_usec;
+    }
+    while (elapsed < limit);
+
+    return (double) elapsed * 1000.0 / (double) calls;
+}
+
+/**********************************************************************************************************************/
+/** Benchmark of one ComId
+ *
+ *  @retval         0           no error
+ *  @retval         1           some error
+ */
+static int benchComId (
+    FILE                        *fp,
+    void                        *pRefCon,
+    const TRDP_COMID_DSID_MAP_T *pMap)
+{
+    static UINT8            wire[BENCH_MAX_SIZE];
+    TRDP_DATASET_T          *pDataset = NULL;
+    UINT32                  seed      = gSeed;
+    UINT64                  wireBytes = 0u;
+    UINT64                  hostBytes = 0u;
+    double                  perByte;
+    UINT32                  size;
+    UINT32                  i;
+    TRDP_ERR_T              err = TRDP_NO_ERR;
+    int                     rv  = 0;
+
+    /*  The lookup loads the dataset and its nested datasets into the shared table  */
+    (void) tau_lookupDataset(pRefCon, pMap->comId, &pDataset);
+    pDataset = benchFindDs(pMap->datasetId);
+    if (pDataset == NULL)
+    {
+        fprintf(stderr, "ComId %u: dataset %u unknown\n", pMap->comId, pMap->datasetId);
+        return 1;
+    }
+
+    memset(gInstance, 0, sizeof(gInstance));
+    for (i = 0u; (i < gNumInstances) && (err == TRDP_NO_ERR); i++)
+    {
+        UINT8 *pPos = wire;
+
+        err = benchGenerate(pDataset, &pPos, wire + BENCH_MAX_SIZE, 0u);
+        if (err == TRDP_NO_ERR)
+        {
+            gInstance[i].wireSize   = (UINT32) (pPos - wire);
+            gInstance[i].pWire      = (UINT8 *) malloc(gInstance[i].wireSize + 1u);
+            err = tau_calcDatasetSize(pRefCon, pMap->datasetId, wire, gInstance[i].wireSize,
+                                      &gInstance[i].hostSize, NULL);
+        }
+        if ((err == TRDP_NO_ERR) && (gInstance[i].pWire != NULL))
+        {
+            memcpy(gInstance[i].pWire, wire, gInstance[i].wireSize);
+            gInstance[i].pHost = (UINT8 *) malloc(gInstance[i].hostSize + 1u);
+
+            /*  The instance must survive the round trip unchanged  */
+            size = gInstance[i].hostSize;
+            err = tau_unmarshall(pRefCon, pMap->comId, gInstance[i].pWire, gInstance[i].wireSize,
+                                 gInstance[i].pHost, &size, NULL);
+            if ((err == TRDP_NO_ERR) && (size != gInstance[i].hostSize))
+            {
+                err = TRDP_MARSHALLING_ERR;
+            }
+            if (err == TRDP_NO_ERR)
+            {
+                size = BENCH_MAX_SIZE;
+                err = tau_marshall(pRefCon, pMap->comId, gInstance[i].pHost, gInstance[i].hostSize,
+                                   wire, &size, NULL);
+            }
+            if ((err == TRDP_NO_ERR) &&
+                ((size != gInstance[i].wireSize) || (memcmp(wire, gInstance[i].pWire, size) != 0)))
+            {
+                err = TRDP_MARSHALLING_ERR;
+            }
+            wireBytes += gInstance[i].wireSize;
+            hostBytes += gInstance[i].hostSize;
+        }
+        if ((err == TRDP_NO_ERR) && ((gInstance[i].pWire == NULL) || (gInstance[i].pHost == NULL)))
+        {
+            err = TRDP_MEM_ERR;
+        }
+    }
+
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "ComId %u: instance %u failed (Err: %d)\n", pMap->comId, i - 1u, err);
+        rv = 1;
+    }
+    else
+    {
+        perByte = (double) gNumInstances / (double) wireBytes;
+        fprintf(fp, "{\"bench\":\"marshall\",\"version\":\"%s\",\"comId\":%u,\"datasetId\":%u,\"instances\":%u,"
+                "\"seed\":%u,\"wire_bytes\":%.0f,\"host_bytes\":%.0f,",
+                tlc_getVersionString(), pMap->comId, pMap->datasetId, gNumInstances, seed,
+                (double) wireBytes / (double) gNumInstances, (double) hostBytes / (double) gNumInstances);
+        fprintf(fp, "\"marshall_ns_per_byte\":%.3f,", benchTime(pRefCon, pMap->comId, 0u, BENCH_MARSHALL) * perByte);
+        fprintf(fp, "\"unmarshall_ns_per_byte\":%.3f,",
+                benchTime(pRefCon, pMap->comId, 0u, BENCH_UNMARSHALL) * perByte);
+        fprintf(fp, "\"calcsize_ns_per_byte\":%.3f}\n",
+                benchTime(pRefCon, 0u, pMap->datasetId, BENCH_CALCSIZE) * perByte);
+        fflush(fp);
+    }
+
+    for (i = 0u; i < gNumInstances; i++)
+    {
+        free(gInstance[i].pWire);
+        free(gInstance[i].pHost);
+    }
+    return rv;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    TAU_XML_DS_SOURCE_T     *pSource        = NULL;
+    UINT32                  numComId        = 0u;
+    TRDP_TIME_T             start;
+    TRDP_TIME_T             now;
+    TRDP_ERR_T              err;
+    void                    *pRefCon        = NULL;
+    const CHAR8             *pXmlFile       = "test/marshalling/marshall-corpus.xml";
+    UINT32                  onlyComId       = 0u;
+    FILE                    *fp             = stdout;
+    int                     rv              = 0;
+    int                     ch;
+    UINT32                  i;
+
+    while ((ch = getopt(argc, argv, "x:c:n:m:r:d:f:lh?v")) != -1)
+    {
+        switch (ch)
+        {
+            case 'x':
+                pXmlFile = optarg;
+                break;
+            case 'c':
+                onlyComId = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                gNumInstances = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'm':
+                gMaxVar = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'r':
+                gSeed = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                gDuration = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                fp = fopen(optarg, "w");
+                if (fp == NULL)
+                {
+                    fprintf(stderr, "Cannot write %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'l':
+                gLazy = TRUE;
+                break;
+            case 'v':   /*  version */
+                printf("%s: Version %s\t(%s - %s)\n",
+                       argv[0], APP_VERSION, __DATE__, __TIME__);
+                exit(0);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if ((gNumInstances == 0u) || (gNumInstances > BENCH_MAX_INSTANCES) || (gSeed == 0u))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /*    No debug output, it would disturb the measurement    */
+    if (tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Initialization error\n");
+        return 1;
+    }
+
+    if (tau_prepareXmlDoc(pXmlFile, &docHandle) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Cannot read %s\n", pXmlFile);
+        (void) tlc_terminate();
+        return 1;
+    }
+
+    vos_getTime(&start);
+    if (gLazy == TRUE)
+    {
+        err = tau_readXmlDatasetIndex(&docHandle, &numComId, &pComIdDsIdMap, &gNumDataset, &gapDataset, &pSource);
+        if (err == TRDP_NO_ERR)
+        {
+            err = tau_initMarshallLazy(&pRefCon, numComId, pComIdDsIdMap, gNumDataset, gapDataset,
+                                       tau_loadXmlDataset, pSource);
+        }
+    }
+    else
+    {
+        err = tau_readXmlDatasetConfig(&docHandle, &numComId, &pComIdDsIdMap, &gNumDataset, &gapDataset);
+        if (err == TRDP_NO_ERR)
+        {
+            err = tau_initMarshall(&pRefCon, numComId, pComIdDsIdMap, gNumDataset, gapDataset);
+        }
+    }
+    vos_getTime(&now);
+    vos_subTime(&now, &start);
+
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Cannot read the datasets of %s\n", pXmlFile);
+        rv = 1;
+    }
+    else
+    {
+        fprintf(fp, "{\"bench\":\"startup\",\"version\":\"%s\",\"lazy\":%s,\"datasets\":%u,\"startup_us\":%u}\n",
+                tlc_getVersionString(), (gLazy == TRUE) ? "true" : "false", gNumDataset,
+                (UINT32) (now.tv_sec * 1000000 + now.tv_usec));
+    }
+
+    for (i = 0u; (i < numComId) && (pRefCon != NULL); i++)
+    {
+        if ((onlyComId == 0u) || (pComIdDsIdMap[i].comId == onlyComId))
+        {
+            rv |= benchComId(fp, pRefCon, &pComIdDsIdMap[i]);
+        }
+    }
+
+    if (pRefCon != NULL)
+    {
+        (void) tau_deInitMarshall(pRefCon);
+    }
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, gNumDataset, gapDataset);
+    tau_freeXmlDatasetSource(pSource);
+    tau_freeXmlDoc(&docHandle);
+    (void) tlc_terminate();
+    if (fp != stdout)
+    {
+        fclose(fp);
+    }
+    return rv;
+}
@@ -0,0 +1,294 @@
+/**********************************************************************************************************************/
+/**
+ * @file            test_hist.c
+ *
+ * @brief           Test of the columnar history store tau_hist
+ *
+ * @details         Telegrams of the datasets of an XML corpus (default marshall-corpus.xml) are logged with slowly
+ *                  changing values, as signals of a train are. The file is read back and every telegram compared.
+ *                  ComIds with datasets of fixed size, of variable size, without dataset and telegrams shorter than
+ *                  their dataset are covered. The time per tau_histLog() and the compression are printed.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif defined (WIN32)
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "tau_hist.h"
+#include "tau_xml.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION         "1.0"
+
+#define TEST_ROWS           5000u               /* telegrams per ComId                      */
+#define TEST_UNKNOWN_COMID  9999u               /* ComId without dataset                    */
+#define TEST_SHORT_COMID    2001u               /* every 100th telegram is shorter          */
+
+/** The ComIds logged and the payload sizes of the corpus datasets */
+static const struct
+{
+    UINT32  comId;
+    UINT32  size;
+} cTelegrams[] =
+{
+    {2001u, 28u},                   /* fixed: doorStatus                        */
+    {2004u, 237u},                  /* fixed, nested: carStatus                 */
+    {2003u, 40u},                   /* variable: diagText, sizes vary           */
+    {TEST_UNKNOWN_COMID, 100u}      /* no dataset                               */
+};
+
+#define TEST_NUM_COMIDS     (sizeof(cTelegrams) / sizeof(cTelegrams[0]))
+
+static UINT32   gNext[TEST_NUM_COMIDS];         /* next row expected per ComId      */
+static UINT32   gErrors;
+static UINT32   gRead;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void usage (const char *);
+UINT32 makeTelegram (UINT32 index, UINT32 row, UINT8 *pData);
+void checkTelegram (void *pRefCon, UINT32 comId, const TRDP_TIME_T *pTime, TRDP_IP_ADDR_T srcIpAddr,
+                    const UINT8 *pData, UINT32 dataSize);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool logs telegrams to a history file, reads them back and compares them.\n"
+           "Arguments are:\n"
+           "-x <file>     XML file with the datasets (default test/marshalling/marshall-corpus.xml)\n"
+           "-f <file>     history file (default /tmp/test_hist.trhs)\n"
+           "-v print version and quit\n"
+           );
+}
+
+/**********************************************************************************************************************/
+/** Build a telegram with slowly changing values
+ *
+ *  @param[in]      index       index in cTelegrams
+ *  @param[in]      row         number of the telegram
+ *  @param[out]     pData       payload
+ *
+ *  @retval         size of the payload
+ */
+UINT32 makeTelegram (UINT32 index, UINT32 row, UINT8 *pData)
+{
+    UINT32 size = cTelegrams[index].size;
+    UINT32 i;
+
+    if (cTelegrams[index].comId == 2003u)
+    {
+        size += (row / 50u) % 16u;
+    }
+    else if ((cTelegrams[index].comId == TEST_SHORT_COMID) && ((row % 100u) == 99u))
+    {
+        size -= 16u;
+    }
+    for (i = 0u; i < size; i++)
+    {
+        /* most bytes constant, some count slowly, few fast */
+        pData[i] = (UINT8) (((i % 7u) == 0u) ? (row >> (i % 3u)) : ((i % 11u) == 0u) ? row * i : i);
+    }
+    return size;
+}
+
+/**********************************************************************************************************************/
+/** Compare a telegram read back */
+void checkTelegram (
+    void                *pRefCon,
+    UINT32              comId,
+    const TRDP_TIME_T   *pTime,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    const UINT8         *pData,
+    UINT32              dataSize)
+{
+    static TRDP_TIME_T  last[TEST_NUM_COMIDS];
+    UINT8               expected[TRDP_MAX_PD_DATA_SIZE];
+    UINT32              index;
+    UINT32              size;
+
+    (void) pRefCon;
+    gRead++;
+    for (index = 0u; (index < TEST_NUM_COMIDS) && (cTelegrams[index].comId != comId); index++)
+    {
+        ;
+    }
+    if (index == TEST_NUM_COMIDS)
+    {
+        printf("### unexpected ComId %u\n", (unsigned int) comId);
+        gErrors++;
+        return;
+    }
+    size = makeTelegram(index, gNext[index], expected);
+    if ((size != dataSize) || (memcmp(expected, pData, size) != 0) || (srcIpAddr != 0x0A000000u + index) ||
+        timercmp(pTime, &last[index], <))
+    {
+        if (gErrors++ < 10u)
+        {
+            printf("### ComId %u, telegram %u differs\n", (unsigned int) comId, (unsigned int) gNext[index]);
+        }
+    }
+    last[index] = *pTime;
+    gNext[index]++;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    const CHAR8             *pXmlFile   = "test/marshalling/marshall-corpus.xml";
+    const CHAR8             *pHistFile  = "/tmp/test_hist.trhs";
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    UINT32                  numComId        = 0u;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    UINT32                  numDataset      = 0u;
+    apTRDP_DATASET_T        apDataset       = NULL;
+    TAU_HIST_CONFIG_T       config;
+    TAU_HIST_STATS_T        stats;
+    TAU_HIST_T              hist;
+    UINT8                   data[TRDP_MAX_PD_DATA_SIZE];
+    VOS_TIMEVAL_T           start;
+    VOS_TIMEVAL_T           end;
+    FILE                    *fp;
+    long                    fileSize    = 1;
+    UINT32                  row;
+    UINT32                  index;
+    TRDP_ERR_T              err;
+    int                     ch;
+
+    while ((ch = getopt(argc, argv, "x:f:h?v")) != -1)
+    {
+        switch (ch)
+        {
+            case 'x':
+                pXmlFile = optarg;
+                break;
+            case 'f':
+                pHistFile = optarg;
+                break;
+            case 'v':   /*  version */
+                printf("%s: Version %s\t(%s - %s)\n",
+                       argv[0], APP_VERSION, __DATE__, __TIME__);
+                exit(0);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR)
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+    if ((tau_prepareXmlDoc(pXmlFile, &docHandle) != TRDP_NO_ERR) ||
+        (tau_readXmlDatasetConfig(&docHandle, &numComId, &pComIdDsIdMap, &numDataset, &apDataset) != TRDP_NO_ERR))
+    {
+        printf("Cannot read the datasets of %s\n", pXmlFile);
+        return 1;
+    }
+
+    memset(&config, 0, sizeof(config));
+    config.numComId         = numComId;
+    config.pComIdDsIdMap    = pComIdDsIdMap;
+    config.numDataset       = numDataset;
+    config.apDataset        = apDataset;
+    config.interval         = 10000u;
+    err = tau_histOpen(&hist, pHistFile, &config);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("tau_histOpen failed (Err: %d)\n", err);
+        return 1;
+    }
+
+    vos_getTime(&start);
+    for (row = 0u; row < TEST_ROWS; row++)
+    {
+        for (index = 0u; index < TEST_NUM_COMIDS; index++)
+        {
+            UINT32 size = makeTelegram(index, row, data);
+
+            while (tau_histLog(hist, cTelegrams[index].comId, 0x0A000000u + index, data, size) == TRDP_QUEUE_FULL_ERR)
+            {
+                (void) vos_threadDelay(1000u);
+            }
+        }
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+
+    (void) tau_histGetStatistics(hist, &stats);
+    err = tau_histClose(hist);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("tau_histClose failed (Err: %d)\n", err);
+        gErrors++;
+    }
+    printf("%u telegrams, %.1f ns per tau_histLog()\n", (unsigned int) stats.numLogged,
+           ((double) end.tv_sec * 1e9 + (double) end.tv_usec * 1e3) / (double) stats.numLogged);
+
+    err = tau_histRead(pHistFile, checkTelegram, NULL);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("tau_histRead failed (Err: %d)\n", err);
+        gErrors++;
+    }
+    for (index = 0u; index < TEST_NUM_COMIDS; index++)
+    {
+        if (gNext[index] != TEST_ROWS)
+        {
+            printf("### ComId %u: %u of %u telegrams read\n", (unsigned int) cTelegrams[index].comId,
+                   (unsigned int) gNext[index], (unsigned int) TEST_ROWS);
+            gErrors++;
+        }
+    }
+    fp = fopen(pHistFile, "rb");
+    if (fp != NULL)
+    {
+        (void) fseek(fp, 0, SEEK_END);
+        fileSize = ftell(fp);
+        fclose(fp);
+    }
+    printf("%u telegrams read, %llu payload bytes in %ld bytes file (%.1f : 1)\n", (unsigned int) gRead,
+           (unsigned long long) stats.bytesLogged, fileSize, (double) stats.bytesLogged / (double) fileSize);
+
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    tau_freeXmlDoc(&docHandle);
+    (void) tlc_terminate();
+
+    printf("%s\n", (gErrors == 0u) ? "Success" : "FAILED");
+    return (gErrors == 0u) ? 0 : 1;
+}
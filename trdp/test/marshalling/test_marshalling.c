@@ -506,6 +506,46 @@ TRDP_DATASET_T  gDataSet2003 =
     }
 };
 
+/*    Long arrays for the vectorized byte swapping, the UINT8 moves the arrays to odd wire offsets    */
+TRDP_DATASET_T  gDataSet2004 =
+{
+    2004,       /*    dataset/com ID  */
+    0,          /*    reserved        */
+    6,          /*    No of elements  */
+    {           /*    TRDP_DATASET_ELEMENT_T[]    */
+        {
+            TRDP_UINT8,
+            1,
+            0,0,0,NULL
+        },
+        {
+            TRDP_UINT16,
+            37,
+            0,0,0,NULL
+        },
+        {
+            TRDP_UINT32,
+            41,
+            0,0,0,NULL
+        },
+        {
+            TRDP_REAL32,
+            201,
+            0,0,0,NULL
+        },
+        {
+            TRDP_UINT64,
+            19,
+            0,0,0,NULL
+        },
+        {
+            TRDP_REAL64,
+            23,
+            0,0,0,NULL
+        }
+    }
+};
+
 /*    Will be sorted by tau_initMarshall    */
 TRDP_DATASET_T  *gDataSets[] =
 {
@@ -516,7 +556,8 @@ TRDP_DATASET_T  *gDataSets[] =
     &gDataSet1992,
     &gDataSet1993,
     &gDataSet2002,
-    &gDataSet2003
+    &gDataSet2003,
+    &gDataSet2004
 };
 
 struct myDataSet1990
@@ -717,12 +758,25 @@ TRDP_COMID_DSID_MAP_T   gComIdMap[] =
 {
     {1000, 1000},
     {1001, 1001},
-    {2003, 2003}
+    {2003, 2003},
+    {2004, 2004}
 };
 
 UINT8   gDstDataBuffer[1500];
 UINT32  *gpRefCon = NULL;
 
+struct myDataSet2004
+{
+    UINT8   a;
+    UINT16  b[37];
+    UINT32  c[41];
+    REAL32  d[201];
+    UINT64  e[19];
+    REAL64  f[23];
+} gMyDataSet2004, gMyDataSet2004Copy;
+
+UINT8   gExpDataBuffer[sizeof(struct myDataSet2004)];
+
 struct myDataSet1000    gMyDataSet1000Copy;
 struct myDataSet1001    gMyDataSet1001Copy;
 struct myDataSet2003    gMyDataSet2003Copy;
@@ -882,14 +936,213 @@ static int test2()
     return 0;
 }
 
+/***********************************************************************************************************************
+    Append an item in network byte order
+***********************************************************************************************************************/
+static UINT8 *putBigEndian (UINT8 *pDst, const void *pItem, UINT32 size)
+{
+    UINT64  value = 0;
+    UINT32  i;
+
+    memcpy(&value, pItem, size);    /* host order, test runs on little endian hosts only */
+    for (i = size; i > 0; i--)
+    {
+        *pDst++ = (UINT8) (value >> ((i - 1) * 8));
+    }
+    return pDst;
+}
+
+/***********************************************************************************************************************
+    Test marshalling of long arrays against a byte by byte reference
+***********************************************************************************************************************/
+static int test3()
+{
+    TRDP_ERR_T  err;
+    UINT32      bufSize;
+    UINT32      bufSize2;
+    UINT32      i;
+    UINT8       *pExp = gExpDataBuffer;
+
+    /*    Test pattern with distinct bytes in every item    */
+    gMyDataSet2004.a = 0xA5;
+    for (i = 0; i < 37; i++)
+    {
+        gMyDataSet2004.b[i] = (UINT16) (0x0102u * (i + 1));
+    }
+    for (i = 0; i < 41; i++)
+    {
+        gMyDataSet2004.c[i] = 0x01020304u * (i + 1);
+    }
+    for (i = 0; i < 201; i++)
+    {
+        gMyDataSet2004.d[i] = (REAL32) i * 1.25f - 100.0f;
+    }
+    for (i = 0; i < 19; i++)
+    {
+        gMyDataSet2004.e[i] = 0x0102030405060708ull * (i + 1);
+    }
+    for (i = 0; i < 23; i++)
+    {
+        gMyDataSet2004.f[i] = (REAL64) i * -3.5e100;
+    }
+
+    /*    Reference encoding    */
+    *pExp++ = gMyDataSet2004.a;
+    for (i = 0; i < 37; i++)
+    {
+        pExp = putBigEndian(pExp, &gMyDataSet2004.b[i], 2);
+    }
+    for (i = 0; i < 41; i++)
+    {
+        pExp = putBigEndian(pExp, &gMyDataSet2004.c[i], 4);
+    }
+    for (i = 0; i < 201; i++)
+    {
+        pExp = putBigEndian(pExp, &gMyDataSet2004.d[i], 4);
+    }
+    for (i = 0; i < 19; i++)
+    {
+        pExp = putBigEndian(pExp, &gMyDataSet2004.e[i], 8);
+    }
+    for (i = 0; i < 23; i++)
+    {
+        pExp = putBigEndian(pExp, &gMyDataSet2004.f[i], 8);
+    }
+
+    bufSize = sizeof(gDstDataBuffer);
+    memset(gDstDataBuffer, 0, sizeof(gDstDataBuffer));
+
+    err = tau_marshall(gpRefCon, 2004, (UINT8 *) &gMyDataSet2004, sizeof(gMyDataSet2004), gDstDataBuffer, &bufSize, NULL);
+
+    if (err != TRDP_NO_ERR)
+    {
+        printf("tau_marshall returns error %d\n", err);
+        return 1;
+    }
+
+    if ((bufSize != (UINT32) (pExp - gExpDataBuffer)) || (memcmp(gDstDataBuffer, gExpDataBuffer, bufSize) != 0))
+    {
+        printf("...### Marshalled arrays differ from the reference!\n");
+        return 1;
+    }
+
+    bufSize2 = sizeof(gMyDataSet2004Copy);
+    memset(&gMyDataSet2004Copy, 0, bufSize2);
+
+    err = tau_unmarshall(gpRefCon, 2004, gDstDataBuffer, bufSize, (UINT8 *) &gMyDataSet2004Copy, &bufSize2, NULL);
+
+    if (err != TRDP_NO_ERR)
+    {
+        printf("tau_unmarshall returns error %d\n", err);
+        return 1;
+    }
+
+    if (memcmp(&gMyDataSet2004, &gMyDataSet2004Copy, sizeof(gMyDataSet2004)) != 0)
+    {
+        printf("Something's wrong in the state of Marshalling!\n");
+        return 1;
+    }
+    else
+    {
+        printf("Marshalling and Unmarshalling of long arrays matched the reference!\n");
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+    Test the comId lookup
+***********************************************************************************************************************/
+static int test4()
+{
+    TRDP_ERR_T      err;
+    TRDP_DATASET_T  *pDataset = NULL;
+    UINT32          i;
+    UINT32          bufSize;
+
+    for (i = 0; i < sizeof(gComIdMap)/sizeof(TRDP_COMID_DSID_MAP_T); i++)
+    {
+        err = tau_lookupDataset(gpRefCon, gComIdMap[i].comId, &pDataset);
+        if ((err != TRDP_NO_ERR) || (pDataset == NULL) || (pDataset->id != gComIdMap[i].datasetId))
+        {
+            printf("tau_lookupDataset(%u) returns error %d\n", gComIdMap[i].comId, err);
+            return 1;
+        }
+    }
+
+    if (tau_lookupDataset(gpRefCon, 4711, &pDataset) != TRDP_COMID_ERR)
+    {
+        printf("tau_lookupDataset found unknown ComId\n");
+        return 1;
+    }
+
+    /*    A resolved dataset can be used as cache    */
+    (void) tau_lookupDataset(gpRefCon, 2004, &pDataset);
+    bufSize = sizeof(gDstDataBuffer);
+    err = tau_marshall(gpRefCon, 2004, (UINT8 *) &gMyDataSet2004, sizeof(gMyDataSet2004), gDstDataBuffer, &bufSize, &pDataset);
+
+    if ((err != TRDP_NO_ERR) || (memcmp(gDstDataBuffer, gExpDataBuffer, bufSize) != 0))
+    {
+        printf("tau_marshall with looked up dataset returns error %d\n", err);
+        return 1;
+    }
+
+    printf("ComId lookup OK!\n");
+    return 0;
+}
+
+/***********************************************************************************************************************
+    Test independent marshalling contexts, e.g. one per session
+***********************************************************************************************************************/
+static int test5()
+{
+    static TRDP_COMID_DSID_MAP_T    comIdMap2[] = {{2004, 1990}};
+    static TRDP_DATASET_T           *dataSets2[] = {&gDataSet1990};
+    TRDP_DATASET_T                  *pDataset = NULL;
+    void                            *pRefCon2 = NULL;
+
+    if (tau_initMarshall(&pRefCon2, 1, comIdMap2, 1, dataSets2) != TRDP_NO_ERR)
+    {
+        printf("second tau_initMarshall failed\n");
+        return 1;
+    }
+
+    /*    The same comId maps to a different dataset in each context    */
+    if ((tau_lookupDataset(pRefCon2, 2004, &pDataset) != TRDP_NO_ERR) || (pDataset->id != 1990) ||
+        (tau_lookupDataset(gpRefCon, 2004, &pDataset) != TRDP_NO_ERR) || (pDataset->id != 2004) ||
+        (tau_lookupDataset(pRefCon2, 1000, &pDataset) != TRDP_COMID_ERR))
+    {
+        printf("marshalling contexts are not independent\n");
+        return 1;
+    }
+
+    /*    Without context the most recent one is used    */
+    if ((tau_lookupDataset(NULL, 2004, &pDataset) != TRDP_NO_ERR) || (pDataset->id != 1990))
+    {
+        printf("default marshalling context is wrong\n");
+        return 1;
+    }
+
+    if ((tau_deInitMarshall(pRefCon2) != TRDP_NO_ERR) ||
+        (tau_lookupDataset(NULL, 2004, &pDataset) != TRDP_NO_ERR) || (pDataset->id != 2004))
+    {
+        printf("tau_deInitMarshall failed\n");
+        return 1;
+    }
+
+    printf("Marshalling contexts OK!\n");
+    return 0;
+}
+
 /******/
 int main ()
 {
     TRDP_ERR_T  err;
 
-    err = tau_initMarshall((void *)&gpRefCon, sizeof(gComIdMap)/sizeof(TRDP_COMID_DSID_MAP_T), gComIdMap, 8, gDataSets);
+    err = tau_initMarshall((void *)&gpRefCon, sizeof(gComIdMap)/sizeof(TRDP_COMID_DSID_MAP_T), gComIdMap,
+                           sizeof(gDataSets)/sizeof(TRDP_DATASET_T *), gDataSets);
 
     //test1();
-    return test2();
+    return test2() | test3() | test4() | test5();
 }
 
@@ -0,0 +1,287 @@
+/**********************************************************************************************************************/
+/**
+ * @file            test_typed.cpp
+ *
+ * @brief           Test of the typed C++ layer (trdp_typed.hpp)
+ *
+ * @details         Packs a dataset holding every supported member kind with trdp::marshall and with tau_marshall
+ *                  and compares the results, unpacks it again and finally sends it through a loopback session
+ *                  with trdp::Publisher / trdp::Subscriber (typed callback and polled).
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "trdp_typed.hpp"
+#include "tau_marshall.h"
+#include "vos_sock.h"
+#include "vos_utils.h"
+
+#define TEST_COMID      3002u
+#define TEST_IP         0x7F000001u     /* 127.0.0.1 */
+
+/**********************************************************************************************************************/
+/* Test datasets, same member order as the TRDP_DATASET_T below */
+/**********************************************************************************************************************/
+struct Inner
+{
+    UINT16      id;
+    TIMEDATE48  stamp;
+
+    using TrdpFields = trdp::Fields<&Inner::id, &Inner::stamp>;
+};
+
+struct Outer
+{
+    BOOL8                   boolean;
+    CHAR8                   name[5];
+    UTF16                   utf16;
+    INT8                    integer8;
+    INT16                   integer16;
+    INT32                   integer32;
+    INT64                   integer64;
+    UINT8                   uInteger8;
+    UINT16                  uInteger16;
+    UINT32                  uInteger32;
+    UINT64                  uInteger64;
+    REAL32                  real32;
+    REAL64                  real64;
+    TIMEDATE32              timeDate32;
+    TIMEDATE48              timeDate48;
+    TIMEDATE64              timeDate64;
+    Inner                   inner[2];
+    std::array<INT16, 3>    values;
+
+    using TrdpFields = trdp::Fields<&Outer::boolean, &Outer::name, &Outer::utf16, &Outer::integer8,
+                                    &Outer::integer16, &Outer::integer32, &Outer::integer64, &Outer::uInteger8,
+                                    &Outer::uInteger16, &Outer::uInteger32, &Outer::uInteger64, &Outer::real32,
+                                    &Outer::real64, &Outer::timeDate32, &Outer::timeDate48, &Outer::timeDate64,
+                                    &Outer::inner, &Outer::values>;
+};
+
+static_assert(trdp::wireSize<Inner>() == 8u, "wire size of Inner");
+static_assert(trdp::wireSize<Outer>() == 1u + 5u + 2u + 1u + 2u + 4u + 8u + 1u + 2u + 4u + 8u + 4u + 8u + 4u + 6u + 8u +
+              2u * 8u + 3u * 2u, "wire size of Outer");
+
+static TRDP_DATASET_T gDataSetInner =
+{
+    3001, 0, 2,
+    {
+        { TRDP_UINT16, 1, NULL },
+        { TRDP_TIMEDATE48, 1, NULL }
+    }
+};
+
+static TRDP_DATASET_T gDataSetOuter =
+{
+    3002, 0, 18,
+    {
+        { TRDP_BOOL8, 1, NULL },
+        { TRDP_CHAR8, 5, NULL },
+        { TRDP_UTF16, 1, NULL },
+        { TRDP_INT8, 1, NULL },
+        { TRDP_INT16, 1, NULL },
+        { TRDP_INT32, 1, NULL },
+        { TRDP_INT64, 1, NULL },
+        { TRDP_UINT8, 1, NULL },
+        { TRDP_UINT16, 1, NULL },
+        { TRDP_UINT32, 1, NULL },
+        { TRDP_UINT64, 1, NULL },
+        { TRDP_REAL32, 1, NULL },
+        { TRDP_REAL64, 1, NULL },
+        { TRDP_TIMEDATE32, 1, NULL },
+        { TRDP_TIMEDATE48, 1, NULL },
+        { TRDP_TIMEDATE64, 1, NULL },
+        { 3001, 2, NULL },
+        { TRDP_INT16, 3, NULL }
+    }
+};
+
+static TRDP_DATASET_T       *gDataSets[]    = { &gDataSetInner, &gDataSetOuter };
+static TRDP_COMID_DSID_MAP_T gComIdMap[]    = { { 3001u, 3001u }, { 3002u, 3002u } };
+
+static const Outer gTestData =
+{
+    1, { 'T', 'R', 'D', 'P', 0 }, 0x00E4, -2, -300, -70000, -5000000000LL, 0xA5, 0x1234, 0x12345678u,
+    0x123456789ABCDEF0ull, 0.12345f, 0.12345678, 0x5A5A5A5Au, { 0x12345678u, 0x9ABCu },
+    { 0x12345678, 999999 }, { { 1u, { 11u, 12u } }, { 2u, { 21u, 22u } } }, {{ -1, 0, 1 }}
+};
+
+static volatile int gCbCount = 0;
+static Outer        gCbData;
+
+static bool equal (const Outer &a, const Outer &b)
+{
+    bool ok = (a.boolean == b.boolean) && (std::memcmp(a.name, b.name, sizeof(a.name)) == 0) &&
+        (a.utf16 == b.utf16) && (a.integer8 == b.integer8) && (a.integer16 == b.integer16) &&
+        (a.integer32 == b.integer32) && (a.integer64 == b.integer64) && (a.uInteger8 == b.uInteger8) &&
+        (a.uInteger16 == b.uInteger16) && (a.uInteger32 == b.uInteger32) && (a.uInteger64 == b.uInteger64) &&
+        (a.real32 == b.real32) && (a.real64 == b.real64) && (a.timeDate32 == b.timeDate32) &&
+        (a.timeDate48.sec == b.timeDate48.sec) && (a.timeDate48.ticks == b.timeDate48.ticks) &&
+        (a.timeDate64.tv_sec == b.timeDate64.tv_sec) && (a.timeDate64.tv_usec == b.timeDate64.tv_usec) &&
+        (a.values == b.values);
+
+    for (int i = 0; i < 2; i++)
+    {
+        ok = ok && (a.inner[i].id == b.inner[i].id) && (a.inner[i].stamp.sec == b.inner[i].stamp.sec) &&
+            (a.inner[i].stamp.ticks == b.inner[i].stamp.ticks);
+    }
+    return ok;
+}
+
+static void typedCallback (void *pRefCon, const Outer &data, const TRDP_PD_INFO_T &info)
+{
+    if ((pRefCon == &gCbCount) && (info.resultCode == TRDP_NO_ERR) && (info.comId == TEST_COMID))
+    {
+        gCbData = data;
+        gCbCount++;
+    }
+}
+
+/**********************************************************************************************************************/
+/* Compare the typed marshalling with tau_marshall */
+/**********************************************************************************************************************/
+static int testMarshall ()
+{
+    void                    *refCon = NULL;
+    trdp::WireBuffer<Outer> typed;
+    UINT8                   reference[256];
+    UINT32                  size = sizeof(reference);
+    Outer                   copy;
+    TRDP_ERR_T              err;
+
+    err = tau_initMarshall(&refCon, sizeof(gComIdMap) / sizeof(gComIdMap[0]), gComIdMap,
+                           sizeof(gDataSets) / sizeof(gDataSets[0]), gDataSets);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("### tau_initMarshall returns error %d\n", err);
+        return 1;
+    }
+    std::memset(reference, 0, sizeof(reference));
+    err = tau_marshall(refCon, TEST_COMID, (UINT8 *) &gTestData, sizeof(gTestData), reference, &size, NULL);
+    if (err != TRDP_NO_ERR)
+    {
+        printf("### tau_marshall returns error %d\n", err);
+        return 1;
+    }
+    trdp::marshall(gTestData, typed.data());
+    if ((size != typed.size()) || (std::memcmp(reference, typed.data(), size) != 0))
+    {
+        printf("### typed marshalling differs from tau_marshall (%u / %u bytes)\n", size, (UINT32) typed.size());
+        return 1;
+    }
+    std::memset(&copy, 0, sizeof(copy));
+    trdp::unmarshall(typed.data(), copy);
+    if (!equal(copy, gTestData))
+    {
+        printf("### typed unmarshalling does not restore the dataset\n");
+        return 1;
+    }
+    printf("Typed marshalling of %u bytes matches tau_marshall\n", size);
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/* Loopback publish / subscribe */
+/**********************************************************************************************************************/
+static void process (TRDP_APP_SESSION_T appHandle, UINT32 ms)
+{
+    for (UINT32 i = 0u; i < ms / 10u; i++)
+    {
+        TRDP_FDS_T  rfds;
+        TRDP_TIME_T tv;
+        TRDP_TIME_T maxTv   = {0, 10000};
+        INT32       noDesc  = 0;
+        INT32       rv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+        if (vos_cmpTime(&tv, &maxTv) > 0)
+        {
+            tv = maxTv;
+        }
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(appHandle, &rfds, &rv);
+    }
+}
+
+static int testLoopback ()
+{
+    TRDP_PROCESS_CONFIG_T   processConfig = {"", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_APP_SESSION_T      appHandle = NULL;
+    Outer                   data = gTestData;
+    Outer                   received;
+    TRDP_PD_INFO_T          info;
+    int                     result = 1;
+
+    if (tlc_openSession(&appHandle, TEST_IP, 0u, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR)
+    {
+        printf("### tlc_openSession failed\n");
+        return 1;
+    }
+
+    {
+        trdp::Publisher<Outer>  pub;
+        trdp::Subscriber<Outer> sub;
+
+        sub.onReceive(typedCallback, (void *) &gCbCount);
+        if ((sub.subscribe(appHandle, TEST_COMID, 1000000u) != TRDP_NO_ERR) ||
+            (pub.publish(appHandle, TEST_COMID, TEST_IP, 10000u, data) != TRDP_NO_ERR))
+        {
+            printf("### typed publish/subscribe failed\n");
+        }
+        else
+        {
+            process(appHandle, 100u);
+            data.uInteger32 = 0xCAFEu;
+            (void) pub.put(data);
+            process(appHandle, 100u);
+
+            if ((sub.get(received, &info) != TRDP_NO_ERR) || !equal(received, data))
+            {
+                printf("### Subscriber<>::get returned other data\n");
+            }
+            else if ((gCbCount == 0) || !equal(gCbData, data))
+            {
+                printf("### typed callback not called or with other data (%d calls)\n", gCbCount);
+            }
+            else
+            {
+                printf("Typed publish/subscribe OK (%d callbacks)\n", gCbCount);
+                result = 0;
+            }
+        }
+    }
+    (void) tlc_closeSession(appHandle);
+    return result;
+}
+
+int main ()
+{
+    int result;
+
+    if (tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR)
+    {
+        printf("### tlc_init failed\n");
+        return 1;
+    }
+    result = testMarshall();
+    if (result == 0)
+    {
+        result = testLoopback();
+    }
+    (void) tlc_terminate();
+    printf((result == 0) ? "Success\n" : "Failed\n");
+    return result;
+}
@@ -275,6 +275,8 @@ const char *get_result_string (TRDP_ERR_T err)
            return "TRDP_INUSE_ERR (Resource is in use error)";
        case TRDP_MARSHALLING_ERR:
            return "TRDP_MARSHALLING_ERR (Mismatch between source size and dataset size)";
+       case TRDP_SAFETY_ERR:
+           return "TRDP_SAFETY_ERR (vital data not valid)";
        case TRDP_UNKNOWN_ERR:
            return "TRDP_UNKNOWN_ERR (unspecified error)";
     }
@@ -0,0 +1,892 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xml2c.c
+ *
+ * @brief           Generator of C structures and marshalling functions for the datasets of an XML configuration
+ *
+ * @details         Reads the data-set-list of a TRDP XML configuration and writes <base>.h and <base>.c:
+ *                  - a C structure for every dataset of fixed size, nested datasets as nested structures
+ *                  - a marshalling and an unmarshalling function for each of them
+ *                  - a table of type TAU_DS_CODEC_T to be passed to tau_registerCodecs() after tau_initMarshall()
+ *                  The marshalling functions of the stack then call the generated functions for these datasets
+ *                  instead of interpreting the dataset description. Datasets with variable sized elements have no
+ *                  C structure and are left to the interpreter.
+ *                  The host sizes in the table are taken from the marshalling of this build, the generated code
+ *                  refuses to compile if the C structures get a different layout with another compiler or target.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2019. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif defined (WIN32)
+#include "getopt.h"
+#endif
+
+#include "tau_xml.h"
+#include "tau_marshall.h"
+#include "trdp_xml.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+#define APP_VERSION     "1.0"
+
+#define GEN_MAX_NAME    64u         /**< max. length of generated identifiers   */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Generation state of a dataset */
+typedef enum
+{
+    GEN_NEW     = 0,    /**< not looked at yet                      */
+    GEN_BUSY    = 1,    /**< being generated (detects recursion)    */
+    GEN_STRUCT  = 2,    /**< structure written                      */
+    GEN_DONE    = 3,    /**< functions written                      */
+    GEN_SKIP    = 4     /**< variable size or unknown types         */
+} GEN_STATE_T;
+
+/** A dataset with the names found in the XML file */
+typedef struct
+{
+    TRDP_DATASET_T  *pDataset;              /**< parsed by tau_readXmlDatasetConfig()   */
+    CHAR8           name[GEN_MAX_NAME];     /**< dataset name as C identifier           */
+    CHAR8           typeName[GEN_MAX_NAME]; /**< name in type names (upper case)        */
+    CHAR8           funcName[GEN_MAX_NAME]; /**< name in function names (capitalised)   */
+    CHAR8           (*pElemName)[GEN_MAX_NAME]; /**< element names as C identifiers     */
+    GEN_STATE_T     state;                  /**< generation state                       */
+    UINT32          wireSize;               /**< wire bytes                             */
+    UINT32          hostSize;               /**< host bytes as the interpreter counts   */
+} GEN_DS_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+static const CHAR8  *gPrefix    = "dsGen";
+static CHAR8        gUpper[GEN_MAX_NAME];
+static GEN_DS_T     *gDs        = NULL;
+static UINT32       gNumDs      = 0u;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+void usage (const char *);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool generates C structures and marshalling functions for the datasets of an XML file.\n"
+           "Arguments are:\n"
+           "-o <base>      write <base>.h and <base>.c (default: the prefix)\n"
+           "-p <prefix>    prefix of the generated identifiers (default dsGen)\n"
+           "-v print version and quit\n"
+           "<xmlfile>      TRDP XML configuration\n"
+           );
+}
+
+/**********************************************************************************************************************/
+/** Copy a name from the XML file as C identifier
+ *
+ *  @param[out]     pDst            identifier
+ *  @param[in]      pSrc            name, may be empty
+ *  @param[in]      pDefault        prefix of the identifier if the name is empty
+ *  @param[in]      index           number appended to pDefault
+ */
+static void genIdentifier (
+    CHAR8       *pDst,
+    const CHAR8 *pSrc,
+    const CHAR8 *pDefault,
+    UINT32      index)
+{
+    UINT32 i;
+
+    if ((pSrc == NULL) || (*pSrc == '\0'))
+    {
+        (void) snprintf(pDst, GEN_MAX_NAME, "%s%u", pDefault, index);
+        return;
+    }
+    i = 0u;
+    if (isdigit((unsigned char) *pSrc))
+    {
+        pDst[i++] = '_';
+    }
+    for (; (*pSrc != '\0') && (i < GEN_MAX_NAME - 1u); pSrc++)
+    {
+        pDst[i++] = (isalnum((unsigned char) *pSrc)) ? *pSrc : '_';
+    }
+    pDst[i] = '\0';
+}
+
+/**********************************************************************************************************************/
+/** Read the names of the datasets and their elements, in the order tau_readXmlDatasetConfig() reads them
+ *
+ *  @param[in]      pFileName       XML file
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  file not readable
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T genReadNames (
+    const CHAR8 *pFileName)
+{
+    XML_HANDLE_T    xml;
+    CHAR8           attribute[MAX_TOK_LEN];
+    CHAR8           value[MAX_TOK_LEN];
+    UINT32          valueInt;
+    UINT32          idx;
+    UINT32          i;
+
+    for (idx = 0u; idx < gNumDs; idx++)
+    {
+        genIdentifier(gDs[idx].name, NULL, "dataset", gDs[idx].pDataset->id);
+        gDs[idx].pElemName = calloc(gDs[idx].pDataset->numElement + 1u, GEN_MAX_NAME);
+        if (gDs[idx].pElemName == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        for (i = 0u; i < gDs[idx].pDataset->numElement; i++)
+        {
+            genIdentifier(gDs[idx].pElemName[i], NULL, "element", i);
+        }
+    }
+
+    if (trdp_XMLOpen(&xml, pFileName) != TRDP_NO_ERR)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    trdp_XMLRewind(&xml);
+    trdp_XMLEnter(&xml);
+    if (trdp_XMLSeekStartTag(&xml, "device") == 0)
+    {
+        trdp_XMLEnter(&xml);
+        if (trdp_XMLSeekStartTag(&xml, "data-set-list") == 0)
+        {
+            trdp_XMLEnter(&xml);
+            for (idx = 0u; (idx < gNumDs) && (trdp_XMLSeekStartTag(&xml, "data-set") == 0); idx++)
+            {
+                trdp_XMLEnter(&xml);
+                while (trdp_XMLGetAttribute(&xml, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+                {
+                    if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
+                    {
+                        genIdentifier(gDs[idx].name, value, "dataset", gDs[idx].pDataset->id);
+                    }
+                }
+                for (i = 0u; trdp_XMLSeekStartTag(&xml, "element") == 0; i++)
+                {
+                    while (trdp_XMLGetAttribute(&xml, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+                    {
+                        if ((vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0) &&
+                            (i < gDs[idx].pDataset->numElement))
+                        {
+                            genIdentifier(gDs[idx].pElemName[i], value, "element", i);
+                        }
+                    }
+                }
+                trdp_XMLLeave(&xml);
+            }
+            trdp_XMLLeave(&xml);
+        }
+        trdp_XMLLeave(&xml);
+    }
+    trdp_XMLLeave(&xml);
+    trdp_XMLClose(&xml);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Find a dataset by its id
+ *
+ *  @param[in]      id              dataset id
+ *
+ *  @retval         NULL if unknown
+ */
+static GEN_DS_T *genFind (
+    UINT32 id)
+{
+    UINT32 i;
+
+    for (i = 0u; i < gNumDs; i++)
+    {
+        if (gDs[i].pDataset->id == id)
+        {
+            return &gDs[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Return the C type and the wire size of a basic type
+ *
+ *  @param[in]      type            TRDP_DATA_TYPE_T
+ *  @param[out]     pWireSize       wire bytes of one item
+ *
+ *  @retval         NULL if not a basic type
+ */
+static const CHAR8 *genCType (
+    UINT32 type,
+    UINT32 *pWireSize)
+{
+    static const struct
+    {
+        const CHAR8 *pName;
+        UINT32      wireSize;
+    } cTypes[] =
+    {
+        {NULL, 0u}, {"BOOL8", 1u}, {"CHAR8", 1u}, {"UTF16", 2u}, {"INT8", 1u}, {"INT16", 2u}, {"INT32", 4u},
+        {"INT64", 8u}, {"UINT8", 1u}, {"UINT16", 2u}, {"UINT32", 4u}, {"UINT64", 8u}, {"REAL32", 4u},
+        {"REAL64", 8u}, {"TIMEDATE32", 4u}, {"TIMEDATE48", 6u}, {"TIMEDATE64", 8u}
+    };
+
+    if ((type == 0u) || (type > TRDP_TIMEDATE64))
+    {
+        return NULL;
+    }
+    *pWireSize = cTypes[type].wireSize;
+    return cTypes[type].pName;
+}
+
+/**********************************************************************************************************************/
+/** Arrays of these types are copied as they are
+ *
+ *  @param[in]      type            element type
+ *
+ *  @retval         TRUE for 8 bit types
+ */
+static BOOL8 genIsBytes (
+    UINT32 type)
+{
+    return ((type == TRDP_BOOL8) || (type == TRDP_CHAR8) || (type == TRDP_INT8) || (type == TRDP_UINT8)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Arrays of these types are converted by swapping the bytes of each item
+ *
+ *  @param[in]      type            element type
+ *
+ *  @retval         item size, 0 for other types
+ */
+static UINT32 genSwapSize (
+    UINT32 type)
+{
+    switch (type)
+    {
+       case TRDP_UTF16:
+       case TRDP_INT16:
+       case TRDP_UINT16:
+           return 2u;
+       case TRDP_INT32:
+       case TRDP_UINT32:
+       case TRDP_REAL32:
+       case TRDP_TIMEDATE32:
+           return 4u;
+       case TRDP_INT64:
+       case TRDP_UINT64:
+       case TRDP_REAL64:
+           return 8u;
+       default:
+           return 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check a dataset (and its nested datasets) for a fixed size and compute the wire size
+ *
+ *  @param[in,out]  pGen            dataset
+ *
+ *  @retval         TRUE if the dataset can be generated
+ */
+static BOOL8 genCheck (
+    GEN_DS_T *pGen)
+{
+    UINT32 i;
+
+    if (pGen->state == GEN_BUSY)
+    {
+        return FALSE;
+    }
+    if (pGen->state != GEN_NEW)
+    {
+        return (pGen->state != GEN_SKIP) ? TRUE : FALSE;
+    }
+    pGen->state     = GEN_BUSY;
+    pGen->wireSize  = 0u;
+    for (i = 0u; i < pGen->pDataset->numElement; i++)
+    {
+        const TRDP_DATASET_ELEMENT_T    *pElement = &pGen->pDataset->pElement[i];
+        GEN_DS_T                        *pNested;
+        UINT32                          wireSize;
+
+        if (pElement->size == TRDP_VAR_SIZE)
+        {
+            pGen->state = GEN_SKIP;
+            return FALSE;
+        }
+        if (pElement->type > TRDP_TYPE_MAX)
+        {
+            pNested = genFind(pElement->type);
+            if ((pNested == NULL) || (genCheck(pNested) == FALSE))
+            {
+                pGen->state = GEN_SKIP;
+                return FALSE;
+            }
+            wireSize = pNested->wireSize;
+        }
+        else if (genCType(pElement->type, &wireSize) == NULL)
+        {
+            pGen->state = GEN_SKIP;
+            return FALSE;
+        }
+        pGen->wireSize += pElement->size * wireSize;
+    }
+    pGen->state = (pGen->pDataset->numElement > 0u) ? GEN_NEW : GEN_SKIP;
+    return (pGen->state == GEN_NEW) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Write the structure of a dataset, nested structures first
+ *
+ *  @param[in]      fp              header file
+ *  @param[in,out]  pGen            dataset
+ */
+static void genStruct (
+    FILE        *fp,
+    GEN_DS_T    *pGen)
+{
+    UINT32  i;
+    UINT32  wireSize;
+
+    if (pGen->state != GEN_NEW)
+    {
+        return;
+    }
+    pGen->state = GEN_BUSY;
+    for (i = 0u; i < pGen->pDataset->numElement; i++)
+    {
+        if (pGen->pDataset->pElement[i].type > TRDP_TYPE_MAX)
+        {
+            genStruct(fp, genFind(pGen->pDataset->pElement[i].type));
+        }
+    }
+
+    fprintf(fp, "/** Dataset %u (%s), %u bytes on the wire */\ntypedef struct\n{\n",
+            pGen->pDataset->id, pGen->name, pGen->wireSize);
+    for (i = 0u; i < pGen->pDataset->numElement; i++)
+    {
+        const TRDP_DATASET_ELEMENT_T    *pElement = &pGen->pDataset->pElement[i];
+        CHAR8                           typeName[2u * GEN_MAX_NAME];
+
+        if (pElement->type > TRDP_TYPE_MAX)
+        {
+            (void) snprintf(typeName, sizeof(typeName), "%s_%s_T", gUpper, genFind(pElement->type)->typeName);
+        }
+        else
+        {
+            (void) snprintf(typeName, sizeof(typeName), "%s", genCType(pElement->type, &wireSize));
+        }
+        if (pElement->size > 1u)
+        {
+            fprintf(fp, "    %-24s %s[%u];\n", typeName, pGen->pElemName[i], pElement->size);
+        }
+        else
+        {
+            fprintf(fp, "    %-24s %s;\n", typeName, pGen->pElemName[i]);
+        }
+    }
+    fprintf(fp, "} %s_%s_T;\n\n", gUpper, pGen->typeName);
+    pGen->state = GEN_STRUCT;
+}
+
+/**********************************************************************************************************************/
+/** Write the statement converting one item of an element
+ *
+ *  @param[in]      fp              source file
+ *  @param[in]      type            element type
+ *  @param[in]      pField          field expression
+ *  @param[in]      marshall        TRUE: host to wire, FALSE: wire to host
+ */
+static void genItem (
+    FILE        *fp,
+    UINT32      type,
+    const CHAR8 *pField,
+    BOOL8       marshall)
+{
+    UINT32 wireSize = 0u;
+
+    if (type > TRDP_TYPE_MAX)
+    {
+        if (marshall == TRUE)
+        {
+            fprintf(fp, "pDst = %sPut%s(&%s, pDst);\n", gPrefix, genFind(type)->funcName, pField);
+        }
+        else
+        {
+            fprintf(fp, "pSrc = %sGet%s(pSrc, &%s);\n", gPrefix, genFind(type)->funcName, pField);
+        }
+        return;
+    }
+    (void) genCType(type, &wireSize);
+    switch (type)
+    {
+       case TRDP_TIMEDATE48:
+           if (marshall == TRUE)
+           {
+               fprintf(fp, "%sPut32(pDst, %s.sec); %sPut16(pDst + 4, %s.ticks); pDst += 6;\n",
+                       gPrefix, pField, gPrefix, pField);
+           }
+           else
+           {
+               fprintf(fp, "%s.sec = %sGet32(pSrc); %s.ticks = %sGet16(pSrc + 4); pSrc += 6;\n",
+                       pField, gPrefix, pField, gPrefix);
+           }
+           break;
+       case TRDP_TIMEDATE64:
+           if (marshall == TRUE)
+           {
+               fprintf(fp, "%sPut32(pDst, %s.tv_sec); %sPut32(pDst + 4, (UINT32) %s.tv_usec); pDst += 8;\n",
+                       gPrefix, pField, gPrefix, pField);
+           }
+           else
+           {
+               fprintf(fp, "%s.tv_sec = %sGet32(pSrc); %s.tv_usec = (INT32) %sGet32(pSrc + 4); pSrc += 8;\n",
+                       pField, gPrefix, pField, gPrefix);
+           }
+           break;
+       case TRDP_REAL32:
+       case TRDP_REAL64:
+           if (marshall == TRUE)
+           {
+               fprintf(fp, "%sPutReal%u(pDst, %s); pDst += %u;\n", gPrefix, wireSize * 8u, pField, wireSize);
+           }
+           else
+           {
+               fprintf(fp, "%s = %sGetReal%u(pSrc); pSrc += %u;\n", pField, gPrefix, wireSize * 8u, wireSize);
+           }
+           break;
+       case TRDP_BITSET8:
+       case TRDP_CHAR8:
+       case TRDP_UTF16:
+       case TRDP_INT8:
+       case TRDP_INT16:
+       case TRDP_INT32:
+       case TRDP_INT64:
+       case TRDP_UINT8:
+       case TRDP_UINT16:
+       case TRDP_UINT32:
+       case TRDP_UINT64:
+       case TRDP_TIMEDATE32:
+           if ((marshall == TRUE) && (wireSize == 1u))
+           {
+               fprintf(fp, "*pDst++ = (UINT8) %s;\n", pField);
+           }
+           else if (marshall == TRUE)
+           {
+               fprintf(fp, "%sPut%u(pDst, (UINT%u) %s); pDst += %u;\n",
+                       gPrefix, wireSize * 8u, wireSize * 8u, pField, wireSize);
+           }
+           else if (wireSize == 1u)
+           {
+               fprintf(fp, "%s = (%s) *pSrc++;\n", pField, genCType(type, &wireSize));
+           }
+           else
+           {
+               fprintf(fp, "%s = (%s) %sGet%u(pSrc); pSrc += %u;\n",
+                       pField, genCType(type, &wireSize), gPrefix, wireSize * 8u, wireSize);
+           }
+           break;
+       default:
+           /*  genCheck() skips such datasets, make the output fail to compile should one get here  */
+           fprintf(stderr, "Cannot convert element type %u of %s\n", type, pField);
+           fprintf(fp, "#error cannot convert element type %u of %s\n", type, pField);
+           break;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write the marshalling and unmarshalling functions of a dataset, nested ones first
+ *
+ *  @param[in]      fp              source file
+ *  @param[in,out]  pGen            dataset
+ */
+static void genFunctions (
+    FILE        *fp,
+    GEN_DS_T    *pGen)
+{
+    UINT32  i;
+    BOOL8   marshall;
+    BOOL8   loop = FALSE;
+
+    if (pGen->state != GEN_STRUCT)
+    {
+        return;
+    }
+    pGen->state = GEN_BUSY;
+    for (i = 0u; i < pGen->pDataset->numElement; i++)
+    {
+        if (pGen->pDataset->pElement[i].type > TRDP_TYPE_MAX)
+        {
+            genFunctions(fp, genFind(pGen->pDataset->pElement[i].type));
+        }
+        if ((pGen->pDataset->pElement[i].size > 1u) && (genIsBytes(pGen->pDataset->pElement[i].type) == FALSE) &&
+            (genSwapSize(pGen->pDataset->pElement[i].type) == 0u))
+        {
+            loop = TRUE;
+        }
+    }
+
+    for (marshall = TRUE; ; marshall = FALSE)
+    {
+        if (marshall == TRUE)
+        {
+            fprintf(fp, "static UINT8 *%sPut%s (\n    const %s_%s_T *p,\n    UINT8 *pDst)\n{\n",
+                    gPrefix, pGen->funcName, gUpper, pGen->typeName);
+        }
+        else
+        {
+            fprintf(fp, "static const UINT8 *%sGet%s (\n    const UINT8 *pSrc,\n    %s_%s_T *p)\n{\n",
+                    gPrefix, pGen->funcName, gUpper, pGen->typeName);
+        }
+        if (loop == TRUE)
+        {
+            fprintf(fp, "    UINT32 i;\n\n");
+        }
+        for (i = 0u; i < pGen->pDataset->numElement; i++)
+        {
+            const TRDP_DATASET_ELEMENT_T    *pElement = &pGen->pDataset->pElement[i];
+            CHAR8                           field[GEN_MAX_NAME + 8u];
+
+            if ((pElement->size > 1u) && (genIsBytes(pElement->type) == TRUE))
+            {
+                if (marshall == TRUE)
+                {
+                    fprintf(fp, "    memcpy(pDst, p->%s, %uu); pDst += %u;\n",
+                            pGen->pElemName[i], pElement->size, pElement->size);
+                }
+                else
+                {
+                    fprintf(fp, "    memcpy(p->%s, pSrc, %uu); pSrc += %u;\n",
+                            pGen->pElemName[i], pElement->size, pElement->size);
+                }
+            }
+            else if ((pElement->size > 1u) && (genSwapSize(pElement->type) != 0u))
+            {
+                UINT32 itemSize = genSwapSize(pElement->type);
+
+                if (marshall == TRUE)
+                {
+                    fprintf(fp, "    tau_swapItems(pDst, (const UINT8 *) p->%s, %uu, %uu); pDst += %u;\n",
+                            pGen->pElemName[i], pElement->size, itemSize, pElement->size * itemSize);
+                }
+                else
+                {
+                    fprintf(fp, "    tau_swapItems((UINT8 *) p->%s, pSrc, %uu, %uu); pSrc += %u;\n",
+                            pGen->pElemName[i], pElement->size, itemSize, pElement->size * itemSize);
+                }
+            }
+            else if (pElement->size > 1u)
+            {
+                (void) snprintf(field, sizeof(field), "p->%s[i]", pGen->pElemName[i]);
+                fprintf(fp, "    for (i = 0u; i < %uu; i++)\n    {\n        ", pElement->size);
+                genItem(fp, pElement->type, field, marshall);
+                fprintf(fp, "    }\n");
+            }
+            else
+            {
+                (void) snprintf(field, sizeof(field), "p->%s", pGen->pElemName[i]);
+                fprintf(fp, "    ");
+                genItem(fp, pElement->type, field, marshall);
+            }
+        }
+        fprintf(fp, "    return %s;\n}\n\n", (marshall == TRUE) ? "pDst" : "pSrc");
+        if (marshall == FALSE)
+        {
+            break;
+        }
+    }
+
+    fprintf(fp, "static void %sMarshall%s (\n    const UINT8 *pSrc,\n    UINT8 *pDst)\n{\n"
+            "    (void) %sPut%s((const %s_%s_T *) (const void *) pSrc, pDst);\n}\n\n",
+            gPrefix, pGen->funcName, gPrefix, pGen->funcName, gUpper, pGen->typeName);
+    fprintf(fp, "static void %sUnmarshall%s (\n    const UINT8 *pSrc,\n    UINT8 *pDst)\n{\n"
+            "    (void) %sGet%s(pSrc, (%s_%s_T *) (void *) pDst);\n}\n\n",
+            gPrefix, pGen->funcName, gPrefix, pGen->funcName, gUpper, pGen->typeName);
+    fprintf(fp, "/*  The structure must have the layout the marshalling of the stack expects  */\n"
+            "typedef char %sCheck%s[(sizeof(%s_%s_T) == ((%uu + ALIGNOF(%s_%s_T) - 1u) / ALIGNOF(%s_%s_T)) * "
+            "ALIGNOF(%s_%s_T)) ? 1 : -1];\n\n",
+            gPrefix, pGen->funcName, gUpper, pGen->typeName, pGen->hostSize, gUpper, pGen->typeName, gUpper, pGen->typeName,
+            gUpper, pGen->typeName);
+    pGen->state = GEN_DONE;
+}
+
+/**********************************************************************************************************************/
+/** Write the conversion helpers used by the generated functions
+ *
+ *  @param[in]      fp              source file
+ */
+static void genHelpers (
+    FILE *fp)
+{
+    const CHAR8 *p = gPrefix;
+
+    fprintf(fp,
+            "static INLINE void %sPut16 (UINT8 *pDst, UINT16 v)\n{\n"
+            "    pDst[0] = (UINT8) (v >> 8u); pDst[1] = (UINT8) v;\n}\n\n"
+            "static INLINE void %sPut32 (UINT8 *pDst, UINT32 v)\n{\n"
+            "    pDst[0] = (UINT8) (v >> 24u); pDst[1] = (UINT8) (v >> 16u);\n"
+            "    pDst[2] = (UINT8) (v >> 8u); pDst[3] = (UINT8) v;\n}\n\n"
+            "static INLINE void %sPut64 (UINT8 *pDst, UINT64 v)\n{\n"
+            "    %sPut32(pDst, (UINT32) (v >> 32u)); %sPut32(pDst + 4, (UINT32) v);\n}\n\n"
+            "static INLINE void %sPutReal32 (UINT8 *pDst, REAL32 v)\n{\n"
+            "    UINT32 u;\n\n    memcpy(&u, &v, 4u); %sPut32(pDst, u);\n}\n\n"
+            "static INLINE void %sPutReal64 (UINT8 *pDst, REAL64 v)\n{\n"
+            "    UINT64 u;\n\n    memcpy(&u, &v, 8u); %sPut64(pDst, u);\n}\n\n",
+            p, p, p, p, p, p, p, p, p);
+    fprintf(fp,
+            "static INLINE UINT16 %sGet16 (const UINT8 *pSrc)\n{\n"
+            "    return (UINT16) ((pSrc[0] << 8u) | pSrc[1]);\n}\n\n"
+            "static INLINE UINT32 %sGet32 (const UINT8 *pSrc)\n{\n"
+            "    return ((UINT32) pSrc[0] << 24u) | ((UINT32) pSrc[1] << 16u) | ((UINT32) pSrc[2] << 8u) | pSrc[3];\n"
+            "}\n\n"
+            "static INLINE UINT64 %sGet64 (const UINT8 *pSrc)\n{\n"
+            "    return ((UINT64) %sGet32(pSrc) << 32u) | %sGet32(pSrc + 4);\n}\n\n"
+            "static INLINE REAL32 %sGetReal32 (const UINT8 *pSrc)\n{\n"
+            "    UINT32 u = %sGet32(pSrc);\n    REAL32 v;\n\n    memcpy(&v, &u, 4u);\n    return v;\n}\n\n"
+            "static INLINE REAL64 %sGetReal64 (const UINT8 *pSrc)\n{\n"
+            "    UINT64 u = %sGet64(pSrc);\n    REAL64 v;\n\n    memcpy(&v, &u, 8u);\n    return v;\n}\n\n",
+            p, p, p, p, p, p, p, p, p);
+}
+
+/**********************************************************************************************************************/
+/** Write <base>.h and <base>.c
+ *
+ *  @param[in]      pBase           output file name without extension
+ *  @param[in]      pXmlFile        XML file, for the comment
+ *
+ *  @retval         0               no error
+ *  @retval         1               file not writable
+ */
+static int genWrite (
+    const CHAR8 *pBase,
+    const CHAR8 *pXmlFile)
+{
+    CHAR8       fileName[256];
+    const CHAR8 *pName;
+    FILE        *fp;
+    UINT32      i;
+    UINT32      numCodecs = 0u;
+
+    pName = strrchr(pBase, '/');
+    pName = (pName != NULL) ? pName + 1 : pBase;
+
+    (void) snprintf(fileName, sizeof(fileName), "%s.h", pBase);
+    fp = fopen(fileName, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Cannot write %s\n", fileName);
+        return 1;
+    }
+    fprintf(fp, "/*  Generated by trdp-xml2c from %s, do not edit  */\n\n"
+            "#ifndef %s_GENERATED_H\n#define %s_GENERATED_H\n\n#include \"tau_marshall.h\"\n\n",
+            pXmlFile, gUpper, gUpper);
+    for (i = 0u; i < gNumDs; i++)
+    {
+        if (gDs[i].state == GEN_SKIP)
+        {
+            fprintf(fp, "/*  Dataset %u (%s) has elements of variable size, it is marshalled by the stack  */\n\n",
+                    gDs[i].pDataset->id, gDs[i].name);
+        }
+        genStruct(fp, &gDs[i]);
+    }
+    for (i = 0u; i < gNumDs; i++)
+    {
+        numCodecs += (gDs[i].state == GEN_STRUCT) ? 1u : 0u;
+    }
+    fprintf(fp, "/** Generated functions, to be passed to tau_registerCodecs() */\n"
+            "#define %s_NUM_CODECS %uu\nextern const TAU_DS_CODEC_T %sCodecs[%s_NUM_CODECS];\n\n#endif\n",
+            gUpper, numCodecs, gPrefix, gUpper);
+    fclose(fp);
+
+    (void) snprintf(fileName, sizeof(fileName), "%s.c", pBase);
+    fp = fopen(fileName, "w");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Cannot write %s\n", fileName);
+        return 1;
+    }
+    fprintf(fp, "/*  Generated by trdp-xml2c from %s, do not edit  */\n\n"
+            "#include <string.h>\n\n#include \"vos_utils.h\"\n#include \"%s.h\"\n\n", pXmlFile, pName);
+    genHelpers(fp);
+    for (i = 0u; i < gNumDs; i++)
+    {
+        genFunctions(fp, &gDs[i]);
+    }
+    fprintf(fp, "const TAU_DS_CODEC_T %sCodecs[%s_NUM_CODECS] =\n{\n", gPrefix, gUpper);
+    for (i = 0u; i < gNumDs; i++)
+    {
+        if (gDs[i].state != GEN_SKIP)
+        {
+            fprintf(fp, "    {%uu, %uu, %uu, ALIGNOF(%s_%s_T), %sMarshall%s, %sUnmarshall%s},\n",
+                    gDs[i].pDataset->id, gDs[i].hostSize, gDs[i].wireSize, gUpper, gDs[i].typeName,
+                    gPrefix, gDs[i].funcName, gPrefix, gDs[i].funcName);
+        }
+    }
+    fprintf(fp, "};\n");
+    fclose(fp);
+    printf("%u of %u datasets generated into %s.h/.c\n", numCodecs, gNumDs, pBase);
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    TRDP_COMID_DSID_MAP_T   dummyMap;
+    UINT32                  numComId        = 0u;
+    UINT32                  numDataset      = 0u;
+    apTRDP_DATASET_T        apDataset       = NULL;
+    void                    *pRefCon        = NULL;
+    const CHAR8             *pBase          = NULL;
+    UINT8                   *pWire;
+    int                     rv              = 0;
+    int                     ch;
+    UINT32                  i;
+
+    while ((ch = getopt(argc, argv, "o:p:h?v")) != -1)
+    {
+        switch (ch)
+        {
+            case 'o':
+                pBase = optarg;
+                break;
+            case 'p':
+                gPrefix = optarg;
+                break;
+            case 'v':   /*  version */
+                printf("%s: Version %s\t(%s - %s)\n",
+                       argv[0], APP_VERSION, __DATE__, __TIME__);
+                exit(0);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if ((optind != argc - 1) || (strlen(gPrefix) >= GEN_MAX_NAME))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    for (i = 0u; gPrefix[i] != '\0'; i++)
+    {
+        gUpper[i] = (CHAR8) toupper((unsigned char) gPrefix[i]);
+    }
+    if (pBase == NULL)
+    {
+        pBase = gPrefix;
+    }
+
+    if ((tau_prepareXmlDoc(argv[optind], &docHandle) != TRDP_NO_ERR) ||
+        (tau_readXmlDatasetConfig(&docHandle, &numComId, &pComIdDsIdMap, &numDataset, &apDataset) != TRDP_NO_ERR) ||
+        (numDataset == 0u))
+    {
+        fprintf(stderr, "Cannot read the datasets of %s\n", argv[optind]);
+        return 1;
+    }
+    gNumDs  = numDataset;
+    gDs     = (GEN_DS_T *) calloc(gNumDs, sizeof(GEN_DS_T));
+    if (gDs == NULL)
+    {
+        return 1;
+    }
+    for (i = 0u; i < gNumDs; i++)
+    {
+        gDs[i].pDataset = apDataset[i];
+    }
+    if (genReadNames(argv[optind]) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Cannot read the names of %s\n", argv[optind]);
+        return 1;
+    }
+    for (i = 0u; i < gNumDs; i++)
+    {
+        UINT32 j;
+
+        for (j = 0u; gDs[i].name[j] != '\0'; j++)
+        {
+            gDs[i].typeName[j] = (CHAR8) toupper((unsigned char) gDs[i].name[j]);
+        }
+        memcpy(gDs[i].funcName, gDs[i].name, GEN_MAX_NAME);
+        gDs[i].funcName[0] = gDs[i].typeName[0];
+        (void) genCheck(&gDs[i]);
+    }
+
+    /*  The host sizes are those the marshalling of this build computes  */
+    dummyMap.comId      = 1u;
+    dummyMap.datasetId  = apDataset[0]->id;
+    if (tau_initMarshall(&pRefCon, (numComId > 0u) ? numComId : 1u, (numComId > 0u) ? pComIdDsIdMap : &dummyMap,
+                         numDataset, apDataset) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Cannot initialise the marshalling\n");
+        return 1;
+    }
+    for (i = 0u; (i < gNumDs) && (rv == 0); i++)
+    {
+        if (gDs[i].state == GEN_NEW)
+        {
+            pWire = (UINT8 *) calloc(1u, gDs[i].wireSize);
+            if ((pWire == NULL) ||
+                (tau_calcDatasetSize(pRefCon, gDs[i].pDataset->id, pWire, gDs[i].wireSize, &gDs[i].hostSize,
+                                     NULL) != TRDP_NO_ERR))
+            {
+                fprintf(stderr, "Cannot size dataset %u\n", gDs[i].pDataset->id);
+                rv = 1;
+            }
+            free(pWire);
+        }
+    }
+
+    if (rv == 0)
+    {
+        rv = genWrite(pBase, argv[optind]);
+    }
+
+    (void) tau_deInitMarshall(pRefCon);
+    for (i = 0u; i < gNumDs; i++)
+    {
+        free(gDs[i].pElemName);
+    }
+    free(gDs);
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    tau_freeXmlDoc(&docHandle);
+    return rv;
+}